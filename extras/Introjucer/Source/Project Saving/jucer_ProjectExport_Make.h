@@ -54,19 +54,28 @@ public:
     bool isLinux() const override                       { return true; }
     bool canCopeWithDuplicateFiles() override           { return false; }
 
-    void createExporterProperties (PropertyListBuilder&) override
+    Value getModuleLibraryCacheValue()          { return getSetting (Ids::moduleLibraryCache); }
+    String getModuleLibraryCacheString() const  { return getSettingString (Ids::moduleLibraryCache); }
+
+    void createExporterProperties (PropertyListBuilder& props) override
     {
+        props.add (new TextPropertyComponent (getModuleLibraryCacheValue(), "Module library cache", 1024, false),
+                   "If this is set, the JUCE modules are built into a static library in this folder, rather than being compiled along with "
+                   "the rest of the project. Each library is stored under a hash of the AppConfig.h settings, compiler flags and module "
+                   "source code, so projects that share the same module configuration will only build it once, and then link to the same "
+                   "library. It can contain make variables such as $(HOME), and can be overridden by setting JUCE_MODULE_CACHE.");
     }
 
     //==============================================================================
     void create (const OwnedArray<LibraryModule>&) const override
     {
-        Array<RelativePath> files;
+        Array<RelativePath> files, moduleFiles;
         for (int i = 0; i < getAllGroups().size(); ++i)
-            findAllFilesToCompile (getAllGroups().getReference(i), files);
+            findAllFilesToCompile (getAllGroups().getReference(i), files,
+                                   shouldUseModuleLibraryCache() ? moduleFiles : files);
 
         MemoryOutputStream mo;
-        writeMakefile (mo, files);
+        writeMakefile (mo, files, moduleFiles);
 
         overwriteFileIfDifferentOrThrow (getTargetFolder().getChildFile ("Makefile"), mo);
     }
@@ -107,20 +116,28 @@ protected:
 
 private:
     //==============================================================================
-    void findAllFilesToCompile (const Project::Item& projectItem, Array<RelativePath>& results) const
+    void findAllFilesToCompile (const Project::Item& projectItem, Array<RelativePath>& results,
+                                Array<RelativePath>& moduleResults) const
     {
         if (projectItem.isGroup())
         {
             for (int i = 0; i < projectItem.getNumChildren(); ++i)
-                findAllFilesToCompile (projectItem.getChild(i), results);
+                findAllFilesToCompile (projectItem.getChild(i), results, moduleResults);
         }
         else
         {
             if (projectItem.shouldBeCompiled())
-                results.add (RelativePath (projectItem.getFile(), getTargetFolder(), RelativePath::buildTargetFolder));
+                (projectItem.isModuleCode() ? moduleResults : results)
+                    .add (RelativePath (projectItem.getFile(), getTargetFolder(), RelativePath::buildTargetFolder));
         }
     }
 
+    bool shouldUseModuleLibraryCache() const
+    {
+        // (a static library has to contain the modules itself)
+        return getModuleLibraryCacheString().trim().isNotEmpty() && ! projectType.isStaticLibrary();
+    }
+
     void writeDefineFlags (OutputStream& out, const BuildConfiguration& config) const
     {
         StringPairArray defines;
@@ -212,17 +229,18 @@ private:
 
         writeCppFlags (out, config);
 
-        out << "  CFLAGS += $(CPPFLAGS) $(TARGET_ARCH)";
+        String compilerFlags;
 
         if (config.isDebug())
-            out << " -g -ggdb";
+            compilerFlags << " -g -ggdb";
 
         if (makefileIsDLL)
-            out << " -fPIC";
+            compilerFlags << " -fPIC";
 
-        out << " -O" << config.getGCCOptimisationFlag()
-            << (" "  + replacePreprocessorTokens (config, getExtraCompilerFlagsString())).trimEnd()
-            << newLine;
+        compilerFlags << " -O" << config.getGCCOptimisationFlag()
+                      << (" "  + replacePreprocessorTokens (config, getExtraCompilerFlagsString())).trimEnd();
+
+        out << "  CFLAGS += $(CPPFLAGS) $(TARGET_ARCH)" << compilerFlags << newLine;
 
         out << "  CXXFLAGS += $(CFLAGS)" << newLine;
 
@@ -239,8 +257,13 @@ private:
 
         out << "  TARGET := " << escapeSpaces (targetName) << newLine;
 
+        if (shouldUseModuleLibraryCache())
+            writeModuleLibraryConfig (out, config, compilerFlags);
+
         if (projectType.isStaticLibrary())
             out << "  BLDCMD = ar -rcs $(OUTDIR)/$(TARGET) $(OBJECTS)" << newLine;
+        else if (shouldUseModuleLibraryCache())
+            out << "  BLDCMD = $(CXX) -o $(OUTDIR)/$(TARGET) $(OBJECTS) -Wl,--whole-archive $(JUCE_MODULE_LIB) -Wl,--no-whole-archive $(LDFLAGS) $(RESOURCES) $(TARGET_ARCH)" << newLine;
         else
             out << "  BLDCMD = $(CXX) -o $(OUTDIR)/$(TARGET) $(OBJECTS) $(LDFLAGS) $(RESOURCES) $(TARGET_ARCH)" << newLine;
 
@@ -249,9 +272,43 @@ private:
             << newLine;
     }
 
-    void writeObjects (OutputStream& out, const Array<RelativePath>& files) const
+    void writeModuleLibraryConfig (OutputStream& out, const BuildConfiguration& config, const String& compilerFlags) const
     {
-        out << "OBJECTS := \\" << newLine;
+        // The library's folder is named after a hash of everything that affects the compiled modules. The
+        // header search paths are left out, as they only locate the AppConfig.h and module files, which are
+        // hashed by their contents.
+        const RelativePath appConfig (project.getGeneratedCodeFolder().getChildFile (project.getAppConfigFilename()),
+                                      getTargetFolder(), RelativePath::buildTargetFolder);
+
+        MemoryOutputStream defines;
+        writeDefineFlags (defines, config);
+
+        out << "  JUCE_MODULE_FLAGS := $(CXX) $(TARGET_ARCH)" << defines.toString() << compilerFlags << newLine
+            << "  JUCE_MODULE_HASH := $(shell { grep -v __JUCE_APPCONFIG_ " << escapeSpaces (appConfig.toUnixStyle())
+            << "; echo \"$(JUCE_MODULE_FLAGS)\"; echo \"$(JUCE_MODULE_SOURCE_HASH)\"; } | md5sum | cut -c1-16)" << newLine
+            << "  JUCE_MODULE_LIB := $(JUCE_MODULE_CACHE)/" << escapeSpaces (config.getName()) << "_$(JUCE_MODULE_HASH)/libjucemodules.a" << newLine;
+    }
+
+    void writeModuleLibraryCache (OutputStream& out) const
+    {
+        out << "# (the JUCE modules are built into a shared cache, in a folder named after a hash of the" << newLine
+            << "# settings and module sources, so that projects with the same module configuration can share them)" << newLine
+            << "JUCE_MODULE_CACHE ?= " << getModuleLibraryCacheString().trim() << newLine
+            << "JUCE_MODULE_FOLDERS :=";
+
+        for (int i = 0; i < makefileModuleFolders.size(); ++i)
+            out << " " << escapeSpaces (makefileModuleFolders.getReference(i)
+                                           .rebased (projectFolder, getTargetFolder(), RelativePath::buildTargetFolder)
+                                           .toUnixStyle());
+
+        out << newLine
+            << "JUCE_MODULE_SOURCE_HASH := $(shell for d in $(JUCE_MODULE_FOLDERS); do (cd \"$$d\" && find . -type f | LC_ALL=C sort | xargs cat); done | md5sum)" << newLine
+            << newLine;
+    }
+
+    void writeObjects (OutputStream& out, const String& variableName, const Array<RelativePath>& files) const
+    {
+        out << variableName << " := \\" << newLine;
 
         for (int i = 0; i < files.size(); ++i)
             if (shouldFileBeCompiledByDefault (files.getReference(i)))
@@ -260,8 +317,29 @@ private:
         out << newLine;
     }
 
-    void writeMakefile (OutputStream& out, const Array<RelativePath>& files) const
+    void writeCompileRules (OutputStream& out, const Array<RelativePath>& files) const
     {
+        for (int i = 0; i < files.size(); ++i)
+        {
+            if (shouldFileBeCompiledByDefault (files.getReference(i)))
+            {
+                jassert (files.getReference(i).getRoot() == RelativePath::buildTargetFolder);
+
+                out << "$(OBJDIR)/" << escapeSpaces (getObjectFileFor (files.getReference(i)))
+                    << ": " << escapeSpaces (files.getReference(i).toUnixStyle()) << newLine
+                    << "\t-@mkdir -p $(OBJDIR)" << newLine
+                    << "\t@echo \"Compiling " << files.getReference(i).getFileName() << "\"" << newLine
+                    << (files.getReference(i).hasFileExtension ("c;s;S") ? "\t@$(CC) $(CFLAGS) -o \"$@\" -c \"$<\""
+                                                                         : "\t@$(CXX) $(CXXFLAGS) -o \"$@\" -c \"$<\"")
+                    << newLine << newLine;
+            }
+        }
+    }
+
+    void writeMakefile (OutputStream& out, const Array<RelativePath>& files, const Array<RelativePath>& moduleFiles) const
+    {
+        const bool useModuleCache = moduleFiles.size() > 0;
+
         out << "# Automatically generated makefile, created by the Introjucer" << newLine
             << "# Don't edit this file! Your changes will be overwritten when you re-save the Introjucer project!" << newLine
             << newLine;
@@ -275,15 +353,22 @@ private:
             << "endif" << newLine
             << newLine;
 
+        if (useModuleCache)
+            writeModuleLibraryCache (out);
+
         for (ConstConfigIterator config (*this); config.next();)
             writeConfig (out, *config);
 
-        writeObjects (out, files);
+        writeObjects (out, "OBJECTS", files);
 
-        out << ".PHONY: clean" << newLine
+        if (useModuleCache)
+            writeObjects (out, "JUCE_MODULE_OBJECTS", moduleFiles);
+
+        out << (useModuleCache ? ".PHONY: clean juce_module_objects" : ".PHONY: clean") << newLine
             << newLine;
 
-        out << "$(OUTDIR)/$(TARGET): $(OBJECTS) $(RESOURCES)" << newLine
+        out << (useModuleCache ? "$(OUTDIR)/$(TARGET): $(OBJECTS) $(JUCE_MODULE_LIB) $(RESOURCES)"
+                               : "$(OUTDIR)/$(TARGET): $(OBJECTS) $(RESOURCES)") << newLine
             << "\t@echo Linking " << projectName << newLine
             << "\t-@mkdir -p $(BINDIR)" << newLine
             << "\t-@mkdir -p $(LIBDIR)" << newLine
@@ -301,22 +386,23 @@ private:
             << "\t-@strip --strip-unneeded $(OUTDIR)/$(TARGET)" << newLine
             << newLine;
 
-        for (int i = 0; i < files.size(); ++i)
+        if (useModuleCache)
         {
-            if (shouldFileBeCompiledByDefault (files.getReference(i)))
-            {
-                jassert (files.getReference(i).getRoot() == RelativePath::buildTargetFolder);
-
-                out << "$(OBJDIR)/" << escapeSpaces (getObjectFileFor (files.getReference(i)))
-                    << ": " << escapeSpaces (files.getReference(i).toUnixStyle()) << newLine
-                    << "\t-@mkdir -p $(OBJDIR)" << newLine
-                    << "\t@echo \"Compiling " << files.getReference(i).getFileName() << "\"" << newLine
-                    << (files.getReference(i).hasFileExtension ("c;s;S") ? "\t@$(CC) $(CFLAGS) -o \"$@\" -c \"$<\""
-                                                                         : "\t@$(CXX) $(CXXFLAGS) -o \"$@\" -c \"$<\"")
-                    << newLine << newLine;
-            }
+            // (the library has no prerequisites, as its name changes whenever anything that it depends on does,
+            // and the objects are built by a separate make invocation so that they're only needed if it's missing)
+            out << "$(JUCE_MODULE_LIB):" << newLine
+                << "\t@echo Building JUCE modules into $(dir $@)" << newLine
+                << "\t@$(MAKE) --no-print-directory juce_module_objects" << newLine
+                << "\t-@mkdir -p $(dir $@)" << newLine
+                << "\t@ar -rcs $@.$$$$ $(JUCE_MODULE_OBJECTS) && mv -f $@.$$$$ $@" << newLine
+                << newLine
+                << "juce_module_objects: $(JUCE_MODULE_OBJECTS)" << newLine
+                << newLine;
         }
 
+        writeCompileRules (out, files);
+        writeCompileRules (out, moduleFiles);
+
         out << "-include $(OBJECTS:%.o=%.d)" << newLine;
     }
 
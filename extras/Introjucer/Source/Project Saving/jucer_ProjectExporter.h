@@ -173,6 +173,7 @@ public:
     String makefileTargetSuffix;
     bool makefileIsDLL;
     StringArray linuxLibs;
+    Array<RelativePath> makefileModuleFolders;
 
     //==============================================================================
     String msvcTargetSuffix;
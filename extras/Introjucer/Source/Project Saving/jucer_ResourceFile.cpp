@@ -121,8 +121,6 @@ Result ResourceFile::writeHeader (MemoryOutputStream& header)
            << "namespace " << className << newLine
            << "{" << newLine;
 
-    bool containsAnyImages = false;
-
     for (int i = 0; i < files.size(); ++i)
     {
         const File& file = files.getReference(i);
@@ -130,20 +128,10 @@ Result ResourceFile::writeHeader (MemoryOutputStream& header)
         if (! file.existsAsFile())
             return Result::fail ("Can't open resource file: " + file.getFullPathName());
 
-        const int64 dataSize = file.getSize();
-
         const String variableName (variableNames[i]);
 
-        FileInputStream fileStream (file);
-
-        if (fileStream.openedOk())
-        {
-            containsAnyImages = containsAnyImages
-                                 || (ImageFileFormat::findImageFormatForStream (fileStream) != nullptr);
-
-            header << "    extern const char*   " << variableName << ";" << newLine;
-            header << "    const int            " << variableName << "Size = " << (int) dataSize << ";" << newLine << newLine;
-        }
+        header << "    extern const char*   " << variableName << ";" << newLine;
+        header << "    const int            " << variableName << "Size = " << (int) file.getSize() << ";" << newLine << newLine;
     }
 
     header << "    // Points to the start of a list of resource names." << newLine
@@ -162,18 +150,69 @@ Result ResourceFile::writeHeader (MemoryOutputStream& header)
     return Result::ok();
 }
 
-Result ResourceFile::writeCpp (MemoryOutputStream& cpp, const File& headerFile, int& i, const int maxFileSize)
+//==============================================================================
+Array<Range<int> > ResourceFile::getChunks (const int maxFileSize) const
+{
+    Array<Range<int> > chunks;
+    int start = 0;
+    int64 chunkSize = 0;
+
+    for (int i = 0; i < files.size(); ++i)
+    {
+        // (each byte takes up to 4 characters when it's written as a number)
+        chunkSize += 4 * files.getReference(i).getSize() + 256;
+
+        if (chunkSize > maxFileSize || i == files.size() - 1)
+        {
+            chunks.add (Range<int> (start, i + 1));
+            start = i + 1;
+            chunkSize = 0;
+        }
+    }
+
+    return chunks;
+}
+
+String ResourceFile::getChunkStamp (Range<int> range) const
 {
-    const bool isFirstFile = (i == 0);
+    // The stamp identifies everything that the generated code depends on, so that a chunk
+    // can be left alone if none of its resources have changed since it was written.
+    String s (className);
 
-    cpp << "/* ==================================== " << resourceFileIdentifierString << " ===================================="
+    for (int i = range.getStart(); i < range.getEnd(); ++i)
+    {
+        const File& file = files.getReference(i);
+
+        s << ';' << variableNames[i]
+          << ';' << file.getFullPathName()
+          << ';' << file.getSize()
+          << ';' << file.getLastModificationTime().toMilliseconds();
+    }
+
+    return String::toHexString (s.hashCode64());
+}
+
+static bool fileHasResourceStamp (const File& file, const String& stamp)
+{
+    FileInputStream in (file);
+
+    if (! in.openedOk())
+        return false;
+
+    MemoryBlock start;
+    in.readIntoMemoryBlock (start, 512);
+    return start.toString().contains ("Resource stamp: " + stamp);
+}
+
+void ResourceFile::writeDataChunk (MemoryOutputStream& cpp, Range<int> range, const String& stamp) const
+{
+    cpp << "/* ==================================== " << resourceFileIdentifierString << " ====================================" << newLine
+        << "   Resource stamp: " << stamp
         << getComment()
         << "namespace " << className << newLine
         << "{" << newLine;
 
-    bool containsAnyImages = false;
-
-    while (i < files.size())
+    for (int i = range.getStart(); i < range.getEnd(); ++i)
     {
         const File& file = files.getReference(i);
         const String variableName (variableNames[i]);
@@ -182,9 +221,6 @@ Result ResourceFile::writeCpp (MemoryOutputStream& cpp, const File& headerFile,
 
         if (fileStream.openedOk())
         {
-            containsAnyImages = containsAnyImages
-                                 || (ImageFileFormat::findImageFormatForStream (fileStream) != nullptr);
-
             const String tempVariable ("temp_binary_data_" + String (i));
 
             cpp  << newLine << "//================== " << file.getFileName() << " ==================" << newLine
@@ -199,60 +235,80 @@ Result ResourceFile::writeCpp (MemoryOutputStream& cpp, const File& headerFile,
             cpp << newLine << newLine
                 << "const char* " << variableName << " = (const char*) " << tempVariable << ";" << newLine;
         }
+    }
 
-        ++i;
+    cpp << newLine
+        << "}" << newLine;
+}
 
-        if (cpp.getPosition() > maxFileSize)
-            break;
-    }
+void ResourceFile::writeResourceIndex (MemoryOutputStream& cpp) const
+{
+    cpp << newLine
+        << "namespace " << className << newLine
+        << "{" << newLine
+        << newLine
+        << "const char* getNamedResource (const char*, int&) throw();" << newLine
+        << "const char* getNamedResource (const char* resourceNameUTF8, int& numBytes) throw()" << newLine
+        << "{" << newLine;
 
-    if (isFirstFile)
+    StringArray returnCodes;
+    for (int j = 0; j < files.size(); ++j)
     {
-        if (i < files.size())
-        {
-            cpp << newLine
-                << "}" << newLine
-                << newLine
-                << "#include \"" << headerFile.getFileName() << "\"" << newLine
-                << newLine
-                << "namespace " << className << newLine
-                << "{";
-        }
+        const File& file = files.getReference(j);
+        const int64 dataSize = file.getSize();
+        returnCodes.add ("numBytes = " + String (dataSize) + "; return " + variableNames[j] + ";");
+    }
 
-        cpp << newLine
-            << newLine
-            << "const char* getNamedResource (const char*, int&) throw();" << newLine
-            << "const char* getNamedResource (const char* resourceNameUTF8, int& numBytes) throw()" << newLine
-            << "{" << newLine;
+    CodeHelpers::createStringMatcher (cpp, "resourceNameUTF8", variableNames, returnCodes, 4);
 
-        StringArray returnCodes;
-        for (int j = 0; j < files.size(); ++j)
-        {
-            const File& file = files.getReference(j);
-            const int64 dataSize = file.getSize();
-            returnCodes.add ("numBytes = " + String (dataSize) + "; return " + variableNames[j] + ";");
-        }
+    cpp << "    numBytes = 0;" << newLine
+        << "    return 0;" << newLine
+        << "}" << newLine
+        << newLine
+        << "const char* namedResourceList[] =" << newLine
+        << "{" << newLine;
 
-        CodeHelpers::createStringMatcher (cpp, "resourceNameUTF8", variableNames, returnCodes, 4);
+    for (int j = 0; j < files.size(); ++j)
+        cpp << "    " << variableNames[j].quoted() << (j < files.size() - 1 ? "," : "") << newLine;
 
-        cpp << "    numBytes = 0;" << newLine
-            << "    return 0;" << newLine
-            << "}" << newLine
-            << newLine
-            << "const char* namedResourceList[] =" << newLine
-            << "{" << newLine;
+    cpp << "};" << newLine
+        << newLine
+        << "}" << newLine;
+}
 
-        for (int j = 0; j < files.size(); ++j)
-            cpp << "    " << variableNames[j].quoted() << (j < files.size() - 1 ? "," : "") << newLine;
+//==============================================================================
+class ResourceFile::ChunkWriterJob  : public ThreadPoolJob
+{
+public:
+    ChunkWriterJob (const ResourceFile& r, const File& f, Range<int> fileRange, const String& chunkStamp, bool index)
+        : ThreadPoolJob ("BinaryData"), owner (r), file (f), range (fileRange),
+          stamp (chunkStamp), includeIndex (index), result (Result::ok())
+    {
+    }
 
-        cpp << "};" << newLine;
+    JobStatus runJob() override
+    {
+        MemoryOutputStream mo;
+        owner.writeDataChunk (mo, range, stamp);
+
+        if (includeIndex)
+            owner.writeResourceIndex (mo);
+
+        if (! FileHelpers::overwriteFileWithNewDataIfDifferent (file, mo))
+            result = Result::fail ("Can't write to file: " + file.getFullPathName());
+
+        return jobHasFinished;
     }
 
-    cpp << newLine
-        << "}" << newLine;
+    const ResourceFile& owner;
+    const File file;
+    const Range<int> range;
+    const String stamp;
+    const bool includeIndex;
+    Result result;
 
-    return Result::ok();
-}
+    JUCE_DECLARE_NON_COPYABLE (ChunkWriterJob)
+};
 
 Result ResourceFile::write (Array<File>& filesCreated, const int maxFileSize)
 {
@@ -271,29 +327,55 @@ Result ResourceFile::write (Array<File>& filesCreated, const int maxFileSize)
         filesCreated.add (headerFile);
     }
 
-    int i = 0;
-    int fileIndex = 0;
+    // If everything fits into one file, it also holds the getNamedResource() function. Otherwise,
+    // the first file just contains that function, and the data is spread across the others, so that
+    // changing one resource only means that the chunk containing it needs to be rebuilt.
+    const Array<Range<int> > chunks (getChunks (maxFileSize));
+    const bool isSingleFile = chunks.size() == 1;
 
-    for (;;)
+    if (! isSingleFile)
     {
-        File cpp (project.getBinaryDataCppFile (fileIndex));
+        const File indexFile (project.getBinaryDataCppFile (0));
 
         MemoryOutputStream mo;
+        mo << "/* ==================================== " << resourceFileIdentifierString << " ===================================="
+           << getComment()
+           << "#include \"" << headerFile.getFileName() << "\"" << newLine;
 
-        Result r (writeCpp (mo, headerFile, i, maxFileSize));
+        writeResourceIndex (mo);
 
-        if (r.failed())
-            return r;
+        if (! FileHelpers::overwriteFileWithNewDataIfDifferent (indexFile, mo))
+            return Result::fail ("Can't write to file: " + indexFile.getFullPathName());
 
-        if (! FileHelpers::overwriteFileWithNewDataIfDifferent (cpp, mo))
-            return Result::fail ("Can't write to file: " + cpp.getFullPathName());
+        filesCreated.add (indexFile);
+    }
 
-        filesCreated.add (cpp);
-        ++fileIndex;
+    // The chunks whose resources have changed are regenerated in parallel, as converting
+    // large files into C++ literals is slow.
+    ThreadPool pool (jmax (1, jmin (chunks.size(), SystemStats::getNumCpus())));
+    OwnedArray<ChunkWriterJob> jobs;
+
+    for (int i = 0; i < chunks.size(); ++i)
+    {
+        const File cpp (project.getBinaryDataCppFile (isSingleFile ? 0 : i + 1));
+        const String stamp (getChunkStamp (chunks.getReference (i)));
+
+        if (! fileHasResourceStamp (cpp, stamp))
+        {
+            ChunkWriterJob* const job = new ChunkWriterJob (*this, cpp, chunks.getReference (i), stamp, isSingleFile);
+            jobs.add (job);
+            pool.addJob (job, false);
+        }
 
-        if (i >= files.size())
-            break;
+        filesCreated.add (cpp);
     }
 
+    for (int i = 0; i < jobs.size(); ++i)
+        pool.waitForJobToFinish (jobs.getUnchecked (i), -1);
+
+    for (int i = 0; i < jobs.size(); ++i)
+        if (jobs.getUnchecked (i)->result.failed())
+            return jobs.getUnchecked (i)->result;
+
     return Result::ok();
 }
@@ -59,8 +59,13 @@ private:
     Project& project;
     String className;
 
+    class ChunkWriterJob;
+
     Result writeHeader (MemoryOutputStream&);
-    Result writeCpp (MemoryOutputStream&, const File& headerFile, int& index, int maxFileSize);
+    Array<Range<int> > getChunks (int maxFileSize) const;
+    String getChunkStamp (Range<int> fileRange) const;
+    void writeDataChunk (MemoryOutputStream&, Range<int> fileRange, const String& stamp) const;
+    void writeResourceIndex (MemoryOutputStream&) const;
     void addResourcesFromProjectItem (const Project::Item& node);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResourceFile)
@@ -294,36 +294,63 @@ static void writeGuardedInclude (OutputStream& out, StringArray paths, StringArr
     }
 }
 
-void LibraryModule::createLocalHeaderWrapper (ProjectSaver& projectSaver, const File& originalHeader, const File& localHeader) const
+void LibraryModule::writeIncludeForAllExporters (ProjectSaver& projectSaver, const String& moduleFileName,
+                                                 const File& includingFile, OutputStream& out) const
 {
     Project& project = projectSaver.project;
-
-    MemoryOutputStream out;
-
-    out << "// This is an auto-generated file to redirect any included" << newLine
-        << "// module headers to the correct external folder." << newLine
-        << newLine;
-
     StringArray paths, guards;
 
     for (Project::ExporterIterator exporter (project); exporter.next();)
     {
-        const RelativePath headerFromProject (exporter->getModuleFolderRelativeToProject (getID(), projectSaver)
-                                                .getChildFile (originalHeader.getFileName()));
+        const RelativePath fileFromProject (exporter->getModuleFolderRelativeToProject (getID(), projectSaver)
+                                              .getChildFile (moduleFileName));
 
-        const RelativePath fileFromHere (headerFromProject.rebased (project.getProjectFolder(),
-                                                                    localHeader.getParentDirectory(), RelativePath::unknown));
+        const RelativePath fileFromHere (fileFromProject.rebased (project.getProjectFolder(),
+                                                                  includingFile.getParentDirectory(), RelativePath::unknown));
 
         paths.add (fileFromHere.toUnixStyle().quoted());
         guards.add ("defined (" + exporter->getExporterIdentifierMacro() + ")");
     }
 
     writeGuardedInclude (out, paths, guards);
+}
+
+void LibraryModule::createLocalHeaderWrapper (ProjectSaver& projectSaver, const File& originalHeader, const File& localHeader) const
+{
+    MemoryOutputStream out;
+
+    out << "// This is an auto-generated file to redirect any included" << newLine
+        << "// module headers to the correct external folder." << newLine
+        << newLine;
+
+    writeIncludeForAllExporters (projectSaver, originalHeader.getFileName(), localHeader, out);
     out << newLine;
 
     projectSaver.replaceFileIfDifferent (localHeader, out);
 }
 
+File LibraryModule::createCompileUnitWrapper (ProjectSaver& projectSaver, const String& moduleFileName, const int unitIndex) const
+{
+    const File original (moduleInfo.getFolder().getChildFile (moduleFileName));
+    const File wrapper (projectSaver.getGeneratedCodeFolder()
+                          .getChildFile (original.getFileNameWithoutExtension() + "_" + String (unitIndex)
+                                            + original.getFileExtension()));
+
+    MemoryOutputStream out;
+
+    out << "// This is an auto-generated file, which builds one part of a module" << newLine
+        << "// that has been split into several compile units." << newLine
+        << newLine
+        << "#define JUCE_MODULE_COMPILE_UNIT " << unitIndex << newLine
+        << newLine;
+
+    writeIncludeForAllExporters (projectSaver, moduleFileName, wrapper, out);
+    out << newLine;
+
+    projectSaver.replaceFileIfDifferent (wrapper, out);
+    return wrapper;
+}
+
 //==============================================================================
 static void parseAndAddLibs (StringArray& libList, const String& libs)
 {
@@ -373,6 +400,7 @@ void LibraryModule::prepareExporter (ProjectExporter& exporter, ProjectSaver& pr
     else if (exporter.isLinux())
     {
         parseAndAddLibs (exporter.linuxLibs, moduleInfo.moduleInfo ["LinuxLibs"].toString());
+        exporter.makefileModuleFolders.add (exporter.getModuleFolderRelativeToProject (getID(), projectSaver));
     }
     else if (exporter.isCodeBlocks())
     {
@@ -536,13 +564,32 @@ void LibraryModule::findAndAddCompiledCode (ProjectExporter& exporter, ProjectSa
                 const File compiledFile (localModuleFolder.getChildFile (filename));
                 result.add (compiledFile);
 
-                Project::Item item (projectSaver.addFileToGeneratedGroup (compiledFile));
+                // If the module can be divided into several compile units, each of these gets a
+                // small wrapper file, which is built instead of the module's own file.
+                Array<File> filesToBuild;
+                const int numUnits = file ["compileUnits"];
 
-                if (file ["warnings"].toString().equalsIgnoreCase ("disabled"))
-                    item.getShouldInhibitWarningsValue() = true;
+                if (numUnits > 1 && exporter.getProject().shouldSplitModuleCompileUnits().getValue())
+                {
+                    for (int unit = 1; unit <= numUnits; ++unit)
+                        filesToBuild.add (createCompileUnitWrapper (projectSaver, filename, unit));
+                }
+                else
+                {
+                    filesToBuild.add (compiledFile);
+                }
 
-                if (file ["stdcall"])
-                    item.getShouldUseStdCallValue() = true;
+                for (int j = 0; j < filesToBuild.size(); ++j)
+                {
+                    Project::Item item (projectSaver.addFileToGeneratedGroup (filesToBuild.getReference (j)));
+                    item.getIsModuleCodeValue() = true;
+
+                    if (file ["warnings"].toString().equalsIgnoreCase ("disabled"))
+                        item.getShouldInhibitWarningsValue() = true;
+
+                    if (file ["stdcall"])
+                        item.getShouldUseStdCallValue() = true;
+                }
             }
         }
     }
@@ -113,6 +113,8 @@ private:
     void findAndAddCompiledCode (ProjectExporter&, ProjectSaver&, const File& localModuleFolder, Array<File>& result) const;
     void addBrowsableCode (ProjectExporter&, ProjectSaver&, const Array<File>& compiled, const File& localModuleFolder) const;
     void createLocalHeaderWrapper (ProjectSaver&, const File& originalHeader, const File& localHeader) const;
+    File createCompileUnitWrapper (ProjectSaver&, const String& moduleFileName, int unitIndex) const;
+    void writeIncludeForAllExporters (ProjectSaver&, const String& moduleFileName, const File& includingFile, OutputStream&) const;
 
     bool isAUPluginHost (const Project&) const;
     bool isVSTPluginHost (const Project&) const;
@@ -429,6 +429,11 @@ void Project::createPropertyEditors (PropertyListBuilder& props)
     props.add (new BooleanPropertyComponent (shouldIncludeBinaryInAppConfig(), "Include Binary",
                                              "Include BinaryData.h in the AppConfig.h file"));
 
+    props.add (new BooleanPropertyComponent (shouldSplitModuleCompileUnits(), "Module compile units", "Split modules into compile units"),
+               "If enabled, large modules are built as several separate compile units rather than one big file, "
+               "so that they can be compiled in parallel. This speeds up clean builds on machines with many cores, "
+               "but makes the total amount of work slightly greater.");
+
     props.add (new TextPropertyComponent (getProjectPreprocessorDefs(), "Preprocessor definitions", 32768, true),
                "Global preprocessor definitions. Use the form \"NAME1=value NAME2=value\", using whitespace, commas, or "
                "new-lines to separate the items - to include a space or comma in a definition, precede it with a backslash.");
@@ -595,6 +600,9 @@ bool Project::Item::shouldInhibitWarnings() const           { return state [Ids:
 Value Project::Item::getShouldUseStdCallValue()             { return state.getPropertyAsValue (Ids::useStdCall, nullptr); }
 bool Project::Item::shouldUseStdCall() const                { return state [Ids::useStdCall]; }
 
+Value Project::Item::getIsModuleCodeValue()                 { return state.getPropertyAsValue (Ids::moduleCode, nullptr); }
+bool Project::Item::isModuleCode() const                    { return state [Ids::moduleCode]; }
+
 String Project::Item::getFilePath() const
 {
     if (isFile())
@@ -111,6 +111,7 @@ public:
     File getBinaryDataHeaderFile() const                { return getBinaryDataCppFile (0).withFileExtension (".h"); }
     Value getMaxBinaryFileSize()                        { return getProjectValue (Ids::maxBinaryFileSize); }
     Value shouldIncludeBinaryInAppConfig()              { return getProjectValue (Ids::includeBinaryInAppConfig); }
+    Value shouldSplitModuleCompileUnits()               { return getProjectValue (Ids::splitModuleCompileUnits); }
 
     //==============================================================================
     String getAmalgamatedHeaderFileName() const         { return "juce_amalgamated.h"; }
@@ -170,6 +171,8 @@ public:
         bool shouldInhibitWarnings() const;
         Value getShouldUseStdCallValue();
         bool shouldUseStdCall() const;
+        Value getIsModuleCodeValue();
+        bool isModuleCode() const;
 
         //==============================================================================
         bool canContain (const Item& child) const;
@@ -126,6 +126,8 @@ namespace Ids
     DECLARE_ID (focusOrder);
     DECLARE_ID (hidden);
     DECLARE_ID (useStdCall);
+    DECLARE_ID (moduleCode);
+    DECLARE_ID (moduleLibraryCache);
     DECLARE_ID (showAllCode);
     DECLARE_ID (useLocalCopy);
     DECLARE_ID (androidActivityClass);
@@ -150,6 +152,7 @@ namespace Ids
     DECLARE_ID (userNotes);
     DECLARE_ID (maxBinaryFileSize);
     DECLARE_ID (includeBinaryInAppConfig);
+    DECLARE_ID (splitModuleCompileUnits);
     DECLARE_ID (characterSet);
     DECLARE_ID (JUCERPROJECT);
     DECLARE_ID (MAINGROUP);
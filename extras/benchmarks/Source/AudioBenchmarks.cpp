@@ -0,0 +1,366 @@
+/*
+  ==============================================================================
+
+   Benchmarks for the audio buffer, DSP, synthesiser and processor graph classes.
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+
+using namespace BenchmarkSizes;
+
+//==============================================================================
+class AudioBufferBenchmarks  : public BenchmarkTest
+{
+public:
+    AudioBufferBenchmarks()  : BenchmarkTest ("AudioSampleBuffer") {}
+
+    struct Mixer
+    {
+        Mixer()  : dest (numChannels, blockSize)
+        {
+            for (int i = 0; i < numMixSources; ++i)
+            {
+                AudioSampleBuffer* const b = sources.add (new AudioSampleBuffer (numChannels, blockSize));
+                fillWithNoise (*b, i + 1);
+            }
+        }
+
+        void operator()()
+        {
+            dest.clear();
+
+            for (int i = 0; i < sources.size(); ++i)
+                for (int ch = 0; ch < numChannels; ++ch)
+                    dest.addFrom (ch, 0, *sources.getUnchecked (i), ch, 0, blockSize, 0.5f);
+        }
+
+        AudioSampleBuffer dest;
+        OwnedArray<AudioSampleBuffer> sources;
+    };
+
+    struct RampedMix  : public Mixer
+    {
+        void operator()()
+        {
+            dest.clear();
+
+            for (int i = 0; i < sources.size(); ++i)
+                for (int ch = 0; ch < numChannels; ++ch)
+                    dest.addFromWithRamp (ch, 0, sources.getUnchecked (i)->getReadPointer (ch), blockSize, 0.2f, 0.8f);
+        }
+    };
+
+    struct GainAndRMS
+    {
+        GainAndRMS()  : buffer (numChannels, blockSize), gain (0.5f)    { fillWithNoise (buffer); }
+
+        void operator()()
+        {
+            // (alternating the gain keeps the levels steady, so denormals don't creep in)
+            gain = 1.0f / gain;
+            buffer.applyGain (gain);
+            doNotOptimiseAway (buffer.getRMSLevel (0, 0, blockSize));
+        }
+
+        AudioSampleBuffer buffer;
+        float gain;
+    };
+
+    void runBenchmarks() override
+    {
+        Mixer mixer;
+        benchmark ("mix 8 stereo sources, 512 samples", mixer);
+
+        RampedMix rampedMixer;
+        benchmark ("mix 8 stereo sources with gain ramps, 512 samples", rampedMixer);
+
+        GainAndRMS gainAndRMS;
+        benchmark ("apply gain and measure RMS, stereo 512 samples", gainAndRMS);
+    }
+};
+
+static AudioBufferBenchmarks audioBufferBenchmarks;
+
+//==============================================================================
+class DSPBenchmarks  : public BenchmarkTest
+{
+public:
+    DSPBenchmarks()  : BenchmarkTest ("DSP") {}
+
+    struct Filters
+    {
+        Filters()  : buffer (numChannels, blockSize)
+        {
+            fillWithNoise (buffer);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                filters[ch].setCoefficients (IIRCoefficients::makeLowPass (sampleRate, 1000.0));
+        }
+
+        void operator()()
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                filters[ch].processSamples (buffer.getWritePointer (ch), blockSize);
+        }
+
+        AudioSampleBuffer buffer;
+        IIRFilter filters [numChannels];
+    };
+
+    struct StereoReverb
+    {
+        StereoReverb()  : buffer (numChannels, blockSize)
+        {
+            fillWithNoise (buffer);
+            reverb.setSampleRate (sampleRate);
+        }
+
+        void operator()()
+        {
+            reverb.processStereo (buffer.getWritePointer (0), buffer.getWritePointer (1), blockSize);
+        }
+
+        AudioSampleBuffer buffer;
+        Reverb reverb;
+    };
+
+    struct Resampler
+    {
+        Resampler()  : buffer (numChannels, blockSize),
+                       resampler (&tone, false, numChannels)
+        {
+            resampler.setResamplingRatio (48000.0 / sampleRate);
+            resampler.prepareToPlay (blockSize, sampleRate);
+        }
+
+        void operator()()
+        {
+            resampler.getNextAudioBlock (AudioSourceChannelInfo (&buffer, 0, blockSize));
+        }
+
+        AudioSampleBuffer buffer;
+        ToneGeneratorAudioSource tone;
+        ResamplingAudioSource resampler;
+    };
+
+    void runBenchmarks() override
+    {
+        Filters filters;
+        benchmark ("IIRFilter low-pass, stereo 512 samples", filters);
+
+        StereoReverb reverb;
+        benchmark ("Reverb, stereo 512 samples", reverb);
+
+        Resampler resampler;
+        benchmark ("ResamplingAudioSource 44.1k to 48k, stereo 512 samples", resampler);
+    }
+};
+
+static DSPBenchmarks dspBenchmarks;
+
+//==============================================================================
+class SynthesiserBenchmarks  : public BenchmarkTest
+{
+public:
+    SynthesiserBenchmarks()  : BenchmarkTest ("Synthesiser") {}
+
+    struct SineSound  : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    struct SineVoice  : public SynthesiserVoice
+    {
+        SineVoice() : angle (0), angleDelta (0), level (0) {}
+
+        bool canPlaySound (SynthesiserSound*) override      { return true; }
+
+        void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int) override
+        {
+            angle = 0;
+            level = velocity * 0.1;
+            angleDelta = 2.0 * double_Pi * MidiMessage::getMidiNoteInHertz (midiNoteNumber) / getSampleRate();
+        }
+
+        void stopNote (float, bool) override                { clearCurrentNote(); }
+        void pitchWheelMoved (int) override                 {}
+        void controllerMoved (int, int) override            {}
+
+        void renderNextBlock (AudioSampleBuffer& output, int startSample, int numSamples) override
+        {
+            while (--numSamples >= 0)
+            {
+                const float sample = (float) (std::sin (angle) * level);
+
+                for (int ch = output.getNumChannels(); --ch >= 0;)
+                    output.addSample (ch, startSample, sample);
+
+                angle += angleDelta;
+                ++startSample;
+            }
+        }
+
+        double angle, angleDelta, level;
+    };
+
+    struct Synth
+    {
+        Synth()  : buffer (numChannels, blockSize)
+        {
+            for (int i = 0; i < numSynthVoices; ++i)
+                synth.addVoice (new SineVoice());
+
+            synth.addSound (new SineSound());
+            synth.setCurrentPlaybackSampleRate (sampleRate);
+
+            for (int i = 0; i < numSynthVoices; ++i)
+                synth.noteOn (1, 40 + i * 2, 0.8f);
+        }
+
+        void operator()()
+        {
+            buffer.clear();
+            synth.renderNextBlock (buffer, midi, 0, blockSize);
+        }
+
+        AudioSampleBuffer buffer;
+        MidiBuffer midi;
+        Synthesiser synth;
+    };
+
+    void runBenchmarks() override
+    {
+        Synth synth;
+        benchmark ("16 sine voices, stereo 512 samples", synth);
+    }
+};
+
+static SynthesiserBenchmarks synthesiserBenchmarks;
+
+//==============================================================================
+class GraphBenchmarks  : public BenchmarkTest
+{
+public:
+    GraphBenchmarks()  : BenchmarkTest ("AudioProcessorGraph") {}
+
+    /** A minimal processor that just applies a gain, so that the graph's own overhead dominates. */
+    struct GainProcessor  : public AudioProcessor
+    {
+        GainProcessor()     { setPlayConfigDetails (numChannels, numChannels, BenchmarkSizes::sampleRate, BenchmarkSizes::blockSize); }
+
+        const String getName() const override                           { return "Gain"; }
+        void prepareToPlay (double, int) override                       {}
+        void releaseResources() override                                {}
+        void processBlock (AudioSampleBuffer& buffer, MidiBuffer&) override  { buffer.applyGain (0.99f); }
+
+        const String getInputChannelName (int) const override           { return String(); }
+        const String getOutputChannelName (int) const override          { return String(); }
+        bool isInputChannelStereoPair (int) const override              { return true; }
+        bool isOutputChannelStereoPair (int) const override             { return true; }
+        bool silenceInProducesSilenceOut() const override               { return true; }
+        double getTailLengthSeconds() const override                    { return 0; }
+        bool acceptsMidi() const override                               { return false; }
+        bool producesMidi() const override                              { return false; }
+        AudioProcessorEditor* createEditor() override                   { return nullptr; }
+        bool hasEditor() const override                                 { return false; }
+        int getNumPrograms() override                                   { return 1; }
+        int getCurrentProgram() override                                { return 0; }
+        void setCurrentProgram (int) override                           {}
+        const String getProgramName (int) override                      { return String(); }
+        void changeProgramName (int, const String&) override            {}
+        void getStateInformation (juce::MemoryBlock&) override          {}
+        void setStateInformation (const void*, int) override            {}
+    };
+
+    /** Builds a graph of parallel chains of four processors between the input and output. */
+    struct Graph
+    {
+        Graph (int numNodes)  : input (numChannels, blockSize), buffer (numChannels, blockSize)
+        {
+            typedef AudioProcessorGraph::AudioGraphIOProcessor IOProcessor;
+
+            graph.setPlayConfigDetails (numChannels, numChannels, sampleRate, blockSize);
+
+            const uint32 inputId  = graph.addNode (new IOProcessor (IOProcessor::audioInputNode))->nodeId;
+            const uint32 outputId = graph.addNode (new IOProcessor (IOProcessor::audioOutputNode))->nodeId;
+            const int chainLength = 4;
+
+            for (int chain = 0; chain < numNodes / chainLength; ++chain)
+            {
+                uint32 previousId = inputId;
+
+                for (int i = 0; i < chainLength; ++i)
+                {
+                    const uint32 nodeId = graph.addNode (new GainProcessor())->nodeId;
+                    connect (previousId, nodeId);
+                    previousId = nodeId;
+                }
+
+                connect (previousId, outputId);
+            }
+
+            graph.prepareToPlay (sampleRate, blockSize);
+            fillWithNoise (input);
+        }
+
+        ~Graph()
+        {
+            graph.releaseResources();
+        }
+
+        void connect (uint32 source, uint32 dest)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                graph.addConnection (source, ch, dest, ch);
+        }
+
+        AudioProcessorGraph graph;
+        AudioSampleBuffer input, buffer;
+        MidiBuffer midi;
+    };
+
+    struct Render
+    {
+        Render (Graph& g) noexcept : graph (g) {}
+        void operator()()
+        {
+            // (the graph sums all its chains into the output, so it needs fresh input each time)
+            for (int ch = 0; ch < numChannels; ++ch)
+                graph.buffer.copyFrom (ch, 0, graph.input, ch, 0, blockSize);
+
+            graph.graph.processBlock (graph.buffer, graph.midi);
+        }
+
+        Graph& graph;
+    };
+
+    struct Rebuild
+    {
+        Rebuild (Graph& g) noexcept : graph (g) {}
+        void operator()()    { graph.graph.prepareToPlay (sampleRate, blockSize); }
+
+        Graph& graph;
+    };
+
+    void runBenchmarks() override
+    {
+        const int nodeCounts[] = { 16, 64 };
+
+        for (int i = 0; i < numElementsInArray (nodeCounts); ++i)
+        {
+            Graph graph (nodeCounts[i]);
+            const String suffix (", " + String (nodeCounts[i]) + " nodes");
+
+            Render render (graph);
+            benchmark ("render stereo 512 samples" + suffix, render);
+
+            Rebuild rebuild (graph);
+            benchmark ("rebuild" + suffix, rebuild);
+        }
+    }
+};
+
+static GraphBenchmarks graphBenchmarks;
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+   Benchmarks for decoding audio files.
+
+   The test files are encoded in memory when the benchmark starts, apart from the MP3
+   file, which has to be supplied on the command line.
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+
+using namespace BenchmarkSizes;
+
+//==============================================================================
+class AudioFormatBenchmarks  : public BenchmarkTest
+{
+public:
+    AudioFormatBenchmarks()  : BenchmarkTest ("Audio file decoding") {}
+
+    /** Decodes the whole of a file that's held in memory. */
+    struct Decoder
+    {
+        Decoder (AudioFormat& f, const MemoryBlock& data)  : format (f), fileData (data), buffer (numChannels, 4096) {}
+
+        void operator()()
+        {
+            ScopedPointer<AudioFormatReader> reader (format.createReaderFor (new MemoryInputStream (fileData, false), true));
+
+            if (reader != nullptr)
+                for (int64 pos = 0; pos < reader->lengthInSamples; pos += buffer.getNumSamples())
+                    reader->read (&buffer, 0, buffer.getNumSamples(), pos, true, true);
+        }
+
+        AudioFormat& format;
+        const MemoryBlock& fileData;
+        AudioSampleBuffer buffer;
+    };
+
+    static MemoryBlock encode (AudioFormat& format, int bitsPerSample, int qualityOptionIndex)
+    {
+        AudioSampleBuffer source (numChannels, (int) sampleRate * audioFileSeconds);
+        fillWithNoise (source);
+
+        // (pure noise doesn't compress, so mix in a tone to give the encoders something to do)
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* const data = source.getWritePointer (ch);
+
+            for (int i = 0; i < source.getNumSamples(); ++i)
+                data[i] = data[i] * 0.1f + 0.5f * (float) std::sin (i * 0.05);
+        }
+
+        MemoryBlock result;
+        ScopedPointer<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (result, false),
+                                                                         sampleRate, (unsigned int) numChannels,
+                                                                         bitsPerSample, StringPairArray(),
+                                                                         qualityOptionIndex));
+        if (writer != nullptr)
+            writer->writeFromAudioSampleBuffer (source, 0, source.getNumSamples());
+
+        writer = nullptr;
+        return result;
+    }
+
+    void benchmarkFormat (AudioFormat& format, const MemoryBlock& data, const String& description)
+    {
+        if (data.getSize() == 0)
+        {
+            logMessage ("Couldn't create a " + format.getFormatName() + " file to benchmark");
+            return;
+        }
+
+        Decoder decoder (format, data);
+        benchmark ("decode " + description, decoder);
+    }
+
+    void runBenchmarks() override
+    {
+        const String description (String (audioFileSeconds) + " seconds, stereo 44.1kHz");
+
+        WavAudioFormat wav;
+        const MemoryBlock wavData (encode (wav, 16, 0));
+        benchmarkFormat (wav, wavData, "WAV 16-bit, " + description);
+
+       #if JUCE_USE_FLAC
+        FlacAudioFormat flac;
+        const MemoryBlock flacData (encode (flac, 16, 0));
+        benchmarkFormat (flac, flacData, "FLAC 16-bit, " + description);
+       #endif
+
+       #if JUCE_USE_OGGVORBIS
+        OggVorbisAudioFormat ogg;
+        const MemoryBlock oggData (encode (ogg, 16, ogg.getQualityOptions().size() / 2));
+        benchmarkFormat (ogg, oggData, "Ogg Vorbis, " + description);
+       #endif
+
+       #if JUCE_USE_MP3AUDIOFORMAT
+        if (mp3FileToBenchmark.existsAsFile())
+        {
+            MP3AudioFormat mp3;
+            MemoryBlock mp3Data;
+            mp3FileToBenchmark.loadFileAsData (mp3Data);
+            benchmarkFormat (mp3, mp3Data, "MP3 " + mp3FileToBenchmark.getFileName());
+        }
+       #endif
+    }
+};
+
+static AudioFormatBenchmarks audioFormatBenchmarks;
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+   A headless set of benchmarks for JUCE's audio and graphics code.
+
+   All the benchmarks use the same fixed sizes, so that the results from different
+   versions, builds and platforms can be compared directly.
+
+  ==============================================================================
+*/
+
+#ifndef BENCHMARKS_H_INCLUDED
+#define BENCHMARKS_H_INCLUDED
+
+#include "../JuceLibraryCode/JuceHeader.h"
+
+
+//==============================================================================
+namespace BenchmarkSizes
+{
+    const double sampleRate         = 44100.0;
+    const int    blockSize          = 512;
+    const int    numChannels        = 2;
+    const int    numMixSources      = 8;
+    const int    numSynthVoices     = 16;
+    const int    audioFileSeconds   = 10;
+    const int    imageSize          = 1024;
+}
+
+/** A file to benchmark the MP3 decoder with, as there's no MP3 encoder to create one. */
+extern File mp3FileToBenchmark;
+
+/** Fills a buffer with repeatable noise. */
+inline void fillWithNoise (AudioSampleBuffer& buffer, int64 seed = 1234)
+{
+    Random r (seed);
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        float* const data = buffer.getWritePointer (ch);
+
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            data[i] = r.nextFloat() * 2.0f - 1.0f;
+    }
+}
+
+
+#endif   // BENCHMARKS_H_INCLUDED
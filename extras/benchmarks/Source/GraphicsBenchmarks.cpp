@@ -0,0 +1,256 @@
+/*
+  ==============================================================================
+
+   Benchmarks for the software renderer, path stroking and text layout.
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+
+using namespace BenchmarkSizes;
+
+//==============================================================================
+static Path createStarPath (int numPoints)
+{
+    Path p;
+    p.addStar (Point<float> (imageSize * 0.5f, imageSize * 0.5f), numPoints,
+               imageSize * 0.2f, imageSize * 0.45f);
+    return p;
+}
+
+static Path createCurvyPath()
+{
+    Random r (42);
+    Path p;
+    p.startNewSubPath (r.nextFloat() * imageSize, r.nextFloat() * imageSize);
+
+    for (int i = 0; i < 100; ++i)
+        p.cubicTo (r.nextFloat() * imageSize, r.nextFloat() * imageSize,
+                   r.nextFloat() * imageSize, r.nextFloat() * imageSize,
+                   r.nextFloat() * imageSize, r.nextFloat() * imageSize);
+
+    return p;
+}
+
+//==============================================================================
+class RenderingBenchmarks  : public BenchmarkTest
+{
+public:
+    RenderingBenchmarks()  : BenchmarkTest ("Rendering") {}
+
+    struct EdgeTableCreation
+    {
+        EdgeTableCreation()  : path (createCurvyPath()) {}
+
+        void operator()()
+        {
+            const EdgeTable et (Rectangle<int> (imageSize, imageSize), path, AffineTransform::identity);
+            doNotOptimiseAway (et.getMaximumBounds());
+        }
+
+        Path path;
+    };
+
+    struct Renderer
+    {
+        Renderer()  : image (Image::ARGB, imageSize, imageSize, true), g (image) {}
+
+        Image image;
+        Graphics g;
+    };
+
+    struct PathFill  : public Renderer
+    {
+        PathFill()  : path (createStarPath (40))    { g.setColour (Colours::red.withAlpha (0.5f)); }
+        void operator()()                           { g.fillPath (path); }
+
+        Path path;
+    };
+
+    struct GradientPathFill  : public PathFill
+    {
+        GradientPathFill()
+        {
+            g.setGradientFill (ColourGradient (Colours::red, 0, 0, Colours::blue.withAlpha (0.5f),
+                                               (float) imageSize, (float) imageSize, false));
+        }
+    };
+
+    struct RectangleFills  : public Renderer
+    {
+        RectangleFills()    { g.setColour (Colours::green.withAlpha (0.7f)); }
+
+        void operator()()
+        {
+            for (int i = 0; i < 1000; ++i)
+                g.fillRect (Rectangle<float> ((i * 37) % imageSize + 0.5f, (i * 91) % imageSize + 0.5f, 20.0f, 20.0f));
+        }
+    };
+
+    struct ImageDraw  : public Renderer
+    {
+        ImageDraw()  : source (Image::ARGB, imageSize / 2, imageSize / 2, true)
+        {
+            Graphics sg (source);
+            sg.setGradientFill (ColourGradient (Colours::white, 0, 0, Colours::transparentBlack,
+                                                imageSize / 2.0f, imageSize / 2.0f, true));
+            sg.fillAll();
+        }
+
+        void operator()()
+        {
+            g.drawImageTransformed (source, AffineTransform::rotation (0.3f).scaled (1.5f)
+                                                                       .translated (imageSize * 0.5f, 0.0f));
+        }
+
+        Image source;
+    };
+
+    void runBenchmarks() override
+    {
+        EdgeTableCreation edgeTable;
+        benchmark ("create EdgeTable from 100-curve path", edgeTable);
+
+        PathFill pathFill;
+        benchmark ("fill 40-point star, 1024x1024 ARGB", pathFill);
+
+        GradientPathFill gradientFill;
+        benchmark ("gradient-fill 40-point star, 1024x1024 ARGB", gradientFill);
+
+        RectangleFills rectangleFills;
+        benchmark ("fill 1000 translucent 20x20 rectangles", rectangleFills);
+
+        ImageDraw imageDraw;
+        benchmark ("draw rotated and scaled 512x512 image", imageDraw);
+    }
+};
+
+static RenderingBenchmarks renderingBenchmarks;
+
+//==============================================================================
+class PathBenchmarks  : public BenchmarkTest
+{
+public:
+    PathBenchmarks()  : BenchmarkTest ("Path") {}
+
+    struct Stroke
+    {
+        Stroke (const PathStrokeType& t)  : path (createCurvyPath()), type (t) {}
+
+        void operator()()
+        {
+            Path stroked;
+            type.createStrokedPath (stroked, path);
+            doNotOptimiseAway (stroked.getBounds());
+        }
+
+        Path path;
+        PathStrokeType type;
+    };
+
+    struct DashedStroke  : public Stroke
+    {
+        DashedStroke()  : Stroke (PathStrokeType (3.0f)) {}
+
+        void operator()()
+        {
+            const float dashes[] = { 10.0f, 5.0f };
+            Path stroked;
+            type.createDashedStroke (stroked, path, dashes, numElementsInArray (dashes));
+            doNotOptimiseAway (stroked.getBounds());
+        }
+    };
+
+    void runBenchmarks() override
+    {
+        Stroke mitered (PathStrokeType (5.0f, PathStrokeType::mitered, PathStrokeType::butt));
+        benchmark ("stroke 100-curve path, mitered", mitered);
+
+        Stroke curved (PathStrokeType (5.0f, PathStrokeType::curved, PathStrokeType::rounded));
+        benchmark ("stroke 100-curve path, curved with rounded ends", curved);
+
+        DashedStroke dashed;
+        benchmark ("dashed stroke 100-curve path", dashed);
+    }
+};
+
+static PathBenchmarks pathBenchmarks;
+
+//==============================================================================
+class TextBenchmarks  : public BenchmarkTest
+{
+public:
+    TextBenchmarks()  : BenchmarkTest ("Text") {}
+
+    static String getParagraph()
+    {
+        return "The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs! "
+               "How vexingly quick daft zebras jump. Sphinx of black quartz, judge my vow. "
+               "The five boxing wizards jump quickly, and a wizard's job is to vex chumps quickly in fog.";
+    }
+
+    struct Layout
+    {
+        Layout()
+        {
+            text.append (getParagraph(), Font (15.0f), Colours::black);
+            text.append (getParagraph(), Font (20.0f, Font::bold), Colours::darkblue);
+            text.append (getParagraph(), Font (12.0f, Font::italic), Colours::black);
+        }
+
+        void operator()()
+        {
+            TextLayout layout;
+            layout.createLayout (text, 400.0f);
+            doNotOptimiseAway (layout.getHeight());
+        }
+
+        AttributedString text;
+    };
+
+    struct Glyphs
+    {
+        Glyphs()  : paragraph (getParagraph()), font (15.0f) {}
+
+        void operator()()
+        {
+            GlyphArrangement glyphs;
+            glyphs.addJustifiedText (font, paragraph, 0, 0, 400.0f, Justification::left);
+            doNotOptimiseAway (glyphs.getNumGlyphs());
+        }
+
+        String paragraph;
+        Font font;
+    };
+
+    struct DrawText
+    {
+        DrawText()  : image (Image::ARGB, 400, 200, true), g (image), paragraph (getParagraph()) {}
+
+        void operator()()
+        {
+            g.setColour (Colours::black);
+            g.setFont (15.0f);
+            g.drawFittedText (paragraph, 0, 0, 400, 200, Justification::topLeft, 20);
+        }
+
+        Image image;
+        Graphics g;
+        String paragraph;
+    };
+
+    void runBenchmarks() override
+    {
+        Layout layout;
+        benchmark ("TextLayout of 3 paragraphs, 400 pixels wide", layout);
+
+        Glyphs glyphs;
+        benchmark ("GlyphArrangement justified paragraph, 400 pixels wide", glyphs);
+
+        DrawText drawText;
+        benchmark ("draw fitted paragraph into 400x200 image", drawText);
+    }
+};
+
+static TextBenchmarks textBenchmarks;
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+   A command-line app that runs the JUCE benchmarks, and writes the results as
+   JSON or CSV so that they can be compared between builds.
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+
+File mp3FileToBenchmark;
+
+//==============================================================================
+class ConsoleBenchmarkRunner  : public BenchmarkRunner
+{
+public:
+    ConsoleBenchmarkRunner() {}
+
+    void logMessage (const String& message) override
+    {
+        std::cout << message << std::endl;
+    }
+};
+
+static String getOption (const StringArray& args, const String& name)
+{
+    const int index = args.indexOf (name);
+    return index >= 0 ? args [index + 1].unquoted() : String();
+}
+
+static bool writeResults (const File& file, const String& content)
+{
+    if (file.replaceWithText (content))
+        return true;
+
+    std::cout << "Couldn't write to " << file.getFullPathName() << std::endl;
+    return false;
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    StringArray args;
+
+    for (int i = 1; i < argc; ++i)
+        args.add (argv[i]);
+
+    if (args.contains ("--help") || args.contains ("-h"))
+    {
+        std::cout << " Usage: Benchmarks [--filter text] [--quick] [--json file] [--csv file] [--mp3 file]\n\n"
+                     "   --filter text   only runs the benchmarks whose names contain this text\n"
+                     "   --quick         takes fewer, shorter samples, for a rough idea of the timings\n"
+                     "   --json file     writes the results to a JSON file\n"
+                     "   --csv file      writes the results to a CSV file\n"
+                     "   --mp3 file      an MP3 file for the MP3 decoding benchmark (which is only built\n"
+                     "                   when JUCE_USE_MP3AUDIOFORMAT is enabled)\n";
+        return 0;
+    }
+
+    // (the graph and graphics classes need a message manager, but nothing here needs a display)
+    ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const File currentDir (File::getCurrentWorkingDirectory());
+    const String filter (getOption (args, "--filter"));
+
+    if (getOption (args, "--mp3").isNotEmpty())
+        mp3FileToBenchmark = currentDir.getChildFile (getOption (args, "--mp3"));
+
+    Array<BenchmarkTest*> benchmarks;
+
+    for (int i = 0; i < BenchmarkTest::getAllBenchmarks().size(); ++i)
+    {
+        BenchmarkTest* const b = BenchmarkTest::getAllBenchmarks().getUnchecked (i);
+
+        if (filter.isEmpty() || b->getName().containsIgnoreCase (filter))
+            benchmarks.add (b);
+    }
+
+    ConsoleBenchmarkRunner runner;
+
+    if (args.contains ("--quick"))
+        runner.setTimingParameters (20, 2, 10);
+
+    std::cout << SystemStats::getJUCEVersion() << ", "
+              << SystemStats::getOperatingSystemName() << ", "
+              << SystemStats::getCpuVendor() << " " << SystemStats::getNumCpus() << " CPUs, "
+              << SystemStats::getCpuSpeedInMegaherz() << " MHz" << std::endl;
+
+    runner.runBenchmarks (benchmarks);
+
+    bool ok = true;
+
+    if (getOption (args, "--json").isNotEmpty())
+        ok = writeResults (currentDir.getChildFile (getOption (args, "--json")), runner.getResultsAsJSON()) && ok;
+
+    if (getOption (args, "--csv").isNotEmpty())
+        ok = writeResults (currentDir.getChildFile (getOption (args, "--csv")), runner.getResultsAsCSV()) && ok;
+
+    return ok ? 0 : 1;
+}
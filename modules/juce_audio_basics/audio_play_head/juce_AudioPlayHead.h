@@ -32,9 +32,11 @@
     status of a moving play head during audio playback.
 
     One of these can be supplied to an AudioProcessor object so that it can find
-    out about the position of the audio that it is rendering.
+    out about the position of the audio that it is rendering, and an AudioIODevice
+    that is synchronised to an external transport can return one from its
+    getPlayHead() method.
 
-    @see AudioProcessor::setPlayHead, AudioProcessor::getPlayHead
+    @see AudioProcessor::setPlayHead, AudioProcessor::getPlayHead, AudioIODevice::getPlayHead
 */
 class JUCE_API  AudioPlayHead
 {
@@ -120,10 +122,35 @@ public:
         bool isLooping;
 
         //==============================================================================
-        bool operator== (const CurrentPositionInfo& other) const noexcept;
-        bool operator!= (const CurrentPositionInfo& other) const noexcept;
-
-        void resetToDefault();
+        bool operator== (const CurrentPositionInfo& other) const noexcept
+        {
+            return timeInSamples == other.timeInSamples
+                && ppqPosition == other.ppqPosition
+                && editOriginTime == other.editOriginTime
+                && ppqPositionOfLastBarStart == other.ppqPositionOfLastBarStart
+                && frameRate == other.frameRate
+                && isPlaying == other.isPlaying
+                && isRecording == other.isRecording
+                && bpm == other.bpm
+                && timeSigNumerator == other.timeSigNumerator
+                && timeSigDenominator == other.timeSigDenominator
+                && ppqLoopStart == other.ppqLoopStart
+                && ppqLoopEnd == other.ppqLoopEnd
+                && isLooping == other.isLooping;
+        }
+
+        bool operator!= (const CurrentPositionInfo& other) const noexcept
+        {
+            return ! operator== (other);
+        }
+
+        void resetToDefault()
+        {
+            zerostruct (*this);
+            timeSigNumerator = 4;
+            timeSigDenominator = 4;
+            bpm = 120;
+        }
     };
 
     //==============================================================================
@@ -470,6 +470,229 @@ void AudioDataConverters::deinterleaveSamples (const float* const source,
     }
 }
 
+//==============================================================================
+#if JUCE_USE_SSE_INTRINSICS
+namespace AudioDataConversionHelpers
+{
+    // Each of these reads or writes four samples at a time as floats, using whole-vector
+    // loads and stores when the samples are packed, and gathering them when they're
+    // interleaved. The results match those of Pointer::convertSamples(), which reads integer
+    // formats with getAsFloat(), but writes them with setAsInt32 (source.getAsInt32()).
+    template <class SampleFormat>
+    struct ScalarSamples
+    {
+        static forcedinline float load1 (const char* src) noexcept
+        {
+            SampleFormat s (const_cast<char*> (src));
+            return AudioData::NativeEndian::getAsFloat (s);
+        }
+
+        static forcedinline void store1 (char* dest, float value) noexcept
+        {
+            SampleFormat s (dest);
+
+            if (SampleFormat::isFloat)
+            {
+                AudioData::NativeEndian::setAsFloat (s, value);
+            }
+            else
+            {
+                AudioData::Float32 source (&value);
+                AudioData::NativeEndian::setAsInt32 (s, AudioData::NativeEndian::getAsInt32 (source));
+            }
+        }
+    };
+
+    // Does the same as Float32::getAsInt32() for a pair of samples
+    static forcedinline __m128i convertPairToInt32 (__m128d v) noexcept
+    {
+        // (NaNs come out of the max() as the lower limit)
+        v = _mm_min_pd (_mm_max_pd (v, _mm_set1_pd (-1.0)), _mm_set1_pd (1.0));
+        return _mm_cvtpd_epi32 (_mm_mul_pd (v, _mm_set1_pd ((double) 0x7fffffff)));
+    }
+
+    static forcedinline __m128i convertToInt32 (__m128 v) noexcept
+    {
+        return _mm_unpacklo_epi64 (convertPairToInt32 (_mm_cvtps_pd (v)),
+                                   convertPairToInt32 (_mm_cvtps_pd (_mm_movehl_ps (v, v))));
+    }
+
+    struct Int16Samples  : public ScalarSamples<AudioData::Int16>
+    {
+        static forcedinline __m128 load4 (const char* src, const int stride) noexcept
+        {
+            const __m128i v = stride == 2 ? _mm_loadl_epi64 ((const __m128i*) src)
+                                          : _mm_setr_epi16 (*(const int16*) src,                *(const int16*) (src + stride),
+                                                            *(const int16*) (src + stride * 2), *(const int16*) (src + stride * 3),
+                                                            0, 0, 0, 0);
+
+            return _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (_mm_unpacklo_epi16 (v, v), 16)),
+                               _mm_set1_ps (1.0f / 0x8000));
+        }
+
+        static forcedinline void store4 (char* dest, const int stride, __m128 v) noexcept
+        {
+            const __m128i i = _mm_srai_epi32 (convertToInt32 (v), 16);
+            const __m128i packed = _mm_packs_epi32 (i, i);
+
+            if (stride == 2)
+            {
+                _mm_storel_epi64 ((__m128i*) dest, packed);
+            }
+            else
+            {
+                *(uint16*) dest                = (uint16) _mm_extract_epi16 (packed, 0);
+                *(uint16*) (dest + stride)     = (uint16) _mm_extract_epi16 (packed, 1);
+                *(uint16*) (dest + stride * 2) = (uint16) _mm_extract_epi16 (packed, 2);
+                *(uint16*) (dest + stride * 3) = (uint16) _mm_extract_epi16 (packed, 3);
+            }
+        }
+    };
+
+    struct Int24Samples  : public ScalarSamples<AudioData::Int24>
+    {
+        // This reads 32 bits for each sample and sign-extends the bottom 24 of them, so it
+        // touches one byte beyond the last sample.
+        static forcedinline __m128 load4 (const char* src, const int stride) noexcept
+        {
+            const __m128i v = _mm_setr_epi32 (*(const int32*) src,                *(const int32*) (src + stride),
+                                              *(const int32*) (src + stride * 2), *(const int32*) (src + stride * 3));
+
+            return _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (_mm_slli_epi32 (v, 8), 8)),
+                               _mm_set1_ps (1.0f / 0x800000));
+        }
+
+        static forcedinline void store4 (char* dest, const int stride, __m128 v) noexcept
+        {
+            int32 values[4];
+            _mm_storeu_si128 ((__m128i*) values, _mm_srai_epi32 (convertToInt32 (v), 8));
+
+            for (int i = 0; i < 4; ++i)
+                ByteOrder::littleEndian24BitToChars (values[i], dest + stride * i);
+        }
+    };
+
+    struct Int32Samples  : public ScalarSamples<AudioData::Int32>
+    {
+        static forcedinline __m128 load4 (const char* src, const int stride) noexcept
+        {
+            const __m128i v = stride == 4 ? _mm_loadu_si128 ((const __m128i*) src)
+                                          : _mm_setr_epi32 (*(const int32*) src,                *(const int32*) (src + stride),
+                                                            *(const int32*) (src + stride * 2), *(const int32*) (src + stride * 3));
+
+            return _mm_mul_ps (_mm_cvtepi32_ps (v), _mm_set1_ps (1.0f / 0x80000000u));
+        }
+
+        static forcedinline void store4 (char* dest, const int stride, __m128 v) noexcept
+        {
+            const __m128i i = convertToInt32 (v);
+
+            if (stride == 4)
+            {
+                _mm_storeu_si128 ((__m128i*) dest, i);
+            }
+            else
+            {
+                int32 values[4];
+                _mm_storeu_si128 ((__m128i*) values, i);
+
+                for (int n = 0; n < 4; ++n)
+                    *(int32*) (dest + stride * n) = values[n];
+            }
+        }
+    };
+
+    struct Float32Samples  : public ScalarSamples<AudioData::Float32>
+    {
+        static forcedinline __m128 load4 (const char* src, const int stride) noexcept
+        {
+            return stride == 4 ? _mm_loadu_ps ((const float*) src)
+                               : _mm_setr_ps (*(const float*) src,                *(const float*) (src + stride),
+                                              *(const float*) (src + stride * 2), *(const float*) (src + stride * 3));
+        }
+
+        static forcedinline void store4 (char* dest, const int stride, __m128 v) noexcept
+        {
+            if (stride == 4)
+            {
+                _mm_storeu_ps ((float*) dest, v);
+            }
+            else
+            {
+                float values[4];
+                _mm_storeu_ps (values, v);
+
+                for (int n = 0; n < 4; ++n)
+                    *(float*) (dest + stride * n) = values[n];
+            }
+        }
+    };
+
+    template <class DestType, class SourceType>
+    static void convertBlock (char* dest, const int destStride, const char* src, const int srcStride, int num) noexcept
+    {
+        // (the last sample is always done on its own, because the 24-bit loads read past it)
+        for (; num > 4; num -= 4)
+        {
+            DestType::store4 (dest, destStride, SourceType::load4 (src, srcStride));
+            dest += destStride * 4;
+            src  += srcStride * 4;
+        }
+
+        while (--num >= 0)
+        {
+            DestType::store1 (dest, SourceType::load1 (src));
+            dest += destStride;
+            src  += srcStride;
+        }
+    }
+
+    template <class DestType>
+    static bool convertFrom (AudioData::BlockConverter::Format sourceFormat, char* dest, int destStride,
+                             const char* src, int srcStride, int num) noexcept
+    {
+        switch (sourceFormat)
+        {
+            case AudioData::BlockConverter::int16:    convertBlock<DestType, Int16Samples>   (dest, destStride, src, srcStride, num); return true;
+            case AudioData::BlockConverter::int24:    convertBlock<DestType, Int24Samples>   (dest, destStride, src, srcStride, num); return true;
+            case AudioData::BlockConverter::int32:    convertBlock<DestType, Int32Samples>   (dest, destStride, src, srcStride, num); return true;
+            case AudioData::BlockConverter::float32:  convertBlock<DestType, Float32Samples> (dest, destStride, src, srcStride, num); return true;
+            default:                                  return false;
+        }
+    }
+}
+#endif
+
+bool AudioData::BlockConverter::convert (Format destFormat, void* dest, int destStride,
+                                         Format sourceFormat, const void* source, int sourceStride, int numSamples) noexcept
+{
+   #if JUCE_USE_SSE_INTRINSICS
+    using namespace AudioDataConversionHelpers;
+
+    char* const d = static_cast<char*> (dest);
+    const char* const s = static_cast<const char*> (source);
+
+    // Only conversions to or from float are done here - integer-to-integer ones are rare
+    if (destFormat == float32)
+        return convertFrom<Float32Samples> (sourceFormat, d, destStride, s, sourceStride, numSamples);
+
+    if (sourceFormat == float32)
+    {
+        switch (destFormat)
+        {
+            case int16:  convertBlock<Int16Samples, Float32Samples> (d, destStride, s, sourceStride, numSamples); return true;
+            case int24:  convertBlock<Int24Samples, Float32Samples> (d, destStride, s, sourceStride, numSamples); return true;
+            case int32:  convertBlock<Int32Samples, Float32Samples> (d, destStride, s, sourceStride, numSamples); return true;
+            default:     break;
+        }
+    }
+   #else
+    ignoreUnused (destFormat, dest, destStride, sourceFormat, source, sourceStride, numSamples);
+   #endif
+
+    return false;
+}
+
 
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -321,6 +321,49 @@ public:
         static inline void* toVoidPtr (VoidType* v) noexcept { return const_cast <void*> (v); }
         enum { isConst = 1 };
     };
+
+    //==============================================================================
+    /** Used by Pointer::convertSamples() to hand the common conversions between float and
+        the packed integer formats over to vectorised routines. Only data in the CPU's native
+        byte order is handled - anything else is left to the sample-by-sample code.
+    */
+    struct JUCE_API  BlockConverter
+    {
+        enum Format { unsupported = 0, int16, int24, int32, float32 };
+
+        template <class PointerType>
+        static Format getFormat() noexcept
+        {
+            if (PointerType::isBigEndian() != (bool) NativeEndian::isBigEndian)
+                return unsupported;
+
+            if (PointerType::isFloatingPoint())
+                return float32;
+
+            switch (PointerType::getBytesPerSample())
+            {
+                case 2:  return int16;
+                case 3:  return int24;
+                case 4:  return PointerType::get32BitResolution() == 1 ? int32 : unsupported;
+                default: return unsupported;
+            }
+        }
+
+        /** Returns false if there's no fast routine for this pair of formats. The strides are in bytes. */
+        static bool convert (Format destFormat, void* dest, int destStride,
+                             Format sourceFormat, const void* source, int sourceStride, int numSamples) noexcept;
+
+        template <class DestPointerType, class SourcePointerType>
+        static bool convert (const DestPointerType& dest, const SourcePointerType& source, int numSamples) noexcept
+        {
+            const Format destFormat = getFormat<DestPointerType>();
+            const Format sourceFormat = getFormat<SourcePointerType>();
+
+            return destFormat != unsupported && sourceFormat != unsupported
+                     && convert (destFormat, const_cast<void*> (dest.getRawData()), dest.getNumBytesBetweenSamples(),
+                                 sourceFormat, source.getRawData(), source.getNumBytesBetweenSamples(), numSamples);
+        }
+    };
   #endif
 
     //==============================================================================
@@ -462,6 +505,9 @@ public:
 
             if (source.getRawData() != getRawData() || source.getNumBytesBetweenSamples() >= getNumBytesBetweenSamples())
             {
+                if (BlockConverter::convert (dest, source, numSamples))
+                    return;
+
                 while (--numSamples >= 0)
                 {
                     Endianness::copyFrom (dest.data, source);
@@ -22,15 +22,17 @@
   ==============================================================================
 */
 
-AudioSampleBuffer::AudioSampleBuffer() noexcept
-  : numChannels (0), size (0), allocatedBytes (0),
-    channels (static_cast<float**> (preallocatedChannelSpace)),
+template <typename Type>
+AudioBuffer<Type>::AudioBuffer() noexcept
+  : numChannels (0), size (0), channelStride (0), allocatedBytes (0),
+    channels (static_cast<Type**> (preallocatedChannelSpace)),
     isClear (false)
 {
 }
 
-AudioSampleBuffer::AudioSampleBuffer (const int numChans,
-                                      const int numSamples) noexcept
+template <typename Type>
+AudioBuffer<Type>::AudioBuffer (const int numChans,
+                                const int numSamples) noexcept
   : numChannels (numChans),
     size (numSamples)
 {
@@ -40,7 +42,8 @@ AudioSampleBuffer::AudioSampleBuffer (const int numChans,
     allocateData();
 }
 
-AudioSampleBuffer::AudioSampleBuffer (const AudioSampleBuffer& other) noexcept
+template <typename Type>
+AudioBuffer<Type>::AudioBuffer (const AudioBuffer& other) noexcept
   : numChannels (other.numChannels),
     size (other.size),
     allocatedBytes (other.allocatedBytes)
@@ -65,27 +68,31 @@ AudioSampleBuffer::AudioSampleBuffer (const AudioSampleBuffer& other) noexcept
     }
 }
 
-void AudioSampleBuffer::allocateData()
+template <typename Type>
+void AudioBuffer<Type>::allocateData()
 {
-    const size_t channelListSize = sizeof (float*) * (size_t) (numChannels + 1);
-    allocatedBytes = (size_t) numChannels * (size_t) size * sizeof (float) + channelListSize + 32;
+    // (the channels are kept in a single block, each starting on a 16-byte boundary)
+    const size_t channelListSize = ((sizeof (Type*) * (size_t) (numChannels + 1)) + 15) & ~15u;
+    channelStride = (size + 3) & ~3;
+    allocatedBytes = (size_t) numChannels * (size_t) channelStride * sizeof (Type) + channelListSize + 32;
     allocatedData.malloc (allocatedBytes);
-    channels = reinterpret_cast<float**> (allocatedData.getData());
+    channels = reinterpret_cast<Type**> (allocatedData.getData());
 
-    float* chan = (float*) (allocatedData + channelListSize);
+    Type* chan = (Type*) (allocatedData + channelListSize);
     for (int i = 0; i < numChannels; ++i)
     {
         channels[i] = chan;
-        chan += size;
+        chan += channelStride;
     }
 
     channels [numChannels] = nullptr;
     isClear = false;
 }
 
-AudioSampleBuffer::AudioSampleBuffer (float* const* dataToReferTo,
-                                      const int numChans,
-                                      const int numSamples) noexcept
+template <typename Type>
+AudioBuffer<Type>::AudioBuffer (Type* const* dataToReferTo,
+                                const int numChans,
+                                const int numSamples) noexcept
     : numChannels (numChans),
       size (numSamples),
       allocatedBytes (0)
@@ -95,10 +102,11 @@ AudioSampleBuffer::AudioSampleBuffer (float* const* dataToReferTo,
     allocateChannels (dataToReferTo, 0);
 }
 
-AudioSampleBuffer::AudioSampleBuffer (float* const* dataToReferTo,
-                                      const int numChans,
-                                      const int startSample,
-                                      const int numSamples) noexcept
+template <typename Type>
+AudioBuffer<Type>::AudioBuffer (Type* const* dataToReferTo,
+                                const int numChans,
+                                const int startSample,
+                                const int numSamples) noexcept
     : numChannels (numChans),
       size (numSamples),
       allocatedBytes (0),
@@ -109,7 +117,8 @@ AudioSampleBuffer::AudioSampleBuffer (float* const* dataToReferTo,
     allocateChannels (dataToReferTo, startSample);
 }
 
-void AudioSampleBuffer::setDataToReferTo (float** dataToReferTo,
+template <typename Type>
+void AudioBuffer<Type>::setDataToReferTo (Type** dataToReferTo,
                                           const int newNumChannels,
                                           const int newNumSamples) noexcept
 {
@@ -129,21 +138,24 @@ void AudioSampleBuffer::setDataToReferTo (float** dataToReferTo,
     jassert (! isClear);
 }
 
-void AudioSampleBuffer::allocateChannels (float* const* const dataToReferTo, int offset)
+template <typename Type>
+void AudioBuffer<Type>::allocateChannels (Type* const* const dataToReferTo, int offset)
 {
     jassert (offset >= 0);
 
     // (try to avoid doing a malloc here, as that'll blow up things like Pro-Tools)
     if (numChannels < (int) numElementsInArray (preallocatedChannelSpace))
     {
-        channels = static_cast<float**> (preallocatedChannelSpace);
+        channels = static_cast<Type**> (preallocatedChannelSpace);
     }
     else
     {
-        allocatedData.malloc ((size_t) numChannels + 1, sizeof (float*));
-        channels = reinterpret_cast<float**> (allocatedData.getData());
+        allocatedData.malloc ((size_t) numChannels + 1, sizeof (Type*));
+        channels = reinterpret_cast<Type**> (allocatedData.getData());
     }
 
+    channelStride = 0;
+
     for (int i = 0; i < numChannels; ++i)
     {
         // you have to pass in the same number of valid pointers as numChannels
@@ -156,33 +168,29 @@ void AudioSampleBuffer::allocateChannels (float* const* const dataToReferTo, int
     isClear = false;
 }
 
-AudioSampleBuffer& AudioSampleBuffer::operator= (const AudioSampleBuffer& other) noexcept
+template <typename Type>
+AudioBuffer<Type>& AudioBuffer<Type>::operator= (const AudioBuffer& other) noexcept
 {
     if (this != &other)
     {
         setSize (other.getNumChannels(), other.getNumSamples(), false, false, false);
 
         if (other.isClear)
-        {
             clear();
-        }
         else
-        {
-            isClear = false;
-
-            for (int i = 0; i < numChannels; ++i)
-                FloatVectorOperations::copy (channels[i], other.channels[i], size);
-        }
+            copyFromAllChannels (0, other, 0, size);
     }
 
     return *this;
 }
 
-AudioSampleBuffer::~AudioSampleBuffer() noexcept
+template <typename Type>
+AudioBuffer<Type>::~AudioBuffer() noexcept
 {
 }
 
-void AudioSampleBuffer::setSize (const int newNumChannels,
+template <typename Type>
+void AudioBuffer<Type>::setSize (const int newNumChannels,
                                  const int newNumSamples,
                                  const bool keepExistingContent,
                                  const bool clearExtraSpace,
@@ -194,8 +202,8 @@ void AudioSampleBuffer::setSize (const int newNumChannels,
     if (newNumSamples != size || newNumChannels != numChannels)
     {
         const size_t allocatedSamplesPerChannel = ((size_t) newNumSamples + 3) & ~3u;
-        const size_t channelListSize = ((sizeof (float*) * (size_t) (newNumChannels + 1)) + 15) & ~15u;
-        const size_t newTotalBytes = ((size_t) newNumChannels * (size_t) allocatedSamplesPerChannel * sizeof (float))
+        const size_t channelListSize = ((sizeof (Type*) * (size_t) (newNumChannels + 1)) + 15) & ~15u;
+        const size_t newTotalBytes = ((size_t) newNumChannels * (size_t) allocatedSamplesPerChannel * sizeof (Type))
                                         + channelListSize + 32;
 
         if (keepExistingContent)
@@ -205,8 +213,8 @@ void AudioSampleBuffer::setSize (const int newNumChannels,
 
             const size_t numSamplesToCopy = (size_t) jmin (newNumSamples, size);
 
-            float** const newChannels = reinterpret_cast<float**> (newData.getData());
-            float* newChan = reinterpret_cast<float*> (newData + channelListSize);
+            Type** const newChannels = reinterpret_cast<Type**> (newData.getData());
+            Type* newChan = reinterpret_cast<Type*> (newData + channelListSize);
 
             for (int j = 0; j < newNumChannels; ++j)
             {
@@ -224,6 +232,7 @@ void AudioSampleBuffer::setSize (const int newNumChannels,
             allocatedData.swapWith (newData);
             allocatedBytes = newTotalBytes;
             channels = newChannels;
+            channelStride = (int) allocatedSamplesPerChannel;
         }
         else
         {
@@ -236,15 +245,17 @@ void AudioSampleBuffer::setSize (const int newNumChannels,
             {
                 allocatedBytes = newTotalBytes;
                 allocatedData.allocate (newTotalBytes, clearExtraSpace || isClear);
-                channels = reinterpret_cast<float**> (allocatedData.getData());
+                channels = reinterpret_cast<Type**> (allocatedData.getData());
             }
 
-            float* chan = reinterpret_cast<float*> (allocatedData + channelListSize);
+            Type* chan = reinterpret_cast<Type*> (allocatedData + channelListSize);
             for (int i = 0; i < newNumChannels; ++i)
             {
                 channels[i] = chan;
                 chan += allocatedSamplesPerChannel;
             }
+
+            channelStride = (int) allocatedSamplesPerChannel;
         }
 
         channels [newNumChannels] = 0;
@@ -253,18 +264,20 @@ void AudioSampleBuffer::setSize (const int newNumChannels,
     }
 }
 
-void AudioSampleBuffer::clear() noexcept
+template <typename Type>
+bool AudioBuffer<Type>::isWholeContiguousBlock (const int startSample, const int numSamples) const noexcept
 {
-    if (! isClear)
-    {
-        for (int i = 0; i < numChannels; ++i)
-            FloatVectorOperations::clear (channels[i], size);
+    return channelStride > 0 && startSample == 0 && numSamples == size;
+}
 
-        isClear = true;
-    }
+template <typename Type>
+void AudioBuffer<Type>::clear() noexcept
+{
+    clear (0, size);
 }
 
-void AudioSampleBuffer::clear (const int startSample,
+template <typename Type>
+void AudioBuffer<Type>::clear (const int startSample,
                                const int numSamples) noexcept
 {
     jassert (startSample >= 0 && startSample + numSamples <= size);
@@ -274,12 +287,20 @@ void AudioSampleBuffer::clear (const int startSample,
         if (startSample == 0 && numSamples == size)
             isClear = true;
 
-        for (int i = 0; i < numChannels; ++i)
-            FloatVectorOperations::clear (channels[i] + startSample, numSamples);
+        if (isWholeContiguousBlock (startSample, numSamples))
+        {
+            FloatVectorOperations::clear (channels[0], numChannels * channelStride);
+        }
+        else
+        {
+            for (int i = 0; i < numChannels; ++i)
+                FloatVectorOperations::clear (channels[i] + startSample, numSamples);
+        }
     }
 }
 
-void AudioSampleBuffer::clear (const int channel,
+template <typename Type>
+void AudioBuffer<Type>::clear (const int channel,
                                const int startSample,
                                const int numSamples) noexcept
 {
@@ -290,14 +311,16 @@ void AudioSampleBuffer::clear (const int channel,
         FloatVectorOperations::clear (channels [channel] + startSample, numSamples);
 }
 
-float AudioSampleBuffer::getSample (int channel, int index) const noexcept
+template <typename Type>
+Type AudioBuffer<Type>::getSample (int channel, int index) const noexcept
 {
     jassert (isPositiveAndBelow (channel, numChannels));
     jassert (isPositiveAndBelow (index, size));
     return *(channels [channel] + index);
 }
 
-void AudioSampleBuffer::setSample (int channel, int index, float newValue) noexcept
+template <typename Type>
+void AudioBuffer<Type>::setSample (int channel, int index, Type newValue) noexcept
 {
     jassert (isPositiveAndBelow (channel, numChannels));
     jassert (isPositiveAndBelow (index, size));
@@ -305,7 +328,8 @@ void AudioSampleBuffer::setSample (int channel, int index, float newValue) noexc
     isClear = false;
 }
 
-void AudioSampleBuffer::addSample (int channel, int index, float valueToAdd) noexcept
+template <typename Type>
+void AudioBuffer<Type>::addSample (int channel, int index, Type valueToAdd) noexcept
 {
     jassert (isPositiveAndBelow (channel, numChannels));
     jassert (isPositiveAndBelow (index, size));
@@ -313,30 +337,32 @@ void AudioSampleBuffer::addSample (int channel, int index, float valueToAdd) noe
     isClear = false;
 }
 
-void AudioSampleBuffer::applyGain (const int channel,
+template <typename Type>
+void AudioBuffer<Type>::applyGain (const int channel,
                                    const int startSample,
                                    int numSamples,
-                                   const float gain) noexcept
+                                   const Type gain) noexcept
 {
     jassert (isPositiveAndBelow (channel, numChannels));
     jassert (startSample >= 0 && startSample + numSamples <= size);
 
-    if (gain != 1.0f && ! isClear)
+    if (gain != (Type) 1 && ! isClear)
     {
-        float* const d = channels [channel] + startSample;
+        Type* const d = channels [channel] + startSample;
 
-        if (gain == 0.0f)
+        if (gain == (Type) 0)
             FloatVectorOperations::clear (d, numSamples);
         else
             FloatVectorOperations::multiply (d, gain, numSamples);
     }
 }
 
-void AudioSampleBuffer::applyGainRamp (const int channel,
+template <typename Type>
+void AudioBuffer<Type>::applyGainRamp (const int channel,
                                        const int startSample,
                                        int numSamples,
-                                       float startGain,
-                                       float endGain) noexcept
+                                       Type startGain,
+                                       Type endGain) noexcept
 {
     if (! isClear)
     {
@@ -349,8 +375,8 @@ void AudioSampleBuffer::applyGainRamp (const int channel,
             jassert (isPositiveAndBelow (channel, numChannels));
             jassert (startSample >= 0 && startSample + numSamples <= size);
 
-            const float increment = (endGain - startGain) / numSamples;
-            float* d = channels [channel] + startSample;
+            const Type increment = (endGain - startGain) / numSamples;
+            Type* d = channels [channel] + startSample;
 
             while (--numSamples >= 0)
             {
@@ -361,31 +387,78 @@ void AudioSampleBuffer::applyGainRamp (const int channel,
     }
 }
 
-void AudioSampleBuffer::applyGain (int startSample, int numSamples, float gain) noexcept
+template <typename Type>
+void AudioBuffer<Type>::applyGain (int startSample, int numSamples, Type gain) noexcept
 {
-    for (int i = 0; i < numChannels; ++i)
-        applyGain (i, startSample, numSamples, gain);
+    jassert (startSample >= 0 && startSample + numSamples <= size);
+
+    if (gain != (Type) 1 && ! isClear)
+    {
+        if (gain == (Type) 0)
+        {
+            clear (startSample, numSamples);
+        }
+        else if (isWholeContiguousBlock (startSample, numSamples))
+        {
+            FloatVectorOperations::multiply (channels[0], gain, numChannels * channelStride);
+        }
+        else
+        {
+            for (int i = 0; i < numChannels; ++i)
+                FloatVectorOperations::multiply (channels[i] + startSample, gain, numSamples);
+        }
+    }
 }
 
-void AudioSampleBuffer::applyGain (const float gain) noexcept
+template <typename Type>
+void AudioBuffer<Type>::applyGain (const Type gain) noexcept
 {
     applyGain (0, size, gain);
 }
 
-void AudioSampleBuffer::applyGainRamp (int startSample, int numSamples,
-                                       float startGain, float endGain) noexcept
+template <typename Type>
+void AudioBuffer<Type>::applyGainRamp (int startSample, int numSamples,
+                                       Type startGain, Type endGain) noexcept
 {
-    for (int i = 0; i < numChannels; ++i)
-        applyGainRamp (i, startSample, numSamples, startGain, endGain);
+    if (! isClear)
+    {
+        if (startGain == endGain)
+        {
+            applyGain (startSample, numSamples, startGain);
+        }
+        else
+        {
+            jassert (startSample >= 0 && startSample + numSamples <= size);
+
+            // The ramp is worked out once for each block of samples, and then applied
+            // to every channel as a vectorised multiply.
+            const Type increment = (endGain - startGain) / numSamples;
+            Type ramp [256];
+
+            for (int done = 0; done < numSamples;)
+            {
+                const int num = jmin ((int) numElementsInArray (ramp), numSamples - done);
+
+                for (int j = 0; j < num; ++j)
+                    ramp[j] = startGain + increment * (Type) (done + j);
+
+                for (int i = 0; i < numChannels; ++i)
+                    FloatVectorOperations::multiply (channels[i] + startSample + done, ramp, num);
+
+                done += num;
+            }
+        }
+    }
 }
 
-void AudioSampleBuffer::addFrom (const int destChannel,
+template <typename Type>
+void AudioBuffer<Type>::addFrom (const int destChannel,
                                  const int destStartSample,
-                                 const AudioSampleBuffer& source,
+                                 const AudioBuffer& source,
                                  const int sourceChannel,
                                  const int sourceStartSample,
                                  int numSamples,
-                                 const float gain) noexcept
+                                 const Type gain) noexcept
 {
     jassert (&source != this || sourceChannel != destChannel);
     jassert (isPositiveAndBelow (destChannel, numChannels));
@@ -393,23 +466,23 @@ void AudioSampleBuffer::addFrom (const int destChannel,
     jassert (isPositiveAndBelow (sourceChannel, source.numChannels));
     jassert (sourceStartSample >= 0 && sourceStartSample + numSamples <= source.size);
 
-    if (gain != 0.0f && numSamples > 0 && ! source.isClear)
+    if (gain != (Type) 0 && numSamples > 0 && ! source.isClear)
     {
-        float* const d = channels [destChannel] + destStartSample;
-        const float* const s  = source.channels [sourceChannel] + sourceStartSample;
+        Type* const d = channels [destChannel] + destStartSample;
+        const Type* const s  = source.channels [sourceChannel] + sourceStartSample;
 
         if (isClear)
         {
             isClear = false;
 
-            if (gain != 1.0f)
+            if (gain != (Type) 1)
                 FloatVectorOperations::copyWithMultiply (d, s, gain, numSamples);
             else
                 FloatVectorOperations::copy (d, s, numSamples);
         }
         else
         {
-            if (gain != 1.0f)
+            if (gain != (Type) 1)
                 FloatVectorOperations::addWithMultiply (d, s, gain, numSamples);
             else
                 FloatVectorOperations::add (d, s, numSamples);
@@ -417,32 +490,92 @@ void AudioSampleBuffer::addFrom (const int destChannel,
     }
 }
 
-void AudioSampleBuffer::addFrom (const int destChannel,
+template <typename Type>
+void AudioBuffer<Type>::addFromAllChannels (const int destStartSample,
+                                            const AudioBuffer& source,
+                                            const int sourceStartSample,
+                                            const int numSamples,
+                                            const Type gain) noexcept
+{
+    jassert (&source != this);
+    jassert (destStartSample >= 0 && destStartSample + numSamples <= size);
+    jassert (sourceStartSample >= 0 && sourceStartSample + numSamples <= source.size);
+
+    const int numChans = jmin (numChannels, source.numChannels);
+
+    if (gain == (Type) 0 || numSamples <= 0 || numChans == 0 || source.isClear)
+        return;
+
+    const bool wasClear = isClear;
+    isClear = false;
+
+    if (numChannels == source.numChannels && channelStride == source.channelStride
+         && isWholeContiguousBlock (destStartSample, numSamples)
+         && source.isWholeContiguousBlock (sourceStartSample, numSamples))
+    {
+        Type* const d = channels[0];
+        const Type* const s = source.channels[0];
+        const int num = numChannels * channelStride;
+
+        if (wasClear)
+        {
+            if (gain != (Type) 1)   FloatVectorOperations::copyWithMultiply (d, s, gain, num);
+            else                FloatVectorOperations::copy (d, s, num);
+        }
+        else
+        {
+            if (gain != (Type) 1)   FloatVectorOperations::addWithMultiply (d, s, gain, num);
+            else                FloatVectorOperations::add (d, s, num);
+        }
+
+        return;
+    }
+
+    for (int i = 0; i < numChans; ++i)
+    {
+        Type* const d = channels[i] + destStartSample;
+        const Type* const s = source.channels[i] + sourceStartSample;
+
+        if (wasClear)
+        {
+            if (gain != (Type) 1)   FloatVectorOperations::copyWithMultiply (d, s, gain, numSamples);
+            else                FloatVectorOperations::copy (d, s, numSamples);
+        }
+        else
+        {
+            if (gain != (Type) 1)   FloatVectorOperations::addWithMultiply (d, s, gain, numSamples);
+            else                FloatVectorOperations::add (d, s, numSamples);
+        }
+    }
+}
+
+template <typename Type>
+void AudioBuffer<Type>::addFrom (const int destChannel,
                                  const int destStartSample,
-                                 const float* source,
+                                 const Type* source,
                                  int numSamples,
-                                 const float gain) noexcept
+                                 const Type gain) noexcept
 {
     jassert (isPositiveAndBelow (destChannel, numChannels));
     jassert (destStartSample >= 0 && destStartSample + numSamples <= size);
     jassert (source != nullptr);
 
-    if (gain != 0.0f && numSamples > 0)
+    if (gain != (Type) 0 && numSamples > 0)
     {
-        float* const d = channels [destChannel] + destStartSample;
+        Type* const d = channels [destChannel] + destStartSample;
 
         if (isClear)
         {
             isClear = false;
 
-            if (gain != 1.0f)
+            if (gain != (Type) 1)
                 FloatVectorOperations::copyWithMultiply (d, source, gain, numSamples);
             else
                 FloatVectorOperations::copy (d, source, numSamples);
         }
         else
         {
-            if (gain != 1.0f)
+            if (gain != (Type) 1)
                 FloatVectorOperations::addWithMultiply (d, source, gain, numSamples);
             else
                 FloatVectorOperations::add (d, source, numSamples);
@@ -450,12 +583,13 @@ void AudioSampleBuffer::addFrom (const int destChannel,
     }
 }
 
-void AudioSampleBuffer::addFromWithRamp (const int destChannel,
+template <typename Type>
+void AudioBuffer<Type>::addFromWithRamp (const int destChannel,
                                          const int destStartSample,
-                                         const float* source,
+                                         const Type* source,
                                          int numSamples,
-                                         float startGain,
-                                         const float endGain) noexcept
+                                         Type startGain,
+                                         const Type endGain) noexcept
 {
     jassert (isPositiveAndBelow (destChannel, numChannels));
     jassert (destStartSample >= 0 && destStartSample + numSamples <= size);
@@ -467,11 +601,11 @@ void AudioSampleBuffer::addFromWithRamp (const int destChannel,
     }
     else
     {
-        if (numSamples > 0 && (startGain != 0.0f || endGain != 0.0f))
+        if (numSamples > 0 && (startGain != (Type) 0 || endGain != (Type) 0))
         {
             isClear = false;
-            const float increment = (endGain - startGain) / numSamples;
-            float* d = channels [destChannel] + destStartSample;
+            const Type increment = (endGain - startGain) / numSamples;
+            Type* d = channels [destChannel] + destStartSample;
 
             while (--numSamples >= 0)
             {
@@ -482,9 +616,10 @@ void AudioSampleBuffer::addFromWithRamp (const int destChannel,
     }
 }
 
-void AudioSampleBuffer::copyFrom (const int destChannel,
+template <typename Type>
+void AudioBuffer<Type>::copyFrom (const int destChannel,
                                   const int destStartSample,
-                                  const AudioSampleBuffer& source,
+                                  const AudioBuffer& source,
                                   const int sourceChannel,
                                   const int sourceStartSample,
                                   int numSamples) noexcept
@@ -512,9 +647,50 @@ void AudioSampleBuffer::copyFrom (const int destChannel,
     }
 }
 
-void AudioSampleBuffer::copyFrom (const int destChannel,
+template <typename Type>
+void AudioBuffer<Type>::copyFromAllChannels (const int destStartSample,
+                                             const AudioBuffer& source,
+                                             const int sourceStartSample,
+                                             const int numSamples) noexcept
+{
+    jassert (&source != this);
+    jassert (destStartSample >= 0 && destStartSample + numSamples <= size);
+    jassert (sourceStartSample >= 0 && sourceStartSample + numSamples <= source.size);
+
+    const int numChans = jmin (numChannels, source.numChannels);
+
+    if (numSamples <= 0 || numChans == 0)
+        return;
+
+    if (source.isClear)
+    {
+        if (! isClear)
+            for (int i = 0; i < numChans; ++i)
+                FloatVectorOperations::clear (channels[i] + destStartSample, numSamples);
+
+        return;
+    }
+
+    isClear = false;
+
+    if (numChannels == source.numChannels && channelStride == source.channelStride
+         && isWholeContiguousBlock (destStartSample, numSamples)
+         && source.isWholeContiguousBlock (sourceStartSample, numSamples))
+    {
+        FloatVectorOperations::copy (channels[0], source.channels[0], numChannels * channelStride);
+    }
+    else
+    {
+        for (int i = 0; i < numChans; ++i)
+            FloatVectorOperations::copy (channels[i] + destStartSample,
+                                         source.channels[i] + sourceStartSample, numSamples);
+    }
+}
+
+template <typename Type>
+void AudioBuffer<Type>::copyFrom (const int destChannel,
                                   const int destStartSample,
-                                  const float* source,
+                                  const Type* source,
                                   int numSamples) noexcept
 {
     jassert (isPositiveAndBelow (destChannel, numChannels));
@@ -528,11 +704,12 @@ void AudioSampleBuffer::copyFrom (const int destChannel,
     }
 }
 
-void AudioSampleBuffer::copyFrom (const int destChannel,
+template <typename Type>
+void AudioBuffer<Type>::copyFrom (const int destChannel,
                                   const int destStartSample,
-                                  const float* source,
+                                  const Type* source,
                                   int numSamples,
-                                  const float gain) noexcept
+                                  const Type gain) noexcept
 {
     jassert (isPositiveAndBelow (destChannel, numChannels));
     jassert (destStartSample >= 0 && destStartSample + numSamples <= size);
@@ -540,9 +717,9 @@ void AudioSampleBuffer::copyFrom (const int destChannel,
 
     if (numSamples > 0)
     {
-        float* const d = channels [destChannel] + destStartSample;
+        Type* const d = channels [destChannel] + destStartSample;
 
-        if (gain != 1.0f)
+        if (gain != (Type) 1)
         {
             if (gain == 0)
             {
@@ -563,12 +740,13 @@ void AudioSampleBuffer::copyFrom (const int destChannel,
     }
 }
 
-void AudioSampleBuffer::copyFromWithRamp (const int destChannel,
+template <typename Type>
+void AudioBuffer<Type>::copyFromWithRamp (const int destChannel,
                                           const int destStartSample,
-                                          const float* source,
+                                          const Type* source,
                                           int numSamples,
-                                          float startGain,
-                                          float endGain) noexcept
+                                          Type startGain,
+                                          Type endGain) noexcept
 {
     jassert (isPositiveAndBelow (destChannel, numChannels));
     jassert (destStartSample >= 0 && destStartSample + numSamples <= size);
@@ -580,11 +758,11 @@ void AudioSampleBuffer::copyFromWithRamp (const int destChannel,
     }
     else
     {
-        if (numSamples > 0 && (startGain != 0.0f || endGain != 0.0f))
+        if (numSamples > 0 && (startGain != (Type) 0 || endGain != (Type) 0))
         {
             isClear = false;
-            const float increment = (endGain - startGain) / numSamples;
-            float* d = channels [destChannel] + destStartSample;
+            const Type increment = (endGain - startGain) / numSamples;
+            Type* d = channels [destChannel] + destStartSample;
 
             while (--numSamples >= 0)
             {
@@ -595,7 +773,8 @@ void AudioSampleBuffer::copyFromWithRamp (const int destChannel,
     }
 }
 
-void AudioSampleBuffer::reverse (int channel, int startSample, int numSamples) const noexcept
+template <typename Type>
+void AudioBuffer<Type>::reverse (int channel, int startSample, int numSamples) const noexcept
 {
     jassert (isPositiveAndBelow (channel, numChannels));
     jassert (startSample >= 0 && startSample + numSamples <= size);
@@ -605,26 +784,29 @@ void AudioSampleBuffer::reverse (int channel, int startSample, int numSamples) c
                       channels[channel] + startSample + numSamples);
 }
 
-void AudioSampleBuffer::reverse (int startSample, int numSamples) const noexcept
+template <typename Type>
+void AudioBuffer<Type>::reverse (int startSample, int numSamples) const noexcept
 {
     for (int i = 0; i < numChannels; ++i)
         reverse (i, startSample, numSamples);
 }
 
-Range<float> AudioSampleBuffer::findMinMax (const int channel,
-                                            const int startSample,
-                                            int numSamples) const noexcept
+template <typename Type>
+Range<Type> AudioBuffer<Type>::findMinMax (const int channel,
+                                           const int startSample,
+                                           int numSamples) const noexcept
 {
     jassert (isPositiveAndBelow (channel, numChannels));
     jassert (startSample >= 0 && startSample + numSamples <= size);
 
     if (isClear)
-        return Range<float>();
+        return Range<Type>();
 
     return FloatVectorOperations::findMinAndMax (channels [channel] + startSample, numSamples);
 }
 
-float AudioSampleBuffer::getMagnitude (const int channel,
+template <typename Type>
+Type AudioBuffer<Type>::getMagnitude (const int channel,
                                        const int startSample,
                                        const int numSamples) const noexcept
 {
@@ -632,25 +814,59 @@ float AudioSampleBuffer::getMagnitude (const int channel,
     jassert (startSample >= 0 && startSample + numSamples <= size);
 
     if (isClear)
-        return 0.0f;
+        return (Type) 0;
 
-    const Range<float> r (findMinMax (channel, startSample, numSamples));
+    const Range<Type> r (findMinMax (channel, startSample, numSamples));
 
     return jmax (r.getStart(), -r.getStart(), r.getEnd(), -r.getEnd());
 }
 
-float AudioSampleBuffer::getMagnitude (int startSample, int numSamples) const noexcept
+template <typename Type>
+Type AudioBuffer<Type>::getMagnitude (int startSample, int numSamples) const noexcept
 {
-    float mag = 0.0f;
+    jassert (startSample >= 0 && startSample + numSamples <= size);
 
-    if (! isClear)
-        for (int i = 0; i < numChannels; ++i)
-            mag = jmax (mag, getMagnitude (i, startSample, numSamples));
+    if (isClear || numSamples <= 0 || numChannels == 0)
+        return (Type) 0;
 
-    return mag;
+    Range<Type> r;
+
+    // (the padding between channels can't be included in the search, so this only works
+    // if there isn't any)
+    if (channelStride == size && isWholeContiguousBlock (startSample, numSamples))
+    {
+        r = FloatVectorOperations::findMinAndMax (channels[0], numChannels * size);
+    }
+    else
+    {
+        r = FloatVectorOperations::findMinAndMax (channels[0] + startSample, numSamples);
+
+        for (int i = 1; i < numChannels; ++i)
+            r = r.getUnionWith (FloatVectorOperations::findMinAndMax (channels[i] + startSample, numSamples));
+    }
+
+    return jmax (r.getEnd(), -r.getStart());
 }
 
-float AudioSampleBuffer::getRMSLevel (const int channel,
+template <typename Type>
+static double getSumOfSquaredSamples (const Type* const data, const int numSamples) noexcept
+{
+    // (the samples are summed in blocks, so that the vectorised sums of float samples
+    // don't lose accuracy over long sections)
+    const int blockSize = 4096;
+    double sum = 0.0;
+
+    for (int i = 0; i < numSamples; i += blockSize)
+    {
+        const Type* const block = data + i;
+        sum += FloatVectorOperations::dotProduct (block, block, jmin (blockSize, numSamples - i));
+    }
+
+    return sum;
+}
+
+template <typename Type>
+Type AudioBuffer<Type>::getRMSLevel (const int channel,
                                       const int startSample,
                                       const int numSamples) const noexcept
 {
@@ -658,16 +874,37 @@ float AudioSampleBuffer::getRMSLevel (const int channel,
     jassert (startSample >= 0 && startSample + numSamples <= size);
 
     if (numSamples <= 0 || channel < 0 || channel >= numChannels || isClear)
-        return 0.0f;
+        return (Type) 0;
+
+    return (Type) std::sqrt (getSumOfSquaredSamples (channels [channel] + startSample, numSamples) / numSamples);
+}
+
+template <typename Type>
+Type AudioBuffer<Type>::getRMSLevel (const int startSample,
+                                      const int numSamples) const noexcept
+{
+    jassert (startSample >= 0 && startSample + numSamples <= size);
+
+    if (numSamples <= 0 || numChannels == 0 || isClear)
+        return (Type) 0;
 
-    const float* const data = channels [channel] + startSample;
     double sum = 0.0;
 
-    for (int i = 0; i < numSamples; ++i)
+    if (channelStride == size && isWholeContiguousBlock (startSample, numSamples))
+    {
+        sum = getSumOfSquaredSamples (channels[0], numChannels * size);
+    }
+    else
     {
-        const float sample = data [i];
-        sum += sample * sample;
+        for (int i = 0; i < numChannels; ++i)
+            sum += getSumOfSquaredSamples (channels[i] + startSample, numSamples);
     }
 
-    return (float) std::sqrt (sum / numSamples);
+    return (Type) std::sqrt (sum / ((double) numSamples * numChannels));
 }
+
+//==============================================================================
+// (the buffer is only used with these two sample types, so the members are compiled
+// here once rather than being inlined into every file that uses them)
+template class AudioBuffer<float>;
+template class AudioBuffer<double>;
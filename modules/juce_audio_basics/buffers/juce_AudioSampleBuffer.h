@@ -28,15 +28,21 @@
 
 //==============================================================================
 /**
-    A multi-channel buffer of 32-bit floating point audio samples.
+    A multi-channel buffer of floating point audio samples.
 
+    The Type parameter is the sample type, which can be either float or double. Most
+    code uses the AudioSampleBuffer typedef of AudioBuffer<float>, but processors that
+    support it can be given an AudioBuffer<double> to work at full double precision.
+
+    @see AudioSampleBuffer
 */
-class JUCE_API  AudioSampleBuffer
+template <typename Type>
+class JUCE_API  AudioBuffer
 {
 public:
     //==============================================================================
     /** Creates an empty buffer with 0 channels and 0 length. */
-    AudioSampleBuffer() noexcept;
+    AudioBuffer() noexcept;
 
     //==============================================================================
     /** Creates a buffer with a specified number of channels and samples.
@@ -47,9 +53,13 @@ public:
         The buffer will allocate its memory internally, and this will be released
         when the buffer is deleted. If the memory can't be allocated, this will
         throw a std::bad_alloc exception.
+
+        All the channels are allocated in a single block, with each one starting on
+        a 16-byte boundary, so that operations on the whole buffer can be done in one
+        pass rather than channel-by-channel.
     */
-    AudioSampleBuffer (int numChannels,
-                       int numSamples) noexcept;
+    AudioBuffer (int numChannels,
+                 int numSamples) noexcept;
 
     /** Creates a buffer using a pre-allocated block of memory.
 
@@ -66,9 +76,9 @@ public:
         @param numSamples       the number of samples to use - this must correspond to the
                                 size of the arrays passed in
     */
-    AudioSampleBuffer (float* const* dataToReferTo,
-                       int numChannels,
-                       int numSamples) noexcept;
+    AudioBuffer (Type* const* dataToReferTo,
+                 int numChannels,
+                 int numSamples) noexcept;
 
     /** Creates a buffer using a pre-allocated block of memory.
 
@@ -86,10 +96,10 @@ public:
         @param numSamples       the number of samples to use - this must correspond to the
                                 size of the arrays passed in
     */
-    AudioSampleBuffer (float* const* dataToReferTo,
-                       int numChannels,
-                       int startSample,
-                       int numSamples) noexcept;
+    AudioBuffer (Type* const* dataToReferTo,
+                 int numChannels,
+                 int startSample,
+                 int numSamples) noexcept;
 
     /** Copies another buffer.
 
@@ -97,17 +107,47 @@ public:
         using an external data buffer, in which case boths buffers will just point to the same
         shared block of data.
     */
-    AudioSampleBuffer (const AudioSampleBuffer&) noexcept;
+    AudioBuffer (const AudioBuffer&) noexcept;
 
     /** Copies another buffer onto this one.
         This buffer's size will be changed to that of the other buffer.
     */
-    AudioSampleBuffer& operator= (const AudioSampleBuffer&) noexcept;
+    AudioBuffer& operator= (const AudioBuffer&) noexcept;
 
     /** Destructor.
         This will free any memory allocated by the buffer.
     */
-    ~AudioSampleBuffer() noexcept;
+    ~AudioBuffer() noexcept;
+
+    /** Resizes this buffer to match another one, and copies its samples into it, converting
+        them if the other buffer has a different sample type.
+
+        If the size doesn't change, this won't reallocate, so a buffer that refers to some
+        external data will still refer to it afterwards.
+    */
+    template <typename OtherType>
+    void makeCopyOf (const AudioBuffer<OtherType>& other)
+    {
+        setSize (other.getNumChannels(), other.getNumSamples(), false, false, true);
+
+        if (other.hasBeenCleared())
+        {
+            clear();
+        }
+        else
+        {
+            isClear = false;
+
+            for (int chan = 0; chan < numChannels; ++chan)
+            {
+                Type* const dest = channels [chan];
+                const OtherType* const src = other.getReadPointer (chan);
+
+                for (int i = 0; i < size; ++i)
+                    dest[i] = static_cast<Type> (src[i]);
+            }
+        }
+    }
 
     //==============================================================================
     /** Returns the number of channels of audio data that this buffer contains.
@@ -127,7 +167,7 @@ public:
         result! Instead, you must call getWritePointer so that the buffer knows you're
         planning on modifying the data.
     */
-    const float* getReadPointer (int channelNumber) const noexcept
+    const Type* getReadPointer (int channelNumber) const noexcept
     {
         jassert (isPositiveAndBelow (channelNumber, numChannels));
         return channels [channelNumber];
@@ -140,7 +180,7 @@ public:
         result! Instead, you must call getWritePointer so that the buffer knows you're
         planning on modifying the data.
     */
-    const float* getReadPointer (int channelNumber, int sampleIndex) const noexcept
+    const Type* getReadPointer (int channelNumber, int sampleIndex) const noexcept
     {
         jassert (isPositiveAndBelow (channelNumber, numChannels));
         jassert (isPositiveAndBelow (sampleIndex, size));
@@ -153,7 +193,7 @@ public:
         Note that if you're not planning on writing to the data, you should always
         use getReadPointer instead.
     */
-    float* getWritePointer (int channelNumber) noexcept
+    Type* getWritePointer (int channelNumber) noexcept
     {
         jassert (isPositiveAndBelow (channelNumber, numChannels));
         isClear = false;
@@ -166,7 +206,7 @@ public:
         Note that if you're not planning on writing to the data, you should
         use getReadPointer instead.
     */
-    float* getWritePointer (int channelNumber, int sampleIndex) noexcept
+    Type* getWritePointer (int channelNumber, int sampleIndex) noexcept
     {
         jassert (isPositiveAndBelow (channelNumber, numChannels));
         jassert (isPositiveAndBelow (sampleIndex, size));
@@ -179,14 +219,14 @@ public:
         Don't modify any of the pointers that are returned, and bear in mind that
         these will become invalid if the buffer is resized.
     */
-    const float** getArrayOfReadPointers() const noexcept           { return const_cast<const float**> (channels); }
+    const Type** getArrayOfReadPointers() const noexcept            { return const_cast<const Type**> (channels); }
 
     /** Returns an array of pointers to the channels in the buffer.
 
         Don't modify any of the pointers that are returned, and bear in mind that
         these will become invalid if the buffer is resized.
     */
-    float** getArrayOfWritePointers() noexcept                      { isClear = false; return channels; }
+    Type** getArrayOfWritePointers() noexcept                       { isClear = false; return channels; }
 
     //==============================================================================
     /** Changes the buffer's size or number of channels.
@@ -233,7 +273,7 @@ public:
         @param numSamples       the number of samples to use - this must correspond to the
                                 size of the arrays passed in
     */
-    void setDataToReferTo (float** dataToReferTo,
+    void setDataToReferTo (Type** dataToReferTo,
                            int numChannels,
                            int numSamples) noexcept;
 
@@ -272,21 +312,21 @@ public:
         an assertion will be thrown, but in a release build, you're into 'undefined behaviour'
         territory.
     */
-    float getSample (int channel, int sampleIndex) const noexcept;
+    Type getSample (int channel, int sampleIndex) const noexcept;
 
     /** Sets a sample in the buffer.
         The channel and index are not checked - they are expected to be in-range. If not,
         an assertion will be thrown, but in a release build, you're into 'undefined behaviour'
         territory.
     */
-    void setSample (int destChannel, int destSample, float newValue) noexcept;
+    void setSample (int destChannel, int destSample, Type newValue) noexcept;
 
     /** Adds a value to a sample in the buffer.
         The channel and index are not checked - they are expected to be in-range. If not,
         an assertion will be thrown, but in a release build, you're into 'undefined behaviour'
         territory.
     */
-    void addSample (int destChannel, int destSample, float valueToAdd) noexcept;
+    void addSample (int destChannel, int destSample, Type valueToAdd) noexcept;
 
     /** Applies a gain multiple to a region of one channel.
 
@@ -296,7 +336,7 @@ public:
     void applyGain (int channel,
                     int startSample,
                     int numSamples,
-                    float gain) noexcept;
+                    Type gain) noexcept;
 
     /** Applies a gain multiple to a region of all the channels.
 
@@ -305,10 +345,10 @@ public:
     */
     void applyGain (int startSample,
                     int numSamples,
-                    float gain) noexcept;
+                    Type gain) noexcept;
 
     /** Applies a gain multiple to all the audio data. */
-    void applyGain (float gain) noexcept;
+    void applyGain (Type gain) noexcept;
 
     /** Applies a range of gains to a region of a channel.
 
@@ -322,8 +362,8 @@ public:
     void applyGainRamp (int channel,
                         int startSample,
                         int numSamples,
-                        float startGain,
-                        float endGain) noexcept;
+                        Type startGain,
+                        Type endGain) noexcept;
 
     /** Applies a range of gains to a region of all channels.
 
@@ -336,8 +376,8 @@ public:
     */
     void applyGainRamp (int startSample,
                         int numSamples,
-                        float startGain,
-                        float endGain) noexcept;
+                        Type startGain,
+                        Type endGain) noexcept;
 
     /** Adds samples from another buffer to this one.
 
@@ -354,11 +394,11 @@ public:
     */
     void addFrom (int destChannel,
                   int destStartSample,
-                  const AudioSampleBuffer& source,
+                  const AudioBuffer& source,
                   int sourceChannel,
                   int sourceStartSample,
                   int numSamples,
-                  float gainToApplyToSource = 1.0f) noexcept;
+                  Type gainToApplyToSource = (Type) 1) noexcept;
 
     /** Adds samples from an array of floats to one of the channels.
 
@@ -373,9 +413,9 @@ public:
     */
     void addFrom (int destChannel,
                   int destStartSample,
-                  const float* source,
+                  const Type* source,
                   int numSamples,
-                  float gainToApplyToSource = 1.0f) noexcept;
+                  Type gainToApplyToSource = (Type) 1) noexcept;
 
     /** Adds samples from an array of floats, applying a gain ramp to them.
 
@@ -390,10 +430,10 @@ public:
     */
     void addFromWithRamp (int destChannel,
                           int destStartSample,
-                          const float* source,
+                          const Type* source,
                           int numSamples,
-                          float startGain,
-                          float endGain) noexcept;
+                          Type startGain,
+                          Type endGain) noexcept;
 
     /** Copies samples from another buffer to this one.
 
@@ -408,7 +448,7 @@ public:
     */
     void copyFrom (int destChannel,
                    int destStartSample,
-                   const AudioSampleBuffer& source,
+                   const AudioBuffer& source,
                    int sourceChannel,
                    int sourceStartSample,
                    int numSamples) noexcept;
@@ -424,7 +464,7 @@ public:
     */
     void copyFrom (int destChannel,
                    int destStartSample,
-                   const float* source,
+                   const Type* source,
                    int numSamples) noexcept;
 
     /** Copies samples from an array of floats into one of the channels, applying a gain to it.
@@ -439,9 +479,9 @@ public:
     */
     void copyFrom (int destChannel,
                    int destStartSample,
-                   const float* source,
+                   const Type* source,
                    int numSamples,
-                   float gain) noexcept;
+                   Type gain) noexcept;
 
     /** Copies samples from an array of floats into one of the channels, applying a gain ramp.
 
@@ -458,10 +498,49 @@ public:
     */
     void copyFromWithRamp (int destChannel,
                            int destStartSample,
-                           const float* source,
+                           const Type* source,
                            int numSamples,
-                           float startGain,
-                           float endGain) noexcept;
+                           Type startGain,
+                           Type endGain) noexcept;
+
+    //==============================================================================
+    /** Adds a section of every channel of another buffer to the matching channels of this one.
+
+        This does the same as calling addFrom() for each channel, but when both buffers
+        use their own storage and the whole length of each one is being used, all the
+        channels are processed as a single block.
+
+        If the buffers have different numbers of channels, only the channels that they
+        both have are used. The source buffer must not be this buffer.
+
+        @param destStartSample      the start sample within this buffer's channels
+        @param source               the buffer to read from
+        @param sourceStartSample    the offset within the source buffer's channels to start reading samples from
+        @param numSamples           the number of samples to process
+        @param gain                 an optional gain to apply to the source samples before they are added
+        @see addFrom
+    */
+    void addFromAllChannels (int destStartSample,
+                             const AudioBuffer& source,
+                             int sourceStartSample,
+                             int numSamples,
+                             Type gain = (Type) 1) noexcept;
+
+    /** Copies a section of every channel of another buffer to the matching channels of this one.
+
+        This does the same as calling copyFrom() for each channel, but when both buffers
+        use their own storage and the whole length of each one is being used, all the
+        channels are processed as a single block.
+
+        If the buffers have different numbers of channels, only the channels that they
+        both have are used. The source buffer must not be this buffer.
+
+        @see copyFrom, addFromAllChannels
+    */
+    void copyFromAllChannels (int destStartSample,
+                              const AudioBuffer& source,
+                              int sourceStartSample,
+                              int numSamples) noexcept;
 
 
     /** Returns a Range indicating the lowest and highest sample values in a given section.
@@ -470,23 +549,27 @@ public:
         @param startSample  the start sample within the channel
         @param numSamples   the number of samples to check
     */
-    Range<float> findMinMax (int channel,
-                             int startSample,
-                             int numSamples) const noexcept;
+    Range<Type> findMinMax (int channel,
+                            int startSample,
+                            int numSamples) const noexcept;
 
     /** Finds the highest absolute sample value within a region of a channel. */
-    float getMagnitude (int channel,
-                        int startSample,
-                        int numSamples) const noexcept;
+    Type getMagnitude (int channel,
+                       int startSample,
+                       int numSamples) const noexcept;
 
     /** Finds the highest absolute sample value within a region on all channels. */
-    float getMagnitude (int startSample,
-                        int numSamples) const noexcept;
+    Type getMagnitude (int startSample,
+                       int numSamples) const noexcept;
 
     /** Returns the root mean squared level for a region of a channel. */
-    float getRMSLevel (int channel,
-                       int startSample,
-                       int numSamples) const noexcept;
+    Type getRMSLevel (int channel,
+                      int startSample,
+                      int numSamples) const noexcept;
+
+    /** Returns the root mean squared level for a region, taken across all the channels. */
+    Type getRMSLevel (int startSample,
+                      int numSamples) const noexcept;
 
     /** Reverses a part of a channel. */
     void reverse (int channel, int startSample, int numSamples) const noexcept;
@@ -497,30 +580,37 @@ public:
     //==============================================================================
    #ifndef DOXYGEN
     // Note that these methods have now been replaced by getReadPointer() and getWritePointer()
-    JUCE_DEPRECATED_WITH_BODY (const float* getSampleData (int channel) const,            { return getReadPointer (channel); })
-    JUCE_DEPRECATED_WITH_BODY (const float* getSampleData (int channel, int index) const, { return getReadPointer (channel, index); })
-    JUCE_DEPRECATED_WITH_BODY (float* getSampleData (int channel),                        { return getWritePointer (channel); })
-    JUCE_DEPRECATED_WITH_BODY (float* getSampleData (int channel, int index),             { return getWritePointer (channel, index); })
+    JUCE_DEPRECATED_WITH_BODY (const Type* getSampleData (int channel) const,             { return getReadPointer (channel); })
+    JUCE_DEPRECATED_WITH_BODY (const Type* getSampleData (int channel, int index) const,  { return getReadPointer (channel, index); })
+    JUCE_DEPRECATED_WITH_BODY (Type* getSampleData (int channel),                         { return getWritePointer (channel); })
+    JUCE_DEPRECATED_WITH_BODY (Type* getSampleData (int channel, int index),              { return getWritePointer (channel, index); })
 
     // These have been replaced by getArrayOfReadPointers() and getArrayOfWritePointers()
-    JUCE_DEPRECATED_WITH_BODY (const float** getArrayOfChannels() const,                  { return getArrayOfReadPointers(); })
-    JUCE_DEPRECATED_WITH_BODY (float** getArrayOfChannels(),                              { return getArrayOfWritePointers(); })
+    JUCE_DEPRECATED_WITH_BODY (const Type** getArrayOfChannels() const,                   { return getArrayOfReadPointers(); })
+    JUCE_DEPRECATED_WITH_BODY (Type** getArrayOfChannels(),                               { return getArrayOfWritePointers(); })
    #endif
 
 private:
     //==============================================================================
-    int numChannels, size;
+    int numChannels, size, channelStride;
     size_t allocatedBytes;
-    float** channels;
+    Type** channels;
     HeapBlock<char, true> allocatedData;
-    float* preallocatedChannelSpace [32];
+    Type* preallocatedChannelSpace [32];
     bool isClear;
 
     void allocateData();
-    void allocateChannels (float* const*, int offset);
+    void allocateChannels (Type* const*, int offset);
+    bool isWholeContiguousBlock (int startSample, int numSamples) const noexcept;
 
-    JUCE_LEAK_DETECTOR (AudioSampleBuffer)
+    JUCE_LEAK_DETECTOR (AudioBuffer)
 };
 
+//==============================================================================
+/** A multi-channel buffer of 32-bit floating point audio samples.
+    @see AudioBuffer
+*/
+typedef AudioBuffer<float> AudioSampleBuffer;
+
 
 #endif   // JUCE_AUDIOSAMPLEBUFFER_H_INCLUDED
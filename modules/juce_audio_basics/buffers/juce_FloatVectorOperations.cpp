@@ -75,6 +75,7 @@ namespace FloatVectorHelpers
 
         static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
         static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+        static forcedinline Type sum (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return (v[0] + v[1]) + (v[2] + v[3]); }
     };
 
     struct BasicOps64
@@ -107,6 +108,7 @@ namespace FloatVectorHelpers
 
         static forcedinline Type max (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1]); }
         static forcedinline Type min (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1]); }
+        static forcedinline Type sum (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return v[0] + v[1]; }
     };
 
 
@@ -201,6 +203,7 @@ namespace FloatVectorHelpers
 
         static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
         static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+        static forcedinline Type sum (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return (v[0] + v[1]) + (v[2] + v[3]); }
     };
 
     struct BasicOps64
@@ -232,6 +235,7 @@ namespace FloatVectorHelpers
 
         static forcedinline Type max (ParallelType a) noexcept  { return a; }
         static forcedinline Type min (ParallelType a) noexcept  { return a; }
+        static forcedinline Type sum (ParallelType a) noexcept  { return a; }
     };
 
     #define JUCE_BEGIN_VEC_OP \
@@ -459,6 +463,372 @@ namespace FloatVectorHelpers
             return Range<Type>::findMinAndMax (src, num);
         }
     };
+
+    template <typename Mode>
+    struct DotProduct
+    {
+        typedef typename Mode::Type Type;
+        typedef typename Mode::ParallelType ParallelType;
+
+        static Type calculate (const Type* src1, const Type* src2, int num) noexcept
+        {
+            Type result = 0;
+            int numLongOps = num / (Mode::numParallel * 2);
+
+           #if JUCE_USE_SSE_INTRINSICS
+            if (numLongOps > 0 && isSSE2Available())
+           #else
+            if (numLongOps > 0)
+           #endif
+            {
+                // two accumulators, so that consecutive multiply-adds don't have to wait for each other
+                ParallelType sum1 = Mode::mul (Mode::loadU (src1), Mode::loadU (src2));
+                ParallelType sum2 = Mode::mul (Mode::loadU (src1 + Mode::numParallel), Mode::loadU (src2 + Mode::numParallel));
+
+                while (--numLongOps > 0)
+                {
+                    src1 += Mode::numParallel * 2;
+                    src2 += Mode::numParallel * 2;
+                    sum1 = Mode::add (sum1, Mode::mul (Mode::loadU (src1), Mode::loadU (src2)));
+                    sum2 = Mode::add (sum2, Mode::mul (Mode::loadU (src1 + Mode::numParallel), Mode::loadU (src2 + Mode::numParallel)));
+                }
+
+                result = Mode::sum (Mode::add (sum1, sum2));
+
+                src1 += Mode::numParallel * 2;
+                src2 += Mode::numParallel * 2;
+                num &= (Mode::numParallel * 2 - 1);
+            }
+
+            for (int i = 0; i < num; ++i)
+                result += src1[i] * src2[i];
+
+            return result;
+        }
+    };
+   #endif
+
+    //==============================================================================
+   #if JUCE_USE_AVX_INTRINSICS
+    #if JUCE_MSVC
+     #define JUCE_AVX_FUNCTION
+     #define JUCE_FMA_FUNCTION
+    #else
+     #define JUCE_AVX_FUNCTION  __attribute__ ((target ("avx")))
+     #define JUCE_FMA_FUNCTION  __attribute__ ((target ("avx,fma")))
+    #endif
+
+    #if ! (JUCE_MSVC && _MSC_VER < 1700)
+     #define JUCE_USE_FMA_INTRINSICS 1
+    #endif
+
+    static bool isAVXAvailable() noexcept
+    {
+        static const bool avxPresent = SystemStats::hasAVX();
+        return avxPresent;
+    }
+
+    static bool isFMAAvailable() noexcept
+    {
+        static const bool fmaPresent = SystemStats::hasAVX() && SystemStats::hasFMA3();
+        return fmaPresent;
+    }
+
+    struct AVXOps32
+    {
+        typedef float Type;
+        typedef __m256 ParallelType;
+        enum { numParallel = 8 };
+
+        static forcedinline JUCE_AVX_FUNCTION ParallelType load1 (Type v) noexcept                        { return _mm256_set1_ps (v); }
+        static forcedinline JUCE_AVX_FUNCTION ParallelType load (const Type* v) noexcept                  { return _mm256_loadu_ps (v); }
+        static forcedinline JUCE_AVX_FUNCTION void store (Type* dest, ParallelType a) noexcept            { _mm256_storeu_ps (dest, a); }
+
+        static forcedinline JUCE_AVX_FUNCTION ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_ps (a, b); }
+        static forcedinline JUCE_AVX_FUNCTION ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_ps (a, b); }
+        static forcedinline JUCE_AVX_FUNCTION ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_ps (a, b); }
+        static forcedinline JUCE_AVX_FUNCTION ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_ps (a, b); }
+        static forcedinline JUCE_AVX_FUNCTION ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_ps (a, b); }
+
+       #if JUCE_USE_FMA_INTRINSICS
+        // returns (a * b) + c, with a single rounding step
+        static forcedinline JUCE_FMA_FUNCTION ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fmadd_ps (a, b, c); }
+       #endif
+
+        static forcedinline JUCE_AVX_FUNCTION Type max (ParallelType a) noexcept { Type v[numParallel]; store (v, a); return jmax (jmax (v[0], v[1], v[2], v[3]), jmax (v[4], v[5], v[6], v[7])); }
+        static forcedinline JUCE_AVX_FUNCTION Type min (ParallelType a) noexcept { Type v[numParallel]; store (v, a); return jmin (jmin (v[0], v[1], v[2], v[3]), jmin (v[4], v[5], v[6], v[7])); }
+        static forcedinline JUCE_AVX_FUNCTION Type sum (ParallelType a) noexcept { Type v[numParallel]; store (v, a); return ((v[0] + v[1]) + (v[2] + v[3])) + ((v[4] + v[5]) + (v[6] + v[7])); }
+    };
+
+    struct AVXOps64
+    {
+        typedef double Type;
+        typedef __m256d ParallelType;
+        enum { numParallel = 4 };
+
+        static forcedinline JUCE_AVX_FUNCTION ParallelType load1 (Type v) noexcept                        { return _mm256_set1_pd (v); }
+        static forcedinline JUCE_AVX_FUNCTION ParallelType load (const Type* v) noexcept                  { return _mm256_loadu_pd (v); }
+        static forcedinline JUCE_AVX_FUNCTION void store (Type* dest, ParallelType a) noexcept            { _mm256_storeu_pd (dest, a); }
+
+        static forcedinline JUCE_AVX_FUNCTION ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_pd (a, b); }
+        static forcedinline JUCE_AVX_FUNCTION ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_pd (a, b); }
+        static forcedinline JUCE_AVX_FUNCTION ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_pd (a, b); }
+        static forcedinline JUCE_AVX_FUNCTION ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_pd (a, b); }
+        static forcedinline JUCE_AVX_FUNCTION ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_pd (a, b); }
+
+       #if JUCE_USE_FMA_INTRINSICS
+        // returns (a * b) + c, with a single rounding step
+        static forcedinline JUCE_FMA_FUNCTION ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fmadd_pd (a, b, c); }
+       #endif
+
+        static forcedinline JUCE_AVX_FUNCTION Type max (ParallelType a) noexcept { Type v[numParallel]; store (v, a); return jmax (v[0], v[1], v[2], v[3]); }
+        static forcedinline JUCE_AVX_FUNCTION Type min (ParallelType a) noexcept { Type v[numParallel]; store (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+        static forcedinline JUCE_AVX_FUNCTION Type sum (ParallelType a) noexcept { Type v[numParallel]; store (v, a); return (v[0] + v[1]) + (v[2] + v[3]); }
+    };
+
+    template<int typeSize> struct AVXModeType    { typedef AVXOps32 Mode; };
+    template<>             struct AVXModeType<8> { typedef AVXOps64 Mode; };
+
+    //==============================================================================
+    // Each of these describes an element-wise operation on the destination (d), up to two
+    // source values (s1, s2) and a constant (c), in both its vector and scalar forms.
+    #define JUCE_DECLARE_AVX_OP(name, functionAttribute, readsDestination, numSrcs, vecOp, normalOp) \
+        template <typename Mode> \
+        struct name \
+        { \
+            typedef typename Mode::Type Type; \
+            typedef typename Mode::ParallelType ParallelType; \
+            enum { readsDest = readsDestination, numSources = numSrcs }; \
+            \
+            static forcedinline functionAttribute ParallelType vec (ParallelType d, ParallelType s1, ParallelType s2, ParallelType c) noexcept \
+            { \
+                ignoreUnused (d, s1, s2, c); \
+                return vecOp; \
+            } \
+            \
+            static forcedinline Type scalar (Type d, Type s1, Type s2, Type c) noexcept \
+            { \
+                ignoreUnused (d, s1, s2, c); \
+                return normalOp; \
+            } \
+        };
+
+    JUCE_DECLARE_AVX_OP (AddConstantOp,         JUCE_AVX_FUNCTION, 1, 0, Mode::add (d, c),              d + c)
+    JUCE_DECLARE_AVX_OP (AddOp,                 JUCE_AVX_FUNCTION, 1, 1, Mode::add (d, s1),             d + s1)
+    JUCE_DECLARE_AVX_OP (AddSourceAndConstOp,   JUCE_AVX_FUNCTION, 0, 1, Mode::add (s1, c),             s1 + c)
+    JUCE_DECLARE_AVX_OP (AddSourcesOp,          JUCE_AVX_FUNCTION, 0, 2, Mode::add (s1, s2),            s1 + s2)
+    JUCE_DECLARE_AVX_OP (AddWithMultiplyOp,     JUCE_AVX_FUNCTION, 1, 1, Mode::add (d, Mode::mul (s1, c)),  d + s1 * c)
+    JUCE_DECLARE_AVX_OP (AddProductOp,          JUCE_AVX_FUNCTION, 1, 2, Mode::add (d, Mode::mul (s1, s2)), d + s1 * s2)
+    JUCE_DECLARE_AVX_OP (MultiplyConstantOp,    JUCE_AVX_FUNCTION, 1, 0, Mode::mul (d, c),              d * c)
+    JUCE_DECLARE_AVX_OP (MultiplyOp,            JUCE_AVX_FUNCTION, 1, 1, Mode::mul (d, s1),             d * s1)
+    JUCE_DECLARE_AVX_OP (CopyWithMultiplyOp,    JUCE_AVX_FUNCTION, 0, 1, Mode::mul (s1, c),             s1 * c)
+    JUCE_DECLARE_AVX_OP (MultiplySourcesOp,     JUCE_AVX_FUNCTION, 0, 2, Mode::mul (s1, s2),            s1 * s2)
+    JUCE_DECLARE_AVX_OP (MinConstantOp,         JUCE_AVX_FUNCTION, 0, 1, Mode::min (s1, c),             jmin (s1, c))
+    JUCE_DECLARE_AVX_OP (MinSourcesOp,          JUCE_AVX_FUNCTION, 0, 2, Mode::min (s1, s2),            jmin (s1, s2))
+    JUCE_DECLARE_AVX_OP (MaxConstantOp,         JUCE_AVX_FUNCTION, 0, 1, Mode::max (s1, c),             jmax (s1, c))
+    JUCE_DECLARE_AVX_OP (MaxSourcesOp,          JUCE_AVX_FUNCTION, 0, 2, Mode::max (s1, s2),            jmax (s1, s2))
+
+   #if JUCE_USE_FMA_INTRINSICS
+    JUCE_DECLARE_AVX_OP (FMAAddWithMultiplyOp,  JUCE_FMA_FUNCTION, 1, 1, Mode::mulAdd (s1, c, d),       d + s1 * c)
+    JUCE_DECLARE_AVX_OP (FMAAddProductOp,       JUCE_FMA_FUNCTION, 1, 2, Mode::mulAdd (s1, s2, d),      d + s1 * s2)
+   #endif
+
+    #undef JUCE_DECLARE_AVX_OP
+
+    //==============================================================================
+    #define JUCE_DECLARE_AVX_KERNEL(name, functionAttribute) \
+        template <typename Mode, typename Op> \
+        static functionAttribute void name (typename Mode::Type* dest, const typename Mode::Type* src1, const typename Mode::Type* src2, \
+                                            const typename Mode::Type constant, int num) noexcept \
+        { \
+            typedef typename Mode::ParallelType ParallelType; \
+            const ParallelType c = Mode::load1 (constant); \
+            \
+            for (int i = num / Mode::numParallel; --i >= 0;) \
+            { \
+                const ParallelType d  = Op::readsDest      ? Mode::load (dest) : c; \
+                const ParallelType s1 = Op::numSources > 0 ? Mode::load (src1) : c; \
+                const ParallelType s2 = Op::numSources > 1 ? Mode::load (src2) : c; \
+                \
+                Mode::store (dest, Op::vec (d, s1, s2, c)); \
+                \
+                dest += Mode::numParallel; \
+                if (Op::numSources > 0)  src1 += Mode::numParallel; \
+                if (Op::numSources > 1)  src2 += Mode::numParallel; \
+            } \
+            \
+            _mm256_zeroupper(); \
+            \
+            for (int i = 0; i < (num & (Mode::numParallel - 1)); ++i) \
+                dest[i] = Op::scalar (dest[i], \
+                                      Op::numSources > 0 ? src1[i] : constant, \
+                                      Op::numSources > 1 ? src2[i] : constant, \
+                                      constant); \
+        }
+
+    JUCE_DECLARE_AVX_KERNEL (performAVXOp, JUCE_AVX_FUNCTION)
+
+   #if JUCE_USE_FMA_INTRINSICS
+    JUCE_DECLARE_AVX_KERNEL (performFMAOp, JUCE_FMA_FUNCTION)
+   #endif
+
+    #undef JUCE_DECLARE_AVX_KERNEL
+
+    static JUCE_AVX_FUNCTION void convertFixedToFloatAVX (float* dest, const int* src, float multiplier, int num) noexcept
+    {
+        const __m256 mult = _mm256_set1_ps (multiplier);
+
+        for (int i = num / 8; --i >= 0;)
+        {
+            _mm256_storeu_ps (dest, _mm256_mul_ps (mult, _mm256_cvtepi32_ps (_mm256_loadu_si256 ((const __m256i*) src))));
+            dest += 8;
+            src += 8;
+        }
+
+        _mm256_zeroupper();
+
+        for (int i = 0; i < (num & 7); ++i)
+            dest[i] = src[i] * multiplier;
+    }
+
+    template <typename Mode>
+    struct AVXMinMax
+    {
+        typedef typename Mode::Type Type;
+        typedef typename Mode::ParallelType ParallelType;
+
+        static JUCE_AVX_FUNCTION Type findMinOrMax (const Type* src, int num, const bool isMinimum) noexcept
+        {
+            int numLongOps = num / Mode::numParallel;
+
+            if (numLongOps <= 1)
+                return isMinimum ? juce::findMinimum (src, num)
+                                 : juce::findMaximum (src, num);
+
+            ParallelType val = Mode::load (src);
+
+            if (isMinimum)
+            {
+                while (--numLongOps > 0)
+                {
+                    src += Mode::numParallel;
+                    val = Mode::min (val, Mode::load (src));
+                }
+            }
+            else
+            {
+                while (--numLongOps > 0)
+                {
+                    src += Mode::numParallel;
+                    val = Mode::max (val, Mode::load (src));
+                }
+            }
+
+            Type result = isMinimum ? Mode::min (val)
+                                    : Mode::max (val);
+
+            _mm256_zeroupper();
+
+            num &= (Mode::numParallel - 1);
+            src += Mode::numParallel;
+
+            for (int i = 0; i < num; ++i)
+                result = isMinimum ? jmin (result, src[i])
+                                   : jmax (result, src[i]);
+
+            return result;
+        }
+
+        static JUCE_AVX_FUNCTION Range<Type> findMinAndMax (const Type* src, int num) noexcept
+        {
+            int numLongOps = num / Mode::numParallel;
+
+            if (numLongOps <= 1)
+                return Range<Type>::findMinAndMax (src, num);
+
+            ParallelType mn = Mode::load (src);
+            ParallelType mx = mn;
+
+            while (--numLongOps > 0)
+            {
+                src += Mode::numParallel;
+                const ParallelType v = Mode::load (src);
+                mn = Mode::min (mn, v);
+                mx = Mode::max (mx, v);
+            }
+
+            Range<Type> result (Mode::min (mn),
+                                Mode::max (mx));
+
+            _mm256_zeroupper();
+
+            num &= (Mode::numParallel - 1);
+            src += Mode::numParallel;
+
+            for (int i = 0; i < num; ++i)
+                result = result.getUnionWith (src[i]);
+
+            return result;
+        }
+    };
+
+    template <typename Mode>
+    static JUCE_AVX_FUNCTION typename Mode::Type dotProductAVX (const typename Mode::Type* src1, const typename Mode::Type* src2, int num) noexcept
+    {
+        typedef typename Mode::ParallelType ParallelType;
+        typename Mode::Type result = 0;
+        int numLongOps = num / (Mode::numParallel * 2);
+
+        if (numLongOps > 0)
+        {
+            ParallelType sum1 = Mode::mul (Mode::load (src1), Mode::load (src2));
+            ParallelType sum2 = Mode::mul (Mode::load (src1 + Mode::numParallel), Mode::load (src2 + Mode::numParallel));
+
+            while (--numLongOps > 0)
+            {
+                src1 += Mode::numParallel * 2;
+                src2 += Mode::numParallel * 2;
+                sum1 = Mode::add (sum1, Mode::mul (Mode::load (src1), Mode::load (src2)));
+                sum2 = Mode::add (sum2, Mode::mul (Mode::load (src1 + Mode::numParallel), Mode::load (src2 + Mode::numParallel)));
+            }
+
+            result = Mode::sum (Mode::add (sum1, sum2));
+            _mm256_zeroupper();
+
+            src1 += Mode::numParallel * 2;
+            src2 += Mode::numParallel * 2;
+            num &= (Mode::numParallel * 2 - 1);
+        }
+
+        for (int i = 0; i < num; ++i)
+            result += src1[i] * src2[i];
+
+        return result;
+    }
+
+    #define JUCE_PERFORM_AVX_OP(opName, src1, src2, constant) \
+        if (FloatVectorHelpers::isAVXAvailable()) \
+        { \
+            typedef FloatVectorHelpers::AVXModeType<sizeof (*dest)>::Mode AVXMode; \
+            FloatVectorHelpers::performAVXOp<AVXMode, FloatVectorHelpers::opName<AVXMode> > (dest, src1, src2, constant, num); \
+            return; \
+        }
+
+    #if JUCE_USE_FMA_INTRINSICS
+     #define JUCE_PERFORM_FMA_OP(opName, src1, src2, constant) \
+         if (FloatVectorHelpers::isFMAAvailable()) \
+         { \
+             typedef FloatVectorHelpers::AVXModeType<sizeof (*dest)>::Mode AVXMode; \
+             FloatVectorHelpers::performFMAOp<AVXMode, FloatVectorHelpers::opName<AVXMode> > (dest, src1, src2, constant, num); \
+             return; \
+         }
+    #else
+     #define JUCE_PERFORM_FMA_OP(opName, src1, src2, constant)
+    #endif
+
+   #else
+    #define JUCE_PERFORM_AVX_OP(opName, src1, src2, constant)
+    #define JUCE_PERFORM_FMA_OP(opName, src1, src2, constant)
    #endif
 }
 
@@ -516,6 +886,7 @@ void JUCE_CALLTYPE FloatVectorOperations::copyWithMultiply (float* dest, const f
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmul (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (CopyWithMultiplyOp, src, nullptr, multiplier)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -527,6 +898,7 @@ void JUCE_CALLTYPE FloatVectorOperations::copyWithMultiply (double* dest, const
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmulD (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (CopyWithMultiplyOp, src, nullptr, multiplier)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -538,6 +910,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, float amount, int nu
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsadd (dest, 1, &amount, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (AddConstantOp, nullptr, nullptr, amount)
     JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount, Mode::add (d, amountToAdd), JUCE_LOAD_DEST,
                               const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
    #endif
@@ -545,6 +918,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, float amount, int nu
 
 void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, double amount, int num) noexcept
 {
+    JUCE_PERFORM_AVX_OP (AddConstantOp, nullptr, nullptr, amount)
     JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount, Mode::add (d, amountToAdd), JUCE_LOAD_DEST,
                               const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
 }
@@ -554,6 +928,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, float* src, float am
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsadd (src, 1, &amount, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (AddSourceAndConstOp, src, nullptr, amount)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount, Mode::add (am, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType am = Mode::load1 (amount);)
@@ -565,6 +940,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, double* src, double
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsaddD (src, 1, &amount, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (AddSourceAndConstOp, src, nullptr, amount)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount, Mode::add (am, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType am = Mode::load1 (amount);)
@@ -576,6 +952,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src, in
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vadd (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (AddOp, src, nullptr, 0)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i], Mode::add (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -585,6 +962,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vaddD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (AddOp, src, nullptr, 0)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i], Mode::add (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -594,6 +972,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src1, c
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vadd (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (AddSourcesOp, src1, src2, 0)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i], Mode::add (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -603,6 +982,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src1,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vaddD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (AddSourcesOp, src1, src2, 0)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i], Mode::add (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -648,6 +1028,8 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const fl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsma (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_FMA_OP (FMAAddWithMultiplyOp, src, nullptr, multiplier)
+    JUCE_PERFORM_AVX_OP (AddWithMultiplyOp, src, nullptr, multiplier)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::add (d, Mode::mul (mult, s)),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -656,6 +1038,8 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const fl
 
 void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const double* src, double multiplier, int num) noexcept
 {
+    JUCE_PERFORM_FMA_OP (FMAAddWithMultiplyOp, src, nullptr, multiplier)
+    JUCE_PERFORM_AVX_OP (AddWithMultiplyOp, src, nullptr, multiplier)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::add (d, Mode::mul (mult, s)),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -666,6 +1050,8 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const fl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vma ((float*) src1, 1, (float*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_FMA_OP (FMAAddProductOp, src1, src2, 0)
+    JUCE_PERFORM_AVX_OP (AddProductOp, src1, src2, 0)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i], Mode::add (d, Mode::mul (s1, s2)),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
@@ -677,6 +1063,8 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmaD ((double*) src1, 1, (double*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_FMA_OP (FMAAddProductOp, src1, src2, 0)
+    JUCE_PERFORM_AVX_OP (AddProductOp, src1, src2, 0)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i], Mode::add (d, Mode::mul (s1, s2)),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
@@ -688,6 +1076,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmul (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (MultiplyOp, src, nullptr, 0)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i], Mode::mul (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -697,6 +1086,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmulD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (MultiplyOp, src, nullptr, 0)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i], Mode::mul (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -706,6 +1096,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmul (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (MultiplySourcesOp, src1, src2, 0)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i], Mode::mul (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -715,6 +1106,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmulD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (MultiplySourcesOp, src1, src2, 0)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i], Mode::mul (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -724,6 +1116,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, float multiplie
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmul (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (MultiplyConstantOp, nullptr, nullptr, multiplier)
     JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier, Mode::mul (d, mult), JUCE_LOAD_DEST,
                               const Mode::ParallelType mult = Mode::load1 (multiplier);)
    #endif
@@ -734,6 +1127,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, double multipl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmulD (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (MultiplyConstantOp, nullptr, nullptr, multiplier)
     JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier, Mode::mul (d, mult), JUCE_LOAD_DEST,
                               const Mode::ParallelType mult = Mode::load1 (multiplier);)
    #endif
@@ -741,6 +1135,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, double multipl
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* src, float multiplier, int num) noexcept
 {
+    JUCE_PERFORM_AVX_OP (CopyWithMultiplyOp, src, nullptr, multiplier)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -748,6 +1143,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double* src, double multiplier, int num) noexcept
 {
+    JUCE_PERFORM_AVX_OP (CopyWithMultiplyOp, src, nullptr, multiplier)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -805,6 +1201,14 @@ void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, cons
                                   vmulq_n_f32 (vcvtq_f32_s32 (vld1q_s32 (src)), multiplier),
                                   JUCE_LOAD_NONE, JUCE_INCREMENT_SRC_DEST, )
    #else
+    #if JUCE_USE_AVX_INTRINSICS
+     if (FloatVectorHelpers::isAVXAvailable())
+     {
+         FloatVectorHelpers::convertFixedToFloatAVX (dest, src, multiplier, num);
+         return;
+     }
+    #endif
+
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
                                   Mode::mul (mult, _mm_cvtepi32_ps (_mm_loadu_si128 ((const __m128i*) src))),
                                   JUCE_LOAD_NONE, JUCE_INCREMENT_SRC_DEST,
@@ -814,6 +1218,7 @@ void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, cons
 
 void JUCE_CALLTYPE FloatVectorOperations::min (float* dest, const float* src, float comp, int num) noexcept
 {
+    JUCE_PERFORM_AVX_OP (MinConstantOp, src, nullptr, comp)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp), Mode::min (s, cmp),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType cmp = Mode::load1 (comp);)
@@ -821,6 +1226,7 @@ void JUCE_CALLTYPE FloatVectorOperations::min (float* dest, const float* src, fl
 
 void JUCE_CALLTYPE FloatVectorOperations::min (double* dest, const double* src, double comp, int num) noexcept
 {
+    JUCE_PERFORM_AVX_OP (MinConstantOp, src, nullptr, comp)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp), Mode::min (s, cmp),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType cmp = Mode::load1 (comp);)
@@ -831,6 +1237,7 @@ void JUCE_CALLTYPE FloatVectorOperations::min (float* dest, const float* src1, c
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmin ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (MinSourcesOp, src1, src2, 0)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]), Mode::min (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -840,12 +1247,14 @@ void JUCE_CALLTYPE FloatVectorOperations::min (double* dest, const double* src1,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vminD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (MinSourcesOp, src1, src2, 0)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmin (src1[i], src2[i]), Mode::min (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::max (float* dest, const float* src, float comp, int num) noexcept
 {
+    JUCE_PERFORM_AVX_OP (MaxConstantOp, src, nullptr, comp)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp), Mode::max (s, cmp),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType cmp = Mode::load1 (comp);)
@@ -853,6 +1262,7 @@ void JUCE_CALLTYPE FloatVectorOperations::max (float* dest, const float* src, fl
 
 void JUCE_CALLTYPE FloatVectorOperations::max (double* dest, const double* src, double comp, int num) noexcept
 {
+    JUCE_PERFORM_AVX_OP (MaxConstantOp, src, nullptr, comp)
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp), Mode::max (s, cmp),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType cmp = Mode::load1 (comp);)
@@ -863,6 +1273,7 @@ void JUCE_CALLTYPE FloatVectorOperations::max (float* dest, const float* src1, c
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmax ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (MaxSourcesOp, src1, src2, 0)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]), Mode::max (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -872,6 +1283,7 @@ void JUCE_CALLTYPE FloatVectorOperations::max (double* dest, const double* src1,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmaxD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_AVX_OP (MaxSourcesOp, src1, src2, 0)
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = jmax (src1[i], src2[i]), Mode::max (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -904,6 +1316,11 @@ void JUCE_CALLTYPE FloatVectorOperations::clip (double* dest, const double* src,
 
 Range<float> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const float* src, int num) noexcept
 {
+   #if JUCE_USE_AVX_INTRINSICS
+    if (FloatVectorHelpers::isAVXAvailable())
+        return FloatVectorHelpers::AVXMinMax<FloatVectorHelpers::AVXOps32>::findMinAndMax (src, num);
+   #endif
+
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinAndMax (src, num);
    #else
@@ -913,6 +1330,11 @@ Range<float> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const float* sr
 
 Range<double> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const double* src, int num) noexcept
 {
+   #if JUCE_USE_AVX_INTRINSICS
+    if (FloatVectorHelpers::isAVXAvailable())
+        return FloatVectorHelpers::AVXMinMax<FloatVectorHelpers::AVXOps64>::findMinAndMax (src, num);
+   #endif
+
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinAndMax (src, num);
    #else
@@ -922,6 +1344,11 @@ Range<double> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const double*
 
 float JUCE_CALLTYPE FloatVectorOperations::findMinimum (const float* src, int num) noexcept
 {
+   #if JUCE_USE_AVX_INTRINSICS
+    if (FloatVectorHelpers::isAVXAvailable())
+        return FloatVectorHelpers::AVXMinMax<FloatVectorHelpers::AVXOps32>::findMinOrMax (src, num, true);
+   #endif
+
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, true);
    #else
@@ -931,6 +1358,11 @@ float JUCE_CALLTYPE FloatVectorOperations::findMinimum (const float* src, int nu
 
 double JUCE_CALLTYPE FloatVectorOperations::findMinimum (const double* src, int num) noexcept
 {
+   #if JUCE_USE_AVX_INTRINSICS
+    if (FloatVectorHelpers::isAVXAvailable())
+        return FloatVectorHelpers::AVXMinMax<FloatVectorHelpers::AVXOps64>::findMinOrMax (src, num, true);
+   #endif
+
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, true);
    #else
@@ -940,6 +1372,11 @@ double JUCE_CALLTYPE FloatVectorOperations::findMinimum (const double* src, int
 
 float JUCE_CALLTYPE FloatVectorOperations::findMaximum (const float* src, int num) noexcept
 {
+   #if JUCE_USE_AVX_INTRINSICS
+    if (FloatVectorHelpers::isAVXAvailable())
+        return FloatVectorHelpers::AVXMinMax<FloatVectorHelpers::AVXOps32>::findMinOrMax (src, num, false);
+   #endif
+
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, false);
    #else
@@ -949,6 +1386,11 @@ float JUCE_CALLTYPE FloatVectorOperations::findMaximum (const float* src, int nu
 
 double JUCE_CALLTYPE FloatVectorOperations::findMaximum (const double* src, int num) noexcept
 {
+   #if JUCE_USE_AVX_INTRINSICS
+    if (FloatVectorHelpers::isAVXAvailable())
+        return FloatVectorHelpers::AVXMinMax<FloatVectorHelpers::AVXOps64>::findMinOrMax (src, num, false);
+   #endif
+
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, false);
    #else
@@ -956,6 +1398,52 @@ double JUCE_CALLTYPE FloatVectorOperations::findMaximum (const double* src, int
    #endif
 }
 
+float JUCE_CALLTYPE FloatVectorOperations::dotProduct (const float* src1, const float* src2, int num) noexcept
+{
+   #if JUCE_USE_AVX_INTRINSICS
+    if (FloatVectorHelpers::isAVXAvailable())
+        return FloatVectorHelpers::dotProductAVX<FloatVectorHelpers::AVXOps32> (src1, src2, num);
+   #endif
+
+   #if JUCE_USE_VDSP_FRAMEWORK
+    float result;
+    vDSP_dotpr (src1, 1, src2, 1, &result, (vDSP_Length) num);
+    return result;
+   #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    return FloatVectorHelpers::DotProduct<FloatVectorHelpers::BasicOps32>::calculate (src1, src2, num);
+   #else
+    float result = 0;
+
+    for (int i = 0; i < num; ++i)
+        result += src1[i] * src2[i];
+
+    return result;
+   #endif
+}
+
+double JUCE_CALLTYPE FloatVectorOperations::dotProduct (const double* src1, const double* src2, int num) noexcept
+{
+   #if JUCE_USE_AVX_INTRINSICS
+    if (FloatVectorHelpers::isAVXAvailable())
+        return FloatVectorHelpers::dotProductAVX<FloatVectorHelpers::AVXOps64> (src1, src2, num);
+   #endif
+
+   #if JUCE_USE_VDSP_FRAMEWORK
+    double result;
+    vDSP_dotprD (src1, 1, src2, 1, &result, (vDSP_Length) num);
+    return result;
+   #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    return FloatVectorHelpers::DotProduct<FloatVectorHelpers::BasicOps64>::calculate (src1, src2, num);
+   #else
+    double result = 0;
+
+    for (int i = 0; i < num; ++i)
+        result += src1[i] * src2[i];
+
+    return result;
+   #endif
+}
+
 void JUCE_CALLTYPE FloatVectorOperations::enableFlushToZeroMode (bool shouldEnable) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS
@@ -1008,6 +1496,16 @@ public:
             u.expect (valuesMatch (FloatVectorOperations::findMinimum (data2, num), juce::findMinimum (data2, num)));
             u.expect (valuesMatch (FloatVectorOperations::findMaximum (data2, num), juce::findMaximum (data2, num)));
 
+            {
+                double expectedDotProduct = 0;
+
+                for (int i = 0; i < num; ++i)
+                    expectedDotProduct += (double) data1[i] * (double) data2[i];
+
+                const double dotProduct = (double) FloatVectorOperations::dotProduct (data1, data2, num);
+                u.expect (std::abs (dotProduct - expectedDotProduct) <= expectedDotProduct * 1.0e-5);
+            }
+
             FloatVectorOperations::clear (data1, num);
             u.expect (areAllValuesEqual (data1, num, 0));
 
@@ -194,6 +194,12 @@ public:
     /** Finds the maximum value in the given array. */
     static double JUCE_CALLTYPE findMaximum (const double* src, int numValues) noexcept;
 
+    /** Returns the sum of the products of each pair of corresponding elements in src1 and src2. */
+    static float JUCE_CALLTYPE dotProduct (const float* src1, const float* src2, int numValues) noexcept;
+
+    /** Returns the sum of the products of each pair of corresponding elements in src1 and src2. */
+    static double JUCE_CALLTYPE dotProduct (const double* src1, const double* src2, int numValues) noexcept;
+
     /** On Intel CPUs, this method enables or disables the SSE flush-to-zero mode.
         Effectively, this is a wrapper around a call to _MM_SET_FLUSH_ZERO_MODE
     */
@@ -27,197 +27,321 @@
 static FFT::Complex operator+ (FFT::Complex a, FFT::Complex b) noexcept     { FFT::Complex c = { a.r + b.r, a.i + b.i }; return c; }
 static FFT::Complex operator- (FFT::Complex a, FFT::Complex b) noexcept     { FFT::Complex c = { a.r - b.r, a.i - b.i }; return c; }
 static FFT::Complex operator* (FFT::Complex a, FFT::Complex b) noexcept     { FFT::Complex c = { a.r * b.r - a.i * b.i, a.r * b.i + a.i * b.r }; return c; }
-static FFT::Complex& operator+= (FFT::Complex& a, FFT::Complex b) noexcept  { a.r += b.r; a.i += b.i; return a; }
+static FFT::Complex operator* (FFT::Complex a, float b) noexcept            { FFT::Complex c = { a.r * b, a.i * b }; return c; }
+static FFT::Complex conjugate (FFT::Complex a) noexcept                     { FFT::Complex c = { a.r, -a.i }; return c; }
 
 //==============================================================================
+/*  The transform is done iteratively: the input is copied into bit-reversed order, then
+    log2 (size) radix-2 passes are applied in-place, fused together in pairs so that each
+    pass over the data does a radix-4 butterfly (with a single radix-2 pass first when the
+    order is odd). The twiddle factors for each radix-4 pass are laid out contiguously so
+    the inner loop just walks through them, and on SSE builds the butterflies operate on
+    two complex values at a time.
+
+    Real-only transforms of size N are done with a complex transform of size N / 2 on the
+    even/odd samples, followed by a single pass to untangle the two halves of the spectrum.
+*/
 struct FFT::FFTConfig
 {
     FFTConfig (int sizeOfFFT, bool isInverse)
-        : fftSize (sizeOfFFT), inverse (isInverse), twiddleTable ((size_t) sizeOfFFT)
+        : fftSize (sizeOfFFT), order (0), inverse (isInverse),
+          bitReversalTable ((size_t) sizeOfFFT),
+          twiddleTable ((size_t) jmax (1, sizeOfFFT))
     {
+        while ((1 << order) < fftSize)
+            ++order;
+
+        jassert ((1 << order) == fftSize);
+
         for (int i = 0; i < fftSize; ++i)
         {
-            const double phase = (isInverse ? 2.0 : -2.0) * double_Pi * i / fftSize;
-            twiddleTable[i].r = (float) cos (phase);
-            twiddleTable[i].i = (float) sin (phase);
+            int reversed = 0;
+
+            for (int bit = 0; bit < order; ++bit)
+                if ((i & (1 << bit)) != 0)
+                    reversed |= 1 << (order - 1 - bit);
+
+            bitReversalTable[i] = reversed;
         }
 
-        const int root = (int) std::sqrt ((double) fftSize);
-        int divisor = 4, n = fftSize;
+        // Each radix-4 pass of span m needs 3 * m twiddles, and the spans grow by 4 each time,
+        // so the total is always less than fftSize.
+        Complex* tw = twiddleTable;
 
-        for (int i = 0; i < numElementsInArray (factors); ++i)
+        for (int m = getFirstRadix4Span(); m < fftSize; m *= 4)
         {
-            while ((n % divisor) != 0)
+            for (int k = 0; k < m; ++k)
             {
-                if (divisor == 2)       divisor = 3;
-                else if (divisor == 4)  divisor = 2;
-                else                    divisor += 2;
-
-                if (divisor > root)
-                    divisor = n;
+                tw[k]         = getTwiddle (k, 4 * m);
+                tw[k + m]     = getTwiddle (2 * k, 4 * m);
+                tw[k + 2 * m] = getTwiddle (3 * k, 4 * m);
             }
 
-            n /= divisor;
-
-            jassert (divisor == 1 || divisor == 2 || divisor == 4);
-            factors[i].radix = divisor;
-            factors[i].length = n;
+            tw += 3 * m;
         }
+
+       #if JUCE_USE_VDSP_FRAMEWORK
+        fftSetup = order > 0 ? vDSP_create_fftsetup ((vDSP_Length) order, kFFTRadix2) : nullptr;
+       #endif
     }
 
-    void perform (const Complex* input, Complex* output) const noexcept
+    ~FFTConfig()
     {
-        perform (input, output, 1, 1, factors);
+       #if JUCE_USE_VDSP_FRAMEWORK
+        if (fftSetup != nullptr)
+            vDSP_destroy_fftsetup (fftSetup);
+       #endif
     }
 
-    const int fftSize;
-    const bool inverse;
+    void prepareRealTransforms()
+    {
+        if (fftSize >= 4)
+        {
+            const int halfSize = fftSize / 2;
+            realTransformConfig = new FFTConfig (halfSize, inverse);
+            realTwiddleTable.malloc ((size_t) halfSize);
 
-    struct Factor { int radix, length; };
-    Factor factors[32];
-    HeapBlock<Complex> twiddleTable;
+            for (int k = 0; k < halfSize; ++k)
+                realTwiddleTable[k] = getTwiddle (k, fftSize);
+        }
+    }
 
-    void perform (const Complex* input, Complex* output, const int stride, const int strideIn, const Factor* facs) const noexcept
+    Complex getTwiddle (int index, int period) const noexcept
     {
-        const Factor factor (*facs++);
-        Complex* const originalOutput = output;
-        const Complex* const outputEnd = output + factor.radix * factor.length;
+        const double phase = (inverse ? 2.0 : -2.0) * double_Pi * index / period;
+        const Complex c = { (float) std::cos (phase), (float) std::sin (phase) };
+        return c;
+    }
 
-        if (stride == 1 && factor.radix <= 5)
+    //==============================================================================
+    void perform (const Complex* input, Complex* output) const noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        if (fftSetup != nullptr)
         {
-            for (int i = 0; i < factor.radix; ++i)
-                perform (input + stride * strideIn * i, output + i * factor.length, stride * factor.radix, strideIn, facs);
+            float* const splitData = static_cast<float*> (alloca (sizeof (float) * 2 * (size_t) fftSize));
+            DSPSplitComplex split = { splitData, splitData + fftSize };
 
-            butterfly (factor, output, stride);
+            vDSP_ctoz (reinterpret_cast<const DSPComplex*> (input), 2, &split, 1, (vDSP_Length) fftSize);
+            vDSP_fft_zip (fftSetup, &split, 1, (vDSP_Length) order, inverse ? kFFTDirection_Inverse : kFFTDirection_Forward);
+            vDSP_ztoc (&split, 1, reinterpret_cast<DSPComplex*> (output), 2, (vDSP_Length) fftSize);
             return;
         }
+       #endif
 
-        if (factor.length == 1)
+        if (input == output)
         {
-            do
+            for (int i = 0; i < fftSize; ++i)
             {
-                *output++ = *input;
-                input += stride * strideIn;
+                const int j = bitReversalTable[i];
+
+                if (i < j)
+                    std::swap (output[i], output[j]);
             }
-            while (output < outputEnd);
         }
         else
         {
-            do
-            {
-                perform (input, output, stride * factor.radix, strideIn, facs);
-                input += stride * strideIn;
-                output += factor.length;
-            }
-            while (output < outputEnd);
+            for (int i = 0; i < fftSize; ++i)
+                output[bitReversalTable[i]] = input[i];
         }
 
-        butterfly (factor, originalOutput, stride);
+        if ((order & 1) != 0)
+            performRadix2Pass (output);
+
+        const Complex* tw = twiddleTable;
+
+        for (int m = getFirstRadix4Span(); m < fftSize; m *= 4)
+        {
+            performRadix4Pass (output, m, tw);
+            tw += 3 * m;
+        }
     }
 
-    void butterfly (const Factor factor, Complex* data, const int stride) const noexcept
+    void performRealForward (float* d) const noexcept
     {
-        switch (factor.radix)
+        const int halfSize = fftSize / 2;
+        Complex* const scratch = static_cast<Complex*> (alloca (sizeof (Complex) * (size_t) halfSize));
+
+        // Treating the even and odd samples as real and imaginary parts, this gives us
+        // Z[k] = E[k] + i O[k], where E and O are the spectra of the even and odd samples.
+        realTransformConfig->perform (reinterpret_cast<const Complex*> (d), scratch);
+
+        Complex* const out = reinterpret_cast<Complex*> (d);
+
+        for (int k = 0; k <= halfSize; ++k)
         {
-            case 1:   break;
-            case 2:   butterfly2 (data, stride, factor.length); return;
-            case 4:   butterfly4 (data, stride, factor.length); return;
-            default:  jassertfalse; break;
+            const Complex z  = scratch[k & (halfSize - 1)];
+            const Complex zc = conjugate (scratch[(halfSize - k) & (halfSize - 1)]);
+
+            const Complex even = (z + zc) * 0.5f;
+            const Complex diff = (z - zc) * 0.5f;
+            const Complex odd  = { diff.i, -diff.r }; // diff / i
+
+            if (k < halfSize)
+                out[k] = even + realTwiddleTable[k] * odd;
+            else
+                out[k] = even - odd; // (the twiddle for k = N / 2 is -1)
         }
 
-        Complex* scratch = static_cast<Complex*> (alloca (sizeof (Complex) * (size_t) factor.radix));
+        for (int k = 1; k < halfSize; ++k)
+            out[fftSize - k] = conjugate (out[k]);
+    }
+
+    void performRealInverse (float* d) const noexcept
+    {
+        const int halfSize = fftSize / 2;
+        Complex* const scratch = static_cast<Complex*> (alloca (sizeof (Complex) * (size_t) halfSize));
+        const Complex* const in = reinterpret_cast<const Complex*> (d);
 
-        for (int i = 0; i < factor.length; ++i)
+        for (int k = 0; k < halfSize; ++k)
         {
-            for (int k = i, q1 = 0; q1 < factor.radix; ++q1)
-            {
-                scratch[q1] = data[k];
-                k += factor.length;
-            }
+            const Complex x  = in[k];
+            const Complex xc = conjugate (in[halfSize - k]);
 
-            for (int k = i, q1 = 0; q1 < factor.radix; ++q1)
-            {
-                int twiddleIndex = 0;
-                data[k] = scratch[0];
+            const Complex even = x + xc;
+            const Complex odd  = (x - xc) * realTwiddleTable[k];
 
-                for (int q = 1; q < factor.radix; ++q)
-                {
-                    twiddleIndex += stride * k;
+            const Complex z = { even.r - odd.i, even.i + odd.r }; // even + i * odd
+            scratch[k] = z;
+        }
 
-                    if (twiddleIndex >= fftSize)
-                        twiddleIndex -= fftSize;
+        // The result comes out with the even and odd samples interleaved, which is just
+        // the order we want them in.
+        realTransformConfig->perform (scratch, reinterpret_cast<Complex*> (d));
 
-                    data[k] += scratch[q] * twiddleTable[twiddleIndex];
-                }
+        FloatVectorOperations::multiply (d, 1.0f / fftSize, fftSize);
+        FloatVectorOperations::clear (d + fftSize, fftSize);
+    }
 
-                k += factor.length;
-            }
+    bool canDoRealTransforms() const noexcept    { return realTransformConfig != nullptr; }
+
+    const int fftSize;
+    int order;
+    const bool inverse;
+
+    HeapBlock<int> bitReversalTable;
+    HeapBlock<Complex> twiddleTable, realTwiddleTable;
+    ScopedPointer<FFTConfig> realTransformConfig;
+
+   #if JUCE_USE_VDSP_FRAMEWORK
+    FFTSetup fftSetup;
+   #endif
+
+private:
+    int getFirstRadix4Span() const noexcept      { return (order & 1) != 0 ? 2 : 1; }
+
+    void performRadix2Pass (Complex* data) const noexcept
+    {
+        for (int i = 0; i < fftSize; i += 2)
+        {
+            const Complex a (data[i]);
+            const Complex b (data[i + 1]);
+            data[i]     = a + b;
+            data[i + 1] = a - b;
         }
     }
 
-    void butterfly2 (Complex* data, const int stride, const int length) const noexcept
+    // Does two fused radix-2 passes, of spans m and 2m. The twiddles for each k are
+    // W(k), W(2k) and W(3k), where W is the 4m-th root of unity.
+    void performRadix4Pass (Complex* const data, const int m, const Complex* const twiddles) const noexcept
     {
-        Complex* dataEnd = data + length;
-        const Complex* tw = twiddleTable;
+       #if JUCE_USE_SSE_INTRINSICS
+        if (m >= 2)
+        {
+            performRadix4PassSSE (data, m, twiddles);
+            return;
+        }
+       #endif
 
-        for (int i = length; --i >= 0;)
+        const Complex* const tw1 = twiddles;
+        const Complex* const tw2 = twiddles + m;
+        const Complex* const tw3 = twiddles + 2 * m;
+
+        for (int block = 0; block < fftSize; block += 4 * m)
         {
-            const Complex s (*dataEnd * *tw);
-            tw += stride;
-            *dataEnd++ = *data - s;
-            *data++ += s;
+            Complex* const d = data + block;
+
+            for (int k = 0; k < m; ++k)
+            {
+                const Complex t1 = d[k + m]     * tw2[k];
+                const Complex t2 = d[k + 2 * m] * tw1[k];
+                const Complex t3 = d[k + 3 * m] * tw3[k];
+
+                const Complex b0 = d[k] + t1;
+                const Complex b1 = d[k] - t1;
+                const Complex b2 = t2 + t3;
+                const Complex diff = t2 - t3;
+
+                // multiply by -i for a forward transform, or +i for an inverse one
+                const Complex b3 = { inverse ? -diff.i : diff.i,
+                                     inverse ? diff.r : -diff.r };
+
+                d[k]         = b0 + b2;
+                d[k + m]     = b1 + b3;
+                d[k + 2 * m] = b0 - b2;
+                d[k + 3 * m] = b1 - b3;
+            }
         }
     }
 
-    void butterfly4 (Complex* data, const int stride, const int length) const noexcept
+   #if JUCE_USE_SSE_INTRINSICS
+    // Multiplies two pairs of interleaved complex numbers
+    static forcedinline __m128 multiplyComplex (__m128 a, __m128 w, __m128 negateRealParts) noexcept
+    {
+        const __m128 wr = _mm_shuffle_ps (w, w, _MM_SHUFFLE (2, 2, 0, 0));
+        const __m128 wi = _mm_shuffle_ps (w, w, _MM_SHUFFLE (3, 3, 1, 1));
+        const __m128 swapped = _mm_shuffle_ps (a, a, _MM_SHUFFLE (2, 3, 0, 1));
+
+        return _mm_add_ps (_mm_mul_ps (a, wr), _mm_mul_ps (_mm_xor_ps (swapped, negateRealParts), wi));
+    }
+
+    void performRadix4PassSSE (Complex* const data, const int m, const Complex* const twiddles) const noexcept
     {
-        const int lengthX2 = length * 2;
-        const int lengthX3 = length * 3;
+        const __m128 negateRealParts = _mm_set_ps (0.0f, -0.0f, 0.0f, -0.0f);
+        const __m128 negateImagParts = _mm_set_ps (-0.0f, 0.0f, -0.0f, 0.0f);
+        const __m128 rotationSign = inverse ? negateRealParts : negateImagParts;
 
-        const Complex* twiddle1 = twiddleTable;
-        const Complex* twiddle2 = twiddle1;
-        const Complex* twiddle3 = twiddle1;
+        const float* const tw1 = reinterpret_cast<const float*> (twiddles);
+        const float* const tw2 = reinterpret_cast<const float*> (twiddles + m);
+        const float* const tw3 = reinterpret_cast<const float*> (twiddles + 2 * m);
+        const int stride = 2 * m; // (in floats)
 
-        for (int i = length; --i >= 0;)
+        for (int block = 0; block < fftSize; block += 4 * m)
         {
-            const Complex s0 = data[length]   * *twiddle1;
-            const Complex s1 = data[lengthX2] * *twiddle2;
-            const Complex s2 = data[lengthX3] * *twiddle3;
-            const Complex s3 = s0 + s2;
-            const Complex s4 = s0 - s2;
-            const Complex s5 = *data - s1;
-            *data += s1;
-            data[lengthX2] = *data - s3;
-            twiddle1 += stride;
-            twiddle2 += stride * 2;
-            twiddle3 += stride * 3;
-            *data += s3;
-
-            if (inverse)
-            {
-                data[length].r   = s5.r - s4.i;
-                data[length].i   = s5.i + s4.r;
-                data[lengthX3].r = s5.r + s4.i;
-                data[lengthX3].i = s5.i - s4.r;
-            }
-            else
+            float* const d = reinterpret_cast<float*> (data + block);
+
+            for (int k = 0; k < stride; k += 4)
             {
-                data[length].r   = s5.r + s4.i;
-                data[length].i   = s5.i - s4.r;
-                data[lengthX3].r = s5.r - s4.i;
-                data[lengthX3].i = s5.i + s4.r;
+                const __m128 t1 = multiplyComplex (_mm_loadu_ps (d + k + stride),     _mm_loadu_ps (tw2 + k), negateRealParts);
+                const __m128 t2 = multiplyComplex (_mm_loadu_ps (d + k + 2 * stride), _mm_loadu_ps (tw1 + k), negateRealParts);
+                const __m128 t3 = multiplyComplex (_mm_loadu_ps (d + k + 3 * stride), _mm_loadu_ps (tw3 + k), negateRealParts);
+                const __m128 d0 = _mm_loadu_ps (d + k);
+
+                const __m128 b0 = _mm_add_ps (d0, t1);
+                const __m128 b1 = _mm_sub_ps (d0, t1);
+                const __m128 b2 = _mm_add_ps (t2, t3);
+                const __m128 diff = _mm_sub_ps (t2, t3);
+                const __m128 b3 = _mm_xor_ps (_mm_shuffle_ps (diff, diff, _MM_SHUFFLE (2, 3, 0, 1)), rotationSign);
+
+                _mm_storeu_ps (d + k,              _mm_add_ps (b0, b2));
+                _mm_storeu_ps (d + k + stride,     _mm_add_ps (b1, b3));
+                _mm_storeu_ps (d + k + 2 * stride, _mm_sub_ps (b0, b2));
+                _mm_storeu_ps (d + k + 3 * stride, _mm_sub_ps (b1, b3));
             }
-
-            ++data;
         }
     }
+   #endif
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FFTConfig)
 };
 
 
 //==============================================================================
-FFT::FFT (int order, bool inverse)  : config (new FFTConfig (1 << order, inverse)), size (1 << order) {}
+FFT::FFT (int order, bool inverse)  : config (new FFTConfig (1 << order, inverse)), size (1 << order)
+{
+    config->prepareRealTransforms();
+}
+
 FFT::~FFT() {}
 
 void FFT::perform (const Complex* const input, Complex* const output) const noexcept
@@ -230,6 +354,12 @@ void FFT::performRealOnlyForwardTransform (float* d) const noexcept
     // This can only be called on an FFT object that was created to do forward transforms.
     jassert (! config->inverse);
 
+    if (config->canDoRealTransforms())
+    {
+        config->performRealForward (d);
+        return;
+    }
+
     Complex* const scratch = static_cast<Complex*> (alloca (16 + sizeof (Complex) * (size_t) size));
 
     for (int i = 0; i < size; ++i)
@@ -246,6 +376,12 @@ void FFT::performRealOnlyInverseTransform (float* d) const noexcept
     // This can only be called on an FFT object that was created to do inverse transforms.
     jassert (config->inverse);
 
+    if (config->canDoRealTransforms())
+    {
+        config->performRealInverse (d);
+        return;
+    }
+
     Complex* const scratch = static_cast<Complex*> (alloca (16 + sizeof (Complex) * (size_t) size));
 
     perform (reinterpret_cast<const Complex*> (d), scratch);
@@ -275,3 +411,98 @@ void FFT::performFrequencyOnlyForwardTransform (float* d) const noexcept
         }
     }
 }
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class FFTTests  : public UnitTest
+{
+public:
+    FFTTests() : UnitTest ("FFT") {}
+
+    static void performReferenceFourier (const FFT::Complex* in, FFT::Complex* out, int size, bool isInverse)
+    {
+        for (int i = 0; i < size; ++i)
+        {
+            double r = 0, im = 0;
+
+            for (int k = 0; k < size; ++k)
+            {
+                const double phase = (isInverse ? 2.0 : -2.0) * double_Pi * i * k / size;
+                r  += in[k].r * std::cos (phase) - in[k].i * std::sin (phase);
+                im += in[k].r * std::sin (phase) + in[k].i * std::cos (phase);
+            }
+
+            out[i].r = (float) r;
+            out[i].i = (float) im;
+        }
+    }
+
+    void expectClose (const float* a, const float* b, int num, float tolerance)
+    {
+        float maxError = 0;
+
+        for (int i = 0; i < num; ++i)
+            maxError = jmax (maxError, std::abs (a[i] - b[i]));
+
+        expect (maxError <= tolerance, "max error: " + String (maxError));
+    }
+
+    void runTest() override
+    {
+        beginTest ("FFT");
+
+        Random random (getRandom());
+
+        for (int order = 0; order <= 10; ++order)
+        {
+            const int size = 1 << order;
+            const float tolerance = 1.0e-5f * size;
+
+            HeapBlock<FFT::Complex> input ((size_t) size), output ((size_t) size), reference ((size_t) size);
+
+            for (int i = 0; i < size; ++i)
+            {
+                input[i].r = random.nextFloat() * 2.0f - 1.0f;
+                input[i].i = random.nextFloat() * 2.0f - 1.0f;
+            }
+
+            for (int inverse = 0; inverse < 2; ++inverse)
+            {
+                FFT fft (order, inverse != 0);
+                fft.perform (input, output);
+                performReferenceFourier (input, reference, size, inverse != 0);
+
+                expectClose (&output->r, &reference->r, size * 2, tolerance);
+            }
+
+            // real-only transforms, which should round-trip back to the original samples
+            HeapBlock<float> realData ((size_t) size * 2);
+
+            for (int i = 0; i < size; ++i)
+            {
+                realData[i] = input[i].r;
+                input[i].i = 0;
+            }
+
+            FFT forward (order, false), inverse (order, true);
+
+            forward.performRealOnlyForwardTransform (realData);
+            performReferenceFourier (input, reference, size, false);
+            expectClose (realData, &reference->r, size * 2, tolerance);
+
+            inverse.performRealOnlyInverseTransform (realData);
+
+            float maxError = 0;
+
+            for (int i = 0; i < size; ++i)
+                maxError = jmax (maxError, std::abs (realData[i] - input[i].r));
+
+            expect (maxError <= tolerance, "max error: " + String (maxError));
+        }
+    }
+};
+
+static FFTTests fftTests;
+
+#endif
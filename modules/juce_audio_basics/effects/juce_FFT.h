@@ -23,11 +23,11 @@
 */
 
 /**
-    A very minimal FFT class.
+    A simple power-of-two FFT class.
 
-    This is only a simple low-footprint implementation and isn't tuned for speed - it may
-    be useful for simple applications where one of the more complex FFT libraries would be
-    overkill. (But in the future it may end up becoming optimised of course...)
+    This uses an iterative radix-4 implementation with pre-computed twiddle tables (and SSE
+    where available), or the vDSP library on OSX/iOS. Real-only transforms are done with a
+    complex transform of half the size, so are roughly twice as fast as complex ones.
 
     The FFT class itself contains lookup tables, so there's some overhead in creating
     one, you should create and cache an FFT object for each size/direction of transform
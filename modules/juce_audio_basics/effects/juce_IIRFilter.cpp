@@ -241,4 +241,333 @@ void IIRFilter::processSamples (float* const samples, const int numSamples) noex
     }
 }
 
+//==============================================================================
+MultiChannelIIRFilter::MultiChannelIIRFilter (int initialNumChannels, int initialNumStages)
+    : numChannels (jmax (0, initialNumChannels)), numStages (0)
+{
+    setNumStages (initialNumStages);
+}
+
+MultiChannelIIRFilter::~MultiChannelIIRFilter() noexcept
+{
+}
+
+void MultiChannelIIRFilter::allocateState()
+{
+    // Each group of channels has a v1 and v2 value for each lane of each stage
+    state.calloc ((size_t) (jmax (1, getNumGroups() * numStages * 2 * channelsPerGroup)));
+}
+
+void MultiChannelIIRFilter::setNumChannels (const int newNumChannels)
+{
+    const SpinLock::ScopedLockType sl (processLock);
+    numChannels = jmax (0, newNumChannels);
+    allocateState();
+}
+
+void MultiChannelIIRFilter::setNumStages (const int newNumStages)
+{
+    const SpinLock::ScopedLockType sl (processLock);
+    numStages = jmax (0, newNumStages);
+
+    coefficients.resize (numStages);
+    stageActive.resize (numStages);
+    allocateState();
+}
+
+void MultiChannelIIRFilter::setCoefficients (const int stageIndex, const IIRCoefficients& newCoefficients) noexcept
+{
+    jassert (isPositiveAndBelow (stageIndex, numStages));
+
+    const SpinLock::ScopedLockType sl (processLock);
+
+    if (isPositiveAndBelow (stageIndex, numStages))
+    {
+        coefficients.getReference (stageIndex) = newCoefficients;
+        stageActive.set (stageIndex, true);
+    }
+}
+
+IIRCoefficients MultiChannelIIRFilter::getCoefficients (const int stageIndex) const noexcept
+{
+    return coefficients [stageIndex];
+}
+
+void MultiChannelIIRFilter::makeStageInactive (const int stageIndex) noexcept
+{
+    const SpinLock::ScopedLockType sl (processLock);
+
+    if (isPositiveAndBelow (stageIndex, numStages))
+        stageActive.set (stageIndex, false);
+}
+
+bool MultiChannelIIRFilter::isStageActive (const int stageIndex) const noexcept
+{
+    return stageActive [stageIndex];
+}
+
+void MultiChannelIIRFilter::reset() noexcept
+{
+    const SpinLock::ScopedLockType sl (processLock);
+    zeromem (state, sizeof (float) * (size_t) (getNumGroups() * numStages * 2 * channelsPerGroup));
+}
+
+void MultiChannelIIRFilter::processSamples (AudioSampleBuffer& buffer, int startSample, int numSamples) noexcept
+{
+    jassert (startSample >= 0 && startSample + numSamples <= buffer.getNumSamples());
+
+    const int numToProcess = jmin (numChannels, buffer.getNumChannels());
+    float** const channels = static_cast<float**> (alloca (sizeof (float*) * (size_t) jmax (1, numToProcess)));
+
+    for (int i = 0; i < numToProcess; ++i)
+        channels[i] = buffer.getWritePointer (i, startSample);
+
+    processSamples (channels, numToProcess, numSamples);
+}
+
+void MultiChannelIIRFilter::processSamples (float* const* channels, int numToProcess, const int numSamples) noexcept
+{
+    jassert (numToProcess <= numChannels);
+    numToProcess = jmin (numToProcess, numChannels);
+
+    const SpinLock::ScopedLockType sl (processLock);
+
+    int* const activeStages = static_cast<int*> (alloca (sizeof (int) * (size_t) jmax (1, numStages)));
+    int numActiveStages = 0;
+
+    for (int i = 0; i < numStages; ++i)
+        if (stageActive.getUnchecked (i))
+            activeStages[numActiveStages++] = i;
+
+    if (numActiveStages == 0)
+        return;
+
+    const int floatsPerGroup = numStages * 2 * channelsPerGroup;
+
+    for (int group = 0; group * channelsPerGroup < numToProcess; ++group)
+    {
+        float* groupChannels[channelsPerGroup];
+
+        for (int lane = 0; lane < channelsPerGroup; ++lane)
+        {
+            const int channel = group * channelsPerGroup + lane;
+            groupChannels[lane] = channel < numToProcess ? channels[channel] : nullptr;
+        }
+
+        float* const groupState = state + group * floatsPerGroup;
+        processGroup (groupChannels, activeStages, numActiveStages, groupState, numSamples);
+
+        for (int i = 0; i < floatsPerGroup; ++i)
+        {
+            JUCE_SNAP_TO_ZERO (groupState[i]);
+        }
+    }
+}
+
+#if JUCE_USE_SSE_INTRINSICS
+namespace IIRFilterHelpers
+{
+    struct VectorCoefficients
+    {
+        VectorCoefficients (const float* c) noexcept
+            : c0 (_mm_set1_ps (c[0])), c1 (_mm_set1_ps (c[1])), c2 (_mm_set1_ps (c[2])),
+              c3 (_mm_set1_ps (c[3])), c4 (_mm_set1_ps (c[4]))
+        {}
+
+        // Transposed direct form II, with each lane holding a different channel
+        forcedinline __m128 process (const __m128 in, __m128& v1, __m128& v2) const noexcept
+        {
+            const __m128 out = _mm_add_ps (_mm_mul_ps (c0, in), v1);
+            v1 = _mm_add_ps (_mm_sub_ps (_mm_mul_ps (c1, in), _mm_mul_ps (c3, out)), v2);
+            v2 = _mm_sub_ps (_mm_mul_ps (c2, in), _mm_mul_ps (c4, out));
+            return out;
+        }
+
+        __m128 c0, c1, c2, c3, c4;
+    };
+}
+#endif
+
+void MultiChannelIIRFilter::processGroup (float** const channels, const int* const activeStages, const int numActiveStages,
+                                          float* const groupState, const int numSamples) noexcept
+{
+    // Missing channels in the last group are fed with silence, so their state stays at zero
+    const int chunkSize = 64;
+    float silence[channelsPerGroup][chunkSize];
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const int num = jmin (chunkSize, numSamples - start);
+        float* lanes[channelsPerGroup];
+
+        for (int lane = 0; lane < channelsPerGroup; ++lane)
+        {
+            if (channels[lane] != nullptr)
+            {
+                lanes[lane] = channels[lane] + start;
+            }
+            else
+            {
+                zeromem (silence[lane], sizeof (float) * (size_t) num);
+                lanes[lane] = silence[lane];
+            }
+        }
+
+       #if JUCE_USE_SSE_INTRINSICS
+        using namespace IIRFilterHelpers;
+        int i = 0;
+
+        for (; i + 4 <= num; i += 4)
+        {
+            __m128 x0 = _mm_loadu_ps (lanes[0] + i);
+            __m128 x1 = _mm_loadu_ps (lanes[1] + i);
+            __m128 x2 = _mm_loadu_ps (lanes[2] + i);
+            __m128 x3 = _mm_loadu_ps (lanes[3] + i);
+
+            // after this, each vector holds one time-step for all four channels
+            _MM_TRANSPOSE4_PS (x0, x1, x2, x3);
+
+            for (int n = 0; n < numActiveStages; ++n)
+            {
+                const int stage = activeStages[n];
+                const VectorCoefficients c (coefficients.getReference (stage).coefficients);
+                float* const stageState = groupState + stage * 2 * channelsPerGroup;
+
+                __m128 v1 = _mm_loadu_ps (stageState);
+                __m128 v2 = _mm_loadu_ps (stageState + channelsPerGroup);
+
+                x0 = c.process (x0, v1, v2);
+                x1 = c.process (x1, v1, v2);
+                x2 = c.process (x2, v1, v2);
+                x3 = c.process (x3, v1, v2);
+
+                _mm_storeu_ps (stageState, v1);
+                _mm_storeu_ps (stageState + channelsPerGroup, v2);
+            }
+
+            _MM_TRANSPOSE4_PS (x0, x1, x2, x3);
+
+            _mm_storeu_ps (lanes[0] + i, x0);
+            _mm_storeu_ps (lanes[1] + i, x1);
+            _mm_storeu_ps (lanes[2] + i, x2);
+            _mm_storeu_ps (lanes[3] + i, x3);
+        }
+
+        for (; i < num; ++i)
+        {
+            float values[channelsPerGroup] = { lanes[0][i], lanes[1][i], lanes[2][i], lanes[3][i] };
+            __m128 x = _mm_loadu_ps (values);
+
+            for (int n = 0; n < numActiveStages; ++n)
+            {
+                const int stage = activeStages[n];
+                const VectorCoefficients c (coefficients.getReference (stage).coefficients);
+                float* const stageState = groupState + stage * 2 * channelsPerGroup;
+
+                __m128 v1 = _mm_loadu_ps (stageState);
+                __m128 v2 = _mm_loadu_ps (stageState + channelsPerGroup);
+                x = c.process (x, v1, v2);
+                _mm_storeu_ps (stageState, v1);
+                _mm_storeu_ps (stageState + channelsPerGroup, v2);
+            }
+
+            _mm_storeu_ps (values, x);
+
+            for (int lane = 0; lane < channelsPerGroup; ++lane)
+                lanes[lane][i] = values[lane];
+        }
+       #else
+        for (int lane = 0; lane < channelsPerGroup; ++lane)
+        {
+            float* const samples = lanes[lane];
+
+            for (int i = 0; i < num; ++i)
+            {
+                float x = samples[i];
+
+                for (int n = 0; n < numActiveStages; ++n)
+                {
+                    const int stage = activeStages[n];
+                    const float* const c = coefficients.getReference (stage).coefficients;
+                    float* const stageState = groupState + stage * 2 * channelsPerGroup + lane;
+                    float& v1 = stageState[0];
+                    float& v2 = stageState[channelsPerGroup];
+
+                    const float out = c[0] * x + v1;
+                    v1 = c[1] * x - c[3] * out + v2;
+                    v2 = c[2] * x - c[4] * out;
+                    x = out;
+                }
+
+                samples[i] = x;
+            }
+        }
+       #endif
+    }
+}
+
 #undef JUCE_SNAP_TO_ZERO
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MultiChannelIIRFilterTests  : public UnitTest
+{
+public:
+    MultiChannelIIRFilterTests() : UnitTest ("MultiChannelIIRFilter") {}
+
+    void runTest() override
+    {
+        beginTest ("Matches cascaded IIRFilters");
+
+        Random random (getRandom());
+
+        const int numChannels = 6, numStages = 3, numSamples = 1000;
+        const IIRCoefficients coeffs[numStages] = { IIRCoefficients::makeLowPass (44100.0, 5000.0),
+                                                    IIRCoefficients::makePeakFilter (44100.0, 1000.0, 0.7, 2.0f),
+                                                    IIRCoefficients::makeHighPass (44100.0, 50.0) };
+
+        MultiChannelIIRFilter filter (numChannels, numStages);
+        OwnedArray<IIRFilter> references;
+
+        for (int stage = 0; stage < numStages; ++stage)
+            filter.setCoefficients (stage, coeffs[stage]);
+
+        for (int i = 0; i < numChannels * numStages; ++i)
+        {
+            references.add (new IIRFilter());
+            references.getLast()->setCoefficients (coeffs[i % numStages]);
+        }
+
+        AudioSampleBuffer buffer (numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        AudioSampleBuffer expected (buffer);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int stage = 0; stage < numStages; ++stage)
+                references.getUnchecked (ch * numStages + stage)->processSamples (expected.getWritePointer (ch), numSamples);
+
+        for (int start = 0; start < numSamples;)
+        {
+            const int num = jmin (numSamples - start, 1 + random.nextInt (100));
+            filter.processSamples (buffer, start, num);
+            start += num;
+        }
+
+        float maxError = 0;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                maxError = jmax (maxError, std::abs (buffer.getSample (ch, i) - expected.getSample (ch, i)));
+
+        expect (maxError < 1.0e-4f, "max error: " + String (maxError));
+    }
+};
+
+static MultiChannelIIRFilterTests multiChannelIIRFilterTests;
+
+#endif
@@ -170,5 +170,88 @@ protected:
     JUCE_LEAK_DETECTOR (IIRFilter)
 };
 
+//==============================================================================
+/**
+    A cascade of biquad IIR filters that processes a number of channels in parallel.
+
+    Each stage in the cascade has its own set of coefficients, which are shared by all
+    the channels. Where SSE is available, the channels are processed in groups of four,
+    one per vector lane, and all the stages are applied in a single pass through the
+    data, so an N-band EQ doesn't need to walk the buffer N times.
+
+    @see IIRFilter, IIRCoefficients
+*/
+class JUCE_API  MultiChannelIIRFilter
+{
+public:
+    //==============================================================================
+    /** Creates a filter with the given number of channels and stages.
+        All the stages are initially inactive.
+    */
+    MultiChannelIIRFilter (int numChannels = 2, int numStages = 1);
+
+    /** Destructor. */
+    ~MultiChannelIIRFilter() noexcept;
+
+    //==============================================================================
+    /** Changes the number of channels that the filter can process.
+        The stages' coefficients are kept, but the filter's state is reset.
+    */
+    void setNumChannels (int newNumChannels);
+
+    /** Returns the number of channels that the filter can process. */
+    int getNumChannels() const noexcept                     { return numChannels; }
+
+    /** Changes the number of cascaded stages.
+        Any existing stages keep their coefficients, and any new ones are inactive.
+        The filter's state is reset.
+    */
+    void setNumStages (int newNumStages);
+
+    /** Returns the number of cascaded stages. */
+    int getNumStages() const noexcept                       { return numStages; }
+
+    //==============================================================================
+    /** Applies a set of coefficients to one of the stages, and makes it active. */
+    void setCoefficients (int stageIndex, const IIRCoefficients& newCoefficients) noexcept;
+
+    /** Returns the coefficients that one of the stages is using. */
+    IIRCoefficients getCoefficients (int stageIndex) const noexcept;
+
+    /** Makes one of the stages pass its input through unchanged. */
+    void makeStageInactive (int stageIndex) noexcept;
+
+    /** Returns true if the given stage has been given some coefficients. */
+    bool isStageActive (int stageIndex) const noexcept;
+
+    //==============================================================================
+    /** Resets the state of all the stages, without changing their coefficients. */
+    void reset() noexcept;
+
+    /** Filters a set of channels in-place.
+        The number of channels must not be more than getNumChannels().
+    */
+    void processSamples (float* const* channels, int numChannelsToProcess, int numSamples) noexcept;
+
+    /** Filters a section of an AudioSampleBuffer in-place. */
+    void processSamples (AudioSampleBuffer& buffer, int startSample, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    SpinLock processLock;
+    Array<IIRCoefficients> coefficients;
+    Array<bool> stageActive;
+    HeapBlock<float> state;
+    int numChannels, numStages;
+
+    enum { channelsPerGroup = 4 };
+
+    void allocateState();
+    int getNumGroups() const noexcept       { return (numChannels + channelsPerGroup - 1) / channelsPerGroup; }
+    void processGroup (float** channels, const int* activeStages, int numActiveStages, float* groupState, int numSamples) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultiChannelIIRFilter)
+};
+
 
 #endif   // JUCE_IIRFILTER_H_INCLUDED
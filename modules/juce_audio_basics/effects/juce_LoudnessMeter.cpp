@@ -0,0 +1,477 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+namespace LoudnessMeterHelpers
+{
+    // The two stages of the K-weighting filter: a high shelf that models the acoustic effect
+    // of the head, followed by the "RLB" high-pass. BS.1770 only gives coefficients for 48KHz,
+    // so these are re-derived from the analogue prototypes for other rates.
+    static IIRCoefficients makeKWeightingShelf (const double sampleRate) noexcept
+    {
+        const double k = std::tan (double_Pi * 1681.974450955533 / sampleRate);
+        const double q = 0.7071752369554196;
+        const double vh = std::pow (10.0, 3.999843853973347 / 20.0);
+        const double vb = std::pow (vh, 0.4996667741545416);
+
+        return IIRCoefficients (vh + vb * k / q + k * k, 2.0 * (k * k - vh), vh - vb * k / q + k * k,
+                                1.0 + k / q + k * k,     2.0 * (k * k - 1.0), 1.0 - k / q + k * k);
+    }
+
+    static IIRCoefficients makeKWeightingHighPass (const double sampleRate) noexcept
+    {
+        const double k = std::tan (double_Pi * 38.13547087602444 / sampleRate);
+        const double q = 0.5003270373238773;
+        const double a0 = 1.0 + k / q + k * k;
+
+        return IIRCoefficients (a0, -2.0 * a0, a0,
+                                a0, 2.0 * (k * k - 1.0), 1.0 - k / q + k * k);
+    }
+
+    static float energyToLoudness (const double meanSquare) noexcept
+    {
+        return meanSquare > 0 ? (float) jmax (-100.0, -0.691 + 10.0 * std::log10 (meanSquare))
+                              : -100.0f;
+    }
+
+    // The histogram's bins are 0.1 LU wide, starting at the absolute gate of -70 LUFS.
+    static int getHistogramBin (const double loudness, const int numBins) noexcept
+    {
+        return jlimit (0, numBins - 1, (int) ((loudness + 70.0) * 10.0));
+    }
+
+    // zeroth-order modified bessel function of the first kind, for the kaiser window
+    static double besselI0 (const double x) noexcept
+    {
+        const double halfX = x * 0.5;
+        double sum = 1.0, term = 1.0;
+
+        for (int k = 1; k < 64 && term > sum * 1.0e-12; ++k)
+        {
+            const double t = halfX / k;
+            term *= t * t;
+            sum += term;
+        }
+
+        return sum;
+    }
+}
+
+//==============================================================================
+struct LoudnessMeter::TruePeakChannel
+{
+    TruePeakChannel() : history ((size_t) tapsPerPhase * 2, true), historyPos (0), peak (0)
+    {
+    }
+
+    void reset() noexcept
+    {
+        history.clear ((size_t) tapsPerPhase * 2);
+        historyPos = 0;
+        peak = 0;
+        publishedPeak = 0.0f;
+    }
+
+    // The history is stored twice over, so that the most recent taps can always be read
+    // as a contiguous block.
+    void process (const float* const samples, const int numSamples,
+                  const float* const coefficients, const int numPhases) noexcept
+    {
+        float localPeak = peak;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            historyPos = (historyPos == 0 ? (int) tapsPerPhase : historyPos) - 1;
+            history[historyPos] = history[historyPos + tapsPerPhase] = samples[i];
+
+            const float* const taps = history + historyPos;
+
+            for (int phase = 0; phase < numPhases; ++phase)
+            {
+                const float* const c = coefficients + phase * tapsPerPhase;
+                float sum = 0;
+
+                for (int k = 0; k < tapsPerPhase; ++k)
+                    sum += c[k] * taps[k];
+
+                localPeak = jmax (localPeak, std::abs (sum));
+            }
+        }
+
+        peak = localPeak;
+        publishedPeak = localPeak;
+    }
+
+    HeapBlock<float> history;
+    int historyPos;
+    float peak;
+    Atomic<float> publishedPeak;
+
+    JUCE_DECLARE_NON_COPYABLE (TruePeakChannel)
+};
+
+//==============================================================================
+LoudnessMeter::LoudnessMeter()
+    : sampleRate (0), numChannels (0), samplesPerStep (1), samplesInCurrentStep (0),
+      numStepsDone (0), oversamplingFactor (1), kWeightingFilter (0, 2),
+      currentStepEnergy (0), momentarySum (0), shortTermSum (0), stepIndex (0),
+      histogramCounts ((size_t) numHistogramBins, true),
+      histogramEnergies ((size_t) numHistogramBins, true),
+      numGatedBlocks (0), gatedEnergy (0),
+      momentaryLoudness (-100.0f), shortTermLoudness (-100.0f), integratedLoudness (-100.0f)
+{
+    zeromem (stepEnergies, sizeof (stepEnergies));
+}
+
+LoudnessMeter::~LoudnessMeter()
+{
+}
+
+void LoudnessMeter::prepare (const double newSampleRate, const int newNumChannels)
+{
+    jassert (newSampleRate > 0 && newNumChannels >= 0);
+
+    using namespace LoudnessMeterHelpers;
+
+    sampleRate = newSampleRate;
+    numChannels = jmax (0, newNumChannels);
+    samplesPerStep = jmax (1, roundToInt (sampleRate * 0.1));
+    oversamplingFactor = sampleRate < 96000.0 ? 4 : (sampleRate < 192000.0 ? 2 : 1);
+
+    kWeightingFilter.setNumChannels (numChannels);
+    kWeightingFilter.setCoefficients (0, makeKWeightingShelf (sampleRate));
+    kWeightingFilter.setCoefficients (1, makeKWeightingHighPass (sampleRate));
+
+    filterBuffer.setSize (jmax (1, numChannels), maxChunkSize);
+
+    channelWeights.malloc ((size_t) jmax (1, numChannels));
+    FloatVectorOperations::fill (channelWeights, 1.0f, numChannels);
+
+    if (numChannels == 6)
+    {
+        channelWeights[3] = 0.0f;
+        channelWeights[4] = channelWeights[5] = 1.41f;
+    }
+    else if (numChannels == 5)
+    {
+        channelWeights[3] = channelWeights[4] = 1.41f;
+    }
+
+    truePeakCoefficients.malloc ((size_t) (oversamplingFactor * tapsPerPhase));
+    fillTruePeakCoefficients();
+
+    truePeakChannels.clear();
+
+    for (int i = 0; i < numChannels; ++i)
+        truePeakChannels.add (new TruePeakChannel());
+
+    reset();
+}
+
+void LoudnessMeter::fillTruePeakCoefficients()
+{
+    using namespace LoudnessMeterHelpers;
+
+    const double beta = 6.0;
+    const double windowScale = 1.0 / besselI0 (beta);
+    const double halfLength = tapsPerPhase / 2;
+
+    // Phase 0 lands exactly on the input samples, and the others are spaced evenly between
+    // them. The cutoff is left at the input's Nyquist frequency, because for a peak meter
+    // it's better to let a little imaging through than to under-read high frequencies.
+    for (int phase = 0; phase < oversamplingFactor; ++phase)
+    {
+        const double offset = (halfLength - 1.0) + phase / (double) oversamplingFactor;
+        float* const coeffs = truePeakCoefficients + phase * tapsPerPhase;
+        double total = 0;
+
+        for (int k = 0; k < tapsPerPhase; ++k)
+        {
+            const double distance = k - offset;
+            const double x = double_Pi * distance;
+            const double sinc = x == 0 ? 1.0 : std::sin (x) / x;
+
+            const double w = distance / halfLength;
+            const double window = w * w < 1.0 ? besselI0 (beta * std::sqrt (1.0 - w * w)) * windowScale : 0.0;
+
+            coeffs[k] = (float) (sinc * window);
+            total += sinc * window;
+        }
+
+        // normalise each phase so that the DC gain is exactly 1
+        if (total != 0)
+            FloatVectorOperations::multiply (coeffs, (float) (1.0 / total), tapsPerPhase);
+    }
+}
+
+void LoudnessMeter::setChannelWeight (const int channel, const float weight) noexcept
+{
+    jassert (isPositiveAndBelow (channel, numChannels));
+
+    if (isPositiveAndBelow (channel, numChannels))
+        channelWeights[channel] = weight;
+}
+
+void LoudnessMeter::reset() noexcept
+{
+    kWeightingFilter.reset();
+
+    for (int i = 0; i < truePeakChannels.size(); ++i)
+        truePeakChannels.getUnchecked(i)->reset();
+
+    zeromem (stepEnergies, sizeof (stepEnergies));
+    currentStepEnergy = momentarySum = shortTermSum = 0;
+    samplesInCurrentStep = numStepsDone = stepIndex = 0;
+
+    momentaryLoudness = -100.0f;
+    shortTermLoudness = -100.0f;
+
+    integratedResetPending = 0;
+    truePeakResetPending = 0;
+    clearIntegratedLoudness();
+}
+
+void LoudnessMeter::clearIntegratedLoudness() noexcept
+{
+    histogramCounts.clear ((size_t) numHistogramBins);
+    histogramEnergies.clear ((size_t) numHistogramBins);
+    numGatedBlocks = 0;
+    gatedEnergy = 0;
+    integratedLoudness = -100.0f;
+}
+
+void LoudnessMeter::resetIntegratedLoudness() noexcept   { integratedResetPending = 1; }
+void LoudnessMeter::resetTruePeaks() noexcept            { truePeakResetPending = 1; }
+
+float LoudnessMeter::getTruePeak (const int channel) const noexcept
+{
+    if (TruePeakChannel* const c = truePeakChannels [channel])
+        return c->publishedPeak.get();
+
+    return 0.0f;
+}
+
+float LoudnessMeter::getMaxTruePeak() const noexcept
+{
+    float maxPeak = 0.0f;
+
+    for (int i = 0; i < truePeakChannels.size(); ++i)
+        maxPeak = jmax (maxPeak, truePeakChannels.getUnchecked(i)->publishedPeak.get());
+
+    return maxPeak;
+}
+
+//==============================================================================
+void LoudnessMeter::process (const AudioSampleBuffer& buffer, int startSample, int numSamples) noexcept
+{
+    jassert (startSample >= 0 && startSample + numSamples <= buffer.getNumSamples());
+
+    if (integratedResetPending.compareAndSetBool (0, 1))
+        clearIntegratedLoudness();
+
+    if (truePeakResetPending.compareAndSetBool (0, 1))
+        for (int i = 0; i < truePeakChannels.size(); ++i)
+            truePeakChannels.getUnchecked(i)->peak = 0;
+
+    const int numToMeter = jmin (numChannels, buffer.getNumChannels());
+
+    if (numToMeter <= 0)
+        return;
+
+    float** const filtered = filterBuffer.getArrayOfWritePointers();
+
+    while (numSamples > 0)
+    {
+        const int num = jmin (numSamples, samplesPerStep - samplesInCurrentStep, (int) maxChunkSize);
+
+        for (int i = 0; i < numToMeter; ++i)
+        {
+            const float* const src = buffer.getReadPointer (i, startSample);
+
+            truePeakChannels.getUnchecked(i)->process (src, num, truePeakCoefficients, oversamplingFactor);
+            FloatVectorOperations::copy (filtered[i], src, num);
+        }
+
+        kWeightingFilter.processSamples (filtered, numToMeter, num);
+
+        for (int i = 0; i < numToMeter; ++i)
+            if (channelWeights[i] != 0)
+                currentStepEnergy += channelWeights[i] * (double) FloatVectorOperations::dotProduct (filtered[i], filtered[i], num);
+
+        startSample += num;
+        numSamples -= num;
+        samplesInCurrentStep += num;
+
+        if (samplesInCurrentStep >= samplesPerStep)
+            finishStep();
+    }
+}
+
+void LoudnessMeter::finishStep() noexcept
+{
+    using namespace LoudnessMeterHelpers;
+
+    const double newEnergy = currentStepEnergy;
+    currentStepEnergy = 0;
+    samplesInCurrentStep = 0;
+
+    // The windows slide along one step at a time, so each sum only needs the newest step
+    // adding and the one that has just dropped out of its window subtracting.
+    momentarySum += newEnergy - stepEnergies [(stepIndex + shortTermSteps - momentarySteps) % shortTermSteps];
+    shortTermSum += newEnergy - stepEnergies [stepIndex];
+    stepEnergies [stepIndex] = newEnergy;
+
+    if (++stepIndex == shortTermSteps)
+    {
+        // re-sum the windows once per lap of the history, so rounding errors can't build up
+        stepIndex = 0;
+        momentarySum = shortTermSum = 0;
+
+        for (int i = 0; i < shortTermSteps; ++i)
+        {
+            shortTermSum += stepEnergies[i];
+
+            if (i >= shortTermSteps - momentarySteps)
+                momentarySum += stepEnergies[i];
+        }
+    }
+
+    ++numStepsDone;
+
+    const double momentaryEnergy = jmax (0.0, momentarySum) / (momentarySteps * (double) samplesPerStep);
+    momentaryLoudness = energyToLoudness (momentaryEnergy);
+    shortTermLoudness = energyToLoudness (jmax (0.0, shortTermSum) / (shortTermSteps * (double) samplesPerStep));
+
+    if (numStepsDone >= momentarySteps)
+        addGatingBlock (momentaryEnergy);
+}
+
+void LoudnessMeter::addGatingBlock (const double energy) noexcept
+{
+    using namespace LoudnessMeterHelpers;
+
+    const double blockLoudness = -0.691 + 10.0 * std::log10 (jmax (energy, 1.0e-20));
+
+    if (blockLoudness <= -70.0)
+        return;
+
+    const int bin = getHistogramBin (blockLoudness, numHistogramBins);
+    ++histogramCounts[bin];
+    histogramEnergies[bin] += energy;
+    ++numGatedBlocks;
+    gatedEnergy += energy;
+
+    // The relative gate is 10 LU below the loudness of all the blocks that passed the
+    // absolute gate. Bins are included if their centre is above it, so the threshold is
+    // effectively rounded to the nearest 0.05 LU.
+    const double relativeGate = -0.691 + 10.0 * std::log10 (gatedEnergy / numGatedBlocks) - 10.0;
+    const int firstBin = jlimit (0, (int) numHistogramBins, (int) std::ceil ((relativeGate + 70.0) * 10.0 - 0.5));
+
+    int count = 0;
+    double total = 0;
+
+    for (int i = firstBin; i < numHistogramBins; ++i)
+    {
+        count += histogramCounts[i];
+        total += histogramEnergies[i];
+    }
+
+    integratedLoudness = count > 0 ? energyToLoudness (total / count) : -100.0f;
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class LoudnessMeterTests  : public UnitTest
+{
+public:
+    LoudnessMeterTests() : UnitTest ("LoudnessMeter") {}
+
+    // Feeds a stereo sine wave through the meter in randomly-sized blocks.
+    void feedSine (LoudnessMeter& meter, double sampleRate, double frequency,
+                   float amplitude, double phase, double seconds)
+    {
+        AudioSampleBuffer buffer (2, 1000);
+        Random r (getRandom());
+        const int total = roundToInt (seconds * sampleRate);
+
+        for (int done = 0; done < total;)
+        {
+            const int num = jmin (r.nextInt (999) + 1, total - done);
+
+            for (int i = 0; i < num; ++i)
+            {
+                const float s = amplitude * (float) std::sin (2.0 * double_Pi * frequency * (done + i) / sampleRate + phase);
+                buffer.setSample (0, i, s);
+                buffer.setSample (1, i, s);
+            }
+
+            meter.process (buffer, 0, num);
+            done += num;
+        }
+    }
+
+    void runTest() override
+    {
+        beginTest ("Loudness");
+        {
+            LoudnessMeter meter;
+            meter.prepare (48000.0, 2);
+
+            // a 997Hz sine at -20dBFS in both channels of a stereo signal reads -20 LUFS
+            feedSine (meter, 48000.0, 997.0, 0.1f, 0.0, 10.0);
+            expect (std::abs (meter.getMomentaryLoudness() + 20.0f) < 0.05f);
+            expect (std::abs (meter.getShortTermLoudness() + 20.0f) < 0.05f);
+            expect (std::abs (meter.getIntegratedLoudness() + 20.0f) < 0.05f);
+
+            beginTest ("Gating");
+            feedSine (meter, 48000.0, 997.0, 0.01f, 0.0, 20.0);
+            expect (std::abs (meter.getShortTermLoudness() + 40.0f) < 0.05f);
+            expect (std::abs (meter.getIntegratedLoudness() + 20.0f) < 0.1f);
+
+            meter.resetIntegratedLoudness();
+            feedSine (meter, 48000.0, 997.0, 0.01f, 0.0, 1.0);
+            expect (std::abs (meter.getIntegratedLoudness() + 40.0f) < 0.1f);
+        }
+
+        beginTest ("True peak");
+        {
+            LoudnessMeter meter;
+            meter.prepare (44100.0, 2);
+
+            feedSine (meter, 44100.0, 1000.0, 0.25f, 0.0, 0.5);
+            expect (std::abs (meter.getMaxTruePeak() - 0.25f) < 0.005f);
+
+            // a quarter of the sample rate, with the peaks falling half-way between samples
+            meter.resetTruePeaks();
+            feedSine (meter, 44100.0, 44100.0 / 4.0, 0.5f, double_Pi / 4.0, 0.5);
+            expect (std::abs (meter.getMaxTruePeak() - 0.5f) < 0.02f);
+            expect (std::abs (meter.getTruePeak (1) - 0.5f) < 0.02f);
+        }
+    }
+};
+
+static LoudnessMeterTests loudnessMeterTests;
+
+#endif
@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_LOUDNESSMETER_H_INCLUDED
+#define JUCE_LOUDNESSMETER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Measures the loudness and true-peak level of a stream of audio, as described in
+    ITU-R BS.1770 and EBU R128.
+
+    Feed the audio to process() on the audio thread, and read the results from any
+    other thread. The readings are published with atomic writes each time they're
+    updated, so a meter component can just poll them from a timer without locking
+    anything or looking at the audio itself.
+
+    The signal is K-weighted, and its energy is summed in 100ms steps. The momentary
+    (400ms) and short-term (3s) windows are kept as running sums that are updated as
+    each step finishes, so they cost the same however long the window is, and the gated
+    integrated loudness is kept as a histogram of block loudnesses with 0.1 LU resolution,
+    so it doesn't need to keep any history however long the programme runs for.
+
+    True-peak levels are found by over-sampling each channel with a windowed-sinc
+    polyphase filter (4 times at rates below 96KHz, twice below 192KHz) and taking the
+    largest magnitude of the interpolated samples.
+
+    @see AudioSampleBuffer::getMagnitude, Decibels
+*/
+class JUCE_API  LoudnessMeter
+{
+public:
+    //==============================================================================
+    /** Creates a meter. You'll need to call prepare() before using it. */
+    LoudnessMeter();
+
+    /** Destructor. */
+    ~LoudnessMeter();
+
+    //==============================================================================
+    /** Sets up the meter for a given sample rate and number of channels, and resets it.
+
+        This allocates memory, so don't call it on the audio thread, or while process()
+        might be running.
+
+        The channels are weighted as BS.1770 recommends, assuming that 6 channels are in
+        the order L, R, C, LFE, Ls, Rs and 5 channels are L, R, C, Ls, Rs. For any other
+        layout they're all given a weight of 1.0, and you can use setChannelWeight() to
+        change them.
+    */
+    void prepare (double sampleRate, int numChannels);
+
+    /** Changes the weighting that is applied to a channel's energy before it's summed.
+        A weight of 0 leaves the channel out of the loudness measurement, although its
+        true-peak level will still be measured. Call this after prepare().
+    */
+    void setChannelWeight (int channel, float weight) noexcept;
+
+    /** Clears all the measurements and the state of the filters.
+        This must not be called while process() is running on another thread - use
+        resetIntegratedLoudness() and resetTruePeaks() for that.
+    */
+    void reset() noexcept;
+
+    /** Returns the number of interpolated samples that are taken for each input sample
+        when finding the true-peak levels.
+    */
+    int getOversamplingFactor() const noexcept              { return oversamplingFactor; }
+
+    //==============================================================================
+    /** Measures a section of a buffer.
+        This doesn't allocate or lock anything, so can be called on the audio thread.
+        Any channels beyond the number passed to prepare() are ignored.
+    */
+    void process (const AudioSampleBuffer& buffer, int startSample, int numSamples) noexcept;
+
+    //==============================================================================
+    /** Returns the loudness of the most recent 400ms, in LUFS.
+        If the signal is silent, this returns -100.
+    */
+    float getMomentaryLoudness() const noexcept             { return momentaryLoudness.get(); }
+
+    /** Returns the loudness of the most recent 3 seconds, in LUFS.
+        If the signal is silent, this returns -100.
+    */
+    float getShortTermLoudness() const noexcept             { return shortTermLoudness.get(); }
+
+    /** Returns the gated loudness of everything since the meter was last reset, in LUFS.
+        Until a 400ms block has been measured that is louder than the absolute gate of
+        -70 LUFS, this returns -100.
+    */
+    float getIntegratedLoudness() const noexcept            { return integratedLoudness.get(); }
+
+    /** Returns the highest true-peak level that one of the channels has reached since the
+        peaks were last reset. This is a gain rather than a value in decibels.
+    */
+    float getTruePeak (int channel) const noexcept;
+
+    /** Returns the highest true-peak level that any channel has reached since the
+        peaks were last reset. This is a gain rather than a value in decibels.
+    */
+    float getMaxTruePeak() const noexcept;
+
+    /** Asks the meter to start measuring the integrated loudness from scratch.
+        This can be called from any thread, and takes effect the next time process()
+        is called.
+    */
+    void resetIntegratedLoudness() noexcept;
+
+    /** Asks the meter to clear the true-peak levels.
+        This can be called from any thread, and takes effect the next time process()
+        is called.
+    */
+    void resetTruePeaks() noexcept;
+
+private:
+    //==============================================================================
+    struct TruePeakChannel;
+
+    enum
+    {
+        momentarySteps = 4,
+        shortTermSteps = 30,
+        numHistogramBins = 800,
+        tapsPerPhase = 16,
+        maxChunkSize = 512
+    };
+
+    double sampleRate;
+    int numChannels, samplesPerStep, samplesInCurrentStep, numStepsDone, oversamplingFactor;
+
+    MultiChannelIIRFilter kWeightingFilter;
+    AudioSampleBuffer filterBuffer;
+    HeapBlock<float> channelWeights, truePeakCoefficients;
+    OwnedArray<TruePeakChannel> truePeakChannels;
+
+    double currentStepEnergy, stepEnergies [shortTermSteps];
+    double momentarySum, shortTermSum;
+    int stepIndex;
+
+    HeapBlock<int> histogramCounts;
+    HeapBlock<double> histogramEnergies;
+    int numGatedBlocks;
+    double gatedEnergy;
+
+    Atomic<float> momentaryLoudness, shortTermLoudness, integratedLoudness;
+    Atomic<int> integratedResetPending, truePeakResetPending;
+
+    void fillTruePeakCoefficients();
+    void clearIntegratedLoudness() noexcept;
+    void finishStep() noexcept;
+    void addGatingBlock (double energy) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoudnessMeter)
+};
+
+
+#endif   // JUCE_LOUDNESSMETER_H_INCLUDED
@@ -0,0 +1,423 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+struct Oversampling::Stage
+{
+    Stage (int numChans, int maxNumInputSamples) noexcept
+        : numChannels (numChans), maxNumSamples (maxNumInputSamples) {}
+
+    virtual ~Stage() {}
+
+    virtual void initProcessing (int maxNumInputSamples) = 0;
+    virtual void reset() noexcept = 0;
+
+    /** Doubles the rate of one channel, writing numInputSamples * 2 output samples. */
+    virtual void processUp (int channel, const float* input, float* output, int numInputSamples) noexcept = 0;
+
+    /** Halves the rate of one channel, reading numOutputSamples * 2 input samples. */
+    virtual void processDown (int channel, const float* input, float* output, int numOutputSamples) noexcept = 0;
+
+    /** The delay of an up-and-down trip through this stage, in samples at its higher rate. */
+    virtual double getLatency() const noexcept = 0;
+
+    const int numChannels;
+    int maxNumSamples;
+
+    JUCE_DECLARE_NON_COPYABLE (Stage)
+};
+
+//==============================================================================
+/*  A linear-phase half-band FIR, with an odd number of taps (4k + 3), centred on an odd tap.
+
+    All the even-numbered taps apart from the centre one are zero, so when up-sampling, one
+    phase of the output is a plain delay of the input, and the other is a FIR of the odd taps.
+    When down-sampling, the even input samples go through the FIR and the odd ones are delayed.
+*/
+struct Oversampling::FIRStage  : public Oversampling::Stage
+{
+    FIRStage (int numChans, int maxNumInputSamples, double transitionWidth, double attenuationDb)
+        : Stage (numChans, maxNumInputSamples)
+    {
+        // Kaiser's estimate of the length needed, rounded up to the next (4k + 3)
+        const double estimatedLength = (attenuationDb - 7.95) / (14.36 * transitionWidth) + 1.0;
+        halfDelay = jmax (1, (int) std::ceil ((estimatedLength - 3.0) / 4.0));
+
+        const int numTaps = 4 * halfDelay + 3;
+        const int centre = numTaps / 2;
+        const double beta = 0.1102 * (attenuationDb - 8.7);
+        const double windowScale = 1.0 / SincResamplerHelpers::besselI0 (beta);
+
+        numCoeffs = numTaps / 2 + 1;
+        coeffs.malloc ((size_t) numCoeffs);
+        double total = 0;
+
+        for (int i = 0; i < numCoeffs; ++i)
+        {
+            const int distance = 2 * i - centre;
+            const double x = double_Pi * 0.5 * distance;
+            const double w = distance / (double) (centre + 1);
+            const double window = SincResamplerHelpers::besselI0 (beta * std::sqrt (1.0 - w * w)) * windowScale;
+
+            coeffs[i] = (float) (std::sin (x) / x * window);
+            total += coeffs[i];
+        }
+
+        // (scaled so that each phase has unity gain, which also makes up for the zeros
+        // that get inserted when up-sampling)
+        FloatVectorOperations::multiply (coeffs, (float) (1.0 / total), numCoeffs);
+
+        initProcessing (maxNumInputSamples);
+    }
+
+    void initProcessing (int maxNumInputSamples) override
+    {
+        maxNumSamples = maxNumInputSamples;
+
+        // Each channel has a history of numCoeffs - 1 samples followed by the current block,
+        // so that the filter can run over a contiguous range.
+        const int historySize = numCoeffs - 1;
+        upStates.setSize (numChannels, historySize + maxNumSamples);
+        downStatesEven.setSize (numChannels, historySize + maxNumSamples);
+        downStatesOdd.setSize (numChannels, historySize + maxNumSamples);
+        reset();
+    }
+
+    void reset() noexcept override
+    {
+        upStates.clear();
+        downStatesEven.clear();
+        downStatesOdd.clear();
+    }
+
+    void processUp (int channel, const float* input, float* output, int numInputSamples) noexcept override
+    {
+        jassert (numInputSamples <= maxNumSamples);
+
+        const int historySize = numCoeffs - 1;
+        float* const buffer = upStates.getWritePointer (channel);
+        FloatVectorOperations::copy (buffer + historySize, input, numInputSamples);
+
+        // (the taps are symmetrical, so don't need reversing)
+        for (int i = 0; i < numInputSamples; ++i)
+        {
+            output[2 * i]     = FloatVectorOperations::dotProduct (buffer + i, coeffs, numCoeffs);
+            output[2 * i + 1] = buffer [historySize + i - halfDelay];
+        }
+
+        memmove (buffer, buffer + numInputSamples, sizeof (float) * (size_t) historySize);
+    }
+
+    void processDown (int channel, const float* input, float* output, int numOutputSamples) noexcept override
+    {
+        jassert (numOutputSamples <= maxNumSamples);
+
+        const int historySize = numCoeffs - 1;
+        float* const even = downStatesEven.getWritePointer (channel);
+        float* const odd  = downStatesOdd.getWritePointer (channel);
+
+        for (int i = 0; i < numOutputSamples; ++i)
+        {
+            even [historySize + i] = input [2 * i];
+            odd  [historySize + i] = input [2 * i + 1];
+        }
+
+        for (int i = 0; i < numOutputSamples; ++i)
+            output[i] = FloatVectorOperations::dotProduct (even + i, coeffs, numCoeffs)
+                          + odd [historySize + i - halfDelay - 1];
+
+        // (each phase has unity gain, so together they need halving)
+        FloatVectorOperations::multiply (output, 0.5f, numOutputSamples);
+
+        memmove (even, even + numOutputSamples, sizeof (float) * (size_t) historySize);
+        memmove (odd,  odd  + numOutputSamples, sizeof (float) * (size_t) historySize);
+    }
+
+    double getLatency() const noexcept override
+    {
+        // the centre tap is 2 * halfDelay + 1 samples in, and the signal passes through two filters
+        return 2.0 * (2 * halfDelay + 1);
+    }
+
+    int halfDelay, numCoeffs;
+    HeapBlock<float> coeffs;
+    AudioSampleBuffer upStates, downStatesEven, downStatesOdd;
+
+    JUCE_DECLARE_NON_COPYABLE (FIRStage)
+};
+
+//==============================================================================
+/*  A half-band filter made from two parallel chains of first-order allpass sections, each
+    running at the lower rate. The coefficients are found with the elliptic design method
+    described by Valenzuela and Constantinides, which is also used by Laurent de Soras' HIIR
+    library.
+*/
+struct Oversampling::IIRStage  : public Oversampling::Stage
+{
+    IIRStage (int numChans, int maxNumInputSamples, double transitionWidth, double attenuationDb)
+        : Stage (numChans, maxNumInputSamples)
+    {
+        double k, q;
+        computeTransitionParams (transitionWidth, k, q);
+
+        const int order = computeOrder (attenuationDb, q);
+        numCoeffs = (order - 1) / 2;
+
+        for (int i = 0; i < numCoeffs; ++i)
+            coeffs.add ((float) computeCoefficient (i, k, q, order));
+
+        initProcessing (maxNumInputSamples);
+    }
+
+    void initProcessing (int maxNumInputSamples) override
+    {
+        maxNumSamples = maxNumInputSamples;
+
+        // for each channel, an input and output state for each section, going up and down
+        states.setSize (numChannels, numCoeffs * 4);
+        reset();
+    }
+
+    void reset() noexcept override
+    {
+        states.clear();
+    }
+
+    // Runs one sample through the sections of one of the paths, starting at the given
+    // coefficient index, and using every other coefficient.
+    static forcedinline float processPath (float sample, const float* coeff, float* state,
+                                           const int firstCoeff, const int numCoeffs) noexcept
+    {
+        for (int i = firstCoeff; i < numCoeffs; i += 2)
+        {
+            float& x1 = state [i * 2];
+            float& y1 = state [i * 2 + 1];
+
+            const float y = (sample - y1) * coeff[i] + x1;
+            x1 = sample;
+            y1 = y;
+            sample = y;
+        }
+
+        return sample;
+    }
+
+    void processUp (int channel, const float* input, float* output, int numInputSamples) noexcept override
+    {
+        float* const state = states.getWritePointer (channel);
+
+        for (int i = 0; i < numInputSamples; ++i)
+        {
+            output[2 * i]     = processPath (input[i], coeffs.begin(), state, 0, numCoeffs);
+            output[2 * i + 1] = processPath (input[i], coeffs.begin(), state, 1, numCoeffs);
+        }
+    }
+
+    void processDown (int channel, const float* input, float* output, int numOutputSamples) noexcept override
+    {
+        float* const state = states.getWritePointer (channel) + numCoeffs * 2;
+
+        for (int i = 0; i < numOutputSamples; ++i)
+            output[i] = 0.5f * (processPath (input[2 * i + 1], coeffs.begin(), state, 0, numCoeffs)
+                                  + processPath (input[2 * i], coeffs.begin(), state, 1, numCoeffs));
+    }
+
+    double getLatency() const noexcept override
+    {
+        // At low frequencies, a section with coefficient a delays by (1 - a) / (1 + a) of its
+        // own samples, which are two samples long at the higher rate. Each filter averages its
+        // two paths, and the half-sample offset between them adds to the delay going up, but
+        // is taken away again going down, as the down-sampler reads the odd samples first.
+        double delay = 0;
+
+        for (int i = 0; i < numCoeffs; ++i)
+            delay += 2.0 * (1.0 - coeffs.getUnchecked(i)) / (1.0 + coeffs.getUnchecked(i));
+
+        return delay;
+    }
+
+    //==============================================================================
+    static void computeTransitionParams (const double transitionWidth, double& k, double& q) noexcept
+    {
+        k = std::tan ((1.0 - transitionWidth * 2.0) * double_Pi / 4.0);
+        k *= k;
+
+        const double kksqrt = std::pow (1.0 - k * k, 0.25);
+        const double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+        const double e4 = e * e * e * e;
+
+        q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+    }
+
+    static int computeOrder (const double attenuationDb, const double q) noexcept
+    {
+        const double attenuation = std::pow (10.0, -attenuationDb / 10.0);
+        const double a = attenuation / (1.0 - attenuation);
+
+        return jmax (3, (int) std::ceil (std::log (a * a / 16.0) / std::log (q))) | 1;
+    }
+
+    static double computeCoefficient (const int index, const double k, const double q, const int order) noexcept
+    {
+        const int c = index + 1;
+        double numerator = 0, denominator = 0;
+
+        for (int i = 0;; ++i)
+        {
+            const double term = std::pow (q, (double) (i * (i + 1))) * std::sin ((i * 2 + 1) * c * double_Pi / order);
+            numerator += (i & 1) ? -term : term;
+
+            if (std::abs (term) < 1.0e-100)
+                break;
+        }
+
+        for (int i = 1;; ++i)
+        {
+            const double term = std::pow (q, (double) (i * i)) * std::cos (i * 2 * c * double_Pi / order);
+            denominator += (i & 1) ? -term : term;
+
+            if (std::abs (term) < 1.0e-100)
+                break;
+        }
+
+        const double ww = numerator * std::pow (q, 0.25) / (denominator + 0.5);
+        const double wwsq = ww * ww;
+        const double x = std::sqrt ((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+
+        return (1.0 - x) / (1.0 + x);
+    }
+
+    int numCoeffs;
+    Array<float> coeffs;
+    AudioSampleBuffer states;
+
+    JUCE_DECLARE_NON_COPYABLE (IIRStage)
+};
+
+//==============================================================================
+Oversampling::Oversampling (const int numChans, const int factorOrder, const FilterType filterType)
+    : numChannels (numChans), maxNumSamples (0)
+{
+    jassert (numChannels > 0);
+    jassert (factorOrder >= 1 && factorOrder <= 3);
+
+    for (int i = 0; i < jlimit (1, 3, factorOrder); ++i)
+    {
+        // The audio band extends to 0.45 of the original rate, so the first stage needs a
+        // steep transition. After that, each stage's images are further from the audio band,
+        // so its transition band (relative to its own higher rate) can be much wider.
+        const double passband = 0.45 / (2 << i);
+        const double transitionWidth = 0.5 - 2.0 * passband;
+
+        if (filterType == filterHalfBandFIR)
+            stages.add (new FIRStage (numChannels, 0, transitionWidth, 110.0));
+        else
+            stages.add (new IIRStage (numChannels, 0, transitionWidth * 0.5, 100.0));
+
+        buffers.add (new AudioSampleBuffer (numChannels, 0));
+    }
+}
+
+Oversampling::~Oversampling()
+{
+}
+
+double Oversampling::getLatencyInSamples() const noexcept
+{
+    double latency = 0;
+
+    for (int i = 0; i < stages.size(); ++i)
+        latency += stages.getUnchecked(i)->getLatency() / (2 << i);
+
+    return latency;
+}
+
+void Oversampling::initProcessing (const int maximumNumberOfSamplesBeforeOversampling)
+{
+    maxNumSamples = maximumNumberOfSamplesBeforeOversampling;
+
+    for (int i = 0; i < stages.size(); ++i)
+    {
+        stages.getUnchecked(i)->initProcessing (maxNumSamples << i);
+        buffers.getUnchecked(i)->setSize (numChannels, maxNumSamples << (i + 1));
+    }
+}
+
+void Oversampling::reset() noexcept
+{
+    for (int i = 0; i < stages.size(); ++i)
+    {
+        stages.getUnchecked(i)->reset();
+        buffers.getUnchecked(i)->clear();
+    }
+}
+
+AudioSampleBuffer& Oversampling::processSamplesUp (const AudioSampleBuffer& source, const int startSample, const int numSamples) noexcept
+{
+    jassert (numSamples <= maxNumSamples); // you need to call initProcessing() with a big enough size!
+
+    const int numChans = jmin (numChannels, source.getNumChannels());
+
+    for (int i = 0; i < stages.size(); ++i)
+    {
+        Stage& stage = *stages.getUnchecked(i);
+        AudioSampleBuffer& output = *buffers.getUnchecked(i);
+        output.setSize (numChannels, numSamples << (i + 1), false, false, true);
+
+        for (int chan = 0; chan < numChans; ++chan)
+        {
+            const float* const input = (i == 0) ? source.getReadPointer (chan, startSample)
+                                                : buffers.getUnchecked (i - 1)->getReadPointer (chan);
+
+            stage.processUp (chan, input, output.getWritePointer (chan), numSamples << i);
+        }
+
+        for (int chan = numChans; chan < numChannels; ++chan)
+            output.clear (chan, 0, output.getNumSamples());
+    }
+
+    return *buffers.getLast();
+}
+
+void Oversampling::processSamplesDown (AudioSampleBuffer& destination, const int startSample, const int numSamples) noexcept
+{
+    jassert (numSamples <= maxNumSamples);
+    jassert (buffers.getLast()->getNumSamples() == numSamples * getOversamplingFactor());
+
+    const int numChans = jmin (numChannels, destination.getNumChannels());
+
+    for (int i = stages.size(); --i >= 0;)
+    {
+        Stage& stage = *stages.getUnchecked(i);
+        const AudioSampleBuffer& input = *buffers.getUnchecked(i);
+
+        for (int chan = 0; chan < numChans; ++chan)
+        {
+            float* const output = (i == 0) ? destination.getWritePointer (chan, startSample)
+                                           : buffers.getUnchecked (i - 1)->getWritePointer (chan);
+
+            stage.processDown (chan, input.getReadPointer (chan), output, numSamples << i);
+        }
+    }
+}
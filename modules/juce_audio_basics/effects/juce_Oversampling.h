@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_OVERSAMPLING_H_INCLUDED
+#define JUCE_OVERSAMPLING_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Up-samples a block of audio by 2x, 4x or 8x, so that non-linear processing such as
+    distortion or saturation can be done at a higher rate, and then brings it back down
+    to the original rate.
+
+    Each doubling is done by a half-band filter stage, working in polyphase form so that
+    only half of the filter is ever applied to each sample. The later stages can have much
+    wider transition bands than the first one, so they're cheap compared to it.
+
+    There are two kinds of filter:
+    - filterHalfBandFIR uses linear-phase FIR filters, which have a fixed latency (which can
+      be a fraction of a sample), and don't change the shape of the waveform.
+    - filterHalfBandPolyphaseIIR uses pairs of allpass chains, which have a much lower latency
+      and cost, but whose phase response isn't linear near the top of the band. The latency
+      reported for these is their delay at low frequencies.
+
+    To use it, create one with the number of channels you need, call initProcessing() before
+    playback starts, and then for each block:
+    @code
+    AudioSampleBuffer& oversampled = oversampling.processSamplesUp (buffer, 0, buffer.getNumSamples());
+    myNonLinearProcess (oversampled);
+    oversampling.processSamplesDown (buffer, 0, buffer.getNumSamples());
+    @endcode
+
+    If you're using it in an AudioProcessor, pass roundToInt (getLatencyInSamples()) to
+    AudioProcessor::setLatencySamples().
+*/
+class JUCE_API  Oversampling
+{
+public:
+    //==============================================================================
+    /** The types of filter that can be used. */
+    enum FilterType
+    {
+        filterHalfBandFIR,          /**< Linear-phase FIR filters, with over 100dB of image rejection. */
+        filterHalfBandPolyphaseIIR  /**< Minimum-latency allpass-based IIR filters, with about 100dB of image rejection. */
+    };
+
+    /** Creates an oversampling engine.
+
+        @param numChannels      the number of channels that will be processed
+        @param factorOrder      the oversampling factor as a power of 2: 1 for 2x, 2 for 4x, or 3 for 8x
+        @param filterType       the kind of filter to use
+    */
+    Oversampling (int numChannels, int factorOrder, FilterType filterType);
+
+    /** Destructor. */
+    ~Oversampling();
+
+    //==============================================================================
+    /** Returns the oversampling factor, i.e. 2, 4 or 8. */
+    int getOversamplingFactor() const noexcept          { return 1 << stages.size(); }
+
+    /** Returns the total delay of an up-and-down trip, measured in samples at the original
+        sample rate. This may not be a whole number of samples.
+    */
+    double getLatencyInSamples() const noexcept;
+
+    /** Allocates the buffers needed to process blocks of up to the given size.
+        This must be called before processing, and shouldn't be called on the audio thread.
+    */
+    void initProcessing (int maximumNumberOfSamplesBeforeOversampling);
+
+    /** Clears the filters' internal state. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Up-samples a block of audio, and returns a buffer containing the result, which will
+        contain getOversamplingFactor() * numSamples samples per channel.
+
+        You can process this buffer in-place, and then call processSamplesDown() to get it
+        back to the original rate. The buffer is owned by this object, and will be
+        overwritten by the next call.
+    */
+    AudioSampleBuffer& processSamplesUp (const AudioSampleBuffer& source, int startSample, int numSamples) noexcept;
+
+    /** Down-samples the contents of the buffer that was returned by the last call to
+        processSamplesUp(), and writes the results into the destination buffer.
+    */
+    void processSamplesDown (AudioSampleBuffer& destination, int startSample, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    struct Stage;
+    struct FIRStage;
+    struct IIRStage;
+    friend struct ContainerDeletePolicy<Stage>;
+
+    const int numChannels;
+    int maxNumSamples;
+    OwnedArray<Stage> stages;
+    OwnedArray<AudioSampleBuffer> buffers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling)
+};
+
+
+#endif   // JUCE_OVERSAMPLING_H_INCLUDED
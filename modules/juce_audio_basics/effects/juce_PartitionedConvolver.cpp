@@ -0,0 +1,516 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+class PartitionedConvolver::Stage
+{
+public:
+    /*  A segment of the impulse response, starting at 'offset', that's processed using
+        uniform overlap-save partitions of 'partitionSize' samples.
+
+        Each time a block of input has been collected, it's convolved with the segment. If
+        the offset is equal to the partition size, the result is needed straight away, so
+        is computed immediately. Otherwise the offset is twice the partition size, which
+        means the result isn't needed until one more block has gone by, so the work can be
+        done by a background thread.
+    */
+    Stage (const AudioSampleBuffer& impulse, int numChannelsToUse,
+           int partitionSize, int segmentOffset, int numPartitionsToUse, bool useThread)
+        : blockSize (partitionSize),
+          numPartitions (numPartitionsToUse),
+          numBinFloats (2 * (partitionSize + 1)),
+          offset (segmentOffset),
+          position (0), delayLineIndex (0),
+          jobPending (false),
+          forwardFFT (getOrder (2 * partitionSize), false),
+          inverseFFT (getOrder (2 * partitionSize), true),
+          workBuffer ((size_t) (4 * partitionSize))
+    {
+        jassert (offset == blockSize || offset == 2 * blockSize);
+
+        for (int i = 0; i < numChannelsToUse; ++i)
+            channels.add (new ChannelState (*this, impulse, i % impulse.getNumChannels()));
+
+        if (useThread && offset > blockSize)
+        {
+            thread = new WorkerThread (*this);
+            thread->startThread (8);
+        }
+    }
+
+    ~Stage()
+    {
+        if (thread != nullptr)
+        {
+            thread->signalThreadShouldExit();
+            thread->startEvent.signal();
+            thread->stopThread (5000);
+        }
+    }
+
+    void reset()
+    {
+        waitForPendingJob();
+
+        for (int i = 0; i < channels.size(); ++i)
+            channels.getUnchecked (i)->reset (blockSize, numPartitions, numBinFloats);
+
+        position = 0;
+        delayLineIndex = 0;
+    }
+
+    // Adds the next numSamples of this segment's output to each channel, and collects
+    // the corresponding input. This must not cross a block boundary.
+    void process (const float* const* input, float* const* output, int numChannels, int numSamples) noexcept
+    {
+        jassert (position + numSamples <= blockSize);
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            ChannelState& c = *channels.getUnchecked (i);
+            FloatVectorOperations::copy (c.inputBlock + position, input[i], numSamples);
+            FloatVectorOperations::add (output[i], c.playbackBlock + position, numSamples);
+        }
+
+        position += numSamples;
+
+        if (position == blockSize)
+        {
+            position = 0;
+            blockFinished();
+        }
+    }
+
+    const int blockSize, numPartitions, numBinFloats, offset;
+
+private:
+    //==============================================================================
+    struct ChannelState
+    {
+        ChannelState (const Stage& stage, const AudioSampleBuffer& impulse, int impulseChannel)
+            : impulseSpectra ((size_t) (stage.numPartitions * stage.numBinFloats), true)
+        {
+            reset (stage.blockSize, stage.numPartitions, stage.numBinFloats);
+
+            const int impulseLength = impulse.getNumSamples();
+            float* const work = stage.workBuffer;
+
+            for (int i = 0; i < stage.numPartitions; ++i)
+            {
+                const int start = stage.offset + i * stage.blockSize;
+                const int num = jmin (stage.blockSize, impulseLength - start);
+
+                FloatVectorOperations::clear (work, 4 * stage.blockSize);
+
+                if (num > 0)
+                    FloatVectorOperations::copy (work, impulse.getReadPointer (impulseChannel, start), num);
+
+                stage.forwardFFT.performRealOnlyForwardTransform (work);
+                FloatVectorOperations::copy (impulseSpectra + i * stage.numBinFloats, work, stage.numBinFloats);
+            }
+        }
+
+        void reset (int blockSize, int numPartitions, int numBinFloats)
+        {
+            delayLine.calloc ((size_t) (numPartitions * numBinFloats));
+            previousInput.calloc ((size_t) blockSize);
+            inputBlock.calloc ((size_t) blockSize);
+            pendingInput.calloc ((size_t) blockSize);
+            result.calloc ((size_t) blockSize);
+            playbackBlock.calloc ((size_t) blockSize);
+        }
+
+        HeapBlock<float> impulseSpectra, delayLine, previousInput, inputBlock,
+                         pendingInput, result, playbackBlock;
+
+        JUCE_DECLARE_NON_COPYABLE (ChannelState)
+    };
+
+    //==============================================================================
+    class WorkerThread  : public Thread
+    {
+    public:
+        WorkerThread (Stage& s)  : Thread ("Convolution"), stage (s) {}
+
+        void run() override
+        {
+            for (;;)
+            {
+                startEvent.wait (-1);
+
+                if (threadShouldExit())
+                    break;
+
+                stage.performConvolution();
+                doneEvent.signal();
+            }
+        }
+
+        Stage& stage;
+        WaitableEvent startEvent, doneEvent;
+
+        JUCE_DECLARE_NON_COPYABLE (WorkerThread)
+    };
+
+    //==============================================================================
+    OwnedArray<ChannelState> channels;
+    int position, delayLineIndex;
+    bool jobPending;
+    FFT forwardFFT, inverseFFT;
+    HeapBlock<float> workBuffer;
+    ScopedPointer<WorkerThread> thread;
+
+    static int getOrder (int size) noexcept
+    {
+        int order = 0;
+
+        while ((1 << order) < size)
+            ++order;
+
+        return order;
+    }
+
+    void waitForPendingJob() noexcept
+    {
+        if (jobPending)
+        {
+            thread->doneEvent.wait (-1);
+            jobPending = false;
+        }
+    }
+
+    void blockFinished() noexcept
+    {
+        if (offset == blockSize)
+        {
+            takeInput();
+            performConvolution();
+            takeResult();
+            return;
+        }
+
+        // The previous block's result is due to start playing now..
+        waitForPendingJob();
+        takeResult();
+        takeInput();
+
+        if (thread != nullptr)
+        {
+            jobPending = true;
+            thread->startEvent.signal();
+        }
+        else
+        {
+            performConvolution();
+        }
+    }
+
+    void takeInput() noexcept
+    {
+        for (int i = 0; i < channels.size(); ++i)
+        {
+            ChannelState& c = *channels.getUnchecked (i);
+            FloatVectorOperations::copy (c.pendingInput, c.inputBlock, blockSize);
+        }
+    }
+
+    void takeResult() noexcept
+    {
+        for (int i = 0; i < channels.size(); ++i)
+        {
+            ChannelState& c = *channels.getUnchecked (i);
+            FloatVectorOperations::copy (c.playbackBlock, c.result, blockSize);
+        }
+    }
+
+    static void multiplyAdd (float* dest, const float* a, const float* b, int numBins) noexcept
+    {
+        for (int i = 0; i < numBins; ++i)
+        {
+            const float ar = a[0], ai = a[1], br = b[0], bi = b[1];
+            dest[0] += ar * br - ai * bi;
+            dest[1] += ar * bi + ai * br;
+            dest += 2;
+            a += 2;
+            b += 2;
+        }
+    }
+
+    // Convolves the pending input blocks with the segment, leaving the output in 'result'.
+    void performConvolution() noexcept
+    {
+        float* const work = workBuffer;
+        const int numBins = numBinFloats / 2;
+
+        for (int i = 0; i < channels.size(); ++i)
+        {
+            ChannelState& c = *channels.getUnchecked (i);
+
+            FloatVectorOperations::copy (work, c.previousInput, blockSize);
+            FloatVectorOperations::copy (work + blockSize, c.pendingInput, blockSize);
+            FloatVectorOperations::copy (c.previousInput, c.pendingInput, blockSize);
+
+            forwardFFT.performRealOnlyForwardTransform (work);
+            FloatVectorOperations::copy (c.delayLine + delayLineIndex * numBinFloats, work, numBinFloats);
+
+            FloatVectorOperations::clear (work, 4 * blockSize);
+
+            for (int part = 0, index = delayLineIndex; part < numPartitions; ++part)
+            {
+                multiplyAdd (work, c.delayLine + index * numBinFloats,
+                             c.impulseSpectra + part * numBinFloats, numBins);
+
+                if (--index < 0)
+                    index = numPartitions - 1;
+            }
+
+            inverseFFT.performRealOnlyInverseTransform (work);
+            FloatVectorOperations::copy (c.result, work + blockSize, blockSize);
+        }
+
+        if (++delayLineIndex >= numPartitions)
+            delayLineIndex = 0;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Stage)
+};
+
+//==============================================================================
+PartitionedConvolver::PartitionedConvolver()
+    : headSize (0), headPosition (0), impulseLength (0), numChannels (0)
+{
+}
+
+PartitionedConvolver::~PartitionedConvolver()
+{
+}
+
+void PartitionedConvolver::loadImpulseResponse (const AudioSampleBuffer& impulse, int numChannelsToProcess,
+                                                int newHeadSize, int maxPartitionSize, bool useBackgroundThreads)
+{
+    // both of these sizes must be powers of two!
+    jassert (isPowerOfTwo (newHeadSize) && isPowerOfTwo (maxPartitionSize) && maxPartitionSize >= newHeadSize);
+    jassert (numChannelsToProcess > 0 && impulse.getNumChannels() > 0);
+
+    clear();
+
+    if (impulse.getNumChannels() <= 0 || numChannelsToProcess <= 0)
+        return;
+
+    impulseLength = impulse.getNumSamples();
+    numChannels = numChannelsToProcess;
+    headSize = newHeadSize;
+    headPosition = 0;
+
+    headCoefficients.calloc ((size_t) (numChannels * headSize));
+    headHistory.calloc ((size_t) (numChannels * headSize * 2));
+
+    for (int i = 0; i < numChannels; ++i)
+    {
+        const float* const src = impulse.getReadPointer (i % impulse.getNumChannels());
+        float* const dest = headCoefficients + i * headSize;
+
+        // (stored backwards, so they can be applied with a forward-moving dot-product)
+        for (int j = jmin (headSize, impulseLength); --j >= 0;)
+            dest[headSize - 1 - j] = src[j];
+    }
+
+    // Each stage's partitions are 8 times bigger than the previous one. Because the
+    // background stages are given an extra block to do their work, each one starts at
+    // an offset of twice its partition size.
+    const int growthFactor = 8;
+    int start = headSize, partitionSize = headSize;
+
+    while (start < impulseLength)
+    {
+        const int nextPartitionSize = partitionSize * growthFactor;
+        const bool isLastStage = nextPartitionSize > maxPartitionSize;
+        const int end = isLastStage ? impulseLength : jmin (impulseLength, 2 * nextPartitionSize);
+        const int numPartitions = (end - start + partitionSize - 1) / partitionSize;
+
+        stages.add (new Stage (impulse, numChannels, partitionSize, start, numPartitions,
+                               useBackgroundThreads));
+
+        if (isLastStage)
+            break;
+
+        start = 2 * nextPartitionSize;
+        partitionSize = nextPartitionSize;
+    }
+}
+
+void PartitionedConvolver::clear()
+{
+    stages.clear();
+    headCoefficients.free();
+    headHistory.free();
+    headSize = headPosition = impulseLength = numChannels = 0;
+}
+
+void PartitionedConvolver::reset()
+{
+    for (int i = 0; i < stages.size(); ++i)
+        stages.getUnchecked (i)->reset();
+
+    if (headHistory != nullptr)
+        FloatVectorOperations::clear (headHistory, numChannels * headSize * 2);
+
+    headPosition = 0;
+}
+
+void PartitionedConvolver::processSamples (float* const* channelData, int numChannelsToProcess, int numSamples) noexcept
+{
+    if (numChannels == 0)
+    {
+        // no impulse response has been loaded, so the output is silent
+        for (int i = 0; i < numChannelsToProcess; ++i)
+            FloatVectorOperations::clear (channelData[i], numSamples);
+
+        return;
+    }
+
+    jassert (numChannelsToProcess <= numChannels);
+    numChannelsToProcess = jmin (numChannelsToProcess, numChannels);
+
+    const float** const input = static_cast<const float**> (alloca (sizeof (float*) * (size_t) numChannelsToProcess));
+    float** const output = static_cast<float**> (alloca (sizeof (float*) * (size_t) numChannelsToProcess));
+    float* const inputCopy = static_cast<float*> (alloca (sizeof (float) * (size_t) (numChannelsToProcess * headSize)));
+
+    for (int start = 0; start < numSamples;)
+    {
+        // All the stages' block boundaries fall on multiples of the head size, so
+        // the work is split up into chunks that don't cross any of these.
+        const int num = jmin (numSamples - start, headSize - headPosition);
+
+        for (int i = 0; i < numChannelsToProcess; ++i)
+        {
+            float* const data = channelData[i] + start;
+            float* const saved = inputCopy + i * headSize;
+            input[i] = saved;
+            output[i] = data;
+
+            FloatVectorOperations::copy (saved, data, num);
+
+            const float* const coeffs = headCoefficients + i * headSize;
+            float* const history = headHistory + i * headSize * 2;
+
+            for (int j = 0; j < num; ++j)
+            {
+                const int pos = headPosition + j;
+                history[pos] = history[pos + headSize] = saved[j];
+
+                const float* const h = history + pos + 1;
+                float sum = 0;
+
+                for (int k = 0; k < headSize; ++k)
+                    sum += coeffs[k] * h[k];
+
+                data[j] = sum;
+            }
+        }
+
+        for (int i = 0; i < stages.size(); ++i)
+            stages.getUnchecked (i)->process (input, output, numChannelsToProcess, num);
+
+        headPosition = (headPosition + num) & (headSize - 1);
+        start += num;
+    }
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PartitionedConvolverTests  : public UnitTest
+{
+public:
+    PartitionedConvolverTests() : UnitTest ("PartitionedConvolver") {}
+
+    void runTest() override
+    {
+        beginTest ("Matches direct convolution");
+
+        Random random (getRandom());
+
+        const int impulseLength = 1500 + random.nextInt (1000);
+        const int numSamples = 6000;
+        const int numChannels = 2;
+
+        AudioSampleBuffer impulse (1, impulseLength);
+
+        for (int i = 0; i < impulseLength; ++i)
+            impulse.setSample (0, i, (random.nextFloat() * 2.0f - 1.0f) * std::exp (-i * 0.002f));
+
+        AudioSampleBuffer input (numChannels, numSamples), expected (numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                double sum = 0;
+
+                for (int j = jmin (i, impulseLength - 1); j >= 0; --j)
+                    sum += impulse.getSample (0, j) * input.getSample (ch, i - j);
+
+                expected.setSample (ch, i, (float) sum);
+            }
+        }
+
+        for (int useThreads = 0; useThreads < 2; ++useThreads)
+        {
+            PartitionedConvolver convolver;
+            convolver.loadImpulseResponse (impulse, numChannels, 16, 1024, useThreads != 0);
+
+            AudioSampleBuffer output (input);
+
+            for (int start = 0; start < numSamples;)
+            {
+                const int num = jmin (numSamples - start, 1 + random.nextInt (300));
+
+                float* channels[numChannels];
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    channels[ch] = output.getWritePointer (ch, start);
+
+                convolver.processSamples (channels, numChannels, num);
+                start += num;
+            }
+
+            float maxError = 0;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    maxError = jmax (maxError, std::abs (output.getSample (ch, i) - expected.getSample (ch, i)));
+
+            expect (maxError < 1.0e-3f, "max error: " + String (maxError));
+        }
+    }
+};
+
+static PartitionedConvolverTests partitionedConvolverTests;
+
+#endif
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_PARTITIONEDCONVOLVER_H_INCLUDED
+#define JUCE_PARTITIONEDCONVOLVER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Performs zero-latency convolution with an impulse response, using a non-uniformly
+    partitioned set of FFT blocks.
+
+    The first few samples of the impulse response are applied with a direct FIR, so
+    that there's no latency. The rest is split into segments of increasing size, each
+    of which is done using overlap-save with uniformly sized FFT partitions. The small
+    partitions are computed on the audio thread, while each of the larger ones can be
+    handed to its own background thread, and is given a whole block-length to finish,
+    so that very long impulse responses don't cause large spikes in the audio callback.
+
+    The impulse response can have multiple channels, in which case each channel that
+    is processed uses the corresponding impulse channel (wrapping around if there are
+    more channels than impulse channels).
+
+    @see FFT, Reverb
+*/
+class JUCE_API  PartitionedConvolver
+{
+public:
+    //==============================================================================
+    /** Creates a convolver with no impulse response, which will output silence. */
+    PartitionedConvolver();
+
+    /** Destructor. */
+    ~PartitionedConvolver();
+
+    //==============================================================================
+    /** Loads an impulse response and prepares to process the given number of channels.
+
+        This allocates all the memory and threads that are needed, so must not be called
+        while processSamples() may be running on another thread.
+
+        @param impulseResponse      the impulse response. Channel n of the audio being
+                                    processed is convolved with channel (n % numChannels)
+                                    of this buffer.
+        @param numChannelsToProcess the number of channels that processSamples() will be
+                                    called with
+        @param headSize             the number of samples that are done by direct
+                                    convolution, which is also the smallest FFT partition
+                                    size. This must be a power of two.
+        @param maxPartitionSize     the largest FFT partition size to use. This must be a
+                                    power of two.
+        @param useBackgroundThreads if true, the larger partitions are processed by
+                                    background threads; if false, everything happens in
+                                    processSamples(), which is handy for offline rendering
+    */
+    void loadImpulseResponse (const AudioSampleBuffer& impulseResponse,
+                              int numChannelsToProcess,
+                              int headSize = 64,
+                              int maxPartitionSize = 8192,
+                              bool useBackgroundThreads = true);
+
+    /** Removes the impulse response and frees up any resources that were being used. */
+    void clear();
+
+    /** Clears the convolver's internal history, without changing the impulse response. */
+    void reset();
+
+    //==============================================================================
+    /** Convolves a block of samples in-place.
+        The number of channels must not be more than was passed to loadImpulseResponse().
+        Any extra channels are left unchanged.
+    */
+    void processSamples (float* const* channelData, int numChannels, int numSamples) noexcept;
+
+    //==============================================================================
+    /** Returns the length of the impulse response that is loaded. */
+    int getImpulseResponseLength() const noexcept       { return impulseLength; }
+
+    /** Returns the number of channels that was passed to loadImpulseResponse(). */
+    int getNumChannels() const noexcept                 { return numChannels; }
+
+private:
+    //==============================================================================
+    class Stage;
+    friend class Stage;
+    OwnedArray<Stage> stages;
+
+    HeapBlock<float> headCoefficients, headHistory;
+    int headSize, headPosition, impulseLength, numChannels;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PartitionedConvolver)
+};
+
+
+#endif   // JUCE_PARTITIONEDCONVOLVER_H_INCLUDED
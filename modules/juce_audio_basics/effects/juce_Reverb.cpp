@@ -0,0 +1,329 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#if JUCE_USE_SSE_INTRINSICS
+namespace ReverbHelpers
+{
+    static forcedinline __m128 undenormalise (__m128 v) noexcept
+    {
+        // (the same as JUCE_UNDENORMALISE, so that the results match the scalar code)
+        const __m128 offset = _mm_set1_ps (0.1f);
+        return _mm_sub_ps (_mm_add_ps (v, offset), offset);
+    }
+
+    // Runs one sample through four comb filters, each of which is in its own lane
+    static forcedinline __m128 processCombStep (const __m128 output, __m128& last, const float input,
+                                                const float damp, const float feedbackLevel) noexcept
+    {
+        last = undenormalise (_mm_add_ps (_mm_mul_ps (output, _mm_set1_ps (1.0f - damp)),
+                                          _mm_mul_ps (last, _mm_set1_ps (damp))));
+
+        return undenormalise (_mm_add_ps (_mm_set1_ps (input), _mm_mul_ps (last, _mm_set1_ps (feedbackLevel))));
+    }
+}
+#endif
+
+//==============================================================================
+void Reverb::CombFilter::processGroup (CombFilter* const filters, const float* const input, const float* const damp,
+                                       const float* const feedbackLevel, float* const output, const int numSamples) noexcept
+{
+    float* const b0 = filters[0].buffer + filters[0].bufferIndex;
+    float* const b1 = filters[1].buffer + filters[1].bufferIndex;
+    float* const b2 = filters[2].buffer + filters[2].bufferIndex;
+    float* const b3 = filters[3].buffer + filters[3].bufferIndex;
+
+    int i = 0;
+
+   #if JUCE_USE_SSE_INTRINSICS
+    using namespace ReverbHelpers;
+
+    __m128 last = _mm_setr_ps (filters[0].last, filters[1].last, filters[2].last, filters[3].last);
+
+    for (; i + 4 <= numSamples; i += 4)
+    {
+        __m128 x0 = _mm_loadu_ps (b0 + i);
+        __m128 x1 = _mm_loadu_ps (b1 + i);
+        __m128 x2 = _mm_loadu_ps (b2 + i);
+        __m128 x3 = _mm_loadu_ps (b3 + i);
+
+        // (the outputs are added in the same order as the scalar code adds them)
+        _mm_storeu_ps (output + i, _mm_add_ps (_mm_add_ps (_mm_add_ps (_mm_add_ps (_mm_loadu_ps (output + i), x0), x1), x2), x3));
+
+        // after this, each vector holds one time-step for all four filters
+        _MM_TRANSPOSE4_PS (x0, x1, x2, x3);
+
+        x0 = processCombStep (x0, last, input[i],     damp[i],     feedbackLevel[i]);
+        x1 = processCombStep (x1, last, input[i + 1], damp[i + 1], feedbackLevel[i + 1]);
+        x2 = processCombStep (x2, last, input[i + 2], damp[i + 2], feedbackLevel[i + 2]);
+        x3 = processCombStep (x3, last, input[i + 3], damp[i + 3], feedbackLevel[i + 3]);
+
+        _MM_TRANSPOSE4_PS (x0, x1, x2, x3);
+
+        _mm_storeu_ps (b0 + i, x0);
+        _mm_storeu_ps (b1 + i, x1);
+        _mm_storeu_ps (b2 + i, x2);
+        _mm_storeu_ps (b3 + i, x3);
+    }
+
+    float lastValues[4];
+    _mm_storeu_ps (lastValues, last);
+
+    for (int j = 0; j < 4; ++j)
+        filters[j].last = lastValues[j];
+   #endif
+
+    float* const buffers[] = { b0, b1, b2, b3 };
+
+    for (; i < numSamples; ++i)
+    {
+        for (int j = 0; j < 4; ++j)
+        {
+            CombFilter& f = filters[j];
+
+            const float out = buffers[j][i];
+            f.last = (out * (1.0f - damp[i])) + (f.last * damp[i]);
+            JUCE_UNDENORMALISE (f.last);
+
+            float temp = input[i] + (f.last * feedbackLevel[i]);
+            JUCE_UNDENORMALISE (temp);
+            buffers[j][i] = temp;
+            output[i] += out;
+        }
+    }
+
+    for (int j = 0; j < 4; ++j)
+    {
+        CombFilter& f = filters[j];
+        jassert (numSamples <= f.getNumSamplesBeforeWrapping());
+
+        f.bufferIndex += numSamples;
+
+        if (f.bufferIndex >= f.bufferSize)
+            f.bufferIndex = 0;
+    }
+}
+
+void Reverb::AllPassFilter::processBlock (float* const samples, const int numSamples) noexcept
+{
+    jassert (numSamples <= getNumSamplesBeforeWrapping());
+
+    float* const b = buffer + bufferIndex;
+    int i = 0;
+
+   #if JUCE_USE_SSE_INTRINSICS
+    using namespace ReverbHelpers;
+
+    for (; i + 4 <= numSamples; i += 4)
+    {
+        const __m128 input = _mm_loadu_ps (samples + i);
+        const __m128 bufferedValue = _mm_loadu_ps (b + i);
+
+        _mm_storeu_ps (b + i, undenormalise (_mm_add_ps (input, _mm_mul_ps (bufferedValue, _mm_set1_ps (0.5f)))));
+        _mm_storeu_ps (samples + i, _mm_sub_ps (bufferedValue, input));
+    }
+   #endif
+
+    for (; i < numSamples; ++i)
+    {
+        const float bufferedValue = b[i];
+        float temp = samples[i] + (bufferedValue * 0.5f);
+        JUCE_UNDENORMALISE (temp);
+        b[i] = temp;
+        samples[i] = bufferedValue - samples[i];
+    }
+
+    bufferIndex += numSamples;
+
+    if (bufferIndex >= bufferSize)
+        bufferIndex = 0;
+}
+
+//==============================================================================
+// Each block stops where the first of the delay lines wraps around, so that every filter
+// can treat its part of the block as a contiguous section of its buffer.
+int Reverb::getNextBlockSize (const int numSamplesLeft, const int numChannelsUsed) const noexcept
+{
+    int num = jmin (numSamplesLeft, (int) maxBlockSize);
+
+    for (int j = 0; j < numChannelsUsed; ++j)
+    {
+        for (int i = 0; i < numCombs; ++i)
+            num = jmin (num, comb[j][i].getNumSamplesBeforeWrapping());
+
+        for (int i = 0; i < numAllPasses; ++i)
+            num = jmin (num, allPass[j][i].getNumSamplesBeforeWrapping());
+    }
+
+    return num;
+}
+
+void Reverb::prepareBlock (float* const damp, float* const feedbackLevel, const int numSamples) noexcept
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        damp[i]          = damping.getNextValue();
+        feedbackLevel[i] = feedback.getNextValue();
+    }
+}
+
+void Reverb::processChannel (const int channel, const float* const input, const float* const damp,
+                             const float* const feedbackLevel, float* const output, const int numSamples) noexcept
+{
+    zeromem (output, sizeof (float) * (size_t) numSamples);
+
+    // accumulate the comb filters in parallel..
+    for (int i = 0; i < numCombs; i += 4)
+        CombFilter::processGroup (comb[channel] + i, input, damp, feedbackLevel, output, numSamples);
+
+    // ..and run the allpass filters in series
+    for (int i = 0; i < numAllPasses; ++i)
+        allPass[channel][i].processBlock (output, numSamples);
+}
+
+void Reverb::processStereo (float* const left, float* const right, const int numSamples) noexcept
+{
+    jassert (left != nullptr && right != nullptr);
+
+    float input[maxBlockSize], damp[maxBlockSize], feedbackLevel[maxBlockSize];
+    float outL[maxBlockSize], outR[maxBlockSize];
+
+    for (int start = 0; start < numSamples;)
+    {
+        const int num = getNextBlockSize (numSamples - start, 2);
+        float* const l = left + start;
+        float* const r = right + start;
+
+        for (int i = 0; i < num; ++i)
+            input[i] = (l[i] + r[i]) * gain;
+
+        prepareBlock (damp, feedbackLevel, num);
+        processChannel (0, input, damp, feedbackLevel, outL, num);
+        processChannel (1, input, damp, feedbackLevel, outR, num);
+
+        for (int i = 0; i < num; ++i)
+        {
+            const float dry  = dryGain.getNextValue();
+            const float wet1 = wetGain1.getNextValue();
+            const float wet2 = wetGain2.getNextValue();
+
+            l[i] = outL[i] * wet1 + outR[i] * wet2 + l[i] * dry;
+            r[i] = outR[i] * wet1 + outL[i] * wet2 + r[i] * dry;
+        }
+
+        start += num;
+    }
+}
+
+void Reverb::processMono (float* const samples, const int numSamples) noexcept
+{
+    jassert (samples != nullptr);
+
+    float input[maxBlockSize], damp[maxBlockSize], feedbackLevel[maxBlockSize], output[maxBlockSize];
+
+    for (int start = 0; start < numSamples;)
+    {
+        const int num = getNextBlockSize (numSamples - start, 1);
+        float* const s = samples + start;
+
+        for (int i = 0; i < num; ++i)
+            input[i] = s[i] * gain;
+
+        prepareBlock (damp, feedbackLevel, num);
+        processChannel (0, input, damp, feedbackLevel, output, num);
+
+        for (int i = 0; i < num; ++i)
+        {
+            const float dry  = dryGain.getNextValue();
+            const float wet1 = wetGain1.getNextValue();
+
+            s[i] = output[i] * wet1 + s[i] * dry;
+        }
+
+        start += num;
+    }
+}
+
+//==============================================================================
+MultiChannelReverb::MultiChannelReverb (const int numChans)
+    : sampleRate (44100.0), numChannels (0)
+{
+    setNumChannels (numChans);
+}
+
+MultiChannelReverb::~MultiChannelReverb()
+{
+}
+
+void MultiChannelReverb::setNumChannels (const int newNumChannels)
+{
+    numChannels = jmax (0, newNumChannels);
+    const int numReverbs = (numChannels + 1) / 2;
+
+    while (reverbs.size() < numReverbs)
+    {
+        Reverb* const r = reverbs.add (new Reverb());
+        r->setParameters (parameters);
+        r->setSampleRate (sampleRate);
+    }
+
+    reverbs.removeRange (numReverbs, reverbs.size());
+}
+
+void MultiChannelReverb::setParameters (const Reverb::Parameters& newParams)
+{
+    parameters = newParams;
+
+    for (int i = reverbs.size(); --i >= 0;)
+        reverbs.getUnchecked (i)->setParameters (newParams);
+}
+
+void MultiChannelReverb::setSampleRate (const double newSampleRate)
+{
+    sampleRate = newSampleRate;
+
+    for (int i = reverbs.size(); --i >= 0;)
+        reverbs.getUnchecked (i)->setSampleRate (newSampleRate);
+}
+
+void MultiChannelReverb::reset()
+{
+    for (int i = reverbs.size(); --i >= 0;)
+        reverbs.getUnchecked (i)->reset();
+}
+
+void MultiChannelReverb::processSamples (float* const* const channels, int numToProcess, const int numSamples) noexcept
+{
+    jassert (numToProcess <= numChannels);
+    numToProcess = jmin (numToProcess, numChannels);
+
+    for (int i = 0; i < numToProcess; i += 2)
+    {
+        Reverb& r = *reverbs.getUnchecked (i / 2);
+
+        if (i + 1 < numToProcess)
+            r.processStereo (channels[i], channels[i + 1], numSamples);
+        else
+            r.processMono (channels[i], numSamples);
+    }
+}
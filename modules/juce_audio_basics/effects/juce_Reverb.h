@@ -34,9 +34,12 @@
     Use setSampleRate() to prepare it, and then call processStereo() or processMono() to
     apply the reverb to your audio data.
 
-    @see ReverbAudioSource
+    The audio is processed in short blocks, and where SSE is available each channel's eight
+    comb filters are run four at a time, one per vector lane.
+
+    @see MultiChannelReverb, ReverbAudioSource
 */
-class Reverb
+class JUCE_API  Reverb
 {
 public:
     //==============================================================================
@@ -139,64 +142,10 @@ public:
 
     //==============================================================================
     /** Applies the reverb to two stereo channels of audio data. */
-    void processStereo (float* const left, float* const right, const int numSamples) noexcept
-    {
-        jassert (left != nullptr && right != nullptr);
-
-        for (int i = 0; i < numSamples; ++i)
-        {
-            const float input = (left[i] + right[i]) * gain;
-            float outL = 0, outR = 0;
-
-            const float damp    = damping.getNextValue();
-            const float feedbck = feedback.getNextValue();
-
-            for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
-            {
-                outL += comb[0][j].process (input, damp, feedbck);
-                outR += comb[1][j].process (input, damp, feedbck);
-            }
-
-            for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
-            {
-                outL = allPass[0][j].process (outL);
-                outR = allPass[1][j].process (outR);
-            }
-
-            const float dry  = dryGain.getNextValue();
-            const float wet1 = wetGain1.getNextValue();
-            const float wet2 = wetGain2.getNextValue();
-
-            left[i]  = outL * wet1 + outR * wet2 + left[i]  * dry;
-            right[i] = outR * wet1 + outL * wet2 + right[i] * dry;
-        }
-    }
+    void processStereo (float* left, float* right, int numSamples) noexcept;
 
     /** Applies the reverb to a single mono channel of audio data. */
-    void processMono (float* const samples, const int numSamples) noexcept
-    {
-        jassert (samples != nullptr);
-
-        for (int i = 0; i < numSamples; ++i)
-        {
-            const float input = samples[i] * gain;
-            float output = 0;
-
-            const float damp    = damping.getNextValue();
-            const float feedbck = feedback.getNextValue();
-
-            for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
-                output += comb[0][j].process (input, damp, feedbck);
-
-            for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
-                output = allPass[0][j].process (output);
-
-            const float dry  = dryGain.getNextValue();
-            const float wet1 = wetGain1.getNextValue();
-
-            samples[i] = output * wet1 + samples[i] * dry;
-        }
-    }
+    void processMono (float* samples, int numSamples) noexcept;
 
 private:
     //==============================================================================
@@ -245,18 +194,13 @@ private:
             buffer.clear ((size_t) bufferSize);
         }
 
-        float process (const float input, const float damp, const float feedbackLevel) noexcept
-        {
-            const float output = buffer[bufferIndex];
-            last = (output * (1.0f - damp)) + (last * damp);
-            JUCE_UNDENORMALISE (last);
-
-            float temp = input + (last * feedbackLevel);
-            JUCE_UNDENORMALISE (temp);
-            buffer[bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
-            return output;
-        }
+        int getNumSamplesBeforeWrapping() const noexcept    { return bufferSize - bufferIndex; }
+
+        /** Runs a group of four filters over a block, adding their outputs to the output array.
+            The block mustn't be longer than getNumSamplesBeforeWrapping() for any of them.
+        */
+        static void processGroup (CombFilter* filters, const float* input, const float* damp,
+                                  const float* feedbackLevel, float* output, int numSamples) noexcept;
 
     private:
         HeapBlock<float> buffer;
@@ -289,15 +233,12 @@ private:
             buffer.clear ((size_t) bufferSize);
         }
 
-        float process (const float input) noexcept
-        {
-            const float bufferedValue = buffer [bufferIndex];
-            float temp = input + (bufferedValue * 0.5f);
-            JUCE_UNDENORMALISE (temp);
-            buffer [bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
-            return bufferedValue - input;
-        }
+        int getNumSamplesBeforeWrapping() const noexcept    { return bufferSize - bufferIndex; }
+
+        /** Processes a block in-place.
+            The block mustn't be longer than getNumSamplesBeforeWrapping().
+        */
+        void processBlock (float* samples, int numSamples) noexcept;
 
     private:
         HeapBlock<float> buffer;
@@ -355,7 +296,7 @@ private:
     };
 
     //==============================================================================
-    enum { numCombs = 8, numAllPasses = 4, numChannels = 2 };
+    enum { numCombs = 8, numAllPasses = 4, numChannels = 2, maxBlockSize = 64 };
 
     Parameters parameters;
     float gain;
@@ -365,8 +306,71 @@ private:
 
     LinearSmoothedValue damping, feedback, dryGain, wetGain1, wetGain2;
 
+    int getNextBlockSize (int numSamplesLeft, int numChannelsUsed) const noexcept;
+    void prepareBlock (float* damp, float* feedbackLevel, int numSamples) noexcept;
+    void processChannel (int channel, const float* input, const float* damp,
+                         const float* feedbackLevel, float* output, int numSamples) noexcept;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Reverb)
 };
 
+//==============================================================================
+/**
+    Applies a Reverb to any number of channels.
+
+    The channels are taken in pairs, each of which is processed as a stereo Reverb, and if
+    there's an odd number of them, the last one is processed in mono. All the channels share
+    the same parameters, so a single object can be used for a whole multichannel stream.
+
+    @see Reverb, ReverbAudioSource
+*/
+class JUCE_API  MultiChannelReverb
+{
+public:
+    //==============================================================================
+    /** Creates a reverb for the given number of channels. */
+    MultiChannelReverb (int numChannels = 2);
+
+    /** Destructor. */
+    ~MultiChannelReverb();
+
+    //==============================================================================
+    /** Changes the number of channels that can be processed.
+        The state of any existing channels is kept.
+    */
+    void setNumChannels (int newNumChannels);
+
+    /** Returns the number of channels that can be processed. */
+    int getNumChannels() const noexcept                         { return numChannels; }
+
+    //==============================================================================
+    /** Returns the reverb's current parameters. */
+    const Reverb::Parameters& getParameters() const noexcept    { return parameters; }
+
+    /** Applies a new set of parameters to all the channels. */
+    void setParameters (const Reverb::Parameters& newParams);
+
+    /** Sets the sample rate that will be used for all the channels. */
+    void setSampleRate (double newSampleRate);
+
+    /** Clears the reverb's buffers. */
+    void reset();
+
+    //==============================================================================
+    /** Applies the reverb to a set of channels in-place.
+        The number of channels must not be more than getNumChannels().
+    */
+    void processSamples (float* const* channels, int numChannelsToProcess, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    OwnedArray<Reverb> reverbs;
+    Reverb::Parameters parameters;
+    double sampleRate;
+    int numChannels;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultiChannelReverb)
+};
+
 
 #endif   // JUCE_REVERB_H_INCLUDED
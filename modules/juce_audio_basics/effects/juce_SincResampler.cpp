@@ -0,0 +1,303 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+namespace SincResamplerHelpers
+{
+    struct QualitySettings
+    {
+        int numTaps, numPhases;
+        double rolloff, kaiserBeta;
+    };
+
+    static const QualitySettings& getSettings (SincResampler::Quality quality) noexcept
+    {
+        static const QualitySettings settings[] =
+        {
+            {  16,   64, 0.85, 6.0 },
+            {  32,  128, 0.90, 8.0 },
+            {  64,  256, 0.94, 10.0 },
+            { 128, 1024, 0.96, 12.5 }
+        };
+
+        return settings [jlimit (0, numElementsInArray (settings) - 1, (int) quality)];
+    }
+
+    // zeroth-order modified bessel function of the first kind, for the kaiser window
+    static double besselI0 (const double x) noexcept
+    {
+        const double halfX = x * 0.5;
+        double sum = 1.0, term = 1.0;
+
+        for (int k = 1; k < 64 && term > sum * 1.0e-12; ++k)
+        {
+            const double t = halfX / k;
+            term *= t * t;
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    static int roundUpToMultipleOf8 (const int n) noexcept
+    {
+        return (n + 7) & ~7;
+    }
+}
+
+//==============================================================================
+SincResampler::SincResampler (const Quality q, const double maxSpeedRatio)
+    : quality (q),
+      baseNumTaps (SincResamplerHelpers::getSettings (q).numTaps),
+      numPhases (SincResamplerHelpers::getSettings (q).numPhases),
+      maxNumTaps (SincResamplerHelpers::roundUpToMultipleOf8 (roundToInt (baseNumTaps * jlimit (1.0, 16.0, maxSpeedRatio)))),
+      numTaps (baseNumTaps),
+      tableCutoff (0),
+      historyPos (0),
+      subSamplePos (1.0)
+{
+    table.malloc ((size_t) ((numPhases + 1) * maxNumTaps));
+    history.malloc ((size_t) (maxNumTaps * 2));
+
+    fillTable (SincResamplerHelpers::getSettings (quality).rolloff, baseNumTaps);
+    reset();
+}
+
+SincResampler::~SincResampler() {}
+
+void SincResampler::reset() noexcept
+{
+    FloatVectorOperations::clear (history, maxNumTaps * 2);
+    historyPos = 0;
+    subSamplePos = 1.0;
+}
+
+void SincResampler::fillTable (const double cutoff, const int numTapsToUse) noexcept
+{
+    using namespace SincResamplerHelpers;
+
+    const double beta = getSettings (quality).kaiserBeta;
+    const double windowScale = 1.0 / besselI0 (beta);
+    const double halfLength = numTapsToUse / 2;
+
+    for (int phase = 0; phase <= numPhases; ++phase)
+    {
+        // tap k is (k - (halfLength - 1) - fraction) samples away from the output position
+        const double offset = (halfLength - 1.0) + phase / (double) numPhases;
+        float* const coeffs = table + phase * numTapsToUse;
+        double total = 0;
+
+        for (int k = 0; k < numTapsToUse; ++k)
+        {
+            const double distance = k - offset;
+            const double x = double_Pi * cutoff * distance;
+            const double sinc = x == 0 ? 1.0 : std::sin (x) / x;
+
+            const double w = distance / halfLength;
+            const double window = w * w < 1.0 ? besselI0 (beta * std::sqrt (1.0 - w * w)) * windowScale : 0.0;
+
+            const double value = cutoff * sinc * window;
+            coeffs[k] = (float) value;
+            total += value;
+        }
+
+        // normalise each phase so that the DC gain is exactly 1
+        if (total != 0)
+            FloatVectorOperations::multiply (coeffs, (float) (1.0 / total), numTapsToUse);
+    }
+
+    numTaps = numTapsToUse;
+    tableCutoff = cutoff;
+}
+
+void SincResampler::updateTableForRatio (const double speedRatio) noexcept
+{
+    const double rolloff = SincResamplerHelpers::getSettings (quality).rolloff;
+
+    if (speedRatio <= 1.0)
+    {
+        if (tableCutoff != rolloff)
+            fillTable (rolloff, baseNumTaps);
+    }
+    else
+    {
+        const double cutoff = rolloff / speedRatio;
+
+        // Re-use the current table unless it would let through too much aliasing, or
+        // would cut off too much of the wanted signal.
+        if (cutoff < tableCutoff * 0.98 || cutoff > tableCutoff * 1.02)
+            fillTable (cutoff, jmin (maxNumTaps, SincResamplerHelpers::roundUpToMultipleOf8 (roundToInt (std::ceil (baseNumTaps * speedRatio)))));
+    }
+}
+
+inline void SincResampler::push (const float newSample) noexcept
+{
+    // Each sample is stored twice, so that the most recent maxNumTaps samples
+    // are always available as a contiguous block.
+    if (++historyPos >= maxNumTaps)
+        historyPos = 0;
+
+    history [historyPos] = newSample;
+    history [historyPos + maxNumTaps] = newSample;
+}
+
+inline float SincResampler::getValueAtOffset (const double offset) const noexcept
+{
+    const float* const samples = history + (historyPos + maxNumTaps + 1 - numTaps);
+
+    const double phase = offset * numPhases;
+    const int index = jmin (numPhases - 1, (int) phase);
+    const float alpha = (float) (phase - index);
+
+    const float* const coeffs = table + index * numTaps;
+    const float v1 = FloatVectorOperations::dotProduct (samples, coeffs, numTaps);
+    const float v2 = FloatVectorOperations::dotProduct (samples, coeffs + numTaps, numTaps);
+
+    return v1 + alpha * (v2 - v1);
+}
+
+template <bool addToOutput>
+int SincResampler::processInternal (const double speedRatio, const float* in,
+                                    float* out, const int numOut, const float gain) noexcept
+{
+    jassert (speedRatio > 0);
+    updateTableForRatio (speedRatio);
+
+    const float* const originalIn = in;
+    double pos = subSamplePos;
+
+    for (int i = numOut; --i >= 0;)
+    {
+        while (pos >= 1.0)
+        {
+            push (*in++);
+            pos -= 1.0;
+        }
+
+        if (addToOutput)
+            *out++ += gain * getValueAtOffset (pos);
+        else
+            *out++ = getValueAtOffset (pos);
+
+        pos += speedRatio;
+    }
+
+    subSamplePos = pos;
+    return (int) (in - originalIn);
+}
+
+int SincResampler::process (const double speedRatio, const float* in,
+                            float* out, const int numOut) noexcept
+{
+    return processInternal<false> (speedRatio, in, out, numOut, 1.0f);
+}
+
+int SincResampler::processAdding (const double speedRatio, const float* in,
+                                  float* out, const int numOut, const float gain) noexcept
+{
+    return processInternal<true> (speedRatio, in, out, numOut, gain);
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SincResamplerTests  : public UnitTest
+{
+public:
+    SincResamplerTests() : UnitTest ("SincResampler") {}
+
+    // Resamples a sine wave in small blocks, and returns the largest difference between
+    // the output and the ideal result.
+    float getWorstError (SincResampler::Quality quality, double ratio, double frequency, bool shouldBePassed)
+    {
+        const int numInputSamples = 20000;
+        const int numOutputSamples = (int) ((numInputSamples - 100) / ratio);
+
+        HeapBlock<float> input ((size_t) numInputSamples), output ((size_t) numOutputSamples);
+
+        for (int i = 0; i < numInputSamples; ++i)
+            input[i] = (float) std::sin (2.0 * double_Pi * frequency * i);
+
+        SincResampler resampler (quality);
+        Random r (getRandom());
+        int numUsed = 0;
+
+        for (int numDone = 0; numDone < numOutputSamples;)
+        {
+            const int num = jmin (r.nextInt (200) + 1, numOutputSamples - numDone);
+            const int used = resampler.process (ratio, input + numUsed, output + numDone, num);
+
+            expect (used <= (int) std::ceil (num * ratio));
+            numUsed += used;
+            numDone += num;
+        }
+
+        const int latency = resampler.getLatencyInSamples();
+        float worst = 0;
+
+        for (int i = 1000; i < numOutputSamples; ++i)
+        {
+            const double expected = shouldBePassed ? std::sin (2.0 * double_Pi * frequency * (i * ratio - latency)) : 0.0;
+            worst = jmax (worst, std::abs (output[i] - (float) expected));
+        }
+
+        return worst;
+    }
+
+    void runTest() override
+    {
+        beginTest ("Up-sampling");
+        expect (getWorstError (SincResampler::normalQuality, 44100.0 / 48000.0, 0.1, true) < 0.001f);
+        expect (getWorstError (SincResampler::highQuality, 44100.0 / 96000.0, 0.3, true) < 0.0001f);
+
+        beginTest ("Down-sampling");
+        expect (getWorstError (SincResampler::normalQuality, 2.0, 0.1, true) < 0.001f);
+        expect (getWorstError (SincResampler::normalQuality, 2.0, 0.3, false) < 0.001f);
+        expect (getWorstError (SincResampler::highQuality, 96000.0 / 44100.0, 0.4, false) < 0.0001f);
+
+        beginTest ("Adding");
+        {
+            HeapBlock<float> input (1000), output1 (1000), output2 (1000);
+            Random r (getRandom());
+
+            for (int i = 0; i < 1000; ++i)
+                input[i] = r.nextFloat() - 0.5f;
+
+            FloatVectorOperations::fill (output2, 0.25f, 800);
+
+            SincResampler resampler1, resampler2;
+            const int used1 = resampler1.process (1.2, input, output1, 800);
+            const int used2 = resampler2.processAdding (1.2, input, output2, 800, 0.5f);
+
+            expectEquals (used1, used2);
+
+            for (int i = 0; i < 800; ++i)
+                expect (std::abs (output2[i] - (0.25f + 0.5f * output1[i])) < 1.0e-6f);
+        }
+    }
+};
+
+static SincResamplerTests sincResamplerTests;
+
+#endif
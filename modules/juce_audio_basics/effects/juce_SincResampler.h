@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_SINCRESAMPLER_H_INCLUDED
+#define JUCE_SINCRESAMPLER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Resamples a stream of floats using a windowed-sinc polyphase filter.
+
+    This is much more expensive than a LagrangeInterpolator, but is suitable for
+    high-quality sample-rate conversion. The filter is a Kaiser-windowed sinc, tabulated
+    at a number of sub-sample phases, and each output sample is interpolated from
+    the two nearest phases, so any ratio can be used, and it can change from one call
+    to the next for varispeed playback.
+
+    When down-sampling, the filter's cutoff is lowered and its length is increased
+    to avoid aliasing. Re-calculating the table takes a moment, so small changes in
+    the ratio will re-use the current table as long as its cutoff is still close enough.
+
+    Like the LagrangeInterpolator, this is stateful, so when there's a break in the
+    continuity of the input stream you should call reset(), and each channel needs
+    its own SincResampler object.
+
+    @see LagrangeInterpolator, ResamplingAudioSource
+*/
+class JUCE_API  SincResampler
+{
+public:
+    //==============================================================================
+    /** The filter settings that can be used. Each step roughly doubles the CPU cost. */
+    enum Quality
+    {
+        draftQuality = 0,   /**< 16 taps, with about 65dB of stop-band rejection. */
+        normalQuality,      /**< 32 taps, with about 80dB of stop-band rejection. */
+        highQuality,        /**< 64 taps, with about 100dB of stop-band rejection. */
+        masteringQuality    /**< 128 taps, with about 120dB of stop-band rejection. */
+    };
+
+    /** Creates a resampler.
+
+        @param quality              the filter preset to use
+        @param maxSpeedRatio        the highest down-sampling ratio for which the filter
+                                    will be lengthened to keep its quality. Above this, it'll
+                                    still be band-limited correctly, but with a wider
+                                    transition band. This determines how much memory is
+                                    allocated up-front, as none is allocated while processing.
+    */
+    SincResampler (Quality quality = normalQuality, double maxSpeedRatio = 4.0);
+
+    /** Destructor. */
+    ~SincResampler();
+
+    /** Returns the quality that was passed to the constructor. */
+    Quality getQuality() const noexcept                 { return quality; }
+
+    /** Resets the state of the resampler.
+        Call this when there's a break in the continuity of the input data stream.
+    */
+    void reset() noexcept;
+
+    /** Returns the delay, in input samples, that the filter currently introduces.
+        This is half the filter's length, so it'll be longer when down-sampling.
+    */
+    int getLatencyInSamples() const noexcept            { return numTaps / 2; }
+
+    //==============================================================================
+    /** Resamples a stream of samples.
+
+        @param speedRatio       the number of input samples to use for each output sample
+        @param inputSamples     the source data to read from. This must contain at
+                                least (speedRatio * numOutputSamplesToProduce) samples,
+                                rounded up.
+        @param outputSamples    the buffer to write the results into
+        @param numOutputSamplesToProduce    the number of output samples that should be created
+
+        @returns the actual number of input samples that were used
+    */
+    int process (double speedRatio,
+                 const float* inputSamples,
+                 float* outputSamples,
+                 int numOutputSamplesToProduce) noexcept;
+
+    /** Resamples a stream of samples, adding the results to the output data
+        with a gain.
+
+        @param speedRatio       the number of input samples to use for each output sample
+        @param inputSamples     the source data to read from. This must contain at
+                                least (speedRatio * numOutputSamplesToProduce) samples,
+                                rounded up.
+        @param outputSamples    the buffer to write the results to - the result values will be added
+                                to any pre-existing data in this buffer after being multiplied by
+                                the gain factor
+        @param numOutputSamplesToProduce    the number of output samples that should be created
+        @param gain             a gain factor to multiply the resulting samples by before
+                                adding them to the destination buffer
+
+        @returns the actual number of input samples that were used
+    */
+    int processAdding (double speedRatio,
+                       const float* inputSamples,
+                       float* outputSamples,
+                       int numOutputSamplesToProduce,
+                       float gain) noexcept;
+
+private:
+    //==============================================================================
+    const Quality quality;
+    const int baseNumTaps, numPhases, maxNumTaps;
+    int numTaps;
+    double tableCutoff;
+
+    HeapBlock<float> table, history;
+    int historyPos;
+    double subSamplePos;
+
+    void updateTableForRatio (double speedRatio) noexcept;
+    void fillTable (double cutoff, int numTapsToUse) noexcept;
+    void push (float newSample) noexcept;
+    float getValueAtOffset (double) const noexcept;
+
+    template <bool addToOutput>
+    int processInternal (double, const float*, float*, int, float) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SincResampler)
+};
+
+
+#endif   // JUCE_SINCRESAMPLER_H_INCLUDED
@@ -52,6 +52,24 @@
  #include <emmintrin.h>
 #endif
 
+// The AVX code is compiled with per-function target attributes and only used after checking
+// the CPU at runtime, so it needs a compiler whose headers allow that.
+#ifndef JUCE_USE_AVX_INTRINSICS
+ #if JUCE_USE_SSE_INTRINSICS && ((JUCE_MSVC && _MSC_FULL_VER >= 160040219) \
+                                  || (JUCE_CLANG && __clang_major__ >= 8) \
+                                  || (JUCE_GCC && ! JUCE_CLANG && __GNUC__ >= 5))
+  #define JUCE_USE_AVX_INTRINSICS 1
+ #endif
+#endif
+
+#if ! JUCE_USE_SSE_INTRINSICS
+ #undef JUCE_USE_AVX_INTRINSICS
+#endif
+
+#if JUCE_USE_AVX_INTRINSICS
+ #include <immintrin.h>
+#endif
+
 #ifndef JUCE_USE_VDSP_FRAMEWORK
  #define JUCE_USE_VDSP_FRAMEWORK 1
 #endif
@@ -80,19 +98,28 @@ namespace juce
 #include "buffers/juce_FloatVectorOperations.cpp"
 #include "effects/juce_IIRFilter.cpp"
 #include "effects/juce_LagrangeInterpolator.cpp"
+#include "effects/juce_SincResampler.cpp"
 #include "effects/juce_FFT.cpp"
+#include "effects/juce_PartitionedConvolver.cpp"
+#include "effects/juce_Reverb.cpp"
+#include "effects/juce_LoudnessMeter.cpp"
+#include "effects/juce_Oversampling.cpp"
 #include "midi/juce_MidiBuffer.cpp"
 #include "midi/juce_MidiFile.cpp"
+#include "midi/juce_StreamingMidiFileReader.cpp"
 #include "midi/juce_MidiKeyboardState.cpp"
 #include "midi/juce_MidiMessage.cpp"
 #include "midi/juce_MidiMessageSequence.cpp"
 #include "sources/juce_BufferingAudioSource.cpp"
+#include "sources/juce_AudioStreamingEngine.cpp"
 #include "sources/juce_ChannelRemappingAudioSource.cpp"
 #include "sources/juce_IIRFilterAudioSource.cpp"
 #include "sources/juce_MixerAudioSource.cpp"
 #include "sources/juce_ResamplingAudioSource.cpp"
 #include "sources/juce_ReverbAudioSource.cpp"
 #include "sources/juce_ToneGeneratorAudioSource.cpp"
-#include "synthesisers/juce_Synthesiser.cpp"
+#include "synthesisers/juce_Synthesiser.cpp"
+#include "synthesisers/juce_SineOscillatorBank.cpp"
+#include "synthesisers/juce_WavetableOscillator.cpp"
 
 }
@@ -34,29 +34,39 @@ namespace juce
 #undef Complex  // apparently some C libraries actually define these symbols (!)
 #undef Factor
 
+#include "audio_play_head/juce_AudioPlayHead.h"
 #include "buffers/juce_AudioDataConverters.h"
 #include "buffers/juce_AudioSampleBuffer.h"
 #include "buffers/juce_FloatVectorOperations.h"
 #include "effects/juce_Decibels.h"
 #include "effects/juce_IIRFilter.h"
 #include "effects/juce_LagrangeInterpolator.h"
+#include "effects/juce_SincResampler.h"
 #include "effects/juce_FFT.h"
+#include "effects/juce_PartitionedConvolver.h"
 #include "effects/juce_Reverb.h"
+#include "effects/juce_LoudnessMeter.h"
+#include "effects/juce_Oversampling.h"
 #include "midi/juce_MidiMessage.h"
+#include "midi/juce_MidiMessageView.h"
 #include "midi/juce_MidiBuffer.h"
 #include "midi/juce_MidiMessageSequence.h"
 #include "midi/juce_MidiFile.h"
+#include "midi/juce_StreamingMidiFileReader.h"
 #include "midi/juce_MidiKeyboardState.h"
 #include "sources/juce_AudioSource.h"
 #include "sources/juce_PositionableAudioSource.h"
 #include "sources/juce_BufferingAudioSource.h"
+#include "sources/juce_AudioStreamingEngine.h"
 #include "sources/juce_ChannelRemappingAudioSource.h"
 #include "sources/juce_IIRFilterAudioSource.h"
 #include "sources/juce_MixerAudioSource.h"
 #include "sources/juce_ResamplingAudioSource.h"
 #include "sources/juce_ReverbAudioSource.h"
 #include "sources/juce_ToneGeneratorAudioSource.h"
-#include "synthesisers/juce_Synthesiser.h"
+#include "synthesisers/juce_Synthesiser.h"
+#include "synthesisers/juce_SineOscillatorBank.h"
+#include "synthesisers/juce_WavetableOscillator.h"
 
 }
 
@@ -75,58 +75,234 @@ namespace MidiBufferHelpers
 
         return d;
     }
+
+    static void writeEvent (uint8* const d, const int sampleNumber, const void* const midiData, const int numBytes) noexcept
+    {
+        *reinterpret_cast<int32*> (d) = sampleNumber;
+        *reinterpret_cast<uint16*> (d + 4) = (uint16) numBytes;
+        memcpy (d + 6, midiData, (size_t) numBytes);
+    }
+
+    static const uint8* findEndOfSortedRun (const uint8* d, const uint8* const endData) noexcept
+    {
+        int lastTime = getEventTime (d);
+
+        for (d += getEventTotalSize (d); d < endData; d += getEventTotalSize (d))
+        {
+            const int time = getEventTime (d);
+
+            if (time < lastTime)
+                break;
+
+            lastTime = time;
+        }
+
+        return d;
+    }
+
+    static uint8* mergeSortedRuns (const uint8* a, const uint8* const aEnd,
+                                   const uint8* b, const uint8* const bEnd, uint8* dest) noexcept
+    {
+        while (a < aEnd && b < bEnd)
+        {
+            // when the times are equal, the event from the first run goes first, so that
+            // the order of the events is otherwise preserved
+            const uint8*& source = (getEventTime (b) < getEventTime (a)) ? b : a;
+            const size_t size = getEventTotalSize (source);
+
+            memcpy (dest, source, size);
+            dest += size;
+            source += size;
+        }
+
+        memcpy (dest, a, (size_t) (aEnd - a));  dest += aEnd - a;
+        memcpy (dest, b, (size_t) (bEnd - b));  dest += bEnd - b;
+        return dest;
+    }
 }
 
 //==============================================================================
-MidiBuffer::MidiBuffer() noexcept {}
+MidiBuffer::MidiBuffer() noexcept  : fixedCapacity (0), sortSpaceSize (0) {}
 MidiBuffer::~MidiBuffer() {}
 
-MidiBuffer::MidiBuffer (const MidiBuffer& other) noexcept  : data (other.data) {}
+MidiBuffer::MidiBuffer (const MidiBuffer& other) noexcept
+    : data (other.data), fixedCapacity (0), sortSpaceSize (0)
+{
+}
 
 MidiBuffer& MidiBuffer::operator= (const MidiBuffer& other) noexcept
 {
-    data = other.data;
+    if (fixedCapacity > 0)
+    {
+        if (&other != this)
+        {
+            data.clearQuick();
+            data.addArray (static_cast<const uint8*> (other.data.begin()), getNumBytesThatFit (other.data.begin(), other.data.end()));
+        }
+    }
+    else
+    {
+        data = other.data;
+    }
+
     return *this;
 }
 
-MidiBuffer::MidiBuffer (const MidiMessage& message) noexcept
+MidiBuffer::MidiBuffer (const MidiMessage& message) noexcept  : fixedCapacity (0), sortSpaceSize (0)
 {
     addEvent (message, 0);
 }
 
-void MidiBuffer::swapWith (MidiBuffer& other) noexcept      { data.swapWith (other.data); }
+void MidiBuffer::swapWith (MidiBuffer& other) noexcept
+{
+    data.swapWith (other.data);
+    sortSpace.swapWith (other.sortSpace);
+    std::swap (fixedCapacity, other.fixedCapacity);
+    std::swap (sortSpaceSize, other.sortSpaceSize);
+}
+
 void MidiBuffer::clear() noexcept                           { data.clearQuick(); }
 void MidiBuffer::ensureSize (size_t minimumNumBytes)        { data.ensureStorageAllocated ((int) minimumNumBytes); }
 bool MidiBuffer::isEmpty() const noexcept                   { return data.size() == 0; }
 
+void MidiBuffer::setFixedCapacity (const size_t maximumNumBytes)
+{
+    fixedCapacity = maximumNumBytes;
+
+    if (maximumNumBytes > 0)
+    {
+        data.ensureStorageAllocated ((int) maximumNumBytes);
+
+        if (sortSpaceSize < maximumNumBytes)
+        {
+            sortSpace.malloc (maximumNumBytes);
+            sortSpaceSize = maximumNumBytes;
+        }
+    }
+}
+
+int MidiBuffer::getNumBytesThatFit (const uint8* const eventData, const uint8* const endData) const noexcept
+{
+    if (fixedCapacity == 0)
+        return (int) (endData - eventData);
+
+    const size_t spaceLeft = fixedCapacity > (size_t) data.size() ? fixedCapacity - (size_t) data.size() : 0;
+    const uint8* d = eventData;
+
+    while (d < endData && (size_t) (d - eventData) + MidiBufferHelpers::getEventTotalSize (d) <= spaceLeft)
+        d += MidiBufferHelpers::getEventTotalSize (d);
+
+    return (int) (d - eventData);
+}
+
 void MidiBuffer::clear (const int startSample, const int numSamples)
 {
     uint8* const start = MidiBufferHelpers::findEventAfter (data.begin(), data.end(), startSample - 1);
     uint8* const end   = MidiBufferHelpers::findEventAfter (start,        data.end(), startSample + numSamples - 1);
 
-    data.removeRange ((int) (start - data.begin()), (int) (end - data.begin()));
+    if (fixedCapacity > 0)
+    {
+        // Array::removeRange() may shrink its storage, so the remaining data is moved
+        // down in place, and then the array's size is reset without reallocating it.
+        const int newSize = data.size() - (int) (end - start);
+        memmove (start, end, (size_t) (data.end() - end));
+
+        data.clearQuick();
+        data.addArray (static_cast<const uint8*> (data.begin()), newSize);
+    }
+    else
+    {
+        data.removeRange ((int) (start - data.begin()), (int) (end - data.begin()));
+    }
 }
 
-void MidiBuffer::addEvent (const MidiMessage& m, const int sampleNumber)
+bool MidiBuffer::addEvent (const MidiMessage& m, const int sampleNumber)
 {
-    addEvent (m.getRawData(), m.getRawDataSize(), sampleNumber);
+    return addEvent (m.getRawData(), m.getRawDataSize(), sampleNumber);
 }
 
-void MidiBuffer::addEvent (const void* const newData, const int maxBytes, const int sampleNumber)
+bool MidiBuffer::addEvent (const void* const newData, const int maxBytes, const int sampleNumber)
 {
     const int numBytes = MidiBufferHelpers::findActualEventLength (static_cast<const uint8*> (newData), maxBytes);
 
     if (numBytes > 0)
     {
         const size_t newItemSize = (size_t) numBytes + sizeof (int32) + sizeof (uint16);
+
+        if (fixedCapacity > 0 && (size_t) data.size() + newItemSize > fixedCapacity)
+            return false;
+
         const int offset = (int) (MidiBufferHelpers::findEventAfter (data.begin(), data.end(), sampleNumber) - data.begin());
 
         data.insertMultiple (offset, 0, (int) newItemSize);
+        MidiBufferHelpers::writeEvent (data.begin() + offset, sampleNumber, newData, numBytes);
+        return true;
+    }
 
-        uint8* const d = data.begin() + offset;
-        *reinterpret_cast<int32*> (d) = sampleNumber;
-        *reinterpret_cast<uint16*> (d + 4) = (uint16) numBytes;
-        memcpy (d + 6, newData, (size_t) numBytes);
+    return false;
+}
+
+bool MidiBuffer::addEventWithoutSorting (const void* const newData, const int maxBytes, const int sampleNumber)
+{
+    const int numBytes = MidiBufferHelpers::findActualEventLength (static_cast<const uint8*> (newData), maxBytes);
+
+    if (numBytes > 0)
+    {
+        const size_t newItemSize = (size_t) numBytes + sizeof (int32) + sizeof (uint16);
+
+        if (fixedCapacity > 0 && (size_t) data.size() + newItemSize > fixedCapacity)
+            return false;
+
+        const int offset = data.size();
+
+        data.insertMultiple (offset, 0, (int) newItemSize);
+        MidiBufferHelpers::writeEvent (data.begin() + offset, sampleNumber, newData, numBytes);
+        return true;
+    }
+
+    return false;
+}
+
+void MidiBuffer::sortEvents()
+{
+    const size_t numBytes = (size_t) data.size();
+
+    if (numBytes == 0 || MidiBufferHelpers::findEndOfSortedRun (data.begin(), data.end()) == data.end())
+        return;
+
+    if (sortSpaceSize < numBytes)
+    {
+        // A buffer with a fixed capacity should already have enough space for this!
+        jassert (fixedCapacity == 0);
+
+        sortSpace.malloc (numBytes);
+        sortSpaceSize = numBytes;
+    }
+
+    // This is a natural merge sort: each pass merges pairs of adjacent sorted runs, so
+    // a buffer made of two sorted sequences only needs a single pass.
+    for (;;)
+    {
+        const uint8* source = data.begin();
+        const uint8* const end = data.end();
+        uint8* dest = sortSpace;
+        int numRuns = 0;
+
+        while (source < end)
+        {
+            const uint8* const firstRunEnd  = MidiBufferHelpers::findEndOfSortedRun (source, end);
+            const uint8* const secondRunEnd = firstRunEnd < end ? MidiBufferHelpers::findEndOfSortedRun (firstRunEnd, end)
+                                                                : firstRunEnd;
+
+            dest = MidiBufferHelpers::mergeSortedRuns (source, firstRunEnd, firstRunEnd, secondRunEnd, dest);
+            source = secondRunEnd;
+            ++numRuns;
+        }
+
+        memcpy (data.begin(), sortSpace, numBytes);
+
+        if (numRuns <= 1)
+            break;
     }
 }
 
@@ -135,16 +311,26 @@ void MidiBuffer::addEvents (const MidiBuffer& otherBuffer,
                             const int numSamples,
                             const int sampleDeltaToAdd)
 {
-    Iterator i (otherBuffer);
-    i.setNextSamplePosition (startSample);
+    // Adding a buffer to itself isn't possible, because its data would move while it's being read!
+    jassert (&otherBuffer != this);
+
+    uint8* const start = MidiBufferHelpers::findEventAfter (otherBuffer.data.begin(), otherBuffer.data.end(), startSample - 1);
+    uint8* const end   = numSamples < 0 ? otherBuffer.data.end()
+                                        : MidiBufferHelpers::findEventAfter (start, otherBuffer.data.end(), startSample + numSamples - 1);
 
-    const uint8* eventData;
-    int eventSize, position;
+    const int numBytes = getNumBytesThatFit (start, end);
 
-    while (i.getNextEvent (eventData, eventSize, position)
-            && (position < startSample + numSamples || numSamples < 0))
+    if (numBytes > 0)
     {
-        addEvent (eventData, eventSize, position + sampleDeltaToAdd);
+        const int oldSize = data.size();
+        data.addArray (static_cast<const uint8*> (start), numBytes);
+
+        if (sampleDeltaToAdd != 0)
+            for (uint8* d = data.begin() + oldSize; d < data.end(); d += MidiBufferHelpers::getEventTotalSize (d))
+                *reinterpret_cast<int32*> (d) += sampleDeltaToAdd;
+
+        // both sets of events are already in order, so this will just merge them in one pass
+        sortEvents();
     }
 }
 
@@ -215,6 +401,18 @@ bool MidiBuffer::Iterator::getNextEvent (const uint8* &midiData, int& numBytes,
     return true;
 }
 
+bool MidiBuffer::Iterator::getNextEvent (MidiMessageView& result) noexcept
+{
+    if (data >= buffer.data.end())
+        return false;
+
+    const int itemSize = MidiBufferHelpers::getEventDataSize (data);
+    result = MidiMessageView (data + sizeof (int32) + sizeof (uint16), itemSize, MidiBufferHelpers::getEventTime (data));
+    data += sizeof (int32) + sizeof (uint16) + (size_t) itemSize;
+
+    return true;
+}
+
 bool MidiBuffer::Iterator::getNextEvent (MidiMessage& result, int& samplePosition) noexcept
 {
     if (data >= buffer.data.end())
@@ -227,3 +425,160 @@ bool MidiBuffer::Iterator::getNextEvent (MidiMessage& result, int& samplePositio
 
     return true;
 }
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MidiBufferTests  : public UnitTest
+{
+public:
+    MidiBufferTests() : UnitTest ("MidiBuffer") {}
+
+    static MidiMessage createRandomMessage (Random& r)
+    {
+        return MidiMessage::controllerEvent (r.nextInt (16) + 1, r.nextInt (128), r.nextInt (128));
+    }
+
+    // adds the events one at a time, in the same way that the original implementation did
+    static void addEventsIndividually (MidiBuffer& dest, const MidiBuffer& source,
+                                       int startSample, int numSamples, int sampleDelta)
+    {
+        MidiBuffer::Iterator i (source);
+        i.setNextSamplePosition (startSample);
+
+        const uint8* eventData;
+        int eventSize, position;
+
+        while (i.getNextEvent (eventData, eventSize, position)
+                && (position < startSample + numSamples || numSamples < 0))
+            dest.addEvent (eventData, eventSize, position + sampleDelta);
+    }
+
+    void runTest() override
+    {
+        Random r (getRandom());
+
+        beginTest ("Sorting");
+        {
+            MidiBuffer sorted, unsorted;
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                const MidiMessage m (createRandomMessage (r));
+                const int time = r.nextInt (200);
+
+                sorted.addEvent (m, time);
+                expect (unsorted.addEventWithoutSorting (m.getRawData(), m.getRawDataSize(), time));
+            }
+
+            unsorted.sortEvents();
+            expect (unsorted.data == sorted.data);
+            expectEquals (unsorted.getNumEvents(), 1000);
+        }
+
+        beginTest ("Merging");
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                MidiBuffer dest, source;
+
+                for (int j = r.nextInt (300); --j >= 0;)    dest.addEvent (createRandomMessage (r), r.nextInt (100));
+                for (int j = r.nextInt (300); --j >= 0;)    source.addEvent (createRandomMessage (r), r.nextInt (100));
+
+                const int startSample = r.nextInt (50) - 10;
+                const int numSamples = r.nextInt (100) - 10;
+                const int delta = r.nextInt (60) - 30;
+
+                MidiBuffer expected (dest);
+                addEventsIndividually (expected, source, startSample, numSamples, delta);
+
+                dest.addEvents (source, startSample, numSamples, delta);
+                expect (dest.data == expected.data);
+            }
+        }
+
+        beginTest ("Iterating with views");
+        {
+            MidiBuffer buffer;
+
+            for (int i = 0; i < 100; ++i)
+                buffer.addEvent (createRandomMessage (r), r.nextInt (100));
+
+            buffer.addEvent (MidiMessage::noteOn (3, 60, (uint8) 100), 50);
+
+            MidiBuffer::Iterator copies (buffer), views (buffer);
+            MidiMessage message;
+            MidiMessageView view;
+            int position, numNoteOns = 0;
+
+            while (copies.getNextEvent (message, position))
+            {
+                expect (views.getNextEvent (view));
+                expectEquals (view.getSamplePosition(), position);
+                expectEquals (view.getRawDataSize(), message.getRawDataSize());
+                expect (memcmp (view.getRawData(), message.getRawData(), (size_t) message.getRawDataSize()) == 0);
+                expectEquals (view.getChannel(), message.getChannel());
+                expect (view.isController() == message.isController());
+
+                if (view.isNoteOn())
+                {
+                    ++numNoteOns;
+                    expectEquals (view.getNoteNumber(), 60);
+                    expectEquals ((int) view.getVelocity(), 100);
+                }
+            }
+
+            expect (! views.getNextEvent (view));
+            expectEquals (numNoteOns, 1);
+        }
+
+        beginTest ("Fixed capacity");
+        {
+            MidiBuffer buffer;
+            buffer.setFixedCapacity (900);
+            const uint8* const storage = buffer.data.begin();
+
+            int numAdded = 0;
+
+            for (int i = 0; i < 200; ++i)
+                if (buffer.addEvent (createRandomMessage (r), r.nextInt (100)))
+                    ++numAdded;
+
+            expectEquals (numAdded, 100);
+            expectEquals (buffer.data.size(), 900);
+
+            buffer.clear (20, 60);
+
+            {
+                MidiBuffer::Iterator i (buffer);
+                MidiMessage m;
+                int position;
+
+                while (i.getNextEvent (m, position))
+                    expect (position < 20 || position >= 80);
+            }
+
+            MidiBuffer other;
+            for (int i = 0; i < 200; ++i)
+                other.addEvent (createRandomMessage (r), r.nextInt (100));
+
+            buffer.addEvents (other, 0, -1, 0);
+            expect (buffer.data.size() <= 900);
+
+            buffer = other;
+            expectEquals (buffer.getNumEvents(), 100);
+
+            buffer.clear();
+            for (int i = 0; i < 100; ++i)
+                buffer.addEventWithoutSorting (other.data.begin() + 6, 3, 100 - i);
+
+            buffer.sortEvents();
+            expectEquals (buffer.getFirstEventTime(), 1);
+            expect (buffer.data.begin() == storage);
+        }
+    }
+};
+
+static MidiBufferTests midiBufferTests;
+
+#endif
@@ -33,6 +33,9 @@
     Analogous to the AudioSampleBuffer, this holds a set of midi events with
     integer time-stamps. The buffer is kept sorted in order of the time-stamps.
 
+    If you need to fill a buffer on the audio thread, you can use setFixedCapacity()
+    to make sure that it never needs to allocate any memory once it has been set up.
+
     If you're working with a sequence of midi events that may need to be manipulated
     or read/written to a midi file, then MidiMessageSequence is probably a more
     appropriate container. MidiBuffer is designed for lower-level streams of raw
@@ -93,8 +96,11 @@ public:
         already in the buffer, the new event will be placed after the existing ones.
 
         To retrieve events, use a MidiBuffer::Iterator object
+
+        @returns true if the event was added, or false if the buffer has a fixed
+                 capacity which doesn't have enough space left for it
     */
-    void addEvent (const MidiMessage& midiMessage, int sampleNumber);
+    bool addEvent (const MidiMessage& midiMessage, int sampleNumber);
 
     /** Adds an event to the buffer from raw midi data.
 
@@ -111,11 +117,39 @@ public:
         add an event at all.
 
         To retrieve events, use a MidiBuffer::Iterator object
+
+        @returns true if the event was added, or false if the data was invalid, or if
+                 the buffer has a fixed capacity which doesn't have enough space left for it
     */
-    void addEvent (const void* rawMidiData,
+    bool addEvent (const void* rawMidiData,
                    int maxBytesOfMidiData,
                    int sampleNumber);
 
+    /** Appends an event to the end of the buffer, without putting it into its sorted position.
+
+        This is much faster than addEvent() when you're adding a lot of events which might
+        not arrive in order. After adding them, you must call sortEvents() before the buffer
+        is used for anything else.
+
+        @returns true if the event was added, or false if the data was invalid, or if
+                 the buffer has a fixed capacity which doesn't have enough space left for it
+        @see sortEvents
+    */
+    bool addEventWithoutSorting (const void* rawMidiData,
+                                 int maxBytesOfMidiData,
+                                 int sampleNumber);
+
+    /** Sorts the events into order of their sample positions.
+
+        You only need to call this after using addEventWithoutSorting(). The sort is stable,
+        so events with the same sample position stay in the order in which they were added.
+        If the buffer is already sorted, this just does a quick scan through it.
+
+        Unless the buffer has a fixed capacity, this may need to allocate some scratch space
+        the first time that it's used.
+    */
+    void sortEvents();
+
     /** Adds some events from another buffer to this one.
 
         @param otherBuffer          the buffer containing the events you want to add
@@ -129,6 +163,10 @@ public:
                                     startSample will be taken.
         @param sampleDeltaToAdd     a value which will be added to the source timestamps of the events
                                     that are added to this buffer
+
+        The events are merged with the ones already in this buffer, so this takes time
+        proportional to the total number of events in both buffers. If this buffer has a
+        fixed capacity, any events that won't fit are discarded.
     */
     void addEvents (const MidiBuffer& otherBuffer,
                     int startSample,
@@ -159,6 +197,23 @@ public:
     */
     void ensureSize (size_t minimumNumBytes);
 
+    /** Preallocates some memory, and stops the buffer from ever allocating any more.
+
+        Once this has been called, adding events, clearing, sorting and assigning another
+        buffer to this one will be done without any memory being allocated or freed, so
+        these operations are safe to use on the audio thread. Events that won't fit into
+        the space available are discarded, and addEvent() will return false.
+
+        Events that are already in the buffer aren't affected. Passing 0 returns the buffer
+        to its normal behaviour, where it grows as needed.
+    */
+    void setFixedCapacity (size_t maximumNumBytes);
+
+    /** Returns the capacity that was set with setFixedCapacity(), or 0 if the buffer
+        is allowed to grow.
+    */
+    size_t getFixedCapacity() const noexcept            { return fixedCapacity; }
+
     //==============================================================================
     /**
         Used to iterate through the events in a MidiBuffer.
@@ -213,6 +268,15 @@ public:
                            int& numBytesOfMidiData,
                            int& samplePosition) noexcept;
 
+        /** Retrieves the next event from the buffer without copying it.
+
+            @param result   on return, this will refer to the event's data, which is stored
+                            inside the MidiBuffer, so it's only valid until the buffer is altered
+            @returns        true if an event was found, or false if the iterator has reached
+                            the end of the buffer
+        */
+        bool getNextEvent (MidiMessageView& result) noexcept;
+
     private:
         //==============================================================================
         const MidiBuffer& buffer;
@@ -228,6 +292,11 @@ public:
     Array<uint8> data;
 
 private:
+    size_t fixedCapacity, sortSpaceSize;
+    HeapBlock<uint8> sortSpace;
+
+    int getNumBytesThatFit (const uint8* eventData, const uint8* endData) const noexcept;
+
     JUCE_LEAK_DETECTOR (MidiBuffer)
 };
 
@@ -243,7 +243,7 @@ double MidiFile::getLastTimestamp() const
 }
 
 //==============================================================================
-bool MidiFile::readFrom (InputStream& sourceStream)
+bool MidiFile::readFrom (InputStream& sourceStream, bool createMatchingNoteOffs)
 {
     clear();
     MemoryBlock data;
@@ -274,7 +274,7 @@ bool MidiFile::readFrom (InputStream& sourceStream)
                     break;
 
                 if (chunkType == (int) ByteOrder::bigEndianInt ("MTrk"))
-                    readNextTrack (d, chunkSize);
+                    readNextTrack (d, chunkSize, createMatchingNoteOffs);
 
                 size -= (size_t) chunkSize + 8;
                 d += chunkSize;
@@ -288,12 +288,13 @@ bool MidiFile::readFrom (InputStream& sourceStream)
     return false;
 }
 
-void MidiFile::readNextTrack (const uint8* data, int size)
+void MidiFile::readNextTrack (const uint8* data, int size, bool createMatchingNoteOffs)
 {
     double time = 0;
     uint8 lastStatusByte = 0;
 
-    MidiMessageSequence result;
+    // the track is built in place, to avoid copying all of its events afterwards
+    MidiMessageSequence& result = *tracks.add (new MidiMessageSequence());
 
     while (size > 0)
     {
@@ -304,7 +305,7 @@ void MidiFile::readNextTrack (const uint8* data, int size)
         time += delay;
 
         int messSize = 0;
-        const MidiMessage mm (data, size, messSize, lastStatusByte, time);
+        MidiMessage mm (data, size, messSize, lastStatusByte, time);
 
         if (messSize <= 0)
             break;
@@ -312,19 +313,23 @@ void MidiFile::readNextTrack (const uint8* data, int size)
         size -= messSize;
         data += messSize;
 
-        result.addEvent (mm);
-
         const uint8 firstByte = *(mm.getRawData());
         if ((firstByte & 0xf0) != 0xf0)
             lastStatusByte = firstByte;
+
+       #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+        result.addEvent (static_cast<MidiMessage&&> (mm));
+       #else
+        result.addEvent (mm);
+       #endif
     }
 
     // use a sort that puts all the note-offs before note-ons that have the same time
     MidiFileHelpers::Sorter sorter;
     result.list.sort (sorter, true);
 
-    addTrack (result);
-    tracks.getLast()->updateMatchedPairs();
+    if (createMatchingNoteOffs)
+        result.updateMatchedPairs();
 }
 
 //==============================================================================
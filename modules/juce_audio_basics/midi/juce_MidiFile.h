@@ -146,9 +146,16 @@ public:
         terms of midi ticks. To convert them to seconds, use the convertTimestampTicksToSeconds()
         method.
 
+        If createMatchingNoteOffs is false, the note-on and note-off events in each track
+        won't be linked up with MidiMessageSequence::updateMatchedPairs(), which saves a lot
+        of time when loading big files whose tracks are only going to be iterated. You can
+        still call updateMatchedPairs() on any tracks that need it later.
+
+        For very large files, or to avoid loading the tracks at all, see StreamingMidiFileReader.
+
         @returns true if the stream was read successfully
     */
-    bool readFrom (InputStream& sourceStream);
+    bool readFrom (InputStream& sourceStream, bool createMatchingNoteOffs = true);
 
     /** Writes the midi tracks as a standard midi file.
         The midiFileType value is written as the file's format type, which can be 0, 1
@@ -170,7 +177,7 @@ private:
     OwnedArray<MidiMessageSequence> tracks;
     short timeFormat;
 
-    void readNextTrack (const uint8*, int size);
+    void readNextTrack (const uint8*, int size, bool createMatchingNoteOffs);
     void writeTrack (OutputStream&, int trackNum);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiFile)
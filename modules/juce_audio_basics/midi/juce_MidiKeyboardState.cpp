@@ -23,8 +23,9 @@
 */
 
 MidiKeyboardState::MidiKeyboardState()
+    : eventsToAdd (maxPendingEvents),
+      eventsBeingAdded ((size_t) maxPendingEvents)
 {
-    zerostruct (noteStates);
 }
 
 MidiKeyboardState::~MidiKeyboardState()
@@ -34,9 +35,12 @@ MidiKeyboardState::~MidiKeyboardState()
 //==============================================================================
 void MidiKeyboardState::reset()
 {
-    const ScopedLock sl (lock);
-    zerostruct (noteStates);
-    eventsToAdd.clear();
+    for (int i = 0; i < 128; ++i)
+        noteStates[i] = 0;
+
+    PendingEvent e;
+    while (eventsToAdd.pop (e))
+    {}
 }
 
 bool MidiKeyboardState::isNoteOn (const int midiChannel, const int n) const noexcept
@@ -44,13 +48,47 @@ bool MidiKeyboardState::isNoteOn (const int midiChannel, const int n) const noex
     jassert (midiChannel >= 0 && midiChannel <= 16);
 
     return isPositiveAndBelow (n, (int) 128)
-            && (noteStates[n] & (1 << (midiChannel - 1))) != 0;
+            && (noteStates[n].get() & (1 << (midiChannel - 1))) != 0;
 }
 
 bool MidiKeyboardState::isNoteOnForChannels (const int midiChannelMask, const int n) const noexcept
 {
     return isPositiveAndBelow (n, (int) 128)
-            && (noteStates[n] & midiChannelMask) != 0;
+            && (noteStates[n].get() & midiChannelMask) != 0;
+}
+
+// Returns true if this call changed the state, so that when two threads race to release
+// the same note, only one of them reports it.
+bool MidiKeyboardState::setNoteState (const int midiChannel, const int midiNoteNumber, const bool isOn) noexcept
+{
+    Atomic<int>& bits = noteStates [midiNoteNumber];
+    const int mask = 1 << (midiChannel - 1);
+
+    for (;;)
+    {
+        const int oldBits = bits.get();
+        const int newBits = isOn ? (oldBits | mask) : (oldBits & ~mask);
+
+        if (newBits == oldBits)
+            return false;
+
+        if (bits.compareAndSetBool (newBits, oldBits))
+            return true;
+    }
+}
+
+void MidiKeyboardState::addPendingEvent (const MidiMessage& message) noexcept
+{
+    PendingEvent e;
+    e.time = Time::getMillisecondCounter();
+    memcpy (e.data, message.getRawData(), sizeof (e.data));
+
+    // If the audio thread isn't taking the events, the oldest ones make way for the new one
+    while (! eventsToAdd.push (e))
+    {
+        PendingEvent oldest;
+        eventsToAdd.pop (oldest);
+    }
 }
 
 void MidiKeyboardState::noteOn (const int midiChannel, const int midiNoteNumber, const float velocity)
@@ -58,14 +96,9 @@ void MidiKeyboardState::noteOn (const int midiChannel, const int midiNoteNumber,
     jassert (midiChannel >= 0 && midiChannel <= 16);
     jassert (isPositiveAndBelow (midiNoteNumber, (int) 128));
 
-    const ScopedLock sl (lock);
-
     if (isPositiveAndBelow (midiNoteNumber, (int) 128))
     {
-        const int timeNow = (int) Time::getMillisecondCounter();
-        eventsToAdd.addEvent (MidiMessage::noteOn (midiChannel, midiNoteNumber, velocity), timeNow);
-        eventsToAdd.clear (0, timeNow - 500);
-
+        addPendingEvent (MidiMessage::noteOn (midiChannel, midiNoteNumber, velocity));
         noteOnInternal (midiChannel, midiNoteNumber, velocity);
     }
 }
@@ -74,42 +107,32 @@ void MidiKeyboardState::noteOnInternal  (const int midiChannel, const int midiNo
 {
     if (isPositiveAndBelow (midiNoteNumber, (int) 128))
     {
-        noteStates [midiNoteNumber] |= (1 << (midiChannel - 1));
+        setNoteState (midiChannel, midiNoteNumber, true);
 
-        for (int i = listeners.size(); --i >= 0;)
-            listeners.getUnchecked(i)->handleNoteOn (this, midiChannel, midiNoteNumber, velocity);
+        listeners.call (&MidiKeyboardStateListener::handleNoteOn, this, midiChannel, midiNoteNumber, velocity);
     }
 }
 
 void MidiKeyboardState::noteOff (const int midiChannel, const int midiNoteNumber)
 {
-    const ScopedLock sl (lock);
-
     if (isNoteOn (midiChannel, midiNoteNumber))
     {
-        const int timeNow = (int) Time::getMillisecondCounter();
-        eventsToAdd.addEvent (MidiMessage::noteOff (midiChannel, midiNoteNumber), timeNow);
-        eventsToAdd.clear (0, timeNow - 500);
-
+        addPendingEvent (MidiMessage::noteOff (midiChannel, midiNoteNumber));
         noteOffInternal (midiChannel, midiNoteNumber);
     }
 }
 
 void MidiKeyboardState::noteOffInternal  (const int midiChannel, const int midiNoteNumber)
 {
-    if (isNoteOn (midiChannel, midiNoteNumber))
+    if (isPositiveAndBelow (midiNoteNumber, (int) 128)
+         && setNoteState (midiChannel, midiNoteNumber, false))
     {
-        noteStates [midiNoteNumber] &= ~(1 << (midiChannel - 1));
-
-        for (int i = listeners.size(); --i >= 0;)
-            listeners.getUnchecked(i)->handleNoteOff (this, midiChannel, midiNoteNumber);
+        listeners.call (&MidiKeyboardStateListener::handleNoteOff, this, midiChannel, midiNoteNumber);
     }
 }
 
 void MidiKeyboardState::allNotesOff (const int midiChannel)
 {
-    const ScopedLock sl (lock);
-
     if (midiChannel <= 0)
     {
         for (int i = 1; i <= 16; ++i)
@@ -148,36 +171,43 @@ void MidiKeyboardState::processNextMidiBuffer (MidiBuffer& buffer,
     MidiMessage message;
     int time;
 
-    const ScopedLock sl (lock);
-
     while (i.getNextEvent (message, time))
         processNextMidiEvent (message);
 
-    if (injectIndirectEvents)
+    int numEvents = 0;
+
+    while (numEvents < maxPendingEvents && eventsToAdd.pop (eventsBeingAdded [numEvents]))
+        ++numEvents;
+
+    if (injectIndirectEvents && numEvents > 0)
     {
-        MidiBuffer::Iterator i2 (eventsToAdd);
-        const int firstEventToAdd = eventsToAdd.getFirstEventTime();
-        const double scaleFactor = numSamples / (double) (eventsToAdd.getLastEventTime() + 1 - firstEventToAdd);
+        // Events that are more than half a second older than the latest one are dropped,
+        // and the rest are spread out across the block in proportion to their times
+        const uint32 lastEventTime = eventsBeingAdded [numEvents - 1].time;
+        int firstEvent = 0;
 
-        while (i2.getNextEvent (message, time))
+        while ((int) (lastEventTime - eventsBeingAdded [firstEvent].time) > 500)
+            ++firstEvent;
+
+        const uint32 firstEventTime = eventsBeingAdded [firstEvent].time;
+        const double scaleFactor = numSamples / (double) (lastEventTime + 1 - firstEventTime);
+
+        for (int n = firstEvent; n < numEvents; ++n)
         {
-            const int pos = jlimit (0, numSamples - 1, roundToInt ((time - firstEventToAdd) * scaleFactor));
-            buffer.addEvent (message, startSample + pos);
+            const PendingEvent& e = eventsBeingAdded [n];
+            const int pos = jlimit (0, numSamples - 1, roundToInt ((int) (e.time - firstEventTime) * scaleFactor));
+            buffer.addEvent (e.data, 3, startSample + pos);
         }
     }
-
-    eventsToAdd.clear();
 }
 
 //==============================================================================
 void MidiKeyboardState::addListener (MidiKeyboardStateListener* const listener)
 {
-    const ScopedLock sl (lock);
-    listeners.addIfNotAlreadyThere (listener);
+    listeners.add (listener);
 }
 
 void MidiKeyboardState::removeListener (MidiKeyboardStateListener* const listener)
 {
-    const ScopedLock sl (lock);
-    listeners.removeFirstMatchingValue (listener);
+    listeners.remove (listener);
 }
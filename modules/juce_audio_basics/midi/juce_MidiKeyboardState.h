@@ -80,6 +80,12 @@ public:
     It also allows key up/down events to be triggered with its noteOn() and noteOff()
     methods, and midi messages for these events will be merged into the
     midi stream that gets processed by processNextMidiBuffer().
+
+    None of the methods take a lock: the key states are held in atomic bitsets, and the
+    events from noteOn() and noteOff() are passed to processNextMidiBuffer() through a
+    lock-free queue, so a GUI keyboard never blocks the audio thread. This also means
+    that listeners can be called from the audio thread and from the thread that calls
+    noteOn() or noteOff() at the same time.
 */
 class JUCE_API  MidiKeyboardState
 {
@@ -190,11 +196,21 @@ public:
 
 private:
     //==============================================================================
-    CriticalSection lock;
-    uint16 noteStates [128];
-    MidiBuffer eventsToAdd;
-    Array <MidiKeyboardStateListener*> listeners;
+    struct PendingEvent
+    {
+        uint32 time;
+        uint8 data[3];
+    };
+
+    enum { maxPendingEvents = 256 };
+
+    Atomic<int> noteStates [128];
+    LockFreeQueue<PendingEvent> eventsToAdd;
+    HeapBlock<PendingEvent> eventsBeingAdded;
+    LockFreeListenerList<MidiKeyboardStateListener> listeners;
 
+    bool setNoteState (int midiChannel, int midiNoteNumber, bool isOn) noexcept;
+    void addPendingEvent (const MidiMessage&) noexcept;
     void noteOnInternal (int midiChannel, int midiNoteNumber, float velocity);
     void noteOffInternal (int midiChannel, int midiNoteNumber);
 
@@ -79,13 +79,13 @@ int MidiMessage::getMessageLengthFromFirstByte (const uint8 firstByte) noexcept
 MidiMessage::MidiMessage() noexcept
    : timeStamp (0), size (2)
 {
-    preallocatedData.asBytes[0] = 0xf0;
-    preallocatedData.asBytes[1] = 0xf7;
+    packedData.asBytes[0] = 0xf0;
+    packedData.asBytes[1] = 0xf7;
 }
 
 MidiMessage::MidiMessage (const void* const d, const int dataSize, const double t)
    : timeStamp (t),
-     size (dataSize)
+     size (0)
 {
     jassert (dataSize > 0);
     memcpy (allocateSpace (dataSize), d, (size_t) dataSize);
@@ -97,7 +97,7 @@ MidiMessage::MidiMessage (const void* const d, const int dataSize, const double
 MidiMessage::MidiMessage (const int byte1, const double t) noexcept
    : timeStamp (t), size (1)
 {
-    preallocatedData.asBytes[0] = (uint8) byte1;
+    packedData.asBytes[0] = (uint8) byte1;
 
     // check that the length matches the data..
     jassert (byte1 >= 0xf0 || getMessageLengthFromFirstByte ((uint8) byte1) == 1);
@@ -106,8 +106,8 @@ MidiMessage::MidiMessage (const int byte1, const double t) noexcept
 MidiMessage::MidiMessage (const int byte1, const int byte2, const double t) noexcept
    : timeStamp (t), size (2)
 {
-    preallocatedData.asBytes[0] = (uint8) byte1;
-    preallocatedData.asBytes[1] = (uint8) byte2;
+    packedData.asBytes[0] = (uint8) byte1;
+    packedData.asBytes[1] = (uint8) byte2;
 
     // check that the length matches the data..
     jassert (byte1 >= 0xf0 || getMessageLengthFromFirstByte ((uint8) byte1) == 2);
@@ -116,9 +116,9 @@ MidiMessage::MidiMessage (const int byte1, const int byte2, const double t) noex
 MidiMessage::MidiMessage (const int byte1, const int byte2, const int byte3, const double t) noexcept
    : timeStamp (t), size (3)
 {
-    preallocatedData.asBytes[0] = (uint8) byte1;
-    preallocatedData.asBytes[1] = (uint8) byte2;
-    preallocatedData.asBytes[2] = (uint8) byte3;
+    packedData.asBytes[0] = (uint8) byte1;
+    packedData.asBytes[1] = (uint8) byte2;
+    packedData.asBytes[2] = (uint8) byte3;
 
     // check that the length matches the data..
     jassert (byte1 >= 0xf0 || getMessageLengthFromFirstByte ((uint8) byte1) == 3);
@@ -127,34 +127,34 @@ MidiMessage::MidiMessage (const int byte1, const int byte2, const int byte3, con
 MidiMessage::MidiMessage (const MidiMessage& other)
    : timeStamp (other.timeStamp), size (other.size)
 {
-    if (other.allocatedData != nullptr)
+    if (other.isHeapAllocated())
     {
-        allocatedData.malloc ((size_t) size);
-        memcpy (allocatedData, other.allocatedData, (size_t) size);
+        packedData.allocatedData = static_cast<uint8*> (std::malloc ((size_t) size));
+        memcpy (packedData.allocatedData, other.packedData.allocatedData, (size_t) size);
     }
     else
     {
-        preallocatedData.asInt32 = other.preallocatedData.asInt32;
+        packedData = other.packedData;
     }
 }
 
 MidiMessage::MidiMessage (const MidiMessage& other, const double newTimeStamp)
    : timeStamp (newTimeStamp), size (other.size)
 {
-    if (other.allocatedData != nullptr)
+    if (other.isHeapAllocated())
     {
-        allocatedData.malloc ((size_t) size);
-        memcpy (allocatedData, other.allocatedData, (size_t) size);
+        packedData.allocatedData = static_cast<uint8*> (std::malloc ((size_t) size));
+        memcpy (packedData.allocatedData, other.packedData.allocatedData, (size_t) size);
     }
     else
     {
-        preallocatedData.asInt32 = other.preallocatedData.asInt32;
+        packedData = other.packedData;
     }
 }
 
 MidiMessage::MidiMessage (const void* srcData, int sz, int& numBytesUsed, const uint8 lastStatusByte,
                           double t, bool sysexHasEmbeddedLength)
-    : timeStamp (t)
+    : timeStamp (t), size (0)
 {
     const uint8* src = static_cast<const uint8*> (srcData);
     unsigned int byte = (unsigned int) *src;
@@ -204,9 +204,8 @@ MidiMessage::MidiMessage (const void* srcData, int sz, int& numBytesUsed, const
             }
 
             src += numVariableLengthSysexBytes;
-            size = 1 + (int) (d - src);
 
-            uint8* dest = allocateSpace (size);
+            uint8* dest = allocateSpace (1 + (int) (d - src));
             *dest = (uint8) byte;
             memcpy (dest + 1, src, (size_t) (size - 1));
 
@@ -216,24 +215,23 @@ MidiMessage::MidiMessage (const void* srcData, int sz, int& numBytesUsed, const
         {
             int n;
             const int bytesLeft = readVariableLengthVal (src + 1, n);
-            size = jmin (sz + 1, n + 2 + bytesLeft);
 
-            uint8* dest = allocateSpace (size);
+            uint8* dest = allocateSpace (jmin (sz + 1, n + 2 + bytesLeft));
             *dest = (uint8) byte;
             memcpy (dest + 1, src, (size_t) size - 1);
         }
         else
         {
-            preallocatedData.asInt32 = 0;
+            zerostruct (packedData);
             size = getMessageLengthFromFirstByte ((uint8) byte);
-            preallocatedData.asBytes[0] = (uint8) byte;
+            packedData.asBytes[0] = (uint8) byte;
 
             if (size > 1)
             {
-                preallocatedData.asBytes[1] = src[0];
+                packedData.asBytes[1] = src[0];
 
                 if (size > 2)
-                    preallocatedData.asBytes[2] = src[1];
+                    packedData.asBytes[2] = src[1];
             }
         }
 
@@ -241,7 +239,7 @@ MidiMessage::MidiMessage (const void* srcData, int sz, int& numBytesUsed, const
     }
     else
     {
-        preallocatedData.asInt32 = 0;
+        zerostruct (packedData);
         size = 0;
     }
 }
@@ -251,17 +249,20 @@ MidiMessage& MidiMessage::operator= (const MidiMessage& other)
     if (this != &other)
     {
         timeStamp = other.timeStamp;
-        size = other.size;
 
-        if (other.allocatedData != nullptr)
+        if (other.isHeapAllocated())
         {
-            allocatedData.malloc ((size_t) size);
-            memcpy (allocatedData, other.allocatedData, (size_t) size);
+            // if the existing block is already the right size, it can just be re-used
+            if (size != other.size)
+                allocateSpace (other.size);
+
+            memcpy (packedData.allocatedData, other.packedData.allocatedData, (size_t) size);
         }
         else
         {
-            allocatedData.free();
-            preallocatedData.asInt32 = other.preallocatedData.asInt32;
+            freeData();
+            size = other.size;
+            packedData = other.packedData;
         }
     }
 
@@ -270,38 +271,51 @@ MidiMessage& MidiMessage::operator= (const MidiMessage& other)
 
 #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
 MidiMessage::MidiMessage (MidiMessage&& other) noexcept
-   : timeStamp (other.timeStamp), size (other.size)
+   : timeStamp (other.timeStamp), packedData (other.packedData), size (other.size)
 {
-    if (other.allocatedData != nullptr)
-        allocatedData.swapWith (other.allocatedData);
-    else
-        preallocatedData.asInt32 = other.preallocatedData.asInt32;
+    other.size = 0;
 }
 
 MidiMessage& MidiMessage::operator= (MidiMessage&& other) noexcept
 {
     jassert (this != &other); // shouldn't be possible
 
+    freeData();
+
     timeStamp = other.timeStamp;
+    packedData = other.packedData;
     size = other.size;
-    allocatedData.swapWith (other.allocatedData);
-    preallocatedData.asInt32 = other.preallocatedData.asInt32;
+    other.size = 0;
 
     return *this;
 }
 #endif
 
-MidiMessage::~MidiMessage() {}
+MidiMessage::~MidiMessage()
+{
+    freeData();
+}
+
+void MidiMessage::freeData() noexcept
+{
+    if (isHeapAllocated())
+        std::free (packedData.allocatedData);
+
+    size = 0;
+}
 
 uint8* MidiMessage::allocateSpace (int bytes)
 {
-    if (bytes > 4)
+    freeData();
+    size = bytes;
+
+    if (isHeapAllocated())
     {
-        allocatedData.malloc ((size_t) bytes);
-        return allocatedData;
+        packedData.allocatedData = static_cast<uint8*> (std::malloc ((size_t) bytes));
+        return packedData.allocatedData;
     }
 
-    return preallocatedData.asBytes;
+    return packedData.asBytes;
 }
 
 int MidiMessage::getChannel() const noexcept
@@ -681,7 +695,6 @@ MidiMessage MidiMessage::textMetaEvent (int type, StringRef text)
     const size_t headerLen = sizeof (header) - n;
 
     uint8* const dest = result.allocateSpace ((int) (headerLen + textSize));
-    result.size = (int) (headerLen + textSize);
 
     memcpy (dest, header + n, headerLen);
     memcpy (dest + headerLen, text.text.getAddress(), textSize);
@@ -1092,3 +1105,71 @@ const char* MidiMessage::getControllerName (const int n)
 
     return isPositiveAndBelow (n, numElementsInArray (names)) ? names[n] : nullptr;
 }
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MidiMessageTests  : public UnitTest
+{
+public:
+    MidiMessageTests() : UnitTest ("MidiMessage") {}
+
+    static bool hasSameData (const MidiMessage& a, const MidiMessage& b)
+    {
+        return a.getRawDataSize() == b.getRawDataSize()
+                && memcmp (a.getRawData(), b.getRawData(), (size_t) a.getRawDataSize()) == 0;
+    }
+
+    void runTest() override
+    {
+        beginTest ("Copying and assigning messages of different sizes");
+
+        Random r (getRandom());
+        Array<MidiMessage> messages;
+
+        for (int size = 0; size < 24; ++size)
+        {
+            HeapBlock<uint8> sysexData ((size_t) size);
+
+            for (int i = 0; i < size; ++i)
+                sysexData[i] = (uint8) r.nextInt (128);
+
+            messages.add (MidiMessage::createSysExMessage (sysexData, size));
+        }
+
+        messages.add (MidiMessage::noteOn (1, 60, (uint8) 100));
+        messages.add (MidiMessage::tempoMetaEvent (500000));
+        messages.add (MidiMessage::textMetaEvent (1, "a fairly long piece of text"));
+
+        for (int i = 0; i < messages.size(); ++i)
+        {
+            const MidiMessage& original = messages.getReference (i);
+            const MidiMessage copy (original);
+            expect (hasSameData (copy, original));
+
+            for (int j = 0; j < messages.size(); ++j)
+            {
+                MidiMessage assigned (messages.getReference (j));
+                assigned = original;
+                expect (hasSameData (assigned, original));
+
+               #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+                MidiMessage moveSource (original), moved (messages.getReference (j));
+                moved = static_cast<MidiMessage&&> (moveSource);
+                expect (hasSameData (moved, original));
+
+                const MidiMessage moveConstructed (static_cast<MidiMessage&&> (moved));
+                expect (hasSameData (moveConstructed, original));
+               #endif
+            }
+        }
+
+        const MidiMessage tempo (MidiMessage::tempoMetaEvent (250000));
+        expect (tempo.isTempoMetaEvent());
+        expectEquals (tempo.getTempoSecondsPerQuarterNote(), 0.25);
+    }
+};
+
+static MidiMessageTests midiMessageTests;
+
+#endif
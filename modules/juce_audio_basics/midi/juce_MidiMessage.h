@@ -118,7 +118,7 @@ public:
     /** Returns a pointer to the raw midi data.
         @see getRawDataSize
     */
-    const uint8* getRawData() const noexcept            { return allocatedData != nullptr ? allocatedData.getData() : preallocatedData.asBytes; }
+    const uint8* getRawData() const noexcept            { return isHeapAllocated() ? packedData.allocatedData : packedData.asBytes; }
 
     /** Returns the number of bytes of data in the message.
         @see getRawData
@@ -885,19 +885,25 @@ public:
 private:
     //==============================================================================
     double timeStamp;
-    HeapBlock<uint8> allocatedData;
-    int size;
+
+    // Messages of up to maxInlineSize bytes are stored inside the object, so only
+    // sysex and longer meta-events need to allocate any memory.
+    enum { maxInlineSize = 8 };
 
    #ifndef DOXYGEN
     union
     {
-        uint8 asBytes[4];
-        uint32 asInt32;
-    } preallocatedData;
+        uint8 asBytes[maxInlineSize];
+        uint8* allocatedData;
+    } packedData;
    #endif
 
-    inline uint8* getData() noexcept   { return allocatedData != nullptr ? allocatedData.getData() : preallocatedData.asBytes; }
+    int size;
+
+    inline bool isHeapAllocated() const noexcept    { return size > (int) maxInlineSize; }
+    inline uint8* getData() noexcept                { return isHeapAllocated() ? packedData.allocatedData : packedData.asBytes; }
     uint8* allocateSpace (int);
+    void freeData() noexcept;
 };
 
 #endif   // JUCE_MIDIMESSAGE_H_INCLUDED
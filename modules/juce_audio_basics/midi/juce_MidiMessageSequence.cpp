@@ -39,6 +39,19 @@ MidiMessageSequence& MidiMessageSequence::operator= (const MidiMessageSequence&
     return *this;
 }
 
+#if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+MidiMessageSequence::MidiMessageSequence (MidiMessageSequence&& other) noexcept
+    : list (static_cast<OwnedArray<MidiEventHolder>&&> (other.list))
+{
+}
+
+MidiMessageSequence& MidiMessageSequence::operator= (MidiMessageSequence&& other) noexcept
+{
+    list = static_cast<OwnedArray<MidiEventHolder>&&> (other.list);
+    return *this;
+}
+#endif
+
 void MidiMessageSequence::swapWith (MidiMessageSequence& other) noexcept
 {
     list.swapWith (other.list);
@@ -82,19 +95,64 @@ int MidiMessageSequence::getIndexOfMatchingKeyUp (const int index) const noexcep
 
 int MidiMessageSequence::getIndexOf (MidiEventHolder* const event) const noexcept
 {
+    if (event != nullptr)
+    {
+        const double time = event->message.getTimeStamp();
+
+        for (int i = getNextIndexAtTime (time); i < list.size(); ++i)
+        {
+            const MidiEventHolder* const meh = list.getUnchecked (i);
+
+            if (meh == event)
+                return i;
+
+            if (meh->message.getTimeStamp() != time)
+                break;
+        }
+    }
+
+    // (if the sequence isn't sorted, the event may still be in there somewhere)
     return list.indexOf (event);
 }
 
 int MidiMessageSequence::getNextIndexAtTime (const double timeStamp) const noexcept
 {
-    const int numEvents = list.size();
+    int start = 0, end = list.size();
 
-    int i;
-    for (i = 0; i < numEvents; ++i)
-        if (list.getUnchecked(i)->message.getTimeStamp() >= timeStamp)
-            break;
+    while (start < end)
+    {
+        const int mid = (start + end) / 2;
+
+        if (list.getUnchecked (mid)->message.getTimeStamp() < timeStamp)
+            start = mid + 1;
+        else
+            end = mid;
+    }
+
+    return start;
+}
+
+int MidiMessageSequence::getIndexAfterTime (const double timeStamp) const noexcept
+{
+    int start = 0, end = list.size();
 
-    return i;
+    while (start < end)
+    {
+        const int mid = (start + end) / 2;
+
+        if (list.getUnchecked (mid)->message.getTimeStamp() <= timeStamp)
+            start = mid + 1;
+        else
+            end = mid;
+    }
+
+    return start;
+}
+
+Range<int> MidiMessageSequence::getIndexRangeForTimes (const double startTime, const double endTime) const noexcept
+{
+    const int start = getNextIndexAtTime (startTime);
+    return Range<int> (start, jmax (start, getNextIndexAtTime (endTime)));
 }
 
 //==============================================================================
@@ -120,17 +178,25 @@ double MidiMessageSequence::getEventTime (const int index) const noexcept
 MidiMessageSequence::MidiEventHolder* MidiMessageSequence::addEvent (const MidiMessage& newMessage,
                                                                      double timeAdjustment)
 {
-    MidiEventHolder* const newOne = new MidiEventHolder (newMessage);
+    return insertEvent (new MidiEventHolder (newMessage), timeAdjustment);
+}
 
-    timeAdjustment += newMessage.getTimeStamp();
-    newOne->message.setTimeStamp (timeAdjustment);
+#if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+MidiMessageSequence::MidiEventHolder* MidiMessageSequence::addEvent (MidiMessage&& newMessage,
+                                                                     double timeAdjustment)
+{
+    return insertEvent (new MidiEventHolder (static_cast<MidiMessage&&> (newMessage)), timeAdjustment);
+}
+#endif
 
-    int i;
-    for (i = list.size(); --i >= 0;)
-        if (list.getUnchecked(i)->message.getTimeStamp() <= timeAdjustment)
-            break;
+MidiMessageSequence::MidiEventHolder* MidiMessageSequence::insertEvent (MidiEventHolder* const newOne,
+                                                                        double timeAdjustment)
+{
+    timeAdjustment += newOne->message.getTimeStamp();
+    newOne->message.setTimeStamp (timeAdjustment);
 
-    list.insert (i + 1, newOne);
+    // new events go after any existing ones with the same time
+    list.insert (getIndexAfterTime (timeAdjustment), newOne);
     return newOne;
 }
 
@@ -190,38 +256,39 @@ void MidiMessageSequence::sort() noexcept
 
 void MidiMessageSequence::updateMatchedPairs() noexcept
 {
+    // For each channel and note, this holds the most recent note-on that hasn't
+    // been matched with a note-off yet.
+    MidiEventHolder* unmatchedNoteOns[16 * 128] = { nullptr };
+
     for (int i = 0; i < list.size(); ++i)
     {
         MidiEventHolder* const meh = list.getUnchecked(i);
-        const MidiMessage& m1 = meh->message;
+        const MidiMessage& m = meh->message;
 
-        if (m1.isNoteOn())
+        if (m.isNoteOn())
         {
-            meh->noteOffObject = nullptr;
-            const int note = m1.getNoteNumber();
-            const int chan = m1.getChannel();
-            const int len = list.size();
+            MidiEventHolder*& previous = unmatchedNoteOns [(m.getChannel() - 1) * 128 + m.getNoteNumber()];
 
-            for (int j = i + 1; j < len; ++j)
+            if (previous != nullptr)
             {
-                const MidiMessage& m = list.getUnchecked(j)->message;
+                // two note-ons in a row, so the first one gets a note-off just before the second
+                MidiEventHolder* const newEvent = new MidiEventHolder (MidiMessage::noteOff (m.getChannel(), m.getNoteNumber()));
+                newEvent->message.setTimeStamp (m.getTimeStamp());
+                list.insert (i++, newEvent);
+                previous->noteOffObject = newEvent;
+            }
 
-                if (m.getNoteNumber() == note && m.getChannel() == chan)
-                {
-                    if (m.isNoteOff())
-                    {
-                        meh->noteOffObject = list[j];
-                        break;
-                    }
-                    else if (m.isNoteOn())
-                    {
-                        MidiEventHolder* const newEvent = new MidiEventHolder (MidiMessage::noteOff (chan, note));
-                        list.insert (j, newEvent);
-                        newEvent->message.setTimeStamp (m.getTimeStamp());
-                        meh->noteOffObject = newEvent;
-                        break;
-                    }
-                }
+            meh->noteOffObject = nullptr;
+            previous = meh;
+        }
+        else if (m.isNoteOff())
+        {
+            MidiEventHolder*& previous = unmatchedNoteOns [(m.getChannel() - 1) * 128 + m.getNoteNumber()];
+
+            if (previous != nullptr)
+            {
+                previous->noteOffObject = meh;
+                previous = nullptr;
             }
         }
     }
@@ -282,7 +349,7 @@ void MidiMessageSequence::createControllerUpdatesForTime (const int channelNumbe
     bool donePitchWheel = false;
     bool doneControllers[128] = { 0 };
 
-    for (int i = list.size(); --i >= 0;)
+    for (int i = getIndexAfterTime (time); --i >= 0;)
     {
         const MidiMessage& mm = list.getUnchecked(i)->message;
 
@@ -320,6 +387,158 @@ MidiMessageSequence::MidiEventHolder::MidiEventHolder (const MidiMessage& mm)
 {
 }
 
+#if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+MidiMessageSequence::MidiEventHolder::MidiEventHolder (MidiMessage&& mm) noexcept
+   : message (static_cast<MidiMessage&&> (mm)), noteOffObject (nullptr)
+{
+}
+#endif
+
 MidiMessageSequence::MidiEventHolder::~MidiEventHolder()
 {
 }
+
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MidiMessageSequenceTests  : public UnitTest
+{
+public:
+    MidiMessageSequenceTests() : UnitTest ("MidiMessageSequence") {}
+
+    static MidiMessage createRandomMessage (Random& r)
+    {
+        const int channel = r.nextInt (2) + 1;
+        const int note = r.nextInt (4) + 60;
+
+        switch (r.nextInt (4))
+        {
+            case 0:  return MidiMessage::noteOn (channel, note, (uint8) (r.nextInt (127) + 1));
+            case 1:  return MidiMessage::noteOff (channel, note);
+            case 2:  return MidiMessage::noteOn (channel, note, (uint8) 0);
+            default: return MidiMessage::controllerEvent (channel, note, 1);
+        }
+    }
+
+    // The original quadratic scan, working on a plain list of messages. The index
+    // of each note-on's note-off ends up in noteOffs, or -1 if it has none.
+    static void updateMatchedPairsReference (Array<MidiMessage>& list, Array<int>& noteOffs)
+    {
+        noteOffs.insertMultiple (0, -1, list.size());
+
+        for (int i = 0; i < list.size(); ++i)
+        {
+            const MidiMessage m1 (list.getReference (i));
+
+            if (m1.isNoteOn())
+            {
+                const int note = m1.getNoteNumber();
+                const int chan = m1.getChannel();
+
+                for (int j = i + 1; j < list.size(); ++j)
+                {
+                    const MidiMessage& m = list.getReference (j);
+
+                    if (m.getNoteNumber() == note && m.getChannel() == chan)
+                    {
+                        if (m.isNoteOff())
+                        {
+                            noteOffs.set (i, j);
+                            break;
+                        }
+
+                        if (m.isNoteOn())
+                        {
+                            list.insert (j, MidiMessage (MidiMessage::noteOff (chan, note), m.getTimeStamp()));
+                            noteOffs.insert (j, -1);
+
+                            for (int k = 0; k < noteOffs.size(); ++k)
+                                if (noteOffs.getUnchecked (k) >= j)
+                                    noteOffs.set (k, noteOffs.getUnchecked (k) + 1);
+
+                            noteOffs.set (i, j);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void runTest() override
+    {
+        Random r (getRandom());
+
+        beginTest ("Matched pairs");
+
+        for (int run = 0; run < 20; ++run)
+        {
+            MidiMessageSequence seq;
+
+            for (int i = 0; i < 300; ++i)
+                seq.addEvent (createRandomMessage (r), (double) r.nextInt (100));
+
+            Array<MidiMessage> reference;
+            Array<int> referenceNoteOffs;
+
+            for (int i = 0; i < seq.getNumEvents(); ++i)
+                reference.add (seq.getEventPointer (i)->message);
+
+            seq.updateMatchedPairs();
+            updateMatchedPairsReference (reference, referenceNoteOffs);
+
+            expectEquals (seq.getNumEvents(), reference.size());
+
+            for (int i = 0; i < jmin (seq.getNumEvents(), reference.size()); ++i)
+            {
+                const MidiMessageSequence::MidiEventHolder* const meh = seq.getEventPointer (i);
+                const MidiMessage& m = reference.getReference (i);
+
+                expect (meh->message.getTimeStamp() == m.getTimeStamp());
+                expect (meh->message.getRawDataSize() == m.getRawDataSize()
+                         && memcmp (meh->message.getRawData(), m.getRawData(), (size_t) m.getRawDataSize()) == 0);
+
+                if (m.isNoteOn())
+                    expectEquals (seq.getIndexOf (meh->noteOffObject), referenceNoteOffs[i]);
+            }
+        }
+
+        beginTest ("Searching");
+
+        {
+            MidiMessageSequence seq;
+
+            for (int i = 0; i < 500; ++i)
+                seq.addEvent (createRandomMessage (r), (double) r.nextInt (50));
+
+            for (int i = 1; i < seq.getNumEvents(); ++i)
+                expect (seq.getEventTime (i - 1) <= seq.getEventTime (i));
+
+            for (int i = 0; i < seq.getNumEvents(); ++i)
+                expectEquals (seq.getIndexOf (seq.getEventPointer (i)), i);
+
+            for (double t = -1.0; t < 52.0; t += 0.5)
+            {
+                int expected = 0;
+                while (expected < seq.getNumEvents() && seq.getEventTime (expected) < t)
+                    ++expected;
+
+                expectEquals (seq.getNextIndexAtTime (t), expected);
+
+                const Range<int> range (seq.getIndexRangeForTimes (t, t + 5.0));
+                expectEquals (range.getStart(), expected);
+                expectEquals (range.getEnd(), seq.getNextIndexAtTime (t + 5.0));
+
+                for (int i = range.getStart(); i < range.getEnd(); ++i)
+                    expect (seq.getEventTime (i) >= t && seq.getEventTime (i) < t + 5.0);
+            }
+
+            expect (seq.getIndexRangeForTimes (10.0, 5.0).isEmpty());
+        }
+    }
+};
+
+static MidiMessageSequenceTests midiMessageSequenceTests;
+
+#endif
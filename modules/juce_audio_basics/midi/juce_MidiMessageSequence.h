@@ -48,6 +48,11 @@ public:
     /** Replaces this sequence with another one. */
     MidiMessageSequence& operator= (const MidiMessageSequence&);
 
+   #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+    MidiMessageSequence (MidiMessageSequence&&) noexcept;
+    MidiMessageSequence& operator= (MidiMessageSequence&&) noexcept;
+   #endif
+
     /** Destructor. */
     ~MidiMessageSequence();
 
@@ -83,6 +88,9 @@ public:
         //==============================================================================
         friend class MidiMessageSequence;
         MidiEventHolder (const MidiMessage&);
+       #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+        MidiEventHolder (MidiMessage&&) noexcept;
+       #endif
         JUCE_LEAK_DETECTOR (MidiEventHolder)
     };
 
@@ -108,7 +116,10 @@ public:
     */
     int getIndexOfMatchingKeyUp (int index) const noexcept;
 
-    /** Returns the index of an event. */
+    /** Returns the index of an event.
+        This uses the event's timestamp to find it, so it's quick as long as the
+        sequence is sorted.
+    */
     int getIndexOf (MidiEventHolder* event) const noexcept;
 
     /** Returns the index of the first event on or after the given timestamp.
@@ -117,6 +128,14 @@ public:
     */
     int getNextIndexAtTime (double timeStamp) const noexcept;
 
+    /** Returns the range of indexes of the events whose timestamps are on or after
+        startTime, and before endTime.
+
+        The sequence must be sorted, and because this uses a binary search, it's quick
+        even for very long sequences.
+    */
+    Range<int> getIndexRangeForTimes (double startTime, double endTime) const noexcept;
+
     //==============================================================================
     /** Returns the timestamp of the first event in the sequence.
         @see getEndTime
@@ -149,6 +168,16 @@ public:
     MidiEventHolder* addEvent (const MidiMessage& newMessage,
                                double timeAdjustment = 0);
 
+   #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+    /** Inserts a midi message into the sequence, taking ownership of its data
+        rather than copying it.
+
+        @see addEvent
+    */
+    MidiEventHolder* addEvent (MidiMessage&& newMessage,
+                               double timeAdjustment = 0);
+   #endif
+
     /** Deletes one of the events in the sequence.
 
         Remember to call updateMatchedPairs() after removing events.
@@ -183,7 +212,11 @@ public:
 
         Call this after re-ordering messages or deleting/adding messages, and it
         will scan the list and make sure all the note-offs in the MidiEventHolder
-        structures are pointing at the correct ones.
+        structures are pointing at the correct ones. If a note-on is followed by
+        another note-on for the same note before any note-off, a note-off is
+        inserted just before the second one.
+
+        This is done in a single pass through the sequence.
     */
     void updateMatchedPairs() noexcept;
 
@@ -256,8 +289,12 @@ public:
 private:
     //==============================================================================
     friend class MidiFile;
+    friend class StreamingMidiFileReader;
     OwnedArray<MidiEventHolder> list;
 
+    MidiEventHolder* insertEvent (MidiEventHolder*, double timeAdjustment);
+    int getIndexAfterTime (double timeStamp) const noexcept;
+
     JUCE_LEAK_DETECTOR (MidiMessageSequence)
 };
 
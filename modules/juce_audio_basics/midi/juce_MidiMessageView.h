@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_MIDIMESSAGEVIEW_H_INCLUDED
+#define JUCE_MIDIMESSAGEVIEW_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A lightweight, non-owning reference to a midi event's raw data.
+
+    This lets you inspect the events in a MidiBuffer without having to copy
+    each one into a MidiMessage object. The view just points at the buffer's
+    internal data, so it's only valid until the buffer is next modified. If
+    you need to keep hold of the event, use getMessage() to make a copy.
+
+    @see MidiMessage, MidiBuffer::Iterator
+*/
+class JUCE_API  MidiMessageView
+{
+public:
+    //==============================================================================
+    /** Creates an empty view. */
+    MidiMessageView() noexcept
+        : data (nullptr), numBytes (0), samplePosition (0)
+    {
+    }
+
+    /** Creates a view of some raw midi data, which must remain valid while the view is in use. */
+    MidiMessageView (const uint8* rawData, int numBytesOfData, int position) noexcept
+        : data (rawData), numBytes (numBytesOfData), samplePosition (position)
+    {
+    }
+
+    //==============================================================================
+    /** Returns a pointer to the raw midi data. */
+    const uint8* getRawData() const noexcept            { return data; }
+
+    /** Returns the number of bytes of data in the message. */
+    int getRawDataSize() const noexcept                 { return numBytes; }
+
+    /** Returns the event's position, as a sample index within its buffer. */
+    int getSamplePosition() const noexcept              { return samplePosition; }
+
+    /** Returns a MidiMessage containing a copy of this event, with the sample position
+        as its timestamp.
+    */
+    MidiMessage getMessage() const                      { return MidiMessage (data, numBytes, (double) samplePosition); }
+
+    //==============================================================================
+    /** Returns the midi channel, in the range 1 to 16, or 0 if this isn't a channel message.
+        @see MidiMessage::getChannel
+    */
+    int getChannel() const noexcept                     { return (data[0] & 0xf0) != 0xf0 ? (data[0] & 0xf) + 1 : 0; }
+
+    /** @see MidiMessage::isNoteOn */
+    bool isNoteOn (bool returnTrueForVelocity0 = false) const noexcept
+    {
+        return ((data[0] & 0xf0) == 0x90) && (returnTrueForVelocity0 || data[2] != 0);
+    }
+
+    /** @see MidiMessage::isNoteOff */
+    bool isNoteOff (bool returnTrueForNoteOnVelocity0 = true) const noexcept
+    {
+        return ((data[0] & 0xf0) == 0x80)
+                || (returnTrueForNoteOnVelocity0 && (data[2] == 0) && ((data[0] & 0xf0) == 0x90));
+    }
+
+    /** @see MidiMessage::isController */
+    bool isController() const noexcept                  { return (data[0] & 0xf0) == 0xb0; }
+
+    /** @see MidiMessage::isPitchWheel */
+    bool isPitchWheel() const noexcept                  { return (data[0] & 0xf0) == 0xe0; }
+
+    /** @see MidiMessage::isSysEx */
+    bool isSysEx() const noexcept                       { return data[0] == 0xf0; }
+
+    /** Returns the note number, for a note-on or note-off message. */
+    int getNoteNumber() const noexcept                  { return data[1]; }
+
+    /** Returns the velocity of a note-on or note-off message, in the range 0 to 127. */
+    uint8 getVelocity() const noexcept                  { return (data[0] & 0xe0) == 0x80 ? data[2] : (uint8) 0; }
+
+    /** Returns the controller number of a controller message. */
+    int getControllerNumber() const noexcept            { jassert (isController()); return data[1]; }
+
+    /** Returns the controller value of a controller message. */
+    int getControllerValue() const noexcept             { jassert (isController()); return data[2]; }
+
+    /** Returns the value of a pitch-wheel message, in the range 0 to 0x3fff. */
+    int getPitchWheelValue() const noexcept             { jassert (isPitchWheel()); return data[1] | (data[2] << 7); }
+
+private:
+    //==============================================================================
+    const uint8* data;
+    int numBytes, samplePosition;
+};
+
+
+#endif   // JUCE_MIDIMESSAGEVIEW_H_INCLUDED
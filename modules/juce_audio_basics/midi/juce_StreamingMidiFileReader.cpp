@@ -0,0 +1,235 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+StreamingMidiFileReader::StreamingMidiFileReader (const File& midiFile)
+    : timeFormat (0), fileType (0), valid (false)
+{
+    mappedFile = new MemoryMappedFile (midiFile, MemoryMappedFile::readOnly);
+
+    if (mappedFile->getData() != nullptr)
+        findTracks (static_cast<const uint8*> (mappedFile->getData()), mappedFile->getSize());
+}
+
+StreamingMidiFileReader::StreamingMidiFileReader (const void* midiFileData, size_t numBytes)
+    : timeFormat (0), fileType (0), valid (false)
+{
+    if (midiFileData != nullptr)
+        findTracks (static_cast<const uint8*> (midiFileData), numBytes);
+}
+
+StreamingMidiFileReader::~StreamingMidiFileReader()
+{
+}
+
+void StreamingMidiFileReader::findTracks (const uint8* data, size_t numBytes)
+{
+    const uint8* const end = data + numBytes;
+
+    if (numBytes <= 16)
+        return;
+
+    // (a RIFF-wrapped file needs enough data for the header parser to search through)
+    if (ByteOrder::bigEndianInt (data) != ByteOrder::bigEndianInt ("MThd") && numBytes <= 48)
+        return;
+
+    short numTracksExpected;
+
+    if (! MidiFileHelpers::parseMidiHeader (data, timeFormat, fileType, numTracksExpected) || data > end)
+        return;
+
+    valid = true;
+
+    while (end - data >= 8 && tracks.size() < numTracksExpected)
+    {
+        const uint32 chunkType = ByteOrder::bigEndianInt (data);
+        const size_t chunkSize = jmin ((size_t) ByteOrder::bigEndianInt (data + 4), (size_t) (end - data - 8));
+        data += 8;
+
+        if (chunkType == ByteOrder::bigEndianInt ("MTrk"))
+        {
+            const Track t = { data, chunkSize };
+            tracks.add (t);
+        }
+
+        data += chunkSize;
+    }
+}
+
+void StreamingMidiFileReader::readTrack (const int trackIndex, MidiMessageSequence& destination,
+                                         const bool createMatchingNoteOffs) const
+{
+    destination.clear();
+
+    for (TrackIterator i (*this, trackIndex); i.next();)
+        destination.addEvent (i.getMessage());
+
+    // use the same sort as MidiFile, which puts note-offs before note-ons at the same time
+    MidiFileHelpers::Sorter sorter;
+    destination.list.sort (sorter, true);
+
+    if (createMatchingNoteOffs)
+        destination.updateMatchedPairs();
+}
+
+//==============================================================================
+StreamingMidiFileReader::TrackIterator::TrackIterator (const StreamingMidiFileReader& reader, const int trackIndex) noexcept
+    : trackStart (isPositiveAndBelow (trackIndex, reader.tracks.size()) ? reader.tracks.getReference (trackIndex).data : nullptr),
+      trackEnd (trackStart != nullptr ? trackStart + reader.tracks.getReference (trackIndex).size : nullptr),
+      position (trackStart), eventData (nullptr), eventSize (0),
+      ticks (0), lastStatusByte (0), sysexDataSize (0)
+{
+    jassert (isPositiveAndBelow (trackIndex, reader.tracks.size()));
+}
+
+StreamingMidiFileReader::TrackIterator::~TrackIterator()
+{
+}
+
+void StreamingMidiFileReader::TrackIterator::reset() noexcept
+{
+    position = trackStart;
+    eventData = nullptr;
+    eventSize = 0;
+    ticks = 0;
+    lastStatusByte = 0;
+}
+
+bool StreamingMidiFileReader::TrackIterator::readVariableLengthValue (int& value) noexcept
+{
+    value = 0;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        if (position >= trackEnd)
+            return false;
+
+        const uint8 byte = *position++;
+        value = (value << 7) | (byte & 0x7f);
+
+        if (byte < 0x80)
+            return true;
+    }
+
+    return false;
+}
+
+bool StreamingMidiFileReader::TrackIterator::next() noexcept
+{
+    int delta;
+
+    if (! readVariableLengthValue (delta) || position >= trackEnd)
+        return false;
+
+    ticks += delta;
+
+    const uint8 firstByte = *position;
+
+    if (firstByte == 0xff)
+    {
+        // meta-events are kept in the same form as they're stored in the file
+        const uint8* const start = position;
+        position += 2;
+        int length;
+
+        if (position > trackEnd || ! readVariableLengthValue (length) || length > trackEnd - position)
+            return false;
+
+        position += length;
+        eventData = start;
+        eventSize = (int) (position - start);
+        return true;
+    }
+
+    if (firstByte == 0xf0 || firstByte == 0xf7)
+    {
+        // sysex data has its length stored after the 0xf0, so needs copying to remove it
+        ++position;
+        int length;
+
+        if (! readVariableLengthValue (length) || length > trackEnd - position)
+            return false;
+
+        if ((size_t) length + 1 > sysexDataSize)
+        {
+            sysexDataSize = (size_t) length + 1;
+            sysexData.realloc (sysexDataSize);
+        }
+
+        sysexData[0] = firstByte;
+        memcpy (sysexData + 1, position, (size_t) length);
+        position += length;
+
+        eventData = sysexData;
+        eventSize = length + 1;
+        return true;
+    }
+
+    if (firstByte >= 0x80)
+    {
+        const int length = MidiMessage::getMessageLengthFromFirstByte (firstByte);
+
+        if (length > trackEnd - position)
+            return false;
+
+        if ((firstByte & 0xf0) != 0xf0)
+            lastStatusByte = firstByte;
+
+        eventData = position;
+        eventSize = length;
+        position += length;
+        return true;
+    }
+
+    // running status, so the message needs to be re-assembled with its status byte
+    if (lastStatusByte == 0)
+        return false;
+
+    const int numDataBytes = MidiMessage::getMessageLengthFromFirstByte (lastStatusByte) - 1;
+
+    if (numDataBytes > trackEnd - position)
+        return false;
+
+    shortMessage[0] = lastStatusByte;
+
+    for (int i = 0; i < numDataBytes; ++i)
+        shortMessage[i + 1] = position[i];
+
+    position += numDataBytes;
+    eventData = shortMessage;
+    eventSize = numDataBytes + 1;
+    return true;
+}
+
+MidiMessageView StreamingMidiFileReader::TrackIterator::getEvent() const noexcept
+{
+    jassert (eventData != nullptr); // you need to call next() before getting the event!
+    return MidiMessageView (eventData, eventSize, (int) ticks);
+}
+
+MidiMessage StreamingMidiFileReader::TrackIterator::getMessage() const
+{
+    jassert (eventData != nullptr); // you need to call next() before getting the event!
+    return MidiMessage (eventData, eventSize, (double) ticks);
+}
@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_STREAMINGMIDIFILEREADER_H_INCLUDED
+#define JUCE_STREAMINGMIDIFILEREADER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Reads the events from a standard midi file without loading its tracks into memory.
+
+    Unlike MidiFile::readFrom(), which copies the whole stream into memory and turns
+    every track into a MidiMessageSequence, this maps the file into memory, and lets you
+    iterate each track's events straight from the mapped data with a TrackIterator. Only
+    the positions of the track chunks are found when the reader is created, so opening
+    even a very large file is quick, and uses very little memory.
+
+    The reader isn't changed by iterating it, so any number of threads can iterate its
+    tracks at the same time, each with their own TrackIterator, and you can happily use
+    a separate reader per file to process many files in parallel (e.g. with a ThreadPool).
+
+    If you do need a track as a MidiMessageSequence, readTrack() will build one, and can
+    match up the note-on and note-off events if you need them to be.
+
+    @see MidiFile, MidiMessageView
+*/
+class JUCE_API  StreamingMidiFileReader
+{
+public:
+    //==============================================================================
+    /** Opens a midi file by mapping it into memory.
+        If the file can't be opened or isn't a valid midi file, isValid() will return false.
+    */
+    explicit StreamingMidiFileReader (const File& midiFile);
+
+    /** Reads a midi file from a block of data in memory.
+        The data isn't copied, so it must remain valid until this reader and any
+        iterators using it have been deleted.
+    */
+    StreamingMidiFileReader (const void* midiFileData, size_t numBytes);
+
+    /** Destructor. */
+    ~StreamingMidiFileReader();
+
+    //==============================================================================
+    /** Returns true if a valid midi file header was found. */
+    bool isValid() const noexcept                       { return valid; }
+
+    /** Returns the file's type (0, 1 or 2). */
+    int getFileType() const noexcept                    { return fileType; }
+
+    /** Returns the raw time format code from the file's header.
+        @see MidiFile::getTimeFormat
+    */
+    short getTimeFormat() const noexcept                { return timeFormat; }
+
+    /** Returns the number of track chunks in the file. */
+    int getNumTracks() const noexcept                   { return tracks.size(); }
+
+    //==============================================================================
+    /**
+        Steps through the events in one of a StreamingMidiFileReader's tracks.
+
+        The events are returned in the order they appear in the file, with their times
+        in midi ticks. Each iterator only holds its own position, so you can create as
+        many as you like, on any thread.
+    */
+    class JUCE_API  TrackIterator
+    {
+    public:
+        /** Creates an iterator, positioned before the first event of the given track. */
+        TrackIterator (const StreamingMidiFileReader& reader, int trackIndex) noexcept;
+
+        /** Destructor. */
+        ~TrackIterator();
+
+        /** Moves on to the next event.
+            @returns false if there are no more events, or if the data is corrupt
+        */
+        bool next() noexcept;
+
+        /** Returns the current event's time, in midi ticks from the start of the track. */
+        int64 getTimeInTicks() const noexcept           { return ticks; }
+
+        /** Returns a view of the current event's raw data, with its time in ticks as the position.
+            The view is only valid until next() is called.
+        */
+        MidiMessageView getEvent() const noexcept;
+
+        /** Returns a MidiMessage containing a copy of the current event, with its time
+            in ticks as the timestamp.
+        */
+        MidiMessage getMessage() const;
+
+        /** Restarts the iterator at the beginning of its track. */
+        void reset() noexcept;
+
+    private:
+        //==============================================================================
+        const uint8* const trackStart;
+        const uint8* const trackEnd;
+        const uint8* position;
+        const uint8* eventData;
+        int eventSize;
+        int64 ticks;
+        uint8 lastStatusByte;
+        uint8 shortMessage[3];
+        HeapBlock<uint8> sysexData;
+        size_t sysexDataSize;
+
+        bool readVariableLengthValue (int& value) noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE (TrackIterator)
+    };
+
+    //==============================================================================
+    /** Reads a whole track into a MidiMessageSequence, with timestamps in midi ticks.
+
+        The events are sorted in the same way as MidiFile::readFrom() sorts them. If
+        createMatchingNoteOffs is true, MidiMessageSequence::updateMatchedPairs() is called
+        on the result, which is what MidiFile does, but is slow for very large tracks.
+    */
+    void readTrack (int trackIndex, MidiMessageSequence& destination, bool createMatchingNoteOffs = true) const;
+
+private:
+    //==============================================================================
+    struct Track
+    {
+        const uint8* data;
+        size_t size;
+    };
+
+    ScopedPointer<MemoryMappedFile> mappedFile;
+    Array<Track> tracks;
+    short timeFormat, fileType;
+    bool valid;
+
+    void findTracks (const uint8* data, size_t numBytes);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StreamingMidiFileReader)
+};
+
+
+#endif   // JUCE_STREAMINGMIDIFILEREADER_H_INCLUDED
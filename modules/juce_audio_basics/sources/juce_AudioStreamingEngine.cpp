@@ -0,0 +1,668 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+AudioStreamingEngine::AudioStreamingEngine (TimeSliceThread& thread, const size_t maxBytesToBuffer)
+    : backgroundThread (thread),
+      numSlabs (jmax (1, (int) (maxBytesToBuffer / ((size_t) getSlabSize() * sizeof (float))))),
+      numFreeSlabs (numSlabs)
+{
+    slabData.malloc ((size_t) numSlabs * (size_t) getSlabSize());
+    freeSlabs.malloc ((size_t) numSlabs);
+
+    for (int i = 0; i < numSlabs; ++i)
+        freeSlabs[i] = i;
+
+    backgroundThread.addTimeSliceClient (this);
+}
+
+AudioStreamingEngine::~AudioStreamingEngine()
+{
+    // You need to delete all your Streams before deleting the engine that they use!
+    jassert (streams.size() == 0);
+
+    backgroundThread.removeTimeSliceClient (this);
+}
+
+AudioStreamingEngine::Stream* AudioStreamingEngine::createStream (PositionableAudioSource* const source,
+                                                                  const bool deleteSourceWhenDeleted,
+                                                                  const int numberOfSamplesToBuffer,
+                                                                  const int numberOfChannels)
+{
+    return new Stream (*this, source, deleteSourceWhenDeleted, numberOfSamplesToBuffer, numberOfChannels);
+}
+
+float AudioStreamingEngine::getProportionOfMemoryUsed() const noexcept
+{
+    return 1.0f - numFreeSlabs / (float) numSlabs;
+}
+
+int AudioStreamingEngine::allocateSlab() noexcept
+{
+    const SpinLock::ScopedLockType sl (freeSlabLock);
+    return numFreeSlabs > 0 ? freeSlabs [--numFreeSlabs] : -1;
+}
+
+void AudioStreamingEngine::releaseSlab (const int slab) noexcept
+{
+    const SpinLock::ScopedLockType sl (freeSlabLock);
+    jassert (numFreeSlabs < numSlabs);
+    freeSlabs [numFreeSlabs++] = slab;
+}
+
+int AudioStreamingEngine::useTimeSlice()
+{
+    const ScopedLock sl (streamLock);
+
+    Stream* mostUrgent = nullptr;
+    double shortestTime = std::numeric_limits<double>::max();
+
+    for (int i = streams.size(); --i >= 0;)
+    {
+        Stream* const s = streams.getUnchecked (i);
+
+        if (s->needsReading())
+        {
+            const double t = s->getSecondsUntilEmpty();
+
+            if (t < shortestTime)
+            {
+                mostUrgent = s;
+                shortestTime = t;
+            }
+        }
+    }
+
+    if (mostUrgent == nullptr)
+        return 20;
+
+    if (mostUrgent->readNextChunk())
+        return 1;
+
+    // If there's no free memory, start by taking back any slabs that streams are
+    // still holding for audio that they've already played..
+    for (int i = streams.size(); --i >= 0;)
+        streams.getUnchecked (i)->releasePlayedSlabs();
+
+    if (mostUrgent->readNextChunk())
+        return 1;
+
+    // ..and if that's not enough, take slabs from whichever stream has the most audio
+    // buffered, for as long as it'd still have more than this one afterwards. This one
+    // is the stream that'll run out soonest, so it always gets the memory first.
+    for (;;)
+    {
+        Stream* donor = nullptr;
+        double longestTime = shortestTime;
+
+        for (int i = streams.size(); --i >= 0;)
+        {
+            Stream* const s = streams.getUnchecked (i);
+            const double t = s->getSecondsToSpare();
+
+            if (t > longestTime && s != mostUrgent)
+            {
+                donor = s;
+                longestTime = t;
+            }
+        }
+
+        if (donor == nullptr || ! donor->releaseLastSlab())
+            return 20;
+
+        if (mostUrgent->readNextChunk())
+            return 1;
+    }
+}
+
+//==============================================================================
+AudioStreamingEngine::Stream::Stream (AudioStreamingEngine& e, PositionableAudioSource* const s,
+                                      const bool deleteSourceWhenDeleted, const int bufferSizeSamples,
+                                      const int numChannels)
+    : engine (e),
+      source (s, deleteSourceWhenDeleted),
+      numberOfSamplesToBuffer (jmax (1024, bufferSizeSamples)),
+      numberOfChannels (numChannels),
+      bufferSize (0), numSlots (0),
+      bufferValidStart (0),
+      bufferValidEnd (0),
+      nextPlayPos (0),
+      sampleRate (0),
+      numUnderruns (0),
+      numSamplesMissed (0),
+      wasSourceLooping (false),
+      isPrepared (false)
+{
+    jassert (source != nullptr);
+    channelPointers.malloc ((size_t) numberOfChannels);
+}
+
+AudioStreamingEngine::Stream::~Stream()
+{
+    releaseResources();
+}
+
+//==============================================================================
+void AudioStreamingEngine::Stream::prepareToPlay (int samplesPerBlockExpected, double newSampleRate)
+{
+    const int bufferSizeNeeded = jmax (samplesPerBlockExpected * 2, numberOfSamplesToBuffer);
+
+    if (newSampleRate != sampleRate
+         || bufferSizeNeeded != bufferSize
+         || ! isPrepared)
+    {
+        {
+            const ScopedLock sl (engine.streamLock);
+            engine.streams.removeFirstMatchingValue (this);
+        }
+
+        isPrepared = true;
+        sampleRate = newSampleRate;
+
+        source->prepareToPlay (samplesPerBlockExpected, newSampleRate);
+
+        {
+            const ScopedLock sl (bufferStartPosLock);
+
+            releaseSlabs (0, 0);
+            bufferSize = bufferSizeNeeded;
+            numSlots = bufferSize / getSlabSize() + 2;
+
+            slotSlabs.malloc ((size_t) (numSlots * numberOfChannels));
+            slotPositions.malloc ((size_t) numSlots);
+
+            for (int i = 0; i < numSlots; ++i)
+                slotPositions[i] = -1;
+
+            bufferValidStart = 0;
+            bufferValidEnd = 0;
+        }
+
+        {
+            const ScopedLock sl (engine.streamLock);
+            engine.streams.add (this);
+        }
+
+        while (getNumSamplesBuffered() < jmin (((int) newSampleRate) / 4, bufferSize / 2)
+                && needsReading() && engine.numFreeSlabs > 0
+                && engine.backgroundThread.isThreadRunning())
+        {
+            engine.backgroundThread.notify();
+            Thread::sleep (5);
+        }
+    }
+}
+
+void AudioStreamingEngine::Stream::releaseResources()
+{
+    isPrepared = false;
+
+    {
+        const ScopedLock sl (engine.streamLock);
+        engine.streams.removeFirstMatchingValue (this);
+    }
+
+    {
+        const ScopedLock sl (bufferStartPosLock);
+        releaseSlabs (0, 0);
+        bufferValidStart = 0;
+        bufferValidEnd = 0;
+    }
+
+    source->releaseResources();
+}
+
+void AudioStreamingEngine::Stream::getNextAudioBlock (const AudioSourceChannelInfo& info)
+{
+    const ScopedLock sl (bufferStartPosLock);
+
+    // Past the end of a non-looping source, there's nothing to read, so it counts as silence
+    // rather than as missing data..
+    const int64 totalLength = source->getTotalLength();
+    const bool reachedEnd = totalLength > 0 && ! source->isLooping() && bufferValidEnd >= totalLength;
+    const int64 dataEnd = reachedEnd ? jmax (nextPlayPos + info.numSamples, bufferValidEnd) : bufferValidEnd;
+
+    const int validStart = (int) (jlimit (bufferValidStart, dataEnd, nextPlayPos) - nextPlayPos);
+    const int validEnd   = (int) (jlimit (bufferValidStart, dataEnd, nextPlayPos + info.numSamples) - nextPlayPos);
+    const int numMissed  = info.numSamples - (validEnd - validStart);
+
+    if (numMissed > 0 && isPrepared)
+    {
+        ++numUnderruns;
+        numSamplesMissed += numMissed;
+    }
+
+    if (validStart == validEnd)
+    {
+        // total cache miss
+        info.clearActiveBufferRegion();
+        return;
+    }
+
+    if (validStart > 0)
+        info.buffer->clear (info.startSample, validStart);  // partial cache miss at start
+
+    const int bufferedEnd = (int) (jmin (nextPlayPos + validEnd, (int64) bufferValidEnd) - nextPlayPos);
+
+    if (bufferedEnd < info.numSamples)
+        info.buffer->clear (info.startSample + jmax (validStart, bufferedEnd),
+                            info.numSamples - jmax (validStart, bufferedEnd));   // partial cache miss or end of source
+
+    const int numChans = jmin (numberOfChannels, info.buffer->getNumChannels());
+
+    for (int i = validStart; i < bufferedEnd;)
+    {
+        const int64 pos = nextPlayPos + i;
+        const int offsetInSlab = (int) (pos % getSlabSize());
+        const int num = jmin (getSlabSize() - offsetInSlab, bufferedEnd - i);
+        const int slot = getSlot (pos);
+
+        for (int chan = numChans; --chan >= 0;)
+            info.buffer->copyFrom (chan, info.startSample + i, getSlabChannel (slot, chan) + offsetInSlab, num);
+
+        i += num;
+    }
+
+    nextPlayPos += info.numSamples;
+}
+
+int64 AudioStreamingEngine::Stream::getNextReadPosition() const
+{
+    jassert (source->getTotalLength() > 0);
+    return (source->isLooping() && nextPlayPos > 0)
+                    ? nextPlayPos % source->getTotalLength()
+                    : nextPlayPos;
+}
+
+void AudioStreamingEngine::Stream::setNextReadPosition (int64 newPosition)
+{
+    {
+        const ScopedLock sl (bufferStartPosLock);
+        nextPlayPos = newPosition;
+    }
+
+    engine.backgroundThread.notify();
+}
+
+int AudioStreamingEngine::Stream::getNumSamplesBuffered() const noexcept
+{
+    const int64 pos = nextPlayPos, start = bufferValidStart, end = bufferValidEnd;
+    return (pos >= start && pos < end) ? (int) (end - pos) : 0;
+}
+
+void AudioStreamingEngine::Stream::resetUnderrunStatistics() noexcept
+{
+    numUnderruns = 0;
+    numSamplesMissed = 0;
+}
+
+//==============================================================================
+int AudioStreamingEngine::Stream::getSlot (const int64 position) const noexcept
+{
+    return (int) ((position / getSlabSize()) % numSlots);
+}
+
+float* AudioStreamingEngine::Stream::getSlabChannel (const int slot, const int channel) const noexcept
+{
+    const int slab = slotSlabs [slot * numberOfChannels + channel];
+    jassert (slab >= 0 && slotPositions[slot] >= 0);
+    return engine.slabData + slab * getSlabSize();
+}
+
+void AudioStreamingEngine::Stream::releaseSlabs (const int64 keepStart, const int64 keepEnd)
+{
+    for (int slot = 0; slot < numSlots; ++slot)
+    {
+        const int64 slabStart = slotPositions[slot] * getSlabSize();
+
+        if (slotPositions[slot] >= 0
+             && (slabStart + getSlabSize() <= keepStart || slabStart >= keepEnd))
+        {
+            for (int i = 0; i < numberOfChannels; ++i)
+                engine.releaseSlab (slotSlabs [slot * numberOfChannels + i]);
+
+            slotPositions[slot] = -1;
+        }
+    }
+}
+
+void AudioStreamingEngine::Stream::releasePlayedSlabs()
+{
+    const ScopedLock sl (bufferStartPosLock);
+
+    const int64 newBVS = jmax ((int64) 0, (int64) nextPlayPos);
+
+    if (wasSourceLooping != isLooping() || newBVS < bufferValidStart || newBVS > bufferValidEnd)
+    {
+        wasSourceLooping = isLooping();
+        bufferValidStart = newBVS;
+        bufferValidEnd = newBVS;
+    }
+
+    bufferValidStart = newBVS;
+    releaseSlabs (bufferValidStart, bufferValidEnd);
+}
+
+bool AudioStreamingEngine::Stream::releaseLastSlab()
+{
+    const ScopedLock sl (bufferStartPosLock);
+
+    const int64 newEnd = ((bufferValidEnd - 1) / getSlabSize()) * getSlabSize();
+
+    if (newEnd <= nextPlayPos || newEnd < bufferValidStart)
+        return false;
+
+    bufferValidEnd = newEnd;
+    releaseSlabs (bufferValidStart, bufferValidEnd);
+    return true;
+}
+
+double AudioStreamingEngine::Stream::getSecondsUntilEmpty() const noexcept
+{
+    return sampleRate > 0 ? getNumSamplesBuffered() / sampleRate : 0.0;
+}
+
+double AudioStreamingEngine::Stream::getSecondsToSpare() const noexcept
+{
+    return sampleRate > 0 ? (getNumSamplesBuffered() - getSlabSize()) / sampleRate : 0.0;
+}
+
+bool AudioStreamingEngine::Stream::needsReading() const noexcept
+{
+    if (! isPrepared)
+        return false;
+
+    const int64 pos = jmax ((int64) 0, (int64) nextPlayPos), start = bufferValidStart, end = bufferValidEnd;
+
+    if (pos < start || pos > end || wasSourceLooping != isLooping())
+        return true;
+
+    const int64 totalLength = source->getTotalLength();
+
+    if (totalLength > 0 && ! source->isLooping() && end >= totalLength)
+        return false;
+
+    // Wait until there's a whole slab to read, unless it's about to run out
+    return pos + bufferSize - end >= getSlabSize()
+            || end - pos < getSlabSize();
+}
+
+bool AudioStreamingEngine::Stream::allocateSlot (const int slot)
+{
+    for (int i = 0; i < numberOfChannels; ++i)
+    {
+        const int slab = engine.allocateSlab();
+
+        if (slab < 0)
+        {
+            while (--i >= 0)
+                engine.releaseSlab (slotSlabs [slot * numberOfChannels + i]);
+
+            return false;
+        }
+
+        slotSlabs [slot * numberOfChannels + i] = slab;
+    }
+
+    return true;
+}
+
+bool AudioStreamingEngine::Stream::readNextChunk()
+{
+    int64 sectionToReadStart, sectionToReadEnd;
+
+    {
+        const ScopedLock sl (bufferStartPosLock);
+
+        releasePlayedSlabs();
+
+        sectionToReadStart = bufferValidEnd;
+        sectionToReadEnd = bufferValidStart + bufferSize;
+
+        const int64 totalLength = source->getTotalLength();
+
+        if (totalLength > 0 && ! source->isLooping())
+            sectionToReadEnd = jmin (sectionToReadEnd, totalLength);
+
+        // Read a few slabs at a time, and where possible only fill whole slabs, so
+        // that the next read can carry on where this one left off..
+        const int maxChunkSize = 4 * getSlabSize();
+        sectionToReadEnd = jmin (sectionToReadEnd, sectionToReadStart + maxChunkSize);
+
+        const int64 firstSlabEnd = (sectionToReadStart / getSlabSize() + 1) * getSlabSize();
+
+        if (sectionToReadEnd > firstSlabEnd)
+            sectionToReadEnd = jmax (firstSlabEnd, (sectionToReadEnd / getSlabSize()) * getSlabSize());
+
+        // Make sure all the slabs we're going to write into are allocated..
+        for (int64 slabPos = sectionToReadStart / getSlabSize(); slabPos * getSlabSize() < sectionToReadEnd; ++slabPos)
+        {
+            const int slot = (int) (slabPos % numSlots);
+
+            if (slotPositions[slot] == slabPos)
+                continue;
+
+            // (if the slot's still holding slabs for some other position, that audio is outside
+            // the valid range, so they can just be reused)
+            if (slotPositions[slot] < 0 && ! allocateSlot (slot))
+            {
+                sectionToReadEnd = jmax (sectionToReadStart, slabPos * getSlabSize());
+                break;
+            }
+
+            slotPositions[slot] = slabPos;
+        }
+    }
+
+    if (sectionToReadStart >= sectionToReadEnd)
+        return false;
+
+    readSection (sectionToReadStart, (int) (sectionToReadEnd - sectionToReadStart));
+
+    const ScopedLock sl (bufferStartPosLock);
+    bufferValidEnd = sectionToReadEnd;
+    return true;
+}
+
+void AudioStreamingEngine::Stream::readSection (const int64 start, const int length)
+{
+    if (source->getNextReadPosition() != start)
+        source->setNextReadPosition (start);
+
+    for (int i = 0; i < length;)
+    {
+        const int64 pos = start + i;
+        const int offsetInSlab = (int) (pos % getSlabSize());
+        const int num = jmin (getSlabSize() - offsetInSlab, length - i);
+        const int slot = getSlot (pos);
+
+        for (int chan = 0; chan < numberOfChannels; ++chan)
+            channelPointers[chan] = getSlabChannel (slot, chan) + offsetInSlab;
+
+        AudioSampleBuffer buffer (channelPointers, numberOfChannels, num);
+        AudioSourceChannelInfo info (&buffer, 0, num);
+        source->getNextAudioBlock (info);
+
+        i += num;
+    }
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioStreamingEngineTests  : public UnitTest
+{
+public:
+    AudioStreamingEngineTests()  : UnitTest ("AudioStreamingEngine") {}
+
+    // A source whose samples are their own positions, so it's easy to check the output..
+    struct RampSource  : public PositionableAudioSource
+    {
+        RampSource (int64 len) : length (len), position (0) {}
+
+        void prepareToPlay (int, double) override {}
+        void releaseResources() override {}
+
+        void getNextAudioBlock (const AudioSourceChannelInfo& info) override
+        {
+            for (int chan = 0; chan < info.buffer->getNumChannels(); ++chan)
+                for (int i = 0; i < info.numSamples; ++i)
+                    info.buffer->setSample (chan, info.startSample + i,
+                                            position + i < length ? (float) ((position + i) * 2 + chan) : 0.0f);
+
+            position += info.numSamples;
+        }
+
+        void setNextReadPosition (int64 newPosition) override   { position = newPosition; }
+        int64 getNextReadPosition() const override              { return position; }
+        int64 getTotalLength() const override                   { return length; }
+        bool isLooping() const override                         { return false; }
+
+        const int64 length;
+        int64 position;
+    };
+
+    // The tests never start their TimeSliceThread, and instead do the engine's work
+    // themselves, so that the results don't depend on how the threads get scheduled..
+    static void readAhead (TimeSliceThread& thread)
+    {
+        TimeSliceClient* const engine = thread.getClient (0);
+
+        for (int i = 0; i < 10000 && engine->useTimeSlice() <= 1; ++i)
+        {}
+    }
+
+    static int getTotalBuffered (const OwnedArray<AudioStreamingEngine::Stream>& streams)
+    {
+        int total = 0;
+
+        for (int i = 0; i < streams.size(); ++i)
+            total += streams.getUnchecked (i)->getNumSamplesBuffered();
+
+        return total;
+    }
+
+    static bool playAndCheck (TimeSliceThread& thread, AudioStreamingEngine::Stream& stream, int64 startPos, int numBlocks)
+    {
+        AudioSampleBuffer buffer (2, 512);
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            readAhead (thread);
+
+            if (stream.getNumSamplesBuffered() < buffer.getNumSamples())
+                return false;
+
+            stream.getNextAudioBlock (AudioSourceChannelInfo (buffer));
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const int64 pos = startPos + block * buffer.getNumSamples() + i;
+
+                if (buffer.getSample (0, i) != (float) (pos * 2) || buffer.getSample (1, i) != (float) (pos * 2 + 1))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    void runTest() override
+    {
+        TimeSliceThread thread ("streaming test");
+
+        beginTest ("Reading");
+        {
+            AudioStreamingEngine engine (thread, 1024 * 1024);
+            ScopedPointer<AudioStreamingEngine::Stream> stream (engine.createStream (new RampSource (1000000), true, 32768));
+            stream->prepareToPlay (512, 44100.0);
+
+            expect (playAndCheck (thread, *stream, 0, 300));
+
+            stream->setNextReadPosition (500000);
+            expect (playAndCheck (thread, *stream, 500000, 100));
+            expect (stream->getNextReadPosition() == 500000 + 100 * 512);
+
+            stream->releaseResources();
+            expect (engine.getProportionOfMemoryUsed() == 0.0f);
+        }
+
+        beginTest ("End of source");
+        {
+            AudioStreamingEngine engine (thread, 1024 * 1024);
+            ScopedPointer<AudioStreamingEngine::Stream> stream (engine.createStream (new RampSource (10000), true, 32768));
+            stream->prepareToPlay (512, 44100.0);
+            stream->resetUnderrunStatistics();
+            readAhead (thread);
+
+            AudioSampleBuffer buffer (2, 512);
+
+            for (int i = 0; i < 40; ++i)
+                stream->getNextAudioBlock (AudioSourceChannelInfo (buffer));
+
+            expectEquals (stream->getNumUnderruns(), 0);
+            expect (buffer.getMagnitude (0, 512) == 0.0f);
+        }
+
+        beginTest ("Sharing memory");
+        {
+            // Enough memory for all the streams to have some data, but not a full buffer each..
+            const int numStreams = 8;
+            AudioStreamingEngine engine (thread, (size_t) numStreams * 2 * 3 * 4096 * sizeof (float));
+            OwnedArray<AudioStreamingEngine::Stream> streams;
+
+            for (int i = 0; i < numStreams; ++i)
+            {
+                streams.add (engine.createStream (new RampSource (1000000), true, 65536));
+                streams.getLast()->prepareToPlay (512, 44100.0);
+            }
+
+            // The memory should be shared out evenly, even though the first streams
+            // to be serviced would happily have used all of it..
+            readAhead (thread);
+            expect (engine.getProportionOfMemoryUsed() == 1.0f);
+
+            for (int i = 0; i < numStreams; ++i)
+                expectEquals (streams.getUnchecked (i)->getNumSamplesBuffered(), 3 * AudioStreamingEngine::getSlabSize());
+
+            // Each stream that plays has to take memory from the others as it goes..
+            for (int i = 0; i < numStreams; ++i)
+                expect (playAndCheck (thread, *streams.getUnchecked (i), 0, 50));
+
+            for (int i = 0; i < numStreams; ++i)
+                expect (streams.getUnchecked (i)->getNumSamplesBuffered() >= AudioStreamingEngine::getSlabSize());
+
+            // ..and when one is released, its memory goes to the others.
+            streams.getFirst()->releaseResources();
+            const int numBuffered = getTotalBuffered (streams);
+            readAhead (thread);
+            expect (engine.getProportionOfMemoryUsed() == 1.0f);
+            expect (getTotalBuffered (streams) > numBuffered);
+            expect (playAndCheck (thread, *streams.getUnchecked (1), 50 * 512, 100));
+        }
+    }
+};
+
+static AudioStreamingEngineTests audioStreamingEngineTests;
+
+#endif
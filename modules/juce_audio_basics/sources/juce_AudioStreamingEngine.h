@@ -0,0 +1,205 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_AUDIOSTREAMINGENGINE_H_INCLUDED
+#define JUCE_AUDIOSTREAMINGENGINE_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Reads ahead from a large number of PositionableAudioSources on a background
+    thread, sharing one pool of memory between them.
+
+    Each Stream that this creates does the same job as a BufferingAudioSource (and
+    can be used in the same places), but instead of each one having its own buffer
+    and being serviced in turn, the engine keeps track of all of them:
+
+    - Their buffers are made up of slabs of getSlabSize() samples, which are taken
+      from a single block of memory that's allocated when the engine is created. A
+      stream only holds slabs for the audio it has actually buffered, so the memory
+      used by streams that are stopped, or that have just been repositioned, can be
+      used by the others.
+    - Each time the background thread runs, it reads from whichever stream will run
+      out of buffered audio soonest. If there's no free memory, that stream takes
+      slabs from the one with the most audio buffered.
+    - Except just after a stream has been repositioned, it waits until there's at
+      least a whole slab to read, and then reads as much as it can, so the sources
+      get fewer, larger sequential reads.
+    - Each Stream counts how many times it has run out of data, so you can see
+      whether the engine is keeping up.
+
+    @see BufferingAudioSource
+*/
+class JUCE_API  AudioStreamingEngine  : private TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** Creates an engine.
+
+        @param backgroundThread     the thread that should be used to read from the sources.
+                                    Make sure that the thread you supply is running, and that it
+                                    won't be deleted before the engine
+        @param maxBytesToBuffer     the total amount of memory that all of the streams can use
+                                    between them
+    */
+    AudioStreamingEngine (TimeSliceThread& backgroundThread, size_t maxBytesToBuffer);
+
+    /** Destructor.
+        You must delete all the Streams that were created by this engine before
+        deleting the engine itself.
+    */
+    ~AudioStreamingEngine();
+
+    //==============================================================================
+    /** A PositionableAudioSource which reads ahead from another source using an
+        AudioStreamingEngine.
+        You create one of these with AudioStreamingEngine::createStream().
+    */
+    class JUCE_API  Stream  : public PositionableAudioSource
+    {
+    public:
+        /** Destructor.
+            The input source may be deleted depending on whether the deleteSourceWhenDeleted
+            flag was set when this was created.
+        */
+        ~Stream();
+
+        //==============================================================================
+        /** Implementation of the AudioSource method. */
+        void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+
+        /** Implementation of the AudioSource method. */
+        void releaseResources() override;
+
+        /** Implementation of the AudioSource method. */
+        void getNextAudioBlock (const AudioSourceChannelInfo&) override;
+
+        /** Implements the PositionableAudioSource method. */
+        void setNextReadPosition (int64 newPosition) override;
+
+        /** Implements the PositionableAudioSource method. */
+        int64 getNextReadPosition() const override;
+
+        /** Implements the PositionableAudioSource method. */
+        int64 getTotalLength() const override       { return source->getTotalLength(); }
+
+        /** Implements the PositionableAudioSource method. */
+        bool isLooping() const override             { return source->isLooping(); }
+
+        //==============================================================================
+        /** Returns the number of samples ahead of the current play position that have
+            been read from the source.
+        */
+        int getNumSamplesBuffered() const noexcept;
+
+        /** Returns the number of times getNextAudioBlock() couldn't supply all the
+            samples it was asked for, because the engine hadn't read them yet.
+        */
+        int getNumUnderruns() const noexcept        { return numUnderruns; }
+
+        /** Returns the total number of samples that getNextAudioBlock() had to fill
+            with silence because the engine hadn't read them yet.
+        */
+        int64 getNumSamplesMissed() const noexcept  { return numSamplesMissed; }
+
+        /** Resets the counts returned by getNumUnderruns() and getNumSamplesMissed(). */
+        void resetUnderrunStatistics() noexcept;
+
+    private:
+        friend class AudioStreamingEngine;
+
+        AudioStreamingEngine& engine;
+        OptionalScopedPointer<PositionableAudioSource> source;
+        const int numberOfSamplesToBuffer, numberOfChannels;
+        int bufferSize, numSlots;
+        HeapBlock<int> slotSlabs;
+        HeapBlock<int64> slotPositions;
+        HeapBlock<float*> channelPointers;
+        CriticalSection bufferStartPosLock;
+        int64 volatile bufferValidStart, bufferValidEnd, nextPlayPos;
+        double volatile sampleRate;
+        int volatile numUnderruns;
+        int64 volatile numSamplesMissed;
+        bool wasSourceLooping, isPrepared;
+
+        Stream (AudioStreamingEngine&, PositionableAudioSource*, bool deleteSource, int numSamples, int numChannels);
+        int getSlot (int64 position) const noexcept;
+        float* getSlabChannel (int slot, int channel) const noexcept;
+        void releaseSlabs (int64 keepStart, int64 keepEnd);
+        double getSecondsUntilEmpty() const noexcept;
+        double getSecondsToSpare() const noexcept;
+        bool needsReading() const noexcept;
+        void releasePlayedSlabs();
+        bool releaseLastSlab();
+        bool allocateSlot (int slot);
+        bool readNextChunk();
+        void readSection (int64 start, int length);
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Stream)
+    };
+
+    /** Creates a Stream that will read ahead from a source using this engine.
+
+        @param source                   the input source to read from
+        @param deleteSourceWhenDeleted  if true, then the input source object will
+                                        be deleted when the stream is deleted
+        @param numberOfSamplesToBuffer  the maximum number of samples that the stream should
+                                        read ahead of its play position
+        @param numberOfChannels         the number of channels that will be played
+
+        The caller must delete the Stream that's returned, before deleting the engine.
+    */
+    Stream* createStream (PositionableAudioSource* source,
+                          bool deleteSourceWhenDeleted,
+                          int numberOfSamplesToBuffer,
+                          int numberOfChannels = 2);
+
+    //==============================================================================
+    /** Returns the number of samples in each slab of memory. */
+    static int getSlabSize() noexcept                   { return 4096; }
+
+    /** Returns the proportion of the engine's memory that's currently in use, from 0 to 1. */
+    float getProportionOfMemoryUsed() const noexcept;
+
+private:
+    //==============================================================================
+    TimeSliceThread& backgroundThread;
+    HeapBlock<float> slabData;
+    HeapBlock<int> freeSlabs;
+    const int numSlabs;
+    int numFreeSlabs;
+    SpinLock freeSlabLock;
+
+    Array<Stream*> streams;
+    CriticalSection streamLock;
+
+    int allocateSlab() noexcept;
+    void releaseSlab (int slab) noexcept;
+    int useTimeSlice() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioStreamingEngine)
+};
+
+
+#endif   // JUCE_AUDIOSTREAMINGENGINE_H_INCLUDED
@@ -22,6 +22,12 @@
   ==============================================================================
 */
 
+BufferingAudioSource::CuePoint::CuePoint (const int64 start, const int numChannels, const int numSamples, const bool temporary)
+    : startPosition (start), data (numChannels, numSamples), numValid (0), isTemporary (temporary)
+{
+}
+
+//==============================================================================
 BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
                                             TimeSliceThread& thread,
                                             const bool deleteSourceWhenDeleted,
@@ -71,6 +77,9 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
         bufferValidStart = 0;
         bufferValidEnd = 0;
 
+        for (int i = cuePoints.size(); --i >= 0;)
+            cuePoints.getObjectPointerUnchecked (i)->numValid = 0;
+
         backgroundThread.addTimeSliceClient (this);
 
         while (bufferValidEnd - bufferValidStart < jmin (((int) newSampleRate) / 4,
@@ -98,6 +107,14 @@ void BufferingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info
     const int validStart = (int) (jlimit (bufferValidStart, bufferValidEnd, nextPlayPos) - nextPlayPos);
     const int validEnd   = (int) (jlimit (bufferValidStart, bufferValidEnd, nextPlayPos + info.numSamples) - nextPlayPos);
 
+    // if the main buffer can't supply the whole block (e.g. just after a jump), one of the
+    // cue points may be able to
+    if ((validStart > 0 || validEnd < info.numSamples) && copyFromCuePoint (info))
+    {
+        nextPlayPos += info.numSamples;
+        return;
+    }
+
     if (validStart == validEnd)
     {
         // total cache miss
@@ -164,6 +181,155 @@ void BufferingAudioSource::setNextReadPosition (int64 newPosition)
     backgroundThread.moveToFrontOfQueue (this);
 }
 
+//==============================================================================
+void BufferingAudioSource::addCuePoint (const int64 position)
+{
+    addCuePoint (position, false);
+}
+
+void BufferingAudioSource::prefetchRegion (const int64 position)
+{
+    addCuePoint (position, true);
+}
+
+void BufferingAudioSource::addCuePoint (const int64 position, const bool temporary)
+{
+    CuePoint::Ptr newCue;
+
+    {
+        const ScopedLock sl (bufferStartPosLock);
+
+        for (int i = cuePoints.size(); --i >= 0;)
+        {
+            CuePoint* const c = cuePoints.getObjectPointerUnchecked (i);
+
+            if (c->startPosition == position && (c->isTemporary == temporary || ! c->isTemporary))
+                return;
+        }
+    }
+
+    // (the buffer is allocated here rather than while holding the lock that the audio thread uses)
+    newCue = new CuePoint (position, numberOfChannels, numberOfSamplesToBuffer, temporary);
+
+    {
+        const ScopedLock sl (bufferStartPosLock);
+
+        if (temporary)
+            for (int i = cuePoints.size(); --i >= 0;)
+                if (cuePoints.getObjectPointerUnchecked (i)->isTemporary)
+                    cuePoints.remove (i);
+
+        cuePoints.add (newCue);
+    }
+
+    backgroundThread.moveToFrontOfQueue (this);
+}
+
+void BufferingAudioSource::removeCuePoint (const int64 position)
+{
+    CuePoint::Ptr removed;   // (deleted after the lock is released)
+
+    const ScopedLock sl (bufferStartPosLock);
+
+    for (int i = cuePoints.size(); --i >= 0;)
+    {
+        CuePoint* const c = cuePoints.getObjectPointerUnchecked (i);
+
+        if (c->startPosition == position && ! c->isTemporary)
+        {
+            removed = c;
+            cuePoints.remove (i);
+        }
+    }
+}
+
+void BufferingAudioSource::clearCuePoints()
+{
+    ReferenceCountedArray<CuePoint> removed;   // (deleted after the lock is released)
+
+    const ScopedLock sl (bufferStartPosLock);
+    removed.swapWith (cuePoints);
+}
+
+int BufferingAudioSource::getMinSamplesNeededToStart() const noexcept
+{
+    return jmax (1, jmin ((int) sampleRate / 4, numberOfSamplesToBuffer / 2));
+}
+
+bool BufferingAudioSource::isReadyToPlayFrom (const int64 position) const
+{
+    const ScopedLock sl (bufferStartPosLock);
+    const int minSamples = getMinSamplesNeededToStart();
+
+    if (position >= bufferValidStart && bufferValidEnd - position >= minSamples)
+        return true;
+
+    for (int i = cuePoints.size(); --i >= 0;)
+    {
+        const CuePoint* const c = cuePoints.getObjectPointerUnchecked (i);
+
+        if (position >= c->startPosition && c->startPosition + c->numValid - position >= minSamples)
+            return true;
+    }
+
+    return false;
+}
+
+bool BufferingAudioSource::copyFromCuePoint (const AudioSourceChannelInfo& info)
+{
+    for (int i = cuePoints.size(); --i >= 0;)
+    {
+        const CuePoint* const c = cuePoints.getObjectPointerUnchecked (i);
+
+        if (nextPlayPos >= c->startPosition && nextPlayPos + info.numSamples <= c->startPosition + c->numValid)
+        {
+            const int offset = (int) (nextPlayPos - c->startPosition);
+
+            for (int chan = jmin (numberOfChannels, info.buffer->getNumChannels()); --chan >= 0;)
+                info.buffer->copyFrom (chan, info.startSample, c->data, chan, offset, info.numSamples);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Reads the next chunk into the first cue point that isn't full yet. A region that's been
+// prefetched for a pending jump is urgent until it holds enough to start playing from, and
+// is read before the main buffer; the others are only filled once the main buffer is full.
+bool BufferingAudioSource::readNextCuePointChunk (const bool onlyUrgentOnes)
+{
+    CuePoint::Ptr cue;
+
+    {
+        const ScopedLock sl (bufferStartPosLock);
+        const int minSamples = getMinSamplesNeededToStart();
+
+        for (int i = 0; i < cuePoints.size(); ++i)
+        {
+            CuePoint* const c = cuePoints.getObjectPointerUnchecked (i);
+
+            if (c->numValid < (onlyUrgentOnes ? (c->isTemporary ? minSamples : 0)
+                                              : c->data.getNumSamples()))
+            {
+                cue = c;
+                break;
+            }
+        }
+    }
+
+    if (cue == nullptr)
+        return false;
+
+    const int numToRead = jmin (2048, cue->data.getNumSamples() - cue->numValid);
+    readSection (cue->data, cue->startPosition + cue->numValid, numToRead, cue->numValid);
+
+    const ScopedLock sl (bufferStartPosLock);
+    cue->numValid = cue->numValid + numToRead;
+    return true;
+}
+
 bool BufferingAudioSource::readNextBufferChunk()
 {
     int64 newBVS, newBVE, sectionToReadStart, sectionToReadEnd;
@@ -245,15 +411,22 @@ bool BufferingAudioSource::readNextBufferChunk()
 }
 
 void BufferingAudioSource::readBufferSection (const int64 start, const int length, const int bufferOffset)
+{
+    readSection (buffer, start, length, bufferOffset);
+}
+
+void BufferingAudioSource::readSection (AudioSampleBuffer& dest, const int64 start, const int length, const int bufferOffset)
 {
     if (source->getNextReadPosition() != start)
         source->setNextReadPosition (start);
 
-    AudioSourceChannelInfo info (&buffer, bufferOffset, length);
+    AudioSourceChannelInfo info (&dest, bufferOffset, length);
     source->getNextAudioBlock (info);
 }
 
 int BufferingAudioSource::useTimeSlice()
 {
-    return readNextBufferChunk() ? 1 : 100;
+    return (readNextCuePointChunk (true)
+             || readNextBufferChunk()
+             || readNextCuePointChunk (false)) ? 1 : 100;
 }
@@ -89,8 +89,52 @@ public:
     /** Implements the PositionableAudioSource method. */
     bool isLooping() const override             { return source->isLooping(); }
 
+    //==============================================================================
+    /** Starts reading the source at the given position into a separate buffer, so that
+        a later jump to that position can start playing straight away, rather than
+        waiting for the main buffer to refill.
+
+        Each cue point holds as many samples as the main read-ahead buffer, and they're
+        filled in the background when the main buffer doesn't need any more data. They
+        stay until removed.
+
+        @see removeCuePoint, prefetchRegion, isReadyToPlayFrom
+    */
+    void addCuePoint (int64 position);
+
+    /** Removes a cue point that was added with addCuePoint(). */
+    void removeCuePoint (int64 position);
+
+    /** Removes all the cue points, including any region requested with prefetchRegion(). */
+    void clearCuePoints();
+
+    /** Like addCuePoint(), but only one of these regions is kept at a time, so each call
+        replaces the region requested by the previous one. This is intended for seeking,
+        where the region is only needed until the main buffer has caught up, so until it
+        holds enough to start playing from, it's read in preference to the main buffer.
+    */
+    void prefetchRegion (int64 position);
+
+    /** Returns true if playback could start at this position without a gap, i.e. if either
+        the main buffer or one of the cue points already holds a good amount of the data
+        that follows it.
+    */
+    bool isReadyToPlayFrom (int64 position) const;
+
 private:
     //==============================================================================
+    struct CuePoint  : public ReferenceCountedObject
+    {
+        CuePoint (int64 start, int numChannels, int numSamples, bool temporary);
+
+        typedef ReferenceCountedObjectPtr<CuePoint> Ptr;
+
+        const int64 startPosition;
+        AudioSampleBuffer data;
+        int volatile numValid;
+        const bool isTemporary;
+    };
+
     OptionalScopedPointer<PositionableAudioSource> source;
     TimeSliceThread& backgroundThread;
     int numberOfSamplesToBuffer, numberOfChannels;
@@ -99,9 +143,15 @@ private:
     int64 volatile bufferValidStart, bufferValidEnd, nextPlayPos;
     double volatile sampleRate;
     bool wasSourceLooping, isPrepared;
+    ReferenceCountedArray<CuePoint> cuePoints;
 
     bool readNextBufferChunk();
+    bool readNextCuePointChunk (bool onlyUrgentOnes);
     void readBufferSection (int64 start, int length, int bufferOffset);
+    void readSection (AudioSampleBuffer&, int64 start, int length, int bufferOffset);
+    void addCuePoint (int64 position, bool temporary);
+    bool copyFromCuePoint (const AudioSourceChannelInfo&);
+    int getMinSamplesNeededToStart() const noexcept;
     int useTimeSlice() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BufferingAudioSource)
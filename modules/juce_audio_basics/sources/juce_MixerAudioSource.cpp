@@ -22,26 +22,210 @@
   ==============================================================================
 */
 
+struct MixerAudioSource::Input
+{
+    Input (AudioSource* s, bool shouldDelete) noexcept
+        : source (s), deleteWhenRemoved (shouldDelete), targetGain (1.0f), currentGain (1.0f)
+    {}
+
+    // Renders straight into the destination, replacing its contents
+    void render (const AudioSourceChannelInfo& info)
+    {
+        source->getNextAudioBlock (info);
+
+        const float startGain = currentGain;
+        currentGain = targetGain.get();
+
+        if (startGain != 1.0f || currentGain != 1.0f)
+            info.buffer->applyGainRamp (info.startSample, info.numSamples, startGain, currentGain);
+    }
+
+    // Renders into a temporary buffer, and adds that to the destination
+    void addTo (AudioSampleBuffer& dest, const int destStartSample, const int numSamples, AudioSampleBuffer& temp)
+    {
+        AudioSourceChannelInfo info (&temp, 0, numSamples);
+        source->getNextAudioBlock (info);
+
+        const float startGain = currentGain;
+        currentGain = targetGain.get();
+
+        for (int chan = 0; chan < dest.getNumChannels(); ++chan)
+            dest.addFromWithRamp (chan, destStartSample, temp.getReadPointer (chan), numSamples, startGain, currentGain);
+    }
+
+    AudioSource* const source;
+    const bool deleteWhenRemoved;
+    Atomic<float> targetGain;
+    float currentGain; // (only used by the thread that's rendering this input)
+
+    JUCE_DECLARE_NON_COPYABLE (Input)
+};
+
+// A snapshot of the inputs that the audio thread uses. Once it has been published, it's
+// never modified - changes are made by publishing a new one.
+struct MixerAudioSource::InputList
+{
+    Array<Input*> inputs;
+    RenderingThreadPool* threadPool;
+};
+
+//==============================================================================
+class MixerAudioSource::RenderingThreadPool  : private RealtimeThreadGroup::Job
+{
+public:
+    RenderingThreadPool (const int numWorkers)
+        : threads ("Mixer rendering", numWorkers),
+          inputList (nullptr), outputInfo (nullptr), callerTemp (nullptr), callerHasRendered (false)
+    {
+        for (int i = 0; i < numWorkers; ++i)
+            workerBuffers.add (new WorkerBuffers());
+    }
+
+    void render (Input* const* const inputsToRender, const int numInputs,
+                 const AudioSourceChannelInfo& info, AudioSampleBuffer& temp)
+    {
+        const int numChannels = info.buffer->getNumChannels();
+
+        for (int i = 0; i < workerBuffers.size(); ++i)
+            workerBuffers.getUnchecked (i)->prepare (numChannels, info.numSamples);
+
+        inputList = inputsToRender;
+        outputInfo = &info;
+        callerTemp = &temp;
+        callerHasRendered = false;
+
+        // The first input that this thread picks up is rendered straight into the output,
+        // and the workers mix theirs into their scratch buffers
+        threads.perform (*this, numInputs);
+
+        if (! callerHasRendered)
+            info.clearActiveBufferRegion();
+
+        for (int i = 0; i < workerBuffers.size(); ++i)
+        {
+            const WorkerBuffers& w = *workerBuffers.getUnchecked (i);
+
+            if (w.hasRendered)
+                for (int chan = 0; chan < numChannels; ++chan)
+                    info.buffer->addFrom (chan, info.startSample, w.scratch, chan, 0, info.numSamples);
+        }
+    }
+
+private:
+    //==============================================================================
+    struct WorkerBuffers
+    {
+        WorkerBuffers() : hasRendered (false) {}
+
+        void prepare (const int numChannels, const int numSamples)
+        {
+            scratch.setSize (numChannels, numSamples, false, false, true);
+            temp.setSize (jmax (1, numChannels), numSamples, false, false, true);
+            hasRendered = false;
+        }
+
+        AudioSampleBuffer scratch, temp;
+        bool hasRendered;
+
+        JUCE_DECLARE_NON_COPYABLE (WorkerBuffers)
+    };
+
+    OwnedArray<WorkerBuffers> workerBuffers;
+    RealtimeThreadGroup threads;
+    Input* const* inputList;
+    const AudioSourceChannelInfo* outputInfo;
+    AudioSampleBuffer* callerTemp;
+    bool callerHasRendered;
+
+    void performItem (const int inputIndex, const int threadIndex) override
+    {
+        Input* const input = inputList[inputIndex];
+
+        if (threadIndex == 0)
+        {
+            if (callerHasRendered)
+            {
+                input->addTo (*outputInfo->buffer, outputInfo->startSample, outputInfo->numSamples, *callerTemp);
+            }
+            else
+            {
+                input->render (*outputInfo);
+                callerHasRendered = true;
+            }
+
+            return;
+        }
+
+        WorkerBuffers& w = *workerBuffers.getUnchecked (threadIndex - 1);
+
+        if (! w.hasRendered)
+        {
+            w.scratch.clear();
+            w.hasRendered = true;
+        }
+
+        input->addTo (w.scratch, 0, outputInfo->numSamples, w.temp);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (RenderingThreadPool)
+};
+
+//==============================================================================
 MixerAudioSource::MixerAudioSource()
-   : currentSampleRate (0.0), bufferSizeExpected (0)
+   : currentSampleRate (0.0), bufferSizeExpected (0), numRenderingThreads (1)
 {
 }
 
 MixerAudioSource::~MixerAudioSource()
 {
     removeAllInputs();
+
+    const ScopedLock sl (lock);
+    renderingThreadPool = nullptr;
+    delete currentList.exchange (nullptr);
 }
 
 //==============================================================================
+int MixerAudioSource::indexOfInput (AudioSource* const source) const noexcept
+{
+    for (int i = inputs.size(); --i >= 0;)
+        if (inputs.getUnchecked (i)->source == source)
+            return i;
+
+    return -1;
+}
+
+// This must be called with the lock held. When it returns, the audio thread is no longer
+// using the previous list, so anything that only that list referred to can be deleted.
+void MixerAudioSource::publishInputList()
+{
+    InputList* const newList = new InputList();
+    newList->inputs.ensureStorageAllocated (inputs.size());
+
+    for (int i = 0; i < inputs.size(); ++i)
+        newList->inputs.add (inputs.getUnchecked (i));
+
+    newList->threadPool = renderingThreadPool;
+
+    const ScopedPointer<InputList> oldList (currentList.exchange (newList));
+
+    while (oldList != nullptr && listInUse.get() == oldList)
+        Thread::sleep (1);
+}
+
 void MixerAudioSource::addInputSource (AudioSource* input, const bool deleteWhenRemoved)
 {
-    if (input != nullptr && ! inputs.contains (input))
+    if (input != nullptr)
     {
         double localRate;
         int localBufferSize;
 
         {
             const ScopedLock sl (lock);
+
+            if (indexOfInput (input) >= 0)
+                return;
+
             localRate = currentSampleRate;
             localBufferSize = bufferSizeExpected;
         }
@@ -51,8 +235,8 @@ void MixerAudioSource::addInputSource (AudioSource* input, const bool deleteWhen
 
         const ScopedLock sl (lock);
 
-        inputsToDelete.setBit (inputs.size(), deleteWhenRemoved);
-        inputs.add (input);
+        inputs.add (new Input (input, deleteWhenRemoved));
+        publishInputList();
     }
 }
 
@@ -64,16 +248,17 @@ void MixerAudioSource::removeInputSource (AudioSource* const input)
 
         {
             const ScopedLock sl (lock);
-            const int index = inputs.indexOf (input);
+            const int index = indexOfInput (input);
 
             if (index < 0)
                 return;
 
-            if (inputsToDelete [index])
+            const ScopedPointer<Input> removed (inputs.removeAndReturn (index));
+
+            if (removed->deleteWhenRemoved)
                 toDelete = input;
 
-            inputsToDelete.shiftBits (-1, index);
-            inputs.remove (index);
+            publishInputList();
         }
 
         input->releaseResources();
@@ -83,21 +268,67 @@ void MixerAudioSource::removeInputSource (AudioSource* const input)
 void MixerAudioSource::removeAllInputs()
 {
     OwnedArray<AudioSource> toDelete;
+    Array<AudioSource*> toRelease;
 
     {
         const ScopedLock sl (lock);
 
-        for (int i = inputs.size(); --i >= 0;)
-            if (inputsToDelete[i])
-                toDelete.add (inputs.getUnchecked(i));
+        OwnedArray<Input> removed;
+        removed.swapWith (inputs);
+        publishInputList();
 
-        inputs.clear();
+        for (int i = removed.size(); --i >= 0;)
+        {
+            Input* const in = removed.getUnchecked (i);
+            toRelease.add (in->source);
+
+            if (in->deleteWhenRemoved)
+                toDelete.add (in->source);
+        }
     }
 
-    for (int i = toDelete.size(); --i >= 0;)
-        toDelete.getUnchecked(i)->releaseResources();
+    for (int i = toRelease.size(); --i >= 0;)
+        toRelease.getUnchecked (i)->releaseResources();
+}
+
+//==============================================================================
+void MixerAudioSource::setInputGain (AudioSource* const input, const float newGain)
+{
+    const ScopedLock sl (lock);
+    const int index = indexOfInput (input);
+
+    if (index >= 0)
+        inputs.getUnchecked (index)->targetGain = newGain;
+}
+
+float MixerAudioSource::getInputGain (AudioSource* const input) const
+{
+    const ScopedLock sl (lock);
+    const int index = indexOfInput (input);
+
+    return index >= 0 ? inputs.getUnchecked (index)->targetGain.get() : 0.0f;
+}
+
+void MixerAudioSource::setNumRenderingThreads (const int numThreads)
+{
+    const ScopedLock sl (lock);
+
+    const int newNumThreads = jmax (1, numThreads);
+
+    if (newNumThreads != numRenderingThreads)
+    {
+        numRenderingThreads = newNumThreads;
+
+        ScopedPointer<RenderingThreadPool> oldPool (renderingThreadPool.release());
+
+        if (newNumThreads > 1)
+            renderingThreadPool = new RenderingThreadPool (newNumThreads - 1);
+
+        publishInputList();
+    }
 }
 
+//==============================================================================
 void MixerAudioSource::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
 {
     tempBuffer.setSize (2, samplesPerBlockExpected);
@@ -108,7 +339,7 @@ void MixerAudioSource::prepareToPlay (int samplesPerBlockExpected, double sample
     bufferSizeExpected = samplesPerBlockExpected;
 
     for (int i = inputs.size(); --i >= 0;)
-        inputs.getUnchecked(i)->prepareToPlay (samplesPerBlockExpected, sampleRate);
+        inputs.getUnchecked(i)->source->prepareToPlay (samplesPerBlockExpected, sampleRate);
 }
 
 void MixerAudioSource::releaseResources()
@@ -116,7 +347,7 @@ void MixerAudioSource::releaseResources()
     const ScopedLock sl (lock);
 
     for (int i = inputs.size(); --i >= 0;)
-        inputs.getUnchecked(i)->releaseResources();
+        inputs.getUnchecked(i)->source->releaseResources();
 
     tempBuffer.setSize (2, 0);
 
@@ -126,30 +357,43 @@ void MixerAudioSource::releaseResources()
 
 void MixerAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
 {
-    const ScopedLock sl (lock);
+    // Mark the list as being in use, making sure that it wasn't replaced before the mark
+    // was visible, so that the thread replacing it will wait for this callback to finish.
+    InputList* list;
 
-    if (inputs.size() > 0)
+    do
     {
-        inputs.getUnchecked(0)->getNextAudioBlock (info);
+        list = currentList.get();
+        listInUse = list;
+    }
+    while (list != currentList.get());
 
-        if (inputs.size() > 1)
-        {
-            tempBuffer.setSize (jmax (1, info.buffer->getNumChannels()),
-                                info.buffer->getNumSamples());
+    const int numInputs = list != nullptr ? list->inputs.size() : 0;
 
-            AudioSourceChannelInfo info2 (&tempBuffer, 0, info.numSamples);
+    if (numInputs > 0)
+    {
+        Input* const* const in = list->inputs.begin();
 
-            for (int i = 1; i < inputs.size(); ++i)
-            {
-                inputs.getUnchecked(i)->getNextAudioBlock (info2);
+        if (numInputs > 1)
+            tempBuffer.setSize (jmax (1, info.buffer->getNumChannels()),
+                                info.buffer->getNumSamples(), false, false, true);
 
-                for (int chan = 0; chan < info.buffer->getNumChannels(); ++chan)
-                    info.buffer->addFrom (chan, info.startSample, tempBuffer, chan, 0, info.numSamples);
-            }
+        if (numInputs > 1 && list->threadPool != nullptr)
+        {
+            list->threadPool->render (in, numInputs, info, tempBuffer);
+        }
+        else
+        {
+            in[0]->render (info);
+
+            for (int i = 1; i < numInputs; ++i)
+                in[i]->addTo (*info.buffer, info.startSample, info.numSamples, tempBuffer);
         }
     }
     else
     {
         info.clearActiveBufferRegion();
     }
+
+    listInUse = nullptr;
 }
@@ -33,6 +33,15 @@
     Input sources can be added and removed while the mixer is running as long as their
     prepareToPlay() and releaseResources() methods are called before and after adding
     them to the mixer.
+
+    The audio thread never takes a lock: the mixer keeps an immutable snapshot of its
+    inputs, and adding or removing an input swaps in a new snapshot. The old one (and
+    any source that was removed) is only released once the audio thread has finished
+    any callback that was using it, so these methods may block for the length of one
+    audio callback. Only one thread should call getNextAudioBlock() at a time.
+
+    Each input has a gain, which is ramped smoothly when it changes, and the inputs can
+    optionally be rendered on a set of worker threads - see setNumRenderingThreads().
 */
 class JUCE_API  MixerAudioSource  : public AudioSource
 {
@@ -70,6 +79,36 @@ public:
     */
     void removeAllInputs();
 
+    //==============================================================================
+    /** Changes the gain that is applied to one of the inputs.
+        The gain of a newly-added input is 1.0. When it changes, the mixer ramps from
+        the old gain to the new one over the course of the next block, so this can be
+        called from any thread while the mixer is running without causing clicks.
+    */
+    void setInputGain (AudioSource* input, float newGain);
+
+    /** Returns the gain that is being applied to one of the inputs.
+        If the source isn't one of the mixer's inputs, this returns 0.
+    */
+    float getInputGain (AudioSource* input) const;
+
+    //==============================================================================
+    /** Sets the number of threads that are used to render the inputs.
+
+        By default this is 1, and all the inputs are rendered on the audio thread. If you
+        set it to more than that, a pool of (numThreads - 1) worker threads is created, and
+        the inputs are shared out between these and the audio thread. This is only worth
+        doing if the inputs are expensive to render (e.g. chains of ResamplingAudioSources),
+        and their getNextAudioBlock() methods must be safe to call at the same time as each
+        other.
+    */
+    void setNumRenderingThreads (int numThreads);
+
+    /** Returns the number of threads that are used for rendering.
+        @see setNumRenderingThreads
+    */
+    int getNumRenderingThreads() const noexcept                 { return numRenderingThreads; }
+
     //==============================================================================
     /** Implementation of the AudioSource method.
         This will call prepareToPlay() on all its input sources.
@@ -87,12 +126,21 @@ public:
 
 private:
     //==============================================================================
-    Array<AudioSource*> inputs;
-    BigInteger inputsToDelete;
+    struct Input;
+    struct InputList;
+    class RenderingThreadPool;
+    friend class RenderingThreadPool;
+
+    OwnedArray<Input> inputs;
+    ScopedPointer<RenderingThreadPool> renderingThreadPool;
+    Atomic<InputList*> currentList, listInUse;
     CriticalSection lock;
     AudioSampleBuffer tempBuffer;
     double currentSampleRate;
-    int bufferSizeExpected;
+    int bufferSizeExpected, numRenderingThreads;
+
+    int indexOfInput (AudioSource*) const noexcept;
+    void publishInputList();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MixerAudioSource)
 };
@@ -31,7 +31,9 @@ ResamplingAudioSource::ResamplingAudioSource (AudioSource* const inputSource,
       bufferPos (0),
       sampsInBuffer (0),
       subSampleOffset (0),
-      numChannels (channels)
+      numChannels (channels),
+      useSinc (false),
+      sincQuality (SincResampler::normalQuality)
 {
     jassert (input != nullptr);
     zeromem (coefficients, sizeof (coefficients));
@@ -61,6 +63,12 @@ void ResamplingAudioSource::prepareToPlay (int samplesPerBlockExpected, double s
     destBuffers.calloc ((size_t) numChannels);
     createLowPass (ratio);
 
+    sincResamplers.clear();
+
+    if (useSinc)
+        for (int i = 0; i < numChannels; ++i)
+            sincResamplers.add (new SincResampler (sincQuality, jmax (4.0, ratio)));
+
     flushBuffers();
 }
 
@@ -71,12 +79,22 @@ void ResamplingAudioSource::flushBuffers()
     sampsInBuffer = 0;
     subSampleOffset = 0.0;
     resetFilters();
+
+    for (int i = sincResamplers.size(); --i >= 0;)
+        sincResamplers.getUnchecked(i)->reset();
+}
+
+void ResamplingAudioSource::setUseSincInterpolation (const bool shouldUseSinc, const SincResampler::Quality quality)
+{
+    useSinc = shouldUseSinc;
+    sincQuality = quality;
 }
 
 void ResamplingAudioSource::releaseResources()
 {
     input->releaseResources();
     buffer.setSize (numChannels, 0);
+    sincResamplers.clear();
 }
 
 void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
@@ -88,6 +106,12 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
         localRatio = ratio;
     }
 
+    if (sincResamplers.size() > 0)
+    {
+        getNextSincBlock (info, localRatio);
+        return;
+    }
+
     if (lastRatio != localRatio)
     {
         createLowPass (localRatio);
@@ -195,6 +219,39 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
     jassert (sampsInBuffer >= 0);
 }
 
+void ResamplingAudioSource::getNextSincBlock (const AudioSourceChannelInfo& info, const double localRatio)
+{
+    // In this mode, the buffer isn't circular: it holds the input samples that the
+    // resamplers haven't used yet, starting at index 0.
+    const int sampsNeeded = (int) std::ceil (info.numSamples * localRatio) + 1;
+
+    if (buffer.getNumSamples() < sampsNeeded)
+        buffer.setSize (buffer.getNumChannels(), sampsNeeded + 32, true, true);
+
+    if (sampsInBuffer < sampsNeeded)
+    {
+        AudioSourceChannelInfo readInfo (&buffer, sampsInBuffer, sampsNeeded - sampsInBuffer);
+        input->getNextAudioBlock (readInfo);
+        sampsInBuffer = sampsNeeded;
+    }
+
+    const int channelsToProcess = jmin (numChannels, info.buffer->getNumChannels());
+    int numUsed = 0;
+
+    for (int channel = 0; channel < channelsToProcess; ++channel)
+        numUsed = sincResamplers.getUnchecked (channel)->process (localRatio, buffer.getReadPointer (channel),
+                                                                  info.buffer->getWritePointer (channel, info.startSample),
+                                                                  info.numSamples);
+
+    jassert (numUsed <= sampsInBuffer);
+    sampsInBuffer -= numUsed;
+
+    if (numUsed > 0 && sampsInBuffer > 0)
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            memmove (buffer.getWritePointer (channel), buffer.getReadPointer (channel, numUsed),
+                     (size_t) sampsInBuffer * sizeof (float));
+}
+
 void ResamplingAudioSource::createLowPass (const double frequencyRatio)
 {
     const double proportionalRate = (frequencyRatio > 1.0) ? 0.5 / frequencyRatio
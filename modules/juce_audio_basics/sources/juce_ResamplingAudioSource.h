@@ -69,6 +69,19 @@ public:
     /** Clears any buffers and filters that the resampler is using. */
     void flushBuffers();
 
+    /** Chooses whether to use a SincResampler for each channel, rather than the
+        default linear interpolation and IIR filtering.
+
+        The sinc filter is far more expensive, but is good enough for mastering-grade
+        sample-rate conversion, e.g. when converting files offline. It also delays the
+        signal by the resampler's latency (SincResampler::getLatencyInSamples()), measured
+        in input samples.
+
+        This must be called before prepareToPlay().
+    */
+    void setUseSincInterpolation (bool shouldUseSinc,
+                                  SincResampler::Quality quality = SincResampler::normalQuality);
+
     //==============================================================================
     void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
     void releaseResources() override;
@@ -98,6 +111,11 @@ private:
     HeapBlock<FilterState> filterStates;
     void resetFilters();
 
+    bool useSinc;
+    SincResampler::Quality sincQuality;
+    OwnedArray<SincResampler> sincResamplers;
+    void getNextSincBlock (const AudioSourceChannelInfo&, double localRatio);
+
     void applyFilter (float* samples, int num, FilterState& fs);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResamplingAudioSource)
@@ -48,18 +48,17 @@ void ReverbAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& bufferT
 
     if (! bypass)
     {
-        float* const firstChannel = bufferToFill.buffer->getWritePointer (0, bufferToFill.startSample);
-
-        if (bufferToFill.buffer->getNumChannels() > 1)
-        {
-            reverb.processStereo (firstChannel,
-                                  bufferToFill.buffer->getWritePointer (1, bufferToFill.startSample),
-                                  bufferToFill.numSamples);
-        }
-        else
-        {
-            reverb.processMono (firstChannel, bufferToFill.numSamples);
-        }
+        const int numChannels = bufferToFill.buffer->getNumChannels();
+
+        if (numChannels > reverb.getNumChannels())
+            reverb.setNumChannels (numChannels);
+
+        float** const channels = static_cast<float**> (alloca (sizeof (float*) * (size_t) jmax (1, numChannels)));
+
+        for (int i = 0; i < numChannels; ++i)
+            channels[i] = bufferToFill.buffer->getWritePointer (i, bufferToFill.startSample);
+
+        reverb.processSamples (channels, numChannels, bufferToFill.numSamples);
     }
 }
 
@@ -30,7 +30,10 @@
 /**
     An AudioSource that uses the Reverb class to apply a reverb to another AudioSource.
 
-    @see Reverb
+    Pairs of channels are given a stereo reverb, and if there's an odd number of channels,
+    the last one is given a mono reverb.
+
+    @see Reverb, MultiChannelReverb
 */
 class JUCE_API  ReverbAudioSource   : public AudioSource
 {
@@ -66,7 +69,7 @@ private:
     //==============================================================================
     CriticalSection lock;
     OptionalScopedPointer<AudioSource> input;
-    Reverb reverb;
+    MultiChannelReverb reverb;
     volatile bool bypass;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReverbAudioSource)
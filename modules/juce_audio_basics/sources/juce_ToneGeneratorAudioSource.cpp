@@ -25,9 +25,10 @@
 ToneGeneratorAudioSource::ToneGeneratorAudioSource()
     : frequency (1000.0),
       sampleRate (44100.0),
-      currentPhase (0.0),
-      phasePerSample (0.0),
-      amplitude (0.5f)
+      phasorReal (1.0), phasorImag (0.0),
+      rotationReal (1.0), rotationImag (0.0),
+      amplitude (0.5f),
+      needsNewRotation (true)
 {
 }
 
@@ -44,14 +45,15 @@ void ToneGeneratorAudioSource::setAmplitude (const float newAmplitude)
 void ToneGeneratorAudioSource::setFrequency (const double newFrequencyHz)
 {
     frequency = newFrequencyHz;
-    phasePerSample = 0.0;
+    needsNewRotation = true;
 }
 
 //==============================================================================
 void ToneGeneratorAudioSource::prepareToPlay (int /*samplesPerBlockExpected*/, double rate)
 {
-    currentPhase = 0.0;
-    phasePerSample = 0.0;
+    phasorReal = 1.0;
+    phasorImag = 0.0;
+    needsNewRotation = true;
     sampleRate = rate;
 }
 
@@ -61,15 +63,35 @@ void ToneGeneratorAudioSource::releaseResources()
 
 void ToneGeneratorAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
 {
-    if (phasePerSample == 0.0)
-        phasePerSample = double_Pi * 2.0 / (sampleRate / frequency);
+    if (info.buffer->getNumChannels() == 0)
+        return;
+
+    if (needsNewRotation)
+    {
+        const double phasePerSample = double_Pi * 2.0 / (sampleRate / frequency);
+        rotationReal = std::cos (phasePerSample);
+        rotationImag = std::sin (phasePerSample);
+        needsNewRotation = false;
+    }
+
+    // Rather than calling sin() for each sample, the phasor is rotated by a complex
+    // multiplication, and its imaginary part is the output.
+    float* const dest = info.buffer->getWritePointer (0, info.startSample);
 
     for (int i = 0; i < info.numSamples; ++i)
     {
-        const float sample = amplitude * (float) std::sin (currentPhase);
-        currentPhase += phasePerSample;
+        dest[i] = amplitude * (float) phasorImag;
 
-        for (int j = info.buffer->getNumChannels(); --j >= 0;)
-            info.buffer->setSample (j, info.startSample + i, sample);
+        const double newReal = phasorReal * rotationReal - phasorImag * rotationImag;
+        phasorImag = phasorReal * rotationImag + phasorImag * rotationReal;
+        phasorReal = newReal;
     }
+
+    // stop rounding errors from slowly changing the phasor's magnitude
+    const double correction = 1.5 - 0.5 * (phasorReal * phasorReal + phasorImag * phasorImag);
+    phasorReal *= correction;
+    phasorImag *= correction;
+
+    for (int j = info.buffer->getNumChannels(); --j > 0;)
+        info.buffer->copyFrom (j, info.startSample, dest, info.numSamples);
 }
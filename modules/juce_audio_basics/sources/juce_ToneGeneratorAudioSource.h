@@ -63,8 +63,9 @@ public:
 private:
     //==============================================================================
     double frequency, sampleRate;
-    double currentPhase, phasePerSample;
+    double phasorReal, phasorImag, rotationReal, rotationImag;
     float amplitude;
+    bool needsNewRotation;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ToneGeneratorAudioSource)
 };
@@ -0,0 +1,282 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+namespace SineOscillatorBankHelpers
+{
+    // A plain version of the FloatVectorHelpers ops, for builds without SSE or NEON.
+    struct ScalarOps32
+    {
+        typedef float Type;
+        struct ParallelType  { float v[4]; };
+        enum { numParallel = 4 };
+
+        static forcedinline ParallelType load1 (Type v) noexcept                        { ParallelType r = { { v, v, v, v } }; return r; }
+        static forcedinline ParallelType loadU (const Type* v) noexcept                 { ParallelType r = { { v[0], v[1], v[2], v[3] } }; return r; }
+        static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { for (int i = 0; i < 4; ++i) dest[i] = a.v[i]; }
+
+        static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { for (int i = 0; i < 4; ++i) a.v[i] += b.v[i]; return a; }
+        static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { for (int i = 0; i < 4; ++i) a.v[i] -= b.v[i]; return a; }
+        static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { for (int i = 0; i < 4; ++i) a.v[i] *= b.v[i]; return a; }
+    };
+
+    enum { samplesPerChunk = 256 };
+
+    /*  Renders a chunk of samples for a group of 4 partials, adding each partial's output
+        into its own lane of an interleaved 4-channel scratch buffer. Running each group
+        across the whole chunk keeps its state in registers, and means the lanes only need
+        to be summed once per sample at the end, rather than once per group.
+    */
+    template <typename Mode>
+    static void renderGroup (float* re, float* im, const float* rotRe, const float* rotIm,
+                             float* amp, const float* target, float* scratch,
+                             const int numSamples, const int numSamplesLeftInBlock) noexcept
+    {
+        typedef typename Mode::ParallelType Vec;
+
+        Vec r  = Mode::loadU (re),    i  = Mode::loadU (im);
+        Vec cr = Mode::loadU (rotRe), ci = Mode::loadU (rotIm);
+        Vec a  = Mode::loadU (amp);
+
+        const Vec t = Mode::loadU (target);
+        const Vec da = Mode::mul (Mode::sub (t, a), Mode::load1 (1.0f / (float) numSamplesLeftInBlock));
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float* const s = scratch + n * 4;
+            Mode::storeU (s, Mode::add (Mode::loadU (s), Mode::mul (a, i)));
+
+            const Vec newR = Mode::sub (Mode::mul (r, cr), Mode::mul (i, ci));
+            i = Mode::add (Mode::mul (r, ci), Mode::mul (i, cr));
+            r = newR;
+            a = Mode::add (a, da);
+        }
+
+        // Rounding errors make the phasors' magnitudes drift slowly, so they're pulled
+        // back to 1 with a first-order correction after each chunk.
+        const Vec mag = Mode::add (Mode::mul (r, r), Mode::mul (i, i));
+        const Vec correction = Mode::sub (Mode::load1 (1.5f), Mode::mul (Mode::load1 (0.5f), mag));
+
+        Mode::storeU (re, Mode::mul (r, correction));
+        Mode::storeU (im, Mode::mul (i, correction));
+        Mode::storeU (amp, numSamples == numSamplesLeftInBlock ? t : a);
+    }
+}
+
+//==============================================================================
+SineOscillatorBank::SineOscillatorBank()
+    : sampleRate (44100.0), numPartials (0), numPartialsAllocated (0)
+{
+}
+
+SineOscillatorBank::~SineOscillatorBank()
+{
+}
+
+void SineOscillatorBank::setSampleRate (const double newSampleRate)
+{
+    jassert (newSampleRate > 0);
+    sampleRate = newSampleRate;
+
+    for (int i = 0; i < numPartials; ++i)
+    {
+        updateRotation (i);
+        updateTargetAmplitude (i);
+    }
+}
+
+void SineOscillatorBank::setNumPartials (const int newNumPartials)
+{
+    jassert (newNumPartials >= 0);
+
+    const int newNumAllocated = (newNumPartials + 3) & ~3;
+
+    if (newNumAllocated != numPartialsAllocated)
+    {
+        HeapBlock<float>* const floatArrays[] = { &phasorReal, &phasorImag, &rotationReal, &rotationImag,
+                                                  &amplitudes, &targetAmplitudes, &requestedAmplitudes };
+
+        for (int i = 0; i < numElementsInArray (floatArrays); ++i)
+        {
+            floatArrays[i]->realloc ((size_t) newNumAllocated);
+
+            if (newNumAllocated > numPartialsAllocated)
+                zeromem (floatArrays[i]->getData() + numPartialsAllocated,
+                         sizeof (float) * (size_t) (newNumAllocated - numPartialsAllocated));
+        }
+
+        frequencies.realloc ((size_t) newNumAllocated);
+
+        for (int i = numPartialsAllocated; i < newNumAllocated; ++i)
+        {
+            frequencies[i] = 0;
+            phasorReal[i] = 1.0f;
+            rotationReal[i] = 1.0f;
+        }
+
+        numPartialsAllocated = newNumAllocated;
+    }
+
+    // Any padding partials beyond the end must stay silent
+    for (int i = newNumPartials; i < numPartialsAllocated; ++i)
+        amplitudes[i] = targetAmplitudes[i] = requestedAmplitudes[i] = 0;
+
+    numPartials = newNumPartials;
+}
+
+void SineOscillatorBank::setPartial (const int partialIndex, const double frequencyHz, const float amplitude) noexcept
+{
+    setPartialFrequency (partialIndex, frequencyHz);
+    setPartialAmplitude (partialIndex, amplitude);
+}
+
+void SineOscillatorBank::setPartialFrequency (const int partialIndex, const double frequencyHz) noexcept
+{
+    if (isPositiveAndBelow (partialIndex, numPartials))
+    {
+        frequencies[partialIndex] = frequencyHz;
+        updateRotation (partialIndex);
+        updateTargetAmplitude (partialIndex);
+    }
+    else
+    {
+        jassertfalse;
+    }
+}
+
+void SineOscillatorBank::setPartialAmplitude (const int partialIndex, const float amplitude) noexcept
+{
+    if (isPositiveAndBelow (partialIndex, numPartials))
+    {
+        requestedAmplitudes[partialIndex] = amplitude;
+        updateTargetAmplitude (partialIndex);
+    }
+    else
+    {
+        jassertfalse;
+    }
+}
+
+double SineOscillatorBank::getPartialFrequency (const int partialIndex) const noexcept
+{
+    return isPositiveAndBelow (partialIndex, numPartials) ? frequencies[partialIndex] : 0.0;
+}
+
+void SineOscillatorBank::updateRotation (const int i) noexcept
+{
+    const double angle = 2.0 * double_Pi * frequencies[i] / sampleRate;
+
+    rotationReal[i] = (float) std::cos (angle);
+    rotationImag[i] = (float) std::sin (angle);
+}
+
+void SineOscillatorBank::updateTargetAmplitude (const int i) noexcept
+{
+    targetAmplitudes[i] = std::abs (frequencies[i]) < sampleRate * 0.5 ? requestedAmplitudes[i] : 0.0f;
+}
+
+void SineOscillatorBank::reset (const double startPhase) noexcept
+{
+    const float re = (float) std::cos (startPhase);
+    const float im = (float) std::sin (startPhase);
+
+    for (int i = 0; i < numPartialsAllocated; ++i)
+    {
+        phasorReal[i] = re;
+        phasorImag[i] = im;
+        amplitudes[i] = targetAmplitudes[i];
+    }
+}
+
+//==============================================================================
+void SineOscillatorBank::renderChunk (float* const dest, const int numSamples, const int numSamplesLeftInBlock) noexcept
+{
+    using namespace SineOscillatorBankHelpers;
+    jassert (numSamples <= samplesPerChunk);
+
+    float scratch [samplesPerChunk * 4];
+    zeromem (scratch, sizeof (float) * (size_t) (numSamples * 4));
+
+    for (int i = 0; i < numPartialsAllocated; i += 4)
+    {
+       #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        #if JUCE_USE_SSE_INTRINSICS
+         if (FloatVectorHelpers::isSSE2Available())
+        #endif
+        {
+            renderGroup<FloatVectorHelpers::BasicOps32> (phasorReal + i, phasorImag + i, rotationReal + i, rotationImag + i,
+                                                         amplitudes + i, targetAmplitudes + i, scratch, numSamples, numSamplesLeftInBlock);
+            continue;
+        }
+       #endif
+
+        renderGroup<ScalarOps32> (phasorReal + i, phasorImag + i, rotationReal + i, rotationImag + i,
+                                  amplitudes + i, targetAmplitudes + i, scratch, numSamples, numSamplesLeftInBlock);
+    }
+
+    for (int n = 0; n < numSamples; ++n)
+    {
+        const float* const s = scratch + n * 4;
+        dest[n] += (s[0] + s[1]) + (s[2] + s[3]);
+    }
+}
+
+void SineOscillatorBank::render (float* destSamples, int numSamples) noexcept
+{
+    for (int numSamplesLeft = numSamples; numSamplesLeft > 0;)
+    {
+        const int numThisTime = jmin (numSamplesLeft, (int) SineOscillatorBankHelpers::samplesPerChunk);
+        renderChunk (destSamples, numThisTime, numSamplesLeft);
+
+        destSamples += numThisTime;
+        numSamplesLeft -= numThisTime;
+    }
+}
+
+void SineOscillatorBank::renderNextBlock (AudioSampleBuffer& outputBuffer, int startSample, int numSamples) noexcept
+{
+    const int numChannels = outputBuffer.getNumChannels();
+
+    if (numChannels == 1)
+    {
+        render (outputBuffer.getWritePointer (0, startSample), numSamples);
+        return;
+    }
+
+    float mono [SineOscillatorBankHelpers::samplesPerChunk];
+
+    for (int numSamplesLeft = numSamples; numSamplesLeft > 0;)
+    {
+        const int numThisTime = jmin (numSamplesLeft, (int) SineOscillatorBankHelpers::samplesPerChunk);
+
+        FloatVectorOperations::clear (mono, numThisTime);
+        renderChunk (mono, numThisTime, numSamplesLeft);
+
+        for (int i = 0; i < numChannels; ++i)
+            outputBuffer.addFrom (i, startSample, mono, numThisTime);
+
+        startSample += numThisTime;
+        numSamplesLeft -= numThisTime;
+    }
+}
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_SINEOSCILLATORBANK_H_INCLUDED
+#define JUCE_SINEOSCILLATORBANK_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Generates the sum of a large number of sine waves, each with its own frequency
+    and amplitude.
+
+    Rather than calling a sin() function for each sample, each partial is a phasor that's
+    rotated by a fixed complex multiplication per sample, and the partials are processed
+    four at a time with SIMD instructions where they're available. This makes it cheap
+    enough to run thousands of partials for additive synthesis, or to use as a bank of LFOs
+    or test tones.
+
+    Amplitude changes are ramped smoothly over the next block that's rendered, so that
+    partials can be re-tuned or faded while playing without clicks. Partials whose frequency
+    is above the Nyquist limit are silenced.
+
+    The render methods add to whatever's already in the destination, so a voice can call
+    renderNextBlock() directly from its SynthesiserVoice::renderNextBlock() method.
+
+    @see WavetableOscillator, ToneGeneratorAudioSource
+*/
+class JUCE_API  SineOscillatorBank
+{
+public:
+    //==============================================================================
+    /** Creates an empty bank. Call setSampleRate() and setNumPartials() before using it. */
+    SineOscillatorBank();
+
+    /** Destructor. */
+    ~SineOscillatorBank();
+
+    //==============================================================================
+    /** Sets the sample rate at which the partials will run.
+        If the partials already have frequencies set, they're re-tuned for the new rate.
+    */
+    void setSampleRate (double newSampleRate);
+
+    /** Changes the number of partials. This allocates memory, so shouldn't be called on the
+        audio thread. Any new partials start out silent, and existing ones are kept.
+    */
+    void setNumPartials (int newNumPartials);
+
+    /** Returns the number of partials. */
+    int getNumPartials() const noexcept                 { return numPartials; }
+
+    /** Sets the frequency and amplitude of one of the partials.
+        The amplitude will be ramped to its new value over the next block that gets rendered.
+    */
+    void setPartial (int partialIndex, double frequencyHz, float amplitude) noexcept;
+
+    /** Changes the frequency of one of the partials, keeping its current phase. */
+    void setPartialFrequency (int partialIndex, double frequencyHz) noexcept;
+
+    /** Changes the amplitude of one of the partials.
+        The amplitude will be ramped to its new value over the next block that gets rendered.
+    */
+    void setPartialAmplitude (int partialIndex, float amplitude) noexcept;
+
+    /** Returns a partial's frequency. */
+    double getPartialFrequency (int partialIndex) const noexcept;
+
+    /** Restarts all the partials at the given phase (in radians), and jumps straight to
+        their target amplitudes rather than ramping towards them.
+    */
+    void reset (double startPhase = 0.0) noexcept;
+
+    //==============================================================================
+    /** Adds the next block of samples to a buffer of floats. */
+    void render (float* destSamples, int numSamples) noexcept;
+
+    /** Adds the next block of samples to all the channels of a buffer.
+        This has the same signature as SynthesiserVoice::renderNextBlock(), so a voice can
+        simply forward its calls to this method.
+    */
+    void renderNextBlock (AudioSampleBuffer& outputBuffer, int startSample, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    double sampleRate;
+    int numPartials, numPartialsAllocated;
+
+    // Each of these holds a value per partial, padded to a multiple of 4 partials.
+    HeapBlock<float> phasorReal, phasorImag, rotationReal, rotationImag, amplitudes, targetAmplitudes;
+    HeapBlock<double> frequencies;
+    HeapBlock<float> requestedAmplitudes;
+
+    void renderChunk (float* dest, int numSamples, int numSamplesLeftInBlock) noexcept;
+    void updateRotation (int partialIndex) noexcept;
+    void updateTargetAmplitude (int partialIndex) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SineOscillatorBank)
+};
+
+
+#endif   // JUCE_SINEOSCILLATORBANK_H_INCLUDED
@@ -32,7 +32,8 @@ SynthesiserVoice::SynthesiserVoice()
       currentPlayingMidiChannel (0),
       noteOnTime (0),
       keyIsDown (false),
-      sostenutoPedalDown (false)
+      sostenutoPedalDown (false),
+      isInActiveVoiceList (false)
 {
 }
 
@@ -58,7 +59,10 @@ bool SynthesiserVoice::isVoiceActive() const
 void SynthesiserVoice::clearCurrentNote()
 {
     currentlyPlayingNote = -1;
-    currentlyPlayingSound = nullptr;
+
+    // (if the sound has been removed from the synth, this may be the last reference to it,
+    // so it mustn't be deleted here on the audio thread)
+    deferredDeleter->release (currentlyPlayingSound);
     currentPlayingMidiChannel = 0;
 }
 
@@ -70,12 +74,123 @@ bool SynthesiserVoice::wasStartedBefore (const SynthesiserVoice& other) const no
     return noteOnTime < other.noteOnTime;
 }
 
+//==============================================================================
+class Synthesiser::RenderingThreadPool  : private RealtimeThreadGroup::Job
+{
+public:
+    RenderingThreadPool (const int numWorkers, const int maxNumChannels)
+        : threads ("Synthesiser rendering", numWorkers),
+          voiceList (nullptr), output (nullptr), outputStartSample (0), numSamplesToRender (0)
+    {
+        // The scratch buffers are allocated here, so that the audio thread never has to
+        for (int i = 0; i < numWorkers; ++i)
+            scratchBuffers.add (new ScratchBuffer (maxNumChannels));
+    }
+
+    /** Returns false if the output has more channels than the scratch buffers were made for. */
+    bool canRenderInto (const AudioSampleBuffer& buffer) const noexcept
+    {
+        return scratchBuffers.size() == 0
+                || buffer.getNumChannels() <= scratchBuffers.getUnchecked (0)->maxNumChannels;
+    }
+
+    void render (SynthesiserVoice* const* const voicesToRender, const int numVoices,
+                 AudioSampleBuffer& outputBuffer, int startSample, int numSamples) noexcept
+    {
+        voiceList = voicesToRender;
+        output = &outputBuffer;
+
+        while (numSamples > 0)
+        {
+            const int numThisTime = jmin (numSamples, (int) scratchBufferSize);
+
+            for (int i = 0; i < scratchBuffers.size(); ++i)
+                scratchBuffers.getUnchecked (i)->prepare (outputBuffer.getNumChannels(), numThisTime);
+
+            outputStartSample = startSample;
+            numSamplesToRender = numThisTime;
+
+            // This thread renders straight into the output, while the workers use their scratch buffers
+            threads.perform (*this, numVoices);
+
+            for (int i = 0; i < scratchBuffers.size(); ++i)
+            {
+                const ScratchBuffer& scratch = *scratchBuffers.getUnchecked (i);
+
+                if (scratch.hasRendered)
+                    for (int chan = 0; chan < outputBuffer.getNumChannels(); ++chan)
+                        outputBuffer.addFrom (chan, startSample, scratch.buffer, chan, 0, numThisTime);
+            }
+
+            startSample += numThisTime;
+            numSamples -= numThisTime;
+        }
+    }
+
+private:
+    //==============================================================================
+    enum { scratchBufferSize = 1024 };
+
+    struct ScratchBuffer
+    {
+        ScratchBuffer (const int numChannels)
+            : buffer (numChannels, scratchBufferSize), maxNumChannels (numChannels), hasRendered (false)
+        {}
+
+        void prepare (const int numChannels, const int numSamples) noexcept
+        {
+            jassert (numChannels <= maxNumChannels && numSamples <= scratchBufferSize);
+            buffer.setSize (numChannels, numSamples, false, false, true);
+            hasRendered = false;
+        }
+
+        AudioSampleBuffer buffer;
+        const int maxNumChannels;
+        bool hasRendered;
+
+        JUCE_DECLARE_NON_COPYABLE (ScratchBuffer)
+    };
+
+    OwnedArray<ScratchBuffer> scratchBuffers;
+    RealtimeThreadGroup threads;
+    SynthesiserVoice* const* voiceList;
+    AudioSampleBuffer* output;
+    int outputStartSample, numSamplesToRender;
+
+    void performItem (const int voiceIndex, const int threadIndex) override
+    {
+        SynthesiserVoice* const voice = voiceList[voiceIndex];
+
+        if (threadIndex == 0)
+        {
+            voice->renderNextBlock (*output, outputStartSample, numSamplesToRender);
+            return;
+        }
+
+        ScratchBuffer& scratch = *scratchBuffers.getUnchecked (threadIndex - 1);
+
+        if (! scratch.hasRendered)
+        {
+            scratch.buffer.clear();
+            scratch.hasRendered = true;
+        }
+
+        voice->renderNextBlock (scratch.buffer, 0, numSamplesToRender);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (RenderingThreadPool)
+};
+
 //==============================================================================
 Synthesiser::Synthesiser()
     : sampleRate (0),
       lastNoteOnCounter (0),
       minimumSubBlockSize (32),
-      shouldStealNotes (true)
+      shouldStealNotes (true),
+      numRenderingThreads (1),
+      maxNumRenderingChannels (2),
+      numActiveVoices (0),
+      onlyRenderActiveVoices (false)
 {
     for (int i = 0; i < numElementsInArray (lastPitchWheelValues); ++i)
         lastPitchWheelValues[i] = 0x2000;
@@ -83,6 +198,7 @@ Synthesiser::Synthesiser()
 
 Synthesiser::~Synthesiser()
 {
+    renderingThreadPool = nullptr;
 }
 
 //==============================================================================
@@ -96,18 +212,22 @@ void Synthesiser::clearVoices()
 {
     const ScopedLock sl (lock);
     voices.clear();
+    updateActiveVoiceStorage();
 }
 
 SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
 {
     const ScopedLock sl (lock);
-    return voices.add (newVoice);
+    voices.add (newVoice);
+    updateActiveVoiceStorage();
+    return newVoice;
 }
 
 void Synthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (lock);
     voices.remove (index);
+    updateActiveVoiceStorage();
 }
 
 void Synthesiser::clearSounds()
@@ -204,8 +324,84 @@ void Synthesiser::renderNextBlock (AudioSampleBuffer& outputBuffer, const MidiBu
 
 void Synthesiser::renderVoices (AudioSampleBuffer& buffer, int startSample, int numSamples)
 {
-    for (int i = voices.size(); --i >= 0;)
-        voices.getUnchecked (i)->renderNextBlock (buffer, startSample, numSamples);
+    SynthesiserVoice* const* const voicesToRender = onlyRenderActiveVoices ? activeVoices.getData()
+                                                                           : voices.getRawDataPointer();
+    const int numVoicesToRender = onlyRenderActiveVoices ? numActiveVoices : voices.size();
+
+    const bool useRenderingThreads = renderingThreadPool != nullptr && numVoicesToRender > 1;
+
+    // If this fails, the buffer has more channels than you allowed for when you called
+    // setNumRenderingThreads(), so all the voices will be rendered on this thread.
+    jassert (! useRenderingThreads || renderingThreadPool->canRenderInto (buffer));
+
+    if (useRenderingThreads && renderingThreadPool->canRenderInto (buffer))
+    {
+        renderingThreadPool->render (voicesToRender, numVoicesToRender, buffer, startSample, numSamples);
+    }
+    else
+    {
+        for (int i = numVoicesToRender; --i >= 0;)
+            voicesToRender[i]->renderNextBlock (buffer, startSample, numSamples);
+    }
+
+    removeInactiveVoices();
+}
+
+void Synthesiser::updateActiveVoiceStorage()
+{
+    // (called with the lock held, whenever the set of voices changes)
+    activeVoices.realloc ((size_t) jmax (1, voices.size()));
+    numActiveVoices = 0;
+
+    for (int i = 0; i < voices.size(); ++i)
+    {
+        SynthesiserVoice* const voice = voices.getUnchecked (i);
+        voice->isInActiveVoiceList = voice->isVoiceActive();
+
+        if (voice->isInActiveVoiceList)
+            activeVoices[numActiveVoices++] = voice;
+    }
+}
+
+void Synthesiser::removeInactiveVoices() noexcept
+{
+    int numKept = 0;
+
+    for (int i = 0; i < numActiveVoices; ++i)
+    {
+        SynthesiserVoice* const voice = activeVoices[i];
+
+        if (voice->isVoiceActive())
+            activeVoices[numKept++] = voice;
+        else
+            voice->isInActiveVoiceList = false;
+    }
+
+    numActiveVoices = numKept;
+}
+
+void Synthesiser::setOnlyRenderActiveVoices (const bool shouldOnlyRenderActiveVoices) noexcept
+{
+    const ScopedLock sl (lock);
+    onlyRenderActiveVoices = shouldOnlyRenderActiveVoices;
+}
+
+void Synthesiser::setNumRenderingThreads (int numThreads, const int maxNumOutputChannels)
+{
+    numThreads = jmax (1, numThreads);
+
+    if (numThreads != numRenderingThreads || maxNumOutputChannels != maxNumRenderingChannels)
+    {
+        ScopedPointer<RenderingThreadPool> newPool (numThreads > 1 ? new RenderingThreadPool (numThreads - 1, maxNumOutputChannels)
+                                                                   : nullptr);
+
+        {
+            const ScopedLock sl (lock);
+            newPool.swapWith (renderingThreadPool);
+            numRenderingThreads = numThreads;
+            maxNumRenderingChannels = maxNumOutputChannels;
+        }
+    }
 }
 
 void Synthesiser::handleMidiEvent (const MidiMessage& m)
@@ -293,10 +489,17 @@ void Synthesiser::startVoice (SynthesiserVoice* const voice,
         voice->currentlyPlayingNote = midiNoteNumber;
         voice->currentPlayingMidiChannel = midiChannel;
         voice->noteOnTime = ++lastNoteOnCounter;
+        voice->deferredDeleter->release (voice->currentlyPlayingSound);
         voice->currentlyPlayingSound = sound;
         voice->keyIsDown = true;
         voice->sostenutoPedalDown = false;
 
+        if (! voice->isInActiveVoiceList && numActiveVoices < voices.size())
+        {
+            voice->isInActiveVoiceList = true;
+            activeVoices[numActiveVoices++] = voice;
+        }
+
         voice->startNote (midiNoteNumber, velocity, sound,
                           lastPitchWheelValues [midiChannel - 1]);
     }
@@ -244,7 +244,8 @@ private:
     int currentlyPlayingNote, currentPlayingMidiChannel;
     uint32 noteOnTime;
     SynthesiserSound::Ptr currentlyPlayingSound;
-    bool keyIsDown, sostenutoPedalDown;
+    bool keyIsDown, sostenutoPedalDown, isInActiveVoiceList;
+    SharedResourcePointer<DeferredDeleter> deferredDeleter;
 
    #if JUCE_CATCH_DEPRECATED_CODE_MISUSE
     // Note the new parameters for this method.
@@ -521,6 +522,44 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples) noexcept;
 
+    //==============================================================================
+    /** Sets the number of threads that the default renderVoices() method will use.
+
+        By default this is 1, and all the voices are rendered on the thread that calls
+        renderNextBlock(). If you set it to more than that, a pool of (numThreads - 1)
+        worker threads is created, and the voices are shared out between these and the
+        rendering thread. Each worker renders its voices into its own scratch buffer, and
+        these are mixed into the output once all the voices are done.
+
+        To use this, your voices' renderNextBlock() methods must be safe to call at the
+        same time as each other.
+
+        The scratch buffers are allocated by this method, so maxNumOutputChannels must be
+        at least the number of channels in the buffers that you'll pass to renderNextBlock().
+        If a buffer has more channels than that, its voices are all rendered on the calling
+        thread. Long blocks are rendered in chunks of up to 1024 samples, so the block size
+        doesn't matter.
+    */
+    void setNumRenderingThreads (int numThreads, int maxNumOutputChannels = 2);
+
+    /** Returns the number of threads that are used for rendering.
+        @see setNumRenderingThreads
+    */
+    int getNumRenderingThreads() const noexcept                 { return numRenderingThreads; }
+
+    /** If enabled, the default renderVoices() method only calls the voices that are active.
+
+        The synthesiser keeps a list of voices that have been started by startVoice(), and
+        removes them from it once their isVoiceActive() method returns false, so when you
+        have a large number of voices, this avoids calling every one of them for each
+        sub-block.
+
+        Only enable this if all your notes are started by startVoice() (as the default
+        noteOn() method does), and your voices never produce any output while their
+        isVoiceActive() method returns false.
+    */
+    void setOnlyRenderActiveVoices (bool shouldOnlyRenderActiveVoices) noexcept;
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
@@ -583,7 +622,18 @@ private:
     bool shouldStealNotes;
     BigInteger sustainPedalsDown;
 
+    class RenderingThreadPool;
+    friend class RenderingThreadPool;
+    ScopedPointer<RenderingThreadPool> renderingThreadPool;
+    int numRenderingThreads, maxNumRenderingChannels;
+
+    HeapBlock<SynthesiserVoice*> activeVoices;
+    int numActiveVoices;
+    bool onlyRenderActiveVoices;
+
     void stopVoice (SynthesiserVoice*, float velocity, bool allowTailOff);
+    void updateActiveVoiceStorage();
+    void removeInactiveVoices() noexcept;
 
    #if JUCE_CATCH_DEPRECATED_CODE_MISUSE
     // Note the new parameters for these methods.
@@ -0,0 +1,279 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+Wavetable::Wavetable (const int order)
+    : tableSizeOrder (order), tableSize (1 << order), numLevels (0)
+{
+    jassert (order >= 2 && order <= 16);
+}
+
+Wavetable::Wavetable (const float* singleCycle, const int numSamples, const int order)
+    : tableSizeOrder (order), tableSize (1 << order), numLevels (0)
+{
+    jassert (order >= 2 && order <= 16);
+    jassert (singleCycle != nullptr && numSamples > 0);
+
+    HeapBlock<float> spectrum ((size_t) tableSize * 2, true);
+
+    for (int i = 0; i < tableSize; ++i)
+    {
+        const double pos = i * numSamples / (double) tableSize;
+        const int index = (int) pos;
+        const float s1 = singleCycle [index];
+        const float s2 = singleCycle [(index + 1) % numSamples];
+
+        spectrum[i] = s1 + (float) (pos - index) * (s2 - s1);
+    }
+
+    FFT (tableSizeOrder, false).performRealOnlyForwardTransform (spectrum);
+    createLevels (spectrum);
+}
+
+Wavetable::~Wavetable()
+{
+}
+
+Wavetable* Wavetable::createFromHarmonics (const float* harmonicAmplitudes, int numHarmonics, const int order)
+{
+    Wavetable* const w = new Wavetable (order);
+
+    numHarmonics = jmin (numHarmonics, w->tableSize / 2 - 1);
+    HeapBlock<float> spectrum ((size_t) w->tableSize * 2, true);
+
+    // A sine wave of amplitude a at harmonic k appears as -a/2 imaginary in bin k and
+    // +a/2 imaginary in the mirrored bin, scaled up by the size of the transform.
+    for (int k = 1; k <= numHarmonics; ++k)
+    {
+        const float value = harmonicAmplitudes [k - 1] * w->tableSize * 0.5f;
+
+        spectrum [2 * k + 1] = -value;
+        spectrum [2 * (w->tableSize - k) + 1] = value;
+    }
+
+    w->createLevels (spectrum);
+    return w;
+}
+
+Wavetable* Wavetable::createSawtooth (const int order)
+{
+    const int numHarmonics = (1 << order) / 2 - 1;
+    HeapBlock<float> amplitudes ((size_t) numHarmonics);
+
+    for (int k = 1; k <= numHarmonics; ++k)
+        amplitudes [k - 1] = (float) ((k & 1 ? 2.0 : -2.0) / (double_Pi * k));
+
+    return createFromHarmonics (amplitudes, numHarmonics, order);
+}
+
+Wavetable* Wavetable::createSquare (const int order)
+{
+    const int numHarmonics = (1 << order) / 2 - 1;
+    HeapBlock<float> amplitudes ((size_t) numHarmonics);
+
+    for (int k = 1; k <= numHarmonics; ++k)
+        amplitudes [k - 1] = (float) (k & 1 ? 4.0 / (double_Pi * k) : 0.0);
+
+    return createFromHarmonics (amplitudes, numHarmonics, order);
+}
+
+Wavetable* Wavetable::createTriangle (const int order)
+{
+    const int numHarmonics = (1 << order) / 2 - 1;
+    HeapBlock<float> amplitudes ((size_t) numHarmonics);
+
+    for (int k = 1; k <= numHarmonics; ++k)
+        amplitudes [k - 1] = (float) (k & 1 ? ((k & 3) == 1 ? 8.0 : -8.0) / (double_Pi * double_Pi * k * k) : 0.0);
+
+    return createFromHarmonics (amplitudes, numHarmonics, order);
+}
+
+int Wavetable::getNumHarmonicsInLevel (const int level) const noexcept
+{
+    jassert (isPositiveAndBelow (level, numLevels));
+    return (tableSize / 2 - 1) >> level;
+}
+
+const float* Wavetable::getLevel (const int level) const noexcept
+{
+    jassert (isPositiveAndBelow (level, numLevels));
+    return tables + level * (tableSize + 1);
+}
+
+void Wavetable::createLevels (const float* spectrum)
+{
+    numLevels = 0;
+
+    for (int n = tableSize / 2 - 1; n > 0; n >>= 1)
+        ++numLevels;
+
+    tables.malloc ((size_t) (numLevels * (tableSize + 1)));
+
+    const FFT inverseFFT (tableSizeOrder, true);
+    HeapBlock<float> levelSpectrum ((size_t) tableSize * 2);
+
+    for (int level = 0; level < numLevels; ++level)
+    {
+        const int numHarmonics = getNumHarmonicsInLevel (level);
+
+        memcpy (levelSpectrum, spectrum, sizeof (float) * (size_t) tableSize * 2);
+
+        // remove everything above this level's top harmonic, including the Nyquist bin
+        zeromem (levelSpectrum + 2 * (numHarmonics + 1),
+                 sizeof (float) * (size_t) (2 * (tableSize - 2 * numHarmonics - 1)));
+
+        inverseFFT.performRealOnlyInverseTransform (levelSpectrum);
+
+        float* const table = tables + level * (tableSize + 1);
+        memcpy (table, levelSpectrum, sizeof (float) * (size_t) tableSize);
+        table [tableSize] = table[0];
+    }
+}
+
+//==============================================================================
+WavetableOscillator::WavetableOscillator()
+    : sampleRate (44100.0), frequency (440.0), phase (0.0),
+      amplitude (1.0f), targetAmplitude (1.0f)
+{
+}
+
+WavetableOscillator::~WavetableOscillator()
+{
+}
+
+void WavetableOscillator::setWavetable (Wavetable* const newWavetable) noexcept
+{
+    wavetable = newWavetable;
+}
+
+void WavetableOscillator::setSampleRate (const double newSampleRate) noexcept
+{
+    jassert (newSampleRate > 0);
+    sampleRate = newSampleRate;
+}
+
+void WavetableOscillator::setFrequency (const double frequencyHz) noexcept
+{
+    jassert (frequencyHz >= 0);
+    frequency = frequencyHz;
+}
+
+void WavetableOscillator::setAmplitude (const float newAmplitude) noexcept
+{
+    targetAmplitude = newAmplitude;
+}
+
+void WavetableOscillator::reset (const double startPhase) noexcept
+{
+    phase = startPhase - std::floor (startPhase);
+    amplitude = targetAmplitude;
+}
+
+//==============================================================================
+void WavetableOscillator::renderChunk (float* const dest, const int numSamples, const int numSamplesLeftInBlock) noexcept
+{
+    const double increment = frequency / sampleRate;
+    const float amplitudeDelta = (targetAmplitude - amplitude) / (float) numSamplesLeftInBlock;
+
+    if (wavetable == nullptr || increment >= 0.5)
+    {
+        phase += increment * numSamples;
+        phase -= std::floor (phase);
+    }
+    else
+    {
+        // Pick the level with the most harmonics that all fit below the Nyquist limit, and as
+        // its top harmonic gets into the top octave, fade across to the next level down.
+        const int numLevels = wavetable->getNumLevels();
+        int level = 0;
+
+        while (level < numLevels - 1 && wavetable->getNumHarmonicsInLevel (level) * increment > 0.5)
+            ++level;
+
+        float fade = 0;
+
+        if (level < numLevels - 1)
+            fade = jlimit (0.0f, 1.0f, (float) (wavetable->getNumHarmonicsInLevel (level) * increment * 4.0 - 1.0));
+
+        const int tableSize = wavetable->getTableSize();
+        const float* const table1 = wavetable->getLevel (level);
+        const float* const table2 = wavetable->getLevel (jmin (level + 1, numLevels - 1));
+
+        float amp = amplitude;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double pos = phase * tableSize;
+            const int index = (int) pos;
+            const float alpha = (float) (pos - index);
+
+            const float s1 = table1[index] + alpha * (table1[index + 1] - table1[index]);
+            const float s2 = table2[index] + alpha * (table2[index + 1] - table2[index]);
+
+            dest[i] += amp * (s1 + fade * (s2 - s1));
+            amp += amplitudeDelta;
+
+            phase += increment;
+
+            if (phase >= 1.0)
+                phase -= 1.0;
+        }
+    }
+
+    amplitude = (numSamples == numSamplesLeftInBlock) ? targetAmplitude
+                                                      : amplitude + amplitudeDelta * numSamples;
+}
+
+void WavetableOscillator::render (float* destSamples, int numSamples) noexcept
+{
+    renderChunk (destSamples, numSamples, numSamples);
+}
+
+void WavetableOscillator::renderNextBlock (AudioSampleBuffer& outputBuffer, int startSample, int numSamples) noexcept
+{
+    const int numChannels = outputBuffer.getNumChannels();
+
+    if (numChannels == 1)
+    {
+        render (outputBuffer.getWritePointer (0, startSample), numSamples);
+        return;
+    }
+
+    const int maxSamplesPerChunk = 256;
+    float mono [maxSamplesPerChunk];
+
+    for (int numSamplesLeft = numSamples; numSamplesLeft > 0;)
+    {
+        const int numThisTime = jmin (numSamplesLeft, maxSamplesPerChunk);
+
+        FloatVectorOperations::clear (mono, numThisTime);
+        renderChunk (mono, numThisTime, numSamplesLeft);
+
+        for (int i = 0; i < numChannels; ++i)
+            outputBuffer.addFrom (i, startSample, mono, numThisTime);
+
+        startSample += numThisTime;
+        numSamplesLeft -= numThisTime;
+    }
+}
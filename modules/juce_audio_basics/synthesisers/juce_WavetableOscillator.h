@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_WAVETABLEOSCILLATOR_H_INCLUDED
+#define JUCE_WAVETABLEOSCILLATOR_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A single-cycle waveform, stored as a set of band-limited tables for use by a
+    WavetableOscillator.
+
+    The waveform is split into "mip-map" levels, each of which has half as many harmonics
+    as the one before, so that an oscillator can always pick a level that has no harmonics
+    above the Nyquist frequency, whatever pitch it's playing at.
+
+    These are reference-counted, so a single table can be shared between all the voices
+    of a synth.
+
+    @see WavetableOscillator
+*/
+class JUCE_API  Wavetable  : public ReferenceCountedObject
+{
+public:
+    //==============================================================================
+    /** Creates a wavetable from one cycle of a waveform.
+
+        @param singleCycle      the samples of one cycle of the waveform. If the number of
+                                samples isn't the same as the table size, the cycle is
+                                stretched to fit using linear interpolation.
+        @param numSamples       the number of samples in the cycle
+        @param tableSizeOrder   the size of each table, as a power of 2. The number of
+                                harmonics that can be kept is half of the table size,
+                                which limits how low the fundamental frequency can go
+                                before its top harmonics start to be lost.
+    */
+    Wavetable (const float* singleCycle, int numSamples, int tableSizeOrder = 11);
+
+    /** Destructor. */
+    ~Wavetable();
+
+    /** Creates a wavetable from the amplitudes of a set of sine harmonics.
+        The first value in the array is the amplitude of the fundamental.
+    */
+    static Wavetable* createFromHarmonics (const float* harmonicAmplitudes, int numHarmonics,
+                                           int tableSizeOrder = 11);
+
+    /** Creates a sawtooth wave with a peak level of about 1.0. */
+    static Wavetable* createSawtooth (int tableSizeOrder = 11);
+
+    /** Creates a square wave with a peak level of about 1.0. */
+    static Wavetable* createSquare (int tableSizeOrder = 11);
+
+    /** Creates a triangle wave with a peak level of about 1.0. */
+    static Wavetable* createTriangle (int tableSizeOrder = 11);
+
+    /** A pointer to a Wavetable. */
+    typedef ReferenceCountedObjectPtr<Wavetable> Ptr;
+
+    //==============================================================================
+    /** Returns the number of samples in each level's table. */
+    int getTableSize() const noexcept                   { return tableSize; }
+
+    /** Returns the number of band-limited levels. */
+    int getNumLevels() const noexcept                   { return numLevels; }
+
+    /** Returns the highest harmonic that's present in one of the levels.
+        Level 0 has the most harmonics, and each subsequent level has half as many.
+    */
+    int getNumHarmonicsInLevel (int level) const noexcept;
+
+    /** Returns the samples for one of the levels.
+        There are getTableSize() + 1 of them, as the first sample is repeated at the end to
+        make interpolation simpler.
+    */
+    const float* getLevel (int level) const noexcept;
+
+private:
+    //==============================================================================
+    const int tableSizeOrder, tableSize;
+    int numLevels;
+    HeapBlock<float> tables;
+
+    Wavetable (int tableSizeOrder);
+    void createLevels (const float* spectrum);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Wavetable)
+};
+
+//==============================================================================
+/**
+    Plays a Wavetable at a given frequency, without aliasing.
+
+    For each block, the oscillator chooses the table levels whose harmonics all fit
+    below the Nyquist frequency at the current pitch, and crossfades between the two
+    nearest ones as the pitch moves, so that sweeps don't produce audible steps as
+    harmonics are removed.
+
+    Like the SineOscillatorBank, the render methods add to whatever's already in the
+    destination, and renderNextBlock() can be called directly from a
+    SynthesiserVoice::renderNextBlock() method.
+
+    @see Wavetable, SineOscillatorBank
+*/
+class JUCE_API  WavetableOscillator
+{
+public:
+    //==============================================================================
+    /** Creates an oscillator with no wavetable. */
+    WavetableOscillator();
+
+    /** Destructor. */
+    ~WavetableOscillator();
+
+    //==============================================================================
+    /** Sets the wavetable to play. This can be null to make the oscillator silent. */
+    void setWavetable (Wavetable* newWavetable) noexcept;
+
+    /** Returns the current wavetable. */
+    Wavetable* getWavetable() const noexcept            { return wavetable; }
+
+    /** Sets the sample rate that the oscillator will run at. */
+    void setSampleRate (double newSampleRate) noexcept;
+
+    /** Sets the oscillator's frequency. The current phase is kept, so this can be
+        changed while playing.
+    */
+    void setFrequency (double frequencyHz) noexcept;
+
+    /** Returns the oscillator's frequency. */
+    double getFrequency() const noexcept                { return frequency; }
+
+    /** Sets the oscillator's level. The change is ramped over the next block that gets rendered. */
+    void setAmplitude (float newAmplitude) noexcept;
+
+    /** Restarts the waveform at a given phase (as a proportion of a cycle, 0 to 1), and
+        jumps straight to the target amplitude rather than ramping towards it.
+    */
+    void reset (double startPhase = 0.0) noexcept;
+
+    //==============================================================================
+    /** Adds the next block of samples to a buffer of floats. */
+    void render (float* destSamples, int numSamples) noexcept;
+
+    /** Adds the next block of samples to all the channels of a buffer.
+        This has the same signature as SynthesiserVoice::renderNextBlock(), so a voice can
+        simply forward its calls to this method.
+    */
+    void renderNextBlock (AudioSampleBuffer& outputBuffer, int startSample, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    Wavetable::Ptr wavetable;
+    double sampleRate, frequency, phase;
+    float amplitude, targetAmplitude;
+
+    void renderChunk (float* dest, int numSamples, int numSamplesLeftInBlock) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WavetableOscillator)
+};
+
+
+#endif   // JUCE_WAVETABLEOSCILLATOR_H_INCLUDED
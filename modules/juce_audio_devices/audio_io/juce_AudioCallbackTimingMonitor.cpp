@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+namespace CallbackTimingHelpers
+{
+    static int toMicroseconds (const double ms) noexcept
+    {
+        return (int) jlimit (0.0, 2147483647.0, ms * 1000.0);
+    }
+
+    static void updateMaximum (Atomic<int>& maximum, const int newValue) noexcept
+    {
+        for (int current = maximum.get(); newValue > current; current = maximum.get())
+            if (maximum.compareAndSetBool (newValue, current))
+                break;
+    }
+}
+
+//==============================================================================
+AudioCallbackTimingMonitor::Stats::Stats() noexcept
+    : periodMs (0), numCallbacks (0), averageLoad (0), maxLoad (0), maxDurationMs (0),
+      averageJitterMs (0), maxJitterMs (0), numLateCallbacks (0), numXRuns (-1)
+{
+}
+
+double AudioCallbackTimingMonitor::Stats::getLoadPercentile (const double proportion) const noexcept
+{
+    int64 total = 0;
+
+    for (int i = 0; i < loadHistogram.size(); ++i)
+        total += loadHistogram.getUnchecked (i);
+
+    if (total == 0)
+        return 0;
+
+    const int64 target = jmax ((int64) 1, (int64) std::ceil (jlimit (0.0, 1.0, proportion) * (double) total));
+    int64 count = 0;
+
+    for (int i = 0; i < loadHistogram.size(); ++i)
+    {
+        count += loadHistogram.getUnchecked (i);
+
+        if (count >= target)
+            return (i + 1) / (double) numBinsPerPeriod;
+    }
+
+    return loadHistogram.size() / (double) numBinsPerPeriod;
+}
+
+//==============================================================================
+AudioCallbackTimingMonitor::AudioCallbackTimingMonitor() noexcept
+    : periodMs (0), binsPerMs (0),
+      lastStartTimeMs (0), smoothedDurationMs (0), smoothedJitterMs (0)
+{
+}
+
+AudioCallbackTimingMonitor::~AudioCallbackTimingMonitor() {}
+
+void AudioCallbackTimingMonitor::prepare (const double sampleRate, const int blockSize) noexcept
+{
+    periodMs = (sampleRate > 0.0 && blockSize > 0) ? (1000.0 * blockSize / sampleRate) : 0.0;
+    binsPerMs = periodMs > 0.0 ? (numBinsPerPeriod / periodMs) : 0.0;
+
+    clearSharedValues();
+    resetPending = 0;
+    lastStartTimeMs = smoothedDurationMs = smoothedJitterMs = 0;
+}
+
+void AudioCallbackTimingMonitor::reset() noexcept
+{
+    clearSharedValues();
+
+    // the audio thread's own running values get cleared by the next callback
+    resetPending = 1;
+}
+
+void AudioCallbackTimingMonitor::clearSharedValues() noexcept
+{
+    for (int i = 0; i < numHistogramBins; ++i)
+        histogram[i] = 0;
+
+    for (int i = 0; i < maxLateCallbackTimes; ++i)
+        lateCallbackTimesUs[i] = 0;
+
+    numCallbacks = 0;
+    averageDurationUs = 0;
+    maxDurationUs = 0;
+    averageJitterUs = 0;
+    maxJitterUs = 0;
+    numLateCallbacks = 0;
+}
+
+void AudioCallbackTimingMonitor::addCallback (const double startTimeMs, const double endTimeMs) noexcept
+{
+    using namespace CallbackTimingHelpers;
+
+    if (resetPending.get() != 0 && resetPending.compareAndSetBool (0, 1))
+        lastStartTimeMs = smoothedDurationMs = smoothedJitterMs = 0;
+
+    const double durationMs = jmax (0.0, endTimeMs - startTimeMs);
+    const double filterAmount = 0.2;
+
+    ++numCallbacks;
+    ++histogram [jlimit (0, (int) numHistogramBins - 1, (int) (durationMs * binsPerMs))];
+
+    smoothedDurationMs += filterAmount * (durationMs - smoothedDurationMs);
+    averageDurationUs = toMicroseconds (smoothedDurationMs);
+    updateMaximum (maxDurationUs, toMicroseconds (durationMs));
+
+    if (lastStartTimeMs > 0)
+    {
+        const double jitterMs = std::abs ((startTimeMs - lastStartTimeMs) - periodMs);
+
+        smoothedJitterMs += filterAmount * (jitterMs - smoothedJitterMs);
+        averageJitterUs = toMicroseconds (smoothedJitterMs);
+        updateMaximum (maxJitterUs, toMicroseconds (jitterMs));
+    }
+
+    lastStartTimeMs = startTimeMs;
+
+    if (periodMs > 0 && durationMs > periodMs)
+    {
+        const int index = numLateCallbacks.get();
+        lateCallbackTimesUs [index % maxLateCallbackTimes] = (int64) (startTimeMs * 1000.0);
+        ++numLateCallbacks;
+    }
+}
+
+AudioCallbackTimingMonitor::Stats AudioCallbackTimingMonitor::getStats() const
+{
+    const double loadScale = periodMs > 0 ? (0.001 / periodMs) : 0.0;
+
+    Stats s;
+    s.periodMs         = periodMs;
+    s.numCallbacks     = numCallbacks.get();
+    s.averageLoad      = averageDurationUs.get() * loadScale;
+    s.maxLoad          = maxDurationUs.get() * loadScale;
+    s.maxDurationMs    = maxDurationUs.get() * 0.001;
+    s.averageJitterMs  = averageJitterUs.get() * 0.001;
+    s.maxJitterMs      = maxJitterUs.get() * 0.001;
+    s.numLateCallbacks = numLateCallbacks.get();
+
+    for (int i = jmax (0, s.numLateCallbacks - (int) maxLateCallbackTimes); i < s.numLateCallbacks; ++i)
+        s.lateCallbackTimes.add (lateCallbackTimesUs [i % maxLateCallbackTimes].get() * 0.001);
+
+    s.loadHistogram.ensureStorageAllocated (numHistogramBins);
+
+    for (int i = 0; i < numHistogramBins; ++i)
+        s.loadHistogram.add (histogram[i].get());
+
+    return s;
+}
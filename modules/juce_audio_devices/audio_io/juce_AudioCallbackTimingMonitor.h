@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_AUDIOCALLBACKTIMINGMONITOR_H_INCLUDED
+#define JUCE_AUDIOCALLBACKTIMINGMONITOR_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Collects timing statistics about a stream of audio callbacks.
+
+    The audio thread reports the start and end time of each callback with
+    addCallback(), and any other thread can call getStats() to see a histogram
+    of the callback durations, the worst-case load, how much the intervals between
+    callbacks have jittered, and when the most recent late callbacks happened.
+
+    Neither side ever takes a lock: all the shared values are atomics, so a GUI
+    can poll this as often as it likes without disturbing the audio thread. The
+    price of this is that the values in a Stats object aren't taken at exactly the
+    same instant, so e.g. the histogram may contain one more callback than the
+    numCallbacks field.
+
+    An AudioDeviceManager keeps one of these for the callbacks it makes - see
+    AudioDeviceManager::getCallbackTimingStats().
+
+    @see AudioDeviceManager
+*/
+class JUCE_API  AudioCallbackTimingMonitor
+{
+public:
+    //==============================================================================
+    /** Creates a monitor. Call prepare() before giving it any callbacks. */
+    AudioCallbackTimingMonitor() noexcept;
+
+    /** Destructor. */
+    ~AudioCallbackTimingMonitor();
+
+    //==============================================================================
+    /** Sets the sample rate and block size that the callbacks will be using, and
+        clears all the stats.
+        This must not be called while callbacks are being added.
+    */
+    void prepare (double sampleRate, int blockSize) noexcept;
+
+    /** Clears all the stats.
+        This can be called from any thread, even while callbacks are being added.
+    */
+    void reset() noexcept;
+
+    /** Records a callback.
+        This must only be called by the audio thread. The times are values from
+        Time::getMillisecondCounterHiRes().
+    */
+    void addCallback (double startTimeMs, double endTimeMs) noexcept;
+
+    //==============================================================================
+    enum
+    {
+        numHistogramBins = 64,          /**< The number of bins in Stats::loadHistogram. */
+        numBinsPerPeriod = 32,          /**< Each bin covers 1/32 of the callback period, so the
+                                             last bin holds any callbacks that took twice
+                                             their period or more. */
+        maxLateCallbackTimes = 32       /**< The number of late-callback times that are kept. */
+    };
+
+    /** A snapshot of the stats. */
+    struct JUCE_API  Stats
+    {
+        Stats() noexcept;
+
+        /** The length of time that each callback has to fill its buffer. */
+        double periodMs;
+
+        /** The number of callbacks since the stats were last cleared. */
+        int64 numCallbacks;
+
+        /** The callback durations, as a proportion of the period.
+            averageLoad is a running average over the most recent callbacks, like
+            AudioDeviceManager::getCpuUsage(), except that it isn't clipped to 1.0.
+        */
+        double averageLoad, maxLoad;
+
+        /** The longest callback that has been recorded. */
+        double maxDurationMs;
+
+        /** How far the intervals between the starts of consecutive callbacks have
+            differed from the period.
+        */
+        double averageJitterMs, maxJitterMs;
+
+        /** The number of callbacks that took longer than their period. */
+        int numLateCallbacks;
+
+        /** The Time::getMillisecondCounterHiRes() values at which the most recent
+            late callbacks started, oldest first.
+        */
+        Array<double> lateCallbackTimes;
+
+        /** The number of callbacks in each load bin.
+            Bin i holds the callbacks whose load was between i / numBinsPerPeriod
+            and (i + 1) / numBinsPerPeriod, apart from the last bin, which holds
+            everything above that.
+        */
+        Array<int> loadHistogram;
+
+        /** The number of xruns reported by the device, or -1 if it can't detect them.
+            An AudioCallbackTimingMonitor doesn't know about the device, so it leaves
+            this as -1 - AudioDeviceManager::getCallbackTimingStats() fills it in.
+            @see AudioIODevice::getXRunCount
+        */
+        int numXRuns;
+
+        /** Uses the histogram to estimate the load below which the given proportion
+            of callbacks fall, e.g. getLoadPercentile (0.99) for the 99th percentile.
+            The result is the upper edge of the histogram bin that contains it.
+        */
+        double getLoadPercentile (double proportion) const noexcept;
+    };
+
+    /** Returns a snapshot of the stats. This can be called from any thread. */
+    Stats getStats() const;
+
+private:
+    //==============================================================================
+    // Durations are kept as whole microseconds, so that they fit into atomics.
+    Atomic<int> histogram [numHistogramBins];
+    Atomic<int64> numCallbacks;
+    Atomic<int> averageDurationUs, maxDurationUs, averageJitterUs, maxJitterUs, numLateCallbacks;
+    Atomic<int64> lateCallbackTimesUs [maxLateCallbackTimes];
+    Atomic<int> resetPending;
+
+    double periodMs, binsPerMs;
+
+    // only touched by the audio thread
+    double lastStartTimeMs, smoothedDurationMs, smoothedJitterMs;
+
+    void clearSharedValues() noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioCallbackTimingMonitor)
+};
+
+
+#endif   // JUCE_AUDIOCALLBACKTIMINGMONITOR_H_INCLUDED
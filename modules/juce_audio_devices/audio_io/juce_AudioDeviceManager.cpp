@@ -700,6 +700,8 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float** inputChannelDat
                                                    int numOutputChannels,
                                                    int numSamples)
 {
+    JUCE_TRACE_ZONE ("audio", "AudioDeviceManager::audioDeviceIOCallback");
+
     const ScopedLock sl (audioCallbackLock);
 
     if (inputLevelMeasurementEnabledCount.get() > 0 && numInputChannels > 0)
@@ -734,15 +736,21 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float** inputChannelDat
 
         tempBuffer.setSize (jmax (1, numOutputChannels), jmax (1, numSamples), false, false, true);
 
-        callbacks.getUnchecked(0)->audioDeviceIOCallback (inputChannelData, numInputChannels,
-                                                          outputChannelData, numOutputChannels, numSamples);
+        {
+            JUCE_TRACE_ZONE_FOR_OBJECT ("audio", "AudioIODeviceCallback::audioDeviceIOCallback", *callbacks.getUnchecked(0));
+            callbacks.getUnchecked(0)->audioDeviceIOCallback (inputChannelData, numInputChannels,
+                                                              outputChannelData, numOutputChannels, numSamples);
+        }
 
         float** const tempChans = tempBuffer.getArrayOfWritePointers();
 
         for (int i = callbacks.size(); --i > 0;)
         {
-            callbacks.getUnchecked(i)->audioDeviceIOCallback (inputChannelData, numInputChannels,
-                                                              tempChans, numOutputChannels, numSamples);
+            {
+                JUCE_TRACE_ZONE_FOR_OBJECT ("audio", "AudioIODeviceCallback::audioDeviceIOCallback", *callbacks.getUnchecked(i));
+                callbacks.getUnchecked(i)->audioDeviceIOCallback (inputChannelData, numInputChannels,
+                                                                  tempChans, numOutputChannels, numSamples);
+            }
 
             for (int chan = 0; chan < numOutputChannels; ++chan)
             {
@@ -753,9 +761,14 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float** inputChannelDat
             }
         }
 
-        const double msTaken = Time::getMillisecondCounterHiRes() - callbackStartTime;
+        const double callbackEndTime = Time::getMillisecondCounterHiRes();
+        const double msTaken = callbackEndTime - callbackStartTime;
         const double filterAmount = 0.2;
         cpuUsageMs += filterAmount * (msTaken - cpuUsageMs);
+
+        JUCE_TRACE_COUNTER ("audio", "AudioDeviceManager CPU usage", msTaken * timeToCpuScale);
+
+        callbackTimingMonitor.addCallback (callbackStartTime, callbackEndTime);
     }
     else
     {
@@ -791,6 +804,8 @@ void AudioDeviceManager::audioDeviceAboutToStartInt (AudioIODevice* const device
         timeToCpuScale = (msPerBlock > 0.0) ? (1.0 / msPerBlock) : 0.0;
     }
 
+    callbackTimingMonitor.prepare (sampleRate, blockSize);
+
     {
         const ScopedLock sl (audioCallbackLock);
         for (int i = callbacks.size(); --i >= 0;)
@@ -823,6 +838,16 @@ double AudioDeviceManager::getCpuUsage() const
     return jlimit (0.0, 1.0, timeToCpuScale * cpuUsageMs);
 }
 
+AudioCallbackTimingMonitor::Stats AudioDeviceManager::getCallbackTimingStats() const
+{
+    AudioCallbackTimingMonitor::Stats stats (callbackTimingMonitor.getStats());
+
+    if (currentAudioDevice != nullptr)
+        stats.numXRuns = currentAudioDevice->getXRunCount();
+
+    return stats;
+}
+
 //==============================================================================
 void AudioDeviceManager::setMidiInputEnabled (const String& name, const bool enabled)
 {
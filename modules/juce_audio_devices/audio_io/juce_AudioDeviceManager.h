@@ -307,6 +307,24 @@ public:
     */
     double getCpuUsage() const;
 
+    /** Returns a snapshot of detailed timing stats for the audio callbacks.
+
+        This includes a histogram of the callback durations, the worst-case load, the
+        jitter between callbacks, the times of recent late callbacks, and the number of
+        xruns that the current device has reported. It doesn't take any locks, so it's
+        fine to poll this frequently from the message thread.
+
+        The stats are cleared whenever the device (re)starts.
+
+        @see AudioCallbackTimingMonitor, AudioIODevice::getXRunCount
+    */
+    AudioCallbackTimingMonitor::Stats getCallbackTimingStats() const;
+
+    /** Returns the object that collects the stats for getCallbackTimingStats().
+        You can call its reset() method to start collecting them afresh.
+    */
+    AudioCallbackTimingMonitor& getCallbackTimingMonitor() noexcept     { return callbackTimingMonitor; }
+
     //==============================================================================
     /** Enables or disables a midi input device.
 
@@ -471,6 +489,7 @@ private:
     CriticalSection audioCallbackLock, midiCallbackLock;
 
     double cpuUsageMs, timeToCpuScale;
+    AudioCallbackTimingMonitor callbackTimingMonitor;
 
     //==============================================================================
     class CallbackHandler;
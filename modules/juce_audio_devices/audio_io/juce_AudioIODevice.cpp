@@ -32,6 +32,8 @@ AudioIODevice::~AudioIODevice() {}
 void AudioIODeviceCallback::audioDeviceError (const String&)    {}
 bool AudioIODevice::setAudioPreprocessingEnabled (bool)         { return false; }
 bool AudioIODevice::hasControlPanel() const                     { return false; }
+int AudioIODevice::getXRunCount() const noexcept                { return -1; }
+AudioPlayHead* AudioIODevice::getPlayHead()                     { return nullptr; }
 
 bool AudioIODevice::showControlPanel()
 {
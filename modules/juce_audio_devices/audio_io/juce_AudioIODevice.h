@@ -274,6 +274,24 @@ public:
     */
     virtual int getInputLatencyInSamples() = 0;
 
+    /** Returns the number of over- or under-runs that the device has reported since
+        it was opened.
+
+        An xrun is a glitch that the driver noticed, e.g. an ALSA -EPIPE, a WASAPI data
+        discontinuity or a CoreAudio processor overload. This can be called from any
+        thread. If the device type can't detect xruns, it returns -1.
+    */
+    virtual int getXRunCount() const noexcept;
+
+    /** If the device is synchronised to an external transport, this returns a play head
+        that describes it, otherwise it returns nullptr.
+
+        For example, a JACK device returns the state of the JACK transport. The play head
+        belongs to the device, and its getCurrentPosition() method should only be called
+        from inside the audio callback.
+    */
+    virtual AudioPlayHead* getPlayHead();
+
 
     //==============================================================================
     /** True if this device can show a pop-up control panel for editing its settings.
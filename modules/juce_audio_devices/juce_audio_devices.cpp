@@ -133,6 +133,7 @@
 namespace juce
 {
 
+#include "audio_io/juce_AudioCallbackTimingMonitor.cpp"
 #include "audio_io/juce_AudioDeviceManager.cpp"
 #include "audio_io/juce_AudioIODevice.cpp"
 #include "audio_io/juce_AudioIODeviceType.cpp"
@@ -72,6 +72,35 @@
  #define JUCE_ALSA 1
 #endif
 
+/** Config: JUCE_ALSA_USE_MMAP
+    If enabled, ALSA devices will be driven by memory-mapping their buffers and
+    waiting on their poll descriptors, rather than by blocking reads and writes. This
+    avoids a copy and gives tighter wake-ups, so works better with small period counts.
+    Devices that can't be memory-mapped will fall back to the normal read/write mode.
+*/
+#ifndef JUCE_ALSA_USE_MMAP
+ #define JUCE_ALSA_USE_MMAP 0
+#endif
+
+/** Config: JUCE_ALSA_NUM_PERIODS
+    The number of periods that ALSA devices are asked to use for their hardware buffers.
+    The default of 4 is very safe; 2 or 3 will give lower latency if your system can keep up.
+*/
+#ifndef JUCE_ALSA_NUM_PERIODS
+ #define JUCE_ALSA_NUM_PERIODS 4
+#endif
+
+/** Config: JUCE_ALSA_REALTIME_PRIORITY
+    If this is set to a value between 1 and 99, the ALSA audio thread will switch itself to
+    SCHED_FIFO scheduling with exactly this priority. If it's 0 (the default), the thread
+    uses Thread::setCurrentThreadRealtime() with a high priority. Using SCHED_FIFO needs the
+    process to have the right rtprio limits (e.g. via /etc/security/limits.conf), otherwise
+    it'll silently be ignored.
+*/
+#ifndef JUCE_ALSA_REALTIME_PRIORITY
+ #define JUCE_ALSA_REALTIME_PRIORITY 0
+#endif
+
 /** Config: JUCE_JACK
     Enables JACK audio devices (Linux only).
 */
@@ -119,6 +148,7 @@ namespace juce
 #include "sources/juce_AudioTransportSource.h"
 #include "audio_cd/juce_AudioCDBurner.h"
 #include "audio_cd/juce_AudioCDReader.h"
+#include "audio_io/juce_AudioCallbackTimingMonitor.h"
 #include "audio_io/juce_AudioDeviceManager.h"
 
 }
@@ -53,8 +53,11 @@ public:
 
         @param source   the MidiInput object that generated the message
         @param message  the incoming message. The message's timestamp is set to a value
-                        equivalent to (Time::getMillisecondCounter() / 1000.0) to specify the
-                        time when the message arrived.
+                        equivalent to (Time::getMillisecondCounterHiRes() / 1000.0) to specify
+                        the time when the message arrived. Where the driver records the time
+                        at which each message was received (CoreMIDI, ALSA and WinMM all do),
+                        that time is used rather than the time at which this callback is made,
+                        so the timestamps aren't affected by the scheduling of the midi thread.
     */
     virtual void handleIncomingMidiMessage (MidiInput* source,
                                             const MidiMessage& message) = 0;
@@ -24,12 +24,17 @@
 
 MidiMessageCollector::MidiMessageCollector()
     : lastCallbackTime (0),
-      sampleRate (44100.0001)
+      incomingMessages (maxPendingMessages),
+      sampleRate (44100.0001),
+      fixedLatencyMs (0),
+      expectedCallbackTime (0)
 {
+    heldMessages.ensureStorageAllocated (maxPendingMessages);
 }
 
 MidiMessageCollector::~MidiMessageCollector()
 {
+    clearPendingMessages();
 }
 
 //==============================================================================
@@ -37,10 +42,38 @@ void MidiMessageCollector::reset (const double sampleRate_)
 {
     jassert (sampleRate_ > 0);
 
-    const ScopedLock sl (midiCallbackLock);
+    clearPendingMessages();
     sampleRate = sampleRate_;
-    incomingMessages.clear();
     lastCallbackTime = Time::getMillisecondCounterHiRes();
+    expectedCallbackTime = 0;
+}
+
+void MidiMessageCollector::setFixedLatency (const double milliseconds)
+{
+    jassert (milliseconds >= 0);
+    fixedLatencyMs = jmax (0.0, milliseconds);
+    expectedCallbackTime = 0;
+}
+
+void MidiMessageCollector::clearPendingMessages()
+{
+    PendingMessage m;
+
+    while (incomingMessages.pop (m))
+        delete m.longMessage;
+
+    for (int i = heldMessages.size(); --i >= 0;)
+        delete heldMessages.getReference (i).longMessage;
+
+    heldMessages.clearQuick();
+}
+
+void MidiMessageCollector::addToBuffer (MidiBuffer& destBuffer, const PendingMessage& m, const int samplePosition)
+{
+    if (m.longMessage != nullptr)
+        destBuffer.addEventWithoutSorting (m.longMessage->getRawData(), m.longMessage->getRawDataSize(), samplePosition);
+    else
+        destBuffer.addEventWithoutSorting (m.data, m.size, samplePosition);
 }
 
 void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
@@ -52,17 +85,32 @@ void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
     // for details of what the number should be.
     jassert (message.getTimeStamp() != 0);
 
-    const ScopedLock sl (midiCallbackLock);
+    PendingMessage m;
+    m.timeStamp = message.getTimeStamp();
+    m.longMessage = nullptr;
+    m.size = 0;
 
-    const int sampleNumber
-        = (int) ((message.getTimeStamp() - 0.001 * lastCallbackTime) * sampleRate);
+    const int numBytes = message.getRawDataSize();
 
-    incomingMessages.addEvent (message, sampleNumber);
+    if (numBytes <= (int) sizeof (m.data))
+    {
+        memcpy (m.data, message.getRawData(), (size_t) numBytes);
+        m.size = (uint8) numBytes;
+    }
+    else
+    {
+        m.longMessage = new MidiMessage (message);
+    }
+
+    // if the messages aren't being used, we'd better get rid of
+    // the oldest ones to make room
+    while (! incomingMessages.push (m))
+    {
+        PendingMessage oldest;
 
-    // if the messages don't get used for over a second, we'd better
-    // get rid of any old ones to avoid the queue getting too big
-    if (sampleNumber > sampleRate)
-        incomingMessages.clear (0, sampleNumber - (int) sampleRate);
+        if (incomingMessages.pop (oldest))
+            delete oldest.longMessage;
+    }
 }
 
 void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
@@ -73,61 +121,132 @@ void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
     jassert (numSamples > 0);
 
     const double timeNow = Time::getMillisecondCounterHiRes();
-    const double msElapsed = timeNow - lastCallbackTime;
 
-    const ScopedLock sl (midiCallbackLock);
+    if (fixedLatencyMs > 0)
+    {
+        removeNextBlockWithFixedLatency (destBuffer, numSamples, timeNow);
+        return;
+    }
+
+    const double msElapsed = timeNow - lastCallbackTime;
+    const double lastCallbackTimeInSeconds = 0.001 * lastCallbackTime;
     lastCallbackTime = timeNow;
 
     if (! incomingMessages.isEmpty())
     {
         int numSourceSamples = jmax (1, roundToInt (msElapsed * 0.001 * sampleRate));
 
+        // if our list of events is longer than the buffer we're being asked for, they get
+        // scaled down to squeeze them all in, otherwise they're put towards the end of the buffer
+        const bool squeezeEvents = numSourceSamples > numSamples;
         int startSample = 0;
         int scale = 1 << 16;
 
-        const uint8* midiData;
-        int numBytes, samplePosition;
-
-        MidiBuffer::Iterator iter (incomingMessages);
-
-        if (numSourceSamples > numSamples)
+        if (squeezeEvents)
         {
-            // if our list of events is longer than the buffer we're being
-            // asked for, scale them down to squeeze them all in..
             const int maxBlockLengthToUse = numSamples << 5;
 
             if (numSourceSamples > maxBlockLengthToUse)
             {
                 startSample = numSourceSamples - maxBlockLengthToUse;
                 numSourceSamples = maxBlockLengthToUse;
-                iter.setNextSamplePosition (startSample);
             }
 
             scale = (numSamples << 10) / numSourceSamples;
-
-            while (iter.getNextEvent (midiData, numBytes, samplePosition))
-            {
-                samplePosition = ((samplePosition - startSample) * scale) >> 10;
-
-                destBuffer.addEvent (midiData, numBytes,
-                                     jlimit (0, numSamples - 1, samplePosition));
-            }
         }
         else
         {
-            // if our event list is shorter than the number we need, put them
-            // towards the end of the buffer
             startSample = numSamples - numSourceSamples;
+        }
 
-            while (iter.getNextEvent (midiData, numBytes, samplePosition))
+        PendingMessage m;
+
+        while (incomingMessages.pop (m))
+        {
+            int samplePosition = (int) ((m.timeStamp - lastCallbackTimeInSeconds) * sampleRate);
+
+            if (squeezeEvents)
             {
-                destBuffer.addEvent (midiData, numBytes,
-                                     jlimit (0, numSamples - 1, samplePosition + startSample));
+                if (samplePosition >= startSample)
+                    addToBuffer (destBuffer, m, jlimit (0, numSamples - 1, ((samplePosition - startSample) * scale) >> 10));
             }
+            else
+            {
+                addToBuffer (destBuffer, m, jlimit (0, numSamples - 1, samplePosition + startSample));
+            }
+
+            delete m.longMessage;
+        }
+
+        // the events were appended in the order they arrived, so this will usually just
+        // have to merge them with anything that was already in the destination buffer
+        destBuffer.sortEvents();
+    }
+}
+
+void MidiMessageCollector::removeNextBlockWithFixedLatency (MidiBuffer& destBuffer, const int numSamples,
+                                                            const double timeNow)
+{
+    lastCallbackTime = timeNow;
+
+    // The callbacks themselves arrive with some jitter, so rather than using the time of
+    // each one, this tracks a steady clock that advances by the length of each block and is
+    // pulled gently towards the actual callback times. If it gets too far out (e.g. after
+    // a glitch or a change of block size) it's resynchronised.
+    const double blockLengthMs = numSamples * 1000.0 / sampleRate;
+    double blockStartTime = timeNow;
+
+    if (expectedCallbackTime > 0)
+    {
+        const double error = timeNow - expectedCallbackTime;
+
+        if (std::abs (error) < jmax (fixedLatencyMs, blockLengthMs))
+            blockStartTime = expectedCallbackTime + error * 0.05;
+    }
+
+    expectedCallbackTime = blockStartTime + blockLengthMs;
+
+    const double samplesPerMs = sampleRate * 0.001;
+    const double latencyOffset = fixedLatencyMs - blockStartTime;
+    int numHeld = 0;
+
+    // anything held over from earlier blocks came in first, so goes before the new messages
+    for (int i = 0; i < heldMessages.size(); ++i)
+    {
+        const PendingMessage& m = heldMessages.getReference (i);
+        const int samplePosition = roundToInt ((m.timeStamp * 1000.0 + latencyOffset) * samplesPerMs);
+
+        if (samplePosition >= numSamples)
+        {
+            heldMessages.getReference (numHeld++) = m;
         }
+        else
+        {
+            addToBuffer (destBuffer, m, jmax (0, samplePosition));
+            delete m.longMessage;
+        }
+    }
+
+    heldMessages.removeLast (heldMessages.size() - numHeld);
+
+    PendingMessage m;
 
-        incomingMessages.clear();
+    while (incomingMessages.pop (m))
+    {
+        const int samplePosition = roundToInt ((m.timeStamp * 1000.0 + latencyOffset) * samplesPerMs);
+
+        if (samplePosition >= numSamples && heldMessages.size() < maxPendingMessages)
+        {
+            heldMessages.add (m);
+        }
+        else
+        {
+            addToBuffer (destBuffer, m, jlimit (0, numSamples - 1, samplePosition));
+            delete m.longMessage;
+        }
     }
+
+    destBuffer.sortEvents();
 }
 
 //==============================================================================
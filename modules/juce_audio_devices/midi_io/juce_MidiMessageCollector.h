@@ -34,6 +34,11 @@
     The class can also be used as either a MidiKeyboardStateListener or a MidiInputCallback
     so it can easily use a midi input or keyboard component as its source.
 
+    Incoming messages are passed to the audio thread through a lock-free queue, so
+    removeNextBlockOfMessages() never has to wait for a midi input thread, and
+    messages can be added from several threads at once. If the queue fills up because
+    nothing is removing the messages, the oldest ones are discarded.
+
     @see MidiMessage, MidiInput
 */
 class JUCE_API  MidiMessageCollector    : public MidiKeyboardStateListener,
@@ -55,6 +60,26 @@ public:
     */
     void reset (double sampleRate);
 
+    /** Makes the collector place each message a fixed time after its timestamp.
+
+        By default (or if the latency is 0), the messages that arrived since the last call to
+        removeNextBlockOfMessages() are spread across the next block, which keeps the delay
+        as short as possible, but means that any jitter in the timing of the audio callbacks
+        ends up in the timing of the notes.
+
+        With a fixed latency, each message is placed at the sample that is played exactly
+        this many milliseconds after the message's timestamp, and is held over to a later
+        block if necessary. As long as the latency is longer than the audio block size plus
+        any jitter in the callbacks, the gaps between the notes will be reproduced exactly.
+        Messages that arrive too late for their slot are played at the start of the block.
+
+        This should be called before the audio callbacks start, like reset().
+    */
+    void setFixedLatency (double milliseconds);
+
+    /** Returns the latency set by setFixedLatency(), or 0 if it's not being used. */
+    double getFixedLatency() const noexcept             { return fixedLatencyMs; }
+
     /** Takes an incoming real-time message and adds it to the queue.
 
         The message's timestamp is taken, and it will be ready for retrieval as part
@@ -92,10 +117,25 @@ public:
 
 private:
     //==============================================================================
+    struct PendingMessage
+    {
+        double timeStamp;
+        MidiMessage* longMessage;   // only used for messages that don't fit in data
+        uint8 data[3];
+        uint8 size;
+    };
+
+    enum { maxPendingMessages = 1024 };
+
     double lastCallbackTime;
-    CriticalSection midiCallbackLock;
-    MidiBuffer incomingMessages;
+    LockFreeQueue<PendingMessage> incomingMessages;
     double sampleRate;
+    double fixedLatencyMs, expectedCallbackTime;
+    Array<PendingMessage> heldMessages;
+
+    void clearPendingMessages();
+    void removeNextBlockWithFixedLatency (MidiBuffer&, int numSamples, double timeNow);
+    static void addToBuffer (MidiBuffer&, const PendingMessage&, int samplePosition);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiMessageCollector)
 };
@@ -35,6 +35,7 @@ struct MidiOutput::PendingMessage
 MidiOutput::MidiOutput()
     : Thread ("midi out"),
       internal (nullptr),
+      incomingMessages (maxQueuedMessages),
       firstMessage (nullptr)
 {
 }
@@ -58,11 +59,47 @@ void MidiOutput::sendBlockOfMessages (const MidiBuffer& buffer,
 
     while (i.getNextEvent (data, len, time))
     {
-        const double eventTime = millisecondCounterToStartAt + timeScaleFactor * time;
+        QueuedMessage m;
+        m.timeStamp = millisecondCounterToStartAt + timeScaleFactor * time;
+        m.longMessage = nullptr;
+        m.size = 0;
 
-        PendingMessage* const m = new PendingMessage (data, len, eventTime);
+        if (len <= (int) sizeof (m.data))
+        {
+            memcpy (m.data, data, (size_t) len);
+            m.size = (uint8) len;
+        }
+        else
+        {
+            m.longMessage = new MidiMessage (data, len, m.timeStamp);
+        }
+
+        if (! incomingMessages.push (m))
+        {
+            // The background thread isn't keeping up with the messages you're sending!
+            jassertfalse;
+            delete m.longMessage;
+            break;
+        }
+    }
+
+    notify();
+}
+
+// Moves the messages that sendBlockOfMessages() has queued into the time-ordered list.
+// The caller must hold the lock.
+void MidiOutput::addQueuedMessagesToPendingList()
+{
+    QueuedMessage q;
+
+    while (incomingMessages.pop (q))
+    {
+        PendingMessage* const m = q.longMessage != nullptr
+                                    ? new PendingMessage (q.longMessage->getRawData(), q.longMessage->getRawDataSize(), q.timeStamp)
+                                    : new PendingMessage (q.data, q.size, q.timeStamp);
+        delete q.longMessage;
 
-        const ScopedLock sl (lock);
+        const double eventTime = q.timeStamp;
 
         if (firstMessage == nullptr || firstMessage->message.getTimeStamp() > eventTime)
         {
@@ -80,14 +117,17 @@ void MidiOutput::sendBlockOfMessages (const MidiBuffer& buffer,
             mm->next = m;
         }
     }
-
-    notify();
 }
 
 void MidiOutput::clearAllPendingMessages()
 {
     const ScopedLock sl (lock);
 
+    QueuedMessage q;
+
+    while (incomingMessages.pop (q))
+        delete q.longMessage;
+
     while (firstMessage != nullptr)
     {
         PendingMessage* const m = firstMessage;
@@ -104,29 +144,36 @@ void MidiOutput::startBackgroundThread()
 void MidiOutput::stopBackgroundThread()
 {
     stopThread (5000);
+    clearAllPendingMessages();
 }
 
 void MidiOutput::run()
 {
+    // The thread sleeps until shortly before each message is due, and then spins for the
+    // last couple of milliseconds, because a wait() can easily overshoot by a millisecond
+    // or more, which is enough to be audible in a midi clock or a tight sequence.
+    const double spinTimeMs = 2.0;
+
     while (! threadShouldExit())
     {
-        uint32 now = Time::getMillisecondCounter();
-        uint32 eventTime = 0;
-        uint32 timeToWait = 500;
+        const double now = Time::getMillisecondCounterHiRes();
+        double eventTime = 0;
+        int timeToWait = 500;
 
         PendingMessage* message;
 
         {
             const ScopedLock sl (lock);
+            addQueuedMessagesToPendingList();
             message = firstMessage;
 
             if (message != nullptr)
             {
-                eventTime = (uint32) roundToInt (message->message.getTimeStamp());
+                eventTime = message->message.getTimeStamp();
 
-                if (eventTime > now + 20)
+                if (eventTime > now + spinTimeMs)
                 {
-                    timeToWait = eventTime - (now + 20);
+                    timeToWait = jmax (1, (int) (eventTime - (now + spinTimeMs)));
                     message = nullptr;
                 }
                 else
@@ -140,12 +187,12 @@ void MidiOutput::run()
         {
             const ScopedPointer<PendingMessage> messageDeleter (message);
 
-            if (eventTime > now)
+            while (Time::getMillisecondCounterHiRes() < eventTime)
             {
-                Time::waitForMillisecondCounter (eventTime);
-
                 if (threadShouldExit())
-                    break;
+                    return;
+
+                Thread::yield();
             }
 
             if (eventTime > now - 200)
@@ -154,9 +201,7 @@ void MidiOutput::run()
         else
         {
             jassert (timeToWait < 1000 * 30);
-            wait ((int) timeToWait);
+            wait (timeToWait);
         }
     }
-
-    clearAllPendingMessages();
 }
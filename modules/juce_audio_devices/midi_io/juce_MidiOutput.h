@@ -101,6 +101,13 @@ public:
 
         A time is specified, at which the block of messages should be sent. This time uses
         the same time base as Time::getMillisecondCounter(), and must be in the future.
+        It's a double, so it can be given with sub-millisecond precision, and the thread
+        times each message against Time::getMillisecondCounterHiRes().
+
+        This method doesn't take any locks or wait for the background thread, so it can be
+        called from the audio thread. Only messages longer than 3 bytes (i.e. sysex) need to
+        allocate memory. If several thousand messages are waiting to be picked up by the
+        background thread, any more will be dropped.
 
         The samplesPerSecondForBuffer parameter indicates the number of samples per second
         used by the MidiBuffer. Each event in a MidiBuffer has a sample position, and the
@@ -127,11 +134,24 @@ public:
 
 private:
     //==============================================================================
+    struct QueuedMessage
+    {
+        double timeStamp;
+        MidiMessage* longMessage;   // only used for messages that don't fit in data
+        uint8 data[3];
+        uint8 size;
+    };
+
+    enum { maxQueuedMessages = 4096 };
+
     void* internal;
     CriticalSection lock;
+    LockFreeQueue<QueuedMessage> incomingMessages;
     struct PendingMessage;
     PendingMessage* firstMessage;
 
+    void addQueuedMessagesToPendingList();
+
     MidiOutput(); // These objects are created with the openDevice() method.
     void run() override;
 
@@ -148,14 +148,17 @@ static void silentErrorHandler (const char*, int, const char*, int, const char*,
 class ALSADevice
 {
 public:
-    ALSADevice (const String& devID, bool forInput)
+    ALSADevice (const String& devID, bool forInput, Atomic<int>& xRunCounter)
         : handle (nullptr),
           bitDepth (16),
           numChannelsRunning (0),
           latency (0),
           deviceID (devID),
           isInput (forInput),
-          isInterleaved (true)
+          isInterleaved (true),
+          isMemoryMapped (false),
+          numPollDescriptors (0),
+          numXRuns (xRunCounter)
     {
         JUCE_ALSA_LOG ("snd_pcm_open (" << deviceID.toUTF8().getAddress() << ", forInput=" << forInput << ")");
 
@@ -209,6 +212,16 @@ public:
             return false;
         }
 
+        isMemoryMapped = false;
+
+       #if JUCE_ALSA_USE_MMAP
+        if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_MMAP_INTERLEAVED) >= 0)
+        {
+            isInterleaved = true;
+            isMemoryMapped = true;
+        }
+        else
+       #endif
         if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED) >= 0) // works better for plughw..
             isInterleaved = true;
         else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_NONINTERLEAVED) >= 0)
@@ -256,7 +269,7 @@ public:
         }
 
         int dir = 0;
-        unsigned int periods = 4;
+        unsigned int periods = (unsigned int) jmax (2, JUCE_ALSA_NUM_PERIODS);
         snd_pcm_uframes_t samplesPerPeriod = bufferSize;
 
         if (JUCE_ALSA_FAILED (snd_pcm_hw_params_set_rate_near (handle, hwParams, &sampleRate, 0))
@@ -289,11 +302,26 @@ public:
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_silence_size (handle, swParams, boundary))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_start_threshold (handle, swParams, samplesPerPeriod))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_stop_threshold (handle, swParams, boundary))
+            || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_avail_min (handle, swParams, samplesPerPeriod))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params (handle, swParams)))
         {
             return false;
         }
 
+        if (isMemoryMapped)
+        {
+            numPollDescriptors = snd_pcm_poll_descriptors_count (handle);
+
+            if (numPollDescriptors <= 0)
+            {
+                error = "couldn't get the device's poll descriptors";
+                return false;
+            }
+
+            pollDescriptors.calloc ((size_t) numPollDescriptors);
+            numPollDescriptors = snd_pcm_poll_descriptors (handle, pollDescriptors, (unsigned int) numPollDescriptors);
+        }
+
        #if JUCE_ALSA_LOGGING
         // enable this to dump the config of the devices that get opened
         snd_output_t* out;
@@ -314,6 +342,9 @@ public:
         float* const* const data = outputChannelBuffer.getArrayOfWritePointers();
         snd_pcm_sframes_t numDone = 0;
 
+        if (isMemoryMapped)
+            return transferMemoryMapped (data, numSamples);
+
         if (isInterleaved)
         {
             scratch.ensureSize (sizeof (float) * numSamples * numChannelsRunning, false);
@@ -331,7 +362,7 @@ public:
             numDone = snd_pcm_writen (handle, (void**) data, numSamples);
         }
 
-        if (numDone < 0 && JUCE_ALSA_FAILED (snd_pcm_recover (handle, numDone, 1 /* silent */)))
+        if (numDone < 0 && ! recover ((int) numDone))
             return false;
 
         if (numDone < numSamples)
@@ -345,6 +376,9 @@ public:
         jassert (numChannelsRunning <= inputChannelBuffer.getNumChannels());
         float* const* const data = inputChannelBuffer.getArrayOfWritePointers();
 
+        if (isMemoryMapped)
+            return transferMemoryMapped (data, numSamples);
+
         if (isInterleaved)
         {
             scratch.ensureSize (sizeof (float) * numSamples * numChannelsRunning, false);
@@ -352,7 +386,7 @@ public:
 
             snd_pcm_sframes_t num = snd_pcm_readi (handle, scratch.getData(), numSamples);
 
-            if (num < 0 && JUCE_ALSA_FAILED (snd_pcm_recover (handle, num, 1 /* silent */)))
+            if (num < 0 && ! recover ((int) num))
                 return false;
 
             if (num < numSamples)
@@ -365,7 +399,7 @@ public:
         {
             snd_pcm_sframes_t num = snd_pcm_readn (handle, (void**) data, numSamples);
 
-            if (num < 0 && JUCE_ALSA_FAILED (snd_pcm_recover (handle, num, 1 /* silent */)))
+            if (num < 0 && ! recover ((int) num))
                 return false;
 
             if (num < numSamples)
@@ -378,6 +412,32 @@ public:
         return true;
     }
 
+    /** Returns the number of frames between the application pointer and the
+        hardware, i.e. how much is queued for playback, or waiting to be read.
+    */
+    int getCurrentDelay()
+    {
+        snd_pcm_sframes_t delay = 0;
+
+        if (handle == nullptr || snd_pcm_delay (handle, &delay) < 0)
+            return -1;
+
+        return (int) delay;
+    }
+
+    bool usesMemoryMapping() const noexcept     { return isMemoryMapped; }
+
+    /** Recovers from an error returned by a read, write or avail call, counting
+        it if it was an xrun.
+    */
+    bool recover (const int err, const bool silent = true)
+    {
+        if (err == -EPIPE)
+            ++numXRuns;
+
+        return ! JUCE_ALSA_FAILED (snd_pcm_recover (handle, err, silent ? 1 : 0));
+    }
+
     //==============================================================================
     snd_pcm_t* handle;
     String error;
@@ -387,9 +447,124 @@ private:
     //==============================================================================
     String deviceID;
     const bool isInput;
-    bool isInterleaved;
+    bool isInterleaved, isMemoryMapped;
     MemoryBlock scratch;
     ScopedPointer<AudioData::Converter> converter;
+    HeapBlock<struct pollfd> pollDescriptors;
+    int numPollDescriptors;
+    Atomic<int>& numXRuns;
+
+    //==============================================================================
+    // Copies directly to or from the device's mapped ring buffer, waiting on its
+    // poll descriptors whenever there isn't enough space or data available yet.
+    bool transferMemoryMapped (float* const* const data, const int numSamples)
+    {
+        int numDone = 0;
+
+        while (numDone < numSamples)
+        {
+            // a capture stream won't start by itself in mmap mode (and if it's linked to
+            // the output, this'll start that too, which will then play silence until it's
+            // given some data)
+            if (isInput && snd_pcm_state (handle) == SND_PCM_STATE_PREPARED
+                  && JUCE_ALSA_FAILED (snd_pcm_start (handle)))
+                return false;
+
+            const snd_pcm_sframes_t avail = snd_pcm_avail_update (handle);
+
+            if (avail < 0)
+            {
+                if (! recover ((int) avail))
+                    return false;
+
+                continue;
+            }
+
+            if (avail < numSamples - numDone)
+            {
+                if (! waitForPollDescriptors (2000))
+                    return false;
+
+                continue;
+            }
+
+            const snd_pcm_channel_area_t* areas = nullptr;
+            snd_pcm_uframes_t offset = 0;
+            snd_pcm_uframes_t frames = (snd_pcm_uframes_t) (numSamples - numDone);
+
+            if (JUCE_ALSA_FAILED (snd_pcm_mmap_begin (handle, &areas, &offset, &frames)))
+                return false;
+
+            // for interleaved access, all the channels share one area, with their samples
+            // laid out the same way as in the scratch buffer used for snd_pcm_writei
+            char* const mapped = static_cast<char*> (areas[0].addr)
+                                   + (areas[0].first + offset * areas[0].step) / 8;
+
+            for (int i = 0; i < numChannelsRunning; ++i)
+            {
+                if (isInput)
+                    converter->convertSamples (data[i] + numDone, 0, mapped, i, (int) frames);
+                else
+                    converter->convertSamples (mapped, i, data[i] + numDone, 0, (int) frames);
+            }
+
+            const snd_pcm_sframes_t committed = snd_pcm_mmap_commit (handle, offset, frames);
+
+            if (committed < 0 || (snd_pcm_uframes_t) committed != frames)
+            {
+                JUCE_ALSA_LOG ("mmap commit failed: " << (int) committed << ", frames: " << (int) frames);
+
+                if (! recover (committed >= 0 ? -EPIPE : (int) committed))
+                    return false;
+
+                continue;
+            }
+
+            numDone += (int) frames;
+
+            if ((! isInput) && snd_pcm_state (handle) == SND_PCM_STATE_PREPARED
+                  && JUCE_ALSA_FAILED (snd_pcm_start (handle)))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool waitForPollDescriptors (const int timeoutMs)
+    {
+        for (;;)
+        {
+            const int result = poll (pollDescriptors, (nfds_t) numPollDescriptors, timeoutMs);
+
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                JUCE_ALSA_LOG ("poll failed: " << errno);
+                return false;
+            }
+
+            if (result == 0)
+            {
+                JUCE_ALSA_LOG ("poll timed out");
+                return false;
+            }
+
+            unsigned short revents = 0;
+
+            if (JUCE_ALSA_FAILED (snd_pcm_poll_descriptors_revents (handle, pollDescriptors,
+                                                                     (unsigned int) numPollDescriptors, &revents)))
+                return false;
+
+            if ((revents & POLLNVAL) != 0)
+                return false;
+
+            // (an xrun shows up as POLLERR, which the caller's avail_update will then report)
+            if ((revents & (POLLERR | (isInput ? POLLIN : POLLOUT))) != 0)
+                return true;
+        }
+    }
 
     //==============================================================================
     template <class SampleType>
@@ -483,6 +658,7 @@ public:
         close();
 
         error.clear();
+        numXRuns = 0;
         sampleRate = newSampleRate;
         bufferSize = newBufferSize;
 
@@ -524,7 +700,7 @@ public:
 
         if (outputChannelDataForCallback.size() > 0 && outputId.isNotEmpty())
         {
-            outputDevice = new ALSADevice (outputId, false);
+            outputDevice = new ALSADevice (outputId, false, numXRuns);
 
             if (outputDevice->error.isNotEmpty())
             {
@@ -548,7 +724,7 @@ public:
 
         if (inputChannelDataForCallback.size() > 0 && inputId.isNotEmpty())
         {
-            inputDevice = new ALSADevice (inputId, true);
+            inputDevice = new ALSADevice (inputId, true, numXRuns);
 
             if (inputDevice->error.isNotEmpty())
             {
@@ -642,11 +818,28 @@ public:
 
     void run() override
     {
+       #if JUCE_ALSA_REALTIME_PRIORITY > 0
+        setRealtimePriority (JUCE_ALSA_REALTIME_PRIORITY);
+       #else
+        {
+            const double periodMs = bufferSize * 1000.0 / sampleRate;
+            Thread::setCurrentThreadRealtime (periodMs, periodMs * 0.5, periodMs, 9);
+        }
+       #endif
+
+        int numLatencyMeasurements = 0;
+
         while (! threadShouldExit())
         {
+            const bool shouldMeasureLatency = numLatencyMeasurements < numCallbacksToMeasureLatency;
+
             if (inputDevice != nullptr && inputDevice->handle != nullptr)
             {
-                if (outputDevice == nullptr || outputDevice->handle == nullptr)
+                if (shouldMeasureLatency)
+                    updateMeasuredLatency (inputLatency, inputDevice->getCurrentDelay(), numLatencyMeasurements);
+
+                if ((outputDevice == nullptr || outputDevice->handle == nullptr)
+                      && ! inputDevice->usesMemoryMapping())
                 {
                     JUCE_ALSA_FAILED (snd_pcm_wait (inputDevice->handle, 2000));
 
@@ -656,7 +849,7 @@ public:
                     snd_pcm_sframes_t avail = snd_pcm_avail_update (inputDevice->handle);
 
                     if (avail < 0)
-                        JUCE_ALSA_FAILED (snd_pcm_recover (inputDevice->handle, avail, 0));
+                        inputDevice->recover ((int) avail, false);
                 }
 
                 audioIoInProgress = true;
@@ -694,15 +887,18 @@ public:
 
             if (outputDevice != nullptr && outputDevice->handle != nullptr)
             {
-                JUCE_ALSA_FAILED (snd_pcm_wait (outputDevice->handle, 2000));
+                if (! outputDevice->usesMemoryMapping())
+                {
+                    JUCE_ALSA_FAILED (snd_pcm_wait (outputDevice->handle, 2000));
 
-                if (threadShouldExit())
-                    break;
+                    if (threadShouldExit())
+                        break;
 
-                snd_pcm_sframes_t avail = snd_pcm_avail_update (outputDevice->handle);
+                    snd_pcm_sframes_t avail = snd_pcm_avail_update (outputDevice->handle);
 
-                if (avail < 0)
-                    JUCE_ALSA_FAILED (snd_pcm_recover (outputDevice->handle, avail, 0));
+                    if (avail < 0)
+                        outputDevice->recover ((int) avail, false);
+                }
 
                 audioIoInProgress = true;
 
@@ -713,7 +909,13 @@ public:
                 }
 
                 audioIoInProgress = false;
+
+                if (shouldMeasureLatency)
+                    updateMeasuredLatency (outputLatency, outputDevice->getCurrentDelay(), numLatencyMeasurements);
             }
+
+            if (shouldMeasureLatency)
+                ++numLatencyMeasurements;
         }
 
         audioIoInProgress = false;
@@ -739,6 +941,7 @@ public:
     Array<double> sampleRates;
     StringArray channelNamesOut, channelNamesIn;
     AudioIODeviceCallback* callback;
+    Atomic<int> numXRuns;
 
 private:
     //==============================================================================
@@ -756,6 +959,26 @@ private:
     unsigned int minChansOut, maxChansOut;
     unsigned int minChansIn, maxChansIn;
 
+    // For the first few callbacks, the latencies are updated with the largest delays that
+    // the devices actually report, which is more accurate than guessing from the periods.
+    enum { numCallbacksToMeasureLatency = 64 };
+
+    static void updateMeasuredLatency (int& latency, const int delay, const int numMeasurements) noexcept
+    {
+        if (delay >= 0)
+            latency = numMeasurements == 0 ? delay : jmax (latency, delay);
+    }
+
+    void setRealtimePriority (const int priority)
+    {
+        struct sched_param param;
+        param.sched_priority = jlimit (sched_get_priority_min (SCHED_FIFO),
+                                       sched_get_priority_max (SCHED_FIFO), priority);
+
+        if (pthread_setschedparam (pthread_self(), SCHED_FIFO, &param) != 0)
+            JUCE_ALSA_LOG ("Couldn't switch to SCHED_FIFO, priority " << param.sched_priority);
+    }
+
     bool failed (const int errorNum)
     {
         if (errorNum >= 0)
@@ -888,6 +1111,7 @@ public:
 
     int getOutputLatencyInSamples() override         { return internal.outputLatency; }
     int getInputLatencyInSamples() override          { return internal.inputLatency; }
+    int getXRunCount() const noexcept override       { return internal.numXRuns.get(); }
 
     void start (AudioIODeviceCallback* callback) override
     {
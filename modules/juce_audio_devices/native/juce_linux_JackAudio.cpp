@@ -69,6 +69,8 @@ JUCE_DECL_JACK_FUNCTION (void*, jack_set_port_connect_callback, (jack_client_t*
 JUCE_DECL_JACK_FUNCTION (jack_port_t* , jack_port_by_id, (jack_client_t* client, jack_port_id_t port_id), (client, port_id));
 JUCE_DECL_JACK_FUNCTION (int, jack_port_connected, (const jack_port_t* port), (port));
 JUCE_DECL_JACK_FUNCTION (int, jack_port_connected_to, (const jack_port_t* port, const char* port_name), (port, port_name));
+JUCE_DECL_JACK_FUNCTION (int, jack_set_xrun_callback, (jack_client_t* client, JackXRunCallback xrun_callback, void* arg), (client, xrun_callback, arg));
+JUCE_DECL_JACK_FUNCTION (jack_transport_state_t, jack_transport_query, (const jack_client_t* client, jack_position_t* pos), (client, pos));
 
 #if JUCE_DEBUG
  #define JACK_LOGGING_ENABLED 1
@@ -143,7 +145,8 @@ class JackAudioIODeviceType;
 static Array<JackAudioIODeviceType*> activeDeviceTypes;
 
 //==============================================================================
-class JackAudioIODevice   : public AudioIODevice
+class JackAudioIODevice   : public AudioIODevice,
+                            private AudioPlayHead
 {
 public:
     JackAudioIODevice (const String& deviceName,
@@ -258,8 +261,11 @@ public:
         lastError.clear();
         close();
 
+        numXRuns = 0;
+
         juce::jack_set_process_callback (client, processCallback, this);
         juce::jack_set_port_connect_callback (client, portConnectCallback, this);
+        juce::jack_set_xrun_callback (client, xrunCallback, this);
         juce::jack_on_shutdown (client, shutdownCallback, this);
         juce::jack_activate (client);
         deviceIsOpen = true;
@@ -302,6 +308,7 @@ public:
             juce::jack_deactivate (client);
             juce::jack_set_process_callback (client, processCallback, nullptr);
             juce::jack_set_port_connect_callback (client, portConnectCallback, nullptr);
+            juce::jack_set_xrun_callback (client, xrunCallback, nullptr);
             juce::jack_on_shutdown (client, shutdownCallback, nullptr);
         }
 
@@ -336,6 +343,8 @@ public:
     bool isPlaying() override                        { return callback != nullptr; }
     int getCurrentBitDepth() override                { return 32; }
     String getLastError() override                   { return lastError; }
+    int getXRunCount() const noexcept override       { return numXRuns.get(); }
+    AudioPlayHead* getPlayHead() override            { return this; }
 
     BigInteger getActiveOutputChannels() const override  { return activeOutputChannels; }
     BigInteger getActiveInputChannels()  const override  { return activeInputChannels;  }
@@ -363,6 +372,43 @@ public:
     String inputId, outputId;
 
 private:
+    // The JACK transport's position. The callback receives the port buffers themselves, so
+    // this describes exactly the block that's being processed.
+    bool getCurrentPosition (CurrentPositionInfo& result) override
+    {
+        if (client == nullptr)
+            return false;
+
+        jack_position_t pos;
+        zerostruct (pos);
+        const jack_transport_state_t state = juce::jack_transport_query (client, &pos);
+
+        result.resetToDefault();
+        result.frameRate = fpsUnknown;
+        result.isPlaying = (state == JackTransportRolling);
+        result.timeInSamples = (int64) pos.frame;
+        result.timeInSeconds = pos.frame_rate > 0 ? pos.frame / (double) pos.frame_rate : 0.0;
+
+        if ((pos.valid & JackPositionBBT) != 0 && pos.beat_type > 0 && pos.beats_per_minute > 0)
+        {
+            const double quarterNotesPerBeat = 4.0 / pos.beat_type;
+            const double beatsToBarStart = (pos.bar - 1) * (double) pos.beats_per_bar;
+            const double beatsInBar = (pos.beat - 1) + (pos.ticks_per_beat > 0 ? pos.tick / pos.ticks_per_beat : 0.0);
+
+            result.bpm = pos.beats_per_minute;
+            result.timeSigNumerator = (int) pos.beats_per_bar;
+            result.timeSigDenominator = (int) pos.beat_type;
+            result.ppqPositionOfLastBarStart = beatsToBarStart * quarterNotesPerBeat;
+            result.ppqPosition = (beatsToBarStart + beatsInBar) * quarterNotesPerBeat;
+        }
+        else
+        {
+            result.ppqPosition = result.timeInSeconds * result.bpm / 60.0;
+        }
+
+        return true;
+    }
+
     void process (const int numSamples)
     {
         int numActiveInChans = 0, numActiveOutChans = 0;
@@ -441,6 +487,14 @@ private:
             device->updateActivePorts();
     }
 
+    static int xrunCallback (void* callbackArgument)
+    {
+        if (JackAudioIODevice* device = static_cast <JackAudioIODevice*> (callbackArgument))
+            ++(device->numXRuns);
+
+        return 0;
+    }
+
     static void threadInitCallback (void* /* callbackArgument */)
     {
         JUCE_JACK_LOG ("JackAudioIODevice::initialise");
@@ -475,6 +529,7 @@ private:
     int totalNumberOfOutputChannels;
     Array<void*> inputPorts, outputPorts;
     BigInteger activeInputChannels, activeOutputChannels;
+    Atomic<int> numXRuns;
 };
 
 
@@ -46,16 +46,33 @@ public:
     typedef ReferenceCountedObjectPtr<AlsaClient> Ptr;
 
     AlsaClient (bool forInput)
-        : input (forInput), handle (nullptr)
+        : input (forInput), handle (nullptr), timestampQueue (-1), queueStartTime (0)
     {
         snd_seq_open (&handle, "default", forInput ? SND_SEQ_OPEN_INPUT
                                                    : SND_SEQ_OPEN_OUTPUT, 0);
+
+        // input ports ask the sequencer to stamp each event with the real time at which
+        // it arrived, measured on this queue
+        if (forInput && handle != nullptr)
+        {
+            timestampQueue = snd_seq_alloc_queue (handle);
+
+            if (timestampQueue >= 0)
+            {
+                snd_seq_start_queue (handle, timestampQueue, nullptr);
+                snd_seq_drain_output (handle);
+                queueStartTime = Time::getMillisecondCounterHiRes();
+            }
+        }
     }
 
     ~AlsaClient()
     {
         if (handle != nullptr)
         {
+            if (timestampQueue >= 0)
+                snd_seq_free_queue (handle, timestampQueue);
+
             snd_seq_close (handle);
             handle = nullptr;
         }
@@ -106,10 +123,25 @@ public:
     void handleIncomingMidiMessage (const MidiMessage& message, int port);
 
     snd_seq_t* get() const noexcept     { return handle; }
+    int getTimestampQueue() const noexcept  { return timestampQueue; }
+
+    double getEventTimeInSeconds (const snd_seq_event_t& e) const
+    {
+        const double timeNow = Time::getMillisecondCounterHiRes();
+
+        if (timestampQueue < 0 || e.queue != timestampQueue
+             || (e.flags & SND_SEQ_TIME_STAMP_MASK) != SND_SEQ_TIME_STAMP_REAL)
+            return timeNow * 0.001;
+
+        const double t = queueStartTime + e.time.time.tv_sec * 1000.0 + e.time.time.tv_nsec * 1.0e-6;
+        return jmin (t, timeNow) * 0.001;
+    }
 
 private:
     bool input;
     snd_seq_t* handle;
+    int timestampQueue;
+    double queueStartTime;
 
     Array<AlsaPortAndCallback*> activeCallbacks;
     CriticalSection callbackLock;
@@ -162,7 +194,7 @@ private:
                                 if (numBytes > 0)
                                 {
                                     const MidiMessage message ((const uint8*) buffer, numBytes,
-                                                               Time::getMillisecondCounter() * 0.001);
+                                                               client.getEventTimeInSeconds (*inputEvent));
 
                                     client.handleIncomingMidiMessage (message, inputEvent->dest.port);
                                 }
@@ -217,10 +249,32 @@ public:
         client = c;
 
         if (snd_seq_t* handle = client->get())
-            portId = snd_seq_create_simple_port (handle, name.toUTF8(),
-                                                 forInput ? (SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_SUBS_WRITE)
-                                                          : (SND_SEQ_PORT_CAP_READ  | SND_SEQ_PORT_CAP_SUBS_READ),
-                                                 SND_SEQ_PORT_TYPE_MIDI_GENERIC);
+        {
+            snd_seq_port_info_t* portInfo = nullptr;
+
+            if (forInput && client->getTimestampQueue() >= 0
+                 && snd_seq_port_info_malloc (&portInfo) == 0)
+            {
+                snd_seq_port_info_set_name (portInfo, name.toUTF8());
+                snd_seq_port_info_set_capability (portInfo, SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_SUBS_WRITE);
+                snd_seq_port_info_set_type (portInfo, SND_SEQ_PORT_TYPE_MIDI_GENERIC | SND_SEQ_PORT_TYPE_APPLICATION);
+                snd_seq_port_info_set_timestamping (portInfo, 1);
+                snd_seq_port_info_set_timestamp_real (portInfo, 1);
+                snd_seq_port_info_set_timestamp_queue (portInfo, client->getTimestampQueue());
+
+                if (snd_seq_create_port (handle, portInfo) == 0)
+                    portId = snd_seq_port_info_get_port (portInfo);
+
+                snd_seq_port_info_free (portInfo);
+            }
+            else
+            {
+                portId = snd_seq_create_simple_port (handle, name.toUTF8(),
+                                                     forInput ? (SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_SUBS_WRITE)
+                                                              : (SND_SEQ_PORT_CAP_READ  | SND_SEQ_PORT_CAP_SUBS_READ),
+                                                     SND_SEQ_PORT_TYPE_MIDI_GENERIC);
+            }
+        }
     }
 
     void deletePort()
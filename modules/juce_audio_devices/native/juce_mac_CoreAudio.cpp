@@ -587,6 +587,7 @@ public:
         if (! started)
         {
             callback = nullptr;
+            numXRuns = 0;
 
             if (deviceID != 0)
             {
@@ -761,6 +762,7 @@ public:
    #if MAC_OS_X_VERSION_MIN_REQUIRED >= MAC_OS_X_VERSION_10_5
     AudioDeviceIOProcID audioProcID;
    #endif
+    Atomic<int> numXRuns;
 
 private:
     CriticalSection callbackLock;
@@ -803,6 +805,10 @@ private:
                 intern->deviceDetailsChanged();
                 break;
 
+            case kAudioDeviceProcessorOverload:
+                ++(intern->numXRuns);
+                break;
+
             case kAudioDevicePropertyBufferSizeRange:
             case kAudioDevicePropertyVolumeScalar:
             case kAudioDevicePropertyMute:
@@ -975,6 +981,11 @@ public:
         return internal->inputLatency;
     }
 
+    int getXRunCount() const noexcept override
+    {
+        return internal->numXRuns.get();
+    }
+
     void start (AudioIODeviceCallback* callback) override
     {
         if (! isStarted)
@@ -1293,6 +1304,16 @@ public:
         return lat + currentBufferSize * 2;
     }
 
+    int getXRunCount() const noexcept override
+    {
+        int numXRuns = 0;
+
+        for (int i = 0; i < devices.size(); ++i)
+            numXRuns += jmax (0, devices.getUnchecked(i)->device->getXRunCount());
+
+        return numXRuns;
+    }
+
     void start (AudioIODeviceCallback* newCallback) override
     {
         if (callback != newCallback)
@@ -44,6 +44,26 @@ namespace CoreMidiHelpers
     #undef CHECK_ERROR
     #define CHECK_ERROR(a) CoreMidiHelpers::checkError (a, __LINE__)
 
+    //==============================================================================
+    // Converts a packet's host time into the same timebase as Time::getMillisecondCounterHiRes(),
+    // which is also derived from mach_absolute_time(). A timestamp of zero means "now".
+    static double getPacketTimeInSeconds (const MIDITimeStamp timeStamp, const double timeNow)
+    {
+        if (timeStamp == 0)
+            return timeNow;
+
+        static double hostTimeToSeconds = 0;
+
+        if (hostTimeToSeconds == 0)
+        {
+            mach_timebase_info_data_t timebase;
+            (void) mach_timebase_info (&timebase);
+            hostTimeToSeconds = timebase.numer / (timebase.denom * 1.0e9);
+        }
+
+        return jmin (timeNow, timeStamp * hostTimeToSeconds);
+    }
+
     //==============================================================================
     static String getMidiObjectName (MIDIObjectRef entity)
     {
@@ -283,7 +303,8 @@ namespace CoreMidiHelpers
 
                 for (unsigned int i = 0; i < pktlist->numPackets; ++i)
                 {
-                    concatenator.pushMidiData (packet->data, (int) packet->length, time,
+                    concatenator.pushMidiData (packet->data, (int) packet->length,
+                                               getPacketTimeInSeconds (packet->timeStamp, time),
                                                input, callback);
 
                     packet = MIDIPacketNext (packet);
@@ -130,6 +130,7 @@ enum EDataFlow
 enum
 {
     DEVICE_STATE_ACTIVE = 1,
+    AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY = 1,
     AUDCLNT_BUFFERFLAGS_SILENT = 2
 };
 
@@ -190,14 +191,6 @@ JUCE_COMCLASS (MMDeviceEnumerator, "BCDE0395-E52F-467C-8E3D-C4579291692E");
 
 typedef LONGLONG REFERENCE_TIME;
 
-enum AVRT_PRIORITY
-{
-    AVRT_PRIORITY_LOW = -1,
-    AVRT_PRIORITY_NORMAL,
-    AVRT_PRIORITY_HIGH,
-    AVRT_PRIORITY_CRITICAL
-};
-
 enum AUDCLNT_SHAREMODE
 {
     AUDCLNT_SHAREMODE_SHARED,
@@ -220,6 +213,21 @@ JUCE_IUNKNOWNCLASS (IAudioClient, "1CB9AD4C-DBFA-4c32-B178-C2F568A703B2")
     JUCE_COMCALL GetService (REFIID, void**) = 0;
 };
 
+JUCE_COMCLASS (IAudioClient2, "726778CD-F60A-4eda-82DE-E47610CD78AA")  : public IAudioClient
+{
+    JUCE_COMCALL IsOffloadCapable (int /*AUDIO_STREAM_CATEGORY*/, BOOL*) = 0;
+    JUCE_COMCALL SetClientProperties (const void* /*AudioClientProperties*/) = 0;
+    JUCE_COMCALL GetBufferSizeLimits (const WAVEFORMATEX*, BOOL, REFERENCE_TIME*, REFERENCE_TIME*) = 0;
+};
+
+// (only available from Windows 10 onwards)
+JUCE_COMCLASS (IAudioClient3, "7ED4EE07-8E67-4CD4-8C1A-2B7A5987AD42")  : public IAudioClient2
+{
+    JUCE_COMCALL GetSharedModeEnginePeriod (const WAVEFORMATEX*, UINT32*, UINT32*, UINT32*, UINT32*) = 0;
+    JUCE_COMCALL GetCurrentSharedModeEnginePeriod (WAVEFORMATEX**, UINT32*) = 0;
+    JUCE_COMCALL InitializeSharedAudioStream (DWORD, UINT32, const WAVEFORMATEX*, LPCGUID) = 0;
+};
+
 JUCE_IUNKNOWNCLASS (IAudioCaptureClient, "C8ADBD64-E71E-48a0-A4DE-185C395CD317")
 {
     JUCE_COMCALL GetBuffer (BYTE**, UINT32*, DWORD*, UINT64*, UINT64*) = 0;
@@ -361,7 +369,10 @@ public:
           actualBufferSize (0),
           bytesPerSample (0),
           bytesPerFrame (0),
-          sampleRateHasChanged (false)
+          sampleRateHasChanged (false),
+          lowLatencyMinPeriod (0),
+          lowLatencyMaxPeriod (0),
+          lowLatencyPeriodGranularity (0)
     {
         clientEvent = CreateEvent (nullptr, false, false, nullptr);
 
@@ -379,7 +390,6 @@ public:
 
         WAVEFORMATEXTENSIBLE format;
         copyWavFormat (format, mixFormat);
-        CoTaskMemFree (mixFormat);
 
         actualNumChannels = numChannels = format.Format.nChannels;
         defaultSampleRate = format.Format.nSamplesPerSec;
@@ -387,6 +397,26 @@ public:
         defaultBufferSize = refTimeToSamples (defaultPeriod, defaultSampleRate);
         mixFormatChannelMask = format.dwChannelMask;
 
+        if (! useExclusiveMode)
+        {
+            // On Windows 10, the shared-mode engine can run at a shorter period than its
+            // default, if the stream uses the engine's own format
+            ComSmartPtr<IAudioClient3> client3;
+            UINT32 defaultFrames = 0, granularity = 0, minFrames = 0, maxFrames = 0;
+
+            if (SUCCEEDED (tempClient.QueryInterface (client3))
+                 && check (client3->GetSharedModeEnginePeriod (mixFormat, &defaultFrames, &granularity, &minFrames, &maxFrames))
+                 && granularity > 0 && minFrames > 0)
+            {
+                lowLatencyMinPeriod = (int) minFrames;
+                lowLatencyMaxPeriod = (int) maxFrames;
+                lowLatencyPeriodGranularity = (int) granularity;
+                minBufferSize = jmin (minBufferSize, lowLatencyMinPeriod);
+            }
+        }
+
+        CoTaskMemFree (mixFormat);
+
         rates.addUsingDefaultSort (defaultSampleRate);
 
         if (useExclusiveMode
@@ -487,6 +517,11 @@ public:
     UINT32 actualBufferSize;
     int bytesPerSample, bytesPerFrame;
     bool sampleRateHasChanged;
+    Atomic<int> numXRuns;
+
+    // the shared-mode engine periods (in samples at the default rate) that IAudioClient3
+    // allows, or 0 if it isn't available
+    int lowLatencyMinPeriod, lowLatencyMaxPeriod, lowLatencyPeriodGranularity;
 
     virtual void updateFormat (bool isFloat) = 0;
 
@@ -626,12 +661,58 @@ private:
         return false;
     }
 
+    void formatInitialised (const WAVEFORMATEXTENSIBLE& format)
+    {
+        actualNumChannels  = format.Format.nChannels;
+        const bool isFloat = format.Format.wFormatTag == WAVE_FORMAT_EXTENSIBLE && format.SubFormat == KSDATAFORMAT_SUBTYPE_IEEE_FLOAT;
+        bytesPerSample     = format.Format.wBitsPerSample / 8;
+        bytesPerFrame      = format.Format.nBlockAlign;
+
+        updateFormat (isFloat);
+    }
+
+    // Tries to open a shared-mode stream whose engine period matches the buffer size, which
+    // only works on Windows 10 and when the format is the same as the engine's mix format.
+    bool tryInitialisingLowLatencySharedStream (const WAVEFORMATEXTENSIBLE& format, const int bufferSizeSamples)
+    {
+        if (useExclusiveMode || lowLatencyPeriodGranularity <= 0 || bufferSizeSamples <= 0
+             || sampleRate != defaultSampleRate)
+            return false;
+
+        ComSmartPtr<IAudioClient3> client3;
+
+        if (FAILED (client.QueryInterface (client3)))
+            return false;
+
+        int periodFrames = jlimit (lowLatencyMinPeriod, lowLatencyMaxPeriod, bufferSizeSamples);
+        periodFrames = lowLatencyMinPeriod + lowLatencyPeriodGranularity
+                         * ((periodFrames - lowLatencyMinPeriod) / lowLatencyPeriodGranularity);
+
+        if (! check (client3->InitializeSharedAudioStream (0x40000 /*AUDCLNT_STREAMFLAGS_EVENTCALLBACK*/,
+                                                           (UINT32) periodFrames, (const WAVEFORMATEX*) &format, nullptr)))
+        {
+            // a failed initialisation leaves the client unusable, so start again with a new one
+            client = nullptr;
+            client = createClient();
+            return false;
+        }
+
+        formatInitialised (format);
+        return true;
+    }
+
     bool tryInitialisingWithBufferSize (const int bufferSizeSamples)
     {
         WAVEFORMATEXTENSIBLE format;
 
         if (findSupportedFormat (client, sampleRate, mixFormatChannelMask, format))
         {
+            if (tryInitialisingLowLatencySharedStream (format, bufferSizeSamples))
+                return true;
+
+            if (client == nullptr)
+                return false;
+
             REFERENCE_TIME defaultPeriod = 0, minPeriod = 0;
 
             check (client->GetDevicePeriod (&defaultPeriod, &minPeriod));
@@ -648,12 +729,7 @@ private:
 
                 if (check (hr))
                 {
-                    actualNumChannels  = format.Format.nChannels;
-                    const bool isFloat = format.Format.wFormatTag == WAVE_FORMAT_EXTENSIBLE && format.SubFormat == KSDATAFORMAT_SUBTYPE_IEEE_FLOAT;
-                    bytesPerSample     = format.Format.wBitsPerSample / 8;
-                    bytesPerFrame      = format.Format.nBlockAlign;
-
-                    updateFormat (isFloat);
+                    formatInitialised (format);
                     return true;
                 }
 
@@ -685,7 +761,8 @@ class WASAPIInputDevice  : public WASAPIDeviceBase
 public:
     WASAPIInputDevice (const ComSmartPtr<IMMDevice>& d, const bool exclusiveMode)
         : WASAPIDeviceBase (d, exclusiveMode),
-          reservoir (1, 1)
+          reservoir (1, 1),
+          compensateForDrift (false)
     {
     }
 
@@ -730,6 +807,7 @@ public:
         reservoirMask = nextPowerOfTwo (reservoirSize) - 1;
         reservoir.setSize ((reservoirMask + 1) * bytesPerFrame, true);
         reservoirReadPos = reservoirWritePos = 0;
+        numLevelReadings = 0;
 
         if (! check (client->Start()))
             return false;
@@ -764,6 +842,9 @@ public:
         {
             int samplesLeft = (int) numSamplesAvailable;
 
+            if ((flags & AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY) != 0)
+                ++numXRuns;
+
             while (samplesLeft > 0)
             {
                 const int localWrite = reservoirWritePos & reservoirMask;
@@ -783,7 +864,11 @@ public:
             }
 
             if (getNumSamplesInReservoir() > reservoirSize)
+            {
                 reservoirReadPos = reservoirWritePos - reservoirSize;
+                numLevelReadings = 0;
+                ++numXRuns;
+            }
 
             captureClient->ReleaseBuffer (numSamplesAvailable);
         }
@@ -798,11 +883,14 @@ public:
 
         if (offset > 0)
         {
+            ++numXRuns;
+
             for (int i = 0; i < numDestBuffers; ++i)
                 zeromem (destBuffers[i], offset * sizeof (float));
 
             bufferSize -= offset;
             reservoirReadPos -= offset / 2;
+            numLevelReadings = 0;
         }
 
         while (bufferSize > 0)
@@ -822,6 +910,42 @@ public:
             offset += samplesToDo;
             reservoirReadPos += samplesToDo;
         }
+
+        if (compensateForDrift)
+            updateDriftCompensation();
+    }
+
+    // When the input and output are separate devices, their clocks never quite agree, so
+    // the reservoir slowly fills up or drains until it glitches. Instead, this watches its
+    // average level and drops or repeats a single frame whenever it wanders too far from
+    // the level it settled at when the stream started.
+    void updateDriftCompensation()
+    {
+        const double level = getNumSamplesInReservoir();
+
+        if (numLevelReadings < 256)
+        {
+            averageReservoirLevel = numLevelReadings == 0 ? level
+                                                          : averageReservoirLevel + (level - averageReservoirLevel) / (numLevelReadings + 1);
+            targetReservoirLevel = averageReservoirLevel;
+            ++numLevelReadings;
+            return;
+        }
+
+        averageReservoirLevel += (level - averageReservoirLevel) * 0.01;
+
+        const double tolerance = 8.0;
+
+        if (averageReservoirLevel > targetReservoirLevel + tolerance && level > 0)
+        {
+            ++reservoirReadPos;
+            averageReservoirLevel -= 1.0;
+        }
+        else if (averageReservoirLevel < targetReservoirLevel - tolerance && level < reservoirMask)
+        {
+            --reservoirReadPos;
+            averageReservoirLevel += 1.0;
+        }
     }
 
     ComSmartPtr<IAudioCaptureClient> captureClient;
@@ -829,6 +953,10 @@ public:
     int reservoirSize, reservoirMask;
     volatile int reservoirReadPos, reservoirWritePos;
 
+    bool compensateForDrift;
+    int numLevelReadings;
+    double averageReservoirLevel, targetReservoirLevel;
+
     ScopedPointer<AudioData::Converter> converter;
 
 private:
@@ -1063,6 +1191,12 @@ public:
     BigInteger getActiveInputChannels() const override      { return inputDevice  != nullptr ? inputDevice->channels  : BigInteger(); }
     String getLastError() override                          { return lastError; }
 
+    int getXRunCount() const noexcept override
+    {
+        return (inputDevice  != nullptr ? inputDevice->numXRuns.get()  : 0)
+             + (outputDevice != nullptr ? outputDevice->numXRuns.get() : 0);
+    }
+
 
     String open (const BigInteger& inputChannels, const BigInteger& outputChannels,
                  double sampleRate, int bufferSizeSamples) override
@@ -1111,6 +1245,12 @@ public:
         if (inputDevice != nullptr)   ResetEvent (inputDevice->clientEvent);
         if (outputDevice != nullptr)  ResetEvent (outputDevice->clientEvent);
 
+        if (inputDevice != nullptr)   inputDevice->numXRuns = 0;
+        if (outputDevice != nullptr)  outputDevice->numXRuns = 0;
+
+        if (inputDevice != nullptr)
+            inputDevice->compensateForDrift = outputDevice != nullptr && outputDevice->client != nullptr;
+
         startThread (8);
         Thread::sleep (5);
 
@@ -1196,25 +1336,13 @@ public:
         }
     }
 
-    void setMMThreadPriority()
+    void run() override
     {
-        DynamicLibrary dll ("avrt.dll");
-        JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadCharacteristicsW, avSetMmThreadCharacteristics, HANDLE, (LPCWSTR, LPDWORD))
-        JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadPriority, avSetMmThreadPriority, HANDLE, (HANDLE, AVRT_PRIORITY))
-
-        if (avSetMmThreadCharacteristics != 0 && avSetMmThreadPriority != 0)
         {
-            DWORD dummy = 0;
-            HANDLE h = avSetMmThreadCharacteristics (L"Pro Audio", &dummy);
-
-            if (h != 0)
-                avSetMmThreadPriority (h, AVRT_PRIORITY_NORMAL);
+            // (a priority of 8 gives the normal MMCSS "Pro Audio" priority)
+            const double periodMs = currentBufferSizeSamples * 1000.0 / currentSampleRate;
+            Thread::setCurrentThreadRealtime (periodMs, periodMs * 0.5, periodMs, 8);
         }
-    }
-
-    void run() override
-    {
-        setMMThreadPriority();
 
         const int bufferSize        = currentBufferSizeSamples;
         const int numInputBuffers   = getActiveInputChannels().countNumberOfSetBits();
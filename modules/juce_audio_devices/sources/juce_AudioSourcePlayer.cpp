@@ -27,7 +27,11 @@ AudioSourcePlayer::AudioSourcePlayer()
       sampleRate (0),
       bufferSize (0),
       lastGain (1.0f),
-      gain (1.0f)
+      gain (1.0f),
+      numInputs (0),
+      numOutputs (0),
+      mappedTotalInputs (-1),
+      mappedTotalOutputs (-1)
 {
 }
 
@@ -69,73 +73,42 @@ void AudioSourcePlayer::audioDeviceIOCallback (const float** inputChannelData,
     // these should have been prepared by audioDeviceAboutToStart()...
     jassert (sampleRate > 0 && bufferSize > 0);
 
+    const RealtimeSafety::ScopedRealtimeContext realtimeContext;
     const ScopedLock sl (readLock);
 
     if (source != nullptr)
     {
-        int numActiveChans = 0, numInputs = 0, numOutputs = 0;
-
-        // messy stuff needed to compact the channels down into an array
-        // of non-zero pointers..
-        for (int i = 0; i < totalNumInputChannels; ++i)
+        if (totalNumInputChannels != mappedTotalInputs
+             || totalNumOutputChannels != mappedTotalOutputs
+             || numSamples > tempBuffer.getNumSamples())
+            updateChannelMapping (inputChannelData, totalNumInputChannels,
+                                  outputChannelData, totalNumOutputChannels, numSamples);
+
+        // The outputs are used as the source's buffer, so the inputs get copied into them
+        // (unless the driver has given us the same buffer for both), and any extra inputs
+        // go into the temp buffer, whose channels are already in the list.
+        for (int i = 0; i < numOutputs; ++i)
         {
-            if (inputChannelData[i] != nullptr)
-            {
-                inputChans [numInputs++] = inputChannelData[i];
-                if (numInputs >= numElementsInArray (inputChans))
-                    break;
-            }
-        }
+            float* const dest = outputChannelData [outputIndexes[i]];
+            channels[i] = dest;
 
-        for (int i = 0; i < totalNumOutputChannels; ++i)
-        {
-            if (outputChannelData[i] != nullptr)
+            if (i < numInputs)
             {
-                outputChans [numOutputs++] = outputChannelData[i];
-                if (numOutputs >= numElementsInArray (outputChans))
-                    break;
-            }
-        }
-
-        if (numInputs > numOutputs)
-        {
-            // if there aren't enough output channels for the number of
-            // inputs, we need to create some temporary extra ones (can't
-            // use the input data in case it gets written to)
-            tempBuffer.setSize (numInputs - numOutputs, numSamples,
-                                false, false, true);
+                const float* const src = inputChannelData [inputIndexes[i]];
 
-            for (int i = 0; i < numOutputs; ++i)
-            {
-                channels[numActiveChans] = outputChans[i];
-                memcpy (channels[numActiveChans], inputChans[i], sizeof (float) * (size_t) numSamples);
-                ++numActiveChans;
+                if (src != dest)
+                    memcpy (dest, src, sizeof (float) * (size_t) numSamples);
             }
-
-            for (int i = numOutputs; i < numInputs; ++i)
+            else
             {
-                channels[numActiveChans] = tempBuffer.getWritePointer (i - numOutputs);
-                memcpy (channels[numActiveChans], inputChans[i], sizeof (float) * (size_t) numSamples);
-                ++numActiveChans;
+                zeromem (dest, sizeof (float) * (size_t) numSamples);
             }
         }
-        else
-        {
-            for (int i = 0; i < numInputs; ++i)
-            {
-                channels[numActiveChans] = outputChans[i];
-                memcpy (channels[numActiveChans], inputChans[i], sizeof (float) * (size_t) numSamples);
-                ++numActiveChans;
-            }
 
-            for (int i = numInputs; i < numOutputs; ++i)
-            {
-                channels[numActiveChans] = outputChans[i];
-                zeromem (channels[numActiveChans], sizeof (float) * (size_t) numSamples);
-                ++numActiveChans;
-            }
-        }
+        for (int i = numOutputs; i < numInputs; ++i)
+            memcpy (channels[i], inputChannelData [inputIndexes[i]], sizeof (float) * (size_t) numSamples);
 
+        const int numActiveChans = jmax (numInputs, numOutputs);
         AudioSampleBuffer buffer (channels, numActiveChans, numSamples);
 
         AudioSourceChannelInfo info (&buffer, 0, numSamples);
@@ -154,10 +127,52 @@ void AudioSourcePlayer::audioDeviceIOCallback (const float** inputChannelData,
     }
 }
 
+// Works out which of the device's channels are active. Drivers may give us different buffers
+// on each callback, but the set of active channels only changes when the device is restarted,
+// so this is only done when the layout changes, and not on every callback.
+void AudioSourcePlayer::updateChannelMapping (const float** inputChannelData, const int totalNumInputChannels,
+                                              float** outputChannelData, const int totalNumOutputChannels,
+                                              const int numSamples)
+{
+    const int maxChans = numElementsInArray (channels);
+    numInputs = numOutputs = 0;
+
+    for (int i = 0; i < totalNumInputChannels && numInputs < maxChans; ++i)
+        if (inputChannelData[i] != nullptr)
+            inputIndexes [numInputs++] = i;
+
+    for (int i = 0; i < totalNumOutputChannels && numOutputs < maxChans; ++i)
+        if (outputChannelData[i] != nullptr)
+            outputIndexes [numOutputs++] = i;
+
+    if (numInputs > numOutputs || numSamples > tempBuffer.getNumSamples())
+    {
+        // if there aren't enough output channels for the number of
+        // inputs, we need to create some temporary extra ones (can't
+        // use the input data in case it gets written to)
+
+        // (this only allocates if audioDeviceAboutToStart() couldn't predict the size)
+        const RealtimeSafety::ScopedRealtimeExemption exemption;
+        tempBuffer.setSize (jmax (1, numInputs - numOutputs, tempBuffer.getNumChannels()),
+                            jmax (numSamples, tempBuffer.getNumSamples()), false, false, true);
+    }
+
+    for (int i = numOutputs; i < numInputs; ++i)
+        channels[i] = tempBuffer.getWritePointer (i - numOutputs);
+
+    mappedTotalInputs = totalNumInputChannels;
+    mappedTotalOutputs = totalNumOutputChannels;
+}
+
 void AudioSourcePlayer::audioDeviceAboutToStart (AudioIODevice* device)
 {
-    prepareToPlay (device->getCurrentSampleRate(),
-                   device->getCurrentBufferSizeSamples());
+    const int numChansIn  = device->getActiveInputChannels().countNumberOfSetBits();
+    const int numChansOut = device->getActiveOutputChannels().countNumberOfSetBits();
+    const int newBufferSize = device->getCurrentBufferSizeSamples();
+
+    tempBuffer.setSize (jmax (1, numChansIn - numChansOut), newBufferSize);
+
+    prepareToPlay (device->getCurrentSampleRate(), newBufferSize);
 }
 
 void AudioSourcePlayer::prepareToPlay (double newSampleRate, int newBufferSize)
@@ -165,6 +180,7 @@ void AudioSourcePlayer::prepareToPlay (double newSampleRate, int newBufferSize)
     sampleRate = newSampleRate;
     bufferSize = newBufferSize;
     zeromem (channels, sizeof (channels));
+    mappedTotalInputs = mappedTotalOutputs = -1;
 
     if (source != nullptr)
         source->prepareToPlay (bufferSize, sampleRate);
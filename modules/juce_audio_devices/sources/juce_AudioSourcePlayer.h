@@ -103,10 +103,12 @@ private:
     double sampleRate;
     int bufferSize;
     float* channels [128];
-    float* outputChans [128];
-    const float* inputChans [128];
+    int inputIndexes [128], outputIndexes [128];
     AudioSampleBuffer tempBuffer;
     float lastGain, gain;
+    int numInputs, numOutputs, mappedTotalInputs, mappedTotalOutputs;
+
+    void updateChannelMapping (const float**, int, float**, int, int);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioSourcePlayer)
 };
@@ -36,8 +36,11 @@ AudioTransportSource::AudioTransportSource()
       sourceSampleRate (0.0),
       blockSize (128),
       readAheadBufferSize (0),
+      maxChannels (2),
       isPrepared (false),
-      inputStreamEOF (false)
+      inputStreamEOF (false),
+      crossfadedSeeking (false),
+      pendingSeekPosition (-1)
 {
 }
 
@@ -61,6 +64,7 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
 
     readAheadBufferSize = readAheadSize;
     sourceSampleRate = sourceSampleRateToCorrectFor;
+    maxChannels = maxNumChannels;
 
     ResamplingAudioSource* newResamplerSource = nullptr;
     BufferingAudioSource* newBufferingSource = nullptr;
@@ -114,6 +118,7 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
 
         inputStreamEOF = false;
         playing = false;
+        pendingSeekPosition = -1;
     }
 
     if (oldMasterSource != nullptr)
@@ -181,26 +186,67 @@ void AudioTransportSource::setNextReadPosition (int64 newPosition)
         if (sampleRate > 0 && sourceSampleRate > 0)
             newPosition = (int64) (newPosition * sourceSampleRate / sampleRate);
 
-        positionableSource->setNextReadPosition (newPosition);
+        if (crossfadedSeeking && playing)
+        {
+            // the audio thread will make the jump once the data is ready
+            if (bufferingSource != nullptr)
+                bufferingSource->prefetchRegion (newPosition);
+
+            const ScopedLock sl (callbackLock);
+            pendingSeekPosition = newPosition;
+            inputStreamEOF = false;
+            return;
+        }
 
-        if (resamplerSource != nullptr)
-            resamplerSource->flushBuffers();
+        {
+            const ScopedLock sl (callbackLock);
+            pendingSeekPosition = -1;
+        }
 
-        inputStreamEOF = false;
+        jumpToPosition (newPosition);
     }
 }
 
+void AudioTransportSource::jumpToPosition (const int64 sourcePosition)
+{
+    positionableSource->setNextReadPosition (sourcePosition);
+
+    if (resamplerSource != nullptr)
+        resamplerSource->flushBuffers();
+
+    inputStreamEOF = false;
+}
+
 int64 AudioTransportSource::getNextReadPosition() const
 {
     if (positionableSource != nullptr)
     {
         const double ratio = (sampleRate > 0 && sourceSampleRate > 0) ? sampleRate / sourceSampleRate : 1.0;
-        return (int64) (positionableSource->getNextReadPosition() * ratio);
+        const int64 pending = pendingSeekPosition;
+
+        return (int64) ((pending >= 0 ? pending : positionableSource->getNextReadPosition()) * ratio);
     }
 
     return 0;
 }
 
+int64 AudioTransportSource::toSourcePosition (const double seconds) const noexcept
+{
+    return (int64) (seconds * (sourceSampleRate > 0 ? sourceSampleRate : sampleRate));
+}
+
+void AudioTransportSource::addCuePoint (const double positionInSeconds)
+{
+    if (bufferingSource != nullptr)
+        bufferingSource->addCuePoint (toSourcePosition (positionInSeconds));
+}
+
+void AudioTransportSource::removeCuePoint (const double positionInSeconds)
+{
+    if (bufferingSource != nullptr)
+        bufferingSource->removeCuePoint (toSourcePosition (positionInSeconds));
+}
+
 int64 AudioTransportSource::getTotalLength() const
 {
     const ScopedLock sl (callbackLock);
@@ -231,6 +277,7 @@ void AudioTransportSource::prepareToPlay (int samplesPerBlockExpected, double ne
 
     sampleRate = newSampleRate;
     blockSize = samplesPerBlockExpected;
+    crossfadeBuffer.setSize (jmax (2, maxChannels), samplesPerBlockExpected);
 
     if (masterSource != nullptr)
         masterSource->prepareToPlay (samplesPerBlockExpected, sampleRate);
@@ -263,7 +310,11 @@ void AudioTransportSource::getNextAudioBlock (const AudioSourceChannelInfo& info
 
     if (masterSource != nullptr && ! stopped)
     {
-        masterSource->getNextAudioBlock (info);
+        if (pendingSeekPosition >= 0 && playing
+             && (bufferingSource == nullptr || bufferingSource->isReadyToPlayFrom (pendingSeekPosition)))
+            renderCrossfadedSeek (info);
+        else
+            masterSource->getNextAudioBlock (info);
 
         if (! playing)
         {
@@ -290,9 +341,40 @@ void AudioTransportSource::getNextAudioBlock (const AudioSourceChannelInfo& info
     }
     else
     {
+        if (pendingSeekPosition >= 0 && positionableSource != nullptr)
+        {
+            jumpToPosition (pendingSeekPosition);
+            pendingSeekPosition = -1;
+        }
+
         info.clearActiveBufferRegion();
         stopped = true;
     }
 
     lastGain = gain;
 }
+
+// Plays one block from both the old and new positions, and fades between them.
+void AudioTransportSource::renderCrossfadedSeek (const AudioSourceChannelInfo& info)
+{
+    const int numChannels = info.buffer->getNumChannels();
+
+    if (crossfadeBuffer.getNumChannels() < numChannels || crossfadeBuffer.getNumSamples() < info.numSamples)
+        crossfadeBuffer.setSize (jmax (numChannels, crossfadeBuffer.getNumChannels()),
+                                 jmax (info.numSamples, crossfadeBuffer.getNumSamples()), false, false, true);
+
+    AudioSampleBuffer oldPositionAudio (crossfadeBuffer.getArrayOfWritePointers(), numChannels, info.numSamples);
+    AudioSourceChannelInfo oldInfo (oldPositionAudio);
+    masterSource->getNextAudioBlock (oldInfo);
+
+    jumpToPosition (pendingSeekPosition);
+    pendingSeekPosition = -1;
+
+    masterSource->getNextAudioBlock (info);
+
+    for (int i = numChannels; --i >= 0;)
+    {
+        info.buffer->applyGainRamp (i, info.startSample, info.numSamples, 0.0f, 1.0f);
+        info.buffer->addFromWithRamp (i, info.startSample, oldPositionAudio.getReadPointer (i), info.numSamples, 1.0f, 0.0f);
+    }
+}
@@ -103,6 +103,40 @@ public:
     /** Returns true if the player has stopped because its input stream ran out of data. */
     bool hasStreamFinished() const noexcept             { return inputStreamEOF; }
 
+    //==============================================================================
+    /** Enables or disables crossfaded seeking.
+
+        Normally, a call to setPosition() while playing jumps straight to the new position,
+        which causes a click, and if there's a read-ahead buffer, a gap until the buffer has
+        refilled from the new position.
+
+        With crossfaded seeking enabled, playback carries on from the old position while the
+        read-ahead buffer fetches the data at the new position in the background (unless it's
+        already available, e.g. from a cue point), and then crossfades from the old position
+        to the new one over the course of one block.
+
+        @see addCuePoint
+    */
+    void setCrossfadedSeeking (bool shouldCrossfade) noexcept   { crossfadedSeeking = shouldCrossfade; }
+
+    /** Returns true if crossfaded seeking is enabled. @see setCrossfadedSeeking */
+    bool isCrossfadedSeeking() const noexcept                   { return crossfadedSeeking; }
+
+    /** Tells the read-ahead buffer to load the data at a position that's likely to be
+        jumped to, so that a later call to setPosition() can start playing from there
+        straight away.
+
+        This only has an effect if a read-ahead buffer was requested in setSource(), and
+        the cue points are cleared when the source changes.
+
+        @param positionInSeconds    the time in seconds, as used by setPosition()
+        @see removeCuePoint, setCrossfadedSeeking
+    */
+    void addCuePoint (double positionInSeconds);
+
+    /** Removes a cue point that was added with addCuePoint(). */
+    void removeCuePoint (double positionInSeconds);
+
     //==============================================================================
     /** Starts playing (if a source has been selected).
 
@@ -168,9 +202,14 @@ private:
     float volatile gain, lastGain;
     bool volatile playing, stopped;
     double sampleRate, sourceSampleRate;
-    int blockSize, readAheadBufferSize;
-    bool volatile isPrepared, inputStreamEOF;
-
+    int blockSize, readAheadBufferSize, maxChannels;
+    bool volatile isPrepared, inputStreamEOF, crossfadedSeeking;
+    int64 volatile pendingSeekPosition;
+    AudioSampleBuffer crossfadeBuffer;
+
+    int64 toSourcePosition (double seconds) const noexcept;
+    void jumpToPosition (int64 sourcePosition);
+    void renderCrossfadedSeek (const AudioSourceChannelInfo&);
     void releaseMasterResources();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioTransportSource)
@@ -976,6 +976,14 @@ bool AiffAudioFormat::canHandleFile (const File& f)
 }
 #endif
 
+AudioFormat::HeaderMatch AiffAudioFormat::checkFileHeader (const void* headerData, const size_t numBytes)
+{
+    const char* const d = static_cast<const char*> (headerData);
+
+    return numBytes >= 12 && memcmp (d, "FORM", 4) == 0
+                          && (memcmp (d + 8, "AIFF", 4) == 0 || memcmp (d + 8, "AIFC", 4) == 0) ? headerMatches : headerDoesNotMatch;
+}
+
 AudioFormatReader* AiffAudioFormat::createReaderFor (InputStream* sourceStream, const bool deleteStreamIfOpeningFails)
 {
     ScopedPointer <AiffAudioFormatReader> w (new AiffAudioFormatReader (sourceStream));
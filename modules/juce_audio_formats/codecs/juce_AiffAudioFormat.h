@@ -66,6 +66,8 @@ public:
     bool canHandleFile (const File& fileToTest) override;
    #endif
 
+    HeaderMatch checkFileHeader (const void* headerData, size_t numBytes) override;
+
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
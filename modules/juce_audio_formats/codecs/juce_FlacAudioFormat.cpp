@@ -323,33 +323,31 @@ private:
 class FlacWriter  : public AudioFormatWriter
 {
 public:
-    FlacWriter (OutputStream* const out, double rate, uint32 numChans, uint32 bits, int qualityOptionIndex)
-        : AudioFormatWriter (out, flacFormatName, rate, numChans, bits)
+    FlacWriter (OutputStream* const out, double rate, uint32 numChans, uint32 bits,
+                int qualityOptionIndex, int numThreadsToUse)
+        : AudioFormatWriter (out, flacFormatName, rate, numChans, bits),
+          quality (qualityOptionIndex)
     {
         using namespace FlacNamespace;
         encoder = FLAC__stream_encoder_new();
-
-        if (qualityOptionIndex > 0)
-            FLAC__stream_encoder_set_compression_level (encoder, (uint32) jmin (8, qualityOptionIndex));
-
-        FLAC__stream_encoder_set_do_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_loose_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_channels (encoder, numChannels);
-        FLAC__stream_encoder_set_bits_per_sample (encoder, jmin ((unsigned int) 24, bitsPerSample));
-        FLAC__stream_encoder_set_sample_rate (encoder, (unsigned int) sampleRate);
-        FLAC__stream_encoder_set_blocksize (encoder, 0);
-        FLAC__stream_encoder_set_do_escape_coding (encoder, true);
+        setEncoderOptions (encoder);
 
         ok = FLAC__stream_encoder_init_stream (encoder,
                                                encodeWriteCallback, encodeSeekCallback,
                                                encodeTellCallback, encodeMetadataCallback,
                                                this) == FLAC__STREAM_ENCODER_INIT_STATUS_OK;
+
+        if (ok && numThreadsToUse > 1)
+            parallelEncoder = new ParallelEncoder (*this, numThreadsToUse);
     }
 
     ~FlacWriter()
     {
         if (ok)
         {
+            if (parallelEncoder != nullptr)
+                parallelEncoder->finish();
+
             FlacNamespace::FLAC__stream_encoder_finish (encoder);
             output->flush();
         }
@@ -359,9 +357,26 @@ public:
                               // to the caller of createWriter()
         }
 
+        parallelEncoder = nullptr;
         FlacNamespace::FLAC__stream_encoder_delete (encoder);
     }
 
+    void setEncoderOptions (FlacNamespace::FLAC__StreamEncoder* e) const
+    {
+        using namespace FlacNamespace;
+
+        if (quality > 0)
+            FLAC__stream_encoder_set_compression_level (e, (uint32) jmin (8, quality));
+
+        FLAC__stream_encoder_set_do_mid_side_stereo (e, numChannels == 2);
+        FLAC__stream_encoder_set_loose_mid_side_stereo (e, numChannels == 2);
+        FLAC__stream_encoder_set_channels (e, numChannels);
+        FLAC__stream_encoder_set_bits_per_sample (e, jmin ((unsigned int) 24, bitsPerSample));
+        FLAC__stream_encoder_set_sample_rate (e, (unsigned int) sampleRate);
+        FLAC__stream_encoder_set_blocksize (e, 0);
+        FLAC__stream_encoder_set_do_escape_coding (e, true);
+    }
+
     //==============================================================================
     bool write (const int** samplesToWrite, int numSamples) override
     {
@@ -393,6 +408,9 @@ public:
             samplesToWrite = const_cast<const int**> (channels.getData());
         }
 
+        if (parallelEncoder != nullptr)
+            return parallelEncoder->write (samplesToWrite, numSamples);
+
         return FLAC__stream_encoder_process (encoder, (const FLAC__int32**) samplesToWrite, (unsigned) numSamples) != 0;
     }
 
@@ -415,7 +433,10 @@ public:
     void writeMetaData (const FlacNamespace::FLAC__StreamMetadata* metadata)
     {
         using namespace FlacNamespace;
-        const FLAC__StreamMetadata_StreamInfo& info = metadata->data.stream_info;
+        FLAC__StreamMetadata_StreamInfo info (metadata->data.stream_info);
+
+        if (parallelEncoder != nullptr)
+            parallelEncoder->updateStreamInfo (info);
 
         unsigned char buffer [FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
         const unsigned int channelsMinus1 = info.channels - 1;
@@ -481,7 +502,314 @@ public:
     bool ok;
 
 private:
+    //==============================================================================
+    /* This encodes the stream in segments, each one using its own FLAC encoder
+       running on a thread pool, and then writes out their frames in order.
+
+       To make sure the result is identical to what a single encoder would have
+       produced, the segments all start on a frame where a single encoder would have
+       re-evaluated its loose mid-side stereo decision, which is the only state that
+       libFLAC carries from one frame to the next. The frame numbers in each segment's
+       frame headers have to be rewritten, and the MD5 and total length of the whole
+       stream are worked out here and put into the STREAMINFO block at the end.
+    */
+    class ParallelEncoder
+    {
+    public:
+        ParallelEncoder (FlacWriter& w, int numThreads)
+            : owner (w), pool (numThreads),
+              blockSize ((int) FlacNamespace::FLAC__stream_encoder_get_blocksize (w.encoder)),
+              samplesPerSegment (getNumFramesPerSegment (w.sampleRate, blockSize) * blockSize),
+              maxJobsInProgress (numThreads * 2),
+              nextFrameNumber (0), totalSamples (0),
+              minFrameSize ((1u << FlacNamespace::FLAC__STREAM_METADATA_STREAMINFO_MIN_FRAME_SIZE_LEN) - 1),
+              maxFrameSize (0), failed (false), finished (false)
+        {
+            FlacNamespace::FLAC__MD5Init (&md5);
+        }
+
+        ~ParallelEncoder()
+        {
+            pool.removeAllJobs (true, 10000);
+
+            if (! finished)
+                FlacNamespace::FLAC__MD5Final (md5Digest, &md5);
+        }
+
+        bool write (const int* const* data, int numSamples)
+        {
+            using namespace FlacNamespace;
+
+            if (! FLAC__MD5Accumulate (&md5, (const FLAC__int32* const*) data, owner.numChannels,
+                                       (unsigned) numSamples, (owner.bitsPerSample + 7) / 8))
+                return false;
+
+            for (int pos = 0; pos < numSamples;)
+            {
+                if (currentJob == nullptr)
+                    currentJob = new EncodeJob (*this);
+
+                const int num = jmin (numSamples - pos, samplesPerSegment - currentJob->numSamples);
+
+                for (int i = 0; i < (int) owner.numChannels; ++i)
+                    memcpy (currentJob->getChannel (i) + currentJob->numSamples, data[i] + pos, (size_t) num * sizeof (int));
+
+                currentJob->numSamples += num;
+                pos += num;
+
+                if (currentJob->numSamples == samplesPerSegment)
+                    startCurrentJob();
+            }
+
+            writeFinishedJobs (false);
+            return ! failed;
+        }
+
+        void finish()
+        {
+            if (currentJob != nullptr)
+                startCurrentJob();
+
+            writeFinishedJobs (true);
+
+            FlacNamespace::FLAC__MD5Final (md5Digest, &md5);
+            finished = true;
+        }
+
+        void updateStreamInfo (FlacNamespace::FLAC__StreamMetadata_StreamInfo& info) const
+        {
+            info.total_samples = totalSamples;
+            info.min_framesize = jmin (info.min_framesize, minFrameSize);
+            info.max_framesize = jmax (info.max_framesize, maxFrameSize);
+            memcpy (info.md5sum, md5Digest, sizeof (md5Digest));
+        }
+
+    private:
+        //==============================================================================
+        struct EncodeJob  : public ThreadPoolJob
+        {
+            EncodeJob (ParallelEncoder& p)
+                : ThreadPoolJob ("FLAC encoder"), owner (p),
+                  numSamples (0), firstFrameNumber (0), ok (false)
+            {
+                samples.malloc ((size_t) owner.owner.numChannels * (size_t) owner.samplesPerSegment);
+            }
+
+            int* getChannel (int channel) const noexcept    { return samples + channel * owner.samplesPerSegment; }
+
+            JobStatus runJob() override
+            {
+                using namespace FlacNamespace;
+                FLAC__StreamEncoder* const e = FLAC__stream_encoder_new();
+                owner.owner.setEncoderOptions (e);
+                FLAC__stream_encoder_set_do_md5 (e, false);
+
+                if (FLAC__stream_encoder_init_stream (e, writeCallback, nullptr, nullptr, nullptr, this)
+                      == FLAC__STREAM_ENCODER_INIT_STATUS_OK)
+                {
+                    HeapBlock<const FLAC__int32*> channels ((size_t) owner.owner.numChannels);
+
+                    for (int i = 0; i < (int) owner.owner.numChannels; ++i)
+                        channels[i] = getChannel (i);
+
+                    ok = FLAC__stream_encoder_process (e, channels, (unsigned) numSamples) != 0;
+                    ok = (FLAC__stream_encoder_finish (e) != 0) && ok;
+                }
+
+                FLAC__stream_encoder_delete (e);
+                return jobHasFinished;
+            }
+
+            static FlacNamespace::FLAC__StreamEncoderWriteStatus writeCallback (const FlacNamespace::FLAC__StreamEncoder*,
+                                                                                const FlacNamespace::FLAC__byte buffer[],
+                                                                                size_t bytes, unsigned int samples,
+                                                                                unsigned int, void* client_data)
+            {
+                // (the stream headers that each encoder writes before its frames are ignored)
+                if (samples > 0)
+                {
+                    EncodeJob* const job = static_cast<EncodeJob*> (client_data);
+                    job->frameData.append (buffer, bytes);
+                    job->frameSizes.add ((int) bytes);
+                }
+
+                return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+            }
+
+            ParallelEncoder& owner;
+            HeapBlock<int> samples;
+            int numSamples;
+            uint32 firstFrameNumber;
+            MemoryBlock frameData;
+            Array<int> frameSizes;
+            bool ok;
+
+            JUCE_DECLARE_NON_COPYABLE (EncodeJob)
+        };
+
+        FlacWriter& owner;
+        ThreadPool pool;
+        const int blockSize, samplesPerSegment, maxJobsInProgress;
+        ScopedPointer<EncodeJob> currentJob;
+        OwnedArray<EncodeJob> jobsInProgress;
+        uint32 nextFrameNumber;
+        FlacNamespace::FLAC__uint64 totalSamples;
+        unsigned int minFrameSize, maxFrameSize;
+        FlacNamespace::FLAC__MD5Context md5;
+        FlacNamespace::FLAC__byte md5Digest[16];
+        MemoryBlock renumberedFrame;
+        bool failed, finished;
+
+        static int getNumFramesPerSegment (double sampleRate, int blockSize) noexcept
+        {
+            // This matches the way libFLAC decides how often to re-evaluate its loose mid-side choice
+            const int framesPerDecision = jmax (1, (int) (sampleRate * 0.4 / blockSize + 0.5));
+            return framesPerDecision * jmax (1, 32 / framesPerDecision);
+        }
+
+        void startCurrentJob()
+        {
+            currentJob->firstFrameNumber = nextFrameNumber;
+            nextFrameNumber += (uint32) ((currentJob->numSamples + blockSize - 1) / blockSize);
+            totalSamples += (FlacNamespace::FLAC__uint64) currentJob->numSamples;
+
+            EncodeJob* const job = jobsInProgress.add (currentJob.release());
+            pool.addJob (job, false);
+
+            while (jobsInProgress.size() > maxJobsInProgress)
+                writeFinishedJobs (true, 1);
+        }
+
+        void writeFinishedJobs (bool waitForJobs, int maxNumToWrite = std::numeric_limits<int>::max())
+        {
+            while (jobsInProgress.size() > 0 && --maxNumToWrite >= 0)
+            {
+                EncodeJob* const job = jobsInProgress.getFirst();
+
+                if (! pool.waitForJobToFinish (job, waitForJobs ? -1 : 0))
+                    break;
+
+                writeFrames (*job);
+                jobsInProgress.remove (0);
+            }
+        }
+
+        void writeFrames (const EncodeJob& job)
+        {
+            if (! job.ok)
+                failed = true;
+
+            const uint8* frame = static_cast<const uint8*> (job.frameData.getData());
+
+            for (int i = 0; i < job.frameSizes.size(); ++i)
+            {
+                const size_t size = (size_t) job.frameSizes.getUnchecked (i);
+                writeFrame (frame, size, job.firstFrameNumber + (uint32) i, job.firstFrameNumber == 0);
+                frame += size;
+            }
+        }
+
+        void writeFrame (const uint8* frame, size_t size, uint32 frameNumber, bool isNumberedCorrectly)
+        {
+            if (! isNumberedCorrectly)
+            {
+                const size_t newSize = renumberFrame (frame, size, frameNumber);
+
+                if (newSize > 0)
+                {
+                    frame = static_cast<const uint8*> (renumberedFrame.getData());
+                    size = newSize;
+                }
+            }
+
+            minFrameSize = jmin (minFrameSize, (unsigned int) size);
+            maxFrameSize = jmax (maxFrameSize, (unsigned int) size);
+
+            if (! owner.output->write (frame, size))
+                failed = true;
+        }
+
+        // Copies a frame into renumberedFrame, replacing the frame number in its header and
+        // recalculating its CRCs. Returns the new size, or 0 if the frame isn't one it understands.
+        size_t renumberFrame (const uint8* frame, size_t size, uint32 frameNumber)
+        {
+            using namespace FlacNamespace;
+
+            if (size < 8 || frame[0] != 0xff || (frame[1] & 0xfe) != 0xf8 || (frame[1] & 1) != 0)
+            {
+                jassertfalse;
+                return 0;
+            }
+
+            const int oldNumberSize = getUTF8Length (frame[4]);
+            const int blockSizeCode = frame[2] >> 4, sampleRateCode = frame[2] & 0x0f;
+            const int extraHeaderSize = (blockSizeCode == 6 ? 1 : (blockSizeCode == 7 ? 2 : 0))
+                                         + (sampleRateCode == 12 ? 1 : (sampleRateCode == 13 || sampleRateCode == 14 ? 2 : 0));
+            const size_t oldHeaderSize = (size_t) (4 + oldNumberSize + extraHeaderSize);
+
+            if (oldNumberSize == 0 || oldHeaderSize + 3 > size)
+            {
+                jassertfalse;
+                return 0;
+            }
+
+            const size_t bodySize = size - oldHeaderSize - 3;
+            renumberedFrame.ensureSize (size + 8);
+            uint8* const dest = static_cast<uint8*> (renumberedFrame.getData());
+
+            memcpy (dest, frame, 4);
+            const int newNumberSize = writeUTF8 (dest + 4, frameNumber);
+            const size_t newHeaderSize = (size_t) (4 + newNumberSize + extraHeaderSize);
+            memcpy (dest + 4 + newNumberSize, frame + 4 + oldNumberSize, (size_t) extraHeaderSize);
+            dest[newHeaderSize] = FLAC__crc8 (dest, (unsigned) newHeaderSize);
+
+            memcpy (dest + newHeaderSize + 1, frame + oldHeaderSize + 1, bodySize);
+            const size_t sizeWithoutCRC = newHeaderSize + 1 + bodySize;
+            const unsigned crc = FLAC__crc16 (dest, (unsigned) sizeWithoutCRC);
+            dest[sizeWithoutCRC]     = (uint8) (crc >> 8);
+            dest[sizeWithoutCRC + 1] = (uint8) crc;
+
+            return sizeWithoutCRC + 2;
+        }
+
+        static int getUTF8Length (uint8 firstByte) noexcept
+        {
+            if ((firstByte & 0x80) == 0)   return 1;
+            if ((firstByte & 0xe0) == 0xc0) return 2;
+            if ((firstByte & 0xf0) == 0xe0) return 3;
+            if ((firstByte & 0xf8) == 0xf0) return 4;
+            if ((firstByte & 0xfc) == 0xf8) return 5;
+            if ((firstByte & 0xfe) == 0xfc) return 6;
+            return 0;
+        }
+
+        static int writeUTF8 (uint8* dest, uint32 value) noexcept
+        {
+            const int numBytes = value < 0x80 ? 1 : (value < 0x800 ? 2 : (value < 0x10000 ? 3
+                                  : (value < 0x200000 ? 4 : (value < 0x4000000 ? 5 : 6))));
+
+            if (numBytes == 1)
+            {
+                dest[0] = (uint8) value;
+                return 1;
+            }
+
+            for (int i = numBytes; --i > 0;)
+            {
+                dest[i] = (uint8) (0x80 | (value & 0x3f));
+                value >>= 6;
+            }
+
+            dest[0] = (uint8) ((0xff << (8 - numBytes)) | value);
+            return numBytes;
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (ParallelEncoder)
+    };
+
     FlacNamespace::FLAC__StreamEncoder* encoder;
+    ScopedPointer<ParallelEncoder> parallelEncoder;
+    const int quality;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacWriter)
 };
@@ -489,7 +817,8 @@ private:
 
 //==============================================================================
 FlacAudioFormat::FlacAudioFormat()
-    : AudioFormat (flacFormatName, ".flac")
+    : AudioFormat (flacFormatName, ".flac"),
+      numThreadsForWriting (1)
 {
 }
 
@@ -516,6 +845,17 @@ bool FlacAudioFormat::canDoStereo()     { return true; }
 bool FlacAudioFormat::canDoMono()       { return true; }
 bool FlacAudioFormat::isCompressed()    { return true; }
 
+AudioFormat::HeaderMatch FlacAudioFormat::checkFileHeader (const void* headerData, const size_t numBytes)
+{
+    const char* const d = static_cast<const char*> (headerData);
+
+    if (numBytes >= 4 && memcmp (d, "fLaC", 4) == 0)
+        return headerMatches;
+
+    // (the decoder will skip over an ID3 tag to find the stream marker)
+    return numBytes >= 3 && memcmp (d, "ID3", 3) == 0 ? headerMightMatch : headerDoesNotMatch;
+}
+
 AudioFormatReader* FlacAudioFormat::createReaderFor (InputStream* in, const bool deleteStreamIfOpeningFails)
 {
     ScopedPointer<FlacReader> r (new FlacReader (in));
@@ -539,7 +879,8 @@ AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
     if (getPossibleBitDepths().contains (bitsPerSample))
     {
         ScopedPointer<FlacWriter> w (new FlacWriter (out, sampleRate, numberOfChannels,
-                                                     (uint32) bitsPerSample, qualityOptionIndex));
+                                                     (uint32) bitsPerSample, qualityOptionIndex,
+                                                     numThreadsForWriting));
         if (w->ok)
             return w.release();
     }
@@ -547,6 +888,12 @@ AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
     return nullptr;
 }
 
+void FlacAudioFormat::setNumThreadsForWriting (int numThreads) noexcept
+{
+    jassert (numThreads > 0);
+    numThreadsForWriting = jmax (1, numThreads);
+}
+
 StringArray FlacAudioFormat::getQualityOptions()
 {
     static const char* options[] = { "0 (Fastest)", "1", "2", "3", "4", "5 (Default)","6", "7", "8 (Highest quality)", 0 };
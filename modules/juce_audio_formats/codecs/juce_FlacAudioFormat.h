@@ -47,6 +47,8 @@ public:
     bool isCompressed() override;
     StringArray getQualityOptions() override;
 
+    HeaderMatch checkFileHeader (const void* headerData, size_t numBytes) override;
+
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
@@ -57,7 +59,22 @@ public:
                                         int bitsPerSample,
                                         const StringPairArray& metadataValues,
                                         int qualityOptionIndex) override;
+
+    //==============================================================================
+    /** Makes the writers that this format creates encode on several threads.
+
+        By default, a writer compresses the audio on whichever thread calls its write()
+        method. If you set this to more than 1, writers created after this call will
+        instead pass large sections of the audio to a set of background threads, which
+        compress them in parallel. This is useful for speeding up an offline export of
+        a long file (the output is exactly the same either way), but it uses more
+        memory, and the final sections are only written when the writer is deleted.
+    */
+    void setNumThreadsForWriting (int numThreads) noexcept;
+
 private:
+    int numThreadsForWriting;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacAudioFormat)
 };
 
@@ -1398,7 +1398,8 @@ struct MP3Stream
 {
     MP3Stream (InputStream& source)
         : stream (source, 8192),
-          numFrames (0), currentFrameIndex (0), vbrHeaderFound (false)
+          numFrames (0), currentFrameIndex (0), vbrHeaderFound (false),
+          frameIndexComplete (false), numFramesInIndex (0)
     {
         reset();
     }
@@ -1567,7 +1568,10 @@ struct MP3Stream
     {
         frameIndex = jmax (0, frameIndex);
 
-        while (frameIndex >= frameStreamPositions.size() * storedStartPosInterval)
+        if (frameIndex >= frameStreamPositions.size() * storedStartPosInterval)
+            extendFrameIndex (frameIndex);
+
+        while (frameIndex >= frameStreamPositions.size() * storedStartPosInterval && ! frameIndexComplete)
         {
             int dummy = 0;
             const int result = decodeNextBlock (nullptr, nullptr, dummy);
@@ -1587,6 +1591,108 @@ struct MP3Stream
         return true;
     }
 
+    /*  Adds entries to the frame index by hopping from one frame header to the next,
+        which is much quicker than scanning and parsing each frame. If something that
+        isn't a valid header turns up before the end of the stream, it gives up, and
+        seek() will fall back to scanning the frames.
+    */
+    void extendFrameIndex (const int targetFrameIndex)
+    {
+        if (frameIndexComplete || frameStreamPositions.size() == 0 || frame.layer == 0)
+            return;
+
+        const int64 oldPos = stream.getPosition();
+        int index = (frameStreamPositions.size() - 1) * storedStartPosInterval;
+        int64 pos = frameStreamPositions.getLast();
+        MP3Frame f;
+
+        while (index <= targetFrameIndex + storedStartPosInterval)
+        {
+            uint8 headerData[4];
+            stream.setPosition (pos);
+
+            if (stream.read (headerData, 4) != 4)
+            {
+                frameIndexComplete = true;
+                numFramesInIndex = index;
+                break;
+            }
+
+            const uint32 header = ByteOrder::bigEndianInt (headerData);
+
+            if (! isValidHeader (header, frame.layer) || ((header >> 12) & 15) == 0)
+            {
+                // A trailing ID3v1 tag is the only thing that's expected after the last frame..
+                frameIndexComplete = (headerData[0] == 'T' && headerData[1] == 'A' && headerData[2] == 'G');
+                numFramesInIndex = index;
+                break;
+            }
+
+            if ((index & (storedStartPosInterval - 1)) == 0)
+                frameStreamPositions.set (index / storedStartPosInterval, pos);
+
+            f.decodeHeader (header);
+            pos += f.frameSize + 4;
+            ++index;
+        }
+
+        stream.setPosition (oldPos);
+    }
+
+    bool isFrameIndexComplete() const noexcept      { return frameIndexComplete; }
+
+    /** If the index is complete, this is the total number of frame headers in the stream. */
+    int getNumFramesInIndex() const noexcept        { return numFramesInIndex; }
+
+    void writeFrameIndex (OutputStream& out)
+    {
+        out.writeInt (getFrameIndexMagicNumber());
+        out.writeInt64 (stream.getTotalLength());
+        out.writeInt (storedStartPosInterval);
+        out.writeInt (numFramesInIndex);
+        out.writeInt (frameStreamPositions.size());
+
+        for (int i = 0; i < frameStreamPositions.size(); ++i)
+            out.writeInt64 (frameStreamPositions.getUnchecked (i));
+    }
+
+    bool readFrameIndex (InputStream& in)
+    {
+        if (in.readInt() != getFrameIndexMagicNumber()
+             || in.readInt64() != stream.getTotalLength()
+             || in.readInt() != storedStartPosInterval)
+            return false;
+
+        const int numFrames = in.readInt();
+        const int numEntries = in.readInt();
+
+        if (numEntries <= 0 || numEntries > (int) (stream.getTotalLength() / (storedStartPosInterval * 4))
+             || numFrames <= (numEntries - 1) * storedStartPosInterval || numFrames > numEntries * storedStartPosInterval)
+            return false;
+
+        Array<int64> positions;
+        positions.ensureStorageAllocated (numEntries);
+
+        for (int i = 0; i < numEntries; ++i)
+        {
+            const int64 pos = in.readInt64();
+
+            if (pos < 0 || pos >= stream.getTotalLength() || (i > 0 && pos <= positions.getLast()))
+                return false;
+
+            positions.add (pos);
+        }
+
+        // the start of the stream should match what's already been found by decoding it
+        if (frameStreamPositions.size() > 0 && positions.getFirst() != frameStreamPositions.getFirst())
+            return false;
+
+        frameStreamPositions.swapWith (positions);
+        frameIndexComplete = true;
+        numFramesInIndex = numFrames;
+        return true;
+    }
+
     MP3Frame frame;
     VBRTagData vbrTagData;
     BufferedInputStream stream;
@@ -1594,6 +1700,11 @@ struct MP3Stream
     bool vbrHeaderFound;
 
 private:
+    bool frameIndexComplete;
+    int numFramesInIndex;
+
+    static int getFrameIndexMagicNumber() noexcept     { return (int) ByteOrder::littleEndianInt ("MP3I"); }
+
     bool headerParsed, sideParsed, dataParsed, needToSyncBitStream;
     bool isFreeFormat, wasFreeFormat;
     int sideInfoSize, dataSize;
@@ -2949,7 +3060,7 @@ static const char* const mp3FormatName = "MP3 file";
 class MP3Reader : public AudioFormatReader
 {
 public:
-    MP3Reader (InputStream* const in)
+    MP3Reader (InputStream* const in, const File& seekTableFile)
         : AudioFormatReader (in, mp3FormatName),
           stream (*in), currentPosition (0),
           decodedStart (0), decodedEnd (0)
@@ -2964,6 +3075,15 @@ public:
             sampleRate = stream.frame.getFrequency();
             numChannels = (unsigned int) stream.frame.numChannels;
             lengthInSamples = findLength (streamPos);
+
+            if (seekTableFile != File())
+            {
+                loadOrCreateSeekTable (seekTableFile);
+
+                // without a VBR header, the length is only an estimate, so use the real frame count
+                if (stream.numFrames <= 0 && stream.isFrameIndexComplete())
+                    lengthInSamples = stream.getNumFramesInIndex() * (int64) 1152;
+            }
         }
     }
 
@@ -2974,7 +3094,7 @@ public:
 
         if (currentPosition != startSampleInFile)
         {
-            if (! stream.seek ((int) (startSampleInFile / 1152 - 1)))
+            if (! stream.seek ((int) (startSampleInFile / 1152 - numPreRollFrames)))
             {
                 currentPosition = -1;
                 createEmptyDecodedData();
@@ -3040,6 +3160,10 @@ private:
     MP3Stream stream;
     int64 currentPosition;
     enum { decodedDataSize = 1152 };
+
+    // The number of frames to decode before the one that's needed, so that the
+    // bit reservoir and overlapping transforms have settled down.
+    enum { numPreRollFrames = 2 };
     float decoded0 [decodedDataSize], decoded1 [decodedDataSize];
     int decodedStart, decodedEnd;
 
@@ -3101,6 +3225,34 @@ private:
         stream.stream.setPosition (originalPosition);
     }
 
+    void loadOrCreateSeekTable (const File& seekTableFile)
+    {
+        {
+            FileInputStream in (seekTableFile);
+
+            if (in.openedOk() && stream.readFrameIndex (in))
+                return;
+        }
+
+        stream.extendFrameIndex (std::numeric_limits<int>::max() / 2);
+
+        if (stream.isFrameIndexComplete())
+        {
+            TemporaryFile temp (seekTableFile);
+
+            {
+                FileOutputStream out (temp.getFile());
+
+                if (! out.openedOk())
+                    return;
+
+                stream.writeFrameIndex (out);
+            }
+
+            temp.overwriteTargetFileWithTemporary();
+        }
+    }
+
     int64 findLength (int64 streamStartPos)
     {
         int64 numFrames = stream.numFrames;
@@ -3139,9 +3291,52 @@ bool MP3AudioFormat::canDoMono()                    { return true; }
 bool MP3AudioFormat::isCompressed()                 { return true; }
 StringArray MP3AudioFormat::getQualityOptions()     { return StringArray(); }
 
+void MP3AudioFormat::setSeekTableDirectory (const File& directory)
+{
+    seekTableDirectory = directory;
+
+    if (directory != File())
+        directory.createDirectory();
+}
+
+File MP3AudioFormat::getSeekTableFileFor (const File& mp3File) const
+{
+    if (seekTableDirectory == File())
+        return File();
+
+    const String description (mp3File.getFullPathName()
+                               + "_" + String (mp3File.getSize())
+                               + "_" + String (mp3File.getLastModificationTime().toMilliseconds()));
+
+    return seekTableDirectory.getChildFile (String::toHexString (description.hashCode64()) + ".mp3index");
+}
+
+AudioFormat::HeaderMatch MP3AudioFormat::checkFileHeader (const void* headerData, const size_t numBytes)
+{
+    const uint8* const d = static_cast<const uint8*> (headerData);
+
+    if (numBytes < 4)
+        return headerDoesNotMatch;
+
+    if (memcmp (d, "ID3", 3) == 0 || (d[0] == 0xff && (d[1] & 0xe0) == 0xe0))
+        return headerMatches;
+
+    if (memcmp (d, "RIFF", 4) == 0 || memcmp (d, "FORM", 4) == 0
+         || memcmp (d, "fLaC", 4) == 0 || memcmp (d, "OggS", 4) == 0)
+        return headerDoesNotMatch;
+
+    // the decoder will search for the first frame, so there could be some junk before it
+    return headerMightMatch;
+}
+
 AudioFormatReader* MP3AudioFormat::createReaderFor (InputStream* sourceStream, const bool deleteStreamIfOpeningFails)
 {
-    ScopedPointer<MP3Decoder::MP3Reader> r (new MP3Decoder::MP3Reader (sourceStream));
+    File seekTableFile;
+
+    if (FileInputStream* fin = dynamic_cast<FileInputStream*> (sourceStream))
+        seekTableFile = getSeekTableFileFor (fin->getFile());
+
+    ScopedPointer<MP3Decoder::MP3Reader> r (new MP3Decoder::MP3Reader (sourceStream, seekTableFile));
 
     if (r->lengthInSamples > 0)
         return r.release();
@@ -54,11 +54,30 @@ public:
     StringArray getQualityOptions() override;
 
     //==============================================================================
+    /** Sets a directory in which to keep the seek-tables of files that are opened.
+
+        Each reader keeps an index of where its frames start, which makes seeking quick
+        once it has been built, but the first seek into a large file means reading through
+        it all. If you set a directory here, any reader for a file (i.e. one created with a
+        FileInputStream) will build the complete index when it's opened and save it here,
+        so that re-opening the same file later can skip that step.
+
+        Pass File() to turn this off, which is the default.
+    */
+    void setSeekTableDirectory (const File& directory);
+
+    //==============================================================================
+    HeaderMatch checkFileHeader (const void* headerData, size_t numBytes) override;
     AudioFormatReader* createReaderFor (InputStream*, bool deleteStreamIfOpeningFails) override;
 
     AudioFormatWriter* createWriterFor (OutputStream*, double sampleRateToUse,
                                         unsigned int numberOfChannels, int bitsPerSample,
                                         const StringPairArray& metadataValues, int qualityOptionIndex) override;
+
+private:
+    File seekTableDirectory;
+
+    File getSeekTableFileFor (const File&) const;
 };
 
 #endif
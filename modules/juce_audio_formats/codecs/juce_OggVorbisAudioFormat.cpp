@@ -463,6 +463,11 @@ bool OggVorbisAudioFormat::canDoStereo()    { return true; }
 bool OggVorbisAudioFormat::canDoMono()      { return true; }
 bool OggVorbisAudioFormat::isCompressed()   { return true; }
 
+AudioFormat::HeaderMatch OggVorbisAudioFormat::checkFileHeader (const void* headerData, const size_t numBytes)
+{
+    return numBytes >= 4 && memcmp (headerData, "OggS", 4) == 0 ? headerMatches : headerDoesNotMatch;
+}
+
 AudioFormatReader* OggVorbisAudioFormat::createReaderFor (InputStream* in, const bool deleteStreamIfOpeningFails)
 {
     ScopedPointer<OggReader> r (new OggReader (in));
@@ -74,6 +74,8 @@ public:
     static const char* const id3genre;          /**< Metadata key for setting an ID3 genre. */
     static const char* const id3trackNumber;    /**< Metadata key for setting an ID3 track number. */
 
+    HeaderMatch checkFileHeader (const void* headerData, size_t numBytes) override;
+
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
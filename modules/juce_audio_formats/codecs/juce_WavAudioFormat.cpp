@@ -1379,6 +1379,14 @@ Array<int> WavAudioFormat::getPossibleBitDepths()
 bool WavAudioFormat::canDoStereo()  { return true; }
 bool WavAudioFormat::canDoMono()    { return true; }
 
+AudioFormat::HeaderMatch WavAudioFormat::checkFileHeader (const void* headerData, const size_t numBytes)
+{
+    const char* const d = static_cast<const char*> (headerData);
+
+    return numBytes >= 12 && (memcmp (d, "RIFF", 4) == 0 || memcmp (d, "RF64", 4) == 0)
+                          && memcmp (d + 8, "WAVE", 4) == 0 ? headerMatches : headerDoesNotMatch;
+}
+
 AudioFormatReader* WavAudioFormat::createReaderFor (InputStream* sourceStream,
                                                     const bool deleteStreamIfOpeningFails)
 {
@@ -144,6 +144,8 @@ public:
     bool canDoStereo() override;
     bool canDoMono() override;
 
+    HeaderMatch checkFileHeader (const void* headerData, size_t numBytes) override;
+
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
@@ -0,0 +1,208 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+AsyncAudioFormatReader::AsyncAudioFormatReader (AudioFormatReader* const sourceReader,
+                                                const bool deleteReaderWhenDeleted,
+                                                TimeSliceThread& backgroundThread)
+    : reader (sourceReader, deleteReaderWhenDeleted),
+      thread (backgroundThread),
+      currentRequest (nullptr),
+      nextRequestID (1)
+{
+    jassert (reader != nullptr);
+    thread.addTimeSliceClient (this);
+}
+
+AsyncAudioFormatReader::~AsyncAudioFormatReader()
+{
+    {
+        const ScopedLock sl (queueLock);
+        queue.clear();
+    }
+
+    thread.removeTimeSliceClient (this);
+}
+
+int AsyncAudioFormatReader::read (const Array<Range<int64> >& ranges, Listener& listener)
+{
+    Request* const r = new Request();
+    r->ranges = ranges;
+    r->listener = &listener;
+
+    int requestID;
+
+    {
+        const ScopedLock sl (queueLock);
+        requestID = nextRequestID++;
+        r->requestID = requestID;
+        queue.add (r);
+    }
+
+    thread.moveToFrontOfQueue (this);
+    return requestID;
+}
+
+bool AsyncAudioFormatReader::cancel (const int requestID)
+{
+    const ScopedLock sl (queueLock);
+
+    for (int i = queue.size(); --i >= 0;)
+    {
+        if (queue.getUnchecked(i)->requestID == requestID)
+        {
+            queue.remove (i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void AsyncAudioFormatReader::cancelAllRequestsFor (Listener& listener)
+{
+    {
+        const ScopedLock sl (queueLock);
+
+        for (int i = queue.size(); --i >= 0;)
+            if (queue.getUnchecked(i)->listener == &listener)
+                queue.remove (i);
+    }
+
+    // wait for any callback that's in progress..
+    const ScopedLock sl (callbackLock);
+}
+
+int AsyncAudioFormatReader::getNumPendingRequests() const
+{
+    const ScopedLock sl (queueLock);
+    return queue.size() + (currentRequest != nullptr ? 1 : 0);
+}
+
+int AsyncAudioFormatReader::useTimeSlice()
+{
+    const ScopedLock sl (callbackLock);
+    ScopedPointer<Request> request;
+
+    {
+        const ScopedLock sl2 (queueLock);
+
+        if (queue.size() == 0)
+            return 500;
+
+        request = queue.removeAndReturn (0);
+        currentRequest = request;
+    }
+
+    process (*request);
+
+    const ScopedLock sl2 (queueLock);
+    currentRequest = nullptr;
+    return queue.size() > 0 ? 0 : 500;
+}
+
+namespace AsyncReaderHelpers
+{
+    struct RangeStartComparator
+    {
+        RangeStartComparator (const Array<Range<int64> >& r) noexcept : ranges (r) {}
+
+        int compareElements (int first, int second) const noexcept
+        {
+            const int64 diff = ranges.getReference (first).getStart() - ranges.getReference (second).getStart();
+            return diff < 0 ? -1 : (diff > 0 ? 1 : 0);
+        }
+
+        const Array<Range<int64> >& ranges;
+    };
+}
+
+void AsyncAudioFormatReader::process (Request& request)
+{
+    const Array<Range<int64> >& ranges = request.ranges;
+    const int numChannels = (int) reader->numChannels;
+
+    OwnedArray<AudioSampleBuffer> results;
+    Array<int> order;
+
+    for (int i = 0; i < ranges.size(); ++i)
+    {
+        results.add (new AudioSampleBuffer (numChannels, (int) jmax ((int64) 0, ranges.getReference(i).getLength())));
+        order.add (i);
+    }
+
+    AsyncReaderHelpers::RangeStartComparator comparator (ranges);
+    order.sort (comparator, true);
+
+    // Ranges with less than this many samples between them are merged into one read, and
+    // merged reads are kept below a maximum size so that the temporary buffer stays reasonable.
+    const int64 maxGapToMerge = 8192;
+    const int64 maxMergedLength = 1 << 20;
+
+    for (int i = 0; i < order.size();)
+    {
+        const Range<int64> first (ranges.getReference (order.getUnchecked (i)));
+        Range<int64> section (first);
+        int numInSection = 1;
+
+        while (i + numInSection < order.size())
+        {
+            const Range<int64> next (ranges.getReference (order.getUnchecked (i + numInSection)));
+
+            if (next.getStart() > section.getEnd() + maxGapToMerge
+                 || jmax (section.getEnd(), next.getEnd()) - section.getStart() > maxMergedLength)
+                break;
+
+            section = section.getUnionWith (next);
+            ++numInSection;
+        }
+
+        if (numInSection == 1)
+        {
+            AudioSampleBuffer& dest = *results.getUnchecked (order.getUnchecked (i));
+
+            if (dest.getNumSamples() > 0)
+                reader->read (&dest, 0, dest.getNumSamples(), first.getStart(), true, true);
+        }
+        else
+        {
+            tempBuffer.setSize (numChannels, (int) section.getLength(), false, false, true);
+            reader->read (&tempBuffer, 0, (int) section.getLength(), section.getStart(), true, true);
+
+            for (int j = 0; j < numInSection; ++j)
+            {
+                const int index = order.getUnchecked (i + j);
+                AudioSampleBuffer& dest = *results.getUnchecked (index);
+
+                for (int chan = 0; chan < numChannels; ++chan)
+                    dest.copyFrom (chan, 0, tempBuffer, chan,
+                                   (int) (ranges.getReference (index).getStart() - section.getStart()),
+                                   dest.getNumSamples());
+            }
+        }
+
+        i += numInSection;
+    }
+
+    request.listener->asyncReadFinished (request.requestID, ranges, results);
+}
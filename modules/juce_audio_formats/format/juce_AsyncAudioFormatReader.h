@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_ASYNCAUDIOFORMATREADER_H_INCLUDED
+#define JUCE_ASYNCAUDIOFORMATREADER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Reads batches of sample ranges from an AudioFormatReader on a background thread.
+
+    AudioFormatReader::read() blocks until the data has been read, which can take
+    a long time if the file is on a slow disk or a network volume. With this class,
+    you pass in a list of ranges that you want, and carry on with whatever else you
+    were doing - then when they've all been read, your Listener is given the data.
+
+    Within each batch, the ranges are sorted, and any that overlap, touch or are
+    close to each other are read with a single call to the reader, so that it doesn't
+    have to keep seeking back and forth.
+
+    The reader is only ever used from the background thread, so once you've
+    given it to this object, don't use it from anywhere else.
+
+    @see AudioFormatReader, BufferingAudioFormatReader
+*/
+class JUCE_API  AsyncAudioFormatReader  : private TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** Creates an AsyncAudioFormatReader.
+
+        @param sourceReader             the reader to read from
+        @param deleteReaderWhenDeleted  if true, the reader will be deleted when this object is
+        @param backgroundThread         the thread that should be used to do the reading. Make sure
+                                        that the thread you supply is running, and won't be deleted
+                                        while this object still exists
+    */
+    AsyncAudioFormatReader (AudioFormatReader* sourceReader,
+                            bool deleteReaderWhenDeleted,
+                            TimeSliceThread& backgroundThread);
+
+    /** Destructor.
+        Any requests that haven't been started will be cancelled, and if one is being read,
+        this will wait until it's finished.
+    */
+    ~AsyncAudioFormatReader();
+
+    //==============================================================================
+    /** Receives the data for requests made with AsyncAudioFormatReader::read(). */
+    class JUCE_API  Listener
+    {
+    public:
+        /** Destructor. */
+        virtual ~Listener() {}
+
+        /** Called when all the ranges in a request have been read.
+
+            This is called on the background thread. The buffers contain one channel for
+            each channel in the reader, and are in the same order as the ranges that were
+            requested. They're deleted after this method returns, but you can take
+            ownership of any of them by removing them from the array.
+        */
+        virtual void asyncReadFinished (int requestID,
+                                        const Array<Range<int64> >& ranges,
+                                        OwnedArray<AudioSampleBuffer>& samples) = 0;
+    };
+
+    /** Adds a batch of ranges to the queue of data to be read.
+
+        Each range is a start position and end position, in samples. When they've all
+        been read, the listener's asyncReadFinished() method is called with the data.
+        Any parts of the ranges that lie outside the reader's length will be silent.
+
+        The return value is an ID for the request, which will be passed to the listener,
+        and which can be used with cancel(). The listener must not be deleted until
+        the request has finished or been cancelled (see cancelAllRequestsFor()).
+    */
+    int read (const Array<Range<int64> >& ranges, Listener& listener);
+
+    /** Removes a request from the queue, if it hasn't yet been started.
+        Returns true if the request was removed, or false if its listener has already been
+        called or is being called.
+    */
+    bool cancel (int requestID);
+
+    /** Removes any requests that were made by this listener.
+        If one of its requests is currently being read, this waits until its callback
+        has finished, so after this returns, the listener won't be called again.
+    */
+    void cancelAllRequestsFor (Listener& listener);
+
+    /** Returns the number of requests that haven't yet been finished. */
+    int getNumPendingRequests() const;
+
+    /** Returns the reader that this object is using. */
+    AudioFormatReader* getReader() const noexcept       { return reader; }
+
+private:
+    //==============================================================================
+    struct Request
+    {
+        int requestID;
+        Array<Range<int64> > ranges;
+        Listener* listener;
+    };
+
+    OptionalScopedPointer<AudioFormatReader> reader;
+    TimeSliceThread& thread;
+    OwnedArray<Request> queue;
+    CriticalSection queueLock, callbackLock;
+    Request* volatile currentRequest;
+    int nextRequestID;
+    AudioSampleBuffer tempBuffer;
+
+    int useTimeSlice() override;
+    void process (Request&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncAudioFormatReader)
+};
+
+
+#endif   // JUCE_ASYNCAUDIOFORMATREADER_H_INCLUDED
@@ -0,0 +1,608 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+// The index is stored as a Header, followed by an array of Records sorted by path, then
+// the null-terminated UTF-8 strings that the records refer to, and then the overview data.
+// Everything is stored in the machine's native byte order, and the structures all have
+// fixed sizes, so a memory-mapped index can be used without parsing it.
+struct AudioFileIndex::Header
+{
+    uint32 magic, version, numRecords, reserved;
+    uint64 stringDataSize, overviewDataSize;
+};
+
+struct AudioFileIndex::Record
+{
+    int64 fileSize, modificationTime, lengthInSamples;
+    double sampleRate;
+    uint32 pathOffset, formatNameOffset, overviewOffset;
+    float peakLevel, rmsLevel;
+    uint16 numChannels, bitsPerSample, numOverviewPoints;
+    uint8 flags, unused;
+
+    enum { usesFloatingPointData = 1, hasLevels = 2 };
+};
+
+namespace AudioFileIndexHelpers
+{
+    static const uint32 magicNumber = 0x4946414a; // "JAFI"
+    static const uint32 currentVersion = 1;
+}
+
+//==============================================================================
+struct AudioFileIndex::FileToRead
+{
+    FileToRead (const DirectoryScanner::FileInfo& info)  : file (info.file), wasRead (false)
+    {
+        zerostruct (record);
+        record.fileSize = info.fileSize;
+        record.modificationTime = info.modificationTime.toMilliseconds();
+    }
+
+    File file;
+    Record record;
+    String formatName;
+    Array<uint8> overview;
+    bool wasRead;
+};
+
+struct AudioFileIndex::ReadFunction
+{
+    ReadFunction (AudioFileIndex& o, OwnedArray<FileToRead>& f, const Options& opts)
+        : owner (o), files (f), options (opts) {}
+
+    void operator() (int index) const       { owner.readFile (*files.getUnchecked (index), options); }
+
+    AudioFileIndex& owner;
+    OwnedArray<FileToRead>& files;
+    const Options& options;
+};
+
+struct AudioFileIndex::Builder
+{
+    Builder() {}
+
+    void addRecord (const Record& r, const String& path, const String& formatName,
+                    const uint8* overview, int numOverviewPoints)
+    {
+        Record newRecord (r);
+        newRecord.pathOffset = addString (path.getCharPointer());
+        newRecord.formatNameOffset = getFormatNameOffset (formatName);
+        newRecord.overviewOffset = (uint32) overviews.getDataSize();
+        newRecord.numOverviewPoints = (uint16) numOverviewPoints;
+        overviews.write (overview, (size_t) numOverviewPoints);
+        records.add (newRecord);
+    }
+
+    void addExistingRecord (const AudioFileIndex& source, const Record& r)
+    {
+        addRecord (r, String (CharPointer_UTF8 (source.strings + r.pathOffset)),
+                   String (CharPointer_UTF8 (source.strings + r.formatNameOffset)),
+                   source.overviews + r.overviewOffset, r.numOverviewPoints);
+    }
+
+    void writeTo (MemoryBlock& dest) const
+    {
+        Header header;
+        zerostruct (header);
+        header.magic = AudioFileIndexHelpers::magicNumber;
+        header.version = AudioFileIndexHelpers::currentVersion;
+        header.numRecords = (uint32) records.size();
+        header.stringDataSize = strings.getDataSize();
+        header.overviewDataSize = overviews.getDataSize();
+
+        MemoryOutputStream out (dest, false);
+        out.preallocate (sizeof (Header) + sizeof (Record) * (size_t) records.size()
+                           + strings.getDataSize() + overviews.getDataSize());
+        out.write (&header, sizeof (header));
+        out.write (records.begin(), sizeof (Record) * (size_t) records.size());
+        out.write (strings.getData(), strings.getDataSize());
+        out.write (overviews.getData(), overviews.getDataSize());
+    }
+
+private:
+    Array<Record> records;
+    MemoryOutputStream strings, overviews;
+    HashMap<String, int> formatNameOffsets;
+
+    uint32 addString (String::CharPointerType text)
+    {
+        const uint32 offset = (uint32) strings.getDataSize();
+        strings.write (text.getAddress(), text.sizeInBytes());
+        return offset;
+    }
+
+    uint32 getFormatNameOffset (const String& name)
+    {
+        // (there are only a few different names, so each one is only stored once)
+        const int existing = formatNameOffsets [name] - 1;
+
+        if (existing >= 0)
+            return (uint32) existing;
+
+        const uint32 offset = addString (name.getCharPointer());
+        formatNameOffsets.set (name, (int) offset + 1);
+        return offset;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Builder)
+};
+
+//==============================================================================
+AudioFileIndex::Options::Options() noexcept
+    : includeSubfolders (true), measureLevels (false),
+      numOverviewPoints (0), threadPool (nullptr)
+{
+}
+
+AudioFileIndex::Query::Query() noexcept
+    : minSampleRate (0), maxSampleRate (std::numeric_limits<double>::max()),
+      minNumChannels (0), maxNumChannels (std::numeric_limits<int>::max()),
+      minLengthSeconds (0), maxLengthSeconds (std::numeric_limits<double>::max())
+{
+}
+
+AudioFileIndex::AudioFileIndex (AudioFormatManager& fm)
+    : formatManager (fm), header (nullptr), records (nullptr),
+      strings (nullptr), overviews (nullptr)
+{
+    // (the structures are written directly to the index file, so they mustn't change size)
+    static_jassert (sizeof (Header) == 32);
+    static_jassert (sizeof (Record) == 64);
+}
+
+AudioFileIndex::~AudioFileIndex()
+{
+}
+
+//==============================================================================
+bool AudioFileIndex::setData (const void* const data, const size_t size) noexcept
+{
+    header = nullptr;
+    records = nullptr;
+    strings = nullptr;
+    overviews = nullptr;
+
+    if (data == nullptr || size < sizeof (Header))
+        return false;
+
+    const Header* const h = static_cast<const Header*> (data);
+    const uint64 recordDataSize = sizeof (Record) * (uint64) h->numRecords;
+
+    if (h->magic != AudioFileIndexHelpers::magicNumber
+         || h->version != AudioFileIndexHelpers::currentVersion
+         || sizeof (Header) + recordDataSize + h->stringDataSize + h->overviewDataSize > size)
+        return false;
+
+    header = h;
+    records = reinterpret_cast<const Record*> (h + 1);
+    strings = reinterpret_cast<const char*> (records + h->numRecords);
+    overviews = reinterpret_cast<const uint8*> (strings + h->stringDataSize);
+    return true;
+}
+
+void AudioFileIndex::clear()
+{
+    const ScopedLock sl (lock);
+    setData (nullptr, 0);
+    mappedFile = nullptr;
+    ownedData.reset();
+}
+
+bool AudioFileIndex::saveTo (const File& indexFile) const
+{
+    const ScopedLock sl (lock);
+
+    if (header == nullptr)
+    {
+        MemoryBlock empty;
+        Builder().writeTo (empty);
+        return indexFile.replaceWithData (empty.getData(), empty.getSize());
+    }
+
+    return indexFile.replaceWithData (header, sizeof (Header) + sizeof (Record) * header->numRecords
+                                                + (size_t) header->stringDataSize
+                                                + (size_t) header->overviewDataSize);
+}
+
+bool AudioFileIndex::loadFrom (const File& indexFile)
+{
+    ScopedPointer<MemoryMappedFile> newFile (new MemoryMappedFile (indexFile, MemoryMappedFile::readOnly));
+
+    const ScopedLock sl (lock);
+
+    if (setData (newFile->getData(), newFile->getSize()))
+    {
+        mappedFile = newFile;
+        ownedData.reset();
+        return true;
+    }
+
+    mappedFile = nullptr;
+    ownedData.reset();
+    return false;
+}
+
+//==============================================================================
+int AudioFileIndex::getNumEntries() const noexcept
+{
+    const ScopedLock sl (lock);
+    return header != nullptr ? (int) header->numRecords : 0;
+}
+
+String AudioFileIndex::getPath (const Record& r) const
+{
+    return String (CharPointer_UTF8 (strings + r.pathOffset));
+}
+
+AudioFileIndex::Entry AudioFileIndex::getEntry (const int index) const
+{
+    const ScopedLock sl (lock);
+    Entry e;
+
+    if (header != nullptr && isPositiveAndBelow (index, (int) header->numRecords))
+    {
+        const Record& r = records[index];
+
+        e.file = File (getPath (r));
+        e.formatName = String (CharPointer_UTF8 (strings + r.formatNameOffset));
+        e.fileSize = r.fileSize;
+        e.modificationTime = Time (r.modificationTime);
+        e.sampleRate = r.sampleRate;
+        e.lengthInSamples = r.lengthInSamples;
+        e.numChannels = r.numChannels;
+        e.bitsPerSample = r.bitsPerSample;
+        e.usesFloatingPointData = (r.flags & Record::usesFloatingPointData) != 0;
+        e.hasLevels = (r.flags & Record::hasLevels) != 0;
+        e.peakLevel = r.peakLevel;
+        e.rmsLevel = r.rmsLevel;
+    }
+    else
+    {
+        jassertfalse; // index out of range!
+        e.fileSize = e.lengthInSamples = 0;
+        e.sampleRate = 0;
+        e.numChannels = e.bitsPerSample = 0;
+        e.usesFloatingPointData = e.hasLevels = false;
+        e.peakLevel = e.rmsLevel = 0;
+    }
+
+    return e;
+}
+
+int AudioFileIndex::findFirstRecordNotBefore (const String& path) const noexcept
+{
+    int start = 0, end = header != nullptr ? (int) header->numRecords : 0;
+
+    while (start < end)
+    {
+        const int mid = start + (end - start) / 2;
+
+        if (CharPointer_UTF8 (strings + records[mid].pathOffset).compare (path.getCharPointer()) < 0)
+            start = mid + 1;
+        else
+            end = mid;
+    }
+
+    return start;
+}
+
+int AudioFileIndex::indexOf (const File& file) const
+{
+    const ScopedLock sl (lock);
+    const String path (file.getFullPathName());
+    const int index = findFirstRecordNotBefore (path);
+
+    if (header != nullptr && index < (int) header->numRecords
+         && CharPointer_UTF8 (strings + records[index].pathOffset).compare (path.getCharPointer()) == 0)
+        return index;
+
+    return -1;
+}
+
+Array<float> AudioFileIndex::getOverview (const int index) const
+{
+    const ScopedLock sl (lock);
+    Array<float> levels;
+
+    if (header != nullptr && isPositiveAndBelow (index, (int) header->numRecords))
+    {
+        const Record& r = records[index];
+        const uint8* const data = overviews + r.overviewOffset;
+
+        levels.ensureStorageAllocated (r.numOverviewPoints);
+
+        for (int i = 0; i < r.numOverviewPoints; ++i)
+            levels.add (data[i] / 255.0f);
+    }
+
+    return levels;
+}
+
+Array<int> AudioFileIndex::findEntries (const Query& q) const
+{
+    const ScopedLock sl (lock);
+    Array<int> results;
+
+    if (header == nullptr)
+        return results;
+
+    int start = 0, end = (int) header->numRecords;
+    String folderPrefix;
+
+    // (the records are sorted by path, so everything in a folder is in one block)
+    if (q.folder != File::nonexistent)
+    {
+        folderPrefix = File::addTrailingSeparator (q.folder.getFullPathName());
+        start = findFirstRecordNotBefore (folderPrefix);
+    }
+
+    const bool matchAllNames = q.fileNameWildcard.isEmpty() || q.fileNameWildcard == "*";
+    const bool ignoreCase = ! File::areFileNamesCaseSensitive();
+
+    for (int i = start; i < end; ++i)
+    {
+        const Record& r = records[i];
+        const CharPointer_UTF8 path (strings + r.pathOffset);
+
+        if (folderPrefix.isNotEmpty() && path.compareUpTo (folderPrefix.getCharPointer(), folderPrefix.length()) != 0)
+            break;
+
+        const double lengthSeconds = r.sampleRate > 0 ? r.lengthInSamples / r.sampleRate : 0.0;
+
+        if (r.sampleRate < q.minSampleRate || r.sampleRate > q.maxSampleRate
+             || r.numChannels < q.minNumChannels || r.numChannels > q.maxNumChannels
+             || lengthSeconds < q.minLengthSeconds || lengthSeconds > q.maxLengthSeconds)
+            continue;
+
+        if (q.formatName.isNotEmpty()
+             && CharPointer_UTF8 (strings + r.formatNameOffset).compare (q.formatName.getCharPointer()) != 0)
+            continue;
+
+        if (! (matchAllNames || String (path).fromLastOccurrenceOf (File::separatorString, false, false)
+                                              .matchesWildcard (q.fileNameWildcard, ignoreCase)))
+            continue;
+
+        results.add (i);
+    }
+
+    return results;
+}
+
+//==============================================================================
+struct AudioFileComparator
+{
+    static int compareElements (const DirectoryScanner::FileInfo& first, const DirectoryScanner::FileInfo& second)
+    {
+        return first.file.getFullPathName().compare (second.file.getFullPathName());
+    }
+};
+
+Result AudioFileIndex::update (const File& folder, const Options& options)
+{
+    jassert (options.numOverviewPoints >= 0 && options.numOverviewPoints < 65536);
+
+    if (! folder.isDirectory())
+        return Result::fail ("Directory doesn't exist: " + folder.getFullPathName());
+
+    shouldCancel = 0;
+
+    ScopedPointer<ThreadPool> temporaryPool;
+    ThreadPool* pool = options.threadPool;
+
+    if (pool == nullptr)
+        pool = temporaryPool = new ThreadPool (jmax (2, SystemStats::getNumCpus()));
+
+    Array<DirectoryScanner::FileInfo> found;
+
+    {
+        DirectoryScanner scanner (pool);
+        const Result r (scanner.scan (folder));
+
+        if (r.failed())
+            return r;
+
+        scanner.findFiles (found, File::findFiles | File::ignoreHiddenFiles,
+                           formatManager.getWildcardForAllFormats());
+    }
+
+    if (! options.includeSubfolders)
+        for (int i = found.size(); --i >= 0;)
+            if (found.getReference(i).file.getParentDirectory() != folder)
+                found.remove (i);
+
+    AudioFileComparator comparator;
+    found.sort (comparator);
+
+    // Find the block of existing records which are inside the folder, and work out which
+    // of them can be kept, by walking through them alongside the sorted list of files.
+    const String prefix (File::addTrailingSeparator (folder.getFullPathName()));
+    const int numOldRecords = header != nullptr ? (int) header->numRecords : 0;
+    const int oldStart = findFirstRecordNotBefore (prefix);
+    int oldEnd = oldStart;
+
+    while (oldEnd < numOldRecords
+            && CharPointer_UTF8 (strings + records[oldEnd].pathOffset).compareUpTo (prefix.getCharPointer(), prefix.length()) == 0)
+        ++oldEnd;
+
+    OwnedArray<FileToRead> filesToRead;
+    Array<int> sources; // (for each file, the old record to keep, or -1 for the next file to read)
+    int oldIndex = oldStart;
+
+    for (int i = 0; i < found.size(); ++i)
+    {
+        const DirectoryScanner::FileInfo& info = found.getReference (i);
+        const String path (info.file.getFullPathName());
+
+        while (oldIndex < oldEnd && CharPointer_UTF8 (strings + records[oldIndex].pathOffset).compare (path.getCharPointer()) < 0)
+            ++oldIndex;
+
+        if (oldIndex < oldEnd && CharPointer_UTF8 (strings + records[oldIndex].pathOffset).compare (path.getCharPointer()) == 0)
+        {
+            const Record& r = records[oldIndex];
+
+            if (r.fileSize == info.fileSize
+                 && r.modificationTime == info.modificationTime.toMilliseconds()
+                 && (! options.measureLevels || (r.flags & Record::hasLevels) != 0)
+                 && r.numOverviewPoints >= options.numOverviewPoints)
+            {
+                sources.add (oldIndex++);
+                continue;
+            }
+        }
+
+        filesToRead.add (new FileToRead (info));
+        sources.add (-1);
+    }
+
+    pool->parallelFor (0, filesToRead.size(), ReadFunction (*this, filesToRead, options));
+
+    if (shouldCancel.get() != 0)
+        return Result::fail ("The update was cancelled");
+
+    Builder builder;
+
+    for (int i = 0; i < oldStart; ++i)
+        builder.addExistingRecord (*this, records[i]);
+
+    for (int i = 0, nextFileToRead = 0; i < sources.size(); ++i)
+    {
+        if (sources.getUnchecked (i) >= 0)
+        {
+            builder.addExistingRecord (*this, records [sources.getUnchecked (i)]);
+        }
+        else
+        {
+            const FileToRead& f = *filesToRead.getUnchecked (nextFileToRead++);
+
+            // (files that can't be read are left out of the index)
+            if (f.wasRead)
+                builder.addRecord (f.record, f.file.getFullPathName(), f.formatName,
+                                   f.overview.begin(), f.overview.size());
+        }
+    }
+
+    for (int i = oldEnd; i < numOldRecords; ++i)
+        builder.addExistingRecord (*this, records[i]);
+
+    MemoryBlock newData;
+    builder.writeTo (newData);
+
+    const ScopedLock sl (lock);
+    ownedData.swapWith (newData);
+    setData (ownedData.getData(), ownedData.getSize());
+    mappedFile = nullptr;
+    return Result::ok();
+}
+
+void AudioFileIndex::cancel() noexcept
+{
+    shouldCancel = 1;
+}
+
+//==============================================================================
+void AudioFileIndex::readFile (FileToRead& f, const Options& options)
+{
+    if (shouldCancel.get() != 0)
+        return;
+
+    ScopedPointer<AudioFormatReader> reader (formatManager.createReaderFor (f.file));
+
+    if (reader == nullptr)
+        return;
+
+    Record& r = f.record;
+    r.sampleRate = reader->sampleRate;
+    r.lengthInSamples = reader->lengthInSamples;
+    r.numChannels = (uint16) reader->numChannels;
+    r.bitsPerSample = (uint16) reader->bitsPerSample;
+    r.flags = reader->usesFloatingPointData ? (uint8) Record::usesFloatingPointData : 0;
+    f.formatName = reader->getFormatName();
+    f.wasRead = true;
+
+    const int numPoints = options.numOverviewPoints;
+    const int numChannels = (int) reader->numChannels;
+    const int64 length = reader->lengthInSamples;
+
+    if (! (options.measureLevels || numPoints > 0) || numChannels <= 0 || length <= 0)
+        return;
+
+    const int blockSize = 32768;
+    AudioSampleBuffer buffer (numChannels, blockSize);
+    Array<float> peaks;
+    peaks.insertMultiple (0, 0.0f, numPoints);
+    float peak = 0;
+    double sumOfSquares = 0;
+
+    for (int64 pos = 0; pos < length; pos += blockSize)
+    {
+        if (shouldCancel.get() != 0)
+            return;
+
+        const int numSamples = (int) jmin ((int64) blockSize, length - pos);
+        reader->read (reinterpret_cast<int**> (buffer.getArrayOfWritePointers()), numChannels, pos, numSamples, false);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* const data = buffer.getWritePointer (ch);
+
+            if (! reader->usesFloatingPointData)
+                FloatVectorOperations::convertFixedToFloat (data, reinterpret_cast<const int*> (data),
+                                                            1.0f / 0x7fffffff, numSamples);
+
+            // Each block is split at the boundaries of the overview's points, so that each
+            // section's peak goes into the right point.
+            for (int i = 0; i < numSamples;)
+            {
+                const int point = numPoints > 0 ? (int) (((pos + i) * numPoints) / length) : 0;
+                const int sectionEnd = numPoints > 0 ? (int) jmin ((int64) numSamples, ((point + 1) * length + numPoints - 1) / numPoints - pos)
+                                                     : numSamples;
+                float sectionPeak = 0;
+
+                for (; i < sectionEnd; ++i)
+                {
+                    const float s = std::abs (data[i]);
+                    sumOfSquares += s * s;
+                    sectionPeak = jmax (sectionPeak, s);
+                }
+
+                peak = jmax (peak, sectionPeak);
+
+                if (numPoints > 0)
+                    peaks.set (point, jmax (peaks.getUnchecked (point), sectionPeak));
+            }
+        }
+    }
+
+    if (options.measureLevels)
+    {
+        r.flags |= (uint8) Record::hasLevels;
+        r.peakLevel = peak;
+        r.rmsLevel = (float) std::sqrt (sumOfSquares / ((double) length * numChannels));
+    }
+
+    for (int i = 0; i < numPoints; ++i)
+        f.overview.add ((uint8) jlimit (0, 255, roundToInt (peaks.getUnchecked (i) * 255.0f)));
+}
@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_AUDIOFILEINDEX_H_INCLUDED
+#define JUCE_AUDIOFILEINDEX_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A database of the properties of a large number of audio files, which can be
+    searched without opening any of the files.
+
+    update() scans a folder, reads the header of each audio file in parallel, and
+    stores its sample rate, length, channel count, etc. It can also read all the audio
+    to measure each file's peak and RMS levels and create a small overview of its
+    waveform. Files whose size and modification time haven't changed since the last
+    update are not read again.
+
+    The index is kept in a compact binary form, sorted by path. saveTo() writes this
+    to a file, and loadFrom() memory-maps it, so even an index of millions of files can
+    be opened instantly, and queries run directly on the mapped data.
+
+    The index can hold the contents of several folders - updating one folder leaves
+    the entries for any others unchanged.
+
+    @see AudioFormatManager, DirectoryScanner
+*/
+class JUCE_API  AudioFileIndex
+{
+public:
+    //==============================================================================
+    /** Creates an empty index.
+
+        @param formatManager    the formats to use to read the files. This must not be
+                                deleted while the index is in use, and no formats should be
+                                registered with it while an update is running
+    */
+    AudioFileIndex (AudioFormatManager& formatManager);
+
+    /** Destructor. */
+    ~AudioFileIndex();
+
+    //==============================================================================
+    /** Settings that control what update() does. */
+    struct Options
+    {
+        Options() noexcept;
+
+        /** If true (the default), the folder's subfolders are also indexed. */
+        bool includeSubfolders;
+
+        /** If true, all the audio in each file is read to measure its peak and RMS
+            levels. This is much slower than just reading the headers. The default is false.
+        */
+        bool measureLevels;
+
+        /** If this is greater than zero, each file's waveform is summarised into this
+            many peak values, which can be retrieved with getOverview(). Like measureLevels,
+            this means reading all the audio. The default is 0.
+        */
+        int numOverviewPoints;
+
+        /** The pool to read the files with. If this is null (the default), a temporary
+            pool is created for each update.
+        */
+        ThreadPool* threadPool;
+    };
+
+    /** Brings the index up-to-date with the audio files in a folder.
+
+        This blocks until it has finished. The index can be queried from other threads
+        while this is running, but only one update can run at a time.
+
+        Entries for files in the folder which no longer exist are removed, and entries
+        for files outside it aren't affected.
+    */
+    Result update (const File& folder, const Options& options = Options());
+
+    /** Makes an update that's running on another thread stop as soon as possible.
+        Any files that it had already read are discarded.
+    */
+    void cancel() noexcept;
+
+    /** Removes all the entries. */
+    void clear();
+
+    //==============================================================================
+    /** Writes the index to a file. */
+    bool saveTo (const File& indexFile) const;
+
+    /** Replaces the contents of the index with a file that was written by saveTo().
+
+        The file is memory-mapped rather than read, so it mustn't be modified or deleted
+        while this object is using it.
+
+        @returns false if the file couldn't be opened or isn't a valid index, in which
+                 case the index will be left empty.
+    */
+    bool loadFrom (const File& indexFile);
+
+    //==============================================================================
+    /** Describes one of the files in the index. */
+    struct Entry
+    {
+        File file;
+        String formatName;
+        int64 fileSize;
+        Time modificationTime;
+        double sampleRate;
+        int64 lengthInSamples;
+        int numChannels, bitsPerSample;
+        bool usesFloatingPointData;
+
+        /** True if the peakLevel and rmsLevel have been measured. */
+        bool hasLevels;
+        float peakLevel, rmsLevel;
+
+        double getLengthInSeconds() const noexcept      { return sampleRate > 0 ? lengthInSamples / sampleRate : 0.0; }
+    };
+
+    /** Returns the number of files in the index. */
+    int getNumEntries() const noexcept;
+
+    /** Returns the details of one of the files. The entries are sorted by path. */
+    Entry getEntry (int index) const;
+
+    /** Returns the index of the entry for a file, or -1 if it isn't in the index. */
+    int indexOf (const File& file) const;
+
+    /** Returns the overview of a file's waveform, as a set of peak levels between 0 and 1.
+        This will be empty unless the file was indexed with Options::numOverviewPoints.
+    */
+    Array<float> getOverview (int index) const;
+
+    //==============================================================================
+    /** A set of conditions for findEntries(). The default values match everything. */
+    struct Query
+    {
+        Query() noexcept;
+
+        /** A wildcard to match against the file's name (not including its folder). */
+        String fileNameWildcard;
+
+        /** If this isn't empty, only files in this folder (or its subfolders) will match. */
+        File folder;
+
+        /** If this isn't empty, only files of this format will match. */
+        String formatName;
+
+        double minSampleRate, maxSampleRate;
+        int minNumChannels, maxNumChannels;
+        double minLengthSeconds, maxLengthSeconds;
+    };
+
+    /** Returns the indexes of all the entries that match a query. */
+    Array<int> findEntries (const Query& query) const;
+
+private:
+    //==============================================================================
+    struct Header;
+    struct Record;
+    struct Builder;
+    struct FileToRead;
+    struct ReadFunction;
+    friend struct Builder;
+    friend struct ReadFunction;
+
+    AudioFormatManager& formatManager;
+    CriticalSection lock;
+    MemoryBlock ownedData;
+    ScopedPointer<MemoryMappedFile> mappedFile;
+    const Header* header;
+    const Record* records;
+    const char* strings;
+    const uint8* overviews;
+    Atomic<int> shouldCancel;
+
+    bool setData (const void* data, size_t size) noexcept;
+    String getPath (const Record&) const;
+    int findFirstRecordNotBefore (const String& path) const noexcept;
+    void readFile (FileToRead&, const Options&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFileIndex)
+};
+
+
+#endif   // JUCE_AUDIOFILEINDEX_H_INCLUDED
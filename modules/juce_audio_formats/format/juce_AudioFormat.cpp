@@ -45,6 +45,11 @@ bool AudioFormat::canHandleFile (const File& f)
     return false;
 }
 
+AudioFormat::HeaderMatch AudioFormat::checkFileHeader (const void*, size_t)
+{
+    return headerMightMatch;
+}
+
 const String& AudioFormat::getFormatName() const                { return formatName; }
 const StringArray& AudioFormat::getFileExtensions() const       { return fileExtensions; }
 bool AudioFormat::isCompressed()                                { return false; }
@@ -64,6 +64,27 @@ public:
     */
     virtual bool canHandleFile (const File& fileToTest);
 
+    /** The results that checkFileHeader() can return. */
+    enum HeaderMatch
+    {
+        headerDoesNotMatch,     /**< The data definitely isn't in this format. */
+        headerMightMatch,       /**< The format can't tell from the header alone. */
+        headerMatches           /**< The header identifies the data as being in this format. */
+    };
+
+    /** Looks at the first few bytes of a file to see whether it's in this format.
+
+        The AudioFormatManager reads the start of a file once and passes it to each of its
+        formats, so that it can go straight to the right one instead of asking them all to
+        try opening the file. Subclasses should just check for a signature here, and mustn't
+        try to parse or decode anything. The data will be the first 64 bytes of the file, or
+        less if the file is shorter than that.
+
+        The base class implementation returns headerMightMatch, in which case the manager
+        only tries this format if canHandleFile() accepts the file's name.
+    */
+    virtual HeaderMatch checkFileHeader (const void* headerData, size_t numBytes);
+
     /** Returns a set of sample rates that the format can read and write. */
     virtual Array<int> getPossibleSampleRates() = 0;
 
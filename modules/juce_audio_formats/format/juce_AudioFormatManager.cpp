@@ -77,6 +77,7 @@ void AudioFormatManager::registerBasicFormats()
 
 void AudioFormatManager::clearFormats()
 {
+    recentFiles.clear();
     knownFormats.clear();
     defaultFormatIndex = 0;
 }
@@ -126,20 +127,74 @@ String AudioFormatManager::getWildcardForAllFormats() const
 }
 
 //==============================================================================
+AudioFormatReader* AudioFormatManager::tryToOpen (AudioFormat& format, FileInputStream& in)
+{
+    in.setPosition (0);
+    return format.createReaderFor (&in, false);
+}
+
 AudioFormatReader* AudioFormatManager::createReaderFor (const File& file)
 {
     // you need to actually register some formats before the manager can
     // use them to open a file!
     jassert (getNumKnownFormats() > 0);
 
+    ScopedPointer<FileInputStream> in (file.createInputStream());
+
+    if (in == nullptr)
+        return nullptr;
+
+    const String path (file.getFullPathName());
+    RecentFile recent;
+    recent.modificationTime = file.getLastModificationTime();
+    recent.size = in->getTotalLength();
+
+    {
+        const RecentFile previous (recentFiles [path]);
+
+        if (previous.format != nullptr && previous.size == recent.size
+             && previous.modificationTime == recent.modificationTime)
+        {
+            if (AudioFormatReader* const r = tryToOpen (*previous.format, *in))
+            {
+                in.release();
+                return r;
+            }
+        }
+    }
+
+    char header[64] = { 0 };
+    const size_t headerSize = (size_t) jmax (0, in->read (header, sizeof (header)));
+
+    Array<AudioFormat*> candidates;
+    int numDefiniteMatches = 0;
+
     for (int i = 0; i < getNumKnownFormats(); ++i)
     {
-        AudioFormat* const af = getKnownFormat(i);
+        AudioFormat* const af = getKnownFormat (i);
+        const AudioFormat::HeaderMatch match = af->checkFileHeader (header, headerSize);
+
+        if (match == AudioFormat::headerMatches)
+            candidates.insert (numDefiniteMatches++, af);
+        else if (match == AudioFormat::headerMightMatch && af->canHandleFile (file))
+            candidates.add (af);
+    }
+
+    for (int i = 0; i < candidates.size(); ++i)
+    {
+        if (AudioFormatReader* const r = tryToOpen (*candidates.getUnchecked (i), *in))
+        {
+            // (this only needs to stop the table growing forever, so it's simply
+            // emptied when it gets big)
+            if (recentFiles.size() >= 1024)
+                recentFiles.clear();
+
+            recent.format = candidates.getUnchecked (i);
+            recentFiles.set (path, recent);
 
-        if (af->canHandleFile (file))
-            if (InputStream* const in = file.createInputStream())
-                if (AudioFormatReader* const r = af->createReaderFor (in, true))
-                    return r;
+            in.release();
+            return r;
+        }
     }
 
     return nullptr;
@@ -112,6 +112,13 @@ public:
     /** Searches through the known formats to try to create a suitable reader for
         this file.
 
+        The start of the file is read once and passed to each format's checkFileHeader()
+        method. Any formats that recognise it are tried first, followed by any that can't
+        tell but which accept the file's extension, so a file with the wrong extension
+        can still be opened, and one that isn't audio at all is rejected without being
+        parsed. The manager remembers which format opened each of the most recent files,
+        so opening the same file again goes straight to that format.
+
         If none of the registered formats can open the file, it'll return 0. If it
         returns a reader, it's the caller's responsibility to delete the reader.
     */
@@ -136,6 +143,19 @@ private:
     OwnedArray<AudioFormat> knownFormats;
     int defaultFormatIndex;
 
+    struct RecentFile
+    {
+        RecentFile() noexcept : size (0), format (nullptr) {}
+
+        Time modificationTime;
+        int64 size;
+        AudioFormat* format;
+    };
+
+    HashMap<String, RecentFile, DefaultHashFunctions, CriticalSection> recentFiles;
+
+    static AudioFormatReader* tryToOpen (AudioFormat&, FileInputStream&);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatManager)
 };
 
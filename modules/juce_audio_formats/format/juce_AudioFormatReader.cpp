@@ -367,7 +367,8 @@ int64 AudioFormatReader::searchForLevel (int64 startSample,
 MemoryMappedAudioFormatReader::MemoryMappedAudioFormatReader (const File& f, const AudioFormatReader& reader,
                                                               int64 start, int64 length, int frameSize)
     : AudioFormatReader (nullptr, reader.getFormatName()), file (f),
-      dataChunkStart (start), dataLength (length), bytesPerFrame (frameSize)
+      dataChunkStart (start), dataLength (length), bytesPerFrame (frameSize),
+      accessPattern (MemoryMappedFile::sequentialAccess), prefetcher (nullptr)
 {
     sampleRate      = reader.sampleRate;
     bitsPerSample   = reader.bitsPerSample;
@@ -377,6 +378,19 @@ MemoryMappedAudioFormatReader::MemoryMappedAudioFormatReader (const File& f, con
     usesFloatingPointData = reader.usesFloatingPointData;
 }
 
+MemoryMappedAudioFormatReader::~MemoryMappedAudioFormatReader()
+{
+    unmap();
+}
+
+void MemoryMappedAudioFormatReader::unmap()
+{
+    if (prefetcher != nullptr && map != nullptr)
+        prefetcher->cancelRequests (*map);
+
+    map = nullptr;
+}
+
 bool MemoryMappedAudioFormatReader::mapEntireFile()
 {
     return mapSectionOfFile (Range<int64> (0, lengthInSamples));
@@ -386,7 +400,7 @@ bool MemoryMappedAudioFormatReader::mapSectionOfFile (Range<int64> samplesToMap)
 {
     if (map == nullptr || samplesToMap != mappedSection)
     {
-        map = nullptr;
+        unmap();
 
         const Range<int64> fileRange (sampleToFilePos (samplesToMap.getStart()),
                                       sampleToFilePos (samplesToMap.getEnd()));
@@ -394,10 +408,17 @@ bool MemoryMappedAudioFormatReader::mapSectionOfFile (Range<int64> samplesToMap)
         map = new MemoryMappedFile (file, fileRange, MemoryMappedFile::readOnly);
 
         if (map->getData() == nullptr)
+        {
             map = nullptr;
+        }
         else
+        {
             mappedSection = Range<int64> (jmax ((int64) 0, filePosToSample (map->getRange().getStart() + (bytesPerFrame - 1))),
                                           jmin (lengthInSamples, filePosToSample (map->getRange().getEnd())));
+
+            if (accessPattern != MemoryMappedFile::sequentialAccess)
+                map->setAccessPattern (accessPattern);
+        }
     }
 
     return map != nullptr;
@@ -412,3 +433,46 @@ void MemoryMappedAudioFormatReader::touchSample (int64 sample) const noexcept
     else
         jassertfalse; // you must make sure that the window contains all the samples you're going to attempt to read.
 }
+
+Range<int64> MemoryMappedAudioFormatReader::samplesToFileRange (Range<int64> samples) const noexcept
+{
+    samples = samples.getIntersectionWith (mappedSection);
+    return Range<int64> (sampleToFilePos (samples.getStart()), sampleToFilePos (samples.getEnd()));
+}
+
+void MemoryMappedAudioFormatReader::prefetchSamples (Range<int64> samples) const noexcept
+{
+    if (map != nullptr)
+        map->prefetch (samplesToFileRange (samples));
+}
+
+bool MemoryMappedAudioFormatReader::prefetchSamples (MemoryMappedFilePrefetcher& p, Range<int64> samples) noexcept
+{
+    if (map == nullptr)
+        return false;
+
+    // this reader can only cancel the requests of one prefetcher when it's unmapped
+    jassert (prefetcher == nullptr || prefetcher == &p);
+    prefetcher = &p;
+
+    return p.prefetch (*map, samplesToFileRange (samples));
+}
+
+bool MemoryMappedAudioFormatReader::lockSamplesInMemory (Range<int64> samples) noexcept
+{
+    return map != nullptr && map->lockInMemory (samplesToFileRange (samples));
+}
+
+void MemoryMappedAudioFormatReader::unlockSamplesFromMemory (Range<int64> samples) noexcept
+{
+    if (map != nullptr)
+        map->unlockFromMemory (samplesToFileRange (samples));
+}
+
+void MemoryMappedAudioFormatReader::setAccessPattern (MemoryMappedFile::AccessPattern pattern) noexcept
+{
+    accessPattern = pattern;
+
+    if (map != nullptr)
+        map->setAccessPattern (pattern);
+}
@@ -32,7 +32,8 @@ AudioFormatWriter::AudioFormatWriter (OutputStream* const out,
     bitsPerSample (bitsPerSample_),
     usesFloatingPointData (false),
     output (out),
-    formatName (formatName_)
+    formatName (formatName_),
+    ditherType (noDither)
 {
 }
 
@@ -41,7 +42,7 @@ AudioFormatWriter::~AudioFormatWriter()
     delete output;
 }
 
-static void convertFloatsToInts (int* dest, const float* src, int numSamples) noexcept
+static void convertFloatsToIntsWithoutDither (int* dest, const float* src, int numSamples) noexcept
 {
     while (--numSamples >= 0)
     {
@@ -58,6 +59,123 @@ static void convertFloatsToInts (int* dest, const float* src, int numSamples) no
     }
 }
 
+//==============================================================================
+/*  Converts floats to ints which are quantised at the file's bit depth, with dither.
+
+    The random numbers come from four independent xorshift generators, which are stepped
+    together so that the TPDF loop has no dependencies between neighbouring samples, and
+    can be vectorised by the compiler. Each 32-bit value provides both of the uniform
+    numbers that are added together to make one triangular one.
+
+    The noise-shaped version feeds the quantisation error back through a three-tap filter
+    (Wannamaker's weighted design for 44.1kHz), so has to run one sample at a time.
+*/
+struct AudioFormatWriter::Ditherer
+{
+    Ditherer (const int bitsPerSample)
+        : scale (double (1 << (bitsPerSample - 1))),
+          maxValue (scale - 1.0),
+          outputMultiplier (1 << (32 - bitsPerSample))
+    {
+        const uint32 seed = (uint32) Random::getSystemRandom().nextInt();
+
+        for (int i = 0; i < numLanes; ++i)
+            lanes[i] = (seed + 0x9e3779b9u * (uint32) (i + 1)) | 1u;
+    }
+
+    enum { numLanes = 4, numErrorTaps = 3 };
+
+    static forcedinline uint32 nextRandom (uint32& state) noexcept
+    {
+        uint32 s = state;
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        state = s;
+        return s;
+    }
+
+    // a triangular random value between -1 and 1
+    static forcedinline double triangular (const uint32 r) noexcept
+    {
+        return ((r & 0xffff) + (r >> 16)) * (1.0 / 65536.0) - 1.0;
+    }
+
+    forcedinline int quantise (const double value) const noexcept
+    {
+        // (adding an offset so that truncation rounds towards minus infinity)
+        const double offset = 16777216.0 + 0.5;
+        return ((int) (jlimit (-scale, maxValue, value) + offset) - 16777216) * outputMultiplier;
+    }
+
+    void convertTriangular (int* dest, const float* src, const int numSamples) noexcept
+    {
+        int i = 0;
+
+        for (; i <= numSamples - numLanes; i += numLanes)
+            for (int lane = 0; lane < numLanes; ++lane)
+                dest[i + lane] = quantise (src[i + lane] * scale + triangular (nextRandom (lanes[lane])));
+
+        for (; i < numSamples; ++i)
+            dest[i] = quantise (src[i] * scale + triangular (nextRandom (lanes[i & (numLanes - 1)])));
+    }
+
+    void convertNoiseShaped (double* errors, int* dest, const float* src, const int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double target = src[i] * scale - (1.623 * errors[0] - 0.982 * errors[1] + 0.109 * errors[2]);
+            const int quantised = quantise (target + triangular (nextRandom (lanes[i & (numLanes - 1)])));
+
+            // (limited, so that clipping can't make the feedback run away)
+            const double error = jlimit (-4.0, 4.0, quantised / (double) outputMultiplier - target);
+
+            errors[2] = errors[1];
+            errors[1] = errors[0];
+            errors[0] = error;
+            dest[i] = quantised;
+        }
+    }
+
+    double* getErrors (const int channel)
+    {
+        if (channel >= errors.size() / numErrorTaps)
+            errors.insertMultiple (-1, 0.0, (channel + 1) * numErrorTaps - errors.size());
+
+        return errors.getRawDataPointer() + channel * numErrorTaps;
+    }
+
+    const double scale, maxValue;
+    const int outputMultiplier;
+    uint32 lanes [numLanes];
+    Array<double> errors;
+
+    JUCE_DECLARE_NON_COPYABLE (Ditherer)
+};
+
+void AudioFormatWriter::setDither (const DitherType newDitherType)
+{
+    ditherType = newDitherType;
+    ditherer = nullptr;
+}
+
+void AudioFormatWriter::convertFloatsToInts (const int channel, int* dest, const float* src, const int numSamples)
+{
+    if (ditherType == noDither || bitsPerSample > 24 || bitsPerSample < 8)
+    {
+        convertFloatsToIntsWithoutDither (dest, src, numSamples);
+        return;
+    }
+
+    if (ditherer == nullptr)
+        ditherer = new Ditherer ((int) bitsPerSample);
+
+    if (ditherType == noiseShapedDither)
+        ditherer->convertNoiseShaped (ditherer->getErrors (channel), dest, src, numSamples);
+    else
+        ditherer->convertTriangular (dest, src, numSamples);
+}
+
 bool AudioFormatWriter::writeFromAudioReader (AudioFormatReader& reader,
                                               int64 startSample,
                                               int64 numSamplesToRead)
@@ -91,7 +209,7 @@ bool AudioFormatWriter::writeFromAudioReader (AudioFormatReader& reader,
                 if (isFloatingPoint())
                     FloatVectorOperations::convertFixedToFloat ((float*) b, (int*) b, 1.0f / 0x7fffffff, numToDo);
                 else
-                    convertFloatsToInts ((int*) b, (float*) b, numToDo);
+                    convertFloatsToInts ((int) (bufferChan - buffers) - 1, (int*) b, (float*) b, numToDo);
             }
         }
 
@@ -152,7 +270,7 @@ bool AudioFormatWriter::writeFromFloatArrays (const float* const* channels, int
         const int numToDo = jmin (numSamples, maxSamples);
 
         for (int i = 0; i < numSourceChannels; ++i)
-            convertFloatsToInts (chans[i], channels[i] + startSample, numToDo);
+            convertFloatsToInts (i, chans[i], channels[i] + startSample, numToDo);
 
         if (! write ((const int**) chans, numToDo))
             return false;
@@ -153,6 +153,29 @@ public:
     /** Returns true if it's a floating-point format, false if it's fixed-point. */
     bool isFloatingPoint() const noexcept       { return usesFloatingPointData; }
 
+    //==============================================================================
+    /** The kinds of dither that can be added when float data is written to a
+        fixed-point format.
+        @see setDither
+    */
+    enum DitherType
+    {
+        noDither,               /**< Samples are just scaled and truncated, with no dither (the default). */
+        triangularDither,       /**< Adds TPDF dither of +/- 1 LSB at the file's bit depth, and rounds. */
+        noiseShapedDither       /**< Like triangularDither, but the quantisation error is shaped so
+                                     that most of it is moved up to frequencies where it's harder to
+                                     hear. This is designed for 44.1 or 48kHz material. */
+    };
+
+    /** Sets the dither to use when writeFromFloatArrays(), writeFromAudioSampleBuffer(),
+        writeFromAudioSource() or writeFromAudioReader() have to convert floating-point
+        data to a fixed-point format with fewer than 32 bits.
+    */
+    void setDither (DitherType newDitherType);
+
+    /** Returns the dither type that was set with setDither(). */
+    DitherType getDither() const noexcept       { return ditherType; }
+
     //==============================================================================
     /**
         Provides a FIFO for an AudioFormatWriter, allowing you to push incoming
@@ -268,6 +291,13 @@ private:
     String formatName;
     friend class ThreadedWriter;
 
+    struct Ditherer;
+    friend struct ContainerDeletePolicy<Ditherer>;
+    DitherType ditherType;
+    ScopedPointer<Ditherer> ditherer;
+
+    void convertFloatsToInts (int channel, int* dest, const float* src, int numSamples);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatWriter)
 };
 
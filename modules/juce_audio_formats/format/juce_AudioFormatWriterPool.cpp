@@ -0,0 +1,318 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+class AudioFormatWriterPool::EncoderThread  : public Thread
+{
+public:
+    EncoderThread (AudioFormatWriterPool& p)  : Thread ("audio encoder"), pool (p) {}
+
+    void run() override
+    {
+        while (! threadShouldExit())
+            if (! pool.encodeNextWriter())
+                pool.dataReady.wait (10);
+    }
+
+private:
+    AudioFormatWriterPool& pool;
+
+    JUCE_DECLARE_NON_COPYABLE (EncoderThread)
+};
+
+//==============================================================================
+AudioFormatWriterPool::AudioFormatWriterPool (const int numThreads, const size_t maxBytesToBuffer, const int threadPriority)
+    : numBlocks (jmax (1, (int) (maxBytesToBuffer / ((size_t) getBlockSize() * sizeof (float))))),
+      numFreeBlocks (numBlocks)
+{
+    jassert (numThreads > 0);
+
+    blockData.malloc ((size_t) numBlocks * (size_t) getBlockSize());
+    freeBlocks.malloc ((size_t) numBlocks);
+
+    for (int i = 0; i < numBlocks; ++i)
+        freeBlocks[i] = i;
+
+    for (int i = 0; i < jmax (1, numThreads); ++i)
+    {
+        EncoderThread* const t = threads.add (new EncoderThread (*this));
+        t->startThread (threadPriority);
+    }
+}
+
+AudioFormatWriterPool::~AudioFormatWriterPool()
+{
+    // You need to delete all your Writers before deleting the pool that they use!
+    jassert (writers.size() == 0);
+
+    for (int i = threads.size(); --i >= 0;)
+        threads.getUnchecked(i)->signalThreadShouldExit();
+
+    threads.clear();
+}
+
+AudioFormatWriterPool::Writer* AudioFormatWriterPool::createWriter (AudioFormatWriter* const writerToUse)
+{
+    jassert (writerToUse != nullptr);
+
+    Writer* const w = new Writer (*this, writerToUse);
+
+    const ScopedLock sl (writerLock);
+    writers.add (w);
+    return w;
+}
+
+float AudioFormatWriterPool::getProportionOfMemoryUsed() const noexcept
+{
+    return 1.0f - numFreeBlocks / (float) numBlocks;
+}
+
+int AudioFormatWriterPool::getNumWriters() const
+{
+    const ScopedLock sl (writerLock);
+    return writers.size();
+}
+
+bool AudioFormatWriterPool::allocateBlocks (int* dest, const int num) noexcept
+{
+    const SpinLock::ScopedLockType sl (freeBlockLock);
+
+    if (numFreeBlocks < num)
+        return false;
+
+    numFreeBlocks -= num;
+    memcpy (dest, freeBlocks + numFreeBlocks, (size_t) num * sizeof (int));
+    return true;
+}
+
+void AudioFormatWriterPool::releaseBlocks (const int* blocks, const int num) noexcept
+{
+    const SpinLock::ScopedLockType sl (freeBlockLock);
+
+    jassert (numFreeBlocks + num <= numBlocks);
+    memcpy (freeBlocks + numFreeBlocks, blocks, (size_t) num * sizeof (int));
+    numFreeBlocks += num;
+}
+
+bool AudioFormatWriterPool::encodeNextWriter()
+{
+    Writer* writerToEncode = nullptr;
+
+    {
+        const ScopedLock sl (writerLock);
+        int mostChunksWaiting = 0;
+
+        for (int i = writers.size(); --i >= 0;)
+        {
+            Writer* const w = writers.getUnchecked (i);
+            const int numWaiting = w->getNumChunksWaiting();
+
+            if (numWaiting > mostChunksWaiting && ! w->isBeingEncoded)
+            {
+                writerToEncode = w;
+                mostChunksWaiting = numWaiting;
+            }
+        }
+
+        if (writerToEncode == nullptr)
+            return false;
+
+        writerToEncode->isBeingEncoded = true;
+    }
+
+    // Only doing a few blocks at a time stops one busy writer from hogging a thread
+    writerToEncode->encodeChunks (4);
+
+    const ScopedLock sl (writerLock);
+    writerToEncode->isBeingEncoded = false;
+    return true;
+}
+
+//==============================================================================
+AudioFormatWriterPool::Writer::Writer (AudioFormatWriterPool& p, AudioFormatWriter* const w)
+    : pool (p), writer (w),
+      numChannels (w->getNumChannels()),
+      maxChunks (jmax (1, p.numBlocks / jmax (1, w->getNumChannels()))),
+      numSamplesInCurrentChunk (0),
+      isBeingEncoded (false),
+      receiver (nullptr),
+      samplesWritten (0),
+      samplesPerFlush (0),
+      flushSampleCounter (0)
+{
+    // This pool's memory isn't big enough for even one block of this writer's channels!
+    jassert (p.numBlocks >= numChannels);
+
+    chunkBlocks.malloc ((size_t) (maxChunks * numChannels));
+    channelPointers.malloc ((size_t) numChannels);
+}
+
+AudioFormatWriterPool::Writer::~Writer()
+{
+    {
+        const ScopedLock sl (pool.writerLock);
+        pool.writers.removeFirstMatchingValue (this);
+    }
+
+    for (;;)
+    {
+        {
+            const ScopedLock sl (pool.writerLock);
+
+            if (! isBeingEncoded)
+                break;
+        }
+
+        Thread::sleep (1);
+    }
+
+    encodeChunks (std::numeric_limits<int>::max());
+
+    if (numSamplesInCurrentChunk > 0)
+    {
+        const int chunk = numChunksReady.get() % maxChunks;
+        encodeChunk (chunk, numSamplesInCurrentChunk);
+        pool.releaseBlocks (chunkBlocks + chunk * numChannels, numChannels);
+    }
+}
+
+bool AudioFormatWriterPool::Writer::write (const float* const* data, const int numSamples)
+{
+    if (numSamples <= 0)
+        return true;
+
+    const int blockSize = getBlockSize();
+    const int firstReady = numChunksReady.get();
+    const int firstNewChunk = firstReady + (numSamplesInCurrentChunk > 0 ? 1 : 0);
+    const int numNewChunks = (numSamplesInCurrentChunk + numSamples + blockSize - 1) / blockSize
+                               - (firstNewChunk - firstReady);
+
+    if (firstNewChunk + numNewChunks - numChunksEncoded.get() > maxChunks)
+    {
+        ++numOverruns;
+        return false;
+    }
+
+    for (int i = 0; i < numNewChunks; ++i)
+    {
+        if (! pool.allocateBlocks (chunkBlocks + ((firstNewChunk + i) % maxChunks) * numChannels, numChannels))
+        {
+            while (--i >= 0)
+                pool.releaseBlocks (chunkBlocks + ((firstNewChunk + i) % maxChunks) * numChannels, numChannels);
+
+            ++numOverruns;
+            return false;
+        }
+    }
+
+    bool anyChunksFinished = false;
+
+    for (int pos = 0; pos < numSamples;)
+    {
+        const int* const blocks = chunkBlocks + (numChunksReady.get() % maxChunks) * numChannels;
+        const int num = jmin (blockSize - numSamplesInCurrentChunk, numSamples - pos);
+
+        for (int i = 0; i < numChannels; ++i)
+            memcpy (pool.getBlock (blocks[i]) + numSamplesInCurrentChunk, data[i] + pos, (size_t) num * sizeof (float));
+
+        pos += num;
+        numSamplesInCurrentChunk += num;
+
+        if (numSamplesInCurrentChunk == blockSize)
+        {
+            numSamplesInCurrentChunk = 0;
+            ++numChunksReady;
+            anyChunksFinished = true;
+        }
+    }
+
+    if (anyChunksFinished)
+        pool.dataReady.signal();
+
+    return true;
+}
+
+int AudioFormatWriterPool::Writer::getNumChunksWaiting() const noexcept
+{
+    return numChunksReady.get() - numChunksEncoded.get();
+}
+
+int AudioFormatWriterPool::Writer::getNumSamplesWaiting() const noexcept
+{
+    return getNumChunksWaiting() * getBlockSize() + numSamplesInCurrentChunk;
+}
+
+void AudioFormatWriterPool::Writer::encodeChunks (int maxNumChunks)
+{
+    for (int num = jmin (maxNumChunks, getNumChunksWaiting()); --num >= 0;)
+    {
+        const int chunk = numChunksEncoded.get() % maxChunks;
+        encodeChunk (chunk, getBlockSize());
+        pool.releaseBlocks (chunkBlocks + chunk * numChannels, numChannels);
+        ++numChunksEncoded;
+    }
+}
+
+void AudioFormatWriterPool::Writer::encodeChunk (const int chunk, const int numSamples)
+{
+    for (int i = 0; i < numChannels; ++i)
+        channelPointers[i] = pool.getBlock (chunkBlocks [chunk * numChannels + i]);
+
+    const AudioSampleBuffer buffer (channelPointers, numChannels, numSamples);
+    writer->writeFromAudioSampleBuffer (buffer, 0, numSamples);
+
+    {
+        const ScopedLock sl (receiverLock);
+
+        if (receiver != nullptr)
+            receiver->addBlock (samplesWritten, buffer, 0, numSamples);
+
+        samplesWritten += numSamples;
+    }
+
+    if (samplesPerFlush > 0)
+    {
+        flushSampleCounter -= numSamples;
+
+        if (flushSampleCounter <= 0)
+        {
+            flushSampleCounter = samplesPerFlush;
+            writer->flush();
+        }
+    }
+}
+
+void AudioFormatWriterPool::Writer::setDataReceiver (AudioFormatWriter::ThreadedWriter::IncomingDataReceiver* newReceiver)
+{
+    if (newReceiver != nullptr)
+        newReceiver->reset (numChannels, writer->getSampleRate(), 0);
+
+    const ScopedLock sl (receiverLock);
+    receiver = newReceiver;
+    samplesWritten = 0;
+}
+
+void AudioFormatWriterPool::Writer::setFlushInterval (const int numSamplesPerFlush) noexcept
+{
+    samplesPerFlush = numSamplesPerFlush;
+}
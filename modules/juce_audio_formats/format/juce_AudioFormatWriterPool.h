@@ -0,0 +1,193 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_AUDIOFORMATWRITERPOOL_H_INCLUDED
+#define JUCE_AUDIOFORMATWRITERPOOL_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Runs a set of AudioFormatWriters on a pool of background threads.
+
+    This does the same job as AudioFormatWriter::ThreadedWriter, but it's designed
+    for recording lots of files at once. An AudioFormatWriter::ThreadedWriter does
+    all its encoding on one TimeSliceThread, so if you're recording dozens of tracks
+    to a compressed format like FLAC, encoding them one after another may not keep
+    up. This class instead shares its writers between several threads, each of
+    which picks the writer with the largest backlog and encodes some of it.
+
+    The audio waiting to be written is kept in a single block of memory whose size
+    you choose when creating the pool, and the writers all share it. This means
+    that one writer that's fallen behind can use much more than its share of the
+    memory, while the total can never go over the limit. The memory is split into
+    blocks of getBlockSize() samples, and a block is only handed to an encoder once
+    it's full (or when its Writer is deleted).
+
+    Each Writer can tell you how much of its audio is still waiting to be encoded,
+    and how many times it's had to reject incoming data. You can use this to spot
+    a recording that's falling behind before any audio is lost.
+
+    @see AudioFormatWriter::ThreadedWriter
+*/
+class JUCE_API  AudioFormatWriterPool
+{
+public:
+    //==============================================================================
+    /** Creates a pool.
+
+        @param numThreads               the number of threads to use for encoding
+        @param maxBytesToBuffer         the total amount of memory that all of the writers
+                                        can use between them for the audio waiting to
+                                        be encoded
+        @param threadPriority           the priority of the encoding threads - see
+                                        Thread::setPriority()
+    */
+    AudioFormatWriterPool (int numThreads, size_t maxBytesToBuffer, int threadPriority = 5);
+
+    /** Destructor.
+        You must delete all the Writers that were created by this pool before
+        deleting the pool itself.
+    */
+    ~AudioFormatWriterPool();
+
+    //==============================================================================
+    /** Writes data to an AudioFormatWriter using the threads in an AudioFormatWriterPool.
+        You create one of these with AudioFormatWriterPool::createWriter().
+    */
+    class JUCE_API  Writer
+    {
+    public:
+        /** Destructor.
+            This waits until all the data that was written is encoded, and then
+            deletes the AudioFormatWriter.
+        */
+        ~Writer();
+
+        /** Pushes some incoming audio data into the pool.
+
+            If there's enough free memory in the pool, this copies the data and returns
+            true. If not, none of the data is used and it returns false - you can then
+            either try again later or give up and lose this block. In that case,
+            getNumOverruns() will be incremented.
+
+            This method doesn't allocate, so it's safe to call from your audio callback,
+            but you shouldn't call it for a single Writer from more than one thread at
+            once.
+
+            The data must be an array containing the same number of channels as the
+            AudioFormatWriter object is using. None of these channels can be null.
+        */
+        bool write (const float* const* data, int numSamples);
+
+        /** Returns the number of samples that have been written to this object, but
+            which haven't yet been passed to the AudioFormatWriter.
+        */
+        int getNumSamplesWaiting() const noexcept;
+
+        /** Returns the number of times that write() has had to reject some data
+            because the pool had no free memory.
+        */
+        int getNumOverruns() const noexcept             { return numOverruns.get(); }
+
+        /** Allows you to specify a callback that this writer should update with the
+            incoming data.
+            @see AudioFormatWriter::ThreadedWriter::setDataReceiver
+        */
+        void setDataReceiver (AudioFormatWriter::ThreadedWriter::IncomingDataReceiver*);
+
+        /** Sets how many samples should be written before calling the AudioFormatWriter::flush method.
+            Set this to 0 to disable flushing (this is the default).
+        */
+        void setFlushInterval (int numSamplesPerFlush) noexcept;
+
+    private:
+        friend class AudioFormatWriterPool;
+
+        AudioFormatWriterPool& pool;
+        ScopedPointer<AudioFormatWriter> writer;
+        const int numChannels, maxChunks;
+        HeapBlock<int> chunkBlocks;
+        HeapBlock<float*> channelPointers;
+        Atomic<int> numChunksReady, numChunksEncoded, numOverruns;
+        int numSamplesInCurrentChunk;
+        bool isBeingEncoded;
+
+        CriticalSection receiverLock;
+        AudioFormatWriter::ThreadedWriter::IncomingDataReceiver* receiver;
+        int64 samplesWritten;
+        int samplesPerFlush, flushSampleCounter;
+
+        Writer (AudioFormatWriterPool&, AudioFormatWriter*);
+        int getNumChunksWaiting() const noexcept;
+        void encodeChunks (int maxNumChunks);
+        void encodeChunk (int chunkIndex, int numSamples);
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Writer)
+    };
+
+    /** Creates a Writer that will encode its data on this pool's threads.
+
+        The AudioFormatWriter object which is passed in here will be owned and
+        deleted by the Writer, and the caller must delete the Writer that's returned
+        (before deleting the pool).
+    */
+    Writer* createWriter (AudioFormatWriter* writerToUse);
+
+    //==============================================================================
+    /** Returns the number of samples held by each block of memory. */
+    static int getBlockSize() noexcept                  { return 4096; }
+
+    /** Returns the proportion of the pool's memory that's currently in use, from 0 to 1. */
+    float getProportionOfMemoryUsed() const noexcept;
+
+    /** Returns the number of Writers that are currently using this pool. */
+    int getNumWriters() const;
+
+private:
+    //==============================================================================
+    class EncoderThread;
+    friend class EncoderThread;
+    friend struct ContainerDeletePolicy<EncoderThread>;
+
+    HeapBlock<float> blockData;
+    HeapBlock<int> freeBlocks;
+    const int numBlocks;
+    int numFreeBlocks;
+    SpinLock freeBlockLock;
+
+    Array<Writer*> writers;
+    CriticalSection writerLock;
+    OwnedArray<EncoderThread> threads;
+    WaitableEvent dataReady;
+
+    float* getBlock (int index) const noexcept          { return blockData + index * getBlockSize(); }
+    bool allocateBlocks (int* dest, int num) noexcept;
+    void releaseBlocks (const int* blocks, int num) noexcept;
+    bool encodeNextWriter();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatWriterPool)
+};
+
+
+#endif   // JUCE_AUDIOFORMATWRITERPOOL_H_INCLUDED
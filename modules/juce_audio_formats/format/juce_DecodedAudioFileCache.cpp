@@ -0,0 +1,247 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+class DecodedAudioFileCache::DecodeJob
+{
+public:
+    DecodeJob (AudioFormatReader* sourceReader, const File& targetFile)
+        : tempFile (targetFile), reader (sourceReader), position (0)
+    {
+    }
+
+    bool createWriter()
+    {
+        ScopedPointer<FileOutputStream> out (tempFile.getFile().createOutputStream());
+
+        if (out == nullptr)
+            return false;
+
+        // Floating-point sources (and any unusual bit depths) are stored as 32-bit floats,
+        // everything else keeps its original resolution.
+        WavAudioFormat wav;
+        const int bitDepth = (reader->usesFloatingPointData || ! wav.getPossibleBitDepths().contains ((int) reader->bitsPerSample))
+                                ? 32 : (int) reader->bitsPerSample;
+
+        writer = wav.createWriterFor (out, reader->sampleRate, reader->numChannels,
+                                      bitDepth, StringPairArray(), 0);
+
+        if (writer == nullptr)
+            return false;
+
+        out.release();
+        return true;
+    }
+
+    /** Returns true if there's more to do. */
+    bool decodeNextBlock()
+    {
+        const int64 numToDo = jmin ((int64) samplesPerBlock, reader->lengthInSamples - position);
+
+        if (numToDo > 0)
+        {
+            if (! writer->writeFromAudioReader (*reader, position, numToDo))
+                return false;
+
+            position += numToDo;
+
+            if (position < reader->lengthInSamples)
+                return true;
+        }
+
+        writer = nullptr;
+        tempFile.overwriteTargetFileWithTemporary();
+        return false;
+    }
+
+private:
+    TemporaryFile tempFile; // (declared first, so that the writer's stream is closed before it's deleted)
+    ScopedPointer<AudioFormatReader> reader;
+    ScopedPointer<AudioFormatWriter> writer;
+    int64 position;
+
+    enum { samplesPerBlock = 65536 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DecodeJob)
+};
+
+//==============================================================================
+DecodedAudioFileCache::DecodedAudioFileCache (AudioFormatManager& formats,
+                                              const File& cacheDirectory,
+                                              TimeSliceThread& backgroundThread)
+    : formatManager (formats),
+      directory (cacheDirectory),
+      thread (backgroundThread)
+{
+    directory.createDirectory();
+    thread.addTimeSliceClient (this);
+}
+
+DecodedAudioFileCache::~DecodedAudioFileCache()
+{
+    thread.removeTimeSliceClient (this);
+}
+
+File DecodedAudioFileCache::getCacheFileFor (const File& sourceFile) const
+{
+    const String description (sourceFile.getFullPathName()
+                               + "_" + String (sourceFile.getSize())
+                               + "_" + String (sourceFile.getLastModificationTime().toMilliseconds()));
+
+    return directory.getChildFile (String::toHexString (description.hashCode64()) + ".wav");
+}
+
+bool DecodedAudioFileCache::isDecoded (const File& sourceFile) const
+{
+    return getCacheFileFor (sourceFile).existsAsFile();
+}
+
+MemoryMappedAudioFormatReader* DecodedAudioFileCache::createMemoryMappedReader (const File& sourceFile,
+                                                                                const bool startDecodingIfNeeded)
+{
+    if (AudioFormat* format = formatManager.findFormatForFileExtension (sourceFile.getFileExtension()))
+        if (MemoryMappedAudioFormatReader* r = format->createMemoryMappedReader (sourceFile))
+            return r;
+
+    const File cacheFile (getCacheFileFor (sourceFile));
+
+    if (cacheFile.existsAsFile())
+    {
+        WavAudioFormat wav;
+
+        if (MemoryMappedAudioFormatReader* r = wav.createMemoryMappedReader (cacheFile))
+            return r;
+    }
+
+    if (startDecodingIfNeeded)
+        startDecoding (sourceFile);
+
+    return nullptr;
+}
+
+AudioFormatReader* DecodedAudioFileCache::createReaderFor (const File& sourceFile)
+{
+    ScopedPointer<MemoryMappedAudioFormatReader> mappedReader (createMemoryMappedReader (sourceFile, true));
+
+    if (mappedReader != nullptr && mappedReader->mapEntireFile())
+        return mappedReader.release();
+
+    return formatManager.createReaderFor (sourceFile);
+}
+
+//==============================================================================
+void DecodedAudioFileCache::startDecoding (const File& sourceFile)
+{
+    if (isDecoded (sourceFile))
+        return;
+
+    {
+        const ScopedLock sl (queueLock);
+
+        if (sourceFile == fileBeingDecoded || queue.contains (sourceFile))
+            return;
+
+        queue.add (sourceFile);
+    }
+
+    thread.moveToFrontOfQueue (this);
+}
+
+int DecodedAudioFileCache::getNumFilesPending() const
+{
+    const ScopedLock sl (queueLock);
+    return queue.size() + (fileBeingDecoded != File() ? 1 : 0);
+}
+
+void DecodedAudioFileCache::clearCache()
+{
+    const ScopedLock sl (jobLock);
+    currentJob = nullptr;
+
+    {
+        const ScopedLock sl2 (queueLock);
+        queue.clear();
+        fileBeingDecoded = File();
+    }
+
+    Array<File> files;
+    directory.findChildFiles (files, File::findFiles, false, "*.wav");
+
+    for (int i = files.size(); --i >= 0;)
+        files.getReference(i).deleteFile();
+}
+
+void DecodedAudioFileCache::startNextJob()
+{
+    File source;
+
+    {
+        const ScopedLock sl (queueLock);
+
+        if (queue.size() == 0)
+            return;
+
+        source = queue.remove (0);
+        fileBeingDecoded = source;
+    }
+
+    const File target (getCacheFileFor (source));
+
+    if (! target.existsAsFile())
+    {
+        if (AudioFormatReader* reader = formatManager.createReaderFor (source))
+        {
+            currentJob = new DecodeJob (reader, target);
+
+            if (! currentJob->createWriter())
+                currentJob = nullptr;
+        }
+    }
+}
+
+int DecodedAudioFileCache::useTimeSlice()
+{
+    const ScopedLock sl (jobLock);
+
+    if (currentJob == nullptr)
+    {
+        startNextJob();
+
+        if (currentJob == nullptr)
+        {
+            const ScopedLock sl2 (queueLock);
+            fileBeingDecoded = File();
+            return queue.size() > 0 ? 0 : 500;
+        }
+    }
+
+    if (currentJob->decodeNextBlock())
+        return 0;
+
+    currentJob = nullptr;
+
+    const ScopedLock sl2 (queueLock);
+    fileBeingDecoded = File();
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_DECODEDAUDIOFILECACHE_H_INCLUDED
+#define JUCE_DECODEDAUDIOFILECACHE_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Keeps decoded copies of compressed audio files, so that they can be read with
+    a MemoryMappedAudioFormatReader.
+
+    Formats like FLAC and Ogg-Vorbis can't be memory-mapped, so reading them at random
+    positions (e.g. for a sampler with lots of voices) means decoding them on the fly.
+    This class decompresses them once, on a background thread, into uncompressed WAV
+    files in a cache directory, after which they can be memory-mapped as cheaply as
+    any other WAV file.
+
+    Each cached file's name is derived from the original file's path, size and
+    modification time, so if the original changes, it'll be decoded again. Old cache
+    files are left in the directory until clearCache() is called.
+
+    The AudioFormatManager is used from the background thread, so don't register
+    any new formats with it while this cache exists.
+
+    @see MemoryMappedAudioFormatReader, AudioFormat::createMemoryMappedReader
+*/
+class JUCE_API  DecodedAudioFileCache  : private TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** Creates a cache.
+
+        @param formatManager    the formats to use to read the original files. This must
+                                not be deleted while the cache is in use
+        @param cacheDirectory   the directory to keep the decoded files in. This will be
+                                created if it doesn't already exist
+        @param backgroundThread the thread that should be used to decode the files. Make
+                                sure that the thread you supply is running, and won't be
+                                deleted while the cache still exists
+    */
+    DecodedAudioFileCache (AudioFormatManager& formatManager,
+                           const File& cacheDirectory,
+                           TimeSliceThread& backgroundThread);
+
+    /** Destructor. If a file is half-way through being decoded, it'll be abandoned. */
+    ~DecodedAudioFileCache();
+
+    //==============================================================================
+    /** Tries to create a memory-mapped reader for a file.
+
+        If the file's format can be memory-mapped directly, this just returns the
+        format's own reader. Otherwise, if a decoded copy of the file is in the cache,
+        it returns a reader for that (so its getFile() method will return the cached
+        file, not the original). If neither of those is possible, it returns nullptr, and
+        if startDecodingIfNeeded is true, the file is added to the queue of files to decode.
+
+        As with any MemoryMappedAudioFormatReader, you'll need to call mapEntireFile()
+        or mapSectionOfFile() before reading from it. The caller must delete the object
+        that is returned.
+    */
+    MemoryMappedAudioFormatReader* createMemoryMappedReader (const File& sourceFile,
+                                                             bool startDecodingIfNeeded = true);
+
+    /** Creates a reader for a file, using the decoded copy if there is one.
+
+        If a memory-mapped reader can be created with createMemoryMappedReader(), this
+        maps the entire file and returns that. Otherwise, it starts decoding the file in
+        the background, and returns a normal reader from the AudioFormatManager, so it'll
+        only return nullptr if the file can't be read at all.
+
+        The caller must delete the object that is returned.
+    */
+    AudioFormatReader* createReaderFor (const File& sourceFile);
+
+    //==============================================================================
+    /** Adds a file to the queue of files to decode, unless it's already been done. */
+    void startDecoding (const File& sourceFile);
+
+    /** Returns true if a decoded copy of this file is available. */
+    bool isDecoded (const File& sourceFile) const;
+
+    /** Returns the number of files that are queued or being decoded. */
+    int getNumFilesPending() const;
+
+    /** Returns the file that a decoded copy of this file would be stored in. */
+    File getCacheFileFor (const File& sourceFile) const;
+
+    /** Abandons any pending work and deletes all the files in the cache directory.
+        Don't call this while any readers for cached files are still in use.
+    */
+    void clearCache();
+
+private:
+    //==============================================================================
+    class DecodeJob;
+
+    AudioFormatManager& formatManager;
+    const File directory;
+    TimeSliceThread& thread;
+
+    CriticalSection queueLock, jobLock;
+    Array<File> queue;
+    File fileBeingDecoded;
+    ScopedPointer<DecodeJob> currentJob;
+
+    int useTimeSlice() override;
+    void startNextJob();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DecodedAudioFileCache)
+};
+
+
+#endif   // JUCE_DECODEDAUDIOFILECACHE_H_INCLUDED
@@ -55,6 +55,9 @@ protected:
                                    int64 dataChunkStart, int64 dataChunkLength, int bytesPerFrame);
 
 public:
+    /** Destructor. */
+    ~MemoryMappedAudioFormatReader();
+
     /** Returns the file that is being mapped */
     const File& getFile() const noexcept                    { return file; }
 
@@ -70,6 +73,35 @@ public:
     /** Touches the memory for the given sample, to force it to be loaded into active memory. */
     void touchSample (int64 sample) const noexcept;
 
+    /** Asks the OS to start reading a range of samples from the disk in the background.
+        Only the part of the range that lies within the mapped section is affected.
+        @see MemoryMappedFile::prefetch
+    */
+    void prefetchSamples (Range<int64> samples) const noexcept;
+
+    /** Asks a MemoryMappedFilePrefetcher to load a range of samples into memory on its
+        background thread.
+
+        This is safe to call from the audio thread. The reader will cancel any pending
+        requests when it's deleted or re-mapped, so the prefetcher must outlive it.
+        @returns false if the prefetcher's queue was full
+    */
+    bool prefetchSamples (MemoryMappedFilePrefetcher& prefetcher, Range<int64> samples) noexcept;
+
+    /** Locks a range of samples into physical memory, so that they can't be paged out.
+        @see MemoryMappedFile::lockInMemory
+    */
+    bool lockSamplesInMemory (Range<int64> samples) noexcept;
+
+    /** Unlocks a range of samples that was locked with lockSamplesInMemory(). */
+    void unlockSamplesFromMemory (Range<int64> samples) noexcept;
+
+    /** Tells the OS how the mapped section is going to be read.
+        The pattern is remembered and applied again if a different section is mapped.
+        @see MemoryMappedFile::setAccessPattern
+    */
+    void setAccessPattern (MemoryMappedFile::AccessPattern pattern) noexcept;
+
     /** Returns the samples for all channels at a given sample position.
         The result array must be large enough to hold a value for each channel
         that this reader contains.
@@ -85,6 +117,11 @@ protected:
     ScopedPointer<MemoryMappedFile> map;
     int64 dataChunkStart, dataLength;
     int bytesPerFrame;
+    MemoryMappedFile::AccessPattern accessPattern;
+    MemoryMappedFilePrefetcher* prefetcher;
+
+    void unmap();
+    Range<int64> samplesToFileRange (Range<int64> samples) const noexcept;
 
     /** Converts a sample index to a byte position in the file. */
     inline int64 sampleToFilePos (int64 sample) const noexcept       { return dataChunkStart + sample * bytesPerFrame; }
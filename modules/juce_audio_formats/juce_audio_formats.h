@@ -88,12 +88,16 @@ namespace juce
 class AudioFormat;
 #include "format/juce_AudioFormatReader.h"
 #include "format/juce_AudioFormatWriter.h"
+#include "format/juce_AudioFormatWriterPool.h"
 #include "format/juce_MemoryMappedAudioFormatReader.h"
 #include "format/juce_AudioFormat.h"
 #include "format/juce_AudioFormatManager.h"
 #include "format/juce_AudioFormatReaderSource.h"
 #include "format/juce_AudioSubsectionReader.h"
 #include "format/juce_BufferingAudioFormatReader.h"
+#include "format/juce_AsyncAudioFormatReader.h"
+#include "format/juce_DecodedAudioFileCache.h"
+#include "format/juce_AudioFileIndex.h"
 #include "codecs/juce_AiffAudioFormat.h"
 #include "codecs/juce_CoreAudioFormat.h"
 #include "codecs/juce_FlacAudioFormat.h"
@@ -104,6 +108,7 @@ class AudioFormat;
 #include "codecs/juce_WavAudioFormat.h"
 #include "codecs/juce_WindowsMediaAudioFormat.h"
 #include "sampler/juce_Sampler.h"
+#include "sampler/juce_StreamingSampler.h"
 
 }
 
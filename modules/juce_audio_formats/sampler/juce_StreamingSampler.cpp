@@ -0,0 +1,329 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+StreamingSamplerSound::StreamingSamplerSound (const String& soundName,
+                                              AudioFormatReader* const source,
+                                              const BigInteger& notes,
+                                              const int midiNoteForNormalPitch,
+                                              const double attackTimeSecs,
+                                              const double releaseTimeSecs,
+                                              const double maxSampleLengthSeconds,
+                                              const double preloadTimeSecs)
+    : name (soundName),
+      reader (source),
+      sourceSampleRate (0),
+      midiNotes (notes),
+      numChannels (0), length (0), preloadLength (0),
+      attackSamples (0), releaseSamples (0),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    jassert (source != nullptr);
+
+    if (source != nullptr && source->sampleRate > 0 && source->lengthInSamples > 0)
+    {
+        sourceSampleRate = source->sampleRate;
+        numChannels = jmin (2, (int) source->numChannels);
+
+        length = (int) jmin (source->lengthInSamples,
+                             (int64) (maxSampleLengthSeconds * sourceSampleRate));
+
+        preloadLength = jmin (length, roundToInt (preloadTimeSecs * sourceSampleRate));
+
+        preloadBuffer.setSize (numChannels, preloadLength + 4);
+        preloadBuffer.clear();
+        readFromSource (preloadBuffer, 0, preloadLength, 0);
+
+        attackSamples = roundToInt (attackTimeSecs * sourceSampleRate);
+        releaseSamples = roundToInt (releaseTimeSecs * sourceSampleRate);
+    }
+}
+
+StreamingSamplerSound::~StreamingSamplerSound()
+{
+}
+
+bool StreamingSamplerSound::appliesToNote (int midiNoteNumber)
+{
+    return midiNotes [midiNoteNumber];
+}
+
+bool StreamingSamplerSound::appliesToChannel (int /*midiChannel*/)
+{
+    return true;
+}
+
+void StreamingSamplerSound::readFromSource (AudioSampleBuffer& dest, int destStartSample,
+                                            int numSamples, int sourceStartSample)
+{
+    const ScopedLock sl (readerLock);
+    reader->read (&dest, destStartSample, numSamples, sourceStartSample, true, true);
+}
+
+//==============================================================================
+StreamingSamplerVoice::StreamingSamplerVoice (TimeSliceThread& backgroundThread, int ringBufferSize)
+    : thread (backgroundThread),
+      ringBuffer (2, nextPowerOfTwo (jmax (1024, ringBufferSize))),
+      ringSize (ringBuffer.getNumSamples()),
+      streamGeneration (0), streamValidEnd (0), streamReadPosition (0),
+      pitchRatio (0.0),
+      sourceSamplePosition (0.0),
+      lgain (0.0f), rgain (0.0f),
+      attackReleaseLevel (0), attackDelta (0), releaseDelta (0),
+      isInAttack (false), isInRelease (false),
+      numUnderruns (0)
+{
+    ringBuffer.clear();
+    thread.addTimeSliceClient (this);
+}
+
+StreamingSamplerVoice::~StreamingSamplerVoice()
+{
+    thread.removeTimeSliceClient (this);
+}
+
+bool StreamingSamplerVoice::canPlaySound (SynthesiserSound* sound)
+{
+    return dynamic_cast<const StreamingSamplerSound*> (sound) != nullptr;
+}
+
+void StreamingSamplerVoice::startNote (const int midiNoteNumber,
+                                       const float velocity,
+                                       SynthesiserSound* s,
+                                       const int /*currentPitchWheelPosition*/)
+{
+    if (StreamingSamplerSound* const sound = dynamic_cast <StreamingSamplerSound*> (s))
+    {
+        pitchRatio = pow (2.0, (midiNoteNumber - sound->midiRootNote) / 12.0)
+                        * sound->sourceSampleRate / getSampleRate();
+
+        sourceSamplePosition = 0.0;
+        lgain = velocity;
+        rgain = velocity;
+
+        isInAttack = (sound->attackSamples > 0);
+        isInRelease = false;
+
+        if (isInAttack)
+        {
+            attackReleaseLevel = 0.0f;
+            attackDelta = (float) (pitchRatio / sound->attackSamples);
+        }
+        else
+        {
+            attackReleaseLevel = 1.0f;
+            attackDelta = 0.0f;
+        }
+
+        if (sound->releaseSamples > 0)
+            releaseDelta = (float) (-pitchRatio / sound->releaseSamples);
+        else
+            releaseDelta = -1.0f;
+
+        // The new note plays from the preloaded data while the background thread
+        // starts filling the ring buffer with whatever comes after it.
+        const SpinLock::ScopedLockType sl (streamLock);
+        streamSound = sound;
+        ++streamGeneration;
+        streamValidEnd = sound->preloadLength;
+        streamReadPosition = 0;
+    }
+    else
+    {
+        jassertfalse; // this object can only play StreamingSamplerSounds!
+    }
+}
+
+void StreamingSamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
+{
+    if (allowTailOff)
+    {
+        isInAttack = false;
+        isInRelease = true;
+    }
+    else
+    {
+        stopStreaming();
+        clearCurrentNote();
+    }
+}
+
+void StreamingSamplerVoice::stopStreaming() noexcept
+{
+    const SpinLock::ScopedLockType sl (streamLock);
+    streamSound = nullptr;
+    ++streamGeneration;
+}
+
+void StreamingSamplerVoice::pitchWheelMoved (const int /*newValue*/)
+{
+}
+
+void StreamingSamplerVoice::controllerMoved (const int /*controllerNumber*/,
+                                             const int /*newValue*/)
+{
+}
+
+//==============================================================================
+int StreamingSamplerVoice::useTimeSlice()
+{
+    StreamingSamplerSound::Ptr sound;
+    int generation, start, end;
+
+    {
+        const SpinLock::ScopedLockType sl (streamLock);
+
+        if (streamSound == nullptr)
+            return 20;
+
+        sound = streamSound;
+        generation = streamGeneration;
+        start = streamValidEnd;
+
+        // The ring buffer slots we can write to are the ones holding samples that
+        // come before the voice's current read position.
+        end = streamReadPosition + ringSize - 8;
+    }
+
+    const int maxChunkSize = 8192;
+    end = jmin (end, start + maxChunkSize, sound->length);
+
+    if (end <= start)
+        return start >= sound->length ? 20 : 2;
+
+    const int ringStart = start & (ringSize - 1);
+    const int numBeforeWrap = jmin (end - start, ringSize - ringStart);
+
+    sound->readFromSource (ringBuffer, ringStart, numBeforeWrap, start);
+
+    if (numBeforeWrap < end - start)
+        sound->readFromSource (ringBuffer, 0, end - start - numBeforeWrap, start + numBeforeWrap);
+
+    {
+        const SpinLock::ScopedLockType sl (streamLock);
+
+        // (if the voice has started a different note in the meantime, this data gets discarded)
+        if (generation == streamGeneration)
+            streamValidEnd = end;
+    }
+
+    return 0;
+}
+
+float StreamingSamplerVoice::getSample (const StreamingSamplerSound& sound, int channel,
+                                        int index, int availableEnd) const noexcept
+{
+    if (index < sound.preloadLength)
+        return sound.preloadBuffer.getSample (channel, index);
+
+    if (index < availableEnd)
+        return ringBuffer.getSample (channel, index & (ringSize - 1));
+
+    return 0.0f;
+}
+
+void StreamingSamplerVoice::renderNextBlock (AudioSampleBuffer& outputBuffer, int startSample, int numSamples)
+{
+    if (const StreamingSamplerSound* const playingSound = static_cast <StreamingSamplerSound*> (getCurrentlyPlayingSound().get()))
+    {
+        int availableEnd;
+
+        {
+            const SpinLock::ScopedLockType sl (streamLock);
+            streamReadPosition = (int) sourceSamplePosition;
+            availableEnd = streamValidEnd;
+        }
+
+        const bool isStereo = playingSound->numChannels > 1;
+
+        float* outL = outputBuffer.getWritePointer (0, startSample);
+        float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+
+        while (--numSamples >= 0)
+        {
+            const int pos = (int) sourceSamplePosition;
+            const float alpha = (float) (sourceSamplePosition - pos);
+            const float invAlpha = 1.0f - alpha;
+
+            if (pos + 1 >= availableEnd && pos + 1 < playingSound->length)
+                ++numUnderruns;
+
+            // just using a very simple linear interpolation here..
+            float l = getSample (*playingSound, 0, pos, availableEnd) * invAlpha
+                        + getSample (*playingSound, 0, pos + 1, availableEnd) * alpha;
+
+            float r = isStereo ? getSample (*playingSound, 1, pos, availableEnd) * invAlpha
+                                   + getSample (*playingSound, 1, pos + 1, availableEnd) * alpha
+                               : l;
+
+            l *= lgain;
+            r *= rgain;
+
+            if (isInAttack)
+            {
+                l *= attackReleaseLevel;
+                r *= attackReleaseLevel;
+
+                attackReleaseLevel += attackDelta;
+
+                if (attackReleaseLevel >= 1.0f)
+                {
+                    attackReleaseLevel = 1.0f;
+                    isInAttack = false;
+                }
+            }
+            else if (isInRelease)
+            {
+                l *= attackReleaseLevel;
+                r *= attackReleaseLevel;
+
+                attackReleaseLevel += releaseDelta;
+
+                if (attackReleaseLevel <= 0.0f)
+                {
+                    stopNote (0.0f, false);
+                    break;
+                }
+            }
+
+            if (outR != nullptr)
+            {
+                *outL++ += l;
+                *outR++ += r;
+            }
+            else
+            {
+                *outL++ += (l + r) * 0.5f;
+            }
+
+            sourceSamplePosition += pitchRatio;
+
+            if (sourceSamplePosition > playingSound->length)
+            {
+                stopNote (0.0f, false);
+                break;
+            }
+        }
+    }
+}
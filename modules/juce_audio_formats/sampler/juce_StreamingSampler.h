@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_STREAMINGSAMPLER_H_INCLUDED
+#define JUCE_STREAMINGSAMPLER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A SynthesiserSound that plays a sample which is streamed from disk.
+
+    Unlike SamplerSound, this only loads the first part of the sample into memory.
+    The rest is read on demand by StreamingSamplerVoice objects, using a background
+    thread, so that very large sample sets can be used without running out of memory.
+
+    @see StreamingSamplerVoice, SamplerSound
+*/
+class JUCE_API  StreamingSamplerSound    : public SynthesiserSound
+{
+public:
+    //==============================================================================
+    /** Creates a streamed sound from an audio reader.
+
+        @param name         a name for the sample
+        @param source       the audio to play. This object will take ownership of the
+                            reader and keep it open so that it can stream from it, so
+                            the reader must not be used by anything else
+        @param midiNotes    the set of midi keys that this sound should be played on
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate
+        @param attackTimeSecs   the attack (fade-in) time, in seconds
+        @param releaseTimeSecs  the decay (fade-out) time, in seconds
+        @param maxSampleLengthSeconds   a maximum length of audio to play from the source,
+                                        in seconds
+        @param preloadTimeSecs  the length of audio to keep in memory. This has to cover
+                                the time it takes for a voice's background thread to
+                                start reading the rest of the sample from disk
+    */
+    StreamingSamplerSound (const String& name,
+                           AudioFormatReader* source,
+                           const BigInteger& midiNotes,
+                           int midiNoteForNormalPitch,
+                           double attackTimeSecs,
+                           double releaseTimeSecs,
+                           double maxSampleLengthSeconds,
+                           double preloadTimeSecs = 0.25);
+
+    /** Destructor. */
+    ~StreamingSamplerSound();
+
+    //==============================================================================
+    /** Returns the sample's name */
+    const String& getName() const noexcept                  { return name; }
+
+    /** Returns the total length of the sample that will be played. */
+    int getLengthInSamples() const noexcept                 { return length; }
+
+    /** Returns the number of samples at the start of the sound that are held in memory. */
+    int getNumPreloadedSamples() const noexcept             { return preloadLength; }
+
+    //==============================================================================
+    bool appliesToNote (int midiNoteNumber) override;
+    bool appliesToChannel (int midiChannel) override;
+
+    /** A pointer to a StreamingSamplerSound. */
+    typedef ReferenceCountedObjectPtr<StreamingSamplerSound> Ptr;
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerVoice;
+
+    String name;
+    ScopedPointer<AudioFormatReader> reader;
+    CriticalSection readerLock;
+    AudioSampleBuffer preloadBuffer;
+    double sourceSampleRate;
+    BigInteger midiNotes;
+    int numChannels, length, preloadLength, attackSamples, releaseSamples;
+    int midiRootNote;
+
+    void readFromSource (AudioSampleBuffer& dest, int destStartSample, int numSamples, int sourceStartSample);
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerSound)
+};
+
+
+//==============================================================================
+/**
+    A SynthesiserVoice that can play a StreamingSamplerSound.
+
+    Each voice has a ring buffer which is kept filled ahead of the playback position
+    by a TimeSliceThread. While a note starts playing from the sound's preloaded data,
+    the thread starts reading the rest of the sample into the ring buffer, and playback
+    seamlessly moves over to this once it gets past the end of the preloaded section.
+
+    If the disk can't keep up, the voice outputs silence for the missing samples, and
+    getNumUnderruns() is incremented.
+
+    @see StreamingSamplerSound, Synthesiser
+*/
+class JUCE_API  StreamingSamplerVoice    : public SynthesiserVoice,
+                                           private TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** Creates a voice.
+
+        @param backgroundThread     the thread that will read the audio from disk. This
+                                    must be running, and must not be deleted until after
+                                    the voice. Lots of voices can share the same thread.
+        @param ringBufferSize       the number of samples to buffer ahead of the current
+                                    playback position. This will be rounded up to a power
+                                    of two.
+    */
+    StreamingSamplerVoice (TimeSliceThread& backgroundThread, int ringBufferSize = 65536);
+
+    /** Destructor. */
+    ~StreamingSamplerVoice();
+
+    //==============================================================================
+    /** Returns the number of samples which couldn't be played because the disk
+        hadn't read them in time.
+    */
+    int getNumUnderruns() const noexcept                    { return numUnderruns; }
+
+    //==============================================================================
+    bool canPlaySound (SynthesiserSound*) override;
+
+    void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int pitchWheel) override;
+    void stopNote (float velocity, bool allowTailOff) override;
+
+    void pitchWheelMoved (int newValue) override;
+    void controllerMoved (int controllerNumber, int newValue) override;
+
+    void renderNextBlock (AudioSampleBuffer&, int startSample, int numSamples) override;
+
+private:
+    //==============================================================================
+    TimeSliceThread& thread;
+    AudioSampleBuffer ringBuffer;
+    const int ringSize;
+
+    // These are shared with the background thread, and protected by the lock
+    SpinLock streamLock;
+    StreamingSamplerSound::Ptr streamSound;
+    int streamGeneration, streamValidEnd, streamReadPosition;
+
+    double pitchRatio;
+    double sourceSamplePosition;
+    float lgain, rgain, attackReleaseLevel, attackDelta, releaseDelta;
+    bool isInAttack, isInRelease;
+    int numUnderruns;
+
+    int useTimeSlice() override;
+    void stopStreaming() noexcept;
+    float getSample (const StreamingSamplerSound&, int channel, int index, int availableEnd) const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StreamingSamplerVoice)
+};
+
+
+#endif   // JUCE_STREAMINGSAMPLER_H_INCLUDED
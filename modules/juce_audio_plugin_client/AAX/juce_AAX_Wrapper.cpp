@@ -862,6 +862,7 @@ struct AAXClasses
                 }
 
                 const ScopedLock sl (pluginInstance->getCallbackLock());
+                const RealtimeSafety::ScopedRealtimeContext realtimeContext;
 
                 if (bypass)
                     pluginInstance->processBlockBypassed (buffer, midiBuffer);
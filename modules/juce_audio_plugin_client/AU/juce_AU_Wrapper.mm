@@ -915,6 +915,7 @@ public:
                 AudioSampleBuffer buffer (channels, jmax (numIn, numOut), (int) numSamples);
 
                 const ScopedLock sl (juceFilter->getCallbackLock());
+                const RealtimeSafety::ScopedRealtimeContext realtimeContext;
 
                 if (juceFilter->isSuspended())
                 {
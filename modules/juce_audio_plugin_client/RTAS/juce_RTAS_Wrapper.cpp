@@ -571,6 +571,7 @@ public:
                 }
 
                 AudioSampleBuffer chans (channels, totalChans, numSamples);
+                const RealtimeSafety::ScopedRealtimeContext realtimeContext;
 
                 if (mBypassed)
                     juceFilter->processBlockBypassed (chans, midiEvents);
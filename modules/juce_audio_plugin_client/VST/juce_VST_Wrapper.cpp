@@ -264,7 +264,10 @@ public:
         #else
          useNSView (false),
         #endif
+         useDoublePrecision (false),
+         tempChannelBuffer (1, 1),
          processTempBuffer (1, 1),
+         doublePrecisionBuffer (1, 1),
          hostWindow (0)
     {
         filter->setPlayConfigDetails (numInChans, numOutChans, 0, 0);
@@ -280,6 +283,7 @@ public:
         setNumOutputs (numOutChans);
 
         canProcessReplacing (true);
+        canDoubleReplacing (true);
 
         isSynth ((JucePlugin_IsSynth) != 0);
         setInitialDelay (filter->getLatencySamples());
@@ -311,7 +315,6 @@ public:
                 jassert (editorComp == 0);
 
                 channels.free();
-                deleteTempChannels();
 
                 jassert (activePlugins.contains (this));
                 activePlugins.removeFirstMatchingValue (this);
@@ -503,7 +506,8 @@ public:
         const int numIn = numInChans;
         const int numOut = numOutChans;
 
-        processTempBuffer.setSize (numIn, numSamples, false, false, true);
+        checkFirstProcessCallback();
+        ensureBuffersAreLargeEnough (numSamples);
 
         for (int i = numIn; --i >= 0;)
             processTempBuffer.copyFrom (i, 0, outputs[i], numSamples);
@@ -516,7 +520,7 @@ public:
             dest.addFrom (i, 0, processTempBuffer, i, 0, numSamples);
     }
 
-    void processReplacing (float** inputs, float** outputs, VstInt32 numSamples) override
+    void checkFirstProcessCallback()
     {
         if (firstProcessCallback)
         {
@@ -538,12 +542,15 @@ public:
                 filter->setNonRealtime (true);
            #endif
         }
+    }
 
-       #if JUCE_DEBUG && ! JucePlugin_ProducesMidiOutput
+    void processReplacing (float** inputs, float** outputs, VstInt32 numSamples) override
+    {
+        checkFirstProcessCallback();
         const int numMidiEventsComingIn = midiEvents.getNumEvents();
-       #endif
 
         jassert (activePlugins.contains (this));
+        ensureBuffersAreLargeEnough (numSamples);
 
         {
             const ScopedLock sl (filter->getCallbackLock());
@@ -569,12 +576,12 @@ public:
 
                         // if some output channels are disabled, some hosts supply the same buffer
                         // for multiple channels - this buggers up our method of copying the
-                        // inputs over the outputs, so we need to create unique temp buffers in this case..
+                        // inputs over the outputs, so we need to use unique temp buffers in this case..
                         for (int j = i; --j >= 0;)
                         {
                             if (outputs[j] == chan)
                             {
-                                chan = new float [blockSize * 2];
+                                chan = tempChannelBuffer.getWritePointer (i);
                                 tempChannels.set (i, chan);
                                 break;
                             }
@@ -592,6 +599,7 @@ public:
 
                 {
                     AudioSampleBuffer chans (channels, jmax (numIn, numOut), numSamples);
+                    const RealtimeSafety::ScopedRealtimeContext realtimeContext;
 
                     if (isBypassed)
                         filter->processBlockBypassed (chans, midiEvents);
@@ -606,6 +614,14 @@ public:
             }
         }
 
+        handleMidiOutput (numSamples, numMidiEventsComingIn);
+    }
+
+    // Sends any events that the filter has left in the midi buffer on to the host.
+    void handleMidiOutput (const int numSamples, const int numMidiEventsComingIn)
+    {
+        (void) numSamples; (void) numMidiEventsComingIn;
+
         if (! midiEvents.isEmpty())
         {
            #if JucePlugin_ProducesMidiOutput
@@ -648,6 +664,91 @@ public:
         }
     }
 
+    // If the filter has been set to double precision, it processes the host's samples at
+    // that precision. Otherwise, it only works in single precision, so this converts the host's
+    // buffers into a buffer that was allocated in resume(), and processes that in place.
+    void processDoubleReplacing (double** inputs, double** outputs, VstInt32 numSamples) override
+    {
+        if (filter->isUsingDoublePrecision())
+        {
+            processDoublePrecision (inputs, outputs, numSamples);
+            return;
+        }
+
+        const int numIn = numInChans;
+        const int numOut = numOutChans;
+
+        checkFirstProcessCallback();
+        ensureBuffersAreLargeEnough (numSamples);
+        float** const chans = doublePrecisionBuffer.getArrayOfWritePointers();
+
+        for (int i = 0; i < numIn; ++i)
+            for (int j = 0; j < numSamples; ++j)
+                chans[i][j] = (float) inputs[i][j];
+
+        for (int i = numIn; i < numOut; ++i)
+            FloatVectorOperations::clear (chans[i], numSamples);
+
+        processReplacing (chans, chans, numSamples);
+
+        for (int i = 0; i < numOut; ++i)
+            for (int j = 0; j < numSamples; ++j)
+                outputs[i][j] = chans[i][j];
+    }
+
+    // The host's channels are copied into a buffer that was allocated in resume(), so that
+    // hosts which use the same memory for several channels can't upset the filter.
+    void processDoublePrecision (double** inputs, double** outputs, const int numSamples)
+    {
+        const int numIn = numInChans;
+        const int numOut = numOutChans;
+
+        checkFirstProcessCallback();
+        const int numMidiEventsComingIn = midiEvents.getNumEvents();
+        ensureBuffersAreLargeEnough (numSamples);
+
+        AudioBuffer<double> chans (doublePrecisionProcessBuffer.getArrayOfWritePointers(),
+                                   jmax (numIn, numOut), numSamples);
+
+        for (int i = 0; i < numIn; ++i)
+            chans.copyFrom (i, 0, inputs[i], numSamples);
+
+        for (int i = numIn; i < numOut; ++i)
+            chans.clear (i, 0, numSamples);
+
+        {
+            const ScopedLock sl (filter->getCallbackLock());
+
+            if (filter->isSuspended())
+            {
+                chans.clear();
+            }
+            else
+            {
+                const RealtimeSafety::ScopedRealtimeContext realtimeContext;
+
+                if (isBypassed)
+                    filter->processBlockBypassed (chans, midiEvents);
+                else
+                    filter->processBlock (chans, midiEvents);
+            }
+        }
+
+        for (int i = 0; i < numOut; ++i)
+            FloatVectorOperations::copy (outputs[i], chans.getReadPointer (i), numSamples);
+
+        handleMidiOutput (numSamples, numMidiEventsComingIn);
+    }
+
+    // VST 2.4 hosts call this while the plugin is suspended, before using processDoubleReplacing(),
+    // so the new precision is passed on to the filter before it's next prepared in resume().
+    bool setProcessPrecision (VstInt32 precision) override
+    {
+        useDoublePrecision = precision == kVstProcessPrecision64
+                               && filter != nullptr && filter->supportsDoublePrecisionProcessing();
+        return true;
+    }
+
     //==============================================================================
     VstInt32 startProcess() override  { return 0; }
     VstInt32 stopProcess() override   { return 0; }
@@ -671,8 +772,10 @@ public:
 
             filter->setNonRealtime (getCurrentProcessLevel() == 4 /* kVstProcessLevelOffline */);
             filter->setPlayConfigDetails (numInChans, numOutChans, rate, currentBlockSize);
+            filter->setProcessingPrecision (useDoublePrecision ? AudioProcessor::doublePrecision
+                                                               : AudioProcessor::singlePrecision);
 
-            deleteTempChannels();
+            allocateTempBuffers (currentBlockSize);
 
             filter->prepareToPlay (rate, currentBlockSize);
 
@@ -701,7 +804,7 @@ public:
             isProcessing = false;
             channels.free();
 
-            deleteTempChannels();
+            allocateTempBuffers (1);
         }
     }
 
@@ -1090,6 +1193,7 @@ public:
 
                 for (int i = ComponentPeer::getNumPeers(); --i >= 0;)
                     if (ComponentPeer* p = ComponentPeer::getPeer(i))
+                        p->flushQueuedRepaints();
                         p->performAnyPendingRepaintsNow();
 
                 recursionCheck = false;
@@ -1456,10 +1560,11 @@ private:
     VstSpeakerArrangementType speakerIn, speakerOut;
     int numInChans, numOutChans;
     bool isProcessing, isBypassed, hasShutdown, isInSizeWindow, firstProcessCallback;
-    bool shouldDeleteEditor, useNSView;
+    bool shouldDeleteEditor, useNSView, useDoublePrecision;
     HeapBlock<float*> channels;
     Array<float*> tempChannels;  // see note in processReplacing()
-    AudioSampleBuffer processTempBuffer;
+    AudioSampleBuffer tempChannelBuffer, processTempBuffer, doublePrecisionBuffer;
+    AudioBuffer<double> doublePrecisionProcessBuffer;
 
    #if JUCE_MAC
     void* hostWindow;
@@ -1517,15 +1622,31 @@ private:
    #endif
 
     //==============================================================================
-    void deleteTempChannels()
+    // All the buffers that the process callbacks need are allocated here, so that
+    // processing a block never has to allocate.
+    void allocateTempBuffers (const int numSamples)
     {
-        for (int i = tempChannels.size(); --i >= 0;)
-            delete[] (tempChannels.getUnchecked(i));
-
-        tempChannels.clear();
+        tempChannels.clearQuick();
 
         if (filter != nullptr)
             tempChannels.insertMultiple (0, nullptr, filter->getNumInputChannels() + filter->getNumOutputChannels());
+
+        tempChannelBuffer.setSize (jmax (1, numOutChans), numSamples);
+        processTempBuffer.setSize (jmax (1, numInChans), numSamples);
+        doublePrecisionBuffer.setSize (jmax (1, numInChans, numOutChans), numSamples);
+        doublePrecisionProcessBuffer.setSize (useDoublePrecision ? jmax (1, numInChans, numOutChans) : 1,
+                                              numSamples);
+    }
+
+    // Only a host that breaks its promise about the maximum block size will trigger this.
+    void ensureBuffersAreLargeEnough (const int numSamples)
+    {
+        if (numSamples > tempChannelBuffer.getNumSamples())
+        {
+            jassertfalse;
+            const RealtimeSafety::ScopedRealtimeExemption exemption;
+            allocateTempBuffers (numSamples);
+        }
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (JuceVSTWrapper)
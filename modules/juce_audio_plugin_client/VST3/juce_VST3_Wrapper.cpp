@@ -779,6 +779,8 @@ public:
 
             channelList.clear();
             channelList.insertMultiple (0, nullptr, jmax (JucePlugin_MaxNumInputChannels, JucePlugin_MaxNumOutputChannels) + 1);
+            doubleChannelList.clear();
+            doubleChannelList.insertMultiple (0, nullptr, jmax (JucePlugin_MaxNumInputChannels, JucePlugin_MaxNumOutputChannels) + 1);
 
             preparePlugin (sampleRate, bufferSize);
         }
@@ -1180,7 +1182,11 @@ public:
 
     tresult PLUGIN_API canProcessSampleSize (Steinberg::int32 symbolicSampleSize) override
     {
-        return symbolicSampleSize == Vst::kSample32 ? kResultTrue : kResultFalse;
+        if (symbolicSampleSize == Vst::kSample32)
+            return kResultTrue;
+
+        return symbolicSampleSize == Vst::kSample64 && getPluginInstance().supportsDoublePrecisionProcessing()
+                 ? kResultTrue : kResultFalse;
     }
 
     Steinberg::uint32 PLUGIN_API getLatencySamples() override
@@ -1220,26 +1226,42 @@ public:
     }
 
     //==============================================================================
+    // Every point of the host's automation is pushed into the plugin's ParameterChangeQueue,
+    // so that a processBlock() which reads the queue can apply them at their sample offsets.
+    // Plugins that don't read it still get each parameter set to its final value for the block.
     void processParameterChanges (Vst::IParameterChanges& paramChanges)
     {
         jassert (pluginInstance != nullptr);
 
+        ParameterChangeQueue& queue = pluginInstance->getParameterChangeQueue();
+
+        // (anything the plugin didn't read during the last block is out of date now - this
+        //  is the same thread that the plugin reads from, so it's safe to drain it here)
+        ParameterChangeQueue::Change unreadChange;
+        while (queue.pop (unreadChange)) {}
+
         const Steinberg::int32 numParamsChanged = paramChanges.getParameterCount();
 
         for (Steinberg::int32 i = 0; i < numParamsChanged; ++i)
         {
             if (Vst::IParamValueQueue* paramQueue = paramChanges.getParameterData (i))
             {
+                const int id = (int) paramQueue->getParameterId();
                 const Steinberg::int32 numPoints = paramQueue->getPointCount();
+                jassert (isPositiveAndBelow (id, pluginInstance->getNumParameters()));
 
                 Steinberg::int32 offsetSamples;
                 double value = 0.0;
 
-                if (paramQueue->getPoint (numPoints - 1,  offsetSamples, value) == kResultTrue)
+                for (Steinberg::int32 point = 0; point < numPoints; ++point)
                 {
-                    const int id = (int) paramQueue->getParameterId();
-                    jassert (isPositiveAndBelow (id, pluginInstance->getNumParameters()));
-                    pluginInstance->setParameter (id, (float) value);
+                    if (paramQueue->getPoint (point, offsetSamples, value) == kResultTrue)
+                    {
+                        queue.push (id, (float) value, (int) offsetSamples);
+
+                        if (point == numPoints - 1)
+                            pluginInstance->setParameter (id, (float) value);
+                    }
                 }
             }
         }
@@ -1266,54 +1288,15 @@ public:
         const int numMidiEventsComingIn = midiBuffer.getNumEvents();
        #endif
 
-        const int numInputChans  = (data.inputs  != nullptr && data.inputs[0].channelBuffers32 != nullptr)  ? (int) data.inputs[0].numChannels  : 0;
-        const int numOutputChans = (data.outputs != nullptr && data.outputs[0].channelBuffers32 != nullptr) ? (int) data.outputs[0].numChannels : 0;
-
-        int totalChans = 0;
+        // The host picks the sample size in setupProcessing(), and the plugin has been
+        // prepared to match it, so only one of these will ever be used.
+        const bool ok = processSetup.symbolicSampleSize == Vst::kSample64
+                            ? processAudio (data, doubleChannelList)
+                            : processAudio (data, channelList);
 
-        while (totalChans < numInputChans)
-        {
-            channelList.set (totalChans, data.inputs[0].channelBuffers32[totalChans]);
-            ++totalChans;
-        }
-
-        while (totalChans < numOutputChans)
-        {
-            channelList.set (totalChans, data.outputs[0].channelBuffers32[totalChans]);
-            ++totalChans;
-        }
-
-        AudioSampleBuffer buffer;
-
-        if (totalChans != 0)
-            buffer.setDataToReferTo (channelList.getRawDataPointer(), totalChans, (int) data.numSamples);
-        else if (getHostType().isWavelab()
-                  && pluginInstance->getNumInputChannels() + pluginInstance->getNumOutputChannels() > 0)
+        if (! ok)
             return kResultFalse;
 
-        {
-            const ScopedLock sl (pluginInstance->getCallbackLock());
-
-            pluginInstance->setNonRealtime (data.processMode == Vst::kOffline);
-
-            if (data.inputParameterChanges != nullptr)
-                processParameterChanges (*data.inputParameterChanges);
-
-            if (pluginInstance->isSuspended())
-                buffer.clear();
-            else
-                pluginInstance->processBlock (buffer, midiBuffer);
-        }
-
-        for (int i = 0; i < numOutputChans; ++i)
-            FloatVectorOperations::copy (data.outputs[0].channelBuffers32[i], buffer.getReadPointer (i), (int) data.numSamples);
-
-        // clear extra busses..
-        if (data.outputs != nullptr)
-            for (int i = 1; i < data.numOutputs; ++i)
-                for (int f = 0; f < data.outputs[i].numChannels; ++f)
-                    FloatVectorOperations::clear (data.outputs[i].channelBuffers32[f], (int) data.numSamples);
-
        #if JucePlugin_ProducesMidiOutput
         if (data.outputEvents != nullptr)
             MidiEventList::toEventList (*data.outputEvents, midiBuffer);
@@ -1357,6 +1340,7 @@ private:
     Vst::BusList audioInputs, audioOutputs, eventInputs, eventOutputs;
     MidiBuffer midiBuffer;
     Array<float*> channelList;
+    Array<double*> doubleChannelList;
 
     ScopedJuceInitialiser_GUI libraryInitialiser;
 
@@ -1401,8 +1385,80 @@ private:
         return (int) info.channelCount;
     }
 
+    //==============================================================================
+    template <typename FloatType>
+    bool processAudio (Vst::ProcessData& data, Array<FloatType*>& channels)
+    {
+        FloatType** const inputs  = data.inputs  != nullptr ? getChannelBuffers (data.inputs[0],  channels) : nullptr;
+        FloatType** const outputs = data.outputs != nullptr ? getChannelBuffers (data.outputs[0], channels) : nullptr;
+
+        const int numInputChans  = inputs  != nullptr ? (int) data.inputs[0].numChannels  : 0;
+        const int numOutputChans = outputs != nullptr ? (int) data.outputs[0].numChannels : 0;
+
+        // The plugin processes the host's output buffers directly. The inputs are copied into
+        // them unless the host is already processing in place, and any extra inputs are used
+        // where they are.
+        int totalChans = 0;
+
+        while (totalChans < numOutputChans)
+        {
+            FloatType* const dest = outputs[totalChans];
+
+            if (totalChans < numInputChans && inputs[totalChans] != dest)
+                FloatVectorOperations::copy (dest, inputs[totalChans], (int) data.numSamples);
+
+            channels.set (totalChans, dest);
+            ++totalChans;
+        }
+
+        while (totalChans < numInputChans)
+        {
+            channels.set (totalChans, inputs[totalChans]);
+            ++totalChans;
+        }
+
+        AudioBuffer<FloatType> buffer;
+
+        if (totalChans != 0)
+            buffer.setDataToReferTo (channels.getRawDataPointer(), totalChans, (int) data.numSamples);
+        else if (getHostType().isWavelab()
+                  && pluginInstance->getNumInputChannels() + pluginInstance->getNumOutputChannels() > 0)
+            return false;
+
+        {
+            const ScopedLock sl (pluginInstance->getCallbackLock());
+            const RealtimeSafety::ScopedRealtimeContext realtimeContext;
+
+            pluginInstance->setNonRealtime (data.processMode == Vst::kOffline);
+
+            if (data.inputParameterChanges != nullptr)
+                processParameterChanges (*data.inputParameterChanges);
+
+            if (pluginInstance->isSuspended())
+                buffer.clear();
+            else
+                pluginInstance->processBlock (buffer, midiBuffer);
+        }
+
+        // clear extra busses..
+        if (data.outputs != nullptr)
+            for (int i = 1; i < data.numOutputs; ++i)
+                for (int f = 0; f < data.outputs[i].numChannels; ++f)
+                    FloatVectorOperations::clear (getChannelBuffers (data.outputs[i], channels)[f], (int) data.numSamples);
+
+        return true;
+    }
+
+    // (the channel list's type picks which of the host's buffers to use)
+    static float**  getChannelBuffers (Vst::AudioBusBuffers& bus, const Array<float*>&) noexcept    { return bus.channelBuffers32; }
+    static double** getChannelBuffers (Vst::AudioBusBuffers& bus, const Array<double*>&) noexcept   { return bus.channelBuffers64; }
+
     void preparePlugin (double sampleRate, int bufferSize)
     {
+        getPluginInstance().setProcessingPrecision (processSetup.symbolicSampleSize == Vst::kSample64
+                                                        ? AudioProcessor::doublePrecision
+                                                        : AudioProcessor::singlePrecision);
+
         getPluginInstance().setPlayConfigDetails (getNumChannels (audioInputs),
                                                   getNumChannels (audioOutputs),
                                                   sampleRate, bufferSize);
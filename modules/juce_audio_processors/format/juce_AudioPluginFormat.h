@@ -64,6 +64,16 @@ public:
                                                                 double initialSampleRate,
                                                                 int initialBufferSize) = 0;
 
+    /** Returns true if createInstanceFromDescription() can safely be called on a thread
+        other than the message thread.
+
+        Most formats need to create their instances on the message thread, so this
+        returns false by default.
+
+        @see AudioPluginFormatManager::createPluginInstanceAsync
+    */
+    virtual bool canCreateInstancesOnBackgroundThreads() const      { return false; }
+
     /** Should do a quick check to see if this file or directory might be a plugin of
         this format.
 
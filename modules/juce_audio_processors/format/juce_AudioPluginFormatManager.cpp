@@ -22,8 +22,133 @@
   ==============================================================================
 */
 
+struct AudioPluginFormatManager::PooledPlugin
+{
+    PooledPlugin (const PluginDescription& d, int size, double rate, int block)
+        : description (d), targetSize (size), numPending (0), sampleRate (rate), blockSize (block)
+    {
+    }
+
+    PluginDescription description;
+    int targetSize, numPending;
+    double sampleRate;
+    int blockSize;
+    OwnedArray<AudioPluginInstance> instances;
+};
+
+// Hands a finished instance (or the reason it failed) to its callback on the message thread.
+struct AudioPluginFormatManager::CompletionMessage  : public CallbackMessage
+{
+    CompletionMessage (AudioPluginInstance* i, const String& e, InstantiationCompletionCallback* c)
+        : instance (i), error (e), callback (c)
+    {
+    }
+
+    void messageCallback() override
+    {
+        callback->completionCallback (instance.release(), error);
+    }
+
+    ScopedPointer<AudioPluginInstance> instance;
+    String error;
+    ScopedPointer<InstantiationCompletionCallback> callback;
+};
+
+struct AudioPluginFormatManager::InstantiationJob  : public ThreadPoolJob
+{
+    InstantiationJob (const AudioPluginFormatManager& m, AudioPluginFormat& f, const PluginDescription& d,
+                      double rate, int block, InstantiationCompletionCallback* c)
+        : ThreadPoolJob ("Plugin instantiation"), manager (m), format (f),
+          description (d), sampleRate (rate), blockSize (block), callback (c)
+    {
+    }
+
+    ~InstantiationJob()
+    {
+        // (if the manager was deleted before this got to run, the callback still needs to hear about it)
+        if (callback != nullptr)
+            (new CompletionMessage (nullptr, TRANS ("The plug-in was not loaded because its format manager was deleted"),
+                                    callback.release()))->post();
+    }
+
+    JobStatus runJob() override
+    {
+        AudioPluginInstance* const instance = format.createInstanceFromDescription (description, sampleRate, blockSize);
+
+        (new CompletionMessage (instance,
+                                instance != nullptr ? String() : manager.getFailureMessage (description),
+                                callback.release()))->post();
+
+        return jobHasFinished;
+    }
+
+    const AudioPluginFormatManager& manager;
+    AudioPluginFormat& format;
+    const PluginDescription description;
+    const double sampleRate;
+    const int blockSize;
+    ScopedPointer<InstantiationCompletionCallback> callback;
+};
+
+// Creates an instance on the message thread, for formats that can't be loaded elsewhere.
+struct AudioPluginFormatManager::DeferredInstantiationMessage  : public CallbackMessage
+{
+    DeferredInstantiationMessage (AudioPluginFormatManager& m, const PluginDescription& d,
+                                  double rate, int block, InstantiationCompletionCallback* c)
+        : manager (&m), description (d), sampleRate (rate), blockSize (block), callback (c)
+    {
+    }
+
+    void messageCallback() override
+    {
+        if (AudioPluginFormatManager* const m = manager)
+        {
+            String error;
+            AudioPluginInstance* const instance = m->createNewInstance (description, sampleRate, blockSize, error);
+            callback->completionCallback (instance, error);
+        }
+        else
+        {
+            callback->completionCallback (nullptr, TRANS ("The plug-in was not loaded because its format manager was deleted"));
+        }
+    }
+
+    WeakReference<AudioPluginFormatManager> manager;
+    const PluginDescription description;
+    const double sampleRate;
+    const int blockSize;
+    ScopedPointer<InstantiationCompletionCallback> callback;
+};
+
+struct AudioPluginFormatManager::PoolRefillCallback  : public InstantiationCompletionCallback
+{
+    PoolRefillCallback (AudioPluginFormatManager& m, const PluginDescription& d)
+        : manager (&m), description (d)
+    {
+    }
+
+    void completionCallback (AudioPluginInstance* instance, const String&) override
+    {
+        if (AudioPluginFormatManager* const m = manager)
+            m->addInstanceToPool (description, instance);
+        else
+            delete instance;
+    }
+
+    WeakReference<AudioPluginFormatManager> manager;
+    const PluginDescription description;
+};
+
+//==============================================================================
 AudioPluginFormatManager::AudioPluginFormatManager() {}
-AudioPluginFormatManager::~AudioPluginFormatManager() {}
+
+AudioPluginFormatManager::~AudioPluginFormatManager()
+{
+    // (this waits for any background instantiations, which use the formats)
+    instantiationThreads = nullptr;
+    clearInstancePool();
+    masterReference.clear();
+}
 
 //==============================================================================
 void AudioPluginFormatManager::addDefaultFormats()
@@ -84,16 +209,184 @@ void AudioPluginFormatManager::addFormat (AudioPluginFormat* const format)
 
 AudioPluginInstance* AudioPluginFormatManager::createPluginInstance (const PluginDescription& description, double rate,
                                                                      int blockSize, String& errorMessage) const
+{
+    if (AudioPluginInstance* const pooled = takeInstanceFromPool (description))
+        return pooled;
+
+    return createNewInstance (description, rate, blockSize, errorMessage);
+}
+
+AudioPluginInstance* AudioPluginFormatManager::createNewInstance (const PluginDescription& description, double rate,
+                                                                  int blockSize, String& errorMessage) const
 {
     for (int i = 0; i < formats.size(); ++i)
         if (AudioPluginInstance* result = formats.getUnchecked(i)->createInstanceFromDescription (description, rate, blockSize))
             return result;
 
-    errorMessage = doesPluginStillExist (description) ? TRANS ("This plug-in failed to load correctly")
-                                                      : TRANS ("This plug-in file no longer exists");
+    errorMessage = getFailureMessage (description);
+    return nullptr;
+}
+
+String AudioPluginFormatManager::getFailureMessage (const PluginDescription& description) const
+{
+    return doesPluginStillExist (description) ? TRANS ("This plug-in failed to load correctly")
+                                              : TRANS ("This plug-in file no longer exists");
+}
+
+//==============================================================================
+void AudioPluginFormatManager::createPluginInstanceAsync (const PluginDescription& description, double rate,
+                                                          int blockSize, InstantiationCompletionCallback* callback)
+{
+    jassert (callback != nullptr);
+
+    if (AudioPluginInstance* const pooled = takeInstanceFromPool (description))
+        (new CompletionMessage (pooled, String(), callback))->post();
+    else
+        startCreatingInstance (description, rate, blockSize, callback);
+}
+
+void AudioPluginFormatManager::startCreatingInstance (const PluginDescription& description, double rate,
+                                                      int blockSize, InstantiationCompletionCallback* callback) const
+{
+    for (int i = 0; i < formats.size(); ++i)
+    {
+        AudioPluginFormat& format = *formats.getUnchecked(i);
+
+        if (format.getName() == description.pluginFormatName && format.canCreateInstancesOnBackgroundThreads())
+        {
+            const ScopedLock sl (poolLock);
+
+            if (instantiationThreads == nullptr)
+                instantiationThreads = new ThreadPool (jlimit (1, 4, SystemStats::getNumCpus() - 1));
+
+            instantiationThreads->addJob (new InstantiationJob (*this, format, description, rate, blockSize, callback), true);
+            return;
+        }
+    }
+
+    // (the message holds a weak reference, which needs a non-const pointer, but it
+    //  only uses the manager to create an instance, which is a const operation)
+    (new DeferredInstantiationMessage (const_cast<AudioPluginFormatManager&> (*this),
+                                       description, rate, blockSize, callback))->post();
+}
+
+//==============================================================================
+void AudioPluginFormatManager::setInstancePoolSize (const PluginDescription& description, int numInstances,
+                                                    double sampleRate, int blockSize)
+{
+    OwnedArray<AudioPluginInstance> instancesToDelete;   // (deleted after the lock is released)
+
+    {
+        const ScopedLock sl (poolLock);
+
+        PooledPlugin* entry = nullptr;
+
+        for (int i = pool.size(); --i >= 0;)
+            if (pool.getUnchecked(i)->description.isDuplicateOf (description))
+                entry = pool.getUnchecked(i);
+
+        if (numInstances <= 0)
+        {
+            if (entry != nullptr)
+            {
+                entry->instances.swapWith (instancesToDelete);
+                pool.removeObject (entry);
+            }
+
+            return;
+        }
+
+        if (entry == nullptr)
+            entry = pool.add (new PooledPlugin (description, numInstances, sampleRate, blockSize));
+
+        entry->targetSize = numInstances;
+        entry->sampleRate = sampleRate;
+        entry->blockSize = blockSize;
+
+        while (entry->instances.size() > numInstances)
+            instancesToDelete.add (entry->instances.removeAndReturn (entry->instances.size() - 1));
+
+        refillPool (*entry);
+    }
+}
+
+int AudioPluginFormatManager::getNumPooledInstances (const PluginDescription& description) const
+{
+    const ScopedLock sl (poolLock);
+
+    for (int i = pool.size(); --i >= 0;)
+        if (pool.getUnchecked(i)->description.isDuplicateOf (description))
+            return pool.getUnchecked(i)->instances.size();
+
+    return 0;
+}
+
+void AudioPluginFormatManager::clearInstancePool()
+{
+    OwnedArray<PooledPlugin> entriesToDelete;   // (deleted after the lock is released)
+
+    const ScopedLock sl (poolLock);
+    pool.swapWith (entriesToDelete);
+}
+
+AudioPluginInstance* AudioPluginFormatManager::takeInstanceFromPool (const PluginDescription& description) const
+{
+    const ScopedLock sl (poolLock);
+
+    for (int i = pool.size(); --i >= 0;)
+    {
+        PooledPlugin& entry = *pool.getUnchecked(i);
+
+        if (entry.description.isDuplicateOf (description))
+        {
+            AudioPluginInstance* const instance = entry.instances.removeAndReturn (0);
+            refillPool (entry);
+            return instance;
+        }
+    }
+
     return nullptr;
 }
 
+void AudioPluginFormatManager::refillPool (PooledPlugin& entry) const
+{
+    while (entry.instances.size() + entry.numPending < entry.targetSize)
+    {
+        ++entry.numPending;
+        startCreatingInstance (entry.description, entry.sampleRate, entry.blockSize,
+                               new PoolRefillCallback (const_cast<AudioPluginFormatManager&> (*this), entry.description));
+    }
+}
+
+void AudioPluginFormatManager::addInstanceToPool (const PluginDescription& description, AudioPluginInstance* newInstance)
+{
+    ScopedPointer<AudioPluginInstance> instance (newInstance);
+
+    const ScopedLock sl (poolLock);
+
+    for (int i = pool.size(); --i >= 0;)
+    {
+        PooledPlugin& entry = *pool.getUnchecked(i);
+
+        if (entry.description.isDuplicateOf (description))
+        {
+            entry.numPending = jmax (0, entry.numPending - 1);
+
+            if (instance == nullptr)
+            {
+                // if it won't load, there's no point retrying every time one is taken..
+                entry.targetSize = entry.instances.size() + entry.numPending;
+            }
+            else if (entry.instances.size() + entry.numPending < entry.targetSize)
+            {
+                entry.instances.add (instance.release());
+            }
+
+            break;
+        }
+    }
+}
+
 bool AudioPluginFormatManager::doesPluginStillExist (const PluginDescription& description) const
 {
     for (int i = 0; i < formats.size(); ++i)
@@ -81,6 +81,68 @@ public:
                                                int initialBufferSize,
                                                String& errorMessage) const;
 
+    //==============================================================================
+    /** Receives the instance created by createPluginInstanceAsync(). */
+    class JUCE_API  InstantiationCompletionCallback
+    {
+    public:
+        virtual ~InstantiationCompletionCallback() {}
+
+        /** Called on the message thread when the instance is ready.
+
+            The callee takes ownership of the instance. If the plugin couldn't be loaded,
+            the instance will be nullptr and the error string will explain why.
+        */
+        virtual void completionCallback (AudioPluginInstance* instance, const String& error) = 0;
+    };
+
+    /** Creates a plugin instance without keeping the message thread busy for long.
+
+        If the plugin's format can create instances on a background thread (see
+        AudioPluginFormat::canCreateInstancesOnBackgroundThreads()), the plugin is loaded
+        by one of the manager's background threads. Otherwise it has to be loaded on the
+        message thread, so this posts a message to create it there. Either way, if you
+        request a lot of instances at once, e.g. while opening a session, the message
+        loop gets to run between them, so the UI doesn't freeze until they're all done.
+
+        The callback is always called asynchronously on the message thread, and is then
+        deleted by the manager. If the manager is deleted before the instance has been
+        created, the callback is told that it failed.
+
+        As with createPluginInstance(), an instance from the pool is used if one is ready.
+
+        @see setInstancePoolSize
+    */
+    void createPluginInstanceAsync (const PluginDescription& description,
+                                    double initialSampleRate,
+                                    int initialBufferSize,
+                                    InstantiationCompletionCallback* callback);
+
+    //==============================================================================
+    /** Keeps some instances of a plugin ready in advance, so that they can be inserted
+        without any delay, e.g. during a live performance.
+
+        The instances are created asynchronously, as if by createPluginInstanceAsync().
+        When createPluginInstance() or createPluginInstanceAsync() is asked for this plugin,
+        a pooled instance is handed over if one is ready, and a replacement is started
+        so that the pool stays at this size. Pooled instances are created with the sample
+        rate and block size given here, so you'll still need to call prepareToPlay() on one
+        before using it. They also keep the plugin's module loaded, so creating further
+        instances won't need to load it again.
+
+        Passing a size of 0 removes the plugin from the pool.
+    */
+    void setInstancePoolSize (const PluginDescription& description,
+                              int numInstancesToKeepReady,
+                              double sampleRate,
+                              int blockSize);
+
+    /** Returns the number of pooled instances of this plugin that are ready to use. */
+    int getNumPooledInstances (const PluginDescription& description) const;
+
+    /** Deletes all the pooled instances, and stops creating new ones. */
+    void clearInstancePool();
+
     /** Checks that the file or component for this plugin actually still exists.
 
         (This won't try to load the plugin)
@@ -89,7 +151,28 @@ public:
 
 private:
     //==============================================================================
+    struct PooledPlugin;
+    struct InstantiationJob;
+    struct CompletionMessage;
+    struct DeferredInstantiationMessage;
+    struct PoolRefillCallback;
+    friend struct DeferredInstantiationMessage;
+    friend struct PoolRefillCallback;
+
     OwnedArray<AudioPluginFormat> formats;
+    mutable OwnedArray<PooledPlugin> pool;    // (createPluginInstance() is const, but can take from the pool)
+    CriticalSection poolLock;
+    mutable ScopedPointer<ThreadPool> instantiationThreads;
+
+    WeakReference<AudioPluginFormatManager>::Master masterReference;
+    friend class WeakReference<AudioPluginFormatManager>;
+
+    AudioPluginInstance* createNewInstance (const PluginDescription&, double, int, String&) const;
+    String getFailureMessage (const PluginDescription&) const;
+    AudioPluginInstance* takeInstanceFromPool (const PluginDescription&) const;
+    void startCreatingInstance (const PluginDescription&, double, int, InstantiationCompletionCallback*) const;
+    void refillPool (PooledPlugin&) const;
+    void addInstanceToPool (const PluginDescription&, AudioPluginInstance*);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioPluginFormatManager)
 };
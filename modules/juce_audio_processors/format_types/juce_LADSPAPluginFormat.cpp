@@ -54,12 +54,21 @@ public:
 
     ~LADSPAModuleHandle()
     {
+        const ScopedLock sl (getLock());
         getActiveModules().removeFirstMatchingValue (this);
         close();
     }
 
     typedef ReferenceCountedObjectPtr<LADSPAModuleHandle> Ptr;
 
+    // Instances can be created on background threads, so this protects the list of
+    // modules, and the globals that are used while creating an instance.
+    static CriticalSection& getLock()
+    {
+        static CriticalSection lock;
+        return lock;
+    }
+
     static Array <LADSPAModuleHandle*>& getActiveModules()
     {
         static Array <LADSPAModuleHandle*> activeModules;
@@ -619,6 +628,7 @@ AudioPluginInstance* LADSPAPluginFormat::createInstanceFromDescription (const Pl
     {
         File file (desc.fileOrIdentifier);
 
+        const ScopedLock sl (LADSPAModuleHandle::getLock());
         const File previousWorkingDirectory (File::getCurrentWorkingDirectory());
         file.getParentDirectory().setAsCurrentWorkingDirectory();
 
@@ -46,6 +46,7 @@ public:
     bool doesPluginStillExist (const PluginDescription&) override;
     FileSearchPath getDefaultLocationsToSearch() override;
     bool canScanForPlugins() const override        { return true; }
+    bool canCreateInstancesOnBackgroundThreads() const override   { return true; }
 
 private:
     void recursiveFileSearch (StringArray&, const File&, bool recursive);
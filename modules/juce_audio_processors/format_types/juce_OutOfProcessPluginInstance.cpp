@@ -0,0 +1,1104 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+namespace OutOfProcessPluginHelpers
+{
+    enum Command
+    {
+        loadCommand = 1,
+        prepareCommand,
+        releaseCommand,
+        setParameterCommand,
+        getParameterTextCommand,
+        getStateCommand,
+        setStateCommand,
+        setProgramCommand,
+        getProgramNameCommand,
+        changeProgramNameCommand
+    };
+
+    enum
+    {
+        midiBufferBytes = 65536,
+        parameterQueueSize = 1024
+    };
+
+    //==============================================================================
+    /** A named semaphore that can be shared between processes. */
+    class CrossProcessSemaphore
+    {
+    public:
+        CrossProcessSemaphore (const String& semaphoreName, const bool create)
+        {
+           #if JUCE_WINDOWS
+            const String fullName ("Local\\" + semaphoreName);
+
+            handle = create ? CreateSemaphoreW (nullptr, 0, 0x7fffffff, fullName.toWideCharPointer())
+                            : OpenSemaphoreW (SEMAPHORE_ALL_ACCESS, FALSE, fullName.toWideCharPointer());
+           #else
+            name = "/" + semaphoreName;
+            isOwner = create;
+
+            semaphore = create ? sem_open (name.toRawUTF8(), O_CREAT | O_EXCL, 0600, 0)
+                               : sem_open (name.toRawUTF8(), 0);
+
+            if (semaphore == SEM_FAILED)
+                semaphore = nullptr;
+           #endif
+        }
+
+        ~CrossProcessSemaphore()
+        {
+           #if JUCE_WINDOWS
+            if (handle != 0)
+                CloseHandle (handle);
+           #else
+            if (semaphore != nullptr)
+            {
+                sem_close (semaphore);
+
+                if (isOwner)
+                    sem_unlink (name.toRawUTF8());
+            }
+           #endif
+        }
+
+        bool isValid() const noexcept
+        {
+           #if JUCE_WINDOWS
+            return handle != 0;
+           #else
+            return semaphore != nullptr;
+           #endif
+        }
+
+        void signal() noexcept
+        {
+           #if JUCE_WINDOWS
+            ReleaseSemaphore (handle, 1, nullptr);
+           #else
+            sem_post (semaphore);
+           #endif
+        }
+
+        /** Returns false if the timeout expired before the semaphore was signalled. */
+        bool wait (const int timeoutMs) noexcept
+        {
+           #if JUCE_WINDOWS
+            return WaitForSingleObject (handle, (DWORD) timeoutMs) == WAIT_OBJECT_0;
+           #elif JUCE_LINUX || JUCE_ANDROID
+            struct timespec deadline;
+            clock_gettime (CLOCK_REALTIME, &deadline);
+
+            deadline.tv_sec  += timeoutMs / 1000;
+            deadline.tv_nsec += (timeoutMs % 1000) * 1000000;
+
+            if (deadline.tv_nsec >= 1000000000)
+            {
+                ++deadline.tv_sec;
+                deadline.tv_nsec -= 1000000000;
+            }
+
+            for (;;)
+            {
+                if (sem_timedwait (semaphore, &deadline) == 0)
+                    return true;
+
+                if (errno != EINTR)
+                    return false;
+            }
+           #else
+            // OSX has no sem_timedwait(), so this spins briefly before backing off to sleeps
+            const uint32 startTime = Time::getMillisecondCounter();
+
+            for (int i = 0;; ++i)
+            {
+                if (sem_trywait (semaphore) == 0)
+                    return true;
+
+                if (Time::getMillisecondCounter() - startTime >= (uint32) timeoutMs)
+                    return false;
+
+                if (i < 100)
+                    Thread::yield();
+                else
+                    Thread::sleep (1);
+            }
+           #endif
+        }
+
+    private:
+       #if JUCE_WINDOWS
+        HANDLE handle;
+       #else
+        sem_t* semaphore;
+        String name;
+        bool isOwner;
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE (CrossProcessSemaphore)
+    };
+
+    //==============================================================================
+    struct SharedHeader
+    {
+        int32 numSamples, numMidiInBytes, numMidiOutBytes;
+        Atomic<int32> parameterQueueWritePos, parameterQueueReadPos;
+    };
+
+    struct ParameterChange
+    {
+        int32 index;
+        float value;
+    };
+
+    /** The shared memory area and pair of semaphores that carry the audio between the
+        two processes. The master signals the request semaphore when a block is ready,
+        and the slave signals the reply semaphore when it has processed it.
+
+        The layout is: the header, the audio channels, the incoming and outgoing MIDI,
+        the queue of parameter changes, and the current parameter values.
+    */
+    class SharedAudioBlock
+    {
+    public:
+        SharedAudioBlock (const String& blockName, const File& mappedFileToUse,
+                          const int numChans, const int blockSize, const int numParams, const bool create)
+            : name (blockName), file (mappedFileToUse),
+              numChannels (jmax (0, numChans)), maxBlockSize (jmax (1, blockSize)), numParameters (jmax (0, numParams)),
+              requestSemaphore (blockName + "q", create),
+              replySemaphore (blockName + "r", create),
+              isOwner (create)
+        {
+            const size_t audioStart = (size_t) roundUp (sizeof (SharedHeader));
+            midiInStart        = audioStart + roundUp (sizeof (float) * (size_t) (numChannels * maxBlockSize));
+            midiOutStart       = midiInStart + midiBufferBytes;
+            parameterQueueStart = midiOutStart + midiBufferBytes;
+            parameterValuesStart = parameterQueueStart + sizeof (ParameterChange) * parameterQueueSize;
+            const size_t totalSize = parameterValuesStart + roundUp (sizeof (float) * (size_t) numParameters);
+
+            if (create)
+            {
+                const MemoryBlock zeros (totalSize, true);
+
+                if (! file.replaceWithData (zeros.getData(), zeros.getSize()))
+                    return;
+            }
+
+            mappedFile = new MemoryMappedFile (file, MemoryMappedFile::readWrite);
+
+            if (mappedFile->getData() == nullptr || mappedFile->getSize() < totalSize)
+            {
+                mappedFile = nullptr;
+                return;
+            }
+
+            char* const data = static_cast<char*> (mappedFile->getData());
+
+            for (int i = 0; i < numChannels; ++i)
+                channels.add (reinterpret_cast<float*> (data + audioStart) + i * maxBlockSize);
+        }
+
+        ~SharedAudioBlock()
+        {
+            mappedFile = nullptr;
+
+            if (isOwner)
+                file.deleteFile();
+        }
+
+        bool isValid() const noexcept
+        {
+            return mappedFile != nullptr && requestSemaphore.isValid() && replySemaphore.isValid();
+        }
+
+        SharedHeader& getHeader() const noexcept        { return *static_cast<SharedHeader*> (mappedFile->getData()); }
+        float** getChannels() noexcept                  { return channels.getRawDataPointer(); }
+        uint8* getMidiIn() const noexcept               { return getPointer<uint8> (midiInStart); }
+        uint8* getMidiOut() const noexcept              { return getPointer<uint8> (midiOutStart); }
+        ParameterChange* getParameterQueue() const noexcept  { return getPointer<ParameterChange> (parameterQueueStart); }
+        float* getParameterValues() const noexcept      { return getPointer<float> (parameterValuesStart); }
+
+        static File getFolder()
+        {
+           #if JUCE_LINUX
+            // (a tmpfs folder keeps the pages out of the disk cache)
+            const File shm ("/dev/shm");
+
+            if (shm.isDirectory())
+                return shm;
+           #endif
+
+            return File::getSpecialLocation (File::tempDirectory);
+        }
+
+        static String createUniqueName()
+        {
+            // (OSX semaphore names are limited to 31 characters)
+            return "jop" + String::toHexString (Random::getSystemRandom().nextInt64());
+        }
+
+        const String name;
+        const File file;
+        const int numChannels, maxBlockSize, numParameters;
+        CrossProcessSemaphore requestSemaphore, replySemaphore;
+
+    private:
+        ScopedPointer<MemoryMappedFile> mappedFile;
+        Array<float*> channels;
+        size_t midiInStart, midiOutStart, parameterQueueStart, parameterValuesStart;
+        const bool isOwner;
+
+        static size_t roundUp (const size_t n) noexcept  { return (n + 15) & ~(size_t) 15; }
+
+        template <typename Type>
+        Type* getPointer (const size_t offset) const noexcept
+        {
+            return reinterpret_cast<Type*> (static_cast<char*> (mappedFile->getData()) + offset);
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (SharedAudioBlock)
+    };
+
+    //==============================================================================
+    // Each event is stored as an int32 sample position, an int32 size, and the data.
+    static int writeMidi (const MidiBuffer& midi, uint8* const dest, const int startSample, const int numSamples)
+    {
+        MidiBuffer::Iterator iter (midi);
+        const uint8* data;
+        int numBytes, samplePosition, bytesUsed = 0;
+        iter.setNextSamplePosition (startSample);
+
+        while (iter.getNextEvent (data, numBytes, samplePosition))
+        {
+            if (samplePosition >= startSample + numSamples
+                 || bytesUsed + 8 + numBytes > (int) midiBufferBytes)
+                break;
+
+            const int32 header[2] = { samplePosition - startSample, numBytes };
+            memcpy (dest + bytesUsed, header, sizeof (header));
+            memcpy (dest + bytesUsed + 8, data, (size_t) numBytes);
+            bytesUsed += 8 + numBytes;
+        }
+
+        return bytesUsed;
+    }
+
+    static void readMidi (MidiBuffer& midi, const uint8* const source, const int numBytes, const int sampleOffset)
+    {
+        for (int pos = 0; pos + 8 <= jmin (numBytes, (int) midiBufferBytes);)
+        {
+            int32 header[2];
+            memcpy (header, source + pos, sizeof (header));
+
+            if (header[1] <= 0 || pos + 8 + header[1] > numBytes)
+                break;
+
+            midi.addEvent (source + pos + 8, header[1], header[0] + sampleOffset);
+            pos += 8 + header[1];
+        }
+    }
+}
+
+//==============================================================================
+const char* const OutOfProcessPluginInstance::defaultCommandLineID = "juceOutOfProcessPluginHost";
+
+// A request is an int request ID, an int command and the command's arguments. Every
+// request gets a reply, which is the same ID followed by the command's results.
+struct OutOfProcessPluginInstance::Connection  : public ChildProcessMaster,
+                                                  private AsyncUpdater
+{
+    Connection()  : nextRequestID (0), replyRequestID (-1) {}
+
+    ~Connection()
+    {
+        cancelPendingUpdate();
+    }
+
+    /** If reply is null, this just posts the request without waiting for it to finish. */
+    bool sendRequest (const int command, const MemoryBlock& arguments, MemoryBlock* const reply, const int timeoutMs)
+    {
+        const ScopedLock sl (requestLock);
+        const int requestID = ++nextRequestID;
+
+        if (hasCrashed())
+            return false;
+
+        {
+            const ScopedLock rl (replyLock);
+            replyRequestID = -1;
+            replyData.reset();
+        }
+
+        replyReceived.reset();
+
+        MemoryOutputStream request;
+        request.writeInt (requestID);
+        request.writeInt (command);
+        request << arguments;
+
+        if (! sendMessageToSlave (request.getMemoryBlock()))
+        {
+            markAsCrashed();
+            return false;
+        }
+
+        if (reply == nullptr)
+            return true;
+
+        const uint32 startTime = Time::getMillisecondCounter();
+
+        for (;;)
+        {
+            replyReceived.wait (100);
+
+            {
+                const ScopedLock rl (replyLock);
+
+                if (replyRequestID == requestID)
+                {
+                    *reply = replyData;
+                    return true;
+                }
+            }
+
+            if (hasCrashed())
+                return false;
+
+            // a plugin that hangs gets treated in the same way as one that crashes
+            if (Time::getMillisecondCounter() - startTime > (uint32) timeoutMs)
+            {
+                markAsCrashed();
+                return false;
+            }
+        }
+    }
+
+    void handleMessageFromSlave (const MemoryBlock& message) override
+    {
+        if (message.getSize() < sizeof (int))
+            return;
+
+        {
+            const ScopedLock rl (replyLock);
+            replyRequestID = (int) ByteOrder::littleEndianInt (message.getData());
+            replyData = MemoryBlock (addBytesToPointer (message.getData(), sizeof (int)),
+                                     message.getSize() - sizeof (int));
+        }
+
+        replyReceived.signal();
+    }
+
+    void handleConnectionLost() override
+    {
+        crashed = 1;
+        replyReceived.signal();
+    }
+
+    bool hasCrashed() const noexcept    { return crashed.get() != 0; }
+
+    /** Can be called on the audio thread: the child process gets killed asynchronously. */
+    void markAsCrashed()
+    {
+        crashed = 1;
+        replyReceived.signal();
+        triggerAsyncUpdate();
+    }
+
+private:
+    CriticalSection requestLock, replyLock;
+    int nextRequestID, replyRequestID;
+    MemoryBlock replyData;
+    WaitableEvent replyReceived;
+    Atomic<int> crashed;
+
+    void handleAsyncUpdate() override
+    {
+        killSlaveProcess();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Connection)
+};
+
+struct OutOfProcessPluginInstance::Transport  : public OutOfProcessPluginHelpers::SharedAudioBlock
+{
+    Transport (const String& uniqueName, const int numChans, const int blockSize, const int numParams)
+        : SharedAudioBlock (uniqueName, getFolder().getChildFile (uniqueName),
+                            numChans, blockSize, numParams, true)
+    {
+        midiOut.ensureSize (2048);
+    }
+
+    MidiBuffer midiOut;
+
+    JUCE_DECLARE_NON_COPYABLE (Transport)
+};
+
+//==============================================================================
+OutOfProcessPluginInstance* OutOfProcessPluginInstance::create (const File& hostExecutable,
+                                                                const PluginDescription& desc,
+                                                                const double initialSampleRate,
+                                                                const int initialBufferSize,
+                                                                String& errorMessage,
+                                                                const String& commandLineID)
+{
+    ScopedPointer<Connection> c (new Connection());
+
+    if (! c->launchSlaveProcess (hostExecutable, commandLineID))
+    {
+        errorMessage = "Couldn't launch the plugin host process";
+        return nullptr;
+    }
+
+    const ScopedPointer<XmlElement> xml (desc.createXml());
+
+    MemoryOutputStream args;
+    args.writeString (xml->createDocument (String::empty, true, false));
+    args.writeDouble (initialSampleRate);
+    args.writeInt (initialBufferSize);
+
+    MemoryBlock reply;
+
+    if (! c->sendRequest (OutOfProcessPluginHelpers::loadCommand, args.getMemoryBlock(), &reply, 30000))
+    {
+        errorMessage = "The plugin host process crashed or stopped responding";
+        return nullptr;
+    }
+
+    MemoryInputStream in (reply, false);
+
+    if (! in.readBool())
+    {
+        errorMessage = in.readString();
+        return nullptr;
+    }
+
+    ScopedPointer<OutOfProcessPluginInstance> instance (new OutOfProcessPluginInstance (c.release()));
+    instance->description = desc;
+
+    if (! instance->readPluginDetails (MemoryBlock (addBytesToPointer (reply.getData(), 1), reply.getSize() - 1)))
+    {
+        errorMessage = "The plugin host process returned an invalid reply";
+        return nullptr;
+    }
+
+    instance->setPlayConfigDetails (instance->getNumInputChannels(), instance->getNumOutputChannels(),
+                                    initialSampleRate, initialBufferSize);
+    return instance.release();
+}
+
+OutOfProcessPluginInstance::OutOfProcessPluginInstance (Connection* const c)
+    : connection (c),
+      pluginAcceptsMidi (false), pluginProducesMidi (false), pluginSilenceInProducesSilenceOut (false),
+      tailLengthSeconds (0), numPrograms (0), currentProgram (0), processTimeoutMs (1000)
+{
+}
+
+OutOfProcessPluginInstance::~OutOfProcessPluginInstance()
+{
+    // (deleting the connection shuts down the child before its shared memory goes away)
+    connection = nullptr;
+    transport = nullptr;
+}
+
+bool OutOfProcessPluginInstance::isPluginProcessRunning() const noexcept
+{
+    return ! connection->hasCrashed();
+}
+
+void OutOfProcessPluginInstance::setProcessTimeout (const int timeoutMs) noexcept
+{
+    processTimeoutMs = jmax (1, timeoutMs);
+}
+
+bool OutOfProcessPluginInstance::sendRequest (const int command, const MemoryBlock& arguments,
+                                              MemoryBlock* const reply, const int timeoutMs)
+{
+    return connection->sendRequest (command, arguments, reply, timeoutMs);
+}
+
+bool OutOfProcessPluginInstance::readPluginDetails (const MemoryBlock& details)
+{
+    MemoryInputStream in (details, false);
+
+    name                              = in.readString();
+    pluginAcceptsMidi                 = in.readBool();
+    pluginProducesMidi                = in.readBool();
+    pluginSilenceInProducesSilenceOut = in.readBool();
+    tailLengthSeconds                 = in.readDouble();
+
+    const int numIns  = in.readCompressedInt();
+    const int numOuts = in.readCompressedInt();
+    const int latency = in.readCompressedInt();
+
+    StringArray newParameterNames;
+    Array<float> newParameterValues;
+
+    for (int i = in.readCompressedInt(); --i >= 0 && ! in.isExhausted();)
+    {
+        newParameterNames.add (in.readString());
+        newParameterValues.add (in.readFloat());
+    }
+
+    numPrograms    = in.readCompressedInt();
+    currentProgram = in.readCompressedInt();
+
+    if (name.isEmpty())
+        return false;
+
+    {
+        // (the values may be being refreshed by the audio thread)
+        const ScopedLock sl (transportLock);
+
+        if (transport != nullptr && newParameterValues.size() != parameterValues.size())
+            newParameterValues.resize (parameterValues.size());
+
+        parameterNames.swapWith (newParameterNames);
+        parameterValues.swapWith (newParameterValues);
+    }
+
+    setPlayConfigDetails (numIns, numOuts, getSampleRate(), getBlockSize());
+    setLatencySamples (latency);
+    return true;
+}
+
+//==============================================================================
+void OutOfProcessPluginInstance::fillInPluginDescription (PluginDescription& desc) const
+{
+    desc = description;
+}
+
+const String OutOfProcessPluginInstance::getName() const        { return name; }
+
+void OutOfProcessPluginInstance::prepareToPlay (const double sampleRate, const int estimatedSamplesPerBlock)
+{
+    releaseResources();
+
+    const ScopedLock sl (transportLock);
+
+    ScopedPointer<Transport> newTransport (new Transport (Transport::createUniqueName(),
+                                                          jmax (getNumInputChannels(), getNumOutputChannels()),
+                                                          estimatedSamplesPerBlock, parameterValues.size()));
+
+    if (! newTransport->isValid())
+    {
+        jassertfalse; // couldn't create the shared memory or semaphores
+        return;
+    }
+
+    for (int i = 0; i < parameterValues.size(); ++i)
+        newTransport->getParameterValues()[i] = parameterValues.getUnchecked (i);
+
+    MemoryOutputStream args;
+    args.writeDouble (sampleRate);
+    args.writeInt (getNumInputChannels());
+    args.writeInt (getNumOutputChannels());
+    args.writeInt (newTransport->maxBlockSize);
+    args.writeInt (newTransport->numParameters);
+    args.writeString (newTransport->name);
+    args.writeString (newTransport->file.getFullPathName());
+
+    MemoryBlock reply;
+
+    if (sendRequest (OutOfProcessPluginHelpers::prepareCommand, args.getMemoryBlock(), &reply, 10000))
+    {
+        MemoryInputStream in (reply, false);
+
+        if (in.readBool())
+        {
+            setLatencySamples (in.readInt());
+            transport = newTransport;
+        }
+    }
+}
+
+void OutOfProcessPluginInstance::releaseResources()
+{
+    const ScopedLock sl (transportLock);
+
+    if (transport != nullptr)
+    {
+        MemoryBlock reply;
+        sendRequest (OutOfProcessPluginHelpers::releaseCommand, MemoryBlock(), &reply, 10000);
+        transport = nullptr;
+    }
+}
+
+void OutOfProcessPluginInstance::processBlock (AudioSampleBuffer& buffer, MidiBuffer& midiMessages)
+{
+    using namespace OutOfProcessPluginHelpers;
+
+    const ScopedTryLock sl (transportLock);
+
+    if (! sl.isLocked() || transport == nullptr || connection->hasCrashed())
+    {
+        buffer.clear();
+        midiMessages.clear();
+        return;
+    }
+
+    SharedHeader& header = transport->getHeader();
+    float** const channels = transport->getChannels();
+    const int numSamples = buffer.getNumSamples();
+    transport->midiOut.clear();
+
+    for (int start = 0; start < numSamples; start += transport->maxBlockSize)
+    {
+        const int num = jmin (transport->maxBlockSize, numSamples - start);
+
+        for (int i = 0; i < transport->numChannels; ++i)
+        {
+            if (i < buffer.getNumChannels())
+                FloatVectorOperations::copy (channels[i], buffer.getReadPointer (i, start), num);
+            else
+                FloatVectorOperations::clear (channels[i], num);
+        }
+
+        header.numSamples = num;
+        header.numMidiInBytes = writeMidi (midiMessages, transport->getMidiIn(), start, num);
+
+        transport->requestSemaphore.signal();
+
+        if (! transport->replySemaphore.wait (processTimeoutMs))
+        {
+            connection->markAsCrashed();
+            buffer.clear();
+            midiMessages.clear();
+            return;
+        }
+
+        for (int i = jmin (transport->numChannels, buffer.getNumChannels()); --i >= 0;)
+            buffer.copyFrom (i, start, channels[i], num);
+
+        readMidi (transport->midiOut, transport->getMidiOut(), header.numMidiOutBytes, start);
+    }
+
+    midiMessages.swapWith (transport->midiOut);
+
+    const float* const values = transport->getParameterValues();
+
+    for (int i = jmin (transport->numParameters, parameterValues.size()); --i >= 0;)
+        parameterValues.getReference (i) = values[i];
+}
+
+//==============================================================================
+const String OutOfProcessPluginInstance::getInputChannelName (const int index) const   { return String (index + 1); }
+const String OutOfProcessPluginInstance::getOutputChannelName (const int index) const  { return String (index + 1); }
+
+bool OutOfProcessPluginInstance::isInputChannelStereoPair (int) const   { return true; }
+bool OutOfProcessPluginInstance::isOutputChannelStereoPair (int) const  { return true; }
+
+bool OutOfProcessPluginInstance::silenceInProducesSilenceOut() const    { return pluginSilenceInProducesSilenceOut; }
+double OutOfProcessPluginInstance::getTailLengthSeconds() const         { return tailLengthSeconds; }
+bool OutOfProcessPluginInstance::acceptsMidi() const                    { return pluginAcceptsMidi; }
+bool OutOfProcessPluginInstance::producesMidi() const                   { return pluginProducesMidi; }
+
+AudioProcessorEditor* OutOfProcessPluginInstance::createEditor()        { return nullptr; }
+bool OutOfProcessPluginInstance::hasEditor() const                      { return false; }
+
+//==============================================================================
+int OutOfProcessPluginInstance::getNumParameters()                      { return parameterNames.size(); }
+const String OutOfProcessPluginInstance::getParameterName (const int index)   { return parameterNames [index]; }
+
+float OutOfProcessPluginInstance::getParameter (const int index)
+{
+    return isPositiveAndBelow (index, parameterValues.size()) ? parameterValues.getUnchecked (index) : 0.0f;
+}
+
+const String OutOfProcessPluginInstance::getParameterText (const int index)
+{
+    MemoryOutputStream args;
+    args.writeInt (index);
+
+    MemoryBlock reply;
+
+    if (sendRequest (OutOfProcessPluginHelpers::getParameterTextCommand, args.getMemoryBlock(), &reply, 1000))
+        return MemoryInputStream (reply, false).readString();
+
+    return String (getParameter (index), 2);
+}
+
+void OutOfProcessPluginInstance::setParameter (const int index, const float newValue)
+{
+    using namespace OutOfProcessPluginHelpers;
+
+    if (! isPositiveAndBelow (index, parameterValues.size()))
+        return;
+
+    parameterValues.getReference (index) = newValue;
+
+    const ScopedTryLock sl (transportLock);
+
+    if (sl.isLocked() && transport != nullptr)
+    {
+        // (this may be called on the audio thread, so the change goes into the queue
+        // that the child reads before its next block, rather than through a message)
+        const SpinLock::ScopedLockType ql (parameterQueueLock);
+        SharedHeader& header = transport->getHeader();
+        const int writePos = header.parameterQueueWritePos.get();
+
+        if (writePos - header.parameterQueueReadPos.get() < (int) parameterQueueSize)
+        {
+            ParameterChange& change = transport->getParameterQueue() [writePos % (int) parameterQueueSize];
+            change.index = index;
+            change.value = newValue;
+            header.parameterQueueWritePos = writePos + 1;
+        }
+    }
+    else
+    {
+        MemoryOutputStream args;
+        args.writeInt (index);
+        args.writeFloat (newValue);
+
+        sendRequest (setParameterCommand, args.getMemoryBlock(), nullptr, 0);
+    }
+}
+
+//==============================================================================
+int OutOfProcessPluginInstance::getNumPrograms()        { return numPrograms; }
+int OutOfProcessPluginInstance::getCurrentProgram()     { return currentProgram; }
+
+void OutOfProcessPluginInstance::setCurrentProgram (const int index)
+{
+    MemoryOutputStream args;
+    args.writeInt (index);
+
+    MemoryBlock reply;
+
+    if (sendRequest (OutOfProcessPluginHelpers::setProgramCommand, args.getMemoryBlock(), &reply, 10000))
+        readPluginDetails (reply);
+}
+
+const String OutOfProcessPluginInstance::getProgramName (const int index)
+{
+    MemoryOutputStream args;
+    args.writeInt (index);
+
+    MemoryBlock reply;
+
+    if (sendRequest (OutOfProcessPluginHelpers::getProgramNameCommand, args.getMemoryBlock(), &reply, 1000))
+        return MemoryInputStream (reply, false).readString();
+
+    return String::empty;
+}
+
+void OutOfProcessPluginInstance::changeProgramName (const int index, const String& newName)
+{
+    MemoryOutputStream args;
+    args.writeInt (index);
+    args.writeString (newName);
+
+    MemoryBlock reply;
+    sendRequest (OutOfProcessPluginHelpers::changeProgramNameCommand, args.getMemoryBlock(), &reply, 1000);
+}
+
+void OutOfProcessPluginInstance::getStateInformation (MemoryBlock& destData)
+{
+    MemoryBlock reply;
+
+    if (sendRequest (OutOfProcessPluginHelpers::getStateCommand, MemoryBlock(), &reply, 10000))
+        destData = reply;
+}
+
+void OutOfProcessPluginInstance::setStateInformation (const void* data, const int sizeInBytes)
+{
+    MemoryBlock reply;
+
+    if (sendRequest (OutOfProcessPluginHelpers::setStateCommand, MemoryBlock (data, (size_t) sizeInBytes), &reply, 10000))
+        readPluginDetails (reply);
+}
+
+//==============================================================================
+class PluginHostSlave::AudioThread  : public Thread
+{
+public:
+    AudioThread (AudioPluginInstance& p, OutOfProcessPluginHelpers::SharedAudioBlock* const b, const double rate)
+        : Thread ("Plugin host audio"), plugin (p), block (b), sampleRate (rate)
+    {
+        midi.ensureSize (2048);
+    }
+
+    ~AudioThread()
+    {
+        stopThread (2000);
+    }
+
+    bool isValid() const noexcept   { return block->isValid(); }
+
+    void run() override
+    {
+        using namespace OutOfProcessPluginHelpers;
+
+        const double periodMs = 1000.0 * block->maxBlockSize / jmax (1.0, sampleRate);
+        Thread::setCurrentThreadRealtime (periodMs, periodMs * 0.5, periodMs);
+
+        SharedHeader& header = block->getHeader();
+
+        while (! threadShouldExit())
+        {
+            if (! block->requestSemaphore.wait (100))
+                continue;
+
+            applyParameterChanges (header);
+
+            AudioSampleBuffer buffer (block->getChannels(), block->numChannels,
+                                      jlimit (0, block->maxBlockSize, (int) header.numSamples));
+
+            midi.clear();
+            readMidi (midi, block->getMidiIn(), header.numMidiInBytes, 0);
+
+            {
+                const ScopedLock sl (plugin.getCallbackLock());
+
+                if (plugin.isSuspended())
+                    buffer.clear();
+                else
+                    plugin.processBlock (buffer, midi);
+            }
+
+            header.numMidiOutBytes = writeMidi (midi, block->getMidiOut(), 0, buffer.getNumSamples());
+
+            float* const values = block->getParameterValues();
+
+            for (int i = jmin (block->numParameters, plugin.getNumParameters()); --i >= 0;)
+                values[i] = plugin.getParameter (i);
+
+            block->replySemaphore.signal();
+        }
+    }
+
+private:
+    AudioPluginInstance& plugin;
+    ScopedPointer<OutOfProcessPluginHelpers::SharedAudioBlock> block;
+    const double sampleRate;
+    MidiBuffer midi;
+
+    void applyParameterChanges (OutOfProcessPluginHelpers::SharedHeader& header)
+    {
+        using namespace OutOfProcessPluginHelpers;
+
+        const int writePos = header.parameterQueueWritePos.get();
+        const ParameterChange* const queue = block->getParameterQueue();
+
+        for (int pos = header.parameterQueueReadPos.get(); pos != writePos; ++pos)
+        {
+            const ParameterChange& change = queue [pos % (int) parameterQueueSize];
+            plugin.setParameter (change.index, change.value);
+        }
+
+        header.parameterQueueReadPos = writePos;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (AudioThread)
+};
+
+struct PluginHostSlave::RequestMessage  : public CallbackMessage
+{
+    RequestMessage (PluginHostSlave& s, const MemoryBlock& m)  : owner (s), message (m) {}
+
+    void messageCallback() override
+    {
+        MemoryInputStream in (message, false);
+        const int requestID = in.readInt();
+        const int command = in.readInt();
+
+        owner.handleRequest (requestID, command, in);
+    }
+
+    PluginHostSlave& owner;
+    const MemoryBlock message;
+
+    JUCE_DECLARE_NON_COPYABLE (RequestMessage)
+};
+
+PluginHostSlave::PluginHostSlave (AudioPluginFormatManager& formatsToUse)
+    : formatManager (formatsToUse)
+{
+}
+
+PluginHostSlave::~PluginHostSlave()
+{
+    stopAudioThread();
+    plugin = nullptr;
+}
+
+void PluginHostSlave::handleMessageFromMaster (const MemoryBlock& message)
+{
+    // plugins expect to be created and controlled on the message thread
+    (new RequestMessage (*this, message))->post();
+}
+
+void PluginHostSlave::handleConnectionLost()
+{
+    JUCEApplicationBase::quit();
+}
+
+void PluginHostSlave::stopAudioThread()
+{
+    audioThread = nullptr;
+}
+
+MemoryBlock PluginHostSlave::createPluginDetails()
+{
+    MemoryOutputStream out;
+    out.writeString (plugin->getName());
+    out.writeBool (plugin->acceptsMidi());
+    out.writeBool (plugin->producesMidi());
+    out.writeBool (plugin->silenceInProducesSilenceOut());
+    out.writeDouble (plugin->getTailLengthSeconds());
+    out.writeCompressedInt (plugin->getNumInputChannels());
+    out.writeCompressedInt (plugin->getNumOutputChannels());
+    out.writeCompressedInt (plugin->getLatencySamples());
+    out.writeCompressedInt (plugin->getNumParameters());
+
+    for (int i = 0; i < plugin->getNumParameters(); ++i)
+    {
+        out.writeString (plugin->getParameterName (i));
+        out.writeFloat (plugin->getParameter (i));
+    }
+
+    out.writeCompressedInt (plugin->getNumPrograms());
+    out.writeCompressedInt (plugin->getCurrentProgram());
+    return out.getMemoryBlock();
+}
+
+void PluginHostSlave::handleRequest (const int requestID, const int command, MemoryInputStream& in)
+{
+    using namespace OutOfProcessPluginHelpers;
+
+    MemoryOutputStream reply;
+    reply.writeInt (requestID);
+
+    if (command == loadCommand)
+    {
+        const String xmlText (in.readString());
+        const double sampleRate = in.readDouble();
+        const int blockSize = in.readInt();
+
+        const ScopedPointer<XmlElement> xml (XmlDocument::parse (xmlText));
+        PluginDescription desc;
+        String error;
+
+        if (plugin == nullptr && xml != nullptr && desc.loadFromXml (*xml))
+            plugin = formatManager.createPluginInstance (desc, sampleRate, blockSize, error);
+        else
+            error = "Invalid plugin description";
+
+        reply.writeBool (plugin != nullptr);
+
+        if (plugin != nullptr)
+            reply << createPluginDetails();
+        else
+            reply.writeString (error);
+    }
+    else if (plugin != nullptr)
+    {
+        switch (command)
+        {
+            case prepareCommand:
+            {
+                stopAudioThread();
+
+                const double sampleRate = in.readDouble();
+                const int numIns = in.readInt();
+                const int numOuts = in.readInt();
+                const int blockSize = in.readInt();
+                const int numParams = in.readInt();
+                const String name (in.readString());
+                const File file (in.readString());
+
+                plugin->setPlayConfigDetails (numIns, numOuts, sampleRate, blockSize);
+                plugin->prepareToPlay (sampleRate, blockSize);
+
+                audioThread = new AudioThread (*plugin, new SharedAudioBlock (name, file, jmax (numIns, numOuts),
+                                                                              blockSize, numParams, false),
+                                               sampleRate);
+
+                if (audioThread->isValid())
+                    audioThread->startThread (9);
+                else
+                    audioThread = nullptr;
+
+                reply.writeBool (audioThread != nullptr);
+                reply.writeInt (plugin->getLatencySamples());
+                break;
+            }
+
+            case releaseCommand:
+                stopAudioThread();
+                plugin->releaseResources();
+                break;
+
+            case setParameterCommand:
+            {
+                const int index = in.readInt();
+                plugin->setParameter (index, in.readFloat());
+                break;
+            }
+
+            case getParameterTextCommand:
+                reply.writeString (plugin->getParameterText (in.readInt()));
+                break;
+
+            case getStateCommand:
+            {
+                MemoryBlock state;
+                plugin->getStateInformation (state);
+                reply << state;
+                break;
+            }
+
+            case setStateCommand:
+            {
+                MemoryBlock state;
+                in.readIntoMemoryBlock (state);
+                plugin->setStateInformation (state.getData(), (int) state.getSize());
+                reply << createPluginDetails();
+                break;
+            }
+
+            case setProgramCommand:
+                plugin->setCurrentProgram (in.readInt());
+                reply << createPluginDetails();
+                break;
+
+            case getProgramNameCommand:
+                reply.writeString (plugin->getProgramName (in.readInt()));
+                break;
+
+            case changeProgramNameCommand:
+            {
+                const int index = in.readInt();
+                plugin->changeProgramName (index, in.readString());
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    sendMessageToMaster (reply.getMemoryBlock());
+}
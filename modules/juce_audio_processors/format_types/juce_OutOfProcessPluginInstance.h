@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_OUTOFPROCESSPLUGININSTANCE_H_INCLUDED
+#define JUCE_OUTOFPROCESSPLUGININSTANCE_H_INCLUDED
+
+
+//==============================================================================
+/**
+    An AudioPluginInstance that runs the real plugin in a child process.
+
+    If the plugin crashes or hangs, only the child process dies: this instance then
+    carries on producing silence, and isPluginProcessRunning() returns false.
+
+    The audio and MIDI for each block go through a shared memory area, and the two
+    processes wake each other with a pair of cross-process semaphores, so a block
+    costs two semaphore hand-offs rather than a trip through a pipe. Everything else
+    (loading, state, programs, etc) is sent as messages through a ChildProcessMaster.
+
+    Parameter changes are queued in the shared memory and applied by the child just
+    before it processes the next block, and the values it reports back after each
+    block are what getParameter() returns, so neither of these blocks the caller.
+
+    The child process runs the executable that you give it, which may be your own
+    app. Its startup code needs to use a PluginHostSlave to recognise that it has
+    been launched as a plugin host.
+
+    The plugin's editor isn't available through this class.
+
+    @see PluginHostSlave, ChildProcessMaster
+*/
+class JUCE_API  OutOfProcessPluginInstance  : public AudioPluginInstance
+{
+public:
+    //==============================================================================
+    /** Launches a child process and loads a plugin in it.
+
+        @param hostExecutable       the executable to launch. Its startup code must pass its
+                                    command-line to a PluginHostSlave, using the same commandLineID
+        @param description          the plugin to load
+        @param initialSampleRate    passed to the plugin when it's loaded
+        @param initialBufferSize    passed to the plugin when it's loaded
+        @param errorMessage         if this fails, the reason is put in here
+        @param commandLineID        a short alphanumeric string (no spaces) that's used to
+                                    recognise the host's command-line
+        @returns a new instance, or nullptr if the plugin couldn't be loaded
+    */
+    static OutOfProcessPluginInstance* create (const File& hostExecutable,
+                                               const PluginDescription& description,
+                                               double initialSampleRate,
+                                               int initialBufferSize,
+                                               String& errorMessage,
+                                               const String& commandLineID = defaultCommandLineID);
+
+    /** Destructor. This shuts down the child process. */
+    ~OutOfProcessPluginInstance();
+
+    /** The ID that's used if you don't supply one. */
+    static const char* const defaultCommandLineID;
+
+    //==============================================================================
+    /** Returns false if the child process has crashed, hung or been disconnected. */
+    bool isPluginProcessRunning() const noexcept;
+
+    /** Sets how long processBlock() will wait for the child to finish a block before
+        deciding that it has hung. The default is 1000ms.
+    */
+    void setProcessTimeout (int timeoutMs) noexcept;
+
+    //==============================================================================
+    /** @internal */
+    void fillInPluginDescription (PluginDescription&) const override;
+    /** @internal */
+    const String getName() const override;
+    /** @internal */
+    void prepareToPlay (double sampleRate, int estimatedSamplesPerBlock) override;
+    /** @internal */
+    void releaseResources() override;
+    /** @internal */
+    void processBlock (AudioSampleBuffer&, MidiBuffer&) override;
+    /** @internal */
+    const String getInputChannelName (int) const override;
+    /** @internal */
+    const String getOutputChannelName (int) const override;
+    /** @internal */
+    bool isInputChannelStereoPair (int) const override;
+    /** @internal */
+    bool isOutputChannelStereoPair (int) const override;
+    /** @internal */
+    bool silenceInProducesSilenceOut() const override;
+    /** @internal */
+    double getTailLengthSeconds() const override;
+    /** @internal */
+    bool acceptsMidi() const override;
+    /** @internal */
+    bool producesMidi() const override;
+    /** @internal */
+    AudioProcessorEditor* createEditor() override;
+    /** @internal */
+    bool hasEditor() const override;
+    /** @internal */
+    int getNumParameters() override;
+    /** @internal */
+    const String getParameterName (int) override;
+    /** @internal */
+    float getParameter (int) override;
+    /** @internal */
+    const String getParameterText (int) override;
+    /** @internal */
+    void setParameter (int, float) override;
+    /** @internal */
+    int getNumPrograms() override;
+    /** @internal */
+    int getCurrentProgram() override;
+    /** @internal */
+    void setCurrentProgram (int) override;
+    /** @internal */
+    const String getProgramName (int) override;
+    /** @internal */
+    void changeProgramName (int, const String&) override;
+    /** @internal */
+    void getStateInformation (MemoryBlock&) override;
+    /** @internal */
+    void setStateInformation (const void*, int) override;
+
+private:
+    //==============================================================================
+    struct Connection;
+    friend struct Connection;
+    friend struct ContainerDeletePolicy<Connection>;
+    struct Transport;
+    friend struct ContainerDeletePolicy<Transport>;
+
+    ScopedPointer<Connection> connection;
+    ScopedPointer<Transport> transport;
+    CriticalSection transportLock;
+    SpinLock parameterQueueLock;
+
+    PluginDescription description;
+    String name;
+    bool pluginAcceptsMidi, pluginProducesMidi, pluginSilenceInProducesSilenceOut;
+    double tailLengthSeconds;
+    StringArray parameterNames;
+    Array<float> parameterValues;
+    int numPrograms, currentProgram, processTimeoutMs;
+
+    OutOfProcessPluginInstance (Connection*);
+
+    bool sendRequest (int command, const MemoryBlock& arguments, MemoryBlock* reply, int timeoutMs);
+    bool readPluginDetails (const MemoryBlock&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OutOfProcessPluginInstance)
+};
+
+//==============================================================================
+/**
+    The child-process end of an OutOfProcessPluginInstance.
+
+    Create one of these in your app's startup code, and if initialiseFromCommandLine()
+    returns true, the app has been launched to host a plugin and should just keep its
+    message loop running, e.g.
+
+    @code
+    void initialise (const String& commandLine) override
+    {
+        formatManager.addDefaultFormats();
+
+        ScopedPointer<PluginHostSlave> slave (new PluginHostSlave (formatManager));
+
+        if (slave->initialiseFromCommandLine (commandLine, OutOfProcessPluginInstance::defaultCommandLineID))
+        {
+            hostSlave = slave; // keep it alive until the app quits
+            return;
+        }
+
+        // ..otherwise carry on with your normal startup..
+    }
+    @endcode
+
+    The plugin is created and controlled on the message thread, and its audio is
+    processed on a realtime thread that this object runs. When the master process
+    goes away, handleConnectionLost() calls JUCEApplicationBase::quit().
+*/
+class JUCE_API  PluginHostSlave  : public ChildProcessSlave
+{
+public:
+    /** Creates a slave that uses the formats in the given manager, which must not be
+        deleted before this object is.
+    */
+    PluginHostSlave (AudioPluginFormatManager& formatsToUse);
+
+    /** Destructor. */
+    ~PluginHostSlave();
+
+    //==============================================================================
+    /** @internal */
+    void handleMessageFromMaster (const MemoryBlock&) override;
+    /** @internal */
+    void handleConnectionLost() override;
+
+private:
+    AudioPluginFormatManager& formatManager;
+    ScopedPointer<AudioPluginInstance> plugin;
+
+    struct RequestMessage;
+    friend struct RequestMessage;
+    class AudioThread;
+    friend class AudioThread;
+    friend struct ContainerDeletePolicy<AudioThread>;
+    ScopedPointer<AudioThread> audioThread;
+
+    void handleRequest (int requestID, int command, MemoryInputStream& arguments);
+    MemoryBlock createPluginDetails();
+    void stopAudioThread();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginHostSlave)
+};
+
+
+#endif   // JUCE_OUTOFPROCESSPLUGININSTANCE_H_INCLUDED
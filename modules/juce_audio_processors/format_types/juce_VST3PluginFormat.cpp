@@ -1742,6 +1742,12 @@ public:
 
         setLatencySamples (jmax (0, (int) processor->getLatencySamples()));
 
+        // (the edit controller shouldn't be asked for these on the audio thread)
+        parameterIDs.clearQuick();
+
+        for (int i = 0; i < getNumParameters(); ++i)
+            parameterIDs.add (getParameterInfoForIndex (i).id);
+
         warnOnFailure (component->setActive (true));
         warnOnFailure (processor->setProcessing (true));
 
@@ -1794,6 +1800,7 @@ public:
 
             associateTo (data, buffer);
             associateTo (data, midiMessages);
+            addQueuedParameterChanges (numSamples);
 
             processor->process (data);
 
@@ -2189,6 +2196,7 @@ private:
     }
 
     ComSmartPtr<ParamValueQueueList> inputParameterChanges, outputParameterChanges;
+    Array<Vst::ParamID> parameterIDs;
     ComSmartPtr<MidiEventList> midiInputs, midiOutputs;
     Vst::ProcessContext timingInfo; //< Only use this in processBlock()!
     bool isComponentInitialised, isControllerInitialised, isActive;
@@ -2414,6 +2422,26 @@ private:
         destination.outputEvents = midiOutputs;
     }
 
+    // Any changes that have been pushed into this instance's ParameterChangeQueue (and that
+    // nothing else has read) are passed on to the plugin at their sample offsets, so that it
+    // can apply them sample-accurately instead of at the start of the block.
+    void addQueuedParameterChanges (const int numSamples)
+    {
+        ParameterChangeQueue& queue = getParameterChangeQueue();
+        ParameterChangeQueue::Change change;
+
+        while (queue.pop (change))
+        {
+            if (isPositiveAndBelow (change.parameterIndex, parameterIDs.size()))
+            {
+                Steinberg::int32 index;
+                inputParameterChanges->addParameterData (parameterIDs.getUnchecked (change.parameterIndex), index)
+                    ->addPoint ((Steinberg::int32) jlimit (0, jmax (0, numSamples - 1), change.sampleOffset),
+                                (Vst::ParamValue) change.newValue, index);
+            }
+        }
+    }
+
     void updateTimingInformation (Vst::ProcessData& destination, double processSampleRate)
     {
         toProcessContext (timingInfo, getPlayHead(), processSampleRate);
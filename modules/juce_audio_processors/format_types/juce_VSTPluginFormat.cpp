@@ -1278,6 +1278,7 @@ public:
 
                     for (int i = ComponentPeer::getNumPeers(); --i >= 0;)
                         if (ComponentPeer* p = ComponentPeer::getPeer(i))
+                            p->flushQueuedRepaints();
                             p->performAnyPendingRepaintsNow();
                 }
                 break;
@@ -58,6 +58,10 @@
  #undef KeyPress
 #endif
 
+#if ! JUCE_WINDOWS
+ #include <semaphore.h>
+#endif
+
 #if ! JUCE_WINDOWS && ! JUCE_MAC
  #undef JUCE_PLUGINHOST_VST3
  #define JUCE_PLUGINHOST_VST3 0
@@ -146,13 +150,17 @@ struct AutoResizingNSViewComponentWithParent  : public AutoResizingNSViewCompone
 #include "processors/juce_AudioProcessorEditor.cpp"
 #include "processors/juce_AudioProcessorGraph.cpp"
 #include "processors/juce_GenericAudioProcessorEditor.cpp"
+#include "processors/juce_ParameterChangeQueue.cpp"
 #include "processors/juce_PluginDescription.cpp"
 #include "format_types/juce_LADSPAPluginFormat.cpp"
 #include "format_types/juce_VSTPluginFormat.cpp"
 #include "format_types/juce_VST3PluginFormat.cpp"
 #include "format_types/juce_AudioUnitPluginFormat.mm"
+#include "format_types/juce_OutOfProcessPluginInstance.cpp"
 #include "scanning/juce_KnownPluginList.cpp"
+#include "scanning/juce_KnownPluginListCache.cpp"
 #include "scanning/juce_PluginDirectoryScanner.cpp"
+#include "scanning/juce_OutOfProcessPluginScanner.cpp"
 #include "scanning/juce_PluginListComponent.cpp"
 
 }
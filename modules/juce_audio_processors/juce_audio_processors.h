@@ -73,10 +73,10 @@ namespace juce
 {
 
 class AudioProcessor;
-#include "processors/juce_AudioPlayHead.h"
 #include "processors/juce_AudioProcessorEditor.h"
 #include "processors/juce_AudioProcessorListener.h"
 #include "processors/juce_AudioProcessorParameter.h"
+#include "processors/juce_ParameterChangeQueue.h"
 #include "processors/juce_AudioProcessor.h"
 #include "processors/juce_PluginDescription.h"
 #include "processors/juce_AudioPluginInstance.h"
@@ -85,12 +85,15 @@ class AudioProcessor;
 #include "format/juce_AudioPluginFormat.h"
 #include "format/juce_AudioPluginFormatManager.h"
 #include "scanning/juce_KnownPluginList.h"
+#include "scanning/juce_KnownPluginListCache.h"
 #include "format_types/juce_AudioUnitPluginFormat.h"
 #include "format_types/juce_LADSPAPluginFormat.h"
 #include "format_types/juce_VSTMidiEventList.h"
 #include "format_types/juce_VSTPluginFormat.h"
 #include "format_types/juce_VST3PluginFormat.h"
+#include "format_types/juce_OutOfProcessPluginInstance.h"
 #include "scanning/juce_PluginDirectoryScanner.h"
+#include "scanning/juce_OutOfProcessPluginScanner.h"
 #include "scanning/juce_PluginListComponent.h"
 
 }
@@ -38,7 +38,8 @@ AudioProcessor::AudioProcessor()
       numOutputChannels (0),
       latencySamples (0),
       suspended (false),
-      nonRealtime (false)
+      nonRealtime (false),
+      processingPrecision (singlePrecision)
 {
 }
 
@@ -62,14 +63,12 @@ void AudioProcessor::setPlayHead (AudioPlayHead* const newPlayHead)
 
 void AudioProcessor::addListener (AudioProcessorListener* const newListener)
 {
-    const ScopedLock sl (listenerLock);
-    listeners.addIfNotAlreadyThere (newListener);
+    listeners.add (newListener);
 }
 
 void AudioProcessor::removeListener (AudioProcessorListener* const listenerToRemove)
 {
-    const ScopedLock sl (listenerLock);
-    listeners.removeFirstMatchingValue (listenerToRemove);
+    listeners.remove (listenerToRemove);
 }
 
 void AudioProcessor::setPlayConfigDetails (const int newNumIns,
@@ -102,6 +101,19 @@ void AudioProcessor::setNonRealtime (const bool newNonRealtime) noexcept
     nonRealtime = newNonRealtime;
 }
 
+void AudioProcessor::setProcessingPrecision (const ProcessingPrecision newPrecision) noexcept
+{
+    // If you hit this, the processor doesn't have a double precision processBlock()..
+    jassert (newPrecision == singlePrecision || supportsDoublePrecisionProcessing());
+
+    processingPrecision = newPrecision;
+}
+
+bool AudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return false;
+}
+
 void AudioProcessor::setLatencySamples (const int newLatency)
 {
     if (latencySamples != newLatency)
@@ -115,22 +127,15 @@ void AudioProcessor::setParameterNotifyingHost (const int parameterIndex,
                                                 const float newValue)
 {
     setParameter (parameterIndex, newValue);
+    parameterChangeQueue.markAsDirty (parameterIndex);
     sendParamChangeMessageToListeners (parameterIndex, newValue);
 }
 
-AudioProcessorListener* AudioProcessor::getListenerLocked (const int index) const noexcept
-{
-    const ScopedLock sl (listenerLock);
-    return listeners [index];
-}
-
 void AudioProcessor::sendParamChangeMessageToListeners (const int parameterIndex, const float newValue)
 {
     if (isPositiveAndBelow (parameterIndex, getNumParameters()))
     {
-        for (int i = listeners.size(); --i >= 0;)
-            if (AudioProcessorListener* l = getListenerLocked (i))
-                l->audioProcessorParameterChanged (this, parameterIndex, newValue);
+        listeners.call (&AudioProcessorListener::audioProcessorParameterChanged, this, parameterIndex, newValue);
     }
     else
     {
@@ -149,9 +154,7 @@ void AudioProcessor::beginParameterChangeGesture (int parameterIndex)
         changingParams.setBit (parameterIndex);
        #endif
 
-        for (int i = listeners.size(); --i >= 0;)
-            if (AudioProcessorListener* l = getListenerLocked (i))
-                l->audioProcessorParameterChangeGestureBegin (this, parameterIndex);
+        listeners.call (&AudioProcessorListener::audioProcessorParameterChangeGestureBegin, this, parameterIndex);
     }
     else
     {
@@ -171,9 +174,7 @@ void AudioProcessor::endParameterChangeGesture (int parameterIndex)
         changingParams.clearBit (parameterIndex);
        #endif
 
-        for (int i = listeners.size(); --i >= 0;)
-            if (AudioProcessorListener* l = getListenerLocked (i))
-                l->audioProcessorParameterChangeGestureEnd (this, parameterIndex);
+        listeners.call (&AudioProcessorListener::audioProcessorParameterChangeGestureEnd, this, parameterIndex);
     }
     else
     {
@@ -183,9 +184,7 @@ void AudioProcessor::endParameterChangeGesture (int parameterIndex)
 
 void AudioProcessor::updateHostDisplay()
 {
-    for (int i = listeners.size(); --i >= 0;)
-        if (AudioProcessorListener* l = getListenerLocked (i))
-            l->audioProcessorChanged (this);
+    listeners.call (&AudioProcessorListener::audioProcessorChanged, this);
 }
 
 const OwnedArray<AudioProcessorParameter>& AudioProcessor::getParameters() const noexcept
@@ -310,6 +309,7 @@ void AudioProcessor::addParameter (AudioProcessorParameter* p)
     p->processor = this;
     p->parameterIndex = managedParameters.size();
     managedParameters.add (p);
+    parameterChangeQueue.setNumParameters (managedParameters.size());
 }
 
 void AudioProcessor::suspendProcessing (const bool shouldBeSuspended)
@@ -320,6 +320,15 @@ void AudioProcessor::suspendProcessing (const bool shouldBeSuspended)
 
 void AudioProcessor::reset() {}
 void AudioProcessor::processBlockBypassed (AudioSampleBuffer&, MidiBuffer&) {}
+void AudioProcessor::processBlockBypassed (AudioBuffer<double>&, MidiBuffer&) {}
+
+void AudioProcessor::processBlock (AudioBuffer<double>&, MidiBuffer&)
+{
+    // If you hit this, either the host has called the double precision processBlock() on a
+    // processor that doesn't support it, or the processor's supportsDoublePrecisionProcessing()
+    // returns true but it hasn't overridden this method.
+    jassertfalse;
+}
 
 //==============================================================================
 void AudioProcessor::editorBeingDeleted (AudioProcessorEditor* const editor) noexcept
@@ -367,6 +376,142 @@ void AudioProcessor::setCurrentProgramStateInformation (const void* data, int si
 // magic number to identify memory blocks that we've stored as XML
 const uint32 magicXmlNumber = 0x21324356;
 
+/*  A compact state block is the magic number, a flags word (the format version in the
+    low byte, then the content type and compression flags), the payload size, and then
+    the payload: either a ValueTree written with ValueTree::writeToStream(), or an
+    XmlElement written by writeXmlElement().
+*/
+namespace CompactStateHelpers
+{
+    const uint32 magicCompactStateNumber = 0x21324357;
+
+    enum
+    {
+        formatVersion    = 1,
+        versionMask      = 0xff,
+        xmlContent       = 0x100,
+        valueTreeContent = 0,
+        compressedFlag   = 0x200,
+        headerSize       = 12
+    };
+
+    static void writeXmlElement (OutputStream& out, const XmlElement& xml)
+    {
+        if (xml.isTextElement())
+        {
+            out.writeString (String());
+            out.writeString (xml.getText());
+            return;
+        }
+
+        out.writeString (xml.getTagName());
+
+        const int numAttributes = xml.getNumAttributes();
+        out.writeCompressedInt (numAttributes);
+
+        for (int i = 0; i < numAttributes; ++i)
+        {
+            out.writeString (xml.getAttributeName (i));
+            out.writeString (xml.getAttributeValue (i));
+        }
+
+        out.writeCompressedInt (xml.getNumChildElements());
+
+        for (const XmlElement* child = xml.getFirstChildElement(); child != nullptr; child = child->getNextElement())
+            writeXmlElement (out, *child);
+    }
+
+    static XmlElement* readXmlElement (InputStream& in, const int depth)
+    {
+        const String tagName (in.readString());
+
+        if (tagName.isEmpty())
+            return XmlElement::createTextElement (in.readString());
+
+        if (depth > 256)
+            return nullptr;
+
+        ScopedPointer<XmlElement> xml (new XmlElement (tagName));
+
+        for (int i = in.readCompressedInt(); --i >= 0 && ! in.isExhausted();)
+        {
+            const String name (in.readString());
+            xml->setAttribute (name, in.readString());
+        }
+
+        for (int i = in.readCompressedInt(); --i >= 0;)
+        {
+            if (in.isExhausted())
+                return nullptr;
+
+            if (XmlElement* const child = readXmlElement (in, depth + 1))
+                xml->addChildElement (child);
+            else
+                return nullptr;
+        }
+
+        return xml.release();
+    }
+
+    static int64 writeHeader (OutputStream& out, const int contentType, const bool compress)
+    {
+        const int64 headerStart = out.getPosition();
+        out.writeInt ((int) magicCompactStateNumber);
+        out.writeInt (formatVersion | contentType | (compress ? (int) compressedFlag : 0));
+        out.writeInt (0);
+        return headerStart;
+    }
+
+    static void finishHeader (MemoryOutputStream& out, const int64 headerStart)
+    {
+        out.flush();
+
+        // go back and write the payload size..
+        const uint32 payloadSize = (uint32) (out.getPosition() - headerStart - headerSize);
+        const int64 endPos = out.getPosition();
+
+        out.setPosition (headerStart + 8);
+        out.writeInt ((int) payloadSize);
+        out.setPosition (endPos);
+    }
+
+    static bool readHeader (const void* const data, const int sizeInBytes,
+                            int& flags, const void*& payload, size_t& payloadSize)
+    {
+        if (data == nullptr || sizeInBytes < headerSize
+             || ByteOrder::littleEndianInt (data) != magicCompactStateNumber)
+            return false;
+
+        flags = (int) ByteOrder::littleEndianInt (addBytesToPointer (data, 4));
+        payloadSize = (size_t) ByteOrder::littleEndianInt (addBytesToPointer (data, 8));
+        payload = addBytesToPointer (data, headerSize);
+
+        // (states from a newer version of the format can't be read)
+        return (flags & versionMask) <= formatVersion
+                 && payloadSize <= (size_t) (sizeInBytes - headerSize);
+    }
+
+    static XmlElement* readXml (const void* const data, const int sizeInBytes)
+    {
+        int flags;
+        const void* payload;
+        size_t payloadSize;
+
+        if (! (readHeader (data, sizeInBytes, flags, payload, payloadSize) && (flags & xmlContent) != 0))
+            return nullptr;
+
+        MemoryInputStream in (payload, payloadSize, false);
+
+        if ((flags & compressedFlag) != 0)
+        {
+            GZIPDecompressorInputStream gzip (in);
+            return readXmlElement (gzip, 0);
+        }
+
+        return readXmlElement (in, 0);
+    }
+}
+
 void AudioProcessor::copyXmlToBinary (const XmlElement& xml, juce::MemoryBlock& destData)
 {
     {
@@ -394,7 +539,63 @@ XmlElement* AudioProcessor::getXmlFromBinary (const void* data, const int sizeIn
                                                          jmin ((sizeInBytes - 8), stringLength)));
     }
 
-    return nullptr;
+    return CompactStateHelpers::readXml (data, sizeInBytes);
+}
+
+void AudioProcessor::copyXmlToCompactBinary (const XmlElement& xml, juce::MemoryBlock& destData, const bool compress)
+{
+    using namespace CompactStateHelpers;
+
+    MemoryOutputStream out (destData, false);
+    const int64 headerStart = writeHeader (out, xmlContent, compress);
+
+    if (compress)
+    {
+        GZIPCompressorOutputStream gzip (&out, 6, false);
+        writeXmlElement (gzip, xml);
+    }
+    else
+    {
+        writeXmlElement (out, xml);
+    }
+
+    finishHeader (out, headerStart);
+}
+
+void AudioProcessor::copyValueTreeToBinary (const ValueTree& state, juce::MemoryBlock& destData, const bool compress)
+{
+    using namespace CompactStateHelpers;
+
+    MemoryOutputStream out (destData, false);
+    const int64 headerStart = writeHeader (out, valueTreeContent, compress);
+
+    if (compress)
+    {
+        GZIPCompressorOutputStream gzip (&out, 6, false);
+        state.writeToStream (gzip);
+    }
+    else
+    {
+        state.writeToStream (out);
+    }
+
+    finishHeader (out, headerStart);
+}
+
+ValueTree AudioProcessor::getValueTreeFromBinary (const void* const data, const int sizeInBytes)
+{
+    using namespace CompactStateHelpers;
+
+    int flags;
+    const void* payload;
+    size_t payloadSize;
+
+    if (readHeader (data, sizeInBytes, flags, payload, payloadSize) && (flags & xmlContent) == 0)
+        return (flags & compressedFlag) != 0 ? ValueTree::readFromGZIPData (payload, payloadSize)
+                                             : ValueTree::readFromData (payload, payloadSize);
+
+    const ScopedPointer<XmlElement> xml (getXmlFromBinary (data, sizeInBytes));
+    return xml != nullptr ? ValueTree::fromXml (*xml) : ValueTree();
 }
 
 //==============================================================================
@@ -441,34 +642,3 @@ String AudioProcessorParameter::getText (float value, int /*maximumStringLength*
 {
     return String (value, 2);
 }
-
-//==============================================================================
-bool AudioPlayHead::CurrentPositionInfo::operator== (const CurrentPositionInfo& other) const noexcept
-{
-    return timeInSamples == other.timeInSamples
-        && ppqPosition == other.ppqPosition
-        && editOriginTime == other.editOriginTime
-        && ppqPositionOfLastBarStart == other.ppqPositionOfLastBarStart
-        && frameRate == other.frameRate
-        && isPlaying == other.isPlaying
-        && isRecording == other.isRecording
-        && bpm == other.bpm
-        && timeSigNumerator == other.timeSigNumerator
-        && timeSigDenominator == other.timeSigDenominator
-        && ppqLoopStart == other.ppqLoopStart
-        && ppqLoopEnd == other.ppqLoopEnd
-        && isLooping == other.isLooping;
-}
-
-bool AudioPlayHead::CurrentPositionInfo::operator!= (const CurrentPositionInfo& other) const noexcept
-{
-    return ! operator== (other);
-}
-
-void AudioPlayHead::CurrentPositionInfo::resetToDefault()
-{
-    zerostruct (*this);
-    timeSigNumerator = 4;
-    timeSigDenominator = 4;
-    bpm = 120;
-}
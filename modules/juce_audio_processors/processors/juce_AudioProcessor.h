@@ -125,6 +125,20 @@ public:
     virtual void processBlock (AudioSampleBuffer& buffer,
                                MidiBuffer& midiMessages) = 0;
 
+    /** Renders the next block at double precision.
+
+        This is only called if supportsDoublePrecisionProcessing() returns true, and the
+        host has chosen double precision with setProcessingPrecision(). It works in exactly
+        the same way as the single precision version of processBlock().
+
+        The default implementation of this does nothing, so if you override
+        supportsDoublePrecisionProcessing() to return true, you must also override this.
+
+        @see supportsDoublePrecisionProcessing, setProcessingPrecision
+    */
+    virtual void processBlock (AudioBuffer<double>& buffer,
+                               MidiBuffer& midiMessages);
+
     /** Renders the next block when the processor is being bypassed.
         The default implementation of this method will pass-through any incoming audio, but
         you may override this method e.g. to add latency compensation to the data to match
@@ -136,6 +150,45 @@ public:
     virtual void processBlockBypassed (AudioSampleBuffer& buffer,
                                        MidiBuffer& midiMessages);
 
+    /** The double precision version of processBlockBypassed().
+        Like the single precision one, the default implementation passes the audio through.
+    */
+    virtual void processBlockBypassed (AudioBuffer<double>& buffer,
+                                       MidiBuffer& midiMessages);
+
+    //==============================================================================
+    /** The sample types that a processor's processBlock() can be called with.
+        @see setProcessingPrecision
+    */
+    enum ProcessingPrecision
+    {
+        singlePrecision,
+        doublePrecision
+    };
+
+    /** Returns true if this processor has an implementation of processBlock() which takes
+        an AudioBuffer<double>.
+
+        The default implementation returns false, so processors that want to work at double
+        precision must override both this and the double precision processBlock().
+    */
+    virtual bool supportsDoublePrecisionProcessing() const;
+
+    /** Tells the processor which version of processBlock() the host is going to call.
+
+        This must be called before prepareToPlay(), and not while the processor is playing.
+        Double precision can only be chosen if supportsDoublePrecisionProcessing() returns
+        true. Once it's been chosen, the host must only call the double precision version
+        of processBlock().
+    */
+    void setProcessingPrecision (ProcessingPrecision newPrecision) noexcept;
+
+    /** Returns the precision that the host has chosen with setProcessingPrecision(). */
+    ProcessingPrecision getProcessingPrecision() const noexcept         { return processingPrecision; }
+
+    /** Returns true if the host will be calling the double precision version of processBlock(). */
+    bool isUsingDoublePrecision() const noexcept                        { return processingPrecision == doublePrecision; }
+
     //==============================================================================
     /** Returns the current AudioPlayHead object that should be used to find
         out the state and position of the playhead.
@@ -515,6 +568,16 @@ public:
     */
     void setParameterNotifyingHost (int parameterIndex, float newValue);
 
+    /** Returns this processor's lock-free queue of parameter changes.
+
+        A host can use it to pass sample-accurate automation into processBlock(), and an
+        editor can use its dirty set to find out which parameters have been changed by
+        setParameterNotifyingHost(), instead of listening for every change.
+
+        @see ParameterChangeQueue
+    */
+    ParameterChangeQueue& getParameterChangeQueue() noexcept        { return parameterChangeQueue; }
+
     /** Returns true if the host can automate this parameter.
         By default, this returns true for all parameters.
 
@@ -712,6 +775,36 @@ public:
     */
     static XmlElement* getXmlFromBinary (const void* data, int sizeInBytes);
 
+    /** Converts an xml element into a compact binary blob.
+
+        This does the same job as copyXmlToBinary(), but rather than formatting the XML
+        as text, it writes its tags and attributes directly, optionally GZIP-compressed.
+        For big states, this is much faster to save and load, and uses less memory.
+
+        Use getXmlFromBinary() to read the data back - it recognises both formats, so
+        you can switch a processor to using this without breaking older saved states.
+    */
+    static void copyXmlToCompactBinary (const XmlElement& xml,
+                                        juce::MemoryBlock& destData,
+                                        bool compress = false);
+
+    /** Converts a ValueTree into a compact binary blob, optionally GZIP-compressed.
+
+        Use getValueTreeFromBinary() to read the data back.
+    */
+    static void copyValueTreeToBinary (const ValueTree& state,
+                                       juce::MemoryBlock& destData,
+                                       bool compress = false);
+
+    /** Retrieves a ValueTree that was stored with copyValueTreeToBinary().
+
+        The tree is read directly from the data that's passed in, without copying it.
+        This can also read data that was stored as XML with copyXmlToBinary() or
+        copyXmlToCompactBinary(), using ValueTree::fromXml(). If the data's unsuitable
+        or corrupted, it returns an invalid ValueTree.
+    */
+    static ValueTree getValueTreeFromBinary (const void* data, int sizeInBytes);
+
     /** @internal */
     static void JUCE_CALLTYPE setTypeOfNextNewPlugin (WrapperType);
 
@@ -723,23 +816,23 @@ protected:
     void sendParamChangeMessageToListeners (int parameterIndex, float newValue);
 
 private:
-    Array<AudioProcessorListener*> listeners;
+    LockFreeListenerList<AudioProcessorListener> listeners;
     Component::SafePointer<AudioProcessorEditor> activeEditor;
     double sampleRate;
     int blockSize, numInputChannels, numOutputChannels, latencySamples;
     bool suspended, nonRealtime;
-    CriticalSection callbackLock, listenerLock;
+    ProcessingPrecision processingPrecision;
+    CriticalSection callbackLock;
     String inputSpeakerArrangement, outputSpeakerArrangement;
 
     OwnedArray<AudioProcessorParameter> managedParameters;
+    ParameterChangeQueue parameterChangeQueue;
     AudioProcessorParameter* getParamChecked (int) const noexcept;
 
    #if JUCE_DEBUG && ! JUCE_DISABLE_AUDIOPROCESSOR_BEGIN_END_GESTURE_CHECKING
     BigInteger changingParams;
    #endif
 
-    AudioProcessorListener* getListenerLocked (int) const noexcept;
-
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessor)
 };
 
@@ -28,27 +28,108 @@ const int AudioProcessorGraph::midiChannelIndex = 0x1000;
 namespace GraphRenderingOps
 {
 
+//==============================================================================
+/** Collects the set of shared buffers that a rendering op reads from or writes to.
+
+    Audio channels, midi buffers and the graph's own i/o buffers are all mapped onto
+    a single range of resource indices, so that the ops can be arranged into groups
+    which don't touch each other's data, and are therefore safe to run concurrently.
+*/
+struct RenderingResourceUsage
+{
+    RenderingResourceUsage (const int numAudioBuffers, const int numMidiBuffers) noexcept
+        : midiResourceBase (numAudioBuffers),
+          graphIOResource (numAudioBuffers + numMidiBuffers)
+    {}
+
+    int getNumResources() const noexcept            { return graphIOResource + 1; }
+
+    // audio buffer 0 is the shared read-only buffer of zeros, so writes to it are ignored
+    void readAudio (const int channel)              { reads.addIfNotAlreadyThere (channel); }
+    void writeAudio (const int channel)             { if (channel != 0) writes.addIfNotAlreadyThere (channel); }
+    void readMidi (const int buffer)                { reads.addIfNotAlreadyThere (midiResourceBase + buffer); }
+    void writeMidi (const int buffer)               { writes.addIfNotAlreadyThere (midiResourceBase + buffer); }
+    void writeGraphIO()                             { writes.addIfNotAlreadyThere (graphIOResource); }
+
+    void clear() noexcept                           { reads.clearQuick(); writes.clearQuick(); }
+
+    Array<int> reads, writes;
+
+private:
+    const int midiResourceBase, graphIOResource;
+
+    JUCE_DECLARE_NON_COPYABLE (RenderingResourceUsage)
+};
+
 //==============================================================================
 struct AudioGraphRenderingOp
 {
     AudioGraphRenderingOp() noexcept {}
     virtual ~AudioGraphRenderingOp() {}
 
+    /** Runs the op. The silentChannels array has a flag for each of the shared audio
+        channels, which is true if the whole channel is known to contain zeros.
+    */
     virtual void perform (AudioSampleBuffer& sharedBufferChans,
                           const OwnedArray<MidiBuffer>& sharedMidiBuffers,
+                          bool* silentChannels,
                           const int numSamples) = 0;
 
+    /** Runs the op on the shared buffers of a graph that's rendering at double precision. */
+    virtual void perform (AudioBuffer<double>& sharedBufferChans,
+                          const OwnedArray<MidiBuffer>& sharedMidiBuffers,
+                          bool* silentChannels,
+                          const int numSamples) = 0;
+
+    virtual void getResourceUsage (RenderingResourceUsage&) const = 0;
+
     JUCE_LEAK_DETECTOR (AudioGraphRenderingOp)
 };
 
+/** Implements both versions of perform() by calling the op's render() method, which is
+    a template that works with either sample type.
+*/
+template <class OpType>
+struct AudioGraphRenderingOpBase  : public AudioGraphRenderingOp
+{
+    void perform (AudioSampleBuffer& sharedBufferChans, const OwnedArray<MidiBuffer>& sharedMidiBuffers,
+                  bool* silentChannels, const int numSamples) override
+    {
+        static_cast<OpType*> (this)->render (sharedBufferChans, sharedMidiBuffers, silentChannels, numSamples);
+    }
+
+    void perform (AudioBuffer<double>& sharedBufferChans, const OwnedArray<MidiBuffer>& sharedMidiBuffers,
+                  bool* silentChannels, const int numSamples) override
+    {
+        static_cast<OpType*> (this)->render (sharedBufferChans, sharedMidiBuffers, silentChannels, numSamples);
+    }
+};
+
+/** Clears the whole of a shared channel, unless it's already known to be silent. */
+template <typename FloatType>
+static void clearSharedChannel (AudioBuffer<FloatType>& sharedBufferChans, bool* silentChannels, const int channel)
+{
+    if (! silentChannels [channel])
+    {
+        sharedBufferChans.clear (channel, 0, sharedBufferChans.getNumSamples());
+        silentChannels [channel] = true;
+    }
+}
+
 //==============================================================================
-struct ClearChannelOp  : public AudioGraphRenderingOp
+struct ClearChannelOp  : public AudioGraphRenderingOpBase<ClearChannelOp>
 {
     ClearChannelOp (const int channel) noexcept  : channelNum (channel)  {}
 
-    void perform (AudioSampleBuffer& sharedBufferChans, const OwnedArray<MidiBuffer>&, const int numSamples)
+    template <typename FloatType>
+    void render (AudioBuffer<FloatType>& sharedBufferChans, const OwnedArray<MidiBuffer>&, bool* silentChannels, const int)
     {
-        sharedBufferChans.clear (channelNum, 0, numSamples);
+        clearSharedChannel (sharedBufferChans, silentChannels, channelNum);
+    }
+
+    void getResourceUsage (RenderingResourceUsage& usage) const
+    {
+        usage.writeAudio (channelNum);
     }
 
     const int channelNum;
@@ -57,15 +138,30 @@ struct ClearChannelOp  : public AudioGraphRenderingOp
 };
 
 //==============================================================================
-struct CopyChannelOp  : public AudioGraphRenderingOp
+struct CopyChannelOp  : public AudioGraphRenderingOpBase<CopyChannelOp>
 {
     CopyChannelOp (const int srcChan, const int dstChan) noexcept
         : srcChannelNum (srcChan), dstChannelNum (dstChan)
     {}
 
-    void perform (AudioSampleBuffer& sharedBufferChans, const OwnedArray<MidiBuffer>&, const int numSamples)
+    template <typename FloatType>
+    void render (AudioBuffer<FloatType>& sharedBufferChans, const OwnedArray<MidiBuffer>&, bool* silentChannels, const int numSamples)
+    {
+        if (silentChannels [srcChannelNum])
+        {
+            clearSharedChannel (sharedBufferChans, silentChannels, dstChannelNum);
+        }
+        else
+        {
+            sharedBufferChans.copyFrom (dstChannelNum, 0, sharedBufferChans, srcChannelNum, 0, numSamples);
+            silentChannels [dstChannelNum] = false;
+        }
+    }
+
+    void getResourceUsage (RenderingResourceUsage& usage) const
     {
-        sharedBufferChans.copyFrom (dstChannelNum, 0, sharedBufferChans, srcChannelNum, 0, numSamples);
+        usage.readAudio (srcChannelNum);
+        usage.writeAudio (dstChannelNum);
     }
 
     const int srcChannelNum, dstChannelNum;
@@ -74,15 +170,30 @@ struct CopyChannelOp  : public AudioGraphRenderingOp
 };
 
 //==============================================================================
-struct AddChannelOp  : public AudioGraphRenderingOp
+struct AddChannelOp  : public AudioGraphRenderingOpBase<AddChannelOp>
 {
     AddChannelOp (const int srcChan, const int dstChan) noexcept
         : srcChannelNum (srcChan), dstChannelNum (dstChan)
     {}
 
-    void perform (AudioSampleBuffer& sharedBufferChans, const OwnedArray<MidiBuffer>&, const int numSamples)
+    template <typename FloatType>
+    void render (AudioBuffer<FloatType>& sharedBufferChans, const OwnedArray<MidiBuffer>&, bool* silentChannels, const int numSamples)
     {
-        sharedBufferChans.addFrom (dstChannelNum, 0, sharedBufferChans, srcChannelNum, 0, numSamples);
+        if (! silentChannels [srcChannelNum])
+        {
+            if (silentChannels [dstChannelNum])
+                sharedBufferChans.copyFrom (dstChannelNum, 0, sharedBufferChans, srcChannelNum, 0, numSamples);
+            else
+                sharedBufferChans.addFrom (dstChannelNum, 0, sharedBufferChans, srcChannelNum, 0, numSamples);
+
+            silentChannels [dstChannelNum] = false;
+        }
+    }
+
+    void getResourceUsage (RenderingResourceUsage& usage) const
+    {
+        usage.readAudio (srcChannelNum);
+        usage.writeAudio (dstChannelNum);
     }
 
     const int srcChannelNum, dstChannelNum;
@@ -91,116 +202,445 @@ struct AddChannelOp  : public AudioGraphRenderingOp
 };
 
 //==============================================================================
-struct ClearMidiBufferOp  : public AudioGraphRenderingOp
+struct ClearMidiBufferOp  : public AudioGraphRenderingOpBase<ClearMidiBufferOp>
 {
     ClearMidiBufferOp (const int buffer) noexcept  : bufferNum (buffer)  {}
 
-    void perform (AudioSampleBuffer&, const OwnedArray<MidiBuffer>& sharedMidiBuffers, const int)
+    template <typename FloatType>
+    void render (AudioBuffer<FloatType>&, const OwnedArray<MidiBuffer>& sharedMidiBuffers, bool*, const int)
     {
         sharedMidiBuffers.getUnchecked (bufferNum)->clear();
     }
 
+    void getResourceUsage (RenderingResourceUsage& usage) const
+    {
+        usage.writeMidi (bufferNum);
+    }
+
     const int bufferNum;
 
     JUCE_DECLARE_NON_COPYABLE (ClearMidiBufferOp)
 };
 
 //==============================================================================
-struct CopyMidiBufferOp  : public AudioGraphRenderingOp
+struct CopyMidiBufferOp  : public AudioGraphRenderingOpBase<CopyMidiBufferOp>
 {
     CopyMidiBufferOp (const int srcBuffer, const int dstBuffer) noexcept
         : srcBufferNum (srcBuffer), dstBufferNum (dstBuffer)
     {}
 
-    void perform (AudioSampleBuffer&, const OwnedArray<MidiBuffer>& sharedMidiBuffers, const int)
+    template <typename FloatType>
+    void render (AudioBuffer<FloatType>&, const OwnedArray<MidiBuffer>& sharedMidiBuffers, bool*, const int)
     {
         *sharedMidiBuffers.getUnchecked (dstBufferNum) = *sharedMidiBuffers.getUnchecked (srcBufferNum);
     }
 
+    void getResourceUsage (RenderingResourceUsage& usage) const
+    {
+        usage.readMidi (srcBufferNum);
+        usage.writeMidi (dstBufferNum);
+    }
+
     const int srcBufferNum, dstBufferNum;
 
     JUCE_DECLARE_NON_COPYABLE (CopyMidiBufferOp)
 };
 
 //==============================================================================
-struct AddMidiBufferOp  : public AudioGraphRenderingOp
+struct AddMidiBufferOp  : public AudioGraphRenderingOpBase<AddMidiBufferOp>
 {
     AddMidiBufferOp (const int srcBuffer, const int dstBuffer)
         : srcBufferNum (srcBuffer), dstBufferNum (dstBuffer)
     {}
 
-    void perform (AudioSampleBuffer&, const OwnedArray<MidiBuffer>& sharedMidiBuffers, const int numSamples)
+    template <typename FloatType>
+    void render (AudioBuffer<FloatType>&, const OwnedArray<MidiBuffer>& sharedMidiBuffers, bool*, const int numSamples)
     {
         sharedMidiBuffers.getUnchecked (dstBufferNum)
             ->addEvents (*sharedMidiBuffers.getUnchecked (srcBufferNum), 0, numSamples, 0);
     }
 
+    void getResourceUsage (RenderingResourceUsage& usage) const
+    {
+        usage.readMidi (srcBufferNum);
+        usage.writeMidi (dstBufferNum);
+    }
+
     const int srcBufferNum, dstBufferNum;
 
     JUCE_DECLARE_NON_COPYABLE (AddMidiBufferOp)
 };
 
 //==============================================================================
-struct DelayChannelOp  : public AudioGraphRenderingOp
+/** A block of memory that's divided up between the delay lines.
+
+    Its size is a number of samples, and there's room for that many doubles, so that it can
+    be used by a graph that's rendering at either precision. (The arena is cleared whenever
+    the graph's precision changes, so one block never holds samples of both types).
+*/
+struct DelayBlock  : public ReferenceCountedObject
+{
+    DelayBlock (const int numSamples)  : size (numSamples)
+    {
+        data.calloc ((size_t) numSamples);
+    }
+
+    template <typename FloatType>
+    FloatType* getData() const noexcept     { return reinterpret_cast<FloatType*> (data.getData()); }
+
+    HeapBlock<double> data;
+    const int size;
+
+    typedef ReferenceCountedObjectPtr<DelayBlock> Ptr;
+
+    JUCE_DECLARE_NON_COPYABLE (DelayBlock)
+};
+
+/** A ring buffer that compensates for the latency of the path along one connection.
+
+    A line is identified by the source and destination channels of the connection
+    that it delays, so when the graph is rebuilt, a line with the same connection and
+    delay is handed over to the new rendering sequence with its contents intact.
+    Once a line has been used for rendering, only the audio thread touches it.
+*/
+struct DelayLine  : public ReferenceCountedObject
+{
+    DelayLine (const uint32 sourceNode, const int sourceChan,
+               const uint32 destNode, const int destChan, const int delaySamples) noexcept
+        : sourceNodeId (sourceNode), destNodeId (destNode),
+          sourceChannel (sourceChan), destChannel (destChan), length (delaySamples),
+          start (-1), writeIndex (0), numSilentSamples (0), needsClearing (true)
+    {}
+
+    bool isFor (const uint32 sourceNode, const int sourceChan,
+                const uint32 destNode, const int destChan, const int delaySamples) const noexcept
+    {
+        return sourceNodeId == sourceNode && sourceChannel == sourceChan
+                && destNodeId == destNode && destChannel == destChan && length == delaySamples;
+    }
+
+    /** Delays a block, and returns true if it skipped it because both the block and
+        the line's contents were silent.
+    */
+    template <typename FloatType>
+    bool process (FloatType* const samples, const int numSamples, const bool inputIsSilent) noexcept
+    {
+        FloatType* const buffer = block->getData<FloatType>() + start;
+
+        if (needsClearing)
+        {
+            // (the space may have belonged to another line until this one was first used)
+            FloatVectorOperations::clear (buffer, length);
+            writeIndex = 0;
+            numSilentSamples = length;
+            needsClearing = false;
+        }
+
+        if (inputIsSilent && numSilentSamples >= length)
+            return true;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const FloatType delayed = buffer [writeIndex];
+            buffer [writeIndex] = samples[i];
+            samples[i] = delayed;
+
+            if (++writeIndex >= length)
+                writeIndex = 0;
+        }
+
+        numSilentSamples = inputIsSilent ? jmin (length, numSilentSamples + numSamples) : 0;
+        return false;
+    }
+
+    const uint32 sourceNodeId, destNodeId;
+    const int sourceChannel, destChannel, length;
+
+    DelayBlock::Ptr block;
+    int start, writeIndex, numSilentSamples; // (the number of zeros that were most recently written)
+    bool needsClearing;
+
+    typedef ReferenceCountedObjectPtr<DelayLine> Ptr;
+
+    JUCE_DECLARE_NON_COPYABLE (DelayLine)
+};
+
+/** Hands out the delay lines for each new rendering sequence, keeping them all in one
+    shared block of memory which is re-used across rebuilds.
+
+    This is only used on the message thread. Lines which are still needed by a new
+    sequence are never modified, because the audio thread may still be using them in
+    the old one, and the memory of any that are no longer needed is kept alive by the
+    old sequence's ops until it's deleted.
+*/
+class DelayLineArena
 {
-    DelayChannelOp (const int chan, const int delaySize)
-        : channel (chan),
-          bufferSize (delaySize + 1),
-          readIndex (0), writeIndex (delaySize)
+public:
+    DelayLineArena() {}
+
+    DelayLine* getLine (const uint32 sourceNode, const int sourceChan,
+                        const uint32 destNode, const int destChan, const int delaySamples)
+    {
+        for (int i = 0; i < lines.size(); ++i)
+        {
+            DelayLine* const line = lines.getUnchecked (i);
+
+            if (line->isFor (sourceNode, sourceChan, destNode, destChan, delaySamples)
+                 && ! linesForNextSequence.contains (line))
+            {
+                linesForNextSequence.add (line);
+                return line;
+            }
+        }
+
+        DelayLine* const line = new DelayLine (sourceNode, sourceChan, destNode, destChan, delaySamples);
+        linesForNextSequence.add (line);
+        return line;
+    }
+
+    /** Finds space for any new lines that were asked for since the last call. */
+    void finishedBuilding()
+    {
+        int totalSize = 0;
+
+        for (int i = 0; i < linesForNextSequence.size(); ++i)
+            totalSize += linesForNextSequence.getUnchecked (i)->length;
+
+        if (totalSize == 0)
+            block = nullptr;
+        else if (block == nullptr || totalSize > block->size || ! placeNewLinesInGaps())
+            reallocate (totalSize);
+
+        lines.swapWith (linesForNextSequence);
+        linesForNextSequence.clear();
+    }
+
+    void clear()
     {
-        buffer.calloc ((size_t) bufferSize);
+        lines.clear();
+        linesForNextSequence.clear();
+        block = nullptr;
     }
 
-    void perform (AudioSampleBuffer& sharedBufferChans, const OwnedArray<MidiBuffer>&, const int numSamples)
+private:
+    ReferenceCountedArray<DelayLine> lines, linesForNextSequence;
+    DelayBlock::Ptr block;
+
+    bool placeNewLinesInGaps()
     {
-        float* data = sharedBufferChans.getWritePointer (channel, 0);
+        Array<Range<int> > usedRanges;
 
-        for (int i = numSamples; --i >= 0;)
+        for (int i = 0; i < linesForNextSequence.size(); ++i)
         {
-            buffer [writeIndex] = *data;
-            *data++ = buffer [readIndex];
+            const DelayLine* const line = linesForNextSequence.getUnchecked (i);
 
-            if (++readIndex  >= bufferSize) readIndex = 0;
-            if (++writeIndex >= bufferSize) writeIndex = 0;
+            if (line->start >= 0)
+                addSorted (usedRanges, Range<int> (line->start, line->start + line->length));
         }
+
+        for (int i = 0; i < linesForNextSequence.size(); ++i)
+        {
+            DelayLine* const line = linesForNextSequence.getUnchecked (i);
+
+            if (line->start < 0)
+            {
+                const int start = findGap (usedRanges, line->length);
+
+                if (start < 0)
+                    return false;
+
+                addSorted (usedRanges, Range<int> (start, start + line->length));
+                line->block = block;
+                line->start = start;
+            }
+        }
+
+        return true;
+    }
+
+    void reallocate (const int totalSize)
+    {
+        // (leaves some headroom so that a few latency changes don't need another block)
+        block = new DelayBlock (totalSize * 2);
+        int start = 0;
+
+        for (int i = 0; i < linesForNextSequence.size(); ++i)
+        {
+            DelayLine* line = linesForNextSequence.getUnchecked (i);
+
+            // a line that's already in use can't be moved, so it's replaced by a new one
+            if (line->start >= 0)
+            {
+                line = new DelayLine (line->sourceNodeId, line->sourceChannel,
+                                      line->destNodeId, line->destChannel, line->length);
+                linesForNextSequence.set (i, line);
+            }
+
+            line->block = block;
+            line->start = start;
+            start += line->length;
+        }
+    }
+
+    int findGap (const Array<Range<int> >& usedRanges, const int size) const noexcept
+    {
+        int pos = 0;
+
+        for (int i = 0; i < usedRanges.size(); ++i)
+        {
+            const Range<int> r (usedRanges.getReference (i));
+
+            if (r.getStart() - pos >= size)
+                return pos;
+
+            pos = jmax (pos, r.getEnd());
+        }
+
+        return block->size - pos >= size ? pos : -1;
+    }
+
+    static void addSorted (Array<Range<int> >& ranges, const Range<int> r)
+    {
+        int i = 0;
+
+        while (i < ranges.size() && ranges.getReference (i).getStart() < r.getStart())
+            ++i;
+
+        ranges.insert (i, r);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (DelayLineArena)
+};
+
+//==============================================================================
+struct DelayChannelOp  : public AudioGraphRenderingOpBase<DelayChannelOp>
+{
+    DelayChannelOp (const int chan, DelayLine* const delayLine)
+        : channel (chan), line (delayLine)
+    {
+    }
+
+    template <typename FloatType>
+    void render (AudioBuffer<FloatType>& sharedBufferChans, const OwnedArray<MidiBuffer>&, bool* silentChannels, const int numSamples)
+    {
+        if (! line->process (sharedBufferChans.getWritePointer (channel, 0), numSamples, silentChannels [channel]))
+            silentChannels [channel] = false;
+    }
+
+    void getResourceUsage (RenderingResourceUsage& usage) const
+    {
+        usage.writeAudio (channel);
     }
 
 private:
-    HeapBlock<float> buffer;
-    const int channel, bufferSize;
-    int readIndex, writeIndex;
+    const int channel;
+    const DelayLine::Ptr line;
 
     JUCE_DECLARE_NON_COPYABLE (DelayChannelOp)
 };
 
 
 //==============================================================================
-struct ProcessBufferOp   : public AudioGraphRenderingOp
+/** Runs a node's processor on its channels.
+
+    If the node can be skipped when it's idle, this counts how long its audio inputs have
+    been silent and its midi input empty. Once that's longer than its tail, the processor
+    isn't called at all, and its channels are just marked as silent.
+*/
+struct ProcessBufferOp   : public AudioGraphRenderingOpBase<ProcessBufferOp>
 {
     ProcessBufferOp (const AudioProcessorGraph::Node::Ptr& n,
                      const Array<int>& audioChannels,
                      const int totalNumChans,
-                     const int midiBuffer)
+                     const int midiBuffer,
+                     const int64 tailLengthSamples)
         : node (n),
           processor (n->getProcessor()),
           audioChannelsToUse (audioChannels),
           totalChans (jmax (1, totalNumChans)),
-          midiBufferToUse (midiBuffer)
+          numInputChans (jmin (totalChans, processor->getNumInputChannels())),
+          midiBufferToUse (midiBuffer),
+          tailSamples (tailLengthSamples),
+          numIdleSamples (0)
     {
         channels.calloc ((size_t) totalChans);
+        doubleChannels.calloc ((size_t) totalChans);
 
         while (audioChannelsToUse.size() < totalChans)
             audioChannelsToUse.add (0);
     }
 
-    void perform (AudioSampleBuffer& sharedBufferChans, const OwnedArray<MidiBuffer>& sharedMidiBuffers, const int numSamples)
+    template <typename FloatType>
+    void render (AudioBuffer<FloatType>& sharedBufferChans, const OwnedArray<MidiBuffer>& sharedMidiBuffers,
+                 bool* silentChannels, const int numSamples)
+    {
+        MidiBuffer& midi = *sharedMidiBuffers.getUnchecked (midiBufferToUse);
+
+        if (tailSamples >= 0 && areInputsSilent (silentChannels, midi))
+        {
+            if (numIdleSamples >= tailSamples)
+            {
+                for (int i = totalChans; --i >= 0;)
+                    clearSharedChannel (sharedBufferChans, silentChannels, audioChannelsToUse.getUnchecked (i));
+
+                return;
+            }
+
+            numIdleSamples += numSamples;
+        }
+        else
+        {
+            numIdleSamples = 0;
+        }
+
+        FloatType** const chans = getChannelList (sharedBufferChans);
+
+        for (int i = totalChans; --i >= 0;)
+            chans[i] = sharedBufferChans.getWritePointer (audioChannelsToUse.getUnchecked (i), 0);
+
+        AudioBuffer<FloatType> buffer (chans, totalChans, numSamples);
+
+        {
+            JUCE_TRACE_ZONE_FOR_OBJECT ("audio", "AudioProcessor::processBlock", *processor);
+            processor->processBlock (buffer, midi);
+        }
+
+        // if the processor finished by clearing its buffer, its outputs are known to be silent
+        const bool outputIsSilent = buffer.hasBeenCleared();
+
+        for (int i = totalChans; --i >= 0;)
+        {
+            const int chan = audioChannelsToUse.getUnchecked (i);
+
+            if (chan != 0) // (channel 0 is the shared read-only empty one)
+            {
+                if (outputIsSilent)
+                {
+                    sharedBufferChans.clear (chan, numSamples, sharedBufferChans.getNumSamples() - numSamples);
+                    silentChannels [chan] = true;
+                }
+                else
+                {
+                    silentChannels [chan] = false;
+                }
+            }
+        }
+    }
+
+    void getResourceUsage (RenderingResourceUsage& usage) const
     {
         for (int i = totalChans; --i >= 0;)
-            channels[i] = sharedBufferChans.getWritePointer (audioChannelsToUse.getUnchecked (i), 0);
+        {
+            usage.readAudio (audioChannelsToUse.getUnchecked (i));
+            usage.writeAudio (audioChannelsToUse.getUnchecked (i));
+        }
 
-        AudioSampleBuffer buffer (channels, totalChans, numSamples);
+        usage.readMidi (midiBufferToUse);
+        usage.writeMidi (midiBufferToUse);
 
-        processor->processBlock (buffer, *sharedMidiBuffers.getUnchecked (midiBufferToUse));
+        // the i/o processors all read or write the parent graph's own buffers
+        if (dynamic_cast<AudioProcessorGraph::AudioGraphIOProcessor*> (processor) != nullptr)
+            usage.writeGraphIO();
     }
 
     const AudioProcessorGraph::Node::Ptr node;
@@ -209,8 +649,23 @@ struct ProcessBufferOp   : public AudioGraphRenderingOp
 private:
     Array<int> audioChannelsToUse;
     HeapBlock<float*> channels;
-    const int totalChans;
+    HeapBlock<double*> doubleChannels;
+    const int totalChans, numInputChans;
     const int midiBufferToUse;
+    const int64 tailSamples;
+    int64 numIdleSamples;
+
+    float** getChannelList (AudioSampleBuffer&) const noexcept          { return channels; }
+    double** getChannelList (AudioBuffer<double>&) const noexcept       { return doubleChannels; }
+
+    bool areInputsSilent (const bool* silentChannels, const MidiBuffer& midi) const noexcept
+    {
+        for (int i = numInputChans; --i >= 0;)
+            if (! silentChannels [audioChannelsToUse.getUnchecked (i)])
+                return false;
+
+        return midi.isEmpty();
+    }
 
     JUCE_DECLARE_NON_COPYABLE (ProcessBufferOp)
 };
@@ -218,14 +673,23 @@ private:
 //==============================================================================
 /** Used to calculate the correct sequence of rendering ops needed, based on
     the best re-use of shared buffers at each stage.
+
+    Before generating any ops, this works out which connections feed each node, and
+    the last step at which each node output is read. Buffers are then handed out like
+    registers: an output's buffer goes back on the free list as soon as the step that
+    last reads it has been generated, and any scratch buffers a step needs are freed
+    when the step ends. So a rebuild is linear in the number of connections, and the
+    graph never needs more buffers than the most outputs that are live at once.
 */
 struct RenderingOpSequenceCalculator
 {
     RenderingOpSequenceCalculator (AudioProcessorGraph& g,
                                    const Array<AudioProcessorGraph::Node*>& nodes,
-                                   Array<void*>& renderingOps)
+                                   Array<void*>& renderingOps,
+                                   DelayLineArena& delayLineArena)
         : graph (g),
           orderedNodes (nodes),
+          delayLines (delayLineArena),
           totalLatency (0)
     {
         nodeIds.add ((uint32) zeroNodeID); // first buffer is read-only zeros
@@ -233,12 +697,15 @@ struct RenderingOpSequenceCalculator
 
         midiNodeIds.add ((uint32) zeroNodeID);
 
+        analyseConnections();
+
         for (int i = 0; i < orderedNodes.size(); ++i)
         {
             createRenderingOpsForNode (*orderedNodes.getUnchecked(i), renderingOps, i);
             markAnyUnusedBuffersAsFree (i);
         }
 
+        delayLines.finishedBuilding();
         graph.setLatencySamples (totalLatency);
     }
 
@@ -252,44 +719,147 @@ private:
     Array<int> channels;
     Array<uint32> nodeIds, midiNodeIds;
 
-    enum { freeNodeID = 0xffffffff, zeroNodeID = 0xfffffffe };
+    enum { freeNodeID = 0xffffffff, zeroNodeID = 0xfffffffe, scratchNodeID = 0xfffffffd };
+
+    static bool holdsNodeOutput (uint32 nodeID) noexcept    { return nodeID < (uint32) scratchNodeID; }
 
-    static bool isNodeBusy (uint32 nodeID) noexcept     { return nodeID != freeNodeID && nodeID != zeroNodeID; }
+    // Where each node output currently lives, and the buffers that are free for re-use
+    HashMap<int64, int> audioBufferContaining;
+    HashMap<int, int> midiBufferContaining;
+    Array<int> freeBuffers, freeMidiBuffers, scratchBuffers, scratchMidiBuffers;
 
-    Array<uint32> nodeDelayIDs;
-    Array<int> nodeDelays;
+    // The connections into each node, grouped by the node's step in orderedNodes
+    Array<const AudioProcessorGraph::Connection*> inputConnections;
+    Array<int> firstInputConnection;
+
+    // For each node output that's read by something, the last step that reads it
+    struct LastUse
+    {
+        int step, inputChannel;
+        bool isReadBySeveralInputs;
+    };
+
+    Array<LastUse> lastUses;
+    HashMap<int64, int> lastUseIndex;
+
+    DelayLineArena& delayLines;
+    HashMap<int, int> nodeDelays;
     int totalLatency;
 
-    int getNodeDelay (const uint32 nodeID) const        { return nodeDelays [nodeDelayIDs.indexOf (nodeID)]; }
+    static int64 getOutputKey (const uint32 nodeID, const int outputChannel) noexcept
+    {
+        // (the node ID goes in the low word, because that's what HashMap hashes)
+        return (((int64) outputChannel) << 32) | (int64) nodeID;
+    }
+
+    int getNodeDelay (const uint32 nodeID) const        { return nodeDelays [(int) nodeID]; }
+    void setNodeDelay (const uint32 nodeID, const int latency)  { nodeDelays.set ((int) nodeID, latency); }
 
-    void setNodeDelay (const uint32 nodeID, const int latency)
+    void addDelayOp (Array<void*>& renderingOps, const int bufIndex,
+                     const uint32 sourceNodeId, const int sourceChannel,
+                     const uint32 destNodeId, const int destChannel, const int delaySamples)
     {
-        const int index = nodeDelayIDs.indexOf (nodeID);
+        renderingOps.add (new DelayChannelOp (bufIndex, delayLines.getLine (sourceNodeId, sourceChannel,
+                                                                            destNodeId, destChannel,
+                                                                            delaySamples)));
+    }
 
-        if (index >= 0)
+    int getInputLatencyForNode (const int step) const
+    {
+        int maxLatency = 0;
+
+        for (int i = firstInputConnection.getUnchecked (step); i < firstInputConnection.getUnchecked (step + 1); ++i)
+            maxLatency = jmax (maxLatency, getNodeDelay (inputConnections.getUnchecked(i)->sourceNodeId));
+
+        return maxLatency;
+    }
+
+    void getSourcesForInput (const int step, const int inputChan,
+                             Array<uint32>& sourceNodes, Array<int>& sourceOutputChans) const
+    {
+        for (int i = firstInputConnection.getUnchecked (step + 1); --i >= firstInputConnection.getUnchecked (step);)
         {
-            nodeDelays.set (index, latency);
+            const AudioProcessorGraph::Connection* const c = inputConnections.getUnchecked(i);
+
+            if (c->destChannelIndex == inputChan)
+            {
+                sourceNodes.add (c->sourceNodeId);
+                sourceOutputChans.add (c->sourceChannelIndex);
+            }
         }
-        else
+    }
+
+    //==============================================================================
+    void analyseConnections()
+    {
+        const int numSteps = orderedNodes.size();
+        const int numConnections = graph.getNumConnections();
+
+        HashMap<int, int> stepForNode;
+
+        for (int i = 0; i < numSteps; ++i)
+            stepForNode.set ((int) orderedNodes.getUnchecked(i)->nodeId, i);
+
+        Array<int> destSteps;
+        destSteps.ensureStorageAllocated (numConnections);
+        firstInputConnection.insertMultiple (0, 0, numSteps + 1);
+
+        for (int i = 0; i < numConnections; ++i)
         {
-            nodeDelayIDs.add (nodeID);
-            nodeDelays.add (latency);
+            const AudioProcessorGraph::Connection& c = *graph.getConnection (i);
+            int step = -1;
+
+            if (stepForNode.contains ((int) c.destNodeId))
+            {
+                step = stepForNode [(int) c.destNodeId];
+                ++firstInputConnection.getReference (step + 1);
+                addUseOfOutput (c, step);
+            }
+
+            destSteps.add (step);
         }
+
+        for (int i = 0; i < numSteps; ++i)
+            firstInputConnection.getReference (i + 1) += firstInputConnection.getUnchecked (i);
+
+        Array<int> nextSlot (firstInputConnection);
+        inputConnections.insertMultiple (0, nullptr, firstInputConnection.getLast());
+
+        for (int i = 0; i < numConnections; ++i)
+            if (destSteps.getUnchecked(i) >= 0)
+                inputConnections.set (nextSlot.getReference (destSteps.getUnchecked(i))++,
+                                      graph.getConnection (i));
     }
 
-    int getInputLatencyForNode (const uint32 nodeID) const
+    void addUseOfOutput (const AudioProcessorGraph::Connection& c, const int step)
     {
-        int maxLatency = 0;
+        if (c.destChannelIndex != AudioProcessorGraph::midiChannelIndex
+             && c.destChannelIndex >= orderedNodes.getUnchecked (step)->getProcessor()->getNumInputChannels())
+            return;
 
-        for (int i = graph.getNumConnections(); --i >= 0;)
+        const int64 key = getOutputKey (c.sourceNodeId, c.sourceChannelIndex);
+
+        if (lastUseIndex.contains (key))
         {
-            const AudioProcessorGraph::Connection* const c = graph.getConnection (i);
+            LastUse& use = lastUses.getReference (lastUseIndex [key]);
 
-            if (c->destNodeId == nodeID)
-                maxLatency = jmax (maxLatency, getNodeDelay (c->sourceNodeId));
+            if (step > use.step)
+            {
+                use.step = step;
+                use.inputChannel = c.destChannelIndex;
+                use.isReadBySeveralInputs = false;
+            }
+            else if (step == use.step && c.destChannelIndex != use.inputChannel)
+            {
+                use.isReadBySeveralInputs = true;
+            }
+        }
+        else
+        {
+            const LastUse use = { step, c.destChannelIndex, false };
+            lastUseIndex.set (key, lastUses.size());
+            lastUses.add (use);
         }
-
-        return maxLatency;
     }
 
     //==============================================================================
@@ -305,7 +875,7 @@ private:
         Array<int> audioChannelsToUse;
         int midiBufferToUse = -1;
 
-        int maxLatency = getInputLatencyForNode (node.nodeId);
+        int maxLatency = getInputLatencyForNode (ourRenderingIndex);
 
         for (int inputChan = 0; inputChan < numIns; ++inputChan)
         {
@@ -313,16 +883,7 @@ private:
             Array<uint32> sourceNodes;
             Array<int> sourceOutputChans;
 
-            for (int i = graph.getNumConnections(); --i >= 0;)
-            {
-                const AudioProcessorGraph::Connection* const c = graph.getConnection (i);
-
-                if (c->destNodeId == node.nodeId && c->destChannelIndex == inputChan)
-                {
-                    sourceNodes.add (c->sourceNodeId);
-                    sourceOutputChans.add (c->sourceChannelIndex);
-                }
-            }
+            getSourcesForInput (ourRenderingIndex, inputChan, sourceNodes, sourceOutputChans);
 
             int bufIndex = -1;
 
@@ -354,12 +915,18 @@ private:
                     // if not found, this is probably a feedback loop
                     bufIndex = getReadOnlyEmptyBuffer();
                     jassert (bufIndex >= 0);
-                }
 
-                if (inputChan < numOuts
-                     && isBufferNeededLater (ourRenderingIndex,
-                                             inputChan,
-                                             srcNode, srcChan))
+                    if (inputChan < numOuts)
+                    {
+                        // ..but the processor will write into this channel, so it can't be the shared empty one
+                        bufIndex = getFreeBuffer (false);
+                        renderingOps.add (new ClearChannelOp (bufIndex));
+                    }
+                }
+                else if (inputChan < numOuts
+                          && isBufferNeededLater (ourRenderingIndex,
+                                                  inputChan,
+                                                  srcNode, srcChan))
                 {
                     // can't mess up this channel because it's needed later by another node, so we
                     // need to use a copy of it..
@@ -373,7 +940,7 @@ private:
                 const int nodeDelay = getNodeDelay (srcNode);
 
                 if (nodeDelay < maxLatency)
-                    renderingOps.add (new DelayChannelOp (bufIndex, maxLatency - nodeDelay));
+                    addDelayOp (renderingOps, bufIndex, srcNode, srcChan, node.nodeId, inputChan, maxLatency - nodeDelay);
             }
             else
             {
@@ -399,7 +966,9 @@ private:
 
                         const int nodeDelay = getNodeDelay (sourceNodes.getUnchecked (i));
                         if (nodeDelay < maxLatency)
-                            renderingOps.add (new DelayChannelOp (sourceBufIndex, maxLatency - nodeDelay));
+                            addDelayOp (renderingOps, sourceBufIndex,
+                                        sourceNodes.getUnchecked (i), sourceOutputChans.getUnchecked (i),
+                                        node.nodeId, inputChan, maxLatency - nodeDelay);
 
                         break;
                     }
@@ -427,7 +996,9 @@ private:
                     const int nodeDelay = getNodeDelay (sourceNodes.getFirst());
 
                     if (nodeDelay < maxLatency)
-                        renderingOps.add (new DelayChannelOp (bufIndex, maxLatency - nodeDelay));
+                        addDelayOp (renderingOps, bufIndex,
+                                    sourceNodes.getFirst(), sourceOutputChans.getFirst(),
+                                    node.nodeId, inputChan, maxLatency - nodeDelay);
                 }
 
                 for (int j = 0; j < sourceNodes.size(); ++j)
@@ -446,13 +1017,17 @@ private:
                                                            sourceNodes.getUnchecked(j),
                                                            sourceOutputChans.getUnchecked(j)))
                                 {
-                                    renderingOps.add (new DelayChannelOp (srcIndex, maxLatency - nodeDelay));
+                                    addDelayOp (renderingOps, srcIndex,
+                                                sourceNodes.getUnchecked (j), sourceOutputChans.getUnchecked (j),
+                                                node.nodeId, inputChan, maxLatency - nodeDelay);
                                 }
                                 else // buffer is reused elsewhere, can't be delayed
                                 {
                                     const int bufferToDelay = getFreeBuffer (false);
                                     renderingOps.add (new CopyChannelOp (srcIndex, bufferToDelay));
-                                    renderingOps.add (new DelayChannelOp (bufferToDelay, maxLatency - nodeDelay));
+                                    addDelayOp (renderingOps, bufferToDelay,
+                                                sourceNodes.getUnchecked (j), sourceOutputChans.getUnchecked (j),
+                                                node.nodeId, inputChan, maxLatency - nodeDelay);
                                     srcIndex = bufferToDelay;
                                 }
                             }
@@ -481,14 +1056,10 @@ private:
 
         // Now the same thing for midi..
         Array<uint32> midiSourceNodes;
+        Array<int> midiSourceChans;
 
-        for (int i = graph.getNumConnections(); --i >= 0;)
-        {
-            const AudioProcessorGraph::Connection* const c = graph.getConnection (i);
-
-            if (c->destNodeId == node.nodeId && c->destChannelIndex == AudioProcessorGraph::midiChannelIndex)
-                midiSourceNodes.add (c->sourceNodeId);
-        }
+        getSourcesForInput (ourRenderingIndex, AudioProcessorGraph::midiChannelIndex,
+                            midiSourceNodes, midiSourceChans);
 
         if (midiSourceNodes.size() == 0)
         {
@@ -585,31 +1156,63 @@ private:
             totalLatency = maxLatency;
 
         renderingOps.add (new ProcessBufferOp (&node, audioChannelsToUse,
-                                               totalChans, midiBufferToUse));
+                                               totalChans, midiBufferToUse,
+                                               getTailLengthSamples (node)));
+    }
+
+    /** Returns the number of silent samples after which the node can stop being processed,
+        or -1 if it must always be processed.
+    */
+    int64 getTailLengthSamples (const AudioProcessorGraph::Node& node) const
+    {
+        AudioProcessor& processor = *node.getProcessor();
+
+        // the i/o processors need to run every time, and a processor that produces midi
+        // might do so without any input
+        if (dynamic_cast<AudioProcessorGraph::AudioGraphIOProcessor*> (&processor) != nullptr
+             || processor.producesMidi())
+            return -1;
+
+        double tailSeconds = node.getTailLengthHint();
+
+        if (tailSeconds < 0)
+        {
+            if (! processor.silenceInProducesSilenceOut())
+                return -1;
+
+            tailSeconds = processor.getTailLengthSeconds();
+        }
+
+        const double tailSamples = jmax (0.0, tailSeconds) * graph.getSampleRate();
+        return tailSamples < 1.0e18 ? (int64) tailSamples : std::numeric_limits<int64>::max();
     }
 
     //==============================================================================
     int getFreeBuffer (const bool forMidi)
     {
-        if (forMidi)
-        {
-            for (int i = 1; i < midiNodeIds.size(); ++i)
-                if (midiNodeIds.getUnchecked(i) == freeNodeID)
-                    return i;
+        Array<uint32>& ids = forMidi ? midiNodeIds : nodeIds;
+        Array<int>& freeList = forMidi ? freeMidiBuffers : freeBuffers;
+        int index;
 
-            midiNodeIds.add ((uint32) freeNodeID);
-            return midiNodeIds.size() - 1;
+        if (freeList.size() > 0)
+        {
+            // take the most recently freed one, as it's the most likely to still be in the cache
+            index = freeList.getLast();
+            freeList.removeLast();
         }
         else
         {
-            for (int i = 1; i < nodeIds.size(); ++i)
-                if (nodeIds.getUnchecked(i) == freeNodeID)
-                    return i;
+            index = ids.size();
+            ids.add ((uint32) freeNodeID);
 
-            nodeIds.add ((uint32) freeNodeID);
-            channels.add (0);
-            return nodeIds.size() - 1;
+            if (! forMidi)
+                channels.add (0);
         }
+
+        // keep it until the end of this step, in case it doesn't get given an output to hold
+        ids.set (index, (uint32) scratchNodeID);
+        (forMidi ? scratchMidiBuffers : scratchBuffers).add (index);
+        return index;
     }
 
     int getReadOnlyEmptyBuffer() const noexcept
@@ -621,16 +1224,15 @@ private:
     {
         if (outputChannel == AudioProcessorGraph::midiChannelIndex)
         {
-            for (int i = midiNodeIds.size(); --i >= 0;)
-                if (midiNodeIds.getUnchecked(i) == nodeId)
-                    return i;
+            if (midiBufferContaining.contains ((int) nodeId))
+                return midiBufferContaining [(int) nodeId];
         }
         else
         {
-            for (int i = nodeIds.size(); --i >= 0;)
-                if (nodeIds.getUnchecked(i) == nodeId
-                     && channels.getUnchecked(i) == outputChannel)
-                    return i;
+            const int64 key = getOutputKey (nodeId, outputChannel);
+
+            if (audioBufferContaining.contains (key))
+                return audioBufferContaining [key];
         }
 
         return -1;
@@ -638,59 +1240,104 @@ private:
 
     void markAnyUnusedBuffersAsFree (const int stepIndex)
     {
-        for (int i = 0; i < nodeIds.size(); ++i)
+        // the inputs that this step was the last to read..
+        for (int i = firstInputConnection.getUnchecked (stepIndex); i < firstInputConnection.getUnchecked (stepIndex + 1); ++i)
         {
-            if (isNodeBusy (nodeIds.getUnchecked(i))
-                 && ! isBufferNeededLater (stepIndex, -1,
-                                           nodeIds.getUnchecked(i),
-                                           channels.getUnchecked(i)))
-            {
-                nodeIds.set (i, (uint32) freeNodeID);
-            }
+            const AudioProcessorGraph::Connection* const c = inputConnections.getUnchecked(i);
+            freeBufferIfNotNeededLater (stepIndex + 1, c->sourceNodeId, c->sourceChannelIndex);
         }
 
-        for (int i = 0; i < midiNodeIds.size(); ++i)
+        // ..any of its outputs that nothing reads..
+        const AudioProcessorGraph::Node& node = *orderedNodes.getUnchecked (stepIndex);
+
+        for (int i = node.getProcessor()->getNumOutputChannels(); --i >= 0;)
+            freeBufferIfNotNeededLater (stepIndex + 1, node.nodeId, i);
+
+        freeBufferIfNotNeededLater (stepIndex + 1, node.nodeId, AudioProcessorGraph::midiChannelIndex);
+
+        // ..and its scratch buffers
+        for (int i = 0; i < scratchBuffers.size(); ++i)
         {
-            if (isNodeBusy (midiNodeIds.getUnchecked(i))
-                 && ! isBufferNeededLater (stepIndex, -1,
-                                           midiNodeIds.getUnchecked(i),
-                                           AudioProcessorGraph::midiChannelIndex))
-            {
-                midiNodeIds.set (i, (uint32) freeNodeID);
-            }
+            const int index = scratchBuffers.getUnchecked(i);
+
+            if (nodeIds.getUnchecked (index) == (uint32) scratchNodeID)
+                freeBuffer (false, index);
         }
+
+        for (int i = 0; i < scratchMidiBuffers.size(); ++i)
+        {
+            const int index = scratchMidiBuffers.getUnchecked(i);
+
+            if (midiNodeIds.getUnchecked (index) == (uint32) scratchNodeID)
+                freeBuffer (true, index);
+        }
+
+        scratchBuffers.clearQuick();
+        scratchMidiBuffers.clearQuick();
     }
 
-    bool isBufferNeededLater (int stepIndexToSearchFrom,
-                              int inputChannelOfIndexToIgnore,
-                              const uint32 nodeId,
-                              const int outputChanIndex) const
+    void freeBufferIfNotNeededLater (const int stepIndex, const uint32 nodeId, const int outputChanIndex)
     {
-        while (stepIndexToSearchFrom < orderedNodes.size())
+        if (! isBufferNeededLater (stepIndex, -1, nodeId, outputChanIndex))
         {
-            const AudioProcessorGraph::Node* const node = (const AudioProcessorGraph::Node*) orderedNodes.getUnchecked (stepIndexToSearchFrom);
+            const int index = getBufferContaining (nodeId, outputChanIndex);
 
-            if (outputChanIndex == AudioProcessorGraph::midiChannelIndex)
-            {
-                if (inputChannelOfIndexToIgnore != AudioProcessorGraph::midiChannelIndex
-                     && graph.getConnectionBetween (nodeId, AudioProcessorGraph::midiChannelIndex,
-                                                    node->nodeId, AudioProcessorGraph::midiChannelIndex) != nullptr)
-                    return true;
-            }
-            else
-            {
-                for (int i = 0; i < node->getProcessor()->getNumInputChannels(); ++i)
-                    if (i != inputChannelOfIndexToIgnore
-                         && graph.getConnectionBetween (nodeId, outputChanIndex,
-                                                        node->nodeId, i) != nullptr)
-                        return true;
-            }
+            if (index > 0)
+                freeBuffer (outputChanIndex == AudioProcessorGraph::midiChannelIndex, index);
+        }
+    }
 
-            inputChannelOfIndexToIgnore = -1;
-            ++stepIndexToSearchFrom;
+    void freeBuffer (const bool isMidi, const int index)
+    {
+        forgetBufferContents (isMidi, index);
+
+        if (isMidi)
+        {
+            midiNodeIds.set (index, (uint32) freeNodeID);
+            freeMidiBuffers.add (index);
+        }
+        else
+        {
+            nodeIds.set (index, (uint32) freeNodeID);
+            freeBuffers.add (index);
         }
+    }
 
-        return false;
+    void forgetBufferContents (const bool isMidi, const int index)
+    {
+        if (isMidi)
+        {
+            const uint32 oldNodeId = midiNodeIds.getUnchecked (index);
+
+            if (holdsNodeOutput (oldNodeId))
+                midiBufferContaining.remove ((int) oldNodeId);
+        }
+        else
+        {
+            const uint32 oldNodeId = nodeIds.getUnchecked (index);
+
+            if (holdsNodeOutput (oldNodeId))
+                audioBufferContaining.remove (getOutputKey (oldNodeId, channels.getUnchecked (index)));
+        }
+    }
+
+    bool isBufferNeededLater (const int stepIndexToSearchFrom,
+                              const int inputChannelOfIndexToIgnore,
+                              const uint32 nodeId,
+                              const int outputChanIndex) const
+    {
+        const int64 key = getOutputKey (nodeId, outputChanIndex);
+
+        if (! lastUseIndex.contains (key))
+            return false;
+
+        const LastUse& use = lastUses.getReference (lastUseIndex [key]);
+
+        if (use.step != stepIndexToSearchFrom)
+            return use.step > stepIndexToSearchFrom;
+
+        // this step is the last one that reads it, so it's only needed if some other input reads it too
+        return use.isReadBySeveralInputs || use.inputChannel != inputChannelOfIndexToIgnore;
     }
 
     void markBufferAsContaining (int bufferNum, uint32 nodeId, int outputIndex)
@@ -699,14 +1346,18 @@ private:
         {
             jassert (bufferNum > 0 && bufferNum < midiNodeIds.size());
 
+            forgetBufferContents (true, bufferNum);
             midiNodeIds.set (bufferNum, nodeId);
+            midiBufferContaining.set ((int) nodeId, bufferNum);
         }
         else
         {
-            jassert (bufferNum >= 0 && bufferNum < nodeIds.size());
+            jassert (bufferNum > 0 && bufferNum < nodeIds.size());
 
+            forgetBufferContents (false, bufferNum);
             nodeIds.set (bufferNum, nodeId);
             channels.set (bufferNum, outputIndex);
+            audioBufferContaining.set (getOutputKey (nodeId, outputIndex), bufferNum);
         }
     }
 
@@ -714,136 +1365,329 @@ private:
 };
 
 //==============================================================================
-// Holds a fast lookup table for checking which nodes are inputs to others.
+// Works out which nodes feed into which others, either directly or via other nodes.
 class ConnectionLookupTable
 {
 public:
-    explicit ConnectionLookupTable (const OwnedArray<AudioProcessorGraph::Connection>& connections)
+    ConnectionLookupTable (const ReferenceCountedArray<AudioProcessorGraph::Node>& nodes,
+                           const OwnedArray<AudioProcessorGraph::Connection>& connections)
     {
+        const int numNodes = nodes.size();
+        HashMap<int, int> nodeIndexes;
+
+        for (int i = 0; i < numNodes; ++i)
+            nodeIndexes.set ((int) nodes.getUnchecked(i)->nodeId, i);
+
+        Array<Array<int> > sources;
+        sources.insertMultiple (0, Array<int>(), numNodes);
+
         for (int i = 0; i < connections.size(); ++i)
         {
             const AudioProcessorGraph::Connection* const c = connections.getUnchecked(i);
 
-            int index;
-            Entry* entry = findEntry (c->destNodeId, index);
+            if (nodeIndexes.contains ((int) c->sourceNodeId) && nodeIndexes.contains ((int) c->destNodeId))
+                sources.getReference (nodeIndexes [(int) c->destNodeId])
+                    .addIfNotAlreadyThere (nodeIndexes [(int) c->sourceNodeId]);
+        }
+
+        // Each node gets a bitmap of all the nodes that it can be reached from. (This
+        // visits every node at most once per destination, so copes with feedback loops)
+        inputsToNode.insertMultiple (0, BigInteger(), numNodes);
+        Array<int> nodesToVisit;
+
+        for (int i = 0; i < numNodes; ++i)
+        {
+            BigInteger& inputs = inputsToNode.getReference (i);
+            nodesToVisit = sources.getReference (i);
 
-            if (entry == nullptr)
+            while (nodesToVisit.size() > 0)
             {
-                entry = new Entry (c->destNodeId);
-                entries.insert (index, entry);
-            }
+                const int n = nodesToVisit.getLast();
+                nodesToVisit.removeLast();
 
-            entry->srcNodes.add (c->sourceNodeId);
+                if (! inputs[n])
+                {
+                    inputs.setBit (n);
+                    nodesToVisit.addArray (sources.getReference (n));
+                }
+            }
         }
     }
 
-    bool isAnInputTo (const uint32 possibleInputId,
-                      const uint32 possibleDestinationId) const noexcept
+    // (these take indexes into the array of nodes that the table was built from)
+    bool isAnInputTo (const int possibleInputIndex, const int possibleDestinationIndex) const noexcept
     {
-        return isAnInputToRecursive (possibleInputId, possibleDestinationId, entries.size());
+        return inputsToNode.getReference (possibleDestinationIndex) [possibleInputIndex];
     }
 
 private:
-    //==============================================================================
-    struct Entry
+    Array<BigInteger> inputsToNode;
+
+    JUCE_DECLARE_NON_COPYABLE (ConnectionLookupTable)
+};
+
+//==============================================================================
+struct ConnectionSorter
+{
+    static int compareElements (const AudioProcessorGraph::Connection* const first,
+                                const AudioProcessorGraph::Connection* const second) noexcept
     {
-        explicit Entry (const uint32 destNodeId_) noexcept : destNodeId (destNodeId_) {}
+        if (first->sourceNodeId < second->sourceNodeId)                return -1;
+        if (first->sourceNodeId > second->sourceNodeId)                return 1;
+        if (first->destNodeId < second->destNodeId)                    return -1;
+        if (first->destNodeId > second->destNodeId)                    return 1;
+        if (first->sourceChannelIndex < second->sourceChannelIndex)    return -1;
+        if (first->sourceChannelIndex > second->sourceChannelIndex)    return 1;
+        if (first->destChannelIndex < second->destChannelIndex)        return -1;
+        if (first->destChannelIndex > second->destChannelIndex)        return 1;
 
-        const uint32 destNodeId;
-        SortedSet<uint32> srcNodes;
+        return 0;
+    }
+};
 
-        JUCE_DECLARE_NON_COPYABLE (Entry)
-    };
+//==============================================================================
+/** Re-orders a sequence of rendering ops into levels, where none of the ops within a
+    level touch any of the same buffers, so can be run concurrently.
+
+    Each op is placed after any earlier ops that write to something it uses, or that read
+    something it writes to, so performing the re-ordered list serially gives exactly the
+    same results as the original order did.
 
-    OwnedArray<Entry> entries;
+    For each op, this also fills in the number of ops (i.e. those in the earlier levels)
+    which must have finished before it can be started.
+*/
+static void arrangeRenderingOpsIntoLevels (Array<void*>& ops, Array<int>& numOpsToWaitFor,
+                                           const int numAudioBuffers, const int numMidiBuffers)
+{
+    RenderingResourceUsage usage (numAudioBuffers, numMidiBuffers);
 
-    bool isAnInputToRecursive (const uint32 possibleInputId,
-                               const uint32 possibleDestinationId,
-                               int recursionCheck) const noexcept
+    Array<int> lastWriteLevel, lastReadLevel, opLevels;
+    lastWriteLevel.insertMultiple (0, -1, usage.getNumResources());
+    lastReadLevel.insertMultiple (0, -1, usage.getNumResources());
+    int numLevels = 0;
+
+    for (int i = 0; i < ops.size(); ++i)
     {
-        int index;
+        usage.clear();
+        static_cast<const AudioGraphRenderingOp*> (ops.getUnchecked (i))->getResourceUsage (usage);
+
+        int level = 0;
 
-        if (const Entry* const entry = findEntry (possibleDestinationId, index))
+        for (int j = usage.reads.size(); --j >= 0;)
+            level = jmax (level, lastWriteLevel.getUnchecked (usage.reads.getUnchecked (j)) + 1);
+
+        for (int j = usage.writes.size(); --j >= 0;)
         {
-            const SortedSet<uint32>& srcNodes = entry->srcNodes;
+            const int resource = usage.writes.getUnchecked (j);
+            level = jmax (level, lastWriteLevel.getUnchecked (resource) + 1, lastReadLevel.getUnchecked (resource) + 1);
+        }
 
-            if (srcNodes.contains (possibleInputId))
-                return true;
+        for (int j = usage.reads.size(); --j >= 0;)
+        {
+            const int resource = usage.reads.getUnchecked (j);
+            lastReadLevel.set (resource, jmax (level, lastReadLevel.getUnchecked (resource)));
+        }
+
+        for (int j = usage.writes.size(); --j >= 0;)
+            lastWriteLevel.set (usage.writes.getUnchecked (j), level);
 
-            if (--recursionCheck >= 0)
+        opLevels.add (level);
+        numLevels = jmax (numLevels, level + 1);
+    }
+
+    Array<void*> sortedOps;
+    numOpsToWaitFor.clearQuick();
+
+    for (int level = 0; level < numLevels; ++level)
+    {
+        const int numOpsInEarlierLevels = sortedOps.size();
+
+        for (int i = 0; i < ops.size(); ++i)
+        {
+            if (opLevels.getUnchecked (i) == level)
             {
-                for (int i = 0; i < srcNodes.size(); ++i)
-                    if (isAnInputToRecursive (possibleInputId, srcNodes.getUnchecked(i), recursionCheck))
-                        return true;
+                sortedOps.add (ops.getUnchecked (i));
+                numOpsToWaitFor.add (numOpsInEarlierLevels);
             }
         }
+    }
 
-        return false;
+    ops.swapWith (sortedOps);
+}
+
+}
+
+//==============================================================================
+/** A set of realtime threads which help the audio callback thread to get through the
+    graph's rendering ops, when multi-threaded rendering is enabled.
+*/
+class AudioProcessorGraph::RenderingThreadPool  : private RealtimeThreadGroup::Job
+{
+public:
+    RenderingThreadPool (const int numWorkerThreads, const Array<uint32>& affinityMasks,
+                         const double sampleRate, const int blockSize)
+        : threads ("Audio graph rendering", numWorkerThreads, getWorkerAffinityMasks (numWorkerThreads, affinityMasks)),
+          ops (nullptr), opsToWaitFor (nullptr),
+          sharedBuffers (nullptr), sharedDoubleBuffers (nullptr),
+          sharedMidiBuffers (nullptr), sharedSilentChannels (nullptr),
+          numSamples (0)
+    {
+        setCallbackPeriod (sampleRate, blockSize);
     }
 
-    Entry* findEntry (const uint32 destNodeId, int& insertIndex) const noexcept
+    int getNumThreads() const noexcept      { return threads.getNumWorkers() + 1; }
+
+    /** The workers pass this on to Thread::setCurrentThreadRealtime() the next time they wake up. */
+    void setCallbackPeriod (const double sampleRate, const int blockSize) noexcept
     {
-        Entry* result = nullptr;
+        if (sampleRate > 0 && blockSize > 0)
+            threads.setCallbackPeriod (blockSize * 1000.0 / sampleRate);
+    }
 
-        int start = 0;
-        int end = entries.size();
+    void perform (const Array<void*>& renderingOps, const Array<int>& numOpsToWaitFor,
+                  AudioSampleBuffer& buffers, const OwnedArray<MidiBuffer>& midiBuffers,
+                  bool* silentChannels, const int numSamplesToProcess) noexcept
+    {
+        sharedBuffers = &buffers;
+        sharedDoubleBuffers = nullptr;
+        performOps (renderingOps, numOpsToWaitFor, midiBuffers, silentChannels, numSamplesToProcess);
+    }
 
-        for (;;)
-        {
-            if (start >= end)
-            {
-                break;
-            }
-            else if (destNodeId == entries.getUnchecked (start)->destNodeId)
-            {
-                result = entries.getUnchecked (start);
-                break;
-            }
-            else
-            {
-                const int halfway = (start + end) / 2;
+    void perform (const Array<void*>& renderingOps, const Array<int>& numOpsToWaitFor,
+                  AudioBuffer<double>& buffers, const OwnedArray<MidiBuffer>& midiBuffers,
+                  bool* silentChannels, const int numSamplesToProcess) noexcept
+    {
+        sharedBuffers = nullptr;
+        sharedDoubleBuffers = &buffers;
+        performOps (renderingOps, numOpsToWaitFor, midiBuffers, silentChannels, numSamplesToProcess);
+    }
+
+private:
+    //==============================================================================
+    RealtimeThreadGroup threads;
+
+    void* const* ops;
+    const int* opsToWaitFor;
+    AudioSampleBuffer* sharedBuffers;
+    AudioBuffer<double>* sharedDoubleBuffers;
+    const OwnedArray<MidiBuffer>* sharedMidiBuffers;
+    bool* sharedSilentChannels;
+    int numSamples;
+
+    // Workers without a mask of their own are kept off any efficiency cores, which
+    // could make the whole callback wait for them.
+    static Array<uint32> getWorkerAffinityMasks (const int numWorkerThreads, const Array<uint32>& affinityMasks)
+    {
+        const uint32 performanceCpus = SystemStats::getNumPerformanceCores() < SystemStats::getNumPhysicalCpus()
+                                         ? SystemStats::getPerformanceCpuAffinityMask() : 0;
+        Array<uint32> masks;
+
+        for (int i = 0; i < numWorkerThreads; ++i)
+            masks.add (affinityMasks[i] != 0 ? affinityMasks[i] : performanceCpus);
+
+        return masks;
+    }
+
+    void performOps (const Array<void*>& renderingOps, const Array<int>& numOpsToWaitFor,
+                     const OwnedArray<MidiBuffer>& midiBuffers,
+                     bool* silentChannels, const int numSamplesToProcess) noexcept
+    {
+        jassert (renderingOps.size() == numOpsToWaitFor.size());
 
-                if (halfway == start)
-                {
-                    if (destNodeId >= entries.getUnchecked (halfway)->destNodeId)
-                        ++start;
+        ops = renderingOps.begin();
+        opsToWaitFor = numOpsToWaitFor.begin();
+        sharedMidiBuffers = &midiBuffers;
+        sharedSilentChannels = silentChannels;
+        numSamples = numSamplesToProcess;
 
-                    break;
-                }
-                else if (destNodeId >= entries.getUnchecked (halfway)->destNodeId)
-                    start = halfway;
-                else
-                    end = halfway;
-            }
-        }
+        threads.perform (*this, renderingOps.size());
+    }
 
-        insertIndex = start;
-        return result;
+    void performItem (const int index, int) override
+    {
+        // (the ops are arranged in levels, and each one waits for all the ops in the earlier levels)
+        threads.waitForItemsToFinish (opsToWaitFor[index]);
+
+        GraphRenderingOps::AudioGraphRenderingOp* const op
+            = static_cast<GraphRenderingOps::AudioGraphRenderingOp*> (ops[index]);
+
+        if (sharedDoubleBuffers != nullptr)
+            op->perform (*sharedDoubleBuffers, *sharedMidiBuffers, sharedSilentChannels, numSamples);
+        else
+            op->perform (*sharedBuffers, *sharedMidiBuffers, sharedSilentChannels, numSamples);
     }
 
-    JUCE_DECLARE_NON_COPYABLE (ConnectionLookupTable)
+    JUCE_DECLARE_NON_COPYABLE (RenderingThreadPool)
 };
 
 //==============================================================================
-struct ConnectionSorter
+/** A complete set of rendering ops, together with the shared buffers that they use.
+
+    Once one of these has been built and handed over to the audio thread, its layout
+    is never modified, so the audio thread can pick up a new one without any locking.
+*/
+struct AudioProcessorGraph::RenderingSequence
 {
-    static int compareElements (const AudioProcessorGraph::Connection* const first,
-                                const AudioProcessorGraph::Connection* const second) noexcept
+    RenderingSequence (Array<void*>& renderingOps, Array<int>& opDependencies,
+                       const int numBuffersNeeded, const int numMidiBuffersNeeded, const int blockSize,
+                       const bool useDoublePrecision)
+        : buffers (useDoublePrecision ? 0 : numBuffersNeeded, blockSize),
+          doubleBuffers (useDoublePrecision ? numBuffersNeeded : 0, blockSize),
+          silentChannels ((size_t) numBuffersNeeded),
+          isDoublePrecision (useDoublePrecision)
     {
-        if (first->sourceNodeId < second->sourceNodeId)                return -1;
-        if (first->sourceNodeId > second->sourceNodeId)                return 1;
-        if (first->destNodeId < second->destNodeId)                    return -1;
-        if (first->destNodeId > second->destNodeId)                    return 1;
-        if (first->sourceChannelIndex < second->sourceChannelIndex)    return -1;
-        if (first->sourceChannelIndex > second->sourceChannelIndex)    return 1;
-        if (first->destChannelIndex < second->destChannelIndex)        return -1;
-        if (first->destChannelIndex > second->destChannelIndex)        return 1;
+        ops.swapWith (renderingOps);
+        numOpsToWaitFor.swapWith (opDependencies);
+        buffers.clear();
+        doubleBuffers.clear();
 
-        return 0;
+        for (int i = 0; i < numBuffersNeeded; ++i)
+            silentChannels[i] = true;
+
+        for (int i = 0; i < numMidiBuffersNeeded; ++i)
+            midiBuffers.add (new MidiBuffer());
     }
-};
 
-}
+    ~RenderingSequence()
+    {
+        for (int i = ops.size(); --i >= 0;)
+            delete static_cast<GraphRenderingOps::AudioGraphRenderingOp*> (ops.getUnchecked(i));
+    }
+
+    /** Renders the ops with whichever set of buffers matches the sequence's precision. */
+    void perform (RenderingThreadPool* const threadPool, const int numSamples)
+    {
+        if (isDoublePrecision)
+            perform (threadPool, doubleBuffers, numSamples);
+        else
+            perform (threadPool, buffers, numSamples);
+    }
+
+    template <typename FloatType>
+    void perform (RenderingThreadPool* const threadPool, AudioBuffer<FloatType>& sharedBuffers, const int numSamples)
+    {
+        if (threadPool != nullptr)
+        {
+            threadPool->perform (ops, numOpsToWaitFor, sharedBuffers, midiBuffers, silentChannels, numSamples);
+        }
+        else
+        {
+            for (int i = 0; i < ops.size(); ++i)
+                static_cast<GraphRenderingOps::AudioGraphRenderingOp*> (ops.getUnchecked(i))
+                    ->perform (sharedBuffers, midiBuffers, silentChannels, numSamples);
+        }
+    }
+
+    Array<void*> ops;
+    Array<int> numOpsToWaitFor;
+    AudioSampleBuffer buffers;
+    AudioBuffer<double> doubleBuffers;
+    OwnedArray<MidiBuffer> midiBuffers;
+    HeapBlock<bool> silentChannels;
+    const bool isDoublePrecision;
+
+    JUCE_DECLARE_NON_COPYABLE (RenderingSequence)
+};
 
 //==============================================================================
 AudioProcessorGraph::Connection::Connection (const uint32 sourceID, const int sourceChannel,
@@ -855,18 +1699,22 @@ AudioProcessorGraph::Connection::Connection (const uint32 sourceID, const int so
 
 //==============================================================================
 AudioProcessorGraph::Node::Node (const uint32 nodeID, AudioProcessor* const p) noexcept
-    : nodeId (nodeID), processor (p), isPrepared (false)
+    : nodeId (nodeID), processor (p), isPrepared (false), latencyAtLastBuild (0), tailLengthHint (-1.0)
 {
     jassert (processor != nullptr);
 }
 
 void AudioProcessorGraph::Node::prepare (const double sampleRate, const int blockSize,
-                                         AudioProcessorGraph* const graph)
+                                         AudioProcessorGraph* const graph, const ProcessingPrecision precision)
 {
+    if (isPrepared && processor->getProcessingPrecision() != precision)
+        unprepare();
+
     if (! isPrepared)
     {
         isPrepared = true;
         setParentGraph (graph);
+        processor->setProcessingPrecision (precision);
 
         processor->setPlayConfigDetails (processor->getNumInputChannels(),
                                          processor->getNumOutputChannels(),
@@ -892,11 +1740,21 @@ void AudioProcessorGraph::Node::setParentGraph (AudioProcessorGraph* const graph
         ioProc->setParentGraph (graph);
 }
 
+//==============================================================================
+struct AudioProcessorGraph::DelayLines  : public GraphRenderingOps::DelayLineArena
+{
+};
+
 //==============================================================================
 AudioProcessorGraph::AudioProcessorGraph()
     : lastNodeId (0),
+      batchEditDepth (0),
+      numRenderingThreads (1),
+      delayLines (new DelayLines()),
       currentAudioInputBuffer (nullptr),
-      currentMidiInputBuffer (nullptr)
+      currentDoubleAudioInputBuffer (nullptr),
+      currentMidiInputBuffer (nullptr),
+      isRenderingDoublePrecision (false)
 {
 }
 
@@ -904,6 +1762,7 @@ AudioProcessorGraph::~AudioProcessorGraph()
 {
     clearRenderingSequence();
     clear();
+    renderingThreadPool = nullptr;
 }
 
 const String AudioProcessorGraph::getName() const
@@ -914,18 +1773,18 @@ const String AudioProcessorGraph::getName() const
 //==============================================================================
 void AudioProcessorGraph::clear()
 {
+    for (int i = nodes.size(); --i >= 0;)
+        nodes.getUnchecked(i)->getProcessor()->removeListener (this);
+
     nodes.clear();
+    nodesById.clear();
     connections.clear();
-    triggerAsyncUpdate();
+    graphChanged();
 }
 
 AudioProcessorGraph::Node* AudioProcessorGraph::getNodeForId (const uint32 nodeId) const
 {
-    for (int i = nodes.size(); --i >= 0;)
-        if (nodes.getUnchecked(i)->nodeId == nodeId)
-            return nodes.getUnchecked(i);
-
-    return nullptr;
+    return nodesById [(int) nodeId];
 }
 
 AudioProcessorGraph::Node* AudioProcessorGraph::addNode (AudioProcessor* const newProcessor, uint32 nodeId)
@@ -960,10 +1819,12 @@ AudioProcessorGraph::Node* AudioProcessorGraph::addNode (AudioProcessor* const n
     }
 
     newProcessor->setPlayHead (getPlayHead());
+    newProcessor->addListener (this);
 
     Node* const n = new Node (nodeId, newProcessor);
     nodes.add (n);
-    triggerAsyncUpdate();
+    nodesById.set ((int) nodeId, n);
+    graphChanged();
 
     n->setParentGraph (this);
     return n;
@@ -973,16 +1834,15 @@ bool AudioProcessorGraph::removeNode (const uint32 nodeId)
 {
     disconnectNode (nodeId);
 
-    for (int i = nodes.size(); --i >= 0;)
+    if (Node* const n = getNodeForId (nodeId))
     {
-        if (nodes.getUnchecked(i)->nodeId == nodeId)
-        {
-            nodes.getUnchecked(i)->setParentGraph (nullptr);
-            nodes.remove (i);
-            triggerAsyncUpdate();
+        n->getProcessor()->removeListener (this);
+        n->setParentGraph (nullptr);
+        nodesById.remove ((int) nodeId);
+        nodes.removeObject (n);
+        graphChanged();
 
-            return true;
-        }
+        return true;
     }
 
     return false;
@@ -994,24 +1854,30 @@ const AudioProcessorGraph::Connection* AudioProcessorGraph::getConnectionBetween
                                                                                   const uint32 destNodeId,
                                                                                   const int destChannelIndex) const
 {
-    const Connection c (sourceNodeId, sourceChannelIndex, destNodeId, destChannelIndex);
-    GraphRenderingOps::ConnectionSorter sorter;
-    return connections [connections.indexOfSorted (sorter, &c)];
+    // (every connection is also listed by the nodes at each end of it)
+    if (const Node* const source = getNodeForId (sourceNodeId))
+    {
+        for (int i = source->outputConnections.size(); --i >= 0;)
+        {
+            const Connection* const c = source->outputConnections.getUnchecked(i);
+
+            if (c->destNodeId == destNodeId
+                 && c->sourceChannelIndex == sourceChannelIndex
+                 && c->destChannelIndex == destChannelIndex)
+                return c;
+        }
+    }
+
+    return nullptr;
 }
 
 bool AudioProcessorGraph::isConnected (const uint32 possibleSourceNodeId,
                                        const uint32 possibleDestNodeId) const
 {
-    for (int i = connections.size(); --i >= 0;)
-    {
-        const Connection* const c = connections.getUnchecked(i);
-
-        if (c->sourceNodeId == possibleSourceNodeId
-             && c->destNodeId == possibleDestNodeId)
-        {
-            return true;
-        }
-    }
+    if (const Node* const source = getNodeForId (possibleSourceNodeId))
+        for (int i = source->outputConnections.size(); --i >= 0;)
+            if (source->outputConnections.getUnchecked(i)->destNodeId == possibleDestNodeId)
+                return true;
 
     return false;
 }
@@ -1053,57 +1919,77 @@ bool AudioProcessorGraph::addConnection (const uint32 sourceNodeId,
     if (! canConnect (sourceNodeId, sourceChannelIndex, destNodeId, destChannelIndex))
         return false;
 
+    Connection* const c = new Connection (sourceNodeId, sourceChannelIndex, destNodeId, destChannelIndex);
+
     GraphRenderingOps::ConnectionSorter sorter;
-    connections.addSorted (sorter, new Connection (sourceNodeId, sourceChannelIndex,
-                                                   destNodeId, destChannelIndex));
-    triggerAsyncUpdate();
+    connections.addSorted (sorter, c);
+
+    getNodeForId (sourceNodeId)->outputConnections.add (c);
+    getNodeForId (destNodeId)->inputConnections.add (c);
+
+    graphChanged();
     return true;
 }
 
 void AudioProcessorGraph::removeConnection (const int index)
 {
-    connections.remove (index);
-    triggerAsyncUpdate();
+    if (const Connection* const c = connections [index])
+    {
+        if (Node* const source = getNodeForId (c->sourceNodeId))
+            source->outputConnections.removeFirstMatchingValue (c);
+
+        if (Node* const dest = getNodeForId (c->destNodeId))
+            dest->inputConnections.removeFirstMatchingValue (c);
+
+        connections.remove (index);
+        graphChanged();
+    }
 }
 
 bool AudioProcessorGraph::removeConnection (const uint32 sourceNodeId, const int sourceChannelIndex,
                                             const uint32 destNodeId, const int destChannelIndex)
 {
-    bool doneAnything = false;
-
-    for (int i = connections.size(); --i >= 0;)
+    if (const Connection* const c = getConnectionBetween (sourceNodeId, sourceChannelIndex,
+                                                          destNodeId, destChannelIndex))
     {
-        const Connection* const c = connections.getUnchecked(i);
-
-        if (c->sourceNodeId == sourceNodeId
-             && c->destNodeId == destNodeId
-             && c->sourceChannelIndex == sourceChannelIndex
-             && c->destChannelIndex == destChannelIndex)
-        {
-            removeConnection (i);
-            doneAnything = true;
-        }
+        GraphRenderingOps::ConnectionSorter sorter;
+        removeConnection (connections.indexOfSorted (sorter, c));
+        return true;
     }
 
-    return doneAnything;
+    return false;
 }
 
 bool AudioProcessorGraph::disconnectNode (const uint32 nodeId)
 {
-    bool doneAnything = false;
+    const Node* const node = getNodeForId (nodeId);
 
-    for (int i = connections.size(); --i >= 0;)
-    {
-        const Connection* const c = connections.getUnchecked(i);
+    if (node == nullptr)
+        return false;
 
-        if (c->sourceNodeId == nodeId || c->destNodeId == nodeId)
-        {
-            removeConnection (i);
-            doneAnything = true;
-        }
-    }
+    Array<const Connection*> nodeConnections (node->inputConnections);
+    nodeConnections.addArray (node->outputConnections);
 
-    return doneAnything;
+    GraphRenderingOps::ConnectionSorter sorter;
+
+    for (int i = nodeConnections.size(); --i >= 0;)
+        removeConnection (connections.indexOfSorted (sorter, nodeConnections.getUnchecked (i)));
+
+    return nodeConnections.size() > 0;
+}
+
+//==============================================================================
+AudioProcessorGraph::ScopedBatchEdit::ScopedBatchEdit (AudioProcessorGraph& g) noexcept  : graph (g)
+{
+    ++graph.batchEditDepth;
+}
+
+AudioProcessorGraph::ScopedBatchEdit::~ScopedBatchEdit()
+{
+    jassert (graph.batchEditDepth > 0);
+
+    if (--graph.batchEditDepth == 0)
+        graph.triggerAsyncUpdate();
 }
 
 bool AudioProcessorGraph::isConnectionLegal (const Connection* const c) const
@@ -1138,109 +2024,235 @@ bool AudioProcessorGraph::removeIllegalConnections()
 }
 
 //==============================================================================
-static void deleteRenderOpArray (Array<void*>& ops)
-{
-    for (int i = ops.size(); --i >= 0;)
-        delete static_cast<GraphRenderingOps::AudioGraphRenderingOp*> (ops.getUnchecked(i));
-}
-
-void AudioProcessorGraph::clearRenderingSequence()
+void AudioProcessorGraph::setRenderingSequence (RenderingSequence* const newSequence)
 {
-    Array<void*> oldOps;
+    RenderingSequence* const oldSequence = currentRenderingSequence.exchange (newSequence);
 
+    if (oldSequence != nullptr)
     {
-        const ScopedLock sl (getCallbackLock());
-        renderingOps.swapWith (oldOps);
-    }
+        // The audio thread may still be half-way through rendering the old sequence, so
+        // wait for it to finish before deleting it.
+        while (renderingSequenceInUse.get() == oldSequence)
+            Thread::yield();
 
-    deleteRenderOpArray (oldOps);
+        delete oldSequence;
+    }
 }
 
-bool AudioProcessorGraph::isAnInputTo (const uint32 possibleInputId,
-                                       const uint32 possibleDestinationId,
-                                       const int recursionCheck) const
+AudioProcessorGraph::RenderingSequence* AudioProcessorGraph::acquireRenderingSequence() noexcept
 {
-    if (recursionCheck > 0)
+    for (;;)
     {
-        for (int i = connections.size(); --i >= 0;)
-        {
-            const AudioProcessorGraph::Connection* const c = connections.getUnchecked (i);
+        RenderingSequence* const sequence = currentRenderingSequence.get();
+        renderingSequenceInUse.set (sequence);
 
-            if (c->destNodeId == possibleDestinationId
-                 && (c->sourceNodeId == possibleInputId
-                      || isAnInputTo (possibleInputId, c->sourceNodeId, recursionCheck - 1)))
-                return true;
-        }
+        // make sure this hasn't been replaced by a new one before we marked it as being in use
+        if (currentRenderingSequence.get() == sequence)
+            return sequence;
     }
+}
 
-    return false;
+void AudioProcessorGraph::releaseRenderingSequence() noexcept
+{
+    renderingSequenceInUse.set (nullptr);
+}
+
+void AudioProcessorGraph::clearRenderingSequence()
+{
+    setRenderingSequence (nullptr);
 }
 
 void AudioProcessorGraph::buildRenderingSequence()
 {
+    JUCE_TRACE_ZONE ("audio", "AudioProcessorGraph::buildRenderingSequence");
+
     Array<void*> newRenderingOps;
     int numRenderingBuffersNeeded = 2;
     int numMidiBuffersNeeded = 1;
 
+    const bool useDoublePrecision = canRenderDoublePrecision();
+
     {
         MessageManagerLock mml;
 
+        if (useDoublePrecision != isRenderingDoublePrecision)
+        {
+            // The nodes have to be prepared again at the new precision, and the contents of
+            // the delay lines can't be converted, so the old sequence must be stopped first.
+            clearRenderingSequence();
+            delayLines->clear();
+            isRenderingDoublePrecision = useDoublePrecision;
+        }
+
         Array<Node*> orderedNodes;
 
         {
-            const GraphRenderingOps::ConnectionLookupTable table (connections);
+            const GraphRenderingOps::ConnectionLookupTable table (nodes, connections);
+            Array<int> orderedNodeIndexes;
 
             for (int i = 0; i < nodes.size(); ++i)
             {
                 Node* const node = nodes.getUnchecked(i);
 
-                node->prepare (getSampleRate(), getBlockSize(), this);
+                node->prepare (getSampleRate(), getBlockSize(), this,
+                               useDoublePrecision ? doublePrecision : singlePrecision);
+                node->latencyAtLastBuild = node->getProcessor()->getLatencySamples();
 
                 int j = 0;
-                for (; j < orderedNodes.size(); ++j)
-                    if (table.isAnInputTo (node->nodeId, ((Node*) orderedNodes.getUnchecked(j))->nodeId))
+                for (; j < orderedNodeIndexes.size(); ++j)
+                    if (table.isAnInputTo (i, orderedNodeIndexes.getUnchecked(j)))
                       break;
 
                 orderedNodes.insert (j, node);
+                orderedNodeIndexes.insert (j, i);
             }
         }
 
-        GraphRenderingOps::RenderingOpSequenceCalculator calculator (*this, orderedNodes, newRenderingOps);
+        GraphRenderingOps::RenderingOpSequenceCalculator calculator (*this, orderedNodes, newRenderingOps, *delayLines);
 
         numRenderingBuffersNeeded = calculator.getNumBuffersNeeded();
         numMidiBuffersNeeded = calculator.getNumMidiBuffersNeeded();
     }
 
-    {
-        // swap over to the new rendering sequence..
-        const ScopedLock sl (getCallbackLock());
+    Array<int> newOpDependencies;
+    GraphRenderingOps::arrangeRenderingOpsIntoLevels (newRenderingOps, newOpDependencies,
+                                                      numRenderingBuffersNeeded, numMidiBuffersNeeded);
+
+    // swap over to the new rendering sequence, and delete the old one..
+    setRenderingSequence (new RenderingSequence (newRenderingOps, newOpDependencies,
+                                                 numRenderingBuffersNeeded, numMidiBuffersNeeded,
+                                                 getBlockSize(), useDoublePrecision));
+}
 
-        renderingBuffers.setSize (numRenderingBuffersNeeded, getBlockSize());
-        renderingBuffers.clear();
+bool AudioProcessorGraph::canRenderDoublePrecision() const
+{
+    if (! isUsingDoublePrecision())
+        return false;
 
-        for (int i = midiBuffers.size(); --i >= 0;)
-            midiBuffers.getUnchecked(i)->clear();
+    for (int i = nodes.size(); --i >= 0;)
+        if (! nodes.getUnchecked (i)->getProcessor()->supportsDoublePrecisionProcessing())
+            return false;
 
-        while (midiBuffers.size() < numMidiBuffersNeeded)
-            midiBuffers.add (new MidiBuffer());
+    return true;
+}
+
+void AudioProcessorGraph::graphChanged()
+{
+    graphHasChanged = 1;
+
+    if (batchEditDepth == 0)
+        triggerAsyncUpdate();
+}
+
+bool AudioProcessorGraph::haveNodeLatenciesChanged() const
+{
+    for (int i = nodes.size(); --i >= 0;)
+    {
+        const Node* const node = nodes.getUnchecked (i);
 
-        renderingOps.swapWith (newRenderingOps);
+        if (node->isPrepared && node->getProcessor()->getLatencySamples() != node->latencyAtLastBuild)
+            return true;
     }
 
-    // delete the old ones..
-    deleteRenderOpArray (newRenderingOps);
+    return false;
 }
 
 void AudioProcessorGraph::handleAsyncUpdate()
 {
-    buildRenderingSequence();
+    if (batchEditDepth > 0)
+        return;  // (the last ScopedBatchEdit will trigger another update when it's deleted)
+
+    // a node's updateHostDisplay() only needs a rebuild if its latency has changed, and
+    // then the delay lines for any paths whose compensation is unchanged are kept
+    if (graphHasChanged.exchange (0) != 0 || haveNodeLatenciesChanged())
+        buildRenderingSequence();
+}
+
+void AudioProcessorGraph::audioProcessorParameterChanged (AudioProcessor*, int, float) {}
+
+void AudioProcessorGraph::audioProcessorChanged (AudioProcessor*)
+{
+    // (this may be called on any thread, so the latencies get checked asynchronously)
+    triggerAsyncUpdate();
+}
+
+//==============================================================================
+void AudioProcessorGraph::setNumRenderingThreads (const int newNumThreads)
+{
+    const int numThreads = jmax (1, newNumThreads);
+
+    if (numThreads != numRenderingThreads)
+    {
+        numRenderingThreads = numThreads;
+        recreateRenderingThreadPool();
+    }
+}
+
+int AudioProcessorGraph::getNumRenderingThreads() const noexcept
+{
+    return numRenderingThreads;
+}
+
+void AudioProcessorGraph::setRenderingThreadAffinityMasks (const Array<uint32>& affinityMasks)
+{
+    if (affinityMasks != renderingThreadAffinityMasks)
+    {
+        renderingThreadAffinityMasks = affinityMasks;
+
+        if (numRenderingThreads > 1)
+            recreateRenderingThreadPool();
+    }
+}
+
+void AudioProcessorGraph::recreateRenderingThreadPool()
+{
+    // (there's no point running more realtime threads than there are performance cores)
+    const int numThreads = jmin (numRenderingThreads, SystemStats::getNumPerformanceCores());
+
+    ScopedPointer<RenderingThreadPool> newPool (numThreads > 1
+                                                  ? new RenderingThreadPool (numThreads - 1,
+                                                                             renderingThreadAffinityMasks,
+                                                                             getSampleRate(), getBlockSize())
+                                                  : nullptr);
+
+    {
+        const ScopedLock sl (getCallbackLock());
+        renderingThreadPool.swapWith (newPool);
+    }
+}
+
+bool AudioProcessorGraph::setTailLengthHint (const uint32 nodeId, const double tailLengthSeconds)
+{
+    Node* const n = getNodeForId (nodeId);
+
+    if (n == nullptr)
+        return false;
+
+    if (n->tailLengthHint != tailLengthSeconds)
+    {
+        n->tailLengthHint = tailLengthSeconds;
+        graphChanged();
+    }
+
+    return true;
 }
 
 //==============================================================================
-void AudioProcessorGraph::prepareToPlay (double /*sampleRate*/, int estimatedSamplesPerBlock)
+void AudioProcessorGraph::prepareToPlay (double sampleRate, int estimatedSamplesPerBlock)
 {
+    if (renderingThreadPool != nullptr)
+        renderingThreadPool->setCallbackPeriod (sampleRate, estimatedSamplesPerBlock);
+
     currentAudioInputBuffer = nullptr;
     currentAudioOutputBuffer.setSize (jmax (1, getNumOutputChannels()), estimatedSamplesPerBlock);
+    currentDoubleAudioInputBuffer = nullptr;
+
+    if (isUsingDoublePrecision())
+    {
+        currentDoubleAudioOutputBuffer.setSize (jmax (1, getNumOutputChannels()), estimatedSamplesPerBlock);
+        conversionBuffer.setSize (jmax (1, getNumInputChannels(), getNumOutputChannels()), estimatedSamplesPerBlock);
+    }
+
     currentMidiInputBuffer = nullptr;
     currentMidiOutputBuffer.clear();
 
@@ -1253,11 +2265,14 @@ void AudioProcessorGraph::releaseResources()
     for (int i = 0; i < nodes.size(); ++i)
         nodes.getUnchecked(i)->unprepare();
 
-    renderingBuffers.setSize (1, 1);
-    midiBuffers.clear();
+    clearRenderingSequence();
+    delayLines->clear();
 
     currentAudioInputBuffer = nullptr;
     currentAudioOutputBuffer.setSize (1, 1);
+    currentDoubleAudioInputBuffer = nullptr;
+    currentDoubleAudioOutputBuffer.setSize (1, 1);
+    conversionBuffer.setSize (1, 1);
     currentMidiInputBuffer = nullptr;
     currentMidiOutputBuffer.clear();
 }
@@ -1286,29 +2301,70 @@ void AudioProcessorGraph::setPlayHead (AudioPlayHead* audioPlayHead)
         nodes.getUnchecked(i)->getProcessor()->setPlayHead (audioPlayHead);
 }
 
-void AudioProcessorGraph::processBlock (AudioSampleBuffer& buffer, MidiBuffer& midiMessages)
+/** Renders the graph, if its current sequence uses the same sample type as the buffer.
+    If not, this returns false without doing anything.
+*/
+template <typename FloatType>
+bool AudioProcessorGraph::processAudio (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages,
+                                        AudioBuffer<FloatType>*& currentInput, AudioBuffer<FloatType>& currentOutput)
 {
+    JUCE_TRACE_ZONE ("audio", "AudioProcessorGraph::processBlock");
+
+    RenderingSequence* const sequence = acquireRenderingSequence();
+
+    if (sequence != nullptr && sequence->isDoublePrecision != (sizeof (FloatType) == sizeof (double)))
+    {
+        releaseRenderingSequence();
+        return false;
+    }
+
     const int numSamples = buffer.getNumSamples();
 
-    currentAudioInputBuffer = &buffer;
-    currentAudioOutputBuffer.setSize (jmax (1, buffer.getNumChannels()), numSamples);
-    currentAudioOutputBuffer.clear();
+    currentInput = &buffer;
+    currentOutput.setSize (jmax (1, buffer.getNumChannels()), numSamples);
+    currentOutput.clear();
     currentMidiInputBuffer = &midiMessages;
     currentMidiOutputBuffer.clear();
 
-    for (int i = 0; i < renderingOps.size(); ++i)
-    {
-        GraphRenderingOps::AudioGraphRenderingOp* const op
-            = (GraphRenderingOps::AudioGraphRenderingOp*) renderingOps.getUnchecked(i);
+    if (sequence != nullptr)
+        sequence->perform (renderingThreadPool, numSamples);
 
-        op->perform (renderingBuffers, midiBuffers, numSamples);
-    }
+    releaseRenderingSequence();
 
     for (int i = 0; i < buffer.getNumChannels(); ++i)
-        buffer.copyFrom (i, 0, currentAudioOutputBuffer, i, 0, numSamples);
+        buffer.copyFrom (i, 0, currentOutput, i, 0, numSamples);
 
     midiMessages.clear();
     midiMessages.addEvents (currentMidiOutputBuffer, 0, buffer.getNumSamples(), 0);
+    return true;
+}
+
+void AudioProcessorGraph::processBlock (AudioSampleBuffer& buffer, MidiBuffer& midiMessages)
+{
+    // (this can only fail if the graph has been set to double precision, in which case
+    // the host should be calling the other version)
+    if (! processAudio (buffer, midiMessages, currentAudioInputBuffer, currentAudioOutputBuffer))
+        buffer.clear();
+}
+
+void AudioProcessorGraph::processBlock (AudioBuffer<double>& buffer, MidiBuffer& midiMessages)
+{
+    if (! processAudio (buffer, midiMessages, currentDoubleAudioInputBuffer, currentDoubleAudioOutputBuffer))
+    {
+        // Some of the nodes can only work in single precision, so the whole graph is being
+        // rendered that way, and the audio is just converted on its way in and out.
+        conversionBuffer.makeCopyOf (buffer);
+
+        if (! processAudio (conversionBuffer, midiMessages, currentAudioInputBuffer, currentAudioOutputBuffer))
+            conversionBuffer.clear();
+
+        buffer.makeCopyOf (conversionBuffer);
+    }
+}
+
+bool AudioProcessorGraph::supportsDoublePrecisionProcessing() const
+{
+    return true;
 }
 
 const String AudioProcessorGraph::getInputChannelName (int channelIndex) const
@@ -1383,19 +2439,19 @@ void AudioProcessorGraph::AudioGraphIOProcessor::releaseResources()
 {
 }
 
-void AudioProcessorGraph::AudioGraphIOProcessor::processBlock (AudioSampleBuffer& buffer,
-                                                               MidiBuffer& midiMessages)
+template <typename FloatType>
+void AudioProcessorGraph::AudioGraphIOProcessor::processAudio (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages,
+                                                               AudioBuffer<FloatType>* const graphInput,
+                                                               AudioBuffer<FloatType>& graphOutput)
 {
-    jassert (graph != nullptr);
-
     switch (type)
     {
         case audioOutputNode:
         {
-            for (int i = jmin (graph->currentAudioOutputBuffer.getNumChannels(),
+            for (int i = jmin (graphOutput.getNumChannels(),
                                buffer.getNumChannels()); --i >= 0;)
             {
-                graph->currentAudioOutputBuffer.addFrom (i, 0, buffer, i, 0, buffer.getNumSamples());
+                graphOutput.addFrom (i, 0, buffer, i, 0, buffer.getNumSamples());
             }
 
             break;
@@ -1403,10 +2459,10 @@ void AudioProcessorGraph::AudioGraphIOProcessor::processBlock (AudioSampleBuffer
 
         case audioInputNode:
         {
-            for (int i = jmin (graph->currentAudioInputBuffer->getNumChannels(),
+            for (int i = jmin (graphInput->getNumChannels(),
                                buffer.getNumChannels()); --i >= 0;)
             {
-                buffer.copyFrom (i, 0, *graph->currentAudioInputBuffer, i, 0, buffer.getNumSamples());
+                buffer.copyFrom (i, 0, *graphInput, i, 0, buffer.getNumSamples());
             }
 
             break;
@@ -1425,6 +2481,25 @@ void AudioProcessorGraph::AudioGraphIOProcessor::processBlock (AudioSampleBuffer
     }
 }
 
+void AudioProcessorGraph::AudioGraphIOProcessor::processBlock (AudioSampleBuffer& buffer,
+                                                               MidiBuffer& midiMessages)
+{
+    jassert (graph != nullptr);
+    processAudio (buffer, midiMessages, graph->currentAudioInputBuffer, graph->currentAudioOutputBuffer);
+}
+
+void AudioProcessorGraph::AudioGraphIOProcessor::processBlock (AudioBuffer<double>& buffer,
+                                                               MidiBuffer& midiMessages)
+{
+    jassert (graph != nullptr);
+    processAudio (buffer, midiMessages, graph->currentDoubleAudioInputBuffer, graph->currentDoubleAudioOutputBuffer);
+}
+
+bool AudioProcessorGraph::AudioGraphIOProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
 bool AudioProcessorGraph::AudioGraphIOProcessor::silenceInProducesSilenceOut() const
 {
     return isOutput();
@@ -41,7 +41,8 @@
     AudioProcessorPlayer object.
 */
 class JUCE_API  AudioProcessorGraph   : public AudioProcessor,
-                                        private AsyncUpdater
+                                        private AsyncUpdater,
+                                        private AudioProcessorListener
 {
 public:
     //==============================================================================
@@ -53,6 +54,8 @@ public:
     */
     ~AudioProcessorGraph();
 
+    struct Connection;
+
     //==============================================================================
     /** Represents one of the nodes, or processors, in an AudioProcessorGraph.
 
@@ -78,6 +81,11 @@ public:
         */
         NamedValueSet properties;
 
+        /** Returns the tail length that was set with AudioProcessorGraph::setTailLengthHint(),
+            or a negative value if there isn't one.
+        */
+        double getTailLengthHint() const noexcept               { return tailLengthHint; }
+
         //==============================================================================
         /** A convenient typedef for referring to a pointer to a node object. */
         typedef ReferenceCountedObjectPtr<Node> Ptr;
@@ -88,11 +96,14 @@ public:
 
         const ScopedPointer<AudioProcessor> processor;
         bool isPrepared;
+        int latencyAtLastBuild;
+        double tailLengthHint;
+        Array<const Connection*> inputConnections, outputConnections;
 
         Node (uint32 nodeId, AudioProcessor*) noexcept;
 
         void setParentGraph (AudioProcessorGraph*) const;
-        void prepare (double sampleRate, int blockSize, AudioProcessorGraph*);
+        void prepare (double sampleRate, int blockSize, AudioProcessorGraph*, ProcessingPrecision);
         void unprepare();
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Node)
@@ -229,6 +240,27 @@ public:
     /** Removes all connections from the specified node. */
     bool disconnectNode (uint32 nodeId);
 
+    //==============================================================================
+    /** While one of these exists, changes to the graph don't cause it to rebuild its
+        rendering sequence.
+
+        Normally, every node or connection that gets added or removed triggers a rebuild.
+        If you're making a lot of edits at once, e.g. building a large graph, create one
+        of these on the message thread first, and the graph will do a single rebuild
+        when the last ScopedBatchEdit is deleted.
+    */
+    class JUCE_API  ScopedBatchEdit
+    {
+    public:
+        ScopedBatchEdit (AudioProcessorGraph&) noexcept;
+        ~ScopedBatchEdit();
+
+    private:
+        AudioProcessorGraph& graph;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedBatchEdit)
+    };
+
     /** Returns true if the given connection's channel numbers map on to valid
         channels at each end.
         Even if a connection is valid when created, its status could change if
@@ -251,6 +283,72 @@ public:
     */
     static const int midiChannelIndex;
 
+    //==============================================================================
+    /** Sets the number of threads that should be used to render the graph.
+
+        By default, the whole graph is rendered by the audio callback thread. If you set
+        this to a value greater than 1, then numThreads - 1 realtime worker threads will
+        be started, and any nodes which don't depend on each other's output will be
+        processed concurrently, with the audio callback thread taking part in the work.
+
+        The rendering sequence is arranged so that the results are exactly the same as
+        when it's rendered on a single thread, but bear in mind that the processors in
+        the graph must be able to cope with having their processBlock() methods called
+        from different threads, and at the same time as other processors.
+
+        The number of threads actually used is limited to SystemStats::getNumPerformanceCores(),
+        and on CPUs that also have efficiency cores, the workers are kept off those unless
+        you've given them affinity masks with setRenderingThreadAffinityMasks().
+
+        @see getNumRenderingThreads
+    */
+    void setNumRenderingThreads (int numThreads);
+
+    /** Returns the number of threads being used to render the graph.
+        @see setNumRenderingThreads
+    */
+    int getNumRenderingThreads() const noexcept;
+
+    /** Pins the graph's rendering worker threads to particular CPU cores.
+
+        The first mask in the array is used for the first worker thread, and so on (see
+        Thread::setAffinityMask() for the format). Any workers beyond the end of the array,
+        or whose mask is 0, are left free to run on any core. The audio callback thread
+        itself isn't affected, as it belongs to the audio device.
+
+        @see setNumRenderingThreads
+    */
+    void setRenderingThreadAffinityMasks (const Array<uint32>& affinityMasks);
+
+    //==============================================================================
+    /** Tells the graph how long a node keeps producing sound after its input goes silent.
+
+        The graph keeps track of which of its channels contain nothing but silence. When all
+        of a node's audio inputs are silent and its midi input is empty, and that has been
+        the case for longer than the node's tail, the graph stops calling its processBlock()
+        method and just treats its outputs as silent, until some input arrives again.
+
+        By default, this is only done for processors whose silenceInProducesSilenceOut()
+        method returns true, using their getTailLengthSeconds() as the tail. Setting a hint
+        lets it be done for a processor which doesn't report this itself, or overrides the
+        tail that it reports. A negative value removes the hint. Processors that produce
+        midi, and the graph's own i/o processors, are never skipped.
+
+        @returns false if there's no node with this ID
+    */
+    bool setTailLengthHint (uint32 nodeId, double tailLengthSeconds);
+
+    //==============================================================================
+    /** The graph can always be given double precision buffers.
+
+        If the graph is set to double precision with setProcessingPrecision(), and all of
+        its nodes support it, they're all prepared for double precision and the whole graph
+        is rendered with double buffers. If any node can only work in single precision, the
+        graph is rendered at single precision instead, and the audio is only converted where
+        it enters and leaves the graph.
+    */
+    bool supportsDoublePrecisionProcessing() const override;
+
 
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
@@ -309,6 +407,8 @@ public:
         void prepareToPlay (double sampleRate, int estimatedSamplesPerBlock) override;
         void releaseResources() override;
         void processBlock (AudioSampleBuffer&, MidiBuffer&);
+        void processBlock (AudioBuffer<double>&, MidiBuffer&) override;
+        bool supportsDoublePrecisionProcessing() const override;
 
         const String getInputChannelName (int channelIndex) const override;
         const String getOutputChannelName (int channelIndex) const override;
@@ -338,6 +438,10 @@ public:
         const IODeviceType type;
         AudioProcessorGraph* graph;
 
+        template <typename FloatType>
+        void processAudio (AudioBuffer<FloatType>&, MidiBuffer&,
+                           AudioBuffer<FloatType>* graphInput, AudioBuffer<FloatType>& graphOutput);
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioGraphIOProcessor)
     };
 
@@ -346,6 +450,7 @@ public:
     void prepareToPlay (double, int) override;
     void releaseResources() override;
     void processBlock (AudioSampleBuffer&, MidiBuffer&) override;
+    void processBlock (AudioBuffer<double>&, MidiBuffer&) override;
 
     void reset() override;
     void setNonRealtime (bool) noexcept override;
@@ -374,22 +479,53 @@ public:
 private:
     //==============================================================================
     ReferenceCountedArray<Node> nodes;
+    HashMap<int, Node*> nodesById;
     OwnedArray<Connection> connections;
     uint32 lastNodeId;
-    AudioSampleBuffer renderingBuffers;
-    OwnedArray<MidiBuffer> midiBuffers;
-    Array<void*> renderingOps;
+    int batchEditDepth;
+
+    struct RenderingSequence;
+    friend struct RenderingSequence;
+    Atomic<RenderingSequence*> currentRenderingSequence, renderingSequenceInUse;
+
+    class RenderingThreadPool;
+    friend class RenderingThreadPool;
+    ScopedPointer<RenderingThreadPool> renderingThreadPool;
+    int numRenderingThreads;
+    Array<uint32> renderingThreadAffinityMasks;
+
+    struct DelayLines;
+    friend struct DelayLines;
+    friend struct ContainerDeletePolicy<DelayLines>;
+    ScopedPointer<DelayLines> delayLines;
+    Atomic<int> graphHasChanged;
 
     friend class AudioGraphIOProcessor;
     AudioSampleBuffer* currentAudioInputBuffer;
     AudioSampleBuffer currentAudioOutputBuffer;
+    AudioBuffer<double>* currentDoubleAudioInputBuffer;
+    AudioBuffer<double> currentDoubleAudioOutputBuffer;
+    AudioSampleBuffer conversionBuffer;
     MidiBuffer* currentMidiInputBuffer;
     MidiBuffer currentMidiOutputBuffer;
+    bool isRenderingDoublePrecision;
 
     void handleAsyncUpdate() override;
+    void audioProcessorParameterChanged (AudioProcessor*, int, float) override;
+    void audioProcessorChanged (AudioProcessor*) override;
+    void graphChanged();
+    bool haveNodeLatenciesChanged() const;
     void clearRenderingSequence();
+    void setRenderingSequence (RenderingSequence*);
+    RenderingSequence* acquireRenderingSequence() noexcept;
+    void releaseRenderingSequence() noexcept;
     void buildRenderingSequence();
-    bool isAnInputTo (uint32 possibleInputId, uint32 possibleDestinationId, int recursionCheck) const;
+    bool canRenderDoublePrecision() const;
+    void recreateRenderingThreadPool();
+
+    template <typename FloatType>
+    bool processAudio (AudioBuffer<FloatType>&, MidiBuffer&,
+                       AudioBuffer<FloatType>*& currentInput, AudioBuffer<FloatType>& currentOutput);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorGraph)
 };
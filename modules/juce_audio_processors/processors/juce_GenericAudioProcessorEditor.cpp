@@ -22,59 +22,26 @@
   ==============================================================================
 */
 
-class ProcessorParameterPropertyComp   : public PropertyComponent,
-                                         private AudioProcessorListener,
-                                         private Timer
+class ProcessorParameterPropertyComp   : public PropertyComponent
 {
 public:
     ProcessorParameterPropertyComp (const String& name, AudioProcessor& p, int paramIndex)
         : PropertyComponent (name),
           owner (p),
           index (paramIndex),
-          paramHasChanged (false),
           slider (p, paramIndex)
     {
-        startTimer (100);
         addAndMakeVisible (slider);
-        owner.addListener (this);
-    }
-
-    ~ProcessorParameterPropertyComp()
-    {
-        owner.removeListener (this);
     }
 
     void refresh() override
     {
-        paramHasChanged = false;
-
         if (slider.getThumbBeingDragged() < 0)
             slider.setValue (owner.getParameter (index), dontSendNotification);
 
         slider.updateText();
     }
 
-    void audioProcessorChanged (AudioProcessor*) override  {}
-
-    void audioProcessorParameterChanged (AudioProcessor*, int parameterIndex, float) override
-    {
-        if (parameterIndex == index)
-            paramHasChanged = true;
-    }
-
-    void timerCallback() override
-    {
-        if (paramHasChanged)
-        {
-            refresh();
-            startTimerHz (50);
-        }
-        else
-        {
-            startTimer (jmin (1000 / 4, getTimerInterval() + 10));
-        }
-    }
-
 private:
     //==============================================================================
     class ParamSlider  : public Slider
@@ -120,7 +87,6 @@ private:
 
     AudioProcessor& owner;
     const int index;
-    bool volatile paramHasChanged;
     ParamSlider slider;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProcessorParameterPropertyComp)
@@ -149,12 +115,14 @@ GenericAudioProcessorEditor::GenericAudioProcessorEditor (AudioProcessor* const
 
         ProcessorParameterPropertyComp* const pc = new ProcessorParameterPropertyComp (name, *p, i);
         params.add (pc);
+        paramComps.add (pc);
         totalHeight += pc->getPreferredHeight();
     }
 
     panel.addProperties (params);
 
     setSize (400, jlimit (25, 400, totalHeight));
+    startTimer (100);
 }
 
 GenericAudioProcessorEditor::~GenericAudioProcessorEditor()
@@ -170,3 +138,21 @@ void GenericAudioProcessorEditor::resized()
 {
     panel.setBounds (getLocalBounds());
 }
+
+void GenericAudioProcessorEditor::timerCallback()
+{
+    BigInteger dirtyParams;
+
+    if (processor.getParameterChangeQueue().getDirtyParameters (dirtyParams, paramComps.size()))
+    {
+        for (int i = dirtyParams.findNextSetBit (0); isPositiveAndBelow (i, paramComps.size());
+             i = dirtyParams.findNextSetBit (i + 1))
+            paramComps.getUnchecked (i)->refresh();
+
+        startTimerHz (50);
+    }
+    else
+    {
+        startTimer (jmin (1000 / 4, getTimerInterval() + 10));
+    }
+}
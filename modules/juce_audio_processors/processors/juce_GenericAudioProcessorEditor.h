@@ -36,7 +36,8 @@
 
     @see AudioProcessor
 */
-class JUCE_API  GenericAudioProcessorEditor      : public AudioProcessorEditor
+class JUCE_API  GenericAudioProcessorEditor      : public AudioProcessorEditor,
+                                                  private Timer
 {
 public:
     //==============================================================================
@@ -50,6 +51,9 @@ public:
 private:
     //==============================================================================
     PropertyPanel panel;
+    Array<PropertyComponent*> paramComps;
+
+    void timerCallback() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GenericAudioProcessorEditor)
 };
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+ParameterChangeQueue::ParameterChangeQueue (const int capacity)
+    : fifo (capacity), numDirtyWords (0)
+{
+    setNumParameters (256);
+}
+
+ParameterChangeQueue::~ParameterChangeQueue() {}
+
+//==============================================================================
+bool ParameterChangeQueue::push (const int parameterIndex, const float newValue, const int sampleOffset) noexcept
+{
+    markAsDirty (parameterIndex);
+
+    const Change change = { parameterIndex, newValue, sampleOffset };
+    return fifo.push (change);
+}
+
+bool ParameterChangeQueue::pop (Change& result) noexcept
+{
+    return fifo.pop (result);
+}
+
+int ParameterChangeQueue::getNumPendingChanges() const noexcept
+{
+    return fifo.getNumReady();
+}
+
+void ParameterChangeQueue::clearPendingChanges() noexcept
+{
+    fifo.reset();
+}
+
+//==============================================================================
+void ParameterChangeQueue::markAsDirty (const int parameterIndex) noexcept
+{
+    const int word = parameterIndex >> 5;
+
+    if (isPositiveAndBelow (word, numDirtyWords))
+    {
+        Atomic<int>& bits = dirtyBits [word];
+        const int mask = 1 << (parameterIndex & 31);
+
+        for (;;)
+        {
+            const int oldBits = bits.get();
+
+            if ((oldBits & mask) != 0 || bits.compareAndSetBool (oldBits | mask, oldBits))
+                break;
+        }
+    }
+    else
+    {
+        overflowed = 1;
+    }
+
+    anyDirty = 1;
+}
+
+bool ParameterChangeQueue::getDirtyParameters (BigInteger& result, const int numParameters)
+{
+    result.clear();
+
+    if (anyDirty.exchange (0) == 0)
+        return false;
+
+    for (int i = 0; i < numDirtyWords; ++i)
+    {
+        const int bits = dirtyBits[i].exchange (0);
+
+        if (bits != 0)
+            for (int bit = 0; bit < 32; ++bit)
+                if ((bits & (1 << bit)) != 0)
+                    result.setBit ((i << 5) + bit);
+    }
+
+    if (overflowed.exchange (0) != 0 && numParameters > 0)
+        result.setRange (0, numParameters, true);
+
+    return ! result.isZero();
+}
+
+void ParameterChangeQueue::setNumParameters (const int numParameters)
+{
+    const int numWordsNeeded = (numParameters + 31) >> 5;
+
+    if (numWordsNeeded > numDirtyWords)
+    {
+        HeapBlock<Atomic<int> > newBits ((size_t) numWordsNeeded, true);
+
+        for (int i = 0; i < numDirtyWords; ++i)
+            newBits[i] = dirtyBits[i].get();
+
+        dirtyBits.swapWith (newBits);
+        numDirtyWords = numWordsNeeded;
+    }
+}
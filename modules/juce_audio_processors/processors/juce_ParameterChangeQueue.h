@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_PARAMETERCHANGEQUEUE_H_INCLUDED
+#define JUCE_PARAMETERCHANGEQUEUE_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A lock-free stream of parameter changes for an AudioProcessor.
+
+    Each AudioProcessor has one of these, which you can get with
+    AudioProcessor::getParameterChangeQueue(). It does two separate jobs:
+
+    - It holds a single-reader, single-writer FIFO of timestamped changes. A host
+      can push() the automation for the next block before calling processBlock(),
+      and the processor can pop() them inside processBlock() to apply each one at
+      its sample offset.
+
+    - It keeps a set of "dirty" parameters, which gets marked whenever a parameter
+      changes through AudioProcessor::setParameterNotifyingHost(). Marking is lock-free
+      and never allocates, so it's safe on the audio thread. Rather than reacting to
+      an AudioProcessorListener callback for every single change, an editor can call
+      getDirtyParameters() from a timer to find out which parameters have changed
+      since it last looked. Each change is only reported once, so there should only
+      be one thing reading the dirty set - normally the processor's editor.
+
+    @see AudioProcessor::getParameterChangeQueue, FifoBuffer
+*/
+class JUCE_API  ParameterChangeQueue
+{
+public:
+    //==============================================================================
+    /** A change to a parameter, at a sample position within the next block. */
+    struct Change
+    {
+        int parameterIndex;
+        float newValue;
+        int sampleOffset;
+    };
+
+    //==============================================================================
+    /** Creates a queue which can hold the given number of pending changes. */
+    explicit ParameterChangeQueue (int capacity = 1024);
+
+    /** Destructor. */
+    ~ParameterChangeQueue();
+
+    //==============================================================================
+    /** Adds a change to the FIFO, and marks its parameter as dirty.
+        This must only be called by one thread at a time.
+        @returns false if the FIFO was full, in which case the change is dropped
+    */
+    bool push (int parameterIndex, float newValue, int sampleOffset) noexcept;
+
+    /** Removes the oldest change from the FIFO.
+        This must only be called by the reader thread - normally inside processBlock().
+        @returns false if the FIFO was empty
+    */
+    bool pop (Change& result) noexcept;
+
+    /** Returns the number of changes waiting to be read from the FIFO. */
+    int getNumPendingChanges() const noexcept;
+
+    /** Discards any changes in the FIFO.
+        This isn't thread-safe, so must not be called while the FIFO is in use.
+    */
+    void clearPendingChanges() noexcept;
+
+    //==============================================================================
+    /** Marks a parameter as having changed. This can be called from any thread. */
+    void markAsDirty (int parameterIndex) noexcept;
+
+    /** Fills the given set with the indexes of the parameters that have been marked
+        as dirty since the last call, and clears them.
+
+        The numParameters value is used if a parameter beyond the set's capacity was
+        marked, in which case all of them are reported as dirty.
+
+        @returns true if any parameters were dirty
+    */
+    bool getDirtyParameters (BigInteger& result, int numParameters);
+
+    /** Makes sure that the dirty set has a bit for each parameter.
+        This allocates, so it mustn't be called while parameters may be being changed.
+    */
+    void setNumParameters (int numParameters);
+
+private:
+    //==============================================================================
+    FifoBuffer<Change> fifo;
+    HeapBlock<Atomic<int> > dirtyBits;
+    int numDirtyWords;
+    Atomic<int> anyDirty, overflowed;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterChangeQueue)
+};
+
+
+#endif   // JUCE_PARAMETERCHANGEQUEUE_H_INCLUDED
@@ -54,6 +54,8 @@ PluginDescription* KnownPluginList::getTypeForIdentifierString (const String& id
 
 bool KnownPluginList::addType (const PluginDescription& type)
 {
+    const ScopedLock sl (scanLock);
+
     for (int i = types.size(); --i >= 0;)
     {
         if (types.getUnchecked(i)->isDuplicateOf (type))
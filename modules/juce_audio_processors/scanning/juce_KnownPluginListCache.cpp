@@ -0,0 +1,342 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+/*  The file layout is:
+
+    - magic number, version, number of files
+    - the index: for each file, the hash of its path, its modification time,
+      and the start and size of its record
+    - the blacklist
+    - the records: for each file, its path, then its plugin descriptions
+*/
+namespace KnownPluginListCacheHelpers
+{
+    enum
+    {
+        magicNumber = 0x43504c4b,  // "KPLC"
+        formatVersion = 1,
+        indexEntrySize = 8 + 8 + 4 + 4
+    };
+
+    static void writeDescription (OutputStream& out, const PluginDescription& d)
+    {
+        out.writeString (d.name);
+        out.writeString (d.descriptiveName);
+        out.writeString (d.pluginFormatName);
+        out.writeString (d.category);
+        out.writeString (d.manufacturerName);
+        out.writeString (d.version);
+        out.writeInt64 (d.lastFileModTime.toMilliseconds());
+        out.writeInt (d.uid);
+        out.writeBool (d.isInstrument);
+        out.writeCompressedInt (d.numInputChannels);
+        out.writeCompressedInt (d.numOutputChannels);
+        out.writeBool (d.hasSharedContainer);
+    }
+
+    static void readDescription (InputStream& in, PluginDescription& d, const String& fileOrIdentifier)
+    {
+        d.name              = in.readString();
+        d.descriptiveName   = in.readString();
+        d.pluginFormatName  = in.readString();
+        d.category          = in.readString();
+        d.manufacturerName  = in.readString();
+        d.version           = in.readString();
+        d.fileOrIdentifier  = fileOrIdentifier;
+        d.lastFileModTime   = Time (in.readInt64());
+        d.uid               = in.readInt();
+        d.isInstrument      = in.readBool();
+        d.numInputChannels  = in.readCompressedInt();
+        d.numOutputChannels = in.readCompressedInt();
+        d.hasSharedContainer = in.readBool();
+    }
+}
+
+//==============================================================================
+KnownPluginListCache::KnownPluginListCache (const File& cacheFile)
+    : file (cacheFile), recordsStart (0), hasLoaded (false)
+{
+}
+
+KnownPluginListCache::~KnownPluginListCache() {}
+
+bool KnownPluginListCache::save (const KnownPluginList& list)
+{
+    using namespace KnownPluginListCacheHelpers;
+
+    // group the types by file, keeping them in the order they appear in the list
+    StringArray files;
+    OwnedArray<Array<const PluginDescription*> > typesForFile;
+    HashMap<String, int> fileIndexes;
+
+    for (int i = 0; i < list.getNumTypes(); ++i)
+    {
+        const PluginDescription* const d = list.getType (i);
+
+        if (! fileIndexes.contains (d->fileOrIdentifier))
+        {
+            fileIndexes.set (d->fileOrIdentifier, files.size());
+            files.add (d->fileOrIdentifier);
+            typesForFile.add (new Array<const PluginDescription*>());
+        }
+
+        typesForFile.getUnchecked (fileIndexes [d->fileOrIdentifier])->add (d);
+    }
+
+    MemoryOutputStream header, records;
+    header.writeInt (magicNumber);
+    header.writeInt (formatVersion);
+    header.writeInt (files.size());
+
+    for (int i = 0; i < files.size(); ++i)
+    {
+        const Array<const PluginDescription*>& types = *typesForFile.getUnchecked (i);
+        const int recordStart = (int) records.getPosition();
+        int64 modTime = 0;
+
+        records.writeString (files[i]);
+        records.writeCompressedInt (types.size());
+
+        for (int j = 0; j < types.size(); ++j)
+        {
+            writeDescription (records, *types.getUnchecked (j));
+            modTime = jmax (modTime, types.getUnchecked (j)->lastFileModTime.toMilliseconds());
+        }
+
+        header.writeInt64 (files[i].hashCode64());
+        header.writeInt64 (modTime);
+        header.writeInt (recordStart);
+        header.writeInt ((int) records.getPosition() - recordStart);
+    }
+
+    const StringArray& blacklisted = list.getBlacklistedFiles();
+    header.writeCompressedInt (blacklisted.size());
+
+    for (int i = 0; i < blacklisted.size(); ++i)
+        header.writeString (blacklisted[i]);
+
+    header << records;
+
+    const ScopedLock sl (lock);
+
+    if (! file.replaceWithData (header.getData(), header.getDataSize()))
+        return false;
+
+    data = header.getMemoryBlock();
+    hasLoaded = true;
+    parseIndex();
+    return true;
+}
+
+bool KnownPluginListCache::restore (KnownPluginList& list)
+{
+    OwnedArray<PluginDescription> types;
+    StringArray blacklisted;
+
+    {
+        const ScopedLock sl (lock);
+        loadIfNeeded();
+
+        if (data.getSize() == 0)
+            return false;
+
+        for (int i = 0; i < index.size(); ++i)
+        {
+            String fileOrIdentifier;
+            readRecord (index.getReference (i), fileOrIdentifier, &types);
+        }
+
+        blacklisted = blacklist;
+    }
+
+    list.clear();
+    list.clearBlacklistedFiles();
+
+    // (addType() inserts at the start of the list, so go backwards to keep the order)
+    for (int i = types.size(); --i >= 0;)
+        list.addType (*types.getUnchecked (i));
+
+    for (int i = 0; i < blacklisted.size(); ++i)
+        list.addToBlacklist (blacklisted[i]);
+
+    return true;
+}
+
+int KnownPluginListCache::getNumFiles()
+{
+    const ScopedLock sl (lock);
+    loadIfNeeded();
+    return index.size();
+}
+
+bool KnownPluginListCache::isUpToDate (const String& fileOrIdentifier, AudioPluginFormat& format)
+{
+    OwnedArray<PluginDescription> types;
+
+    {
+        const ScopedLock sl (lock);
+        loadIfNeeded();
+
+        const IndexEntry* const entry = findEntry (fileOrIdentifier);
+
+        if (entry == nullptr)
+            return false;
+
+        if (File::isAbsolutePath (fileOrIdentifier))
+            return File (fileOrIdentifier).getLastModificationTime().toMilliseconds() == entry->modTime;
+
+        String path;
+        readRecord (*entry, path, &types);
+    }
+
+    // (this is called without the lock held, as it may be slow)
+    for (int i = 0; i < types.size(); ++i)
+        if (format.pluginNeedsRescanning (*types.getUnchecked (i)))
+            return false;
+
+    return types.size() > 0;
+}
+
+bool KnownPluginListCache::getTypesForFile (const String& fileOrIdentifier, OwnedArray<PluginDescription>& results)
+{
+    const ScopedLock sl (lock);
+    loadIfNeeded();
+
+    if (const IndexEntry* const entry = findEntry (fileOrIdentifier))
+    {
+        String path;
+        return readRecord (*entry, path, &results);
+    }
+
+    return false;
+}
+
+//==============================================================================
+void KnownPluginListCache::loadIfNeeded()
+{
+    if (! hasLoaded)
+    {
+        hasLoaded = true;
+
+        if (! (file.loadFileAsData (data) && parseIndex()))
+            data.reset();
+    }
+}
+
+void KnownPluginListCache::clearIndex()
+{
+    index.clearQuick();
+    indexForHash.clear();
+    blacklist.clear();
+    recordsStart = 0;
+}
+
+bool KnownPluginListCache::parseIndex()
+{
+    using namespace KnownPluginListCacheHelpers;
+
+    clearIndex();
+
+    MemoryInputStream in (data, false);
+
+    if (in.readInt() != magicNumber || in.readInt() != formatVersion)
+        return false;
+
+    const int numFiles = in.readInt();
+
+    if (numFiles < 0 || numFiles > in.getNumBytesRemaining() / indexEntrySize)
+        return false;
+
+    Array<int64> hashes;
+    hashes.ensureStorageAllocated (numFiles);
+    index.ensureStorageAllocated (numFiles);
+
+    for (int i = 0; i < numFiles; ++i)
+    {
+        hashes.add (in.readInt64());
+
+        IndexEntry entry;
+        entry.modTime     = in.readInt64();
+        entry.recordStart = in.readInt();
+        entry.recordSize  = in.readInt();
+        index.add (entry);
+    }
+
+    for (int i = in.readCompressedInt(); --i >= 0 && ! in.isExhausted();)
+        blacklist.add (in.readString());
+
+    recordsStart = (int) in.getPosition();
+    const int64 recordsSize = (int64) data.getSize() - recordsStart;
+
+    for (int i = 0; i < numFiles; ++i)
+    {
+        const IndexEntry& entry = index.getReference (i);
+
+        if (entry.recordStart < 0 || entry.recordSize < 0
+             || entry.recordStart + (int64) entry.recordSize > recordsSize)
+        {
+            clearIndex();
+            return false;
+        }
+
+        indexForHash.set (hashes.getUnchecked (i), i);
+    }
+
+    return true;
+}
+
+const KnownPluginListCache::IndexEntry* KnownPluginListCache::findEntry (const String& fileOrIdentifier) const
+{
+    const int64 hash = fileOrIdentifier.hashCode64();
+
+    if (! indexForHash.contains (hash))
+        return nullptr;
+
+    const IndexEntry& entry = index.getReference (indexForHash [hash]);
+
+    // check that it's not just a hash collision
+    String path;
+    return readRecord (entry, path, nullptr) && path == fileOrIdentifier ? &entry : nullptr;
+}
+
+bool KnownPluginListCache::readRecord (const IndexEntry& entry, String& fileOrIdentifier,
+                                       OwnedArray<PluginDescription>* const results) const
+{
+    MemoryInputStream in (addBytesToPointer (data.getData(), recordsStart + entry.recordStart),
+                          (size_t) entry.recordSize, false);
+
+    fileOrIdentifier = in.readString();
+
+    if (results != nullptr)
+    {
+        for (int i = in.readCompressedInt(); --i >= 0 && ! in.isExhausted();)
+        {
+            PluginDescription* const d = new PluginDescription();
+            KnownPluginListCacheHelpers::readDescription (in, *d, fileOrIdentifier);
+            results->add (d);
+        }
+    }
+
+    return fileOrIdentifier.isNotEmpty();
+}
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_KNOWNPLUGINLISTCACHE_H_INCLUDED
+#define JUCE_KNOWNPLUGINLISTCACHE_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A compact binary file that stores the contents of a KnownPluginList.
+
+    This is a faster alternative to KnownPluginList::createXml() and recreateFromXml()
+    for big lists. The file starts with an index which maps a hash of each plugin
+    file or identifier to its modification time and the position of its plugin
+    descriptions, so deciding whether a file needs rescanning only needs a hash
+    lookup and a single stat of the file.
+
+    The file isn't read until the first time it's needed, and then only the index
+    is parsed: a file's descriptions aren't decoded until they're asked for.
+
+    To make a PluginDirectoryScanner skip all the files whose cached entries are
+    still up to date, pass one of these to PluginDirectoryScanner::setCache(), and
+    call save() when the scan has finished.
+
+    All the methods are thread-safe.
+
+    @see KnownPluginList, PluginDirectoryScanner
+*/
+class JUCE_API  KnownPluginListCache
+{
+public:
+    //==============================================================================
+    /** Creates a cache that uses the given file. The file doesn't have to exist yet. */
+    explicit KnownPluginListCache (const File& cacheFile);
+
+    /** Destructor. */
+    ~KnownPluginListCache();
+
+    //==============================================================================
+    /** Replaces the cache file with the types and blacklist in the given list.
+        Returns false if the file couldn't be written.
+    */
+    bool save (const KnownPluginList& list);
+
+    /** Replaces the contents of the list with the types and blacklist in the cache.
+        Returns false if the cache file doesn't exist or isn't valid.
+    */
+    bool restore (KnownPluginList& list);
+
+    /** Returns the number of plugin files or identifiers in the cache. */
+    int getNumFiles();
+
+    /** Returns true if the cache has an entry for this file or identifier, and the
+        plugin hasn't changed since it was saved.
+
+        For a file, this just compares the file's modification time with the cached one.
+        For other identifiers (e.g. AudioUnits), it uses the format's pluginNeedsRescanning()
+        method on each of the cached descriptions.
+    */
+    bool isUpToDate (const String& fileOrIdentifier, AudioPluginFormat& format);
+
+    /** Adds the cached descriptions for a file or identifier to an array.
+        Returns false if the cache doesn't have an entry for it.
+    */
+    bool getTypesForFile (const String& fileOrIdentifier, OwnedArray<PluginDescription>& results);
+
+private:
+    //==============================================================================
+    struct IndexEntry
+    {
+        int64 modTime;
+        int recordStart, recordSize;
+    };
+
+    const File file;
+    CriticalSection lock;
+    MemoryBlock data;
+    Array<IndexEntry> index;
+    HashMap<int64, int> indexForHash;
+    StringArray blacklist;
+    int recordsStart;
+    bool hasLoaded;
+
+    void loadIfNeeded();
+    void clearIndex();
+    bool parseIndex();
+    const IndexEntry* findEntry (const String& fileOrIdentifier) const;
+    bool readRecord (const IndexEntry&, String& fileOrIdentifier, OwnedArray<PluginDescription>* results) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KnownPluginListCache)
+};
+
+
+#endif   // JUCE_KNOWNPLUGINLISTCACHE_H_INCLUDED
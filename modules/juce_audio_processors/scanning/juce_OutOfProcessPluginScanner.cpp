@@ -0,0 +1,322 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+const char* const OutOfProcessPluginScanner::defaultCommandLineID = "jucePluginScanner";
+
+//==============================================================================
+// A scan request is an int request ID followed by the format name and the file or
+// identifier. The reply is the same ID, followed by an XML document containing the
+// descriptions of any types that were found.
+struct OutOfProcessPluginScanner::ScannerProcess  : public ChildProcessMaster
+{
+    ScannerProcess()  : nextRequestID (0), replyRequestID (-1), connectionLost (false) {}
+
+    enum Result
+    {
+        succeeded,
+        crashed,
+        cancelled
+    };
+
+    Result scan (const String& formatName, const String& fileOrIdentifier,
+                 OwnedArray<PluginDescription>& results, const int timeoutMs,
+                 const KnownPluginList::CustomScanner& owner)
+    {
+        const int requestID = ++nextRequestID;
+
+        {
+            const ScopedLock sl (replyLock);
+
+            if (connectionLost)
+                return crashed;
+
+            replyRequestID = -1;
+            replyXml.clear();
+        }
+
+        replyReceived.reset();
+
+        MemoryOutputStream request;
+        request.writeInt (requestID);
+        request.writeString (formatName);
+        request.writeString (fileOrIdentifier);
+
+        if (! sendMessageToSlave (request.getMemoryBlock()))
+            return crashed;
+
+        const uint32 startTime = Time::getMillisecondCounter();
+
+        for (;;)
+        {
+            replyReceived.wait (100);
+
+            {
+                const ScopedLock sl (replyLock);
+
+                if (replyRequestID == requestID)
+                {
+                    addTypesFromXml (replyXml, results);
+                    return succeeded;
+                }
+
+                if (connectionLost)
+                    return crashed;
+            }
+
+            if (owner.shouldExit())
+                return cancelled;
+
+            // a plugin that hangs gets treated in the same way as one that crashes
+            if (Time::getMillisecondCounter() - startTime > (uint32) timeoutMs)
+                return crashed;
+        }
+    }
+
+    void handleMessageFromSlave (const MemoryBlock& message) override
+    {
+        MemoryInputStream in (message, false);
+        const int requestID = in.readInt();
+        const String xml (in.readString());
+
+        {
+            const ScopedLock sl (replyLock);
+            replyRequestID = requestID;
+            replyXml = xml;
+        }
+
+        replyReceived.signal();
+    }
+
+    void handleConnectionLost() override
+    {
+        {
+            const ScopedLock sl (replyLock);
+            connectionLost = true;
+        }
+
+        replyReceived.signal();
+    }
+
+private:
+    int nextRequestID, replyRequestID;
+    bool connectionLost;
+    String replyXml;
+    CriticalSection replyLock;
+    WaitableEvent replyReceived;
+
+    static void addTypesFromXml (const String& xmlText, OwnedArray<PluginDescription>& results)
+    {
+        const ScopedPointer<XmlElement> xml (XmlDocument::parse (xmlText));
+
+        if (xml != nullptr)
+        {
+            forEachXmlChildElement (*xml, e)
+            {
+                PluginDescription desc;
+
+                if (desc.loadFromXml (*e))
+                    results.add (new PluginDescription (desc));
+            }
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (ScannerProcess)
+};
+
+//==============================================================================
+OutOfProcessPluginScanner::OutOfProcessPluginScanner (const File& scannerExecutable,
+                                                      const int maxNumProcesses,
+                                                      const int timeoutMsPerPlugin,
+                                                      const String& commandLineUniqueID)
+    : executable (scannerExecutable),
+      commandLineID (commandLineUniqueID),
+      maxProcesses (jmax (1, maxNumProcesses)),
+      timeoutMs (timeoutMsPerPlugin),
+      numProcesses (0)
+{
+}
+
+OutOfProcessPluginScanner::~OutOfProcessPluginScanner()
+{
+    // all the scans should have finished before this is deleted!
+    jassert (numProcesses == idleProcesses.size());
+
+    idleProcesses.clear();
+}
+
+bool OutOfProcessPluginScanner::findPluginTypesFor (AudioPluginFormat& format,
+                                                    OwnedArray<PluginDescription>& result,
+                                                    const String& fileOrIdentifier)
+{
+    ScannerProcess* const process = getProcess();
+
+    // if there's no process, the scan was cancelled or the scanner couldn't be launched,
+    // which doesn't mean that the plugin is to blame
+    if (process == nullptr)
+        return true;
+
+    const ScannerProcess::Result r = process->scan (format.getName(), fileOrIdentifier,
+                                                    result, timeoutMs, *this);
+
+    releaseProcess (process, r == ScannerProcess::succeeded);
+    return r != ScannerProcess::crashed;
+}
+
+void OutOfProcessPluginScanner::scanFinished()
+{
+    const ScopedLock sl (lock);
+
+    numProcesses -= idleProcesses.size();
+    idleProcesses.clear();
+}
+
+OutOfProcessPluginScanner::ScannerProcess* OutOfProcessPluginScanner::getProcess()
+{
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            if (idleProcesses.size() > 0)
+                return idleProcesses.removeAndReturn (idleProcesses.size() - 1);
+
+            if (numProcesses < maxProcesses)
+            {
+                ++numProcesses;
+                break;
+            }
+        }
+
+        if (shouldExit())
+            return nullptr;
+
+        processReleased.wait (100);
+    }
+
+    ScopedPointer<ScannerProcess> process (new ScannerProcess());
+
+    if (process->launchSlaveProcess (executable, commandLineID))
+        return process.release();
+
+    // Couldn't start the scanner! Check that the executable exists, and that its
+    // startup code passes its command-line to a PluginScannerSlave.
+    jassertfalse;
+
+    {
+        const ScopedLock sl (lock);
+        --numProcesses;
+    }
+
+    processReleased.signal();
+    return nullptr;
+}
+
+void OutOfProcessPluginScanner::releaseProcess (ScannerProcess* const process, const bool isStillUsable)
+{
+    if (isStillUsable)
+    {
+        const ScopedLock sl (lock);
+        idleProcesses.add (process);
+    }
+    else
+    {
+        process->killSlaveProcess();
+        delete process;
+
+        const ScopedLock sl (lock);
+        --numProcesses;
+    }
+
+    processReleased.signal();
+}
+
+//==============================================================================
+struct PluginScannerSlave::ScanMessage  : public CallbackMessage
+{
+    ScanMessage (PluginScannerSlave& s, const int id, const String& format, const String& file)
+        : owner (s), requestID (id), formatName (format), fileOrIdentifier (file)
+    {
+    }
+
+    void messageCallback() override
+    {
+        owner.scanAndReply (requestID, formatName, fileOrIdentifier);
+    }
+
+    PluginScannerSlave& owner;
+    const int requestID;
+    const String formatName, fileOrIdentifier;
+
+    JUCE_DECLARE_NON_COPYABLE (ScanMessage)
+};
+
+PluginScannerSlave::PluginScannerSlave (AudioPluginFormatManager& formatsToUse)
+    : formatManager (formatsToUse)
+{
+}
+
+PluginScannerSlave::~PluginScannerSlave() {}
+
+void PluginScannerSlave::handleMessageFromMaster (const MemoryBlock& message)
+{
+    MemoryInputStream in (message, false);
+    const int requestID = in.readInt();
+    const String formatName (in.readString());
+    const String fileOrIdentifier (in.readString());
+
+    // plugins expect to be created on the message thread
+    (new ScanMessage (*this, requestID, formatName, fileOrIdentifier))->post();
+}
+
+void PluginScannerSlave::handleConnectionLost()
+{
+    JUCEApplicationBase::quit();
+}
+
+void PluginScannerSlave::scanAndReply (const int requestID, const String& formatName, const String& fileOrIdentifier)
+{
+    OwnedArray<PluginDescription> found;
+
+    for (int i = 0; i < formatManager.getNumFormats(); ++i)
+    {
+        AudioPluginFormat* const format = formatManager.getFormat (i);
+
+        if (format->getName() == formatName)
+        {
+            format->findAllTypesForFile (found, fileOrIdentifier);
+            break;
+        }
+    }
+
+    XmlElement xml ("PLUGINS");
+
+    for (int i = 0; i < found.size(); ++i)
+        xml.addChildElement (found.getUnchecked(i)->createXml());
+
+    MemoryOutputStream reply;
+    reply.writeInt (requestID);
+    reply.writeString (xml.createDocument (String::empty, true, false));
+
+    sendMessageToMaster (reply.getMemoryBlock());
+}
@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_OUTOFPROCESSPLUGINSCANNER_H_INCLUDED
+#define JUCE_OUTOFPROCESSPLUGINSCANNER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A KnownPluginList::CustomScanner that loads each plugin in a child process.
+
+    When a plugin crashes or hangs while it's being scanned, it only takes down
+    the child process, and the plugin gets blacklisted. Any plugin that takes
+    longer than the timeout to load is treated as if it had crashed, and its
+    process is killed.
+
+    The scanner keeps a pool of up to maxNumProcesses child processes, and
+    findPluginTypesFor() can be called from several threads at once, each one
+    using its own process. So to scan in parallel, give one of these to your
+    KnownPluginList, and call PluginDirectoryScanner::scanNextFile() from as many
+    threads as you have processes - e.g. with
+    PluginListComponent::setNumberOfThreadsForScanning().
+
+    The child processes run the executable that you give it, which may be your
+    own app. Its startup code needs to use a PluginScannerSlave to recognise that
+    it has been launched as a scanner - see PluginScannerSlave for an example.
+
+    @see PluginScannerSlave, KnownPluginList::setCustomScanner, PluginDirectoryScanner
+*/
+class JUCE_API  OutOfProcessPluginScanner  : public KnownPluginList::CustomScanner
+{
+public:
+    //==============================================================================
+    /** Creates a scanner.
+
+        @param scannerExecutable    the executable to launch as a child process. Its
+                                    startup code must pass its command-line to a
+                                    PluginScannerSlave, using the same commandLineID
+        @param maxNumProcesses      the maximum number of child processes to run at once
+        @param timeoutMsPerPlugin   how long a plugin may take to load before its process
+                                    is killed and it's blacklisted
+        @param commandLineID        a short alphanumeric string (no spaces) that's used
+                                    to recognise the scanner's command-line
+    */
+    OutOfProcessPluginScanner (const File& scannerExecutable,
+                               int maxNumProcesses,
+                               int timeoutMsPerPlugin = 30000,
+                               const String& commandLineID = defaultCommandLineID);
+
+    /** Destructor. This kills any child processes that are still running. */
+    ~OutOfProcessPluginScanner();
+
+    /** The ID that's used if you don't supply one. */
+    static const char* const defaultCommandLineID;
+
+    //==============================================================================
+    /** @internal */
+    bool findPluginTypesFor (AudioPluginFormat&, OwnedArray<PluginDescription>&,
+                             const String& fileOrIdentifier) override;
+    /** @internal */
+    void scanFinished() override;
+
+private:
+    //==============================================================================
+    struct ScannerProcess;
+    friend struct ScannerProcess;
+    friend struct ContainerDeletePolicy<ScannerProcess>;
+
+    const File executable;
+    const String commandLineID;
+    const int maxProcesses, timeoutMs;
+
+    CriticalSection lock;
+    OwnedArray<ScannerProcess> idleProcesses;
+    int numProcesses;
+    WaitableEvent processReleased;
+
+    ScannerProcess* getProcess();
+    void releaseProcess (ScannerProcess*, bool isStillUsable);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OutOfProcessPluginScanner)
+};
+
+//==============================================================================
+/**
+    The child-process end of an OutOfProcessPluginScanner.
+
+    Create one of these in your app's startup code, and if initialiseFromCommandLine()
+    returns true, the app has been launched as a scanner and should just keep its
+    message loop running without doing anything else. e.g.
+
+    @code
+    void initialise (const String& commandLine) override
+    {
+        formatManager.addDefaultFormats();
+
+        ScopedPointer<PluginScannerSlave> slave (new PluginScannerSlave (formatManager));
+
+        if (slave->initialiseFromCommandLine (commandLine, OutOfProcessPluginScanner::defaultCommandLineID))
+        {
+            scannerSlave = slave; // keep it alive until the app quits
+            return;
+        }
+
+        // ..otherwise carry on with your normal startup..
+    }
+    @endcode
+
+    The plugins are loaded on the message thread. When the master process goes
+    away, handleConnectionLost() calls JUCEApplicationBase::quit().
+*/
+class JUCE_API  PluginScannerSlave  : public ChildProcessSlave
+{
+public:
+    /** Creates a slave that uses the formats in the given manager, which must not be
+        deleted before this object is.
+    */
+    PluginScannerSlave (AudioPluginFormatManager& formatsToUse);
+
+    /** Destructor. */
+    ~PluginScannerSlave();
+
+    //==============================================================================
+    /** @internal */
+    void handleMessageFromMaster (const MemoryBlock&) override;
+    /** @internal */
+    void handleConnectionLost() override;
+
+private:
+    AudioPluginFormatManager& formatManager;
+
+    struct ScanMessage;
+    friend struct ScanMessage;
+
+    void scanAndReply (int requestID, const String& formatName, const String& fileOrIdentifier);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScannerSlave)
+};
+
+
+#endif   // JUCE_OUTOFPROCESSPLUGINSCANNER_H_INCLUDED
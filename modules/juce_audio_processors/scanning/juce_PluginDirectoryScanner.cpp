@@ -37,6 +37,7 @@ PluginDirectoryScanner::PluginDirectoryScanner (KnownPluginList& listToAddTo,
                                                 const File& deadMansPedal)
     : list (listToAddTo),
       format (formatToLookFor),
+      cache (nullptr),
       deadMansPedalFile (deadMansPedal),
       progress (0)
 {
@@ -86,21 +87,29 @@ bool PluginDirectoryScanner::scanNextFile (const bool dontRescanIfAlreadyInList,
     {
         const String file (filesOrIdentifiersToScan [index]);
 
-        if (file.isNotEmpty() && ! list.isListingUpToDate (file, format))
+        if (file.isNotEmpty() && ! isListingUpToDate (file))
         {
             nameOfPluginBeingScanned = format.getNameOfPluginFromIdentifier (file);
 
             OwnedArray <PluginDescription> typesFound;
 
             // Add this plugin to the end of the dead-man's pedal list in case it crashes...
-            StringArray crashedPlugins (readDeadMansPedalFile (deadMansPedalFile));
-            crashedPlugins.removeString (file);
-            crashedPlugins.add (file);
-            setDeadMansPedalFile (crashedPlugins);
+            {
+                const ScopedLock sl (deadMansPedalLock);
+
+                StringArray crashedPlugins (readDeadMansPedalFile (deadMansPedalFile));
+                crashedPlugins.removeString (file);
+                crashedPlugins.add (file);
+                setDeadMansPedalFile (crashedPlugins);
+            }
 
             list.scanAndAddFile (file, dontRescanIfAlreadyInList, typesFound, format);
 
             // Managed to load without crashing, so remove it from the dead-man's-pedal..
+            // (this re-reads the file, because other threads may be scanning at the same time)
+            const ScopedLock sl (deadMansPedalLock);
+
+            StringArray crashedPlugins (readDeadMansPedalFile (deadMansPedalFile));
             crashedPlugins.removeString (file);
             setDeadMansPedalFile (crashedPlugins);
 
@@ -113,6 +122,25 @@ bool PluginDirectoryScanner::scanNextFile (const bool dontRescanIfAlreadyInList,
     return index > 0;
 }
 
+bool PluginDirectoryScanner::isListingUpToDate (const String& file)
+{
+    if (cache != nullptr && cache->isUpToDate (file, format))
+    {
+        if (list.getTypeForFile (file) == nullptr)
+        {
+            OwnedArray<PluginDescription> cachedTypes;
+            cache->getTypesForFile (file, cachedTypes);
+
+            for (int i = 0; i < cachedTypes.size(); ++i)
+                list.addType (*cachedTypes.getUnchecked (i));
+        }
+
+        return true;
+    }
+
+    return list.isListingUpToDate (file, format);
+}
+
 bool PluginDirectoryScanner::skipNextFile()
 {
     updateProgress();
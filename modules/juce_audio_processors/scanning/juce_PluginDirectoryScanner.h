@@ -32,6 +32,11 @@
 
     To use one of these, create it and call scanNextFile() repeatedly, until
     it returns false.
+
+    scanNextFile() can be called from several threads at once. Plugins are normally
+    loaded in-process, so if you want a crashing or hanging plugin not to take your
+    app down with it, give the KnownPluginList an OutOfProcessPluginScanner, which
+    can also run a scanner process for each of your threads.
 */
 class JUCE_API  PluginDirectoryScanner
 {
@@ -103,6 +108,15 @@ public:
     */
     const StringArray& getFailedFiles() const noexcept              { return failedFiles; }
 
+    /** Gives the scanner a cache to check before scanning each file.
+
+        Any file that has an up-to-date entry in the cache is skipped, and if the list
+        doesn't already contain its types, they're added from the cache. The cache isn't
+        modified, so call KnownPluginListCache::save() when the scan has finished. The
+        cache must not be deleted before the scanner.
+    */
+    void setCache (KnownPluginListCache* cacheToUse) noexcept       { cache = cacheToUse; }
+
     /** Reads the given dead-mans-pedal file and applies its contents to the list. */
     static void applyBlacklistingsFromDeadMansPedal (KnownPluginList& listToApplyTo,
                                                      const File& deadMansPedalFile);
@@ -111,13 +125,16 @@ private:
     //==============================================================================
     KnownPluginList& list;
     AudioPluginFormat& format;
+    KnownPluginListCache* cache;
     StringArray filesOrIdentifiersToScan;
     File deadMansPedalFile;
     StringArray failedFiles;
+    CriticalSection deadMansPedalLock;
     Atomic<int> nextIndex;
     float progress;
 
     void updateProgress();
+    bool isListingUpToDate (const String& fileOrIdentifier);
     void setDeadMansPedalFile (const StringArray& newContents);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginDirectoryScanner)
@@ -72,23 +72,29 @@ private:
 };
 
 //==============================================================================
-class AudioThumbnail::LevelDataSource   : public TimeSliceClient
+class AudioThumbnail::LevelDataSource   : public TimeSliceClient,
+                                         public ThreadPoolJob
 {
 public:
     LevelDataSource (AudioThumbnail& thumb, AudioFormatReader* newReader, int64 hash)
-        : lengthInSamples (0), numSamplesFinished (0), sampleRate (0), numChannels (0),
+        : ThreadPoolJob ("thumbnail"),
+          lengthInSamples (0), numSamplesFinished (0), sampleRate (0), numChannels (0),
           hashCode (hash), owner (thumb), reader (newReader), lastReaderUseTime (0)
     {
     }
 
     LevelDataSource (AudioThumbnail& thumb, InputSource* src)
-        : lengthInSamples (0), numSamplesFinished (0), sampleRate (0), numChannels (0),
+        : ThreadPoolJob ("thumbnail"),
+          lengthInSamples (0), numSamplesFinished (0), sampleRate (0), numChannels (0),
           hashCode (src->hashCode()), owner (thumb), source (src), lastReaderUseTime (0)
     {
     }
 
     ~LevelDataSource()
     {
+        if (ThreadPool* const pool = owner.cache.getThreadPool())
+            pool->removeJob (this, true, -1);
+
         owner.cache.getTimeSliceThread().removeTimeSliceClient (this);
     }
 
@@ -110,6 +116,8 @@ public:
 
             if (lengthInSamples <= 0 || isFullyLoaded())
                 reader = nullptr;
+            else if (ThreadPool* const pool = owner.cache.getThreadPool())
+                pool->addJob (this, false);
             else
                 owner.cache.getTimeSliceThread().addTimeSliceClient (this);
         }
@@ -162,6 +170,10 @@ public:
             return -1;
         }
 
+        // if the cache has a thread pool, the blocks are being read by runJob() instead
+        if (owner.cache.getThreadPool() != nullptr)
+            return 200;
+
         bool justFinished = false;
 
         {
@@ -184,6 +196,27 @@ public:
         return 200;
     }
 
+    JobStatus runJob() override
+    {
+        {
+            const ScopedLock sl (readerLock);
+
+            createReader();
+
+            if (reader == nullptr)
+                return jobHasFinished;
+
+            if (! readNextBlock())
+                return jobNeedsRunningAgain;
+        }
+
+        owner.cache.storeThumb (owner, hashCode);
+
+        // the shared thread takes care of releasing the reader once it's no longer being used
+        owner.cache.getTimeSliceThread().addTimeSliceClient (this);
+        return jobHasFinished;
+    }
+
     bool isFullyLoaded() const noexcept
     {
         return numSamplesFinished >= lengthInSamples;
@@ -228,6 +261,7 @@ private:
                 const int firstThumbIndex = sampleToThumbSample (startSample);
                 const int lastThumbIndex  = sampleToThumbSample (startSample + numToDo);
                 const int numThumbSamps = lastThumbIndex - firstThumbIndex;
+                const int samplesPerThumbSample = owner.samplesPerThumbSample;
 
                 HeapBlock<MinMaxValue> levelData ((size_t) numThumbSamps * numChannels);
                 HeapBlock<MinMaxValue*> levels (numChannels);
@@ -235,15 +269,18 @@ private:
                 for (int i = 0; i < (int) numChannels; ++i)
                     levels[i] = levelData + i * numThumbSamps;
 
-                HeapBlock<Range<float> > levelsRead (numChannels);
+                // decode the whole block in one go, and then find the range of each thumb sample
+                AudioSampleBuffer samples ((int) numChannels, numThumbSamps * samplesPerThumbSample);
+                reader->read (&samples, 0, samples.getNumSamples(),
+                              firstThumbIndex * (int64) samplesPerThumbSample, true, true);
 
-                for (int i = 0; i < numThumbSamps; ++i)
+                for (int j = 0; j < (int) numChannels; ++j)
                 {
-                    reader->readMaxLevels ((firstThumbIndex + i) * owner.samplesPerThumbSample,
-                                           owner.samplesPerThumbSample, levelsRead, (int) numChannels);
+                    const float* const channelData = samples.getReadPointer (j);
 
-                    for (int j = 0; j < (int) numChannels; ++j)
-                        levels[j][i].setFloat (levelsRead[j]);
+                    for (int i = 0; i < numThumbSamps; ++i)
+                        levels[j][i].setFloat (FloatVectorOperations::findMinAndMax (channelData + i * samplesPerThumbSample,
+                                                                                     samplesPerThumbSample));
                 }
 
                 {
@@ -268,6 +305,7 @@ public:
         : peakLevel (-1)
     {
         ensureSize (numThumbSamples);
+        updateDecimatedLevels (0, numThumbSamples);
     }
 
     inline MinMaxValue* getData (const int thumbSampleIndex) noexcept
@@ -290,14 +328,30 @@ public:
             char mx = -128;
             char mn = 127;
 
+            const Array<MinMaxValue>* level = &data;
+            int levelIndex = 0;
+
             while (startSample <= endSample)
             {
-                const MinMaxValue& v = data.getReference (startSample);
+                if (levelIndex < decimatedLevels.size() && endSample - startSample >= 2 * decimationFactor)
+                {
+                    // scan the unaligned ends at this resolution, and then do the rest
+                    // of the range using the next, coarser level
+                    for (; startSample % decimationFactor != 0; ++startSample)
+                        addToRange (level->getReference (startSample), mn, mx);
 
-                if (v.getMinValue() < mn)  mn = v.getMinValue();
-                if (v.getMaxValue() > mx)  mx = v.getMaxValue();
+                    for (; (endSample + 1) % decimationFactor != 0; --endSample)
+                        addToRange (level->getReference (endSample), mn, mx);
 
-                ++startSample;
+                    startSample /= decimationFactor;
+                    endSample = (endSample + 1) / decimationFactor - 1;
+                    level = decimatedLevels.getUnchecked (levelIndex++);
+                }
+                else
+                {
+                    for (; startSample <= endSample; ++startSample)
+                        addToRange (level->getReference (startSample), mn, mx);
+                }
             }
 
             if (mn <= mx)
@@ -314,13 +368,55 @@ public:
     {
         resetPeak();
 
-        if (startIndex + numValues > data.size())
+        const int oldSize = data.size();
+
+        if (startIndex + numValues > oldSize)
             ensureSize (startIndex + numValues);
 
         MinMaxValue* const dest = getData (startIndex);
 
         for (int i = 0; i < numValues; ++i)
             dest[i] = values[i];
+
+        updateDecimatedLevels (jmin (startIndex, oldSize), startIndex + numValues);
+    }
+
+    // Recalculates the coarser levels that cover the given range of thumb samples
+    void updateDecimatedLevels (int startIndex, int endIndex)
+    {
+        const Array<MinMaxValue>* source = &data;
+
+        for (int levelIndex = 0; source->size() > decimationFactor; ++levelIndex)
+        {
+            if (levelIndex >= decimatedLevels.size())
+                decimatedLevels.add (new Array<MinMaxValue>());
+
+            Array<MinMaxValue>& level = *decimatedLevels.getUnchecked (levelIndex);
+
+            const int oldSize = level.size();
+            const int newSize = (source->size() + decimationFactor - 1) / decimationFactor;
+
+            if (newSize > oldSize)
+                level.insertMultiple (-1, MinMaxValue(), newSize - oldSize);
+
+            startIndex = jmin (startIndex / decimationFactor, oldSize);
+            endIndex = jmin ((endIndex + decimationFactor - 1) / decimationFactor, newSize);
+
+            for (int i = startIndex; i < endIndex; ++i)
+            {
+                char mx = -128;
+                char mn = 127;
+
+                const int end = jmin (source->size(), (i + 1) * decimationFactor);
+
+                for (int j = i * decimationFactor; j < end; ++j)
+                    addToRange (source->getReference (j), mn, mx);
+
+                level.getReference (i).set (mn, mx);
+            }
+
+            source = &level;
+        }
     }
 
     void resetPeak() noexcept
@@ -332,9 +428,12 @@ public:
     {
         if (peakLevel < 0)
         {
-            for (int i = 0; i < data.size(); ++i)
+            // the coarsest level covers the same range of values as the full-resolution data
+            const Array<MinMaxValue>& level = decimatedLevels.size() > 0 ? *decimatedLevels.getLast() : data;
+
+            for (int i = 0; i < level.size(); ++i)
             {
-                const int peak = data[i].getPeak();
+                const int peak = level[i].getPeak();
                 if (peak > peakLevel)
                     peakLevel = peak;
             }
@@ -344,9 +443,21 @@ public:
     }
 
 private:
+    // Each of the decimated levels holds the combined ranges of groups of this many
+    // values from the level below it, so that getMinMax() only needs to look at a
+    // handful of values from each level, however long the range is.
+    enum { decimationFactor = 8 };
+
     Array<MinMaxValue> data;
+    OwnedArray<Array<MinMaxValue> > decimatedLevels;
     int peakLevel;
 
+    static inline void addToRange (const MinMaxValue& v, char& mn, char& mx) noexcept
+    {
+        if (v.getMinValue() < mn)  mn = v.getMinValue();
+        if (v.getMaxValue() > mx)  mx = v.getMaxValue();
+    }
+
     void ensureSize (const int thumbSamples)
     {
         const int extraNeeded = thumbSamples - data.size();
@@ -377,14 +488,16 @@ public:
                       const double rate, const int numChans, const int sampsPerThumbSample,
                       LevelDataSource* levelData, const OwnedArray<ThumbData>& chans)
     {
-        if (refillCache (area.getWidth(), startTime, endTime, rate,
-                         numChans, sampsPerThumbSample, levelData, chans)
+        if (updateWindow (area.getWidth(), startTime, endTime, rate, numChans)
              && isPositiveAndBelow (channelNum, numChannelsCached))
         {
             const Rectangle<int> clip (g.getClipBounds().getIntersection (area.withWidth (jmin (numSamplesCached, area.getWidth()))));
 
             if (! clip.isEmpty())
             {
+                fillColumns (Range<int> (clip.getX(), clip.getRight()) - area.getX(),
+                             rate, sampsPerThumbSample, levelData, chans);
+
                 const float topY = (float) area.getY();
                 const float bottomY = (float) area.getBottom();
                 const float midY = (topY + bottomY) * 0.5f;
@@ -420,11 +533,14 @@ private:
     Array<MinMaxValue> data;
     double cachedStart, cachedTimePerPixel;
     int numChannelsCached, numSamplesCached;
+    Range<int> validColumns;
     bool cacheNeedsRefilling;
 
-    bool refillCache (const int numSamples, double startTime, const double endTime,
-                      const double rate, const int numChans, const int sampsPerThumbSample,
-                      LevelDataSource* levelData, const OwnedArray<ThumbData>& chans)
+    // Lines the cache up with the area being drawn. If the view has only been scrolled by a
+    // whole number of pixels, the columns that are still visible are moved along rather
+    // than being thrown away, so that only the newly exposed ones need to be calculated.
+    bool updateWindow (const int numSamples, const double startTime, const double endTime,
+                       const double rate, const int numChans)
     {
         const double timePerPixel = (endTime - startTime) / numSamples;
 
@@ -434,85 +550,141 @@ private:
             return false;
         }
 
-        if (numSamples == numSamplesCached
-             && numChannelsCached == numChans
-             && startTime == cachedStart
-             && timePerPixel == cachedTimePerPixel
-             && ! cacheNeedsRefilling)
+        // (the scale is compared loosely, because scrolling a fixed-length range can
+        // change the last bits of its length)
+        if (numSamples != numSamplesCached
+             || numChannelsCached != numChans
+             || std::abs (timePerPixel - cachedTimePerPixel) > cachedTimePerPixel * 1.0e-9
+             || cacheNeedsRefilling)
         {
-            return ! cacheNeedsRefilling;
+            numSamplesCached = numSamples;
+            numChannelsCached = numChans;
+            cachedTimePerPixel = timePerPixel;
+            cacheNeedsRefilling = false;
+            validColumns = Range<int>();
+            ensureSize (numSamples);
+        }
+        else if (startTime != cachedStart)
+        {
+            const double pixelsMoved = (startTime - cachedStart) / timePerPixel;
+            const int shift = roundToInt (pixelsMoved);
+
+            if (std::abs (pixelsMoved - shift) < 0.001 && std::abs (shift) < numSamples)
+                shiftColumns (shift);
+            else
+                validColumns = Range<int>();
         }
 
-        numSamplesCached = numSamples;
-        numChannelsCached = numChans;
         cachedStart = startTime;
-        cachedTimePerPixel = timePerPixel;
-        cacheNeedsRefilling = false;
+        return true;
+    }
+
+    void shiftColumns (const int shift) noexcept
+    {
+        const Range<int> remaining ((validColumns - shift).getIntersectionWith (Range<int> (0, numSamplesCached)));
+
+        if (remaining.isEmpty())
+        {
+            validColumns = Range<int>();
+            return;
+        }
+
+        for (int chan = 0; chan < numChannelsCached; ++chan)
+            memmove (getData (chan, remaining.getStart()),
+                     getData (chan, remaining.getStart() + shift),
+                     sizeof (MinMaxValue) * (size_t) remaining.getLength());
 
-        ensureSize (numSamples);
+        validColumns = remaining;
+    }
+
+    // Makes sure that the given columns have been calculated. The valid section of the
+    // cache is kept contiguous, so if the new columns don't touch it, it's started again.
+    void fillColumns (Range<int> columns, const double rate, const int sampsPerThumbSample,
+                      LevelDataSource* levelData, const OwnedArray<ThumbData>& chans)
+    {
+        columns = columns.getIntersectionWith (Range<int> (0, numSamplesCached));
+
+        if (validColumns.isEmpty()
+             || columns.getEnd() < validColumns.getStart()
+             || columns.getStart() > validColumns.getEnd())
+        {
+            calculateColumns (columns, rate, sampsPerThumbSample, levelData, chans);
+            validColumns = columns;
+            return;
+        }
+
+        if (columns.getStart() < validColumns.getStart())
+            calculateColumns (Range<int> (columns.getStart(), validColumns.getStart()),
+                              rate, sampsPerThumbSample, levelData, chans);
+
+        if (columns.getEnd() > validColumns.getEnd())
+            calculateColumns (Range<int> (validColumns.getEnd(), columns.getEnd()),
+                              rate, sampsPerThumbSample, levelData, chans);
+
+        validColumns = validColumns.getUnionWith (columns);
+    }
+
+    void calculateColumns (const Range<int> columns, const double rate, const int sampsPerThumbSample,
+                           LevelDataSource* levelData, const OwnedArray<ThumbData>& chans)
+    {
+        if (columns.isEmpty())
+            return;
+
+        // (each column's time is worked out from its index rather than by accumulating,
+        // so that it always gets the same value however the cache was filled)
+        const double timePerPixel = cachedTimePerPixel;
 
         if (timePerPixel * rate <= sampsPerThumbSample && levelData != nullptr)
         {
-            int sample = roundToInt (startTime * rate);
             Array<Range<float> > levels;
+            int sample = roundToInt ((cachedStart + columns.getStart() * timePerPixel) * rate);
 
-            int i;
-            for (i = 0; i < numSamples; ++i)
+            for (int i = columns.getStart(); i < columns.getEnd(); ++i)
             {
-                const int nextSample = roundToInt ((startTime + timePerPixel) * rate);
+                const int nextSample = roundToInt ((cachedStart + (i + 1) * timePerPixel) * rate);
 
-                if (sample >= 0)
+                if (sample < 0 || sample >= levelData->lengthInSamples)
                 {
-                    if (sample >= levelData->lengthInSamples)
-                    {
-                        for (int chan = 0; chan < numChannelsCached; ++chan)
-                            *getData (chan, i) = MinMaxValue();
-                    }
-                    else
-                    {
-                        levelData->getLevels (sample, jmax (1, nextSample - sample), levels);
+                    for (int chan = 0; chan < numChannelsCached; ++chan)
+                        *getData (chan, i) = MinMaxValue();
+                }
+                else
+                {
+                    levelData->getLevels (sample, jmax (1, nextSample - sample), levels);
 
-                        const int totalChans = jmin (levels.size(), numChannelsCached);
+                    const int totalChans = jmin (levels.size(), numChannelsCached);
 
-                        for (int chan = 0; chan < totalChans; ++chan)
-                            getData (chan, i)->setFloat (levels.getReference (chan));
-                    }
+                    for (int chan = 0; chan < totalChans; ++chan)
+                        getData (chan, i)->setFloat (levels.getReference (chan));
                 }
 
-                startTime += timePerPixel;
                 sample = nextSample;
             }
-
-            numSamplesCached = i;
         }
         else
         {
             jassert (chans.size() == numChannelsCached);
 
+            const double timeToThumbSampleFactor = rate / (double) sampsPerThumbSample;
+
             for (int channelNum = 0; channelNum < numChannelsCached; ++channelNum)
             {
                 ThumbData* channelData = chans.getUnchecked (channelNum);
-                MinMaxValue* cacheData = getData (channelNum, 0);
-
-                const double timeToThumbSampleFactor = rate / (double) sampsPerThumbSample;
+                MinMaxValue* cacheData = getData (channelNum, columns.getStart());
 
-                startTime = cachedStart;
-                int sample = roundToInt (startTime * timeToThumbSampleFactor);
+                int sample = roundToInt ((cachedStart + columns.getStart() * timePerPixel) * timeToThumbSampleFactor);
 
-                for (int i = numSamples; --i >= 0;)
+                for (int i = columns.getStart(); i < columns.getEnd(); ++i)
                 {
-                    const int nextSample = roundToInt ((startTime + timePerPixel) * timeToThumbSampleFactor);
+                    const int nextSample = roundToInt ((cachedStart + (i + 1) * timePerPixel) * timeToThumbSampleFactor);
 
                     channelData->getMinMax (sample, nextSample, *cacheData);
 
                     ++cacheData;
-                    startTime += timePerPixel;
                     sample = nextSample;
                 }
             }
         }
-
-        return true;
     }
 
     MinMaxValue* getData (const int channelNum, const int cacheIndex) noexcept
@@ -613,6 +785,9 @@ bool AudioThumbnail::loadFrom (InputStream& rawInput)
         for (int chan = 0; chan < numChannels; ++chan)
             channels.getUnchecked(chan)->getData(i)->read (input);
 
+    for (int chan = 0; chan < numChannels; ++chan)
+        channels.getUnchecked(chan)->updateDecimatedLevels (0, numThumbnailSamples);
+
     return true;
 }
 
@@ -63,6 +63,21 @@ AudioThumbnailCache::AudioThumbnailCache (const int maxNumThumbs)
     thread.startThread (2);
 }
 
+AudioThumbnailCache::AudioThumbnailCache (const int maxNumThumbs, const int numThreadsForGeneration)
+    : thread ("thumb cache"),
+      maxNumThumbsToStore (maxNumThumbs)
+{
+    jassert (maxNumThumbsToStore > 0);
+    jassert (numThreadsForGeneration > 0);
+    thread.startThread (2);
+
+    if (numThreadsForGeneration > 1)
+    {
+        pool = new ThreadPool (numThreadsForGeneration);
+        pool->setThreadPriorities (2);
+    }
+}
+
 AudioThumbnailCache::~AudioThumbnailCache()
 {
 }
@@ -32,7 +32,8 @@
 
     The cache runs a single background thread that is shared by all the thumbnails
     that need it, and it maintains a set of low-res previews in memory, to avoid
-    having to re-scan audio files too often.
+    having to re-scan audio files too often. It can optionally also run a pool of
+    threads, so that several thumbnails can be generated in parallel.
 
     @see AudioThumbnail
 */
@@ -47,6 +48,15 @@ public:
     */
     explicit AudioThumbnailCache (int maxNumThumbsToStore);
 
+    /** Creates a cache object which generates its thumbnails on a pool of threads.
+
+        The maxNumThumbsToStore parameter lets you specify how many previews should
+        be kept in memory at once, and numThreadsForGeneration is the number of files
+        that may be scanned at the same time. If this is 1, then the thumbnails will
+        all share the cache's single background thread.
+    */
+    AudioThumbnailCache (int maxNumThumbsToStore, int numThreadsForGeneration);
+
     /** Destructor. */
     virtual ~AudioThumbnailCache();
 
@@ -87,6 +97,11 @@ public:
     /** Returns the thread that client thumbnails can use. */
     TimeSliceThread& getTimeSliceThread() noexcept      { return thread; }
 
+    /** Returns the pool that client thumbnails should use to generate their data, or
+        nullptr if they should use the time-slice thread instead.
+    */
+    ThreadPool* getThreadPool() const noexcept          { return pool; }
+
 protected:
     /** This can be overridden to provide a custom callback for saving thumbnails
         once they have finished being loaded.
@@ -101,6 +116,7 @@ protected:
 private:
     //==============================================================================
     TimeSliceThread thread;
+    ScopedPointer<ThreadPool> pool;
 
     class ThumbnailCacheEntry;
     friend struct ContainerDeletePolicy<ThumbnailCacheEntry>;
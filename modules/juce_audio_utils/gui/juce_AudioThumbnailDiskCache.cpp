@@ -0,0 +1,277 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+static inline int getThumbnailDiskCacheIndexMagic() noexcept   { return (int) ByteOrder::littleEndianInt ("ThmI"); }
+static inline int getThumbnailDiskCacheFileMagic() noexcept    { return (int) ByteOrder::littleEndianInt ("ThmD"); }
+
+enum { thumbnailIndexHeaderSize = 8, thumbnailIndexEntrySize = 24 };
+
+//==============================================================================
+AudioThumbnailDiskCache::AudioThumbnailDiskCache (const File& cacheDirectory, int maxNumThumbsInMemory,
+                                                  int64 maxBytesOnDisk, int numThreadsForGeneration)
+    : AudioThumbnailCache (maxNumThumbsInMemory, numThreadsForGeneration),
+      directory (cacheDirectory),
+      maxDiskUsage (maxBytesOnDisk),
+      totalDiskUsage (0),
+      indexNeedsWriting (false)
+{
+    jassert (maxDiskUsage > 0);
+
+    directory.createDirectory();
+    readIndex();
+}
+
+AudioThumbnailDiskCache::~AudioThumbnailDiskCache()
+{
+    flushIndex();
+}
+
+//==============================================================================
+int AudioThumbnailDiskCache::getNumThumbsOnDisk() const
+{
+    const ScopedLock sl (indexLock);
+    return index.size();
+}
+
+int64 AudioThumbnailDiskCache::getDiskUsage() const
+{
+    const ScopedLock sl (indexLock);
+    return totalDiskUsage;
+}
+
+void AudioThumbnailDiskCache::setMaximumDiskUsage (int64 maxBytesOnDisk)
+{
+    const ScopedLock sl (indexLock);
+    maxDiskUsage = maxBytesOnDisk;
+    removeLeastRecentlyUsedThumbs();
+}
+
+void AudioThumbnailDiskCache::clearDiskCache()
+{
+    const ScopedLock sl (indexLock);
+
+    for (HashMap<int64, IndexEntry>::Iterator i (index); i.next();)
+        getFileForThumb (i.getKey()).deleteFile();
+
+    index.clear();
+    totalDiskUsage = 0;
+    indexNeedsWriting = true;
+    flushIndex();
+}
+
+void AudioThumbnailDiskCache::flushIndex()
+{
+    const ScopedLock sl (indexLock);
+
+    if (indexNeedsWriting)
+    {
+        indexNeedsWriting = false;
+        writeIndex();
+    }
+}
+
+//==============================================================================
+void AudioThumbnailDiskCache::saveNewlyFinishedThumbnail (const AudioThumbnailBase& thumb, int64 hashCode)
+{
+    const File file (getFileForThumb (hashCode));
+
+    {
+        TemporaryFile temp (file);
+
+        {
+            FileOutputStream out (temp.getFile());
+
+            if (! out.openedOk())
+                return;
+
+            out.writeInt (getThumbnailDiskCacheFileMagic());
+            out.writeInt64 (hashCode);
+
+            GZIPCompressorOutputStream compressor (&out);
+            thumb.saveTo (compressor);
+        }
+
+        if (! temp.overwriteTargetFileWithTemporary())
+            return;
+    }
+
+    const ScopedLock sl (indexLock);
+
+    if (index.contains (hashCode))
+        totalDiskUsage -= index [hashCode].size;
+
+    IndexEntry entry = { hashCode, file.getSize(), Time::currentTimeMillis() };
+    index.set (hashCode, entry);
+    totalDiskUsage += entry.size;
+    indexNeedsWriting = true;
+
+    removeLeastRecentlyUsedThumbs();
+    flushIndex();
+}
+
+bool AudioThumbnailDiskCache::loadNewThumb (AudioThumbnailBase& thumb, int64 hashCode)
+{
+    {
+        const ScopedLock sl (indexLock);
+
+        if (! index.contains (hashCode))
+            return false;
+    }
+
+    FileInputStream in (getFileForThumb (hashCode));
+
+    if (in.openedOk()
+         && in.readInt() == getThumbnailDiskCacheFileMagic()
+         && in.readInt64() == hashCode)
+    {
+        GZIPDecompressorInputStream decompressor (in);
+
+        if (thumb.loadFrom (decompressor))
+        {
+            const ScopedLock sl (indexLock);
+
+            IndexEntry entry (index [hashCode]);
+            entry.lastUsed = Time::currentTimeMillis();
+            index.set (hashCode, entry);
+            indexNeedsWriting = true;
+            return true;
+        }
+    }
+
+    // the file is missing or damaged, so it'll need to be re-created
+    const ScopedLock sl (indexLock);
+    removeEntry (hashCode);
+    return false;
+}
+
+//==============================================================================
+File AudioThumbnailDiskCache::getIndexFile() const
+{
+    return directory.getChildFile ("index");
+}
+
+File AudioThumbnailDiskCache::getFileForThumb (int64 hashCode) const
+{
+    return directory.getChildFile (String::toHexString (hashCode)).withFileExtension ("thumb");
+}
+
+void AudioThumbnailDiskCache::removeEntry (int64 hashCode)
+{
+    if (index.contains (hashCode))
+    {
+        totalDiskUsage -= index [hashCode].size;
+        index.remove (hashCode);
+        indexNeedsWriting = true;
+    }
+
+    getFileForThumb (hashCode).deleteFile();
+}
+
+void AudioThumbnailDiskCache::removeLeastRecentlyUsedThumbs()
+{
+    if (totalDiskUsage <= maxDiskUsage)
+        return;
+
+    Array<IndexEntry> entries;
+
+    for (HashMap<int64, IndexEntry>::Iterator i (index); i.next();)
+        entries.add (i.getValue());
+
+    struct OldestFirst
+    {
+        static int compareElements (const IndexEntry& first, const IndexEntry& second) noexcept
+        {
+            return first.lastUsed < second.lastUsed ? -1 : (first.lastUsed > second.lastUsed ? 1 : 0);
+        }
+    };
+
+    OldestFirst comparator;
+    entries.sort (comparator);
+
+    for (int i = 0; i < entries.size() && totalDiskUsage > maxDiskUsage; ++i)
+        removeEntry (entries.getReference (i).hash);
+}
+
+//==============================================================================
+void AudioThumbnailDiskCache::readIndex()
+{
+    index.clear();
+    totalDiskUsage = 0;
+
+    const File indexFile (getIndexFile());
+
+    if (indexFile.existsAsFile())
+    {
+        const MemoryMappedFile mappedIndex (indexFile, MemoryMappedFile::readOnly);
+        const char* const data = static_cast<const char*> (mappedIndex.getData());
+        const size_t size = mappedIndex.getSize();
+
+        if (data != nullptr && size >= thumbnailIndexHeaderSize
+             && (int) ByteOrder::littleEndianInt (data) == getThumbnailDiskCacheIndexMagic())
+        {
+            const int numEntries = jmin ((int) ByteOrder::littleEndianInt (data + 4),
+                                         (int) ((size - thumbnailIndexHeaderSize) / thumbnailIndexEntrySize));
+
+            for (int i = 0; i < numEntries; ++i)
+            {
+                const char* const e = data + thumbnailIndexHeaderSize + i * thumbnailIndexEntrySize;
+
+                IndexEntry entry;
+                entry.hash     = (int64) ByteOrder::littleEndianInt64 (e);
+                entry.size     = (int64) ByteOrder::littleEndianInt64 (e + 8);
+                entry.lastUsed = (int64) ByteOrder::littleEndianInt64 (e + 16);
+
+                index.set (entry.hash, entry);
+                totalDiskUsage += entry.size;
+            }
+        }
+    }
+
+    removeLeastRecentlyUsedThumbs();
+}
+
+void AudioThumbnailDiskCache::writeIndex()
+{
+    TemporaryFile temp (getIndexFile());
+
+    {
+        FileOutputStream out (temp.getFile());
+
+        if (! out.openedOk())
+            return;
+
+        out.writeInt (getThumbnailDiskCacheIndexMagic());
+        out.writeInt (index.size());
+
+        for (HashMap<int64, IndexEntry>::Iterator i (index); i.next();)
+        {
+            const IndexEntry& entry = i.getValue();
+            out.writeInt64 (entry.hash);
+            out.writeInt64 (entry.size);
+            out.writeInt64 (entry.lastUsed);
+        }
+    }
+
+    temp.overwriteTargetFileWithTemporary();
+}
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_AUDIOTHUMBNAILDISKCACHE_H_INCLUDED
+#define JUCE_AUDIOTHUMBNAILDISKCACHE_H_INCLUDED
+
+
+//==============================================================================
+/**
+    An AudioThumbnailCache that also keeps every finished thumbnail in a folder on disk,
+    so that thumbnails can be re-loaded, rather than re-scanned, after an app restarts.
+
+    Each thumbnail is stored as a compressed file named after its hash code. Because a
+    FileInputSource's hash includes the file's modification time, thumbnails for files
+    that have changed just won't be found, and will eventually be evicted.
+
+    The folder also contains a small index file recording the size and last-use time of
+    each stored thumbnail. When the total size goes over the limit, the least recently
+    used thumbnails are deleted.
+
+    @see AudioThumbnailCache, AudioThumbnail
+*/
+class JUCE_API  AudioThumbnailDiskCache  : public AudioThumbnailCache
+{
+public:
+    //==============================================================================
+    /** Creates a cache that stores its thumbnails in the given folder.
+
+        @param cacheDirectory           the folder to use - it will be created if it doesn't exist
+        @param maxNumThumbsInMemory     the number of thumbnails to keep in memory, as for the
+                                        AudioThumbnailCache constructor
+        @param maxBytesOnDisk           the total size that the stored thumbnails are allowed to use
+        @param numThreadsForGeneration  the number of files that may be scanned in parallel, as for
+                                        the AudioThumbnailCache constructor
+    */
+    AudioThumbnailDiskCache (const File& cacheDirectory, int maxNumThumbsInMemory,
+                             int64 maxBytesOnDisk, int numThreadsForGeneration = 1);
+
+    /** Destructor. This writes out any changes to the index. */
+    ~AudioThumbnailDiskCache();
+
+    //==============================================================================
+    /** Returns the folder in which the thumbnails are being stored. */
+    const File& getCacheDirectory() const noexcept      { return directory; }
+
+    /** Returns the number of thumbnails that are currently stored on disk. */
+    int getNumThumbsOnDisk() const;
+
+    /** Returns the total size of the thumbnails that are currently stored on disk. */
+    int64 getDiskUsage() const;
+
+    /** Changes the maximum total size of the stored thumbnails, deleting some if needed. */
+    void setMaximumDiskUsage (int64 maxBytesOnDisk);
+
+    /** Deletes all the thumbnails that are stored on disk. */
+    void clearDiskCache();
+
+    /** Writes the index file, if it has changed since it was last written. */
+    void flushIndex();
+
+protected:
+    //==============================================================================
+    /** @internal */
+    void saveNewlyFinishedThumbnail (const AudioThumbnailBase&, int64 hashCode) override;
+    /** @internal */
+    bool loadNewThumb (AudioThumbnailBase&, int64 hashCode) override;
+
+private:
+    //==============================================================================
+    struct IndexEntry
+    {
+        int64 hash, size, lastUsed;
+    };
+
+    const File directory;
+    HashMap<int64, IndexEntry> index;
+    CriticalSection indexLock;
+    int64 maxDiskUsage, totalDiskUsage;
+    bool indexNeedsWriting;
+
+    File getIndexFile() const;
+    File getFileForThumb (int64 hashCode) const;
+    void readIndex();
+    void writeIndex();
+    void removeEntry (int64 hashCode);
+    void removeLeastRecentlyUsedThumbs();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioThumbnailDiskCache)
+};
+
+
+#endif   // JUCE_AUDIOTHUMBNAILDISKCACHE_H_INCLUDED
@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+SpectrogramComponent::SpectrogramComponent (const int fftOrder, const int columns, const int rows)
+    : fft (fftOrder, false),
+      fftSize (1 << fftOrder),
+      numBins ((1 << fftOrder) / 2),
+      numColumns (jmax (1, columns)),
+      numRows (jmax (1, rows)),
+      window ((size_t) fftSize),
+      inputSamples ((size_t) fftSize, true),
+      fftData ((size_t) fftSize * 2),
+      frameData ((size_t) (fifoSizeInFrames * numBins)),
+      inputPos (0),
+      samplesUntilNextFrame (fftSize),
+      frameFifo (fifoSizeInFrames),
+      imageType (new SoftwareImageType()),
+      nextColumn (0),
+      rowStartBins ((size_t) numRows + 1),
+      minDecibels (-100.0f),
+      maxDecibels (0.0f)
+{
+    // A hann window, scaled so that a full-scale sine wave gives a magnitude of 1
+    double windowSum = 0;
+
+    for (int i = 0; i < fftSize; ++i)
+    {
+        window[i] = (float) (0.5 - 0.5 * std::cos (2.0 * double_Pi * i / fftSize));
+        windowSum += window[i];
+    }
+
+    FloatVectorOperations::multiply (window, (float) (2.0 / windowSum), fftSize);
+
+    // Row 0 is the bottom of the image. Each row covers the bins between its start and the
+    // next row's start, and always at least one bin, so that none are missed out.
+    for (int row = 0; row <= numRows; ++row)
+        rowStartBins[row] = row == 0 ? 0 : jlimit (0, numBins, roundToInt (std::pow ((double) numBins, row / (double) numRows)));
+
+    ColourGradient colours (Colours::black, 0.0f, 0.0f, Colours::white, 1.0f, 0.0f, false);
+    colours.addColour (0.25, Colour (0xff1a0a66));
+    colours.addColour (0.5,  Colour (0xffb0306a));
+    colours.addColour (0.75, Colour (0xfff59a32));
+    setColourMap (colours);
+
+    setOpaque (true);
+    startTimerHz (60);
+}
+
+SpectrogramComponent::~SpectrogramComponent()
+{
+    stopTimer();
+}
+
+//==============================================================================
+void SpectrogramComponent::pushSamples (const float* samples, int numSamples) noexcept
+{
+    while (numSamples > 0)
+    {
+        const int num = jmin (numSamples, samplesUntilNextFrame, fftSize - inputPos);
+
+        FloatVectorOperations::copy (inputSamples + inputPos, samples, num);
+        inputPos = (inputPos + num) % fftSize;
+        samplesUntilNextFrame -= num;
+        samples += num;
+        numSamples -= num;
+
+        if (samplesUntilNextFrame == 0)
+        {
+            samplesUntilNextFrame = numBins;
+
+            // the input is a ring buffer, so the oldest sample is the one at inputPos
+            const int numToEnd = fftSize - inputPos;
+            FloatVectorOperations::multiply (fftData, inputSamples + inputPos, window, numToEnd);
+            FloatVectorOperations::multiply (fftData + numToEnd, inputSamples, window + numToEnd, inputPos);
+            FloatVectorOperations::clear (fftData + fftSize, fftSize);
+
+            fft.performFrequencyOnlyForwardTransform (fftData);
+
+            int start1, size1, start2, size2;
+            frameFifo.prepareToWrite (1, start1, size1, start2, size2);
+
+            if (size1 > 0)
+            {
+                FloatVectorOperations::copy (frameData + start1 * numBins, fftData, numBins);
+                frameFifo.finishedWrite (1);
+            }
+        }
+    }
+}
+
+//==============================================================================
+void SpectrogramComponent::setLevelRange (const float newMinDecibels, const float newMaxDecibels)
+{
+    jassert (newMaxDecibels > newMinDecibels);
+
+    minDecibels = newMinDecibels;
+    maxDecibels = jmax (newMinDecibels + 1.0f, newMaxDecibels);
+}
+
+void SpectrogramComponent::setColourMap (const ColourGradient& colours)
+{
+    for (int i = 0; i < numElementsInArray (colourTable); ++i)
+        colourTable[i] = colours.getColourAtPosition (i / 255.0).withAlpha (1.0f).getPixelARGB();
+}
+
+void SpectrogramComponent::setImageType (ImageType* const newImageType)
+{
+    jassert (newImageType != nullptr);
+
+    if (newImageType != nullptr)
+    {
+        imageType = newImageType;
+        image = Image();
+        repaint();
+    }
+}
+
+void SpectrogramComponent::clear()
+{
+    frameFifo.finishedRead (frameFifo.getNumReady());
+
+    if (image.isValid())
+        image.clear (image.getBounds(), Colour (colourTable[0].getARGB()));
+
+    nextColumn = 0;
+    repaint();
+}
+
+//==============================================================================
+void SpectrogramComponent::timerCallback()
+{
+    if (frameFifo.getNumReady() > 0)
+        repaint();
+}
+
+void SpectrogramComponent::paint (Graphics& g)
+{
+    // (the image is created here rather than earlier, because some image types,
+    // e.g. OpenGL ones, can only be created while their context is active)
+    if (image.isNull())
+    {
+        image = Image (Image::ARGB, numColumns, numRows, false, *imageType);
+        image.clear (image.getBounds(), Colour (colourTable[0].getARGB()));
+        nextColumn = 0;
+    }
+
+    writeNewColumns();
+
+    const int w = getWidth();
+    const int h = getHeight();
+    const int numOldColumns = numColumns - nextColumn;
+    const int split = roundToInt (numOldColumns * w / (double) numColumns);
+
+    g.setImageResamplingQuality (Graphics::lowResamplingQuality);
+    g.drawImage (image, 0, 0, split, h, nextColumn, 0, numOldColumns, numRows);
+
+    if (nextColumn > 0)
+        g.drawImage (image, split, 0, w - split, h, 0, 0, nextColumn, numRows);
+}
+
+void SpectrogramComponent::writeNewColumns()
+{
+    const int numReady = frameFifo.getNumReady();
+
+    if (numReady > 0)
+    {
+        int start1, size1, start2, size2;
+        frameFifo.prepareToRead (numReady, start1, size1, start2, size2);
+
+        for (int i = 0; i < size1; ++i)
+            writeColumn (frameData + (start1 + i) * numBins);
+
+        for (int i = 0; i < size2; ++i)
+            writeColumn (frameData + (start2 + i) * numBins);
+
+        frameFifo.finishedRead (size1 + size2);
+    }
+}
+
+void SpectrogramComponent::writeColumn (const float* const magnitudes)
+{
+    const Image::BitmapData pixels (image, nextColumn, 0, 1, numRows, Image::BitmapData::writeOnly);
+    const float scale = 255.0f / (maxDecibels - minDecibels);
+
+    for (int row = 0; row < numRows; ++row)
+    {
+        const int startBin = rowStartBins[row];
+        const int endBin = jmin (numBins, jmax (startBin + 1, rowStartBins[row + 1]));
+        float peak = 0;
+
+        for (int i = startBin; i < endBin; ++i)
+            peak = jmax (peak, magnitudes[i]);
+
+        const float level = Decibels::gainToDecibels (peak, minDecibels);
+        const int index = jlimit (0, 255, (int) ((level - minDecibels) * scale));
+
+        reinterpret_cast<PixelARGB*> (pixels.getPixelPointer (0, numRows - 1 - row))->set (colourTable[index]);
+    }
+
+    nextColumn = (nextColumn + 1) % numColumns;
+}
@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_SPECTROGRAMCOMPONENT_H_INCLUDED
+#define JUCE_SPECTROGRAMCOMPONENT_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A component that draws a scrolling spectrogram of an audio signal.
+
+    Call pushSamples() from your audio callback. Each time enough samples have arrived,
+    it performs a windowed FFT and adds the magnitudes to a lock-free FIFO, so nothing on
+    the audio thread waits for the GUI. If the FIFO fills up because the component isn't
+    being painted, new frames are dropped.
+
+    When the component is painted, each new frame is drawn as one column of an image that
+    is used as a ring buffer, so that scrolling never moves any pixels - the image is just
+    drawn in two pieces, starting from the oldest column. Only the new columns are written
+    to, so if you use setImageType() to make this an OpenGLImageType, only those columns are
+    uploaded to the texture, and the scrolling is done by the GPU.
+
+    @see FFT, AudioAppComponent
+*/
+class JUCE_API  SpectrogramComponent  : public Component,
+                                        private Timer
+{
+public:
+    //==============================================================================
+    /** Creates a spectrogram.
+
+        @param fftOrder     the size of the FFT to use, as a power of two. A new frame
+                            is produced every half of this number of samples.
+        @param numColumns   the number of frames of history to show across the width
+                            of the component
+        @param numRows      the vertical resolution of the image. The frequencies are
+                            spread logarithmically across these rows.
+    */
+    SpectrogramComponent (int fftOrder = 11, int numColumns = 512, int numRows = 256);
+
+    /** Destructor. */
+    ~SpectrogramComponent();
+
+    //==============================================================================
+    /** Adds some samples to be analysed.
+        This can be called on the audio thread, and it doesn't allocate or lock anything.
+        Only one thread should call it at a time.
+    */
+    void pushSamples (const float* samples, int numSamples) noexcept;
+
+    //==============================================================================
+    /** Sets the range of levels that the colour map covers.
+        Anything below the minimum is drawn with the colour at the start of the map.
+        A full-scale sine wave has a level of about 0dB. The default is -100 to 0dB.
+    */
+    void setLevelRange (float minDecibels, float maxDecibels);
+
+    /** Changes the colours used for the different levels.
+        The start of the gradient is used for the lowest level and the end for the highest,
+        and its points are ignored.
+    */
+    void setColourMap (const ColourGradient& colours);
+
+    /** Changes the type of image that the spectrogram is drawn into.
+        The object passed-in will be deleted by this component. The image is re-created
+        the next time the component is painted, so the history will be lost.
+    */
+    void setImageType (ImageType* newImageType);
+
+    /** Clears the history, and any frames that haven't been drawn yet. */
+    void clear();
+
+    //==============================================================================
+    /** @internal */
+    void paint (Graphics&) override;
+
+private:
+    //==============================================================================
+    enum { fifoSizeInFrames = 64 };
+
+    FFT fft;
+    const int fftSize, numBins, numColumns, numRows;
+
+    HeapBlock<float> window, inputSamples, fftData, frameData;
+    int inputPos, samplesUntilNextFrame;
+    AbstractFifo frameFifo;
+
+    ScopedPointer<ImageType> imageType;
+    Image image;
+    int nextColumn;
+
+    HeapBlock<int> rowStartBins;
+    PixelARGB colourTable[256];
+    float minDecibels, maxDecibels;
+
+    void timerCallback() override;
+    void writeNewColumns();
+    void writeColumn (const float* magnitudes);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrogramComponent)
+};
+
+
+#endif   // JUCE_SPECTROGRAMCOMPONENT_H_INCLUDED
@@ -44,8 +44,11 @@ namespace juce
 #include "gui/juce_AudioDeviceSelectorComponent.cpp"
 #include "gui/juce_AudioThumbnail.cpp"
 #include "gui/juce_AudioThumbnailCache.cpp"
+#include "gui/juce_AudioThumbnailDiskCache.cpp"
 #include "gui/juce_MidiKeyboardComponent.cpp"
+#include "gui/juce_SpectrogramComponent.cpp"
 #include "gui/juce_AudioAppComponent.cpp"
 #include "players/juce_AudioProcessorPlayer.cpp"
+#include "players/juce_OfflineAudioRenderer.cpp"
 
 }
@@ -38,9 +38,12 @@ namespace juce
 #include "gui/juce_AudioThumbnailBase.h"
 #include "gui/juce_AudioThumbnail.h"
 #include "gui/juce_AudioThumbnailCache.h"
+#include "gui/juce_AudioThumbnailDiskCache.h"
 #include "gui/juce_MidiKeyboardComponent.h"
+#include "gui/juce_SpectrogramComponent.h"
 #include "gui/juce_AudioAppComponent.h"
 #include "players/juce_AudioProcessorPlayer.h"
+#include "players/juce_OfflineAudioRenderer.h"
 
 }
 
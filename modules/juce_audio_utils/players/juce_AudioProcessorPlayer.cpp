@@ -28,7 +28,12 @@ AudioProcessorPlayer::AudioProcessorPlayer()
       blockSize (0),
       isPrepared (false),
       numInputChans (0),
-      numOutputChans (0)
+      numOutputChans (0),
+      mappedInputChans (-1),
+      mappedOutputChans (-1),
+      splitAtParameterChanges (false),
+      minimumSubBlockSize (32),
+      pendingChanges ((size_t) maxChangesPerBlock)
 {
 }
 
@@ -62,6 +67,14 @@ void AudioProcessorPlayer::setProcessor (AudioProcessor* const processorToPlay)
     }
 }
 
+void AudioProcessorPlayer::setSampleAccurateAutomation (const bool shouldSplitBlocks,
+                                                        const int minimumSubBlockSizeToUse) noexcept
+{
+    const ScopedLock sl (lock);
+    splitAtParameterChanges = shouldSplitBlocks;
+    minimumSubBlockSize = jmax (1, minimumSubBlockSizeToUse);
+}
+
 //==============================================================================
 void AudioProcessorPlayer::audioDeviceIOCallback (const float** const inputChannelData,
                                                   const int numInputChannels,
@@ -72,49 +85,39 @@ void AudioProcessorPlayer::audioDeviceIOCallback (const float** const inputChann
     // these should have been prepared by audioDeviceAboutToStart()...
     jassert (sampleRate > 0 && blockSize > 0);
 
+    const RealtimeSafety::ScopedRealtimeContext realtimeContext;
+
     incomingMidi.clear();
     messageCollector.removeNextBlockOfMessages (incomingMidi, numSamples);
-    int totalNumChans = 0;
 
-    if (numInputChannels > numOutputChannels)
+    if (numInputChannels != mappedInputChans
+         || numOutputChannels != mappedOutputChans
+         || numSamples > tempBuffer.getNumSamples())
+        updateChannelMapping (numInputChannels, numOutputChannels, numSamples);
+
+    // The outputs are used as the processor's buffer, so the inputs get copied into them
+    // (unless the driver has given us the same buffer for both), and any extra inputs
+    // go into the temp buffer, whose channels are already in the list.
+    for (int i = 0; i < numOutputChannels; ++i)
     {
-        // if there aren't enough output channels for the number of
-        // inputs, we need to create some temporary extra ones (can't
-        // use the input data in case it gets written to)
-        tempBuffer.setSize (numInputChannels - numOutputChannels, numSamples,
-                            false, false, true);
+        float* const dest = outputChannelData[i];
+        channels[i] = dest;
 
-        for (int i = 0; i < numOutputChannels; ++i)
+        if (i < numInputChannels)
         {
-            channels[totalNumChans] = outputChannelData[i];
-            memcpy (channels[totalNumChans], inputChannelData[i], sizeof (float) * (size_t) numSamples);
-            ++totalNumChans;
+            if (inputChannelData[i] != dest)
+                memcpy (dest, inputChannelData[i], sizeof (float) * (size_t) numSamples);
         }
-
-        for (int i = numOutputChannels; i < numInputChannels; ++i)
+        else
         {
-            channels[totalNumChans] = tempBuffer.getWritePointer (i - numOutputChannels);
-            memcpy (channels[totalNumChans], inputChannelData[i], sizeof (float) * (size_t) numSamples);
-            ++totalNumChans;
+            zeromem (dest, sizeof (float) * (size_t) numSamples);
         }
     }
-    else
-    {
-        for (int i = 0; i < numInputChannels; ++i)
-        {
-            channels[totalNumChans] = outputChannelData[i];
-            memcpy (channels[totalNumChans], inputChannelData[i], sizeof (float) * (size_t) numSamples);
-            ++totalNumChans;
-        }
 
-        for (int i = numInputChannels; i < numOutputChannels; ++i)
-        {
-            channels[totalNumChans] = outputChannelData[i];
-            zeromem (channels[totalNumChans], sizeof (float) * (size_t) numSamples);
-            ++totalNumChans;
-        }
-    }
+    for (int i = numOutputChannels; i < numInputChannels; ++i)
+        memcpy (channels[i], inputChannelData[i], sizeof (float) * (size_t) numSamples);
 
+    const int totalNumChans = jmax (numInputChannels, numOutputChannels);
     AudioSampleBuffer buffer (channels, totalNumChans, numSamples);
 
     {
@@ -126,7 +129,11 @@ void AudioProcessorPlayer::audioDeviceIOCallback (const float** const inputChann
 
             if (! processor->isSuspended())
             {
-                processor->processBlock (buffer, incomingMidi);
+                if (splitAtParameterChanges && numSamples > 0)
+                    processWithParameterChanges (buffer, totalNumChans);
+                else
+                    processor->processBlock (buffer, incomingMidi);
+
                 return;
             }
         }
@@ -136,6 +143,80 @@ void AudioProcessorPlayer::audioDeviceIOCallback (const float** const inputChann
         FloatVectorOperations::clear (outputChannelData[i], numSamples);
 }
 
+void AudioProcessorPlayer::processWithParameterChanges (AudioSampleBuffer& buffer, const int numChans)
+{
+    ParameterChangeQueue& queue = processor->getParameterChangeQueue();
+    const int numSamples = buffer.getNumSamples();
+    int numChanges = 0;
+
+    while (numChanges < maxChangesPerBlock && queue.pop (pendingChanges[numChanges]))
+    {
+        pendingChanges[numChanges].sampleOffset = jlimit (0, numSamples - 1, pendingChanges[numChanges].sampleOffset);
+
+        // (the changes will normally arrive in order, so this insertion sort is cheap)
+        for (int i = numChanges; i > 0 && pendingChanges[i - 1].sampleOffset > pendingChanges[i].sampleOffset; --i)
+            std::swap (pendingChanges[i - 1], pendingChanges[i]);
+
+        ++numChanges;
+    }
+
+    if (numChanges == 0)
+    {
+        processor->processBlock (buffer, incomingMidi);
+        return;
+    }
+
+    int startSample = 0, nextChange = 0;
+
+    while (startSample < numSamples)
+    {
+        // changes which are too close to the start of this sub-block get applied early
+        while (nextChange < numChanges
+                && pendingChanges[nextChange].sampleOffset < startSample + minimumSubBlockSize)
+        {
+            const ParameterChangeQueue::Change& change = pendingChanges[nextChange++];
+            processor->setParameter (change.parameterIndex, change.newValue);
+        }
+
+        const int endSample = nextChange < numChanges ? pendingChanges[nextChange].sampleOffset : numSamples;
+        const int numThisTime = endSample - startSample;
+
+        AudioSampleBuffer subBuffer (channels, numChans, startSample, numThisTime);
+        subBlockMidi.clear();
+        subBlockMidi.addEvents (incomingMidi, startSample, numThisTime, -startSample);
+
+        processor->processBlock (subBuffer, subBlockMidi);
+        startSample = endSample;
+    }
+}
+
+// The temp buffer's channels only need adding to the list when the device's layout
+// changes, so this is called when the device starts rather than on every callback.
+void AudioProcessorPlayer::updateChannelMapping (const int numIns, const int numOuts, const int numSamples)
+{
+    {
+        // (this only allocates if audioDeviceAboutToStart() couldn't predict the size)
+        const RealtimeSafety::ScopedRealtimeExemption exemption;
+
+        const int numChans = jmax (numIns, numOuts);
+
+        if (numChans > jmax (mappedInputChans, mappedOutputChans))
+            channels.calloc ((size_t) numChans + 2);
+
+        // if there aren't enough output channels for the number of
+        // inputs, we need to create some temporary extra ones (can't
+        // use the input data in case it gets written to)
+        tempBuffer.setSize (jmax (1, numIns - numOuts, tempBuffer.getNumChannels()),
+                            jmax (numSamples, tempBuffer.getNumSamples()), false, false, true);
+    }
+
+    for (int i = numOuts; i < numIns; ++i)
+        channels[i] = tempBuffer.getWritePointer (i - numOuts);
+
+    mappedInputChans = numIns;
+    mappedOutputChans = numOuts;
+}
+
 void AudioProcessorPlayer::audioDeviceAboutToStart (AudioIODevice* const device)
 {
     const double newSampleRate = device->getCurrentSampleRate();
@@ -151,7 +232,9 @@ void AudioProcessorPlayer::audioDeviceAboutToStart (AudioIODevice* const device)
     numOutputChans = numChansOut;
 
     messageCollector.reset (sampleRate);
-    channels.calloc ((size_t) jmax (numChansIn, numChansOut) + 2);
+    mappedInputChans = mappedOutputChans = -1;
+    updateChannelMapping (numChansIn, numChansOut, newBlockSize);
+    subBlockMidi.ensureSize (2048);
 
     if (processor != nullptr)
     {
@@ -175,6 +258,7 @@ void AudioProcessorPlayer::audioDeviceStopped()
     blockSize = 0;
     isPrepared = false;
     tempBuffer.setSize (1, 1);
+    mappedInputChans = mappedOutputChans = -1;
 }
 
 void AudioProcessorPlayer::handleIncomingMidiMessage (MidiInput*, const MidiMessage& message)
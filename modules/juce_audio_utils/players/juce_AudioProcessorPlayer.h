@@ -65,6 +65,31 @@ public:
     */
     MidiMessageCollector& getMidiMessageCollector() noexcept        { return messageCollector; }
 
+    //==============================================================================
+    /** Turns sample-accurate automation on or off.
+
+        When this is enabled, the player reads the changes from its processor's
+        ParameterChangeQueue before each block, and splits the block into smaller
+        calls to processBlock() so that each change is applied at its sample offset.
+        Changes are timestamped relative to the start of the next block, so push them
+        into the processor's queue before that block starts. While this is enabled,
+        the player is the queue's reader, so the processor mustn't read it itself.
+
+        To stop a dense stream of changes from chopping the block into tiny pieces, a
+        change that's less than minimumSubBlockSize samples after the start of a
+        sub-block is applied at the start of that sub-block, rather than causing a split.
+
+        By default, this is disabled, and whole device blocks are passed to the processor.
+
+        @see ParameterChangeQueue, Synthesiser::setMinimumRenderingSubdivisionSize
+    */
+    void setSampleAccurateAutomation (bool shouldSplitBlocks, int minimumSubBlockSize = 32) noexcept;
+
+    /** Returns true if sample-accurate automation is enabled.
+        @see setSampleAccurateAutomation
+    */
+    bool isUsingSampleAccurateAutomation() const noexcept           { return splitAtParameterChanges; }
+
     //==============================================================================
     /** @internal */
     void audioDeviceIOCallback (const float**, int, float**, int, int) override;
@@ -83,13 +108,22 @@ private:
     int blockSize;
     bool isPrepared;
 
-    int numInputChans, numOutputChans;
+    int numInputChans, numOutputChans, mappedInputChans, mappedOutputChans;
     HeapBlock<float*> channels;
     AudioSampleBuffer tempBuffer;
 
     MidiBuffer incomingMidi;
     MidiMessageCollector messageCollector;
 
+    enum { maxChangesPerBlock = 1024 };
+    bool splitAtParameterChanges;
+    int minimumSubBlockSize;
+    HeapBlock<ParameterChangeQueue::Change> pendingChanges;
+    MidiBuffer subBlockMidi;
+
+    void processWithParameterChanges (AudioSampleBuffer&, int numChans);
+    void updateChannelMapping (int numIns, int numOuts, int numSamples);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorPlayer)
 };
 
@@ -0,0 +1,208 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+class OfflineAudioRenderer::Job  : public ThreadPoolJob,
+                                   private AudioPlayHead
+{
+public:
+    Job (OfflineAudioRenderer& r, AudioProcessor& p, AudioFormatWriter* w,
+         const int64 numToWrite, const int64 start, const int64 preroll)
+        : ThreadPoolJob ("Offline render"),
+          owner (r), processor (p), writer (w),
+          numSamplesToWrite (numToWrite), startSample (start), numPrerollSamples (preroll),
+          position (start - preroll)
+    {
+        jassert (w != nullptr);
+    }
+
+    int64 getTotalLength() const noexcept      { return numPrerollSamples + numSamplesToWrite; }
+
+    JobStatus runJob() override
+    {
+        const int blockSize = owner.blockSize;
+        const double sampleRate = writer->getSampleRate();
+        const int numWriterChannels = (int) writer->getNumChannels();
+        const int numChannels = jmax (processor.getNumInputChannels(),
+                                      processor.getNumOutputChannels(),
+                                      numWriterChannels);
+
+        // the writer FIFO lets the writer thread encode one chunk while the next is rendered
+        AudioFormatWriter::ThreadedWriter threadedWriter (writer.release(), owner.writerThread, blockSize * 8);
+
+        AudioSampleBuffer buffer (numChannels, blockSize);
+        MidiBuffer midi;
+
+        AudioPlayHead* const oldPlayHead = processor.getPlayHead();
+        const bool wasNonRealtime = processor.isNonRealtime();
+
+        processor.setNonRealtime (true);
+        processor.setPlayHead (this);
+        processor.setPlayConfigDetails (processor.getNumInputChannels(), processor.getNumOutputChannels(),
+                                        sampleRate, blockSize);
+        processor.prepareToPlay (sampleRate, blockSize);
+
+        const int64 endPosition = startSample + numSamplesToWrite;
+
+        while (position < endPosition && ! shouldStop())
+        {
+            // (a block never straddles the end of the pre-roll, so it's either all written or not at all)
+            const int64 segmentEnd = position < startSample ? startSample : endPosition;
+            const int numSamples = (int) jmin ((int64) blockSize, segmentEnd - position);
+
+            buffer.clear();
+            midi.clear();
+
+            {
+                AudioSampleBuffer block (buffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+                const ScopedLock sl (processor.getCallbackLock());
+
+                if (processor.isSuspended())
+                    block.clear();
+                else
+                    processor.processBlock (block, midi);
+            }
+
+            if (position >= startSample)
+            {
+                // if the writer's FIFO is full, give it time to catch up
+                while (! threadedWriter.write (buffer.getArrayOfReadPointers(), numSamples)
+                        && ! shouldStop())
+                    Thread::sleep (1);
+            }
+
+            position += numSamples;
+            owner.numSamplesDone += numSamples;
+        }
+
+        processor.releaseResources();
+        processor.setPlayHead (oldPlayHead);
+        processor.setNonRealtime (wasNonRealtime);
+
+        // (the ThreadedWriter's destructor flushes whatever's left in its FIFO)
+        return jobHasFinished;
+    }
+
+private:
+    OfflineAudioRenderer& owner;
+    AudioProcessor& processor;
+    ScopedPointer<AudioFormatWriter> writer;
+    const int64 numSamplesToWrite, startSample, numPrerollSamples;
+    int64 position;
+
+    bool shouldStop() const noexcept
+    {
+        return owner.shouldCancel.get() != 0 || shouldExit();
+    }
+
+    bool getCurrentPosition (CurrentPositionInfo& result) override
+    {
+        result = owner.positionInfo;
+        result.timeInSamples = position;
+
+        const double sampleRate = processor.getSampleRate();
+        result.timeInSeconds = sampleRate > 0 ? position / sampleRate : 0.0;
+        result.ppqPosition = result.timeInSeconds * result.bpm / 60.0;
+
+        const double quarterNotesPerBar = result.timeSigDenominator > 0
+                                            ? result.timeSigNumerator * 4.0 / result.timeSigDenominator
+                                            : 4.0;
+
+        result.ppqPositionOfLastBarStart = quarterNotesPerBar > 0
+                                            ? std::floor (result.ppqPosition / quarterNotesPerBar) * quarterNotesPerBar
+                                            : 0.0;
+        result.isPlaying = true;
+        result.isRecording = false;
+        return true;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Job)
+};
+
+//==============================================================================
+OfflineAudioRenderer::OfflineAudioRenderer (const int numRenderingThreads, const int samplesPerBlock)
+    : renderingThreads (jmax (1, numRenderingThreads)),
+      writerThread ("Offline render writer"),
+      blockSize (jmax (1, samplesPerBlock)),
+      totalNumSamples (0)
+{
+    positionInfo.resetToDefault();
+    positionInfo.bpm = 120.0;
+    positionInfo.timeSigNumerator = 4;
+    positionInfo.timeSigDenominator = 4;
+}
+
+OfflineAudioRenderer::~OfflineAudioRenderer()
+{
+    cancel();
+    renderingThreads.removeAllJobs (true, -1);
+    writerThread.stopThread (10000);
+}
+
+void OfflineAudioRenderer::addJob (AudioProcessor& processor, AudioFormatWriter* writer,
+                                   const int64 numSamples, const int64 startSample, const int64 numPrerollSamples)
+{
+    if (writer != nullptr)
+        jobs.add (new Job (*this, processor, writer, jmax ((int64) 0, numSamples),
+                           startSample, jmax ((int64) 0, numPrerollSamples)));
+}
+
+void OfflineAudioRenderer::setPositionInfo (const AudioPlayHead::CurrentPositionInfo& newInfo)
+{
+    positionInfo = newInfo;
+}
+
+bool OfflineAudioRenderer::render()
+{
+    shouldCancel = 0;
+    numSamplesDone = 0;
+    totalNumSamples = 0;
+
+    for (int i = 0; i < jobs.size(); ++i)
+        totalNumSamples += jobs.getUnchecked(i)->getTotalLength();
+
+    writerThread.startThread (6);
+
+    for (int i = 0; i < jobs.size(); ++i)
+        renderingThreads.addJob (jobs.getUnchecked(i), false);
+
+    for (int i = 0; i < jobs.size(); ++i)
+        renderingThreads.waitForJobToFinish (jobs.getUnchecked(i), -1);
+
+    jobs.clear();
+    writerThread.stopThread (10000);
+
+    return shouldCancel.get() == 0;
+}
+
+void OfflineAudioRenderer::cancel() noexcept
+{
+    shouldCancel = 1;
+}
+
+double OfflineAudioRenderer::getProgress() const noexcept
+{
+    return totalNumSamples > 0 ? jlimit (0.0, 1.0, numSamplesDone.get() / (double) totalNumSamples)
+                               : 1.0;
+}
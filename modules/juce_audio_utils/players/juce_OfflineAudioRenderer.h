@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_OFFLINEAUDIORENDERER_H_INCLUDED
+#define JUCE_OFFLINEAUDIORENDERER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Renders the output of AudioProcessors (typically AudioProcessorGraphs) into
+    AudioFormatWriters as fast as possible, e.g. for bouncing a mix to disk.
+
+    You add a job for each file that you want to create, and then call render(). Each
+    job puts its processor into non-realtime mode, prepares it with the writer's sample
+    rate and the renderer's block size, and then calls processBlock() in a loop, giving
+    it a play head which reports the position being rendered.
+
+    Encoding is pipelined with rendering: each job's output goes into a FIFO, and a
+    separate thread does the format conversion and disk writing, so a job only has to
+    wait for the disk when the FIFO is full.
+
+    Jobs which use different processors are independent, so if you give the renderer
+    more than one rendering thread, they'll run in parallel. This lets you render a
+    set of stems, each from its own graph, at the same time. It can also be used to
+    split a long render into time ranges, if you can create a separate processor for
+    each range (e.g. by restoring the same state into several instances). For processors
+    that carry state from one block to the next, give each range some pre-roll, so that
+    reverb tails etc. from before the range start have built up by the time it's written.
+
+    @code
+    OfflineAudioRenderer renderer (4);
+
+    for (int i = 0; i < stemGraphs.size(); ++i)
+        renderer.addJob (*stemGraphs[i], wavFormat.createWriterFor (...), lengthInSamples);
+
+    if (! renderer.render())
+        ..the render was cancelled..
+    @endcode
+
+    @see AudioProcessorGraph, AudioFormatWriter::ThreadedWriter
+*/
+class JUCE_API  OfflineAudioRenderer
+{
+public:
+    //==============================================================================
+    /** Creates a renderer.
+
+        @param numRenderingThreads  the maximum number of jobs to render at once
+        @param blockSize            the number of samples to pass to each processBlock() call.
+                                    Without a realtime deadline, large blocks are the most
+                                    efficient, as long as the processors are happy with them.
+    */
+    OfflineAudioRenderer (int numRenderingThreads = 1, int blockSize = 8192);
+
+    /** Destructor. */
+    ~OfflineAudioRenderer();
+
+    //==============================================================================
+    /** Adds a job to be done by the next call to render().
+
+        @param processor            the processor to render. This isn't owned by the renderer,
+                                    and mustn't be used by anything else until the render
+                                    has finished. It mustn't be used by any other job either.
+        @param writer               the writer to send the processor's output to. This will be
+                                    deleted by the renderer when the job has finished. The
+                                    first writer->getNumChannels() channels of the output
+                                    are written.
+        @param numSamples           the number of samples to write
+        @param startSample          the timeline position that the play head reports at the
+                                    first written sample
+        @param numPrerollSamples    the number of samples to render and discard before
+                                    startSample
+    */
+    void addJob (AudioProcessor& processor, AudioFormatWriter* writer,
+                 int64 numSamples, int64 startSample = 0, int64 numPrerollSamples = 0);
+
+    /** Sets the tempo, time signature, etc. that the play head reports to the processors.
+        The position fields of this structure are ignored, as they're filled in by each job.
+    */
+    void setPositionInfo (const AudioPlayHead::CurrentPositionInfo& newInfo);
+
+    //==============================================================================
+    /** Runs all the jobs that have been added, and waits for them to finish.
+
+        When this returns, all the jobs have been removed and their writers deleted.
+
+        @returns false if the render was cancelled
+    */
+    bool render();
+
+    /** Stops a render that's in progress. This can be called from any thread. */
+    void cancel() noexcept;
+
+    /** Returns the proportion of the current render that has been done, from 0 to 1.
+        This can be called from any thread.
+    */
+    double getProgress() const noexcept;
+
+private:
+    //==============================================================================
+    class Job;
+    friend class Job;
+    friend struct ContainerDeletePolicy<Job>;
+
+    OwnedArray<Job> jobs;
+    ThreadPool renderingThreads;
+    TimeSliceThread writerThread;
+    const int blockSize;
+    AudioPlayHead::CurrentPositionInfo positionInfo;
+    Atomic<int64> numSamplesDone;
+    int64 totalNumSamples;
+    Atomic<int> shouldCancel;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineAudioRenderer)
+};
+
+
+#endif   // JUCE_OFFLINEAUDIORENDERER_H_INCLUDED
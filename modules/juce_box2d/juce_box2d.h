@@ -33,6 +33,7 @@
 namespace juce
 {
   #include "utils/juce_Box2DRenderer.h"
+  #include "utils/juce_Box2DWorldThread.h"
 }
 
 #endif   // JUCE_BOX2D_H_INCLUDED
@@ -22,23 +22,109 @@
   ==============================================================================
 */
 
-Box2DRenderer::Box2DRenderer() noexcept   : graphics (nullptr)
+struct Box2DRenderer::Snapshot::Batch
+{
+    Colour colour;
+    Path fills, outlines;
+};
+
+Box2DRenderer::Snapshot::Snapshot()  : numBatchesUsed (0)
+{
+}
+
+Box2DRenderer::Snapshot::~Snapshot()
+{
+}
+
+void Box2DRenderer::Snapshot::clear() noexcept
+{
+    for (int i = 0; i < numBatchesUsed; ++i)
+    {
+        batches.getUnchecked (i)->fills.clear();
+        batches.getUnchecked (i)->outlines.clear();
+    }
+
+    numBatchesUsed = 0;
+}
+
+Box2DRenderer::Snapshot::Batch& Box2DRenderer::Snapshot::getBatch (Colour colour)
+{
+    // (there are usually only a handful of colours, so a linear search is fine)
+    for (int i = 0; i < numBatchesUsed; ++i)
+        if (batches.getUnchecked (i)->colour == colour)
+            return *batches.getUnchecked (i);
+
+    if (numBatchesUsed == batches.size())
+        batches.add (new Batch());
+
+    Batch& b = *batches.getUnchecked (numBatchesUsed++);
+    b.colour = colour;
+    return b;
+}
+
+//=============================================================================
+Box2DRenderer::Box2DRenderer() noexcept
+    : graphics (nullptr), currentSnapshot (&ownSnapshot)
 {
     SetFlags (e_shapeBit);
 }
 
+void Box2DRenderer::addTransform (Graphics& g, float left, float top, float right, float bottom,
+                                  const Rectangle<float>& target) const
+{
+    g.addTransform (AffineTransform::fromTargetPoints (left,  top,    target.getX(),     target.getY(),
+                                                       right, top,    target.getRight(), target.getY(),
+                                                       left,  bottom, target.getX(),     target.getBottom()));
+}
+
 void Box2DRenderer::render (Graphics& g, b2World& world,
                             float left, float top, float right, float bottom,
                             const Rectangle<float>& target)
 {
     graphics = &g;
+    addTransform (g, left, top, right, bottom, target);
 
-    g.addTransform (AffineTransform::fromTargetPoints (left,  top,    target.getX(),     target.getY(),
-                                                       right, top,    target.getRight(), target.getY(),
-                                                       left,  bottom, target.getX(),     target.getBottom()));
+    captureSnapshot (world, ownSnapshot);
+    drawSnapshot (ownSnapshot);
+}
+
+void Box2DRenderer::render (Graphics& g, const Snapshot& snapshot,
+                            float left, float top, float right, float bottom,
+                            const Rectangle<float>& target)
+{
+    graphics = &g;
+    addTransform (g, left, top, right, bottom, target);
+
+    drawSnapshot (snapshot);
+}
+
+void Box2DRenderer::captureSnapshot (b2World& world, Snapshot& snapshot)
+{
+    snapshot.clear();
+    currentSnapshot = &snapshot;
 
     world.SetDebugDraw (this);
     world.DrawDebugData();
+    world.SetDebugDraw (nullptr);
+
+    currentSnapshot = &ownSnapshot;
+}
+
+void Box2DRenderer::drawSnapshot (const Snapshot& snapshot)
+{
+    const PathStrokeType stroke (getLineThickness());
+
+    for (int i = 0; i < snapshot.numBatchesUsed; ++i)
+    {
+        const Snapshot::Batch& b = *snapshot.batches.getUnchecked (i);
+        graphics->setColour (b.colour);
+
+        if (! b.fills.isEmpty())
+            graphics->fillPath (b.fills);
+
+        if (! b.outlines.isEmpty())
+            graphics->strokePath (b.outlines, stroke);
+    }
 }
 
 Colour Box2DRenderer::getColour (const b2Color& c) const
@@ -63,41 +149,31 @@ static void createPath (Path& p, const b2Vec2* vertices, int32 vertexCount)
 
 void Box2DRenderer::DrawPolygon (const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
 {
-    graphics->setColour (getColour (color));
-
-    Path p;
-    createPath (p, vertices, vertexCount);
-    graphics->strokePath (p, PathStrokeType (getLineThickness()));
+    createPath (currentSnapshot->getBatch (getColour (color)).outlines, vertices, vertexCount);
 }
 
 void Box2DRenderer::DrawSolidPolygon (const b2Vec2* vertices, int32 vertexCount, const b2Color& color)
 {
-    graphics->setColour (getColour (color));
-
-    Path p;
-    createPath (p, vertices, vertexCount);
-    graphics->fillPath (p);
+    createPath (currentSnapshot->getBatch (getColour (color)).fills, vertices, vertexCount);
 }
 
 void Box2DRenderer::DrawCircle (const b2Vec2& center, float32 radius, const b2Color& color)
 {
-    graphics->setColour (getColour (color));
-    graphics->drawEllipse (center.x - radius, center.y - radius,
-                           radius * 2.0f, radius * 2.0f,
-                           getLineThickness());
+    currentSnapshot->getBatch (getColour (color)).outlines
+        .addEllipse (center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f);
 }
 
 void Box2DRenderer::DrawSolidCircle (const b2Vec2& center, float32 radius, const b2Vec2& /*axis*/, const b2Color& colour)
 {
-    graphics->setColour (getColour (colour));
-    graphics->fillEllipse (center.x - radius, center.y - radius,
-                           radius * 2.0f, radius * 2.0f);
+    currentSnapshot->getBatch (getColour (colour)).fills
+        .addEllipse (center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f);
 }
 
 void Box2DRenderer::DrawSegment (const b2Vec2& p1, const b2Vec2& p2, const b2Color& color)
 {
-    graphics->setColour (getColour (color));
-    graphics->drawLine (p1.x, p1.y, p2.x, p2.y, getLineThickness());
+    Path& p = currentSnapshot->getBatch (getColour (color)).outlines;
+    p.startNewSubPath (p1.x, p1.y);
+    p.lineTo (p2.x, p2.y);
 }
 
 void Box2DRenderer::DrawTransform (const b2Transform&)
@@ -30,6 +30,13 @@
 
     To use it, simply create an instance of this class in your paint() method,
     and call its render() method.
+
+    Rather than drawing each fixture separately, the shapes are gathered into one
+    path per colour, and each of these is filled or stroked in a single call when
+    the whole world has been collected. With a lot of bodies, this is much quicker,
+    particularly with a hardware-accelerated context such as the OpenGL renderer.
+
+    @see Box2DWorldThread
 */
 class Box2DRenderer   : public b2Draw
 
@@ -54,6 +61,48 @@ public:
                  float box2DWorldRight, float box2DWorldBottom,
                  const Rectangle<float>& targetArea);
 
+    //=============================================================================
+    /** The shapes of a world at a particular moment, grouped by colour.
+
+        A Snapshot can be made by one thread with captureSnapshot() and drawn by
+        another one, so it's what a Box2DWorldThread uses to pass the results of
+        each step to the thread that draws them.
+    */
+    class Snapshot  : public ReferenceCountedObject
+    {
+    public:
+        Snapshot();
+        ~Snapshot();
+
+        typedef ReferenceCountedObjectPtr<Snapshot> Ptr;
+
+        /** Removes all the shapes (but keeps the memory they used, for re-use). */
+        void clear() noexcept;
+
+    private:
+        struct Batch;
+        friend class Box2DRenderer;
+        friend struct ContainerDeletePolicy<Batch>;
+        OwnedArray<Batch> batches;
+        int numBatchesUsed;
+
+        Batch& getBatch (Colour);
+
+        JUCE_DECLARE_NON_COPYABLE (Snapshot)
+    };
+
+    /** Replaces the contents of a snapshot with the shapes of the given world. */
+    void captureSnapshot (b2World& world, Snapshot& snapshot);
+
+    /** Draws a snapshot that was made by captureSnapshot().
+        The parameters are the same as for the other render() method.
+    */
+    void render (Graphics& g,
+                 const Snapshot& snapshot,
+                 float box2DWorldLeft, float box2DWorldTop,
+                 float box2DWorldRight, float box2DWorldBottom,
+                 const Rectangle<float>& targetArea);
+
     // b2Draw methods:
     void DrawPolygon (const b2Vec2*, int32, const b2Color&) override;
     void DrawSolidPolygon (const b2Vec2*, int32, const b2Color&) override;
@@ -70,6 +119,13 @@ public:
 protected:
     Graphics* graphics;
 
+private:
+    Snapshot ownSnapshot;
+    Snapshot* currentSnapshot;
+
+    void addTransform (Graphics&, float, float, float, float, const Rectangle<float>&) const;
+    void drawSnapshot (const Snapshot&);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Box2DRenderer)
 };
 
@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+Box2DWorldThread::Box2DWorldThread (b2World& w, double rate, int velocityIts, int positionIts)
+    : Thread ("Box2D world"),
+      world (w),
+      stepsPerSecond (rate),
+      velocityIterations (velocityIts),
+      positionIterations (positionIts),
+      latestSnapshot (new Box2DRenderer::Snapshot()),
+      numSteps (0)
+{
+    jassert (rate > 0);
+}
+
+Box2DWorldThread::~Box2DWorldThread()
+{
+    stop();
+}
+
+void Box2DWorldThread::start()
+{
+    startThread (7);
+}
+
+void Box2DWorldThread::stop()
+{
+    stopThread (5000);
+}
+
+Box2DRenderer::Snapshot::Ptr Box2DWorldThread::getLatestSnapshot() const
+{
+    const SpinLock::ScopedLockType sl (snapshotLock);
+    return latestSnapshot;
+}
+
+Box2DRenderer::Snapshot* Box2DWorldThread::getFreeSnapshot()
+{
+    // A snapshot that only this array refers to isn't being drawn, so it can be
+    // overwritten. Usually that's just the one before the latest.
+    for (int i = 0; i < snapshots.size(); ++i)
+        if (snapshots.getObjectPointerUnchecked (i)->getReferenceCount() == 1)
+            return snapshots.getObjectPointerUnchecked (i);
+
+    return snapshots.add (new Box2DRenderer::Snapshot());
+}
+
+void Box2DWorldThread::run()
+{
+    const double msPerStep = 1000.0 / stepsPerSecond;
+    double nextStepTime = Time::getMillisecondCounterHiRes();
+
+    while (! threadShouldExit())
+    {
+        Box2DRenderer::Snapshot* const snapshot = getFreeSnapshot();
+
+        {
+            const ScopedLock sl (worldLock);
+            world.Step ((float32) (1.0 / stepsPerSecond), velocityIterations, positionIterations);
+            snapshotRenderer.captureSnapshot (world, *snapshot);
+        }
+
+        {
+            const SpinLock::ScopedLockType sl (snapshotLock);
+            latestSnapshot = snapshot;
+        }
+
+        ++numSteps;
+
+        // (if the steps fall behind, this catches up without trying to take all the missed steps)
+        nextStepTime = jmax (nextStepTime + msPerStep, Time::getMillisecondCounterHiRes() - msPerStep);
+
+        const int msToWait = (int) (nextStepTime - Time::getMillisecondCounterHiRes());
+
+        if (msToWait > 0)
+            wait (msToWait);
+    }
+}
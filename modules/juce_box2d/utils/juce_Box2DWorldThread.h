@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_BOX2DWORLDTHREAD_H_INCLUDED
+#define JUCE_BOX2DWORLDTHREAD_H_INCLUDED
+
+//=============================================================================
+/** Steps a Box2D world on a background thread, at a fixed rate.
+
+    After each step, the thread captures the shapes of the world in a
+    Box2DRenderer::Snapshot. Your paint() method can then draw the latest one
+    with Box2DRenderer::render(), without having to wait for a step to finish, and
+    without the step having to wait for the drawing.
+
+    Once the thread is running, anything else that touches the world (e.g. adding
+    bodies or applying forces) must hold the lock returned by getWorldLock().
+
+    e.g.
+    @code
+    void paint (Graphics& g) override
+    {
+        Box2DRenderer renderer;
+        renderer.render (g, *worldThread.getLatestSnapshot(), -10.0f, 10.0f, 10.0f, -10.0f,
+                         getLocalBounds().toFloat());
+    }
+    @endcode
+
+    @see Box2DRenderer
+*/
+class Box2DWorldThread  : private Thread
+{
+public:
+    /** Creates a thread to step the given world.
+        The world must not be deleted until after this object.
+        Call start() to begin stepping.
+    */
+    Box2DWorldThread (b2World& world,
+                      double stepsPerSecond = 60.0,
+                      int velocityIterations = 8,
+                      int positionIterations = 3);
+
+    /** Destructor. */
+    ~Box2DWorldThread();
+
+    /** Starts stepping the world. */
+    void start();
+
+    /** Stops stepping the world, waiting for the current step to finish. */
+    void stop();
+
+    /** Returns the lock which must be held by anything else that uses the world
+        while the thread is running.
+    */
+    const CriticalSection& getWorldLock() const noexcept        { return worldLock; }
+
+    /** Returns the shapes of the world as they were after the latest step.
+        This will never return nullptr, but the snapshot will be empty until the
+        first step has been taken.
+    */
+    Box2DRenderer::Snapshot::Ptr getLatestSnapshot() const;
+
+    /** Returns the number of steps that have been taken. */
+    int64 getNumSteps() const noexcept                          { return numSteps; }
+
+private:
+    b2World& world;
+    const double stepsPerSecond;
+    const int velocityIterations, positionIterations;
+    CriticalSection worldLock;
+    SpinLock snapshotLock;
+    Box2DRenderer::Snapshot::Ptr latestSnapshot;
+    ReferenceCountedArray<Box2DRenderer::Snapshot> snapshots;
+    Box2DRenderer snapshotRenderer;
+    int64 volatile numSteps;
+
+    Box2DRenderer::Snapshot* getFreeSnapshot();
+    void run() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Box2DWorldThread)
+};
+
+
+#endif   // JUCE_BOX2DWORLDTHREAD_H_INCLUDED
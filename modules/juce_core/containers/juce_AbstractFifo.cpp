@@ -232,4 +232,125 @@ public:
 
 static AbstractFifoTests fifoUnitTests;
 
+//==============================================================================
+class LockFreeQueueTests  : public UnitTest
+{
+public:
+    LockFreeQueueTests() : UnitTest ("Lock Free Queue") {}
+
+    enum { numWriters = 4, numItemsPerWriter = 50000 };
+
+    class QueueWriteThread  : public Thread
+    {
+    public:
+        QueueWriteThread (LockFreeQueue<int>& q, int index)
+            : Thread ("queue writer"), queue (q), writerIndex (index)
+        {
+            startThread();
+        }
+
+        ~QueueWriteThread()
+        {
+            stopThread (5000);
+        }
+
+        void run()
+        {
+            for (int i = 0; i < numItemsPerWriter && ! threadShouldExit();)
+                if (queue.push (writerIndex * numItemsPerWriter + i))
+                    ++i;
+        }
+
+    private:
+        LockFreeQueue<int>& queue;
+        const int writerIndex;
+    };
+
+    void runTest()
+    {
+        beginTest ("LockFreeQueue");
+
+        {
+            LockFreeQueue<int> queue (5);
+            expectEquals (queue.getCapacity(), 8);
+
+            for (int i = 0; i < 8; ++i)
+                expect (queue.push (i));
+
+            expect (! queue.push (8));
+            expectEquals (queue.getNumReady(), 8);
+
+            int value = -1;
+
+            for (int i = 0; i < 8; ++i)
+                expect (queue.pop (value) && value == i);
+
+            expect (! queue.pop (value));
+            expect (queue.isEmpty());
+        }
+
+        beginTest ("LockFreeQueue with multiple writers");
+
+        {
+            LockFreeQueue<int> queue (1024);
+            int nextExpected [numWriters] = { 0 };
+            bool failed = false;
+
+            {
+                OwnedArray<QueueWriteThread> writers;
+
+                for (int i = 0; i < numWriters; ++i)
+                    writers.add (new QueueWriteThread (queue, i));
+
+                for (int numRead = 0; numRead < numWriters * numItemsPerWriter;)
+                {
+                    int value;
+
+                    if (queue.pop (value))
+                    {
+                        // each writer's items must arrive in the order they were pushed
+                        const int writer = value / numItemsPerWriter;
+                        failed = (value % numItemsPerWriter != nextExpected [writer]++) || failed;
+                        ++numRead;
+                    }
+                }
+            }
+
+            expect (! failed, "values were read out of order");
+            expect (queue.isEmpty());
+        }
+
+        beginTest ("FifoBuffer");
+
+        {
+            FifoBuffer<int> fifo (100);
+            expectEquals (fifo.getCapacity(), 100);
+            expectEquals (fifo.getFreeSpace(), 100);
+
+            int source [150], dest [150];
+
+            for (int i = 0; i < numElementsInArray (source); ++i)
+                source[i] = i;
+
+            expectEquals (fifo.write (source, 70), 70);
+            expectEquals (fifo.read (dest, 50), 50);
+            expectEquals (fifo.write (source + 70, 80), 80);
+            expectEquals (fifo.getNumReady(), 100);
+            expect (! fifo.push (0));
+
+            expectEquals (fifo.read (dest + 50, 150), 100);
+
+            bool failed = false;
+
+            for (int i = 0; i < numElementsInArray (dest); ++i)
+                failed = (dest[i] != i) || failed;
+
+            expect (! failed, "read values were incorrect");
+            expectEquals (fifo.getNumReady(), 0);
+        }
+    }
+};
+
+static LockFreeQueueTests lockFreeQueueUnitTests;
+
 #endif
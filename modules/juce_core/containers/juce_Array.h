@@ -39,8 +39,12 @@
     The Array class can be used to hold simple, non-polymorphic objects as well as primitive types - to
     do so, the class must fulfil these requirements:
     - it must have a copy constructor and assignment operator
-    - it must be able to be relocated in memory by a memcpy without this causing any problems - so
-      objects whose functionality relies on external pointers or references to themselves can not be used.
+    - on compilers without move semantics, it must be able to be relocated in memory by a memcpy
+      without this causing any problems - so objects whose functionality relies on external pointers
+      or references to themselves can not be used. With move semantics, elements that aren't trivially
+      copyable are moved into place with their move constructors instead, unless their class has been
+      declared relocatable with JUCE_DECLARE_TRIVIALLY_RELOCATABLE, in which case the faster memcpy
+      is still used.
 
     You can of course have an array of pointers to any kind of object, e.g. Array<MyClass*>, but if
     you do this, the array doesn't take any ownership of the objects - see the OwnedArray class or the
@@ -392,7 +396,7 @@ public:
     void add (const ElementType& newElement)
     {
         const ScopedLockType lock (getLock());
-        data.ensureAllocatedSize (numUsed + 1);
+        data.ensureAllocatedSize (numUsed + 1, numUsed);
         new (data.elements + numUsed++) ElementType (newElement);
     }
 
@@ -405,11 +409,27 @@ public:
     void add (ElementType&& newElement)
     {
         const ScopedLockType lock (getLock());
-        data.ensureAllocatedSize (numUsed + 1);
+        data.ensureAllocatedSize (numUsed + 1, numUsed);
         new (data.elements + numUsed++) ElementType (static_cast<ElementType&&> (newElement));
     }
    #endif
 
+   #if JUCE_COMPILER_SUPPORTS_VARIADIC_TEMPLATES
+    /** Constructs a new element at the end of the array, passing the given arguments
+        to its constructor, so that no temporary object needs to be created and copied.
+
+        @returns a reference to the new element, which is only valid until the array is next modified
+        @see add
+    */
+    template <typename... Args>
+    ElementType& emplace (Args&&... constructorArgs)
+    {
+        const ScopedLockType lock (getLock());
+        data.ensureAllocatedSize (numUsed + 1, numUsed);
+        return *new (data.elements + numUsed++) ElementType (static_cast<Args&&> (constructorArgs)...);
+    }
+   #endif
+
     /** Inserts a new element into the array at a given position.
 
         If the index is less than 0 or greater than the size of the array, the
@@ -422,28 +442,26 @@ public:
         @param newElement         the new object to add to the array
         @see add, addSorted, addUsingDefaultSort, set
     */
-    void insert (int indexToInsertAt, ParameterType newElement)
+    void insert (int indexToInsertAt, const ElementType& newElement)
     {
         const ScopedLockType lock (getLock());
-        data.ensureAllocatedSize (numUsed + 1);
-        jassert (data.elements != nullptr);
+        new (createSpaceForInsertion (indexToInsertAt, 1)) ElementType (newElement);
+    }
 
-        if (isPositiveAndBelow (indexToInsertAt, numUsed))
-        {
-            ElementType* const insertPos = data.elements + indexToInsertAt;
-            const int numberToMove = numUsed - indexToInsertAt;
+   #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+    /** Inserts a new element into the array at a given position, moving it into place.
 
-            if (numberToMove > 0)
-                memmove (insertPos + 1, insertPos, ((size_t) numberToMove) * sizeof (ElementType));
+        If the index is less than 0 or greater than the size of the array, the
+        element will be added to the end of the array.
 
-            new (insertPos) ElementType (newElement);
-            ++numUsed;
-        }
-        else
-        {
-            new (data.elements + numUsed++) ElementType (newElement);
-        }
+        @see add, set
+    */
+    void insert (int indexToInsertAt, ElementType&& newElement)
+    {
+        const ScopedLockType lock (getLock());
+        new (createSpaceForInsertion (indexToInsertAt, 1)) ElementType (static_cast<ElementType&&> (newElement));
     }
+   #endif
 
     /** Inserts multiple copies of an element into the array at a given position.
 
@@ -463,21 +481,7 @@ public:
         if (numberOfTimesToInsertIt > 0)
         {
             const ScopedLockType lock (getLock());
-            data.ensureAllocatedSize (numUsed + numberOfTimesToInsertIt);
-            ElementType* insertPos;
-
-            if (isPositiveAndBelow (indexToInsertAt, numUsed))
-            {
-                insertPos = data.elements + indexToInsertAt;
-                const int numberToMove = numUsed - indexToInsertAt;
-                memmove (insertPos + numberOfTimesToInsertIt, insertPos, ((size_t) numberToMove) * sizeof (ElementType));
-            }
-            else
-            {
-                insertPos = data.elements + numUsed;
-            }
-
-            numUsed += numberOfTimesToInsertIt;
+            ElementType* insertPos = createSpaceForInsertion (indexToInsertAt, numberOfTimesToInsertIt);
 
             while (--numberOfTimesToInsertIt >= 0)
             {
@@ -507,21 +511,7 @@ public:
         if (numberOfElements > 0)
         {
             const ScopedLockType lock (getLock());
-            data.ensureAllocatedSize (numUsed + numberOfElements);
-            ElementType* insertPos = data.elements;
-
-            if (isPositiveAndBelow (indexToInsertAt, numUsed))
-            {
-                insertPos += indexToInsertAt;
-                const int numberToMove = numUsed - indexToInsertAt;
-                memmove (insertPos + numberOfElements, insertPos, numberToMove * sizeof (ElementType));
-            }
-            else
-            {
-                insertPos += numUsed;
-            }
-
-            numUsed += numberOfElements;
+            ElementType* insertPos = createSpaceForInsertion (indexToInsertAt, numberOfElements);
 
             while (--numberOfElements >= 0)
                 new (insertPos++) ElementType (*newElements++);
@@ -565,7 +555,7 @@ public:
         }
         else if (indexToChange >= 0)
         {
-            data.ensureAllocatedSize (numUsed + 1);
+            data.ensureAllocatedSize (numUsed + 1, numUsed);
             new (data.elements + numUsed++) ElementType (newValue);
         }
     }
@@ -600,7 +590,7 @@ public:
 
         if (numElementsToAdd > 0)
         {
-            data.ensureAllocatedSize (numUsed + numElementsToAdd);
+            data.ensureAllocatedSize (numUsed + numElementsToAdd, numUsed);
 
             while (--numElementsToAdd >= 0)
             {
@@ -615,7 +605,7 @@ public:
     void addArray (const std::initializer_list<TypeToCreateFrom>& items)
     {
         const ScopedLockType lock (getLock());
-        data.ensureAllocatedSize (numUsed + (int) items.size());
+        data.ensureAllocatedSize (numUsed + (int) items.size(), numUsed);
 
         for (auto& item : items)
         {
@@ -799,7 +789,11 @@ public:
         if (isPositiveAndBelow (indexToRemove, numUsed))
         {
             jassert (data.elements != nullptr);
+           #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+            ElementType removed (static_cast<ElementType&&> (data.elements[indexToRemove]));
+           #else
             ElementType removed (data.elements[indexToRemove]);
+           #endif
             removeInternal (indexToRemove);
             return removed;
         }
@@ -873,9 +867,7 @@ public:
             for (int i = 0; i < numberToRemove; ++i)
                 e[i].~ElementType();
 
-            const int numToShift = numUsed - endIndex;
-            if (numToShift > 0)
-                memmove (e, e + numberToRemove, ((size_t) numToShift) * sizeof (ElementType));
+            data.moveElements (e, e + numberToRemove, numUsed - endIndex);
 
             numUsed -= numberToRemove;
             minimiseStorageAfterRemoval();
@@ -1001,23 +993,30 @@ public:
                 if (! isPositiveAndBelow (newIndex, numUsed))
                     newIndex = numUsed - 1;
 
-                char tempCopy [sizeof (ElementType)];
-                memcpy (tempCopy, data.elements + currentIndex, sizeof (ElementType));
+                ElementType* const e = data.elements;
 
-                if (newIndex > currentIndex)
+                if (TypeHelpers::IsTriviallyRelocatable<ElementType>::value)
                 {
-                    memmove (data.elements + currentIndex,
-                             data.elements + currentIndex + 1,
-                             sizeof (ElementType) * (size_t) (newIndex - currentIndex));
+                    char tempCopy [sizeof (ElementType)];
+                    memcpy (tempCopy, static_cast<const void*> (e + currentIndex), sizeof (ElementType));
+                    shiftElementsForMove (currentIndex, newIndex);
+                    memcpy (static_cast<void*> (e + newIndex), tempCopy, sizeof (ElementType));
                 }
                 else
                 {
-                    memmove (data.elements + newIndex + 1,
-                             data.elements + newIndex,
-                             sizeof (ElementType) * (size_t) (currentIndex - newIndex));
+                   #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+                    ElementType temp (static_cast<ElementType&&> (e[currentIndex]));
+                   #else
+                    ElementType temp (e[currentIndex]);
+                   #endif
+                    e[currentIndex].~ElementType();
+                    shiftElementsForMove (currentIndex, newIndex);
+                   #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+                    new (e + newIndex) ElementType (static_cast<ElementType&&> (temp));
+                   #else
+                    new (e + newIndex) ElementType (temp);
+                   #endif
                 }
-
-                memcpy (data.elements + newIndex, tempCopy, sizeof (ElementType));
             }
         }
     }
@@ -1032,7 +1031,7 @@ public:
     void minimiseStorageOverheads()
     {
         const ScopedLockType lock (getLock());
-        data.shrinkToNoMoreThan (numUsed);
+        data.shrinkToNoMoreThan (numUsed, numUsed);
     }
 
     /** Increases the array's internal storage to hold a minimum number of elements.
@@ -1044,7 +1043,7 @@ public:
     void ensureStorageAllocated (const int minNumElements)
     {
         const ScopedLockType lock (getLock());
-        data.ensureAllocatedSize (minNumElements);
+        data.ensureAllocatedSize (minNumElements, numUsed);
     }
 
     //==============================================================================
@@ -1112,14 +1111,40 @@ private:
         --numUsed;
         ElementType* const e = data.elements + indexToRemove;
         e->~ElementType();
-        const int numberToShift = numUsed - indexToRemove;
-
-        if (numberToShift > 0)
-            memmove (e, e + 1, ((size_t) numberToShift) * sizeof (ElementType));
+        data.moveElements (e, e + 1, numUsed - indexToRemove);
 
         minimiseStorageAfterRemoval();
     }
 
+    // closes the gap left at currentIndex by opening one at newIndex
+    void shiftElementsForMove (const int currentIndex, const int newIndex) noexcept
+    {
+        ElementType* const e = data.elements;
+
+        if (newIndex > currentIndex)
+            data.moveElements (e + currentIndex, e + currentIndex + 1, newIndex - currentIndex);
+        else
+            data.moveElements (e + newIndex + 1, e + newIndex, currentIndex - newIndex);
+    }
+
+    // makes room for some new elements, and returns the (uninitialised) space where they should go
+    ElementType* createSpaceForInsertion (const int indexToInsertAt, const int numElements)
+    {
+        data.ensureAllocatedSize (numUsed + numElements, numUsed);
+        jassert (data.elements != nullptr);
+
+        ElementType* insertPos = data.elements + numUsed;
+
+        if (isPositiveAndBelow (indexToInsertAt, numUsed))
+        {
+            insertPos = data.elements + indexToInsertAt;
+            data.moveElements (insertPos + numElements, insertPos, numUsed - indexToInsertAt);
+        }
+
+        numUsed += numElements;
+        return insertPos;
+    }
+
     inline void deleteAllElements() noexcept
     {
         for (int i = 0; i < numUsed; ++i)
@@ -1129,7 +1154,7 @@ private:
     void minimiseStorageAfterRemoval()
     {
         if (data.numAllocated > jmax (minimumAllocatedSize, numUsed * 2))
-            data.shrinkToNoMoreThan (jmax (numUsed, jmax (minimumAllocatedSize, 64 / (int) sizeof (ElementType))));
+            data.shrinkToNoMoreThan (jmax (numUsed, jmax (minimumAllocatedSize, 64 / (int) sizeof (ElementType))), numUsed);
     }
 };
 
@@ -79,6 +79,10 @@ public:
         This will retain any data currently held in the array, and either add or
         remove extra space at the end.
 
+        Because this just reallocates the raw memory, it's only safe to use when the
+        elements are trivially relocatable, or when none of them are in use. Otherwise,
+        use the version of this method that takes the number of elements in use.
+
         @param numElements  the number of elements that are needed
     */
     void setAllocatedSize (const int numElements)
@@ -94,6 +98,61 @@ public:
         }
     }
 
+    /** Changes the amount of storage allocated, moving the elements that are in use.
+
+        If the element type is trivially relocatable (see TypeHelpers::IsTriviallyRelocatable),
+        the memory is simply reallocated, but otherwise the elements are move-constructed into
+        a new block, and the old ones are destroyed.
+
+        @param numElements          the number of elements that are needed
+        @param numElementsInUse     the number of constructed elements at the start of the
+                                    storage, which must not be more than numElements
+    */
+    void setAllocatedSize (const int numElements, const int numElementsInUse)
+    {
+        jassert (numElementsInUse <= numElements);
+
+        if (numAllocated != numElements)
+        {
+            if (TypeHelpers::IsTriviallyRelocatable<ElementType>::value || numElementsInUse <= 0)
+            {
+                setAllocatedSize (numElements);
+            }
+            else
+            {
+                HeapBlock<ElementType> newElements ((size_t) numElements);
+                moveElements (newElements, elements, numElementsInUse);
+                elements.swapWith (newElements);
+                numAllocated = numElements;
+            }
+        }
+    }
+
+    /** Increases the amount of storage allocated if it is less than a given amount.
+
+        The storage grows geometrically, so adding elements one at a time only
+        causes a logarithmic number of reallocations.
+
+        @param minNumElements       the minimum number of elements that are needed
+        @param numElementsInUse     the number of constructed elements at the start of the storage
+    */
+    void ensureAllocatedSize (const int minNumElements, const int numElementsInUse)
+    {
+        if (minNumElements > numAllocated)
+            setAllocatedSize ((minNumElements + minNumElements / 2 + 8) & ~7, numElementsInUse);
+
+        jassert (numAllocated <= 0 || elements != nullptr);
+    }
+
+    /** Minimises the amount of storage allocated so that it's no more than
+        the given number of elements, moving any elements that are in use.
+    */
+    void shrinkToNoMoreThan (const int maxNumElements, const int numElementsInUse)
+    {
+        if (maxNumElements < numAllocated)
+            setAllocatedSize (maxNumElements, numElementsInUse);
+    }
+
     /** Increases the amount of storage allocated if it is less than a given amount.
 
         This will retain any data currently held in the array, but will add
@@ -119,6 +178,19 @@ public:
             setAllocatedSize (maxNumElements);
     }
 
+    /** Moves a run of constructed elements to a new position, which may overlap the old one.
+
+        The destination must be uninitialised storage (apart from any part of it that
+        overlaps the source), and the source elements that aren't overwritten are left
+        uninitialised. Trivially relocatable elements are moved with memmove, and others
+        are move-constructed into place, one at a time, with the originals destroyed.
+    */
+    static void moveElements (ElementType* dest, ElementType* source, const int numElements) noexcept
+    {
+        if (numElements > 0 && dest != source)
+            moveElements (dest, source, numElements, RelocationType<TypeHelpers::IsTriviallyRelocatable<ElementType>::value>());
+    }
+
     /** Swap the contents of two objects. */
     void swapWith (ArrayAllocationBase <ElementType, TypeOfCriticalSectionToUse>& other) noexcept
     {
@@ -131,6 +203,38 @@ public:
     int numAllocated;
 
 private:
+    template <bool isTriviallyRelocatable> struct RelocationType {};
+
+    static void moveElements (ElementType* dest, ElementType* source, int numElements, RelocationType<true>) noexcept
+    {
+        // (the type has been declared relocatable, so moving its bytes is deliberate)
+        memmove (static_cast<void*> (dest), static_cast<const void*> (source), ((size_t) numElements) * sizeof (ElementType));
+    }
+
+    static void moveElements (ElementType* dest, ElementType* source, int numElements, RelocationType<false>) noexcept
+    {
+        if (dest < source)
+        {
+            for (int i = 0; i < numElements; ++i)
+                relocate (dest + i, source + i);
+        }
+        else
+        {
+            for (int i = numElements; --i >= 0;)
+                relocate (dest + i, source + i);
+        }
+    }
+
+    static void relocate (ElementType* dest, ElementType* source) noexcept
+    {
+       #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+        new (dest) ElementType (static_cast<ElementType&&> (*source));
+       #else
+        new (dest) ElementType (*source);
+       #endif
+        source->~ElementType();
+    }
+
     JUCE_DECLARE_NON_COPYABLE (ArrayAllocationBase)
 };
 
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_FIFOBUFFER_H_INCLUDED
+#define JUCE_FIFOBUFFER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A single-reader, single-writer lock-free FIFO that holds a buffer of elements.
+
+    This wraps up an AbstractFifo together with the storage it manages, so you don't
+    need to write the prepareToWrite() / finishedWrite() code yourself. One thread can
+    write to it while another thread reads from it, without needing any locks.
+
+    Elements are copied with the assignment operator, so this is best suited to simple
+    types like numbers, structs or pointers.
+
+    @see AbstractFifo, LockFreeQueue
+*/
+template <typename ElementType>
+class FifoBuffer
+{
+public:
+    //==============================================================================
+    /** Creates a FIFO which can hold the given number of elements. */
+    FifoBuffer (int capacity)
+        : fifo (capacity + 1), buffer ((size_t) capacity + 1)
+    {
+        // (the AbstractFifo always keeps one slot empty, so it's given an extra one)
+    }
+
+    /** Destructor. */
+    ~FifoBuffer() {}
+
+    //==============================================================================
+    /** Writes as many of the given elements as there's space for.
+        This must only be called by the writer thread.
+        @returns the number of elements that were written
+    */
+    int write (const ElementType* source, int numElements) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (numElements, start1, size1, start2, size2);
+
+        copyElements (buffer + start1, source, size1);
+        copyElements (buffer + start2, source + size1, size2);
+
+        fifo.finishedWrite (size1 + size2);
+        return size1 + size2;
+    }
+
+    /** Reads up to the given number of elements.
+        This must only be called by the reader thread.
+        @returns the number of elements that were read
+    */
+    int read (ElementType* dest, int numElements) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (numElements, start1, size1, start2, size2);
+
+        copyElements (dest, buffer + start1, size1);
+        copyElements (dest + size1, buffer + start2, size2);
+
+        fifo.finishedRead (size1 + size2);
+        return size1 + size2;
+    }
+
+    /** Writes a single element.
+        This must only be called by the writer thread.
+        @returns false if the FIFO was full
+    */
+    bool push (const ElementType& newElement) noexcept      { return write (&newElement, 1) == 1; }
+
+    /** Reads a single element.
+        This must only be called by the reader thread.
+        @returns false if the FIFO was empty
+    */
+    bool pop (ElementType& result) noexcept                 { return read (&result, 1) == 1; }
+
+    //==============================================================================
+    /** Returns the number of elements that can currently be read. */
+    int getNumReady() const noexcept                        { return fifo.getNumReady(); }
+
+    /** Returns the number of elements that can currently be written. */
+    int getFreeSpace() const noexcept                       { return fifo.getFreeSpace(); }
+
+    /** Returns the maximum number of elements that the FIFO can hold. */
+    int getCapacity() const noexcept                        { return fifo.getTotalSize() - 1; }
+
+    /** Discards any elements that are in the FIFO.
+        This isn't thread-safe, so must not be called while it's being read or written.
+    */
+    void reset() noexcept                                   { fifo.reset(); }
+
+private:
+    //==============================================================================
+    AbstractFifo fifo;
+    HeapBlock<ElementType> buffer;
+
+    static void copyElements (ElementType* dest, const ElementType* source, int num) noexcept
+    {
+        for (int i = 0; i < num; ++i)
+            dest[i] = source[i];
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (FifoBuffer)
+};
+
+
+#endif   // JUCE_FIFOBUFFER_H_INCLUDED
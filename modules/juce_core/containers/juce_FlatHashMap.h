@@ -0,0 +1,518 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_FLATHASHMAP_H_INCLUDED
+#define JUCE_FLATHASHMAP_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Holds a set of mappings between some key/value pairs, using an open-addressed
+    hash table.
+
+    This does the same job as HashMap, but without allocating anything per item. The
+    items are kept packed together in one array, and the hash table is a separate
+    array of small slots, each holding an item's hash and its index. Collisions are
+    resolved with Robin Hood linear probing, so a lookup normally touches a single
+    cache line of slots, and only has to compare keys whose hashes match. The table
+    grows automatically to keep it no more than 7/8 full.
+
+    The key and value types are copy-by-value types, as for HashMap. If your compiler
+    supports move semantics, the value type can also be a move-only type, although
+    then you'll need to use find() instead of operator[] to get at the values.
+
+    The hash function class works the same way as for HashMap. Each hash it generates
+    is scrambled before use, so it doesn't matter if your function produces clustered
+    values, but it should be given as many bits to work with as possible.
+
+    As well as the key type, the lookup methods accept a StringRef or a string literal,
+    so a map with String keys can be searched without creating a temporary String.
+
+    @code
+    FlatHashMap<String, int> map;
+    map.set ("one", 1);
+
+    if (const int* value = map.find (StringRef ("one")))
+        DBG (*value);
+
+    for (FlatHashMap<String, int>::Iterator i (map); i.next();)
+        DBG (i.getKey() << " -> " << i.getValue());
+    @endcode
+
+    @see HashMap, DefaultHashFunctions
+*/
+template <typename KeyType,
+          typename ValueType,
+          class HashFunctionType = DefaultHashFunctions,
+          class TypeOfCriticalSectionToUse = DummyCriticalSection>
+class FlatHashMap
+{
+private:
+    typedef PARAMETER_TYPE (KeyType)   KeyTypeParameter;
+    typedef PARAMETER_TYPE (ValueType) ValueTypeParameter;
+
+public:
+    //==============================================================================
+    /** Creates an empty map.
+
+        @param hashFunction An instance of HashFunctionType, which will be copied and
+                            stored to use with the map. This parameter can be omitted
+                            if HashFunctionType has a default constructor.
+    */
+    explicit FlatHashMap (HashFunctionType hashFunction = HashFunctionType())
+        : hashFunctionToUse (hashFunction)
+    {
+        resizeTable (minimumNumSlots);
+    }
+
+    /** Destructor. */
+    ~FlatHashMap() {}
+
+    //==============================================================================
+    /** Removes all values from the map.
+        This doesn't release the memory that the map is using.
+    */
+    void clear()
+    {
+        const ScopedLockType sl (getLock());
+
+        entries.clearQuick();
+        slots.clear ((size_t) numSlots);
+    }
+
+    /** Returns the current number of items in the map. */
+    inline int size() const noexcept                    { return entries.size(); }
+
+    /** Returns true if the map is empty. */
+    inline bool isEmpty() const noexcept                { return entries.size() == 0; }
+
+    /** Returns the value corresponding to a given key.
+        If the map doesn't contain the key, a default instance of the value type is returned.
+    */
+    inline ValueType operator[] (KeyTypeParameter keyToLookFor) const     { return getValueOrDefault (keyToLookFor); }
+    /** Returns the value corresponding to a given key. */
+    inline ValueType operator[] (StringRef keyToLookFor) const            { return getValueOrDefault (keyToLookFor); }
+    /** Returns the value corresponding to a given key. */
+    inline ValueType operator[] (const char* keyToLookFor) const          { return getValueOrDefault (StringRef (keyToLookFor)); }
+
+    /** Returns true if the map contains an item with the specified key. */
+    bool contains (KeyTypeParameter keyToLookFor) const     { return find (keyToLookFor) != nullptr; }
+    /** Returns true if the map contains an item with the specified key. */
+    bool contains (StringRef keyToLookFor) const            { return find (keyToLookFor) != nullptr; }
+    /** Returns true if the map contains an item with the specified key. */
+    bool contains (const char* keyToLookFor) const          { return find (StringRef (keyToLookFor)) != nullptr; }
+
+    /** Returns a pointer to the value for a given key, or nullptr if there isn't one.
+        The pointer is only valid until the map is next modified.
+    */
+    ValueType* find (KeyTypeParameter keyToLookFor) const noexcept    { return findValue (keyToLookFor); }
+    /** Returns a pointer to the value for a given key, or nullptr if there isn't one. */
+    ValueType* find (StringRef keyToLookFor) const noexcept           { return findValue (keyToLookFor); }
+    /** Returns a pointer to the value for a given key, or nullptr if there isn't one. */
+    ValueType* find (const char* keyToLookFor) const noexcept         { return findValue (StringRef (keyToLookFor)); }
+
+    /** Returns true if the map contains at least one occurrence of a given value. */
+    bool containsValue (ValueTypeParameter valueToLookFor) const
+    {
+        const ScopedLockType sl (getLock());
+
+        for (int i = entries.size(); --i >= 0;)
+            if (entries.getReference (i).value == valueToLookFor)
+                return true;
+
+        return false;
+    }
+
+    //==============================================================================
+    /** Adds or replaces an element in the map.
+        If there's already an item with the given key, this will replace its value.
+        Otherwise, a new item will be added to the map.
+    */
+    void set (KeyTypeParameter newKey, const ValueType& newValue)
+    {
+        const ScopedLockType sl (getLock());
+        const uint32 hash = getHashFor (newKey);
+        const int slot = findSlot (newKey, hash);
+
+        if (slot >= 0)
+        {
+            entries.getReference (slots[slot].index).value = newValue;
+        }
+        else
+        {
+            Entry entry = { hash, newKey, newValue };
+            addEntry (entry);
+        }
+    }
+
+   #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+    /** Adds or replaces an element in the map, moving the value into place. */
+    void set (KeyTypeParameter newKey, ValueType&& newValue)
+    {
+        const ScopedLockType sl (getLock());
+        const uint32 hash = getHashFor (newKey);
+        const int slot = findSlot (newKey, hash);
+
+        if (slot >= 0)
+        {
+            entries.getReference (slots[slot].index).value = static_cast<ValueType&&> (newValue);
+        }
+        else
+        {
+            Entry entry = { hash, newKey, static_cast<ValueType&&> (newValue) };
+            addEntry (entry);
+        }
+    }
+   #endif
+
+    /** Removes the item with the given key, if there is one.
+        @returns true if an item was removed
+    */
+    bool remove (KeyTypeParameter keyToRemove)
+    {
+        const ScopedLockType sl (getLock());
+        const int slot = findSlot (keyToRemove, getHashFor (keyToRemove));
+
+        if (slot < 0)
+            return false;
+
+        removeEntryAt (slot);
+        return true;
+    }
+
+    /** Removes all items with the given value. */
+    void removeValue (ValueTypeParameter valueToRemove)
+    {
+        const ScopedLockType sl (getLock());
+
+        for (int i = entries.size(); --i >= 0;)
+        {
+            const Entry& e = entries.getReference (i);
+
+            if (e.value == valueToRemove)
+                removeEntryAt (findSlotForIndex (e.hash, i));
+        }
+    }
+
+    /** Makes sure that the map can hold at least this many items without having to
+        reallocate anything.
+    */
+    void ensureStorageAllocated (const int numItems)
+    {
+        const ScopedLockType sl (getLock());
+
+        entries.ensureStorageAllocated (numItems);
+
+        if (numItems > getMaximumNumItems (numSlots))
+        {
+            int newNumSlots = numSlots;
+
+            while (numItems > getMaximumNumItems (newNumSlots))
+                newNumSlots *= 2;
+
+            resizeTable (newNumSlots);
+        }
+    }
+
+    /** Returns the number of slots in the hash table. This is always a power of two. */
+    inline int getNumSlots() const noexcept             { return numSlots; }
+
+    //==============================================================================
+    /** Efficiently swaps the contents of two maps. */
+    template <class OtherHashMapType>
+    void swapWith (OtherHashMapType& otherHashMap) noexcept
+    {
+        const ScopedLockType lock1 (getLock());
+        const typename OtherHashMapType::ScopedLockType lock2 (otherHashMap.getLock());
+
+        entries.swapWith (otherHashMap.entries);
+        slots.swapWith (otherHashMap.slots);
+        std::swap (numSlots, otherHashMap.numSlots);
+        std::swap (slotShift, otherHashMap.slotShift);
+    }
+
+    //==============================================================================
+    /** Returns the CriticalSection that locks this structure.
+        To lock, you can call getLock().enter() and getLock().exit(), or preferably use
+        an object of ScopedLockType as an RAII lock for it.
+    */
+    inline const TypeOfCriticalSectionToUse& getLock() const noexcept      { return lock; }
+
+    /** Returns the type of scoped lock to use for locking this array */
+    typedef typename TypeOfCriticalSectionToUse::ScopedLockType ScopedLockType;
+
+private:
+    //==============================================================================
+    struct Entry
+    {
+        uint32 hash;
+        KeyType key;
+        ValueType value;
+    };
+
+    // A hash of 0 marks an empty slot
+    struct Slot
+    {
+        uint32 hash;
+        int index;
+    };
+
+public:
+    //==============================================================================
+    /** Iterates over the items in a FlatHashMap.
+
+        To use it, repeatedly call next() until it returns false. The items are stored
+        contiguously, so this is much faster than iterating a HashMap. The order in which
+        they're visited isn't related to the order in which they were added.
+
+        As soon as you call any non-const methods on the map, any iterators that were
+        created beforehand will cease to be valid, and should not be used.
+
+        @see FlatHashMap
+    */
+    class Iterator
+    {
+    public:
+        //==============================================================================
+        Iterator (const FlatHashMap& hashMapToIterate) noexcept
+            : hashMap (hashMapToIterate), index (-1)
+        {}
+
+        /** Moves to the next item, if one is available.
+            When this returns true, you can get the item's key and value using getKey() and
+            getValue(). If it returns false, the iteration has finished and you should stop.
+        */
+        bool next() noexcept
+        {
+            return ++index < hashMap.entries.size();
+        }
+
+        /** Returns the current item's key.
+            This should only be called when a call to next() has just returned true.
+        */
+        const KeyType& getKey() const noexcept
+        {
+            return hashMap.entries.getReference (index).key;
+        }
+
+        /** Returns the current item's value.
+            This should only be called when a call to next() has just returned true.
+        */
+        const ValueType& getValue() const noexcept
+        {
+            return hashMap.entries.getReference (index).value;
+        }
+
+    private:
+        //==============================================================================
+        const FlatHashMap& hashMap;
+        int index;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Iterator)
+    };
+
+private:
+    //==============================================================================
+    enum { minimumNumSlots = 8 };
+    friend class Iterator;
+
+    HashFunctionType hashFunctionToUse;
+    Array<Entry> entries;
+    HeapBlock<Slot> slots;
+    int numSlots, slotShift;
+    TypeOfCriticalSectionToUse lock;
+
+    static int getMaximumNumItems (const int numSlotsInTable) noexcept     { return numSlotsInTable - numSlotsInTable / 8; }
+
+    template <typename KeyLookupType>
+    uint32 getHashFor (const KeyLookupType& key) const
+    {
+        const int hash = hashFunctionToUse.generateHash (key, 0x7fffffff);
+        jassert (hash >= 0); // your hash function is generating out-of-range numbers!
+
+        // Fibonacci hashing spreads the bits out, and the table index comes from the top
+        // bits, so the bottom one can be set to make sure that the result is never 0
+        return ((uint32) hash * 0x9e3779b9u) | 1u;
+    }
+
+    inline int getIdealSlot (const uint32 hash) const noexcept     { return (int) (hash >> slotShift); }
+
+    inline int getProbeDistance (const uint32 hash, const int slot) const noexcept
+    {
+        return (slot - getIdealSlot (hash)) & (numSlots - 1);
+    }
+
+    template <typename KeyLookupType>
+    int findSlot (const KeyLookupType& key, const uint32 hash) const noexcept
+    {
+        const int mask = numSlots - 1;
+
+        for (int slot = getIdealSlot (hash), distance = 0;; slot = (slot + 1) & mask, ++distance)
+        {
+            const Slot& s = slots[slot];
+
+            // with Robin Hood probing, the key can't be any further along than an item
+            // which is closer to its own ideal slot than the key would be
+            if (s.hash == 0 || getProbeDistance (s.hash, slot) < distance)
+                return -1;
+
+            if (s.hash == hash && entries.getReference (s.index).key == key)
+                return slot;
+        }
+    }
+
+    int findSlotForIndex (const uint32 hash, const int index) const noexcept
+    {
+        const int mask = numSlots - 1;
+        int slot = getIdealSlot (hash);
+
+        while (slots[slot].index != index || slots[slot].hash != hash)
+            slot = (slot + 1) & mask;
+
+        return slot;
+    }
+
+    template <typename KeyLookupType>
+    ValueType* findValue (const KeyLookupType& key) const noexcept
+    {
+        const ScopedLockType sl (getLock());
+        const int slot = findSlot (key, getHashFor (key));
+
+        return slot >= 0 ? &(entries.getReference (slots[slot].index).value) : nullptr;
+    }
+
+    template <typename KeyLookupType>
+    ValueType getValueOrDefault (const KeyLookupType& key) const
+    {
+        const ScopedLockType sl (getLock());
+
+        if (const ValueType* const v = findValue (key))
+            return *v;
+
+        return ValueType();
+    }
+
+    void addEntry (Entry& entry)
+    {
+        if (entries.size() >= getMaximumNumItems (numSlots))
+            resizeTable (numSlots * 2);
+
+        const uint32 hash = entry.hash;
+
+       #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+        entries.add (static_cast<Entry&&> (entry));
+       #else
+        entries.add (entry);
+       #endif
+
+        insertSlot (hash, entries.size() - 1);
+    }
+
+    void insertSlot (uint32 hash, int index) noexcept
+    {
+        const int mask = numSlots - 1;
+
+        for (int slot = getIdealSlot (hash), distance = 0;; slot = (slot + 1) & mask, ++distance)
+        {
+            Slot& s = slots[slot];
+
+            if (s.hash == 0)
+            {
+                s.hash = hash;
+                s.index = index;
+                return;
+            }
+
+            // take the place of any item that's closer to its ideal slot than this one
+            const int existingDistance = getProbeDistance (s.hash, slot);
+
+            if (existingDistance < distance)
+            {
+                std::swap (s.hash, hash);
+                std::swap (s.index, index);
+                distance = existingDistance;
+            }
+        }
+    }
+
+    void removeEntryAt (int slot)
+    {
+        const int index = slots[slot].index;
+        const int mask = numSlots - 1;
+
+        // shift the following items back until one is found that's already in its ideal slot
+        for (;;)
+        {
+            const int next = (slot + 1) & mask;
+
+            if (slots[next].hash == 0 || getProbeDistance (slots[next].hash, next) == 0)
+                break;
+
+            slots[slot] = slots[next];
+            slot = next;
+        }
+
+        slots[slot].hash = 0;
+
+        // fill the gap in the entries array with the last one
+        const int lastIndex = entries.size() - 1;
+
+        if (index != lastIndex)
+        {
+            Entry& last = entries.getReference (lastIndex);
+            slots [findSlotForIndex (last.hash, lastIndex)].index = index;
+
+           #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+            entries.getReference (index) = static_cast<Entry&&> (last);
+           #else
+            entries.getReference (index) = last;
+           #endif
+        }
+
+        entries.removeLast();
+    }
+
+    void resizeTable (const int newNumSlots)
+    {
+        jassert (isPowerOfTwo (newNumSlots));
+
+        slots.calloc ((size_t) newNumSlots);
+        numSlots = newNumSlots;
+        slotShift = 32;
+
+        for (int n = newNumSlots; n > 1; n >>= 1)
+            --slotShift;
+
+        for (int i = 0; i < entries.size(); ++i)
+            insertSlot (entries.getReference (i).hash, i);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlatHashMap)
+};
+
+#endif   // JUCE_FLATHASHMAP_H_INCLUDED
@@ -44,6 +44,16 @@ struct DefaultHashFunctions
     int generateHash (const int64 key, const int upperLimit) const noexcept      { return std::abs ((int) key) % upperLimit; }
     /** Generates a simple hash from a string. */
     int generateHash (const String& key, const int upperLimit) const noexcept    { return (int) (((uint32) key.hashCode()) % (uint32) upperLimit); }
+    /** Generates a simple hash from a StringRef, which matches the hash of an equal String. */
+    int generateHash (StringRef key, const int upperLimit) const noexcept
+    {
+        uint32 hash = 0;
+
+        for (String::CharPointerType t (key.text); ! t.isEmpty();)
+            hash = 31 * hash + (uint32) t.getAndAdvance();
+
+        return (int) (hash % (uint32) upperLimit);
+    }
     /** Generates a simple hash from a variant. */
     int generateHash (const var& key, const int upperLimit) const noexcept       { return generateHash (key.toString(), upperLimit); }
 };
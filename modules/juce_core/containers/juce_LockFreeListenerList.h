@@ -0,0 +1,379 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_LOCKFREELISTENERLIST_H_INCLUDED
+#define JUCE_LOCKFREELISTENERLIST_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A list of listener objects which can be called from a realtime thread without
+    taking a lock.
+
+    This works like a ListenerList, but iterating it never blocks or allocates, so it's
+    safe to call listeners from an audio callback while other threads are adding and
+    removing them. Adding and removing listeners takes a lock, but that lock is only
+    shared between the threads that modify the list.
+
+    The listeners are held in a block of slots. Removing a listener clears its slot,
+    so an iteration that's in progress on any thread won't call it once remove() has
+    returned, unless that call had already started. Adding a listener normally fills
+    the next free slot at the end of the block. When the block is full, a new one is
+    allocated. The old block stays alive until no iterations are using it.
+
+    As with ListenerList, listeners can safely add or remove themselves (or each other)
+    during a callback. Listeners are called in the reverse of the order in which they
+    were added, and any listener added during a callback won't be called until the
+    next iteration.
+
+    e.g.
+    @code
+    LockFreeListenerList<MyListenerType> listeners;
+    listeners.add (someCallbackObject);
+
+    // This can be called from any thread, and will invoke myCallbackMethod (1234, true)
+    // on each of the objects in the list...
+    listeners.call (&MyListenerType::myCallbackMethod, 1234, true);
+    @endcode
+
+    @see ListenerList
+*/
+template <class ListenerClass>
+class LockFreeListenerList
+{
+public:
+    //==============================================================================
+    /** Creates an empty list. */
+    LockFreeListenerList() noexcept
+        : retiredBlocks (nullptr)
+    {
+    }
+
+    /** Destructor. */
+    ~LockFreeListenerList()
+    {
+        // deleting the list while another thread is iterating it would be a bad idea!
+        jassert (numActiveIterators.get() == 0);
+
+        delete currentBlock.get();
+        deleteRetiredBlocks();
+    }
+
+    //==============================================================================
+    /** Adds a listener to the list.
+        A listener can only be added once, so if the listener is already in the list,
+        this method has no effect.
+    */
+    void add (ListenerClass* const listenerToAdd)
+    {
+        // Listeners can't be null pointers!
+        jassert (listenerToAdd != nullptr);
+
+        if (listenerToAdd == nullptr)
+            return;
+
+        const ScopedLock sl (writeLock);
+        Block* block = currentBlock.get();
+
+        if (block != nullptr)
+        {
+            if (block->indexOf (listenerToAdd) >= 0)
+                return;
+
+            if (block->numUsed.get() >= block->capacity)
+                block = replaceBlock (block);
+        }
+        else
+        {
+            block = new Block (8);
+            currentBlock = block;
+        }
+
+        // (the slot is filled before the count is increased, so an iterator never sees an unset slot)
+        block->slots [block->numUsed.get()] = listenerToAdd;
+        ++(block->numUsed);
+        ++numListeners;
+
+        deleteRetiredBlocksIfUnused();
+    }
+
+    /** Removes a listener from the list.
+        If the listener wasn't in the list, this has no effect.
+    */
+    void remove (ListenerClass* const listenerToRemove)
+    {
+        // Listeners can't be null pointers!
+        jassert (listenerToRemove != nullptr);
+
+        const ScopedLock sl (writeLock);
+
+        if (Block* const block = currentBlock.get())
+        {
+            const int index = block->indexOf (listenerToRemove);
+
+            if (index >= 0)
+            {
+                block->slots [index] = nullptr;
+                --numListeners;
+
+                // (an iterator may still be working through an older block on this thread)
+                for (Block* b = retiredBlocks; b != nullptr; b = b->nextRetired)
+                    b->clearSlotFor (listenerToRemove);
+            }
+        }
+
+        deleteRetiredBlocksIfUnused();
+    }
+
+    /** Returns the number of registered listeners. */
+    int size() const noexcept                       { return numListeners.get(); }
+
+    /** Returns true if no listeners are registered. */
+    bool isEmpty() const noexcept                   { return numListeners.get() == 0; }
+
+    /** Removes all the listeners. */
+    void clear()
+    {
+        const ScopedLock sl (writeLock);
+
+        if (Block* const block = currentBlock.get())
+            block->clearAllSlots();
+
+        for (Block* b = retiredBlocks; b != nullptr; b = b->nextRetired)
+            b->clearAllSlots();
+
+        numListeners = 0;
+        deleteRetiredBlocksIfUnused();
+    }
+
+    /** Returns true if the specified listener has been added to the list. */
+    bool contains (ListenerClass* const listener) const noexcept
+    {
+        const ScopedLock sl (writeLock);
+        const Block* const block = currentBlock.get();
+        return block != nullptr && block->indexOf (listener) >= 0;
+    }
+
+    //==============================================================================
+    /** Calls a member function on each listener in the list, with no parameters. */
+    void call (void (ListenerClass::*callbackFunction) ())
+    {
+        for (Iterator iter (*this); iter.next();)
+            (iter.getListener()->*callbackFunction) ();
+    }
+
+    /** Calls a member function on each listener in the list, with 1 parameter. */
+    template <typename P1>
+    void call (void (ListenerClass::*callbackFunction) (P1), PARAMETER_TYPE(P1) param1)
+    {
+        for (Iterator iter (*this); iter.next();)
+            (iter.getListener()->*callbackFunction) (param1);
+    }
+
+    /** Calls a member function on each listener in the list, with 2 parameters. */
+    template <typename P1, typename P2>
+    void call (void (ListenerClass::*callbackFunction) (P1, P2),
+               PARAMETER_TYPE(P1) param1, PARAMETER_TYPE(P2) param2)
+    {
+        for (Iterator iter (*this); iter.next();)
+            (iter.getListener()->*callbackFunction) (param1, param2);
+    }
+
+    /** Calls a member function on each listener in the list, with 3 parameters. */
+    template <typename P1, typename P2, typename P3>
+    void call (void (ListenerClass::*callbackFunction) (P1, P2, P3),
+               PARAMETER_TYPE(P1) param1, PARAMETER_TYPE(P2) param2, PARAMETER_TYPE(P3) param3)
+    {
+        for (Iterator iter (*this); iter.next();)
+            (iter.getListener()->*callbackFunction) (param1, param2, param3);
+    }
+
+    /** Calls a member function on each listener in the list, with 4 parameters. */
+    template <typename P1, typename P2, typename P3, typename P4>
+    void call (void (ListenerClass::*callbackFunction) (P1, P2, P3, P4),
+               PARAMETER_TYPE(P1) param1, PARAMETER_TYPE(P2) param2, PARAMETER_TYPE(P3) param3,
+               PARAMETER_TYPE(P4) param4)
+    {
+        for (Iterator iter (*this); iter.next();)
+            (iter.getListener()->*callbackFunction) (param1, param2, param3, param4);
+    }
+
+    /** Calls a member function on each listener in the list, with 5 parameters. */
+    template <typename P1, typename P2, typename P3, typename P4, typename P5>
+    void call (void (ListenerClass::*callbackFunction) (P1, P2, P3, P4, P5),
+               PARAMETER_TYPE(P1) param1, PARAMETER_TYPE(P2) param2, PARAMETER_TYPE(P3) param3,
+               PARAMETER_TYPE(P4) param4, PARAMETER_TYPE(P5) param5)
+    {
+        for (Iterator iter (*this); iter.next();)
+            (iter.getListener()->*callbackFunction) (param1, param2, param3, param4, param5);
+    }
+
+    //==============================================================================
+    /** Iterates the listeners in a LockFreeListenerList.
+
+        While an Iterator exists, the block of listeners that it's using won't be deleted,
+        so iterators should be short-lived local objects.
+    */
+    class Iterator
+    {
+    public:
+        Iterator (const LockFreeListenerList& listToIterate) noexcept
+            : list (listToIterate),
+              block (listToIterate.beginIteration()),
+              index (block != nullptr ? block->numUsed.get() : 0),
+              current (nullptr)
+        {
+        }
+
+        ~Iterator() noexcept
+        {
+            list.endIteration();
+        }
+
+        /** Moves on to the next listener, returning false when there are no more. */
+        bool next() noexcept
+        {
+            while (--index >= 0)
+                if ((current = block->slots[index].get()) != nullptr)
+                    return true;
+
+            current = nullptr;
+            return false;
+        }
+
+        /** Returns the listener that the iterator is currently pointing at. */
+        ListenerClass* getListener() const noexcept     { return current; }
+
+    private:
+        const LockFreeListenerList& list;
+        const typename LockFreeListenerList::Block* const block;
+        int index;
+        ListenerClass* current;
+
+        JUCE_DECLARE_NON_COPYABLE (Iterator)
+    };
+
+private:
+    //==============================================================================
+    struct Block
+    {
+        Block (const int numSlots)
+            : capacity (numSlots), slots ((size_t) numSlots, true), nextRetired (nullptr)
+        {
+        }
+
+        int indexOf (ListenerClass* const listener) const noexcept
+        {
+            for (int i = numUsed.get(); --i >= 0;)
+                if (slots[i].get() == listener)
+                    return i;
+
+            return -1;
+        }
+
+        void clearSlotFor (ListenerClass* const listener) noexcept
+        {
+            const int index = indexOf (listener);
+
+            if (index >= 0)
+                slots [index] = nullptr;
+        }
+
+        void clearAllSlots() noexcept
+        {
+            for (int i = numUsed.get(); --i >= 0;)
+                slots [i] = nullptr;
+        }
+
+        const int capacity;
+        Atomic<int> numUsed;
+        HeapBlock<Atomic<ListenerClass*> > slots;
+        Block* nextRetired;
+
+        JUCE_DECLARE_NON_COPYABLE (Block)
+    };
+
+    CriticalSection writeLock;
+    Atomic<Block*> currentBlock;
+    Block* retiredBlocks;
+    Atomic<int> numListeners;
+    mutable Atomic<int> numActiveIterators;
+
+    const Block* beginIteration() const noexcept
+    {
+        // (the count must be increased before the block is read, so that a writer which sees a
+        // count of zero knows that nobody can still be using a block it has just replaced)
+        ++numActiveIterators;
+        return currentBlock.get();
+    }
+
+    void endIteration() const noexcept
+    {
+        --numActiveIterators;
+    }
+
+    // Copies the listeners that are still in use into a new block, with room to add more.
+    Block* replaceBlock (Block* const oldBlock)
+    {
+        Block* const newBlock = new Block (jmax (8, numListeners.get() * 2));
+
+        int numCopied = 0;
+
+        for (int i = 0; i < oldBlock->numUsed.get(); ++i)
+            if (ListenerClass* const l = oldBlock->slots[i].get())
+                newBlock->slots [numCopied++] = l;
+
+        newBlock->numUsed = numCopied;
+        currentBlock = newBlock;
+
+        oldBlock->nextRetired = retiredBlocks;
+        retiredBlocks = oldBlock;
+        return newBlock;
+    }
+
+    void deleteRetiredBlocksIfUnused()
+    {
+        if (retiredBlocks != nullptr && numActiveIterators.get() == 0)
+            deleteRetiredBlocks();
+    }
+
+    void deleteRetiredBlocks()
+    {
+        while (retiredBlocks != nullptr)
+        {
+            Block* const next = retiredBlocks->nextRetired;
+            delete retiredBlocks;
+            retiredBlocks = next;
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (LockFreeListenerList)
+};
+
+
+#endif   // JUCE_LOCKFREELISTENERLIST_H_INCLUDED
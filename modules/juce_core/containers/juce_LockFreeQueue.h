@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_LOCKFREEQUEUE_H_INCLUDED
+#define JUCE_LOCKFREEQUEUE_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A bounded, lock-free queue that can be used by any number of writer and reader threads.
+
+    This is useful when several threads need to send messages to a realtime thread
+    without using a lock. Each slot in the queue has a sequence number which the writers
+    and readers use to claim it, so none of the operations ever block or allocate.
+
+    When there's only a single reader thread, pop() never has to retry, so it's safe to
+    call from an audio callback.
+
+    The ElementType must be copyable and default-constructible. Elements are copied in
+    and out of the queue, so for larger objects you may want to use pointers.
+
+    e.g.
+    @code
+    LockFreeQueue<MidiMessage> queue (256);
+
+    // on any thread..
+    if (! queue.push (MidiMessage::noteOn (1, 60, 1.0f)))
+        handleQueueOverflow();
+
+    // on the audio thread..
+    MidiMessage m;
+    while (queue.pop (m))
+        handleMessage (m);
+    @endcode
+
+    @see AbstractFifo, FifoBuffer
+*/
+template <typename ElementType>
+class LockFreeQueue
+{
+public:
+    //==============================================================================
+    /** Creates a queue which can hold the given number of elements.
+        The capacity will be rounded up to a power of two.
+    */
+    LockFreeQueue (int capacity)
+        : bufferSize (nextPowerOfTwo (jmax (2, capacity))),
+          mask ((uint32) bufferSize - 1),
+          cells ((size_t) bufferSize)
+    {
+        for (int i = 0; i < bufferSize; ++i)
+            new (cells + i) Cell ((uint32) i);
+
+        writePosition = 0;
+        readPosition = 0;
+    }
+
+    /** Destructor. */
+    ~LockFreeQueue()
+    {
+        for (int i = 0; i < bufferSize; ++i)
+            cells[i].~Cell();
+    }
+
+    //==============================================================================
+    /** Adds an element to the end of the queue.
+        This can be called by any number of threads at once.
+        @returns false if the queue was full, in which case nothing is added
+    */
+    bool push (const ElementType& newElement) noexcept
+    {
+        Cell* cell;
+        uint32 pos = (uint32) writePosition.get();
+
+        for (;;)
+        {
+            cell = cells + (pos & mask);
+            const int diff = (int) ((uint32) cell->sequence.get() - pos);
+
+            if (diff == 0)
+            {
+                // the slot is free - try to claim it
+                if (writePosition.compareAndSetBool ((int) (pos + 1), (int) pos))
+                    break;
+
+                pos = (uint32) writePosition.get();
+            }
+            else if (diff < 0)
+            {
+                return false; // the slot still holds an element that hasn't been read
+            }
+            else
+            {
+                pos = (uint32) writePosition.get();
+            }
+        }
+
+        cell->value = newElement;
+        cell->sequence = (int) (pos + 1);
+        return true;
+    }
+
+    /** Removes the element at the front of the queue.
+        This can be called by any number of threads at once.
+        @returns false if the queue was empty, in which case the result is left unchanged
+    */
+    bool pop (ElementType& result) noexcept
+    {
+        Cell* cell;
+        uint32 pos = (uint32) readPosition.get();
+
+        for (;;)
+        {
+            cell = cells + (pos & mask);
+            const int diff = (int) ((uint32) cell->sequence.get() - (pos + 1));
+
+            if (diff == 0)
+            {
+                if (readPosition.compareAndSetBool ((int) (pos + 1), (int) pos))
+                    break;
+
+                pos = (uint32) readPosition.get();
+            }
+            else if (diff < 0)
+            {
+                return false; // nothing has been written to this slot yet
+            }
+            else
+            {
+                pos = (uint32) readPosition.get();
+            }
+        }
+
+        result = cell->value;
+        cell->value = ElementType();
+        cell->sequence = (int) (pos + mask + 1);
+        return true;
+    }
+
+    //==============================================================================
+    /** Returns the maximum number of elements that the queue can hold. */
+    int getCapacity() const noexcept                { return bufferSize; }
+
+    /** Returns the number of elements in the queue.
+        If other threads are using the queue at the same time, this can only be an estimate.
+    */
+    int getNumReady() const noexcept
+    {
+        return jlimit (0, bufferSize, (int) ((uint32) writePosition.get() - (uint32) readPosition.get()));
+    }
+
+    /** Returns true if the queue is empty.
+        If other threads are using the queue at the same time, this can only be an estimate.
+    */
+    bool isEmpty() const noexcept                   { return getNumReady() == 0; }
+
+private:
+    //==============================================================================
+    struct Cell
+    {
+        Cell (uint32 initialSequence)  : value()   { sequence = (int) initialSequence; }
+
+        Atomic<int> sequence;
+        ElementType value;
+    };
+
+    const int bufferSize;
+    const uint32 mask;
+    HeapBlock<Cell> cells;
+
+    // (the padding keeps the read and write positions on separate cache lines)
+    char paddingBeforeWritePosition[64];
+    Atomic<int> writePosition;
+    char paddingBeforeReadPosition[64];
+    Atomic<int> readPosition;
+
+    JUCE_DECLARE_NON_COPYABLE (LockFreeQueue)
+};
+
+
+#endif   // JUCE_LOCKFREEQUEUE_H_INCLUDED
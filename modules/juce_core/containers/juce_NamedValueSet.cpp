@@ -59,31 +59,43 @@ struct NamedValueSet::NamedValue
 };
 
 //==============================================================================
+// Sets smaller than this are just searched linearly, which is quicker than hashing
+// when there are only a few names to compare.
+static const int minNamedValuesForHashTable = 16;
+
 NamedValueSet::NamedValueSet() noexcept
+    : hashTableSize (0)
 {
 }
 
 NamedValueSet::NamedValueSet (const NamedValueSet& other)
-   : values (other.values)
+   : values (other.values), hashTableSize (0)
 {
+    rebuildHashTable();
 }
 
 NamedValueSet& NamedValueSet::operator= (const NamedValueSet& other)
 {
     clear();
     values = other.values;
+    rebuildHashTable();
     return *this;
 }
 
 #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
 NamedValueSet::NamedValueSet (NamedValueSet&& other) noexcept
-    : values (static_cast <Array<NamedValue>&&> (other.values))
+    : values (static_cast <Array<NamedValue>&&> (other.values)),
+      hashTable (static_cast <HeapBlock<int>&&> (other.hashTable)),
+      hashTableSize (other.hashTableSize)
 {
+    other.hashTableSize = 0;
 }
 
 NamedValueSet& NamedValueSet::operator= (NamedValueSet&& other) noexcept
 {
     other.values.swapWith (values);
+    other.hashTable.swapWith (hashTable);
+    std::swap (other.hashTableSize, hashTableSize);
     return *this;
 }
 #endif
@@ -95,6 +107,81 @@ NamedValueSet::~NamedValueSet() noexcept
 void NamedValueSet::clear()
 {
     values.clear();
+    hashTable.free();
+    hashTableSize = 0;
+}
+
+//==============================================================================
+// The hash table holds (index + 1) for each item in the values array, with 0 marking an
+// empty slot. Identifiers are pooled, so the address of the name's text identifies it.
+static inline uint32 getNamedValueSetHash (const Identifier& name) noexcept
+{
+    const uint32 h = (uint32) (((pointer_sized_uint) name.getCharPointer().getAddress()) >> 3) * 0x9e3779b9u;
+    return h ^ (h >> 16);
+}
+
+int NamedValueSet::findInHashTable (const Identifier& name) const noexcept
+{
+    const uint32 mask = (uint32) hashTableSize - 1;
+
+    for (uint32 i = getNamedValueSetHash (name) & mask;; i = (i + 1) & mask)
+    {
+        const int entry = hashTable[i];
+
+        if (entry == 0)
+            return -1;
+
+        if (values.getReference (entry - 1).name == name)
+            return entry - 1;
+    }
+}
+
+void NamedValueSet::addToHashTable (const int index) noexcept
+{
+    const uint32 mask = (uint32) hashTableSize - 1;
+    uint32 i = getNamedValueSetHash (values.getReference (index).name) & mask;
+
+    while (hashTable[i] != 0)
+        i = (i + 1) & mask;
+
+    hashTable[i] = index + 1;
+}
+
+void NamedValueSet::rebuildHashTable()
+{
+    const int numValues = values.size();
+
+    if (numValues < minNamedValuesForHashTable)
+    {
+        hashTable.free();
+        hashTableSize = 0;
+        return;
+    }
+
+    // (keeping the table no more than half full means new items can be added for a
+    // while before it needs rebuilding)
+    int newSize = 64;
+    while (newSize < numValues * 4)
+        newSize <<= 1;
+
+    if (newSize != hashTableSize)
+    {
+        hashTable.malloc ((size_t) newSize);
+        hashTableSize = newSize;
+    }
+
+    hashTable.clear ((size_t) hashTableSize);
+
+    for (int i = 0; i < numValues; ++i)
+        addToHashTable (i);
+}
+
+void NamedValueSet::valueAdded()
+{
+    if (hashTableSize > 0 && values.size() * 2 <= hashTableSize)
+        addToHashTable (values.size() - 1);
+    else if (values.size() >= minNamedValuesForHashTable)
+        rebuildHashTable();
 }
 
 bool NamedValueSet::operator== (const NamedValueSet& other) const
@@ -130,6 +217,12 @@ var NamedValueSet::getWithDefault (const Identifier& name, const var& defaultRet
 
 var* NamedValueSet::getVarPointer (const Identifier& name) const noexcept
 {
+    if (hashTableSize > 0)
+    {
+        const int index = findInHashTable (name);
+        return index >= 0 ? &(values.getReference (index).value) : nullptr;
+    }
+
     for (NamedValue* e = values.end(), *i = values.begin(); i != e; ++i)
         if (i->name == name)
             return &(i->value);
@@ -137,6 +230,25 @@ var* NamedValueSet::getVarPointer (const Identifier& name) const noexcept
     return nullptr;
 }
 
+var* NamedValueSet::getVarPointer (const Identifier& name, int& indexHint) const noexcept
+{
+    if (isPositiveAndBelow (indexHint, values.size()))
+    {
+        NamedValue& v = values.getReference (indexHint);
+
+        if (v.name == name)
+            return &(v.value);
+    }
+
+    const int index = indexOf (name);
+
+    if (index < 0)
+        return nullptr;
+
+    indexHint = index;
+    return &(values.getReference (index).value);
+}
+
 #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
 bool NamedValueSet::set (Identifier name, var&& newValue)
 {
@@ -150,6 +262,7 @@ bool NamedValueSet::set (Identifier name, var&& newValue)
     }
 
     values.add (NamedValue (name, static_cast<var&&> (newValue)));
+    valueAdded();
     return true;
 }
 #endif
@@ -166,6 +279,7 @@ bool NamedValueSet::set (Identifier name, const var& newValue)
     }
 
     values.add (NamedValue (name, newValue));
+    valueAdded();
     return true;
 }
 
@@ -176,6 +290,9 @@ bool NamedValueSet::contains (const Identifier& name) const noexcept
 
 int NamedValueSet::indexOf (const Identifier& name) const noexcept
 {
+    if (hashTableSize > 0)
+        return findInHashTable (name);
+
     const int numValues = values.size();
 
     for (int i = 0; i < numValues; ++i)
@@ -187,18 +304,18 @@ int NamedValueSet::indexOf (const Identifier& name) const noexcept
 
 bool NamedValueSet::remove (const Identifier& name)
 {
-    const int numValues = values.size();
+    const int index = indexOf (name);
 
-    for (int i = 0; i < numValues; ++i)
-    {
-        if (values.getReference(i).name == name)
-        {
-            values.remove (i);
-            return true;
-        }
-    }
+    if (index < 0)
+        return false;
+
+    values.remove (index);
 
-    return false;
+    // (removing an item shifts the indexes of everything after it)
+    if (hashTableSize > 0)
+        rebuildHashTable();
+
+    return true;
 }
 
 Identifier NamedValueSet::getName (const int index) const noexcept
@@ -231,7 +348,7 @@ void NamedValueSet::setFromXmlAttributes (const XmlElement& xml)
 {
     values.clearQuick();
 
-    for (const XmlElement::XmlAttributeNode* att = xml.attributes; att != nullptr; att = att->nextListItem)
+    for (const XmlElement::XmlAttributeNode* att = xml.attributes.begin(), * const end = xml.attributes.end(); att != end; ++att)
     {
         if (att->name.toString().startsWith ("base64:"))
         {
@@ -246,6 +363,8 @@ void NamedValueSet::setFromXmlAttributes (const XmlElement& xml)
 
         values.add (NamedValue (att->name, var (att->value)));
     }
+
+    rebuildHashTable();
 }
 
 void NamedValueSet::copyToXmlAttributes (XmlElement& xml) const
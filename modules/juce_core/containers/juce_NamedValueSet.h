@@ -35,6 +35,10 @@
 
     This can be used as a basic structure to hold a set of var object, which can
     be retrieved by using their identifier.
+
+    The values are kept in the order in which they were added. Small sets are searched
+    linearly, but once a set grows beyond a few dozen items it also keeps a hash index
+    of the names, so that looking up a name doesn't get slower as the set grows.
 */
 class JUCE_API  NamedValueSet
 {
@@ -110,6 +114,16 @@ public:
     */
     var* getVarPointer (const Identifier& name) const noexcept;
 
+    /** Returns a pointer to the var that holds a named value, or null if there is
+        no value with this name.
+
+        This checks the item at indexHint first, and if the name isn't there, it does a
+        normal search and sets indexHint to the index where the name was found. If you
+        keep the hint between calls, repeated lookups of the same name (or of the same
+        name in sets which were built in the same order) won't need to search.
+    */
+    var* getVarPointer (const Identifier& name, int& indexHint) const noexcept;
+
     /** Returns the value of the item at a given index.
         The index must be between 0 and size() - 1.
     */
@@ -139,6 +153,13 @@ private:
     //==============================================================================
     struct NamedValue;
     Array<NamedValue> values;
+    HeapBlock<int> hashTable;
+    int hashTableSize;
+
+    int findInHashTable (const Identifier&) const noexcept;
+    void addToHashTable (int index) noexcept;
+    void rebuildHashTable();
+    void valueAdded();
 };
 
 
@@ -122,6 +122,28 @@ public:
         clear();
     }
 
+   #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+    /** Takes over the objects from another array, without changing their reference counts. */
+    ReferenceCountedArray (ReferenceCountedArray&& other) noexcept
+        : data (static_cast <ArrayAllocationBase <ObjectClass*, TypeOfCriticalSectionToUse>&&> (other.data)),
+          numUsed (other.numUsed)
+    {
+        other.numUsed = 0;
+    }
+
+    /** Releases this array's objects, and takes over the objects from another array. */
+    ReferenceCountedArray& operator= (ReferenceCountedArray&& other) noexcept
+    {
+        const ScopedLockType lock (getLock());
+        clear();
+
+        data = static_cast <ArrayAllocationBase <ObjectClass*, TypeOfCriticalSectionToUse>&&> (other.data);
+        numUsed = other.numUsed;
+        other.numUsed = 0;
+        return *this;
+    }
+   #endif
+
     //==============================================================================
     /** Removes all objects from the array.
 
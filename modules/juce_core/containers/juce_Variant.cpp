@@ -43,9 +43,14 @@ enum VariantStreamMarkers
 class var::VariantType
 {
 public:
-    VariantType() noexcept {}
+    VariantType (bool trivial = true) noexcept : isTrivial (trivial) {}
     virtual ~VariantType() noexcept {}
 
+    /** True if values of this type can be copied bitwise and need no clean-up, which
+        lets var skip the virtual calls when copying or destroying them.
+    */
+    const bool isTrivial;
+
     virtual int toInt (const ValueUnion&) const noexcept                        { return 0; }
     virtual int64 toInt64 (const ValueUnion&) const noexcept                    { return 0; }
     virtual double toDouble (const ValueUnion&) const noexcept                  { return 0; }
@@ -221,7 +226,7 @@ public:
 class var::VariantType_String   : public var::VariantType
 {
 public:
-    VariantType_String() noexcept {}
+    VariantType_String() noexcept : VariantType (false) {}
     static const VariantType_String instance;
 
     void cleanUp (ValueUnion& data) const noexcept override                       { getString (data)-> ~String(); }
@@ -252,7 +257,6 @@ public:
         output.write (temp, len);
     }
 
-private:
     static inline const String* getString (const ValueUnion& data) noexcept { return reinterpret_cast<const String*> (data.stringValue); }
     static inline String* getString (ValueUnion& data) noexcept             { return reinterpret_cast<String*> (data.stringValue); }
 };
@@ -261,7 +265,7 @@ private:
 class var::VariantType_Object   : public var::VariantType
 {
 public:
-    VariantType_Object() noexcept {}
+    VariantType_Object() noexcept : VariantType (false) {}
     static const VariantType_Object instance;
 
     void cleanUp (ValueUnion& data) const noexcept override   { if (data.objectValue != nullptr) data.objectValue->decReferenceCount(); }
@@ -312,10 +316,13 @@ public:
 
     Array<var>* toArray (const ValueUnion& data) const noexcept override
     {
-        if (RefCountedArray* a = dynamic_cast<RefCountedArray*> (data.objectValue))
-            return &(a->array);
+        // (the object is always a RefCountedArray, as that's all the var constructors create)
+        return getArray (data);
+    }
 
-        return nullptr;
+    static inline Array<var>* getArray (const ValueUnion& data) noexcept
+    {
+        return &(static_cast<RefCountedArray*> (data.objectValue)->array);
     }
 
     bool equals (const ValueUnion& data, const ValueUnion& otherData, const VariantType& otherType) const noexcept override
@@ -367,7 +374,7 @@ public:
 class var::VariantType_Binary   : public var::VariantType
 {
 public:
-    VariantType_Binary() noexcept {}
+    VariantType_Binary() noexcept : VariantType (false) {}
 
     static const VariantType_Binary instance;
 
@@ -432,14 +439,17 @@ const var::VariantType_Method       var::VariantType_Method::instance;
 //==============================================================================
 var::var() noexcept : type (&VariantType_Void::instance) {}
 var::var (const VariantType& t) noexcept  : type (&t) {}
-var::~var() noexcept  { type->cleanUp (value); }
+var::~var() noexcept  { if (! type->isTrivial) type->cleanUp (value); }
 
 const var var::null;
 
 //==============================================================================
 var::var (const var& valueToCopy)  : type (valueToCopy.type)
 {
-    type->createCopy (value, valueToCopy.value);
+    if (type->isTrivial)
+        value = valueToCopy.value;
+    else
+        type->createCopy (value, valueToCopy.value);
 }
 
 var::var (const int v) noexcept       : type (&VariantType_Int::instance)    { value.intValue = v; }
@@ -465,29 +475,52 @@ var::var (ReferenceCountedObject* const object)  : type (&VariantType_Object::in
 var var::undefined() noexcept           { return var (VariantType_Undefined::instance); }
 
 //==============================================================================
-bool var::isVoid() const noexcept       { return type->isVoid(); }
-bool var::isUndefined() const noexcept  { return type->isUndefined(); }
-bool var::isInt() const noexcept        { return type->isInt(); }
-bool var::isInt64() const noexcept      { return type->isInt64(); }
-bool var::isBool() const noexcept       { return type->isBool(); }
-bool var::isDouble() const noexcept     { return type->isDouble(); }
-bool var::isString() const noexcept     { return type->isString(); }
-bool var::isObject() const noexcept     { return type->isObject(); }
-bool var::isArray() const noexcept      { return type->isArray(); }
-bool var::isBinaryData() const noexcept { return type->isBinary(); }
-bool var::isMethod() const noexcept     { return type->isMethod(); }
-
-var::operator int() const noexcept                      { return type->toInt (value); }
-var::operator int64() const noexcept                    { return type->toInt64 (value); }
-var::operator bool() const noexcept                     { return type->toBool (value); }
-var::operator float() const noexcept                    { return (float) type->toDouble (value); }
-var::operator double() const noexcept                   { return type->toDouble (value); }
-String var::toString() const                            { return type->toString (value); }
-var::operator String() const                            { return type->toString (value); }
-ReferenceCountedObject* var::getObject() const noexcept { return type->toObject (value); }
-Array<var>* var::getArray() const noexcept              { return type->toArray (value); }
-MemoryBlock* var::getBinaryData() const noexcept        { return type->toBinary (value); }
-DynamicObject* var::getDynamicObject() const noexcept   { return dynamic_cast<DynamicObject*> (getObject()); }
+// Each type has a single instance, so the type pointer works as a tag: the checks and the
+// common conversions below just compare it, and only fall back to a virtual call when the
+// value needs converting to a different type.
+bool var::isVoid() const noexcept       { return type == &VariantType_Void::instance; }
+bool var::isUndefined() const noexcept  { return type == &VariantType_Undefined::instance; }
+bool var::isInt() const noexcept        { return type == &VariantType_Int::instance; }
+bool var::isInt64() const noexcept      { return type == &VariantType_Int64::instance; }
+bool var::isBool() const noexcept       { return type == &VariantType_Bool::instance; }
+bool var::isDouble() const noexcept     { return type == &VariantType_Double::instance; }
+bool var::isString() const noexcept     { return type == &VariantType_String::instance; }
+bool var::isObject() const noexcept     { return type == &VariantType_Object::instance || type == &VariantType_Array::instance; }
+bool var::isArray() const noexcept      { return type == &VariantType_Array::instance; }
+bool var::isBinaryData() const noexcept { return type == &VariantType_Binary::instance; }
+bool var::isMethod() const noexcept     { return type == &VariantType_Method::instance; }
+
+var::operator int() const noexcept      { return isInt()    ? value.intValue    : type->toInt (value); }
+var::operator int64() const noexcept    { return isInt64()  ? value.int64Value  : type->toInt64 (value); }
+var::operator bool() const noexcept     { return isBool()   ? value.boolValue   : type->toBool (value); }
+var::operator float() const noexcept    { return (float) operator double(); }
+var::operator double() const noexcept   { return isDouble() ? value.doubleValue : type->toDouble (value); }
+var::operator String() const            { return toString(); }
+
+String var::toString() const
+{
+    return isString() ? *VariantType_String::getString (value) : type->toString (value);
+}
+
+ReferenceCountedObject* var::getObject() const noexcept
+{
+    return type == &VariantType_Object::instance ? value.objectValue : nullptr;
+}
+
+Array<var>* var::getArray() const noexcept
+{
+    return isArray() ? VariantType_Array::getArray (value) : nullptr;
+}
+
+MemoryBlock* var::getBinaryData() const noexcept
+{
+    return isBinaryData() ? value.binaryValue : nullptr;
+}
+
+DynamicObject* var::getDynamicObject() const noexcept
+{
+    return type == &VariantType_Object::instance ? dynamic_cast<DynamicObject*> (value.objectValue) : nullptr;
+}
 
 //==============================================================================
 void var::swapWith (var& other) noexcept
@@ -496,14 +529,43 @@ void var::swapWith (var& other) noexcept
     std::swap (value, other.value);
 }
 
-var& var::operator= (const var& v)               { type->cleanUp (value); type = v.type; type->createCopy (value, v.value); return *this; }
-var& var::operator= (const int v)                { type->cleanUp (value); type = &VariantType_Int::instance; value.intValue = v; return *this; }
-var& var::operator= (const int64 v)              { type->cleanUp (value); type = &VariantType_Int64::instance; value.int64Value = v; return *this; }
-var& var::operator= (const bool v)               { type->cleanUp (value); type = &VariantType_Bool::instance; value.boolValue = v; return *this; }
-var& var::operator= (const double v)             { type->cleanUp (value); type = &VariantType_Double::instance; value.doubleValue = v; return *this; }
-var& var::operator= (const char* const v)        { type->cleanUp (value); type = &VariantType_String::instance; new (value.stringValue) String (v); return *this; }
-var& var::operator= (const wchar_t* const v)     { type->cleanUp (value); type = &VariantType_String::instance; new (value.stringValue) String (v); return *this; }
-var& var::operator= (const String& v)            { type->cleanUp (value); type = &VariantType_String::instance; new (value.stringValue) String (v); return *this; }
+var& var::operator= (const var& v)
+{
+    if (type->isTrivial && v.type->isTrivial)
+    {
+        type = v.type;
+        value = v.value;
+    }
+    else if (isString() && v.isString())
+    {
+        *VariantType_String::getString (value) = *VariantType_String::getString (v.value);
+    }
+    else if (this != &v)
+    {
+        var copy (v);
+        swapWith (copy);
+    }
+
+    return *this;
+}
+
+var& var::operator= (const int v)                { if (! type->isTrivial) type->cleanUp (value); type = &VariantType_Int::instance; value.intValue = v; return *this; }
+var& var::operator= (const int64 v)              { if (! type->isTrivial) type->cleanUp (value); type = &VariantType_Int64::instance; value.int64Value = v; return *this; }
+var& var::operator= (const bool v)               { if (! type->isTrivial) type->cleanUp (value); type = &VariantType_Bool::instance; value.boolValue = v; return *this; }
+var& var::operator= (const double v)             { if (! type->isTrivial) type->cleanUp (value); type = &VariantType_Double::instance; value.doubleValue = v; return *this; }
+var& var::operator= (const char* const v)        { var v2 (v); swapWith (v2); return *this; }
+var& var::operator= (const wchar_t* const v)     { var v2 (v); swapWith (v2); return *this; }
+
+var& var::operator= (const String& v)
+{
+    if (isString())
+        *VariantType_String::getString (value) = v;
+    else
+        { var v2 (v); swapWith (v2); }
+
+    return *this;
+}
+
 var& var::operator= (const Array<var>& v)        { var v2 (v); swapWith (v2); return *this; }
 var& var::operator= (ReferenceCountedObject* v)  { var v2 (v); swapWith (v2); return *this; }
 var& var::operator= (NativeFunction v)           { var v2 (v); swapWith (v2); return *this; }
@@ -539,9 +601,33 @@ var::var (Array<var>&& v)  : type (&VariantType_Array::instance)
 
 var& var::operator= (String&& v)
 {
-    type->cleanUp (value);
-    type = &VariantType_String::instance;
-    new (value.stringValue) String (static_cast<String&&> (v));
+    if (isString())
+    {
+        *VariantType_String::getString (value) = static_cast<String&&> (v);
+    }
+    else
+    {
+        var v2 (static_cast<String&&> (v));
+        swapWith (v2);
+    }
+
+    return *this;
+}
+
+var& var::operator= (Array<var>&& v)
+{
+    if (Array<var>* const array = getArray())
+    {
+        // (only reuse the array if nothing else is sharing it)
+        if (value.objectValue->getReferenceCount() == 1)
+        {
+            array->swapWith (v);
+            return *this;
+        }
+    }
+
+    var v2 (static_cast<Array<var>&&> (v));
+    swapWith (v2);
     return *this;
 }
 #endif
@@ -549,6 +635,14 @@ var& var::operator= (String&& v)
 //==============================================================================
 bool var::equals (const var& other) const noexcept
 {
+    if (type == other.type)
+    {
+        if (isString())   return *VariantType_String::getString (value) == *VariantType_String::getString (other.value);
+        if (isInt())      return value.intValue == other.value.intValue;
+        if (isInt64())    return value.int64Value == other.value.int64Value;
+        if (isBool())     return value.boolValue == other.value.boolValue;
+    }
+
     return type->equals (value, other.value, *other.type);
 }
 
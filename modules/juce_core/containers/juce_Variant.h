@@ -107,6 +107,7 @@ public:
     var (Array<var>&& value);
     var& operator= (var&& other) noexcept;
     var& operator= (String&& value);
+    var& operator= (Array<var>&& value);
    #endif
 
     void swapWith (var& other) noexcept;
@@ -314,6 +315,8 @@ private:
     var (const VariantType&) noexcept;
 };
 
+JUCE_DECLARE_TRIVIALLY_RELOCATABLE (var)
+
 /** Compares the values of two var objects, using the var::equals() comparison. */
 bool operator== (const var& v1, const var& v2) noexcept;
 /** Compares the values of two var objects, using the var::equals() comparison. */
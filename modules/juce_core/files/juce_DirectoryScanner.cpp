@@ -0,0 +1,507 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+struct DirectoryScanner::Entry
+{
+    String name;
+    int64 size, modTime;
+    bool isDirectory, isHidden;
+
+    bool isSameAs (const Entry& other) const noexcept
+    {
+        return size == other.size && modTime == other.modTime;
+    }
+};
+
+struct DirectoryScanner::Directory
+{
+    String path;
+    int64 modTime;
+    Array<Entry> entries; // (sorted by name)
+
+    static int compareElements (const Entry& first, const Entry& second) noexcept
+    {
+        return first.name.compare (second.name);
+    }
+};
+
+struct DirectoryScanner::Index
+{
+    Index() : scanTime (0) {}
+
+    Directory* findDirectory (const String& path) const
+    {
+        return directoriesByPath [path];
+    }
+
+    void addDirectory (Directory* d)
+    {
+        directories.add (d);
+        directoriesByPath.set (d->path, d);
+    }
+
+    String rootPath;
+    int64 scanTime;
+    OwnedArray<Directory> directories;
+    HashMap<String, Directory*> directoriesByPath;
+
+    JUCE_DECLARE_NON_COPYABLE (Index)
+};
+
+class DirectoryScanner::ScanTask  : public ThreadPoolTask
+{
+public:
+    ScanTask (DirectoryScanner& o, const String& p)  : owner (o), path (p) {}
+
+    void run() override
+    {
+        owner.scanDirectory (path);
+    }
+
+private:
+    DirectoryScanner& owner;
+    const String path;
+
+    JUCE_DECLARE_NON_COPYABLE (ScanTask)
+};
+
+//==============================================================================
+DirectoryScanner::DirectoryScanner (ThreadPool* poolToUse)
+    : pool (poolToUse), index (new Index()),
+      numFiles (0), numDirectories (0), includeHidden (false), reuseUnchanged (false)
+{
+    // (most of the time is spent waiting for the filesystem, so it's worth having
+    // more threads than there are cores)
+    if (pool == nullptr)
+        pool = ownedPool = new ThreadPool (jmax (2, SystemStats::getNumCpus() * 2));
+}
+
+DirectoryScanner::~DirectoryScanner()
+{
+}
+
+//==============================================================================
+Result DirectoryScanner::scan (const File& rootDirectory, const bool includeHiddenFiles,
+                               const bool reuseUnchangedDirectories)
+{
+    if (! rootDirectory.isDirectory())
+        return Result::fail ("Directory doesn't exist: " + rootDirectory.getFullPathName());
+
+    const String rootPath (rootDirectory.getFullPathName());
+
+    // Changing the hidden file setting would make everything look added or removed, so in
+    // that case, the scan starts from scratch.
+    if (index->rootPath == rootPath && includeHidden == includeHiddenFiles)
+        previousIndex = index.release();
+    else
+        previousIndex = nullptr;
+
+    index = new Index();
+    index->rootPath = rootPath;
+    index->scanTime = Time::currentTimeMillis();
+
+    includeHidden = includeHiddenFiles;
+    reuseUnchanged = reuseUnchangedDirectories && previousIndex != nullptr;
+    shouldCancel = 0;
+    addedFiles.clearQuick();
+    removedFiles.clearQuick();
+    modifiedFiles.clearQuick();
+
+    addNewTask (rootPath);
+
+    // Each task adds the tasks for its subdirectories before it finishes, so once every
+    // task in the list is finished, the whole tree has been read.
+    for (int i = 0;; ++i)
+    {
+        ScanTask* task;
+
+        {
+            const ScopedLock sl (lock);
+
+            if (i >= tasks.size())
+                break;
+
+            task = tasks.getUnchecked (i);
+        }
+
+        pool->waitForTask (task);
+    }
+
+    tasks.clear();
+
+    if (shouldCancel.get() != 0)
+    {
+        if (previousIndex != nullptr)
+            index = previousIndex.release();
+        else
+            index = new Index();
+
+        addedFiles.clear();
+        removedFiles.clear();
+        modifiedFiles.clear();
+        updateCounts();
+        return Result::fail ("The scan was cancelled");
+    }
+
+    previousIndex = nullptr;
+    updateCounts();
+    return Result::ok();
+}
+
+void DirectoryScanner::cancel() noexcept
+{
+    shouldCancel = 1;
+}
+
+void DirectoryScanner::addNewTask (const String& path)
+{
+    ScanTask* const task = new ScanTask (*this, path);
+
+    {
+        const ScopedLock sl (lock);
+        tasks.add (task);
+    }
+
+    pool->addTask (task);
+}
+
+void DirectoryScanner::scanDirectory (const String& path)
+{
+    if (shouldCancel.get() != 0)
+        return;
+
+    const File directory (File::createFileWithoutCheckingPath (path));
+
+    ScopedPointer<Directory> d (new Directory());
+    d->path = path;
+    d->modTime = directory.getLastModificationTime().toMilliseconds();
+
+    const Directory* const oldDirectory = previousIndex != nullptr ? previousIndex->findDirectory (path)
+                                                                   : nullptr;
+
+    // The directory times only have a resolution of a second on some filesystems, so a
+    // listing can only be trusted if it was read well after the directory last changed.
+    if (reuseUnchanged && oldDirectory != nullptr
+         && oldDirectory->modTime == d->modTime
+         && d->modTime < previousIndex->scanTime - 2000)
+    {
+        d->entries = oldDirectory->entries;
+    }
+    else
+    {
+        DirectoryIterator::NativeIterator finder (directory, "*");
+        String filename;
+        Entry e;
+        Time modTime;
+
+        while (finder.next (filename, &e.isDirectory, &e.isHidden, &e.size, &modTime, nullptr, nullptr))
+        {
+            if (filename.containsOnly (".") || (e.isHidden && ! includeHidden))
+                continue;
+
+            e.name = filename;
+            e.modTime = modTime.toMilliseconds();
+
+            if (e.isDirectory)
+                e.size = 0;
+
+            d->entries.add (e);
+        }
+
+        Directory comparator;
+        d->entries.sort (comparator);
+    }
+
+    Array<File> added, removed, modified;
+
+    if (previousIndex != nullptr)
+    {
+        if (oldDirectory != nullptr)
+            compareEntries (*oldDirectory, *d, added, removed, modified);
+        else
+            for (int i = 0; i < d->entries.size(); ++i)
+                added.add (File::createFileWithoutCheckingPath (File::addTrailingSeparator (path) + d->entries.getReference(i).name));
+    }
+
+    StringArray subDirectories;
+
+    for (int i = 0; i < d->entries.size(); ++i)
+    {
+        const Entry& e = d->entries.getReference (i);
+
+        if (e.isDirectory)
+            subDirectories.add (File::addTrailingSeparator (path) + e.name);
+    }
+
+    {
+        const ScopedLock sl (lock);
+
+        index->addDirectory (d.release());
+        addedFiles.addArray (added);
+        removedFiles.addArray (removed);
+        modifiedFiles.addArray (modified);
+    }
+
+    for (int i = 0; i < subDirectories.size(); ++i)
+        addNewTask (subDirectories[i]);
+}
+
+void DirectoryScanner::compareEntries (const Directory& oldDirectory, const Directory& newDirectory,
+                                       Array<File>& added, Array<File>& removed, Array<File>& modified) const
+{
+    const String parent (File::addTrailingSeparator (newDirectory.path));
+    const Array<Entry>& oldEntries = oldDirectory.entries;
+    const Array<Entry>& newEntries = newDirectory.entries;
+    int oldIndex = 0, newIndex = 0;
+
+    for (;;)
+    {
+        const bool hasOld = oldIndex < oldEntries.size();
+        const bool hasNew = newIndex < newEntries.size();
+
+        if (! (hasOld || hasNew))
+            break;
+
+        const int diff = ! hasOld ? 1 : (! hasNew ? -1 : Directory::compareElements (oldEntries.getReference (oldIndex),
+                                                                                    newEntries.getReference (newIndex)));
+
+        if (diff == 0)
+        {
+            const Entry& o = oldEntries.getReference (oldIndex++);
+            const Entry& n = newEntries.getReference (newIndex++);
+
+            if (o.isDirectory != n.isDirectory)
+            {
+                removed.add (File::createFileWithoutCheckingPath (parent + o.name));
+                added.add (File::createFileWithoutCheckingPath (parent + n.name));
+
+                if (o.isDirectory)
+                    if (const Directory* sub = previousIndex->findDirectory (parent + o.name))
+                        addRemovedFiles (*sub, removed);
+            }
+            else if (! (n.isDirectory || n.isSameAs (o)))
+            {
+                modified.add (File::createFileWithoutCheckingPath (parent + n.name));
+            }
+        }
+        else if (diff < 0)
+        {
+            const Entry& o = oldEntries.getReference (oldIndex++);
+            removed.add (File::createFileWithoutCheckingPath (parent + o.name));
+
+            if (o.isDirectory)
+                if (const Directory* sub = previousIndex->findDirectory (parent + o.name))
+                    addRemovedFiles (*sub, removed);
+        }
+        else
+        {
+            added.add (File::createFileWithoutCheckingPath (parent + newEntries.getReference (newIndex++).name));
+        }
+    }
+}
+
+void DirectoryScanner::addRemovedFiles (const Directory& oldDirectory, Array<File>& removed) const
+{
+    const String parent (File::addTrailingSeparator (oldDirectory.path));
+
+    for (int i = 0; i < oldDirectory.entries.size(); ++i)
+    {
+        const Entry& e = oldDirectory.entries.getReference (i);
+        removed.add (File::createFileWithoutCheckingPath (parent + e.name));
+
+        if (e.isDirectory)
+            if (const Directory* sub = previousIndex->findDirectory (parent + e.name))
+                addRemovedFiles (*sub, removed);
+    }
+}
+
+void DirectoryScanner::updateCounts() noexcept
+{
+    numFiles = numDirectories = 0;
+
+    for (int i = 0; i < index->directories.size(); ++i)
+    {
+        const Array<Entry>& entries = index->directories.getUnchecked(i)->entries;
+
+        for (int j = 0; j < entries.size(); ++j)
+        {
+            if (entries.getReference (j).isDirectory)
+                ++numDirectories;
+            else
+                ++numFiles;
+        }
+    }
+}
+
+//==============================================================================
+File DirectoryScanner::getRootDirectory() const
+{
+    return index->rootPath.isNotEmpty() ? File (index->rootPath) : File::nonexistent;
+}
+
+void DirectoryScanner::findFiles (Array<FileInfo>& results, const int whatToLookFor,
+                                  const String& wildCardPattern) const
+{
+    const StringArray wildCards (DirectoryIterator::parseWildcards (wildCardPattern));
+    const bool matchAll = wildCards.size() == 0 || (wildCards.size() == 1 && wildCards[0] == "*");
+
+    for (int i = 0; i < index->directories.size(); ++i)
+    {
+        const Directory& d = *index->directories.getUnchecked (i);
+        const String parent (File::addTrailingSeparator (d.path));
+
+        for (int j = 0; j < d.entries.size(); ++j)
+        {
+            const Entry& e = d.entries.getReference (j);
+
+            if ((whatToLookFor & (e.isDirectory ? File::findDirectories : File::findFiles)) == 0
+                 || (e.isHidden && (whatToLookFor & File::ignoreHiddenFiles) != 0))
+                continue;
+
+            if (matchAll || DirectoryIterator::fileMatches (wildCards, e.name))
+            {
+                FileInfo info;
+                info.file = File::createFileWithoutCheckingPath (parent + e.name);
+                info.fileSize = e.size;
+                info.modificationTime = Time (e.modTime);
+                info.isDirectory = e.isDirectory;
+                info.isHidden = e.isHidden;
+                results.add (info);
+            }
+        }
+    }
+}
+
+void DirectoryScanner::getChangesFromLastScan (Array<File>& added, Array<File>& removed, Array<File>& modified) const
+{
+    added.addArray (addedFiles);
+    removed.addArray (removedFiles);
+    modified.addArray (modifiedFiles);
+}
+
+void DirectoryScanner::clear()
+{
+    index = new Index();
+    addedFiles.clear();
+    removedFiles.clear();
+    modifiedFiles.clear();
+    updateCounts();
+}
+
+//==============================================================================
+namespace DirectoryScannerHelpers
+{
+    static const int indexMagicNumber = 0x4a445349;
+    static const int indexVersion = 1;
+}
+
+bool DirectoryScanner::writeIndex (OutputStream& output) const
+{
+    MemoryOutputStream out;
+
+    out.writeInt (DirectoryScannerHelpers::indexMagicNumber);
+    out.writeInt (DirectoryScannerHelpers::indexVersion);
+    out.writeString (index->rootPath);
+    out.writeInt64 (index->scanTime);
+    out.writeBool (includeHidden);
+    out.writeCompressedInt (index->directories.size());
+
+    for (int i = 0; i < index->directories.size(); ++i)
+    {
+        const Directory& d = *index->directories.getUnchecked (i);
+
+        out.writeString (d.path);
+        out.writeInt64 (d.modTime);
+        out.writeCompressedInt (d.entries.size());
+
+        for (int j = 0; j < d.entries.size(); ++j)
+        {
+            const Entry& e = d.entries.getReference (j);
+
+            out.writeString (e.name);
+            out.writeInt64 (e.size);
+            out.writeInt64 (e.modTime);
+            out.writeByte ((char) ((e.isDirectory ? 1 : 0) | (e.isHidden ? 2 : 0)));
+        }
+    }
+
+    return output.write (out.getData(), out.getDataSize());
+}
+
+bool DirectoryScanner::readIndex (InputStream& in)
+{
+    clear();
+
+    if (in.readInt() != DirectoryScannerHelpers::indexMagicNumber
+         || in.readInt() != DirectoryScannerHelpers::indexVersion)
+        return false;
+
+    ScopedPointer<Index> newIndex (new Index());
+    newIndex->rootPath = in.readString();
+    newIndex->scanTime = in.readInt64();
+    const bool newIncludeHidden = in.readBool();
+    const int numDirs = in.readCompressedInt();
+
+    for (int i = 0; i < numDirs; ++i)
+    {
+        if (in.isExhausted())
+            return false;
+
+        Directory* const d = new Directory();
+        d->path = in.readString();
+        d->modTime = in.readInt64();
+        newIndex->addDirectory (d);
+
+        const int numEntries = in.readCompressedInt();
+
+        if (numEntries < 0)
+            return false;
+
+        d->entries.ensureStorageAllocated (numEntries);
+
+        for (int j = 0; j < numEntries; ++j)
+        {
+            if (in.isExhausted())
+                return false;
+
+            Entry e;
+            e.name = in.readString();
+            e.size = in.readInt64();
+            e.modTime = in.readInt64();
+            const int flags = in.readByte();
+            e.isDirectory = (flags & 1) != 0;
+            e.isHidden    = (flags & 2) != 0;
+            d->entries.add (e);
+        }
+    }
+
+    index = newIndex;
+    includeHidden = newIncludeHidden;
+    updateCounts();
+    return true;
+}
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_DIRECTORYSCANNER_H_INCLUDED
+#define JUCE_DIRECTORYSCANNER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Recursively scans a directory tree using a pool of threads, and keeps an index
+    of everything it found.
+
+    Each directory is read by a separate ThreadPoolTask, so on filesystems where most
+    of the time is spent waiting for the disk or the network, a large tree can be
+    scanned far more quickly than with a single DirectoryIterator. The sizes and
+    modification times come from the same calls that list the directories, so they
+    don't need any extra per-file queries afterwards.
+
+    After a scan, you can search the index with findFiles(), and find out what has
+    been added, removed or modified since the previous scan with getChangesFromLastScan().
+    The index can be saved with writeIndex() and loaded again with readIndex(), so that
+    a later session can rescan incrementally: directories whose modification time hasn't
+    changed since they were last read don't need to be listed again.
+
+    e.g. @code
+    DirectoryScanner scanner;
+
+    FileInputStream in (indexFile);
+
+    if (in.openedOk())
+        scanner.readIndex (in);
+
+    if (scanner.scan (File ("/music")).wasOk())
+    {
+        Array<File> added, removed, modified;
+        scanner.getChangesFromLastScan (added, removed, modified);
+        ...
+    }
+    @endcode
+
+    @see DirectoryIterator, File::findChildFiles
+*/
+class JUCE_API  DirectoryScanner
+{
+public:
+    //==============================================================================
+    /** Creates a scanner.
+
+        @param poolToUse    the pool that should be used to read the directories. If this
+                            is null, the scanner creates a pool of its own.
+    */
+    DirectoryScanner (ThreadPool* poolToUse = nullptr);
+
+    /** Destructor. */
+    ~DirectoryScanner();
+
+    //==============================================================================
+    /** Scans a directory and all its subdirectories, replacing the current index.
+
+        This blocks until the scan has finished, but the calling thread will also help
+        to read directories while it waits.
+
+        If there's already an index of the same directory (either from an earlier call
+        or from readIndex()), the new contents are compared against it, and the
+        differences are available from getChangesFromLastScan().
+
+        @param rootDirectory            the directory to scan
+        @param includeHiddenFiles       if false, hidden files and directories are left out
+        @param reuseUnchangedDirectories if true, a directory whose modification time is the
+                                        same as in the previous index won't be listed again,
+                                        and its previous contents will be kept (although its
+                                        subdirectories are still checked). This is much
+                                        quicker, but because a file's contents can change
+                                        without affecting its parent directory's time, it
+                                        won't notice files that have been modified in-place.
+        @returns    an error if the root directory doesn't exist or the scan was cancelled.
+                    If it fails, the previous index is left unchanged.
+    */
+    Result scan (const File& rootDirectory,
+                 bool includeHiddenFiles = false,
+                 bool reuseUnchangedDirectories = false);
+
+    /** Makes a scan that's running on another thread stop as soon as possible. */
+    void cancel() noexcept;
+
+    //==============================================================================
+    /** Describes a file in the scanner's index. */
+    struct FileInfo
+    {
+        File file;
+        int64 fileSize;
+        Time modificationTime;
+        bool isDirectory, isHidden;
+    };
+
+    /** Returns the directory that the current index describes. */
+    File getRootDirectory() const;
+
+    /** Returns the number of files (not including directories) in the current index. */
+    int getNumFiles() const noexcept                { return numFiles; }
+
+    /** Returns the number of subdirectories in the current index. */
+    int getNumDirectories() const noexcept          { return numDirectories; }
+
+    /** Finds the items in the current index which match a wildcard.
+
+        @param results          the array to add the results to
+        @param whatToLookFor    a value from the File::TypesOfFileToFind enum
+        @param wildCardPattern  the pattern to match. This may contain multiple patterns
+                                separated by a semi-colon or comma, e.g. "*.jpg;*.png"
+    */
+    void findFiles (Array<FileInfo>& results, int whatToLookFor,
+                    const String& wildCardPattern = "*") const;
+
+    /** Returns the differences between the last scan and the index it replaced.
+
+        Everything inside a directory that has appeared or disappeared is included.
+        A file is counted as modified if its size or modification time has changed.
+    */
+    void getChangesFromLastScan (Array<File>& added, Array<File>& removed, Array<File>& modified) const;
+
+    /** Clears the index. */
+    void clear();
+
+    //==============================================================================
+    /** Writes the current index to a stream, so it can be restored with readIndex(). */
+    bool writeIndex (OutputStream& output) const;
+
+    /** Replaces the current index with one that was saved by writeIndex().
+        @returns false if the data wasn't a valid index, in which case the index is
+                 left empty.
+    */
+    bool readIndex (InputStream& input);
+
+private:
+    //==============================================================================
+    struct Entry;
+    struct Directory;
+    struct Index;
+    class ScanTask;
+    friend class ScanTask;
+
+    ScopedPointer<ThreadPool> ownedPool;
+    ThreadPool* pool;
+    ScopedPointer<Index> index, previousIndex;
+    OwnedArray<ScanTask> tasks;
+    Array<File> addedFiles, removedFiles, modifiedFiles;
+    CriticalSection lock;
+    Atomic<int> shouldCancel;
+    int numFiles, numDirectories;
+    bool includeHidden, reuseUnchanged;
+
+    void scanDirectory (const String& path);
+    void addNewTask (const String& path);
+    void addRemovedFiles (const Directory& oldDirectory, Array<File>& removed) const;
+    void compareEntries (const Directory& oldDirectory, const Directory& newDirectory,
+                         Array<File>& added, Array<File>& removed, Array<File>& modified) const;
+    void updateCounts() noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DirectoryScanner)
+};
+
+
+#endif   // JUCE_DIRECTORYSCANNER_H_INCLUDED
@@ -899,6 +899,42 @@ MemoryMappedFile::MemoryMappedFile (const File& file, const Range<int64>& fileRa
     openInternal (file, mode);
 }
 
+bool MemoryMappedFile::getPageRange (Range<int64> fileRange, void*& start, size_t& numBytes) const noexcept
+{
+    fileRange = fileRange.getIntersectionWith (range);
+
+    if (address == nullptr || fileRange.isEmpty())
+        return false;
+
+    // (the OS calls that use this need the start to be aligned to a page)
+    const int64 pageSize = SystemStats::getPageSize();
+    const int64 startOffset = fileRange.getStart() - range.getStart();
+    const int64 alignedStart = startOffset - (startOffset % pageSize);
+
+    start = addBytesToPointer (address, alignedStart);
+    numBytes = (size_t) (fileRange.getEnd() - range.getStart() - alignedStart);
+    return true;
+}
+
+void MemoryMappedFile::touchPages (Range<int64> fileRange) const noexcept
+{
+    void* start;
+    size_t numBytes;
+
+    if (getPageRange (fileRange, start, numBytes))
+    {
+        const size_t pageSize = (size_t) SystemStats::getPageSize();
+        const volatile char* const data = static_cast<const volatile char*> (start);
+        char total = 0;
+
+        for (size_t i = 0; i < numBytes; i += pageSize)
+            total += data[i];
+
+        total += data[numBytes - 1];
+        (void) total;
+    }
+}
+
 
 //==============================================================================
 #if JUCE_UNIT_TESTS
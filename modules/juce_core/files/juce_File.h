@@ -981,4 +981,6 @@ private:
     bool setFileExecutableInternal (bool) const;
 };
 
+JUCE_DECLARE_TRIVIALLY_RELOCATABLE (File)
+
 #endif   // JUCE_FILE_H_INCLUDED
@@ -27,6 +27,7 @@
 */
 
 int64 juce_fileSetPosition (void* handle, int64 pos);
+void juce_fileSetSequentialAccessHint (void* handle, bool isSequential);
 
 
 //==============================================================================
@@ -34,7 +35,9 @@ FileInputStream::FileInputStream (const File& f)
     : file (f),
       fileHandle (nullptr),
       currentPosition (0),
-      status (Result::ok())
+      status (Result::ok()),
+      numReadsSinceSeek (0),
+      hasSequentialHint (true)
 {
     openHandle();
 }
@@ -59,6 +62,15 @@ int FileInputStream::read (void* buffer, int bytesToRead)
     const size_t num = readInternal (buffer, (size_t) bytesToRead);
     currentPosition += (int64) num;
 
+    // The file is opened with a hint that it'll be read sequentially, which is dropped when
+    // the caller starts seeking around, and restored once they've gone back to reading a
+    // run of consecutive blocks.
+    if (! hasSequentialHint && ++numReadsSinceSeek >= 4)
+    {
+        hasSequentialHint = true;
+        juce_fileSetSequentialAccessHint (fileHandle, true);
+    }
+
     return (int) num;
 }
 
@@ -78,7 +90,16 @@ bool FileInputStream::setPosition (int64 pos)
     jassert (openedOk());
 
     if (pos != currentPosition)
+    {
         currentPosition = juce_fileSetPosition (fileHandle, pos);
+        numReadsSinceSeek = 0;
+
+        if (hasSequentialHint)
+        {
+            hasSequentialHint = false;
+            juce_fileSetSequentialAccessHint (fileHandle, false);
+        }
+    }
 
     return currentPosition == pos;
 }
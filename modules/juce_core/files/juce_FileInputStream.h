@@ -85,6 +85,8 @@ private:
     void* fileHandle;
     int64 currentPosition;
     Result status;
+    int numReadsSinceSeek;
+    bool hasSequentialHint;
 
     void openHandle();
     size_t readInternal (void*, size_t);
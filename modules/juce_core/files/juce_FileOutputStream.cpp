@@ -36,7 +36,10 @@ FileOutputStream::FileOutputStream (const File& f, const size_t bufferSizeToUse)
       currentPosition (0),
       bufferSize (bufferSizeToUse),
       bytesInBuffer (0),
-      buffer (jmax (bufferSizeToUse, (size_t) 16))
+      buffer (jmax (bufferSizeToUse, (size_t) 16)),
+      bypassesCache (false),
+      pendingWriteStart (0), pendingWriteEnd (0),
+      writeInProgressStart (0), writeInProgressEnd (0)
 {
     openHandle();
 }
@@ -94,24 +97,28 @@ bool FileOutputStream::write (const void* const src, const size_t numBytes)
     }
     else
     {
-        if (! flushBuffer())
-            return false;
-
         if (numBytes < bufferSize)
         {
+            if (! flushBuffer())
+                return false;
+
             memcpy (buffer + bytesInBuffer, src, numBytes);
             bytesInBuffer += numBytes;
             currentPosition += (int64) numBytes;
         }
         else
         {
-            const ssize_t bytesWritten = writeInternal (src, numBytes);
+            // (the buffered data and the new block get written with a single call)
+            const ssize_t numBuffered = (ssize_t) bytesInBuffer;
+            bytesInBuffer = 0;
+
+            const ssize_t bytesWritten = writeInternal (buffer, (size_t) numBuffered, src, numBytes);
 
-            if (bytesWritten < 0)
+            if (bytesWritten < numBuffered)
                 return false;
 
-            currentPosition += (int64) bytesWritten;
-            return bytesWritten == (ssize_t) numBytes;
+            currentPosition += (int64) (bytesWritten - numBuffered);
+            return bytesWritten == numBuffered + (ssize_t) numBytes;
         }
     }
 
@@ -86,6 +86,33 @@ public:
     */
     Result truncate();
 
+    /** Asks the filesystem to reserve enough space for the file to grow to the given size.
+
+        If you know roughly how much you're going to write, e.g. for a recording of a known
+        length, this lets the space be allocated in one go rather than piecemeal while the
+        data is being written, which avoids fragmentation and keeps the time taken by each
+        write more even.
+
+        This doesn't change the file's length or the write position. If less data than this
+        ends up being written, the rest of the space may stay allocated to the file until it
+        gets truncated. On platforms or filesystems that don't support it, this does nothing.
+    */
+    Result preallocate (int64 totalNumBytes);
+
+    /** Stops the data that's written to this file from building up in the OS's file cache.
+
+        Normally, written data sits in the cache until the OS decides to write it out, so
+        writing lots of large files at once (e.g. recording many tracks) can fill the cache
+        and cause long stalls when it eventually gets flushed. When this is enabled, each
+        chunk of data gets sent to the disk soon after being written, and is dropped from
+        the cache once it's there, so that the cost of writing is spread evenly across the
+        calls to write(). A larger buffer size works best with this.
+
+        On Linux this uses sync_file_range() and posix_fadvise(), and on OSX it uses
+        F_NOCACHE. On Windows, it currently has no effect.
+    */
+    void setBypassesFileCache (bool shouldBypassCache);
+
     //==============================================================================
     void flush() override;
     int64 getPosition() override;
@@ -102,6 +129,8 @@ private:
     int64 currentPosition;
     size_t bufferSize, bytesInBuffer;
     HeapBlock <char> buffer;
+    bool bypassesCache;
+    int64 pendingWriteStart, pendingWriteEnd, writeInProgressStart, writeInProgressEnd;
 
     void openHandle();
     void closeHandle();
@@ -109,6 +138,8 @@ private:
     bool flushBuffer();
     int64 setPositionInternal (int64);
     ssize_t writeInternal (const void*, size_t);
+    ssize_t writeInternal (const void*, size_t, const void*, size_t);
+    void writeBehind (ssize_t numBytesJustWritten);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FileOutputStream)
 };
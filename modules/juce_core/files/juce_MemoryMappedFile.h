@@ -95,6 +95,52 @@ public:
     /** Returns the section of the file at which the mapped memory represents. */
     Range<int64> getRange() const noexcept      { return range; }
 
+    //==============================================================================
+    /** Describes the way the mapped memory will be read, so that the OS can decide
+        how much of the file to read ahead when a page is first accessed.
+        @see setAccessPattern
+    */
+    enum AccessPattern
+    {
+        normalAccess,       /**< Lets the OS use its default behaviour. */
+        sequentialAccess,   /**< The memory will be read in order - this is the default. */
+        randomAccess        /**< The memory will be read in no particular order, so it's not
+                                 worth reading ahead of the pages that are used. */
+    };
+
+    /** Tells the OS how the mapped memory is going to be read.
+        On Windows, where the OS has no equivalent of this, it has no effect.
+    */
+    void setAccessPattern (AccessPattern pattern) noexcept;
+
+    /** Asks the OS to start reading a section of the file into memory.
+
+        This returns immediately, and the data is read in the background, so that it may
+        already be in memory by the time it's accessed. The range is a range of positions
+        in the file (not offsets from getData()), and is clipped to the mapped range.
+    */
+    void prefetch (Range<int64> fileRange) const noexcept;
+
+    /** Reads each page of a section of the file, so that it's all in memory by the time
+        this returns.
+
+        Unlike prefetch(), this blocks while the data is read from the disk, so don't call
+        it from a realtime thread - see MemoryMappedFilePrefetcher for a way to have it done
+        on a background thread instead.
+    */
+    void touchPages (Range<int64> fileRange) const noexcept;
+
+    /** Locks a section of the file into physical memory, so that once it's been read,
+        it can't be paged out again.
+
+        The OS limits how much memory a process can lock, so this may fail if the range is
+        large. Any locked pages are unlocked when this object is deleted.
+    */
+    bool lockInMemory (Range<int64> fileRange) noexcept;
+
+    /** Unlocks a section that was locked with lockInMemory(). */
+    void unlockFromMemory (Range<int64> fileRange) noexcept;
+
 private:
     //==============================================================================
     void* address;
@@ -107,6 +153,7 @@ private:
    #endif
 
     void openInternal (const File&, AccessMode);
+    bool getPageRange (Range<int64> fileRange, void*& start, size_t& numBytes) const noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryMappedFile)
 };
@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+MemoryMappedFilePrefetcher::MemoryMappedFilePrefetcher (TimeSliceThread& t, const int maxPendingRequests)
+    : thread (t), fifo (maxPendingRequests), requests ((size_t) maxPendingRequests)
+{
+    thread.addTimeSliceClient (this);
+}
+
+MemoryMappedFilePrefetcher::~MemoryMappedFilePrefetcher()
+{
+    thread.removeTimeSliceClient (this);
+}
+
+bool MemoryMappedFilePrefetcher::prefetch (const MemoryMappedFile& file, Range<int64> fileRange) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (1, start1, size1, start2, size2);
+
+    if (size1 + size2 == 0)
+        return false;
+
+    Request& r = requests [size1 > 0 ? start1 : start2];
+    r.file = &file;
+    r.range = fileRange;
+
+    fifo.finishedWrite (1);
+    return true;
+}
+
+void MemoryMappedFilePrefetcher::cancelRequests (const MemoryMappedFile& file)
+{
+    const ScopedLock sl (processingLock);
+
+    // While this lock is held, the background thread can't be reading from the queue,
+    // and the writer never touches items that are waiting to be read, so they can be
+    // safely cleared here.
+    int start1, size1, start2, size2;
+    fifo.prepareToRead (fifo.getNumReady(), start1, size1, start2, size2);
+
+    for (int i = 0; i < size1; ++i)
+        if (requests [start1 + i].file == &file)
+            requests [start1 + i].file = nullptr;
+
+    for (int i = 0; i < size2; ++i)
+        if (requests [start2 + i].file == &file)
+            requests [start2 + i].file = nullptr;
+}
+
+int MemoryMappedFilePrefetcher::useTimeSlice()
+{
+    const ScopedLock sl (processingLock);
+
+    for (int numDone = 0; numDone < 16; ++numDone)
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (1, start1, size1, start2, size2);
+
+        if (size1 + size2 == 0)
+            return 5;
+
+        const Request r (requests [size1 > 0 ? start1 : start2]);
+
+        if (r.file != nullptr)
+            r.file->touchPages (r.range);
+
+        fifo.finishedRead (1);
+    }
+
+    return 0;
+}
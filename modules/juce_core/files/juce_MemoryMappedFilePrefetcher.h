@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_MEMORYMAPPEDFILEPREFETCHER_H_INCLUDED
+#define JUCE_MEMORYMAPPEDFILEPREFETCHER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Reads sections of memory-mapped files into memory on a background thread.
+
+    The first time a page of a MemoryMappedFile is accessed, the thread that touched
+    it has to wait while it's read from the disk. On a realtime thread, that can cause
+    a glitch - so instead, the realtime thread can use one of these to ask for the
+    sections that it's about to need to be touched in advance by a TimeSliceThread.
+
+    Requests are passed to the background thread through a lock-free queue, so
+    prefetch() is safe to call from an audio callback.
+
+    @see MemoryMappedFile::touchPages, MemoryMappedFile::prefetch
+*/
+class JUCE_API  MemoryMappedFilePrefetcher  : private TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** Creates a prefetcher.
+
+        @param backgroundThread     the thread that will read the pages. Make sure that it's
+                                    running, and that it isn't deleted before this object
+        @param maxPendingRequests   the size of the queue of requests
+    */
+    MemoryMappedFilePrefetcher (TimeSliceThread& backgroundThread, int maxPendingRequests = 256);
+
+    /** Destructor. */
+    ~MemoryMappedFilePrefetcher();
+
+    //==============================================================================
+    /** Asks for a section of a mapped file to be read into memory.
+
+        This doesn't block or allocate, so it can be called from a realtime thread, but
+        only one thread should call it at a time. The range is a range of positions in
+        the file, as for MemoryMappedFile::touchPages().
+
+        @returns false if the queue was full, in which case the request is ignored
+    */
+    bool prefetch (const MemoryMappedFile& file, Range<int64> fileRange) noexcept;
+
+    /** Discards any pending requests for a file.
+
+        You must call this before deleting a MemoryMappedFile that you've passed to
+        prefetch(). If the background thread is in the middle of reading the file, this
+        will wait for it to finish.
+    */
+    void cancelRequests (const MemoryMappedFile& file);
+
+private:
+    //==============================================================================
+    struct Request
+    {
+        const MemoryMappedFile* file;
+        Range<int64> range;
+    };
+
+    TimeSliceThread& thread;
+    AbstractFifo fifo;
+    HeapBlock<Request> requests;
+    CriticalSection processingLock;
+
+    int useTimeSlice() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryMappedFilePrefetcher)
+};
+
+
+#endif   // JUCE_MEMORYMAPPEDFILEPREFETCHER_H_INCLUDED
@@ -0,0 +1,493 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+JSONStreamReader::JSONStreamReader (InputStream& s, const int size)
+    : source (s), bufferSize (jmax (256, size)),
+      bufferPos (0), bufferEnd (0), bufferStartPosition (0),
+      tokenSize (256), tokenLength (0)
+{
+    buffer.malloc ((size_t) bufferSize);
+    token.malloc (tokenSize);
+}
+
+JSONStreamReader::~JSONStreamReader() {}
+
+int64 JSONStreamReader::getNumBytesParsed() const noexcept
+{
+    return bufferStartPosition + bufferPos;
+}
+
+int JSONStreamReader::readByte()
+{
+    if (bufferPos >= bufferEnd)
+    {
+        bufferStartPosition += bufferEnd;
+        bufferPos = 0;
+        bufferEnd = jmax (0, source.read (buffer, bufferSize));
+
+        if (bufferEnd == 0)
+            return -1;
+    }
+
+    return (unsigned char) buffer[bufferPos++];
+}
+
+int JSONStreamReader::readNonWhitespaceByte()
+{
+    for (;;)
+    {
+        const int c = readByte();
+
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+            return c;
+    }
+}
+
+void JSONStreamReader::unreadByte() noexcept
+{
+    // (this is only ever called straight after a successful readByte(), so the byte is still in the buffer)
+    jassert (bufferPos > 0);
+    --bufferPos;
+}
+
+void JSONStreamReader::appendToToken (const char c)
+{
+    if (tokenLength + 1 >= tokenSize)
+    {
+        tokenSize *= 2;
+        token.realloc (tokenSize);
+    }
+
+    token[tokenLength++] = c;
+}
+
+StringRef JSONStreamReader::getToken()
+{
+    token[tokenLength] = 0;
+
+   #if JUCE_STRING_UTF_TYPE == 8
+    return StringRef (String::CharPointerType (token));
+   #else
+    tokenString = String (CharPointer_UTF8 (token));
+    return tokenString;
+   #endif
+}
+
+Result JSONStreamReader::createFail (const char* const message) const
+{
+    return Result::fail (String (message) + " at byte " + String (getNumBytesParsed()));
+}
+
+Result JSONStreamReader::readString (const int quoteChar)
+{
+    tokenLength = 0;
+
+    for (;;)
+    {
+        int c = readByte();
+
+        if (c == quoteChar)
+            return Result::ok();
+
+        if (c < 0)
+            return createFail ("Unexpected end-of-input in string constant");
+
+        if (c != '\\')
+        {
+            // (the UTF-8 bytes are copied straight through, without being decoded)
+            appendToToken ((char) c);
+            continue;
+        }
+
+        c = readByte();
+        juce_wchar unicodeChar = 0;
+
+        switch (c)
+        {
+            case 'a':  unicodeChar = '\a'; break;
+            case 'b':  unicodeChar = '\b'; break;
+            case 'f':  unicodeChar = '\f'; break;
+            case 'n':  unicodeChar = '\n'; break;
+            case 'r':  unicodeChar = '\r'; break;
+            case 't':  unicodeChar = '\t'; break;
+
+            case 'u':
+            {
+                for (int i = 4; --i >= 0;)
+                {
+                    const int digitValue = CharacterFunctions::getHexDigitValue ((juce_wchar) jmax (0, readByte()));
+
+                    if (digitValue < 0)
+                        return createFail ("Syntax error in unicode escape sequence");
+
+                    unicodeChar = (juce_wchar) ((unicodeChar << 4) + digitValue);
+                }
+
+                break;
+            }
+
+            case -1:
+                return createFail ("Unexpected end-of-input in string constant");
+
+            default:
+                unicodeChar = (juce_wchar) c;
+                break;
+        }
+
+        if (unicodeChar < 0x80)
+        {
+            appendToToken ((char) unicodeChar);
+        }
+        else
+        {
+            char utf8[8];
+            CharPointer_UTF8 dest (utf8);
+            dest.write (unicodeChar);
+
+            for (const char* p = utf8; p < dest.getAddress(); ++p)
+                appendToToken (*p);
+        }
+    }
+}
+
+Result JSONStreamReader::readNumber (const int firstChar, Handler& handler)
+{
+    tokenLength = 0;
+    appendToToken ((char) firstChar);
+
+    const bool isNegative = (firstChar == '-');
+    uint64 intValue = isNegative ? 0 : (uint64) (firstChar - '0');
+    int numDigits = isNegative ? 0 : 1;
+    bool isDouble = false;
+    int c;
+
+    for (;;)
+    {
+        c = readByte();
+
+        if (c >= '0' && c <= '9')
+        {
+            intValue = intValue * 10 + (uint64) (c - '0');
+            ++numDigits;
+        }
+        else if (c == '.' || c == 'e' || c == 'E' || (isDouble && (c == '+' || c == '-')))
+        {
+            isDouble = true;
+        }
+        else
+        {
+            break;
+        }
+
+        appendToToken ((char) c);
+    }
+
+    if (c >= 0)
+    {
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r' && c != ',' && c != '}' && c != ']')
+            return createFail ("Syntax error in number");
+
+        unreadByte();
+    }
+
+    if (numDigits == 0)
+        return createFail ("Syntax error in number");
+
+    bool keepGoing;
+
+    // (anything with more than 18 digits might not fit into an int64)
+    if (isDouble || numDigits > 18)
+    {
+        token[tokenLength] = 0;
+        CharPointer_ASCII t (token);
+        keepGoing = handler.doubleValue (CharacterFunctions::readDoubleValue (t));
+    }
+    else
+    {
+        keepGoing = handler.intValue (isNegative ? -(int64) intValue : (int64) intValue);
+    }
+
+    return keepGoing ? Result::ok() : createFail ("Parsing stopped");
+}
+
+Result JSONStreamReader::readLiteral (const char* remainingChars)
+{
+    while (*remainingChars != 0)
+        if (readByte() != *remainingChars++)
+            return createFail ("Syntax error");
+
+    return Result::ok();
+}
+
+Result JSONStreamReader::readPropertyName (Handler& handler)
+{
+    const int quoteChar = readNonWhitespaceByte();
+
+    if (quoteChar != '"' && quoteChar != '\'')
+        return createFail ("Expected object member declaration");
+
+    Result r (readString (quoteChar));
+
+    if (r.failed())
+        return r;
+
+    if (! handler.propertyName (getToken()))
+        return createFail ("Parsing stopped");
+
+    if (readNonWhitespaceByte() != ':')
+        return createFail ("Expected ':'");
+
+    return Result::ok();
+}
+
+Result JSONStreamReader::parse (Handler& handler)
+{
+    containers.clearQuick();
+
+    for (;;)
+    {
+        // read a value..
+        const int c = readNonWhitespaceByte();
+        bool keepGoing = true;
+
+        switch (c)
+        {
+            case '{':
+            case '[':
+            {
+                const bool isObject = (c == '{');
+
+                if (! (isObject ? handler.startObject() : handler.startArray()))
+                    return createFail ("Parsing stopped");
+
+                const int next = readNonWhitespaceByte();
+
+                if (next == (isObject ? '}' : ']'))
+                {
+                    keepGoing = isObject ? handler.endObject() : handler.endArray();
+                    break;
+                }
+
+                if (next >= 0)
+                    unreadByte();
+
+                containers.add ((char) c);
+
+                if (isObject)
+                {
+                    Result r (readPropertyName (handler));
+
+                    if (r.failed())
+                        return r;
+                }
+
+                continue;
+            }
+
+            case '"':
+            case '\'':
+            {
+                Result r (readString (c));
+
+                if (r.failed())
+                    return r;
+
+                keepGoing = handler.stringValue (getToken());
+                break;
+            }
+
+            case 't':
+            case 'f':
+            case 'n':
+            {
+                Result r (readLiteral (c == 't' ? "rue" : (c == 'f' ? "alse" : "ull")));
+
+                if (r.failed())
+                    return r;
+
+                keepGoing = (c == 'n') ? handler.nullValue() : handler.boolValue (c == 't');
+                break;
+            }
+
+            case -1:
+                return createFail ("Unexpected end-of-input");
+
+            default:
+            {
+                if (c != '-' && ! (c >= '0' && c <= '9'))
+                    return createFail ("Syntax error");
+
+                Result r (readNumber (c, handler));
+
+                if (r.failed())
+                    return r;
+
+                break;
+            }
+        }
+
+        if (! keepGoing)
+            return createFail ("Parsing stopped");
+
+        // ..and then close any containers that it finishes, until there's another value to read
+        for (;;)
+        {
+            if (containers.size() == 0)
+                return Result::ok();
+
+            const bool isObject = (containers.getLast() == '{');
+            const int next = readNonWhitespaceByte();
+
+            if (next == ',')
+            {
+                if (isObject)
+                {
+                    Result r (readPropertyName (handler));
+
+                    if (r.failed())
+                        return r;
+                }
+
+                break;
+            }
+
+            if (next != (isObject ? '}' : ']'))
+                return createFail (next < 0 ? "Unexpected end-of-input"
+                                            : (isObject ? "Expected ',' or '}'" : "Expected ',' or ']'"));
+
+            containers.removeLast();
+
+            if (! (isObject ? handler.endObject() : handler.endArray()))
+                return createFail ("Parsing stopped");
+        }
+    }
+}
+
+//==============================================================================
+JSONStreamWriter::JSONStreamWriter (OutputStream& destination, const bool oneLine)
+    : out (destination), allOnOneLine (oneLine), isExpectingValue (false)
+{
+}
+
+JSONStreamWriter::~JSONStreamWriter()
+{
+    // You need to close all the objects and arrays that you start!
+    jassert (levels.size() == 0);
+}
+
+void JSONStreamWriter::startItem()
+{
+    if (levels.size() > 0)
+    {
+        if (levels.getReference (levels.size() - 1).numItems++ > 0)
+            out << (allOnOneLine ? ", " : ",");
+
+        if (! allOnOneLine)
+        {
+            out << newLine;
+            JSONFormatter::writeSpaces (out, levels.size() * JSONFormatter::indentSize);
+        }
+    }
+}
+
+void JSONStreamWriter::startValue()
+{
+    if (isExpectingValue)
+    {
+        isExpectingValue = false;
+        return;
+    }
+
+    // Inside an object, each value has to be preceded by a call to writePropertyName()
+    jassert (levels.size() == 0 || ! levels.getLast().isObject);
+
+    startItem();
+}
+
+void JSONStreamWriter::startContainer (const char openChar, const bool isObject)
+{
+    startValue();
+    out << openChar;
+
+    const Level level = { isObject, 0 };
+    levels.add (level);
+}
+
+void JSONStreamWriter::endContainer (const char closeChar, const bool isObject)
+{
+    // This must match the most recent startObject() or startArray() call, and the
+    // last property name must have been given a value
+    jassert (levels.size() > 0 && levels.getLast().isObject == isObject && ! isExpectingValue);
+
+    const int numItems = levels.size() > 0 ? levels.getLast().numItems : 0;
+    levels.removeLast();
+
+    if (numItems > 0 && ! allOnOneLine)
+    {
+        out << newLine;
+        JSONFormatter::writeSpaces (out, levels.size() * JSONFormatter::indentSize);
+    }
+
+    out << closeChar;
+}
+
+void JSONStreamWriter::startObject()    { startContainer ('{', true); }
+void JSONStreamWriter::endObject()      { endContainer ('}', true); }
+void JSONStreamWriter::startArray()     { startContainer ('[', false); }
+void JSONStreamWriter::endArray()       { endContainer (']', false); }
+
+void JSONStreamWriter::writePropertyName (StringRef name)
+{
+    // Property names can only be written inside an object, and each one needs a value
+    jassert (levels.size() > 0 && levels.getLast().isObject && ! isExpectingValue);
+
+    startItem();
+    out << '"';
+    JSONFormatter::writeString (out, name.text);
+    out << "\": ";
+    isExpectingValue = true;
+}
+
+void JSONStreamWriter::writeString (StringRef value)
+{
+    startValue();
+    out << '"';
+    JSONFormatter::writeString (out, value.text);
+    out << '"';
+}
+
+void JSONStreamWriter::writeInt (const int64 value)       { startValue(); out << String (value); }
+void JSONStreamWriter::writeDouble (const double value)   { startValue(); out << String (value, 20); }
+void JSONStreamWriter::writeBool (const bool value)       { startValue(); out << (value ? "true" : "false"); }
+void JSONStreamWriter::writeNull()                        { startValue(); out << "null"; }
+
+void JSONStreamWriter::writeValue (const var& value)
+{
+    startValue();
+    JSONFormatter::write (out, value, levels.size() * JSONFormatter::indentSize, allOnOneLine);
+}
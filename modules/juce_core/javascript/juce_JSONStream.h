@@ -0,0 +1,252 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_JSONSTREAM_H_INCLUDED
+#define JUCE_JSONSTREAM_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Reads JSON from a stream, reporting each item to a handler as it's found,
+    rather than building a var tree in memory.
+
+    JSON::parse() has to load the entire document and create a DynamicObject for
+    every object in it, which is a lot of memory and allocations for a large file.
+    This class reads the stream in chunks and works directly on the UTF-8 bytes, so
+    its memory use only depends on the nesting depth and the length of the longest
+    string, and it doesn't allocate anything per item.
+
+    To use it, write a subclass of JSONStreamReader::Handler, and override the
+    callbacks that you're interested in.
+
+    @code
+    struct PresetNameCollector  : public JSONStreamReader::Handler
+    {
+        PresetNameCollector() : nextIsName (false) {}
+
+        bool propertyName (StringRef name) override    { nextIsName = (name == "name"); return true; }
+        bool stringValue (StringRef value) override    { if (nextIsName) names.add (value); return true; }
+
+        StringArray names;
+        bool nextIsName;
+    };
+
+    FileInputStream in (presetLibraryFile);
+    PresetNameCollector collector;
+    Result r (JSONStreamReader (in).parse (collector));
+    @endcode
+
+    @see JSON, JSONStreamWriter
+*/
+class JUCE_API  JSONStreamReader
+{
+public:
+    //==============================================================================
+    /** Creates a reader that will parse the given stream.
+        The stream isn't owned, and must stay valid while the reader is being used.
+    */
+    JSONStreamReader (InputStream& source, int bufferSize = 65536);
+
+    /** Destructor. */
+    ~JSONStreamReader();
+
+    //==============================================================================
+    /**
+        Receives the items that a JSONStreamReader finds.
+
+        Each callback returns true to carry on parsing, or false to stop, in which
+        case JSONStreamReader::parse() returns a failure.
+
+        The strings passed to the callbacks are only valid until the callback returns,
+        so take a copy of any that you want to keep.
+    */
+    class JUCE_API  Handler
+    {
+    public:
+        /** Destructor. */
+        virtual ~Handler() {}
+
+        /** Called at a '{'. */
+        virtual bool startObject()                      { return true; }
+        /** Called at the '}' which matches a startObject() callback. */
+        virtual bool endObject()                        { return true; }
+        /** Called at a '['. */
+        virtual bool startArray()                       { return true; }
+        /** Called at the ']' which matches a startArray() callback. */
+        virtual bool endArray()                         { return true; }
+
+        /** Called with the name of an object member, before the callback for its value. */
+        virtual bool propertyName (StringRef)           { return true; }
+
+        /** Called for a string value. */
+        virtual bool stringValue (StringRef)            { return true; }
+        /** Called for a number without a fractional part or exponent, which fits into an int64. */
+        virtual bool intValue (int64)                   { return true; }
+        /** Called for any other number. */
+        virtual bool doubleValue (double)               { return true; }
+        /** Called for 'true' or 'false'. */
+        virtual bool boolValue (bool)                   { return true; }
+        /** Called for 'null'. */
+        virtual bool nullValue()                        { return true; }
+    };
+
+    //==============================================================================
+    /** Reads the next value from the stream (normally an object or array, but any
+        JSON value is allowed), passing its contents to the handler.
+
+        Parsing stops at the end of the value, so if a stream contains several
+        values one after another, you can call this repeatedly to read them all.
+
+        @returns a failure if the JSON is malformed, the stream ends too soon, or the
+                 handler stops the parse
+    */
+    Result parse (Handler& handler);
+
+    /** Returns the number of bytes of the stream that have been parsed so far. */
+    int64 getNumBytesParsed() const noexcept;
+
+private:
+    //==============================================================================
+    InputStream& source;
+    HeapBlock<char> buffer;
+    const int bufferSize;
+    int bufferPos, bufferEnd;
+    int64 bufferStartPosition;
+
+    HeapBlock<char> token;
+    size_t tokenSize, tokenLength;
+    Array<char> containers;
+
+   #if JUCE_STRING_UTF_TYPE != 8
+    String tokenString;
+   #endif
+
+    int readByte();
+    int readNonWhitespaceByte();
+    void unreadByte() noexcept;
+    void appendToToken (char);
+    StringRef getToken();
+    Result createFail (const char* message) const;
+    Result readString (int quoteChar);
+    Result readNumber (int firstChar, Handler&);
+    Result readLiteral (const char* remainingChars);
+    Result readPropertyName (Handler&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (JSONStreamReader)
+};
+
+//==============================================================================
+/**
+    Writes JSON to a stream one item at a time, so that large documents can be
+    written without building a var tree for them first.
+
+    You call startObject() / startArray() and endObject() / endArray() to open and
+    close containers, and the other methods to write the values inside them. Inside
+    an object, each value must be preceded by a call to writePropertyName(). The
+    writer takes care of the commas and the indentation.
+
+    @code
+    JSONStreamWriter json (outputStream);
+    json.startObject();
+    json.writePropertyName ("presets");
+    json.startArray();
+
+    for (int i = 0; i < presets.size(); ++i)
+        json.writeValue (presets.getReference(i).toVar());
+
+    json.endArray();
+    json.endObject();
+    @endcode
+
+    @see JSON, JSONStreamReader
+*/
+class JUCE_API  JSONStreamWriter
+{
+public:
+    //==============================================================================
+    /** Creates a writer that sends its output to the given stream.
+        The stream isn't owned, and must stay valid while the writer is being used.
+        If allOnOneLine is true, no line-breaks or indentation are written.
+    */
+    JSONStreamWriter (OutputStream& destination, bool allOnOneLine = false);
+
+    /** Destructor. */
+    ~JSONStreamWriter();
+
+    //==============================================================================
+    /** Writes a '{', starting a new object. */
+    void startObject();
+    /** Writes a '}', ending the innermost object. */
+    void endObject();
+    /** Writes a '[', starting a new array. */
+    void startArray();
+    /** Writes a ']', ending the innermost array. */
+    void endArray();
+
+    /** Writes the name of the next member of the current object. */
+    void writePropertyName (StringRef name);
+
+    /** Writes a string value. */
+    void writeString (StringRef value);
+    /** Writes an integer value. */
+    void writeInt (int64 value);
+    /** Writes a floating-point value. */
+    void writeDouble (double value);
+    /** Writes 'true' or 'false'. */
+    void writeBool (bool value);
+    /** Writes 'null'. */
+    void writeNull();
+
+    /** Writes a var, in the same format that JSON::writeToStream() would use.
+        This is handy for writing small sub-trees of the document in one go.
+    */
+    void writeValue (const var& value);
+
+private:
+    //==============================================================================
+    struct Level
+    {
+        bool isObject;
+        int numItems;
+    };
+
+    OutputStream& out;
+    Array<Level> levels;
+    const bool allOnOneLine;
+    bool isExpectingValue;
+
+    void startValue();
+    void startItem();
+    void startContainer (char openChar, bool isObject);
+    void endContainer (char closeChar, bool isObject);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (JSONStreamWriter)
+};
+
+
+#endif   // JUCE_JSONSTREAM_H_INCLUDED
@@ -104,6 +104,13 @@ struct JavascriptEngine::RootObject   : public DynamicObject
     static Identifier getPrototypeIdentifier()       { static const Identifier i ("prototype"); return i; }
     static var* getPropertyPointer (DynamicObject* o, Identifier i)   { return o->getProperties().getVarPointer (i); }
 
+    // The parse tree nodes that look up properties keep the index where they last found
+    // their name, so that when the same code runs again, it can usually skip the search.
+    static var* getPropertyPointer (DynamicObject* o, const Identifier& i, int& indexHint) noexcept
+    {
+        return o->getProperties().getVarPointer (i, indexHint);
+    }
+
     //==============================================================================
     struct CodeLocation
     {
@@ -136,11 +143,12 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         ReferenceCountedObjectPtr<RootObject> root;
         DynamicObject::Ptr scope;
 
-        var findFunctionCall (const CodeLocation& location, const var& targetObject, Identifier functionName) const
+        var findFunctionCall (const CodeLocation& location, const var& targetObject,
+                              const Identifier& functionName, int& indexHint) const
         {
             if (DynamicObject* o = targetObject.getDynamicObject())
             {
-                if (const var* prop = getPropertyPointer (o, functionName))
+                if (const var* prop = getPropertyPointer (o, functionName, indexHint))
                     return *prop;
 
                 for (DynamicObject* p = o->getProperty (getPrototypeIdentifier()).getDynamicObject(); p != nullptr;
@@ -152,34 +160,34 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             }
 
             if (targetObject.isString())
-                if (var* m = findRootClassProperty (StringClass::getClassName(), functionName))
+                if (var* m = findRootClassProperty (StringClass::getClassName(), functionName, indexHint))
                     return *m;
 
             if (targetObject.isArray())
-                if (var* m = findRootClassProperty (ArrayClass::getClassName(), functionName))
+                if (var* m = findRootClassProperty (ArrayClass::getClassName(), functionName, indexHint))
                     return *m;
 
-            if (var* m = findRootClassProperty (ObjectClass::getClassName(), functionName))
+            if (var* m = findRootClassProperty (ObjectClass::getClassName(), functionName, indexHint))
                 return *m;
 
             location.throwError ("Unknown function '" + functionName.toString() + "'");
             return var();
         }
 
-        var* findRootClassProperty (Identifier className, Identifier propName) const
+        var* findRootClassProperty (const Identifier& className, const Identifier& propName, int& indexHint) const
         {
             if (DynamicObject* cls = root->getProperty (className).getDynamicObject())
-                return getPropertyPointer (cls, propName);
+                return getPropertyPointer (cls, propName, indexHint);
 
             return nullptr;
         }
 
-        var findSymbolInParentScopes (Identifier name) const
+        var findSymbolInParentScopes (const Identifier& name, int& indexHint) const
         {
-            if (const var* v = getPropertyPointer (scope, name))
+            if (const var* v = getPropertyPointer (scope, name, indexHint))
                 return *v;
 
-            return parent != nullptr ? parent->findSymbolInParentScopes (name)
+            return parent != nullptr ? parent->findSymbolInParentScopes (name, indexHint)
                                      : var::undefined();
         }
 
@@ -348,24 +356,25 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
     struct UnqualifiedName  : public Expression
     {
-        UnqualifiedName (const CodeLocation& l, Identifier n) noexcept : Expression (l), name (n) {}
+        UnqualifiedName (const CodeLocation& l, Identifier n) noexcept : Expression (l), name (n), indexHint (0) {}
 
-        var getResult (const Scope& s) const override  { return s.findSymbolInParentScopes (name); }
+        var getResult (const Scope& s) const override  { return s.findSymbolInParentScopes (name, indexHint); }
 
         void assign (const Scope& s, const var& newValue) const override
         {
-            if (var* v = getPropertyPointer (s.scope, name))
+            if (var* v = getPropertyPointer (s.scope, name, indexHint))
                 *v = newValue;
             else
                 s.root->setProperty (name, newValue);
         }
 
         Identifier name;
+        mutable int indexHint;
     };
 
     struct DotOperator  : public Expression
     {
-        DotOperator (const CodeLocation& l, ExpPtr& p, Identifier c) noexcept : Expression (l), parent (p), child (c) {}
+        DotOperator (const CodeLocation& l, ExpPtr& p, Identifier c) noexcept : Expression (l), parent (p), child (c), indexHint (0) {}
 
         var getResult (const Scope& s) const override
         {
@@ -379,7 +388,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             }
 
             if (DynamicObject* o = p.getDynamicObject())
-                if (const var* v = getPropertyPointer (o, child))
+                if (const var* v = getPropertyPointer (o, child, indexHint))
                     return *v;
 
             return var::undefined();
@@ -395,6 +404,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
         ExpPtr parent;
         Identifier child;
+        mutable int indexHint;
     };
 
     struct ArraySubscript  : public Expression
@@ -669,14 +679,14 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
     struct FunctionCall  : public Expression
     {
-        FunctionCall (const CodeLocation& l) noexcept : Expression (l) {}
+        FunctionCall (const CodeLocation& l) noexcept : Expression (l), indexHint (0) {}
 
         var getResult (const Scope& s) const override
         {
             if (DotOperator* dot = dynamic_cast<DotOperator*> (object.get()))
             {
                 var thisObject (dot->parent->getResult (s));
-                return invokeFunction (s, s.findFunctionCall (location, thisObject, dot->child), thisObject);
+                return invokeFunction (s, s.findFunctionCall (location, thisObject, dot->child, indexHint), thisObject);
             }
 
             var function (object->getResult (s));
@@ -704,6 +714,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
         ExpPtr object;
         OwnedArray<Expression> arguments;
+        mutable int indexHint;
     };
 
     struct NewOperator  : public FunctionCall
@@ -77,6 +77,9 @@
   #include <sys/errno.h>
   #include <unistd.h>
   #include <netinet/in.h>
+  #include <sys/epoll.h>
+  #include <sys/syscall.h>
+  #include <linux/futex.h>
  #endif
 
  #if JUCE_LINUX
@@ -92,6 +95,7 @@
  #include <sys/time.h>
  #include <net/if.h>
  #include <sys/ioctl.h>
+ #include <poll.h>
 
  #if ! JUCE_ANDROID
   #include <execinfo.h>
@@ -107,43 +111,63 @@
  #include <android/log.h>
 #endif
 
+#if JUCE_GCC
+ #include <cxxabi.h>
+#endif
+
+#if JUCE_USE_LZ4
+ #include JUCE_LZ4_INCLUDE_PATH
+#endif
+
+#if JUCE_USE_ZSTD
+ #include JUCE_ZSTD_INCLUDE_PATH
+#endif
+
 
 //==============================================================================
 namespace juce
 {
 
+// (the module is split into three compile units of roughly equal size - see JUCE_COMPILE_UNIT)
+#if JUCE_COMPILE_UNIT (1)
 #include "containers/juce_AbstractFifo.cpp"
 #include "containers/juce_NamedValueSet.cpp"
 #include "containers/juce_PropertySet.cpp"
 #include "containers/juce_Variant.cpp"
 #include "files/juce_DirectoryIterator.cpp"
+#include "files/juce_DirectoryScanner.cpp"
 #include "files/juce_File.cpp"
 #include "files/juce_FileInputStream.cpp"
 #include "files/juce_FileOutputStream.cpp"
 #include "files/juce_FileSearchPath.cpp"
+#include "files/juce_MemoryMappedFilePrefetcher.cpp"
 #include "files/juce_TemporaryFile.cpp"
 #include "javascript/juce_JSON.cpp"
+#include "javascript/juce_JSONStream.cpp"
 #include "javascript/juce_Javascript.cpp"
 #include "containers/juce_DynamicObject.cpp"
 #include "logging/juce_FileLogger.cpp"
+#include "logging/juce_AsyncFileLogger.cpp"
 #include "logging/juce_Logger.cpp"
+#include "logging/juce_Tracer.cpp"
 #include "maths/juce_BigInteger.cpp"
 #include "maths/juce_Expression.cpp"
+#include "maths/juce_CompiledExpression.cpp"
 #include "maths/juce_Random.cpp"
+#include "memory/juce_MemoryArena.cpp"
 #include "memory/juce_MemoryBlock.cpp"
 #include "misc/juce_Result.cpp"
 #include "misc/juce_Uuid.cpp"
-#include "network/juce_MACAddress.cpp"
-#include "network/juce_NamedPipe.cpp"
-#include "network/juce_Socket.cpp"
-#include "network/juce_IPAddress.cpp"
+#endif
+
+//==============================================================================
+#if JUCE_COMPILE_UNIT (2)
 #include "streams/juce_BufferedInputStream.cpp"
 #include "streams/juce_FileInputSource.cpp"
 #include "streams/juce_InputStream.cpp"
 #include "streams/juce_MemoryInputStream.cpp"
 #include "streams/juce_MemoryOutputStream.cpp"
 #include "streams/juce_SubregionStream.cpp"
-#include "system/juce_SystemStats.cpp"
 #include "text/juce_CharacterFunctions.cpp"
 #include "text/juce_Identifier.cpp"
 #include "text/juce_LocalisedStrings.cpp"
@@ -153,18 +177,47 @@ namespace juce
 #include "text/juce_StringPairArray.cpp"
 #include "text/juce_StringPool.cpp"
 #include "text/juce_TextDiff.cpp"
+#include "threads/juce_LightweightMutex.cpp"
+#include "threads/juce_LightweightReadWriteLock.cpp"
+#include "threads/juce_LightweightSemaphore.cpp"
 #include "threads/juce_ReadWriteLock.cpp"
+#include "threads/juce_RealtimeSafety.cpp"
+#include "threads/juce_RealtimeThreadGroup.cpp"
 #include "threads/juce_Thread.cpp"
 #include "threads/juce_ThreadPool.cpp"
 #include "threads/juce_TimeSliceThread.cpp"
+#include "threads/juce_DeferredDeleter.cpp"
 #include "time/juce_PerformanceCounter.cpp"
 #include "time/juce_RelativeTime.cpp"
 #include "time/juce_Time.cpp"
 #include "unit_tests/juce_UnitTest.cpp"
+#include "unit_tests/juce_BenchmarkTest.cpp"
+#endif
+
+//==============================================================================
+#if JUCE_COMPILE_UNIT (3)
+#include "system/juce_SystemStats.cpp"
+#include "network/juce_MACAddress.cpp"
+#include "network/juce_NamedPipe.cpp"
+#include "network/juce_Socket.cpp"
+#include "network/juce_SocketMultiplexer.cpp"
+#include "network/juce_IPAddress.cpp"
 #include "xml/juce_XmlDocument.cpp"
 #include "xml/juce_XmlElement.cpp"
+#include "xml/juce_XmlPullParser.cpp"
 #include "zip/juce_GZIPDecompressorInputStream.cpp"
 #include "zip/juce_GZIPCompressorOutputStream.cpp"
+
+#if JUCE_USE_LZ4
+ #include "zip/juce_LZ4CompressorOutputStream.cpp"
+ #include "zip/juce_LZ4DecompressorInputStream.cpp"
+#endif
+
+#if JUCE_USE_ZSTD
+ #include "zip/juce_ZstdCompressorOutputStream.cpp"
+ #include "zip/juce_ZstdDecompressorInputStream.cpp"
+#endif
+
 #include "zip/juce_ZipFile.cpp"
 #include "files/juce_FileFilter.cpp"
 #include "files/juce_WildcardFileFilter.cpp"
@@ -181,6 +234,7 @@ namespace juce
 #if ! JUCE_WINDOWS
 #include "native/juce_posix_SharedCode.h"
 #include "native/juce_posix_NamedPipe.cpp"
+#include "native/juce_posix_SharedMemoryChannel.cpp"
 #endif
 
 //==============================================================================
@@ -199,6 +253,7 @@ namespace juce
 #include "native/juce_win32_Registry.cpp"
 #include "native/juce_win32_SystemStats.cpp"
 #include "native/juce_win32_Threads.cpp"
+#include "native/juce_win32_SharedMemoryChannel.cpp"
 
 //==============================================================================
 #elif JUCE_LINUX
@@ -220,7 +275,10 @@ namespace juce
 #endif
 
 #include "threads/juce_ChildProcess.cpp"
+#include "threads/juce_ChildProcessPool.cpp"
 #include "threads/juce_HighResolutionTimer.cpp"
 #include "network/juce_URL.cpp"
+#include "network/juce_SharedMemoryChannel.cpp"
+#endif
 
 }
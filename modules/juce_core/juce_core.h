@@ -117,6 +117,9 @@
 
     If you disable this, you might also want to set a value for JUCE_ZLIB_INCLUDE_PATH, to
     specify the path where your zlib headers live.
+
+    This is also the way to use a faster zlib-compatible library, such as zlib-ng built in
+    its zlib-compatible mode, for all the GZIP streams and zip files.
 */
 #ifndef JUCE_INCLUDE_ZLIB_CODE
  #define JUCE_INCLUDE_ZLIB_CODE 1
@@ -126,6 +129,51 @@
  #define JUCE_ZLIB_INCLUDE_PATH <zlib.h>
 #endif
 
+/** Config: JUCE_USE_LZ4
+    Enables the LZ4CompressorOutputStream and LZ4DecompressorInputStream classes.
+    These need your app to be linked to the LZ4 library, and if its headers aren't on your
+    include path, you can set JUCE_LZ4_INCLUDE_PATH to the location of its lz4frame.h file.
+*/
+#ifndef JUCE_USE_LZ4
+ #define JUCE_USE_LZ4 0
+#endif
+
+#ifndef JUCE_LZ4_INCLUDE_PATH
+ #define JUCE_LZ4_INCLUDE_PATH <lz4frame.h>
+#endif
+
+/** Config: JUCE_USE_ZSTD
+    Enables the ZstdCompressorOutputStream and ZstdDecompressorInputStream classes.
+    These need your app to be linked to the Zstandard library, and if its headers aren't on
+    your include path, you can set JUCE_ZSTD_INCLUDE_PATH to the location of its zstd.h file.
+*/
+#ifndef JUCE_USE_ZSTD
+ #define JUCE_USE_ZSTD 0
+#endif
+
+#ifndef JUCE_ZSTD_INCLUDE_PATH
+ #define JUCE_ZSTD_INCLUDE_PATH <zstd.h>
+#endif
+
+/** Config: JUCE_ENABLE_TRACING
+    Turns on the JUCE_TRACE_ZONE and other tracing macros, so that the Tracer class can
+    record what's happening in the audio callbacks, graph rendering, thread pools, message
+    dispatch and painting. When this is disabled, the macros don't generate any code.
+*/
+#ifndef JUCE_ENABLE_TRACING
+ #define JUCE_ENABLE_TRACING 0
+#endif
+
+/** Config: JUCE_CHECK_REALTIME_SAFETY
+    Enables checks which catch memory allocation, blocking locks, MessageManagerLocks and
+    Thread::sleep() being used by an audio callback. This adds a little overhead to every
+    allocation and lock, so it's intended for debug builds.
+    @see RealtimeSafety
+*/
+#ifndef JUCE_CHECK_REALTIME_SAFETY
+ #define JUCE_CHECK_REALTIME_SAFETY 0
+#endif
+
 /*  Config: JUCE_CATCH_UNHANDLED_EXCEPTIONS
     If enabled, this will add some exception-catching code to forward unhandled exceptions
     to your JUCEApplicationBase::unhandledException() callback.
@@ -156,9 +204,12 @@ class FileInputStream;
 class FileOutputStream;
 class XmlElement;
 class JSONFormatter;
+class TimeSliceThread;
 
 extern JUCE_API bool JUCE_CALLTYPE juce_isRunningUnderDebugger();
 extern JUCE_API void JUCE_CALLTYPE logAssertion (const char* file, int line) noexcept;
+extern JUCE_API bool JUCE_CALLTYPE juce_isInRealtimeContext() noexcept;
+extern JUCE_API void JUCE_CALLTYPE juce_reportRealtimeSafetyViolation (const char* operation) noexcept;
 
 #include "memory/juce_Memory.h"
 #include "maths/juce_MathsFunctions.h"
@@ -206,6 +257,11 @@ extern JUCE_API void JUCE_CALLTYPE logAssertion (const char* file, int line) noe
 #include "containers/juce_SortedSet.h"
 #include "containers/juce_SparseSet.h"
 #include "containers/juce_AbstractFifo.h"
+#include "containers/juce_FifoBuffer.h"
+#include "containers/juce_LockFreeQueue.h"
+#include "containers/juce_LockFreeListenerList.h"
+#include "memory/juce_MemoryArena.h"
+#include "memory/juce_ObjectPool.h"
 #include "text/juce_NewLine.h"
 #include "text/juce_StringPool.h"
 #include "text/juce_Identifier.h"
@@ -218,6 +274,7 @@ extern JUCE_API void JUCE_CALLTYPE logAssertion (const char* file, int line) noe
 #include "containers/juce_NamedValueSet.h"
 #include "containers/juce_DynamicObject.h"
 #include "containers/juce_HashMap.h"
+#include "containers/juce_FlatHashMap.h"
 #include "time/juce_RelativeTime.h"
 #include "time/juce_Time.h"
 #include "streams/juce_InputStream.h"
@@ -239,9 +296,11 @@ extern JUCE_API void JUCE_CALLTYPE logAssertion (const char* file, int line) noe
 #include "streams/juce_FileInputSource.h"
 #include "logging/juce_FileLogger.h"
 #include "javascript/juce_JSON.h"
+#include "javascript/juce_JSONStream.h"
 #include "javascript/juce_Javascript.h"
 #include "maths/juce_BigInteger.h"
 #include "maths/juce_Expression.h"
+#include "maths/juce_CompiledExpression.h"
 #include "maths/juce_Random.h"
 #include "misc/juce_Uuid.h"
 #include "misc/juce_WindowsRegistry.h"
@@ -252,11 +311,21 @@ extern JUCE_API void JUCE_CALLTYPE logAssertion (const char* file, int line) noe
 #include "threads/juce_InterProcessLock.h"
 #include "threads/juce_Process.h"
 #include "threads/juce_SpinLock.h"
+#include "threads/juce_LightweightMutex.h"
+#include "threads/juce_LightweightReadWriteLock.h"
+#include "threads/juce_LightweightSemaphore.h"
 #include "threads/juce_WaitableEvent.h"
 #include "threads/juce_Thread.h"
 #include "threads/juce_ThreadLocalValue.h"
+#include "threads/juce_RealtimeSafety.h"
+#include "threads/juce_RealtimeThreadGroup.h"
 #include "threads/juce_ThreadPool.h"
 #include "threads/juce_TimeSliceThread.h"
+#include "threads/juce_DeferredDeleter.h"
+#include "threads/juce_ChildProcessPool.h"
+#include "logging/juce_AsyncFileLogger.h"
+#include "files/juce_DirectoryScanner.h"
+#include "files/juce_MemoryMappedFilePrefetcher.h"
 #include "threads/juce_ReadWriteLock.h"
 #include "threads/juce_ScopedReadLock.h"
 #include "threads/juce_ScopedWriteLock.h"
@@ -264,13 +333,22 @@ extern JUCE_API void JUCE_CALLTYPE logAssertion (const char* file, int line) noe
 #include "network/juce_MACAddress.h"
 #include "network/juce_NamedPipe.h"
 #include "network/juce_Socket.h"
+#include "network/juce_SocketMultiplexer.h"
+#include "network/juce_SharedMemoryChannel.h"
 #include "network/juce_URL.h"
 #include "time/juce_PerformanceCounter.h"
+#include "logging/juce_Tracer.h"
 #include "unit_tests/juce_UnitTest.h"
+#include "unit_tests/juce_BenchmarkTest.h"
 #include "xml/juce_XmlDocument.h"
 #include "xml/juce_XmlElement.h"
+#include "xml/juce_XmlPullParser.h"
 #include "zip/juce_GZIPCompressorOutputStream.h"
 #include "zip/juce_GZIPDecompressorInputStream.h"
+#include "zip/juce_LZ4CompressorOutputStream.h"
+#include "zip/juce_LZ4DecompressorInputStream.h"
+#include "zip/juce_ZstdCompressorOutputStream.h"
+#include "zip/juce_ZstdDecompressorInputStream.h"
 #include "zip/juce_ZipFile.h"
 #include "containers/juce_PropertySet.h"
 #include "memory/juce_SharedResourcePointer.h"
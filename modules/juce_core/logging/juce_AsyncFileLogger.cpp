@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+AsyncFileLogger::AsyncFileLogger (const File& file,
+                                  const String& welcomeMessage,
+                                  const int64 maxFileSizeBytes,
+                                  const int maxNumBackupFiles,
+                                  const int queueSize,
+                                  const int flushIntervalMs)
+    : Thread ("Log writer"),
+      logFile (file),
+      maxFileSize (maxFileSizeBytes),
+      maxNumBackups (jmax (0, maxNumBackupFiles)),
+      flushInterval (jmax (1, flushIntervalMs)),
+      queue (queueSize),
+      numDroppedReported (0)
+{
+    if (! file.exists())
+        file.create();  // (to create the parent directories)
+
+    String welcome;
+    welcome << newLine
+            << "**********************************************************" << newLine
+            << welcomeMessage << newLine
+            << "Log started: " << Time::getCurrentTime().toString (true, true);
+
+    AsyncFileLogger::logMessage (welcome);
+    startThread (3);
+}
+
+AsyncFileLogger::~AsyncFileLogger()
+{
+    // (the thread writes out whatever's left in the queue before it exits)
+    signalThreadShouldExit();
+    notify();
+    stopThread (-1);
+}
+
+//==============================================================================
+void AsyncFileLogger::logMessage (const String& message)
+{
+    if (queue.push (message))
+    {
+        ++numQueued;
+
+        // (the thread only gets woken early if the queue's filling up - otherwise it'll
+        // pick the message up on its next timer tick)
+        if (queue.getNumReady() >= queue.getCapacity() / 2)
+            notify();
+    }
+    else
+    {
+        ++numDropped;
+    }
+}
+
+void AsyncFileLogger::flush()
+{
+    const int target = numQueued.get();
+
+    while (numWritten.get() - target < 0 && isThreadRunning())
+    {
+        notify();
+        flushed.wait (50);
+    }
+}
+
+//==============================================================================
+File AsyncFileLogger::getBackupFile (const int index) const
+{
+    return logFile.getSiblingFile (logFile.getFileNameWithoutExtension()
+                                     + "." + String (index) + logFile.getFileExtension());
+}
+
+void AsyncFileLogger::openFile()
+{
+    out = new FileOutputStream (logFile, 16384);
+
+    if (out->failedToOpen())
+        out = nullptr;
+}
+
+void AsyncFileLogger::rotateFiles()
+{
+    out = nullptr;
+
+    if (maxNumBackups > 0)
+    {
+        getBackupFile (maxNumBackups).deleteFile();
+
+        for (int i = maxNumBackups; --i > 0;)
+        {
+            const File f (getBackupFile (i));
+
+            if (f.exists())
+                f.moveFileTo (getBackupFile (i + 1));
+        }
+
+        logFile.moveFileTo (getBackupFile (1));
+    }
+    else
+    {
+        logFile.deleteFile();
+    }
+
+    openFile();
+}
+
+void AsyncFileLogger::writeQueuedMessages()
+{
+    bool anythingWritten = false;
+    String message;
+
+    if (out == nullptr)
+        openFile();
+
+    while (queue.pop (message))
+    {
+        if (out != nullptr)
+        {
+            *out << message << newLine;
+            anythingWritten = true;
+
+            if (maxFileSize > 0 && out->getPosition() > maxFileSize)
+                rotateFiles();
+        }
+
+        ++numWritten;
+    }
+
+    const int dropped = numDropped.get();
+
+    if (dropped != numDroppedReported && out != nullptr)
+    {
+        *out << "(" << (dropped - numDroppedReported) << " log messages were dropped)" << newLine;
+        numDroppedReported = dropped;
+        anythingWritten = true;
+    }
+
+    if (anythingWritten && out != nullptr)
+        out->flush();
+
+    flushed.signal();
+}
+
+void AsyncFileLogger::run()
+{
+    if (maxFileSize > 0 && logFile.getSize() > maxFileSize)
+        rotateFiles();
+    else
+        openFile();
+
+    while (! threadShouldExit())
+    {
+        wait (flushInterval);
+        writeQueuedMessages();
+    }
+
+    writeQueuedMessages();
+    out = nullptr;
+}
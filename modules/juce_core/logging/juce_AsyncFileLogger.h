@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_ASYNCFILELOGGER_H_INCLUDED
+#define JUCE_ASYNCFILELOGGER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A Logger that writes to a file using a background thread.
+
+    Unlike FileLogger, which opens the file and writes each message on the thread that
+    logs it, this just pushes the message onto a lock-free queue, so logMessage() never
+    blocks or touches the disk. A background thread keeps the file open, writes the
+    queued messages out in batches, and flushes the file at regular intervals.
+
+    If messages arrive faster than the thread can write them and the queue fills up,
+    new messages are dropped rather than making the caller wait. The number that were
+    lost is written to the log when there's room again, and can be read with
+    getNumMessagesDropped().
+
+    The file is also kept below a maximum size while logging, rather than only when the
+    logger is opened: when it grows beyond the limit it's renamed to "name.1.ext" (with
+    any older backups being shuffled along to "name.2.ext", etc.) and a new file is started.
+
+    @see FileLogger, Logger
+*/
+class JUCE_API  AsyncFileLogger  : public Logger,
+                                   private Thread
+{
+public:
+    //==============================================================================
+    /** Creates an AsyncFileLogger for a given file.
+
+        @param fileToWriteTo        the file to use - new messages will be appended to it. If the
+                                    file doesn't exist, it will be created, along with any parent
+                                    directories that are needed.
+        @param welcomeMessage       when opened, the logger will write a header to the log, along
+                                    with the current date and time, and this welcome message
+        @param maxFileSizeBytes     when the file grows beyond this size, it'll be moved to a
+                                    backup file and a new one started. If this is zero or less,
+                                    the file will be allowed to grow without limit.
+        @param maxNumBackupFiles    the number of old log files to keep when the file is rotated
+        @param queueSize            the maximum number of messages that can be waiting to be written
+        @param flushIntervalMs      how often the background thread writes and flushes the file
+    */
+    AsyncFileLogger (const File& fileToWriteTo,
+                     const String& welcomeMessage,
+                     int64 maxFileSizeBytes = 1024 * 1024,
+                     int maxNumBackupFiles = 2,
+                     int queueSize = 4096,
+                     int flushIntervalMs = 250);
+
+    /** Destructor.
+        This writes any messages that are still waiting before returning.
+    */
+    ~AsyncFileLogger();
+
+    //==============================================================================
+    /** Returns the file that this logger is writing to. */
+    const File& getLogFile() const noexcept               { return logFile; }
+
+    /** Returns the backup file that the log is moved to when it's rotated.
+        An index of 1 is the most recent backup.
+    */
+    File getBackupFile (int index) const;
+
+    /** Returns the total number of messages that have been thrown away because the
+        queue was full.
+    */
+    int getNumMessagesDropped() const noexcept            { return numDropped.get(); }
+
+    /** Blocks until all the messages that were logged before this call have been
+        written and flushed to the file.
+    */
+    void flush();
+
+    //==============================================================================
+    // (implementation of the Logger virtual method)
+    void logMessage (const String&) override;
+
+private:
+    //==============================================================================
+    File logFile;
+    const int64 maxFileSize;
+    const int maxNumBackups, flushInterval;
+    LockFreeQueue<String> queue;
+    Atomic<int> numQueued, numWritten, numDropped;
+    int numDroppedReported;
+    WaitableEvent flushed;
+    ScopedPointer<FileOutputStream> out;
+
+    void run() override;
+    void writeQueuedMessages();
+    void openFile();
+    void rotateFiles();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncFileLogger)
+};
+
+
+#endif   // JUCE_ASYNCFILELOGGER_H_INCLUDED
@@ -34,7 +34,10 @@
 /**
     A simple implementation of a Logger that writes to a file.
 
-    @see Logger
+    Each message is written to the file on the thread that logs it. If you're logging
+    from time-sensitive threads, an AsyncFileLogger may be a better choice.
+
+    @see Logger, AsyncFileLogger
 */
 class JUCE_API  FileLogger  : public Logger
 {
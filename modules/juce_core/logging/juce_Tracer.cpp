@@ -0,0 +1,433 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+struct Tracer::ThreadBuffer
+{
+    enum EventType
+    {
+        zoneEvent,
+        zoneWithClassNameEvent,
+        instantEvent,
+        counterEvent,
+        flowStartEvent,
+        flowStepEvent,
+        flowEndEvent
+    };
+
+    struct Event
+    {
+        int64 time;
+        const char* category;
+        const char* name;
+        const char* detail;
+
+        union
+        {
+            int64 duration;
+            uint64 flowId;
+            double value;
+        };
+
+        int type;
+    };
+
+    ThreadBuffer (const int capacity, const int index, const String& name)
+        : mask (capacity - 1), threadIndex (index), threadName (name)
+    {
+        events.malloc ((size_t) capacity);
+    }
+
+    // Only the thread that owns this buffer ever writes to it, so the only thing that
+    // needs to be atomic is the count, which tells the exporter how far it can read.
+    Event& getNextEvent (const int64 time, const int type, const char* category, const char* name) noexcept
+    {
+        Event& e = events [(int) (numWritten.value & mask)];
+        e.time = time;
+        e.type = type;
+        e.category = category;
+        e.name = name;
+        e.detail = nullptr;
+        return e;
+    }
+
+    void eventFinished() noexcept
+    {
+        numWritten.set (numWritten.value + 1);
+    }
+
+    // Copies out the events that are still in the buffer, leaving out any that the
+    // owner thread may have overwritten while they were being copied.
+    void getEvents (Array<Event>& result) const
+    {
+        const int64 capacity = mask + 1;
+        const int64 end = numWritten.get();
+        int64 start = jmax ((int64) 0, end - capacity);
+
+        for (int64 i = start; i < end; ++i)
+            result.add (events [(int) (i & mask)]);
+
+        const int64 endAfterCopying = numWritten.get();
+        const int64 numOverwritten = jmax ((int64) 0, (endAfterCopying + 1 - capacity) - start);
+
+        result.removeRange (0, (int) jmin (numOverwritten, end - start));
+    }
+
+    HeapBlock<Event> events;
+    const int64 mask;
+    Atomic<int64> numWritten;
+    const int threadIndex;
+    String threadName;
+
+    JUCE_DECLARE_NON_COPYABLE (ThreadBuffer)
+};
+
+//==============================================================================
+struct TracerState
+{
+    TracerState()  : maxEventsPerThread (65536), startTime (0) {}
+
+    Tracer::ThreadBuffer* getBufferForCurrentThread()
+    {
+        Tracer::ThreadBuffer*& buffer = currentThreadBuffer.get();
+
+        if (buffer == nullptr)
+        {
+            const SpinLock::ScopedLockType sl (lock);
+
+            buffer = new Tracer::ThreadBuffer (maxEventsPerThread, threadBuffers.size() + 1,
+                                               getNameOfCurrentThread());
+            threadBuffers.add (buffer);
+        }
+
+        return buffer;
+    }
+
+    String getNameOfCurrentThread() const
+    {
+        const Thread::ThreadID threadId = Thread::getCurrentThreadId();
+
+        for (int i = 0; i < threadNames.size(); ++i)
+            if (threadNames.getReference(i).threadId == threadId)
+                return threadNames.getReference(i).name;
+
+        if (Thread* const t = Thread::getCurrentThread())
+            return t->getThreadName();
+
+        return "Thread " + String::toHexString ((pointer_sized_int) threadId);
+    }
+
+    struct ThreadName
+    {
+        Thread::ThreadID threadId;
+        String name;
+    };
+
+    SpinLock lock;
+    OwnedArray<Tracer::ThreadBuffer> threadBuffers;
+    ThreadLocalValue<Tracer::ThreadBuffer*> currentThreadBuffer;
+    Array<ThreadName> threadNames;
+    int maxEventsPerThread;
+    int64 startTime;
+    Atomic<int64> lastFlowId;
+
+    static TracerState& getInstance()
+    {
+        static TracerState state;
+        return state;
+    }
+
+    static void addFlowEvent (const int type, const char* category, const char* name, const uint64 id) noexcept
+    {
+        Tracer::ThreadBuffer& buffer = *getInstance().getBufferForCurrentThread();
+        buffer.getNextEvent (Time::getHighResolutionTicks(), type, category, name).flowId = id;
+        buffer.eventFinished();
+    }
+};
+
+Atomic<int> Tracer::recording;
+
+//==============================================================================
+void Tracer::startRecording (const int maxEventsPerThread)
+{
+    TracerState& state = TracerState::getInstance();
+
+    {
+        const SpinLock::ScopedLockType sl (state.lock);
+
+        state.maxEventsPerThread = nextPowerOfTwo (jmax (256, maxEventsPerThread));
+
+        if (state.startTime == 0)
+            state.startTime = Time::getHighResolutionTicks();
+    }
+
+    recording = 1;
+}
+
+void Tracer::stopRecording() noexcept
+{
+    recording = 0;
+}
+
+void Tracer::clear()
+{
+    jassert (! isRecording()); // the buffers can't be reset while other threads are writing to them!
+
+    TracerState& state = TracerState::getInstance();
+    const SpinLock::ScopedLockType sl (state.lock);
+
+    for (int i = 0; i < state.threadBuffers.size(); ++i)
+        state.threadBuffers.getUnchecked(i)->numWritten = 0;
+
+    state.startTime = 0;
+}
+
+void Tracer::setCurrentThreadName (const String& name)
+{
+    TracerState& state = TracerState::getInstance();
+    const Thread::ThreadID threadId = Thread::getCurrentThreadId();
+    const SpinLock::ScopedLockType sl (state.lock);
+
+    if (ThreadBuffer* const buffer = state.currentThreadBuffer.get())
+        buffer->threadName = name;
+
+    for (int i = 0; i < state.threadNames.size(); ++i)
+    {
+        if (state.threadNames.getReference(i).threadId == threadId)
+        {
+            state.threadNames.getReference(i).name = name;
+            return;
+        }
+    }
+
+    TracerState::ThreadName tn = { threadId, name };
+    state.threadNames.add (tn);
+}
+
+//==============================================================================
+void Tracer::addZone (const char* category, const char* name, const char* detail,
+                      const bool detailIsClassName, const int64 startTime) noexcept
+{
+    const int64 now = Time::getHighResolutionTicks();
+    ThreadBuffer& buffer = *TracerState::getInstance().getBufferForCurrentThread();
+
+    ThreadBuffer::Event& e = buffer.getNextEvent (startTime, detailIsClassName ? ThreadBuffer::zoneWithClassNameEvent
+                                                                               : ThreadBuffer::zoneEvent,
+                                                  category, name);
+    e.detail = detail;
+    e.duration = now - startTime;
+    buffer.eventFinished();
+}
+
+void Tracer::instant (const char* category, const char* name) noexcept
+{
+    if (isRecording())
+    {
+        ThreadBuffer& buffer = *TracerState::getInstance().getBufferForCurrentThread();
+        buffer.getNextEvent (Time::getHighResolutionTicks(), ThreadBuffer::instantEvent, category, name);
+        buffer.eventFinished();
+    }
+}
+
+void Tracer::counter (const char* category, const char* name, const double value) noexcept
+{
+    if (isRecording())
+    {
+        ThreadBuffer& buffer = *TracerState::getInstance().getBufferForCurrentThread();
+        buffer.getNextEvent (Time::getHighResolutionTicks(), ThreadBuffer::counterEvent, category, name).value = value;
+        buffer.eventFinished();
+    }
+}
+
+void Tracer::flowStart (const char* category, const char* name, const uint64 id) noexcept
+{
+    if (isRecording())
+        TracerState::addFlowEvent (ThreadBuffer::flowStartEvent, category, name, id);
+}
+
+void Tracer::flowStep (const char* category, const char* name, const uint64 id) noexcept
+{
+    if (isRecording())
+        TracerState::addFlowEvent (ThreadBuffer::flowStepEvent, category, name, id);
+}
+
+void Tracer::flowEnd (const char* category, const char* name, const uint64 id) noexcept
+{
+    if (isRecording())
+        TracerState::addFlowEvent (ThreadBuffer::flowEndEvent, category, name, id);
+}
+
+uint64 Tracer::createFlowId() noexcept
+{
+    return (uint64) ++(TracerState::getInstance().lastFlowId);
+}
+
+//==============================================================================
+static String getTracerClassName (const char* mangledName)
+{
+   #if JUCE_GCC
+    int status = 0;
+
+    if (char* const demangled = abi::__cxa_demangle (mangledName, nullptr, nullptr, &status))
+    {
+        const String result (String::fromUTF8 (demangled));
+        ::free (demangled);
+        return result;
+    }
+   #endif
+
+    return String::fromUTF8 (mangledName);
+}
+
+static void writeTracerEventStart (JSONStreamWriter& json, const char* phase, const char* category,
+                                   const char* name, const int threadIndex, const double timeMicroseconds)
+{
+    json.startObject();
+    json.writePropertyName ("ph");     json.writeString (phase);
+    json.writePropertyName ("cat");    json.writeString (category);
+    json.writePropertyName ("name");   json.writeString (name);
+    json.writePropertyName ("pid");    json.writeInt (1);
+    json.writePropertyName ("tid");    json.writeInt (threadIndex);
+    json.writePropertyName ("ts");     json.writeDouble (timeMicroseconds);
+}
+
+bool Tracer::writeChromeTrace (OutputStream& output)
+{
+    TracerState& state = TracerState::getInstance();
+    const SpinLock::ScopedLockType sl (state.lock);
+
+    const double microsecondsPerTick = 1.0e6 / (double) Time::getHighResolutionTicksPerSecond();
+
+    JSONStreamWriter json (output, true);
+    json.startObject();
+    json.writePropertyName ("displayTimeUnit");
+    json.writeString ("ms");
+    json.writePropertyName ("traceEvents");
+    json.startArray();
+
+    Array<ThreadBuffer::Event> events;
+
+    for (int i = 0; i < state.threadBuffers.size(); ++i)
+    {
+        const ThreadBuffer& buffer = *state.threadBuffers.getUnchecked (i);
+
+        json.startObject();
+        json.writePropertyName ("ph");    json.writeString ("M");
+        json.writePropertyName ("name");  json.writeString ("thread_name");
+        json.writePropertyName ("pid");   json.writeInt (1);
+        json.writePropertyName ("tid");   json.writeInt (buffer.threadIndex);
+        json.writePropertyName ("args");
+        json.startObject();
+        json.writePropertyName ("name");  json.writeString (buffer.threadName);
+        json.endObject();
+        json.endObject();
+
+        events.clearQuick();
+        buffer.getEvents (events);
+
+        for (int j = 0; j < events.size(); ++j)
+        {
+            const ThreadBuffer::Event& e = events.getReference (j);
+            const double time = (e.time - state.startTime) * microsecondsPerTick;
+
+            switch (e.type)
+            {
+                case ThreadBuffer::zoneEvent:
+                case ThreadBuffer::zoneWithClassNameEvent:
+                    writeTracerEventStart (json, "X", e.category, e.name, buffer.threadIndex, time);
+                    json.writePropertyName ("dur");
+                    json.writeDouble (e.duration * microsecondsPerTick);
+
+                    if (e.detail != nullptr)
+                    {
+                        json.writePropertyName ("args");
+                        json.startObject();
+                        json.writePropertyName ("detail");
+                        json.writeString (e.type == ThreadBuffer::zoneWithClassNameEvent ? getTracerClassName (e.detail)
+                                                                                         : String::fromUTF8 (e.detail));
+                        json.endObject();
+                    }
+                    break;
+
+                case ThreadBuffer::instantEvent:
+                    writeTracerEventStart (json, "i", e.category, e.name, buffer.threadIndex, time);
+                    json.writePropertyName ("s");
+                    json.writeString ("t");
+                    break;
+
+                case ThreadBuffer::counterEvent:
+                    writeTracerEventStart (json, "C", e.category, e.name, buffer.threadIndex, time);
+                    json.writePropertyName ("args");
+                    json.startObject();
+                    json.writePropertyName ("value");
+                    json.writeDouble (e.value);
+                    json.endObject();
+                    break;
+
+                default:
+                    writeTracerEventStart (json, e.type == ThreadBuffer::flowStartEvent ? "s"
+                                                  : (e.type == ThreadBuffer::flowStepEvent ? "t" : "f"),
+                                          e.category, e.name, buffer.threadIndex, time);
+                    json.writePropertyName ("id");
+                    json.writeInt ((int64) e.flowId);
+
+                    if (e.type == ThreadBuffer::flowEndEvent)
+                    {
+                        json.writePropertyName ("bp");
+                        json.writeString ("e");
+                    }
+                    break;
+            }
+
+            json.endObject();
+        }
+    }
+
+    json.endArray();
+    json.endObject();
+    output.flush();
+    return true;
+}
+
+bool Tracer::saveChromeTrace (const File& file)
+{
+    TemporaryFile temp (file);
+
+    {
+        FileOutputStream out (temp.getFile());
+
+        if (! (out.openedOk() && writeChromeTrace (out)))
+            return false;
+
+        out.flush();
+
+        if (out.getStatus().failed())
+            return false;
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
@@ -0,0 +1,232 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_TRACER_H_INCLUDED
+#define JUCE_TRACER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Records a timeline of what each thread is doing, so that things like audio dropouts
+    and UI hitches can be tracked down to the code that caused them.
+
+    Each thread that records events gets its own fixed-size ring buffer, and writing an
+    event into it doesn't take any locks or allocate any memory, so it's safe to use on
+    the audio thread. When a buffer fills up, the oldest events are overwritten.
+
+    Normally you'd use the JUCE_TRACE_ZONE, JUCE_TRACE_COUNTER, JUCE_TRACE_INSTANT and
+    JUCE_TRACE_FLOW_xxx macros rather than calling this class directly, because they
+    compile to nothing unless JUCE_ENABLE_TRACING is turned on. The audio device callbacks,
+    AudioProcessorGraph, ThreadPool jobs, Timers, message dispatch and component painting
+    are already instrumented with them.
+
+    e.g. @code
+    void MyProcessor::processBlock (AudioSampleBuffer& buffer, MidiBuffer& midi)
+    {
+        JUCE_TRACE_ZONE ("dsp", "MyProcessor::processBlock");
+        ...
+    }
+
+    // ..and then later, in your app:
+    Tracer::startRecording();
+    ...
+    Tracer::stopRecording();
+    Tracer::saveChromeTrace (File::getSpecialLocation (File::userDesktopDirectory)
+                                .getChildFile ("trace.json"));
+    @endcode
+
+    The file that's written can be opened in Chrome's about:tracing page or in the
+    Perfetto UI.
+
+    All the names, categories and details that are passed in must be string literals,
+    or other strings which will stay alive until the trace has been exported, because
+    only their pointers are stored.
+*/
+class JUCE_API  Tracer
+{
+public:
+    //==============================================================================
+    /** Starts recording events on all threads.
+
+        The first time a thread records an event, a ring buffer is created for it which
+        can hold the given number of events (rounded up to a power of two). Each event
+        takes about 48 bytes. Threads which already have a buffer will keep using it.
+    */
+    static void startRecording (int maxEventsPerThread = 65536);
+
+    /** Stops recording. The events that were recorded are kept until clear() is called. */
+    static void stopRecording() noexcept;
+
+    /** Returns true if events are currently being recorded. */
+    static bool isRecording() noexcept              { return recording.value != 0; }
+
+    /** Discards all the events that have been recorded.
+        This must only be called when recording is stopped.
+    */
+    static void clear();
+
+    //==============================================================================
+    /** Writes all the recorded events to a stream, in the Chrome trace event JSON format.
+
+        This can be called while recording is still going on, but any events that were
+        being overwritten during the export will be left out.
+    */
+    static bool writeChromeTrace (OutputStream& output);
+
+    /** Writes all the recorded events to a file, in the Chrome trace event JSON format.
+        @see writeChromeTrace
+    */
+    static bool saveChromeTrace (const File& file);
+
+    /** Sets the name that the calling thread will be given in the exported trace.
+
+        Threads that were started by a juce::Thread will use their thread name if this
+        isn't called.
+    */
+    static void setCurrentThreadName (const String& name);
+
+    //==============================================================================
+    /** Marks the time at which the current thread reached a point in the code. */
+    static void instant (const char* category, const char* name) noexcept;
+
+    /** Records the current value of a named counter. */
+    static void counter (const char* category, const char* name, double value) noexcept;
+
+    /** Starts an arrow which links this point to a later flowStep() or flowEnd() call,
+        possibly on another thread, that uses the same id.
+
+        Flow events are attached to whatever zone the thread is in when they're recorded.
+    */
+    static void flowStart (const char* category, const char* name, uint64 id) noexcept;
+
+    /** Continues an arrow which was started by flowStart(). */
+    static void flowStep (const char* category, const char* name, uint64 id) noexcept;
+
+    /** Ends an arrow which was started by flowStart(). */
+    static void flowEnd (const char* category, const char* name, uint64 id) noexcept;
+
+    /** Returns a new id to use for a set of flow events. */
+    static uint64 createFlowId() noexcept;
+
+    //==============================================================================
+    /** Times the lifetime of this object, and records it as a zone.
+
+        Zones on the same thread can be nested. A zone can also be given a detail string,
+        or the type of the object that's doing the work, which is shown as an argument of
+        the zone.
+    */
+    class JUCE_API  ScopedZone
+    {
+    public:
+        ScopedZone (const char* category, const char* name, const char* detail = nullptr) noexcept
+            : zoneCategory (category), zoneName (name), zoneDetail (detail), detailIsClassName (false),
+              startTime (isRecording() ? Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        ScopedZone (const char* category, const char* name, const std::type_info& classType) noexcept
+            : zoneCategory (category), zoneName (name), zoneDetail (classType.name()), detailIsClassName (true),
+              startTime (isRecording() ? Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        ~ScopedZone() noexcept
+        {
+            if (startTime != 0)
+                addZone (zoneCategory, zoneName, zoneDetail, detailIsClassName, startTime);
+        }
+
+    private:
+        const char* const zoneCategory;
+        const char* const zoneName;
+        const char* const zoneDetail;
+        const bool detailIsClassName;
+        const int64 startTime;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedZone)
+    };
+
+private:
+    //==============================================================================
+    struct ThreadBuffer;
+    friend class ScopedZone;
+    friend struct TracerState;
+
+    static Atomic<int> recording;
+
+    static void addZone (const char*, const char*, const char*, bool, int64 startTime) noexcept;
+
+    Tracer() JUCE_DELETED_FUNCTION;
+    JUCE_DECLARE_NON_COPYABLE (Tracer)
+};
+
+//==============================================================================
+#if JUCE_ENABLE_TRACING || DOXYGEN
+ /** Times the rest of the enclosing scope, and records it as a zone.
+     The category and name must be string literals.
+     @see Tracer::ScopedZone
+ */
+ #define JUCE_TRACE_ZONE(category, name) \
+    const juce::Tracer::ScopedZone JUCE_JOIN_MACRO (juceTraceZone, __LINE__) (category, name)
+
+ /** Times the rest of the enclosing scope, and records it as a zone with a detail string.
+     @see Tracer::ScopedZone
+ */
+ #define JUCE_TRACE_ZONE_WITH_DETAIL(category, name, detail) \
+    const juce::Tracer::ScopedZone JUCE_JOIN_MACRO (juceTraceZone, __LINE__) (category, name, detail)
+
+ /** Times the rest of the enclosing scope, and records it as a zone which shows the
+     class of the given object.
+     @see Tracer::ScopedZone
+ */
+ #define JUCE_TRACE_ZONE_FOR_OBJECT(category, name, object) \
+    const juce::Tracer::ScopedZone JUCE_JOIN_MACRO (juceTraceZone, __LINE__) (category, name, typeid (object))
+
+ /** Records an instant event. @see Tracer::instant */
+ #define JUCE_TRACE_INSTANT(category, name)                 juce::Tracer::instant (category, name)
+ /** Records the value of a counter. @see Tracer::counter */
+ #define JUCE_TRACE_COUNTER(category, name, value)          juce::Tracer::counter (category, name, (double) (value))
+ /** Starts a flow arrow. @see Tracer::flowStart */
+ #define JUCE_TRACE_FLOW_START(category, name, id)          juce::Tracer::flowStart (category, name, (juce::uint64) (id))
+ /** Continues a flow arrow. @see Tracer::flowStep */
+ #define JUCE_TRACE_FLOW_STEP(category, name, id)           juce::Tracer::flowStep (category, name, (juce::uint64) (id))
+ /** Ends a flow arrow. @see Tracer::flowEnd */
+ #define JUCE_TRACE_FLOW_END(category, name, id)            juce::Tracer::flowEnd (category, name, (juce::uint64) (id))
+#else
+ #define JUCE_TRACE_ZONE(category, name)
+ #define JUCE_TRACE_ZONE_WITH_DETAIL(category, name, detail)
+ #define JUCE_TRACE_ZONE_FOR_OBJECT(category, name, object)
+ #define JUCE_TRACE_INSTANT(category, name)
+ #define JUCE_TRACE_COUNTER(category, name, value)
+ #define JUCE_TRACE_FLOW_START(category, name, id)
+ #define JUCE_TRACE_FLOW_STEP(category, name, id)
+ #define JUCE_TRACE_FLOW_END(category, name, id)
+#endif
+
+
+#endif   // JUCE_TRACER_H_INCLUDED
@@ -474,25 +474,339 @@ BigInteger& BigInteger::operator-= (const BigInteger& other)
     return *this;
 }
 
-BigInteger& BigInteger::operator*= (const BigInteger& other)
+//==============================================================================
+// These work directly on arrays of 32-bit limbs, least significant first. The intermediate
+// products and carries are held in 64-bit integers, which keeps them portable.
+namespace BigIntegerLimbs
 {
-    BigInteger total;
-    highestBit = getHighestBit();
-    const bool wasNegative = isNegative();
-    setNegative (false);
+    static size_t getNumUsed (const uint32* v, size_t n) noexcept
+    {
+        while (n > 0 && v[n - 1] == 0)
+            --n;
+
+        return n;
+    }
+
+    // r += a, where r has enough room to hold any carry
+    static void addInPlace (uint32* r, const size_t numR, const uint32* a, const size_t numA) noexcept
+    {
+        uint64 carry = 0;
+        size_t i = 0;
+
+        for (; i < numA; ++i)
+        {
+            carry += (uint64) r[i] + a[i];
+            r[i] = (uint32) carry;
+            carry >>= 32;
+        }
+
+        for (; carry != 0 && i < numR; ++i)
+        {
+            carry += r[i];
+            r[i] = (uint32) carry;
+            carry >>= 32;
+        }
+
+        jassert (carry == 0);
+    }
+
+    // r -= a, where r >= a
+    static void subtractInPlace (uint32* r, const size_t numR, const uint32* a, const size_t numA) noexcept
+    {
+        uint32 borrow = 0;
+        size_t i = 0;
+
+        for (; i < numA; ++i)
+        {
+            const int64 d = (int64) r[i] - a[i] - borrow;
+            r[i] = (uint32) d;
+            borrow = d < 0 ? 1 : 0;
+        }
+
+        for (; borrow != 0 && i < numR; ++i)
+        {
+            borrow = r[i] == 0 ? 1 : 0;
+            --r[i];
+        }
+
+        jassert (borrow == 0);
+    }
+
+    // r = a * b, where r has room for numA + numB limbs and doesn't overlap a or b
+    static void multiplySchoolbook (uint32* r, const uint32* a, const size_t numA,
+                                    const uint32* b, const size_t numB) noexcept
+    {
+        zeromem (r, sizeof (uint32) * (numA + numB));
+
+        for (size_t i = 0; i < numA; ++i)
+        {
+            const uint64 ai = a[i];
+
+            if (ai != 0)
+            {
+                uint64 carry = 0;
+
+                for (size_t j = 0; j < numB; ++j)
+                {
+                    carry += ai * b[j] + r[i + j];
+                    r[i + j] = (uint32) carry;
+                    carry >>= 32;
+                }
+
+                r[i + numB] = (uint32) carry;
+            }
+        }
+    }
+
+    // Below this many limbs, the Karatsuba split costs more than it saves.
+    enum { karatsubaThreshold = 40 };
+
+    static void multiply (uint32* r, const uint32* a, size_t numA, const uint32* b, size_t numB)
+    {
+        if (numA < numB)
+        {
+            std::swap (a, b);
+            std::swap (numA, numB);
+        }
+
+        if (numB < karatsubaThreshold)
+        {
+            multiplySchoolbook (r, a, numA, b, numB);
+            return;
+        }
+
+        const size_t half = (numA + 1) / 2;
+        const size_t numResult = numA + numB;
+
+        if (numB <= half)
+        {
+            // b is much shorter than a, so multiply it by each half of a separately
+            zeromem (r, sizeof (uint32) * numResult);
+            HeapBlock<uint32> product (half + numB);
+
+            multiply (product, a, half, b, numB);
+            addInPlace (r, numResult, product, half + numB);
+
+            multiply (product, a + half, numA - half, b, numB);
+            addInPlace (r + half, numResult - half, product, numA - half + numB);
+            return;
+        }
+
+        // (a1.B + a0) (b1.B + b0) = z2.B^2 + z1.B + z0, where z1 = (a0 + a1) (b0 + b1) - z2 - z0
+        const uint32* const a1 = a + half;
+        const uint32* const b1 = b + half;
+        const size_t numA1 = numA - half;
+        const size_t numB1 = numB - half;
+
+        multiply (r, a, half, b, half);
+        multiply (r + 2 * half, a1, numA1, b1, numB1);
+
+        HeapBlock<uint32> sumA (half + 1, true), sumB (half + 1, true), z1 (2 * (half + 1));
+        memcpy (sumA, a, sizeof (uint32) * half);
+        memcpy (sumB, b, sizeof (uint32) * half);
+        addInPlace (sumA, half + 1, a1, numA1);
+        addInPlace (sumB, half + 1, b1, numB1);
+
+        multiply (z1, sumA, half + 1, sumB, half + 1);
+        subtractInPlace (z1, 2 * (half + 1), r, 2 * half);
+        subtractInPlace (z1, 2 * (half + 1), r + 2 * half, numA1 + numB1);
+        addInPlace (r + half, numResult - half, z1, getNumUsed (z1, 2 * (half + 1)));
+    }
+
+    // Long division (Knuth's algorithm D). The quotient needs numU - numV + 1 limbs, and
+    // the remainder numV limbs; the top limb of v mustn't be zero.
+    static void divide (uint32* quotient, uint32* remainder,
+                        const uint32* u, const size_t numU, const uint32* v, const size_t numV)
+    {
+        jassert (numV > 0 && v[numV - 1] != 0 && numU >= numV);
+
+        if (numV == 1)
+        {
+            const uint64 divisor = v[0];
+            uint64 rem = 0;
+
+            for (size_t i = numU; i-- > 0;)
+            {
+                rem = (rem << 32) | u[i];
+                quotient[i] = (uint32) (rem / divisor);
+                rem %= divisor;
+            }
+
+            remainder[0] = (uint32) rem;
+            return;
+        }
+
+        // Normalise so that the divisor's top bit is set, which keeps the quotient estimates
+        // within 2 of the right answer.
+        const int shift = 31 - highestBitInInt (v[numV - 1]);
+        HeapBlock<uint32> vn (numV), un (numU + 1);
+
+        for (size_t i = numV; --i > 0;)
+            vn[i] = shift == 0 ? v[i] : ((v[i] << shift) | (v[i - 1] >> (32 - shift)));
+
+        vn[0] = v[0] << shift;
+        un[numU] = shift == 0 ? 0 : (u[numU - 1] >> (32 - shift));
+
+        for (size_t i = numU; --i > 0;)
+            un[i] = shift == 0 ? u[i] : ((u[i] << shift) | (u[i - 1] >> (32 - shift)));
+
+        un[0] = u[0] << shift;
+
+        const uint64 base = (uint64) 1 << 32;
+        const uint64 topV = vn[numV - 1];
+
+        for (size_t j = numU - numV + 1; j-- > 0;)
+        {
+            const uint64 top = ((uint64) un[j + numV] << 32) | un[j + numV - 1];
+            uint64 qhat = top / topV;
+            uint64 rhat = top % topV;
+
+            while (qhat >= base || qhat * vn[numV - 2] > ((rhat << 32) | un[j + numV - 2]))
+            {
+                --qhat;
+                rhat += topV;
+
+                if (rhat >= base)
+                    break;
+            }
+
+            // un[j...j + numV] -= qhat * vn
+            uint64 carry = 0;
+            int64 borrow = 0;
+
+            for (size_t i = 0; i < numV; ++i)
+            {
+                const uint64 p = qhat * vn[i] + carry;
+                carry = p >> 32;
+
+                const int64 d = (int64) un[i + j] - (int64) (uint32) p - borrow;
+                un[i + j] = (uint32) d;
+                borrow = d < 0 ? 1 : 0;
+            }
+
+            const int64 d = (int64) un[j + numV] - (int64) carry - borrow;
+            un[j + numV] = (uint32) d;
+            quotient[j] = (uint32) qhat;
+
+            if (d < 0)
+            {
+                // the estimate was one too big, so add the divisor back
+                --quotient[j];
+                uint64 c = 0;
+
+                for (size_t i = 0; i < numV; ++i)
+                {
+                    c += (uint64) un[i + j] + vn[i];
+                    un[i + j] = (uint32) c;
+                    c >>= 32;
+                }
+
+                un[j + numV] += (uint32) c;
+            }
+        }
+
+        for (size_t i = 0; i < numV; ++i)
+            remainder[i] = shift == 0 ? un[i] : ((un[i] >> shift) | (un[i + 1] << (32 - shift)));
+    }
 
-    for (int i = 0; i <= highestBit; ++i)
+    //==============================================================================
+    // Montgomery arithmetic modulo an odd number m of n limbs, with R = 2^(32n). Numbers are
+    // kept in the form aR mod m, so that each modular multiplication needs no division.
+    struct Montgomery
     {
-        if (operator[](i))
+        Montgomery (const uint32* m, size_t n)  : modulus (m), numLimbs (n), scratch (n + 2)
         {
-            BigInteger n (other);
-            n.setNegative (false);
-            n <<= i;
-            total += n;
+            jassert ((m[0] & 1) != 0);
+
+            // Newton's iteration for m[0]^-1 mod 2^32 - each step doubles the number of correct bits
+            uint32 inverse = m[0];
+
+            for (int i = 0; i < 5; ++i)
+                inverse *= 2 - m[0] * inverse;
+
+            minusInverse = (uint32) 0 - inverse;
+        }
+
+        // result = a.b.R^-1 mod m, where a, b < m. The result may alias a or b.
+        // This takes the same time whatever the values are.
+        void multiply (uint32* result, const uint32* a, const uint32* b) const noexcept
+        {
+            const size_t n = numLimbs;
+            uint32* const t = scratch;
+            zeromem (t, sizeof (uint32) * (n + 2));
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                const uint64 bi = b[i];
+                uint64 c = 0;
+
+                for (size_t j = 0; j < n; ++j)
+                {
+                    c += a[j] * bi + t[j];
+                    t[j] = (uint32) c;
+                    c >>= 32;
+                }
+
+                c += t[n];
+                t[n] = (uint32) c;
+                t[n + 1] = (uint32) (c >> 32);
+
+                const uint64 u = (uint32) (t[0] * minusInverse);
+                c = (u * modulus[0] + t[0]) >> 32;
+
+                for (size_t j = 1; j < n; ++j)
+                {
+                    c += u * modulus[j] + t[j];
+                    t[j - 1] = (uint32) c;
+                    c >>= 32;
+                }
+
+                c += t[n];
+                t[n - 1] = (uint32) c;
+                t[n] = t[n + 1] + (uint32) (c >> 32);
+            }
+
+            // t < 2m, so subtract m once if needed, choosing the result with a mask rather than a branch
+            uint32 borrow = 0;
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                const int64 d = (int64) t[i] - modulus[i] - borrow;
+                result[i] = (uint32) d;
+                borrow = (uint32) (d < 0);
+            }
+
+            const uint32 keepOriginal = (uint32) 0 - (uint32) (borrow > t[n]);
+
+            for (size_t i = 0; i < n; ++i)
+                result[i] = (t[i] & keepOriginal) | (result[i] & ~keepOriginal);
         }
+
+        const uint32* modulus;
+        const size_t numLimbs;
+        uint32 minusInverse;
+        HeapBlock<uint32> scratch;
+    };
+}
+
+BigInteger& BigInteger::operator*= (const BigInteger& other)
+{
+    const int ourHB = getHighestBit();
+    const int otherHB = other.getHighestBit();
+    BigInteger total;
+
+    if (ourHB >= 0 && otherHB >= 0)
+    {
+        const size_t numOurs = bitToIndex (ourHB) + 1;
+        const size_t numOthers = bitToIndex (otherHB) + 1;
+
+        total.ensureSize (numOurs + numOthers);
+        BigIntegerLimbs::multiply (total.values, values, numOurs, other.values, numOthers);
+        total.highestBit = ourHB + otherHB + 1;
+        total.highestBit = total.getHighestBit();
     }
 
-    total.setNegative (wasNegative ^ other.isNegative());
+    total.setNegative (isNegative() ^ other.isNegative());
     swapWith (total);
     return *this;
 }
@@ -513,30 +827,34 @@ void BigInteger::divideBy (const BigInteger& divisor, BigInteger& remainder)
     else
     {
         const bool wasNegative = isNegative();
+        const bool divisorWasNegative = divisor.isNegative();
 
-        swapWith (remainder);
-        remainder.setNegative (false);
-        clear();
+        if (ourHB < divHB)
+        {
+            swapWith (remainder);
+            clear();
+        }
+        else
+        {
+            const size_t numOurs = bitToIndex (ourHB) + 1;
+            const size_t numDivisor = bitToIndex (divHB) + 1;
 
-        BigInteger temp (divisor);
-        temp.setNegative (false);
+            BigInteger quotient, rem;
+            quotient.ensureSize (numOurs - numDivisor + 1);
+            rem.ensureSize (numDivisor);
 
-        int leftShift = ourHB - divHB;
-        temp <<= leftShift;
+            BigIntegerLimbs::divide (quotient.values, rem.values, values, numOurs, divisor.values, numDivisor);
 
-        while (leftShift >= 0)
-        {
-            if (remainder.compareAbsolute (temp) >= 0)
-            {
-                remainder -= temp;
-                setBit (leftShift);
-            }
+            quotient.highestBit = ourHB - divHB + 1;
+            quotient.highestBit = quotient.getHighestBit();
+            rem.highestBit = divHB;
+            rem.highestBit = rem.getHighestBit();
 
-            if (--leftShift >= 0)
-                temp >>= 1;
+            swapWith (quotient);
+            remainder.swapWith (rem);
         }
 
-        negative = wasNegative ^ divisor.isNegative();
+        negative = wasNegative ^ divisorWasNegative;
         remainder.setNegative (wasNegative);
     }
 }
@@ -818,12 +1136,18 @@ BigInteger BigInteger::findGreatestCommonDivisor (BigInteger n) const
 
 void BigInteger::exponentModulo (const BigInteger& exponent, const BigInteger& modulus)
 {
+    if (modulus[0] && modulus.getHighestBit() > 0)
+    {
+        exponentModuloMontgomery (exponent, modulus, false);
+        return;
+    }
+
     BigInteger exp (exponent);
-    exp %= modulus;
 
     BigInteger value (1);
     swapWith (value);
     value %= modulus;
+    operator%= (modulus);
 
     while (! exp.isZero())
     {
@@ -839,6 +1163,130 @@ void BigInteger::exponentModulo (const BigInteger& exponent, const BigInteger& m
     }
 }
 
+void BigInteger::exponentModuloConstantTime (const BigInteger& exponent, const BigInteger& modulus)
+{
+    // The constant-time algorithm only works with an odd modulus (which an RSA modulus always is)
+    jassert (modulus[0] && modulus.getHighestBit() > 0);
+
+    if (modulus[0] && modulus.getHighestBit() > 0)
+        exponentModuloMontgomery (exponent, modulus, true);
+    else
+        exponentModulo (exponent, modulus);
+}
+
+void BigInteger::exponentModuloMontgomery (const BigInteger& exponent, const BigInteger& modulus, const bool constantTime)
+{
+    const int modHB = modulus.getHighestBit();
+    const size_t n = bitToIndex (modHB) + 1;
+    const BigIntegerLimbs::Montgomery mont (modulus.values, n);
+
+    // The base and 1 in Montgomery form, i.e. multiplied by R = 2^(32n)
+    BigInteger base (*this);
+    base %= modulus;
+
+    if (base.isNegative())
+        base += modulus;
+
+    base <<= (int) (32 * n);
+    base %= modulus;
+    base.setNegative (false);
+
+    BigInteger one (1);
+    one <<= (int) (32 * n);
+    one %= modulus;
+
+    jassert (base.getHighestBit() <= modHB && one.getHighestBit() <= modHB);
+    base.ensureSize (n);
+    one.ensureSize (n);
+
+    const int windowBits = constantTime ? 4 : (exponent.getHighestBit() > 256 ? 5 : 4);
+    const int tableSize = constantTime ? (1 << windowBits) : (1 << (windowBits - 1));
+
+    HeapBlock<uint32> table ((size_t) tableSize * n), result (n), selected (n), square (n);
+
+    if (constantTime)
+    {
+        // table[i] = base^i
+        memcpy (table, one.values, sizeof (uint32) * n);
+        memcpy (table + n, base.values, sizeof (uint32) * n);
+
+        for (int i = 2; i < tableSize; ++i)
+            mont.multiply (table + (size_t) i * n, table + (size_t) (i - 1) * n, table + n);
+
+        // Always works through the full length of the modulus in fixed windows, and reads
+        // every table entry each time, so neither the timing nor the memory access pattern
+        // depends on the exponent's bits.
+        const int numWindows = (jmax (modHB, exponent.getHighestBit()) + windowBits) / windowBits;
+        memcpy (result, one.values, sizeof (uint32) * n);
+
+        for (int w = numWindows; --w >= 0;)
+        {
+            for (int i = 0; i < windowBits; ++i)
+                mont.multiply (result, result, result);
+
+            const uint32 digit = (uint32) exponent.getBitRangeAsInt (w * windowBits, windowBits);
+            zeromem (selected, sizeof (uint32) * n);
+
+            for (int i = 0; i < tableSize; ++i)
+            {
+                const uint32 diff = digit ^ (uint32) i;
+                const uint32 mask = ((diff | ((uint32) 0 - diff)) >> 31) - 1;   // all ones if i == digit
+                const uint32* const entry = table + (size_t) i * n;
+
+                for (size_t j = 0; j < n; ++j)
+                    selected[j] |= entry[j] & mask;
+            }
+
+            mont.multiply (result, result, selected);
+        }
+    }
+    else
+    {
+        // Sliding window: table[i] = base^(2i + 1)
+        memcpy (table, base.values, sizeof (uint32) * n);
+        mont.multiply (square, table, table);
+
+        for (int i = 1; i < tableSize; ++i)
+            mont.multiply (table + (size_t) i * n, table + (size_t) (i - 1) * n, square);
+
+        memcpy (result, one.values, sizeof (uint32) * n);
+
+        for (int bit = exponent.getHighestBit(); bit >= 0;)
+        {
+            if (! exponent[bit])
+            {
+                mont.multiply (result, result, result);
+                --bit;
+                continue;
+            }
+
+            // find the longest window that starts with this bit and ends in a set bit
+            int lowBit = jmax (0, bit - windowBits + 1);
+
+            while (! exponent[lowBit])
+                ++lowBit;
+
+            for (int i = lowBit; i <= bit; ++i)
+                mont.multiply (result, result, result);
+
+            const int windowValue = exponent.getBitRangeAsInt (lowBit, bit - lowBit + 1);
+            mont.multiply (result, result, table + (size_t) (windowValue >> 1) * n);
+            bit = lowBit - 1;
+        }
+    }
+
+    // converting back out of Montgomery form is a multiplication by 1
+    zeromem (selected, sizeof (uint32) * n);
+    selected[0] = 1;
+    mont.multiply (result, result, selected);
+
+    clear();
+    ensureSize (n);
+    memcpy (values, result, sizeof (uint32) * n);
+    highestBit = (int) (n * 32) - 1;
+    highestBit = getHighestBit();
+}
+
 void BigInteger::inverseModulo (const BigInteger& modulus)
 {
     if (modulus.isOne() || modulus.isNegative())
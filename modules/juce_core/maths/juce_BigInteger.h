@@ -248,9 +248,22 @@ public:
 
     /** Performs a combined exponent and modulo operation.
         This BigInteger's value becomes (this ^ exponent) % modulus.
+
+        The time this takes depends on the exponent's bits, so if the exponent is a secret
+        (e.g. a private key), use exponentModuloConstantTime() instead.
+        @see exponentModuloConstantTime
     */
     void exponentModulo (const BigInteger& exponent, const BigInteger& modulus);
 
+    /** Performs the same operation as exponentModulo(), but in a way that takes the same
+        time and memory accesses whatever the exponent's bits are, so that it can't be used
+        to discover a secret exponent. It's a little slower than exponentModulo().
+
+        The modulus must be odd, as it always is for an RSA key.
+        @see exponentModulo
+    */
+    void exponentModuloConstantTime (const BigInteger& exponent, const BigInteger& modulus);
+
     /** Performs an inverse modulo on the value.
         i.e. the result is (this ^ -1) mod (modulus).
     */
@@ -317,6 +330,7 @@ private:
     void ensureSize (size_t);
     void shiftLeft (int bits, int startBit);
     void shiftRight (int bits, int startBit);
+    void exponentModuloMontgomery (const BigInteger& exponent, const BigInteger& modulus, bool constantTime);
 
     JUCE_LEAK_DETECTOR (BigInteger)
 };
@@ -0,0 +1,526 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+struct CompiledExpression::Instruction
+{
+    enum Type
+    {
+        pushConstant,
+        pushSlot,
+        add,
+        subtract,
+        multiply,
+        divide,
+        negate,
+        callFunction
+    };
+
+    Instruction() noexcept : type (pushConstant), index (0), numParameters (0) {}
+    Instruction (Type t, int i, int numParams) noexcept : type (t), index (i), numParameters (numParams) {}
+
+    Type type;
+    int index, numParameters;
+};
+
+//==============================================================================
+struct CompiledExpression::SymbolTable::Slot
+{
+    Slot (const String& symbolName, const Expression& sym, int64 stamp)
+        : name (symbolName), symbol (sym), value (0), lastChange (stamp), orderState (unvisited)
+    {
+    }
+
+    enum OrderState
+    {
+        unvisited,
+        visiting,
+        ordered,
+        cyclic
+    };
+
+    const String name;
+    Expression symbol;
+    double value;
+    int64 lastChange;
+    ScopedPointer<CompiledExpression> definition;
+    OrderState orderState;
+
+    JUCE_DECLARE_NON_COPYABLE (Slot)
+};
+
+//==============================================================================
+struct CompiledExpression::Compiler
+{
+    Compiler (CompiledExpression& o, SymbolTable& s) noexcept
+        : output (o), symbols (s), depth (0), maxDepth (0)
+    {
+    }
+
+    void compile (const Expression& e)
+    {
+        switch (e.getType())
+        {
+            case Expression::constantType:  addConstant (e.evaluate()); break;
+            case Expression::symbolType:    addSlot (e.getSymbolOrFunction(), e); break;
+            case Expression::functionType:  compileFunction (e); break;
+            case Expression::operatorType:  compileOperator (e); break;
+            default:                        jassertfalse; break;
+        }
+    }
+
+    CompiledExpression& output;
+    SymbolTable& symbols;
+    int depth, maxDepth;
+
+private:
+    void compileOperator (const Expression& e)
+    {
+        const String op (e.getSymbolOrFunction());
+
+        // A reference into another scope can't be resolved against the table, so the
+        // whole thing gets a slot of its own, named by its text.
+        if (op == ".")
+        {
+            addSlot (e.toString(), e);
+            return;
+        }
+
+        const int numInputs = e.getNumInputs();
+
+        for (int i = 0; i < numInputs; ++i)
+            compile (e.getInput (i));
+
+        if (numInputs == 1)
+        {
+            jassert (op == "-");
+            addOperation (Instruction::negate, 1);
+            return;
+        }
+
+        jassert (numInputs == 2);
+
+        if      (op == "+")  addOperation (Instruction::add, 2);
+        else if (op == "-")  addOperation (Instruction::subtract, 2);
+        else if (op == "*")  addOperation (Instruction::multiply, 2);
+        else if (op == "/")  addOperation (Instruction::divide, 2);
+        else                 jassertfalse;
+    }
+
+    void compileFunction (const Expression& e)
+    {
+        const int numParams = e.getNumInputs();
+
+        for (int i = 0; i < numParams; ++i)
+            compile (e.getInput (i));
+
+        // (functions are left to the scope at evaluation time, so they're never folded)
+        const String name (e.getSymbolOrFunction());
+        output.functionNames.addIfNotAlreadyThere (name);
+
+        output.code.add (Instruction (Instruction::callFunction, output.functionNames.indexOf (name), numParams));
+        depth -= numParams;
+        push();
+    }
+
+    void addConstant (const double value)
+    {
+        output.code.add (Instruction (Instruction::pushConstant, output.constants.size(), 0));
+        output.constants.add (value);
+        push();
+    }
+
+    void addSlot (const String& name, const Expression& symbol)
+    {
+        const int slot = symbols.getSlot (name, symbol);
+
+        if (! output.inputSlots.contains (slot))
+            output.inputSlots.addUsingDefaultSort (slot);
+
+        output.code.add (Instruction (Instruction::pushSlot, slot, 0));
+        push();
+    }
+
+    void addOperation (const Instruction::Type type, const int numOperands)
+    {
+        if (operandsAreConstant (numOperands))
+        {
+            const int numConstants = output.constants.size();
+            const double lhs = output.constants.getUnchecked (numConstants - numOperands);
+            const double rhs = output.constants.getUnchecked (numConstants - 1);
+
+            output.code.removeLast (numOperands);
+            output.constants.removeLast (numOperands);
+            depth -= numOperands;
+
+            addConstant (perform (type, lhs, rhs));
+            return;
+        }
+
+        output.code.add (Instruction (type, 0, numOperands));
+        depth -= numOperands - 1;
+    }
+
+    bool operandsAreConstant (const int numOperands) const noexcept
+    {
+        const int size = output.code.size();
+
+        if (size < numOperands)
+            return false;
+
+        for (int i = size - numOperands; i < size; ++i)
+            if (output.code.getReference (i).type != Instruction::pushConstant)
+                return false;
+
+        return true;
+    }
+
+    static double perform (const Instruction::Type type, const double lhs, const double rhs) noexcept
+    {
+        switch (type)
+        {
+            case Instruction::add:       return lhs + rhs;
+            case Instruction::subtract:  return lhs - rhs;
+            case Instruction::multiply:  return lhs * rhs;
+            case Instruction::divide:    return lhs / rhs;
+            case Instruction::negate:    return -lhs;
+            default:                     jassertfalse; return 0;
+        }
+    }
+
+    void push() noexcept
+    {
+        maxDepth = jmax (maxDepth, ++depth);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Compiler)
+};
+
+//==============================================================================
+CompiledExpression::CompiledExpression()
+    : stackSize (0), lastResult (0), lastEvaluation (0)
+{
+}
+
+CompiledExpression::CompiledExpression (const Expression& expression, SymbolTable& symbols)
+    : lastResult (0), lastEvaluation (0)
+{
+    Compiler compiler (*this, symbols);
+    compiler.compile (expression);
+
+    jassert (compiler.depth == 1);
+    stackSize = compiler.maxDepth;
+    stack.malloc ((size_t) stackSize);
+}
+
+CompiledExpression::CompiledExpression (const CompiledExpression& other)
+    : code (other.code), constants (other.constants), functionNames (other.functionNames),
+      inputSlots (other.inputSlots), stack ((size_t) other.stackSize), stackSize (other.stackSize),
+      lastResult (other.lastResult), lastEvaluation (other.lastEvaluation)
+{
+}
+
+CompiledExpression& CompiledExpression::operator= (const CompiledExpression& other)
+{
+    code = other.code;
+    constants = other.constants;
+    functionNames = other.functionNames;
+    inputSlots = other.inputSlots;
+    stackSize = other.stackSize;
+    stack.malloc ((size_t) stackSize);
+    lastResult = other.lastResult;
+    lastEvaluation = other.lastEvaluation;
+    return *this;
+}
+
+CompiledExpression::~CompiledExpression()
+{
+}
+
+//==============================================================================
+bool CompiledExpression::isConstant() const noexcept
+{
+    return code.size() == 1 && code.getReference (0).type == Instruction::pushConstant;
+}
+
+bool CompiledExpression::needsEvaluation (const SymbolTable& symbols) const noexcept
+{
+    if (lastEvaluation == 0)
+        return true;
+
+    if (lastEvaluation == symbols.changeCount)
+        return false;
+
+    for (const int* i = inputSlots.begin(), * const e = inputSlots.end(); i != e; ++i)
+        if (symbols.slots.getUnchecked (*i)->lastChange > lastEvaluation)
+            return true;
+
+    return false;
+}
+
+double CompiledExpression::evaluate (const SymbolTable& symbols)
+{
+    return evaluate (symbols, Expression::Scope());
+}
+
+double CompiledExpression::evaluate (const SymbolTable& symbols, const Expression::Scope& functionScope)
+{
+    String error;
+    return evaluate (symbols, functionScope, error);
+}
+
+double CompiledExpression::evaluate (const SymbolTable& symbols, const Expression::Scope& functionScope, String& evaluationError)
+{
+    if (! needsEvaluation (symbols))
+        return lastResult;
+
+    try
+    {
+        lastResult = run (symbols, functionScope);
+    }
+    catch (Expression::Helpers::EvaluationError& e)
+    {
+        evaluationError = e.description;
+        lastResult = 0;
+    }
+
+    lastEvaluation = symbols.changeCount;
+    return lastResult;
+}
+
+double CompiledExpression::run (const SymbolTable& symbols, const Expression::Scope& functionScope)
+{
+    if (code.size() == 0)
+        return 0;
+
+    double* sp = stack;
+
+    for (const Instruction* i = code.begin(), * const e = code.end(); i != e; ++i)
+    {
+        switch (i->type)
+        {
+            case Instruction::pushConstant:  *sp++ = constants.getUnchecked (i->index); break;
+            case Instruction::pushSlot:      *sp++ = symbols.slots.getUnchecked (i->index)->value; break;
+            case Instruction::add:           --sp; sp[-1] += sp[0]; break;
+            case Instruction::subtract:      --sp; sp[-1] -= sp[0]; break;
+            case Instruction::multiply:      --sp; sp[-1] *= sp[0]; break;
+            case Instruction::divide:        --sp; sp[-1] /= sp[0]; break;
+            case Instruction::negate:        sp[-1] = -sp[-1]; break;
+
+            case Instruction::callFunction:
+                sp -= i->numParameters;
+                *sp = functionScope.evaluateFunction (functionNames[i->index], sp, i->numParameters);
+                ++sp;
+                break;
+
+            default:
+                jassertfalse;
+                break;
+        }
+    }
+
+    jassert (sp == stack + 1);
+    return stack[0];
+}
+
+//==============================================================================
+CompiledExpression::SymbolTable::SymbolTable()
+    : changeCount (1), definitionOrderNeedsRebuilding (false)
+{
+}
+
+CompiledExpression::SymbolTable::~SymbolTable()
+{
+}
+
+int CompiledExpression::SymbolTable::getSlot (const String& symbolName)
+{
+    const int existing = indexOf (symbolName);
+
+    if (existing >= 0)
+        return existing;
+
+    const int index = slots.size();
+    slots.add (new Slot (symbolName, Expression::symbol (symbolName), changeCount));
+    slotIndexes.set (symbolName, index);
+    return index;
+}
+
+int CompiledExpression::SymbolTable::getSlot (const String& symbolName, const Expression& symbol)
+{
+    const int index = getSlot (symbolName);
+
+    // (a slot that was created by name can't know whether a dotted name refers to
+    // another scope, so it takes the term that the compiler found)
+    slots.getUnchecked (index)->symbol = symbol;
+    return index;
+}
+
+int CompiledExpression::SymbolTable::indexOf (const String& symbolName) const
+{
+    return slotIndexes.contains (symbolName) ? slotIndexes [symbolName] : -1;
+}
+
+const String& CompiledExpression::SymbolTable::getName (const int slot) const noexcept
+{
+    jassert (isPositiveAndBelow (slot, slots.size()));
+    return slots.getUnchecked (slot)->name;
+}
+
+double CompiledExpression::SymbolTable::getValue (const int slot) const noexcept
+{
+    jassert (isPositiveAndBelow (slot, slots.size()));
+    return slots.getUnchecked (slot)->value;
+}
+
+void CompiledExpression::SymbolTable::setValue (const int slot, const double newValue) noexcept
+{
+    jassert (isPositiveAndBelow (slot, slots.size()));
+    Slot& s = *slots.getUnchecked (slot);
+
+    if (s.value != newValue)
+    {
+        s.value = newValue;
+        s.lastChange = ++changeCount;
+    }
+}
+
+void CompiledExpression::SymbolTable::setValue (const String& symbolName, const double newValue)
+{
+    setValue (getSlot (symbolName), newValue);
+}
+
+void CompiledExpression::SymbolTable::updateFromScope (const Expression::Scope& scope, String* evaluationError)
+{
+    for (int i = 0; i < slots.size(); ++i)
+    {
+        Slot& s = *slots.getUnchecked (i);
+
+        if (s.definition == nullptr)
+        {
+            String error;
+            setValue (i, s.symbol.evaluate (scope, error));
+
+            if (evaluationError != nullptr && evaluationError->isEmpty())
+                *evaluationError = error;
+        }
+    }
+}
+
+//==============================================================================
+void CompiledExpression::SymbolTable::setDefinition (const int slot, const Expression& definition)
+{
+    jassert (isPositiveAndBelow (slot, slots.size()));
+
+    // (compiling may add new slots, but they're owned, so the slot itself doesn't move)
+    Slot& s = *slots.getUnchecked (slot);
+    s.definition = new CompiledExpression (definition, *this);
+    definitionOrderNeedsRebuilding = true;
+}
+
+void CompiledExpression::SymbolTable::removeDefinition (const int slot)
+{
+    jassert (isPositiveAndBelow (slot, slots.size()));
+    slots.getUnchecked (slot)->definition = nullptr;
+    definitionOrderNeedsRebuilding = true;
+}
+
+bool CompiledExpression::SymbolTable::hasDefinition (const int slot) const noexcept
+{
+    return isPositiveAndBelow (slot, slots.size()) && slots.getUnchecked (slot)->definition != nullptr;
+}
+
+void CompiledExpression::SymbolTable::update()
+{
+    update (Expression::Scope());
+}
+
+void CompiledExpression::SymbolTable::update (const Expression::Scope& functionScope)
+{
+    if (definitionOrderNeedsRebuilding)
+        rebuildDefinitionOrder();
+
+    for (const int* i = definitionOrder.begin(), * const e = definitionOrder.end(); i != e; ++i)
+    {
+        CompiledExpression& definition = *slots.getUnchecked (*i)->definition;
+
+        if (definition.needsEvaluation (*this))
+            setValue (*i, definition.evaluate (*this, functionScope));
+    }
+}
+
+void CompiledExpression::SymbolTable::rebuildDefinitionOrder()
+{
+    definitionOrderNeedsRebuilding = false;
+    definitionOrder.clearQuick();
+
+    for (int i = 0; i < slots.size(); ++i)
+        slots.getUnchecked (i)->orderState = Slot::unvisited;
+
+    for (int i = 0; i < slots.size(); ++i)
+        addToDefinitionOrder (i);
+
+    for (int i = 0; i < slots.size(); ++i)
+    {
+        if (slots.getUnchecked (i)->orderState == Slot::cyclic)
+        {
+            jassertfalse; // This slot's definition refers back to itself!
+            setValue (i, 0);
+        }
+    }
+}
+
+bool CompiledExpression::SymbolTable::addToDefinitionOrder (const int slot)
+{
+    Slot& s = *slots.getUnchecked (slot);
+
+    if (s.definition == nullptr || s.orderState == Slot::ordered)
+        return true;
+
+    if (s.orderState != Slot::unvisited)
+        return false;
+
+    s.orderState = Slot::visiting;
+    bool isValid = true;
+
+    const Array<int>& inputs = s.definition->getInputSlots();
+
+    for (int i = 0; i < inputs.size(); ++i)
+        isValid = addToDefinitionOrder (inputs.getUnchecked (i)) && isValid;
+
+    if (isValid)
+    {
+        s.orderState = Slot::ordered;
+        definitionOrder.add (slot);
+    }
+    else
+    {
+        s.orderState = Slot::cyclic;
+    }
+
+    return isValid;
+}
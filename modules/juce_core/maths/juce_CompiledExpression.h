@@ -0,0 +1,237 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_COMPILEDEXPRESSION_H_INCLUDED
+#define JUCE_COMPILEDEXPRESSION_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A pre-processed form of an Expression, which can be evaluated repeatedly much more
+    quickly than the original.
+
+    When an Expression is evaluated, it walks its tree of terms and looks up each symbol
+    by name through its Scope, every time. A CompiledExpression does that work once: each
+    symbol is bound to a numbered slot in a SymbolTable, and the tree is flattened into a
+    short list of stack-machine instructions, with any constant sub-expressions folded.
+
+    It also keeps track of which slots it reads, and caches its last result, so that
+    re-evaluating it when none of its inputs have changed just returns the cached value.
+
+    e.g. @code
+    CompiledExpression::SymbolTable symbols;
+    CompiledExpression width (Expression ("right - left"), symbols);
+
+    symbols.setValue ("left", 10.0);
+    symbols.setValue ("right", 100.0);
+    double w = width.evaluate (symbols);   // 90
+    @endcode
+
+    Symbols that refer to another scope, e.g. "parent.left", are bound to a slot as a whole,
+    so their values have to be supplied with SymbolTable::setValue() or fetched with
+    SymbolTable::updateFromScope().
+
+    @see Expression
+*/
+class JUCE_API  CompiledExpression
+{
+public:
+    //==============================================================================
+    /**
+        Holds the values of the symbols used by a set of CompiledExpressions.
+
+        Each symbol name gets a slot, which the expressions compiled against this table refer
+        to by index. A slot can either hold a value that you set directly, or be defined by
+        an expression that uses other slots, in which case update() will recalculate it when
+        any of its inputs change.
+
+        The table records when each slot last changed, which is what lets a CompiledExpression
+        tell whether its cached result is still valid. An expression must only be evaluated
+        with the table that it was compiled against.
+    */
+    class JUCE_API  SymbolTable
+    {
+    public:
+        /** Creates an empty table. */
+        SymbolTable();
+
+        /** Destructor. */
+        ~SymbolTable();
+
+        //==============================================================================
+        /** Returns the slot for a symbol, adding a new one with a value of 0 if needed. */
+        int getSlot (const String& symbolName);
+
+        /** Returns the slot for a symbol, or -1 if it isn't in the table. */
+        int indexOf (const String& symbolName) const;
+
+        /** Returns the number of slots in the table. */
+        int size() const noexcept                           { return slots.size(); }
+
+        /** Returns the name of the symbol in a slot. */
+        const String& getName (int slot) const noexcept;
+
+        /** Returns the current value of a slot. */
+        double getValue (int slot) const noexcept;
+
+        /** Changes the value of a slot.
+            The slot is only marked as changed if the new value is actually different.
+        */
+        void setValue (int slot, double newValue) noexcept;
+
+        /** Changes the value of a symbol, adding a slot for it if needed. */
+        void setValue (const String& symbolName, double newValue);
+
+        /** Refreshes all the slots that don't have a definition by evaluating their symbols
+            through a Scope.
+
+            This lets you use the table with an existing Expression::Scope. Any symbols
+            that the scope can't resolve are set to 0, and the first error is returned in
+            evaluationError, if it's not null.
+        */
+        void updateFromScope (const Expression::Scope& scope, String* evaluationError = nullptr);
+
+        //==============================================================================
+        /** Makes a slot's value follow an expression.
+
+            The expression is compiled against this table, and its value is copied into the
+            slot by update(). Definitions may refer to other defined slots, but not to
+            themselves, directly or indirectly - slots that are part of a cycle are set to 0.
+        */
+        void setDefinition (int slot, const Expression& definition);
+
+        /** Removes a slot's definition, leaving it with its current value. */
+        void removeDefinition (int slot);
+
+        /** Returns true if the slot's value is calculated from an expression. */
+        bool hasDefinition (int slot) const noexcept;
+
+        /** Recalculates any defined slots whose inputs have changed since the last update.
+
+            The definitions are evaluated in dependency order, so a single call brings the whole
+            table up to date, and a definition whose result doesn't change won't cause the ones
+            that depend on it to be evaluated again.
+
+            @param functionScope    used to evaluate any functions that the definitions call
+        */
+        void update (const Expression::Scope& functionScope);
+
+        /** Recalculates any defined slots whose inputs have changed, using only the standard
+            functions such as min, max, sin, cos, tan and abs.
+        */
+        void update();
+
+    private:
+        //==============================================================================
+        friend class CompiledExpression;
+        struct Slot;
+        OwnedArray<Slot> slots;
+        HashMap<String, int> slotIndexes;
+        Array<int> definitionOrder;
+        int64 changeCount;
+        bool definitionOrderNeedsRebuilding;
+
+        int getSlot (const String& symbolName, const Expression& symbol);
+        void rebuildDefinitionOrder();
+        bool addToDefinitionOrder (int slot);
+
+        JUCE_DECLARE_NON_COPYABLE (SymbolTable)
+    };
+
+    //==============================================================================
+    /** Creates an empty expression, which evaluates to 0. */
+    CompiledExpression();
+
+    /** Compiles an expression, binding all of its symbols to slots in the given table. */
+    CompiledExpression (const Expression& expression, SymbolTable& symbols);
+
+    /** Creates a copy of another compiled expression. */
+    CompiledExpression (const CompiledExpression&);
+
+    /** Copies another compiled expression. */
+    CompiledExpression& operator= (const CompiledExpression&);
+
+    /** Destructor. */
+    ~CompiledExpression();
+
+    //==============================================================================
+    /** Evaluates the expression, using the values in the table that it was compiled against.
+
+        If none of the slots that it uses have changed since the last time it was evaluated,
+        the cached result is returned. Functions are evaluated with the standard set provided
+        by the base Expression::Scope class, and any errors give a result of 0.
+    */
+    double evaluate (const SymbolTable& symbols);
+
+    /** Evaluates the expression, using a scope to perform any function calls.
+
+        Function results are assumed to depend only on their parameters, so if the scope's
+        functions change their behaviour, call invalidate() to stop a stale result being used.
+    */
+    double evaluate (const SymbolTable& symbols, const Expression::Scope& functionScope);
+
+    /** Evaluates the expression, returning a description of any error in evaluationError. */
+    double evaluate (const SymbolTable& symbols, const Expression::Scope& functionScope, String& evaluationError);
+
+    /** Returns true if one of the expression's inputs has changed since it was last evaluated,
+        so that calling evaluate() would need to run the expression again.
+    */
+    bool needsEvaluation (const SymbolTable& symbols) const noexcept;
+
+    /** Discards the cached result, so that the next call to evaluate() will run the expression. */
+    void invalidate() noexcept                          { lastEvaluation = 0; }
+
+    /** Returns the slots that this expression reads, in ascending order. */
+    const Array<int>& getInputSlots() const noexcept    { return inputSlots; }
+
+    /** Returns true if the expression calls any functions. */
+    bool usesFunctions() const noexcept                 { return functionNames.size() > 0; }
+
+    /** Returns true if the expression has been folded down to a constant value. */
+    bool isConstant() const noexcept;
+
+private:
+    //==============================================================================
+    struct Instruction;
+    struct Compiler;
+    Array<Instruction> code;
+    Array<double> constants;
+    StringArray functionNames;
+    Array<int> inputSlots;
+    HeapBlock<double> stack;
+    int stackSize;
+    double lastResult;
+    int64 lastEvaluation;
+
+    double run (const SymbolTable&, const Expression::Scope&);
+
+    JUCE_LEAK_DETECTOR (CompiledExpression)
+};
+
+
+#endif   // JUCE_COMPILEDEXPRESSION_H_INCLUDED
@@ -260,6 +260,7 @@ private:
     struct Helpers;
     friend class Term;
     friend struct Helpers;
+    friend class CompiledExpression;
     friend struct ContainerDeletePolicy<Term>;
     friend class ReferenceCountedObjectPtr<Term>;
     ReferenceCountedObjectPtr<Term> term;
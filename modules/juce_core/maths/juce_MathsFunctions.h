@@ -596,6 +596,29 @@ namespace TypeHelpers
     */
     template <typename Type> struct SmallestFloatType             { typedef float  type; };
     template <>              struct SmallestFloatType <double>    { typedef double type; };
+
+    /** Tells the array classes whether objects of a type can be moved to a different
+        address just by copying their bytes, rather than by move-constructing a new object
+        and destroying the old one.
+
+        This is true for any type with a trivial copy constructor and destructor, and the
+        classes that are commonly kept in arrays, like String and var, also declare themselves
+        relocatable with JUCE_DECLARE_TRIVIALLY_RELOCATABLE, because although they aren't
+        trivial, they never hold pointers to themselves. You can do the same for your own
+        classes, to let arrays of them be shifted and reallocated with memmove.
+    */
+   #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+    template <typename Type> struct IsTriviallyRelocatable        { enum { value = __has_trivial_copy (Type) && __has_trivial_destructor (Type) }; };
+   #else
+    template <typename Type> struct IsTriviallyRelocatable        { enum { value = true }; };
+   #endif
+
+    /** Specialises TypeHelpers::IsTriviallyRelocatable for a class.
+        This must be used inside the juce namespace, after the class has been declared.
+        @see TypeHelpers::IsTriviallyRelocatable
+    */
+    #define JUCE_DECLARE_TRIVIALLY_RELOCATABLE(Type) \
+        namespace TypeHelpers { template <> struct IsTriviallyRelocatable<Type> { enum { value = true }; }; }
 }
 
 
@@ -255,7 +255,7 @@ public:
     void realloc (const size_t newNumElements, const size_t elementSize = sizeof (ElementType))
     {
         data = static_cast <ElementType*> (data == nullptr ? std::malloc (newNumElements * elementSize)
-                                                           : std::realloc (data, newNumElements * elementSize));
+                                                           : std::realloc (static_cast<void*> (data), newNumElements * elementSize));
         throwOnAllocationFailure();
     }
 
@@ -295,6 +295,9 @@ private:
 
     void throwOnAllocationFailure() const
     {
+        // (this follows every allocation, so it's also where allocating on an audio thread is caught)
+        JUCE_ASSERT_NOT_REALTIME ("HeapBlock allocation");
+
         HeapBlockHelper::ThrowOnFail<throwOnFailure>::check (data);
     }
 
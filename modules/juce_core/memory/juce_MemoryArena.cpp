@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+struct MemoryArena::Block
+{
+    Block (const size_t numBytes)  : size (numBytes), numUsed (0)
+    {
+        data.malloc (numBytes);
+    }
+
+    HeapBlock<char> data;
+    const size_t size;
+    size_t numUsed;
+
+    JUCE_DECLARE_NON_COPYABLE (Block)
+};
+
+MemoryArena::MemoryArena (const size_t sizeOfEachBlock)
+    : currentBlock (0), blockSize (jmax ((size_t) 256, sizeOfEachBlock)), destructors (nullptr)
+{
+}
+
+MemoryArena::~MemoryArena()
+{
+    reset();
+}
+
+void* MemoryArena::allocateFromCurrentBlock (const size_t numBytes, const size_t alignment) noexcept
+{
+    Block& b = *blocks.getUnchecked (currentBlock);
+
+    const pointer_sized_uint base = (pointer_sized_uint) b.data.getData();
+    const pointer_sized_uint start = (base + b.numUsed + alignment - 1) & ~(pointer_sized_uint) (alignment - 1);
+    const size_t newNumUsed = (size_t) (start - base) + numBytes;
+
+    if (newNumUsed > b.size)
+        return nullptr;
+
+    b.numUsed = newNumUsed;
+    return (void*) start;
+}
+
+void* MemoryArena::allocate (const size_t numBytes, const size_t alignment)
+{
+    // the alignment must be a power of two!
+    jassert (alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    for (; currentBlock < blocks.size(); ++currentBlock)
+        if (void* const result = allocateFromCurrentBlock (numBytes, alignment))
+            return result;
+
+    blocks.add (new Block (jmax (blockSize, numBytes + alignment)));
+    currentBlock = blocks.size() - 1;
+
+    void* const result = allocateFromCurrentBlock (numBytes, alignment);
+    jassert (result != nullptr);
+    return result;
+}
+
+void MemoryArena::reset()
+{
+    for (Destructor* d = destructors; d != nullptr; d = d->next)
+        d->destroy (d->object);
+
+    destructors = nullptr;
+
+    for (int i = blocks.size(); --i >= 0;)
+        blocks.getUnchecked (i)->numUsed = 0;
+
+    currentBlock = 0;
+}
+
+void MemoryArena::reserve (const size_t numBytes)
+{
+    for (int i = currentBlock; i < blocks.size(); ++i)
+    {
+        const Block& b = *blocks.getUnchecked (i);
+
+        if (b.size - b.numUsed >= numBytes + defaultAlignment)
+            return;
+    }
+
+    blocks.add (new Block (jmax (blockSize, numBytes + defaultAlignment)));
+}
+
+size_t MemoryArena::getNumBytesUsed() const noexcept
+{
+    size_t total = 0;
+
+    for (int i = 0; i <= currentBlock && i < blocks.size(); ++i)
+        total += blocks.getUnchecked (i)->numUsed;
+
+    return total;
+}
+
+size_t MemoryArena::getTotalSize() const noexcept
+{
+    size_t total = 0;
+
+    for (int i = 0; i < blocks.size(); ++i)
+        total += blocks.getUnchecked (i)->size;
+
+    return total;
+}
@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_MEMORYARENA_H_INCLUDED
+#define JUCE_MEMORYARENA_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A region of memory that objects can be allocated from very quickly, and which
+    frees them all in one go.
+
+    Each allocation just moves a pointer along the current block, so it's much faster
+    than malloc, and there's no per-object overhead. You can't free individual objects:
+    instead, reset() destroys everything that was created in the arena at once, and
+    keeps the memory so that it can be used again.
+
+    This makes it a good fit for things like building a temporary data structure while
+    parsing a document, or for audio-thread code that needs to create some objects for
+    each block: if you call reserve() beforehand (or just let the arena grow during the
+    first few blocks), then later allocations never touch the system allocator.
+
+    @code
+    MemoryArena arena;
+
+    for (;;)
+    {
+        Node* n = arena.create<Node> (someValue);
+        ...
+        arena.reset();  // deletes all the nodes, but keeps their memory
+    }
+    @endcode
+
+    This class isn't thread-safe, so each thread that uses one should have its own.
+
+    @see ObjectPool, HeapBlock
+*/
+class JUCE_API  MemoryArena
+{
+public:
+    //==============================================================================
+    /** Creates an empty arena.
+        @param blockSize    the size of each block of memory that the arena allocates when
+                            it needs more space. Allocations bigger than this get a block
+                            of their own.
+    */
+    explicit MemoryArena (size_t blockSize = 65536);
+
+    /** Destructor.
+        This destroys any objects that were created in the arena with create().
+    */
+    ~MemoryArena();
+
+    //==============================================================================
+    /** Returns some uninitialised memory from the arena.
+        The memory stays valid until reset() is called or the arena is deleted.
+        @param numBytes     the number of bytes needed
+        @param alignment    the alignment of the result, which must be a power of two
+    */
+    void* allocate (size_t numBytes, size_t alignment = defaultAlignment);
+
+    /** Creates an object in the arena, using its default constructor.
+        Its destructor will be called when the arena is reset or deleted.
+    */
+    template <class ObjectType>
+    ObjectType* create()
+    {
+        return addDestructor (new (allocate (sizeof (ObjectType))) ObjectType());
+    }
+
+    /** Creates an object in the arena, passing an argument to its constructor.
+        Its destructor will be called when the arena is reset or deleted.
+    */
+    template <class ObjectType, typename Arg1>
+    ObjectType* create (const Arg1& arg1)
+    {
+        return addDestructor (new (allocate (sizeof (ObjectType))) ObjectType (arg1));
+    }
+
+    /** Creates an object in the arena, passing some arguments to its constructor.
+        Its destructor will be called when the arena is reset or deleted.
+    */
+    template <class ObjectType, typename Arg1, typename Arg2>
+    ObjectType* create (const Arg1& arg1, const Arg2& arg2)
+    {
+        return addDestructor (new (allocate (sizeof (ObjectType))) ObjectType (arg1, arg2));
+    }
+
+    /** Creates an object in the arena, passing some arguments to its constructor.
+        Its destructor will be called when the arena is reset or deleted.
+    */
+    template <class ObjectType, typename Arg1, typename Arg2, typename Arg3>
+    ObjectType* create (const Arg1& arg1, const Arg2& arg2, const Arg3& arg3)
+    {
+        return addDestructor (new (allocate (sizeof (ObjectType))) ObjectType (arg1, arg2, arg3));
+    }
+
+    //==============================================================================
+    /** Destroys all the objects that were created in the arena, and makes all of its
+        memory available to be used again.
+        None of the memory is freed, so after a reset, the arena can provide as much as it
+        did before without allocating.
+    */
+    void reset();
+
+    /** Makes sure that the arena can provide at least this many bytes (in a single
+        allocation) without needing to allocate any more memory.
+    */
+    void reserve (size_t numBytes);
+
+    /** Returns the number of bytes that have been allocated from the arena since it was
+        created or last reset, including any padding that was needed for alignment.
+    */
+    size_t getNumBytesUsed() const noexcept;
+
+    /** Returns the total size of the memory blocks that the arena has allocated. */
+    size_t getTotalSize() const noexcept;
+
+    /** The alignment that's used by create(), and by default for allocate(). */
+    enum { defaultAlignment = 16 };
+
+private:
+    //==============================================================================
+    struct Block;
+    friend struct ContainerDeletePolicy<Block>;
+
+    struct Destructor
+    {
+        Destructor* next;
+        void* object;
+        void (*destroy) (void*);
+    };
+
+    OwnedArray<Block> blocks;
+    int currentBlock;
+    const size_t blockSize;
+    Destructor* destructors;
+
+    template <class ObjectType>
+    static void destroyObject (void* object)    { static_cast<ObjectType*> (object)->~ObjectType(); }
+
+    template <class ObjectType>
+    ObjectType* addDestructor (ObjectType* object)
+    {
+        Destructor* const d = static_cast<Destructor*> (allocate (sizeof (Destructor)));
+        d->next = destructors;
+        d->object = object;
+        d->destroy = destroyObject<ObjectType>;
+        destructors = d;
+        return object;
+    }
+
+    void* allocateFromCurrentBlock (size_t numBytes, size_t alignment) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryArena)
+};
+
+
+#endif   // JUCE_MEMORYARENA_H_INCLUDED
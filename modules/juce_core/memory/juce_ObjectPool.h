@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_OBJECTPOOL_H_INCLUDED
+#define JUCE_OBJECTPOOL_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Creates and deletes objects of one type using a free-list of pre-allocated slots.
+
+    The pool allocates its memory in chunks that hold a number of objects, and reuses
+    the space of each released object for the next one that's created. Once the pool
+    has grown to the number of objects that you need (or you've called reserve()), creating
+    and releasing objects is just a matter of popping and pushing a pointer, so it's
+    deterministic enough for the audio thread.
+
+    @code
+    ObjectPool<Voice> voicePool;
+    voicePool.reserve (128);   // (do this before playback starts)
+
+    Voice* v = voicePool.create();
+    ...
+    voicePool.release (v);
+    @endcode
+
+    The TypeOfCriticalSectionToUse parameter works in the same way as it does for the
+    Array class: by default the pool isn't thread-safe, and the cheapest way to use it
+    from several threads is to give each thread its own pool (e.g. with a ThreadLocalValue),
+    making sure that every object is released to the pool it came from.
+
+    Note that the slots are aligned for any of the built-in types, but not for types that
+    need a larger alignment, such as SIMD vectors.
+
+    @see MemoryArena, ThreadLocalValue
+*/
+template <class ObjectType, class TypeOfCriticalSectionToUse = DummyCriticalSection>
+class ObjectPool
+{
+public:
+    //==============================================================================
+    /** Creates an empty pool.
+        @param objectsPerChunk  the number of slots that the pool allocates each time it runs out
+    */
+    explicit ObjectPool (int objectsPerChunk = 64) noexcept
+        : numObjectsPerChunk (jmax (1, objectsPerChunk)), firstFreeSlot (nullptr), numFreeSlots (0), numInUse (0)
+    {
+    }
+
+    /** Destructor.
+        All the objects that were created by the pool must have been released before it's deleted.
+    */
+    ~ObjectPool()
+    {
+        // If you hit this, some objects are still alive, and their memory is about to be freed!
+        jassert (numInUse == 0);
+    }
+
+    //==============================================================================
+    /** Creates an object using its default constructor. */
+    ObjectType* create()
+    {
+        return new (allocateSlot()) ObjectType();
+    }
+
+    /** Creates an object, passing an argument to its constructor. */
+    template <typename Arg1>
+    ObjectType* create (const Arg1& arg1)
+    {
+        return new (allocateSlot()) ObjectType (arg1);
+    }
+
+    /** Creates an object, passing some arguments to its constructor. */
+    template <typename Arg1, typename Arg2>
+    ObjectType* create (const Arg1& arg1, const Arg2& arg2)
+    {
+        return new (allocateSlot()) ObjectType (arg1, arg2);
+    }
+
+    /** Creates an object, passing some arguments to its constructor. */
+    template <typename Arg1, typename Arg2, typename Arg3>
+    ObjectType* create (const Arg1& arg1, const Arg2& arg2, const Arg3& arg3)
+    {
+        return new (allocateSlot()) ObjectType (arg1, arg2, arg3);
+    }
+
+    /** Destroys an object that was created by this pool, and makes its slot available
+        for the next object. It's ok to pass a nullptr.
+    */
+    void release (ObjectType* const object)
+    {
+        if (object != nullptr)
+        {
+            object->~ObjectType();
+
+            const ScopedLockType sl (lock);
+            jassert (numInUse > 0);
+
+            Slot* const slot = reinterpret_cast<Slot*> (object);
+            slot->nextFree = firstFreeSlot;
+            firstFreeSlot = slot;
+            ++numFreeSlots;
+            --numInUse;
+        }
+    }
+
+    //==============================================================================
+    /** Makes sure that this many objects can be created without the pool needing to
+        allocate any more memory.
+    */
+    void reserve (const int numObjects)
+    {
+        const ScopedLockType sl (lock);
+
+        if (numObjects > numFreeSlots)
+            addChunk (jmax (numObjectsPerChunk, numObjects - numFreeSlots));
+    }
+
+    /** Returns the number of objects that have been created and not yet released. */
+    int getNumObjectsInUse() const noexcept                     { return numInUse; }
+
+    /** Returns the number of objects that can be created before the pool needs more memory. */
+    int getNumFreeSlots() const noexcept                        { return numFreeSlots; }
+
+    //==============================================================================
+    /** Returns the CriticalSection that locks this pool. */
+    inline const TypeOfCriticalSectionToUse& getLock() const noexcept       { return lock; }
+
+    /** Returns the type of scoped lock to use for locking this pool */
+    typedef typename TypeOfCriticalSectionToUse::ScopedLockType ScopedLockType;
+
+private:
+    //==============================================================================
+    union Slot
+    {
+        Slot* nextFree;
+        char object [sizeof (ObjectType)];
+
+        // (these make sure that the slot is aligned for any of the built-in types)
+        double alignmentDouble;
+        int64 alignmentInt64;
+    };
+
+    struct Chunk
+    {
+        Chunk (const int numSlots)  : slots ((size_t) numSlots) {}
+        HeapBlock<Slot> slots;
+    };
+
+    OwnedArray<Chunk> chunks;
+    const int numObjectsPerChunk;
+    Slot* firstFreeSlot;
+    int numFreeSlots, numInUse;
+    TypeOfCriticalSectionToUse lock;
+
+    void* allocateSlot()
+    {
+        const ScopedLockType sl (lock);
+
+        if (firstFreeSlot == nullptr)
+            addChunk (numObjectsPerChunk);
+
+        Slot* const slot = firstFreeSlot;
+        firstFreeSlot = slot->nextFree;
+        --numFreeSlots;
+        ++numInUse;
+        return slot->object;
+    }
+
+    void addChunk (const int numSlots)
+    {
+        Chunk* const chunk = chunks.add (new Chunk (numSlots));
+
+        for (int i = numSlots; --i >= 0;)
+        {
+            Slot* const slot = chunk->slots + i;
+            slot->nextFree = firstFreeSlot;
+            firstFreeSlot = slot;
+        }
+
+        numFreeSlots += numSlots;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (ObjectPool)
+};
+
+
+#endif   // JUCE_OBJECTPOOL_H_INCLUDED
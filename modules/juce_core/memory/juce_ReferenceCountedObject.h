@@ -367,6 +367,13 @@ private:
     }
 };
 
+#ifndef DOXYGEN
+namespace TypeHelpers
+{
+    template <class ObjectType> struct IsTriviallyRelocatable<ReferenceCountedObjectPtr<ObjectType> >  { enum { value = true }; };
+}
+#endif
+
 
 //==============================================================================
 /** Compares two ReferenceCountedObjectPointers. */
@@ -58,12 +58,18 @@
  #include <sys/mount.h>
  #include <sys/utsname.h>
  #include <sys/mman.h>
+ #include <sys/uio.h>
  #include <fnmatch.h>
  #include <utime.h>
  #include <dlfcn.h>
+ #include <spawn.h>
+ #include <crt_externs.h>
  #include <ifaddrs.h>
  #include <net/if_dl.h>
  #include <mach/mach_time.h>
+ #include <mach/mach_init.h>
+ #include <mach/thread_act.h>
+ #include <mach/thread_policy.h>
  #include <mach-o/dyld.h>
  #include <objc/runtime.h>
  #include <objc/objc.h>
@@ -174,7 +180,9 @@
  #include <sys/ptrace.h>
  #include <sys/vfs.h>
  #include <sys/wait.h>
+ #include <spawn.h>
  #include <sys/mman.h>
+ #include <sys/uio.h>
  #include <fnmatch.h>
  #include <utime.h>
  #include <pwd.h>
@@ -208,6 +216,7 @@
  #include <sys/ptrace.h>
  #include <sys/sysinfo.h>
  #include <sys/mman.h>
+ #include <sys/uio.h>
  #include <pwd.h>
  #include <dirent.h>
  #include <fnmatch.h>
@@ -68,7 +68,7 @@ JUCE_API bool JUCE_CALLTYPE Process::openEmailWithAttachments (const String& tar
 class WebInputStream  : public InputStream
 {
 public:
-    WebInputStream (String address, bool isPost, const MemoryBlock& postData,
+    WebInputStream (String address, bool isPost, MemoryBlock postData, InputStream* postDataStream,
                     URL::OpenStreamProgressCallback* progressCallback, void* progressCallbackContext,
                     const String& headers, int timeOutMs, StringPairArray* responseHeaders, const int numRedirectsToFollow)
         : statusCode (0)
@@ -76,6 +76,13 @@ public:
         if (! address.contains ("://"))
             address = "http://" + address;
 
+        // (the java side needs the whole body as one array, so a streamed body gets read in here)
+        if (postDataStream != nullptr)
+        {
+            const ScopedPointer<InputStream> source (postDataStream);
+            source->readIntoMemoryBlock (postData);
+        }
+
         JNIEnv* env = getEnv();
 
         jbyteArray postDataArray = 0;
@@ -118,7 +118,7 @@ public:
                 {
                     filenameFound = CharPointer_UTF8 (de->d_name);
 
-                    updateStatInfoForFile (parentDir + filenameFound, isDir, fileSize, modTime, creationTime, isReadOnly);
+                    updateStatInfoForEntry (de, isDir, fileSize, modTime, creationTime, isReadOnly);
 
                     if (isHidden != nullptr)
                         *isHidden = filenameFound.startsWithChar ('.');
@@ -135,6 +135,42 @@ private:
     String parentDir, wildCard;
     DIR* dir;
 
+    // The directory entry already says whether it's a directory, so unless the size or
+    // times are wanted, there's no need to stat it at all. When a stat is needed, it's
+    // done relative to the open directory, which avoids resolving the whole path again.
+    void updateStatInfoForEntry (const struct dirent* const de, bool* const isDir, int64* const fileSize,
+                                 Time* const modTime, Time* const creationTime, bool* const isReadOnly) const
+    {
+        const int dirFD = dirfd (dir);
+
+       #ifdef _DIRENT_HAVE_D_TYPE
+        if (fileSize == nullptr && modTime == nullptr && creationTime == nullptr
+             && de->d_type != DT_UNKNOWN && de->d_type != DT_LNK)
+        {
+            if (isDir != nullptr)
+                *isDir = (de->d_type == DT_DIR);
+        }
+        else
+       #endif
+        if (isDir != nullptr || fileSize != nullptr || modTime != nullptr || creationTime != nullptr)
+        {
+            juce_statStruct info;
+           #if JUCE_LINUX
+            const bool statOk = fstatat64 (dirFD, de->d_name, &info, 0) == 0;
+           #else
+            const bool statOk = fstatat (dirFD, de->d_name, &info, 0) == 0;
+           #endif
+
+            if (isDir != nullptr)         *isDir        = statOk && ((info.st_mode & S_IFDIR) != 0);
+            if (fileSize != nullptr)      *fileSize     = statOk ? (int64) info.st_size : 0;
+            if (modTime != nullptr)       *modTime      = Time (statOk ? (int64) info.st_mtime  * 1000 : 0);
+            if (creationTime != nullptr)  *creationTime = Time (statOk ? getCreationTime (info) * 1000 : 0);
+        }
+
+        if (isReadOnly != nullptr)
+            *isReadOnly = faccessat (dirFD, de->d_name, W_OK, 0) != 0;
+    }
+
     JUCE_DECLARE_NON_COPYABLE (Pimpl)
 };
 
@@ -68,16 +68,109 @@ bool JUCE_CALLTYPE Process::openEmailWithAttachments (const String& /* targetEma
 }
 
 
+//==============================================================================
+// When a response has been read to the end over a keep-alive connection, its socket is
+// put in here, so that the next request to the same server can skip the connection
+// handshake. Connections that have been idle for a while are closed.
+class IdleHTTPConnectionPool
+{
+public:
+    IdleHTTPConnectionPool() {}
+
+    ~IdleHTTPConnectionPool()
+    {
+        for (int i = entries.size(); --i >= 0;)
+            close (entries.getReference(i).socketHandle);
+    }
+
+    static IdleHTTPConnectionPool& getInstance()
+    {
+        static IdleHTTPConnectionPool pool;
+        return pool;
+    }
+
+    int takeConnection (const String& serverKey)
+    {
+        const ScopedLock sl (lock);
+        const uint32 now = Time::getMillisecondCounter();
+
+        for (int i = entries.size(); --i >= 0;)
+        {
+            const Entry& e = entries.getReference(i);
+
+            if (now - e.timeAdded > maxIdleTimeMs)
+            {
+                close (e.socketHandle);
+                entries.remove (i);
+            }
+            else if (e.serverKey == serverKey)
+            {
+                const int socketHandle = e.socketHandle;
+                entries.remove (i);
+
+                // (if the server has closed it, or sent something unexpected, it's no use)
+                if (isStillUsable (socketHandle))
+                    return socketHandle;
+
+                close (socketHandle);
+            }
+        }
+
+        return -1;
+    }
+
+    void addConnection (const String& serverKey, const int socketHandle)
+    {
+        const ScopedLock sl (lock);
+
+        if (entries.size() >= maxIdleConnections)
+        {
+            close (entries.getReference(0).socketHandle);
+            entries.remove (0);
+        }
+
+        const Entry e = { serverKey, socketHandle, Time::getMillisecondCounter() };
+        entries.add (e);
+    }
+
+private:
+    struct Entry
+    {
+        String serverKey;
+        int socketHandle;
+        uint32 timeAdded;
+    };
+
+    enum { maxIdleTimeMs = 15000, maxIdleConnections = 16 };
+
+    CriticalSection lock;
+    Array<Entry> entries;
+
+    static bool isStillUsable (const int socketHandle)
+    {
+        fd_set readbits;
+        FD_ZERO (&readbits);
+        FD_SET (socketHandle, &readbits);
+
+        struct timeval tv = { 0, 0 };
+        return select (socketHandle + 1, &readbits, 0, 0, &tv) == 0;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (IdleHTTPConnectionPool)
+};
+
 //==============================================================================
 class WebInputStream  : public InputStream
 {
 public:
     WebInputStream (const String& address_, bool isPost_, const MemoryBlock& postData_,
+                    InputStream* postDataStream_,
                     URL::OpenStreamProgressCallback* progressCallback, void* progressCallbackContext,
                     const String& headers_, int timeOutMs_, StringPairArray* responseHeaders,
                     const int maxRedirects)
       : statusCode (0), socketHandle (-1), levelsOfRedirection (0),
-        address (address_), headers (headers_), postData (postData_), position (0),
+        address (address_), headers (headers_), postData (postData_), postDataStream (postDataStream_), position (0),
+        contentLength (-1), chunkBytesLeft (0), isChunked (false), keepAlive (false),
         finished (false), isPost (isPost_), timeOutMs (timeOutMs_), numRedirectsToFollow (maxRedirects)
     {
         statusCode = createConnection (progressCallback, progressCallbackContext, numRedirectsToFollow);
@@ -101,37 +194,38 @@ public:
     }
 
     //==============================================================================
-    bool isError() const                 { return socketHandle < 0; }
+    // (once a response has been read completely, its socket may have gone back into the pool)
+    bool isError() const                 { return socketHandle < 0 && ! finished; }
     bool isExhausted() override          { return finished; }
     int64 getPosition() override         { return position; }
-
-    int64 getTotalLength() override
-    {
-        //xxx to do
-        return -1;
-    }
+    int64 getTotalLength() override      { return contentLength; }
 
     int read (void* buffer, int bytesToRead) override
     {
         if (finished || isError())
             return 0;
 
-        fd_set readbits;
-        FD_ZERO (&readbits);
-        FD_SET (socketHandle, &readbits);
-
-        struct timeval tv;
-        tv.tv_sec = jmax (1, timeOutMs / 1000);
-        tv.tv_usec = 0;
+        if (isChunked)
+        {
+            if (chunkBytesLeft == 0 && ! startNextChunk())
+                return 0;
 
-        if (select (socketHandle + 1, &readbits, 0, 0, &tv) <= 0)
-            return 0;   // (timeout)
+            bytesToRead = (int) jmin ((int64) bytesToRead, chunkBytesLeft);
+        }
+        else if (contentLength >= 0)
+        {
+            bytesToRead = (int) jmin ((int64) bytesToRead, contentLength - position);
+        }
 
-        const int bytesRead = jmax (0, (int) recv (socketHandle, buffer, bytesToRead, MSG_WAITALL));
-        if (bytesRead == 0)
-            finished = true;
+        const int bytesRead = readRaw (buffer, bytesToRead);
 
         position += bytesRead;
+
+        if (isChunked)
+            chunkBytesLeft -= bytesRead;
+        else if (contentLength >= 0 && position >= contentLength)
+            responseFinished();
+
         return bytesRead;
     }
 
@@ -142,10 +236,9 @@ public:
 
         if (wantedPos != position)
         {
-            finished = false;
-
             if (wantedPos < position)
             {
+                finished = false;
                 closeSocket();
                 position = 0;
                 statusCode = createConnection (0, 0, numRedirectsToFollow);
@@ -163,14 +256,100 @@ public:
 private:
     int socketHandle, levelsOfRedirection;
     StringArray headerLines;
-    String address, headers;
+    String address, headers, serverKey;
     MemoryBlock postData;
-    int64 position;
+    ScopedPointer<InputStream> postDataStream;
+    int64 position, contentLength, chunkBytesLeft;
+    bool isChunked, keepAlive;
     bool finished;
     const bool isPost;
     const int timeOutMs;
     const int numRedirectsToFollow;
 
+    int readRaw (void* buffer, int bytesToRead)
+    {
+        fd_set readbits;
+        FD_ZERO (&readbits);
+        FD_SET (socketHandle, &readbits);
+
+        struct timeval tv;
+        tv.tv_sec = jmax (1, timeOutMs / 1000);
+        tv.tv_usec = 0;
+
+        if (select (socketHandle + 1, &readbits, 0, 0, &tv) <= 0)
+            return 0;   // (timeout)
+
+        const int bytesRead = jmax (0, (int) recv (socketHandle, buffer, bytesToRead, MSG_WAITALL));
+        if (bytesRead == 0)
+        {
+            // (the server closed the connection, so it can't be re-used)
+            finished = true;
+            keepAlive = false;
+        }
+
+        return bytesRead;
+    }
+
+    String readLine()
+    {
+        MemoryOutputStream line;
+
+        for (;;)
+        {
+            char c = 0;
+
+            if (readRaw (&c, 1) != 1)
+                return String();
+
+            if (c == '\n')
+                return line.toString().trimEnd();
+
+            line.writeByte (c);
+        }
+    }
+
+    bool startNextChunk()
+    {
+        // (each chunk's data is followed by a CRLF, apart from before the first one)
+        if (position > 0 && readLine().isNotEmpty())
+            return failChunkedRead();
+
+        const String sizeLine (readLine());
+
+        if (sizeLine.isEmpty())
+            return failChunkedRead();
+
+        chunkBytesLeft = sizeLine.upToFirstOccurrenceOf (";", false, false).trim().getHexValue64();
+
+        if (chunkBytesLeft > 0)
+            return true;
+
+        // the last chunk can be followed by some trailing headers, and then a blank line
+        while (readLine().isNotEmpty())
+        {}
+
+        responseFinished();
+        return false;
+    }
+
+    bool failChunkedRead()
+    {
+        keepAlive = false;
+        finished = true;
+        return false;
+    }
+
+    void responseFinished()
+    {
+        finished = true;
+
+        if (keepAlive && socketHandle >= 0)
+        {
+            IdleHTTPConnectionPool::getInstance().addConnection (serverKey, socketHandle);
+            socketHandle = -1;
+        }
+    }
+
     void closeSocket (bool resetLevelsOfRedirection = true)
     {
         if (socketHandle >= 0)
@@ -219,55 +398,43 @@ private:
             port = hostPort;
         }
 
-        struct addrinfo hints;
-        zerostruct (hints);
+        serverKey = serverName + ":" + String (port);
 
-        hints.ai_family = AF_UNSPEC;
-        hints.ai_socktype = SOCK_STREAM;
-        hints.ai_flags = AI_NUMERICSERV;
+        const MemoryBlock requestHeader (createRequestHeader (hostName, hostPort, proxyName, proxyPort,
+                                                              hostPath, address, headers, postData,
+                                                              postDataStream, isPost));
 
-        struct addrinfo* result = nullptr;
-        if (getaddrinfo (serverName.toUTF8(), String (port).toUTF8(), &hints, &result) != 0 || result == 0)
-            return 0;
+        String responseHeader;
 
-        socketHandle = socket (result->ai_family, result->ai_socktype, 0);
+        // Try an idle connection to the same server first, but if the server has dropped it
+        // in the meantime, the request will fail, and a new connection is made instead.
+        socketHandle = IdleHTTPConnectionPool::getInstance().takeConnection (serverKey);
 
-        if (socketHandle == -1)
+        if (socketHandle >= 0)
         {
-            freeaddrinfo (result);
-            return 0;
-        }
-
-        int receiveBufferSize = 16384;
-        setsockopt (socketHandle, SOL_SOCKET, SO_RCVBUF, (char*) &receiveBufferSize, sizeof (receiveBufferSize));
-        setsockopt (socketHandle, SOL_SOCKET, SO_KEEPALIVE, 0, 0);
+            if (sendRequest (requestHeader, timeOutTime, progressCallback, progressCallbackContext))
+                responseHeader = readResponse (timeOutTime);
 
-      #if JUCE_MAC
-        setsockopt (socketHandle, SOL_SOCKET, SO_NOSIGPIPE, 0, 0);
-      #endif
-
-        if (connect (socketHandle, result->ai_addr, result->ai_addrlen) == -1)
-        {
-            closeSocket();
-            freeaddrinfo (result);
-            return 0;
+            if (responseHeader.isEmpty())
+                closeSocket (false);
         }
 
-        freeaddrinfo (result);
-
+        if (socketHandle < 0)
         {
-            const MemoryBlock requestHeader (createRequestHeader (hostName, hostPort, proxyName, proxyPort,
-                                                                  hostPath, address, headers, postData, isPost));
+            finished = false;
 
-            if (! sendHeader (socketHandle, requestHeader, timeOutTime,
-                              progressCallback, progressCallbackContext))
+            if (! openSocket (serverName, port))
+                return 0;
+
+            if (! sendRequest (requestHeader, timeOutTime, progressCallback, progressCallbackContext))
             {
                 closeSocket();
                 return 0;
             }
+
+            responseHeader = readResponse (timeOutTime);
         }
 
-        String responseHeader (readResponse (timeOutTime));
         position = 0;
 
         if (responseHeader.isNotEmpty())
@@ -277,6 +444,8 @@ private:
             const int status = responseHeader.fromFirstOccurrenceOf (" ", false, false)
                                              .substring (0, 3).getIntValue();
 
+            readBodyFormat (responseHeader, status);
+
             String location (findHeaderItem (headerLines, "Location:"));
 
             if (++levelsOfRedirection <= numRedirects
@@ -298,6 +467,9 @@ private:
                 return createConnection (progressCallback, progressCallbackContext, numRedirects);
             }
 
+            if (contentLength == 0)
+                responseFinished();
+
             return status;
         }
 
@@ -305,6 +477,63 @@ private:
         return 0;
     }
 
+    bool openSocket (const String& serverName, const int port)
+    {
+        struct addrinfo hints;
+        zerostruct (hints);
+
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_NUMERICSERV;
+
+        struct addrinfo* result = nullptr;
+        if (getaddrinfo (serverName.toUTF8(), String (port).toUTF8(), &hints, &result) != 0 || result == 0)
+            return false;
+
+        socketHandle = socket (result->ai_family, result->ai_socktype, 0);
+
+        if (socketHandle == -1)
+        {
+            freeaddrinfo (result);
+            return false;
+        }
+
+        int receiveBufferSize = 16384;
+        setsockopt (socketHandle, SOL_SOCKET, SO_RCVBUF, (char*) &receiveBufferSize, sizeof (receiveBufferSize));
+        setsockopt (socketHandle, SOL_SOCKET, SO_KEEPALIVE, 0, 0);
+
+      #if JUCE_MAC
+        setsockopt (socketHandle, SOL_SOCKET, SO_NOSIGPIPE, 0, 0);
+      #endif
+
+        if (connect (socketHandle, result->ai_addr, result->ai_addrlen) == -1)
+        {
+            closeSocket();
+            freeaddrinfo (result);
+            return false;
+        }
+
+        freeaddrinfo (result);
+        return true;
+    }
+
+    // Works out how the body of the response will be delimited, and whether the
+    // connection can be re-used once it has been read.
+    void readBodyFormat (const String& responseHeader, const int status)
+    {
+        const String connection (findHeaderItem (headerLines, "Connection:"));
+        const String lengthItem (findHeaderItem (headerLines, "Content-Length:"));
+
+        isChunked = findHeaderItem (headerLines, "Transfer-Encoding:").containsIgnoreCase ("chunked");
+        contentLength = (status == 204 || status == 304) ? 0
+                                                         : ((isChunked || lengthItem.isEmpty()) ? -1 : lengthItem.getLargeIntValue());
+        chunkBytesLeft = 0;
+
+        keepAlive = responseHeader.startsWithIgnoreCase ("HTTP/1.1")
+                     && ! connection.equalsIgnoreCase ("close")
+                     && (isChunked || contentLength >= 0);
+    }
+
     //==============================================================================
     String readResponse (const uint32 timeOutTime)
     {
@@ -317,7 +546,7 @@ private:
                 && ! (finished || isError()))
         {
             char c = 0;
-            if (read (&c, 1) != 1)
+            if (readRaw (&c, 1) != 1)
                 return String();
 
             buffer.writeByte (c);
@@ -343,16 +572,19 @@ private:
     }
 
     static void writeHost (MemoryOutputStream& dest, const bool isPost,
-                           const String& path, const String& host, int /*port*/)
+                           const String& path, const String& host, int port)
     {
-        dest << (isPost ? "POST " : "GET ") << path << " HTTP/1.0\r\nHost: " << host;
+        dest << (isPost ? "POST " : "GET ") << path << " HTTP/1.1\r\nHost: " << host;
+
+        if (port != 80)
+            dest << ':' << port;
     }
 
     static MemoryBlock createRequestHeader (const String& hostName, const int hostPort,
                                             const String& proxyName, const int proxyPort,
                                             const String& hostPath, const String& originalURL,
                                             const String& userHeaders, const MemoryBlock& postData,
-                                            const bool isPost)
+                                            InputStream* const postDataStream, const bool isPost)
     {
         MemoryOutputStream header;
 
@@ -364,18 +596,30 @@ private:
         writeValueIfNotPresent (header, userHeaders, "User-Agent:", "JUCE/" JUCE_STRINGIFY(JUCE_MAJOR_VERSION)
                                                                         "." JUCE_STRINGIFY(JUCE_MINOR_VERSION)
                                                                         "." JUCE_STRINGIFY(JUCE_BUILDNUMBER));
-        writeValueIfNotPresent (header, userHeaders, "Connection:", "close");
+        writeValueIfNotPresent (header, userHeaders, "Connection:", "keep-alive");
 
         if (isPost)
         {
-            writeValueIfNotPresent (header, userHeaders, "Content-Length:", String ((int) postData.getSize()));
-            header << userHeaders << "\r\n" << postData;
-        }
-        else
-        {
-            header << "\r\n" << userHeaders << "\r\n";
+            if (postDataStream == nullptr)
+                writeValueIfNotPresent (header, userHeaders, "Content-Length:", String ((int) postData.getSize()));
+            else if (postDataStream->getTotalLength() >= 0)
+                writeValueIfNotPresent (header, userHeaders, "Content-Length:", String (postDataStream->getTotalLength()));
+            else
+                writeValueIfNotPresent (header, userHeaders, "Transfer-Encoding:", "chunked");
         }
 
+        // (a stray blank line after the headers would look like the start of another
+        // request, and make a server close the connection rather than keeping it alive)
+        const String extraHeaders (userHeaders.trim());
+
+        if (extraHeaders.isNotEmpty())
+            header << "\r\n" << extraHeaders;
+
+        header << "\r\n\r\n";
+
+        if (isPost && postDataStream == nullptr)
+            header << postData;
+
         return header.getMemoryBlock();
     }
 
@@ -403,6 +647,93 @@ private:
         return true;
     }
 
+    bool sendRequest (const MemoryBlock& requestHeader, const uint32 timeOutTime,
+                      URL::OpenStreamProgressCallback* progressCallback, void* progressCallbackContext)
+    {
+        return sendHeader (socketHandle, requestHeader, timeOutTime, progressCallback, progressCallbackContext)
+                && (postDataStream == nullptr
+                     || sendPostDataStream (requestHeader.getSize(), timeOutTime, progressCallback, progressCallbackContext));
+    }
+
+    // Sends the body straight from the stream as it's read, so that nothing bigger than one
+    // block is ever held in memory. If the stream's length is unknown, it goes in chunks.
+    bool sendPostDataStream (const size_t headerSize, const uint32 timeOutTime,
+                             URL::OpenStreamProgressCallback* progressCallback, void* progressCallbackContext)
+    {
+        InputStream& source = *postDataStream;
+
+        // (a redirect or a retry on a new connection means sending it all again)
+        if (source.getPosition() != 0 && ! source.setPosition (0))
+            return false;
+
+        const int64 totalLength = source.getTotalLength();
+        const bool isChunkedUpload = totalLength < 0;
+        const int blockSize = 32768;
+        HeapBlock<char> block ((size_t) blockSize + 16);
+        int64 totalSent = 0;
+
+        for (;;)
+        {
+            if (Time::getMillisecondCounter() > timeOutTime)
+                return false;
+
+            const int numToRead = isChunkedUpload ? blockSize : (int) jmin ((int64) blockSize, totalLength - totalSent);
+            const int numRead = numToRead > 0 ? source.read (block + 16, numToRead) : 0;
+
+            if (numRead <= 0)
+                break;
+
+            if (isChunkedUpload)
+            {
+                const String chunkHeader (String::toHexString (numRead) + "\r\n");
+
+                if (! (sendAll (chunkHeader.toRawUTF8(), chunkHeader.length())
+                        && sendAll (block + 16, (size_t) numRead)
+                        && sendAll ("\r\n", 2)))
+                    return false;
+            }
+            else if (! sendAll (block + 16, (size_t) numRead))
+            {
+                return false;
+            }
+
+            totalSent += numRead;
+
+            if (progressCallback != nullptr
+                 && ! progressCallback (progressCallbackContext,
+                                        (int) jmin ((int64) std::numeric_limits<int>::max(), (int64) headerSize + totalSent),
+                                        isChunkedUpload ? -1 : (int) jmin ((int64) std::numeric_limits<int>::max(),
+                                                                           (int64) headerSize + totalLength)))
+                return false;
+        }
+
+        // (a stream that stopped early, e.g. because it was cancelled, mustn't be ended as if
+        // the upload were complete)
+        if (isChunkedUpload)
+            return source.isExhausted() && sendAll ("0\r\n\r\n", 5);
+
+        // (if the stream ran out early, the server would be left waiting for the rest)
+        return totalSent == totalLength;
+    }
+
+    bool sendAll (const void* data, size_t numBytes) const
+    {
+        const char* d = static_cast<const char*> (data);
+
+        while (numBytes > 0)
+        {
+            const ssize_t numSent = send (socketHandle, d, numBytes, 0);
+
+            if (numSent <= 0)
+                return false;
+
+            d += numSent;
+            numBytes -= (size_t) numSent;
+        }
+
+        return true;
+    }
+
     static bool decomposeURL (const String& url, String& host, String& path, int& port)
     {
         if (! url.startsWithIgnoreCase ("http://"))
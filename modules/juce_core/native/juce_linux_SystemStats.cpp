@@ -71,6 +71,78 @@ namespace LinuxStatsHelpers
     {
         return getConfigFileValue ("/proc/cpuinfo", key);
     }
+
+    String readSysFile (const String& path)
+    {
+        return File (path).loadFileAsString().trim();
+    }
+
+    // Parses the kernel's format for a set of CPUs, e.g. "0-3,8,10-11"
+    BigInteger parseCpuList (const String& list)
+    {
+        BigInteger cpus;
+        StringArray ranges;
+        ranges.addTokens (list, ",", StringRef());
+
+        for (int i = 0; i < ranges.size(); ++i)
+        {
+            const int start = ranges[i].upToFirstOccurrenceOf ("-", false, false).trim().getIntValue();
+            const int end = ranges[i].contains ("-") ? ranges[i].fromFirstOccurrenceOf ("-", false, false).trim().getIntValue()
+                                                     : start;
+
+            if (start >= 0 && end >= start)
+                cpus.setRange (start, end - start + 1, true);
+        }
+
+        return cpus;
+    }
+
+    // Works out which logical CPUs belong to efficiency cores on a hybrid CPU
+    BigInteger getEfficiencyCpus (const int numCpus)
+    {
+        // Intel hybrid CPUs list their efficiency cores as a separate "atom" PMU..
+        const String atomCpus (readSysFile ("/sys/devices/cpu_atom/cpus"));
+
+        if (atomCpus.isNotEmpty())
+            return parseCpuList (atomCpus);
+
+        // ..and on ARM big.LITTLE, the slower cores have a lower capacity
+        Array<int> capacities;
+        int maxCapacity = 0;
+
+        for (int i = 0; i < numCpus; ++i)
+        {
+            const int capacity = readSysFile ("/sys/devices/system/cpu/cpu" + String (i) + "/cpu_capacity").getIntValue();
+            capacities.add (capacity);
+            maxCapacity = jmax (maxCapacity, capacity);
+        }
+
+        BigInteger cpus;
+
+        for (int i = 0; i < numCpus; ++i)
+            if (capacities.getUnchecked (i) > 0 && capacities.getUnchecked (i) < maxCapacity)
+                cpus.setBit (i);
+
+        return cpus;
+    }
+
+    int getCacheSizeInKilobytes (const int level)
+    {
+        for (int i = 0;; ++i)
+        {
+            const File index ("/sys/devices/system/cpu/cpu0/cache/index" + String (i));
+
+            if (! index.isDirectory())
+                return 0;
+
+            if (readSysFile (index.getChildFile ("level").getFullPathName()).getIntValue() == level
+                 && ! readSysFile (index.getChildFile ("type").getFullPathName()).equalsIgnoreCase ("Instruction"))
+            {
+                const String size (readSysFile (index.getChildFile ("size").getFullPathName()));
+                return size.getIntValue() * (size.endsWithIgnoreCase ("M") ? 1024 : 1);
+            }
+        }
+    }
 }
 
 String SystemStats::getDeviceDescription()
@@ -156,7 +228,53 @@ void CPUInformation::initialise() noexcept
     hasSSE3  = flags.contains ("sse3");
     has3DNow = flags.contains ("3dnow");
 
+    // the kernel only reports these if it has also enabled saving of the AVX registers
+    const StringArray flagList (StringArray::fromTokens (flags, false));
+    hasAVX   = flagList.contains ("avx");
+    hasAVX2  = flagList.contains ("avx2");
+    hasFMA3  = flagList.contains ("fma");
+    hasAVX512F = flagList.contains ("avx512f");
+
+    const StringArray armFeatures (StringArray::fromTokens (LinuxStatsHelpers::getCpuInfo ("Features"), false));
+
+    if (armFeatures.contains ("neon") || armFeatures.contains ("asimd"))
+        hasNeon = true;
+
     numCpus = LinuxStatsHelpers::getCpuInfo ("processor").getIntValue() + 1;
+
+    // Each distinct package/core pair is a physical core
+    const BigInteger efficiencyCpus (LinuxStatsHelpers::getEfficiencyCpus (numCpus));
+    StringArray cores, performanceCores;
+
+    for (int i = 0; i < numCpus; ++i)
+    {
+        const String topology ("/sys/devices/system/cpu/cpu" + String (i) + "/topology/");
+        const String coreID (LinuxStatsHelpers::readSysFile (topology + "core_id"));
+
+        if (coreID.isEmpty())
+            break;
+
+        const String core (LinuxStatsHelpers::readSysFile (topology + "physical_package_id") + ":" + coreID);
+        cores.addIfNotAlreadyThere (core);
+
+        if (! efficiencyCpus[i])
+        {
+            performanceCores.addIfNotAlreadyThere (core);
+
+            if (i < 32)
+                performanceCpuMask |= (1u << i);
+        }
+    }
+
+    numPhysicalCpus = cores.size();
+    numPerformanceCores = performanceCores.size();
+
+    for (int level = 1; level <= 3; ++level)
+        cacheSizesKb [level - 1] = LinuxStatsHelpers::getCacheSizeInKilobytes (level);
+
+    Array<File> nodes;
+    File ("/sys/devices/system/node").findChildFiles (nodes, File::findDirectories, false, "node*");
+    numNumaNodes = nodes.size();
 }
 
 //==============================================================================
@@ -343,13 +343,20 @@ private:
 class WebInputStream  : public InputStream
 {
 public:
-    WebInputStream (const String& address_, bool isPost_, const MemoryBlock& postData_,
+    WebInputStream (const String& address_, bool isPost_, const MemoryBlock& postData_, InputStream* postDataStream,
                     URL::OpenStreamProgressCallback* progressCallback, void* progressCallbackContext,
                     const String& headers_, int timeOutMs_, StringPairArray* responseHeaders,
                     const int numRedirectsToFollow_)
       : statusCode (0), address (address_), headers (headers_), postData (postData_), position (0),
         finished (false), isPost (isPost_), timeOutMs (timeOutMs_), numRedirectsToFollow (numRedirectsToFollow_)
     {
+        // (a streamed body is read in here, as the request may need to be re-sent for a redirect)
+        if (postDataStream != nullptr)
+        {
+            const ScopedPointer<InputStream> source (postDataStream);
+            source->readIntoMemoryBlock (postData);
+        }
+
         JUCE_AUTORELEASEPOOL
         {
             createConnection (progressCallback, progressCallbackContext);
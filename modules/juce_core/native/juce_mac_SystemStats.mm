@@ -65,7 +65,32 @@ namespace SystemStatsHelpers
 
         a = la; b = lb; c = lc; d = ld;
     }
+
+    static bool isAVXStateEnabledByOS() noexcept
+    {
+        uint32 eax, edx;
+        asm ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+        return (eax & 6) == 6;
+    }
+
+    static bool isAVX512StateEnabledByOS() noexcept
+    {
+        uint32 eax, edx;
+        asm ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+        return (eax & 0xe6) == 0xe6;
+    }
    #endif
+
+    static int getSysctlInt (const char* name) noexcept
+    {
+        int64 value = 0;
+        size_t size = sizeof (value);
+
+        if (sysctlbyname (name, &value, &size, nullptr, 0) != 0)
+            return 0;
+
+        return size == sizeof (int32) ? (int) *(int32*) &value : (int) value;
+    }
 }
 
 //==============================================================================
@@ -80,6 +105,26 @@ void CPUInformation::initialise() noexcept
     hasSSE2  = (d & (1u << 26)) != 0;
     has3DNow = (b & (1u << 31)) != 0;
     hasSSE3  = (c & (1u <<  0)) != 0;
+
+    // AVX needs the OS to be saving the extended register state as well as CPU support
+    if ((c & (1u << 27)) != 0 && (c & (1u << 28)) != 0 && SystemStatsHelpers::isAVXStateEnabledByOS())
+    {
+        hasAVX  = true;
+        hasFMA3 = (c & (1u << 12)) != 0;
+
+       #if JUCE_64BIT
+        a = 0; b = 0; c = 0; d = 0;
+        SystemStatsHelpers::doCPUID (a, b, c, d, 0);
+
+        if (a >= 7)
+        {
+            a = 0; b = 0; c = 0; d = 0;
+            SystemStatsHelpers::doCPUID (a, b, c, d, 7);
+            hasAVX2    = (b & (1u << 5)) != 0;
+            hasAVX512F = (b & (1u << 16)) != 0 && SystemStatsHelpers::isAVX512StateEnabledByOS();
+        }
+       #endif
+    }
    #endif
 
    #if JUCE_IOS || (MAC_OS_X_VERSION_MIN_REQUIRED >= MAC_OS_X_VERSION_10_5)
@@ -87,6 +132,16 @@ void CPUInformation::initialise() noexcept
    #else
     numCpus = (int) MPProcessors();
    #endif
+
+    numPhysicalCpus = SystemStatsHelpers::getSysctlInt ("hw.physicalcpu");
+
+    // (on Apple silicon, perflevel0 is the set of performance cores)
+    if (SystemStatsHelpers::getSysctlInt ("hw.nperflevels") > 1)
+        numPerformanceCores = SystemStatsHelpers::getSysctlInt ("hw.perflevel0.physicalcpu");
+
+    cacheSizesKb[0] = SystemStatsHelpers::getSysctlInt ("hw.l1dcachesize") / 1024;
+    cacheSizesKb[1] = SystemStatsHelpers::getSysctlInt ("hw.l2cachesize") / 1024;
+    cacheSizesKb[2] = SystemStatsHelpers::getSysctlInt ("hw.l3cachesize") / 1024;
 }
 
 #if JUCE_MAC
@@ -74,6 +74,32 @@ JUCE_API void JUCE_CALLTYPE Process::setPriority (ProcessPriority)
     // xxx
 }
 
+//==============================================================================
+bool JUCE_CALLTYPE Thread::setCurrentThreadRealtime (double periodMs, double computationMs,
+                                                     double constraintMs, int /*priority*/)
+{
+    jassert (computationMs > 0); // the kernel won't accept a time-constraint policy without this
+
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info (&timebase);
+
+    const double ticksPerMs = (1000000.0 * timebase.denom) / timebase.numer;
+
+    // The kernel rejects computations outside the range of about 50us to 50ms, and
+    // constraints that are shorter than the computation.
+    computationMs = jlimit (0.05, 50.0, computationMs);
+    constraintMs  = jmax (computationMs, constraintMs);
+
+    thread_time_constraint_policy_data_t policy;
+    policy.period      = (uint32_t) (jmax (0.0, periodMs) * ticksPerMs);
+    policy.computation = (uint32_t) (computationMs * ticksPerMs);
+    policy.constraint  = (uint32_t) (constraintMs * ticksPerMs);
+    policy.preemptible = true;
+
+    return thread_policy_set (pthread_mach_thread_np (pthread_self()), THREAD_TIME_CONSTRAINT_POLICY,
+                              (thread_policy_t) &policy, THREAD_TIME_CONSTRAINT_POLICY_COUNT) == KERN_SUCCESS;
+}
+
 //==============================================================================
 JUCE_API bool JUCE_CALLTYPE juce_isRunningUnderDebugger()
 {
@@ -39,7 +39,20 @@ CriticalSection::CriticalSection() noexcept
 }
 
 CriticalSection::~CriticalSection() noexcept        { pthread_mutex_destroy (&lock); }
-void CriticalSection::enter() const noexcept        { pthread_mutex_lock (&lock); }
+
+void CriticalSection::enter() const noexcept
+{
+   #if JUCE_CHECK_REALTIME_SAFETY
+    // (taking a free lock is cheap, so it's only a problem if this would have to wait)
+    if (juce_isInRealtimeContext() && pthread_mutex_trylock (&lock) == 0)
+        return;
+
+    JUCE_ASSERT_NOT_REALTIME ("CriticalSection::enter() on a contended lock");
+   #endif
+
+    pthread_mutex_lock (&lock);
+}
+
 bool CriticalSection::tryEnter() const noexcept     { return pthread_mutex_trylock (&lock) == 0; }
 void CriticalSection::exit() const noexcept         { pthread_mutex_unlock (&lock); }
 
@@ -131,9 +144,109 @@ void WaitableEvent::reset() const noexcept
     pthread_mutex_unlock (&mutex);
 }
 
+//==============================================================================
+#if JUCE_LINUX || JUCE_ANDROID
+void juce_waitOnAddress (const volatile int* address, int expectedValue, int timeOutMs) noexcept
+{
+    struct timespec timeout;
+    timeout.tv_sec = timeOutMs / 1000;
+    timeout.tv_nsec = (timeOutMs % 1000) * 1000000;
+
+    syscall (SYS_futex, address, FUTEX_WAIT_PRIVATE, expectedValue,
+             timeOutMs >= 0 ? &timeout : nullptr, nullptr, 0);
+}
+
+void juce_wakeAddress (const volatile int* address, bool wakeAllWaiters) noexcept
+{
+    syscall (SYS_futex, address, FUTEX_WAKE_PRIVATE,
+             wakeAllWaiters ? std::numeric_limits<int>::max() : 1, nullptr, nullptr, 0);
+}
+
+#else
+// Without futexes, waiting threads sleep on a condition variable chosen by hashing the
+// address. The value is checked while the bucket's mutex is held, and wakers take the same
+// mutex, so a wake-up can't be missed. Threads waiting on different addresses may share
+// a bucket, so every waiter in it gets woken, and rechecks its own value.
+struct AddressWaitBuckets
+{
+    AddressWaitBuckets() noexcept
+    {
+        for (int i = 0; i < numBuckets; ++i)
+        {
+            pthread_mutex_init (&buckets[i].mutex, nullptr);
+            pthread_cond_init (&buckets[i].condition, nullptr);
+        }
+    }
+
+    struct Bucket
+    {
+        pthread_mutex_t mutex;
+        pthread_cond_t condition;
+    };
+
+    Bucket& getBucket (const volatile int* address) noexcept
+    {
+        return buckets [(((pointer_sized_uint) address) >> 2) % numBuckets];
+    }
+
+    // (this is deliberately never deleted, in case threads are still waiting at shutdown)
+    static AddressWaitBuckets& getInstance()
+    {
+        static AddressWaitBuckets* instance = new AddressWaitBuckets();
+        return *instance;
+    }
+
+    enum { numBuckets = 61 };
+    Bucket buckets [numBuckets];
+};
+
+void juce_waitOnAddress (const volatile int* address, int expectedValue, int timeOutMs) noexcept
+{
+    AddressWaitBuckets::Bucket& bucket = AddressWaitBuckets::getInstance().getBucket (address);
+    pthread_mutex_lock (&bucket.mutex);
+
+    if (*address == expectedValue)
+    {
+        if (timeOutMs < 0)
+        {
+            pthread_cond_wait (&bucket.condition, &bucket.mutex);
+        }
+        else
+        {
+            struct timeval now;
+            gettimeofday (&now, 0);
+
+            struct timespec time;
+            time.tv_sec  = now.tv_sec  + (timeOutMs / 1000);
+            time.tv_nsec = (now.tv_usec + ((timeOutMs % 1000) * 1000)) * 1000;
+
+            if (time.tv_nsec >= 1000000000)
+            {
+                time.tv_nsec -= 1000000000;
+                time.tv_sec++;
+            }
+
+            pthread_cond_timedwait (&bucket.condition, &bucket.mutex, &time);
+        }
+    }
+
+    pthread_mutex_unlock (&bucket.mutex);
+}
+
+void juce_wakeAddress (const volatile int* address, bool /*wakeAllWaiters*/) noexcept
+{
+    AddressWaitBuckets::Bucket& bucket = AddressWaitBuckets::getInstance().getBucket (address);
+    pthread_mutex_lock (&bucket.mutex);
+    pthread_cond_broadcast (&bucket.condition);
+    pthread_mutex_unlock (&bucket.mutex);
+}
+#endif
+
 //==============================================================================
 void JUCE_CALLTYPE Thread::sleep (int millisecs)
 {
+    JUCE_ASSERT_NOT_REALTIME ("Thread::sleep()");
+
     struct timespec time;
     time.tv_sec = millisecs / 1000;
     time.tv_nsec = (millisecs % 1000) * 1000000;
@@ -229,6 +342,7 @@ namespace
     static int64 getCreationTime (const juce_statStruct& s) noexcept     { return (int64) s.st_ctime; }
    #endif
 
+   #if JUCE_MAC || JUCE_IOS
     void updateStatInfoForFile (const String& path, bool* const isDir, int64* const fileSize,
                                 Time* const modTime, Time* const creationTime, bool* const isReadOnly)
     {
@@ -246,6 +360,7 @@ namespace
         if (isReadOnly != nullptr)
             *isReadOnly = access (path.toUTF8(), W_OK) != 0;
     }
+   #endif
 
     Result getResultForErrno()
     {
@@ -404,14 +519,30 @@ int64 juce_fileSetPosition (void* handle, int64 pos)
     return -1;
 }
 
+void juce_fileSetSequentialAccessHint (void* handle, bool isSequential)
+{
+   #if JUCE_LINUX
+    // (a sequential hint makes the kernel use a bigger read-ahead window)
+    if (handle != 0)
+        posix_fadvise (getFD (handle), 0, 0, isSequential ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_NORMAL);
+   #else
+    ignoreUnused (handle, isSequential);
+   #endif
+}
+
 void FileInputStream::openHandle()
 {
     const int f = open (file.getFullPathName().toUTF8(), O_RDONLY, 00644);
 
     if (f != -1)
+    {
         fileHandle = fdToVoidPointer (f);
+        juce_fileSetSequentialAccessHint (fileHandle, true);
+    }
     else
+    {
         status = getResultForErrno();
+    }
 }
 
 FileInputStream::~FileInputStream()
@@ -494,11 +625,122 @@ ssize_t FileOutputStream::writeInternal (const void* const data, const size_t nu
 
         if (result == -1)
             status = getResultForErrno();
+        else if (bypassesCache)
+            writeBehind (result);
+    }
+
+    return result;
+}
+
+ssize_t FileOutputStream::writeInternal (const void* const data1, const size_t numBytes1,
+                                         const void* const data2, const size_t numBytes2)
+{
+    ssize_t result = 0;
+
+    if (fileHandle != 0)
+    {
+        struct iovec blocks[2];
+        blocks[0].iov_base = const_cast<void*> (data1);
+        blocks[0].iov_len  = numBytes1;
+        blocks[1].iov_base = const_cast<void*> (data2);
+        blocks[1].iov_len  = numBytes2;
+
+        result = ::writev (getFD (fileHandle), blocks, 2);
+
+        if (result == -1)
+            status = getResultForErrno();
+        else if (bypassesCache)
+            writeBehind (result);
     }
 
     return result;
 }
 
+void FileOutputStream::writeBehind (const ssize_t numBytesJustWritten)
+{
+   #if JUCE_LINUX
+    const int fd = getFD (fileHandle);
+    const int64 end = (int64) lseek (fd, 0, SEEK_CUR);
+    const int64 start = end - numBytesJustWritten;
+
+    if (start != pendingWriteEnd)
+        pendingWriteStart = start;
+
+    pendingWriteEnd = end;
+
+    // Once enough data has built up, this tells the kernel to start writing it to disk, then
+    // waits for the previous chunk to get there (which it normally will have done already),
+    // so that it can be dropped from the cache.
+    if (pendingWriteEnd - pendingWriteStart >= 1024 * 1024)
+    {
+        sync_file_range (fd, (off64_t) pendingWriteStart, (off64_t) (pendingWriteEnd - pendingWriteStart),
+                         SYNC_FILE_RANGE_WRITE);
+
+        if (writeInProgressEnd > writeInProgressStart)
+        {
+            sync_file_range (fd, (off64_t) writeInProgressStart, (off64_t) (writeInProgressEnd - writeInProgressStart),
+                             SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+
+            posix_fadvise (fd, (off_t) writeInProgressStart, (off_t) (writeInProgressEnd - writeInProgressStart),
+                           POSIX_FADV_DONTNEED);
+        }
+
+        writeInProgressStart = pendingWriteStart;
+        writeInProgressEnd = pendingWriteEnd;
+        pendingWriteStart = pendingWriteEnd;
+    }
+   #else
+    ignoreUnused (numBytesJustWritten);
+   #endif
+}
+
+void FileOutputStream::setBypassesFileCache (const bool shouldBypassCache)
+{
+    flushBuffer();
+    bypassesCache = shouldBypassCache;
+    pendingWriteStart = pendingWriteEnd = writeInProgressStart = writeInProgressEnd = 0;
+
+   #if JUCE_MAC || JUCE_IOS
+    if (fileHandle != 0)
+        fcntl (getFD (fileHandle), F_NOCACHE, shouldBypassCache ? 1 : 0);
+   #endif
+}
+
+Result FileOutputStream::preallocate (const int64 totalNumBytes)
+{
+    if (fileHandle == 0)
+        return status;
+
+    const int fd = getFD (fileHandle);
+
+   #if JUCE_LINUX
+    // (FALLOC_FL_KEEP_SIZE reserves the space without changing the file's length)
+    if (fallocate (fd, FALLOC_FL_KEEP_SIZE, 0, (off_t) totalNumBytes) != 0 && errno != EOPNOTSUPP)
+        return getResultForErrno();
+   #elif JUCE_MAC || JUCE_IOS
+    struct stat info;
+
+    if (fstat (fd, &info) == 0 && totalNumBytes > (int64) info.st_size)
+    {
+        fstore_t store = { F_ALLOCATECONTIG | F_ALLOCATEALL, F_PEOFPOSMODE, 0,
+                           (off_t) (totalNumBytes - (int64) info.st_size), 0 };
+
+        if (fcntl (fd, F_PREALLOCATE, &store) == -1)
+        {
+            // if there's no contiguous space, any space will do..
+            store.fst_flags = F_ALLOCATEALL;
+
+            if (fcntl (fd, F_PREALLOCATE, &store) == -1 && errno != ENOTSUP)
+                return getResultForErrno();
+        }
+    }
+   #else
+    ignoreUnused (fd, totalNumBytes);
+   #endif
+
+    return Result::ok();
+}
+
 void FileOutputStream::flushInternal()
 {
     if (fileHandle != 0)
@@ -577,6 +819,41 @@ MemoryMappedFile::~MemoryMappedFile()
         close (fileHandle);
 }
 
+void MemoryMappedFile::setAccessPattern (AccessPattern pattern) noexcept
+{
+    if (address != nullptr)
+        madvise (address, (size_t) range.getLength(),
+                 pattern == sequentialAccess ? MADV_SEQUENTIAL
+                                             : (pattern == randomAccess ? MADV_RANDOM : MADV_NORMAL));
+}
+
+void MemoryMappedFile::prefetch (Range<int64> fileRange) const noexcept
+{
+    void* start;
+    size_t numBytes;
+
+    if (getPageRange (fileRange, start, numBytes))
+        madvise (start, numBytes, MADV_WILLNEED);
+}
+
+bool MemoryMappedFile::lockInMemory (Range<int64> fileRange) noexcept
+{
+    void* start;
+    size_t numBytes;
+
+    return getPageRange (fileRange, start, numBytes)
+            && mlock (start, numBytes) == 0;
+}
+
+void MemoryMappedFile::unlockFromMemory (Range<int64> fileRange) noexcept
+{
+    void* start;
+    size_t numBytes;
+
+    if (getPageRange (fileRange, start, numBytes))
+        munlock (start, numBytes);
+}
+
 //==============================================================================
 #if JUCE_PROJUCER_LIVE_BUILD
 extern "C" const char* juce_getCurrentExecutablePath();
@@ -932,11 +1209,58 @@ bool Thread::setThreadPriority (void* handle, int priority)
     return pthread_setschedparam ((pthread_t) handle, policy, &param) == 0;
 }
 
+#if JUCE_LINUX || JUCE_ANDROID
+bool JUCE_CALLTYPE Thread::setCurrentThreadRealtime (double, double, double, int priority)
+{
+    // (SCHED_FIFO has no notion of a period or deadline, so only the priority is used)
+    const int minPriority = sched_get_priority_min (SCHED_FIFO);
+    const int maxPriority = sched_get_priority_max (SCHED_FIFO);
+
+    struct sched_param param;
+    param.sched_priority = ((maxPriority - minPriority) * jlimit (0, 10, priority)) / 10 + minPriority;
+    return pthread_setschedparam (pthread_self(), SCHED_FIFO, &param) == 0;
+}
+#endif
+
 Thread::ThreadID JUCE_CALLTYPE Thread::getCurrentThreadId()
 {
     return (ThreadID) pthread_self();
 }
 
+//==============================================================================
+NativeThreadLocalSlot::NativeThreadLocalSlot (ThreadExitCallback threadExitCallback) noexcept
+    : slot (0), valid (false)
+{
+    pthread_key_t key;
+
+    if (pthread_key_create (&key, threadExitCallback) == 0)
+    {
+        slot = (pointer_sized_uint) key;
+        valid = true;
+    }
+    else
+    {
+        jassertfalse; // run out of thread-local keys!
+    }
+}
+
+NativeThreadLocalSlot::~NativeThreadLocalSlot()
+{
+    if (valid)
+        pthread_key_delete ((pthread_key_t) slot);
+}
+
+void* NativeThreadLocalSlot::get() const noexcept
+{
+    return valid ? pthread_getspecific ((pthread_key_t) slot) : nullptr;
+}
+
+void NativeThreadLocalSlot::set (void* newValue) const noexcept
+{
+    if (valid)
+        pthread_setspecific ((pthread_key_t) slot, newValue);
+}
+
 void JUCE_CALLTYPE Thread::yield()
 {
     sched_yield();
@@ -968,7 +1292,7 @@ void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask (const uint32 affinityMa
        If you don't want to update your copy of glibc and don't care about cpu affinities,
        then you can just disable all this stuff by setting the SUPPORT_AFFINITIES macro to 0.
     */
-    sched_setaffinity (getpid(), sizeof (cpu_set_t), &affinity);
+    sched_setaffinity (0, sizeof (cpu_set_t), &affinity); // (0 means the calling thread)
     sched_yield();
 
    #else
@@ -1009,123 +1333,308 @@ class ChildProcess::ActiveProcess
 {
 public:
     ActiveProcess (const StringArray& arguments, int streamFlags)
-        : childPID (0), pipeHandle (0), readHandle (0)
+        : childPID (0), readHandle (-1), writeHandle (-1), exitStatus (-1)
     {
         // Looks like you're trying to launch a non-existent exe or a folder (perhaps on OSX
         // you're trying to launch the .app folder rather than the actual binary inside it?)
         jassert ((! arguments[0].containsChar ('/'))
                   || File::getCurrentWorkingDirectory().getChildFile (arguments[0]).existsAsFile());
 
-        int pipeHandles[2] = { 0 };
+        int outputPipe[2] = { -1, -1 };
+        int inputPipe[2]  = { -1, -1 };
 
-        if (pipe (pipeHandles) == 0)
-        {
-            const pid_t result = fork();
+        if (pipe (outputPipe) != 0)
+            return;
 
-            if (result < 0)
+        if ((streamFlags & wantStdIn) != 0)
+        {
+            if (pipe (inputPipe) != 0)
             {
-                close (pipeHandles[0]);
-                close (pipeHandles[1]);
+                closePipe (outputPipe);
+                return;
             }
-            else if (result == 0)
-            {
-                // we're the child process..
-                close (pipeHandles[0]);   // close the read handle
 
-                if ((streamFlags & wantStdOut) != 0)
-                    dup2 (pipeHandles[1], 1); // turns the pipe into stdout
-                else
-                    close (STDOUT_FILENO);
+            // Writing to a child that has exited would otherwise kill this process..
+            ignoreBrokenPipeSignals();
+        }
 
-                if ((streamFlags & wantStdErr) != 0)
-                    dup2 (pipeHandles[1], 2);
-                else
-                    close (STDERR_FILENO);
+        // (stops our ends of the pipes leaking into any other processes that get launched)
+        fcntl (outputPipe[0], F_SETFD, FD_CLOEXEC);
 
-                close (pipeHandles[1]);
+        if (inputPipe[1] >= 0)
+            fcntl (inputPipe[1], F_SETFD, FD_CLOEXEC);
 
-                Array<char*> argv;
-                for (int i = 0; i < arguments.size(); ++i)
-                    if (arguments[i].isNotEmpty())
-                        argv.add (const_cast<char*> (arguments[i].toUTF8().getAddress()));
+        Array<char*> argv;
+        for (int i = 0; i < arguments.size(); ++i)
+            if (arguments[i].isNotEmpty())
+                argv.add (const_cast<char*> (arguments[i].toUTF8().getAddress()));
 
-                argv.add (nullptr);
+        argv.add (nullptr);
 
-                execvp (argv[0], argv.getRawDataPointer());
-                exit (-1);
-            }
-            else
+       #if JUCE_ANDROID
+        const pid_t result = fork();
+
+        if (result == 0)
+        {
+            // we're the child process..
+            close (outputPipe[0]);
+            redirectStream (streamFlags & wantStdOut, outputPipe[1], STDOUT_FILENO);
+            redirectStream (streamFlags & wantStdErr, outputPipe[1], STDERR_FILENO);
+            close (outputPipe[1]);
+
+            if (inputPipe[0] >= 0)
             {
-                // we're the parent process..
-                childPID = result;
-                pipeHandle = pipeHandles[0];
-                close (pipeHandles[1]); // close the write handle
+                close (inputPipe[1]);
+                dup2 (inputPipe[0], STDIN_FILENO);
+                close (inputPipe[0]);
             }
+
+            execvp (argv[0], argv.getRawDataPointer());
+            _exit (-1);
+        }
+       #else
+        // posix_spawn avoids copying this process's page tables the way that fork() does,
+        // which makes launching much quicker when the parent is using a lot of memory.
+        pid_t result = -1;
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init (&actions);
+
+        if ((streamFlags & wantStdOut) != 0)
+            posix_spawn_file_actions_adddup2 (&actions, outputPipe[1], STDOUT_FILENO);
+        else
+            posix_spawn_file_actions_addclose (&actions, STDOUT_FILENO);
+
+        if ((streamFlags & wantStdErr) != 0)
+            posix_spawn_file_actions_adddup2 (&actions, outputPipe[1], STDERR_FILENO);
+        else
+            posix_spawn_file_actions_addclose (&actions, STDERR_FILENO);
+
+        posix_spawn_file_actions_addclose (&actions, outputPipe[1]);
+
+        if (inputPipe[0] >= 0)
+        {
+            posix_spawn_file_actions_adddup2 (&actions, inputPipe[0], STDIN_FILENO);
+            posix_spawn_file_actions_addclose (&actions, inputPipe[0]);
+        }
+
+        // (an ignored SIGPIPE would otherwise be inherited by the child)
+        posix_spawnattr_t attributes;
+        posix_spawnattr_init (&attributes);
+
+        sigset_t defaultSignals;
+        sigemptyset (&defaultSignals);
+        sigaddset (&defaultSignals, SIGPIPE);
+        posix_spawnattr_setsigdefault (&attributes, &defaultSignals);
+        posix_spawnattr_setflags (&attributes, POSIX_SPAWN_SETSIGDEF);
+
+        if (posix_spawnp (&result, argv[0], &actions, &attributes,
+                          argv.getRawDataPointer(), getEnvironment()) != 0)
+            result = -1;
+
+        posix_spawnattr_destroy (&attributes);
+        posix_spawn_file_actions_destroy (&actions);
+       #endif
+
+        close (outputPipe[1]);
+
+        if (inputPipe[0] >= 0)
+            close (inputPipe[0]);
+
+        if (result > 0)
+        {
+            childPID = result;
+            readHandle = outputPipe[0];
+            writeHandle = inputPipe[1];
+        }
+        else
+        {
+            close (outputPipe[0]);
+
+            if (inputPipe[1] >= 0)
+                close (inputPipe[1]);
         }
     }
 
     ~ActiveProcess()
     {
-        if (readHandle != 0)
-            fclose (readHandle);
+        if (readHandle >= 0)
+            close (readHandle);
 
-        if (pipeHandle != 0)
-            close (pipeHandle);
+        closeInput();
     }
 
     bool isRunning() const noexcept
     {
-        if (childPID != 0)
+        if (childPID != 0 && exitStatus < 0)
         {
-            int childState;
+            int childState = 0;
             const int pid = waitpid (childPID, &childState, WNOHANG);
-            return pid == 0 || ! (WIFEXITED (childState) || WIFSIGNALED (childState));
+
+            if (pid == 0)
+                return true;
+
+            // (once waitpid has reaped the child, its status can't be asked for again)
+            exitStatus = (pid == childPID && WIFEXITED (childState)) ? WEXITSTATUS (childState) : 0;
         }
 
         return false;
     }
 
+    bool waitForExit (const int timeoutMs) const noexcept
+    {
+        const uint32 timeoutTime = Time::getMillisecondCounter() + (uint32) timeoutMs;
+        int sleepMs = 0;
+
+        // There's no portable way to wait for a child with a timeout, so this polls, but
+        // backs off so that a long wait doesn't burn a whole core.
+        while (isRunning())
+        {
+            if (timeoutMs >= 0 && Time::getMillisecondCounter() >= timeoutTime)
+                return false;
+
+            if (sleepMs == 0)
+                Thread::yield();
+            else
+                Thread::sleep (sleepMs);
+
+            sleepMs = jmin (sleepMs + 1, 10);
+        }
+
+        return true;
+    }
+
     int read (void* const dest, const int numBytes) noexcept
+    {
+        jassert (dest != nullptr);
+        int total = 0;
+
+        while (readHandle >= 0 && total < numBytes)
+        {
+            const ssize_t numRead = ::read (readHandle, addBytesToPointer (dest, total), (size_t) (numBytes - total));
+
+            if (numRead > 0)
+                total += (int) numRead;
+            else if (numRead == 0 || errno != EINTR)
+                break;
+        }
+
+        return total;
+    }
+
+    int readAvailable (void* const dest, const int numBytes) noexcept
     {
         jassert (dest != nullptr);
 
-        #ifdef fdopen
-         #error // the zlib headers define this function as NULL!
-        #endif
+        if (readHandle < 0)
+            return -1;
 
-        if (readHandle == 0 && childPID != 0)
-            readHandle = fdopen (pipeHandle, "r");
+        if (! waitForOutput (0))
+            return 0;
 
-        if (readHandle != 0)
-            return (int) fread (dest, 1, (size_t) numBytes, readHandle);
+        // (poll() has said that this won't block)
+        const ssize_t numRead = ::read (readHandle, dest, (size_t) numBytes);
 
-        return 0;
+        if (numRead > 0)
+            return (int) numRead;
+
+        return (numRead < 0 && (errno == EINTR || errno == EAGAIN)) ? 0 : -1;
     }
 
-    bool killProcess() const noexcept
+    bool waitForOutput (const int timeoutMs) const noexcept
     {
-        return ::kill (childPID, SIGKILL) == 0;
+        if (readHandle < 0)
+            return true;
+
+        struct pollfd pfd;
+        pfd.fd = readHandle;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        return poll (&pfd, 1, timeoutMs) > 0;
     }
 
-    uint32 getExitCode() const noexcept
+    int write (const void* const source, const int numBytes) noexcept
     {
-        if (childPID != 0)
+        jassert (source != nullptr);
+
+        if (writeHandle < 0)
+            return -1;
+
+        int total = 0;
+
+        while (total < numBytes)
         {
-            int childState = 0;
-            const int pid = waitpid (childPID, &childState, WNOHANG);
+            const ssize_t numWritten = ::write (writeHandle, addBytesToPointer (source, total), (size_t) (numBytes - total));
 
-            if (pid >= 0 && WIFEXITED (childState))
-                return WEXITSTATUS (childState);
+            if (numWritten > 0)
+                total += (int) numWritten;
+            else if (numWritten < 0 && errno == EINTR)
+                continue;
+            else
+                return -1;
         }
 
-        return 0;
+        return total;
+    }
+
+    void closeInput() noexcept
+    {
+        if (writeHandle >= 0)
+        {
+            close (writeHandle);
+            writeHandle = -1;
+        }
+    }
+
+    bool killProcess() const noexcept
+    {
+        return ::kill (childPID, SIGKILL) == 0;
+    }
+
+    uint32 getExitCode() const noexcept
+    {
+        return isRunning() ? 0 : (uint32) exitStatus;
     }
 
     int childPID;
 
 private:
-    int pipeHandle;
-    FILE* readHandle;
+    int readHandle, writeHandle;
+    mutable int exitStatus;
+
+    static void closePipe (int* handles) noexcept
+    {
+        close (handles[0]);
+        close (handles[1]);
+    }
+
+   #if JUCE_ANDROID
+    static void redirectStream (int wanted, int pipeHandle, int stream) noexcept
+    {
+        if (wanted != 0)
+            dup2 (pipeHandle, stream);
+        else
+            close (stream);
+    }
+   #else
+    static char** getEnvironment() noexcept
+    {
+       #if JUCE_MAC || JUCE_IOS
+        return *_NSGetEnviron();
+       #else
+        return ::environ;
+       #endif
+    }
+   #endif
+
+    static void ignoreBrokenPipeSignals() noexcept
+    {
+        struct ::sigaction current;
+
+        if (::sigaction (SIGPIPE, nullptr, &current) == 0 && current.sa_handler == SIG_DFL)
+            signal (SIGPIPE, SIG_IGN);
+    }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ActiveProcess)
 };
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+class SharedMemoryChannel::Pimpl
+{
+public:
+    Pimpl (const String& channelName, const bool create, const size_t size)
+       : name ("/juce_" + String::toHexString (channelName.hashCode64())),
+         handle (-1), data (nullptr), dataSize (0), createdChannel (create)
+    {
+       #if ! JUCE_ANDROID
+        handle = create ? shm_open (name.toUTF8(), O_RDWR | O_CREAT | O_EXCL, 0600)
+                        : shm_open (name.toUTF8(), O_RDWR, 0);
+
+        if (handle < 0)
+            return;
+
+        if (create)
+        {
+            if (ftruncate (handle, (off_t) size) != 0)
+                return;
+
+            dataSize = size;
+        }
+        else
+        {
+            struct stat info;
+
+            if (fstat (handle, &info) != 0 || info.st_size <= 0)
+                return;
+
+            dataSize = (size_t) info.st_size;
+        }
+
+        void* const m = mmap (nullptr, dataSize, PROT_READ | PROT_WRITE, MAP_SHARED, handle, 0);
+
+        if (m != MAP_FAILED)
+            data = m;
+       #else
+        ignoreUnused (create, size);
+       #endif
+    }
+
+    ~Pimpl()
+    {
+       #if ! JUCE_ANDROID
+        if (data != nullptr)
+            munmap (data, dataSize);
+
+        if (handle >= 0)
+        {
+            ::close (handle);
+
+            if (createdChannel)
+                shm_unlink (name.toUTF8());
+        }
+       #endif
+    }
+
+    bool isValid() const noexcept       { return data != nullptr; }
+    void* getData() const noexcept      { return data; }
+    size_t getSize() const noexcept     { return dataSize; }
+
+    void wait (Atomic<int>& signal, int /*signalIndex*/, const int expectedValue, const int timeOutMs)
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        // (the futex isn't a private one, so that it works across processes)
+        struct timespec timeout;
+        timeout.tv_sec = timeOutMs / 1000;
+        timeout.tv_nsec = (timeOutMs % 1000) * 1000000;
+
+        syscall (SYS_futex, &(signal.value), FUTEX_WAIT, expectedValue, &timeout, nullptr, 0);
+       #else
+        // Without futexes, this just polls the value. It's slower to react, but it only
+        // happens when the reader has already spun for a while without getting a message.
+        for (int i = 0; i < timeOutMs && signal.get() == expectedValue; ++i)
+            Thread::sleep (1);
+       #endif
+    }
+
+    void wake (Atomic<int>& signal, int /*signalIndex*/)
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        syscall (SYS_futex, &(signal.value), FUTEX_WAKE, std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+       #else
+        ignoreUnused (signal);
+       #endif
+    }
+
+private:
+    const String name;
+    int handle;
+    void* data;
+    size_t dataSize;
+    const bool createdChannel;
+
+    JUCE_DECLARE_NON_COPYABLE (Pimpl)
+};
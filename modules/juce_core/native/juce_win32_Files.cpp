@@ -234,6 +234,11 @@ int64 juce_fileSetPosition (void* handle, int64 pos)
     return li.QuadPart;
 }
 
+void juce_fileSetSequentialAccessHint (void*, bool)
+{
+    // Windows files are opened with FILE_FLAG_SEQUENTIAL_SCAN, which can't be changed afterwards
+}
+
 void FileInputStream::openHandle()
 {
     HANDLE h = CreateFile (file.getFullPathName().toWideCharPointer(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, 0,
@@ -306,6 +311,52 @@ ssize_t FileOutputStream::writeInternal (const void* buffer, size_t numBytes)
     return 0;
 }
 
+ssize_t FileOutputStream::writeInternal (const void* data1, size_t numBytes1,
+                                         const void* data2, size_t numBytes2)
+{
+    const ssize_t written = writeInternal (data1, numBytes1);
+
+    if (written != (ssize_t) numBytes1)
+        return written;
+
+    return written + jmax ((ssize_t) 0, writeInternal (data2, numBytes2));
+}
+
+void FileOutputStream::writeBehind (ssize_t)
+{
+}
+
+void FileOutputStream::setBypassesFileCache (bool shouldBypassCache)
+{
+    flushBuffer();
+    bypassesCache = shouldBypassCache;
+}
+
+Result FileOutputStream::preallocate (int64 totalNumBytes)
+{
+    if (fileHandle == nullptr)
+        return status;
+
+   #if ! JUCE_MINGW
+    // (unlike SetFileValidData, this doesn't need admin privileges, and doesn't change the file's
+    // length - but asking for less than the current length would truncate it)
+    LARGE_INTEGER currentSize;
+
+    if (GetFileSizeEx ((HANDLE) fileHandle, &currentSize) && totalNumBytes > currentSize.QuadPart)
+    {
+        FILE_ALLOCATION_INFO info;
+        info.AllocationSize.QuadPart = totalNumBytes;
+
+        if (! SetFileInformationByHandle ((HANDLE) fileHandle, FileAllocationInfo, &info, sizeof (info)))
+            return WindowsFileHelpers::getResultForLastError();
+    }
+   #else
+    ignoreUnused (totalNumBytes);
+   #endif
+
+    return Result::ok();
+}
+
 void FileOutputStream::flushInternal()
 {
     if (fileHandle != nullptr)
@@ -378,6 +429,48 @@ MemoryMappedFile::~MemoryMappedFile()
         CloseHandle ((HANDLE) fileHandle);
 }
 
+void MemoryMappedFile::setAccessPattern (AccessPattern) noexcept
+{
+    // Windows only lets you give a hint about this when the file is opened.
+}
+
+void MemoryMappedFile::prefetch (Range<int64> fileRange) const noexcept
+{
+    // PrefetchVirtualMemory is only available from Windows 8 onwards.
+    struct RangeEntry  { PVOID virtualAddress; SIZE_T numberOfBytes; };
+    typedef BOOL (WINAPI* PrefetchVirtualMemoryFunction) (HANDLE, ULONG_PTR, RangeEntry*, ULONG);
+
+    static PrefetchVirtualMemoryFunction prefetchVirtualMemory
+        = (PrefetchVirtualMemoryFunction) GetProcAddress (GetModuleHandleA ("kernel32.dll"), "PrefetchVirtualMemory");
+
+    void* start;
+    size_t numBytes;
+
+    if (prefetchVirtualMemory != nullptr && getPageRange (fileRange, start, numBytes))
+    {
+        RangeEntry entry = { start, numBytes };
+        prefetchVirtualMemory (GetCurrentProcess(), 1, &entry, 0);
+    }
+}
+
+bool MemoryMappedFile::lockInMemory (Range<int64> fileRange) noexcept
+{
+    void* start;
+    size_t numBytes;
+
+    return getPageRange (fileRange, start, numBytes)
+            && VirtualLock (start, numBytes) != 0;
+}
+
+void MemoryMappedFile::unlockFromMemory (Range<int64> fileRange) noexcept
+{
+    void* start;
+    size_t numBytes;
+
+    if (getPageRange (fileRange, start, numBytes))
+        VirtualUnlock (start, numBytes);
+}
+
 //==============================================================================
 int64 File::getSize() const
 {
@@ -705,7 +798,15 @@ public:
 
         if (handle == INVALID_HANDLE_VALUE)
         {
-            handle = FindFirstFile (directoryWithWildCard.toWideCharPointer(), &findData);
+            // FindExInfoBasic skips looking up the short 8.3 name, and FIND_FIRST_EX_LARGE_FETCH
+            // asks for bigger batches of entries per call - both are only understood by Windows 7
+            // and later, so on older systems this falls back to a plain FindFirstFile.
+            handle = FindFirstFileEx (directoryWithWildCard.toWideCharPointer(),
+                                      (FINDEX_INFO_LEVELS) 1 /* FindExInfoBasic */, &findData,
+                                      FindExSearchNameMatch, nullptr, 2 /* FIND_FIRST_EX_LARGE_FETCH */);
+
+            if (handle == INVALID_HANDLE_VALUE && GetLastError() == ERROR_INVALID_PARAMETER)
+                handle = FindFirstFile (directoryWithWildCard.toWideCharPointer(), &findData);
 
             if (handle == INVALID_HANDLE_VALUE)
                 return false;
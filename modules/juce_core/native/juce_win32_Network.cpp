@@ -38,13 +38,20 @@
 class WebInputStream  : public InputStream
 {
 public:
-    WebInputStream (const String& address_, bool isPost_, const MemoryBlock& postData_,
+    WebInputStream (const String& address_, bool isPost_, const MemoryBlock& postData_, InputStream* postDataStream,
                     URL::OpenStreamProgressCallback* progressCallback, void* progressCallbackContext,
                     const String& headers_, int timeOutMs_, StringPairArray* responseHeaders, int numRedirectsToFollow)
       : statusCode (0), connection (0), request (0),
         address (address_), headers (headers_), postData (postData_), position (0),
         finished (false), isPost (isPost_), timeOutMs (timeOutMs_)
     {
+        // (a streamed body is read in here, as the request may need to be re-sent for a redirect)
+        if (postDataStream != nullptr)
+        {
+            const ScopedPointer<InputStream> source (postDataStream);
+            source->readIntoMemoryBlock (postData);
+        }
+
         while (numRedirectsToFollow-- >= 0)
         {
             createConnection (progressCallback, progressCallbackContext);
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+class SharedMemoryChannel::Pimpl
+{
+public:
+    Pimpl (const String& channelName, const bool create, const size_t size)
+       : mapping (0), data (nullptr), dataSize (0)
+    {
+        const String name ("Local\\juce_shm_" + String::toHexString (channelName.hashCode64()));
+
+        if (create)
+        {
+            mapping = CreateFileMapping (INVALID_HANDLE_VALUE, 0, PAGE_READWRITE,
+                                         (DWORD) (((uint64) size) >> 32), (DWORD) size,
+                                         name.toWideCharPointer());
+
+            if (mapping != 0 && GetLastError() == ERROR_ALREADY_EXISTS)
+                return;
+        }
+        else
+        {
+            mapping = OpenFileMapping (FILE_MAP_ALL_ACCESS, FALSE, name.toWideCharPointer());
+        }
+
+        if (mapping == 0)
+            return;
+
+        data = MapViewOfFile (mapping, FILE_MAP_ALL_ACCESS, 0, 0, create ? size : 0);
+
+        if (data == nullptr)
+            return;
+
+        if (create)
+        {
+            dataSize = size;
+        }
+        else
+        {
+            MEMORY_BASIC_INFORMATION info;
+
+            if (VirtualQuery (data, &info, sizeof (info)) != 0)
+                dataSize = (size_t) info.RegionSize;
+        }
+
+        for (int i = 0; i < numElementsInArray (events); ++i)
+            events[i] = CreateEvent (0, FALSE, FALSE, (name + "_" + String (i)).toWideCharPointer());
+    }
+
+    ~Pimpl()
+    {
+        if (data != nullptr)
+        {
+            UnmapViewOfFile (data);
+
+            for (int i = 0; i < numElementsInArray (events); ++i)
+                if (events[i] != 0)
+                    CloseHandle (events[i]);
+        }
+
+        if (mapping != 0)
+            CloseHandle (mapping);
+    }
+
+    bool isValid() const noexcept       { return data != nullptr && dataSize > 0; }
+    void* getData() const noexcept      { return data; }
+    size_t getSize() const noexcept     { return dataSize; }
+
+    void wait (Atomic<int>&, const int signalIndex, int /*expectedValue*/, const int timeOutMs)
+    {
+        // (these are auto-reset events, so a wake-up that happens just before we start
+        // waiting is still seen)
+        WaitForSingleObject (events[signalIndex], (DWORD) timeOutMs);
+    }
+
+    void wake (Atomic<int>&, const int signalIndex)
+    {
+        SetEvent (events[signalIndex]);
+    }
+
+private:
+    HANDLE mapping;
+    void* data;
+    size_t dataSize;
+    HANDLE events[4];
+
+    JUCE_DECLARE_NON_COPYABLE (Pimpl)
+};
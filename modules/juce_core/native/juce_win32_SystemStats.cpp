@@ -47,7 +47,25 @@ void Logger::outputDebugString (const String& text)
 
 static void callCPUID (int result[4], int infoType)
 {
-    __cpuid (result, infoType);
+    __cpuidex (result, infoType, 0);
+}
+
+static bool isAVXStateEnabledByOS()
+{
+   #if _MSC_FULL_VER >= 160040219  // _xgetbv was added in VS2010 SP1
+    return (_xgetbv (0) & 6) == 6;
+   #else
+    return false;
+   #endif
+}
+
+static bool isAVX512StateEnabledByOS()
+{
+   #if _MSC_FULL_VER >= 160040219
+    return (_xgetbv (0) & 0xe6) == 0xe6;
+   #else
+    return false;
+   #endif
 }
 
 #else
@@ -59,7 +77,7 @@ static void callCPUID (int result[4], int infoType)
    #endif
     {
        #if JUCE_GCC
-        __asm__ __volatile__ ("cpuid" : "=a" (result[0]), "=b" (result[1]), "=c" (result[2]),"=d" (result[3]) : "a" (infoType));
+        __asm__ __volatile__ ("cpuid" : "=a" (result[0]), "=b" (result[1]), "=c" (result[2]),"=d" (result[3]) : "a" (infoType), "c" (0));
        #else
         __asm
         {
@@ -79,6 +97,28 @@ static void callCPUID (int result[4], int infoType)
    #endif
 }
 
+static bool isAVXStateEnabledByOS()
+{
+   #if JUCE_GCC
+    unsigned int eax, edx;
+    __asm__ __volatile__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+    return (eax & 6) == 6;
+   #else
+    return false;
+   #endif
+}
+
+static bool isAVX512StateEnabledByOS()
+{
+   #if JUCE_GCC
+    unsigned int eax, edx;
+    __asm__ __volatile__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+    return (eax & 0xe6) == 0xe6;
+   #else
+    return false;
+   #endif
+}
+
 #endif
 
 String SystemStats::getCpuVendor()
@@ -107,9 +147,102 @@ void CPUInformation::initialise() noexcept
     hasSSE3  = (info[2] & (1 <<  0)) != 0;
     has3DNow = (info[1] & (1 << 31)) != 0;
 
+    // AVX needs the OS to be saving the extended register state as well as CPU support
+    if ((info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && isAVXStateEnabledByOS())
+    {
+        hasAVX  = true;
+        hasFMA3 = (info[2] & (1 << 12)) != 0;
+
+        callCPUID (info, 0);
+
+        if (info[0] >= 7)
+        {
+            callCPUID (info, 7);
+            hasAVX2    = (info[1] & (1 << 5)) != 0;
+            hasAVX512F = (info[1] & (1 << 16)) != 0 && isAVX512StateEnabledByOS();
+        }
+    }
+
     SYSTEM_INFO systemInfo;
     GetNativeSystemInfo (&systemInfo);
     numCpus = (int) systemInfo.dwNumberOfProcessors;
+
+    readProcessorTopology();
+}
+
+void CPUInformation::readProcessorTopology() noexcept
+{
+    // GetLogicalProcessorInformationEx is only available from Windows 7 onwards. Its structures
+    // are declared here because older SDKs don't have them, or lack the efficiency class.
+    struct GroupAffinity    { ULONG_PTR mask; WORD group; WORD reserved[3]; };
+    struct CoreInfo         { BYTE flags, efficiencyClass, reserved[20]; WORD groupCount; GroupAffinity groupMask[1]; };
+    struct CacheInfo        { BYTE level, associativity; WORD lineSize; DWORD cacheSize; int type; };
+    struct ProcessorInfo    { DWORD relationship, size; union { CoreInfo core; CacheInfo cache; } info; };
+
+    enum { relationProcessorCore = 0, relationNumaNode = 1, relationCache = 2, relationAll = 0xffff, instructionCache = 1 };
+
+    typedef BOOL (WINAPI* GetLogicalProcessorInformationExFunction) (int, ProcessorInfo*, DWORD*);
+
+    static GetLogicalProcessorInformationExFunction getLogicalProcessorInformationEx
+        = (GetLogicalProcessorInformationExFunction) GetProcAddress (GetModuleHandleA ("kernel32.dll"), "GetLogicalProcessorInformationEx");
+
+    if (getLogicalProcessorInformationEx == nullptr)
+        return;
+
+    DWORD size = 0;
+    getLogicalProcessorInformationEx (relationAll, nullptr, &size);
+
+    if (size == 0)
+        return;
+
+    HeapBlock<char> buffer (size);
+
+    if (! getLogicalProcessorInformationEx (relationAll, (ProcessorInfo*) buffer.getData(), &size))
+        return;
+
+    // On a hybrid CPU, the performance cores have the highest efficiency class
+    int maxEfficiencyClass = 0;
+
+    for (DWORD pos = 0; pos < size;)
+    {
+        const ProcessorInfo& p = *(const ProcessorInfo*) (buffer + pos);
+
+        if (p.relationship == relationProcessorCore)
+            maxEfficiencyClass = jmax (maxEfficiencyClass, (int) p.info.core.efficiencyClass);
+
+        pos += p.size;
+    }
+
+    for (DWORD pos = 0; pos < size;)
+    {
+        const ProcessorInfo& p = *(const ProcessorInfo*) (buffer + pos);
+
+        if (p.relationship == relationProcessorCore)
+        {
+            ++numPhysicalCpus;
+
+            if (p.info.core.efficiencyClass == maxEfficiencyClass)
+            {
+                ++numPerformanceCores;
+
+                if (p.info.core.groupMask[0].group == 0)
+                    performanceCpuMask |= (uint32) p.info.core.groupMask[0].mask;
+            }
+        }
+        else if (p.relationship == relationNumaNode)
+        {
+            ++numNumaNodes;
+        }
+        else if (p.relationship == relationCache)
+        {
+            const int level = p.info.cache.level;
+
+            if (level >= 1 && level <= 3 && p.info.cache.type != instructionCache)
+                cacheSizesKb [level - 1] = jmax (cacheSizesKb [level - 1], (int) (p.info.cache.cacheSize / 1024));
+        }
+
+        pos += p.size;
+    }
 }
 
 #if JUCE_MSVC && JUCE_CHECK_MEMORY_LEAKS
@@ -72,7 +72,20 @@ CriticalSection::CriticalSection() noexcept
 }
 
 CriticalSection::~CriticalSection() noexcept        { DeleteCriticalSection ((CRITICAL_SECTION*) lock); }
-void CriticalSection::enter() const noexcept        { EnterCriticalSection ((CRITICAL_SECTION*) lock); }
+
+void CriticalSection::enter() const noexcept
+{
+   #if JUCE_CHECK_REALTIME_SAFETY
+    // (taking a free lock is cheap, so it's only a problem if this would have to wait)
+    if (juce_isInRealtimeContext() && TryEnterCriticalSection ((CRITICAL_SECTION*) lock) != FALSE)
+        return;
+
+    JUCE_ASSERT_NOT_REALTIME ("CriticalSection::enter() on a contended lock");
+   #endif
+
+    EnterCriticalSection ((CRITICAL_SECTION*) lock);
+}
+
 bool CriticalSection::tryEnter() const noexcept     { return TryEnterCriticalSection ((CRITICAL_SECTION*) lock) != FALSE; }
 void CriticalSection::exit() const noexcept         { LeaveCriticalSection ((CRITICAL_SECTION*) lock); }
 
@@ -91,6 +104,55 @@ bool WaitableEvent::wait (const int timeOutMs) const noexcept
     return WaitForSingleObject (handle, (DWORD) timeOutMs) == WAIT_OBJECT_0;
 }
 
+//==============================================================================
+// WaitOnAddress is only available from Windows 8 onwards. On older systems, waiting threads
+// just sleep briefly and then check the value again.
+struct WaitOnAddressFunctions
+{
+    WaitOnAddressFunctions() noexcept
+        : waitOnAddress (nullptr), wakeByAddressSingle (nullptr), wakeByAddressAll (nullptr)
+    {
+        if (HMODULE dll = LoadLibraryA ("API-MS-Win-Core-Synch-l1-2-0.dll"))
+        {
+            waitOnAddress       = (WaitOnAddressFunction)   GetProcAddress (dll, "WaitOnAddress");
+            wakeByAddressSingle = (WakeByAddressFunction)   GetProcAddress (dll, "WakeByAddressSingle");
+            wakeByAddressAll    = (WakeByAddressFunction)   GetProcAddress (dll, "WakeByAddressAll");
+        }
+    }
+
+    typedef BOOL (WINAPI* WaitOnAddressFunction) (volatile VOID*, PVOID, SIZE_T, DWORD);
+    typedef void (WINAPI* WakeByAddressFunction) (PVOID);
+
+    WaitOnAddressFunction waitOnAddress;
+    WakeByAddressFunction wakeByAddressSingle, wakeByAddressAll;
+
+    static const WaitOnAddressFunctions& getInstance() noexcept
+    {
+        static WaitOnAddressFunctions functions;
+        return functions;
+    }
+};
+
+void juce_waitOnAddress (const volatile int* address, int expectedValue, int timeOutMs) noexcept
+{
+    const WaitOnAddressFunctions& functions = WaitOnAddressFunctions::getInstance();
+
+    if (functions.waitOnAddress != nullptr)
+        functions.waitOnAddress ((volatile VOID*) address, &expectedValue, sizeof (int),
+                                 timeOutMs < 0 ? INFINITE : (DWORD) timeOutMs);
+    else if (*address == expectedValue)
+        Sleep (timeOutMs == 0 ? 0 : 1);
+}
+
+void juce_wakeAddress (const volatile int* address, bool wakeAllWaiters) noexcept
+{
+    const WaitOnAddressFunctions& functions = WaitOnAddressFunctions::getInstance();
+
+    if (functions.waitOnAddress != nullptr)
+        (wakeAllWaiters ? functions.wakeByAddressAll
+                        : functions.wakeByAddressSingle) ((PVOID) address);
+}
+
 //==============================================================================
 void JUCE_API juce_threadEntryPoint (void*);
 
@@ -163,6 +225,96 @@ Thread::ThreadID JUCE_CALLTYPE Thread::getCurrentThreadId()
     return (ThreadID) (pointer_sized_int) GetCurrentThreadId();
 }
 
+//==============================================================================
+// Fibre-local storage is used where it's available (Vista onwards), because unlike the
+// older TLS functions, it can call back when a thread exits.
+struct FlsFunctions
+{
+    FlsFunctions() noexcept
+    {
+        HMODULE kernel = GetModuleHandleA ("kernel32.dll");
+
+        flsAlloc    = (FlsAllocFunction)    GetProcAddress (kernel, "FlsAlloc");
+        flsFree     = (FlsFreeFunction)     GetProcAddress (kernel, "FlsFree");
+        flsGetValue = (FlsGetValueFunction) GetProcAddress (kernel, "FlsGetValue");
+        flsSetValue = (FlsSetValueFunction) GetProcAddress (kernel, "FlsSetValue");
+
+        if (flsAlloc == nullptr || flsFree == nullptr || flsGetValue == nullptr || flsSetValue == nullptr)
+            flsAlloc = nullptr;
+    }
+
+    typedef DWORD (WINAPI* FlsAllocFunction) (NativeThreadLocalSlot::ThreadExitCallback);
+    typedef BOOL  (WINAPI* FlsFreeFunction) (DWORD);
+    typedef PVOID (WINAPI* FlsGetValueFunction) (DWORD);
+    typedef BOOL  (WINAPI* FlsSetValueFunction) (DWORD, PVOID);
+
+    FlsAllocFunction flsAlloc;
+    FlsFreeFunction flsFree;
+    FlsGetValueFunction flsGetValue;
+    FlsSetValueFunction flsSetValue;
+
+    static const FlsFunctions& getInstance() noexcept
+    {
+        static FlsFunctions functions;
+        return functions;
+    }
+};
+
+NativeThreadLocalSlot::NativeThreadLocalSlot (ThreadExitCallback threadExitCallback) noexcept
+    : slot (0), valid (false)
+{
+    const FlsFunctions& fls = FlsFunctions::getInstance();
+
+    const DWORD index = fls.flsAlloc != nullptr ? fls.flsAlloc (threadExitCallback)
+                                                : TlsAlloc();
+
+    if (index != TLS_OUT_OF_INDEXES) // (which has the same value as FLS_OUT_OF_INDEXES)
+    {
+        slot = (pointer_sized_uint) index;
+        valid = true;
+    }
+    else
+    {
+        jassertfalse; // run out of thread-local indexes!
+    }
+}
+
+NativeThreadLocalSlot::~NativeThreadLocalSlot()
+{
+    if (valid)
+    {
+        const FlsFunctions& fls = FlsFunctions::getInstance();
+
+        if (fls.flsAlloc != nullptr)
+            fls.flsFree ((DWORD) slot);
+        else
+            TlsFree ((DWORD) slot);
+    }
+}
+
+void* NativeThreadLocalSlot::get() const noexcept
+{
+    if (! valid)
+        return nullptr;
+
+    const FlsFunctions& fls = FlsFunctions::getInstance();
+    return fls.flsAlloc != nullptr ? fls.flsGetValue ((DWORD) slot)
+                                   : TlsGetValue ((DWORD) slot);
+}
+
+void NativeThreadLocalSlot::set (void* newValue) const noexcept
+{
+    if (valid)
+    {
+        const FlsFunctions& fls = FlsFunctions::getInstance();
+
+        if (fls.flsAlloc != nullptr)
+            fls.flsSetValue ((DWORD) slot, newValue);
+        else
+            TlsSetValue ((DWORD) slot, newValue);
+    }
+}
+
 bool Thread::setThreadPriority (void* handle, int priority)
 {
     int pri = THREAD_PRIORITY_TIME_CRITICAL;
@@ -185,6 +337,27 @@ void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask (const uint32 affinityMa
     SetThreadAffinityMask (GetCurrentThread(), affinityMask);
 }
 
+bool JUCE_CALLTYPE Thread::setCurrentThreadRealtime (double, double, double, int priority)
+{
+    // MMCSS schedules the thread using the task's own settings, so the timing values aren't needed
+    static DynamicLibrary dll ("avrt.dll");
+    JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadCharacteristicsW, avSetMmThreadCharacteristics, HANDLE, (LPCWSTR, LPDWORD))
+    JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadPriority, avSetMmThreadPriority, BOOL, (HANDLE, int))
+
+    if (avSetMmThreadCharacteristics == nullptr || avSetMmThreadPriority == nullptr)
+        return setCurrentThreadPriority (priority);
+
+    DWORD taskIndex = 0;
+    HANDLE h = avSetMmThreadCharacteristics (L"Pro Audio", &taskIndex);
+
+    if (h == 0)
+        return false;
+
+    // these are the AVRT_PRIORITY_LOW, _NORMAL, _HIGH and _CRITICAL values from avrt.h
+    const int mmcssPriority = priority < 5 ? -1 : (priority < 9 ? 0 : (priority < 10 ? 1 : 2));
+    return avSetMmThreadPriority (h, mmcssPriority) != FALSE;
+}
+
 //==============================================================================
 struct SleepEvent
 {
@@ -211,6 +384,7 @@ static SleepEvent sleepEvent;
 void JUCE_CALLTYPE Thread::sleep (const int millisecs)
 {
     jassert (millisecs >= 0);
+    JUCE_ASSERT_NOT_REALTIME ("Thread::sleep()");
 
     if (millisecs >= 10 || sleepEvent.handle == 0)
         Sleep ((DWORD) millisecs);
@@ -445,7 +619,7 @@ class ChildProcess::ActiveProcess
 {
 public:
     ActiveProcess (const String& command, int streamFlags)
-        : ok (false), readPipe (0), writePipe (0)
+        : ok (false), readPipe (0), writePipe (0), inputReadPipe (0), inputWritePipe (0)
     {
         SECURITY_ATTRIBUTES securityAtts = { 0 };
         securityAtts.nLength = sizeof (securityAtts);
@@ -454,16 +628,26 @@ public:
         if (CreatePipe (&readPipe, &writePipe, &securityAtts, 0)
              && SetHandleInformation (readPipe, HANDLE_FLAG_INHERIT, 0))
         {
+            if ((streamFlags & wantStdIn) != 0
+                 && ! (CreatePipe (&inputReadPipe, &inputWritePipe, &securityAtts, 0)
+                        && SetHandleInformation (inputWritePipe, HANDLE_FLAG_INHERIT, 0)))
+                return;
+
             STARTUPINFOW startupInfo = { 0 };
             startupInfo.cb = sizeof (startupInfo);
 
-            startupInfo.hStdOutput = (streamFlags | wantStdOut) != 0 ? writePipe : 0;
-            startupInfo.hStdError  = (streamFlags | wantStdErr) != 0 ? writePipe : 0;
+            startupInfo.hStdOutput = (streamFlags & wantStdOut) != 0 ? writePipe : 0;
+            startupInfo.hStdError  = (streamFlags & wantStdErr) != 0 ? writePipe : 0;
+            startupInfo.hStdInput  = inputReadPipe;
             startupInfo.dwFlags = STARTF_USESTDHANDLES;
 
             ok = CreateProcess (nullptr, const_cast <LPWSTR> (command.toWideCharPointer()),
                                 nullptr, nullptr, TRUE, CREATE_NO_WINDOW | CREATE_UNICODE_ENVIRONMENT,
                                 nullptr, nullptr, &startupInfo, &processInfo) != FALSE;
+
+            // (the child has its own copy of this now, and it must be closed here so that
+            // the child sees the end of its input when closeInput() is called)
+            closeHandle (inputReadPipe);
         }
     }
 
@@ -475,11 +659,10 @@ public:
             CloseHandle (processInfo.hProcess);
         }
 
-        if (readPipe != 0)
-            CloseHandle (readPipe);
-
-        if (writePipe != 0)
-            CloseHandle (writePipe);
+        closeHandle (readPipe);
+        closeHandle (writePipe);
+        closeHandle (inputReadPipe);
+        closeHandle (inputWritePipe);
     }
 
     bool isRunning() const noexcept
@@ -487,6 +670,11 @@ public:
         return WaitForSingleObject (processInfo.hProcess, 0) != WAIT_OBJECT_0;
     }
 
+    bool waitForExit (int timeoutMs) const noexcept
+    {
+        return WaitForSingleObject (processInfo.hProcess, timeoutMs < 0 ? INFINITE : (DWORD) timeoutMs) == WAIT_OBJECT_0;
+    }
+
     int read (void* dest, int numNeeded) const noexcept
     {
         int total = 0;
@@ -522,6 +710,61 @@ public:
         return total;
     }
 
+    int readAvailable (void* dest, int numBytes) const noexcept
+    {
+        const int available = getNumBytesAvailable();
+
+        if (available < 0)
+            return -1;
+
+        DWORD numRead = 0;
+
+        if (available > 0 && ! ReadFile ((HANDLE) readPipe, dest, (DWORD) jmin (available, numBytes), &numRead, nullptr))
+            return -1;
+
+        return (int) numRead;
+    }
+
+    bool waitForOutput (int timeoutMs) const noexcept
+    {
+        // Anonymous pipes can't be waited on, so this has to poll..
+        const uint32 timeoutTime = Time::getMillisecondCounter() + (uint32) timeoutMs;
+        int sleepMs = 0;
+
+        while (getNumBytesAvailable() == 0)
+        {
+            if (timeoutMs >= 0 && Time::getMillisecondCounter() >= timeoutTime)
+                return false;
+
+            if (sleepMs == 0)
+                Thread::yield();
+            else
+                Sleep ((DWORD) sleepMs);
+
+            sleepMs = jmin (sleepMs + 1, 10);
+        }
+
+        return true;
+    }
+
+    int write (const void* source, int numBytes) noexcept
+    {
+        if (inputWritePipe == 0)
+            return -1;
+
+        DWORD numWritten = 0;
+
+        if (! WriteFile ((HANDLE) inputWritePipe, source, (DWORD) numBytes, &numWritten, nullptr))
+            return -1;
+
+        return (int) numWritten;
+    }
+
+    void closeInput() noexcept
+    {
+        closeHandle (inputWritePipe);
+    }
+
     bool killProcess() const noexcept
     {
         return TerminateProcess (processInfo.hProcess, 0) != FALSE;
@@ -537,9 +780,29 @@ public:
     bool ok;
 
 private:
-    HANDLE readPipe, writePipe;
+    HANDLE readPipe, writePipe, inputReadPipe, inputWritePipe;
     PROCESS_INFORMATION processInfo;
 
+    // Returns -1 once the pipe is empty and the process has finished.
+    int getNumBytesAvailable() const noexcept
+    {
+        DWORD available = 0;
+
+        if (! (ok && PeekNamedPipe ((HANDLE) readPipe, nullptr, 0, nullptr, &available, nullptr)))
+            return -1;
+
+        return (available == 0 && ! isRunning()) ? -1 : (int) available;
+    }
+
+    static void closeHandle (HANDLE& h) noexcept
+    {
+        if (h != 0)
+        {
+            CloseHandle (h);
+            h = 0;
+        }
+    }
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ActiveProcess)
 };
 
@@ -0,0 +1,392 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+// Each direction has one of these, which lives in the shared memory. The positions only
+// ever increase (wrapping around at 2^32), and are masked to find the offset into the
+// ring's data. The signal values are bumped whenever a position changes, so that a waiting
+// thread can go to sleep until the value it last saw changes.
+struct SharedMemoryChannel::Ring
+{
+    Atomic<uint32> writePosition;
+    char padding1[60];
+    Atomic<uint32> readPosition;
+    char padding2[60];
+    Atomic<int> dataSignal, numDataWaiters, spaceSignal, numSpaceWaiters;
+    char padding3[48];
+};
+
+struct SharedMemoryChannel::Layout
+{
+    enum
+    {
+        magicNumber = 0x4a534d31,
+        neverConnected = 0,
+        connected = 1,
+        closed = 2
+    };
+
+    uint32 magic, layoutSize, ringSize;
+    Atomic<int> endState[2];
+    char padding[48];
+    Ring rings[2];
+};
+
+namespace SharedMemoryChannelHelpers
+{
+    // Each message is stored as an 8-byte header holding its size, followed by its data,
+    // padded to a multiple of 8 bytes. A message never wraps around the end of the ring -
+    // if there isn't room for it there, the sender puts a padding marker at the end and
+    // starts again at the beginning, so that the reader can always see it in one piece.
+    enum { recordHeaderSize = 8 };
+    static const uint32 paddingMarker = 0xffffffff;
+    static const int numSpinsBeforeWaiting = 200;
+
+    static inline uint32 getRecordSize (const size_t numBytes) noexcept
+    {
+        return (uint32) ((recordHeaderSize + numBytes + 7) & ~(size_t) 7);
+    }
+
+    static inline int getRemainingTime (const int timeOutMs, const uint32 startTime) noexcept
+    {
+        if (timeOutMs < 0)
+            return 100;
+
+        const int elapsed = (int) (Time::getMillisecondCounter() - startTime);
+        return jmin (100, timeOutMs - elapsed);
+    }
+}
+
+//==============================================================================
+SharedMemoryChannel::SharedMemoryChannel()
+    : layout (nullptr), readBuffer (nullptr), writeBuffer (nullptr),
+      readRing (nullptr), writeRing (nullptr), ringSize (0),
+      readRingIndex (0), writeRingIndex (0), otherEndIndex (0),
+      pendingReadSize (0), cancelRead (false)
+{
+}
+
+SharedMemoryChannel::~SharedMemoryChannel()
+{
+    close();
+}
+
+bool SharedMemoryChannel::createNewChannel (const String& channelName, const int bufferSizeBytes)
+{
+    close();
+    currentName = channelName;
+    return openInternal (channelName, true, bufferSizeBytes);
+}
+
+bool SharedMemoryChannel::openExisting (const String& channelName)
+{
+    close();
+    currentName = channelName;
+    return openInternal (channelName, false, 0);
+}
+
+bool SharedMemoryChannel::openInternal (const String& channelName, const bool create, const int bufferSizeBytes)
+{
+    using namespace SharedMemoryChannelHelpers;
+
+    const size_t headerSize = (sizeof (Layout) + 63) & ~(size_t) 63;
+    const uint32 newRingSize = create ? (uint32) nextPowerOfTwo (jmax (4096, bufferSizeBytes)) : 0;
+
+    ScopedPointer<Pimpl> newPimpl (new Pimpl (channelName, create, headerSize + 2 * (size_t) newRingSize));
+
+    if (! newPimpl->isValid())
+        return false;
+
+    Layout* const l = static_cast<Layout*> (newPimpl->getData());
+
+    if (create)
+    {
+        l->ringSize = newRingSize;
+        l->layoutSize = (uint32) sizeof (Layout);
+        l->endState[0] = Layout::connected;
+        l->magic = Layout::magicNumber;
+    }
+    else
+    {
+        // (the creator may not have finished setting up yet, in which case this will fail,
+        // and the caller can try again)
+        if (newPimpl->getSize() < headerSize
+             || l->magic != Layout::magicNumber
+             || l->layoutSize != (uint32) sizeof (Layout)  // (e.g. a 32-bit process talking to a 64-bit one)
+             || ! isPowerOfTwo (l->ringSize)
+             || headerSize + 2 * (size_t) l->ringSize > newPimpl->getSize()
+             || ! l->endState[1].compareAndSetBool (Layout::connected, Layout::neverConnected))
+            return false;
+    }
+
+    layout = l;
+    ringSize = l->ringSize;
+    writeRingIndex = create ? 0 : 1;
+    readRingIndex = 1 - writeRingIndex;
+    otherEndIndex = readRingIndex;
+    readRing  = l->rings + readRingIndex;
+    writeRing = l->rings + writeRingIndex;
+
+    char* const data = static_cast<char*> (newPimpl->getData()) + headerSize;
+    readBuffer  = data + readRingIndex * ringSize;
+    writeBuffer = data + writeRingIndex * ringSize;
+
+    pendingReadSize = 0;
+    cancelRead = false;
+    pimpl = newPimpl;
+    return true;
+}
+
+void SharedMemoryChannel::close()
+{
+    const ScopedLock sl (writeLock);
+
+    if (pimpl != nullptr)
+    {
+        layout->endState[writeRingIndex] = Layout::closed;
+
+        // wake up anything that's waiting at the other end, so it finds that we've gone
+        for (int i = 0; i < 2; ++i)
+        {
+            Ring& r = layout->rings[i];
+            sendSignal (r.dataSignal,  r.numDataWaiters,  i * 2);
+            sendSignal (r.spaceSignal, r.numSpaceWaiters, i * 2 + 1);
+        }
+
+        pimpl = nullptr;
+        layout = nullptr;
+        readRing = writeRing = nullptr;
+        readBuffer = writeBuffer = nullptr;
+        ringSize = 0;
+        pendingReadSize = 0;
+    }
+}
+
+bool SharedMemoryChannel::isOpen() const noexcept
+{
+    return pimpl != nullptr;
+}
+
+bool SharedMemoryChannel::isOtherEndConnected() const noexcept
+{
+    return layout != nullptr && layout->endState[otherEndIndex].get() == Layout::connected;
+}
+
+bool SharedMemoryChannel::hasOtherEndDisconnected() const noexcept
+{
+    return layout != nullptr && layout->endState[otherEndIndex].get() == Layout::closed;
+}
+
+String SharedMemoryChannel::getName() const
+{
+    return currentName;
+}
+
+size_t SharedMemoryChannel::getMaxMessageSize() const noexcept
+{
+    return ringSize > 0 ? (size_t) (ringSize / 2 - SharedMemoryChannelHelpers::recordHeaderSize) : 0;
+}
+
+//==============================================================================
+void SharedMemoryChannel::waitForSignal (Atomic<int>& signal, Atomic<int>& numWaiters,
+                                         const int signalIndex, const int expectedValue, const int timeOutMs)
+{
+    if (timeOutMs <= 0)
+        return;
+
+    ++numWaiters;
+
+    if (signal.get() == expectedValue)
+        pimpl->wait (signal, signalIndex, expectedValue, timeOutMs);
+
+    --numWaiters;
+}
+
+void SharedMemoryChannel::sendSignal (Atomic<int>& signal, Atomic<int>& numWaiters, const int signalIndex)
+{
+    ++signal;
+
+    // (this avoids a system call when nobody's waiting)
+    if (numWaiters.get() > 0)
+        pimpl->wake (signal, signalIndex);
+}
+
+//==============================================================================
+bool SharedMemoryChannel::writeMessage (const void* const messageData, const size_t numBytes, const int timeOutMilliseconds)
+{
+    return writeMessage (&messageData, &numBytes, 1, timeOutMilliseconds);
+}
+
+bool SharedMemoryChannel::writeMessage (const void* const* const dataBlocks, const size_t* const blockSizes,
+                                        const int numBlocks, const int timeOutMilliseconds)
+{
+    using namespace SharedMemoryChannelHelpers;
+
+    size_t numBytes = 0;
+
+    for (int i = 0; i < numBlocks; ++i)
+        numBytes += blockSizes[i];
+
+    const ScopedLock sl (writeLock);
+
+    if (pimpl == nullptr)
+        return false;
+
+    // If this fails, the message is too big for the buffer size you chose!
+    jassert (numBytes <= getMaxMessageSize());
+
+    if (numBytes > getMaxMessageSize())
+        return false;
+
+    const uint32 recordSize = getRecordSize (numBytes);
+    const uint32 mask = ringSize - 1;
+    const uint32 startTime = Time::getMillisecondCounter();
+
+    for (;;)
+    {
+        const int signalValue = writeRing->spaceSignal.get();
+        uint32 writePos = writeRing->writePosition.get();
+        const uint32 readPos = writeRing->readPosition.get();
+
+        const uint32 spaceToEnd = ringSize - (writePos & mask);
+        const uint32 paddingNeeded = recordSize > spaceToEnd ? spaceToEnd : 0;
+
+        if (ringSize - (writePos - readPos) >= recordSize + paddingNeeded)
+        {
+            if (paddingNeeded > 0)
+            {
+                *reinterpret_cast<uint32*> (writeBuffer + (writePos & mask)) = paddingMarker;
+                writePos += paddingNeeded;
+            }
+
+            char* dest = writeBuffer + (writePos & mask);
+            *reinterpret_cast<uint32*> (dest) = (uint32) numBytes;
+            dest += recordHeaderSize;
+
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                memcpy (dest, dataBlocks[i], blockSizes[i]);
+                dest += blockSizes[i];
+            }
+
+            writeRing->writePosition = writePos + recordSize;
+            sendSignal (writeRing->dataSignal, writeRing->numDataWaiters, writeRingIndex * 2);
+            return true;
+        }
+
+        if (hasOtherEndDisconnected())
+            return false;
+
+        const int timeToWait = getRemainingTime (timeOutMilliseconds, startTime);
+
+        if (timeToWait <= 0)
+            return false;
+
+        waitForSignal (writeRing->spaceSignal, writeRing->numSpaceWaiters,
+                       writeRingIndex * 2 + 1, signalValue, timeToWait);
+    }
+}
+
+//==============================================================================
+const void* SharedMemoryChannel::waitForNextMessage (size_t& numBytes, const int timeOutMilliseconds)
+{
+    using namespace SharedMemoryChannelHelpers;
+
+    // You need to call releaseMessage() when you've finished with each message!
+    jassert (pendingReadSize == 0);
+    releaseMessage();
+
+    if (pimpl == nullptr)
+        return nullptr;
+
+    const uint32 mask = ringSize - 1;
+    const uint32 startTime = Time::getMillisecondCounter();
+    int numSpins = 0;
+
+    for (;;)
+    {
+        const int signalValue = readRing->dataSignal.get();
+        const uint32 readPos = readRing->readPosition.get();
+
+        if (readRing->writePosition.get() != readPos)
+        {
+            const char* const src = readBuffer + (readPos & mask);
+            const uint32 size = *reinterpret_cast<const uint32*> (src);
+
+            if (size == paddingMarker)
+            {
+                readRing->readPosition = readPos + (ringSize - (readPos & mask));
+                sendSignal (readRing->spaceSignal, readRing->numSpaceWaiters, readRingIndex * 2 + 1);
+                continue;
+            }
+
+            pendingReadSize = getRecordSize (size);
+            numBytes = size;
+            return src + recordHeaderSize;
+        }
+
+        if (cancelRead)
+        {
+            cancelRead = false;
+            return nullptr;
+        }
+
+        if (hasOtherEndDisconnected())
+            return nullptr;
+
+        // (spinning for a moment before going to sleep means that a quick reply
+        // can be picked up without the latency of being woken up)
+        if (++numSpins < numSpinsBeforeWaiting)
+            continue;
+
+        const int timeToWait = getRemainingTime (timeOutMilliseconds, startTime);
+
+        if (timeToWait <= 0)
+            return nullptr;
+
+        waitForSignal (readRing->dataSignal, readRing->numDataWaiters,
+                       readRingIndex * 2, signalValue, timeToWait);
+    }
+}
+
+void SharedMemoryChannel::releaseMessage()
+{
+    if (pendingReadSize > 0 && readRing != nullptr)
+    {
+        readRing->readPosition = readRing->readPosition.get() + pendingReadSize;
+        pendingReadSize = 0;
+        sendSignal (readRing->spaceSignal, readRing->numSpaceWaiters, readRingIndex * 2 + 1);
+    }
+}
+
+void SharedMemoryChannel::cancelPendingReads()
+{
+    cancelRead = true;
+
+    if (readRing != nullptr)
+        sendSignal (readRing->dataSignal, readRing->numDataWaiters, readRingIndex * 2);
+}
@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_SHAREDMEMORYCHANNEL_H_INCLUDED
+#define JUCE_SHAREDMEMORYCHANNEL_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A two-way message channel between two processes on the same machine, which
+    passes its data through a block of shared memory.
+
+    One process creates the channel with createNewChannel(), and the other one
+    connects to it by name with openExisting(). Each direction has its own ring
+    buffer, so messages never pass through the kernel, and a reader can look at an
+    incoming message directly in the shared memory without it being copied.
+
+    Only one thread should read from a channel at a time. Any number of threads
+    can write to it, although they'll be serialised.
+
+    @see InterprocessConnection, NamedPipe
+*/
+class JUCE_API  SharedMemoryChannel
+{
+public:
+    //==============================================================================
+    /** Creates a channel that isn't open. */
+    SharedMemoryChannel();
+
+    /** Destructor. */
+    ~SharedMemoryChannel();
+
+    //==============================================================================
+    /** Tries to create a new channel that another process can connect to.
+
+        The bufferSizeBytes is the size of the ring buffer used for each direction,
+        and it'll be rounded up to a power of two. A single message can use up to half
+        of this (see getMaxMessageSize()).
+
+        Returns false if the channel couldn't be created, e.g. if a channel with
+        this name is already open.
+    */
+    bool createNewChannel (const String& channelName, int bufferSizeBytes = 1024 * 1024);
+
+    /** Tries to connect to a channel that another process has created.
+        Returns true if it succeeds.
+    */
+    bool openExisting (const String& channelName);
+
+    /** Closes the channel, if it's open.
+        The process at the other end will find that hasOtherEndDisconnected() returns true.
+    */
+    void close();
+
+    /** True if the channel is currently open. */
+    bool isOpen() const noexcept;
+
+    /** True if the process at the other end has connected and hasn't yet closed the channel. */
+    bool isOtherEndConnected() const noexcept;
+
+    /** True if the process at the other end had connected, but has now closed the channel. */
+    bool hasOtherEndDisconnected() const noexcept;
+
+    /** Returns the last name that was used to try to open this channel. */
+    String getName() const;
+
+    /** Returns the largest message that can be written to this channel. */
+    size_t getMaxMessageSize() const noexcept;
+
+    //==============================================================================
+    /** Writes a message to the channel.
+
+        If there's not enough space in the buffer, this will wait up to timeOutMilliseconds
+        for the other end to read some messages (or indefinitely if it's less than zero).
+        Returns false if the message couldn't be written.
+    */
+    bool writeMessage (const void* messageData, size_t numBytes, int timeOutMilliseconds);
+
+    /** Writes a message that's made up of several separate blocks of data, copying each
+        of them straight into the shared buffer.
+        @see writeMessage
+    */
+    bool writeMessage (const void* const* dataBlocks, const size_t* blockSizes,
+                       int numBlocks, int timeOutMilliseconds);
+
+    //==============================================================================
+    /** Waits for the next incoming message.
+
+        If a message arrives within timeOutMilliseconds (or indefinitely if this is less
+        than zero), this returns a pointer to its data, which stays valid until you call
+        releaseMessage(). You must call releaseMessage() before waiting for another message,
+        and until you do, the space it uses can't be re-used by the sender.
+
+        Returns nullptr if there's no message, or if cancelPendingReads() was called.
+    */
+    const void* waitForNextMessage (size_t& numBytes, int timeOutMilliseconds);
+
+    /** Frees the space used by the last message that waitForNextMessage() returned. */
+    void releaseMessage();
+
+    /** Makes any thread that's blocked in waitForNextMessage() return. */
+    void cancelPendingReads();
+
+private:
+    //==============================================================================
+    JUCE_PUBLIC_IN_DLL_BUILD (class Pimpl)
+    struct Ring;
+    struct Layout;
+
+    ScopedPointer<Pimpl> pimpl;
+    Layout* layout;
+    char* readBuffer;
+    char* writeBuffer;
+    Ring* readRing;
+    Ring* writeRing;
+    uint32 ringSize;
+    int readRingIndex, writeRingIndex, otherEndIndex;
+    uint32 pendingReadSize;
+    String currentName;
+    CriticalSection writeLock;
+    bool volatile cancelRead;
+
+    bool openInternal (const String& channelName, bool create, int bufferSizeBytes);
+    void waitForSignal (Atomic<int>& signal, Atomic<int>& numWaiters, int signalIndex, int expectedValue, int timeOutMs);
+    void sendSignal (Atomic<int>& signal, Atomic<int>& numWaiters, int signalIndex);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedMemoryChannel)
+};
+
+
+#endif   // JUCE_SHAREDMEMORYCHANNEL_H_INCLUDED
@@ -363,6 +363,81 @@ namespace SocketHelpers
         const int reuse = 1;
         setsockopt (handle, SOL_SOCKET, SO_REUSEADDR, (const char*) &reuse, sizeof (reuse));
     }
+
+    static bool setIntOption (const SocketHandle handle, const int level, const int option, const int value) noexcept
+    {
+        return handle > 0 && setsockopt (handle, level, option, (const char*) &value, sizeof (value)) == 0;
+    }
+
+    static bool setMulticastMembership (const SocketHandle handle, const String& multicastIPAddress,
+                                        const String& interfaceIPAddress, const bool join) noexcept
+    {
+        struct ip_mreq mreq;
+        zerostruct (mreq);
+        mreq.imr_multiaddr.s_addr = ::inet_addr (multicastIPAddress.toUTF8());
+        mreq.imr_interface.s_addr = interfaceIPAddress.isNotEmpty() ? ::inet_addr (interfaceIPAddress.toUTF8())
+                                                                    : htonl (INADDR_ANY);
+
+        return handle > 0
+                && setsockopt (handle, IPPROTO_IP, join ? IP_ADD_MEMBERSHIP : IP_DROP_MEMBERSHIP,
+                               (const char*) &mreq, sizeof (mreq)) == 0;
+    }
+
+    static void setPacketDetails (DatagramSocket::Packet& packet, const int numBytes,
+                                  const struct sockaddr_in& sender, const int64 receiveTime) noexcept
+    {
+        packet.size = numBytes;
+        packet.senderAddress = IPAddress ((uint32) ntohl (sender.sin_addr.s_addr));
+        packet.senderPort = ntohs (sender.sin_port);
+        packet.receiveTimeMicroseconds = receiveTime;
+    }
+
+   #if ! JUCE_WINDOWS
+    // (big enough for either kind of timestamp)
+    enum { timestampControlSize = 64 };
+
+    static int64 getReceiveTime (struct msghdr& msg) noexcept
+    {
+        for (struct cmsghdr* c = CMSG_FIRSTHDR (&msg); c != nullptr; c = CMSG_NXTHDR (&msg, c))
+        {
+            if (c->cmsg_level != SOL_SOCKET)
+                continue;
+
+           #ifdef SCM_TIMESTAMPNS
+            if (c->cmsg_type == SCM_TIMESTAMPNS)
+            {
+                struct timespec t;
+                memcpy (&t, CMSG_DATA (c), sizeof (t));
+                return t.tv_sec * (int64) 1000000 + t.tv_nsec / 1000;
+            }
+           #endif
+
+            if (c->cmsg_type == SCM_TIMESTAMP)
+            {
+                struct timeval t;
+                memcpy (&t, CMSG_DATA (c), sizeof (t));
+                return t.tv_sec * (int64) 1000000 + t.tv_usec;
+            }
+        }
+
+        return 0;
+    }
+
+    static void prepareMessageHeader (struct msghdr& msg, struct iovec& iov, struct sockaddr_in& address,
+                                      void* control, void* data, const int size) noexcept
+    {
+        iov.iov_base = data;
+        iov.iov_len = (size_t) size;
+
+        zerostruct (msg);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_name = &address;
+        msg.msg_namelen = sizeof (address);
+        msg.msg_control = control;
+        msg.msg_controllen = timestampControlSize;
+    }
+   #endif
 }
 
 //==============================================================================
@@ -594,8 +669,7 @@ int DatagramSocket::read (void* destBuffer, int maxBytesToRead, bool shouldBlock
                     shouldBlock, readLock, &senderIPAddress, &senderPort) : -1;
 }
 
-int DatagramSocket::write (const String& remoteHostname, int remotePortNumber,
-                           const void* sourceBuffer, int numBytesToWrite)
+bool DatagramSocket::lookUpServerAddress (const String& remoteHostname, const int remotePortNumber)
 {
     struct addrinfo*& info = reinterpret_cast <struct addrinfo*&> (lastServerAddress);
 
@@ -606,16 +680,222 @@ int DatagramSocket::write (const String& remoteHostname, int remotePortNumber,
             freeaddrinfo (info);
 
         if ((info = SocketHelpers::getAddressInfo (true, remoteHostname, remotePortNumber)) == nullptr)
-            return -1;
+            return false;
 
         lastServerHost = remoteHostname;
         lastServerPort = remotePortNumber;
     }
 
+    return true;
+}
+
+int DatagramSocket::write (const String& remoteHostname, int remotePortNumber,
+                           const void* sourceBuffer, int numBytesToWrite)
+{
+    if (! lookUpServerAddress (remoteHostname, remotePortNumber))
+        return -1;
+
+    const struct addrinfo* const info = static_cast<const struct addrinfo*> (lastServerAddress);
+
     return (int) ::sendto (handle, (const char*) sourceBuffer,
                            (size_t) numBytesToWrite, 0, info->ai_addr, info->ai_addrlen);
 }
 
+//==============================================================================
+int DatagramSocket::readBatch (Packet* const packets, const int numPackets, const bool shouldBlock)
+{
+    if (! isBound || handle < 0)
+        return -1;
+
+    // avoid race-condition
+    CriticalSection::ScopedTryLockType lock (readLock);
+
+    if (! lock.isLocked())
+        return -1;
+
+   #if JUCE_LINUX
+    enum { maxPacketsPerCall = 64 };
+
+    const int num = jmin (numPackets, (int) maxPacketsPerCall);
+
+    if (num <= 0)
+        return 0;
+
+    struct mmsghdr headers[maxPacketsPerCall];
+    struct iovec iovs[maxPacketsPerCall];
+    struct sockaddr_in addresses[maxPacketsPerCall];
+    char control[maxPacketsPerCall][SocketHelpers::timestampControlSize];
+
+    for (int i = 0; i < num; ++i)
+    {
+        SocketHelpers::prepareMessageHeader (headers[i].msg_hdr, iovs[i], addresses[i], control[i],
+                                             packets[i].data, packets[i].size);
+        headers[i].msg_len = 0;
+    }
+
+    // (MSG_WAITFORONE blocks until the first packet arrives, and then takes whatever else is waiting)
+    const int numRead = recvmmsg (handle, headers, (unsigned int) num,
+                                  shouldBlock ? MSG_WAITFORONE : MSG_DONTWAIT, nullptr);
+
+    if (numRead < 0)
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+
+    for (int i = 0; i < numRead; ++i)
+        SocketHelpers::setPacketDetails (packets[i], (int) headers[i].msg_len, addresses[i],
+                                         SocketHelpers::getReceiveTime (headers[i].msg_hdr));
+
+    return numRead;
+   #else
+    int numRead = 0;
+
+    while (numRead < numPackets)
+    {
+        // (only the first read is allowed to block)
+        if ((numRead > 0 || ! shouldBlock)
+              && SocketHelpers::waitForReadiness (handle, readLock, true, 0) != 1)
+            break;
+
+        Packet& packet = packets[numRead];
+        struct sockaddr_in address;
+
+       #if JUCE_WINDOWS
+        juce_socklen_t addressLength = sizeof (address);
+        const int bytesRead = (int) ::recvfrom (handle, (char*) packet.data, packet.size, 0,
+                                                (struct sockaddr*) &address, &addressLength);
+        const int64 receiveTime = 0;
+       #else
+        struct msghdr msg;
+        struct iovec iov;
+        char control[SocketHelpers::timestampControlSize];
+        SocketHelpers::prepareMessageHeader (msg, iov, address, control, packet.data, packet.size);
+
+        const int bytesRead = (int) ::recvmsg (handle, &msg, 0);
+        const int64 receiveTime = SocketHelpers::getReceiveTime (msg);
+       #endif
+
+        if (bytesRead < 0)
+            return numRead > 0 ? numRead : -1;
+
+        SocketHelpers::setPacketDetails (packet, bytesRead, address, receiveTime);
+        ++numRead;
+    }
+
+    return numRead;
+   #endif
+}
+
+int DatagramSocket::writeBatch (const String& remoteHostname, const int remotePortNumber,
+                                const Packet* const packets, const int numPackets)
+{
+    if (handle < 0 || ! lookUpServerAddress (remoteHostname, remotePortNumber))
+        return -1;
+
+    const struct addrinfo* const info = static_cast<const struct addrinfo*> (lastServerAddress);
+    int numSent = 0;
+
+   #if JUCE_LINUX
+    enum { maxPacketsPerCall = 64 };
+
+    struct mmsghdr headers[maxPacketsPerCall];
+    struct iovec iovs[maxPacketsPerCall];
+
+    while (numSent < numPackets)
+    {
+        const int num = jmin (numPackets - numSent, (int) maxPacketsPerCall);
+
+        for (int i = 0; i < num; ++i)
+        {
+            const Packet& packet = packets[numSent + i];
+            iovs[i].iov_base = packet.data;
+            iovs[i].iov_len = (size_t) packet.size;
+
+            zerostruct (headers[i]);
+            headers[i].msg_hdr.msg_iov = iovs + i;
+            headers[i].msg_hdr.msg_iovlen = 1;
+            headers[i].msg_hdr.msg_name = info->ai_addr;
+            headers[i].msg_hdr.msg_namelen = info->ai_addrlen;
+        }
+
+        const int result = sendmmsg (handle, headers, (unsigned int) num, 0);
+
+        if (result < 0)
+            return numSent > 0 ? numSent : -1;
+
+        numSent += result;
+
+        if (result < num)
+            break;
+    }
+   #else
+    for (; numSent < numPackets; ++numSent)
+    {
+        const Packet& packet = packets[numSent];
+
+        if (::sendto (handle, (const char*) packet.data, (size_t) packet.size, 0,
+                      info->ai_addr, info->ai_addrlen) < 0)
+            return numSent > 0 ? numSent : -1;
+    }
+   #endif
+
+    return numSent;
+}
+
+//==============================================================================
+bool DatagramSocket::joinMulticast (const String& multicastIPAddress, const String& interfaceIPAddress)
+{
+    return SocketHelpers::setMulticastMembership (handle, multicastIPAddress, interfaceIPAddress, true);
+}
+
+bool DatagramSocket::leaveMulticast (const String& multicastIPAddress, const String& interfaceIPAddress)
+{
+    return SocketHelpers::setMulticastMembership (handle, multicastIPAddress, interfaceIPAddress, false);
+}
+
+bool DatagramSocket::setMulticastLoopbackEnabled (const bool enableLoopback)
+{
+   #if JUCE_WINDOWS
+    return SocketHelpers::setIntOption (handle, IPPROTO_IP, IP_MULTICAST_LOOP, enableLoopback ? 1 : 0);
+   #else
+    const u_char loop = enableLoopback ? 1 : 0;
+    return handle > 0 && setsockopt (handle, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof (loop)) == 0;
+   #endif
+}
+
+bool DatagramSocket::setEnablePortReuse (const bool enabled)
+{
+    // You need to call this before binding the socket!
+    jassert (! isBound);
+
+   #ifdef SO_REUSEPORT
+    return SocketHelpers::setIntOption (handle, SOL_SOCKET, SO_REUSEPORT, enabled ? 1 : 0);
+   #else
+    ignoreUnused (enabled);
+    return false;
+   #endif
+}
+
+bool DatagramSocket::setReceiveBufferSize (const int numBytes)
+{
+    return SocketHelpers::setIntOption (handle, SOL_SOCKET, SO_RCVBUF, numBytes);
+}
+
+bool DatagramSocket::setSendBufferSize (const int numBytes)
+{
+    return SocketHelpers::setIntOption (handle, SOL_SOCKET, SO_SNDBUF, numBytes);
+}
+
+bool DatagramSocket::setReceiveTimestampsEnabled (const bool enabled)
+{
+   #if JUCE_WINDOWS
+    ignoreUnused (enabled);
+    return false;
+   #elif defined (SO_TIMESTAMPNS)
+    return SocketHelpers::setIntOption (handle, SOL_SOCKET, SO_TIMESTAMPNS, enabled ? 1 : 0);
+   #else
+    return SocketHelpers::setIntOption (handle, SOL_SOCKET, SO_TIMESTAMP, enabled ? 1 : 0);
+   #endif
+}
+
 #if JUCE_MSVC
  #pragma warning (pop)
 #endif
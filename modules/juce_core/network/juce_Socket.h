@@ -282,6 +282,101 @@ public:
     int write (const String& remoteHostname, int remotePortNumber,
                const void* sourceBuffer, int numBytesToWrite);
 
+    //==============================================================================
+    /** Describes one datagram for readBatch() and writeBatch(). */
+    struct Packet
+    {
+        /** The packet's data, or for readBatch(), the buffer to read it into. */
+        void* data;
+
+        /** The number of bytes to write. For readBatch(), this must be set to the size of
+            the buffer, and it'll be changed to the number of bytes that were received.
+        */
+        int size;
+
+        /** For readBatch(), this is set to the address that sent the packet. */
+        IPAddress senderAddress;
+
+        /** For readBatch(), this is set to the port that sent the packet. */
+        int senderPort;
+
+        /** For readBatch(), this is set to the time at which the packet arrived, in
+            microseconds since 1970 according to the OS, if receive timestamps have been
+            turned on with setReceiveTimestampsEnabled(), or 0 if the time isn't known.
+        */
+        int64 receiveTimeMicroseconds;
+    };
+
+    /** Reads a number of datagrams in one go.
+
+        Where the OS can do it (e.g. with recvmmsg on Linux), all the packets are fetched
+        with a single system call, which is much cheaper than reading them one at a time
+        when there's a lot of traffic.
+
+        If shouldBlock is true, this waits until at least one packet has arrived, and then
+        returns however many are waiting (up to numPackets). If it's false, it returns
+        immediately.
+
+        @returns the number of packets that were read, or -1 if there was an error.
+    */
+    int readBatch (Packet* packets, int numPackets, bool shouldBlock);
+
+    /** Sends a number of datagrams to the same destination in one go.
+
+        Where the OS can do it (e.g. with sendmmsg on Linux), all the packets are sent
+        with a single system call.
+
+        @returns the number of packets that were sent, or -1 if there was an error.
+    */
+    int writeBatch (const String& remoteHostname, int remotePortNumber,
+                    const Packet* packets, int numPackets);
+
+    //==============================================================================
+    /** Joins a multicast group, so that this socket will receive the packets that are
+        sent to it. The socket must be bound to the group's port.
+
+        If interfaceIPAddress is empty, the OS chooses the network interface to use.
+        @returns true on success.
+    */
+    bool joinMulticast (const String& multicastIPAddress, const String& interfaceIPAddress = String());
+
+    /** Leaves a multicast group that was joined with joinMulticast().
+        @returns true on success.
+    */
+    bool leaveMulticast (const String& multicastIPAddress, const String& interfaceIPAddress = String());
+
+    /** Sets whether multicast packets that this machine sends are looped back to its own
+        sockets. (This is on by default).
+        @returns true on success.
+    */
+    bool setMulticastLoopbackEnabled (bool enableLoopback);
+
+    /** Allows more than one socket to bind to the same port, so that incoming packets are
+        shared between them (where the OS supports SO_REUSEPORT). This must be called before
+        bindToPort().
+        @returns true on success.
+    */
+    bool setEnablePortReuse (bool enabled);
+
+    /** Sets the size of the OS's receive buffer for this socket.
+        A larger buffer stops packets being dropped if the reading thread is held up for a
+        moment. The OS may limit the size you can choose.
+        @returns true on success.
+    */
+    bool setReceiveBufferSize (int numBytes);
+
+    /** Sets the size of the OS's send buffer for this socket.
+        @returns true on success.
+    */
+    bool setSendBufferSize (int numBytes);
+
+    /** Asks the OS to record the time at which each packet arrives, which readBatch()
+        will then return. This isn't available on all platforms.
+        @returns true on success.
+        @see Packet::receiveTimeMicroseconds
+    */
+    bool setReceiveTimestampsEnabled (bool enabled);
+
 private:
     //==============================================================================
     int handle;
@@ -291,6 +386,8 @@ private:
     void* lastServerAddress;
     mutable CriticalSection readLock;
 
+    bool lookUpServerAddress (const String& remoteHostname, int remotePortNumber);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DatagramSocket)
 };
 
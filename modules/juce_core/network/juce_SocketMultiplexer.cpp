@@ -0,0 +1,405 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+struct SocketMultiplexer::Registration
+{
+    Registration (StreamingSocket& s, Listener& l, const int regId) noexcept
+        : socket (s), listener (l), registrationId (regId), wantsWriteNotifications (false)
+    {}
+
+    StreamingSocket& socket;
+    Listener& listener;
+    const int registrationId;
+    bool wantsWriteNotifications;
+};
+
+//==============================================================================
+class SocketMultiplexer::Poller
+{
+public:
+    struct Event
+    {
+        int registrationId;
+        bool readable, writable;
+    };
+
+   #if JUCE_LINUX || JUCE_ANDROID
+    //==============================================================================
+    Poller()
+    {
+        epollHandle = epoll_create (64);
+        jassert (epollHandle >= 0);
+
+        wakeUpPipe[0] = wakeUpPipe[1] = -1;
+
+        if (pipe (wakeUpPipe) == 0)
+        {
+            fcntl (wakeUpPipe[0], F_SETFL, O_NONBLOCK);
+
+            struct epoll_event e;
+            zerostruct (e);
+            e.events = EPOLLIN;
+            e.data.u64 = (uint64) -1;
+            epoll_ctl (epollHandle, EPOLL_CTL_ADD, wakeUpPipe[0], &e);
+        }
+    }
+
+    ~Poller()
+    {
+        if (wakeUpPipe[0] >= 0)  ::close (wakeUpPipe[0]);
+        if (wakeUpPipe[1] >= 0)  ::close (wakeUpPipe[1]);
+        ::close (epollHandle);
+    }
+
+    bool add (const int handle, const int registrationId, const bool wantsWrite)
+    {
+        struct epoll_event e = createEvent (registrationId, wantsWrite);
+        return epoll_ctl (epollHandle, EPOLL_CTL_ADD, handle, &e) == 0;
+    }
+
+    void modify (const int handle, const int registrationId, const bool wantsWrite)
+    {
+        struct epoll_event e = createEvent (registrationId, wantsWrite);
+        epoll_ctl (epollHandle, EPOLL_CTL_MOD, handle, &e);
+    }
+
+    void remove (const int handle)
+    {
+        struct epoll_event e; // (older kernels need a non-null pointer here)
+        zerostruct (e);
+        epoll_ctl (epollHandle, EPOLL_CTL_DEL, handle, &e);
+    }
+
+    void wait (const int timeoutMs, Array<Event>& results)
+    {
+        struct epoll_event events[64];
+        const int numEvents = epoll_wait (epollHandle, events, numElementsInArray (events), timeoutMs);
+
+        for (int i = 0; i < numEvents; ++i)
+        {
+            const struct epoll_event& e = events[i];
+
+            if (e.data.u64 == (uint64) -1)
+            {
+                char buffer[32];
+                while (read (wakeUpPipe[0], buffer, sizeof (buffer)) > 0)
+                {}
+
+                continue;
+            }
+
+            // (errors and hang-ups are reported as readable, so that the listener's read() fails)
+            const Event result = { (int) e.data.u64,
+                                   (e.events & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0,
+                                   (e.events & EPOLLOUT) != 0 };
+            results.add (result);
+        }
+    }
+
+    void wakeUp()
+    {
+        if (wakeUpPipe[1] >= 0)
+        {
+            const char x = 0;
+            ssize_t bytesWritten = write (wakeUpPipe[1], &x, 1);
+            (void) bytesWritten;
+        }
+    }
+
+private:
+    int epollHandle;
+    int wakeUpPipe[2];
+
+    static struct epoll_event createEvent (const int registrationId, const bool wantsWrite) noexcept
+    {
+        struct epoll_event e;
+        zerostruct (e);
+        e.events = (uint32) EPOLLIN | (wantsWrite ? (uint32) EPOLLOUT : (uint32) 0);
+        e.data.u64 = (uint64) registrationId;
+        return e;
+    }
+
+   #else
+    //==============================================================================
+    // This fallback uses poll(), so each wait has to pass the whole list of sockets
+    // to the OS, but it's still only a single thread for all the connections.
+   #if JUCE_WINDOWS
+    typedef WSAPOLLFD PollFD;
+    static int callPoll (PollFD* fds, int num, int timeoutMs)   { return WSAPoll (fds, (ULONG) num, timeoutMs); }
+   #else
+    typedef struct pollfd PollFD;
+    static int callPoll (PollFD* fds, int num, int timeoutMs)   { return poll (fds, (nfds_t) num, timeoutMs); }
+   #endif
+
+    Poller() {}
+
+    bool add (const int handle, const int registrationId, const bool wantsWrite)
+    {
+        const ScopedLock sl (lock);
+        PollFD fd = { 0 };
+        fd.fd = (SocketHandle) handle;
+        fd.events = (short) (POLLIN | (wantsWrite ? POLLOUT : 0));
+        fds.add (fd);
+        ids.add (registrationId);
+        return true;
+    }
+
+    void modify (const int handle, const int registrationId, const bool wantsWrite)
+    {
+        const ScopedLock sl (lock);
+        const int index = ids.indexOf (registrationId);
+
+        if (index >= 0)
+            fds.getReference (index).events = (short) (POLLIN | (wantsWrite ? POLLOUT : 0));
+
+        (void) handle;
+    }
+
+    void remove (const int handle)
+    {
+        const ScopedLock sl (lock);
+
+        for (int i = fds.size(); --i >= 0;)
+        {
+            if (fds.getReference(i).fd == (SocketHandle) handle)
+            {
+                fds.remove (i);
+                ids.remove (i);
+            }
+        }
+    }
+
+    void wait (const int timeoutMs, Array<Event>& results)
+    {
+        Array<PollFD> fdsToPoll;
+        Array<int> idsToPoll;
+
+        {
+            const ScopedLock sl (lock);
+            fdsToPoll = fds;
+            idsToPoll = ids;
+        }
+
+        if (fdsToPoll.size() == 0)
+        {
+            Thread::sleep (jmin (timeoutMs, 20));
+            return;
+        }
+
+        // (a short timeout is used because newly added sockets aren't seen until the next wait)
+        if (callPoll (fdsToPoll.getRawDataPointer(), fdsToPoll.size(), jmin (timeoutMs, 20)) > 0)
+        {
+            for (int i = 0; i < fdsToPoll.size(); ++i)
+            {
+                const short revents = fdsToPoll.getReference(i).revents;
+
+                if (revents != 0)
+                {
+                    const Event result = { idsToPoll.getUnchecked(i),
+                                           (revents & (POLLIN | POLLERR | POLLHUP)) != 0,
+                                           (revents & POLLOUT) != 0 };
+                    results.add (result);
+                }
+            }
+        }
+    }
+
+    void wakeUp() {}
+
+private:
+    CriticalSection lock;
+    Array<PollFD> fds;
+    Array<int> ids;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE (Poller)
+};
+
+//==============================================================================
+class SocketMultiplexer::MultiplexerThread  : public Thread
+{
+public:
+    MultiplexerThread (SocketMultiplexer& m, const String& name)
+        : Thread (name), owner (m)
+    {
+    }
+
+    void run() override
+    {
+        owner.runLoop();
+    }
+
+private:
+    SocketMultiplexer& owner;
+
+    JUCE_DECLARE_NON_COPYABLE (MultiplexerThread)
+};
+
+//==============================================================================
+SocketMultiplexer::SocketMultiplexer (const String& threadName)
+    : poller (new Poller()),
+      lastRegistrationId (0)
+{
+    SocketHelpers::initSockets();
+
+    thread = new MultiplexerThread (*this, threadName);
+    thread->startThread();
+}
+
+SocketMultiplexer::~SocketMultiplexer()
+{
+    thread->signalThreadShouldExit();
+    poller->wakeUp();
+    thread->stopThread (4000);
+}
+
+void SocketMultiplexer::Listener::socketReadyForWriting (StreamingSocket&) {}
+
+//==============================================================================
+bool SocketMultiplexer::addSocket (StreamingSocket& socket, Listener& listener)
+{
+    if (! socket.isConnected())
+        return false;
+
+    const ScopedLock sl (registrationLock);
+
+    if (findRegistration (socket) != nullptr)
+        return false;
+
+    // (the id is what the OS hands back, so a stale event for a handle that's been closed
+    // and re-used can never be delivered to the wrong socket)
+    lastRegistrationId = (lastRegistrationId + 1) & 0x7fffffff;
+    Registration* const r = new Registration (socket, listener, lastRegistrationId);
+
+    if (! poller->add (socket.getRawSocketHandle(), r->registrationId, false))
+    {
+        delete r;
+        return false;
+    }
+
+    registrations.add (r);
+    registrationsById.set (r->registrationId, r);
+    poller->wakeUp();
+    return true;
+}
+
+void SocketMultiplexer::removeSocket (StreamingSocket& socket)
+{
+    {
+        const ScopedLock sl (registrationLock);
+
+        if (Registration* const r = findRegistration (socket))
+        {
+            poller->remove (socket.getRawSocketHandle());
+            registrationsById.remove (r->registrationId);
+            registrations.removeObject (r);
+        }
+    }
+
+    // This waits for any callback that's currently in progress to finish. (If this is
+    // being called from inside a callback, the lock is re-entrant, so it won't deadlock)
+    const ScopedLock sl (callbackLock);
+}
+
+void SocketMultiplexer::setWriteNotificationsEnabled (StreamingSocket& socket, const bool shouldBeEnabled)
+{
+    const ScopedLock sl (registrationLock);
+
+    if (Registration* const r = findRegistration (socket))
+    {
+        if (r->wantsWriteNotifications != shouldBeEnabled)
+        {
+            r->wantsWriteNotifications = shouldBeEnabled;
+            poller->modify (socket.getRawSocketHandle(), r->registrationId, shouldBeEnabled);
+        }
+    }
+}
+
+int SocketMultiplexer::getNumSockets() const
+{
+    const ScopedLock sl (registrationLock);
+    return registrations.size();
+}
+
+SocketMultiplexer::Registration* SocketMultiplexer::findRegistration (const StreamingSocket& socket) const noexcept
+{
+    for (int i = registrations.size(); --i >= 0;)
+        if (&(registrations.getUnchecked(i)->socket) == &socket)
+            return registrations.getUnchecked(i);
+
+    return nullptr;
+}
+
+SocketMultiplexer::Registration* SocketMultiplexer::findRegistration (const int registrationId) const noexcept
+{
+    return registrationsById [registrationId];
+}
+
+//==============================================================================
+void SocketMultiplexer::runLoop()
+{
+    Array<Poller::Event> events;
+
+    while (! thread->threadShouldExit())
+    {
+        events.clearQuick();
+        poller->wait (100, events);
+
+        for (int i = 0; i < events.size() && ! thread->threadShouldExit(); ++i)
+        {
+            const Poller::Event& e = events.getReference (i);
+
+            const ScopedLock cl (callbackLock);
+            StreamingSocket* socket = nullptr;
+            Listener* listener = nullptr;
+            bool wantsWrite = false;
+
+            {
+                const ScopedLock rl (registrationLock);
+
+                // (the socket may have been removed since the event was collected)
+                if (Registration* const r = findRegistration (e.registrationId))
+                {
+                    socket = &(r->socket);
+                    listener = &(r->listener);
+                    wantsWrite = r->wantsWriteNotifications;
+                }
+            }
+
+            if (listener != nullptr)
+            {
+                if (e.writable && wantsWrite)
+                    listener->socketReadyForWriting (*socket);
+
+                // (the write callback may have removed the socket)
+                if (e.readable && findRegistration (e.registrationId) != nullptr)
+                    listener->socketReadyForReading (*socket);
+            }
+        }
+    }
+}
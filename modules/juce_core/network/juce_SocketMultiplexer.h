@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_SOCKETMULTIPLEXER_H_INCLUDED
+#define JUCE_SOCKETMULTIPLEXER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Watches any number of StreamingSockets on a single thread, and calls a listener
+    when each one has data waiting to be read (or, optionally, room to write).
+
+    This lets a server handle hundreds of connections without needing a thread for
+    each one. On Linux and Android it uses epoll, and elsewhere it uses poll().
+
+    The listener callbacks are made on the multiplexer's thread. A socket is only
+    reported as readable when a read() call won't block, so a callback should read
+    whatever is available with read (buffer, size, false), and keep any partial data
+    until the rest arrives. A read() that returns less than 1 byte means that the
+    connection has been closed.
+
+    e.g.
+    @code
+    struct MyClient  : public SocketMultiplexer::Listener
+    {
+        void socketReadyForReading (StreamingSocket& s) override
+        {
+            char buffer[4096];
+            const int numRead = s.read (buffer, sizeof (buffer), false);
+
+            if (numRead > 0)
+                handleIncomingData (buffer, numRead);
+            else
+                handleDisconnection();
+        }
+    };
+    @endcode
+
+    @see StreamingSocket, InterprocessConnection::setSocketMultiplexer
+*/
+class JUCE_API  SocketMultiplexer
+{
+public:
+    //==============================================================================
+    /** Creates a multiplexer and starts its thread. */
+    explicit SocketMultiplexer (const String& threadName = "Socket multiplexer");
+
+    /** Destructor.
+        Any sockets that are still registered are removed (but not closed).
+    */
+    ~SocketMultiplexer();
+
+    //==============================================================================
+    /** Receives callbacks from a SocketMultiplexer.
+        @see SocketMultiplexer::addSocket
+    */
+    class JUCE_API  Listener
+    {
+    public:
+        /** Destructor. */
+        virtual ~Listener() {}
+
+        /** Called on the multiplexer's thread when the socket has some data that can be
+            read without blocking, or when it has been closed by the other end.
+        */
+        virtual void socketReadyForReading (StreamingSocket& socket) = 0;
+
+        /** Called on the multiplexer's thread when there's room to write to the socket.
+            This will only be called if setWriteNotificationsEnabled() has been used to
+            turn it on for this socket, and it'll be called repeatedly until it's turned off.
+        */
+        virtual void socketReadyForWriting (StreamingSocket& socket);
+    };
+
+    //==============================================================================
+    /** Starts watching a connected socket.
+
+        The socket and listener must remain valid until removeSocket() has been called.
+        Returns false if the socket isn't connected, or is already being watched.
+    */
+    bool addSocket (StreamingSocket& socket, Listener& listener);
+
+    /** Stops watching a socket.
+
+        When this returns, it's guaranteed that no callback for this socket is in progress
+        (unless this is being called from inside that callback). This must be called before
+        the socket is closed or deleted.
+    */
+    void removeSocket (StreamingSocket& socket);
+
+    /** Turns socketReadyForWriting() callbacks on or off for a socket. */
+    void setWriteNotificationsEnabled (StreamingSocket& socket, bool shouldBeEnabled);
+
+    /** Returns the number of sockets that are being watched. */
+    int getNumSockets() const;
+
+private:
+    //==============================================================================
+    struct Registration;
+    class Poller;
+    class MultiplexerThread;
+    friend class MultiplexerThread;
+
+    CriticalSection registrationLock, callbackLock;
+    OwnedArray<Registration> registrations;
+    HashMap<int, Registration*> registrationsById;
+    ScopedPointer<Poller> poller;
+    ScopedPointer<MultiplexerThread> thread;
+    int lastRegistrationId;
+
+    Registration* findRegistration (const StreamingSocket&) const noexcept;
+    Registration* findRegistration (int registrationId) const noexcept;
+    void runLoop();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SocketMultiplexer)
+};
+
+
+#endif   // JUCE_SOCKETMULTIPLEXER_H_INCLUDED
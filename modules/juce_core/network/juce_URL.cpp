@@ -163,6 +163,127 @@ namespace URLHelpers
         else
             path += suffix;
     }
+
+    //==============================================================================
+    // Reads a sequence of other streams one after another, so that a multipart upload can
+    // be sent straight from its files, without first being assembled in memory.
+    class ConcatenatedInputStream  : public InputStream
+    {
+    public:
+        ConcatenatedInputStream() noexcept  : currentIndex (0), position (0) {}
+
+        void addStream (InputStream* stream)    { streams.add (stream); }
+
+        int64 getTotalLength() override
+        {
+            int64 total = 0;
+
+            for (int i = 0; i < streams.size(); ++i)
+            {
+                const int64 length = streams.getUnchecked(i)->getTotalLength();
+
+                if (length < 0)
+                    return -1;
+
+                total += length;
+            }
+
+            return total;
+        }
+
+        int64 getPosition() override    { return position; }
+        bool isExhausted() override     { return currentIndex >= streams.size(); }
+
+        int read (void* destBuffer, int maxBytesToRead) override
+        {
+            int numRead = 0;
+
+            while (numRead < maxBytesToRead && currentIndex < streams.size())
+            {
+                const int num = streams.getUnchecked (currentIndex)->read (static_cast<char*> (destBuffer) + numRead,
+                                                                          maxBytesToRead - numRead);
+                if (num <= 0)
+                    ++currentIndex;
+                else
+                    numRead += num;
+            }
+
+            position += numRead;
+            return numRead;
+        }
+
+        bool setPosition (int64 newPosition) override
+        {
+            if (newPosition < position)
+            {
+                for (int i = 0; i < streams.size(); ++i)
+                    if (! streams.getUnchecked(i)->setPosition (0))
+                        return false;
+
+                currentIndex = 0;
+                position = 0;
+            }
+
+            skipNextBytes (newPosition - position);
+            return position == newPosition;
+        }
+
+    private:
+        OwnedArray<InputStream> streams;
+        int currentIndex;
+        int64 position;
+
+        JUCE_DECLARE_NON_COPYABLE (ConcatenatedInputStream)
+    };
+
+    //==============================================================================
+    // Calls a progress callback as data is pulled from another stream. If the callback asks
+    // to stop, the stream stops short without being exhausted, so the transfer fails.
+    class ProgressReportingInputStream  : public InputStream
+    {
+    public:
+        ProgressReportingInputStream (InputStream* s, URL::TransferProgressCallback* cb, void* context) noexcept
+            : source (s), callback (cb), callbackContext (context), cancelled (false)
+        {
+        }
+
+        int64 getTotalLength() override             { return source->getTotalLength(); }
+        int64 getPosition() override                { return source->getPosition(); }
+        bool isExhausted() override                 { return source->isExhausted(); }
+        bool setPosition (int64 newPos) override    { return source->setPosition (newPos); }
+
+        int read (void* destBuffer, int maxBytesToRead) override
+        {
+            if (cancelled)
+                return 0;
+
+            const int numRead = source->read (destBuffer, maxBytesToRead);
+
+            if (numRead > 0 && ! callback (callbackContext, source->getPosition(), source->getTotalLength()))
+                cancelled = true;
+
+            return numRead;
+        }
+
+    private:
+        ScopedPointer<InputStream> source;
+        URL::TransferProgressCallback* const callback;
+        void* const callbackContext;
+        bool cancelled;
+
+        JUCE_DECLARE_NON_COPYABLE (ProgressReportingInputStream)
+    };
+
+    static int64 getContentRangeStart (const StringPairArray& responseHeaders)
+    {
+        // e.g. "Content-Range: bytes 1000-1999/2000"
+        const String range (responseHeaders ["Content-Range"].trim());
+
+        if (! range.startsWithIgnoreCase ("bytes"))
+            return -1;
+
+        return range.substring (5).trimStart().getLargeIntValue();
+    }
 }
 
 void URL::addParameter (const String& name, const String& value)
@@ -242,10 +363,8 @@ URL URL::getChildURL (const String& subPath) const
     return u;
 }
 
-void URL::createHeadersAndPostData (String& headers, MemoryBlock& headersAndPostData) const
+InputStream* URL::createHeadersAndPostData (String& headers, MemoryBlock& headersAndPostData) const
 {
-    MemoryOutputStream data (headersAndPostData, false);
-
     if (filesToUpload.size() > 0)
     {
         // (this doesn't currently support mixing custom post-data with uploads..)
@@ -255,6 +374,11 @@ void URL::createHeadersAndPostData (String& headers, MemoryBlock& headersAndPost
 
         headers << "Content-Type: multipart/form-data; boundary=" << boundary << "\r\n";
 
+        // The text parts of the body are gathered into blocks between the uploads, and the
+        // files are only opened to be read as the body is sent.
+        ScopedPointer<URLHelpers::ConcatenatedInputStream> body (new URLHelpers::ConcatenatedInputStream());
+        MemoryOutputStream data;
+
         data << "--" << boundary;
 
         for (int i = 0; i < parameterNames.size(); ++i)
@@ -276,27 +400,34 @@ void URL::createHeadersAndPostData (String& headers, MemoryBlock& headersAndPost
 
             data << "Content-Transfer-Encoding: binary\r\n\r\n";
 
+            body->addStream (new MemoryInputStream (data.getData(), data.getDataSize(), true));
+            data.reset();
+
             if (f.data != nullptr)
-                data << *f.data;
-            else
-                data << f.file;
+                body->addStream (new MemoryInputStream (*f.data, true));
+            else if (FileInputStream* const fileStream = f.file.createInputStream())
+                body->addStream (fileStream);
 
             data << "\r\n--" << boundary;
         }
 
         data << "--\r\n";
+        body->addStream (new MemoryInputStream (data.getData(), data.getDataSize(), true));
+
+        return body.release();
     }
-    else
-    {
-        data << URLHelpers::getMangledParameters (*this)
-             << postData;
 
-        // if the user-supplied headers didn't contain a content-type, add one now..
-        if (! headers.containsIgnoreCase ("Content-Type"))
-            headers << "Content-Type: application/x-www-form-urlencoded\r\n";
+    MemoryOutputStream data (headersAndPostData, false);
 
-        headers << "Content-length: " << (int) data.getDataSize() << "\r\n";
-    }
+    data << URLHelpers::getMangledParameters (*this)
+         << postData;
+
+    // if the user-supplied headers didn't contain a content-type, add one now..
+    if (! headers.containsIgnoreCase ("Content-Type"))
+        headers << "Content-Type: application/x-www-form-urlencoded\r\n";
+
+    headers << "Content-length: " << (int) data.getDataSize() << "\r\n";
+    return nullptr;
 }
 
 //==============================================================================
@@ -338,18 +469,20 @@ InputStream* URL::createInputStream (const bool usePostCommand,
                                      const int numRedirectsToFollow) const
 {
     MemoryBlock headersAndPostData;
+    ScopedPointer<InputStream> postDataStream;
 
     if (! headers.endsWithChar ('\n'))
         headers << "\r\n";
 
     if (usePostCommand)
-        createHeadersAndPostData (headers, headersAndPostData);
+        postDataStream = createHeadersAndPostData (headers, headersAndPostData);
 
     if (! headers.endsWithChar ('\n'))
         headers << "\r\n";
 
     ScopedPointer<WebInputStream> wi (new WebInputStream (toString (! usePostCommand),
                                                           usePostCommand, headersAndPostData,
+                                                          postDataStream.release(),
                                                           progressCallback, progressCallbackContext,
                                                           headers, timeOutMs, responseHeaders,
                                                           numRedirectsToFollow));
@@ -360,6 +493,114 @@ InputStream* URL::createInputStream (const bool usePostCommand,
     return wi->isError() ? nullptr : wi.release();
 }
 
+InputStream* URL::createInputStreamForUpload (InputStream* const dataToUpload,
+                                              TransferProgressCallback* const progressCallback,
+                                              void* const progressCallbackContext,
+                                              String headers,
+                                              const int timeOutMs,
+                                              StringPairArray* const responseHeaders,
+                                              int* const statusCode) const
+{
+    ScopedPointer<InputStream> body (dataToUpload);
+    jassert (body != nullptr);
+
+    if (body == nullptr)
+        return nullptr;
+
+    if (progressCallback != nullptr)
+        body = new URLHelpers::ProgressReportingInputStream (body.release(), progressCallback, progressCallbackContext);
+
+    if (! headers.endsWithChar ('\n'))
+        headers << "\r\n";
+
+    if (! headers.containsIgnoreCase ("Content-Type"))
+        headers << "Content-Type: application/octet-stream\r\n";
+
+    ScopedPointer<WebInputStream> wi (new WebInputStream (toString (true), true, MemoryBlock(), body.release(),
+                                                          nullptr, nullptr, headers, timeOutMs,
+                                                          responseHeaders, 5));
+
+    if (statusCode != nullptr)
+        *statusCode = wi->statusCode;
+
+    return wi->isError() ? nullptr : wi.release();
+}
+
+//==============================================================================
+bool URL::downloadToFile (const File& targetFile, const bool resumeIfPossible,
+                          TransferProgressCallback* const progressCallback, void* const progressCallbackContext,
+                          String headers, const int timeOutMs) const
+{
+    const int64 existingSize = (resumeIfPossible && targetFile.existsAsFile()) ? targetFile.getSize() : 0;
+
+    if (existingSize > 0)
+    {
+        if (headers.isNotEmpty() && ! headers.endsWithChar ('\n'))
+            headers << "\r\n";
+
+        headers << "Range: bytes=" << existingSize << "-\r\n";
+    }
+
+    StringPairArray responseHeaders;
+    int statusCode = 0;
+
+    const ScopedPointer<InputStream> in (createInputStream (false, nullptr, nullptr, headers, timeOutMs,
+                                                           &responseHeaders, &statusCode));
+    if (in == nullptr)
+        return false;
+
+    // (this means the range starts at the end of the data, so the file was already complete)
+    if (existingSize > 0 && statusCode == 416)
+        return true;
+
+    if (statusCode != 0 && (statusCode < 200 || statusCode >= 300))
+        return false;
+
+    // If the server ignored the range, it's sending everything, so the file is started again.
+    // A partial response for some other range would be no use at all.
+    const bool isResuming = existingSize > 0 && statusCode == 206;
+
+    if (isResuming && URLHelpers::getContentRangeStart (responseHeaders) != existingSize)
+        return false;
+
+    if (! isResuming && ! targetFile.deleteFile())
+        return false;
+
+    FileOutputStream out (targetFile);
+
+    if (out.failedToOpen())
+        return false;
+
+    int64 bytesDone = isResuming ? existingSize : 0;
+    const int64 contentLength = in->getTotalLength();
+    const int64 totalBytes = contentLength >= 0 ? bytesDone + contentLength : -1;
+
+    const int bufferSize = 65536;
+    HeapBlock<char> buffer ((size_t) bufferSize);
+
+    for (;;)
+    {
+        const int numRead = in->read (buffer, bufferSize);
+
+        if (numRead <= 0)
+            break;
+
+        if (! out.write (buffer, (size_t) numRead))
+            return false;
+
+        bytesDone += numRead;
+
+        if (progressCallback != nullptr
+             && ! progressCallback (progressCallbackContext, bytesDone, totalBytes))
+            return false;
+    }
+
+    out.flush();
+
+    return totalBytes >= 0 ? (bytesDone == totalBytes)
+                           : in->isExhausted();
+}
+
 //==============================================================================
 bool URL::readEntireBinaryStream (MemoryBlock& destData,
                                   const bool usePostCommand) const
@@ -152,8 +152,9 @@ public:
         lets you specify the file.
 
         Note that the filename is stored, but the file itself won't actually be read
-        until this URL is later used to create a network input stream. If you want to
-        upload data from memory, use withDataToUpload().
+        until this URL is later used to create a network input stream, and it's then
+        read a block at a time as the request is sent, rather than being loaded into
+        memory first. If you want to upload data from memory, use withDataToUpload().
 
         @see withDataToUpload
     */
@@ -280,6 +281,70 @@ public:
                                     int* statusCode = nullptr,
                                     int numRedirectsToFollow = 5) const;
 
+    //==============================================================================
+    /** This callback function can be used by createInputStreamForUpload() and downloadToFile().
+
+        It's called as each block of data is transferred, with the total number of bytes
+        so far, and the total expected, or -1 if that isn't known. If you want to continue
+        the operation, it should return true, or false to abort.
+    */
+    typedef bool (TransferProgressCallback) (void* context, int64 bytesDone, int64 totalBytes);
+
+    /** Does a POST whose body is read from a stream as it's sent, and returns a stream that
+        can read the response.
+
+        The body is never loaded into memory as a whole, so this is the way to upload large
+        files. If the stream's getTotalLength() returns a size, this is sent as the request's
+        Content-Length, otherwise the body is sent using chunked transfer encoding, which
+        the server must support. The stream should be able to go back to its start with
+        setPosition (0), in case the request has to be re-sent after a redirect.
+
+        Any parameters that have been set on the URL are sent as part of the address, and
+        any POST data or files to upload that have been set on it are ignored.
+
+        (On platforms whose native HTTP functions need the entire body up-front, the stream
+        is read into memory before the request is made).
+
+        @param dataToUpload     the stream to read the body from - this will be deleted by
+                                this method when it's no longer needed
+        @param progressCallback if not null, this is called as the body is read from the stream
+        @param progressCallbackContext  a value to pass to the callback
+        @param extraHeaders     any extra headers to send, as for createInputStream()
+        @param connectionTimeOutMs  the timeout, as for createInputStream()
+        @param responseHeaders  if not null, the response headers are stored in this array
+        @param statusCode       if not null, this is set to the response's status code
+        @returns    a stream that reads the response, which the caller must delete, or
+                    nullptr if the request failed
+    */
+    InputStream* createInputStreamForUpload (InputStream* dataToUpload,
+                                             TransferProgressCallback* progressCallback = nullptr,
+                                             void* progressCallbackContext = nullptr,
+                                             String extraHeaders = String(),
+                                             int connectionTimeOutMs = 0,
+                                             StringPairArray* responseHeaders = nullptr,
+                                             int* statusCode = nullptr) const;
+
+    /** Downloads the contents of this URL into a file, writing it a block at a time as it
+        arrives.
+
+        If resumeIfPossible is true and the target file already exists, it's assumed to be
+        the beginning of the data from an earlier attempt that failed or was cancelled, and
+        the server is asked for just the rest of it, using an HTTP Range request. If the
+        server doesn't support ranges, it sends the whole thing, and the file gets
+        overwritten. If resumeIfPossible is false, any existing file is replaced.
+
+        If the download fails or is cancelled by the callback, the part that has already
+        been written is left in the file, so that a later call can carry on from there.
+
+        @returns true if the whole of the data was successfully written to the file
+    */
+    bool downloadToFile (const File& targetFile,
+                         bool resumeIfPossible = true,
+                         TransferProgressCallback* progressCallback = nullptr,
+                         void* progressCallbackContext = nullptr,
+                         String extraHeaders = String(),
+                         int connectionTimeOutMs = 0) const;
+
 
     //==============================================================================
     /** Tries to download the entire contents of this URL into a binary data block.
@@ -377,7 +442,7 @@ private:
 
     URL (const String&, int);
     void addParameter (const String&, const String&);
-    void createHeadersAndPostData (String&, MemoryBlock&) const;
+    InputStream* createHeadersAndPostData (String&, MemoryBlock&) const;
     URL withUpload (Upload*) const;
 
     JUCE_LEAK_DETECTOR (URL)
@@ -43,6 +43,122 @@ namespace
     }
 }
 
+//==============================================================================
+// Reads the chunk of the source that follows the main buffer into a second buffer on a
+// background thread. The prefetched data always begins at start, and is only used when it
+// begins exactly where the main buffer ends. All access to the source goes through the
+// lock while one of these exists, so the reader and the background thread never overlap.
+class BufferedInputStream::Prefetcher  : public TimeSliceClient
+{
+public:
+    Prefetcher (BufferedInputStream& s, TimeSliceThread& t)
+        : owner (s), thread (t), start (0), numBytes (0),
+          numSequentialRefills (0), isActive (false), reachedEnd (false)
+    {
+        data.malloc ((size_t) owner.bufferSize);
+        thread.addTimeSliceClient (this);
+    }
+
+    ~Prefetcher()
+    {
+        thread.removeTimeSliceClient (this);
+    }
+
+    int useTimeSlice() override
+    {
+        const ScopedLock sl (lock);
+
+        if (! isActive || reachedEnd || numBytes >= owner.bufferSize)
+            return 500;
+
+        owner.source->setPosition (start + numBytes);
+        const int bytesRead = owner.source->read (data + numBytes, owner.bufferSize - numBytes);
+
+        if (bytesRead > 0)
+            numBytes += bytesRead;
+        else
+            reachedEnd = true;
+
+        return 0;
+    }
+
+    void refill()
+    {
+        {
+            const ScopedLock sl (lock);
+            BufferedInputStream& s = owner;
+
+            // a refill that carries on from the end of the current buffer means that the
+            // caller is reading sequentially, so it's worth reading ahead for them
+            const bool isSequential = s.position >= s.bufferStart && s.position <= s.lastReadPos;
+            numSequentialRefills = isSequential ? numSequentialRefills + 1 : 0;
+
+            if (isSequential && start == s.lastReadPos && numBytes > 0)
+            {
+                const int bytesToKeep = (int) (s.lastReadPos - s.position);
+                memmove (s.buffer, s.buffer + (int) (s.position - s.bufferStart), (size_t) bytesToKeep);
+
+                const int bytesToTake = jmin (numBytes, s.bufferSize - bytesToKeep);
+                memcpy (s.buffer + bytesToKeep, data, (size_t) bytesToTake);
+                memmove (data, data + bytesToTake, (size_t) (numBytes - bytesToTake));
+
+                s.bufferStart = s.position;
+                s.lastReadPos += bytesToTake;
+                start += bytesToTake;
+                numBytes -= bytesToTake;
+
+                for (int i = bytesToKeep + bytesToTake; i < s.bufferSize; ++i)
+                    s.buffer[i] = 0;
+            }
+            else
+            {
+                s.source->setPosition (s.lastReadPos);
+                s.refillFromSource();
+
+                start = s.lastReadPos;
+                numBytes = 0;
+                reachedEnd = false;
+            }
+
+            isActive = numSequentialRefills >= 2;
+
+            if (! isActive)
+                return;
+        }
+
+        thread.moveToFrontOfQueue (this);
+    }
+
+    bool isSourceExhausted()
+    {
+        const ScopedLock sl (lock);
+
+        if (start == owner.lastReadPos)
+        {
+            if (numBytes > 0)
+                return false;
+
+            if (reachedEnd)
+                return true;
+        }
+
+        owner.source->setPosition (owner.lastReadPos);
+        return owner.source->isExhausted();
+    }
+
+    CriticalSection lock;
+
+private:
+    BufferedInputStream& owner;
+    TimeSliceThread& thread;
+    HeapBlock<char> data;
+    int64 start;
+    int numBytes, numSequentialRefills;
+    bool isActive, reachedEnd;
+
+    JUCE_DECLARE_NON_COPYABLE (Prefetcher)
+};
+
 //==============================================================================
 BufferedInputStream::BufferedInputStream (InputStream* const sourceStream, const int bufferSize_,
                                           const bool deleteSourceWhenDestroyed)
@@ -67,6 +183,19 @@ BufferedInputStream::BufferedInputStream (InputStream& sourceStream, const int b
     buffer.malloc ((size_t) bufferSize);
 }
 
+BufferedInputStream::BufferedInputStream (InputStream* const sourceStream, const int bufferSize_,
+                                          const bool deleteSourceWhenDestroyed, TimeSliceThread& prefetchThread)
+   : source (sourceStream, deleteSourceWhenDestroyed),
+     bufferSize (calcBufferStreamBufferSize (bufferSize_, sourceStream)),
+     position (sourceStream->getPosition()),
+     lastReadPos (0),
+     bufferStart (position),
+     bufferOverlap (128)
+{
+    buffer.malloc ((size_t) bufferSize);
+    prefetcher = new Prefetcher (*this, prefetchThread);
+}
+
 BufferedInputStream::~BufferedInputStream()
 {
 }
@@ -74,6 +203,12 @@ BufferedInputStream::~BufferedInputStream()
 //==============================================================================
 int64 BufferedInputStream::getTotalLength()
 {
+    if (prefetcher != nullptr)
+    {
+        const ScopedLock sl (prefetcher->lock);
+        return source->getTotalLength();
+    }
+
     return source->getTotalLength();
 }
 
@@ -90,7 +225,13 @@ bool BufferedInputStream::setPosition (int64 newPosition)
 
 bool BufferedInputStream::isExhausted()
 {
-    return position >= lastReadPos && source->isExhausted();
+    if (position < lastReadPos)
+        return false;
+
+    if (prefetcher != nullptr)
+        return prefetcher->isSourceExhausted();
+
+    return source->isExhausted();
 }
 
 void BufferedInputStream::ensureBuffered()
@@ -99,34 +240,41 @@ void BufferedInputStream::ensureBuffered()
 
     if (position < bufferStart || position >= bufferEndOverlap)
     {
-        int bytesRead;
+        if (prefetcher != nullptr)
+            prefetcher->refill();
+        else
+            refillFromSource();
+    }
+}
 
-        if (position < lastReadPos
-             && position >= bufferEndOverlap
-             && position >= bufferStart)
-        {
-            const int bytesToKeep = (int) (lastReadPos - position);
-            memmove (buffer, buffer + (int) (position - bufferStart), (size_t) bytesToKeep);
+void BufferedInputStream::refillFromSource()
+{
+    int bytesRead;
 
-            bufferStart = position;
+    if (position < lastReadPos && position >= bufferStart)
+    {
+        // (this assumes that the source is still positioned at lastReadPos)
+        const int bytesToKeep = (int) (lastReadPos - position);
+        memmove (buffer, buffer + (int) (position - bufferStart), (size_t) bytesToKeep);
 
-            bytesRead = source->read (buffer + bytesToKeep,
-                                      (int) (bufferSize - bytesToKeep));
+        bufferStart = position;
 
-            lastReadPos += bytesRead;
-            bytesRead += bytesToKeep;
-        }
-        else
-        {
-            bufferStart = position;
-            source->setPosition (bufferStart);
-            bytesRead = source->read (buffer, bufferSize);
-            lastReadPos = bufferStart + bytesRead;
-        }
+        bytesRead = source->read (buffer + bytesToKeep,
+                                  (int) (bufferSize - bytesToKeep));
 
-        while (bytesRead < bufferSize)
-            buffer [bytesRead++] = 0;
+        lastReadPos += bytesRead;
+        bytesRead += bytesToKeep;
     }
+    else
+    {
+        bufferStart = position;
+        source->setPosition (bufferStart);
+        bytesRead = source->read (buffer, bufferSize);
+        lastReadPos = bufferStart + bytesRead;
+    }
+
+    while (bytesRead < bufferSize)
+        buffer [bytesRead++] = 0;
 }
 
 int BufferedInputStream::read (void* destBuffer, int maxBytesToRead)
@@ -61,6 +61,29 @@ public:
     */
     BufferedInputStream (InputStream& sourceStream, int bufferSize);
 
+    /** Creates a BufferedInputStream which reads ahead of the caller on a background thread.
+
+        Once the stream notices that it's being read sequentially, it uses the thread to fetch
+        the next chunk of the source into a second buffer while the caller is still reading
+        from the first one, so that slow sources such as network streams or files on spinning
+        disks don't hold up the reader every time the buffer needs refilling. Random access
+        works as normal, but doesn't trigger any read-ahead.
+
+        While this stream exists, the source will be read from both the caller's thread and the
+        background thread, so it mustn't be used by anything else.
+
+        @param sourceStream                 the source stream to read from
+        @param bufferSize                   the size of each of the two buffers
+        @param deleteSourceWhenDestroyed    whether the sourceStream that is passed in should be
+                                            deleted by this object when it is itself deleted.
+        @param prefetchThread               the thread to use for reading ahead - this must
+                                            outlive the stream, and must be started by the caller
+    */
+    BufferedInputStream (InputStream* sourceStream,
+                         int bufferSize,
+                         bool deleteSourceWhenDestroyed,
+                         TimeSliceThread& prefetchThread);
+
     /** Destructor.
 
         This may also delete the source stream, if that option was chosen when the
@@ -84,7 +107,13 @@ private:
     int bufferSize;
     int64 position, lastReadPos, bufferStart, bufferOverlap;
     HeapBlock <char> buffer;
+
+    class Prefetcher;
+    friend class Prefetcher;
+    ScopedPointer<Prefetcher> prefetcher;
+
     void ensureBuffered();
+    void refillFromSource();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BufferedInputStream)
 };
@@ -148,6 +148,18 @@
 
 #endif
 
+//==============================================================================
+#if JUCE_CHECK_REALTIME_SAFETY || DOXYGEN
+  /** Reports a violation if the calling thread is inside a realtime context.
+      The operation should be a string literal which describes what's being done.
+      This is only compiled when JUCE_CHECK_REALTIME_SAFETY is enabled.
+      @see RealtimeSafety
+  */
+  #define JUCE_ASSERT_NOT_REALTIME(operation)   MACRO_WITH_FORCED_SEMICOLON (if (juce::juce_isInRealtimeContext()) juce::juce_reportRealtimeSafetyViolation (operation);)
+#else
+  #define JUCE_ASSERT_NOT_REALTIME(operation)   MACRO_WITH_FORCED_SEMICOLON ( ; )
+#endif
+
 //==============================================================================
 #ifndef DOXYGEN
 namespace juce
@@ -153,6 +153,25 @@
  #define JUCE_CATCH_DEPRECATED_CODE_MISUSE 1
 #endif
 
+//==============================================================================
+/** A module's cpp file can be divided into several compile units, so that a large module
+    can be built in parallel.
+
+    To build one of the units, JUCE_MODULE_COMPILE_UNIT is defined as its index (starting
+    from 1) before the module's cpp file is included - the Introjucer creates a small file
+    like this for each unit when its "Split modules into compile units" option is turned on.
+    The module then uses JUCE_COMPILE_UNIT (n) to decide which of its sections to build.
+    If JUCE_MODULE_COMPILE_UNIT isn't defined, the whole module is built in one go.
+*/
+#ifndef JUCE_MODULE_COMPILE_UNIT
+ #define JUCE_MODULE_COMPILE_UNIT 0
+#endif
+
+/** Evaluates to true if the given section of a module should be built in this compile unit.
+    @see JUCE_MODULE_COMPILE_UNIT
+*/
+#define JUCE_COMPILE_UNIT(n)    (JUCE_MODULE_COMPILE_UNIT == 0 || JUCE_MODULE_COMPILE_UNIT == (n))
+
 #ifndef DOXYGEN
  #define JUCE_NAMESPACE juce  // This old macro is deprecated: you should just use the juce namespace directly.
 #endif
@@ -66,16 +66,46 @@ String SystemStats::getJUCEVersion()
 struct CPUInformation
 {
     CPUInformation() noexcept
-        : numCpus (0), hasMMX (false), hasSSE (false),
-          hasSSE2 (false), hasSSE3 (false), has3DNow (false)
+        : numCpus (0), numPhysicalCpus (0), numPerformanceCores (0), numNumaNodes (0),
+          performanceCpuMask (0), hasMMX (false), hasSSE (false),
+          hasSSE2 (false), hasSSE3 (false), has3DNow (false),
+          hasAVX (false), hasAVX2 (false), hasFMA3 (false),
+          hasAVX512F (false), hasNeon (false)
     {
+        zeromem (cacheSizesKb, sizeof (cacheSizesKb));
+
+       #if defined (__ARM_NEON__) || defined (__ARM_NEON) || defined (_M_ARM64)
+        hasNeon = true; // (if the compiler was allowed to generate NEON code, the CPU must have it)
+       #endif
+
         initialise();
+
+        // (the native code fills in whatever it can find out, and the rest defaults to
+        // treating every CPU as a separate, full-speed core)
+        numCpus = jmax (1, numCpus);
+
+        if (numPhysicalCpus <= 0 || numPhysicalCpus > numCpus)
+            numPhysicalCpus = numCpus;
+
+        if (numPerformanceCores <= 0 || numPerformanceCores > numPhysicalCpus)
+            numPerformanceCores = numPhysicalCpus;
+
+        if (performanceCpuMask == 0)
+            performanceCpuMask = numCpus >= 32 ? 0xffffffffu : ((1u << numCpus) - 1);
+
+        numNumaNodes = jmax (1, numNumaNodes);
     }
 
     void initialise() noexcept;
 
-    int numCpus;
-    bool hasMMX, hasSSE, hasSSE2, hasSSE3, has3DNow;
+   #if JUCE_WINDOWS
+    void readProcessorTopology() noexcept;
+   #endif
+
+    int numCpus, numPhysicalCpus, numPerformanceCores, numNumaNodes;
+    int cacheSizesKb[3];
+    uint32 performanceCpuMask;
+    bool hasMMX, hasSSE, hasSSE2, hasSSE3, has3DNow, hasAVX, hasAVX2, hasFMA3, hasAVX512F, hasNeon;
 };
 
 static const CPUInformation& getCPUInformation() noexcept
@@ -85,11 +115,26 @@ static const CPUInformation& getCPUInformation() noexcept
 }
 
 int SystemStats::getNumCpus() noexcept        { return getCPUInformation().numCpus; }
+int SystemStats::getNumPhysicalCpus() noexcept      { return getCPUInformation().numPhysicalCpus; }
+int SystemStats::getNumPerformanceCores() noexcept  { return getCPUInformation().numPerformanceCores; }
+int SystemStats::getNumNumaNodes() noexcept         { return getCPUInformation().numNumaNodes; }
+uint32 SystemStats::getPerformanceCpuAffinityMask() noexcept  { return getCPUInformation().performanceCpuMask; }
+
+int SystemStats::getCpuCacheSizeInKilobytes (const int level) noexcept
+{
+    return (level >= 1 && level <= 3) ? getCPUInformation().cacheSizesKb [level - 1] : 0;
+}
+
 bool SystemStats::hasMMX() noexcept           { return getCPUInformation().hasMMX; }
 bool SystemStats::hasSSE() noexcept           { return getCPUInformation().hasSSE; }
 bool SystemStats::hasSSE2() noexcept          { return getCPUInformation().hasSSE2; }
 bool SystemStats::hasSSE3() noexcept          { return getCPUInformation().hasSSE3; }
 bool SystemStats::has3DNow() noexcept         { return getCPUInformation().has3DNow; }
+bool SystemStats::hasAVX() noexcept           { return getCPUInformation().hasAVX; }
+bool SystemStats::hasAVX2() noexcept          { return getCPUInformation().hasAVX2; }
+bool SystemStats::hasFMA3() noexcept          { return getCPUInformation().hasFMA3; }
+bool SystemStats::hasAVX512F() noexcept       { return getCPUInformation().hasAVX512F; }
+bool SystemStats::hasNeon() noexcept          { return getCPUInformation().hasNeon; }
 
 
 //==============================================================================
@@ -135,9 +135,45 @@ public:
     //==============================================================================
     // CPU and memory information..
 
-    /** Returns the number of CPU cores. */
+    /** Returns the number of CPU cores.
+        This is the number of logical CPUs, so it includes any extra hardware threads that
+        each physical core provides (e.g. with hyperthreading).
+        @see getNumPhysicalCpus
+    */
     static int getNumCpus() noexcept;
 
+    /** Returns the number of physical CPU cores.
+        When a core runs more than one hardware thread, these share its execution units,
+        so for CPU-bound work, this is usually a better number of threads to use than
+        getNumCpus().
+    */
+    static int getNumPhysicalCpus() noexcept;
+
+    /** Returns the number of physical cores that belong to the fastest class of core.
+        Some CPUs mix high-performance cores with slower, power-efficient ones, and for
+        those, this will be less than getNumPhysicalCpus(). On other CPUs they're the same.
+        @see getPerformanceCpuAffinityMask
+    */
+    static int getNumPerformanceCores() noexcept;
+
+    /** Returns a mask of the logical CPUs that belong to performance cores, in the format
+        used by Thread::setAffinityMask(). Only the first 32 CPUs can be represented.
+        @see getNumPerformanceCores
+    */
+    static uint32 getPerformanceCpuAffinityMask() noexcept;
+
+    /** Returns the size of one of the CPU's caches.
+        @param level    1 for the level-1 data cache, 2 for the level-2 cache, or 3 for the
+                        level-3 cache
+        @returns the size in kilobytes, or 0 if it isn't known or doesn't exist
+    */
+    static int getCpuCacheSizeInKilobytes (int level) noexcept;
+
+    /** Returns the number of NUMA nodes in the machine.
+        On most machines, all the memory is equally close to all the CPUs, and this is 1.
+    */
+    static int getNumNumaNodes() noexcept;
+
     /** Returns the approximate CPU speed.
         @returns    the speed in megahertz, e.g. 1500, 2500, 32000 (depending on
                     what year you're reading this...)
@@ -154,6 +190,11 @@ public:
     static bool hasSSE2() noexcept;  /**< Returns true if Intel SSE2 instructions are available. */
     static bool hasSSE3() noexcept;  /**< Returns true if Intel SSE2 instructions are available. */
     static bool has3DNow() noexcept; /**< Returns true if AMD 3DNOW instructions are available. */
+    static bool hasAVX() noexcept;   /**< Returns true if Intel AVX instructions are available and enabled by the OS. */
+    static bool hasAVX2() noexcept;  /**< Returns true if Intel AVX2 instructions are available and enabled by the OS. */
+    static bool hasFMA3() noexcept;  /**< Returns true if Intel FMA3 instructions are available and enabled by the OS. */
+    static bool hasAVX512F() noexcept; /**< Returns true if Intel AVX-512 foundation instructions are available and enabled by the OS. */
+    static bool hasNeon() noexcept;  /**< Returns true if ARM NEON instructions are available. */
 
     //==============================================================================
     /** Finds out how much RAM is in the machine.
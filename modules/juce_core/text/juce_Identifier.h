@@ -116,5 +116,26 @@ private:
     String name;
 };
 
+JUCE_DECLARE_TRIVIALLY_RELOCATABLE (Identifier)
+
+//==============================================================================
+#if JUCE_COMPILER_SUPPORTS_LAMBDAS || DOXYGEN
+ /** Returns an Identifier for a string literal, which only gets looked up in the
+     string pool the first time that this line of code is executed.
+
+     Identifier comparisons are already cheap, but constructing one from a literal
+     means hashing the string and locking the pool each time. In code that's called
+     often, you can avoid that by writing e.g.
+     @code
+     tree.getProperty (JUCE_STATIC_IDENTIFIER ("colour"));
+     @endcode
+     ..which behaves just like Identifier ("colour"), but only does the work once.
+ */
+ #define JUCE_STATIC_IDENTIFIER(stringLiteral) \
+    ([]() -> const juce::Identifier& { static const juce::Identifier staticIdentifier (stringLiteral); return staticIdentifier; }())
+#else
+ #define JUCE_STATIC_IDENTIFIER(stringLiteral)   juce::Identifier (stringLiteral)
+#endif
+
 
 #endif   // JUCE_IDENTIFIER_H_INCLUDED
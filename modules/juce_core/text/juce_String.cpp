@@ -50,6 +50,57 @@ static inline CharPointer_wchar_t castToCharPointer_wchar_t (const void* t) noex
     return CharPointer_wchar_t (static_cast<const CharPointer_wchar_t::CharType*> (t));
 }
 
+//==============================================================================
+// Most strings are pure ASCII, and for those, a conversion between encodings is just a copy of
+// each character into a wider or narrower type. These functions find the length of the ASCII
+// part at the start of a string, so that the conversions can skip decoding it.
+static size_t getNumLeadingASCIIChars (const char* const text) noexcept
+{
+    const size_t numBytes = strlen (text);
+    const size_t highBits = (~(size_t) 0 / 255) * 0x80;
+    size_t i = 0;
+
+    // check a word at a time for any bytes with their high bit set..
+    for (; i + sizeof (size_t) <= numBytes; i += sizeof (size_t))
+    {
+        size_t word;
+        memcpy (&word, text + i, sizeof (word));
+
+        if ((word & highBits) != 0)
+            break;
+    }
+
+    while (i < numBytes && (text[i] & 0x80) == 0)
+        ++i;
+
+    return i;
+}
+
+template <typename CharType>
+static size_t getNumLeadingASCIIUnits (const CharType* const text) noexcept
+{
+    size_t i = 0;
+
+    while ((uint32) text[i] - 1u < 0x7fu)   // (i.e. 0 < c < 0x80)
+        ++i;
+
+    return i;
+}
+
+static size_t getNumLeadingASCIIChars (CharPointer_UTF8 text) noexcept    { return getNumLeadingASCIIChars (text.getAddress()); }
+static size_t getNumLeadingASCIIChars (CharPointer_ASCII text) noexcept   { return getNumLeadingASCIIChars (text.getAddress()); }
+static size_t getNumLeadingASCIIChars (CharPointer_UTF16 text) noexcept   { return getNumLeadingASCIIUnits (text.getAddress()); }
+static size_t getNumLeadingASCIIChars (CharPointer_UTF32 text) noexcept   { return getNumLeadingASCIIUnits (text.getAddress()); }
+
+template <typename DestCharType, typename SrcCharType>
+static void copyASCIIChars (DestCharType* const dest, const SrcCharType* const src, const size_t numChars) noexcept
+{
+    for (size_t i = 0; i < numChars; ++i)
+        dest[i] = (DestCharType) src[i];
+
+    dest[numChars] = 0;
+}
+
 //==============================================================================
 // (Mirrors the structure of StringHolder, but without the atomic member, so can be statically constructed)
 struct EmptyString
@@ -73,6 +124,8 @@ public:
     //==============================================================================
     static CharPointerType createUninitialisedBytes (size_t numBytes)
     {
+        JUCE_ASSERT_NOT_REALTIME ("String allocation");
+
         numBytes = (numBytes + 3) & ~(size_t) 3;
         StringHolder* const s = reinterpret_cast<StringHolder*> (new char [sizeof (StringHolder) - sizeof (CharType) + numBytes]);
         s->refCount.value = 0;
@@ -86,8 +139,18 @@ public:
         if (text.getAddress() == nullptr || text.isEmpty())
             return CharPointerType (&(emptyString.text));
 
-        CharPointer t (text);
-        size_t bytesNeeded = sizeof (CharType);
+        // (each ASCII character takes one unit in any of the encodings)
+        const size_t numASCIIChars = getNumLeadingASCIIChars (text);
+        CharPointer t (text.getAddress() + numASCIIChars);
+
+        if (t.isEmpty())
+        {
+            const CharPointerType dest (createUninitialisedBytes ((numASCIIChars + 1) * sizeof (CharType)));
+            copyASCIIChars (dest.getAddress(), text.getAddress(), numASCIIChars);
+            return dest;
+        }
+
+        size_t bytesNeeded = (numASCIIChars + 1) * sizeof (CharType);
 
         while (! t.isEmpty())
             bytesNeeded += CharPointerType::getBytesRequiredFor (t.getAndAdvance());
@@ -823,22 +886,24 @@ String& String::operator+= (int64 number)
 }
 
 //==============================================================================
-JUCE_API String JUCE_CALLTYPE operator+ (const char* const s1, const String& s2)    { String s (s1); return s += s2; }
-JUCE_API String JUCE_CALLTYPE operator+ (const wchar_t* const s1, const String& s2) { String s (s1); return s += s2; }
+// (these all return a local or by-value parameter rather than the result of operator+=, so that
+// the result can be moved out instead of being copied, which would cost a pair of atomic ops)
+JUCE_API String JUCE_CALLTYPE operator+ (const char* const s1, const String& s2)    { String s (s1); s += s2; return s; }
+JUCE_API String JUCE_CALLTYPE operator+ (const wchar_t* const s1, const String& s2) { String s (s1); s += s2; return s; }
 
 JUCE_API String JUCE_CALLTYPE operator+ (const char s1, const String& s2)           { return String::charToString ((juce_wchar) (uint8) s1) + s2; }
 JUCE_API String JUCE_CALLTYPE operator+ (const wchar_t s1, const String& s2)        { return String::charToString (s1) + s2; }
 
-JUCE_API String JUCE_CALLTYPE operator+ (String s1, const String& s2)               { return s1 += s2; }
-JUCE_API String JUCE_CALLTYPE operator+ (String s1, const char* const s2)           { return s1 += s2; }
-JUCE_API String JUCE_CALLTYPE operator+ (String s1, const wchar_t* s2)              { return s1 += s2; }
+JUCE_API String JUCE_CALLTYPE operator+ (String s1, const String& s2)               { s1 += s2; return s1; }
+JUCE_API String JUCE_CALLTYPE operator+ (String s1, const char* const s2)           { s1 += s2; return s1; }
+JUCE_API String JUCE_CALLTYPE operator+ (String s1, const wchar_t* s2)              { s1 += s2; return s1; }
 
-JUCE_API String JUCE_CALLTYPE operator+ (String s1, const char s2)                  { return s1 += s2; }
-JUCE_API String JUCE_CALLTYPE operator+ (String s1, const wchar_t s2)               { return s1 += s2; }
+JUCE_API String JUCE_CALLTYPE operator+ (String s1, const char s2)                  { s1 += s2; return s1; }
+JUCE_API String JUCE_CALLTYPE operator+ (String s1, const wchar_t s2)               { s1 += s2; return s1; }
 
 #if ! JUCE_NATIVE_WCHAR_IS_UTF32
 JUCE_API String JUCE_CALLTYPE operator+ (const juce_wchar s1, const String& s2)     { return String::charToString (s1) + s2; }
-JUCE_API String JUCE_CALLTYPE operator+ (String s1, const juce_wchar s2)            { return s1 += s2; }
+JUCE_API String JUCE_CALLTYPE operator+ (String s1, const juce_wchar s2)            { s1 += s2; return s1; }
 JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, const juce_wchar s2)         { return s1 += s2; }
 #endif
 
@@ -2017,9 +2082,19 @@ struct StringEncodingConverter
             return CharPointerType_Dest (reinterpret_cast<const DestChar*> (&emptyChar));
 
         CharPointerType_Src text (source.getCharPointer());
-        const size_t extraBytesNeeded = CharPointerType_Dest::getBytesRequiredFor (text) + sizeof (typename CharPointerType_Dest::CharType);
-        const size_t endOffset = (text.sizeInBytes() + 3) & ~3u; // the new string must be word-aligned or many Windows
-                                                                // functions will fail to read it correctly!
+
+        // (if the string is all ASCII, its sizes are known without having to decode it)
+        const size_t numASCIIChars = getNumLeadingASCIIChars (text);
+        const bool isAllASCII = (text.getAddress()[numASCIIChars] == 0);
+
+        const size_t extraBytesNeeded = (isAllASCII ? numASCIIChars * sizeof (DestChar)
+                                                    : CharPointerType_Dest::getBytesRequiredFor (text)) + sizeof (DestChar);
+
+        const size_t sourceBytes = isAllASCII ? (numASCIIChars + 1) * sizeof (typename CharPointerType_Src::CharType)
+                                              : text.sizeInBytes();
+
+        const size_t endOffset = (sourceBytes + 3) & ~3u; // the new string must be word-aligned or many Windows
+                                                          // functions will fail to read it correctly!
         source.preallocateBytes (endOffset + extraBytesNeeded);
         text = source.getCharPointer();
 
@@ -2031,7 +2106,11 @@ struct StringEncodingConverter
         zeromem (addBytesToPointer (newSpace, extraBytesNeeded - bytesToClear), bytesToClear);
        #endif
 
-        CharPointerType_Dest (extraSpace).writeAll (text);
+        if (isAllASCII)
+            copyASCIIChars (extraSpace.getAddress(), text.getAddress(), numASCIIChars);
+        else
+            CharPointerType_Dest (extraSpace).writeAll (text);
+
         return extraSpace;
     }
 };
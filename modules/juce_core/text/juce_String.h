@@ -1244,6 +1244,8 @@ private:
     operator bool() const noexcept  { return false; }
 };
 
+JUCE_DECLARE_TRIVIALLY_RELOCATABLE (String)
+
 //==============================================================================
 /** Concatenates two strings. */
 JUCE_API String JUCE_CALLTYPE operator+ (const char* string1,     const String& string2);
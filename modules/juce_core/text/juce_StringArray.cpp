@@ -152,6 +152,17 @@ void StringArray::insert (const int index, const String& newString)
     strings.insert (index, newString);
 }
 
+#if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+void StringArray::insert (const int index, String&& newString)
+{
+    const int insertIndex = isPositiveAndBelow (index, strings.size()) ? index : strings.size();
+
+    // (the Array only takes copies, so an empty string is inserted and then swapped for the new one)
+    strings.insert (insertIndex, String());
+    strings.getReference (insertIndex).swapWith (newString);
+}
+#endif
+
 void StringArray::addIfNotAlreadyThere (const String& newString, const bool ignoreCase)
 {
     if (! contains (newString, ignoreCase))
@@ -178,6 +189,16 @@ void StringArray::set (const int index, const String& newString)
     strings.set (index, newString);
 }
 
+#if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+void StringArray::set (const int index, String&& newString)
+{
+    if (isPositiveAndBelow (index, strings.size()))
+        strings.getReference (index) = static_cast<String&&> (newString);
+    else if (index >= 0)
+        strings.add (static_cast<String&&> (newString));
+}
+#endif
+
 bool StringArray::contains (StringRef stringToLookFor, const bool ignoreCase) const
 {
     return indexOf (stringToLookFor, ignoreCase) >= 0;
@@ -186,6 +186,17 @@ public:
     */
     void insert (int index, const String& stringToAdd);
 
+   #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+    /** Inserts a string into the array.
+
+        This will insert a string into the array at the given index, moving
+        up the other elements to make room for it.
+        If the index is less than zero or greater than the size of the array,
+        the new string will be added to the end of the array.
+    */
+    void insert (int index, String&& stringToAdd);
+   #endif
+
     /** Adds a string to the array as long as it's not already in there.
         The search can optionally be case-insensitive.
     */
@@ -198,6 +209,15 @@ public:
     */
     void set (int index, const String& newString);
 
+   #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+    /** Replaces one of the strings in the array with another one.
+
+        If the index is higher than the array's size, the new string will be
+        added to the end of the array; if it's less than zero nothing happens.
+    */
+    void set (int index, String&& newString);
+   #endif
+
     /** Appends some strings from another array to the end of this one.
 
         @param other                the array to add
@@ -98,6 +98,23 @@ void StringPairArray::set (const String& key, const String& value)
     }
 }
 
+#if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+void StringPairArray::set (String&& key, String&& value)
+{
+    const int i = keys.indexOf (key, ignoreCase);
+
+    if (i >= 0)
+    {
+        values.set (i, static_cast<String&&> (value));
+    }
+    else
+    {
+        keys.add (static_cast<String&&> (key));
+        values.add (static_cast<String&&> (value));
+    }
+}
+#endif
+
 void StringPairArray::addArray (const StringPairArray& other)
 {
     for (int i = 0; i < other.size(); ++i)
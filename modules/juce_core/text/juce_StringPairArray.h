@@ -105,6 +105,14 @@ public:
     */
     void set (const String& key, const String& value);
 
+   #if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+    /** Adds or amends a key/value pair.
+        If a value already exists with this key, its value will be overwritten,
+        otherwise the key/value pair will be added to the array.
+    */
+    void set (String&& key, String&& value);
+   #endif
+
     /** Adds the items from another array to this one.
         This is equivalent to using set() to add each of the pairs from the other array.
     */
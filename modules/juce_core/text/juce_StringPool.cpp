@@ -29,10 +29,6 @@
 static const int minNumberOfStringsForGarbageCollection = 300;
 static const uint32 garbageCollectionInterval = 30000;
 
-
-StringPool::StringPool() noexcept  : lastGarbageCollectionTime (0) {}
-StringPool::~StringPool() {}
-
 struct StartEndString
 {
     StartEndString (String::CharPointerType s, String::CharPointerType e) noexcept : start (s), end (e) {}
@@ -61,44 +57,167 @@ static int compareStrings (const StartEndString& string1, const String& string2)
     return 0;
 }
 
-template <typename NewStringType>
-static String addPooledString (Array<String>& strings, const NewStringType& newString)
+// The hashes are calculated from the unicode characters rather than the encoded bytes,
+// so that a string gets the same hash whichever form it's passed in.
+static uint32 mixStringHash (const uint32 hash) noexcept
+{
+    // (bit 0 is always set, so that a zero can mark an empty slot)
+    return (hash * 0x9e3779b9u) | 1;
+}
+
+template <typename CharPointerType>
+static uint32 calculateStringHash (CharPointerType t) noexcept
+{
+    uint32 hash = 0;
+
+    while (! t.isEmpty())
+        hash = 31 * hash + (uint32) t.getAndAdvance();
+
+    return mixStringHash (hash);
+}
+
+static uint32 calculateStringHash (const String& s) noexcept    { return calculateStringHash (s.getCharPointer()); }
+
+static uint32 calculateStringHash (const StartEndString& s) noexcept
+{
+    uint32 hash = 0;
+
+    for (String::CharPointerType t (s.start); t < s.end && ! t.isEmpty();)
+        hash = 31 * hash + (uint32) t.getAndAdvance();
+
+    return mixStringHash (hash);
+}
+
+//==============================================================================
+// The top bits of a hash choose the shard, and the bits below them choose the slot.
+enum { numShardBits = 4, numShards = 1 << numShardBits };
+
+struct StringPool::Shard
 {
-    int start = 0;
-    int end = strings.size();
+    Shard()  : numStrings (0), numSlotBits (0), lastGarbageCollectionTime (0)
+    {
+        setNumSlotBits (4);
+    }
 
-    while (start < end)
+    template <typename NewStringType>
+    String getPooledString (const NewStringType& newString, const uint32 hash)
     {
-        const String& startString = strings.getReference (start);
-        const int startComp = compareStrings (newString, startString);
+        const SpinLock::ScopedLockType sl (lock);
+        garbageCollectIfNeeded();
 
-        if (startComp == 0)
-            return startString;
+        int index = getFirstSlot (hash);
 
-        const int halfway = (start + end) / 2;
+        for (; hashes[index] != 0; index = getNextSlot (index))
+            if (hashes[index] == hash && compareStrings (newString, strings.getReference (index)) == 0)
+                return strings.getReference (index);
 
-        if (halfway == start)
+        if ((numStrings + 1) * 4 > strings.size() * 3)
         {
-            if (startComp > 0)
-                ++start;
+            setNumSlotBits (numSlotBits + 1);
+            index = findEmptySlot (hash);
+        }
+
+        const String pooled (newString);
+        strings.set (index, pooled);
+        hashes[index] = hash;
+        ++numStrings;
+        return pooled;
+    }
 
-            break;
+    void garbageCollectIfNeeded()
+    {
+        if (numStrings > minNumberOfStringsForGarbageCollection / numShards
+             && Time::getApproximateMillisecondCounter() > lastGarbageCollectionTime + garbageCollectionInterval)
+            garbageCollect();
+    }
+
+    void garbageCollect()
+    {
+        for (int i = strings.size(); --i >= 0;)
+        {
+            if (hashes[i] != 0 && strings.getReference(i).getReferenceCount() == 1)
+            {
+                strings.getReference(i) = String();
+                hashes[i] = 0;
+                --numStrings;
+            }
         }
 
-        const String& halfwayString = strings.getReference (halfway);
-        const int halfwayComp = compareStrings (newString, halfwayString);
+        // removing strings can break up the runs of slots that lookups rely on, so
+        // the survivors have to be re-inserted
+        setNumSlotBits (numSlotBits);
+        lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
+    }
+
+    SpinLock lock;
+
+private:
+    Array<String> strings;
+    HeapBlock<uint32> hashes;
+    int numStrings, numSlotBits;
+    uint32 lastGarbageCollectionTime;
 
-        if (halfwayComp == 0)
-            return halfwayString;
+    int getFirstSlot (const uint32 hash) const noexcept
+    {
+        return (int) ((hash << numShardBits) >> (32 - numSlotBits));
+    }
+
+    int getNextSlot (const int index) const noexcept
+    {
+        return (index + 1) & ((1 << numSlotBits) - 1);
+    }
+
+    int findEmptySlot (const uint32 hash) const noexcept
+    {
+        int index = getFirstSlot (hash);
+
+        while (hashes[index] != 0)
+            index = getNextSlot (index);
 
-        if (halfwayComp > 0)
-            start = halfway;
-        else
-            end = halfway;
+        return index;
+    }
+
+    void setNumSlotBits (const int newNumSlotBits)
+    {
+        Array<String> oldStrings;
+        oldStrings.swapWith (strings);
+        HeapBlock<uint32> oldHashes;
+        oldHashes.swapWith (hashes);
+
+        numSlotBits = newNumSlotBits;
+        const int numSlots = 1 << numSlotBits;
+
+        strings.insertMultiple (0, String(), numSlots);
+        hashes.calloc ((size_t) numSlots);
+
+        for (int i = 0; i < oldStrings.size(); ++i)
+        {
+            if (oldHashes[i] != 0)
+            {
+                const int index = findEmptySlot (oldHashes[i]);
+                strings.getReference (index).swapWith (oldStrings.getReference (i));
+                hashes[index] = oldHashes[i];
+            }
+        }
     }
 
-    strings.insert (start, newString);
-    return strings.getReference (start);
+    JUCE_DECLARE_NON_COPYABLE (Shard)
+};
+
+//==============================================================================
+StringPool::StringPool()
+{
+    for (int i = 0; i < numShards; ++i)
+        shards.add (new Shard());
+}
+
+StringPool::~StringPool() {}
+
+template <typename NewStringType>
+String StringPool::addPooledString (const NewStringType& newString)
+{
+    const uint32 hash = calculateStringHash (newString);
+    return shards.getUnchecked ((int) (hash >> (32 - numShardBits)))->getPooledString (newString, hash);
 }
 
 String StringPool::getPooledString (const char* const newString)
@@ -106,9 +225,7 @@ String StringPool::getPooledString (const char* const newString)
     if (newString == nullptr || *newString == 0)
         return String();
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, CharPointer_UTF8 (newString));
+    return addPooledString (CharPointer_UTF8 (newString));
 }
 
 String StringPool::getPooledString (String::CharPointerType start, String::CharPointerType end)
@@ -116,9 +233,7 @@ String StringPool::getPooledString (String::CharPointerType start, String::CharP
     if (start.isEmpty() || start == end)
         return String();
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, StartEndString (start, end));
+    return addPooledString (StartEndString (start, end));
 }
 
 String StringPool::getPooledString (StringRef newString)
@@ -126,9 +241,7 @@ String StringPool::getPooledString (StringRef newString)
     if (newString.isEmpty())
         return String();
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString.text);
+    return addPooledString (newString.text);
 }
 
 String StringPool::getPooledString (const String& newString)
@@ -136,27 +249,17 @@ String StringPool::getPooledString (const String& newString)
     if (newString.isEmpty())
         return String();
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString);
-}
-
-void StringPool::garbageCollectIfNeeded()
-{
-    if (strings.size() > minNumberOfStringsForGarbageCollection
-         && Time::getApproximateMillisecondCounter() > lastGarbageCollectionTime + garbageCollectionInterval)
-        garbageCollect();
+    return addPooledString (newString);
 }
 
 void StringPool::garbageCollect()
 {
-    const ScopedLock sl (lock);
-
-    for (int i = strings.size(); --i >= 0;)
-        if (strings.getReference(i).getReferenceCount() == 1)
-            strings.remove (i);
-
-    lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
+    for (int i = 0; i < shards.size(); ++i)
+    {
+        Shard& shard = *shards.getUnchecked (i);
+        const SpinLock::ScopedLockType sl (shard.lock);
+        shard.garbageCollect();
+    }
 }
 
 StringPool& StringPool::getGlobalPool() noexcept
@@ -40,13 +40,17 @@
     is returned every time a matching string is asked for. This means that it's trivial to
     compare two pooled strings for equality, as you can simply compare their pointers. It
     also cuts down on storage if you're using many copies of the same string.
+
+    The strings are kept in a set of hash tables, each with its own lock, and a string's
+    hash decides which table it goes in. So a lookup only takes O(1) time, and threads
+    that are pooling different strings will rarely have to wait for each other.
 */
 class JUCE_API  StringPool
 {
 public:
     //==============================================================================
     /** Creates an empty pool. */
-    StringPool() noexcept;
+    StringPool();
 
     /** Destructor */
     ~StringPool();
@@ -83,11 +87,14 @@ public:
     static StringPool& getGlobalPool() noexcept;
 
 private:
-    Array<String> strings;
-    CriticalSection lock;
-    uint32 lastGarbageCollectionTime;
+    struct Shard;
+    friend struct Shard;
+    friend struct ContainerDeletePolicy<Shard>;
+
+    OwnedArray<Shard> shards;
 
-    void garbageCollectIfNeeded();
+    template <typename NewStringType>
+    String addPooledString (const NewStringType&);
 
     JUCE_DECLARE_NON_COPYABLE (StringPool)
 };
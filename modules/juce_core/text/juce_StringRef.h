@@ -132,7 +132,7 @@ JUCE_API bool JUCE_CALLTYPE operator== (const String& string1, StringRef string2
 JUCE_API bool JUCE_CALLTYPE operator!= (const String& string1, StringRef string2) noexcept;
 
 #if JUCE_STRING_UTF_TYPE != 8 && ! defined (DOXYGEN)
- inline String operator+ (String s1, StringRef s2)      { return s1 += String (s2.text); }
+ inline String operator+ (String s1, StringRef s2)      { s1.appendCharPointer (s2.text); return s1; }
 #endif
 
 #endif   // JUCE_STRINGREF_H_INCLUDED
@@ -39,6 +39,27 @@ int ChildProcess::readProcessOutput (void* dest, int numBytes)
     return activeProcess != nullptr ? activeProcess->read (dest, numBytes) : 0;
 }
 
+int ChildProcess::readAvailableProcessOutput (void* dest, int maxBytes)
+{
+    return activeProcess != nullptr ? activeProcess->readAvailable (dest, maxBytes) : -1;
+}
+
+bool ChildProcess::waitForProcessOutput (int timeoutMs) const
+{
+    return activeProcess == nullptr || activeProcess->waitForOutput (timeoutMs);
+}
+
+int ChildProcess::writeProcessInput (const void* source, int numBytes)
+{
+    return activeProcess != nullptr ? activeProcess->write (source, numBytes) : -1;
+}
+
+void ChildProcess::closeProcessInput()
+{
+    if (activeProcess != nullptr)
+        activeProcess->closeInput();
+}
+
 bool ChildProcess::kill()
 {
     return activeProcess == nullptr || activeProcess->killProcess();
@@ -51,16 +72,7 @@ uint32 ChildProcess::getExitCode() const
 
 bool ChildProcess::waitForProcessToFinish (const int timeoutMs) const
 {
-    const uint32 timeoutTime = Time::getMillisecondCounter() + (uint32) timeoutMs;
-
-    do
-    {
-        if (! isRunning())
-            return true;
-    }
-    while (timeoutMs < 0 || Time::getMillisecondCounter() < timeoutTime);
-
-    return false;
+    return activeProcess == nullptr || activeProcess->waitForExit (timeoutMs);
 }
 
 String ChildProcess::readAllProcessOutput()
@@ -34,8 +34,16 @@
 /**
     Launches and monitors a child process.
 
-    This class lets you launch an executable, and read its output. You can also
-    use it to check whether the child process has finished.
+    This class lets you launch an executable, read its output, and optionally write
+    to its input. You can also use it to check whether the child process has finished.
+
+    On OSX and Linux, processes are launched with posix_spawn(), which is much cheaper
+    than fork() when the parent process is large.
+
+    The output can be read either with readProcessOutput(), which blocks, or by polling
+    readAvailableProcessOutput() from a timer or your own thread, which never does.
+
+    @see ChildProcessPool
 */
 class JUCE_API  ChildProcess
 {
@@ -55,7 +63,8 @@ public:
     enum StreamFlags
     {
         wantStdOut = 1,
-        wantStdErr = 2
+        wantStdErr = 2,
+        wantStdIn  = 4   /**< Creates a pipe to the child's stdin, for writeProcessInput(). */
     };
 
     /** Attempts to launch a child process command.
@@ -89,12 +98,39 @@ public:
     */
     int readProcessOutput (void* destBuffer, int numBytesToRead);
 
+    /** Reads whatever output the process has already produced, without blocking.
+
+        Returns the number of bytes read, which will be 0 if nothing is waiting, or -1
+        once the process has closed its output and there's nothing left to read.
+    */
+    int readAvailableProcessOutput (void* destBuffer, int maxBytesToRead);
+
+    /** Waits until there's some output that can be read without blocking.
+
+        Returns true if some output (or the end of the stream) is waiting, or false if the
+        timeout expired first. A negative timeout waits forever.
+    */
+    bool waitForProcessOutput (int timeoutMs) const;
+
+    /** Writes some data to the child process's stdin.
+
+        This only works if the process was started with the wantStdIn flag. It blocks until
+        all the data has been written, and returns the number of bytes written, or -1 if
+        the pipe isn't open or the process has closed its end.
+    */
+    int writeProcessInput (const void* sourceData, int numBytesToWrite);
+
+    /** Closes the pipe to the child's stdin, so that it sees the end of its input. */
+    void closeProcessInput();
+
     /** Blocks until the process has finished, and then returns its complete output
         as a string.
     */
     String readAllProcessOutput();
 
-    /** Blocks until the process is no longer running. */
+    /** Blocks until the process is no longer running.
+        Returns false if the timeout expired first. A negative timeout waits forever.
+    */
     bool waitForProcessToFinish (int timeoutMs) const;
 
     /** If the process has finished, this returns its exit code. */
@@ -0,0 +1,286 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+struct ChildProcessPool::Worker
+{
+    bool start (const StringArray& command)
+    {
+        return process.start (command, ChildProcess::wantStdOut | ChildProcess::wantStdIn);
+    }
+
+    bool sendRequest (const String& request)
+    {
+        const String line (request + "\n");
+        const int numBytes = (int) line.getNumBytesAsUTF8();
+
+        return process.writeProcessInput (line.toRawUTF8(), numBytes) == numBytes;
+    }
+
+    bool readReply (String& reply, const int timeoutMs)
+    {
+        const uint32 startTime = Time::getMillisecondCounter();
+
+        for (;;)
+        {
+            const char* const data = static_cast<const char*> (pending.getData());
+
+            if (const void* const newLine = memchr (data, '\n', pending.getSize()))
+            {
+                const size_t lineLength = (size_t) (static_cast<const char*> (newLine) - data);
+                reply = String::fromUTF8 (data, (int) lineLength).trimCharactersAtEnd ("\r");
+                pending.removeSection (0, lineLength + 1);
+                return true;
+            }
+
+            int timeLeft = -1;
+
+            if (timeoutMs >= 0)
+            {
+                timeLeft = timeoutMs - (int) (Time::getMillisecondCounter() - startTime);
+
+                if (timeLeft <= 0)
+                    return false;
+            }
+
+            if (! process.waitForProcessOutput (timeLeft))
+                return false;
+
+            char buffer [1024];
+            const int numRead = process.readAvailableProcessOutput (buffer, sizeof (buffer));
+
+            if (numRead < 0)
+                return false;
+
+            pending.append (buffer, (size_t) numRead);
+        }
+    }
+
+    void shutDown()
+    {
+        process.closeProcessInput();
+
+        if (! process.waitForProcessToFinish (100))
+        {
+            process.kill();
+            process.waitForProcessToFinish (1000);  // (reaps it)
+        }
+    }
+
+    ChildProcess process;
+    MemoryBlock pending;
+};
+
+//==============================================================================
+ChildProcessPool::ChildProcessPool (const StringArray& workerCommand, const int maxNumProcesses)
+    : command (workerCommand), maxProcesses (jmax (1, maxNumProcesses)), numProcesses (0)
+{
+    jassert (command.size() > 0);
+}
+
+ChildProcessPool::~ChildProcessPool()
+{
+    shutDownIdleProcesses();
+
+    // All the jobs must have finished before the pool is deleted!
+    jassert (numProcesses == 0);
+}
+
+bool ChildProcessPool::runJob (const String& request, String& reply, const int timeoutMs)
+{
+    // The protocol is one line per job, so a request can't contain any line breaks!
+    jassert (! request.containsAnyOf ("\r\n"));
+
+    Worker* const worker = takeWorker();
+
+    if (worker == nullptr)
+        return false;
+
+    if (worker->sendRequest (request) && worker->readReply (reply, timeoutMs))
+    {
+        returnWorker (worker);
+        return true;
+    }
+
+    // (after a timeout, a late reply would get mixed up with the next job's, so the
+    // worker can't be trusted again)
+    discardWorker (worker);
+    return false;
+}
+
+int ChildProcessPool::getNumProcesses() const
+{
+    const ScopedLock sl (lock);
+    return numProcesses;
+}
+
+void ChildProcessPool::shutDownIdleProcesses()
+{
+    OwnedArray<Worker> workersToStop;
+
+    {
+        const ScopedLock sl (lock);
+        workersToStop.swapWith (idleWorkers);
+        numProcesses -= workersToStop.size();
+    }
+
+    for (int i = 0; i < workersToStop.size(); ++i)
+        workersToStop.getUnchecked(i)->process.closeProcessInput();
+
+    for (int i = 0; i < workersToStop.size(); ++i)
+        workersToStop.getUnchecked(i)->shutDown();
+
+    workerFreed.signal();
+}
+
+ChildProcessPool::Worker* ChildProcessPool::takeWorker()
+{
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            while (idleWorkers.size() > 0)
+            {
+                Worker* const w = idleWorkers.removeAndReturn (idleWorkers.size() - 1);
+
+                if (w->process.isRunning())
+                    return w;
+
+                delete w;
+                --numProcesses;
+            }
+
+            if (numProcesses < maxProcesses)
+            {
+                ++numProcesses;
+                break;
+            }
+        }
+
+        workerFreed.wait();
+    }
+
+    // (launched outside the lock, so that other threads can carry on meanwhile)
+    ScopedPointer<Worker> w (new Worker());
+
+    if (w->start (command))
+        return w.release();
+
+    {
+        const ScopedLock sl (lock);
+        --numProcesses;
+    }
+
+    workerFreed.signal();
+    return nullptr;
+}
+
+void ChildProcessPool::returnWorker (Worker* const w)
+{
+    {
+        const ScopedLock sl (lock);
+        idleWorkers.add (w);
+    }
+
+    workerFreed.signal();
+}
+
+void ChildProcessPool::discardWorker (Worker* const w)
+{
+    {
+        ScopedPointer<Worker> deleter (w);
+        w->process.kill();
+        w->process.waitForProcessToFinish (1000);
+    }
+
+    {
+        const ScopedLock sl (lock);
+        --numProcesses;
+    }
+
+    workerFreed.signal();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS && (JUCE_MAC || JUCE_LINUX)
+
+class ChildProcessPoolTests  : public UnitTest
+{
+public:
+    ChildProcessPoolTests() : UnitTest ("ChildProcessPool") {}
+
+    void runTest()
+    {
+        beginTest ("Pipes");
+
+        {
+            ChildProcess p;
+            expect (p.start ("cat", ChildProcess::wantStdOut | ChildProcess::wantStdIn));
+            expectEquals (p.writeProcessInput ("hello", 5), 5);
+            p.closeProcessInput();
+            expectEquals (p.readAllProcessOutput(), String ("hello"));
+            expect (p.waitForProcessToFinish (5000));
+            expectEquals ((int) p.getExitCode(), 0);
+        }
+
+        {
+            ChildProcess p;
+            expect (p.start ("cat", ChildProcess::wantStdOut | ChildProcess::wantStdIn));
+
+            char buffer [16];
+            expectEquals (p.readAvailableProcessOutput (buffer, sizeof (buffer)), 0);
+            expect (! p.waitForProcessOutput (10));
+
+            p.closeProcessInput();
+            expect (p.waitForProcessOutput (5000));
+            expectEquals (p.readAvailableProcessOutput (buffer, sizeof (buffer)), -1);
+        }
+
+        beginTest ("Pool");
+
+        {
+            ChildProcessPool pool (StringArray::fromTokens ("cat", false), 2);
+            String reply;
+
+            for (int i = 0; i < 10; ++i)
+            {
+                expect (pool.runJob ("job " + String (i), reply, 5000));
+                expectEquals (reply, "job " + String (i));
+            }
+
+            expectEquals (pool.getNumProcesses(), 1);
+
+            pool.shutDownIdleProcesses();
+            expectEquals (pool.getNumProcesses(), 0);
+        }
+    }
+};
+
+static ChildProcessPoolTests childProcessPoolUnitTests;
+
+#endif
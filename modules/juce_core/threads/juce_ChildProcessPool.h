@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_CHILDPROCESSPOOL_H_INCLUDED
+#define JUCE_CHILDPROCESSPOOL_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Keeps a bounded set of long-lived worker processes, and hands batch jobs out to them.
+
+    Launching a new process for every small job can easily cost more than the job itself,
+    so this starts workers on demand (up to a maximum number), and re-uses each one for
+    as many jobs as it'll take.
+
+    The workers must speak a simple line-based protocol: each job is sent to a worker's
+    stdin as a single line of UTF-8 text ending in a newline, and the worker must reply
+    by writing a single line to its stdout, and flushing it. A worker should quit when it
+    reaches the end of its input. Anything written to stderr is discarded.
+
+    runJob() can be called from any number of threads at once. If all the workers are
+    busy and no more can be launched, it'll wait for one to become free.
+
+    e.g.
+    @code
+    ChildProcessPool encoders (StringArray::fromTokens ("encoder --serve", true), 4);
+
+    String reply;
+    if (encoders.runJob ("encode /tmp/in.wav /tmp/out.flac", reply, 30000))
+        DBG (reply);
+    @endcode
+
+    @see ChildProcess
+*/
+class JUCE_API  ChildProcessPool
+{
+public:
+    //==============================================================================
+    /** Creates a pool.
+        No processes are launched until they're needed by runJob().
+
+        @param workerCommand        the executable and arguments to launch each worker with
+        @param maxNumProcesses      the most workers that will ever be running at once
+    */
+    ChildProcessPool (const StringArray& workerCommand, int maxNumProcesses);
+
+    /** Destructor.
+        This closes the input of each idle worker, and kills any that don't quit promptly.
+        All calls to runJob() must have returned before the pool is deleted.
+    */
+    ~ChildProcessPool();
+
+    //==============================================================================
+    /** Sends a job to a free worker and waits for its reply.
+
+        The request mustn't contain any line breaks. If the worker doesn't reply within
+        the timeout (a negative value waits forever), or if it quits or can't be launched,
+        this returns false, and that worker is killed rather than being re-used.
+    */
+    bool runJob (const String& request, String& reply, int timeoutMs = -1);
+
+    /** Returns the number of worker processes that are currently running (or busy
+        being launched).
+    */
+    int getNumProcesses() const;
+
+    /** Shuts down all the workers that aren't currently busy with a job. */
+    void shutDownIdleProcesses();
+
+private:
+    //==============================================================================
+    struct Worker;
+
+    const StringArray command;
+    const int maxProcesses;
+    CriticalSection lock;
+    WaitableEvent workerFreed;
+    OwnedArray<Worker> idleWorkers;
+    int numProcesses;
+
+    Worker* takeWorker();
+    void returnWorker (Worker*);
+    void discardWorker (Worker*);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChildProcessPool)
+};
+
+
+#endif   // JUCE_CHILDPROCESSPOOL_H_INCLUDED
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+DeferredDeleter::DeferredDeleter (const int maxNumPendingObjects, const int intervalMilliseconds)
+    : Thread ("Deferred deletion"),
+      pendingDeletions (maxNumPendingObjects),
+      interval (jmax (1, intervalMilliseconds))
+{
+    startThread (2);
+}
+
+DeferredDeleter::~DeferredDeleter()
+{
+    stopThread (4000);
+    deletePendingObjects();
+}
+
+void DeferredDeleter::addPendingDeletion (void* object, DeleterFunction deleter) noexcept
+{
+    PendingDeletion d;
+    d.object = object;
+    d.deleter = deleter;
+
+    if (! pendingDeletions.push (d))
+    {
+        // The queue is full, so the object has to be deleted on this thread. If this
+        // happens, you should give the DeferredDeleter a bigger queue, or a shorter interval.
+        jassertfalse;
+        deleter (object);
+    }
+}
+
+void DeferredDeleter::deletePendingObjects()
+{
+    PendingDeletion d;
+
+    while (pendingDeletions.pop (d))
+        d.deleter (d.object);
+}
+
+void DeferredDeleter::run()
+{
+    while (! threadShouldExit())
+    {
+        deletePendingObjects();
+        wait (interval);
+    }
+}
@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_DEFERREDDELETER_H_INCLUDED
+#define JUCE_DEFERREDDELETER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Hands objects over to a background thread to be deleted, so that a realtime
+    thread never has to run their destructors.
+
+    When an audio callback drops the last reference to something like a sample or an
+    impulse response, deleting it there means freeing memory, and possibly running a lot
+    of other destructor code, in the middle of the callback. Instead, you can pass it to
+    deleteLater(), or drop your reference with release(), and if the object needs deleting,
+    it's pushed onto a lock-free queue. A background thread empties the queue every few
+    milliseconds and deletes the objects. Neither call blocks or allocates, so they're
+    safe to use from an audio callback.
+
+    Objects are deleted with their ContainerDeletePolicy, just like the ones in an OwnedArray
+    or a ReferenceCountedObjectPtr.
+
+    Each of these has its own thread, so rather than creating lots of them, it's best to
+    share one with a SharedResourcePointer, which must be created on a non-realtime thread:
+    @code
+    struct MyVoice
+    {
+        void stopPlaying()      // called on the audio thread
+        {
+            deleter->release (currentSample);
+        }
+
+        MySample::Ptr currentSample;
+        SharedResourcePointer<DeferredDeleter> deleter;
+    };
+    @endcode
+
+    @see ReferenceCountedObjectPtr, LockFreeQueue
+*/
+class JUCE_API  DeferredDeleter  : private Thread
+{
+public:
+    //==============================================================================
+    /** Creates a DeferredDeleter and starts its background thread.
+
+        @param maxNumPendingObjects     the number of objects that can be waiting to be deleted.
+                                        If the queue fills up, further objects are deleted on
+                                        the calling thread.
+        @param intervalMilliseconds     how often the background thread deletes any objects
+                                        that are waiting
+    */
+    DeferredDeleter (int maxNumPendingObjects = 1024, int intervalMilliseconds = 50);
+
+    /** Destructor.
+        This stops the background thread, and deletes any objects that are still waiting.
+    */
+    ~DeferredDeleter();
+
+    //==============================================================================
+    /** Queues an object to be deleted on the background thread.
+        This can be called from any thread, and does nothing if the object is null.
+    */
+    template <typename ObjectType>
+    void deleteLater (ObjectType* objectToDelete) noexcept
+    {
+        if (objectToDelete != nullptr)
+            addPendingDeletion (objectToDelete, &deleteObject<ObjectType>);
+    }
+
+    /** Clears a ReferenceCountedObjectPtr, and if that released the last reference to
+        its object, queues the object to be deleted on the background thread.
+        This can be called from any thread.
+    */
+    template <typename ObjectType>
+    void release (ReferenceCountedObjectPtr<ObjectType>& pointer) noexcept
+    {
+        if (ObjectType* const object = pointer.get())
+        {
+            // (holding an extra reference while the pointer's cleared means that it can't delete the object)
+            object->incReferenceCount();
+            pointer = nullptr;
+
+            if (object->decReferenceCountWithoutDeleting())
+                deleteLater (object);
+        }
+    }
+
+    //==============================================================================
+    /** Deletes all the objects that are waiting, on the calling thread. */
+    void deletePendingObjects();
+
+    /** Returns the number of objects that are waiting to be deleted.
+        This can only be an estimate if other threads are using the deleter.
+    */
+    int getNumPendingObjects() const noexcept       { return pendingDeletions.getNumReady(); }
+
+private:
+    //==============================================================================
+    typedef void (*DeleterFunction) (void*);
+
+    struct PendingDeletion
+    {
+        PendingDeletion() noexcept  : object (nullptr), deleter (nullptr) {}
+
+        void* object;
+        DeleterFunction deleter;
+    };
+
+    LockFreeQueue<PendingDeletion> pendingDeletions;
+    const int interval;
+
+    template <typename ObjectType>
+    static void deleteObject (void* object)
+    {
+        ContainerDeletePolicy<ObjectType>::destroy (static_cast<ObjectType*> (object));
+    }
+
+    void addPendingDeletion (void* object, DeleterFunction) noexcept;
+    void run() override;
+
+    JUCE_DECLARE_NON_COPYABLE (DeferredDeleter)
+};
+
+
+#endif   // JUCE_DEFERREDDELETER_H_INCLUDED
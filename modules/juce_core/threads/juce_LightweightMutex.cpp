@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+// These are implemented in the native code. The wait returns if the value at the address
+// isn't the expected one, when it's woken, when it times out, or sometimes for no reason
+// at all, so callers must always check the value again afterwards.
+void juce_waitOnAddress (const volatile int* address, int expectedValue, int timeOutMs) noexcept;
+void juce_wakeAddress (const volatile int* address, bool wakeAllWaiters) noexcept;
+
+// The number of times a thread retries before it goes to sleep on a contended lock.
+enum { lightweightLockSpinCount = 100 };
+
+//==============================================================================
+void LightweightMutex::enterContended() const noexcept
+{
+    for (int i = lightweightLockSpinCount; --i >= 0;)
+        if (state.get() == 0 && state.compareAndSetBool (1, 0))
+            return;
+
+    JUCE_ASSERT_NOT_REALTIME ("LightweightMutex::enter() on a contended lock");
+
+    // Setting the state to 2 makes sure that whoever releases the lock will wake a
+    // waiting thread, so it can't be left asleep.
+    while (state.exchange (2) != 0)
+        juce_waitOnAddress (&(state.value), 2, -1);
+}
+
+void LightweightMutex::wakeWaitingThread() const noexcept
+{
+    juce_wakeAddress (&(state.value), false);
+}
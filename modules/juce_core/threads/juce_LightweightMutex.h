@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_LIGHTWEIGHTMUTEX_H_INCLUDED
+#define JUCE_LIGHTWEIGHTMUTEX_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A small, fast, non-recursive mutex.
+
+    When the lock is free, entering and leaving it is a single atomic operation, so it's
+    as cheap as a SpinLock. If it's already held, the caller spins briefly in case it's
+    about to be released, and after that it sleeps until the lock is free. It uses a
+    futex on Linux and Android, and WaitOnAddress on Windows 8 or later. This makes it
+    much better than a SpinLock when the lock is contended, and smaller and quicker
+    than a CriticalSection.
+
+    Unlike a CriticalSection, it's NOT re-entrant. If a thread tries to enter a lock
+    that it already holds, it'll deadlock.
+
+    @see CriticalSection, SpinLock, LightweightReadWriteLock
+*/
+class JUCE_API  LightweightMutex
+{
+public:
+    inline LightweightMutex() noexcept {}
+    inline ~LightweightMutex() noexcept {}
+
+    /** Acquires the lock, waiting until it's free if another thread holds it.
+
+        It's strongly recommended that you never call this method directly - instead use the
+        ScopedLockType class to manage the locking using an RAII pattern instead.
+    */
+    inline void enter() const noexcept
+    {
+        if (! state.compareAndSetBool (1, 0))
+            enterContended();
+    }
+
+    /** Attempts to acquire the lock, returning true if this was successful. */
+    inline bool tryEnter() const noexcept
+    {
+        return state.compareAndSetBool (1, 0);
+    }
+
+    /** Releases the lock. */
+    inline void exit() const noexcept
+    {
+        jassert (state.value != 0); // Agh! Releasing a lock that isn't currently held!
+
+        if (state.exchange (0) == 2)
+            wakeWaitingThread();
+    }
+
+    //==============================================================================
+    /** Provides the type of scoped lock to use for locking a LightweightMutex. */
+    typedef GenericScopedLock <LightweightMutex>       ScopedLockType;
+
+    /** Provides the type of scoped unlocker to use with a LightweightMutex. */
+    typedef GenericScopedUnlock <LightweightMutex>     ScopedUnlockType;
+
+    /** Provides the type of scoped try-lock to use with a LightweightMutex. */
+    typedef GenericScopedTryLock <LightweightMutex>    ScopedTryLockType;
+
+private:
+    //==============================================================================
+    // 0 = free, 1 = locked, 2 = locked and there may be threads waiting for it
+    mutable Atomic<int> state;
+
+    void enterContended() const noexcept;
+    void wakeWaitingThread() const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE (LightweightMutex)
+};
+
+
+#endif   // JUCE_LIGHTWEIGHTMUTEX_H_INCLUDED
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+bool LightweightReadWriteLock::tryEnterRead() const noexcept
+{
+    for (;;)
+    {
+        const int s = state.get();
+
+        if ((s & writerBit) != 0 || numWaitingWriters.get() > 0)
+            return false;
+
+        if (state.compareAndSetBool (s + 1, s))
+            return true;
+    }
+}
+
+void LightweightReadWriteLock::enterRead() const noexcept
+{
+    for (int i = lightweightLockSpinCount; --i >= 0;)
+        if (tryEnterRead())
+            return;
+
+    JUCE_ASSERT_NOT_REALTIME ("LightweightReadWriteLock::enterRead() on a contended lock");
+
+    for (;;)
+    {
+        const int s = state.get();
+
+        if ((s & writerBit) == 0 && numWaitingWriters.get() == 0)
+        {
+            if (state.compareAndSetBool (s + 1, s))
+                return;
+        }
+        else
+        {
+            sleepWhileStateIs (s);
+        }
+    }
+}
+
+void LightweightReadWriteLock::exitRead() const noexcept
+{
+    jassert ((state.get() & ~writerBit) > 0); // releasing a read lock that isn't held!
+
+    if (--state == 0 && numSleepingThreads.get() > 0)
+        juce_wakeAddress (&(state.value), true);
+}
+
+//==============================================================================
+bool LightweightReadWriteLock::tryEnterWrite() const noexcept
+{
+    return state.compareAndSetBool (writerBit, 0);
+}
+
+void LightweightReadWriteLock::enterWrite() const noexcept
+{
+    for (int i = lightweightLockSpinCount; --i >= 0;)
+        if (state.get() == 0 && tryEnterWrite())
+            return;
+
+    JUCE_ASSERT_NOT_REALTIME ("LightweightReadWriteLock::enterWrite() on a contended lock");
+
+    // (while this is non-zero, no new readers will be let in)
+    ++numWaitingWriters;
+
+    for (;;)
+    {
+        const int s = state.get();
+
+        if (s == 0 && tryEnterWrite())
+            break;
+
+        sleepWhileStateIs (s);
+    }
+
+    --numWaitingWriters;
+}
+
+void LightweightReadWriteLock::exitWrite() const noexcept
+{
+    jassert (state.get() == writerBit); // releasing a write lock that isn't held!
+
+    state = 0;
+
+    if (numSleepingThreads.get() > 0)
+        juce_wakeAddress (&(state.value), true);
+}
+
+void LightweightReadWriteLock::sleepWhileStateIs (const int s) const noexcept
+{
+    // The sleeping count is incremented before the state is checked again, so a thread that
+    // changes the state afterwards is sure to see it and wake us.
+    ++numSleepingThreads;
+    juce_waitOnAddress (&(state.value), s, -1);
+    --numSleepingThreads;
+}
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_LIGHTWEIGHTREADWRITELOCK_H_INCLUDED
+#define JUCE_LIGHTWEIGHTREADWRITELOCK_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A non-recursive lock that allows multiple simultaneous readers.
+
+    Unlike ReadWriteLock, this keeps all its state in a single atomic value, so taking
+    a read lock is just one compare-and-swap when there's no writer about, and no
+    other lock is involved. Threads that can't get the lock spin briefly and then
+    sleep until they're woken (see LightweightMutex for how this is done).
+
+    - Multiple readers can hold the lock at the same time, but only one writer
+      can hold it at once.
+    - Once a writer is waiting for the lock, no new readers are let in, so writers
+      can't be starved by a stream of readers.
+    - The lock is NOT recursive: a thread mustn't try to re-enter a lock that it
+      already holds, either for reading or writing.
+
+    @see ReadWriteLock, LightweightMutex
+*/
+class JUCE_API  LightweightReadWriteLock
+{
+public:
+    //==============================================================================
+    LightweightReadWriteLock() noexcept {}
+    ~LightweightReadWriteLock() noexcept {}
+
+    //==============================================================================
+    /** Locks this object for reading, waiting while a writer holds or is waiting for the lock. */
+    void enterRead() const noexcept;
+
+    /** Tries to lock this object for reading, returning false if a writer holds or is
+        waiting for the lock.
+    */
+    bool tryEnterRead() const noexcept;
+
+    /** Releases a read-lock. */
+    void exitRead() const noexcept;
+
+    //==============================================================================
+    /** Locks this object for writing, waiting until any readers or writers have released it. */
+    void enterWrite() const noexcept;
+
+    /** Tries to lock this object for writing, returning false if anyone else holds it. */
+    bool tryEnterWrite() const noexcept;
+
+    /** Releases the write-lock. */
+    void exitWrite() const noexcept;
+
+    //==============================================================================
+    /** Locks a LightweightReadWriteLock for reading for the lifetime of this object. */
+    class ScopedReadLockType
+    {
+    public:
+        inline explicit ScopedReadLockType (const LightweightReadWriteLock& l) noexcept  : lock (l) { lock.enterRead(); }
+        inline ~ScopedReadLockType() noexcept                                            { lock.exitRead(); }
+
+    private:
+        const LightweightReadWriteLock& lock;
+        JUCE_DECLARE_NON_COPYABLE (ScopedReadLockType)
+    };
+
+    /** Locks a LightweightReadWriteLock for writing for the lifetime of this object. */
+    class ScopedWriteLockType
+    {
+    public:
+        inline explicit ScopedWriteLockType (const LightweightReadWriteLock& l) noexcept : lock (l) { lock.enterWrite(); }
+        inline ~ScopedWriteLockType() noexcept                                           { lock.exitWrite(); }
+
+    private:
+        const LightweightReadWriteLock& lock;
+        JUCE_DECLARE_NON_COPYABLE (ScopedWriteLockType)
+    };
+
+private:
+    //==============================================================================
+    // The state holds the number of readers, plus writerBit when a writer has the lock.
+    mutable Atomic<int> state, numWaitingWriters, numSleepingThreads;
+    enum { writerBit = 0x40000000 };
+
+    void sleepWhileStateIs (int) const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE (LightweightReadWriteLock)
+};
+
+
+#endif   // JUCE_LIGHTWEIGHTREADWRITELOCK_H_INCLUDED
@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+LightweightSemaphore::LightweightSemaphore (const int initialCount) noexcept
+    : count (initialCount)
+{
+    jassert (initialCount >= 0);
+}
+
+LightweightSemaphore::~LightweightSemaphore() noexcept
+{
+}
+
+bool LightweightSemaphore::tryWait() const noexcept
+{
+    for (;;)
+    {
+        const int c = count.get();
+
+        if (c <= 0)
+            return false;
+
+        if (count.compareAndSetBool (c - 1, c))
+            return true;
+    }
+}
+
+bool LightweightSemaphore::wait (const int timeOutMilliseconds) const noexcept
+{
+    for (int i = lightweightLockSpinCount; --i >= 0;)
+        if (tryWait())
+            return true;
+
+    if (timeOutMilliseconds == 0)
+        return false;
+
+    JUCE_ASSERT_NOT_REALTIME ("LightweightSemaphore::wait()");
+
+    const uint32 startTime = Time::getMillisecondCounter();
+
+    for (;;)
+    {
+        int timeToWait = -1;
+
+        if (timeOutMilliseconds > 0)
+        {
+            const int elapsed = (int) (Time::getMillisecondCounter() - startTime);
+
+            if (elapsed >= timeOutMilliseconds)
+                return tryWait();
+
+            timeToWait = timeOutMilliseconds - elapsed;
+        }
+
+        ++numSleepingThreads;
+
+        if (count.get() <= 0)
+            juce_waitOnAddress (&(count.value), 0, timeToWait);
+
+        --numSleepingThreads;
+
+        if (tryWait())
+            return true;
+    }
+}
+
+void LightweightSemaphore::signal (const int numToAdd) const noexcept
+{
+    jassert (numToAdd > 0);
+
+    count += numToAdd;
+
+    if (numSleepingThreads.get() > 0)
+        juce_wakeAddress (&(count.value), numToAdd > 1);
+}
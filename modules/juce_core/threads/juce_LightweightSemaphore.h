@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_LIGHTWEIGHTSEMAPHORE_H_INCLUDED
+#define JUCE_LIGHTWEIGHTSEMAPHORE_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A counting semaphore that only calls into the OS when a thread actually has to sleep.
+
+    signal() adds to the count, and wait() takes one from it, blocking while it's zero.
+    When no thread is waiting, signal() is a couple of atomic operations, which makes this
+    a cheaper way than WaitableEvent for one thread to hand work to another.
+
+    A waiting thread spins briefly before it goes to sleep, in the same way as a
+    LightweightMutex.
+
+    @see WaitableEvent, LightweightMutex
+*/
+class JUCE_API  LightweightSemaphore
+{
+public:
+    //==============================================================================
+    /** Creates a semaphore with the given initial count. */
+    explicit LightweightSemaphore (int initialCount = 0) noexcept;
+
+    /** Destructor.
+        If other threads are waiting on this object when it gets deleted, this
+        can cause nasty errors, so be careful!
+    */
+    ~LightweightSemaphore() noexcept;
+
+    //==============================================================================
+    /** Waits until the count is above zero, and then decrements it.
+
+        @param timeOutMilliseconds  the maximum time to wait, in milliseconds. A negative
+                                    value will cause it to wait forever.
+        @returns    true if the count was decremented, or false if it timed out
+    */
+    bool wait (int timeOutMilliseconds = -1) const noexcept;
+
+    /** Decrements the count if it's above zero, without waiting.
+        @returns true if the count was decremented
+    */
+    bool tryWait() const noexcept;
+
+    /** Increments the count, waking up as many waiting threads as it can satisfy. */
+    void signal (int count = 1) const noexcept;
+
+    /** Returns the current count. */
+    int getCount() const noexcept          { return count.get(); }
+
+private:
+    //==============================================================================
+    mutable Atomic<int> count, numSleepingThreads;
+
+    JUCE_DECLARE_NON_COPYABLE (LightweightSemaphore)
+};
+
+
+#endif   // JUCE_LIGHTWEIGHTSEMAPHORE_H_INCLUDED
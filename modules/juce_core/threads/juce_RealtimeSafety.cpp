@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+static RealtimeSafety::ViolationHandling realtimeViolationHandling = RealtimeSafety::assertOnViolation;
+
+// (this has its own type, because on some platforms all the ThreadLocalValues
+// of the same type share their storage)
+struct RealtimeContextDepth
+{
+    RealtimeContextDepth() noexcept : depth (0) {}
+    int depth;
+};
+
+int& RealtimeSafety::getContextDepth() noexcept
+{
+    static ThreadLocalValue<RealtimeContextDepth> threadDepth;
+    return threadDepth.get().depth;
+}
+
+bool RealtimeSafety::isInRealtimeContext() noexcept
+{
+   #if JUCE_CHECK_REALTIME_SAFETY
+    return getContextDepth() > 0;
+   #else
+    return false;
+   #endif
+}
+
+void RealtimeSafety::setViolationHandling (const ViolationHandling newHandling) noexcept
+{
+    realtimeViolationHandling = newHandling;
+}
+
+void RealtimeSafety::reportViolation (const char* const operation) noexcept
+{
+    // (reporting the problem will allocate strings, which mustn't be reported again..)
+    const ScopedRealtimeExemption exemption;
+
+    switch (realtimeViolationHandling)
+    {
+        case assertOnViolation:
+            DBG ("Realtime-safety violation: " << operation);
+            jassertfalse; // something that can block or allocate was called from an audio callback!
+            break;
+
+        case logViolationWithStackTrace:
+            Logger::writeToLog ("Realtime-safety violation: " + String (operation) + newLine
+                                  + SystemStats::getStackBacktrace());
+            break;
+
+        default:
+            break;
+    }
+}
+
+bool JUCE_CALLTYPE juce_isInRealtimeContext() noexcept
+{
+    return RealtimeSafety::isInRealtimeContext();
+}
+
+void JUCE_CALLTYPE juce_reportRealtimeSafetyViolation (const char* const operation) noexcept
+{
+    RealtimeSafety::reportViolation (operation);
+}
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_REALTIMESAFETY_H_INCLUDED
+#define JUCE_REALTIMESAFETY_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Catches code that isn't realtime-safe being called from an audio callback.
+
+    When JUCE_CHECK_REALTIME_SAFETY is enabled, JUCE marks the audio callbacks of
+    AudioSourcePlayer, AudioProcessorPlayer and the plugin wrappers as realtime contexts.
+    While a thread is in one, any of these will be reported as a violation:
+
+    - allocating memory with a HeapBlock or MemoryBlock
+    - allocating the text of a String
+    - a CriticalSection::enter() that would have to wait for another thread (a lock
+      that's free is cheap to take, so only contended locks are reported)
+    - creating a MessageManagerLock
+    - calling Thread::sleep()
+
+    You can mark your own realtime threads with a ScopedRealtimeContext, and add checks
+    to your own code with the JUCE_ASSERT_NOT_REALTIME macro. When the flag isn't enabled,
+    all of this compiles to nothing.
+
+    @see ScopedRealtimeContext, ScopedRealtimeExemption
+*/
+class JUCE_API  RealtimeSafety
+{
+public:
+    //==============================================================================
+    /** Returns true if the calling thread is currently inside a realtime context.
+        This always returns false unless JUCE_CHECK_REALTIME_SAFETY is enabled.
+    */
+    static bool isInRealtimeContext() noexcept;
+
+    /** The ways in which a violation can be reported. */
+    enum ViolationHandling
+    {
+        assertOnViolation,          /**< Triggers a jassertfalse (the default). */
+        logViolationWithStackTrace, /**< Writes a stack trace to the Logger, and carries on. */
+        ignoreViolations            /**< Does nothing. */
+    };
+
+    /** Changes the way violations are reported. */
+    static void setViolationHandling (ViolationHandling) noexcept;
+
+    /** Reports a violation. This is called by the JUCE_ASSERT_NOT_REALTIME macro. */
+    static void reportViolation (const char* operation) noexcept;
+
+    //==============================================================================
+    /** Marks the calling thread as being in a realtime context while this object exists.
+        These can be nested.
+    */
+    class JUCE_API  ScopedRealtimeContext
+    {
+    public:
+       #if JUCE_CHECK_REALTIME_SAFETY
+        ScopedRealtimeContext() noexcept    { ++getContextDepth(); }
+        ~ScopedRealtimeContext() noexcept   { --getContextDepth(); }
+       #else
+        ScopedRealtimeContext() noexcept    {}
+       #endif
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE (ScopedRealtimeContext)
+    };
+
+    /** Temporarily lifts the checks on the calling thread while this object exists.
+
+        This is for the rare places where an audio callback knowingly does something
+        that isn't realtime-safe, e.g. preparing itself on its first callback.
+    */
+    class JUCE_API  ScopedRealtimeExemption
+    {
+    public:
+       #if JUCE_CHECK_REALTIME_SAFETY
+        ScopedRealtimeExemption() noexcept  : previousDepth (getContextDepth())  { getContextDepth() = 0; }
+        ~ScopedRealtimeExemption() noexcept { getContextDepth() = previousDepth; }
+       #else
+        ScopedRealtimeExemption() noexcept  {}
+       #endif
+
+    private:
+       #if JUCE_CHECK_REALTIME_SAFETY
+        const int previousDepth;
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedRealtimeExemption)
+    };
+
+private:
+    //==============================================================================
+    static int& getContextDepth() noexcept;
+
+    RealtimeSafety() JUCE_DELETED_FUNCTION;
+    JUCE_DECLARE_NON_COPYABLE (RealtimeSafety)
+};
+
+
+#endif   // JUCE_REALTIMESAFETY_H_INCLUDED
@@ -0,0 +1,240 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+class RealtimeThreadGroup::WorkerThread  : public Thread
+{
+public:
+    WorkerThread (RealtimeThreadGroup& g, const String& name, const int index, const uint32 affinityMask)
+        : Thread (name), group (g), threadIndex (index), appliedTimingChangeCount (0)
+    {
+        if (affinityMask != 0)
+            setAffinityMask (affinityMask);
+
+        startThread (9);
+    }
+
+    void run() override
+    {
+        for (;;)
+        {
+            wait (-1);
+
+            if (threadShouldExit())
+                break;
+
+            const int timingChangeCount = group.timingChangeCount.get();
+
+            if (timingChangeCount != appliedTimingChangeCount)
+            {
+                appliedTimingChangeCount = timingChangeCount;
+                const double periodMs = group.callbackPeriodMs;
+                Thread::setCurrentThreadRealtime (periodMs, periodMs * 0.5, periodMs, 9);
+            }
+
+            ++(group.numActiveWorkers);
+            group.performItems (threadIndex);
+            --(group.numActiveWorkers);
+        }
+    }
+
+private:
+    RealtimeThreadGroup& group;
+    const int threadIndex;
+    int appliedTimingChangeCount;
+
+    JUCE_DECLARE_NON_COPYABLE (WorkerThread)
+};
+
+//==============================================================================
+RealtimeThreadGroup::RealtimeThreadGroup (const String& threadName, const int numWorkers,
+                                          const Array<uint32>& affinityMasks)
+    : currentJob (nullptr), numItemsToDo (0), callbackPeriodMs (0)
+{
+    nextItemIndex.set (closedItemIndex);
+
+    for (int i = 0; i < numWorkers; ++i)
+        workers.add (new WorkerThread (*this, threadName, i + 1, affinityMasks[i]));
+}
+
+RealtimeThreadGroup::~RealtimeThreadGroup()
+{
+    for (int i = workers.size(); --i >= 0;)
+    {
+        workers.getUnchecked (i)->signalThreadShouldExit();
+        workers.getUnchecked (i)->notify();
+    }
+
+    for (int i = workers.size(); --i >= 0;)
+        workers.getUnchecked (i)->stopThread (4000);
+}
+
+void RealtimeThreadGroup::setCallbackPeriod (const double periodMs) noexcept
+{
+    if (periodMs > 0)
+    {
+        callbackPeriodMs = periodMs;
+        ++timingChangeCount;
+    }
+}
+
+void RealtimeThreadGroup::perform (Job& job, const int numItems) noexcept
+{
+    currentJob = &job;
+    numItemsToDo = numItems;
+    numItemsDone.set (0);
+
+    Atomic<int>::memoryBarrier();
+    nextItemIndex.set (0);
+
+    for (int i = workers.size(); --i >= 0;)
+        workers.getUnchecked (i)->notify();
+
+    performItems (0);
+    waitForItemsToFinish (numItems);
+
+    // Stop any workers that wake up late from grabbing items, and wait for the ones
+    // that are still looking for work before the job can be allowed to change.
+    nextItemIndex.set (closedItemIndex);
+
+    while (numActiveWorkers.get() > 0) {}
+}
+
+void RealtimeThreadGroup::waitForItemsToFinish (const int numItems) const noexcept
+{
+    while (numItemsDone.get() < numItems) {}
+}
+
+void RealtimeThreadGroup::performItems (const int threadIndex) noexcept
+{
+    for (;;)
+    {
+        const int index = (++nextItemIndex) - 1;
+
+        if (index >= numItemsToDo)
+            break;
+
+        currentJob->performItem (index, threadIndex);
+        ++numItemsDone;
+    }
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class RealtimeThreadGroupTests  : public UnitTest
+{
+public:
+    RealtimeThreadGroupTests()  : UnitTest ("RealtimeThreadGroup") {}
+
+    struct SummingJob  : public RealtimeThreadGroup::Job
+    {
+        SummingJob (RealtimeThreadGroup& g, int numThreads)
+            : group (g), totals ((size_t) numThreads, true), levelSize (0)
+        {}
+
+        // Each item adds its index into its thread's total, after checking that all
+        // the items in the earlier levels have finished..
+        void performItem (int itemIndex, int threadIndex) override
+        {
+            if (levelSize > 0)
+            {
+                const int levelStart = (itemIndex / levelSize) * levelSize;
+                group.waitForItemsToFinish (levelStart);
+
+                for (int i = 0; i < levelStart; ++i)
+                    if (! finished[i].get())
+                        errors.set (1);
+            }
+
+            totals[threadIndex] += itemIndex;
+            finished[itemIndex].set (1);
+        }
+
+        RealtimeThreadGroup& group;
+        HeapBlock<int64> totals;
+        Atomic<int> finished[1000], errors;
+        int levelSize;
+    };
+
+    static int64 getTotal (const SummingJob& job, int numThreads)
+    {
+        int64 total = 0;
+
+        for (int i = 0; i < numThreads; ++i)
+            total += job.totals[i];
+
+        return total;
+    }
+
+    void runTest() override
+    {
+        beginTest ("Performing items");
+        {
+            RealtimeThreadGroup group ("test", 3);
+            expectEquals (group.getNumWorkers(), 3);
+
+            SummingJob job (group, 4);
+
+            for (int i = 0; i < 100; ++i)
+                group.perform (job, 1000);
+
+            expect (getTotal (job, 4) == 100 * (int64) (999 * 1000 / 2));
+        }
+
+        beginTest ("Waiting for earlier items");
+        {
+            RealtimeThreadGroup group ("test", 3);
+            SummingJob job (group, 4);
+            job.levelSize = 10;
+
+            for (int i = 0; i < 20; ++i)
+            {
+                for (int j = 0; j < 1000; ++j)
+                    job.finished[j].set (0);
+
+                group.perform (job, 1000);
+            }
+
+            expect (getTotal (job, 4) == 20 * (int64) (999 * 1000 / 2));
+            expectEquals (job.errors.get(), 0);
+        }
+
+        beginTest ("No workers");
+        {
+            RealtimeThreadGroup group ("test", 0);
+            SummingJob job (group, 1);
+            group.perform (job, 1000);
+
+            expect (getTotal (job, 1) == (int64) (999 * 1000 / 2));
+        }
+    }
+};
+
+static RealtimeThreadGroupTests realtimeThreadGroupTests;
+
+#endif
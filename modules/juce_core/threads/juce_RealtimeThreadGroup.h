@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_REALTIMETHREADGROUP_H_INCLUDED
+#define JUCE_REALTIMETHREADGROUP_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A set of high-priority threads which help a realtime thread to get through a
+    list of independent pieces of work, such as the voices of a synth or the nodes
+    of an audio graph.
+
+    The thread that calls perform() takes part in the work, and the group's own
+    threads are woken up to take items from the same list. Items are handed out with
+    an atomic counter, and perform() spins until they're all done, so it never locks
+    or allocates, and can be called from an audio callback.
+
+    Only one thread should call perform() at a time.
+
+    @see Thread::setCurrentThreadRealtime
+*/
+class JUCE_API  RealtimeThreadGroup
+{
+public:
+    //==============================================================================
+    /** A list of work that a RealtimeThreadGroup can share out between its threads. */
+    class JUCE_API  Job
+    {
+    public:
+        /** Destructor. */
+        virtual ~Job() {}
+
+        /** Does one of the job's items.
+
+            This is called once for each item, on whichever thread picks it up. The
+            threadIndex is 0 for the thread that called RealtimeThreadGroup::perform(),
+            and 1 to getNumWorkers() for the group's own threads, so you can use it to
+            give each thread its own scratch space.
+        */
+        virtual void performItem (int itemIndex, int threadIndex) = 0;
+    };
+
+    //==============================================================================
+    /** Creates a group and starts its threads.
+
+        @param threadName       the name to give the threads
+        @param numWorkers       the number of threads to create, not counting the
+                                thread that'll call perform()
+        @param affinityMasks    optionally, an affinity mask for each thread. Any thread
+                                without a (non-zero) mask can run on any core.
+    */
+    RealtimeThreadGroup (const String& threadName, int numWorkers,
+                         const Array<uint32>& affinityMasks = Array<uint32>());
+
+    /** Destructor. This stops all the threads. */
+    ~RealtimeThreadGroup();
+
+    //==============================================================================
+    /** Returns the number of threads that the group has created. */
+    int getNumWorkers() const noexcept                  { return workers.size(); }
+
+    /** Tells the threads how often they'll be woken up.
+        The next time they wake up, they'll pass this on to Thread::setCurrentThreadRealtime().
+    */
+    void setCallbackPeriod (double periodMs) noexcept;
+
+    //==============================================================================
+    /** Calls job.performItem() for each index from 0 to numItems - 1, spread across
+        the calling thread and the group's threads, and returns once they're all done.
+    */
+    void perform (Job& job, int numItems) noexcept;
+
+    /** While perform() is running, this can be called from inside Job::performItem()
+        to wait until a number of items have finished.
+
+        Items are handed out in order, so if an item depends on all the items before a
+        certain index, this lets it wait for them.
+    */
+    void waitForItemsToFinish (int numItems) const noexcept;
+
+private:
+    //==============================================================================
+    class WorkerThread;
+    friend class WorkerThread;
+    friend struct ContainerDeletePolicy<WorkerThread>;
+
+    enum { closedItemIndex = 0x40000000 };
+
+    OwnedArray<WorkerThread> workers;
+    Job* volatile currentJob;
+    int volatile numItemsToDo;
+    Atomic<int> nextItemIndex, numItemsDone, numActiveWorkers, timingChangeCount;
+    double volatile callbackPeriodMs;
+
+    void performItems (int threadIndex) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE (RealtimeThreadGroup)
+};
+
+
+#endif   // JUCE_REALTIMETHREADGROUP_H_INCLUDED
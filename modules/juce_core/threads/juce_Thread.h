@@ -174,6 +174,30 @@ public:
     */
     static bool setCurrentThreadPriority (int priority);
 
+    /** Asks the OS to schedule the caller thread as a realtime thread.
+
+        This is intended for threads like audio callbacks, which wake up regularly and
+        must finish their work within a deadline. The timing values describe that work:
+        the thread wakes up every periodMs milliseconds, needs about computationMs of CPU
+        time each time, and must be done within constraintMs of waking up.
+
+        What happens depends on the platform:
+        - On OSX and iOS, the thread is given a THREAD_TIME_CONSTRAINT_POLICY using the
+          timing values.
+        - On Windows, the thread joins the MMCSS "Pro Audio" task, with the priority
+          selecting the MMCSS priority level.
+        - On Linux and Android, the thread is switched to SCHED_FIFO, with the priority
+          mapped onto the SCHED_FIFO range. This only works if the process is allowed to
+          use realtime scheduling (e.g. via an rtprio entry in /etc/security/limits.conf).
+
+        The priority uses the same 0 to 10 range as setPriority(). Returns false if the
+        OS refused the request.
+
+        @see setCurrentThreadPriority, setCurrentThreadAffinityMask
+    */
+    static bool JUCE_CALLTYPE setCurrentThreadRealtime (double periodMs, double computationMs,
+                                                        double constraintMs, int priority = 9);
+
     //==============================================================================
     /** Sets the affinity mask for the thread.
 
@@ -36,6 +36,45 @@
  #define JUCE_NO_COMPILER_THREAD_LOCAL 1
 #endif
 
+//==============================================================================
+/**
+    A thin wrapper around the OS's own thread-local storage slots (a pthread key or a
+    win32 FLS/TLS index), which holds one pointer per thread.
+
+    This is used internally by ThreadLocalValue - you probably won't need to use it
+    directly.
+
+    If a thread-exit callback is supplied, it's called on each thread that has stored a
+    non-null pointer when that thread terminates (on systems that don't support this,
+    the callback is never called).
+*/
+class JUCE_API  NativeThreadLocalSlot
+{
+public:
+    typedef void (JUCE_CALLTYPE* ThreadExitCallback) (void* valueForExitingThread);
+
+    /** Allocates a slot. */
+    NativeThreadLocalSlot (ThreadExitCallback threadExitCallback = nullptr) noexcept;
+
+    /** Releases the slot. The thread-exit callback won't be called after this. */
+    ~NativeThreadLocalSlot();
+
+    /** Returns the value that the calling thread last stored (or nullptr). */
+    void* get() const noexcept;
+
+    /** Sets the value for the calling thread. */
+    void set (void* newValue) const noexcept;
+
+    /** Returns false if the OS has run out of slots, in which case get() always returns nullptr. */
+    bool isValid() const noexcept           { return valid; }
+
+private:
+    pointer_sized_uint slot;
+    bool valid;
+
+    JUCE_DECLARE_NON_COPYABLE (NativeThreadLocalSlot)
+};
+
 //==============================================================================
 /**
     Provides cross-platform support for thread-local objects.
@@ -50,9 +89,10 @@
     The templated class for your value must be a primitive type, or a simple POD struct.
 
     When a thread no longer needs to use its value, it can call releaseCurrentThreadStorage()
-    to allow the storage to be re-used by another thread. If a thread exits without calling
-    this method, the object storage will be left allocated until the ThreadLocalValue object
-    is deleted.
+    to allow the storage to be re-used by another thread. On platforms where the value isn't
+    a native compiler thread-local, each thread's storage is also released automatically
+    when the thread exits (the storage itself is only freed when the ThreadLocalValue
+    object is deleted, but can be re-used by other threads).
 */
 template <typename Type>
 class ThreadLocalValue
@@ -60,6 +100,9 @@ class ThreadLocalValue
 public:
     /** */
     ThreadLocalValue() noexcept
+       #if JUCE_NO_COMPILER_THREAD_LOCAL
+        : currentThreadHolder (releaseHolderForExitingThread)
+       #endif
     {
     }
 
@@ -68,14 +111,6 @@ public:
     */
     ~ThreadLocalValue()
     {
-       #if JUCE_NO_COMPILER_THREAD_LOCAL
-        for (ObjectHolder* o = first.value; o != nullptr;)
-        {
-            ObjectHolder* const next = o->next;
-            delete o;
-            o = next;
-        }
-       #endif
     }
 
     /** Returns a reference to this thread's instance of the value.
@@ -110,39 +145,10 @@ public:
     Type& get() const noexcept
     {
        #if JUCE_NO_COMPILER_THREAD_LOCAL
-        const Thread::ThreadID threadId = Thread::getCurrentThreadId();
-
-        for (ObjectHolder* o = first.get(); o != nullptr; o = o->next)
-            if (o->threadId == threadId)
-                return o->object;
-
-        for (ObjectHolder* o = first.get(); o != nullptr; o = o->next)
-        {
-            if (o->threadId == nullptr)
-            {
-                {
-                    SpinLock::ScopedLockType sl (lock);
-
-                    if (o->threadId != nullptr)
-                        continue;
-
-                    o->threadId = threadId;
-                }
-
-                o->object = Type();
-                return o->object;
-            }
-        }
-
-        ObjectHolder* const newObject = new ObjectHolder (threadId);
-
-        do
-        {
-            newObject->next = first.get();
-        }
-        while (! first.compareAndSetBool (newObject, newObject->next));
+        if (ObjectHolder* const o = static_cast<ObjectHolder*> (currentThreadHolder.get()))
+            return o->object;
 
-        return newObject->object;
+        return findOrCreateHolder().object;
        #elif JUCE_MAC
         static __thread Type object;
         return object;
@@ -160,7 +166,7 @@ public:
        #if JUCE_NO_COMPILER_THREAD_LOCAL
         const Thread::ThreadID threadId = Thread::getCurrentThreadId();
 
-        for (ObjectHolder* o = first.get(); o != nullptr; o = o->next)
+        for (ObjectHolder* o = holders.first.get(); o != nullptr; o = o->next)
         {
             if (o->threadId == threadId)
             {
@@ -168,6 +174,8 @@ public:
                 o->threadId = nullptr;
             }
         }
+
+        currentThreadHolder.set (nullptr);
        #endif
     }
 
@@ -176,19 +184,92 @@ private:
    #if JUCE_NO_COMPILER_THREAD_LOCAL
     struct ObjectHolder
     {
-        ObjectHolder (const Thread::ThreadID& tid)
-            : threadId (tid), next (nullptr), object()
+        ObjectHolder (const Thread::ThreadID& tid, SpinLock& ownerLock)
+            : threadId (tid), next (nullptr), lock (ownerLock), object()
         {}
 
         Thread::ThreadID threadId;
         ObjectHolder* next;
+        SpinLock& lock;
         Type object;
 
         JUCE_DECLARE_NON_COPYABLE (ObjectHolder)
     };
 
-    mutable Atomic<ObjectHolder*> first;
-    SpinLock lock;
+    struct ObjectHolderList
+    {
+        ~ObjectHolderList()
+        {
+            for (ObjectHolder* o = first.value; o != nullptr;)
+            {
+                ObjectHolder* const next = o->next;
+                delete o;
+                o = next;
+            }
+        }
+
+        Atomic<ObjectHolder*> first;
+    };
+
+    mutable ObjectHolderList holders;
+    mutable SpinLock lock;
+
+    // Caches each thread's holder, so that after its first access a thread doesn't
+    // need to search the list. (Declared after the list and lock so that it's deleted
+    // first, which stops the exit callback being called on holders that are gone).
+    NativeThreadLocalSlot currentThreadHolder;
+
+    ObjectHolder& findOrCreateHolder() const
+    {
+        const Thread::ThreadID threadId = Thread::getCurrentThreadId();
+
+        for (ObjectHolder* o = holders.first.get(); o != nullptr; o = o->next)
+        {
+            if (o->threadId == threadId)
+            {
+                currentThreadHolder.set (o);
+                return *o;
+            }
+        }
+
+        for (ObjectHolder* o = holders.first.get(); o != nullptr; o = o->next)
+        {
+            if (o->threadId == nullptr)
+            {
+                {
+                    SpinLock::ScopedLockType sl (lock);
+
+                    if (o->threadId != nullptr)
+                        continue;
+
+                    o->threadId = threadId;
+                }
+
+                o->object = Type();
+                currentThreadHolder.set (o);
+                return *o;
+            }
+        }
+
+        ObjectHolder* const newObject = new ObjectHolder (threadId, lock);
+
+        do
+        {
+            newObject->next = holders.first.get();
+        }
+        while (! holders.first.compareAndSetBool (newObject, newObject->next));
+
+        currentThreadHolder.set (newObject);
+        return *newObject;
+    }
+
+    static void JUCE_CALLTYPE releaseHolderForExitingThread (void* holder)
+    {
+        ObjectHolder* const o = static_cast<ObjectHolder*> (holder);
+
+        SpinLock::ScopedLockType sl (o->lock);
+        o->threadId = nullptr;
+    }
    #endif
 
     JUCE_DECLARE_NON_COPYABLE (ThreadLocalValue)
@@ -26,27 +26,151 @@
   ==============================================================================
 */
 
+struct ThreadPool::WorkItem
+{
+    WorkItem() noexcept                     : job (nullptr), task (nullptr) {}
+    WorkItem (ThreadPoolJob* j) noexcept    : job (j), task (nullptr) {}
+    WorkItem (ThreadPoolTask* t) noexcept   : job (nullptr), task (t) {}
+
+    ThreadPoolJob* job;
+    ThreadPoolTask* task;
+};
+
+//==============================================================================
+/*  A double-ended queue of work items, which is owned by one of the pool's threads.
+    The owner adds and takes items at the back, and other threads steal them from the
+    front. None of these methods are thread-safe - the caller must hold the lock.
+*/
+class ThreadPool::WorkQueue
+{
+public:
+    WorkQueue() noexcept  : capacity (0), start (0), numItems (0) {}
+
+    int size() const noexcept                       { return numItems; }
+    WorkItem& operator[] (int index) const noexcept { return items [(start + index) & (capacity - 1)]; }
+
+    void addToBack (const WorkItem& item)
+    {
+        ensureSpaceForOneMore();
+        items [(start + numItems++) & (capacity - 1)] = item;
+    }
+
+    void addToFront (const WorkItem& item)
+    {
+        ensureSpaceForOneMore();
+        start = (start + capacity - 1) & (capacity - 1);
+        items [start] = item;
+        ++numItems;
+    }
+
+    void remove (int index) noexcept
+    {
+        jassert (isPositiveAndBelow (index, numItems));
+
+        // shuffle along whichever side of the gap is shorter, so that removing
+        // an item from either end doesn't need to move anything
+        if (index < numItems / 2)
+        {
+            for (int i = index; i > 0; --i)
+                (*this)[i] = (*this)[i - 1];
+
+            start = (start + 1) & (capacity - 1);
+        }
+        else
+        {
+            for (int i = index; i < numItems - 1; ++i)
+                (*this)[i] = (*this)[i + 1];
+        }
+
+        --numItems;
+    }
+
+    SpinLock lock;
+
+private:
+    HeapBlock<WorkItem> items;
+    int capacity, start, numItems;
+
+    void ensureSpaceForOneMore()
+    {
+        if (numItems >= capacity)
+        {
+            const int newCapacity = jmax (32, capacity * 2);
+            HeapBlock<WorkItem> newItems ((size_t) newCapacity);
+
+            for (int i = 0; i < numItems; ++i)
+                newItems[i] = (*this)[i];
+
+            items.swapWith (newItems);
+            capacity = newCapacity;
+            start = 0;
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (WorkQueue)
+};
+
+//==============================================================================
 class ThreadPool::ThreadPoolThread  : public Thread
 {
 public:
-    ThreadPoolThread (ThreadPool& p)
-       : Thread ("Pool"), currentJob (nullptr), pool (p)
+    ThreadPoolThread (ThreadPool& p, int threadIndex)
+       : Thread ("Pool"), currentJob (nullptr), pool (p), index (threadIndex)
     {
     }
 
     void run() override
     {
         while (! threadShouldExit())
-            if (! pool.runNextJob (*this))
+        {
+            if (pool.runNextWorkItem (this, false)
+                 || (! pool.useWorkStealing && pool.runNextJob (*this)))
+                continue;
+
+            // (the pool checks this flag after adding a work item, and the counter is
+            // re-checked here after setting it, so a new item can't be missed)
+            isIdle = 1;
+
+            if (pool.numQueuedWorkItems.get() == 0)
                 wait (500);
+
+            isIdle = 0;
+        }
     }
 
     ThreadPoolJob* volatile currentJob;
     ThreadPool& pool;
+    const int index;
+    WorkQueue queue;
+    Atomic<int> isIdle;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ThreadPoolThread)
 };
 
+//==============================================================================
+// Locks the queues of all the pool's threads, so that no work items can move between
+// the queues and the threads while the jobs are being inspected.
+class ThreadPool::ScopedLockAllQueues
+{
+public:
+    ScopedLockAllQueues (const ThreadPool& p) noexcept  : pool (p)
+    {
+        for (int i = 0; i < pool.threads.size(); ++i)
+            pool.threads.getUnchecked(i)->queue.lock.enter();
+    }
+
+    ~ScopedLockAllQueues() noexcept
+    {
+        for (int i = pool.threads.size(); --i >= 0;)
+            pool.threads.getUnchecked(i)->queue.lock.exit();
+    }
+
+private:
+    const ThreadPool& pool;
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedLockAllQueues)
+};
+
 //==============================================================================
 ThreadPoolJob::ThreadPoolJob (const String& name)
     : jobName (name), pool (nullptr),
@@ -85,7 +209,30 @@ ThreadPoolJob* ThreadPoolJob::getCurrentThreadPoolJob()
 }
 
 //==============================================================================
-ThreadPool::ThreadPool (const int numThreads)
+ThreadPoolTask::ThreadPoolTask() noexcept
+{
+}
+
+ThreadPoolTask::~ThreadPoolTask()
+{
+    // you mustn't delete a task while it's still waiting to be run by a pool!
+    jassert (state.get() != queued);
+}
+
+void ThreadPoolTask::addContinuation (ThreadPoolTask* const continuation)
+{
+    jassert (continuation != nullptr && continuation != this);
+
+    // continuations must be set up before the tasks are added to a pool
+    jassert (state.get() == notQueued && continuation->state.get() == notQueued);
+
+    continuations.add (continuation);
+    ++(continuation->numDependencies);
+}
+
+//==============================================================================
+ThreadPool::ThreadPool (const int numThreads, const bool useWorkStealingScheduler)
+    : useWorkStealing (useWorkStealingScheduler)
 {
     jassert (numThreads > 0); // not much point having a pool without any threads!
 
@@ -93,20 +240,25 @@ ThreadPool::ThreadPool (const int numThreads)
 }
 
 ThreadPool::ThreadPool()
+    : useWorkStealing (false)
 {
-    createThreads (SystemStats::getNumCpus());
+    createThreads (SystemStats::getNumPhysicalCpus());
 }
 
 ThreadPool::~ThreadPool()
 {
     removeAllJobs (true, 5000);
+
+    // you must wait for all your tasks to finish before deleting the pool!
+    jassert (numPendingTasks.get() == 0);
+
     stopThreads();
 }
 
 void ThreadPool::createThreads (int numThreads)
 {
-    for (int i = jmax (1, numThreads); --i >= 0;)
-        threads.add (new ThreadPoolThread (*this));
+    for (int i = 0; i < jmax (1, numThreads); ++i)
+        threads.add (new ThreadPoolThread (*this, i));
 
     for (int i = threads.size(); --i >= 0;)
         threads.getUnchecked(i)->startThread();
@@ -133,6 +285,13 @@ void ThreadPool::addJob (ThreadPoolJob* const job, const bool deleteJobWhenFinis
         job->isActive = false;
         job->shouldBeDeleted = deleteJobWhenFinished;
 
+        if (useWorkStealing)
+        {
+            ++numWorkStealingJobs;
+            addWorkItem (WorkItem (job));
+            return;
+        }
+
         {
             const ScopedLock sl (lock);
             jobs.add (job);
@@ -145,23 +304,60 @@ void ThreadPool::addJob (ThreadPoolJob* const job, const bool deleteJobWhenFinis
 
 int ThreadPool::getNumJobs() const
 {
-    return jobs.size();
+    return useWorkStealing ? numWorkStealingJobs.get() : jobs.size();
 }
 
 ThreadPoolJob* ThreadPool::getJob (const int index) const
 {
+    if (useWorkStealing)
+    {
+        Array<ThreadPoolJob*> allJobs;
+        getWorkStealingJobs (allJobs, false);
+        return allJobs [index];
+    }
+
     const ScopedLock sl (lock);
     return jobs [index];
 }
 
 bool ThreadPool::contains (const ThreadPoolJob* const job) const
 {
+    if (useWorkStealing)
+    {
+        const ScopedLockAllQueues sl (*this);
+
+        for (int i = threads.size(); --i >= 0;)
+        {
+            const ThreadPoolThread& thread = *threads.getUnchecked(i);
+
+            if (thread.currentJob == job)
+                return true;
+
+            for (int j = thread.queue.size(); --j >= 0;)
+                if (thread.queue[j].job == job)
+                    return true;
+        }
+
+        return false;
+    }
+
     const ScopedLock sl (lock);
     return jobs.contains (const_cast <ThreadPoolJob*> (job));
 }
 
 bool ThreadPool::isJobRunning (const ThreadPoolJob* const job) const
 {
+    if (useWorkStealing)
+    {
+        const ScopedLockAllQueues sl (*this);
+
+        for (int i = threads.size(); --i >= 0;)
+            if (threads.getUnchecked(i)->currentJob == job)
+                return true;
+
+        return false;
+    }
+
     const ScopedLock sl (lock);
     return jobs.contains (const_cast <ThreadPoolJob*> (job)) && job->isActive;
 }
@@ -191,7 +387,25 @@ bool ThreadPool::removeJob (ThreadPoolJob* const job,
     bool dontWait = true;
     OwnedArray<ThreadPoolJob> deletionList;
 
-    if (job != nullptr)
+    if (job != nullptr && useWorkStealing)
+    {
+        const ScopedLockAllQueues sl (*this);
+
+        if (! removeQueuedJob (job, deletionList))
+        {
+            for (int i = threads.size(); --i >= 0;)
+            {
+                if (threads.getUnchecked(i)->currentJob == job)
+                {
+                    if (interruptIfRunning)
+                        job->signalJobShouldExit();
+
+                    dontWait = false;
+                }
+            }
+        }
+    }
+    else if (job != nullptr)
     {
         const ScopedLock sl (lock);
 
@@ -223,6 +437,41 @@ bool ThreadPool::removeAllJobs (const bool interruptRunningJobs, const int timeO
     {
         OwnedArray<ThreadPoolJob> deletionList;
 
+        if (useWorkStealing)
+        {
+            const ScopedLockAllQueues sl (*this);
+
+            for (int i = threads.size(); --i >= 0;)
+            {
+                ThreadPoolThread& thread = *threads.getUnchecked(i);
+
+                if (ThreadPoolJob* const job = thread.currentJob)
+                {
+                    if (selectedJobsToRemove == nullptr || selectedJobsToRemove->isJobSuitable (job))
+                    {
+                        jobsToWaitFor.add (job);
+
+                        if (interruptRunningJobs)
+                            job->signalJobShouldExit();
+                    }
+                }
+
+                for (int j = thread.queue.size(); --j >= 0;)
+                {
+                    if (ThreadPoolJob* const job = thread.queue[j].job)
+                    {
+                        if (selectedJobsToRemove == nullptr || selectedJobsToRemove->isJobSuitable (job))
+                        {
+                            thread.queue.remove (j);
+                            --numQueuedWorkItems;
+                            --numWorkStealingJobs;
+                            addToDeleteList (deletionList, job);
+                        }
+                    }
+                }
+            }
+        }
+        else
         {
             const ScopedLock sl (lock);
 
@@ -276,6 +525,27 @@ bool ThreadPool::removeAllJobs (const bool interruptRunningJobs, const int timeO
 StringArray ThreadPool::getNamesOfAllJobs (const bool onlyReturnActiveJobs) const
 {
     StringArray s;
+
+    if (useWorkStealing)
+    {
+        const ScopedLockAllQueues sl (*this);
+
+        for (int i = 0; i < threads.size(); ++i)
+        {
+            const ThreadPoolThread& thread = *threads.getUnchecked(i);
+
+            if (const ThreadPoolJob* const job = thread.currentJob)
+                s.add (job->getJobName());
+
+            if (! onlyReturnActiveJobs)
+                for (int j = 0; j < thread.queue.size(); ++j)
+                    if (const ThreadPoolJob* const job = thread.queue[j].job)
+                        s.add (job->getJobName());
+        }
+
+        return s;
+    }
+
     const ScopedLock sl (lock);
 
     for (int i = 0; i < jobs.size(); ++i)
@@ -338,6 +608,7 @@ bool ThreadPool::runNextJob (ThreadPoolThread& thread)
 
         JUCE_TRY
         {
+            JUCE_TRACE_ZONE_FOR_OBJECT ("threads", "ThreadPoolJob::runJob", *job);
             result = job->runJob();
         }
         JUCE_CATCH_ALL_ASSERT
@@ -382,3 +653,460 @@ void ThreadPool::addToDeleteList (OwnedArray<ThreadPoolJob>& deletionList, Threa
     if (job->shouldBeDeleted)
         deletionList.add (job);
 }
+
+//==============================================================================
+void ThreadPool::addTask (ThreadPoolTask* const task)
+{
+    jassert (task != nullptr);
+
+    // a task that's a continuation of other tasks will be added automatically when they finish!
+    jassert (task->numDependencies.get() == 0);
+
+    // this task has already been added to a pool, and hasn't been run yet!
+    jassert (task->state.get() != ThreadPoolTask::queued);
+
+    if (task != nullptr)
+        scheduleTask (task);
+}
+
+void ThreadPool::scheduleTask (ThreadPoolTask* const task)
+{
+    task->state = ThreadPoolTask::queued;
+    ++numPendingTasks;
+
+    JUCE_TRACE_FLOW_START ("threads", "ThreadPool::scheduleTask", (pointer_sized_uint) task);
+    addWorkItem (WorkItem (task));
+}
+
+bool ThreadPool::waitForTask (ThreadPoolTask* const task, const int timeOutMs)
+{
+    if (task == nullptr)
+        return true;
+
+    ThreadPoolThread* const thread = getCurrentPoolThread();
+    const uint32 start = Time::getMillisecondCounter();
+    int numSpins = 0;
+
+    while (! task->isFinished())
+    {
+        // Rather than blocking, run any other tasks that are waiting. Jobs are left alone,
+        // because the caller might itself be a job, and a job can't run inside another one.
+        if (runNextWorkItem (thread, true))
+            continue;
+
+        if (timeOutMs >= 0 && Time::getMillisecondCounter() >= start + (uint32) timeOutMs)
+            return false;
+
+        if (++numSpins < 100)
+            Thread::yield();
+        else
+            taskFinishedSignal.wait (2);
+    }
+
+    return true;
+}
+
+void ThreadPool::runTask (ThreadPoolTask* const task)
+{
+    JUCE_TRY
+    {
+        JUCE_TRACE_ZONE_FOR_OBJECT ("threads", "ThreadPoolTask::run", *task);
+        JUCE_TRACE_FLOW_END ("threads", "ThreadPool::scheduleTask", (pointer_sized_uint) task);
+        task->run();
+    }
+    JUCE_CATCH_ALL_ASSERT
+
+    for (int i = 0; i < task->continuations.size(); ++i)
+    {
+        ThreadPoolTask* const continuation = task->continuations.getUnchecked(i);
+
+        if (--(continuation->numDependencies) == 0)
+            scheduleTask (continuation);
+    }
+
+    // after this, the task may be deleted by a thread that's waiting for it
+    task->state = ThreadPoolTask::finished;
+
+    --numPendingTasks;
+    taskFinishedSignal.signal();
+}
+
+//==============================================================================
+ThreadPool::ThreadPoolThread* ThreadPool::getCurrentPoolThread() const
+{
+    if (ThreadPoolThread* const t = dynamic_cast<ThreadPoolThread*> (Thread::getCurrentThread()))
+        if (&(t->pool) == this)
+            return t;
+
+    return nullptr;
+}
+
+void ThreadPool::addWorkItem (const WorkItem& item)
+{
+    ThreadPoolThread* thread = getCurrentPoolThread();
+
+    if (thread == nullptr)
+        thread = threads.getUnchecked ((int) ((uint32) ++nextQueueIndex % (uint32) threads.size()));
+
+    {
+        const SpinLock::ScopedLockType sl (thread->queue.lock);
+        thread->queue.addToBack (item);
+    }
+
+    ++numQueuedWorkItems;
+
+    // wake up one of the idle threads, if there are any
+    for (int i = 0; i < threads.size(); ++i)
+    {
+        ThreadPoolThread* const t = threads.getUnchecked ((thread->index + i) % threads.size());
+
+        if (t->isIdle.compareAndSetBool (0, 1))
+        {
+            t->notify();
+            break;
+        }
+    }
+}
+
+bool ThreadPool::takeWorkItem (ThreadPoolThread* const thread, const bool tasksOnly, WorkItem& result)
+{
+    const int numThreads = threads.size();
+    const int firstQueue = thread != nullptr ? thread->index : 0;
+
+    for (int i = 0; i < numThreads; ++i)
+    {
+        ThreadPoolThread& owner = *threads.getUnchecked ((firstQueue + i) % numThreads);
+        const bool isOwnQueue = (&owner == thread);
+
+        OwnedArray<ThreadPoolJob> deletionList;
+        const SpinLock::ScopedLockType sl (owner.queue.lock);
+        WorkQueue& queue = owner.queue;
+
+        for (int j = 0; j < queue.size(); ++j)
+        {
+            // a thread takes the newest items from its own queue, and steals the oldest ones from others
+            const int index = isOwnQueue ? queue.size() - 1 - j : j;
+            const WorkItem item (queue[index]);
+
+            if (tasksOnly && item.task == nullptr)
+                continue;
+
+            queue.remove (index);
+            --numQueuedWorkItems;
+
+            if (ThreadPoolJob* const job = item.job)
+            {
+                if (job->shouldStop)
+                {
+                    --numWorkStealingJobs;
+                    addToDeleteList (deletionList, job);
+                    jobFinishedSignal.signal();
+                    --j;
+                    continue;
+                }
+
+                // this is done while the lock is held, so that the job is never
+                // missing from both the queues and the threads
+                job->isActive = true;
+                thread->currentJob = job;
+            }
+
+            result = item;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ThreadPool::runNextWorkItem (ThreadPoolThread* const thread, const bool tasksOnly)
+{
+    WorkItem item;
+
+    if (! takeWorkItem (thread, tasksOnly, item))
+        return false;
+
+    if (item.task != nullptr)
+        runTask (item.task);
+    else
+        runWorkStealingJob (*thread, item.job);
+
+    return true;
+}
+
+void ThreadPool::runWorkStealingJob (ThreadPoolThread& thread, ThreadPoolJob* const job)
+{
+    ThreadPoolJob::JobStatus result = ThreadPoolJob::jobHasFinished;
+
+    JUCE_TRY
+    {
+        JUCE_TRACE_ZONE_FOR_OBJECT ("threads", "ThreadPoolJob::runJob", *job);
+        result = job->runJob();
+    }
+    JUCE_CATCH_ALL_ASSERT
+
+    OwnedArray<ThreadPoolJob> deletionList;
+    bool finished = false;
+
+    {
+        const SpinLock::ScopedLockType sl (thread.queue.lock);
+
+        job->isActive = false;
+        thread.currentJob = nullptr;
+
+        if (result != ThreadPoolJob::jobNeedsRunningAgain || job->shouldStop)
+        {
+            --numWorkStealingJobs;
+            addToDeleteList (deletionList, job);
+            finished = true;
+        }
+        else
+        {
+            // put the job at the far end of the queue if it wants another go
+            thread.queue.addToFront (WorkItem (job));
+            ++numQueuedWorkItems;
+        }
+    }
+
+    if (finished)
+        jobFinishedSignal.signal();
+}
+
+void ThreadPool::getWorkStealingJobs (Array<ThreadPoolJob*>& result, const bool onlyActiveJobs) const
+{
+    const ScopedLockAllQueues sl (*this);
+
+    for (int i = 0; i < threads.size(); ++i)
+        if (ThreadPoolJob* const job = threads.getUnchecked(i)->currentJob)
+            result.add (job);
+
+    if (! onlyActiveJobs)
+    {
+        for (int i = 0; i < threads.size(); ++i)
+        {
+            const WorkQueue& queue = threads.getUnchecked(i)->queue;
+
+            for (int j = 0; j < queue.size(); ++j)
+                if (ThreadPoolJob* const job = queue[j].job)
+                    result.add (job);
+        }
+    }
+}
+
+bool ThreadPool::removeQueuedJob (ThreadPoolJob* const job, OwnedArray<ThreadPoolJob>& deletionList)
+{
+    // (the caller must have locked all the queues)
+    for (int i = threads.size(); --i >= 0;)
+    {
+        WorkQueue& queue = threads.getUnchecked(i)->queue;
+
+        for (int j = queue.size(); --j >= 0;)
+        {
+            if (queue[j].job == job)
+            {
+                queue.remove (j);
+                --numQueuedWorkItems;
+                --numWorkStealingJobs;
+                addToDeleteList (deletionList, job);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+//==============================================================================
+struct ThreadPool::ParallelForTask  : public ThreadPoolTask
+{
+    ParallelForTask (ParallelForBody& b, Atomic<int>& next, int end, int chunk) noexcept
+        : body (b), nextIndex (next), endIndex (end), chunkSize (chunk)
+    {
+    }
+
+    void run() override
+    {
+        for (;;)
+        {
+            const int chunkStart = (nextIndex += chunkSize) - chunkSize;
+
+            if (chunkStart >= endIndex)
+                break;
+
+            const int chunkEnd = jmin (endIndex, chunkStart + chunkSize);
+
+            for (int i = chunkStart; i < chunkEnd; ++i)
+                body.process (i);
+        }
+    }
+
+    ParallelForBody& body;
+    Atomic<int>& nextIndex;
+    const int endIndex, chunkSize;
+
+    JUCE_DECLARE_NON_COPYABLE (ParallelForTask)
+};
+
+void ThreadPool::runParallelFor (const int startIndex, const int endIndex, int chunkSize, ParallelForBody& body)
+{
+    chunkSize = jmax (1, chunkSize);
+
+    if (endIndex <= startIndex)
+        return;
+
+    // The helper tasks all take chunks of the range from a shared counter until it's
+    // used up, so the work stays balanced even if some threads are busy with other things.
+    Atomic<int> nextIndex (startIndex);
+    const int numChunks = (int) (((int64) endIndex - startIndex + chunkSize - 1) / chunkSize);
+    const int numHelpers = jmin (threads.size(), numChunks - 1);
+
+    OwnedArray<ParallelForTask> helpers;
+
+    for (int i = 0; i < numHelpers; ++i)
+    {
+        ParallelForTask* const t = helpers.add (new ParallelForTask (body, nextIndex, endIndex, chunkSize));
+        addTask (t);
+    }
+
+    ParallelForTask callerTask (body, nextIndex, endIndex, chunkSize);
+    callerTask.run();
+
+    for (int i = 0; i < helpers.size(); ++i)
+        waitForTask (helpers.getUnchecked(i));
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ThreadPoolTests  : public UnitTest
+{
+public:
+    ThreadPoolTests() : UnitTest ("ThreadPool") {}
+
+    struct CountingJob  : public ThreadPoolJob
+    {
+        CountingJob (const String& name, Atomic<int>& c, int runs) : ThreadPoolJob (name), counter (c), numRunsLeft (runs) {}
+
+        JobStatus runJob() override
+        {
+            ++counter;
+            return --numRunsLeft > 0 ? jobNeedsRunningAgain : jobHasFinished;
+        }
+
+        Atomic<int>& counter;
+        int numRunsLeft;
+    };
+
+    struct OddNumberedJobSelector  : public ThreadPool::JobSelector
+    {
+        bool isJobSuitable (ThreadPoolJob* job) override    { return job->getJobName().getIntValue() % 2 != 0; }
+    };
+
+    struct OrderedTask  : public ThreadPoolTask
+    {
+        OrderedTask (Atomic<int>& c) : counter (c), order (-1) {}
+        void run() override     { order = ++counter; }
+
+        Atomic<int>& counter;
+        int order;
+    };
+
+    struct Summer
+    {
+        Summer (Atomic<int>& t) : total (t) {}
+        void operator() (int i) const   { total += i; }
+
+        Atomic<int>& total;
+    };
+
+    struct NestedLoopTask  : public ThreadPoolTask
+    {
+        NestedLoopTask (ThreadPool& p, Atomic<int>& t) : pool (p), total (t) {}
+        void run() override     { pool.parallelFor (0, 1000, Summer (total), 10); }
+
+        ThreadPool& pool;
+        Atomic<int>& total;
+    };
+
+    void runTest()
+    {
+        beginTest ("Work-stealing jobs");
+
+        {
+            ThreadPool pool (4, true);
+            Atomic<int> counter;
+
+            for (int i = 0; i < 2000; ++i)
+                pool.addJob (new CountingJob (String (i), counter, (i % 4) + 1), true);
+
+            for (int i = 0; i < 1000 && pool.getNumJobs() > 0; ++i)
+                Thread::sleep (5);
+
+            expectEquals (pool.getNumJobs(), 0);
+            expectEquals (counter.get(), 5000);
+        }
+
+        beginTest ("Work-stealing job removal");
+
+        {
+            ThreadPool pool (2, true);
+            Atomic<int> counter;
+            OddNumberedJobSelector selector;
+
+            for (int i = 0; i < 200; ++i)
+                pool.addJob (new CountingJob (String (i), counter, 0x7fffffff), true);
+
+            for (int i = 0; i < pool.getNumJobs(); ++i)
+                if (ThreadPoolJob* job = pool.getJob (i))
+                    expect (pool.contains (job));
+
+            expect (pool.removeAllJobs (true, 5000, &selector));
+            expectEquals (pool.getNumJobs(), 100);
+            expect (pool.removeAllJobs (true, 5000));
+            expectEquals (pool.getNumJobs(), 0);
+        }
+
+        beginTest ("Task continuations");
+
+        {
+            ThreadPool pool (3);
+            Atomic<int> counter;
+            OrderedTask a (counter), b (counter), c (counter);
+
+            a.addContinuation (&c);
+            b.addContinuation (&c);
+            pool.addTask (&a);
+            pool.addTask (&b);
+
+            expect (pool.waitForTask (&c, 5000));
+            expect (a.isFinished() && b.isFinished() && c.isFinished());
+            expectEquals (c.order, 3);
+        }
+
+        beginTest ("parallelFor");
+
+        {
+            ThreadPool pool (4);
+
+            Atomic<int> total;
+            pool.parallelFor (0, 10000, Summer (total));
+            expectEquals (total.get(), 10000 * 9999 / 2);
+
+            Atomic<int> nestedTotal;
+            OwnedArray<NestedLoopTask> tasks;
+
+            for (int i = 0; i < 16; ++i)
+                pool.addTask (tasks.add (new NestedLoopTask (pool, nestedTotal)));
+
+            for (int i = 0; i < tasks.size(); ++i)
+                expect (pool.waitForTask (tasks.getUnchecked(i), 5000));
+
+            expectEquals (nestedTotal.get(), 16 * (1000 * 999 / 2));
+        }
+    }
+};
+
+static ThreadPoolTests threadPoolUnitTests;
+
+#endif
@@ -137,6 +137,69 @@ private:
 };
 
 
+//==============================================================================
+/**
+    A lightweight piece of work that can be run by a ThreadPool.
+
+    Tasks are much cheaper to schedule than ThreadPoolJobs, so they're a better choice
+    when you need to run a large number of small operations. Unlike a ThreadPoolJob, a
+    task will always run to completion once it has been added to a pool, and it doesn't
+    appear in the pool's list of jobs.
+
+    A task can have continuations - other tasks which the pool will automatically start
+    once all the tasks they've been attached to have finished. You can use
+    ThreadPool::waitForTask() to wait for a task to finish.
+
+    The pool doesn't take ownership of a task, so you must make sure that it isn't
+    deleted before it has finished running.
+
+    @see ThreadPool::addTask, ThreadPool::waitForTask, ThreadPool::parallelFor
+*/
+class JUCE_API  ThreadPoolTask
+{
+public:
+    //==============================================================================
+    /** Creates a task. */
+    ThreadPoolTask() noexcept;
+
+    /** Destructor. */
+    virtual ~ThreadPoolTask();
+
+    //==============================================================================
+    /** Performs the task's work.
+        Your subclass must implement this method. It will be called on one of the
+        pool's threads, or on a thread that's waiting for a task to finish.
+    */
+    virtual void run() = 0;
+
+    //==============================================================================
+    /** Makes another task start automatically when this one finishes.
+
+        The continuation will be added to the pool once this task, and any other tasks
+        that it has been made a continuation of, have finished. You mustn't add the
+        continuation to a pool yourself.
+
+        This must be called before either of the tasks is added to a pool, and a task
+        that has continuations can only be run once.
+    */
+    void addContinuation (ThreadPoolTask* continuation);
+
+    /** Returns true if the task has been run and has finished. */
+    bool isFinished() const noexcept                    { return state.get() == finished; }
+
+private:
+    //==============================================================================
+    friend class ThreadPool;
+
+    enum State { notQueued, queued, finished };
+
+    Array<ThreadPoolTask*> continuations;
+    Atomic<int> state, numDependencies;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ThreadPoolTask)
+};
+
+
 //==============================================================================
 /**
     A set of threads that will run a list of jobs.
@@ -144,7 +207,16 @@ private:
     When a ThreadPoolJob object is added to the ThreadPool's list, its runJob() method
     will be called by the next pooled thread that becomes free.
 
-    @see ThreadPoolJob, Thread
+    By default, the pool keeps all its jobs in a single list, which its threads take
+    turns to search. If you're going to add a very large number of short jobs, you can
+    create the pool with its work-stealing scheduler enabled, in which case each thread
+    has its own queue of jobs, and only takes work from the other threads' queues when
+    its own one is empty.
+
+    ThreadPoolTask objects, and the parallelFor() method, always use the per-thread
+    queues, regardless of which scheduler is used for jobs.
+
+    @see ThreadPoolJob, ThreadPoolTask, Thread
 */
 class JUCE_API  ThreadPool
 {
@@ -154,14 +226,18 @@ public:
         Once you've created a pool, you can give it some jobs by calling addJob().
         @param numberOfThreads  the number of threads to run. These will be started
                                 immediately, and will run until the pool is deleted.
+        @param useWorkStealingScheduler if true, jobs are kept in a queue for each thread
+                                rather than in a single shared list - see the class
+                                description for more details.
     */
-    ThreadPool (int numberOfThreads);
+    ThreadPool (int numberOfThreads, bool useWorkStealingScheduler = false);
 
     /** Creates a thread pool with one thread per CPU core.
         Once you've created a pool, you can give it some jobs by calling addJob().
         If you want to specify the number of threads, use the other constructor; this
-        one creates a pool which has one thread for each CPU core.
-        @see SystemStats::getNumCpus()
+        one creates a pool which has one thread for each physical CPU core, as extra
+        hardware threads on the same core don't add much for CPU-bound jobs.
+        @see SystemStats::getNumPhysicalCpus()
     */
     ThreadPool();
 
@@ -283,6 +359,60 @@ public:
     */
     StringArray getNamesOfAllJobs (bool onlyReturnActiveJobs) const;
 
+    //==============================================================================
+    /** Adds a task to the pool.
+
+        As soon as a thread is free, it will call the task's ThreadPoolTask::run() method.
+        If this is called from one of the pool's own threads, the task is added to that
+        thread's queue, so it will probably be run by the same thread.
+
+        The pool doesn't take ownership of the task, so you must make sure that the task
+        isn't deleted before it has finished (e.g. by calling waitForTask()).
+    */
+    void addTask (ThreadPoolTask* task);
+
+    /** Waits for a task to finish.
+
+        Rather than just blocking, the calling thread will help to run any other queued
+        tasks while it waits, so it's safe to call this from inside a task or a job that
+        is being run by this pool.
+
+        If the timeout period expires before the task finishes, this will return false.
+    */
+    bool waitForTask (ThreadPoolTask* task, int timeOutMilliseconds = -1);
+
+    /** Calls a function for each index in a range, spreading the work across the pool's threads.
+
+        The function object is called with each integer in the range
+        startIndex <= i < endIndex, in no particular order, and this method only returns
+        once they've all been done. The calling thread will also take part in the work.
+
+        The function must be a copyable object with an operator() which takes an int, and
+        it must be safe for it to be called by several threads at once. The indexes are
+        handed out in groups of chunkSize, so if each index is only a tiny amount of work,
+        using a bigger chunk size will reduce the overhead.
+
+        e.g.
+        @code
+        struct Normaliser
+        {
+            Normaliser (float* d, float g) : data (d), gain (g) {}
+            void operator() (int i) const    { data[i] *= gain; }
+
+            float* data;
+            float gain;
+        };
+
+        pool.parallelFor (0, numSamples, Normaliser (samples, gain), 1024);
+        @endcode
+    */
+    template <typename FunctionType>
+    void parallelFor (int startIndex, int endIndex, FunctionType function, int chunkSize = 1)
+    {
+        ParallelForFunction<FunctionType> body (function);
+        runParallelFor (startIndex, endIndex, chunkSize, body);
+    }
+
     /** Changes the priority of all the threads.
 
         This will call Thread::setPriority() for each thread in the pool.
@@ -296,13 +426,37 @@ private:
     Array <ThreadPoolJob*> jobs;
 
     class ThreadPoolThread;
+    class WorkQueue;
+    struct WorkItem;
+    struct ParallelForTask;
+    class ScopedLockAllQueues;
     friend class ThreadPoolJob;
     friend class ThreadPoolThread;
+    friend class ScopedLockAllQueues;
+    friend struct ParallelForTask;
     friend struct ContainerDeletePolicy<ThreadPoolThread>;
     OwnedArray<ThreadPoolThread> threads;
 
     CriticalSection lock;
-    WaitableEvent jobFinishedSignal;
+    WaitableEvent jobFinishedSignal, taskFinishedSignal;
+
+    const bool useWorkStealing;
+    Atomic<int> numWorkStealingJobs, numQueuedWorkItems, numPendingTasks, nextQueueIndex;
+
+    struct ParallelForBody
+    {
+        virtual ~ParallelForBody() {}
+        virtual void process (int index) = 0;
+    };
+
+    template <typename FunctionType>
+    struct ParallelForFunction  : public ParallelForBody
+    {
+        ParallelForFunction (FunctionType& f) : function (f) {}
+        void process (int index) override    { function (index); }
+
+        FunctionType& function;
+    };
 
     bool runNextJob (ThreadPoolThread&);
     ThreadPoolJob* pickNextJobToRun();
@@ -310,6 +464,17 @@ private:
     void createThreads (int numThreads);
     void stopThreads();
 
+    ThreadPoolThread* getCurrentPoolThread() const;
+    void addWorkItem (const WorkItem&);
+    bool takeWorkItem (ThreadPoolThread*, bool tasksOnly, WorkItem&);
+    bool runNextWorkItem (ThreadPoolThread*, bool tasksOnly);
+    void runWorkStealingJob (ThreadPoolThread&, ThreadPoolJob*);
+    void runTask (ThreadPoolTask*);
+    void scheduleTask (ThreadPoolTask*);
+    void getWorkStealingJobs (Array<ThreadPoolJob*>&, bool onlyActiveJobs) const;
+    bool removeQueuedJob (ThreadPoolJob*, OwnedArray<ThreadPoolJob>&);
+    void runParallelFor (int startIndex, int endIndex, int chunkSize, ParallelForBody&);
+
     // Note that this method has changed, and no longer has a parameter to indicate
     // whether the jobs should be deleted - see the new method for details.
     void removeAllJobs (bool, int, bool);
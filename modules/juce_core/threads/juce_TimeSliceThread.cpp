@@ -26,10 +26,26 @@
   ==============================================================================
 */
 
-TimeSliceThread::TimeSliceThread (const String& name)
-    : Thread (name),
-      clientBeingCalled (nullptr)
+class TimeSliceThread::HelperThread  : public Thread
 {
+public:
+    HelperThread (TimeSliceThread& t, const String& name)  : Thread (name), owner (t) {}
+    ~HelperThread()   { stopThread (2000); }
+
+    void run() override   { owner.serviceClients (*this); }
+
+private:
+    TimeSliceThread& owner;
+
+    JUCE_DECLARE_NON_COPYABLE (HelperThread)
+};
+
+//==============================================================================
+TimeSliceThread::TimeSliceThread (const String& name, const int numThreads)
+    : Thread (name)
+{
+    for (int i = 1; i < numThreads; ++i)
+        helpers.add (new HelperThread (*this, name + " " + String (i + 1)));
 }
 
 TimeSliceThread::~TimeSliceThread()
@@ -42,43 +58,64 @@ void TimeSliceThread::addTimeSliceClient (TimeSliceClient* const client, int mil
 {
     if (client != nullptr)
     {
-        const ScopedLock sl (listLock);
-        client->nextCallTime = Time::getCurrentTime() + RelativeTime::milliseconds (millisecondsBeforeStarting);
-        clients.addIfNotAlreadyThere (client);
-        notify();
+        {
+            const ScopedLock sl (listLock);
+
+            if (! clients.contains (client))
+            {
+                clients.add (client);
+                client->callingThread = nullptr;
+                client->numCalls = 0;
+                client->totalCallTime = client->maxCallTime = 0;
+                client->totalLateness = client->maxLateness = 0;
+            }
+
+            removeFromQueue (client);
+            client->nextCallTime = Time::getMillisecondCounterHiRes() + millisecondsBeforeStarting;
+
+            // if it's in the middle of being called, it'll be queued when the call returns
+            if (client->callingThread == nullptr)
+                addToQueue (client);
+        }
+
+        notifyAllThreads();
     }
 }
 
 void TimeSliceThread::removeTimeSliceClient (TimeSliceClient* const client)
 {
-    const ScopedLock sl1 (listLock);
-
-    // if there's a chance we're in the middle of calling this client, we need to
-    // also lock the outer lock..
-    if (clientBeingCalled == client)
-    {
-        const ScopedUnlock ul (listLock); // unlock first to get the order right..
-
-        const ScopedLock sl2 (callbackLock);
-        const ScopedLock sl3 (listLock);
+    const ScopedLock sl (listLock);
 
-        clients.removeFirstMatchingValue (client);
-    }
-    else
+    if (clients.contains (client))
     {
         clients.removeFirstMatchingValue (client);
+        removeFromQueue (client);
+
+        // if another thread is in the middle of calling this client, we need to wait
+        // for it to finish..
+        while (client->callingThread != nullptr
+                && client->callingThread != Thread::getCurrentThreadId())
+        {
+            const ScopedUnlock ul (listLock);
+            callbackFinished.wait (1);
+        }
     }
 }
 
 void TimeSliceThread::moveToFrontOfQueue (TimeSliceClient* client)
 {
-    const ScopedLock sl (listLock);
-
-    if (clients.contains (client))
     {
-        client->nextCallTime = Time::getCurrentTime();
-        notify();
+        const ScopedLock sl (listLock);
+
+        if (! queue.contains (client))
+            return;
+
+        removeFromQueue (client);
+        client->nextCallTime = Time::getMillisecondCounterHiRes();
+        addToQueue (client);
     }
+
+    notifyAllThreads();
 }
 
 int TimeSliceThread::getNumClients() const
@@ -92,80 +129,166 @@ TimeSliceClient* TimeSliceThread::getClient (const int i) const
     return clients [i];
 }
 
-//==============================================================================
-TimeSliceClient* TimeSliceThread::getNextClient (int index) const
+int TimeSliceThread::getNumThreads() const noexcept
+{
+    return helpers.size() + 1;
+}
+
+TimeSliceThread::ClientStats TimeSliceThread::getClientStats (TimeSliceClient* client) const
 {
-    Time soonest;
-    TimeSliceClient* client = nullptr;
+    ClientStats stats;
+
+    const ScopedLock sl (listLock);
+
+    if (clients.contains (client) && client->numCalls > 0)
+    {
+        stats.numCalls        = client->numCalls;
+        stats.averageCallTime = client->totalCallTime / (double) client->numCalls;
+        stats.maxCallTime     = client->maxCallTime;
+        stats.averageLateness = client->totalLateness / (double) client->numCalls;
+        stats.maxLateness     = client->maxLateness;
+    }
+
+    return stats;
+}
+
+void TimeSliceThread::resetClientStats()
+{
+    const ScopedLock sl (listLock);
 
     for (int i = clients.size(); --i >= 0;)
     {
-        TimeSliceClient* const c = clients.getUnchecked ((i + index) % clients.size());
+        TimeSliceClient* const c = clients.getUnchecked (i);
+        c->numCalls = 0;
+        c->totalCallTime = c->maxCallTime = 0;
+        c->totalLateness = c->maxLateness = 0;
+    }
+}
 
-        if (client == nullptr || c->nextCallTime < soonest)
-        {
-            client = c;
-            soonest = c->nextCallTime;
-        }
+//==============================================================================
+// The queue is a binary heap, with the client that's due soonest at the front.
+bool TimeSliceThread::isDueLaterThan (const TimeSliceClient* a, const TimeSliceClient* b) noexcept
+{
+    return a->nextCallTime > b->nextCallTime;
+}
+
+void TimeSliceThread::addToQueue (TimeSliceClient* const client)
+{
+    queue.add (client);
+    std::push_heap (queue.begin(), queue.end(), isDueLaterThan);
+}
+
+void TimeSliceThread::removeFromQueue (TimeSliceClient* const client)
+{
+    const int index = queue.indexOf (client);
+
+    if (index >= 0)
+    {
+        queue.remove (index);
+        std::make_heap (queue.begin(), queue.end(), isDueLaterThan);
     }
+}
 
-    return client;
+void TimeSliceThread::notifyAllThreads()
+{
+    notify();
+
+    for (int i = helpers.size(); --i >= 0;)
+        helpers.getUnchecked (i)->notify();
 }
 
+//==============================================================================
 void TimeSliceThread::run()
 {
-    int index = 0;
+    for (int i = 0; i < helpers.size(); ++i)
+        helpers.getUnchecked (i)->startThread();
+
+    serviceClients (*this);
+
+    for (int i = 0; i < helpers.size(); ++i)
+        helpers.getUnchecked (i)->signalThreadShouldExit();
+
+    notifyAllThreads();
 
-    while (! threadShouldExit())
+    for (int i = 0; i < helpers.size(); ++i)
+        helpers.getUnchecked (i)->stopThread (2000);
+}
+
+void TimeSliceThread::serviceClients (Thread& thread)
+{
+    while (! thread.threadShouldExit())
     {
+        TimeSliceClient* client = nullptr;
         int timeToWait = 500;
+        bool moreClientsAreDue = false;
 
         {
-            Time nextClientTime;
+            const ScopedLock sl (listLock);
 
+            if (queue.size() > 0)
             {
-                const ScopedLock sl2 (listLock);
+                TimeSliceClient* const first = queue.getFirst();
+                const double now = Time::getMillisecondCounterHiRes();
 
-                index = clients.size() > 0 ? ((index + 1) % clients.size()) : 0;
+                if (first->nextCallTime <= now)
+                {
+                    std::pop_heap (queue.begin(), queue.end(), isDueLaterThan);
+                    queue.removeLast();
 
-                if (TimeSliceClient* const firstClient = getNextClient (index))
-                    nextClientTime = firstClient->nextCallTime;
-            }
+                    client = first;
+                    client->callingThread = Thread::getCurrentThreadId();
 
-            const Time now (Time::getCurrentTime());
+                    const double lateness = now - client->nextCallTime;
+                    client->totalLateness += lateness;
+                    client->maxLateness = jmax (client->maxLateness, lateness);
 
-            if (nextClientTime > now)
-            {
-                timeToWait = (int) jmin ((int64) 500, (nextClientTime - now).inMilliseconds());
+                    moreClientsAreDue = queue.size() > 0 && queue.getFirst()->nextCallTime <= now;
+                }
+                else
+                {
+                    timeToWait = (int) jmin (500.0, std::ceil (first->nextCallTime - now));
+                }
             }
-            else
-            {
-                timeToWait = index == 0 ? 1 : 0;
+        }
 
-                const ScopedLock sl (callbackLock);
+        if (client == nullptr)
+        {
+            thread.wait (timeToWait);
+            continue;
+        }
 
-                {
-                    const ScopedLock sl2 (listLock);
-                    clientBeingCalled = getNextClient (index);
-                }
+        // give any idle threads a chance to pick up the other clients that are waiting
+        if (moreClientsAreDue && helpers.size() > 0)
+            notifyAllThreads();
 
-                if (clientBeingCalled != nullptr)
-                {
-                    const int msUntilNextCall = clientBeingCalled->useTimeSlice();
+        const double startTime = Time::getMillisecondCounterHiRes();
+        const int msUntilNextCall = client->useTimeSlice();
+        const double endTime = Time::getMillisecondCounterHiRes();
 
-                    const ScopedLock sl2 (listLock);
+        {
+            const ScopedLock sl (listLock);
 
-                    if (msUntilNextCall >= 0)
-                        clientBeingCalled->nextCallTime = now + RelativeTime::milliseconds (msUntilNextCall);
-                    else
-                        clients.removeFirstMatchingValue (clientBeingCalled);
+            client->callingThread = nullptr;
 
-                    clientBeingCalled = nullptr;
+            if (clients.contains (client))
+            {
+                const double callTime = endTime - startTime;
+                ++(client->numCalls);
+                client->totalCallTime += callTime;
+                client->maxCallTime = jmax (client->maxCallTime, callTime);
+
+                if (msUntilNextCall < 0)
+                {
+                    clients.removeFirstMatchingValue (client);
+                }
+                else if (! queue.contains (client))
+                {
+                    client->nextCallTime = endTime + msUntilNextCall;
+                    addToQueue (client);
                 }
             }
         }
 
-        if (timeToWait > 0)
-            wait (timeToWait);
+        callbackFinished.signal();
     }
 }
@@ -70,7 +70,10 @@ public:
 
 private:
     friend class TimeSliceThread;
-    Time nextCallTime;
+    double nextCallTime;
+    Thread::ThreadID callingThread;
+    int64 numCalls;
+    double totalCallTime, maxCallTime, totalLateness, maxLateness;
 };
 
 
@@ -79,6 +82,12 @@ private:
     A thread that keeps a list of clients, and calls each one in turn, giving them
     all a chance to run some sort of short task.
 
+    The clients are kept in a queue that's ordered by the time at which each one has
+    asked to be called next. By default they're all called on this thread, but if you
+    give the constructor a number of threads greater than 1, it'll also start some
+    helper threads, so that one slow client doesn't hold up all the others. A client
+    is never called by more than one thread at the same time.
+
     @see TimeSliceClient, Thread
 */
 class JUCE_API  TimeSliceThread   : public Thread
@@ -89,9 +98,10 @@ public:
         Creates a TimeSliceThread.
 
         When first created, the thread is not running. Use the startThread()
-        method to start it.
+        method to start it. If numThreads is more than 1, the extra threads are
+        started and stopped along with this one.
     */
-    explicit TimeSliceThread (const String& threadName);
+    explicit TimeSliceThread (const String& threadName, int numThreads = 1);
 
     /** Destructor.
 
@@ -129,6 +139,35 @@ public:
     /** Returns one of the registered clients. */
     TimeSliceClient* getClient (int index) const;
 
+    /** Returns the number of threads that are used to call the clients. */
+    int getNumThreads() const noexcept;
+
+    //==============================================================================
+    /** Timing information about the calls made to a client.
+        @see getClientStats
+    */
+    struct ClientStats
+    {
+        ClientStats() noexcept
+            : numCalls (0), averageCallTime (0), maxCallTime (0), averageLateness (0), maxLateness (0)
+        {
+        }
+
+        int64 numCalls;             /**< The number of times useTimeSlice() has been called. */
+        double averageCallTime;     /**< The mean time spent inside useTimeSlice(), in milliseconds. */
+        double maxCallTime;         /**< The longest time spent inside useTimeSlice(), in milliseconds. */
+        double averageLateness;     /**< The mean time by which calls were later than the client asked for, in milliseconds. */
+        double maxLateness;         /**< The longest time by which a call was later than the client asked for, in milliseconds. */
+    };
+
+    /** Returns the timing information for a client.
+        If the client hasn't been added to this thread, the stats will all be zero.
+    */
+    ClientStats getClientStats (TimeSliceClient* client) const;
+
+    /** Resets the timing information for all the clients. */
+    void resetClientStats();
+
     //==============================================================================
    #ifndef DOXYGEN
     void run() override;
@@ -136,11 +175,20 @@ public:
 
     //==============================================================================
 private:
-    CriticalSection callbackLock, listLock;
-    Array <TimeSliceClient*> clients;
-    TimeSliceClient* clientBeingCalled;
-
-    TimeSliceClient* getNextClient (int index) const;
+    class HelperThread;
+    friend class HelperThread;
+    friend struct ContainerDeletePolicy<HelperThread>;
+
+    CriticalSection listLock;
+    Array <TimeSliceClient*> clients, queue;
+    OwnedArray<HelperThread> helpers;
+    WaitableEvent callbackFinished;
+
+    void serviceClients (Thread&);
+    void addToQueue (TimeSliceClient*);
+    void removeFromQueue (TimeSliceClient*);
+    void notifyAllThreads();
+    static bool isDueLaterThan (const TimeSliceClient*, const TimeSliceClient*) noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TimeSliceThread)
 };
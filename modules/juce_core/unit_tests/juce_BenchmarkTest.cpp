@@ -0,0 +1,317 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+BenchmarkTest::BenchmarkTest (const String& nm)
+    : name (nm), runner (nullptr)
+{
+    getAllBenchmarks().add (this);
+}
+
+BenchmarkTest::~BenchmarkTest()
+{
+    getAllBenchmarks().removeFirstMatchingValue (this);
+}
+
+Array<BenchmarkTest*>& BenchmarkTest::getAllBenchmarks()
+{
+    static Array<BenchmarkTest*> benchmarks;
+    return benchmarks;
+}
+
+void BenchmarkTest::initialise()  {}
+void BenchmarkTest::shutdown()   {}
+
+void BenchmarkTest::performBenchmarks (BenchmarkRunner* const newRunner)
+{
+    jassert (newRunner != nullptr);
+    runner = newRunner;
+
+    initialise();
+    runBenchmarks();
+    shutdown();
+
+    runner = nullptr;
+}
+
+void BenchmarkTest::logMessage (const String& message)
+{
+    // This method's only valid while the benchmark is being run!
+    jassert (runner != nullptr);
+
+    runner->logMessage (message);
+}
+
+void BenchmarkTest::runBenchmark (const String& benchmarkName, Runnable& r)
+{
+    // This method's only valid while the benchmark is being run!
+    jassert (runner != nullptr);
+
+    runner->runBenchmark (*this, benchmarkName, r);
+}
+
+static volatile char benchmarkTestSink = 0;
+
+void BenchmarkTest::useByte (char c) noexcept
+{
+    benchmarkTestSink = c;
+}
+
+//==============================================================================
+BenchmarkRunner::BenchmarkRunner()
+    : warmUpMs (200), sampleMs (10), numSamplesPerBenchmark (50)
+{
+}
+
+BenchmarkRunner::~BenchmarkRunner()
+{
+}
+
+void BenchmarkRunner::setTimingParameters (int warmUpMilliseconds, int sampleMilliseconds, int numSamples) noexcept
+{
+    warmUpMs = jmax (0, warmUpMilliseconds);
+    sampleMs = jmax (1, sampleMilliseconds);
+    numSamplesPerBenchmark = jmax (1, numSamples);
+}
+
+int BenchmarkRunner::getNumResults() const noexcept
+{
+    return results.size();
+}
+
+const BenchmarkRunner::Result* BenchmarkRunner::getResult (int index) const noexcept
+{
+    return results [index];
+}
+
+void BenchmarkRunner::resultsUpdated()
+{
+}
+
+void BenchmarkRunner::logMessage (const String& message)
+{
+    Logger::writeToLog (message);
+}
+
+bool BenchmarkRunner::shouldAbortBenchmarks()
+{
+    return false;
+}
+
+void BenchmarkRunner::runBenchmarks (const Array<BenchmarkTest*>& benchmarks)
+{
+    results.clear();
+    resultsUpdated();
+
+    for (int i = 0; i < benchmarks.size(); ++i)
+    {
+        if (shouldAbortBenchmarks())
+            break;
+
+        try
+        {
+            benchmarks.getUnchecked(i)->performBenchmarks (this);
+        }
+        catch (...)
+        {
+            logMessage ("!!! An unhandled exception was thrown by " + benchmarks.getUnchecked(i)->getName());
+        }
+    }
+}
+
+void BenchmarkRunner::runAllBenchmarks()
+{
+    runBenchmarks (BenchmarkTest::getAllBenchmarks());
+}
+
+//==============================================================================
+namespace BenchmarkHelpers
+{
+    static int64 timeIterations (BenchmarkTest::Runnable& r, const int numIterations)
+    {
+        const int64 start = Time::getHighResolutionTicks();
+        r.run (numIterations);
+        return Time::getHighResolutionTicks() - start;
+    }
+
+    static double getPercentile (const Array<double>& sortedValues, const double percentile)
+    {
+        // (uses the nearest-rank method)
+        const int index = (int) std::ceil (percentile * sortedValues.size() / 100.0) - 1;
+        return sortedValues [jlimit (0, sortedValues.size() - 1, index)];
+    }
+
+    static String formatNanoseconds (const double seconds)
+    {
+        return String (seconds * 1.0e9, 3);
+    }
+
+    static String escapeForCSV (const String& s)
+    {
+        if (s.containsAnyOf (",\"\r\n"))
+            return "\"" + s.replace ("\"", "\"\"") + "\"";
+
+        return s;
+    }
+}
+
+void BenchmarkRunner::runBenchmark (BenchmarkTest& test, const String& benchmarkName, BenchmarkTest::Runnable& r)
+{
+    if (shouldAbortBenchmarks())
+        return;
+
+    logMessage ("Benchmarking: " + test.getName() + " / " + benchmarkName + "...");
+
+    const double ticksPerSecond = (double) Time::getHighResolutionTicksPerSecond();
+    const int64 warmUpEnd = Time::getHighResolutionTicks() + (int64) (ticksPerSecond * warmUpMs / 1000.0);
+    const int64 ticksPerSample = jmax ((int64) 1, (int64) (ticksPerSecond * sampleMs / 1000.0));
+    const int64 maxIterations = 0x40000000;
+
+    // Keep doubling the number of iterations until a run is long enough to time accurately and
+    // the warm-up time has passed, then scale the count to get the length of sample we want.
+    int64 numIterations = 1;
+
+    for (;;)
+    {
+        const int64 elapsed = BenchmarkHelpers::timeIterations (r, (int) numIterations);
+
+        if (elapsed >= ticksPerSample / 4 || numIterations >= maxIterations)
+        {
+            if (Time::getHighResolutionTicks() >= warmUpEnd)
+            {
+                numIterations = jlimit ((int64) 1, maxIterations, (numIterations * ticksPerSample) / jmax ((int64) 1, elapsed));
+                break;
+            }
+        }
+        else
+        {
+            numIterations *= 2;
+        }
+
+        if (shouldAbortBenchmarks())
+            return;
+    }
+
+    Result* const result = new Result();
+    result->benchmarkTestName = test.getName();
+    result->benchmarkName = benchmarkName;
+    result->iterationsPerSample = (int) numIterations;
+
+    for (int i = 0; i < numSamplesPerBenchmark && ! shouldAbortBenchmarks(); ++i)
+        result->samples.add (BenchmarkHelpers::timeIterations (r, (int) numIterations)
+                               / (ticksPerSecond * (double) numIterations));
+
+    Array<double> sorted (result->samples);
+    DefaultElementComparator<double> comparator;
+    sorted.sort (comparator);
+
+    const int numSamples = sorted.size();
+    double total = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+        total += sorted.getUnchecked (i);
+
+    result->mean = numSamples > 0 ? total / numSamples : 0.0;
+
+    double sumOfSquares = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double diff = sorted.getUnchecked (i) - result->mean;
+        sumOfSquares += diff * diff;
+    }
+
+    result->standardDeviation = numSamples > 1 ? std::sqrt (sumOfSquares / (numSamples - 1)) : 0.0;
+    result->minimum = sorted.getFirst();
+    result->maximum = sorted.getLast();
+    result->median = BenchmarkHelpers::getPercentile (sorted, 50.0);
+    result->percentile99 = BenchmarkHelpers::getPercentile (sorted, 99.0);
+    result->medianTicks = result->median * ticksPerSecond;
+
+    results.add (result);
+
+    logMessage ("    median " + BenchmarkHelpers::formatNanoseconds (result->median)
+                 + " ns, p99 " + BenchmarkHelpers::formatNanoseconds (result->percentile99)
+                 + " ns, std dev " + BenchmarkHelpers::formatNanoseconds (result->standardDeviation)
+                 + " ns (" + String (numSamples) + " samples of " + String (result->iterationsPerSample) + " iterations)");
+
+    resultsUpdated();
+}
+
+//==============================================================================
+String BenchmarkRunner::getResultsAsJSON() const
+{
+    Array<var> list;
+
+    for (int i = 0; i < results.size(); ++i)
+    {
+        const Result& r = *results.getUnchecked (i);
+
+        DynamicObject* const obj = new DynamicObject();
+        var item (obj);
+
+        obj->setProperty ("test", r.benchmarkTestName);
+        obj->setProperty ("benchmark", r.benchmarkName);
+        obj->setProperty ("iterationsPerSample", r.iterationsPerSample);
+        obj->setProperty ("numSamples", r.samples.size());
+        obj->setProperty ("minNs", r.minimum * 1.0e9);
+        obj->setProperty ("maxNs", r.maximum * 1.0e9);
+        obj->setProperty ("meanNs", r.mean * 1.0e9);
+        obj->setProperty ("medianNs", r.median * 1.0e9);
+        obj->setProperty ("p99Ns", r.percentile99 * 1.0e9);
+        obj->setProperty ("stdDevNs", r.standardDeviation * 1.0e9);
+        obj->setProperty ("medianTicks", r.medianTicks);
+
+        list.add (item);
+    }
+
+    return JSON::toString (var (list));
+}
+
+String BenchmarkRunner::getResultsAsCSV() const
+{
+    String csv ("test,benchmark,iterations_per_sample,num_samples,min_ns,max_ns,mean_ns,median_ns,p99_ns,std_dev_ns,median_ticks\n");
+
+    for (int i = 0; i < results.size(); ++i)
+    {
+        const Result& r = *results.getUnchecked (i);
+
+        csv << BenchmarkHelpers::escapeForCSV (r.benchmarkTestName) << ','
+            << BenchmarkHelpers::escapeForCSV (r.benchmarkName) << ','
+            << r.iterationsPerSample << ','
+            << r.samples.size() << ','
+            << BenchmarkHelpers::formatNanoseconds (r.minimum) << ','
+            << BenchmarkHelpers::formatNanoseconds (r.maximum) << ','
+            << BenchmarkHelpers::formatNanoseconds (r.mean) << ','
+            << BenchmarkHelpers::formatNanoseconds (r.median) << ','
+            << BenchmarkHelpers::formatNanoseconds (r.percentile99) << ','
+            << BenchmarkHelpers::formatNanoseconds (r.standardDeviation) << ','
+            << String (r.medianTicks, 3) << '\n';
+    }
+
+    return csv;
+}
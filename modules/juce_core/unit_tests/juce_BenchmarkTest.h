@@ -0,0 +1,292 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_BENCHMARKTEST_H_INCLUDED
+#define JUCE_BENCHMARKTEST_H_INCLUDED
+
+class BenchmarkRunner;
+
+
+//==============================================================================
+/**
+    This is a base class for classes that measure the speed of some code.
+
+    It works in the same way as UnitTest: you create a subclass, and in its
+    runBenchmarks() method, call benchmark() for each piece of code that you want to
+    time, passing it a function object that performs one iteration of the operation.
+
+    @code
+    class VectorAddBenchmark  : public BenchmarkTest
+    {
+    public:
+        VectorAddBenchmark()  : BenchmarkTest ("FloatVectorOperations") {}
+
+        struct AddVectors
+        {
+            AddVectors() : a (512, true), b (512, true) {}
+            void operator()()    { FloatVectorOperations::add (a, b, 512); }
+
+            HeapBlock<float> a, b;
+        };
+
+        void runBenchmarks() override
+        {
+            AddVectors add;
+            benchmark ("add, 512 floats", add);
+        }
+    };
+
+    // Creating a static instance will automatically add the instance to the array
+    // returned by BenchmarkTest::getAllBenchmarks(), so that it'll be included when you
+    // call BenchmarkRunner::runAllBenchmarks()
+    static VectorAddBenchmark vectorAddBenchmark;
+    @endcode
+
+    Each benchmark is run for a short warm-up period, then the number of iterations that
+    it needs to run for a measurable length of time is worked out, and then a set of
+    samples of that many iterations are timed with Time::getHighResolutionTicks(). The
+    BenchmarkRunner collects the statistics for all the samples.
+
+    @see BenchmarkRunner, UnitTest
+*/
+class JUCE_API  BenchmarkTest
+{
+public:
+    //==============================================================================
+    /** Creates a benchmark with the given name. */
+    explicit BenchmarkTest (const String& name);
+
+    /** Destructor. */
+    virtual ~BenchmarkTest();
+
+    /** Returns the name of the benchmark. */
+    const String& getName() const noexcept       { return name; }
+
+    /** Runs the benchmark, using the specified BenchmarkRunner.
+        You shouldn't need to call this method directly - use
+        BenchmarkRunner::runBenchmarks() instead.
+    */
+    void performBenchmarks (BenchmarkRunner* runner);
+
+    /** Returns the set of all BenchmarkTest objects that currently exist. */
+    static Array<BenchmarkTest*>& getAllBenchmarks();
+
+    //==============================================================================
+    /** You can optionally implement this method to set up your benchmark.
+        This method will be called before runBenchmarks().
+    */
+    virtual void initialise();
+
+    /** You can optionally implement this method to clear up after your benchmark has run.
+        This method will be called after runBenchmarks() has returned.
+    */
+    virtual void shutdown();
+
+    /** Implement this method in your subclass to call benchmark() for each of the
+        operations that you want to measure.
+    */
+    virtual void runBenchmarks() = 0;
+
+    //==============================================================================
+    /** Measures how long a function object takes to run.
+
+        The object's operator()() should perform a single iteration of whatever you want to
+        time. It'll be called many times in a tight loop, and because the loop is generated
+        from this template, the call can be inlined, so even very quick operations can be
+        measured accurately.
+
+        If the compiler can see that the function's result isn't used, it may remove the
+        work altogether, so pass any results to doNotOptimiseAway().
+    */
+    template <typename FunctionType>
+    void benchmark (const String& benchmarkName, FunctionType& functionToTime)
+    {
+        FunctionRunner<FunctionType> f (functionToTime);
+        runBenchmark (benchmarkName, f);
+    }
+
+    /** Makes sure that the compiler treats a value as being used, so that the code which
+        calculates it won't get optimised out of a benchmark.
+    */
+    template <typename Type>
+    static void doNotOptimiseAway (const Type& value) noexcept
+    {
+        const volatile char* const p = reinterpret_cast<const volatile char*> (&value);
+        useByte (*p);
+    }
+
+    //==============================================================================
+    /** Writes a message to the log.
+        This can only be called from within your runBenchmarks() method.
+    */
+    void logMessage (const String& message);
+
+    /** The type of object that the benchmark() method wraps a function object in.
+        You won't need to use this directly.
+    */
+    struct Runnable
+    {
+        virtual ~Runnable() {}
+        virtual void run (int numIterations) = 0;
+    };
+
+private:
+    //==============================================================================
+    template <typename FunctionType>
+    struct FunctionRunner  : public Runnable
+    {
+        FunctionRunner (FunctionType& f) noexcept  : function (f) {}
+
+        void run (int numIterations) override
+        {
+            for (int i = numIterations; --i >= 0;)
+                function();
+        }
+
+        FunctionType& function;
+
+        JUCE_DECLARE_NON_COPYABLE (FunctionRunner)
+    };
+
+    const String name;
+    BenchmarkRunner* runner;
+
+    void runBenchmark (const String&, Runnable&);
+    static void useByte (char) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE (BenchmarkTest)
+};
+
+
+//==============================================================================
+/**
+    Runs a set of benchmarks, and collects their timings.
+
+    After running the benchmarks, the results can be read with getResult(), or turned
+    into JSON or CSV with getResultsAsJSON() and getResultsAsCSV(), so that they can be
+    stored and compared between different builds.
+
+    @see BenchmarkTest
+*/
+class JUCE_API  BenchmarkRunner
+{
+public:
+    //==============================================================================
+    /** */
+    BenchmarkRunner();
+
+    /** Destructor. */
+    virtual ~BenchmarkRunner();
+
+    /** Runs a set of benchmarks, in order, and logs their results. */
+    void runBenchmarks (const Array<BenchmarkTest*>& benchmarks);
+
+    /** Runs all the BenchmarkTest objects that currently exist.
+        This calls runBenchmarks() for all the objects listed in BenchmarkTest::getAllBenchmarks().
+    */
+    void runAllBenchmarks();
+
+    /** Changes how each benchmark gets measured.
+
+        @param warmUpMilliseconds       how long to run the code before starting to time it, to
+                                        let the caches and CPU clock speed settle down
+        @param sampleMilliseconds       roughly how long each timed sample should take - the
+                                        number of iterations per sample is chosen to make the
+                                        samples about this long
+        @param numSamples               the number of samples to take for each benchmark
+    */
+    void setTimingParameters (int warmUpMilliseconds, int sampleMilliseconds, int numSamples) noexcept;
+
+    //==============================================================================
+    /** Contains the timings of one of the benchmarks. All the times are in seconds per iteration. */
+    struct Result
+    {
+        /** The name of the BenchmarkTest object that was run. */
+        String benchmarkTestName;
+        /** The name that was passed to BenchmarkTest::benchmark(). */
+        String benchmarkName;
+
+        /** The number of iterations in each sample. */
+        int iterationsPerSample;
+        /** The time of each sample, divided by the number of iterations. */
+        Array<double> samples;
+
+        /** Statistics calculated from the samples. */
+        double minimum, maximum, mean, median, percentile99, standardDeviation;
+
+        /** The median time per iteration, in Time::getHighResolutionTicks() units. */
+        double medianTicks;
+    };
+
+    /** Returns the number of Result objects that have been produced.
+        @see getResult
+    */
+    int getNumResults() const noexcept;
+
+    /** Returns one of the Result objects describing a benchmark that has been run.
+        @see getNumResults
+    */
+    const Result* getResult (int index) const noexcept;
+
+    /** Returns all the results as a JSON array, with an object for each benchmark. */
+    String getResultsAsJSON() const;
+
+    /** Returns all the results as CSV, with a header line and then one line per benchmark. */
+    String getResultsAsCSV() const;
+
+protected:
+    /** Called when the list of results changes.
+        You can override this to perform some sort of behaviour when results are added.
+    */
+    virtual void resultsUpdated();
+
+    /** Logs a message about the benchmarks' progress.
+        By default this just writes the message to the Logger class, but you could override
+        this to do something else with the data.
+    */
+    virtual void logMessage (const String& message);
+
+    /** This can be overridden to let the runner know that it should stop as soon as
+        possible, e.g. because the thread needs to stop.
+    */
+    virtual bool shouldAbortBenchmarks();
+
+private:
+    //==============================================================================
+    friend class BenchmarkTest;
+
+    OwnedArray<Result> results;
+    int warmUpMs, sampleMs, numSamplesPerBenchmark;
+
+    void runBenchmark (BenchmarkTest&, const String& benchmarkName, BenchmarkTest::Runnable&);
+
+    JUCE_DECLARE_NON_COPYABLE (BenchmarkRunner)
+};
+
+
+#endif   // JUCE_BENCHMARKTEST_H_INCLUDED
@@ -410,7 +410,6 @@ XmlElement* XmlDocument::readNextElement (const bool alsoParseSubElements)
 
         node = new XmlElement (input, endOfToken);
         input = endOfToken;
-        LinkedListPointer<XmlElement::XmlAttributeNode>::Appender attributeAppender (node->attributes);
 
         // look for attributes
         for (;;)
@@ -423,6 +422,7 @@ XmlElement* XmlDocument::readNextElement (const bool alsoParseSubElements)
             if (c == '/' && input[1] == '>')
             {
                 input += 2;
+                node->attributes.minimiseStorageOverheads();
                 break;
             }
 
@@ -430,6 +430,7 @@ XmlElement* XmlDocument::readNextElement (const bool alsoParseSubElements)
             if (c == '>')
             {
                 ++input;
+                node->attributes.minimiseStorageOverheads();
 
                 if (alsoParseSubElements)
                     readChildElements (*node);
@@ -457,11 +458,8 @@ XmlElement* XmlDocument::readNextElement (const bool alsoParseSubElements)
 
                         if (nextChar == '"' || nextChar == '\'')
                         {
-                            XmlElement::XmlAttributeNode* const newAtt
-                                = new XmlElement::XmlAttributeNode (attNameStart, attNameEnd);
-
-                            readQuotedString (newAtt->value);
-                            attributeAppender.append (newAtt);
+                            node->attributes.add (XmlElement::XmlAttributeNode (attNameStart, attNameEnd));
+                            readQuotedString (node->attributes.getReference (node->attributes.size() - 1).value);
                             continue;
                         }
                     }
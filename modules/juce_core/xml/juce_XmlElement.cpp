@@ -26,12 +26,6 @@
   ==============================================================================
 */
 
-XmlElement::XmlAttributeNode::XmlAttributeNode (const XmlAttributeNode& other) noexcept
-    : name (other.name),
-      value (other.value)
-{
-}
-
 XmlElement::XmlAttributeNode::XmlAttributeNode (const Identifier& n, const String& v) noexcept
     : name (n), value (v)
 {
@@ -116,7 +110,7 @@ XmlElement& XmlElement::operator= (const XmlElement& other)
 XmlElement::XmlElement (XmlElement&& other) noexcept
     : nextListItem      (static_cast<LinkedListPointer<XmlElement>&&> (other.nextListItem)),
       firstChildElement (static_cast<LinkedListPointer<XmlElement>&&> (other.firstChildElement)),
-      attributes        (static_cast<LinkedListPointer<XmlAttributeNode>&&> (other.attributes)),
+      attributes        (static_cast<Array<XmlAttributeNode>&&> (other.attributes)),
       tagName           (static_cast<String&&> (other.tagName))
 {
 }
@@ -130,7 +124,7 @@ XmlElement& XmlElement::operator= (XmlElement&& other) noexcept
 
     nextListItem      = static_cast<LinkedListPointer<XmlElement>&&> (other.nextListItem);
     firstChildElement = static_cast<LinkedListPointer<XmlElement>&&> (other.firstChildElement);
-    attributes        = static_cast<LinkedListPointer<XmlAttributeNode>&&> (other.attributes);
+    attributes        = static_cast<Array<XmlAttributeNode>&&> (other.attributes);
     tagName           = static_cast<String&&> (other.tagName);
 
     return *this;
@@ -142,14 +136,13 @@ void XmlElement::copyChildrenAndAttributesFrom (const XmlElement& other)
     jassert (firstChildElement.get() == nullptr);
     firstChildElement.addCopyOfList (other.firstChildElement);
 
-    jassert (attributes.get() == nullptr);
-    attributes.addCopyOfList (other.attributes);
+    jassert (attributes.size() == 0);
+    attributes = other.attributes;
 }
 
 XmlElement::~XmlElement() noexcept
 {
     firstChildElement.deleteAll();
-    attributes.deleteAll();
 }
 
 //==============================================================================
@@ -262,7 +255,7 @@ void XmlElement::writeElementAsText (OutputStream& outputStream,
             const size_t attIndent = (size_t) (indentationLevel + tagName.length() + 1);
             int lineLen = 0;
 
-            for (const XmlAttributeNode* att = attributes; att != nullptr; att = att->nextListItem)
+            for (const XmlAttributeNode* att = attributes.begin(), * const end = attributes.end(); att != end; ++att)
             {
                 if (lineLen > lineWrapLength && indentationLevel >= 0)
                 {
@@ -437,24 +430,26 @@ int XmlElement::getNumAttributes() const noexcept
 
 const String& XmlElement::getAttributeName (const int index) const noexcept
 {
-    if (const XmlAttributeNode* const att = attributes [index])
-        return att->name.toString();
+    if (isPositiveAndBelow (index, attributes.size()))
+        return attributes.getReference (index).name.toString();
 
     return String::empty;
 }
 
 const String& XmlElement::getAttributeValue (const int index) const noexcept
 {
-    if (const XmlAttributeNode* const att = attributes [index])
-        return att->value;
+    if (isPositiveAndBelow (index, attributes.size()))
+        return attributes.getReference (index).value;
 
     return String::empty;
 }
 
 XmlElement::XmlAttributeNode* XmlElement::getAttribute (StringRef attributeName) const noexcept
 {
-    for (XmlAttributeNode* att = attributes; att != nullptr; att = att->nextListItem)
-        if (att->name == attributeName)
+    // (an Identifier passed in as the name will share its text with a matching attribute's
+    // name, so checking the pointers first avoids comparing the characters)
+    for (XmlAttributeNode* att = attributes.begin(), * const end = attributes.end(); att != end; ++att)
+        if (att->name.getCharPointer().getAddress() == attributeName.text.getAddress() || att->name == attributeName)
             return att;
 
     return nullptr;
@@ -528,27 +523,16 @@ bool XmlElement::compareAttribute (StringRef attributeName,
 //==============================================================================
 void XmlElement::setAttribute (const Identifier& attributeName, const String& value)
 {
-    if (attributes == nullptr)
-    {
-        attributes = new XmlAttributeNode (attributeName, value);
-    }
-    else
+    for (XmlAttributeNode* att = attributes.begin(), * const end = attributes.end(); att != end; ++att)
     {
-        for (XmlAttributeNode* att = attributes; ; att = att->nextListItem)
+        if (att->name == attributeName)
         {
-            if (att->name == attributeName)
-            {
-                att->value = value;
-                break;
-            }
-
-            if (att->nextListItem == nullptr)
-            {
-                att->nextListItem = new XmlAttributeNode (attributeName, value);
-                break;
-            }
+            att->value = value;
+            return;
         }
     }
+
+    attributes.add (XmlAttributeNode (attributeName, value));
 }
 
 void XmlElement::setAttribute (const Identifier& attributeName, const int number)
@@ -563,13 +547,11 @@ void XmlElement::setAttribute (const Identifier& attributeName, const double num
 
 void XmlElement::removeAttribute (const Identifier& attributeName) noexcept
 {
-    for (LinkedListPointer<XmlAttributeNode>* att = &attributes;
-         att->get() != nullptr;
-         att = &(att->get()->nextListItem))
+    for (int i = 0; i < attributes.size(); ++i)
     {
-        if (att->get()->name == attributeName)
+        if (attributes.getReference (i).name == attributeName)
         {
-            delete att->removeNext();
+            attributes.removeRange (i, 1);
             break;
         }
     }
@@ -577,7 +559,7 @@ void XmlElement::removeAttribute (const Identifier& attributeName) noexcept
 
 void XmlElement::removeAllAttributes() noexcept
 {
-    attributes.deleteAll();
+    attributes.clear();
 }
 
 //==============================================================================
@@ -692,42 +674,28 @@ bool XmlElement::isEquivalentTo (const XmlElement* const other,
 
         if (ignoreOrderOfAttributes)
         {
-            int totalAtts = 0;
+            if (attributes.size() != other->attributes.size())
+                return false;
 
-            for (const XmlAttributeNode* att = attributes; att != nullptr; att = att->nextListItem)
-            {
+            for (const XmlAttributeNode* att = attributes.begin(), * const end = attributes.end(); att != end; ++att)
                 if (! other->compareAttribute (att->name, att->value))
                     return false;
-
-                ++totalAtts;
-            }
-
-            if (totalAtts != other->getNumAttributes())
-                return false;
         }
         else
         {
-            const XmlAttributeNode* thisAtt = attributes;
-            const XmlAttributeNode* otherAtt = other->attributes;
+            if (attributes.size() != other->attributes.size())
+                return false;
 
-            for (;;)
+            for (int i = 0; i < attributes.size(); ++i)
             {
-                if (thisAtt == nullptr || otherAtt == nullptr)
-                {
-                    if (thisAtt == otherAtt) // both nullptr, so it's a match
-                        break;
+                const XmlAttributeNode& thisAtt  = attributes.getReference (i);
+                const XmlAttributeNode& otherAtt = other->attributes.getReference (i);
 
-                    return false;
-                }
-
-                if (thisAtt->name != otherAtt->name
-                     || thisAtt->value != otherAtt->value)
+                if (thisAtt.name != otherAtt.name
+                     || thisAtt.value != otherAtt.value)
                 {
                     return false;
                 }
-
-                thisAtt = thisAtt->nextListItem;
-                otherAtt = otherAtt->nextListItem;
             }
         }
 
@@ -728,27 +728,22 @@ public:
 private:
     struct XmlAttributeNode
     {
-        XmlAttributeNode (const XmlAttributeNode&) noexcept;
         XmlAttributeNode (const Identifier&, const String&) noexcept;
         XmlAttributeNode (String::CharPointerType, String::CharPointerType);
 
-        LinkedListPointer<XmlAttributeNode> nextListItem;
         Identifier name;
         String value;
-
-    private:
-        XmlAttributeNode& operator= (const XmlAttributeNode&) JUCE_DELETED_FUNCTION;
     };
 
     friend class XmlDocument;
-    friend class LinkedListPointer<XmlAttributeNode>;
+    friend class XmlPullParser;
     friend class LinkedListPointer<XmlElement>;
     friend class LinkedListPointer<XmlElement>::Appender;
     friend class NamedValueSet;
 
     LinkedListPointer<XmlElement> nextListItem;
     LinkedListPointer<XmlElement> firstChildElement;
-    LinkedListPointer<XmlAttributeNode> attributes;
+    Array<XmlAttributeNode> attributes;
     String tagName;
 
     XmlElement (int) noexcept;
@@ -0,0 +1,510 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+namespace XmlPullParserHelpers
+{
+    static bool startsWith (const char* p, const char* const end, const char* sequence) noexcept
+    {
+        for (; *sequence != 0; ++p, ++sequence)
+            if (p >= end || *p != *sequence)
+                return false;
+
+        return true;
+    }
+
+    static bool isNameChar (const char c) noexcept
+    {
+        // (any byte of a multi-byte UTF-8 character is allowed)
+        return (c & 0x80) != 0 || XmlIdentifierChars::isIdentifierChar ((juce_wchar) c);
+    }
+
+    static bool areEqual (const XmlPullParser::Slice& a, const XmlPullParser::Slice& b) noexcept
+    {
+        return a.getLength() == b.getLength()
+                && memcmp (a.start, b.start, (size_t) a.getLength()) == 0;
+    }
+}
+
+//==============================================================================
+bool XmlPullParser::Slice::operator== (StringRef other) const noexcept
+{
+    String::CharPointerType t (other.text);
+
+    for (CharPointer_UTF8 s (start); s.getAddress() < end;)
+        if (s.getAndAdvance() != t.getAndAdvance())
+            return false;
+
+    return t.isEmpty();
+}
+
+//==============================================================================
+XmlPullParser::XmlPullParser (const void* const utf8Data, const size_t numBytes)
+{
+    setData (utf8Data, numBytes);
+}
+
+XmlPullParser::XmlPullParser (const File& file)
+    : mappedFile (new MemoryMappedFile (file, MemoryMappedFile::readOnly))
+{
+    setData (mappedFile->getData(), mappedFile->getSize());
+
+    if (mappedFile->getData() == nullptr)
+        fail ("can't open file " + file.getFullPathName());
+}
+
+XmlPullParser::~XmlPullParser() {}
+
+void XmlPullParser::setData (const void* const data, const size_t numBytes) noexcept
+{
+    input = static_cast<const char*> (data);
+    inputEnd = input + (data != nullptr ? numBytes : 0);
+    currentEvent = text;
+    elementName.start = elementName.end = input;
+    textContent = elementName;
+    textIsCData = false;
+    isEmptyElement = false;
+    ignoreEmptyTextElements = true;
+
+    if (XmlPullParserHelpers::startsWith (input, inputEnd, "\xef\xbb\xbf"))
+        input += 3;
+}
+
+void XmlPullParser::setEmptyTextElementsIgnored (const bool shouldBeIgnored) noexcept
+{
+    ignoreEmptyTextElements = shouldBeIgnored;
+}
+
+XmlPullParser::EventType XmlPullParser::fail (const String& message)
+{
+    lastError = message;
+    input = inputEnd;
+    return currentEvent = parseError;
+}
+
+//==============================================================================
+XmlPullParser::EventType XmlPullParser::next()
+{
+    if (currentEvent == endOfDocument || currentEvent == parseError)
+        return currentEvent;
+
+    attributes.clearQuick();
+
+    if (isEmptyElement)
+    {
+        // a tag like <foo/> gets an endElement straight after its startElement
+        isEmptyElement = false;
+        openElements.removeLast();
+        return currentEvent = endElement;
+    }
+
+    for (;;)
+    {
+        if (input >= inputEnd)
+        {
+            if (openElements.size() > 0)
+                return fail ("unmatched tags");
+
+            return currentEvent = endOfDocument;
+        }
+
+        if (*input == '<')
+        {
+            if (readTag())
+                return currentEvent;
+
+            continue;
+        }
+
+        const char* const textStart = input;
+        const char* const nextTag = static_cast<const char*> (memchr (input, '<', (size_t) (inputEnd - input)));
+        input = nextTag != nullptr ? nextTag : inputEnd;
+
+        // (text outside the document element is ignored)
+        if (openElements.size() == 0)
+            continue;
+
+        if (ignoreEmptyTextElements)
+        {
+            const char* t = textStart;
+
+            while (t < input && CharacterFunctions::isWhitespace (*t))
+                ++t;
+
+            if (t == input)
+                continue;
+        }
+
+        textContent.start = textStart;
+        textContent.end = input;
+        textIsCData = false;
+        return currentEvent = text;
+    }
+}
+
+bool XmlPullParser::readTag()
+{
+    using namespace XmlPullParserHelpers;
+    ++input;
+
+    if (startsWith (input, inputEnd, "!--"))
+    {
+        if (! skipPast ("-->"))
+            fail ("unterminated comment");
+
+        return currentEvent == parseError;
+    }
+
+    if (startsWith (input, inputEnd, "![CDATA["))
+    {
+        input += 8;
+        textContent.start = input;
+
+        if (! skipPast ("]]>"))
+        {
+            fail ("unterminated CDATA section");
+            return true;
+        }
+
+        textContent.end = input - 3;
+        textIsCData = true;
+        currentEvent = text;
+        return openElements.size() > 0;
+    }
+
+    if (startsWith (input, inputEnd, "?"))
+    {
+        if (! skipPast ("?>"))
+            fail ("unterminated processing instruction");
+
+        return currentEvent == parseError;
+    }
+
+    if (startsWith (input, inputEnd, "!"))
+    {
+        // skip a DOCTYPE, including any internal DTD inside square brackets
+        for (int bracketDepth = 0; input < inputEnd;)
+        {
+            const char c = *input++;
+
+            if (c == '[')                            ++bracketDepth;
+            else if (c == ']')                       --bracketDepth;
+            else if (c == '>' && bracketDepth <= 0)  return false;
+        }
+
+        fail ("unterminated DOCTYPE");
+        return true;
+    }
+
+    if (startsWith (input, inputEnd, "/"))
+    {
+        ++input;
+        const Slice name (readName());
+        skipWhitespace();
+
+        if (! startsWith (input, inputEnd, ">"))
+        {
+            fail ("expected '>' at the end of " + name.toString());
+            return true;
+        }
+
+        ++input;
+
+        if (openElements.size() == 0 || ! areEqual (openElements.getLast(), name))
+        {
+            fail ("mismatched closing tag: " + name.toString());
+            return true;
+        }
+
+        openElements.removeLast();
+        elementName = name;
+        currentEvent = endElement;
+        return true;
+    }
+
+    elementName = readName();
+
+    if (elementName.isEmpty())
+    {
+        fail ("illegal character in tag");
+        return true;
+    }
+
+    for (;;)
+    {
+        skipWhitespace();
+
+        if (input >= inputEnd)
+        {
+            fail ("unterminated tag: " + elementName.toString());
+            return true;
+        }
+
+        if (*input == '>')
+        {
+            ++input;
+            break;
+        }
+
+        if (startsWith (input, inputEnd, "/>"))
+        {
+            input += 2;
+            isEmptyElement = true;
+            break;
+        }
+
+        Attribute att;
+        att.name = readName();
+
+        if (att.name.isEmpty())
+        {
+            fail ("illegal character found in " + elementName.toString() + ": '" + String::charToString ((juce_wchar) (uint8) *input) + "'");
+            return true;
+        }
+
+        skipWhitespace();
+
+        if (! startsWith (input, inputEnd, "="))
+        {
+            fail ("expected '=' after attribute '" + att.name.toString() + "'");
+            return true;
+        }
+
+        ++input;
+        skipWhitespace();
+
+        const char quote = input < inputEnd ? *input : 0;
+
+        if (quote != '"' && quote != '\'')
+        {
+            fail ("expected a quoted value for attribute '" + att.name.toString() + "'");
+            return true;
+        }
+
+        att.value.start = ++input;
+        att.value.end = static_cast<const char*> (memchr (input, quote, (size_t) (inputEnd - input)));
+
+        if (att.value.end == nullptr)
+        {
+            fail ("unterminated value for attribute '" + att.name.toString() + "'");
+            return true;
+        }
+
+        input = att.value.end + 1;
+        attributes.add (att);
+    }
+
+    openElements.add (elementName);
+    currentEvent = startElement;
+    return true;
+}
+
+bool XmlPullParser::skipPast (const char* const sequence) noexcept
+{
+    const size_t length = strlen (sequence);
+
+    for (; input + length <= inputEnd; ++input)
+    {
+        if (memcmp (input, sequence, length) == 0)
+        {
+            input += length;
+            return true;
+        }
+    }
+
+    input = inputEnd;
+    return false;
+}
+
+void XmlPullParser::skipWhitespace() noexcept
+{
+    while (input < inputEnd && CharacterFunctions::isWhitespace (*input))
+        ++input;
+}
+
+XmlPullParser::Slice XmlPullParser::readName() noexcept
+{
+    Slice name;
+    name.start = input;
+
+    while (input < inputEnd && XmlPullParserHelpers::isNameChar (*input))
+        ++input;
+
+    name.end = input;
+    return name;
+}
+
+//==============================================================================
+const XmlPullParser::Slice& XmlPullParser::getAttributeName (const int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, attributes.size()));
+    return attributes.getReference (index).name;
+}
+
+const XmlPullParser::Slice& XmlPullParser::getRawAttributeValue (const int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, attributes.size()));
+    return attributes.getReference (index).value;
+}
+
+String XmlPullParser::getAttributeValue (const int index) const
+{
+    return expandEntities (getRawAttributeValue (index));
+}
+
+String XmlPullParser::getAttributeValue (StringRef attributeName, const String& defaultReturnValue) const
+{
+    for (int i = 0; i < attributes.size(); ++i)
+        if (attributes.getReference (i).name == attributeName)
+            return getAttributeValue (i);
+
+    return defaultReturnValue;
+}
+
+String XmlPullParser::getText() const
+{
+    return textIsCData ? textContent.toString()
+                       : expandEntities (textContent);
+}
+
+String XmlPullParser::expandEntities (const Slice& s)
+{
+    if (memchr (s.start, '&', (size_t) s.getLength()) == nullptr)
+        return s.toString();
+
+    MemoryOutputStream result ((size_t) s.getLength());
+
+    for (const char* p = s.start; p < s.end;)
+    {
+        const char* const semicolon = *p == '&' ? static_cast<const char*> (memchr (p, ';', (size_t) (s.end - p)))
+                                                : nullptr;
+
+        if (semicolon == nullptr || semicolon - p > 12)
+        {
+            result.writeByte (*p++);
+            continue;
+        }
+
+        const String entity (CharPointer_UTF8 (p + 1), CharPointer_UTF8 (semicolon));
+        juce_wchar c = 0;
+
+        if (entity.equalsIgnoreCase ("amp"))        c = '&';
+        else if (entity.equalsIgnoreCase ("quot"))  c = '"';
+        else if (entity.equalsIgnoreCase ("apos"))  c = '\'';
+        else if (entity.equalsIgnoreCase ("lt"))    c = '<';
+        else if (entity.equalsIgnoreCase ("gt"))    c = '>';
+        else if (entity[0] == '#')
+            c = (juce_wchar) ((entity[1] == 'x' || entity[1] == 'X') ? entity.substring (2).getHexValue32()
+                                                                      : entity.substring (1).getIntValue());
+
+        if (c == 0)
+        {
+            // (entities from a DTD aren't supported, so these are left as they are)
+            result.writeByte (*p++);
+            continue;
+        }
+
+        result.appendUTF8Char (c);
+        p = semicolon + 1;
+    }
+
+    return result.toUTF8();
+}
+
+//==============================================================================
+bool XmlPullParser::skipElement()
+{
+    // This can only be called when the parser is at the start of an element!
+    jassert (currentEvent == startElement);
+
+    if (currentEvent != startElement)
+        return false;
+
+    for (const int parentDepth = openElements.size() - 1;;)
+    {
+        const EventType e = next();
+
+        if (e == parseError || e == endOfDocument)
+            return false;
+
+        if (e == endElement && openElements.size() == parentDepth)
+            return true;
+    }
+}
+
+XmlElement* XmlPullParser::createElement()
+{
+    // This can only be called when the parser is at the start of an element!
+    jassert (currentEvent == startElement);
+
+    if (currentEvent != startElement)
+        return nullptr;
+
+    ScopedPointer<XmlElement> result;
+    OwnedArray<LinkedListPointer<XmlElement>::Appender> childAppenders;
+
+    for (const int parentDepth = openElements.size() - 1;;)
+    {
+        switch (currentEvent)
+        {
+            case startElement:
+            {
+                XmlElement* const e = new XmlElement (elementName.toString());
+
+                if (result == nullptr)
+                    result = e;
+                else
+                    childAppenders.getLast()->append (e);
+
+                for (int i = 0; i < attributes.size(); ++i)
+                    e->attributes.add (XmlElement::XmlAttributeNode (Identifier (getAttributeName (i).toString()),
+                                                                     getAttributeValue (i)));
+
+                e->attributes.minimiseStorageOverheads();
+
+                childAppenders.add (new LinkedListPointer<XmlElement>::Appender (e->firstChildElement));
+                break;
+            }
+
+            case endElement:
+                if (openElements.size() == parentDepth)
+                    return result.release();
+
+                childAppenders.removeLast();
+                break;
+
+            case text:
+                childAppenders.getLast()->append (XmlElement::createTextElement (getText()));
+                break;
+
+            default:
+                return nullptr;
+        }
+
+        next();
+    }
+}
@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_XMLPULLPARSER_H_INCLUDED
+#define JUCE_XMLPULLPARSER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Reads through an XML document one item at a time, without building an
+    XmlElement tree for it.
+
+    XmlDocument always creates the whole tree, with a String for every name and value
+    in the file. For big files where you only want some of the data, this class is
+    much faster: it works directly on the UTF-8 data (or a memory-mapped file), and
+    each time you call next() it just finds the next tag or block of text, and gives
+    you pointers to the names and values inside it.
+
+    When you find an element that you're interested in, you can use createElement()
+    to turn just that part of the document into an XmlElement tree, or skipElement()
+    to quickly jump past a part that you don't need.
+
+    @code
+    XmlPullParser parser (pluginListFile);
+
+    while (parser.next() != XmlPullParser::endOfDocument)
+    {
+        if (parser.getEventType() == XmlPullParser::parseError)
+        {
+            DBG (parser.getLastParseError());
+            break;
+        }
+
+        if (parser.getEventType() == XmlPullParser::startElement && parser.getElementName() == "PLUGIN")
+            names.add (parser.getAttributeValue ("name"));
+    }
+    @endcode
+
+    The parser handles the standard character entities, comments, CDATA sections and
+    processing instructions, but unlike XmlDocument it ignores any DTD, so entities that
+    a DTD defines are left as they are. The data must be UTF-8.
+
+    @see XmlDocument, XmlElement
+*/
+class JUCE_API  XmlPullParser
+{
+public:
+    //==============================================================================
+    /** Creates a parser for a block of UTF-8 data.
+        The data isn't copied, so it must stay valid for the lifetime of the parser.
+    */
+    XmlPullParser (const void* utf8Data, size_t numBytes);
+
+    /** Creates a parser that memory-maps the given file.
+        If the file can't be opened, the first call to next() will return parseError.
+    */
+    explicit XmlPullParser (const File& file);
+
+    /** Destructor. */
+    ~XmlPullParser();
+
+    //==============================================================================
+    /** A range of characters within the document. */
+    struct JUCE_API  Slice
+    {
+        const char* start;
+        const char* end;
+
+        /** Returns the number of bytes in the slice. */
+        int getLength() const noexcept                          { return (int) (end - start); }
+
+        /** Returns true if the slice is empty. */
+        bool isEmpty() const noexcept                           { return start == end; }
+
+        /** Returns a copy of the characters. */
+        String toString() const                                 { return String (CharPointer_UTF8 (start), CharPointer_UTF8 (end)); }
+
+        /** Compares the slice with a string. */
+        bool operator== (StringRef other) const noexcept;
+        /** Compares the slice with a string. */
+        bool operator!= (StringRef other) const noexcept        { return ! operator== (other); }
+    };
+
+    //==============================================================================
+    /** The types of item that next() can find. */
+    enum EventType
+    {
+        startElement,   /**< An opening tag. A tag like <foo/> produces a startElement followed by an endElement. */
+        endElement,     /**< A closing tag. */
+        text,           /**< Some text or a CDATA section between two tags. */
+        endOfDocument,  /**< The end of the data has been reached. */
+        parseError      /**< The data isn't valid XML - see getLastParseError(). */
+    };
+
+    /** Moves on to the next item in the document, and returns its type.
+        Once this has returned endOfDocument or parseError, it'll keep returning it.
+    */
+    EventType next();
+
+    /** Returns the type of the item that next() last returned. */
+    EventType getEventType() const noexcept                     { return currentEvent; }
+
+    /** Returns the number of elements that are currently open, including the current one
+        if it's a startElement.
+    */
+    int getDepth() const noexcept                               { return openElements.size(); }
+
+    //==============================================================================
+    /** For a startElement or endElement, returns the element's tag name. */
+    const Slice& getElementName() const noexcept                { return elementName; }
+
+    /** For a startElement, returns the number of attributes it has. */
+    int getNumAttributes() const noexcept                       { return attributes.size(); }
+
+    /** For a startElement, returns the name of one of its attributes. */
+    const Slice& getAttributeName (int index) const noexcept;
+
+    /** For a startElement, returns the value of one of its attributes, without
+        expanding any character entities in it.
+    */
+    const Slice& getRawAttributeValue (int index) const noexcept;
+
+    /** For a startElement, returns the value of one of its attributes. */
+    String getAttributeValue (int index) const;
+
+    /** For a startElement, returns the value of the attribute with the given name, or
+        defaultReturnValue if there isn't one.
+    */
+    String getAttributeValue (StringRef attributeName, const String& defaultReturnValue = String()) const;
+
+    //==============================================================================
+    /** For a text item, returns the text without expanding any character entities in it. */
+    const Slice& getRawText() const noexcept                    { return textContent; }
+
+    /** For a text item, returns the text. */
+    String getText() const;
+
+    //==============================================================================
+    /** When the current item is a startElement, this skips everything up to and including
+        the matching endElement.
+        @returns false if there was a parse error
+    */
+    bool skipElement();
+
+    /** When the current item is a startElement, this reads everything up to and including
+        the matching endElement, and returns it as an XmlElement tree.
+        @returns a new XmlElement which the caller must delete, or nullptr if there was an error.
+    */
+    XmlElement* createElement();
+
+    /** Returns the error that caused next() to return parseError. */
+    const String& getLastParseError() const noexcept            { return lastError; }
+
+    /** Sets whether text items that only contain whitespace are skipped (the default) or
+        returned by next().
+    */
+    void setEmptyTextElementsIgnored (bool shouldBeIgnored) noexcept;
+
+private:
+    //==============================================================================
+    struct Attribute
+    {
+        Slice name, value;
+    };
+
+    ScopedPointer<MemoryMappedFile> mappedFile;
+    const char* input;
+    const char* inputEnd;
+    EventType currentEvent;
+    Slice elementName, textContent;
+    Array<Attribute> attributes;
+    Array<Slice> openElements;
+    String lastError;
+    bool textIsCData, isEmptyElement, ignoreEmptyTextElements;
+
+    void setData (const void*, size_t) noexcept;
+    bool readTag();
+    EventType fail (const String&);
+    bool skipPast (const char* sequence) noexcept;
+    void skipWhitespace() noexcept;
+    Slice readName() noexcept;
+    static String expandEntities (const Slice&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (XmlPullParser)
+};
+
+
+#endif   // JUCE_XMLPULLPARSER_H_INCLUDED
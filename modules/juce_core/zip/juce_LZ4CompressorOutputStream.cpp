@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+class LZ4CompressorOutputStream::LZ4CompressorHelper
+{
+public:
+    LZ4CompressorHelper (const int compressionLevel)
+        : context (nullptr),
+          headerWritten (false),
+          finished (false),
+          isValid (false)
+    {
+        zerostruct (preferences);
+        preferences.frameInfo.blockSizeID = LZ4F_max64KB;
+        preferences.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+        preferences.compressionLevel = jlimit (0, 12, compressionLevel);
+
+        // (this is big enough for the frame header, or the result of compressing one block)
+        bufferSize = LZ4F_compressBound ((size_t) maxInputBlockSize, &preferences) + 32;
+        buffer.malloc (bufferSize);
+
+        isValid = ! LZ4F_isError (LZ4F_createCompressionContext (&context, LZ4F_VERSION));
+    }
+
+    ~LZ4CompressorHelper()
+    {
+        if (context != nullptr)
+            LZ4F_freeCompressionContext (context);
+    }
+
+    bool write (const uint8* data, size_t dataSize, OutputStream& out)
+    {
+        // When you call flush() on an LZ4 stream, the stream is closed, and you can
+        // no longer continue to write data to it!
+        jassert (! finished);
+
+        if (! writeHeader (out))
+            return false;
+
+        while (dataSize > 0)
+        {
+            const size_t numToDo = jmin (dataSize, (size_t) maxInputBlockSize);
+
+            if (! writeOutput (LZ4F_compressUpdate (context, buffer, bufferSize, data, numToDo, nullptr), out))
+                return false;
+
+            data += numToDo;
+            dataSize -= numToDo;
+        }
+
+        return true;
+    }
+
+    void finish (OutputStream& out)
+    {
+        if (! finished && writeHeader (out))
+            writeOutput (LZ4F_compressEnd (context, buffer, bufferSize, nullptr), out);
+
+        finished = true;
+    }
+
+private:
+    enum { maxInputBlockSize = 65536 };
+
+    LZ4F_cctx* context;
+    LZ4F_preferences_t preferences;
+    HeapBlock<char> buffer;
+    size_t bufferSize;
+    bool headerWritten, finished, isValid;
+
+    bool writeHeader (OutputStream& out)
+    {
+        if (headerWritten)
+            return isValid;
+
+        headerWritten = true;
+        return isValid && writeOutput (LZ4F_compressBegin (context, buffer, bufferSize, &preferences), out);
+    }
+
+    bool writeOutput (const size_t result, OutputStream& out)
+    {
+        if (LZ4F_isError (result))
+        {
+            isValid = false;
+            return false;
+        }
+
+        return result == 0 || out.write (buffer, result);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (LZ4CompressorHelper)
+};
+
+//==============================================================================
+LZ4CompressorOutputStream::LZ4CompressorOutputStream (OutputStream* const out,
+                                                      const int compressionLevel,
+                                                      const bool deleteDestStream)
+    : destStream (out, deleteDestStream),
+      helper (new LZ4CompressorHelper (compressionLevel))
+{
+    jassert (out != nullptr);
+}
+
+LZ4CompressorOutputStream::~LZ4CompressorOutputStream()
+{
+    flush();
+}
+
+void LZ4CompressorOutputStream::flush()
+{
+    helper->finish (*destStream);
+    destStream->flush();
+}
+
+bool LZ4CompressorOutputStream::write (const void* destBuffer, size_t howMany)
+{
+    jassert (destBuffer != nullptr && (ssize_t) howMany >= 0);
+
+    return helper->write (static_cast <const uint8*> (destBuffer), howMany, *destStream);
+}
+
+int64 LZ4CompressorOutputStream::getPosition()
+{
+    return destStream->getPosition();
+}
+
+bool LZ4CompressorOutputStream::setPosition (int64 /*newPosition*/)
+{
+    jassertfalse; // can't do it!
+    return false;
+}
@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_LZ4COMPRESSOROUTPUTSTREAM_H_INCLUDED
+#define JUCE_LZ4COMPRESSOROUTPUTSTREAM_H_INCLUDED
+
+#if JUCE_USE_LZ4 || DOXYGEN
+
+//==============================================================================
+/**
+    A stream which uses the LZ4 library to compress the data written into it.
+
+    LZ4 compresses and decompresses many times faster than zlib, although the data
+    that it produces is larger, so it's a good choice for things like temporary files,
+    caches, or state that's saved often, where speed matters more than size.
+
+    The data is written in the standard LZ4 frame format, so it can be read by any
+    other LZ4 tool, and by an LZ4DecompressorInputStream.
+
+    This class is only available if you enable JUCE_USE_LZ4, and link your app to
+    the LZ4 library.
+
+    Like a GZIPCompressorOutputStream, when you call flush() on this stream, the data
+    is closed, and no more data can be written to it.
+
+    @see LZ4DecompressorInputStream, GZIPCompressorOutputStream
+*/
+class JUCE_API  LZ4CompressorOutputStream  : public OutputStream
+{
+public:
+    //==============================================================================
+    /** Creates a compression stream.
+
+        @param destStream                       the stream into which the compressed data should
+                                                be written
+        @param compressionLevel                 0 uses LZ4's fastest mode, and higher values up to 12
+                                                use its slower, high-compression mode
+        @param deleteDestStreamWhenDestroyed    whether or not to delete the destStream object when
+                                                this stream is destroyed
+    */
+    LZ4CompressorOutputStream (OutputStream* destStream,
+                               int compressionLevel = 0,
+                               bool deleteDestStreamWhenDestroyed = false);
+
+    /** Destructor. */
+    ~LZ4CompressorOutputStream();
+
+    //==============================================================================
+    /** Flushes and closes the stream.
+        When you call flush() on this stream, the stream is closed, and any subsequent
+        attempts to call write() will cause an assertion.
+    */
+    void flush() override;
+
+    int64 getPosition() override;
+    bool setPosition (int64) override;
+    bool write (const void*, size_t) override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<OutputStream> destStream;
+
+    class LZ4CompressorHelper;
+    friend struct ContainerDeletePolicy<LZ4CompressorHelper>;
+    ScopedPointer<LZ4CompressorHelper> helper;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LZ4CompressorOutputStream)
+};
+
+#endif
+#endif   // JUCE_LZ4COMPRESSOROUTPUTSTREAM_H_INCLUDED
@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+class LZ4DecompressorInputStream::LZ4DecompressorHelper
+{
+public:
+    LZ4DecompressorHelper()
+        : context (nullptr),
+          buffer ((size_t) bufferSize),
+          bufferPos (0),
+          bufferEnd (0),
+          finished (false),
+          error (LZ4F_isError (LZ4F_createDecompressionContext (&context, LZ4F_VERSION)))
+    {
+    }
+
+    ~LZ4DecompressorHelper()
+    {
+        if (context != nullptr)
+            LZ4F_freeDecompressionContext (context);
+    }
+
+    // Decompresses as much as possible into the destination, reading more of the source
+    // whenever the decompressor needs it.
+    int read (InputStream& source, uint8* dest, const int maxBytes)
+    {
+        int numDone = 0;
+
+        while (numDone < maxBytes && ! (finished || error))
+        {
+            if (bufferPos >= bufferEnd)
+            {
+                bufferPos = 0;
+                bufferEnd = jmax (0, source.read (buffer, (int) bufferSize));
+
+                if (bufferEnd == 0)
+                {
+                    // (if the source ends part-way through a frame, the data was truncated)
+                    error = ! finished;
+                    break;
+                }
+            }
+
+            size_t numOut = (size_t) (maxBytes - numDone);
+            size_t numIn  = (size_t) (bufferEnd - bufferPos);
+
+            const size_t hint = LZ4F_decompress (context, dest + numDone, &numOut,
+                                                 buffer + bufferPos, &numIn, nullptr);
+
+            if (LZ4F_isError (hint))
+            {
+                error = true;
+                break;
+            }
+
+            bufferPos += (int) numIn;
+            numDone += (int) numOut;
+
+            if (hint == 0)
+                finished = true;
+        }
+
+        return numDone;
+    }
+
+    bool isFinished() const noexcept    { return finished || error; }
+
+private:
+    enum { bufferSize = 65536 };
+
+    LZ4F_dctx* context;
+    HeapBlock<uint8> buffer;
+    int bufferPos, bufferEnd;
+    bool finished, error;
+
+    JUCE_DECLARE_NON_COPYABLE (LZ4DecompressorHelper)
+};
+
+//==============================================================================
+LZ4DecompressorInputStream::LZ4DecompressorInputStream (InputStream* const source,
+                                                        const bool deleteSourceWhenDestroyed,
+                                                        const int64 uncompressedLength)
+  : sourceStream (source, deleteSourceWhenDestroyed),
+    uncompressedStreamLength (uncompressedLength),
+    originalSourcePos (source->getPosition()),
+    currentPos (0),
+    helper (new LZ4DecompressorHelper())
+{
+}
+
+LZ4DecompressorInputStream::~LZ4DecompressorInputStream()
+{
+}
+
+int64 LZ4DecompressorInputStream::getTotalLength()
+{
+    return uncompressedStreamLength;
+}
+
+int LZ4DecompressorInputStream::read (void* destBuffer, int howMany)
+{
+    jassert (destBuffer != nullptr && howMany >= 0);
+
+    const int numRead = helper->read (*sourceStream, static_cast<uint8*> (destBuffer), howMany);
+    currentPos += numRead;
+    return numRead;
+}
+
+bool LZ4DecompressorInputStream::isExhausted()
+{
+    return helper->isFinished();
+}
+
+int64 LZ4DecompressorInputStream::getPosition()
+{
+    return currentPos;
+}
+
+bool LZ4DecompressorInputStream::setPosition (int64 newPos)
+{
+    if (newPos < currentPos)
+    {
+        // to go backwards, reset the stream and start again..
+        currentPos = 0;
+        helper = new LZ4DecompressorHelper();
+
+        sourceStream->setPosition (originalSourcePos);
+    }
+
+    skipNextBytes (newPos - currentPos);
+    return true;
+}
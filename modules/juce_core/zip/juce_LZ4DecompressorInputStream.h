@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_LZ4DECOMPRESSORINPUTSTREAM_H_INCLUDED
+#define JUCE_LZ4DECOMPRESSORINPUTSTREAM_H_INCLUDED
+
+#if JUCE_USE_LZ4 || DOXYGEN
+
+//==============================================================================
+/**
+    This stream will decompress a source-stream that contains LZ4 frame-format data.
+
+    This class is only available if you enable JUCE_USE_LZ4, and link your app to
+    the LZ4 library.
+
+    @see LZ4CompressorOutputStream, GZIPDecompressorInputStream
+*/
+class JUCE_API  LZ4DecompressorInputStream  : public InputStream
+{
+public:
+    //==============================================================================
+    /** Creates a decompressor stream.
+
+        @param sourceStream                 the stream to read from
+        @param deleteSourceWhenDestroyed    whether or not to delete the source stream
+                                            when this object is destroyed
+        @param uncompressedStreamLength     if the creator knows the length that the
+                                            uncompressed stream will be, then it can supply this
+                                            value, which will be returned by getTotalLength()
+    */
+    LZ4DecompressorInputStream (InputStream* sourceStream,
+                                bool deleteSourceWhenDestroyed,
+                                int64 uncompressedStreamLength = -1);
+
+    /** Destructor. */
+    ~LZ4DecompressorInputStream();
+
+    //==============================================================================
+    int64 getPosition() override;
+    bool setPosition (int64 pos) override;
+    int64 getTotalLength() override;
+    bool isExhausted() override;
+    int read (void* destBuffer, int maxBytesToRead) override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<InputStream> sourceStream;
+    const int64 uncompressedStreamLength;
+    int64 originalSourcePos, currentPos;
+
+    class LZ4DecompressorHelper;
+    friend struct ContainerDeletePolicy<LZ4DecompressorHelper>;
+    ScopedPointer<LZ4DecompressorHelper> helper;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LZ4DecompressorInputStream)
+};
+
+#endif
+#endif   // JUCE_LZ4DECOMPRESSORINPUTSTREAM_H_INCLUDED
@@ -108,6 +108,75 @@ namespace
 
         return 0;
     }
+
+    File getZipEntryTargetFile (const String& filename, const File& targetDirectory)
+    {
+       #if JUCE_WINDOWS
+        return targetDirectory.getChildFile (filename);
+       #else
+        return targetDirectory.getChildFile (filename.replaceCharacter ('\\', '/'));
+       #endif
+    }
+
+    bool isZipDirectoryEntry (const String& filename) noexcept
+    {
+        return filename.endsWithChar ('/') || filename.endsWithChar ('\\');
+    }
+
+    // Uncompresses one entry for a parallelFor, and keeps the first failure that happens.
+    struct ZipEntryUncompressor
+    {
+        ZipEntryUncompressor (ZipFile& z, const Array<int>& indexes, const File& target,
+                              bool overwrite, CriticalSection& lock, Result& r) noexcept
+            : zip (z), entryIndexes (indexes), targetDirectory (target),
+              shouldOverwriteFiles (overwrite), resultLock (lock), result (r)
+        {
+        }
+
+        void operator() (int i) const
+        {
+            {
+                const ScopedLock sl (resultLock);
+
+                if (result.failed())
+                    return;
+            }
+
+            const Result r (zip.uncompressEntry (entryIndexes.getUnchecked (i), targetDirectory, shouldOverwriteFiles));
+
+            if (r.failed())
+            {
+                const ScopedLock sl (resultLock);
+
+                if (result.wasOk())
+                    result = r;
+            }
+        }
+
+        ZipFile& zip;
+        const Array<int>& entryIndexes;
+        const File& targetDirectory;
+        bool shouldOverwriteFiles;
+        CriticalSection& resultLock;
+        Result& result;
+    };
+
+    // Puts the biggest entries first, so that a big one doesn't get started last and
+    // leave all the other threads waiting for it.
+    struct ZipEntrySizeComparator
+    {
+        ZipEntrySizeComparator (const ZipFile& z) noexcept : zip (z) {}
+
+        int compareElements (int first, int second) const noexcept
+        {
+            const unsigned int size1 = zip.getEntry (first)->uncompressedSize;
+            const unsigned int size2 = zip.getEntry (second)->uncompressedSize;
+
+            return size1 > size2 ? -1 : (size1 < size2 ? 1 : 0);
+        }
+
+        const ZipFile& zip;
+    };
 }
 
 //==============================================================================
@@ -128,7 +197,7 @@ public:
         else
         {
            #if JUCE_DEBUG
-            zf.streamCounter.numOpenStreams++;
+            ++zf.streamCounter.numOpenStreams;
            #endif
         }
 
@@ -148,7 +217,7 @@ public:
     {
        #if JUCE_DEBUG
         if (inputStream != nullptr && inputStream == file.inputStream)
-            file.streamCounter.numOpenStreams--;
+            --file.streamCounter.numOpenStreams;
        #endif
     }
 
@@ -231,8 +300,16 @@ ZipFile::ZipFile (InputStream& stream)
 
 ZipFile::ZipFile (const File& file)
     : inputStream (nullptr),
-      inputSource (new FileInputSource (file))
+      mappedFile (new MemoryMappedFile (file, MemoryMappedFile::readOnly))
 {
+    // (if the file can't be mapped, e.g. because there isn't enough address space for it,
+    // each entry's stream opens the file for itself instead)
+    if (mappedFile->getData() == nullptr)
+    {
+        mappedFile = nullptr;
+        inputSource = new FileInputSource (file);
+    }
+
     init();
 }
 
@@ -256,7 +333,7 @@ ZipFile::OpenStreamCounter::~OpenStreamCounter()
        Streams can't be kept open after the file is deleted because they need to share the input
        stream that is managed by the ZipFile object.
     */
-    jassert (numOpenStreams == 0);
+    jassert (numOpenStreams.get() == 0);
 }
 #endif
 
@@ -294,7 +371,20 @@ InputStream* ZipFile::createStreamForEntry (const int index)
 
     if (ZipEntryHolder* const zei = entries[index])
     {
-        stream = new ZipInputStream (*this, *zei);
+        if (mappedFile != nullptr)
+        {
+            // (a mapped entry's data is read straight from memory, so this needs no locking)
+            const char* const data = getMappedEntryData (*zei);
+
+            if (data == nullptr)
+                return nullptr;
+
+            stream = new MemoryInputStream (data, zei->compressedSize, false);
+        }
+        else
+        {
+            stream = new ZipInputStream (*this, *zei);
+        }
 
         if (zei->compressed)
         {
@@ -325,13 +415,39 @@ void ZipFile::sortEntriesByFilename()
     entries.sort (sorter);
 }
 
+const char* ZipFile::getMappedEntryData (const ZipEntryHolder& zei) const noexcept
+{
+    if (mappedFile == nullptr)
+        return nullptr;
+
+    const char* const data = static_cast<const char*> (mappedFile->getData());
+    const size_t size = mappedFile->getSize();
+    const size_t offset = zei.streamOffset;
+
+    if (offset + 30 > size || ByteOrder::littleEndianInt (data + offset) != 0x04034b50)
+        return nullptr;
+
+    const size_t headerSize = 30 + (size_t) ByteOrder::littleEndianShort (data + offset + 26)
+                                 + (size_t) ByteOrder::littleEndianShort (data + offset + 28);
+
+    if (offset + headerSize + zei.compressedSize > size)
+        return nullptr;
+
+    return data + offset + headerSize;
+}
+
 //==============================================================================
 void ZipFile::init()
 {
     ScopedPointer <InputStream> toDelete;
     InputStream* in = inputStream;
 
-    if (inputSource != nullptr)
+    if (mappedFile != nullptr)
+    {
+        in = new MemoryInputStream (mappedFile->getData(), mappedFile->getSize(), false);
+        toDelete = in;
+    }
+    else if (inputSource != nullptr)
     {
         in = inputSource->createInputStream();
         toDelete = in;
@@ -346,10 +462,16 @@ void ZipFile::init()
         {
             const int size = (int) (in->getTotalLength() - pos);
 
-            in->setPosition (pos);
             MemoryBlock headerData;
+            const char* directory = nullptr;
 
-            if (in->readIntoMemoryBlock (headerData, size) == (size_t) size)
+            // (a mapped file's directory can be parsed where it is, without copying it)
+            if (mappedFile != nullptr)
+                directory = static_cast<const char*> (mappedFile->getData()) + pos;
+            else if (in->setPosition (pos) && in->readIntoMemoryBlock (headerData, size) == (size_t) size)
+                directory = static_cast<const char*> (headerData.getData());
+
+            if (directory != nullptr)
             {
                 pos = 0;
 
@@ -358,7 +480,7 @@ void ZipFile::init()
                     if (pos + 46 > size)
                         break;
 
-                    const char* const buffer = static_cast <const char*> (headerData.getData()) + pos;
+                    const char* const buffer = directory + pos;
 
                     const int fileNameLen = ByteOrder::littleEndianShort (buffer + 28);
 
@@ -377,16 +499,61 @@ void ZipFile::init()
 }
 
 Result ZipFile::uncompressTo (const File& targetDirectory,
-                              const bool shouldOverwriteFiles)
+                              const bool shouldOverwriteFiles,
+                              ThreadPool* const threadPool)
 {
+    if (threadPool == nullptr)
+    {
+        for (int i = 0; i < entries.size(); ++i)
+        {
+            Result result (uncompressEntry (i, targetDirectory, shouldOverwriteFiles));
+            if (result.failed())
+                return result;
+        }
+
+        return Result::ok();
+    }
+
+    // All the folders are created first, so that the threads never race to create the same one.
+    Array<int> fileIndexes;
+    File lastFolder;
+
     for (int i = 0; i < entries.size(); ++i)
     {
-        Result result (uncompressEntry (i, targetDirectory, shouldOverwriteFiles));
-        if (result.failed())
-            return result;
+        const String& filename = entries.getUnchecked (i)->entry.filename;
+
+        if (isZipDirectoryEntry (filename))
+        {
+            Result result (uncompressEntry (i, targetDirectory, shouldOverwriteFiles));
+            if (result.failed())
+                return result;
+        }
+        else
+        {
+            const File folder (getZipEntryTargetFile (filename, targetDirectory).getParentDirectory());
+
+            if (folder != lastFolder)
+            {
+                if (! folder.createDirectory())
+                    return Result::fail ("Failed to create target folder: " + folder.getFullPathName());
+
+                lastFolder = folder;
+            }
+
+            fileIndexes.add (i);
+        }
     }
 
-    return Result::ok();
+    ZipEntrySizeComparator comparator (*this);
+    fileIndexes.sort (comparator);
+
+    CriticalSection resultLock;
+    Result result (Result::ok());
+
+    threadPool->parallelFor (0, fileIndexes.size(),
+                             ZipEntryUncompressor (*this, fileIndexes, targetDirectory,
+                                                   shouldOverwriteFiles, resultLock, result));
+    return result;
 }
 
 Result ZipFile::uncompressEntry (const int index,
@@ -394,16 +561,9 @@ Result ZipFile::uncompressEntry (const int index,
                                  bool shouldOverwriteFiles)
 {
     const ZipEntryHolder* zei = entries.getUnchecked (index);
+    const File targetFile (getZipEntryTargetFile (zei->entry.filename, targetDirectory));
 
-   #if JUCE_WINDOWS
-    const String entryPath (zei->entry.filename);
-   #else
-    const String entryPath (zei->entry.filename.replaceCharacter ('\\', '/'));
-   #endif
-
-    const File targetFile (targetDirectory.getChildFile (entryPath));
-
-    if (entryPath.endsWithChar ('/') || entryPath.endsWithChar ('\\'))
+    if (isZipDirectoryEntry (zei->entry.filename))
         return targetFile.createDirectory(); // (entry is a directory, not a file)
 
     ScopedPointer<InputStream> in (createStreamForEntry (index));
@@ -429,7 +589,13 @@ Result ZipFile::uncompressEntry (const int index,
         if (out.failedToOpen())
             return Result::fail ("Failed to write to target file: " + targetFile.getFullPathName());
 
-        out << *in;
+        // (an uncompressed entry in a mapped file can be written straight from the mapped memory)
+        const char* const storedData = zei->compressed ? nullptr : getMappedEntryData (*zei);
+
+        if (storedData != nullptr)
+            out.write (storedData, zei->compressedSize);
+        else
+            out << *in;
     }
 
     targetFile.setCreationTime (zei->entry.fileTime);
@@ -451,31 +617,47 @@ public:
     {
     }
 
-    bool writeData (OutputStream& target, const int64 overallStartPosition)
+    // This can be called on any thread, before writeData() is called.
+    bool compressData()
     {
-        MemoryOutputStream compressedData ((size_t) file.getSize());
+        ScopedPointer<MemoryOutputStream> data (new MemoryOutputStream ((size_t) file.getSize()));
 
         if (compressionLevel > 0)
         {
-            GZIPCompressorOutputStream compressor (&compressedData, compressionLevel, false,
+            GZIPCompressorOutputStream compressor (data, compressionLevel, false,
                                                    GZIPCompressorOutputStream::windowBitsRaw);
             if (! writeSource (compressor))
                 return false;
         }
         else
         {
-            if (! writeSource (compressedData))
+            if (! writeSource (*data))
                 return false;
         }
 
-        compressedSize = (int) compressedData.getDataSize();
+        compressedSize = (int) data->getDataSize();
+        compressedData = data;
+        return true;
+    }
+
+    void discardCompressedData()
+    {
+        compressedData = nullptr;
+    }
+
+    bool writeData (OutputStream& target, const int64 overallStartPosition)
+    {
+        if (compressedData == nullptr && ! compressData())
+            return false;
+
         headerStart = (int) (target.getPosition() - overallStartPosition);
 
         target.writeInt (0x04034b50);
         writeFlagsAndSizes (target);
         target << storedPathname
-               << compressedData;
+               << *compressedData;
 
+        compressedData = nullptr;
         return true;
     }
 
@@ -497,6 +679,7 @@ public:
 private:
     const File file;
     ScopedPointer<InputStream> stream;
+    ScopedPointer<MemoryOutputStream> compressedData;
     String storedPathname;
     Time fileTime;
     int compressionLevel, compressedSize, uncompressedSize, headerStart;
@@ -573,17 +756,64 @@ void ZipFile::Builder::addEntry (InputStream* stream, int compression, const Str
     items.add (new Item (File(), stream, compression, path, time));
 }
 
-bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progress) const
+bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progress,
+                                      ThreadPool* const threadPool) const
 {
+    struct CompressionTask  : public ThreadPoolTask
+    {
+        CompressionTask (Item& i) noexcept  : item (i), succeeded (false) {}
+
+        void run() override     { succeeded = item.compressData(); }
+
+        Item& item;
+        bool succeeded;
+    };
+
     const int64 fileStart = target.getPosition();
 
-    for (int i = 0; i < items.size(); ++i)
+    // Only a few items are compressed ahead of the one being written, so that the amount
+    // of compressed data waiting in memory doesn't grow with the size of the archive.
+    const int numToCompressAhead = SystemStats::getNumCpus() * 2;
+    OwnedArray<ThreadPoolTask> tasks;
+    bool ok = true;
+
+    for (int i = 0; i < items.size() && ok; ++i)
     {
         if (progress != nullptr)
             *progress = (i + 0.5) / items.size();
 
-        if (! items.getUnchecked (i)->writeData (target, fileStart))
-            return false;
+        if (threadPool != nullptr)
+        {
+            while (tasks.size() < jmin (items.size(), i + 1 + numToCompressAhead))
+            {
+                CompressionTask* const task = new CompressionTask (*items.getUnchecked (tasks.size()));
+                tasks.add (task);
+                threadPool->addTask (task);
+            }
+
+            threadPool->waitForTask (tasks.getUnchecked (i));
+
+            if (! static_cast<CompressionTask*> (tasks.getUnchecked (i))->succeeded)
+            {
+                ok = false;
+                break;
+            }
+        }
+
+        ok = items.getUnchecked (i)->writeData (target, fileStart);
+    }
+
+    // (any tasks that are still compressing later items must finish before they're deleted)
+    if (threadPool != nullptr)
+        for (int i = 0; i < tasks.size(); ++i)
+            threadPool->waitForTask (tasks.getUnchecked (i));
+
+    if (! ok)
+    {
+        for (int i = 0; i < items.size(); ++i)
+            items.getUnchecked (i)->discardCompressedData();
+
+        return false;
     }
 
     const int64 directoryStart = target.getPosition();
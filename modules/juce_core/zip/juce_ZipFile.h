@@ -40,7 +40,12 @@
 class JUCE_API  ZipFile
 {
 public:
-    /** Creates a ZipFile based for a file. */
+    /** Creates a ZipFile based for a file.
+
+        Where possible, the file is memory-mapped, so that its entries can be read by any
+        number of threads at once without any locking, and entries that are stored without
+        compression are read straight out of the mapped memory.
+    */
     explicit ZipFile (const File& file);
 
     //==============================================================================
@@ -149,10 +154,13 @@ public:
 
         @param targetDirectory      the root folder to uncompress to
         @param shouldOverwriteFiles whether to overwrite existing files with similarly-named ones
+        @param threadPool           if this isn't null, the entries are uncompressed in parallel
+                                    on the pool's threads (and the calling thread)
         @returns success if the file is successfully unzipped
     */
     Result uncompressTo (const File& targetDirectory,
-                         bool shouldOverwriteFiles = true);
+                         bool shouldOverwriteFiles = true,
+                         ThreadPool* threadPool = nullptr);
 
     /** Uncompresses one of the entries from the zip file.
 
@@ -214,8 +222,13 @@ public:
         /** Generates the zip file, writing it to the specified stream.
             If the progress parameter is non-null, it will be updated with an approximate
             progress status between 0 and 1.0
+
+            If a thread pool is supplied, the next few items are compressed on its threads
+            while each one is being written, which is much quicker for large archives. The
+            items are still written in the order in which they were added.
         */
-        bool writeToStream (OutputStream& target, double* progress) const;
+        bool writeToStream (OutputStream& target, double* progress,
+                            ThreadPool* threadPool = nullptr) const;
 
         //==============================================================================
     private:
@@ -238,20 +251,22 @@ private:
     InputStream* inputStream;
     ScopedPointer <InputStream> streamToDelete;
     ScopedPointer <InputSource> inputSource;
+    ScopedPointer <MemoryMappedFile> mappedFile;
 
    #if JUCE_DEBUG
     struct OpenStreamCounter
     {
-        OpenStreamCounter() : numOpenStreams (0) {}
+        OpenStreamCounter() {}
         ~OpenStreamCounter();
 
-        int numOpenStreams;
+        Atomic<int> numOpenStreams;
     };
 
     OpenStreamCounter streamCounter;
    #endif
 
     void init();
+    const char* getMappedEntryData (const ZipEntryHolder&) const noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZipFile)
 };
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+class ZstdCompressorOutputStream::ZstdCompressorHelper
+{
+public:
+    ZstdCompressorHelper (const int compressionLevel)
+        : context (ZSTD_createCCtx()),
+          bufferSize (ZSTD_CStreamOutSize()),
+          buffer (bufferSize),
+          finished (false),
+          isValid (context != nullptr)
+    {
+        const int level = (compressionLevel < 1 || compressionLevel > ZSTD_maxCLevel()) ? ZSTD_CLEVEL_DEFAULT
+                                                                                         : compressionLevel;
+        isValid = isValid
+                   && ! ZSTD_isError (ZSTD_CCtx_setParameter (context, ZSTD_c_compressionLevel, level))
+                   && ! ZSTD_isError (ZSTD_CCtx_setParameter (context, ZSTD_c_checksumFlag, 1));
+    }
+
+    ~ZstdCompressorHelper()
+    {
+        ZSTD_freeCCtx (context);
+    }
+
+    bool write (const uint8* data, size_t dataSize, OutputStream& out)
+    {
+        // When you call flush() on a zstd stream, the stream is closed, and you can
+        // no longer continue to write data to it!
+        jassert (! finished);
+
+        ZSTD_inBuffer input = { data, dataSize, 0 };
+
+        while (input.pos < input.size)
+            if (! doNextBlock (input, ZSTD_e_continue, out))
+                return false;
+
+        return true;
+    }
+
+    void finish (OutputStream& out)
+    {
+        ZSTD_inBuffer input = { nullptr, 0, 0 };
+
+        while (! finished)
+            if (! doNextBlock (input, ZSTD_e_end, out))
+                break;
+
+        finished = true;
+    }
+
+private:
+    ZSTD_CCtx* context;
+    const size_t bufferSize;
+    HeapBlock<char> buffer;
+    bool finished, isValid;
+
+    bool doNextBlock (ZSTD_inBuffer& input, const ZSTD_EndDirective mode, OutputStream& out)
+    {
+        if (! isValid)
+            return false;
+
+        ZSTD_outBuffer output = { buffer, bufferSize, 0 };
+        const size_t result = ZSTD_compressStream2 (context, &output, &input, mode);
+
+        if (ZSTD_isError (result))
+        {
+            isValid = false;
+            return false;
+        }
+
+        // (when ending the frame, a zero result means that everything has been written)
+        if (mode == ZSTD_e_end && result == 0)
+            finished = true;
+
+        return output.pos == 0 || out.write (buffer, output.pos);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (ZstdCompressorHelper)
+};
+
+//==============================================================================
+ZstdCompressorOutputStream::ZstdCompressorOutputStream (OutputStream* const out,
+                                                        const int compressionLevel,
+                                                        const bool deleteDestStream)
+    : destStream (out, deleteDestStream),
+      helper (new ZstdCompressorHelper (compressionLevel))
+{
+    jassert (out != nullptr);
+}
+
+ZstdCompressorOutputStream::~ZstdCompressorOutputStream()
+{
+    flush();
+}
+
+void ZstdCompressorOutputStream::flush()
+{
+    helper->finish (*destStream);
+    destStream->flush();
+}
+
+bool ZstdCompressorOutputStream::write (const void* destBuffer, size_t howMany)
+{
+    jassert (destBuffer != nullptr && (ssize_t) howMany >= 0);
+
+    return helper->write (static_cast <const uint8*> (destBuffer), howMany, *destStream);
+}
+
+int64 ZstdCompressorOutputStream::getPosition()
+{
+    return destStream->getPosition();
+}
+
+bool ZstdCompressorOutputStream::setPosition (int64 /*newPosition*/)
+{
+    jassertfalse; // can't do it!
+    return false;
+}
@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_ZSTDCOMPRESSOROUTPUTSTREAM_H_INCLUDED
+#define JUCE_ZSTDCOMPRESSOROUTPUTSTREAM_H_INCLUDED
+
+#if JUCE_USE_ZSTD || DOXYGEN
+
+//==============================================================================
+/**
+    A stream which uses the Zstandard library to compress the data written into it.
+
+    At its lower levels, Zstandard is several times faster than zlib and still compresses
+    a little better, and at its higher levels it gets much smaller results than zlib can,
+    so it can be tuned for speed or for size, e.g. for plugin state or cached data.
+
+    The data is written in the standard Zstandard frame format, so it can be read by any
+    other zstd tool, and by a ZstdDecompressorInputStream.
+
+    This class is only available if you enable JUCE_USE_ZSTD, and link your app to
+    the Zstandard library.
+
+    Like a GZIPCompressorOutputStream, when you call flush() on this stream, the data
+    is closed, and no more data can be written to it.
+
+    @see ZstdDecompressorInputStream, GZIPCompressorOutputStream
+*/
+class JUCE_API  ZstdCompressorOutputStream  : public OutputStream
+{
+public:
+    //==============================================================================
+    /** Creates a compression stream.
+
+        @param destStream                       the stream into which the compressed data should
+                                                be written
+        @param compressionLevel                 between 1 (fastest) and 22 (smallest) - any value
+                                                outside this range selects the library's default level
+        @param deleteDestStreamWhenDestroyed    whether or not to delete the destStream object when
+                                                this stream is destroyed
+    */
+    ZstdCompressorOutputStream (OutputStream* destStream,
+                               int compressionLevel = 0,
+                               bool deleteDestStreamWhenDestroyed = false);
+
+    /** Destructor. */
+    ~ZstdCompressorOutputStream();
+
+    //==============================================================================
+    /** Flushes and closes the stream.
+        When you call flush() on this stream, the stream is closed, and any subsequent
+        attempts to call write() will cause an assertion.
+    */
+    void flush() override;
+
+    int64 getPosition() override;
+    bool setPosition (int64) override;
+    bool write (const void*, size_t) override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<OutputStream> destStream;
+
+    class ZstdCompressorHelper;
+    friend struct ContainerDeletePolicy<ZstdCompressorHelper>;
+    ScopedPointer<ZstdCompressorHelper> helper;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZstdCompressorOutputStream)
+};
+
+#endif
+#endif   // JUCE_ZSTDCOMPRESSOROUTPUTSTREAM_H_INCLUDED
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+   This file is part of the juce_core module of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission to use, copy, modify, and/or distribute this software for any purpose with
+   or without fee is hereby granted, provided that the above copyright notice and this
+   permission notice appear in all copies.
+
+   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD
+   TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS. IN
+   NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+   DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER
+   IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN
+   CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+   ------------------------------------------------------------------------------
+
+   NOTE! This permissive ISC license applies ONLY to files within the juce_core module!
+   All other JUCE modules are covered by a dual GPL/commercial license, so if you are
+   using any other modules, be sure to check that you also comply with their license.
+
+   For more details, visit www.juce.com
+
+  ==============================================================================
+*/
+
+class ZstdDecompressorInputStream::ZstdDecompressorHelper
+{
+public:
+    ZstdDecompressorHelper()
+        : context (ZSTD_createDCtx()),
+          bufferSize (ZSTD_DStreamInSize()),
+          buffer (bufferSize),
+          bufferPos (0),
+          bufferEnd (0),
+          finished (false),
+          error (context == nullptr)
+    {
+    }
+
+    ~ZstdDecompressorHelper()
+    {
+        ZSTD_freeDCtx (context);
+    }
+
+    // Decompresses as much as possible into the destination, reading more of the source
+    // whenever the decompressor needs it.
+    int read (InputStream& source, uint8* dest, const int maxBytes)
+    {
+        ZSTD_outBuffer output = { dest, (size_t) maxBytes, 0 };
+
+        while (output.pos < output.size && ! (finished || error))
+        {
+            if (bufferPos >= bufferEnd)
+            {
+                bufferPos = 0;
+                bufferEnd = (size_t) jmax (0, source.read (buffer, (int) bufferSize));
+
+                if (bufferEnd == 0)
+                {
+                    // (if the source ends part-way through a frame, the data was truncated)
+                    error = true;
+                    break;
+                }
+            }
+
+            ZSTD_inBuffer input = { buffer, bufferEnd, bufferPos };
+            const size_t result = ZSTD_decompressStream (context, &output, &input);
+
+            if (ZSTD_isError (result))
+            {
+                error = true;
+                break;
+            }
+
+            bufferPos = input.pos;
+
+            if (result == 0)
+                finished = true;
+        }
+
+        return (int) output.pos;
+    }
+
+    bool isFinished() const noexcept    { return finished || error; }
+
+private:
+    ZSTD_DCtx* context;
+    const size_t bufferSize;
+    HeapBlock<uint8> buffer;
+    size_t bufferPos, bufferEnd;
+    bool finished, error;
+
+    JUCE_DECLARE_NON_COPYABLE (ZstdDecompressorHelper)
+};
+
+//==============================================================================
+ZstdDecompressorInputStream::ZstdDecompressorInputStream (InputStream* const source,
+                                                          const bool deleteSourceWhenDestroyed,
+                                                          const int64 uncompressedLength)
+  : sourceStream (source, deleteSourceWhenDestroyed),
+    uncompressedStreamLength (uncompressedLength),
+    originalSourcePos (source->getPosition()),
+    currentPos (0),
+    helper (new ZstdDecompressorHelper())
+{
+}
+
+ZstdDecompressorInputStream::~ZstdDecompressorInputStream()
+{
+}
+
+int64 ZstdDecompressorInputStream::getTotalLength()
+{
+    return uncompressedStreamLength;
+}
+
+int ZstdDecompressorInputStream::read (void* destBuffer, int howMany)
+{
+    jassert (destBuffer != nullptr && howMany >= 0);
+
+    const int numRead = helper->read (*sourceStream, static_cast<uint8*> (destBuffer), howMany);
+    currentPos += numRead;
+    return numRead;
+}
+
+bool ZstdDecompressorInputStream::isExhausted()
+{
+    return helper->isFinished();
+}
+
+int64 ZstdDecompressorInputStream::getPosition()
+{
+    return currentPos;
+}
+
+bool ZstdDecompressorInputStream::setPosition (int64 newPos)
+{
+    if (newPos < currentPos)
+    {
+        // to go backwards, reset the stream and start again..
+        currentPos = 0;
+        helper = new ZstdDecompressorHelper();
+
+        sourceStream->setPosition (originalSourcePos);
+    }
+
+    skipNextBytes (newPos - currentPos);
+    return true;
+}
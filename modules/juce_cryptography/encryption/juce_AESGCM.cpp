@@ -0,0 +1,709 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+namespace AESHelpers
+{
+    static inline uint8 xtime (const uint8 x) noexcept
+    {
+        return (uint8) ((x << 1) ^ ((x & 0x80) != 0 ? 0x1b : 0));
+    }
+
+    static inline uint32 rotateRight (const uint32 x, const int bits) noexcept
+    {
+        return (x >> bits) | (x << (32 - bits));
+    }
+
+    // The S-box and the combined SubBytes/MixColumns table for the portable version
+    struct Tables
+    {
+        Tables() noexcept
+        {
+            // The S-box is the multiplicative inverse in GF(2^8) followed by an affine transform
+            for (int i = 0; i < 256; ++i)
+            {
+                const uint32 inv = inverse ((uint8) i);
+                const uint32 x = inv | (inv << 8);
+                sbox[i] = (uint8) (inv ^ (x >> 7) ^ (x >> 6) ^ (x >> 5) ^ (x >> 4) ^ 0x63);
+            }
+
+            for (int i = 0; i < 256; ++i)
+            {
+                const uint32 s = sbox[i];
+                const uint32 s2 = xtime ((uint8) s);
+                te[i] = (s2 << 24) | (s << 16) | (s << 8) | (s2 ^ s);
+            }
+        }
+
+        static uint8 multiply (uint8 a, uint8 b) noexcept
+        {
+            uint8 result = 0;
+
+            for (; b != 0; b >>= 1, a = xtime (a))
+                if ((b & 1) != 0)
+                    result ^= a;
+
+            return result;
+        }
+
+        static uint8 inverse (const uint8 x) noexcept
+        {
+            // x^254 = x^-1 for any non-zero x
+            uint8 result = x == 0 ? 0 : 1;
+
+            for (int i = 0; i < 254 && x != 0; ++i)
+                result = multiply (result, x);
+
+            return result;
+        }
+
+        static const Tables& get() noexcept
+        {
+            static Tables tables;
+            return tables;
+        }
+
+        uint8 sbox[256];
+        uint32 te[256];
+    };
+
+    static void encryptBlockPortable (const uint8* roundKeys, const int numRounds,
+                                      const uint8* input, uint8* output) noexcept
+    {
+        const Tables& t = Tables::get();
+        const uint8* rk = roundKeys;
+
+        uint32 s0 = ByteOrder::bigEndianInt (input)      ^ ByteOrder::bigEndianInt (rk);
+        uint32 s1 = ByteOrder::bigEndianInt (input + 4)  ^ ByteOrder::bigEndianInt (rk + 4);
+        uint32 s2 = ByteOrder::bigEndianInt (input + 8)  ^ ByteOrder::bigEndianInt (rk + 8);
+        uint32 s3 = ByteOrder::bigEndianInt (input + 12) ^ ByteOrder::bigEndianInt (rk + 12);
+
+        #define JUCE_AES_COLUMN(a, b, c, d, offset) \
+            (t.te[a >> 24] ^ rotateRight (t.te[(b >> 16) & 0xff], 8) ^ rotateRight (t.te[(c >> 8) & 0xff], 16) \
+               ^ rotateRight (t.te[d & 0xff], 24) ^ ByteOrder::bigEndianInt (rk + offset))
+
+        for (int round = 1; round < numRounds; ++round)
+        {
+            rk += 16;
+            const uint32 t0 = JUCE_AES_COLUMN (s0, s1, s2, s3, 0);
+            const uint32 t1 = JUCE_AES_COLUMN (s1, s2, s3, s0, 4);
+            const uint32 t2 = JUCE_AES_COLUMN (s2, s3, s0, s1, 8);
+            const uint32 t3 = JUCE_AES_COLUMN (s3, s0, s1, s2, 12);
+            s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+        }
+
+        #undef JUCE_AES_COLUMN
+
+        rk += 16;
+
+        #define JUCE_AES_LAST_COLUMN(a, b, c, d, offset) \
+            ((((uint32) t.sbox[a >> 24]) << 24) ^ (((uint32) t.sbox[(b >> 16) & 0xff]) << 16) \
+               ^ (((uint32) t.sbox[(c >> 8) & 0xff]) << 8) ^ (uint32) t.sbox[d & 0xff] ^ ByteOrder::bigEndianInt (rk + offset))
+
+        const uint32 results[] = { JUCE_AES_LAST_COLUMN (s0, s1, s2, s3, 0),
+                                   JUCE_AES_LAST_COLUMN (s1, s2, s3, s0, 4),
+                                   JUCE_AES_LAST_COLUMN (s2, s3, s0, s1, 8),
+                                   JUCE_AES_LAST_COLUMN (s3, s0, s1, s2, 12) };
+        #undef JUCE_AES_LAST_COLUMN
+
+        for (int i = 0; i < 4; ++i)
+        {
+            output[i * 4]     = (uint8) (results[i] >> 24);
+            output[i * 4 + 1] = (uint8) (results[i] >> 16);
+            output[i * 4 + 2] = (uint8) (results[i] >> 8);
+            output[i * 4 + 3] = (uint8) results[i];
+        }
+    }
+
+    // Multiplies x by the hash key in GF(2^128), using Shoup's 4-bit tables
+    static void multiplyByHashKeyPortable (uint8* x, const uint64* tableHigh, const uint64* tableLow) noexcept
+    {
+        static const uint64 reductions[] =
+        {
+            0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+            0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+        };
+
+        int nibble = x[15] & 0xf;
+        uint64 zh = tableHigh[nibble];
+        uint64 zl = tableLow[nibble];
+
+        for (int i = 15; i >= 0; --i)
+        {
+            for (int half = (i == 15 ? 1 : 0); half < 2; ++half)
+            {
+                nibble = half == 0 ? (x[i] & 0xf) : (x[i] >> 4);
+
+                const int remainder = (int) (zl & 0xf);
+                zl = (zh << 60) | (zl >> 4);
+                zh = (zh >> 4) ^ (reductions[remainder] << 48) ^ tableHigh[nibble];
+                zl ^= tableLow[nibble];
+            }
+        }
+
+        for (int i = 0; i < 8; ++i)
+        {
+            x[i]     = (uint8) (zh >> (56 - i * 8));
+            x[i + 8] = (uint8) (zl >> (56 - i * 8));
+        }
+    }
+
+    static inline void incrementCounter (uint8* counter) noexcept
+    {
+        for (int i = 16; --i >= 12;)
+            if (++counter[i] != 0)
+                break;
+    }
+
+    //==============================================================================
+   #if JUCE_AES_USE_X86_INSTRUCTIONS
+    static bool cpuHasAESInstructions() noexcept
+    {
+       #if JUCE_MSVC
+        int info[4];
+        __cpuid (info, 1);
+        const int ecx = info[2];
+       #else
+        unsigned int a, b, ecx, d;
+
+        if (! __get_cpuid (1, &a, &b, &ecx, &d))
+            return false;
+       #endif
+
+        // AES, PCLMULQDQ, SSSE3 and SSE4.1
+        return (ecx & (1 << 25)) != 0 && (ecx & (1 << 1)) != 0
+            && (ecx & (1 << 9)) != 0 && (ecx & (1 << 19)) != 0;
+    }
+
+    #if JUCE_GCC
+     #define JUCE_AES_X86_TARGET __attribute__ ((target ("aes,pclmul,ssse3,sse4.1")))
+    #else
+     #define JUCE_AES_X86_TARGET
+    #endif
+
+    JUCE_AES_X86_TARGET
+    static void encryptBlockX86 (const uint8* roundKeys, const int numRounds, const uint8* input, uint8* output) noexcept
+    {
+        __m128i b = _mm_xor_si128 (_mm_loadu_si128 ((const __m128i*) input), _mm_loadu_si128 ((const __m128i*) roundKeys));
+
+        for (int i = 1; i < numRounds; ++i)
+            b = _mm_aesenc_si128 (b, _mm_loadu_si128 ((const __m128i*) (roundKeys + 16 * i)));
+
+        _mm_storeu_si128 ((__m128i*) output, _mm_aesenclast_si128 (b, _mm_loadu_si128 ((const __m128i*) (roundKeys + 16 * numRounds))));
+    }
+
+    // Counter mode, encrypting four blocks at a time so that the AES instructions can overlap
+    JUCE_AES_X86_TARGET
+    static void applyKeyStreamX86 (const uint8* roundKeys, const int numRounds, uint8* counter,
+                                   uint8* data, size_t numBytes) noexcept
+    {
+        __m128i keys[15];
+
+        for (int i = 0; i <= numRounds; ++i)
+            keys[i] = _mm_loadu_si128 ((const __m128i*) (roundKeys + 16 * i));
+
+        const __m128i counterBase = _mm_loadu_si128 ((const __m128i*) counter);
+        uint32 count = ByteOrder::bigEndianInt (counter + 12);
+
+        for (; numBytes > 0; count += 4)
+        {
+            __m128i b[4];
+
+            for (int k = 0; k < 4; ++k)
+                b[k] = _mm_xor_si128 (_mm_insert_epi32 (counterBase, (int) ByteOrder::swap ((uint32) (count + (uint32) k)), 3), keys[0]);
+
+            for (int i = 1; i < numRounds; ++i)
+                for (int k = 0; k < 4; ++k)
+                    b[k] = _mm_aesenc_si128 (b[k], keys[i]);
+
+            for (int k = 0; k < 4; ++k)
+                b[k] = _mm_aesenclast_si128 (b[k], keys[numRounds]);
+
+            if (numBytes >= 64)
+            {
+                for (int k = 0; k < 4; ++k)
+                    _mm_storeu_si128 ((__m128i*) (data + 16 * k),
+                                      _mm_xor_si128 (_mm_loadu_si128 ((const __m128i*) (data + 16 * k)), b[k]));
+
+                data += 64;
+                numBytes -= 64;
+            }
+            else
+            {
+                uint8 keyStream[64];
+
+                for (int k = 0; k < 4; ++k)
+                    _mm_storeu_si128 ((__m128i*) (keyStream + 16 * k), b[k]);
+
+                for (size_t i = 0; i < numBytes; ++i)
+                    data[i] ^= keyStream[i];
+
+                count += (uint32) (numBytes + 15) / 16 - 4;
+                numBytes = 0;
+            }
+        }
+
+        counter[12] = (uint8) (count >> 24);
+        counter[13] = (uint8) (count >> 16);
+        counter[14] = (uint8) (count >> 8);
+        counter[15] = (uint8) count;
+    }
+
+    // Multiplication in GF(2^128) of bit-reflected values, from Intel's carry-less multiplication white paper
+    JUCE_AES_X86_TARGET
+    static inline __m128i galoisMultiplyX86 (const __m128i a, const __m128i b) noexcept
+    {
+        __m128i lo     = _mm_clmulepi64_si128 (a, b, 0x00);
+        __m128i middle = _mm_xor_si128 (_mm_clmulepi64_si128 (a, b, 0x10), _mm_clmulepi64_si128 (a, b, 0x01));
+        __m128i hi     = _mm_clmulepi64_si128 (a, b, 0x11);
+
+        lo = _mm_xor_si128 (lo, _mm_slli_si128 (middle, 8));
+        hi = _mm_xor_si128 (hi, _mm_srli_si128 (middle, 8));
+
+        // shift the 256-bit product left by one bit
+        const __m128i loCarry = _mm_srli_epi32 (lo, 31);
+        const __m128i hiCarry = _mm_srli_epi32 (hi, 31);
+        lo = _mm_or_si128 (_mm_slli_epi32 (lo, 1), _mm_slli_si128 (loCarry, 4));
+        hi = _mm_or_si128 (_mm_or_si128 (_mm_slli_epi32 (hi, 1), _mm_slli_si128 (hiCarry, 4)), _mm_srli_si128 (loCarry, 12));
+
+        // reduce modulo x^128 + x^7 + x^2 + x + 1
+        __m128i t = _mm_xor_si128 (_mm_xor_si128 (_mm_slli_epi32 (lo, 31), _mm_slli_epi32 (lo, 30)), _mm_slli_epi32 (lo, 25));
+        const __m128i spill = _mm_srli_si128 (t, 4);
+        lo = _mm_xor_si128 (lo, _mm_slli_si128 (t, 12));
+
+        t = _mm_xor_si128 (_mm_xor_si128 (_mm_srli_epi32 (lo, 1), _mm_srli_epi32 (lo, 2)), _mm_srli_epi32 (lo, 7));
+        t = _mm_xor_si128 (t, spill);
+        return _mm_xor_si128 (hi, _mm_xor_si128 (lo, t));
+    }
+
+    JUCE_AES_X86_TARGET
+    static void updateHashX86 (uint8* hash, const uint8* hashKey, const uint8* data, size_t numBytes) noexcept
+    {
+        const __m128i byteReverse = _mm_set_epi8 (0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m128i h = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) hashKey), byteReverse);
+        __m128i x = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) hash), byteReverse);
+
+        if (numBytes >= 64)
+        {
+            // Four blocks at a time, using ((((x + b0) h + b1) h + b2) h + b3) h
+            //  = (x + b0) h^4 + b1 h^3 + b2 h^2 + b3 h, so that the multiplications can overlap
+            const __m128i h2 = galoisMultiplyX86 (h, h);
+            const __m128i h3 = galoisMultiplyX86 (h2, h);
+            const __m128i h4 = galoisMultiplyX86 (h3, h);
+
+            for (; numBytes >= 64; numBytes -= 64, data += 64)
+            {
+                const __m128i b0 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) data), byteReverse);
+                const __m128i b1 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) (data + 16)), byteReverse);
+                const __m128i b2 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) (data + 32)), byteReverse);
+                const __m128i b3 = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) (data + 48)), byteReverse);
+
+                x = _mm_xor_si128 (_mm_xor_si128 (galoisMultiplyX86 (_mm_xor_si128 (x, b0), h4), galoisMultiplyX86 (b1, h3)),
+                                   _mm_xor_si128 (galoisMultiplyX86 (b2, h2), galoisMultiplyX86 (b3, h)));
+            }
+        }
+
+        for (; numBytes >= 16; numBytes -= 16, data += 16)
+            x = galoisMultiplyX86 (_mm_xor_si128 (x, _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) data), byteReverse)), h);
+
+        if (numBytes > 0)
+        {
+            uint8 lastBlock[16] = { 0 };
+            memcpy (lastBlock, data, numBytes);
+            x = galoisMultiplyX86 (_mm_xor_si128 (x, _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) lastBlock), byteReverse)), h);
+        }
+
+        _mm_storeu_si128 ((__m128i*) hash, _mm_shuffle_epi8 (x, byteReverse));
+    }
+
+    #undef JUCE_AES_X86_TARGET
+
+   #elif JUCE_AES_USE_ARM_INSTRUCTIONS
+    static void encryptBlockARM (const uint8* roundKeys, const int numRounds, const uint8* input, uint8* output) noexcept
+    {
+        uint8x16_t b = vld1q_u8 (input);
+
+        for (int i = 0; i < numRounds - 1; ++i)
+            b = vaesmcq_u8 (vaeseq_u8 (b, vld1q_u8 (roundKeys + 16 * i)));
+
+        b = vaeseq_u8 (b, vld1q_u8 (roundKeys + 16 * (numRounds - 1)));
+        vst1q_u8 (output, veorq_u8 (b, vld1q_u8 (roundKeys + 16 * numRounds)));
+    }
+   #endif
+
+    static bool shouldUseHardware() noexcept
+    {
+       #if JUCE_AES_USE_X86_INSTRUCTIONS
+        static const bool hasInstructions = cpuHasAESInstructions();
+        return hasInstructions;
+       #elif JUCE_AES_USE_ARM_INSTRUCTIONS
+        return true;
+       #else
+        return false;
+       #endif
+    }
+}
+
+//==============================================================================
+AESGCM::AESGCM (const void* const keyData, const size_t keyBytes)
+{
+    setKey (keyData, keyBytes);
+}
+
+AESGCM::AESGCM (const MemoryBlock& key)
+{
+    setKey (key.getData(), key.getSize());
+}
+
+AESGCM::AESGCM (const AESGCM& other) noexcept
+{
+    operator= (other);
+}
+
+AESGCM& AESGCM::operator= (const AESGCM& other) noexcept
+{
+    memcpy (roundKeys, other.roundKeys, sizeof (roundKeys));
+    numRounds = other.numRounds;
+    memcpy (hashKey, other.hashKey, sizeof (hashKey));
+    memcpy (hashTableHigh, other.hashTableHigh, sizeof (hashTableHigh));
+    memcpy (hashTableLow, other.hashTableLow, sizeof (hashTableLow));
+    return *this;
+}
+
+AESGCM::~AESGCM() noexcept
+{
+    zerostruct (roundKeys);
+    zerostruct (hashKey);
+    zerostruct (hashTableHigh);
+    zerostruct (hashTableLow);
+}
+
+void AESGCM::setKey (const void* const keyData, size_t keyBytes) noexcept
+{
+    // The key must be 16, 24 or 32 bytes long!
+    jassert (keyData != nullptr && (keyBytes == 16 || keyBytes == 24 || keyBytes == 32));
+
+    zerostruct (roundKeys);
+
+    if (keyData == nullptr)
+        keyBytes = 0;
+
+    // (any other length of key is padded with zeros or truncated to the next valid size)
+    const int keyWords = keyBytes <= 16 ? 4 : (keyBytes <= 24 ? 6 : 8);
+    numRounds = keyWords + 6;
+    memcpy (roundKeys, keyData, jmin (keyBytes, (size_t) keyWords * 4));
+
+    const AESHelpers::Tables& t = AESHelpers::Tables::get();
+    uint8 roundConstant = 1;
+
+    for (int i = keyWords; i < 4 * (numRounds + 1); ++i)
+    {
+        uint8 word[4];
+        memcpy (word, roundKeys + 4 * (i - 1), 4);
+
+        if (i % keyWords == 0)
+        {
+            const uint8 first = word[0];
+            word[0] = (uint8) (t.sbox[word[1]] ^ roundConstant);
+            word[1] = t.sbox[word[2]];
+            word[2] = t.sbox[word[3]];
+            word[3] = t.sbox[first];
+            roundConstant = AESHelpers::xtime (roundConstant);
+        }
+        else if (keyWords > 6 && i % keyWords == 4)
+        {
+            for (int j = 0; j < 4; ++j)
+                word[j] = t.sbox[word[j]];
+        }
+
+        for (int j = 0; j < 4; ++j)
+            roundKeys[4 * i + j] = (uint8) (roundKeys[4 * (i - keyWords) + j] ^ word[j]);
+    }
+
+    // The hash key is the encryption of a block of zeros
+    zerostruct (hashKey);
+    encryptBlock (hashKey, hashKey);
+
+    // Tables of the hash key multiplied by each 4-bit value, for the portable version of GHASH
+    uint64 vh = ByteOrder::bigEndianInt64 (hashKey);
+    uint64 vl = ByteOrder::bigEndianInt64 (hashKey + 8);
+
+    hashTableHigh[0] = hashTableLow[0] = 0;
+    hashTableHigh[8] = vh;
+    hashTableLow[8] = vl;
+
+    for (int i = 4; i > 0; i >>= 1)
+    {
+        const uint64 reduction = (vl & 1) != 0 ? ((uint64) 0xe1000000 << 32) : 0;
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ reduction;
+        hashTableHigh[i] = vh;
+        hashTableLow[i] = vl;
+    }
+
+    for (int i = 2; i <= 8; i <<= 1)
+    {
+        for (int j = 1; j < i; ++j)
+        {
+            hashTableHigh[i + j] = hashTableHigh[i] ^ hashTableHigh[j];
+            hashTableLow[i + j]  = hashTableLow[i]  ^ hashTableLow[j];
+        }
+    }
+}
+
+bool AESGCM::isHardwareAccelerated() noexcept
+{
+    return AESHelpers::shouldUseHardware();
+}
+
+//==============================================================================
+void AESGCM::encryptBlock (const uint8* input, uint8* output) const noexcept
+{
+   #if JUCE_AES_USE_X86_INSTRUCTIONS
+    if (AESHelpers::shouldUseHardware())
+        return AESHelpers::encryptBlockX86 (roundKeys, numRounds, input, output);
+   #elif JUCE_AES_USE_ARM_INSTRUCTIONS
+    return AESHelpers::encryptBlockARM (roundKeys, numRounds, input, output);
+   #endif
+
+    AESHelpers::encryptBlockPortable (roundKeys, numRounds, input, output);
+}
+
+void AESGCM::applyKeyStream (const uint8* nonce, uint8* data, size_t numBytes) const noexcept
+{
+    // The first counter block is used for the tag, so the key stream starts at the second one
+    uint8 counter[16];
+    memcpy (counter, nonce, nonceSize);
+    counter[12] = counter[13] = counter[14] = 0;
+    counter[15] = 2;
+
+   #if JUCE_AES_USE_X86_INSTRUCTIONS
+    if (AESHelpers::shouldUseHardware())
+        return AESHelpers::applyKeyStreamX86 (roundKeys, numRounds, counter, data, numBytes);
+   #endif
+
+    while (numBytes > 0)
+    {
+        uint8 keyStream[16];
+        encryptBlock (counter, keyStream);
+        AESHelpers::incrementCounter (counter);
+
+        const size_t num = jmin (numBytes, (size_t) 16);
+
+        for (size_t i = 0; i < num; ++i)
+            data[i] ^= keyStream[i];
+
+        data += num;
+        numBytes -= num;
+    }
+}
+
+void AESGCM::updateHash (uint8* hash, const uint8* data, size_t numBytes) const noexcept
+{
+   #if JUCE_AES_USE_X86_INSTRUCTIONS
+    if (AESHelpers::shouldUseHardware())
+        return AESHelpers::updateHashX86 (hash, hashKey, data, numBytes);
+   #endif
+
+    // (a final partial block is padded with zeros)
+    while (numBytes > 0)
+    {
+        const size_t num = jmin (numBytes, (size_t) 16);
+
+        for (size_t i = 0; i < num; ++i)
+            hash[i] ^= data[i];
+
+        AESHelpers::multiplyByHashKeyPortable (hash, hashTableHigh, hashTableLow);
+        data += num;
+        numBytes -= num;
+    }
+}
+
+void AESGCM::calculateTag (const uint8* nonce, const uint8* additionalData, const size_t additionalDataBytes,
+                           const uint8* cipherText, const size_t numBytes, uint8* tag) const noexcept
+{
+    uint8 hash[16] = { 0 };
+    updateHash (hash, additionalData, additionalDataBytes);
+    updateHash (hash, cipherText, numBytes);
+
+    uint8 lengths[16];
+    const uint64 additionalBits = (uint64) additionalDataBytes * 8;
+    const uint64 cipherTextBits = (uint64) numBytes * 8;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        lengths[i]     = (uint8) (additionalBits >> (56 - i * 8));
+        lengths[i + 8] = (uint8) (cipherTextBits >> (56 - i * 8));
+    }
+
+    updateHash (hash, lengths, sizeof (lengths));
+
+    uint8 counter[16];
+    memcpy (counter, nonce, nonceSize);
+    counter[12] = counter[13] = counter[14] = 0;
+    counter[15] = 1;
+    encryptBlock (counter, counter);
+
+    for (int i = 0; i < tagSize; ++i)
+        tag[i] = (uint8) (hash[i] ^ counter[i]);
+}
+
+//==============================================================================
+void AESGCM::encrypt (const void* const nonce, void* const data, const size_t numBytes, void* const tag,
+                      const void* const additionalData, const size_t additionalDataBytes) const noexcept
+{
+    jassert (nonce != nullptr && tag != nullptr && (data != nullptr || numBytes == 0));
+
+    applyKeyStream (static_cast<const uint8*> (nonce), static_cast<uint8*> (data), numBytes);
+    calculateTag (static_cast<const uint8*> (nonce), static_cast<const uint8*> (additionalData), additionalDataBytes,
+                  static_cast<const uint8*> (data), numBytes, static_cast<uint8*> (tag));
+}
+
+bool AESGCM::decrypt (const void* const nonce, void* const data, const size_t numBytes, const void* const tag,
+                      const void* const additionalData, const size_t additionalDataBytes) const noexcept
+{
+    jassert (nonce != nullptr && tag != nullptr && (data != nullptr || numBytes == 0));
+
+    uint8 expectedTag[tagSize];
+    calculateTag (static_cast<const uint8*> (nonce), static_cast<const uint8*> (additionalData), additionalDataBytes,
+                  static_cast<const uint8*> (data), numBytes, expectedTag);
+
+    // (the comparison takes the same time wherever the tags differ)
+    uint8 difference = 0;
+
+    for (int i = 0; i < tagSize; ++i)
+        difference |= (uint8) (expectedTag[i] ^ static_cast<const uint8*> (tag)[i]);
+
+    if (difference != 0)
+        return false;
+
+    applyKeyStream (static_cast<const uint8*> (nonce), static_cast<uint8*> (data), numBytes);
+    return true;
+}
+
+void AESGCM::encrypt (MemoryBlock& data) const
+{
+    const size_t numBytes = data.getSize();
+    MemoryBlock result (nonceSize + numBytes + tagSize);
+    uint8* const dest = static_cast<uint8*> (result.getData());
+
+    createNonce (dest);
+    memcpy (dest + nonceSize, data.getData(), numBytes);
+    encrypt (dest, dest + nonceSize, numBytes, dest + nonceSize + numBytes);
+
+    data.swapWith (result);
+}
+
+bool AESGCM::decrypt (MemoryBlock& data) const
+{
+    if (data.getSize() < nonceSize + tagSize)
+        return false;
+
+    const size_t numBytes = data.getSize() - (nonceSize + tagSize);
+    const uint8* const source = static_cast<const uint8*> (data.getData());
+    MemoryBlock result (source + nonceSize, numBytes);
+
+    if (! decrypt (source, result.getData(), numBytes, source + nonceSize + numBytes))
+        return false;
+
+    data.swapWith (result);
+    return true;
+}
+
+void AESGCM::createNonce (void* const nonce)
+{
+    uint8* const dest = static_cast<uint8*> (nonce);
+
+   #if JUCE_LINUX || JUCE_MAC || JUCE_IOS || JUCE_ANDROID
+    {
+        FileInputStream in (File ("/dev/urandom"));
+
+        if (in.openedOk() && in.read (dest, nonceSize) == nonceSize)
+            return;
+    }
+   #endif
+
+    // Otherwise, mix the system's random generator with the time and a counter, so that
+    // two calls can't give the same value even if the generator repeats itself
+    static Atomic<int> callCount;
+    Random& r = Random::getSystemRandom();
+    const int64 a = r.nextInt64() ^ Time::getHighResolutionTicks();
+    const uint32 b = (uint32) r.nextInt() ^ (uint32) ++callCount;
+
+    memcpy (dest, &a, 8);
+    memcpy (dest + 8, &b, 4);
+}
+
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AESGCMTests  : public UnitTest
+{
+public:
+    AESGCMTests() : UnitTest ("AES-GCM") {}
+
+    void runTest()
+    {
+        beginTest ("AES-GCM");
+
+        {
+            // The first two test cases from the GCM specification
+            const uint8 zeros[16] = { 0 };
+            uint8 data[16] = { 0 };
+            uint8 tag[16];
+            AESGCM aes (zeros, 16);
+
+            aes.encrypt (zeros, data, 0, tag);
+            expectEquals (String::toHexString (tag, 16, 0), String ("58e2fccefa7e3061367f1d57a4e7455a"));
+
+            aes.encrypt (zeros, data, 16, tag);
+            expectEquals (String::toHexString (data, 16, 0), String ("0388dace60b6a392f328c2b971b2fe78"));
+            expectEquals (String::toHexString (tag, 16, 0), String ("ab6e47d42cec13bdf53a67b21257bddf"));
+        }
+
+        {
+            Random r (getRandom());
+            MemoryBlock key (32), original ((size_t) 1000);
+            r.fillBitsRandomly (key.getData(), key.getSize());
+            r.fillBitsRandomly (original.getData(), original.getSize());
+
+            AESGCM aes (key);
+            MemoryBlock data (original);
+            aes.encrypt (data);
+            expect (data.getSize() == original.getSize() + AESGCM::nonceSize + AESGCM::tagSize);
+
+            MemoryBlock decrypted (data);
+            expect (aes.decrypt (decrypted));
+            expect (decrypted == original);
+
+            static_cast<uint8*> (data.getData()) [100] ^= 1;
+            expect (! aes.decrypt (data));
+        }
+    }
+};
+
+static AESGCMTests aesGCMUnitTests;
+
+#endif
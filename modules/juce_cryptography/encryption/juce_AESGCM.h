@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_AESGCM_H_INCLUDED
+#define JUCE_AESGCM_H_INCLUDED
+
+
+//==============================================================================
+/**
+    AES encryption in Galois/Counter Mode (GCM).
+
+    This encrypts data and also produces a 16-byte authentication tag, so that when the
+    data is decrypted, any changes that have been made to it are detected and the data
+    is rejected.
+
+    Every message that's encrypted with the same key must use a different 12-byte
+    nonce. Reusing one with the same key gives away the key stream and allows
+    forgeries, so either use a counter or call createNonce() to make a random one.
+
+    Where the CPU has AES and carry-less multiply instructions (AES-NI and PCLMULQDQ
+    on x86, or the ARMv8 crypto extensions), these are used automatically, which makes
+    it many times faster, and also immune to cache-timing attacks. The portable version
+    uses lookup tables, so it doesn't have that protection.
+
+    To encrypt a stream of data, see AESGCMOutputStream and AESGCMInputStream.
+
+    @see AESGCMOutputStream, AESGCMInputStream, BlowFish
+*/
+class JUCE_API  AESGCM
+{
+public:
+    //==============================================================================
+    /** Creates an object that can encrypt and decrypt data using the given key.
+        The key must be 16, 24 or 32 bytes long, to use AES-128, AES-192 or AES-256.
+    */
+    AESGCM (const void* keyData, size_t keyBytes);
+
+    /** Creates an object that can encrypt and decrypt data using the given key.
+        The key must be 16, 24 or 32 bytes long, to use AES-128, AES-192 or AES-256.
+    */
+    explicit AESGCM (const MemoryBlock& key);
+
+    /** Creates a copy of another AESGCM object. */
+    AESGCM (const AESGCM&) noexcept;
+
+    /** Copies another AESGCM object. */
+    AESGCM& operator= (const AESGCM&) noexcept;
+
+    /** Destructor. */
+    ~AESGCM() noexcept;
+
+    //==============================================================================
+    enum
+    {
+        nonceSize = 12,     /**< The number of bytes in a nonce. */
+        tagSize = 16        /**< The number of bytes in an authentication tag. */
+    };
+
+    /** Encrypts a block of data in place, and calculates its authentication tag.
+
+        @param nonce                a 12-byte value that must never be used for more than
+                                    one message with the same key
+        @param data                 the data to encrypt - the encrypted version replaces it,
+                                    and is the same size
+        @param numBytes             the number of bytes of data
+        @param tag                  a 16-byte buffer which receives the tag - this must be
+                                    stored with the encrypted data, as it's needed to decrypt it
+        @param additionalData       some optional data that isn't encrypted, but which is
+                                    covered by the tag, so that decryption will fail if it
+                                    doesn't match
+        @param additionalDataBytes  the size of the additional data
+    */
+    void encrypt (const void* nonce, void* data, size_t numBytes, void* tag,
+                  const void* additionalData = nullptr, size_t additionalDataBytes = 0) const noexcept;
+
+    /** Checks the authentication tag of some encrypted data, and if it matches, decrypts
+        the data in place.
+
+        The parameters must be the same as those that were passed to encrypt(). If the
+        tag doesn't match, the data is left unchanged and this returns false.
+    */
+    bool decrypt (const void* nonce, void* data, size_t numBytes, const void* tag,
+                  const void* additionalData = nullptr, size_t additionalDataBytes = 0) const noexcept;
+
+    //==============================================================================
+    /** Encrypts a MemoryBlock, using a new random nonce.
+        The nonce is added to the start of the block, and the tag to its end, so the
+        block gets (nonceSize + tagSize) bytes bigger.
+        @see decrypt
+    */
+    void encrypt (MemoryBlock& data) const;
+
+    /** Decrypts a MemoryBlock that was encrypted with encrypt (MemoryBlock&).
+        If the data has been changed or wasn't encrypted with this key, the block is left
+        unchanged and this returns false.
+    */
+    bool decrypt (MemoryBlock& data) const;
+
+    //==============================================================================
+    /** Fills a buffer with a random 12-byte nonce.
+        Where the OS provides a secure random number source, this uses it.
+    */
+    static void createNonce (void* nonce);
+
+    /** Returns true if the CPU's own AES instructions are being used. */
+    static bool isHardwareAccelerated() noexcept;
+
+private:
+    //==============================================================================
+    uint8 roundKeys [15 * 16];
+    int numRounds;
+    uint8 hashKey [16];
+    uint64 hashTableHigh [16], hashTableLow [16];
+
+    void setKey (const void*, size_t) noexcept;
+    void encryptBlock (const uint8* input, uint8* output) const noexcept;
+    void applyKeyStream (const uint8* nonce, uint8* data, size_t numBytes) const noexcept;
+    void updateHash (uint8* hash, const uint8* data, size_t numBytes) const noexcept;
+    void calculateTag (const uint8* nonce, const uint8* additionalData, size_t additionalDataBytes,
+                       const uint8* cipherText, size_t numBytes, uint8* tag) const noexcept;
+
+    JUCE_LEAK_DETECTOR (AESGCM)
+};
+
+
+#endif   // JUCE_AESGCM_H_INCLUDED
@@ -0,0 +1,281 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+namespace AESGCMStreamHelpers
+{
+    enum
+    {
+        segmentSize = AESGCMOutputStream::segmentSize,
+        encryptedSegmentSize = segmentSize + AESGCM::tagSize,
+        headerSize = 8
+    };
+
+    // Each segment's nonce is the stream's random prefix followed by the segment's index,
+    // and the additional data marks whether it's the last one.
+    static void makeNonce (uint8* nonce, const uint8* prefix, const uint32 index) noexcept
+    {
+        memcpy (nonce, prefix, headerSize);
+        nonce[8]  = (uint8) (index >> 24);
+        nonce[9]  = (uint8) (index >> 16);
+        nonce[10] = (uint8) (index >> 8);
+        nonce[11] = (uint8) index;
+    }
+}
+
+//==============================================================================
+AESGCMOutputStream::AESGCMOutputStream (OutputStream* const dest, const AESGCM& c,
+                                        const bool deleteDestStream)
+    : destStream (dest, deleteDestStream),
+      cipher (c),
+      buffer ((size_t) AESGCMStreamHelpers::encryptedSegmentSize),
+      numBuffered (0), segmentIndex (0), position (0), isClosed (false)
+{
+    jassert (dest != nullptr);
+
+    uint8 nonce [AESGCM::nonceSize];
+    AESGCM::createNonce (nonce);
+    memcpy (noncePrefix, nonce, sizeof (noncePrefix));
+
+    if (! destStream->write (noncePrefix, sizeof (noncePrefix)))
+        isClosed = true;
+}
+
+AESGCMOutputStream::~AESGCMOutputStream()
+{
+    flush();
+}
+
+bool AESGCMOutputStream::writeSegment (const bool isLastSegment)
+{
+    uint8 nonce [AESGCM::nonceSize];
+    AESGCMStreamHelpers::makeNonce (nonce, noncePrefix, segmentIndex++);
+
+    const uint8 lastSegmentFlag = isLastSegment ? 1 : 0;
+    cipher.encrypt (nonce, buffer, numBuffered, buffer + numBuffered, &lastSegmentFlag, 1);
+
+    const size_t numToWrite = numBuffered + AESGCM::tagSize;
+    numBuffered = 0;
+    return destStream->write (buffer, numToWrite);
+}
+
+void AESGCMOutputStream::flush()
+{
+    if (! isClosed)
+    {
+        // (the last segment is always shorter than a full one, even if that means it's empty)
+        writeSegment (true);
+        isClosed = true;
+    }
+
+    destStream->flush();
+}
+
+bool AESGCMOutputStream::write (const void* destBuffer, size_t howMany)
+{
+    jassert (destBuffer != nullptr && (ssize_t) howMany >= 0);
+
+    if (isClosed)
+    {
+        jassertfalse;  // you can't write any more data after calling flush()!
+        return false;
+    }
+
+    const uint8* source = static_cast<const uint8*> (destBuffer);
+    position += (int64) howMany;
+
+    while (howMany > 0)
+    {
+        const size_t numToCopy = jmin (howMany, (size_t) AESGCMStreamHelpers::segmentSize - numBuffered);
+        memcpy (buffer + numBuffered, source, numToCopy);
+        numBuffered += numToCopy;
+        source += numToCopy;
+        howMany -= numToCopy;
+
+        if (numBuffered == (size_t) AESGCMStreamHelpers::segmentSize && ! writeSegment (false))
+            return false;
+    }
+
+    return true;
+}
+
+int64 AESGCMOutputStream::getPosition()
+{
+    return position;
+}
+
+bool AESGCMOutputStream::setPosition (int64 /*newPosition*/)
+{
+    jassertfalse; // can't do it!
+    return false;
+}
+
+//==============================================================================
+AESGCMInputStream::AESGCMInputStream (InputStream* const source, const AESGCM& c,
+                                      const bool deleteSourceWhenDestroyed)
+    : sourceStream (source, deleteSourceWhenDestroyed),
+      cipher (c),
+      buffer ((size_t) AESGCMStreamHelpers::encryptedSegmentSize),
+      sourceStart (source->getPosition()),
+      currentSegment (-1), nextSourceSegment (0),
+      segmentLength (0), positionInSegment (0),
+      isLastSegment (false), headerRead (false), failed (false)
+{
+    zerostruct (noncePrefix);
+}
+
+AESGCMInputStream::~AESGCMInputStream()
+{
+}
+
+bool AESGCMInputStream::readHeader()
+{
+    if (! headerRead)
+    {
+        if (sourceStream->read (noncePrefix, sizeof (noncePrefix)) != (int) sizeof (noncePrefix))
+        {
+            failed = true;
+            return false;
+        }
+
+        headerRead = true;
+    }
+
+    return true;
+}
+
+bool AESGCMInputStream::loadSegment (const int64 index)
+{
+    using namespace AESGCMStreamHelpers;
+
+    if (failed || ! readHeader())
+        return false;
+
+    if (index != nextSourceSegment
+         && ! sourceStream->setPosition (sourceStart + headerSize + index * encryptedSegmentSize))
+        return false;
+
+    const int bytesRead = sourceStream->read (buffer, encryptedSegmentSize);
+    nextSourceSegment = index + 1;
+
+    uint8 nonce [AESGCM::nonceSize];
+    makeNonce (nonce, noncePrefix, (uint32) index);
+
+    // Only the last segment is shorter than a full one, and it must be marked as the last,
+    // so a stream that has been cut off at any point will fail to authenticate
+    const uint8 lastSegmentFlag = bytesRead < encryptedSegmentSize ? 1 : 0;
+    const int dataLength = bytesRead - AESGCM::tagSize;
+
+    if (dataLength < 0 || ! cipher.decrypt (nonce, buffer, (size_t) dataLength, buffer + dataLength, &lastSegmentFlag, 1))
+    {
+        failed = true;
+        currentSegment = -1;
+        segmentLength = positionInSegment = 0;
+        return false;
+    }
+
+    currentSegment = index;
+    segmentLength = dataLength;
+    positionInSegment = 0;
+    isLastSegment = lastSegmentFlag != 0;
+    return true;
+}
+
+int64 AESGCMInputStream::getTotalLength()
+{
+    using namespace AESGCMStreamHelpers;
+
+    const int64 sourceLength = sourceStream->getTotalLength();
+
+    if (sourceLength < 0)
+        return -1;
+
+    const int64 encryptedLength = jmax ((int64) 0, sourceLength - sourceStart - headerSize);
+    const int64 lastSegmentLength = encryptedLength % encryptedSegmentSize;
+
+    return (encryptedLength / encryptedSegmentSize) * segmentSize
+             + jmax ((int64) 0, lastSegmentLength - AESGCM::tagSize);
+}
+
+bool AESGCMInputStream::isExhausted()
+{
+    return failed || (isLastSegment && positionInSegment >= segmentLength);
+}
+
+int AESGCMInputStream::read (void* destBuffer, int howMany)
+{
+    jassert (destBuffer != nullptr && howMany >= 0);
+
+    uint8* dest = static_cast<uint8*> (destBuffer);
+    int numRead = 0;
+
+    while (howMany > 0)
+    {
+        if (positionInSegment >= segmentLength)
+        {
+            if ((currentSegment >= 0 && isLastSegment) || ! loadSegment (currentSegment + 1))
+                break;
+
+            continue;
+        }
+
+        const int numToCopy = jmin (howMany, segmentLength - positionInSegment);
+        memcpy (dest, buffer + positionInSegment, (size_t) numToCopy);
+        positionInSegment += numToCopy;
+        dest += numToCopy;
+        numRead += numToCopy;
+        howMany -= numToCopy;
+
+        // (loading the next segment straight away means that if the stream has been cut
+        //  off at the end of this one, that's reported as soon as its data has been read)
+        if (positionInSegment >= segmentLength && ! isLastSegment)
+            loadSegment (currentSegment + 1);
+    }
+
+    return numRead;
+}
+
+int64 AESGCMInputStream::getPosition()
+{
+    return jmax ((int64) 0, currentSegment) * AESGCMStreamHelpers::segmentSize + positionInSegment;
+}
+
+bool AESGCMInputStream::setPosition (int64 newPos)
+{
+    using namespace AESGCMStreamHelpers;
+
+    const int64 totalLength = getTotalLength();
+
+    if (totalLength >= 0)
+        newPos = jmin (newPos, totalLength);
+
+    newPos = jmax ((int64) 0, newPos);
+    const int64 index = newPos / segmentSize;
+
+    if (index != currentSegment && ! loadSegment (index))
+        return false;
+
+    positionInSegment = (int) jmin ((int64) segmentLength, newPos - index * segmentSize);
+    return true;
+}
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_AESGCMSTREAMS_H_INCLUDED
+#define JUCE_AESGCMSTREAMS_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A stream which encrypts the data written into it with AES-GCM.
+
+    The data is split into segments of 64KB, each encrypted with its own nonce and
+    followed by its own authentication tag. This means that an AESGCMInputStream can
+    check each segment as it reads it, rather than needing to read the whole stream
+    before any of it can be trusted, and it can also seek to any position.
+
+    The output starts with a random 8-byte value that's used to make the nonces, and
+    the last segment is marked, so that a stream which has been cut short is detected.
+
+    Important note: When you call flush() on an AESGCMOutputStream, the last segment is
+    written and the stream is closed - this means that no more data can be written to
+    it, and any subsequent attempts to call write() will cause an assertion. The
+    destructor calls flush() if you haven't already done so.
+
+    @see AESGCMInputStream, AESGCM
+*/
+class JUCE_API  AESGCMOutputStream  : public OutputStream
+{
+public:
+    //==============================================================================
+    /** Creates an encrypting stream.
+
+        @param destStream                       the stream into which the encrypted data
+                                                should be written
+        @param cipher                           the key to encrypt with - this object keeps its
+                                                own copy
+        @param deleteDestStreamWhenDestroyed    whether or not to delete the destStream object
+                                                when this stream is destroyed
+    */
+    AESGCMOutputStream (OutputStream* destStream,
+                        const AESGCM& cipher,
+                        bool deleteDestStreamWhenDestroyed = false);
+
+    /** Destructor. */
+    ~AESGCMOutputStream();
+
+    //==============================================================================
+    /** Writes the last segment and closes the stream.
+        Note that unlike most streams, when you call flush() on an AESGCMOutputStream,
+        the stream is closed - this means that no more data can be written to it, and
+        any subsequent attempts to call write() will cause an assertion.
+    */
+    void flush() override;
+
+    int64 getPosition() override;
+    bool setPosition (int64) override;
+    bool write (const void*, size_t) override;
+
+    /** The number of bytes of data in each encrypted segment. */
+    enum { segmentSize = 65536 };
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<OutputStream> destStream;
+    AESGCM cipher;
+    HeapBlock<uint8> buffer;
+    uint8 noncePrefix [8];
+    size_t numBuffered;
+    uint32 segmentIndex;
+    int64 position;
+    bool isClosed;
+
+    bool writeSegment (bool isLastSegment);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AESGCMOutputStream)
+};
+
+//==============================================================================
+/**
+    A stream which decrypts data that was written by an AESGCMOutputStream.
+
+    Each segment of the data is checked before any of it is returned. If a segment has
+    been changed, or the stream has been cut short, the stream stops at that point, and
+    hasAuthenticationFailed() will return true.
+
+    If the source stream can seek, this one can seek too.
+
+    @see AESGCMOutputStream, AESGCM
+*/
+class JUCE_API  AESGCMInputStream  : public InputStream
+{
+public:
+    //==============================================================================
+    /** Creates a decrypting stream.
+
+        @param sourceStream                 the stream to read the encrypted data from,
+                                            starting at its current position
+        @param cipher                       the key to decrypt with - this object keeps its
+                                            own copy
+        @param deleteSourceWhenDestroyed    whether or not to delete the source stream
+                                            when this stream is destroyed
+    */
+    AESGCMInputStream (InputStream* sourceStream,
+                       const AESGCM& cipher,
+                       bool deleteSourceWhenDestroyed = false);
+
+    /** Destructor. */
+    ~AESGCMInputStream();
+
+    //==============================================================================
+    /** Returns true if some of the data didn't match its authentication tag, which
+        means that it has been changed, was encrypted with a different key, or is
+        incomplete.
+    */
+    bool hasAuthenticationFailed() const noexcept       { return failed; }
+
+    //==============================================================================
+    int64 getTotalLength() override;
+    bool isExhausted() override;
+    int read (void* destBuffer, int maxBytesToRead) override;
+    int64 getPosition() override;
+    bool setPosition (int64 pos) override;
+
+private:
+    //==============================================================================
+    OptionalScopedPointer<InputStream> sourceStream;
+    AESGCM cipher;
+    HeapBlock<uint8> buffer;
+    uint8 noncePrefix [8];
+    const int64 sourceStart;
+    int64 currentSegment, nextSourceSegment;
+    int segmentLength, positionInSegment;
+    bool isLastSegment, headerRead, failed;
+
+    bool readHeader();
+    bool loadSegment (int64 index);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AESGCMInputStream)
+};
+
+
+#endif   // JUCE_AESGCMSTREAMS_H_INCLUDED
@@ -73,6 +73,10 @@ bool RSAKey::applyToValue (BigInteger& value) const
         return false;
     }
 
+    // A public key's exponent is small, but a private one is as big as the modulus and must
+    // be kept secret, so that needs the slower calculation that doesn't leak it via its timing.
+    const bool isPrivateExponent = part1.getHighestBit() > 64 && part2[0];
+
     BigInteger result;
 
     while (! value.isZero())
@@ -82,7 +86,10 @@ bool RSAKey::applyToValue (BigInteger& value) const
         BigInteger remainder;
         value.divideBy (part2, remainder);
 
-        remainder.exponentModulo (part1, part2);
+        if (isPrivateExponent)
+            remainder.exponentModuloConstantTime (part1, part2);
+        else
+            remainder.exponentModulo (part1, part2);
 
         result += remainder;
     }
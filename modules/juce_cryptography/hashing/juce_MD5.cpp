@@ -26,6 +26,11 @@ class MD5Generator
 {
 public:
     MD5Generator() noexcept
+    {
+        reset();
+    }
+
+    void reset() noexcept
     {
         state[0] = 0x67452301;
         state[1] = 0xefcdab89;
@@ -254,6 +259,37 @@ MD5::MD5 (const File& file)
 
 MD5::~MD5() noexcept {}
 
+//==============================================================================
+struct MD5::Builder::Pimpl  : public MD5Generator
+{
+};
+
+MD5::Builder::Builder()  : pimpl (new Pimpl()) {}
+MD5::Builder::~Builder() {}
+
+void MD5::Builder::update (const void* data, size_t numBytes) noexcept
+{
+    pimpl->processBlock (data, numBytes);
+}
+
+void MD5::Builder::update (const MemoryBlock& data) noexcept
+{
+    pimpl->processBlock (data.getData(), data.getSize());
+}
+
+MD5 MD5::Builder::finish() noexcept
+{
+    MD5 m;
+    pimpl->finish (m.result);
+    pimpl->reset();
+    return m;
+}
+
+void MD5::Builder::reset() noexcept
+{
+    pimpl->reset();
+}
+
 void MD5::processData (const void* data, size_t numBytes) noexcept
 {
     MD5Generator generator;
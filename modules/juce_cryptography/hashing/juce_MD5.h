@@ -31,7 +31,8 @@
     MD5 checksum class.
 
     Create one of these with a block of source data or a stream, and it calculates
-    the MD5 checksum of that data.
+    the MD5 checksum of that data. If the data arrives in pieces, use an MD5::Builder
+    instead.
 
     You can then retrieve this checksum as a 16-byte block, or as a hex string.
     @see SHA256
@@ -77,6 +78,50 @@ public:
     /** Destructor. */
     ~MD5() noexcept;
 
+    //==============================================================================
+    /**
+        Calculates an MD5 checksum from data that's supplied in a series of blocks.
+
+        Call update() with each block of data in turn, and then finish() to get the result,
+        e.g.
+        @code
+        MD5::Builder builder;
+        builder.update (header.getData(), header.getSize());
+        builder.update (body.getData(), body.getSize());
+        MD5 result (builder.finish());
+        @endcode
+    */
+    class JUCE_API  Builder
+    {
+    public:
+        /** Creates a Builder that's ready to receive some data. */
+        Builder();
+
+        /** Destructor. */
+        ~Builder();
+
+        /** Adds some more data. */
+        void update (const void* data, size_t numBytes) noexcept;
+
+        /** Adds the contents of a MemoryBlock. */
+        void update (const MemoryBlock& data) noexcept;
+
+        /** Returns the result for all the data that has been added, and then resets
+            the builder so that it can be used again.
+        */
+        MD5 finish() noexcept;
+
+        /** Discards any data that has been added. */
+        void reset() noexcept;
+
+    private:
+        struct Pimpl;
+        friend struct ContainerDeletePolicy<Pimpl>;
+        ScopedPointer<Pimpl> pimpl;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Builder)
+    };
+
     //==============================================================================
     /** Returns the checksum as a 16-byte block of data. */
     MemoryBlock getRawChecksumData() const;
@@ -22,11 +22,134 @@
   ==============================================================================
 */
 
+static const uint32 sha256Constants[] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+//==============================================================================
+#if JUCE_SHA256_USE_X86_INSTRUCTIONS
+
+static bool cpuHasSHAInstructions() noexcept
+{
+   #if JUCE_MSVC
+    int info[4];
+    __cpuid (info, 0);
+
+    if (info[0] < 7)
+        return false;
+
+    __cpuid (info, 1);
+    const bool hasSSE41 = (info[2] & (1 << 19)) != 0;
+    __cpuidex (info, 7, 0);
+    return hasSSE41 && (info[1] & (1 << 29)) != 0;
+   #else
+    if (__get_cpuid_max (0, nullptr) < 7)
+        return false;
+
+    unsigned int a, b, c, d;
+    __cpuid (1, a, b, c, d);
+    const bool hasSSE41 = (c & (1 << 19)) != 0;
+    __cpuid_count (7, 0, a, b, c, d);
+    return hasSSE41 && (b & (1 << 29)) != 0;
+   #endif
+}
+
+#if JUCE_GCC
+ __attribute__ ((target ("sha,sse4.1")))
+#endif
+static void processSHA256BlocksWithX86Instructions (uint32* const state, const uint8* data, size_t numBlocks) noexcept
+{
+    const __m128i byteSwapMask = _mm_set_epi64x (0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+
+    // The instructions want the state arranged as ABEF and CDGH
+    const __m128i dcba = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i*) state), 0xb1);
+    const __m128i efgh = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i*) (state + 4)), 0x1b);
+    __m128i abef = _mm_alignr_epi8 (dcba, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16 (efgh, dcba, 0xf0);
+
+    for (; numBlocks > 0; --numBlocks, data += 64)
+    {
+        const __m128i previousABEF = abef, previousCDGH = cdgh;
+        __m128i w[4];
+
+        // Each step does four rounds, and extends the message schedule by four words
+        for (int i = 0; i < 16; ++i)
+        {
+            if (i < 4)
+                w[i] = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) (data + 16 * i)), byteSwapMask);
+            else
+                w[i & 3] = _mm_sha256msg2_epu32 (_mm_add_epi32 (_mm_sha256msg1_epu32 (w[i & 3], w[(i + 1) & 3]),
+                                                                _mm_alignr_epi8 (w[(i + 3) & 3], w[(i + 2) & 3], 4)),
+                                                 w[(i + 3) & 3]);
+
+            const __m128i message = _mm_add_epi32 (w[i & 3], _mm_loadu_si128 ((const __m128i*) (sha256Constants + 4 * i)));
+            cdgh = _mm_sha256rnds2_epu32 (cdgh, abef, message);
+            abef = _mm_sha256rnds2_epu32 (abef, cdgh, _mm_shuffle_epi32 (message, 0x0e));
+        }
+
+        abef = _mm_add_epi32 (abef, previousABEF);
+        cdgh = _mm_add_epi32 (cdgh, previousCDGH);
+    }
+
+    const __m128i feba = _mm_shuffle_epi32 (abef, 0x1b);
+    const __m128i dchg = _mm_shuffle_epi32 (cdgh, 0xb1);
+    _mm_storeu_si128 ((__m128i*) state,       _mm_blend_epi16 (feba, dchg, 0xf0));
+    _mm_storeu_si128 ((__m128i*) (state + 4), _mm_alignr_epi8 (dchg, feba, 8));
+}
+
+#elif JUCE_SHA256_USE_ARM_INSTRUCTIONS
+
+static void processSHA256BlocksWithARMInstructions (uint32* const state, const uint8* data, size_t numBlocks) noexcept
+{
+    uint32x4_t abcd = vld1q_u32 (state);
+    uint32x4_t efgh = vld1q_u32 (state + 4);
+
+    for (; numBlocks > 0; --numBlocks, data += 64)
+    {
+        const uint32x4_t previousABCD = abcd, previousEFGH = efgh;
+        uint32x4_t w[4];
+
+        for (int i = 0; i < 16; ++i)
+        {
+            if (i < 4)
+                w[i] = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 16 * i)));
+            else
+                w[i & 3] = vsha256su1q_u32 (vsha256su0q_u32 (w[i & 3], w[(i + 1) & 3]), w[(i + 2) & 3], w[(i + 3) & 3]);
+
+            const uint32x4_t message = vaddq_u32 (w[i & 3], vld1q_u32 (sha256Constants + 4 * i));
+            const uint32x4_t oldABCD = abcd;
+            abcd = vsha256hq_u32  (abcd, efgh, message);
+            efgh = vsha256h2q_u32 (efgh, oldABCD, message);
+        }
+
+        abcd = vaddq_u32 (abcd, previousABCD);
+        efgh = vaddq_u32 (efgh, previousEFGH);
+    }
+
+    vst1q_u32 (state, abcd);
+    vst1q_u32 (state + 4, efgh);
+}
+
+#endif
+
+//==============================================================================
 class SHA256Processor
 {
 public:
     SHA256Processor() noexcept
-        : length (0)
+    {
+        reset();
+    }
+
+    void reset() noexcept
     {
         state[0] = 0x6a09e667;
         state[1] = 0xbb67ae85;
@@ -36,77 +159,58 @@ public:
         state[5] = 0x9b05688c;
         state[6] = 0x1f83d9ab;
         state[7] = 0x5be0cd19;
+
+        length = 0;
+        bufferPos = 0;
     }
 
-    // expects 64 bytes of data
-    void processFullBlock (const void* const data) noexcept
+    void processData (const void* data, size_t numBytes) noexcept
     {
-        const uint32 constants[] =
-        {
-            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-        };
-
-        uint32 block[16], s[8];
-        memcpy (s, state, sizeof (s));
-
-        for (int i = 0; i < 16; ++i)
-            block[i] = ByteOrder::bigEndianInt (addBytesToPointer (data, i * 4));
+        const uint8* d = static_cast<const uint8*> (data);
+        length += numBytes;
 
-        for (uint32 j = 0; j < 64; j += 16)
+        if (bufferPos > 0)
         {
-            #define JUCE_SHA256(i) \
-                s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + constants[i + j] \
-                                     + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15])) \
-                                               : block[i]); \
-                s[(3 - i) & 7] += s[(7 - i) & 7]; \
-                s[(7 - i) & 7] += S0 (s[(0 - i) & 7]) + maj (s[(0 - i) & 7], s[(1 - i) & 7], s[(2 - i) & 7])
+            const size_t numToCopy = jmin (numBytes, (size_t) 64 - bufferPos);
+            memcpy (buffer + bufferPos, d, numToCopy);
+            bufferPos += numToCopy;
+            d += numToCopy;
+            numBytes -= numToCopy;
 
-            JUCE_SHA256(0);  JUCE_SHA256(1);  JUCE_SHA256(2);  JUCE_SHA256(3);  JUCE_SHA256(4);  JUCE_SHA256(5);  JUCE_SHA256(6);  JUCE_SHA256(7);
-            JUCE_SHA256(8);  JUCE_SHA256(9);  JUCE_SHA256(10); JUCE_SHA256(11); JUCE_SHA256(12); JUCE_SHA256(13); JUCE_SHA256(14); JUCE_SHA256(15);
-            #undef JUCE_SHA256
+            if (bufferPos < 64)
+                return;
+
+            processBlocks (buffer, 1);
+            bufferPos = 0;
         }
 
-        for (int i = 0; i < 8; ++i)
-            state[i] += s[i];
+        const size_t numBlocks = numBytes / 64;
+        processBlocks (d, numBlocks);
+        d += numBlocks * 64;
 
-        length += 64;
+        bufferPos = numBytes - numBlocks * 64;
+        memcpy (buffer, d, bufferPos);
     }
 
-    void processFinalBlock (const void* const data, unsigned int numBytes) noexcept
+    void finish (uint8* result) noexcept
     {
-        jassert (numBytes < 64);
-
-        length += numBytes;
-        length *= 8; // (the length is stored as a count of bits, not bytes)
+        const uint64 numBits = length * 8;
 
         uint8 finalBlocks[128];
+        size_t numBytes = bufferPos;
 
-        memcpy (finalBlocks, data, numBytes);
+        memcpy (finalBlocks, buffer, numBytes);
         finalBlocks [numBytes++] = 128; // append a '1' bit
 
         while (numBytes != 56 && numBytes < 64 + 56)
             finalBlocks [numBytes++] = 0; // pad with zeros..
 
         for (int i = 8; --i >= 0;)
-            finalBlocks [numBytes++] = (uint8) (length >> (i * 8)); // append the length.
+            finalBlocks [numBytes++] = (uint8) (numBits >> (i * 8)); // append the length.
 
         jassert (numBytes == 64 || numBytes == 128);
+        processBlocks (finalBlocks, numBytes / 64);
 
-        processFullBlock (finalBlocks);
-
-        if (numBytes > 64)
-            processFullBlock (finalBlocks + 64);
-    }
-
-    void copyResult (uint8* result) const noexcept
-    {
         for (int i = 0; i < 8; ++i)
         {
             *result++ = (uint8) (state[i] >> 24);
@@ -121,27 +225,75 @@ public:
         if (numBytesToRead < 0)
             numBytesToRead = std::numeric_limits<int64>::max();
 
-        for (;;)
+        HeapBlock<uint8> tempBuffer (readBufferSize);
+
+        while (numBytesToRead > 0)
         {
-            uint8 buffer [64];
-            const int bytesRead = input.read (buffer, (int) jmin (numBytesToRead, (int64) sizeof (buffer)));
+            const int bytesRead = input.read (tempBuffer, (int) jmin (numBytesToRead, (int64) readBufferSize));
 
-            if (bytesRead < (int) sizeof (buffer))
-            {
-                processFinalBlock (buffer, (unsigned int) bytesRead);
+            if (bytesRead <= 0)
                 break;
-            }
 
-            numBytesToRead -= sizeof (buffer);
-            processFullBlock (buffer);
+            numBytesToRead -= bytesRead;
+            processData (tempBuffer, (size_t) bytesRead);
         }
 
-        copyResult (result);
+        finish (result);
     }
 
 private:
     uint32 state[8];
     uint64 length;
+    uint8 buffer[64];
+    size_t bufferPos;
+
+    enum { readBufferSize = 65536 };
+
+    void processBlocks (const uint8* data, size_t numBlocks) noexcept
+    {
+       #if JUCE_SHA256_USE_X86_INSTRUCTIONS
+        static const bool useSHAInstructions = cpuHasSHAInstructions();
+
+        if (useSHAInstructions)
+        {
+            processSHA256BlocksWithX86Instructions (state, data, numBlocks);
+            return;
+        }
+       #elif JUCE_SHA256_USE_ARM_INSTRUCTIONS
+        processSHA256BlocksWithARMInstructions (state, data, numBlocks);
+        return;
+       #endif
+
+        for (; numBlocks > 0; --numBlocks, data += 64)
+            processFullBlock (data);
+    }
+
+    // expects 64 bytes of data
+    void processFullBlock (const void* const data) noexcept
+    {
+        uint32 block[16], s[8];
+        memcpy (s, state, sizeof (s));
+
+        for (int i = 0; i < 16; ++i)
+            block[i] = ByteOrder::bigEndianInt (addBytesToPointer (data, i * 4));
+
+        for (uint32 j = 0; j < 64; j += 16)
+        {
+            #define JUCE_SHA256(i) \
+                s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + sha256Constants[i + j] \
+                                     + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15])) \
+                                               : block[i]); \
+                s[(3 - i) & 7] += s[(7 - i) & 7]; \
+                s[(7 - i) & 7] += S0 (s[(0 - i) & 7]) + maj (s[(0 - i) & 7], s[(1 - i) & 7], s[(2 - i) & 7])
+
+            JUCE_SHA256(0);  JUCE_SHA256(1);  JUCE_SHA256(2);  JUCE_SHA256(3);  JUCE_SHA256(4);  JUCE_SHA256(5);  JUCE_SHA256(6);  JUCE_SHA256(7);
+            JUCE_SHA256(8);  JUCE_SHA256(9);  JUCE_SHA256(10); JUCE_SHA256(11); JUCE_SHA256(12); JUCE_SHA256(13); JUCE_SHA256(14); JUCE_SHA256(15);
+            #undef JUCE_SHA256
+        }
+
+        for (int i = 0; i < 8; ++i)
+            state[i] += s[i];
+    }
 
     static inline uint32 rotate (const uint32 x, const uint32 y) noexcept                { return (x >> y) | (x << (32 - y)); }
     static inline uint32 ch  (const uint32 x, const uint32 y, const uint32 z) noexcept   { return z ^ ((y ^ z) & x); }
@@ -213,9 +365,99 @@ SHA256::SHA256 (CharPointer_UTF8 utf8) noexcept
 
 void SHA256::process (const void* const data, size_t numBytes)
 {
-    MemoryInputStream m (data, numBytes, false);
     SHA256Processor processor;
-    processor.processStream (m, -1, result);
+    processor.processData (data, numBytes);
+    processor.finish (result);
+}
+
+//==============================================================================
+Array<SHA256> SHA256::hashFiles (const Array<File>& files, int numThreads)
+{
+    Array<SHA256> hashes;
+    hashes.insertMultiple (0, SHA256(), files.size());
+
+    if (numThreads <= 0)
+        numThreads = SystemStats::getNumCpus();
+
+    numThreads = jmin (numThreads, files.size());
+
+    if (numThreads <= 1)
+    {
+        for (int i = 0; i < files.size(); ++i)
+            hashes.getReference (i) = SHA256 (files.getReference (i));
+
+        return hashes;
+    }
+
+    // Each job keeps taking the next file from the list until they've all been done, so
+    // a few big files don't leave the other threads idle.
+    struct HashingJob  : public ThreadPoolJob
+    {
+        HashingJob (const Array<File>& f, Array<SHA256>& h, Atomic<int>& next)
+            : ThreadPoolJob ("SHA256"), files (f), hashes (h), nextIndex (next)
+        {
+        }
+
+        JobStatus runJob() override
+        {
+            for (;;)
+            {
+                const int index = ++nextIndex - 1;
+
+                if (index >= files.size() || shouldExit())
+                    return jobHasFinished;
+
+                hashes.getReference (index) = SHA256 (files.getReference (index));
+            }
+        }
+
+        const Array<File>& files;
+        Array<SHA256>& hashes;
+        Atomic<int>& nextIndex;
+    };
+
+    Atomic<int> nextIndex;
+    OwnedArray<HashingJob> jobs;
+    ThreadPool pool (numThreads);
+
+    for (int i = 0; i < numThreads; ++i)
+        pool.addJob (jobs.add (new HashingJob (files, hashes, nextIndex)), false);
+
+    for (int i = 0; i < jobs.size(); ++i)
+        pool.waitForJobToFinish (jobs.getUnchecked (i), -1);
+
+    return hashes;
+}
+
+//==============================================================================
+struct SHA256::Builder::Pimpl  : public SHA256Processor
+{
+};
+
+SHA256::Builder::Builder()  : pimpl (new Pimpl()) {}
+SHA256::Builder::~Builder() {}
+
+void SHA256::Builder::update (const void* data, size_t numBytes) noexcept
+{
+    pimpl->processData (data, numBytes);
+}
+
+void SHA256::Builder::update (const MemoryBlock& data) noexcept
+{
+    pimpl->processData (data.getData(), data.getSize());
+}
+
+SHA256 SHA256::Builder::finish() noexcept
+{
+    SHA256 hash;
+    pimpl->finish (hash.result);
+    pimpl->reset();
+    return hash;
+}
+
+void SHA256::Builder::reset() noexcept
+{
+    pimpl->reset();
 }
 
 MemoryBlock SHA256::getRawData() const
@@ -258,6 +500,15 @@ public:
             SHA256 hash (m);
             expectEquals (hash.toHexString(), String (expected));
         }
+
+        {
+            SHA256::Builder builder;
+
+            for (const char* c = input; *c != 0; ++c)
+                builder.update (c, 1);
+
+            expectEquals (builder.finish().toHexString(), String (expected));
+        }
     }
 
     void runTest()
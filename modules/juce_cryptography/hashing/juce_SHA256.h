@@ -31,10 +31,14 @@
     SHA-256 secure hash generator.
 
     Create one of these objects from a block of source data or a stream, and it
-    calculates the SHA-256 hash of that data.
+    calculates the SHA-256 hash of that data. If the data arrives in pieces, use a
+    SHA256::Builder instead.
+
+    Where the CPU has its own SHA-256 instructions (the x86 SHA extensions or the
+    ARMv8 crypto extensions), these are used automatically.
 
     You can retrieve the hash as a raw 32-byte block, or as a 64-digit hex string.
-    @see MD5
+    @see MD5, XXHash64
 */
 class JUCE_API  SHA256
 {
@@ -83,6 +87,63 @@ public:
     */
     explicit SHA256 (CharPointer_UTF8 utf8Text) noexcept;
 
+    //==============================================================================
+    /** Hashes a set of files, using several threads to read and hash them at the same time.
+
+        The array that's returned contains one hash for each file, in the same order. A file
+        that can't be opened gets an uninitialised hash, as with the SHA256 (const File&)
+        constructor.
+
+        @param files        the files to hash
+        @param numThreads   the number of threads to use - if this is 0 or less, it'll use
+                            one per CPU core
+    */
+    static Array<SHA256> hashFiles (const Array<File>& files, int numThreads = 0);
+
+    //==============================================================================
+    /**
+        Calculates a SHA-256 hash from data that's supplied in a series of blocks.
+
+        Call update() with each block of data in turn, and then finish() to get the hash,
+        e.g.
+        @code
+        SHA256::Builder builder;
+        builder.update (header.getData(), header.getSize());
+        builder.update (body.getData(), body.getSize());
+        SHA256 hash (builder.finish());
+        @endcode
+    */
+    class JUCE_API  Builder
+    {
+    public:
+        /** Creates a Builder that's ready to receive some data. */
+        Builder();
+
+        /** Destructor. */
+        ~Builder();
+
+        /** Adds some more data to the hash. */
+        void update (const void* data, size_t numBytes) noexcept;
+
+        /** Adds the contents of a MemoryBlock to the hash. */
+        void update (const MemoryBlock& data) noexcept;
+
+        /** Returns the hash of all the data that has been added, and then resets
+            the builder so that it can be used for another hash.
+        */
+        SHA256 finish() noexcept;
+
+        /** Discards any data that has been added. */
+        void reset() noexcept;
+
+    private:
+        struct Pimpl;
+        friend struct ContainerDeletePolicy<Pimpl>;
+        ScopedPointer<Pimpl> pimpl;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Builder)
+    };
+
     //==============================================================================
     /** Returns the hash as a 32-byte block of data. */
     MemoryBlock getRawData() const;
@@ -24,8 +24,15 @@
 
 struct WhirlpoolProcessor
 {
-    WhirlpoolProcessor() noexcept   : bufferBits (0), bufferPos (0)
+    WhirlpoolProcessor() noexcept
     {
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        bufferBits = 0;
+        bufferPos = 0;
         zeromem (bitLength, sizeof (bitLength));
         zeromem (buffer, sizeof (buffer));
         zeromem (hash, sizeof (hash));
@@ -57,7 +64,20 @@ struct WhirlpoolProcessor
     int bufferBits, bufferPos;
     uint64 hash[8];
 
-private:
+    void addData (const void* data, size_t numBytes) noexcept
+    {
+        const uint8* d = static_cast<const uint8*> (data);
+
+        // (add() takes a count of bits as an int, so big blocks have to be split up)
+        while (numBytes > 0)
+        {
+            const size_t numToAdd = jmin (numBytes, (size_t) 65536);
+            add (d, (int) numToAdd * 8);
+            d += numToAdd;
+            numBytes -= numToAdd;
+        }
+    }
+
     void add (const uint8* const source, int numBits) noexcept
     {
         int sourcePos = 0;                        // index of leftmost source uint8 containing data (1 to 8 bits)
@@ -167,6 +187,7 @@ private:
         }
     }
 
+private:
     void processNextBuffer() noexcept
     {
         #undef X
@@ -536,7 +557,6 @@ private:
         hash[7] ^= state[7] ^ block[7];
     }
 
-private:
     JUCE_DECLARE_NON_COPYABLE (WhirlpoolProcessor)
 };
 
@@ -599,9 +619,40 @@ Whirlpool::Whirlpool (CharPointer_UTF8 utf8) noexcept
 
 void Whirlpool::process (const void* const data, size_t numBytes)
 {
-    MemoryInputStream m (data, numBytes, false);
     WhirlpoolProcessor processor;
-    processor.processStream (m, -1, result);
+    processor.addData (data, numBytes);
+    processor.finalize (result);
+}
+
+//==============================================================================
+struct Whirlpool::Builder::Pimpl  : public WhirlpoolProcessor
+{
+};
+
+Whirlpool::Builder::Builder()  : pimpl (new Pimpl()) {}
+Whirlpool::Builder::~Builder() {}
+
+void Whirlpool::Builder::update (const void* data, size_t numBytes) noexcept
+{
+    pimpl->addData (data, numBytes);
+}
+
+void Whirlpool::Builder::update (const MemoryBlock& data) noexcept
+{
+    pimpl->addData (data.getData(), data.getSize());
+}
+
+Whirlpool Whirlpool::Builder::finish() noexcept
+{
+    Whirlpool w;
+    pimpl->finalize (w.result);
+    pimpl->reset();
+    return w;
+}
+
+void Whirlpool::Builder::reset() noexcept
+{
+    pimpl->reset();
 }
 
 MemoryBlock Whirlpool::getRawData() const
@@ -89,6 +89,50 @@ public:
     */
     explicit Whirlpool (CharPointer_UTF8 utf8Text) noexcept;
 
+    //==============================================================================
+    /**
+        Calculates a Whirlpool hash from data that's supplied in a series of blocks.
+
+        Call update() with each block of data in turn, and then finish() to get the result,
+        e.g.
+        @code
+        Whirlpool::Builder builder;
+        builder.update (header.getData(), header.getSize());
+        builder.update (body.getData(), body.getSize());
+        Whirlpool result (builder.finish());
+        @endcode
+    */
+    class JUCE_API  Builder
+    {
+    public:
+        /** Creates a Builder that's ready to receive some data. */
+        Builder();
+
+        /** Destructor. */
+        ~Builder();
+
+        /** Adds some more data. */
+        void update (const void* data, size_t numBytes) noexcept;
+
+        /** Adds the contents of a MemoryBlock. */
+        void update (const MemoryBlock& data) noexcept;
+
+        /** Returns the result for all the data that has been added, and then resets
+            the builder so that it can be used again.
+        */
+        Whirlpool finish() noexcept;
+
+        /** Discards any data that has been added. */
+        void reset() noexcept;
+
+    private:
+        struct Pimpl;
+        friend struct ContainerDeletePolicy<Pimpl>;
+        ScopedPointer<Pimpl> pimpl;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Builder)
+    };
+
     //==============================================================================
     /** Returns the hash as a 64-byte block of data. */
     MemoryBlock getRawData() const;
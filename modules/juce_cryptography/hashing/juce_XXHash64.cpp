@@ -0,0 +1,248 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+namespace XXHash64Helpers
+{
+    static const uint64 prime1 = 11400714785074694791ULL;
+    static const uint64 prime2 = 14029467366897019727ULL;
+    static const uint64 prime3 = 1609587929392839161ULL;
+    static const uint64 prime4 = 9650029242287828579ULL;
+    static const uint64 prime5 = 2870177450012600261ULL;
+
+    static inline uint64 rotateLeft (const uint64 x, const int bits) noexcept
+    {
+        return (x << bits) | (x >> (64 - bits));
+    }
+
+    static inline uint64 round (uint64 accumulator, const uint64 input) noexcept
+    {
+        accumulator += input * prime2;
+        return rotateLeft (accumulator, 31) * prime1;
+    }
+
+    static inline uint64 mergeRound (uint64 hash, const uint64 accumulator) noexcept
+    {
+        hash ^= round (0, accumulator);
+        return hash * prime1 + prime4;
+    }
+
+    // Consumes as many whole 32-byte stripes as possible, and returns the number of bytes used
+    static size_t processStripes (uint64* const accumulators, const uint8* const data, const size_t numBytes) noexcept
+    {
+        uint64 v1 = accumulators[0], v2 = accumulators[1], v3 = accumulators[2], v4 = accumulators[3];
+        size_t i = 0;
+
+        for (; i + 32 <= numBytes; i += 32)
+        {
+            v1 = round (v1, ByteOrder::littleEndianInt64 (data + i));
+            v2 = round (v2, ByteOrder::littleEndianInt64 (data + i + 8));
+            v3 = round (v3, ByteOrder::littleEndianInt64 (data + i + 16));
+            v4 = round (v4, ByteOrder::littleEndianInt64 (data + i + 24));
+        }
+
+        accumulators[0] = v1;
+        accumulators[1] = v2;
+        accumulators[2] = v3;
+        accumulators[3] = v4;
+        return i;
+    }
+}
+
+//==============================================================================
+XXHash64::XXHash64 (const uint64 s) noexcept
+{
+    reset (s);
+}
+
+XXHash64::~XXHash64() noexcept {}
+
+void XXHash64::reset (const uint64 newSeed) noexcept
+{
+    using namespace XXHash64Helpers;
+
+    seed = newSeed;
+    accumulators[0] = seed + prime1 + prime2;
+    accumulators[1] = seed + prime2;
+    accumulators[2] = seed;
+    accumulators[3] = seed - prime1;
+    totalLength = 0;
+    bufferSize = 0;
+}
+
+void XXHash64::update (const void* const data, size_t numBytes) noexcept
+{
+    const uint8* d = static_cast<const uint8*> (data);
+    totalLength += numBytes;
+
+    if (bufferSize > 0)
+    {
+        const size_t numToCopy = jmin (numBytes, sizeof (buffer) - bufferSize);
+        memcpy (buffer + bufferSize, d, numToCopy);
+        bufferSize += numToCopy;
+        d += numToCopy;
+        numBytes -= numToCopy;
+
+        if (bufferSize < sizeof (buffer))
+            return;
+
+        XXHash64Helpers::processStripes (accumulators, buffer, sizeof (buffer));
+        bufferSize = 0;
+    }
+
+    const size_t numUsed = XXHash64Helpers::processStripes (accumulators, d, numBytes);
+    bufferSize = numBytes - numUsed;
+    memcpy (buffer, d + numUsed, bufferSize);
+}
+
+void XXHash64::update (const MemoryBlock& data) noexcept
+{
+    update (data.getData(), data.getSize());
+}
+
+uint64 XXHash64::getHash() const noexcept
+{
+    using namespace XXHash64Helpers;
+
+    uint64 hash;
+
+    if (totalLength >= 32)
+    {
+        hash = rotateLeft (accumulators[0], 1)  + rotateLeft (accumulators[1], 7)
+             + rotateLeft (accumulators[2], 12) + rotateLeft (accumulators[3], 18);
+
+        for (int i = 0; i < 4; ++i)
+            hash = mergeRound (hash, accumulators[i]);
+    }
+    else
+    {
+        hash = seed + prime5;
+    }
+
+    hash += totalLength;
+
+    const uint8* p = buffer;
+    const uint8* const end = buffer + bufferSize;
+
+    for (; p + 8 <= end; p += 8)
+        hash = rotateLeft (hash ^ round (0, ByteOrder::littleEndianInt64 (p)), 27) * prime1 + prime4;
+
+    if (p + 4 <= end)
+    {
+        hash = rotateLeft (hash ^ (ByteOrder::littleEndianInt (p) * prime1), 23) * prime2 + prime3;
+        p += 4;
+    }
+
+    for (; p < end; ++p)
+        hash = rotateLeft (hash ^ (*p * prime5), 11) * prime1;
+
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+//==============================================================================
+uint64 XXHash64::calculate (const void* const data, const size_t numBytes, const uint64 seed) noexcept
+{
+    XXHash64 hash (seed);
+    hash.update (data, numBytes);
+    return hash.getHash();
+}
+
+uint64 XXHash64::calculate (const MemoryBlock& data, const uint64 seed) noexcept
+{
+    return calculate (data.getData(), data.getSize(), seed);
+}
+
+uint64 XXHash64::calculate (InputStream& input, int64 numBytesToRead, const uint64 seed)
+{
+    if (numBytesToRead < 0)
+        numBytesToRead = std::numeric_limits<int64>::max();
+
+    XXHash64 hash (seed);
+    const int bufferSize = 65536;
+    HeapBlock<uint8> tempBuffer ((size_t) bufferSize);
+
+    while (numBytesToRead > 0)
+    {
+        const int bytesRead = input.read (tempBuffer, (int) jmin (numBytesToRead, (int64) bufferSize));
+
+        if (bytesRead <= 0)
+            break;
+
+        numBytesToRead -= bytesRead;
+        hash.update (tempBuffer, (size_t) bytesRead);
+    }
+
+    return hash.getHash();
+}
+
+uint64 XXHash64::calculate (const File& file, const uint64 seed)
+{
+    FileInputStream fin (file);
+
+    if (fin.getStatus().wasOk())
+        return calculate (fin, -1, seed);
+
+    return 0;
+}
+
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class XXHash64Tests  : public UnitTest
+{
+public:
+    XXHash64Tests() : UnitTest ("XXHash64") {}
+
+    void test (const char* input, uint64 expected)
+    {
+        const size_t length = strlen (input);
+        expectEquals ((int64) XXHash64::calculate (input, length), (int64) expected);
+
+        XXHash64 hash;
+
+        for (size_t i = 0; i < length; ++i)
+            hash.update (input + i, 1);
+
+        expectEquals ((int64) hash.getHash(), (int64) expected);
+    }
+
+    void runTest()
+    {
+        beginTest ("XXHash64");
+
+        test ("", 0xef46db3751d8e999ULL);
+        test ("abc", 0x44bc2cf5ad770999ULL);
+        test ("Nobody inspects the spammish repetition", 0xfbcea83c8a378bf1ULL);
+    }
+};
+
+static XXHash64Tests xxHash64UnitTests;
+
+#endif
@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_XXHASH64_H_INCLUDED
+#define JUCE_XXHASH64_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Calculates 64-bit hashes with the xxHash64 algorithm.
+
+    This is many times faster than a cryptographic hash like SHA256, so it's a good
+    choice for things like cache keys or checking whether some data has changed. But
+    it's not secure: it's easy to create data that has a particular hash, so don't
+    use it where someone might do that deliberately.
+
+    You can either use one of the static calculate() methods, or create an XXHash64
+    object and call update() with each block of data in turn, e.g.
+    @code
+    XXHash64 hash;
+    hash.update (header.getData(), header.getSize());
+    hash.update (body.getData(), body.getSize());
+    uint64 key = hash.getHash();
+    @endcode
+
+    The results are the same as those of the reference xxHash implementation.
+
+    @see SHA256, MD5
+*/
+class JUCE_API  XXHash64
+{
+public:
+    //==============================================================================
+    /** Creates an XXHash64 that's ready to receive some data.
+        Different seeds give unrelated hashes for the same data.
+    */
+    explicit XXHash64 (uint64 seed = 0) noexcept;
+
+    /** Destructor. */
+    ~XXHash64() noexcept;
+
+    //==============================================================================
+    /** Adds some more data to the hash. */
+    void update (const void* data, size_t numBytes) noexcept;
+
+    /** Adds the contents of a MemoryBlock to the hash. */
+    void update (const MemoryBlock& data) noexcept;
+
+    /** Returns the hash of all the data that has been added so far.
+        This doesn't change the object, so you can carry on adding more data afterwards.
+    */
+    uint64 getHash() const noexcept;
+
+    /** Discards any data that has been added, and starts again with a new seed. */
+    void reset (uint64 seed = 0) noexcept;
+
+    //==============================================================================
+    /** Returns the hash of a block of data. */
+    static uint64 calculate (const void* data, size_t numBytes, uint64 seed = 0) noexcept;
+
+    /** Returns the hash of a block of data. */
+    static uint64 calculate (const MemoryBlock& data, uint64 seed = 0) noexcept;
+
+    /** Returns the hash of the contents of a stream.
+
+        This will read from the stream until the stream is exhausted, or until
+        maxBytesToRead bytes have been read. If maxBytesToRead is negative, the entire
+        stream will be read.
+    */
+    static uint64 calculate (InputStream& input, int64 maxBytesToRead = -1, uint64 seed = 0);
+
+    /** Returns the hash of a file's contents, or 0 if the file can't be opened. */
+    static uint64 calculate (const File& file, uint64 seed = 0);
+
+private:
+    //==============================================================================
+    uint64 accumulators[4], seed, totalLength;
+    uint8 buffer[32];
+    size_t bufferSize;
+
+    JUCE_LEAK_DETECTOR (XXHash64)
+};
+
+
+#endif   // JUCE_XXHASH64_H_INCLUDED
@@ -37,14 +37,55 @@
 
 #include "juce_cryptography.h"
 
+//==============================================================================
+// SHA-256 and AES use the CPU's own instructions for them when they're available
+#if JUCE_INTEL && (JUCE_CLANG || (JUCE_MSVC && _MSC_VER >= 1900) \
+                    || (JUCE_GCC && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+ #define JUCE_CRYPTOGRAPHY_X86_INTRINSICS_AVAILABLE 1
+#endif
+
+#if ! defined (JUCE_SHA256_USE_X86_INSTRUCTIONS) && JUCE_CRYPTOGRAPHY_X86_INTRINSICS_AVAILABLE
+ #define JUCE_SHA256_USE_X86_INSTRUCTIONS 1
+#endif
+
+#if ! defined (JUCE_AES_USE_X86_INSTRUCTIONS) && JUCE_CRYPTOGRAPHY_X86_INTRINSICS_AVAILABLE
+ #define JUCE_AES_USE_X86_INSTRUCTIONS 1
+#endif
+
+#if ! defined (JUCE_SHA256_USE_ARM_INSTRUCTIONS) && JUCE_ARM \
+     && (defined (__ARM_FEATURE_CRYPTO) || defined (__ARM_FEATURE_SHA2))
+ #define JUCE_SHA256_USE_ARM_INSTRUCTIONS 1
+#endif
+
+#if ! defined (JUCE_AES_USE_ARM_INSTRUCTIONS) && JUCE_ARM \
+     && (defined (__ARM_FEATURE_CRYPTO) || defined (__ARM_FEATURE_AES))
+ #define JUCE_AES_USE_ARM_INSTRUCTIONS 1
+#endif
+
+#if JUCE_SHA256_USE_X86_INSTRUCTIONS || JUCE_AES_USE_X86_INSTRUCTIONS
+ #include <immintrin.h>
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <cpuid.h>
+ #endif
+#endif
+
+#if JUCE_SHA256_USE_ARM_INSTRUCTIONS || JUCE_AES_USE_ARM_INSTRUCTIONS
+ #include <arm_neon.h>
+#endif
+
 namespace juce
 {
 
+#include "encryption/juce_AESGCM.cpp"
+#include "encryption/juce_AESGCMStreams.cpp"
 #include "encryption/juce_BlowFish.cpp"
 #include "encryption/juce_Primes.cpp"
 #include "encryption/juce_RSAKey.cpp"
 #include "hashing/juce_MD5.cpp"
 #include "hashing/juce_SHA256.cpp"
 #include "hashing/juce_Whirlpool.cpp"
+#include "hashing/juce_XXHash64.cpp"
 
 }
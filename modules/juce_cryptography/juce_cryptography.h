@@ -31,12 +31,15 @@
 namespace juce
 {
 
+#include "encryption/juce_AESGCM.h"
+#include "encryption/juce_AESGCMStreams.h"
 #include "encryption/juce_BlowFish.h"
 #include "encryption/juce_Primes.h"
 #include "encryption/juce_RSAKey.h"
 #include "hashing/juce_MD5.h"
 #include "hashing/juce_SHA256.h"
 #include "hashing/juce_Whirlpool.h"
+#include "hashing/juce_XXHash64.h"
 
 }
 
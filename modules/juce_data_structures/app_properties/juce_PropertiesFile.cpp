@@ -40,7 +40,8 @@ PropertiesFile::Options::Options()
       doNotSave (false),
       millisecondsBeforeSaving (3000),
       storageFormat (PropertiesFile::storeAsXML),
-      processLock (nullptr)
+      processLock (nullptr),
+      saveOnBackgroundThread (false)
 {
 }
 
@@ -103,6 +104,82 @@ File PropertiesFile::Options::getDefaultFile() const
 }
 
 
+//==============================================================================
+class PropertiesFile::BackgroundWriter  : private TimeSliceClient
+{
+public:
+    BackgroundWriter (const File& f, InterProcessLock* l)
+        : file (f), processLock (l), hasPendingData (false)
+    {
+    }
+
+    ~BackgroundWriter()
+    {
+        flush();
+    }
+
+    void write (MemoryBlock& newData)
+    {
+        {
+            const ScopedLock sl (lock);
+            pendingData.swapWith (newData);
+            hasPendingData = true;
+        }
+
+        thread->addTimeSliceClient (this);
+    }
+
+    void flush()
+    {
+        // (this waits for any write that's already in progress on the background thread)
+        thread->removeTimeSliceClient (this);
+        writePendingData();
+    }
+
+private:
+    struct WriterThread  : public TimeSliceThread
+    {
+        WriterThread()  : TimeSliceThread ("PropertiesFile writer")   { startThread (3); }
+        ~WriterThread()                                                 { stopThread (10000); }
+    };
+
+    SharedResourcePointer<WriterThread> thread;
+    const File file;
+    InterProcessLock* const processLock;
+    CriticalSection lock;
+    MemoryBlock pendingData;
+    bool hasPendingData;
+
+    void writePendingData()
+    {
+        MemoryBlock data;
+
+        {
+            const ScopedLock sl (lock);
+
+            if (! hasPendingData)
+                return;
+
+            data.swapWith (pendingData);
+            hasPendingData = false;
+        }
+
+        PropertiesFile::writeToFile (file, processLock, data.getData(), data.getSize());
+    }
+
+    int useTimeSlice() override
+    {
+        writePendingData();
+
+        // (the client stays registered while idle, because removing itself here could race
+        // with a new write() - calling addTimeSliceClient() again just brings the next call forward)
+        const ScopedLock sl (lock);
+        return hasPendingData ? 0 : 10000;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (BackgroundWriter)
+};
+
 //==============================================================================
 PropertiesFile::PropertiesFile (const File& f, const Options& o)
     : PropertySet (o.ignoreCaseOfKeyNames),
@@ -122,6 +199,9 @@ PropertiesFile::PropertiesFile (const Options& o)
 
 bool PropertiesFile::reload()
 {
+    if (backgroundWriter != nullptr)
+        backgroundWriter->flush();
+
     ProcessScopedLock pl (createProcessLock());
 
     if (pl != nullptr && ! pl->isLocked())
@@ -134,6 +214,7 @@ bool PropertiesFile::reload()
 PropertiesFile::~PropertiesFile()
 {
     saveIfNeeded();
+    backgroundWriter = nullptr;
 }
 
 InterProcessLock::ScopedLockType* PropertiesFile::createProcessLock() const
@@ -171,10 +252,60 @@ bool PropertiesFile::save()
          || ! file.getParentDirectory().createDirectory())
         return false;
 
+    MemoryOutputStream data;
+    writeContents (data);
+
+    if (options.saveOnBackgroundThread)
+    {
+        if (backgroundWriter == nullptr)
+            backgroundWriter = new BackgroundWriter (file, options.processLock);
+
+        MemoryBlock block (data.getData(), data.getDataSize());
+        backgroundWriter->write (block);
+        needsWriting = false;
+        return true;
+    }
+
+    if (writeToFile (file, options.processLock, data.getData(), data.getDataSize()))
+    {
+        needsWriting = false;
+        return true;
+    }
+
+    return false;
+}
+
+void PropertiesFile::writeContents (OutputStream& out)
+{
     if (options.storageFormat == storeAsXML)
-        return saveAsXml();
+        writeContentsAsXml (out);
+    else
+        writeContentsAsBinary (out);
+}
 
-    return saveAsBinary();
+bool PropertiesFile::writeToFile (const File& file, InterProcessLock* processLock,
+                                  const void* data, size_t size)
+{
+    ProcessScopedLock pl (processLock != nullptr ? new InterProcessLock::ScopedLockType (*processLock) : nullptr);
+
+    if (pl != nullptr && ! pl->isLocked())
+        return false; // locking failure..
+
+    TemporaryFile tempFile (file);
+
+    {
+        ScopedPointer<FileOutputStream> out (tempFile.getFile().createOutputStream());
+
+        if (out == nullptr || ! out->write (data, size))
+            return false;
+
+        out->flush();
+
+        if (out->getStatus().failed())
+            return false;
+    }
+
+    return tempFile.overwriteTargetFileWithTemporary();
 }
 
 bool PropertiesFile::loadAsXml()
@@ -213,7 +344,7 @@ bool PropertiesFile::loadAsXml()
     return false;
 }
 
-bool PropertiesFile::saveAsXml()
+void PropertiesFile::writeContentsAsXml (OutputStream& out)
 {
     XmlElement doc (PropertyFileConstants::fileTag);
     const StringPairArray& props = getAllProperties();
@@ -230,18 +361,7 @@ bool PropertiesFile::saveAsXml()
             e->setAttribute (PropertyFileConstants::valueAttribute, props.getAllValues() [i]);
     }
 
-    ProcessScopedLock pl (createProcessLock());
-
-    if (pl != nullptr && ! pl->isLocked())
-        return false; // locking failure..
-
-    if (doc.writeToFile (file, String()))
-    {
-        needsWriting = false;
-        return true;
-    }
-
-    return false;
+    doc.writeToStream (out, String());
 }
 
 bool PropertiesFile::loadAsBinary()
@@ -285,56 +405,37 @@ bool PropertiesFile::loadAsBinary (InputStream& input)
     return true;
 }
 
-bool PropertiesFile::saveAsBinary()
+void PropertiesFile::writeContentsAsBinary (OutputStream& output)
 {
-    ProcessScopedLock pl (createProcessLock());
+    OutputStream* out = &output;
+    ScopedPointer<GZIPCompressorOutputStream> gzip;
 
-    if (pl != nullptr && ! pl->isLocked())
-        return false; // locking failure..
-
-    TemporaryFile tempFile (file);
-    ScopedPointer<OutputStream> out (tempFile.getFile().createOutputStream());
-
-    if (out != nullptr)
+    if (options.storageFormat == storeAsCompressedBinary)
     {
-        if (options.storageFormat == storeAsCompressedBinary)
-        {
-            out->writeInt (PropertyFileConstants::magicNumberCompressed);
-            out->flush();
-
-            out = new GZIPCompressorOutputStream (out.release(), 9, true);
-        }
-        else
-        {
-            // have you set up the storage option flags correctly?
-            jassert (options.storageFormat == storeAsBinary);
-
-            out->writeInt (PropertyFileConstants::magicNumber);
-        }
-
-        const StringPairArray& props = getAllProperties();
-        const int numProperties   = props.size();
-        const StringArray& keys   = props.getAllKeys();
-        const StringArray& values = props.getAllValues();
+        output.writeInt (PropertyFileConstants::magicNumberCompressed);
+        gzip = new GZIPCompressorOutputStream (&output, 9, false);
+        out = gzip;
+    }
+    else
+    {
+        // have you set up the storage option flags correctly?
+        jassert (options.storageFormat == storeAsBinary);
 
-        out->writeInt (numProperties);
+        output.writeInt (PropertyFileConstants::magicNumber);
+    }
 
-        for (int i = 0; i < numProperties; ++i)
-        {
-            out->writeString (keys[i]);
-            out->writeString (values[i]);
-        }
+    const StringPairArray& props = getAllProperties();
+    const int numProperties   = props.size();
+    const StringArray& keys   = props.getAllKeys();
+    const StringArray& values = props.getAllValues();
 
-        out = nullptr;
+    out->writeInt (numProperties);
 
-        if (tempFile.overwriteTargetFileWithTemporary())
-        {
-            needsWriting = false;
-            return true;
-        }
+    for (int i = 0; i < numProperties; ++i)
+    {
+        out->writeString (keys[i]);
+        out->writeString (values[i]);
     }
-
-    return false;
 }
 
 void PropertiesFile::timerCallback()
@@ -135,6 +135,19 @@ public:
         */
         InterProcessLock* processLock;
 
+        /** If true, the file is written to disk on a shared background thread rather than by
+            the thread that calls save().
+
+            The properties are still serialised synchronously when the file is saved, but the
+            (possibly slow) business of writing the data and atomically renaming it over the old
+            file is done later. If several saves happen before the background thread gets round
+            to writing, only the most recent data is written. Any pending write is completed
+            before the PropertiesFile is deleted or reloaded.
+
+            The default constructor initialises this value to false.
+        */
+        bool saveOnBackgroundThread;
+
         /** This can be called to suggest a file that should be used, based on the values
             in this structure.
 
@@ -196,7 +209,9 @@ public:
         anything has changed since the last save.
 
         Returns false if it fails to write to the file for some reason (maybe because
-        it's read-only or the directory doesn't exist or something).
+        it's read-only or the directory doesn't exist or something). If the
+        Options::saveOnBackgroundThread flag is set, the data is only queued for writing, so
+        a successful return doesn't guarantee that the file has been written yet.
 
         @see saveIfNeeded
     */
@@ -231,12 +246,18 @@ private:
     Options options;
     bool loadedOk, needsWriting;
 
+    class BackgroundWriter;
+    friend class BackgroundWriter;
+    ScopedPointer<BackgroundWriter> backgroundWriter;
+
     typedef const ScopedPointer<InterProcessLock::ScopedLockType> ProcessScopedLock;
     InterProcessLock::ScopedLockType* createProcessLock() const;
 
     void timerCallback() override;
-    bool saveAsXml();
-    bool saveAsBinary();
+    void writeContents (OutputStream&);
+    void writeContentsAsXml (OutputStream&);
+    void writeContentsAsBinary (OutputStream&);
+    static bool writeToFile (const File&, InterProcessLock*, const void* data, size_t size);
     bool loadAsXml();
     bool loadAsBinary();
     bool loadAsBinary (InputStream&);
@@ -132,14 +132,11 @@ bool UndoManager::perform (UndoableAction* const newAction)
 
             if (actionSet != nullptr && ! newTransaction)
             {
-                if (UndoableAction* const lastAction = actionSet->actions.getLast())
+                if (coalesceWithEarlierAction (*actionSet, action))
                 {
-                    if (UndoableAction* const coalescedAction = lastAction->createCoalescedAction (action))
-                    {
-                        action = coalescedAction;
-                        totalUnitsStored -= lastAction->getSizeInUnits();
-                        actionSet->actions.removeLast();
-                    }
+                    clearFutureTransactions();
+                    sendChangeMessage();
+                    return true;
                 }
             }
             else
@@ -162,6 +159,31 @@ bool UndoManager::perform (UndoableAction* const newAction)
     return false;
 }
 
+bool UndoManager::coalesceWithEarlierAction (ActionSet& actionSet, UndoableAction* const newAction)
+{
+    // (this limit stops a transaction full of unrelated actions from making each
+    // new action search through all the earlier ones)
+    const int maxActionsToSearch = 32;
+    const int numActions = actionSet.actions.size();
+
+    for (int i = numActions; --i >= jmax (0, numActions - maxActionsToSearch);)
+    {
+        UndoableAction* const earlierAction = actionSet.actions.getUnchecked (i);
+
+        if (UndoableAction* const coalescedAction = earlierAction->createCoalescedAction (newAction))
+        {
+            totalUnitsStored += coalescedAction->getSizeInUnits() - earlierAction->getSizeInUnits();
+            actionSet.actions.set (i, coalescedAction);
+            return true;
+        }
+
+        if (! newAction->isIndependentOf (earlierAction))
+            break;
+    }
+
+    return false;
+}
+
 void UndoManager::clearFutureTransactions()
 {
     while (nextIndex < transactions.size())
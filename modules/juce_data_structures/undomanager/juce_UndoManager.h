@@ -41,6 +41,13 @@
     together - all actions performed between calls to beginNewTransaction() are
     grouped together and are all undone/redone as a group.
 
+    Within a transaction, each new action is coalesced with an earlier one where
+    possible (see UndoableAction::createCoalescedAction() and
+    UndoableAction::isIndependentOf()), so repeatedly changing the same ValueTree
+    property only stores one action. The actions that ValueTree creates report their
+    sizes in bytes, so when they're all you're storing, the limit that you give the
+    UndoManager is a limit on the memory its history uses.
+
     The UndoManager is a ChangeBroadcaster, so listeners can register to be told
     when actions are performed or undone.
 
@@ -231,6 +238,7 @@ private:
     ActionSet* getCurrentSet() const noexcept;
     ActionSet* getNextSet() const noexcept;
     void clearFutureTransactions();
+    bool coalesceWithEarlierAction (ActionSet&, UndoableAction*);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (UndoManager)
 };
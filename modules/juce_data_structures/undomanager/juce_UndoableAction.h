@@ -93,6 +93,20 @@ public:
         If it's not possible to merge the two actions, the method should return zero.
     */
     virtual UndoableAction* createCoalescedAction (UndoableAction* nextAction)  { (void) nextAction; return nullptr; }
+
+    /** Returns true if this action and the one supplied change unrelated things, so
+        that doing them in either order would have the same result.
+
+        When an action can't be coalesced with the one before it, the UndoManager looks
+        further back through the current transaction for one that it can be coalesced with,
+        but only as long as the new action is independent of all the actions it skips over.
+        So if a transaction sets two properties alternately, each property ends up with a
+        single action.
+
+        The default implementation returns false, which means that only consecutive
+        actions will be coalesced.
+    */
+    virtual bool isIndependentOf (UndoableAction* otherAction)  { (void) otherAction; return false; }
 };
 
 
@@ -28,13 +28,14 @@ public:
     typedef ReferenceCountedObjectPtr<SharedObject> Ptr;
 
     explicit SharedObject (Identifier t) noexcept
-        : type (t), parent (nullptr)
+        : type (t), parent (nullptr), activeBatch (nullptr), pendingChanges (nullptr)
     {
     }
 
     SharedObject (const SharedObject& other)
         : ReferenceCountedObject(),
-          type (other.type), properties (other.properties), parent (nullptr)
+          type (other.type), properties (other.properties), parent (nullptr),
+          activeBatch (nullptr), pendingChanges (nullptr)
     {
         for (int i = 0; i < other.children.size(); ++i)
         {
@@ -126,7 +127,33 @@ public:
         }
     }
 
+    ScopedNotificationBatch* findActiveBatch() const noexcept
+    {
+        for (const SharedObject* t = this; t != nullptr; t = t->parent)
+            if (t->activeBatch != nullptr)
+                return t->activeBatch;
+
+        return nullptr;
+    }
+
+    void invalidateSnapshots()
+    {
+        // (if a node has no snapshot, its parents can't have one either)
+        for (SharedObject* t = this; t != nullptr && t->snapshot.isValid(); t = t->parent)
+            t->snapshot = ValueTreeSnapshot();
+    }
+
     void sendPropertyChangeMessage (const Identifier property)
+    {
+        invalidateSnapshots();
+
+        if (ScopedNotificationBatch* const batch = findActiveBatch())
+            batch->addPendingChange (*this, property);
+        else
+            callPropertyChangeListeners (property);
+    }
+
+    void callPropertyChangeListeners (const Identifier property)
     {
         ValueTree tree (this);
 
@@ -134,8 +161,16 @@ public:
             t->callListeners (&ValueTree::Listener::valueTreePropertyChanged, tree, property);
     }
 
+    void deliverBatchedChanges()
+    {
+        if (ScopedNotificationBatch* const batch = findActiveBatch())
+            batch->deliverPendingChanges();
+    }
+
     void sendChildAddedMessage (ValueTree child)
     {
+        invalidateSnapshots();
+        deliverBatchedChanges();
         ValueTree tree (this);
 
         for (ValueTree::SharedObject* t = this; t != nullptr; t = t->parent)
@@ -144,6 +179,8 @@ public:
 
     void sendChildRemovedMessage (ValueTree child, int index)
     {
+        invalidateSnapshots();
+        deliverBatchedChanges();
         ValueTree tree (this);
 
         for (ValueTree::SharedObject* t = this; t != nullptr; t = t->parent)
@@ -152,6 +189,8 @@ public:
 
     void sendChildOrderChangedMessage (int oldIndex, int newIndex)
     {
+        invalidateSnapshots();
+        deliverBatchedChanges();
         ValueTree tree (this);
 
         for (ValueTree::SharedObject* t = this; t != nullptr; t = t->parent)
@@ -440,6 +479,80 @@ public:
             writeObjectToStream (output, children.getObjectPointerUnchecked(i));
     }
 
+    // These are used to work out how much memory the undoable actions are keeping hold of.
+    static int getHeapSizeInBytes (const var& v)
+    {
+        if (v.isString())
+            return (int) (sizeof (pointer_sized_int) * 2 + v.toString().getNumBytesAsUTF8() + 1);
+
+        if (const MemoryBlock* const mb = v.getBinaryData())
+            return (int) (sizeof (MemoryBlock) + mb->getSize());
+
+        if (const Array<var>* const array = v.getArray())
+        {
+            int total = (int) (sizeof (ReferenceCountedObject) + sizeof (Array<var>));
+
+            for (int i = 0; i < array->size(); ++i)
+                total += (int) sizeof (var) + getHeapSizeInBytes (array->getReference (i));
+
+            return total;
+        }
+
+        return 0;
+    }
+
+    int64 getSizeInBytes() const
+    {
+        int64 total = (int64) sizeof (*this);
+
+        for (int i = 0; i < properties.size(); ++i)
+            total += (int64) (sizeof (Identifier) + sizeof (var)) + getHeapSizeInBytes (properties.getValueAt (i));
+
+        for (int i = 0; i < children.size(); ++i)
+            total += (int64) sizeof (SharedObject*) + children.getObjectPointerUnchecked (i)->getSizeInBytes();
+
+        return total;
+    }
+
+    void addIdentifiersTo (NamedValueSet& identifiers) const
+    {
+        if (! identifiers.contains (type))
+            identifiers.set (type, identifiers.size());
+
+        for (int i = 0; i < properties.size(); ++i)
+        {
+            const Identifier name (properties.getName (i));
+
+            if (! identifiers.contains (name))
+                identifiers.set (name, identifiers.size());
+        }
+
+        for (int i = 0; i < children.size(); ++i)
+            children.getObjectPointerUnchecked(i)->addIdentifiersTo (identifiers);
+    }
+
+    void writeToIndexedStream (OutputStream& output, const NamedValueSet& identifiers) const
+    {
+        // Each node is preceded by its size, so that a reader can skip over it
+        MemoryOutputStream data;
+        data.writeCompressedInt (identifiers [type]);
+        data.writeCompressedInt (properties.size());
+
+        for (int j = 0; j < properties.size(); ++j)
+        {
+            data.writeCompressedInt (identifiers [properties.getName (j)]);
+            properties.getValueAt(j).writeToStream (data);
+        }
+
+        data.writeCompressedInt (children.size());
+
+        for (int i = 0; i < children.size(); ++i)
+            children.getObjectPointerUnchecked(i)->writeToIndexedStream (data, identifiers);
+
+        output.writeCompressedInt ((int) data.getDataSize());
+        output << data;
+    }
+
     static void writeObjectToStream (OutputStream& output, const SharedObject* const object)
     {
         if (object != nullptr)
@@ -461,7 +574,8 @@ public:
         SetPropertyAction (SharedObject* const so, const Identifier propertyName,
                            const var& newVal, const var& oldVal, bool isAdding, bool isDeleting)
             : target (so), name (propertyName), newValue (newVal), oldValue (oldVal),
-              isAddingNewProperty (isAdding), isDeletingProperty (isDeleting)
+              isAddingNewProperty (isAdding), isDeletingProperty (isDeleting),
+              sizeInBytes ((int) sizeof (*this) + getHeapSizeInBytes (newVal) + getHeapSizeInBytes (oldVal))
         {
         }
 
@@ -489,7 +603,7 @@ public:
 
         int getSizeInUnits()
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            return sizeInBytes;
         }
 
         UndoableAction* createCoalescedAction (UndoableAction* nextAction)
@@ -505,12 +619,22 @@ public:
             return nullptr;
         }
 
+        bool isIndependentOf (UndoableAction* otherAction)
+        {
+            // (changes to other properties, or to other objects, don't affect this one)
+            if (SetPropertyAction* const other = dynamic_cast<SetPropertyAction*> (otherAction))
+                return other->target != target || other->name != name;
+
+            return false;
+        }
+
     private:
         const Ptr target;
         const Identifier name;
         const var newValue;
         var oldValue;
         const bool isAddingNewProperty : 1, isDeletingProperty : 1;
+        const int sizeInBytes;
 
         JUCE_DECLARE_NON_COPYABLE (SetPropertyAction)
     };
@@ -523,7 +647,9 @@ public:
             : target (parentObject),
               child (newChild != nullptr ? newChild : parentObject->children.getObjectPointer (index)),
               childIndex (index),
-              isDeleting (newChild == nullptr)
+              isDeleting (newChild == nullptr),
+              sizeInBytes ((int) jmin ((int64) std::numeric_limits<int>::max() / 2,
+                                       (int64) sizeof (*this) + (child != nullptr ? child->getSizeInBytes() : 0)))
         {
             jassert (child != nullptr);
         }
@@ -557,13 +683,15 @@ public:
 
         int getSizeInUnits()
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            // (this includes the child tree, as the action can end up being its only owner)
+            return sizeInBytes;
         }
 
     private:
         const Ptr target, child;
         const int childIndex;
         const bool isDeleting;
+        const int sizeInBytes;
 
         JUCE_DECLARE_NON_COPYABLE (AddOrRemoveChildAction)
     };
@@ -591,7 +719,7 @@ public:
 
         int getSizeInUnits()
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            return (int) sizeof (*this);
         }
 
         UndoableAction* createCoalescedAction (UndoableAction* nextAction)
@@ -616,12 +744,72 @@ public:
     ReferenceCountedArray<SharedObject> children;
     SortedSet<ValueTree*> valueTreesWithListeners;
     SharedObject* parent;
+    ScopedNotificationBatch* activeBatch;
+    ScopedNotificationBatch::PendingChanges* pendingChanges;
+    ValueTreeSnapshot snapshot;
 
 private:
     SharedObject& operator= (const SharedObject&);
     JUCE_LEAK_DETECTOR (SharedObject)
 };
 
+//==============================================================================
+struct ValueTree::ScopedNotificationBatch::PendingChanges
+{
+    PendingChanges (SharedObject& o)  : object (&o) {}
+
+    const SharedObject::Ptr object;
+    NamedValueSet properties; // (used as an ordered set of the property names)
+};
+
+ValueTree::ScopedNotificationBatch::ScopedNotificationBatch (const ValueTree& tree)
+{
+    if (tree.object != nullptr && tree.object->findActiveBatch() == nullptr)
+    {
+        object = tree.object;
+        object->activeBatch = this;
+    }
+}
+
+ValueTree::ScopedNotificationBatch::~ScopedNotificationBatch()
+{
+    if (object != nullptr)
+    {
+        object->activeBatch = nullptr;
+        deliverPendingChanges();
+    }
+}
+
+void ValueTree::ScopedNotificationBatch::addPendingChange (SharedObject& changed, const Identifier& property)
+{
+    if (changed.pendingChanges == nullptr)
+        changed.pendingChanges = pending.add (new PendingChanges (changed));
+
+    changed.pendingChanges->properties.set (property, var());
+}
+
+void ValueTree::ScopedNotificationBatch::deliverPendingChanges()
+{
+    // A listener may change more properties while it's being called, and if the batch
+    // is still active, those changes get added to a new list.
+    while (pending.size() > 0)
+    {
+        OwnedArray<PendingChanges> changes;
+        changes.swapWith (pending);
+
+        for (int i = 0; i < changes.size(); ++i)
+            changes.getUnchecked(i)->object->pendingChanges = nullptr;
+
+        for (int i = 0; i < changes.size(); ++i)
+        {
+            const PendingChanges& p = *changes.getUnchecked(i);
+
+            for (int j = 0; j < p.properties.size(); ++j)
+                p.object->callPropertyChangeListeners (p.properties.getName (j));
+        }
+    }
+}
+
 //==============================================================================
 ValueTree::ValueTree() noexcept
 {
@@ -983,13 +1171,75 @@ void ValueTree::writeToStream (OutputStream& output) const
     SharedObject::writeObjectToStream (output, object);
 }
 
+namespace ValueTreeIndexedFormat
+{
+    // An indexed stream starts with these bytes. 0xff can never begin a UTF-8 type name,
+    // so ValueTree::readFromStream() can tell this format from the original one.
+    static const uint8 magic[] = { 0xff, 'V', 'T', 2 };
+
+    static bool skipVar (MemoryInputStream& input)
+    {
+        // (var::writeToStream() always starts with the number of bytes that follow)
+        const int numBytes = input.readCompressedInt();
+
+        if (numBytes < 0 || numBytes > input.getNumBytesRemaining())
+            return false;
+
+        input.skipNextBytes (numBytes);
+        return true;
+    }
+}
+
+void ValueTree::writeToIndexedStream (OutputStream& output) const
+{
+    if (object == nullptr)
+    {
+        writeToStream (output);
+        return;
+    }
+
+    NamedValueSet identifiers;
+    object->addIdentifiersTo (identifiers);
+
+    MemoryOutputStream body;
+    body.writeCompressedInt (identifiers.size());
+
+    for (int i = 0; i < identifiers.size(); ++i)
+        body.writeString (identifiers.getName (i).toString());
+
+    object->writeToIndexedStream (body, identifiers);
+
+    output.write (ValueTreeIndexedFormat::magic, sizeof (ValueTreeIndexedFormat::magic));
+    output.writeCompressedInt ((int) body.getDataSize());
+    output << body;
+}
+
 ValueTree ValueTree::readFromStream (InputStream& input)
 {
-    const String type (input.readString());
+    const char firstByte = input.readByte();
 
-    if (type.isEmpty())
+    if (firstByte == 0)
         return ValueTree();
 
+    if ((uint8) firstByte == ValueTreeIndexedFormat::magic[0])
+        return ValueTreeReader::readFromStream (input);
+
+    // (we've already read the first character of the type name)
+    MemoryOutputStream typeName;
+    typeName.writeByte (firstByte);
+
+    for (;;)
+    {
+        const char c = input.readByte();
+
+        if (c == 0)
+            break;
+
+        typeName.writeByte (c);
+    }
+
+    const String type (typeName.toUTF8());
+
     ValueTree v (type);
 
     const int numProps = input.readCompressedInt();
@@ -37,7 +37,8 @@
     Create ValueTree objects on the stack, and don't be afraid to copy them around, as
     they're simply a lightweight reference to a shared data container. Creating a copy
     of another ValueTree simply creates a new reference to the same underlying object - to
-    make a separate, deep copy of a tree you should explicitly call createCopy().
+    make a separate, deep copy of a tree you should explicitly call createCopy(). If you
+    only need to read the copy, a ValueTreeSnapshot is much cheaper to create.
 
     Each ValueTree has a type name, in much the same way as an XmlElement has a tag name,
     and much of the structure of a ValueTree is similar to an XmlElement tree.
@@ -121,7 +122,9 @@ public:
     */
     bool isValid() const                            { return object != nullptr; }
 
-    /** Returns a deep copy of this tree and all its sub-nodes. */
+    /** Returns a deep copy of this tree and all its sub-nodes.
+        @see ValueTreeSnapshot
+    */
     ValueTree createCopy() const;
 
     //==============================================================================
@@ -348,10 +351,28 @@ public:
     */
     void writeToStream (OutputStream& output) const;
 
-    /** Reloads a tree from a stream that was written with writeToStream(). */
+    /** Stores this tree (and all its children) in an indexed binary format.
+
+        This format starts with a table of all the type and property names used in the
+        tree, and the nodes then refer to names by their index in it. Each node also
+        starts with its size. So the data is usually smaller than writeToStream()'s,
+        it's quicker to load because each name is only converted to an Identifier once,
+        and a ValueTreeReader can open it without loading the whole tree.
+
+        The data can be read back with readFromStream(), readFromData() or ValueTreeReader.
+
+        @see ValueTreeReader
+    */
+    void writeToIndexedStream (OutputStream& output) const;
+
+    /** Reloads a tree from a stream that was written with writeToStream() or
+        writeToIndexedStream().
+    */
     static ValueTree readFromStream (InputStream& input);
 
-    /** Reloads a tree from a data block that was written with writeToStream(). */
+    /** Reloads a tree from a data block that was written with writeToStream() or
+        writeToIndexedStream().
+    */
     static ValueTree readFromData (const void* data, size_t numBytes);
 
     /** Reloads a tree from a data block that was written with writeToStream() and
@@ -455,6 +476,11 @@ public:
     */
     void sendPropertyChangeMessage (const Identifier property);
 
+    /** Holds back property-change callbacks for a tree while it exists.
+        @see ValueTree::ScopedNotificationBatch
+    */
+    class ScopedNotificationBatch;
+
     //==============================================================================
     /** This method uses a comparator object to sort the tree's children into order.
 
@@ -504,6 +530,8 @@ private:
     //==============================================================================
     JUCE_PUBLIC_IN_DLL_BUILD (class SharedObject)
     friend class SharedObject;
+    friend class ValueTreeSnapshot;
+    friend class ValueTreeReader;
 
     ReferenceCountedObjectPtr<SharedObject> object;
     ListenerList<Listener> listeners;
@@ -529,5 +557,57 @@ private:
     explicit ValueTree (SharedObject*);
 };
 
+//==============================================================================
+/**
+    While one of these exists, the valueTreePropertyChanged() callbacks for changes made
+    to a tree (or to any of its sub-trees) are held back, and then delivered when the
+    batch is deleted.
+
+    The changes themselves still happen immediately, so the tree can be read as normal
+    while the batch is active. Only the callbacks are deferred, and each property that
+    changed gets just one callback, however many times it was set. This makes bulk
+    edits such as loading a preset much cheaper for trees with listeners attached.
+
+    @code
+    {
+        ValueTree::ScopedNotificationBatch batch (myTree);
+
+        for (int i = 0; i < numParams; ++i)
+            myTree.setProperty (paramIDs[i], values[i], nullptr);
+
+    }   // <- listeners are told about the changes here
+    @endcode
+
+    Callbacks for children being added, removed or moved aren't deferred. Before one of
+    those is sent, any property-change callbacks that are being held back are delivered,
+    so that listeners still see the events in the order in which they happened.
+
+    Batches can be nested. A batch that's created while an outer batch is already active
+    for the same tree (or for one of its parents) does nothing, and the outer batch
+    delivers all the changes when it ends.
+*/
+class JUCE_API  ValueTree::ScopedNotificationBatch
+{
+public:
+    /** Starts holding back property-change callbacks for the given tree. */
+    explicit ScopedNotificationBatch (const ValueTree& tree);
+
+    /** Delivers any property-change callbacks that were held back. */
+    ~ScopedNotificationBatch();
+
+private:
+    struct PendingChanges;
+    friend class SharedObject;
+    friend struct ContainerDeletePolicy<PendingChanges>;
+
+    ReferenceCountedObjectPtr<SharedObject> object;
+    OwnedArray<PendingChanges> pending;
+
+    void addPendingChange (SharedObject&, const Identifier&);
+    void deliverPendingChanges();
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedNotificationBatch)
+};
+
 
 #endif   // JUCE_VALUETREE_H_INCLUDED
@@ -0,0 +1,394 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+//==============================================================================
+struct ValueTreeReader::Node::SharedData  : public ReferenceCountedObject
+{
+    SharedData() noexcept : body (nullptr), bodySize (0) {}
+
+    ScopedPointer<MemoryMappedFile> file;
+    const char* body;
+    size_t bodySize;
+    Array<Identifier> identifiers;
+
+    bool getIdentifier (MemoryInputStream& input, Identifier& result) const
+    {
+        const int index = input.readCompressedInt();
+
+        if (! isPositiveAndBelow (index, identifiers.size()))
+            return false;
+
+        result = identifiers.getReference (index);
+        return true;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (SharedData)
+};
+
+//==============================================================================
+ValueTreeReader::ValueTreeReader (const File& file)
+{
+    ScopedPointer<MemoryMappedFile> mappedFile (new MemoryMappedFile (file, MemoryMappedFile::readOnly));
+
+    if (mappedFile->getData() != nullptr)
+    {
+        open (mappedFile->getData(), mappedFile->getSize());
+
+        if (root.data != nullptr)
+            root.data->file = mappedFile;
+    }
+}
+
+ValueTreeReader::ValueTreeReader (const void* data, size_t numBytes)
+{
+    open (data, numBytes);
+}
+
+ValueTreeReader::~ValueTreeReader() {}
+
+bool ValueTreeReader::isValid() const noexcept
+{
+    return root.isValid();
+}
+
+ValueTreeReader::Node ValueTreeReader::getRoot() const
+{
+    return root;
+}
+
+void ValueTreeReader::open (const void* const data, const size_t numBytes)
+{
+    using namespace ValueTreeIndexedFormat;
+
+    if (data == nullptr || numBytes <= sizeof (magic) || memcmp (data, magic, sizeof (magic)) != 0)
+        return;
+
+    MemoryInputStream input (data, numBytes, false);
+    input.skipNextBytes (sizeof (magic));
+
+    const int bodySize = input.readCompressedInt();
+
+    if (bodySize <= 0 || bodySize > input.getNumBytesRemaining())
+        return;
+
+    ReferenceCountedObjectPtr<Node::SharedData> shared (new Node::SharedData());
+    shared->body = static_cast<const char*> (data) + input.getPosition();
+    shared->bodySize = (size_t) bodySize;
+
+    MemoryInputStream body (shared->body, shared->bodySize, false);
+    const int numIdentifiers = body.readCompressedInt();
+
+    if (numIdentifiers < 0 || numIdentifiers > body.getNumBytesRemaining())
+        return;
+
+    shared->identifiers.ensureStorageAllocated (numIdentifiers);
+
+    for (int i = 0; i < numIdentifiers; ++i)
+    {
+        const String name (body.readString());
+
+        if (name.isEmpty())
+            return;
+
+        shared->identifiers.add (Identifier (name));
+    }
+
+    const int rootSize = body.readCompressedInt();
+
+    if (rootSize > 0 && rootSize <= body.getNumBytesRemaining())
+        root = Node (shared, (size_t) body.getPosition(), (size_t) rootSize);
+}
+
+//==============================================================================
+ValueTreeReader::Node::Node() noexcept : start (0), size (0) {}
+ValueTreeReader::Node::Node (SharedData* d, size_t s, size_t sz) noexcept : data (d), start (s), size (sz) {}
+ValueTreeReader::Node::Node (const Node& other) noexcept : data (other.data), start (other.start), size (other.size) {}
+ValueTreeReader::Node::~Node() {}
+
+ValueTreeReader::Node& ValueTreeReader::Node::operator= (const Node& other) noexcept
+{
+    data = other.data;
+    start = other.start;
+    size = other.size;
+    return *this;
+}
+
+bool ValueTreeReader::Node::isValid() const noexcept
+{
+    return data != nullptr;
+}
+
+Identifier ValueTreeReader::Node::getType() const
+{
+    Identifier type;
+
+    if (data != nullptr)
+    {
+        MemoryInputStream input (data->body + start, size, false);
+        data->getIdentifier (input, type);
+    }
+
+    return type;
+}
+
+int ValueTreeReader::Node::getNumProperties() const
+{
+    if (data == nullptr)
+        return 0;
+
+    MemoryInputStream input (data->body + start, size, false);
+    input.readCompressedInt();
+    return jmax (0, input.readCompressedInt());
+}
+
+Identifier ValueTreeReader::Node::getPropertyName (const int index) const
+{
+    Identifier name;
+
+    if (data != nullptr)
+    {
+        MemoryInputStream input (data->body + start, size, false);
+        input.readCompressedInt();
+        const int numProperties = input.readCompressedInt();
+
+        if (isPositiveAndBelow (index, numProperties))
+        {
+            for (int i = 0; i < index; ++i)
+                if (! (data->getIdentifier (input, name) && ValueTreeIndexedFormat::skipVar (input)))
+                    return Identifier();
+
+            if (! data->getIdentifier (input, name))
+                return Identifier();
+        }
+    }
+
+    return name;
+}
+
+var ValueTreeReader::Node::getProperty (const Identifier name) const
+{
+    if (data != nullptr)
+    {
+        MemoryInputStream input (data->body + start, size, false);
+        input.readCompressedInt();
+
+        for (int i = input.readCompressedInt(); --i >= 0;)
+        {
+            Identifier propertyName;
+
+            if (! data->getIdentifier (input, propertyName))
+                break;
+
+            if (propertyName == name)
+                return var::readFromStream (input);
+
+            if (! ValueTreeIndexedFormat::skipVar (input))
+                break;
+        }
+    }
+
+    return var();
+}
+
+bool ValueTreeReader::Node::findChildren (MemoryInputStream& input, int& numChildren) const
+{
+    Identifier name;
+
+    if (! data->getIdentifier (input, name))
+        return false;
+
+    for (int i = input.readCompressedInt(); --i >= 0;)
+        if (! (data->getIdentifier (input, name) && ValueTreeIndexedFormat::skipVar (input)))
+            return false;
+
+    numChildren = input.readCompressedInt();
+    return numChildren >= 0;
+}
+
+int ValueTreeReader::Node::getNumChildren() const
+{
+    int numChildren = 0;
+
+    if (data != nullptr)
+    {
+        MemoryInputStream input (data->body + start, size, false);
+
+        if (! findChildren (input, numChildren))
+            return 0;
+    }
+
+    return numChildren;
+}
+
+ValueTreeReader::Node ValueTreeReader::Node::getChild (const int index) const
+{
+    if (data != nullptr)
+    {
+        MemoryInputStream input (data->body + start, size, false);
+        int numChildren;
+
+        if (findChildren (input, numChildren) && isPositiveAndBelow (index, numChildren))
+        {
+            for (int i = 0;; ++i)
+            {
+                const int childSize = input.readCompressedInt();
+
+                if (childSize <= 0 || childSize > input.getNumBytesRemaining())
+                    break;
+
+                if (i == index)
+                    return Node (data, start + (size_t) input.getPosition(), (size_t) childSize);
+
+                input.skipNextBytes (childSize);
+            }
+        }
+    }
+
+    return Node();
+}
+
+ValueTreeReader::Node ValueTreeReader::Node::getChildWithName (const Identifier type) const
+{
+    if (data != nullptr)
+    {
+        MemoryInputStream input (data->body + start, size, false);
+        int numChildren;
+
+        if (findChildren (input, numChildren))
+        {
+            for (int i = 0; i < numChildren; ++i)
+            {
+                const int childSize = input.readCompressedInt();
+
+                if (childSize <= 0 || childSize > input.getNumBytesRemaining())
+                    break;
+
+                const Node child (data, start + (size_t) input.getPosition(), (size_t) childSize);
+
+                if (child.getType() == type)
+                    return child;
+
+                input.skipNextBytes (childSize);
+            }
+        }
+    }
+
+    return Node();
+}
+
+ValueTree ValueTreeReader::Node::createValueTree() const
+{
+    return ValueTreeReader::createValueTree (*this);
+}
+
+//==============================================================================
+ValueTree ValueTreeReader::createValueTree (const Node& node)
+{
+    if (node.data == nullptr)
+        return ValueTree();
+
+    const Node::SharedData& data = *node.data;
+    MemoryInputStream input (data.body + node.start, node.size, false);
+
+    Identifier type;
+
+    if (! data.getIdentifier (input, type))
+        return ValueTree();
+
+    ValueTree v (type);
+
+    for (int i = input.readCompressedInt(); --i >= 0;)
+    {
+        Identifier name;
+
+        if (! data.getIdentifier (input, name))
+        {
+            jassertfalse;  // trying to read corrupted data!
+            return v;
+        }
+
+        v.object->properties.set (name, var::readFromStream (input));
+    }
+
+    const int numChildren = input.readCompressedInt();
+
+    if (numChildren > 0)
+        v.object->children.ensureStorageAllocated (numChildren);
+
+    for (int i = 0; i < numChildren; ++i)
+    {
+        const int childSize = input.readCompressedInt();
+
+        if (childSize <= 0 || childSize > input.getNumBytesRemaining())
+        {
+            jassertfalse;  // trying to read corrupted data!
+            break;
+        }
+
+        ValueTree child (createValueTree (Node (node.data, node.start + (size_t) input.getPosition(), (size_t) childSize)));
+
+        if (child.object != nullptr)
+        {
+            v.object->children.add (child.object);
+            child.object->parent = v.object;
+        }
+
+        input.skipNextBytes (childSize);
+    }
+
+    return v;
+}
+
+ValueTree ValueTreeReader::readFromStream (InputStream& input)
+{
+    // This is called by ValueTree::readFromStream() after it has read the first byte
+    // of the magic number, and reads the rest of the indexed data into memory.
+    using namespace ValueTreeIndexedFormat;
+
+    MemoryOutputStream data;
+    data.writeByte ((char) magic[0]);
+
+    for (size_t i = 1; i < sizeof (magic); ++i)
+    {
+        const char c = input.readByte();
+
+        if ((uint8) c != magic[i])
+            return ValueTree();
+
+        data.writeByte (c);
+    }
+
+    const int bodySize = input.readCompressedInt();
+
+    if (bodySize <= 0)
+        return ValueTree();
+
+    data.writeCompressedInt (bodySize);
+
+    if (data.writeFromInputStream (input, bodySize) != bodySize)
+        return ValueTree();
+
+    const ValueTreeReader reader (data.getData(), data.getDataSize());
+    return reader.getRoot().createValueTree();
+}
@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_VALUETREEREADER_H_INCLUDED
+#define JUCE_VALUETREEREADER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Gives read-only access to a ValueTree that was saved with
+    ValueTree::writeToIndexedStream(), without loading the whole tree.
+
+    The indexed format stores each node's size before its data. That lets the reader
+    skip over sub-trees it doesn't need. Nothing is decoded until you ask for it:
+    a node's properties are only decoded when you read them, and its children only
+    when you step into them. When you need an editable copy of part of the tree, call
+    Node::createValueTree() on that part.
+
+    When reading from a file, the reader memory-maps it, so opening even a very
+    large file is quick, and only the parts that get read are loaded from disk.
+
+    @code
+    ValueTreeReader reader (sessionFile);
+
+    if (reader.isValid())
+    {
+        ValueTreeReader::Node tracks (reader.getRoot().getChildWithName ("TRACKS"));
+
+        for (int i = 0; i < tracks.getNumChildren(); ++i)
+            DBG (tracks.getChild (i).getProperty ("name").toString());
+    }
+    @endcode
+
+    @see ValueTree::writeToIndexedStream
+*/
+class JUCE_API  ValueTreeReader
+{
+public:
+    //==============================================================================
+    /** Memory-maps a file that was written with ValueTree::writeToIndexedStream(). */
+    explicit ValueTreeReader (const File& file);
+
+    /** Reads a block of data that was written with ValueTree::writeToIndexedStream().
+        The data isn't copied, so it must stay valid for as long as this reader, or any
+        of the nodes it returns, are in use.
+    */
+    ValueTreeReader (const void* data, size_t numBytes);
+
+    /** Destructor. */
+    ~ValueTreeReader();
+
+    /** Returns true if the data was opened and is in the indexed format. */
+    bool isValid() const noexcept;
+
+    //==============================================================================
+    /** A handle to one node of the tree being read.
+        Node objects are small and cheap to copy, and keep the reader's data alive.
+    */
+    class JUCE_API  Node
+    {
+    public:
+        /** Creates an invalid node. */
+        Node() noexcept;
+        Node (const Node&) noexcept;
+        Node& operator= (const Node&) noexcept;
+        ~Node();
+
+        /** Returns false if this node doesn't exist, or its data is corrupt. */
+        bool isValid() const noexcept;
+
+        /** Returns the node's type. */
+        Identifier getType() const;
+
+        /** Returns the number of properties the node has. */
+        int getNumProperties() const;
+
+        /** Returns the name of one of the node's properties. */
+        Identifier getPropertyName (int index) const;
+
+        /** Decodes and returns a property's value, or a void var if it isn't set. */
+        var getProperty (const Identifier name) const;
+
+        /** Returns the number of child nodes. */
+        int getNumChildren() const;
+
+        /** Returns one of the child nodes. This has to step over the children before it. */
+        Node getChild (int index) const;
+
+        /** Returns the first child node with the given type. */
+        Node getChildWithName (const Identifier type) const;
+
+        /** Decodes this node and everything below it into a new, editable ValueTree. */
+        ValueTree createValueTree() const;
+
+    private:
+        friend class ValueTreeReader;
+        struct SharedData;
+        ReferenceCountedObjectPtr<SharedData> data;
+        size_t start, size;
+
+        Node (SharedData*, size_t start, size_t size) noexcept;
+        bool findChildren (MemoryInputStream&, int& numChildren) const;
+    };
+
+    /** Returns the root node of the tree. */
+    Node getRoot() const;
+
+private:
+    //==============================================================================
+    friend class ValueTree;
+    Node root;
+
+    void open (const void* data, size_t numBytes);
+    static ValueTree createValueTree (const Node&);
+    static ValueTree readFromStream (InputStream&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueTreeReader)
+};
+
+
+#endif   // JUCE_VALUETREEREADER_H_INCLUDED
@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+struct ValueTreeSnapshot::Node  : public ReferenceCountedObject
+{
+    Node (const Identifier t, const NamedValueSet& p)  : type (t), properties (p) {}
+
+    // (nothing changes these after the node has been built)
+    const Identifier type;
+    const NamedValueSet properties;
+    ReferenceCountedArray<Node> children;
+
+    void writeToStream (OutputStream& output) const
+    {
+        output.writeString (type.toString());
+        output.writeCompressedInt (properties.size());
+
+        for (int j = 0; j < properties.size(); ++j)
+        {
+            output.writeString (properties.getName (j).toString());
+            properties.getValueAt (j).writeToStream (output);
+        }
+
+        output.writeCompressedInt (children.size());
+
+        for (int i = 0; i < children.size(); ++i)
+            children.getObjectPointerUnchecked (i)->writeToStream (output);
+    }
+
+    ValueTree createTree() const
+    {
+        ValueTree v (type);
+
+        for (int i = 0; i < properties.size(); ++i)
+            v.setProperty (properties.getName (i), properties.getValueAt (i), nullptr);
+
+        for (int i = 0; i < children.size(); ++i)
+            v.addChild (children.getObjectPointerUnchecked (i)->createTree(), -1, nullptr);
+
+        return v;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Node)
+};
+
+//==============================================================================
+ValueTreeSnapshot::ValueTreeSnapshot() noexcept {}
+ValueTreeSnapshot::ValueTreeSnapshot (Node* n) noexcept  : node (n) {}
+ValueTreeSnapshot::ValueTreeSnapshot (const ValueTreeSnapshot& other) noexcept  : node (other.node) {}
+ValueTreeSnapshot::~ValueTreeSnapshot() {}
+
+ValueTreeSnapshot::ValueTreeSnapshot (const ValueTree& tree)
+{
+    if (tree.object != nullptr)
+        node = getSnapshot (*tree.object).node;
+}
+
+ValueTreeSnapshot& ValueTreeSnapshot::operator= (const ValueTreeSnapshot& other) noexcept
+{
+    node = other.node;
+    return *this;
+}
+
+bool ValueTreeSnapshot::operator== (const ValueTreeSnapshot& other) const noexcept  { return node == other.node; }
+bool ValueTreeSnapshot::operator!= (const ValueTreeSnapshot& other) const noexcept  { return node != other.node; }
+
+ValueTreeSnapshot ValueTreeSnapshot::getSnapshot (ValueTree::SharedObject& object)
+{
+    // Each tree node keeps its latest snapshot until it, or one of its children, is
+    // changed, so only the changed parts of the tree need to be copied here.
+    if (! object.snapshot.isValid())
+    {
+        Node* const n = new Node (object.type, object.properties);
+        object.snapshot = ValueTreeSnapshot (n);
+
+        for (int i = 0; i < object.children.size(); ++i)
+            n->children.add (getSnapshot (*object.children.getObjectPointerUnchecked (i)).node);
+    }
+
+    return object.snapshot;
+}
+
+//==============================================================================
+Identifier ValueTreeSnapshot::getType() const noexcept
+{
+    return node != nullptr ? node->type : Identifier();
+}
+
+bool ValueTreeSnapshot::hasType (const Identifier typeName) const noexcept
+{
+    return node != nullptr && node->type == typeName;
+}
+
+int ValueTreeSnapshot::getNumProperties() const noexcept
+{
+    return node != nullptr ? node->properties.size() : 0;
+}
+
+Identifier ValueTreeSnapshot::getPropertyName (const int index) const noexcept
+{
+    return node != nullptr ? node->properties.getName (index) : Identifier();
+}
+
+const var& ValueTreeSnapshot::getProperty (const Identifier name) const noexcept
+{
+    return node != nullptr ? node->properties [name] : var::null;
+}
+
+var ValueTreeSnapshot::getProperty (const Identifier name, const var& defaultReturnValue) const
+{
+    return node != nullptr ? node->properties.getWithDefault (name, defaultReturnValue)
+                           : defaultReturnValue;
+}
+
+const var& ValueTreeSnapshot::operator[] (const Identifier name) const noexcept
+{
+    return getProperty (name);
+}
+
+bool ValueTreeSnapshot::hasProperty (const Identifier name) const noexcept
+{
+    return node != nullptr && node->properties.contains (name);
+}
+
+int ValueTreeSnapshot::getNumChildren() const noexcept
+{
+    return node != nullptr ? node->children.size() : 0;
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::getChild (const int index) const
+{
+    return ValueTreeSnapshot (node != nullptr ? node->children.getObjectPointer (index)
+                                              : static_cast<Node*> (nullptr));
+}
+
+ValueTreeSnapshot ValueTreeSnapshot::getChildWithName (const Identifier type) const
+{
+    if (node != nullptr)
+        for (int i = 0; i < node->children.size(); ++i)
+            if (node->children.getObjectPointerUnchecked (i)->type == type)
+                return ValueTreeSnapshot (node->children.getObjectPointerUnchecked (i));
+
+    return ValueTreeSnapshot();
+}
+
+//==============================================================================
+ValueTree ValueTreeSnapshot::createTree() const
+{
+    return node != nullptr ? node->createTree() : ValueTree();
+}
+
+void ValueTreeSnapshot::writeToStream (OutputStream& output) const
+{
+    if (node != nullptr)
+    {
+        node->writeToStream (output);
+    }
+    else
+    {
+        // (the same as ValueTree::writeToStream() writes for an invalid tree)
+        output.writeString (String());
+        output.writeCompressedInt (0);
+        output.writeCompressedInt (0);
+    }
+}
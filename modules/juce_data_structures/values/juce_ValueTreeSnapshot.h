@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_VALUETREESNAPSHOT_H_INCLUDED
+#define JUCE_VALUETREESNAPSHOT_H_INCLUDED
+
+
+//==============================================================================
+/**
+    An immutable copy of the state of a ValueTree at a particular moment.
+
+    Snapshots are cheap to take. Each node in a ValueTree keeps hold of its most
+    recent snapshot, and a change to a node only discards the snapshots of that node
+    and its parents. The next snapshot of the tree then only has to copy those nodes,
+    and shares all the unchanged sub-trees with earlier snapshots. Taking a snapshot
+    of a tree that hasn't changed just returns the previous one.
+
+    Because a snapshot never changes, it can be read from any thread without locking,
+    while the original tree carries on being edited. That makes it useful for autosaving,
+    undo histories, and background threads that need a consistent view of a large tree.
+    The snapshot itself has to be taken on the thread that modifies the tree.
+
+    Note that property values are copied the same way as with ValueTree::createCopy(),
+    so if a property holds an object or an array, the snapshot shares it with the tree.
+
+    @code
+    ValueTreeSnapshot snapshot (sessionTree);     // (on the message thread)
+
+    ...later, on a background thread:
+    FileOutputStream out (autosaveFile);
+    snapshot.writeToStream (out);
+    @endcode
+
+    @see ValueTree
+*/
+class JUCE_API  ValueTreeSnapshot
+{
+public:
+    //==============================================================================
+    /** Creates an invalid snapshot. */
+    ValueTreeSnapshot() noexcept;
+
+    /** Takes a snapshot of the current state of a tree.
+        This must be called on the thread that changes the tree.
+    */
+    explicit ValueTreeSnapshot (const ValueTree& tree);
+
+    /** Creates another reference to the same snapshot. */
+    ValueTreeSnapshot (const ValueTreeSnapshot&) noexcept;
+
+    /** Makes this refer to the same snapshot as another one. */
+    ValueTreeSnapshot& operator= (const ValueTreeSnapshot&) noexcept;
+
+    /** Destructor. */
+    ~ValueTreeSnapshot();
+
+    /** Returns true if both snapshots refer to the same node data.
+        Because unchanged sub-trees are shared between snapshots, this is a quick way
+        to find out whether part of a tree has changed between two snapshots.
+    */
+    bool operator== (const ValueTreeSnapshot&) const noexcept;
+
+    /** Returns true if the snapshots refer to different node data. */
+    bool operator!= (const ValueTreeSnapshot&) const noexcept;
+
+    //==============================================================================
+    /** Returns true if this snapshot holds some data. */
+    bool isValid() const noexcept                   { return node != nullptr; }
+
+    /** Returns the type of this node. */
+    Identifier getType() const noexcept;
+
+    /** Returns true if the node has this type. */
+    bool hasType (const Identifier typeName) const noexcept;
+
+    //==============================================================================
+    /** Returns the number of properties that the node has. */
+    int getNumProperties() const noexcept;
+
+    /** Returns the name of one of the node's properties. */
+    Identifier getPropertyName (int index) const noexcept;
+
+    /** Returns the value of a named property, or a void var if it isn't set. */
+    const var& getProperty (const Identifier name) const noexcept;
+
+    /** Returns the value of a named property, or a default value if it isn't set. */
+    var getProperty (const Identifier name, const var& defaultReturnValue) const;
+
+    /** Returns the value of a named property, or a void var if it isn't set. */
+    const var& operator[] (const Identifier name) const noexcept;
+
+    /** Returns true if the node has a property with this name. */
+    bool hasProperty (const Identifier name) const noexcept;
+
+    //==============================================================================
+    /** Returns the number of child nodes. */
+    int getNumChildren() const noexcept;
+
+    /** Returns one of the child nodes, or an invalid snapshot if the index is out of range. */
+    ValueTreeSnapshot getChild (int index) const;
+
+    /** Returns the first child node with this type, or an invalid snapshot if there isn't one. */
+    ValueTreeSnapshot getChildWithName (const Identifier type) const;
+
+    //==============================================================================
+    /** Creates a new, editable ValueTree with the same contents as this snapshot. */
+    ValueTree createTree() const;
+
+    /** Writes the snapshot in the same binary format as ValueTree::writeToStream(), so
+        it can be read back with ValueTree::readFromStream().
+    */
+    void writeToStream (OutputStream& output) const;
+
+private:
+    //==============================================================================
+    struct Node;
+    ReferenceCountedObjectPtr<Node> node;
+
+    explicit ValueTreeSnapshot (Node*) noexcept;
+    static ValueTreeSnapshot getSnapshot (ValueTree::SharedObject&);
+};
+
+
+#endif   // JUCE_VALUETREESNAPSHOT_H_INCLUDED
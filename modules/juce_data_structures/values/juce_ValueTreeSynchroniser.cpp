@@ -26,11 +26,14 @@ namespace ValueTreeSynchroniserHelpers
 {
     enum ChangeType
     {
-        propertyChanged  = 1,
-        fullSync         = 2,
-        childAdded       = 3,
-        childRemoved     = 4,
-        childMoved       = 5
+        propertyChanged    = 1,
+        fullSync           = 2,
+        childAdded         = 3,
+        childRemoved       = 4,
+        childMoved         = 5,
+        compressedFullSync = 6,
+        sequencedFullSync  = 7,
+        sequencedChanges   = 8
     };
 
     static void getValueTreePath (ValueTree v, const ValueTree& topLevelTree, Array<int>& path)
@@ -66,6 +69,30 @@ namespace ValueTreeSynchroniserHelpers
             stream.writeCompressedInt (path.getUnchecked(i));
     }
 
+    static void writeTree (MemoryOutputStream& stream, const ValueTree& tree, bool compress)
+    {
+        if (compress)
+        {
+            GZIPCompressorOutputStream gzip (&stream, 9);
+            tree.writeToStream (gzip);
+        }
+        else
+        {
+            tree.writeToStream (stream);
+        }
+    }
+
+    static ValueTree readTree (MemoryInputStream& input, bool isCompressed)
+    {
+        if (isCompressed)
+        {
+            GZIPDecompressorInputStream gzip (input);
+            return ValueTree::readFromStream (gzip);
+        }
+
+        return ValueTree::readFromStream (input);
+    }
+
     static ValueTree readSubTreeLocation (MemoryInputStream& input, ValueTree v)
     {
         const int numLevels = input.readCompressedInt();
@@ -85,33 +112,212 @@ namespace ValueTreeSynchroniserHelpers
 
         return v;
     }
+
+    // Applies one of the changes that can be sent on its own, or as part of a batch.
+    // In a batch, property names are indexes into the receiver's table of names.
+    static bool applySingleChange (MemoryInputStream& input, ChangeType type, ValueTree& root,
+                                   UndoManager* undoManager, const Array<Identifier>* propertyNames)
+    {
+        ValueTree v (readSubTreeLocation (input, root));
+
+        if (! v.isValid())
+            return false;
+
+        switch (type)
+        {
+            case propertyChanged:
+            {
+                if (propertyNames != nullptr)
+                {
+                    const int index = input.readCompressedInt();
+
+                    if (! isPositiveAndBelow (index, propertyNames->size()))
+                        break;
+
+                    v.setProperty (propertyNames->getReference (index), var::readFromStream (input), undoManager);
+                    return true;
+                }
+
+                Identifier property (input.readString());
+                v.setProperty (property, var::readFromStream (input), undoManager);
+                return true;
+            }
+
+            case childAdded:
+            {
+                const int index = input.readCompressedInt();
+                v.addChild (ValueTree::readFromStream (input), index, undoManager);
+                return true;
+            }
+
+            case childRemoved:
+            {
+                const int index = input.readCompressedInt();
+
+                if (isPositiveAndBelow (index, v.getNumChildren()))
+                {
+                    v.removeChild (index, undoManager);
+                    return true;
+                }
+
+                jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+                break;
+            }
+
+            case childMoved:
+            {
+                const int oldIndex = input.readCompressedInt();
+                const int newIndex = input.readCompressedInt();
+
+                if (isPositiveAndBelow (oldIndex, v.getNumChildren())
+                     && isPositiveAndBelow (newIndex, v.getNumChildren()))
+                {
+                    v.moveChild (oldIndex, newIndex, undoManager);
+                    return true;
+                }
+
+                jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+                break;
+            }
+
+            default:
+                jassertfalse; // Seem to have received some corrupt data?
+                break;
+        }
+
+        return false;
+    }
 }
 
-ValueTreeSynchroniser::ValueTreeSynchroniser (const ValueTree& tree)  : valueTree (tree)
+ValueTreeSynchroniser::ValueTreeSynchroniser (const ValueTree& tree)
+    : valueTree (tree), batchingInterval (0), compressFullSyncs (false),
+      nextSequenceNumber (0), numPendingChanges (0)
 {
     valueTree.addListener (this);
 }
 
 ValueTreeSynchroniser::~ValueTreeSynchroniser()
 {
+    // (any changes still waiting in a batch are dropped, as the subclass has already gone)
     valueTree.removeListener (this);
 }
 
+void ValueTreeSynchroniser::setBatchingInterval (const int milliseconds)
+{
+    if (milliseconds <= 0)
+        sendPendingChanges();
+
+    batchingInterval = jmax (0, milliseconds);
+}
+
+void ValueTreeSynchroniser::setFullSyncCompressionEnabled (const bool shouldCompress) noexcept
+{
+    compressFullSyncs = shouldCompress;
+}
+
 void ValueTreeSynchroniser::sendFullSyncCallback()
 {
+    using namespace ValueTreeSynchroniserHelpers;
     MemoryOutputStream m;
-    writeHeader (m, ValueTreeSynchroniserHelpers::fullSync);
-    valueTree.writeToStream (m);
+
+    if (batchingInterval > 0)
+    {
+        // The full sync replaces anything in the current batch, and the receiver
+        // starts a new table of property names when it gets it.
+        stopTimer();
+        pendingChanges.reset();
+        numPendingChanges = 0;
+        newPropertyNames.clear();
+        propertyNameIndexes.clear();
+
+        writeHeader (m, sequencedFullSync);
+        m.writeCompressedInt ((int) nextSequenceNumber++);
+        m.writeBool (compressFullSyncs);
+    }
+    else
+    {
+        writeHeader (m, compressFullSyncs ? compressedFullSync : fullSync);
+    }
+
+    writeTree (m, valueTree, compressFullSyncs);
+    stateChanged (m.getData(), m.getDataSize());
+}
+
+void ValueTreeSynchroniser::sendPendingChanges()
+{
+    stopTimer();
+
+    if (numPendingChanges == 0)
+        return;
+
+    MemoryOutputStream m ((size_t) pendingChanges.getDataSize() + 64);
+    ValueTreeSynchroniserHelpers::writeHeader (m, ValueTreeSynchroniserHelpers::sequencedChanges);
+    m.writeCompressedInt ((int) nextSequenceNumber++);
+    m.writeCompressedInt (newPropertyNames.size());
+
+    for (int i = 0; i < newPropertyNames.size(); ++i)
+        m.writeString (newPropertyNames[i]);
+
+    m.writeCompressedInt (numPendingChanges);
+    m << pendingChanges;
+
+    pendingChanges.reset();
+    numPendingChanges = 0;
+    newPropertyNames.clear();
+
     stateChanged (m.getData(), m.getDataSize());
 }
 
+void ValueTreeSynchroniser::timerCallback()
+{
+    sendPendingChanges();
+}
+
+void ValueTreeSynchroniser::sendChange (MemoryOutputStream& m)
+{
+    if (batchingInterval > 0)
+    {
+        pendingChanges << m;
+        ++numPendingChanges;
+
+        if (! isTimerRunning())
+            startTimer (batchingInterval);
+    }
+    else
+    {
+        stateChanged (m.getData(), m.getDataSize());
+    }
+}
+
+void ValueTreeSynchroniser::writePropertyName (MemoryOutputStream& m, const Identifier& property)
+{
+    if (batchingInterval > 0)
+    {
+        if (const var* const index = propertyNameIndexes.getVarPointer (property))
+        {
+            m.writeCompressedInt (*index);
+        }
+        else
+        {
+            const int newIndex = propertyNameIndexes.size();
+            propertyNameIndexes.set (property, newIndex);
+            newPropertyNames.add (property.toString());
+            m.writeCompressedInt (newIndex);
+        }
+    }
+    else
+    {
+        m.writeString (property.toString());
+    }
+}
+
 void ValueTreeSynchroniser::valueTreePropertyChanged (ValueTree& vt, const Identifier& property)
 {
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::propertyChanged, vt);
-    m.writeString (property.toString());
+    writePropertyName (m, property);
     vt.getProperty (property).writeToStream (m);
-    stateChanged (m.getData(), m.getDataSize());
+    sendChange (m);
 }
 
 void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTree& childTree)
@@ -123,7 +329,7 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childAdded, parentTree);
     m.writeCompressedInt (index);
     childTree.writeToStream (m);
-    stateChanged (m.getData(), m.getDataSize());
+    sendChange (m);
 }
 
 void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueTree&, int oldIndex)
@@ -131,7 +337,7 @@ void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueT
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childRemoved, parentTree);
     m.writeCompressedInt (oldIndex);
-    stateChanged (m.getData(), m.getDataSize());
+    sendChange (m);
 }
 
 void ValueTreeSynchroniser::valueTreeChildOrderChanged (ValueTree& parent, int oldIndex, int newIndex)
@@ -140,78 +346,106 @@ void ValueTreeSynchroniser::valueTreeChildOrderChanged (ValueTree& parent, int o
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childMoved, parent);
     m.writeCompressedInt (oldIndex);
     m.writeCompressedInt (newIndex);
-    stateChanged (m.getData(), m.getDataSize());
+    sendChange (m);
 }
 
 void ValueTreeSynchroniser::valueTreeParentChanged (ValueTree&)  {} // (No action needed here)
 
 bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size_t dataSize, UndoManager* undoManager)
 {
+    using namespace ValueTreeSynchroniserHelpers;
     MemoryInputStream input (data, dataSize, false);
 
-    const ValueTreeSynchroniserHelpers::ChangeType type = (ValueTreeSynchroniserHelpers::ChangeType) input.readByte();
+    const ChangeType type = (ChangeType) input.readByte();
 
-    if (type == ValueTreeSynchroniserHelpers::fullSync)
+    switch (type)
     {
-        root = ValueTree::readFromStream (input);
+        case fullSync:
+            root = ValueTree::readFromStream (input);
+            return true;
+
+        case compressedFullSync:
+            root = readTree (input, true);
+            return true;
+
+        case sequencedFullSync:
+        {
+            input.readCompressedInt(); // (the sequence number only matters to a Receiver)
+            const bool isCompressed = input.readBool();
+            root = readTree (input, isCompressed);
+            return true;
+        }
+
+        case sequencedChanges:
+            jassertfalse; // Batched changes have to be applied with a ValueTreeSynchroniser::Receiver!
+            return false;
+
+        default:
+            return applySingleChange (input, type, root, undoManager, nullptr);
+    }
+}
+
+//==============================================================================
+ValueTreeSynchroniser::Receiver::Receiver()
+    : expectedSequenceNumber (0), fullSyncNeeded (false)
+{
+}
+
+ValueTreeSynchroniser::Receiver::~Receiver()
+{
+}
+
+bool ValueTreeSynchroniser::Receiver::applyChange (ValueTree& root, const void* data, size_t dataSize, UndoManager* undoManager)
+{
+    using namespace ValueTreeSynchroniserHelpers;
+    MemoryInputStream input (data, dataSize, false);
+
+    const ChangeType type = (ChangeType) input.readByte();
+
+    if (type == sequencedFullSync)
+    {
+        expectedSequenceNumber = (uint32) input.readCompressedInt() + 1;
+        const bool isCompressed = input.readBool();
+        root = readTree (input, isCompressed);
+        propertyNames.clearQuick();
+        fullSyncNeeded = false;
         return true;
     }
 
-    ValueTree v (ValueTreeSynchroniserHelpers::readSubTreeLocation (input, root));
+    if (type != sequencedChanges)
+        return ValueTreeSynchroniser::applyChange (root, data, dataSize, undoManager);
 
-    if (! v.isValid())
+    if (fullSyncNeeded)
         return false;
 
-    switch (type)
+    if ((uint32) input.readCompressedInt() != expectedSequenceNumber)
     {
-        case ValueTreeSynchroniserHelpers::propertyChanged:
-        {
-            Identifier property (input.readString());
-            v.setProperty (property, var::readFromStream (input), undoManager);
-            return true;
-        }
+        // A batch has been lost or delivered out of order, so the trees are out of step
+        fullSyncNeeded = true;
+        return false;
+    }
 
-        case ValueTreeSynchroniserHelpers::childAdded:
-        {
-            const int index = input.readCompressedInt();
-            v.addChild (ValueTree::readFromStream (input), index, undoManager);
-            return true;
-        }
+    ++expectedSequenceNumber;
 
-        case ValueTreeSynchroniserHelpers::childRemoved:
-        {
-            const int index = input.readCompressedInt();
+    const int numNewNames = input.readCompressedInt();
 
-            if (isPositiveAndBelow (index, v.getNumChildren()))
-            {
-                v.removeChild (index, undoManager);
-                return true;
-            }
+    if (! isPositiveAndBelow (numNewNames, 65536)) // sanity-check
+    {
+        fullSyncNeeded = true;
+        return false;
+    }
 
-            jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
-            break;
-        }
+    for (int i = 0; i < numNewNames; ++i)
+        propertyNames.add (Identifier (input.readString()));
 
-        case ValueTreeSynchroniserHelpers::childMoved:
+    for (int i = input.readCompressedInt(); --i >= 0;)
+    {
+        if (! applySingleChange (input, (ChangeType) input.readByte(), root, undoManager, &propertyNames))
         {
-            const int oldIndex = input.readCompressedInt();
-            const int newIndex = input.readCompressedInt();
-
-            if (isPositiveAndBelow (oldIndex, v.getNumChildren())
-                 && isPositiveAndBelow (newIndex, v.getNumChildren()))
-            {
-                v.moveChild (oldIndex, newIndex, undoManager);
-                return true;
-            }
-
-            jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
-            break;
+            fullSyncNeeded = true;
+            return false;
         }
-
-        default:
-            jassertfalse; // Seem to have received some corrupt data?
-            break;
     }
 
-    return false;
+    return true;
 }
@@ -39,8 +39,15 @@
     and implement the stateChanged() method to transmit the encoded change (maybe
     via a network or other means) to a remote destination, where it can be
     applied to a target tree.
+
+    By default, each change is sent as soon as it happens. If you call
+    setBatchingInterval(), the changes are instead collected and sent together
+    at regular intervals, in numbered messages in which property names are only
+    sent the first time they're used. Those messages need to be applied with a
+    ValueTreeSynchroniser::Receiver, which can tell when one has gone missing.
 */
-class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener
+class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener,
+                                         private Timer
 {
 public:
     /** Creates a ValueTreeSynchroniser that watches the given tree.
@@ -68,21 +75,104 @@ public:
     */
     void sendFullSyncCallback();
 
+    /** Makes the synchroniser collect changes and send them together.
+
+        If the interval is more than zero, changes are added to a batch, and the batch
+        is sent as a single stateChanged() message once the interval has elapsed since
+        the first change in it. Each batch message has a sequence number, and property
+        names are sent as indexes into a table that's built up across messages, so the
+        messages must be applied in order using a Receiver. Call sendFullSyncCallback()
+        after turning this on, so that the receiver starts from a known state.
+
+        An interval of zero (the default) sends each change as soon as it happens, in
+        a format that the static applyChange() method can decode.
+
+        Batching needs the message thread to be running, as it uses a Timer.
+    */
+    void setBatchingInterval (int milliseconds);
+
+    /** Sends any changes that are waiting in the current batch straight away.
+        @see setBatchingInterval
+    */
+    void sendPendingChanges();
+
+    /** If this is turned on, the tree data in full-sync messages is GZIP-compressed. */
+    void setFullSyncCompressionEnabled (bool shouldCompress) noexcept;
+
     /** Applies an encoded change to the given destination tree.
 
         When you implement a receiver for changes that were sent by the stateChanged()
         message, this is the function that you'll need to call to apply them to the
         target tree that you want to be synced.
+
+        This can't apply batched messages, as they depend on earlier messages: if you've
+        used setBatchingInterval(), use a Receiver instead.
     */
     static bool applyChange (ValueTree& target,
                              const void* encodedChangeData, size_t encodedChangeDataSize,
                              UndoManager* undoManager);
 
+    //==============================================================================
+    /**
+        Applies the messages sent by a ValueTreeSynchroniser to a target tree, keeping
+        track of the state needed to decode batched messages.
+
+        If a batched message arrives out of sequence (because one was lost or reordered
+        by the transport), or it can't be applied because the trees have drifted apart,
+        the receiver ignores any further batches until it's given a full sync. When that
+        happens, needsFullSync() returns true, and you should ask the sender to call
+        sendFullSyncCallback().
+
+        A Receiver can also apply all the messages that the static applyChange() method
+        can handle.
+    */
+    class JUCE_API  Receiver
+    {
+    public:
+        /** Creates a receiver, ready for the first message sent by a synchroniser. */
+        Receiver();
+
+        /** Destructor. */
+        ~Receiver();
+
+        /** Applies an encoded change to the given destination tree.
+            @returns true if the change was applied; false if the data was corrupt, or
+                     the receiver is waiting for a full sync
+        */
+        bool applyChange (ValueTree& target,
+                          const void* encodedChangeData, size_t encodedChangeDataSize,
+                          UndoManager* undoManager);
+
+        /** Returns true if a batched message was missed, or couldn't be applied, and
+            the receiver needs a full sync before it can apply any more.
+        */
+        bool needsFullSync() const noexcept     { return fullSyncNeeded; }
+
+    private:
+        Array<Identifier> propertyNames;
+        uint32 expectedSequenceNumber;
+        bool fullSyncNeeded;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Receiver)
+    };
+
+    //==============================================================================
     /** Returns the root ValueTree that is being observed. */
     const ValueTree& getRoot() noexcept       { return valueTree; }
 
 private:
     ValueTree valueTree;
+    int batchingInterval;
+    bool compressFullSyncs;
+    uint32 nextSequenceNumber;
+    NamedValueSet propertyNameIndexes;
+    StringArray newPropertyNames;
+    MemoryOutputStream pendingChanges;
+    int numPendingChanges;
+
+    void sendChange (MemoryOutputStream&);
+    void writePropertyName (MemoryOutputStream&, const Identifier&);
+    void timerCallback() override;
 
     void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
     void valueTreeChildAdded (ValueTree&, ValueTree&) override;
@@ -94,7 +94,7 @@ private:
 
     friend class ChangeBroadcasterCallback;
     ChangeBroadcasterCallback callback;
-    ListenerList <ChangeListener> changeListeners;
+    LockFreeListenerList<ChangeListener> changeListeners;
 
     void callListeners();
 
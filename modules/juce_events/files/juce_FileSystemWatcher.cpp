@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+FileSystemWatcher::FileSystemWatcher()  : coalescingIntervalMs (100)
+{
+}
+
+FileSystemWatcher::~FileSystemWatcher()
+{
+    removeAllFolders();
+    cancelPendingUpdate();
+    stopTimer();
+}
+
+//==============================================================================
+bool FileSystemWatcher::addFolder (const File& folder, const bool watchSubfolders)
+{
+    if (! folder.isDirectory())
+        return false;
+
+    removeFolder (folder);
+
+    ScopedPointer<Pimpl> p (new Pimpl (*this, folder, watchSubfolders));
+
+    if (! p->isValid())
+        return false;
+
+    folders.add (p.release());
+    return true;
+}
+
+void FileSystemWatcher::removeFolder (const File& folder)
+{
+    for (int i = folders.size(); --i >= 0;)
+        if (folders.getUnchecked(i)->folder == folder)
+            folders.remove (i);
+}
+
+void FileSystemWatcher::removeAllFolders()
+{
+    folders.clear();
+}
+
+Array<File> FileSystemWatcher::getWatchedFolders() const
+{
+    Array<File> result;
+
+    for (int i = 0; i < folders.size(); ++i)
+        result.add (folders.getUnchecked(i)->folder);
+
+    return result;
+}
+
+void FileSystemWatcher::setCoalescingInterval (const int milliseconds)
+{
+    coalescingIntervalMs = jmax (1, milliseconds);
+}
+
+void FileSystemWatcher::addListener (Listener* const l)      { listeners.add (l); }
+void FileSystemWatcher::removeListener (Listener* const l)   { listeners.remove (l); }
+
+//==============================================================================
+void FileSystemWatcher::addChange (const File& file, const ChangeType type)
+{
+    {
+        const ScopedLock sl (pendingLock);
+
+        Change c;
+        c.file = file;
+        c.type = type;
+        pendingChanges.add (c);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void FileSystemWatcher::handleAsyncUpdate()
+{
+    if (! isTimerRunning())
+        startTimer (coalescingIntervalMs);
+}
+
+namespace FileSystemWatcherHelpers
+{
+    // Returns the type that describes two successive changes to the same file,
+    // or -1 if they cancel each other out.
+    static int mergeChanges (const int first, const int second) noexcept
+    {
+        if (first < 0)                                      return second;
+        if (first == FileSystemWatcher::folderNeedsRescan
+             || second == FileSystemWatcher::folderNeedsRescan)
+            return FileSystemWatcher::folderNeedsRescan;
+
+        if (first == FileSystemWatcher::fileCreated)
+            return second == FileSystemWatcher::fileDeleted ? -1 : (int) FileSystemWatcher::fileCreated;
+
+        if (first == FileSystemWatcher::fileDeleted)
+            return second == FileSystemWatcher::fileCreated ? (int) FileSystemWatcher::fileModified
+                                                            : (int) FileSystemWatcher::fileDeleted;
+
+        return second == FileSystemWatcher::fileDeleted ? (int) FileSystemWatcher::fileDeleted
+                                                        : (int) FileSystemWatcher::fileModified;
+    }
+}
+
+void FileSystemWatcher::timerCallback()
+{
+    stopTimer();
+
+    Array<Change> changes;
+
+    {
+        const ScopedLock sl (pendingLock);
+        changes.swapWith (pendingChanges);
+    }
+
+    // Each file keeps the position of its first change, with the type of all its changes merged.
+    Array<int> types;
+    HashMap<String, int> indexes;
+
+    for (int i = 0; i < changes.size(); ++i)
+    {
+        const Change& c = changes.getReference (i);
+        const String path (c.file.getFullPathName());
+        const int index = indexes [path] - 1;
+
+        if (index < 0)
+        {
+            indexes.set (path, types.size() + 1);
+            types.add (c.type);
+        }
+        else
+        {
+            types.set (index, FileSystemWatcherHelpers::mergeChanges (types.getUnchecked (index), c.type));
+        }
+    }
+
+    Array<Change> batch;
+
+    for (int i = 0; i < changes.size(); ++i)
+    {
+        const Change& c = changes.getReference (i);
+        const int index = indexes [c.file.getFullPathName()] - 1;
+
+        if (index >= 0 && types.getUnchecked (index) >= 0)
+        {
+            Change merged (c);
+            merged.type = (ChangeType) types.getUnchecked (index);
+            batch.add (merged);
+
+            types.set (index, -1); // (so that the file only appears once)
+        }
+    }
+
+    if (batch.size() > 0)
+        listeners.call (&Listener::fileSystemChanged, *this, batch);
+}
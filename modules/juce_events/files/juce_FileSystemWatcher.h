@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_FILESYSTEMWATCHER_H_INCLUDED
+#define JUCE_FILESYSTEMWATCHER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Watches a set of folders, and tells its listeners when files inside them are
+    created, deleted or modified.
+
+    This uses the operating system's change notifications (inotify on Linux and
+    Android, FSEvents on OSX and ReadDirectoryChangesW on Windows), so it doesn't need
+    to keep rescanning the folders. On iOS, where there's no such API, the folders are
+    polled in the background instead.
+
+    Changes are collected on background threads, and then delivered to the listeners
+    in batches on the message thread. Within a batch, several changes to the same file
+    are merged together - e.g. a file that's created and then written to several times
+    is reported once as being created, and a temporary file that's created and then
+    deleted again isn't reported at all.
+
+    A file that's renamed or moved is reported as the old file being deleted and the
+    new one being created.
+
+    @see DirectoryContentsList
+*/
+class JUCE_API  FileSystemWatcher  : private AsyncUpdater,
+                                     private Timer
+{
+public:
+    //==============================================================================
+    /** Creates a watcher that isn't watching any folders yet. */
+    FileSystemWatcher();
+
+    /** Destructor. */
+    ~FileSystemWatcher();
+
+    //==============================================================================
+    /** Starts watching a folder.
+
+        @param folder           the folder to watch
+        @param watchSubfolders  if true, changes inside any of the folder's subfolders
+                                (including ones that are created later) are also reported
+        @returns false if the folder doesn't exist or can't be watched
+    */
+    bool addFolder (const File& folder, bool watchSubfolders = true);
+
+    /** Stops watching a folder that was added with addFolder(). */
+    void removeFolder (const File& folder);
+
+    /** Stops watching all folders. */
+    void removeAllFolders();
+
+    /** Returns the folders that are being watched. */
+    Array<File> getWatchedFolders() const;
+
+    /** Sets how long the watcher waits after a change before delivering it.
+
+        Any other changes that happen during this time are delivered in the same batch,
+        so a longer interval means fewer callbacks when lots of files are changing.
+        The default is 100ms.
+    */
+    void setCoalescingInterval (int milliseconds);
+
+    //==============================================================================
+    /** The kinds of change that can be reported. */
+    enum ChangeType
+    {
+        fileCreated,        /**< A file or folder has appeared. */
+        fileDeleted,        /**< A file or folder has gone. */
+        fileModified,       /**< A file's contents or attributes have changed. */
+        folderNeedsRescan   /**< The details of some changes inside this folder were lost (e.g.
+                                 because too many happened at once), so anything that depends
+                                 on its contents needs to rescan it. */
+    };
+
+    /** Describes a change to a file. */
+    struct Change
+    {
+        File file;
+        ChangeType type;
+    };
+
+    /** Receives callbacks when the watched folders change.
+        @see FileSystemWatcher::addListener
+    */
+    class JUCE_API  Listener
+    {
+    public:
+        /** Destructor. */
+        virtual ~Listener() {}
+
+        /** Called on the message thread with a batch of changes.
+            A file will only appear once in each batch.
+        */
+        virtual void fileSystemChanged (FileSystemWatcher& watcher, const Array<Change>& changes) = 0;
+    };
+
+    /** Registers a listener to be told about changes. */
+    void addListener (Listener* listener);
+
+    /** Deregisters a previously-registered listener. */
+    void removeListener (Listener* listener);
+
+private:
+    //==============================================================================
+    class Pimpl;
+    friend class Pimpl;
+    friend struct ContainerDeletePolicy<Pimpl>;
+
+    OwnedArray<Pimpl> folders;
+    ListenerList<Listener> listeners;
+    CriticalSection pendingLock;
+    Array<Change> pendingChanges;
+    int coalescingIntervalMs;
+
+    void addChange (const File& file, ChangeType type);
+    void handleAsyncUpdate() override;
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FileSystemWatcher)
+};
+
+
+#endif   // JUCE_FILESYSTEMWATCHER_H_INCLUDED
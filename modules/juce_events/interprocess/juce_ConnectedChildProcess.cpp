@@ -34,6 +34,12 @@ static String getCommandLinePrefix (const String& commandLineUniqueID)
     return "--" + commandLineUniqueID + ":";
 }
 
+// (the first character of the pipe name tells the slave which kind of connection to make)
+static bool isSharedMemoryChannelName (const String& pipeName)
+{
+    return pipeName.startsWithChar ('s');
+}
+
 //==============================================================================
 // This thread sends and receives ping messages every second, so that it
 // can find out if the other process has stopped running.
@@ -84,12 +90,13 @@ private:
 struct ChildProcessMaster::Connection  : public InterprocessConnection,
                                          private ChildProcessPingThread
 {
-    Connection (ChildProcessMaster& m, const String& pipeName, int timeout)
+    Connection (ChildProcessMaster& m, const String& pipeName, int timeout, int sharedMemoryBufferSize)
         : InterprocessConnection (false, magicMastSlaveConnectionHeader),
           ChildProcessPingThread (timeout),
           owner (m)
     {
-        if (createPipe (pipeName, timeoutMs))
+        if (isSharedMemoryChannelName (pipeName) ? createSharedMemoryChannel (pipeName, sharedMemoryBufferSize, timeoutMs)
+                                                 : createPipe (pipeName, timeoutMs))
             startThread (4);
     }
 
@@ -133,6 +140,18 @@ ChildProcessMaster::~ChildProcessMaster()
 
 void ChildProcessMaster::handleConnectionLost() {}
 
+void ChildProcessMaster::killSlaveProcess()
+{
+    if (connection != nullptr)
+    {
+        sendMessageToSlave (MemoryBlock (killMessage, specialMessageSize));
+        connection->disconnect();
+        connection = nullptr;
+    }
+
+    childProcess.kill();
+}
+
 bool ChildProcessMaster::sendMessageToSlave (const MemoryBlock& mb)
 {
     if (connection != nullptr)
@@ -142,12 +161,13 @@ bool ChildProcessMaster::sendMessageToSlave (const MemoryBlock& mb)
     return false;
 }
 
-bool ChildProcessMaster::launchSlaveProcess (const File& executable, const String& commandLineUniqueID, int timeoutMs)
+bool ChildProcessMaster::launchSlaveProcess (const File& executable, const String& commandLineUniqueID,
+                                             int timeoutMs, int sharedMemoryBufferSize)
 {
     connection = nullptr;
     jassert (childProcess.kill());
 
-    const String pipeName ("p" + String::toHexString (Random().nextInt64()));
+    const String pipeName ((sharedMemoryBufferSize > 0 ? "s" : "p") + String::toHexString (Random().nextInt64()));
 
     StringArray args;
     args.add (executable.getFullPathName());
@@ -155,7 +175,8 @@ bool ChildProcessMaster::launchSlaveProcess (const File& executable, const Strin
 
     if (childProcess.start (args))
     {
-        connection = new Connection (*this, pipeName, timeoutMs <= 0 ? defaultTimeoutMs : timeoutMs);
+        connection = new Connection (*this, pipeName, timeoutMs <= 0 ? defaultTimeoutMs : timeoutMs,
+                                     sharedMemoryBufferSize);
 
         if (connection->isConnected())
         {
@@ -178,7 +199,11 @@ struct ChildProcessSlave::Connection  : public InterprocessConnection,
           ChildProcessPingThread (timeout),
           owner (p)
     {
-        connectToPipe (pipeName, timeoutMs);
+        if (isSharedMemoryChannelName (pipeName))
+            connectToSharedMemoryChannel (pipeName, timeoutMs, timeoutMs);
+        else
+            connectToPipe (pipeName, timeoutMs);
+
         startThread (4);
     }
 
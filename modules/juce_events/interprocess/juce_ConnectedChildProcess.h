@@ -152,12 +152,18 @@ public:
         handleConnectionLost() will be called. Passing <= 0 for this timeout makes
         it use a default value.
 
+        If sharedMemoryBufferSize is greater than zero, the two processes will talk through
+        a shared-memory channel with buffers of this size, rather than a named pipe (see
+        InterprocessConnection::createSharedMemoryChannel()). Messages can't be bigger than
+        half of this size.
+
         If this all works, the method returns true, and you can begin sending and
         receiving messages with the slave process.
     */
     bool launchSlaveProcess (const File& executableToLaunch,
                              const String& commandLineUniqueID,
-                             int timeoutMs = 0);
+                             int timeoutMs = 0,
+                             int sharedMemoryBufferSize = 0);
 
     /** This will be called to deliver a message from the slave process.
         The call will probably be made on a background thread, so be careful with your thread-safety!
@@ -176,6 +182,12 @@ public:
     */
     bool sendMessageToSlave (const MemoryBlock&);
 
+    /** Disconnects from the slave process and forcibly kills it.
+        Unlike deleting this object, which politely asks the slave to quit, this will
+        also get rid of a slave that has stopped responding.
+    */
+    void killSlaveProcess();
+
 private:
     ChildProcess childProcess;
 
@@ -34,13 +34,161 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConnectionThread)
 };
 
+//==============================================================================
+struct InterprocessConnection::ReceiveBuffer
+{
+    ReceiveBuffer() noexcept  : size (0), allocatedSize (0) {}
+
+    void setSize (const size_t newSize)
+    {
+        if (newSize > allocatedSize)
+        {
+            data.malloc (newSize);
+            allocatedSize = newSize;
+        }
+
+        size = newSize;
+    }
+
+    HeapBlock<char> data;
+    size_t size, allocatedSize;
+
+    JUCE_DECLARE_NON_COPYABLE (ReceiveBuffer)
+};
+
+// Incoming messages are read into buffers from this pool, and the buffers are handed
+// back once the message has been delivered, so a steady stream of messages doesn't
+// need any allocations. (It's reference-counted because messages that are waiting to
+// be delivered on the message thread can outlive their connection).
+class InterprocessConnection::ReceiveBufferPool  : public ReferenceCountedObject
+{
+public:
+    ReceiveBufferPool() {}
+
+    typedef ReferenceCountedObjectPtr<ReceiveBufferPool> Ptr;
+
+    ReceiveBuffer* getBuffer (const size_t size)
+    {
+        ReceiveBuffer* b;
+
+        {
+            const ScopedLock sl (lock);
+            b = freeBuffers.removeAndReturn (freeBuffers.size() - 1);
+        }
+
+        if (b == nullptr)
+            b = new ReceiveBuffer();
+
+        b->setSize (size);
+        return b;
+    }
+
+    void recycle (ReceiveBuffer* const b)
+    {
+        // (very big buffers aren't kept, so that a single huge message doesn't hang on to its memory)
+        if (b->allocatedSize <= maxSizeToKeep)
+        {
+            const ScopedLock sl (lock);
+
+            if (freeBuffers.size() < maxNumToKeep)
+            {
+                freeBuffers.add (b);
+                return;
+            }
+        }
+
+        delete b;
+    }
+
+private:
+    enum { maxNumToKeep = 16, maxSizeToKeep = 1024 * 1024 };
+
+    CriticalSection lock;
+    OwnedArray<ReceiveBuffer> freeBuffers;
+
+    JUCE_DECLARE_NON_COPYABLE (ReceiveBufferPool)
+};
+
+//==============================================================================
+// Reassembles messages from whatever pieces of data the multiplexer says are
+// available, so that a callback never blocks waiting for the rest of a message.
+struct InterprocessConnection::MultiplexedReader  : public SocketMultiplexer::Listener
+{
+    MultiplexedReader (InterprocessConnection& c)  : owner (c), body (nullptr)   { reset(); }
+    ~MultiplexedReader()    { reset(); }
+
+    void reset()
+    {
+        if (body != nullptr)
+            owner.receiveBufferPool->recycle (body);
+
+        body = nullptr;
+        headerBytesRead = 0;
+        bodyBytesRead = 0;
+    }
+
+    void socketReadyForReading (StreamingSocket& s) override
+    {
+        int numRead;
+
+        if (body == nullptr)
+        {
+            numRead = s.read (addBytesToPointer (header, headerBytesRead),
+                              (int) sizeof (header) - headerBytesRead, false);
+
+            if (numRead > 0 && (headerBytesRead += numRead) == (int) sizeof (header))
+            {
+                headerBytesRead = 0;
+
+                if (ByteOrder::swapIfBigEndian (header[0]) == owner.magicMessageHeader)
+                {
+                    const int size = (int) ByteOrder::swapIfBigEndian (header[1]);
+
+                    if (size > 0)
+                    {
+                        body = owner.receiveBufferPool->getBuffer ((size_t) size);
+                        bodyBytesRead = 0;
+                    }
+                }
+            }
+        }
+        else
+        {
+            const int bodySize = (int) body->size;
+
+            numRead = s.read (body->data + bodyBytesRead,
+                              jmin (bodySize - bodyBytesRead, 65536), false);
+
+            if (numRead > 0 && (bodyBytesRead += numRead) == bodySize)
+            {
+                ReceiveBuffer* const completeMessage = body;
+                body = nullptr;
+                owner.deliverDataInt (completeMessage);
+            }
+        }
+
+        if (numRead <= 0)
+            owner.multiplexedConnectionLost();
+    }
+
+    InterprocessConnection& owner;
+    uint32 header[2];
+    int headerBytesRead, bodyBytesRead;
+    ReceiveBuffer* body;
+
+    JUCE_DECLARE_NON_COPYABLE (MultiplexedReader)
+};
+
 //==============================================================================
 InterprocessConnection::InterprocessConnection (const bool callbacksOnMessageThread,
                                                 const uint32 magicMessageHeaderNumber)
     : callbackConnectionState (false),
       useMessageThread (callbacksOnMessageThread),
       magicMessageHeader (magicMessageHeaderNumber),
-      pipeReceiveMessageTimeout (-1)
+      pipeReceiveMessageTimeout (-1),
+      multiplexer (nullptr),
+      socketIsMultiplexed (false),
+      receiveBufferPool (new ReceiveBufferPool())
 {
     thread = new ConnectionThread (*this);
 }
@@ -51,6 +199,7 @@ InterprocessConnection::~InterprocessConnection()
     disconnect();
     masterReference.clear();
     thread = nullptr;
+    multiplexedReader = nullptr;
 }
 
 //==============================================================================
@@ -66,7 +215,7 @@ bool InterprocessConnection::connectToSocket (const String& hostName,
     if (socket->connect (hostName, portNumber, timeOutMillisecs))
     {
         connectionMadeInt();
-        thread->startThread();
+        startReading();
         return true;
     }
 
@@ -108,14 +257,84 @@ bool InterprocessConnection::createPipe (const String& pipeName, const int timeo
     return false;
 }
 
+bool InterprocessConnection::createSharedMemoryChannel (const String& channelName, const int bufferSizeBytes,
+                                                        const int writeTimeoutMs)
+{
+    disconnect();
+
+    ScopedPointer<SharedMemoryChannel> newChannel (new SharedMemoryChannel());
+
+    if (newChannel->createNewChannel (channelName, bufferSizeBytes))
+    {
+        const ScopedLock sl (pipeAndSocketLock);
+        pipeReceiveMessageTimeout = writeTimeoutMs;
+        initialiseWithSharedMemoryChannel (newChannel.release());
+        return true;
+    }
+
+    return false;
+}
+
+bool InterprocessConnection::connectToSharedMemoryChannel (const String& channelName, const int connectTimeoutMs,
+                                                           const int writeTimeoutMs)
+{
+    disconnect();
+
+    ScopedPointer<SharedMemoryChannel> newChannel (new SharedMemoryChannel());
+    const uint32 timeoutEnd = Time::getMillisecondCounter() + (uint32) jmax (0, connectTimeoutMs);
+
+    // (the other process may not have created the channel yet, so keep trying for a while)
+    while (! newChannel->openExisting (channelName))
+    {
+        if (Time::getMillisecondCounter() >= timeoutEnd)
+            return false;
+
+        Thread::sleep (5);
+    }
+
+    const ScopedLock sl (pipeAndSocketLock);
+    pipeReceiveMessageTimeout = writeTimeoutMs;
+    initialiseWithSharedMemoryChannel (newChannel.release());
+    return true;
+}
+
+void InterprocessConnection::setSocketMultiplexer (SocketMultiplexer* const multiplexerToUse)
+{
+    // This must be set before the connection is opened!
+    jassert (socket == nullptr && pipe == nullptr);
+
+    multiplexer = multiplexerToUse;
+
+    if (multiplexer != nullptr && multiplexedReader == nullptr)
+        multiplexedReader = new MultiplexedReader (*this);
+}
+
 void InterprocessConnection::disconnect()
 {
+    if (socketIsMultiplexed)
+    {
+        StreamingSocket* s;
+
+        {
+            const ScopedLock sl (pipeAndSocketLock);
+            s = socket;
+        }
+
+        // (this mustn't hold pipeAndSocketLock, because it waits for any callback
+        // in progress, and a callback may need that lock)
+        if (s != nullptr)
+            multiplexer->removeSocket (*s);
+
+        socketIsMultiplexed = false;
+    }
+
     thread->signalThreadShouldExit();
 
     {
         const ScopedLock sl (pipeAndSocketLock);
         if (socket != nullptr)  socket->close();
         if (pipe != nullptr)    pipe->close();
+        if (sharedMemoryChannel != nullptr)  sharedMemoryChannel->cancelPendingReads();
     }
 
     thread->stopThread (4000);
@@ -128,6 +347,7 @@ void InterprocessConnection::deletePipeAndSocket()
     const ScopedLock sl (pipeAndSocketLock);
     socket = nullptr;
     pipe = nullptr;
+    sharedMemoryChannel = nullptr;
 }
 
 bool InterprocessConnection::isConnected() const
@@ -135,8 +355,9 @@ bool InterprocessConnection::isConnected() const
     const ScopedLock sl (pipeAndSocketLock);
 
     return ((socket != nullptr && socket->isConnected())
-              || (pipe != nullptr && pipe->isOpen()))
-            && thread->isThreadRunning();
+              || (pipe != nullptr && pipe->isOpen())
+              || (sharedMemoryChannel != nullptr && sharedMemoryChannel->isOpen()))
+            && (socketIsMultiplexed || thread->isThreadRunning());
 }
 
 String InterprocessConnection::getConnectedHostName() const
@@ -144,7 +365,7 @@ String InterprocessConnection::getConnectedHostName() const
     {
         const ScopedLock sl (pipeAndSocketLock);
 
-        if (pipe == nullptr && socket == nullptr)
+        if (pipe == nullptr && socket == nullptr && sharedMemoryChannel == nullptr)
             return String();
 
         if (socket != nullptr && ! socket->isLocal())
@@ -157,17 +378,67 @@ String InterprocessConnection::getConnectedHostName() const
 //==============================================================================
 bool InterprocessConnection::sendMessage (const MemoryBlock& message)
 {
-    uint32 messageHeader[2] = { ByteOrder::swapIfBigEndian (magicMessageHeader),
-                                ByteOrder::swapIfBigEndian ((uint32) message.getSize()) };
+    return sendMessage (message.getData(), message.getSize());
+}
+
+bool InterprocessConnection::sendMessage (const void* const messageData, const size_t numBytes)
+{
+    return sendMessage (&messageData, &numBytes, 1);
+}
+
+bool InterprocessConnection::sendMessage (const void* const* const dataBlocks,
+                                          const size_t* const blockSizes, const int numBlocks)
+{
+    size_t totalSize = 0;
+
+    for (int i = 0; i < numBlocks; ++i)
+        totalSize += blockSizes[i];
+
+    const uint32 messageHeader[2] = { ByteOrder::swapIfBigEndian (magicMessageHeader),
+                                      ByteOrder::swapIfBigEndian ((uint32) totalSize) };
+
+    const size_t messageSize = sizeof (messageHeader) + totalSize;
 
-    MemoryBlock messageData (sizeof (messageHeader) + message.getSize());
-    messageData.copyFrom (messageHeader, 0, sizeof (messageHeader));
-    messageData.copyFrom (message.getData(), sizeof (messageHeader), message.getSize());
+    // (holding the lock keeps the pieces together if other threads are also sending)
+    const ScopedLock sl (pipeAndSocketLock);
+
+    // (a shared-memory channel keeps its messages separate, so it doesn't need the header)
+    if (sharedMemoryChannel != nullptr)
+        return sharedMemoryChannel->writeMessage (dataBlocks, blockSizes, numBlocks, pipeReceiveMessageTimeout);
+
+    if (messageSize > 65536)
+    {
+        // Big messages are written piece-by-piece, rather than being copied..
+        if (writeData (messageHeader, (int) sizeof (messageHeader)) != (int) sizeof (messageHeader))
+            return false;
+
+        for (int i = 0; i < numBlocks; ++i)
+            if (blockSizes[i] > 0 && writeData (dataBlocks[i], (int) blockSizes[i]) != (int) blockSizes[i])
+                return false;
 
-    return writeData (messageData.getData(), (int) messageData.getSize()) == (int) messageData.getSize();
+        return true;
+    }
+
+    // ..but small ones are gathered into a buffer that's kept between calls, so that
+    // each one goes out in a single write without allocating anything.
+    if (sendBuffer.getSize() < messageSize)
+        sendBuffer.setSize (messageSize);
+
+    char* const dest = static_cast<char*> (sendBuffer.getData());
+    memcpy (dest, messageHeader, sizeof (messageHeader));
+
+    size_t offset = sizeof (messageHeader);
+
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        memcpy (dest + offset, dataBlocks[i], blockSizes[i]);
+        offset += blockSizes[i];
+    }
+
+    return writeData (dest, (int) messageSize) == (int) messageSize;
 }
 
-int InterprocessConnection::writeData (void* data, int dataSize)
+int InterprocessConnection::writeData (const void* data, int dataSize)
 {
     const ScopedLock sl (pipeAndSocketLock);
 
@@ -186,7 +457,7 @@ void InterprocessConnection::initialiseWithSocket (StreamingSocket* newSocket)
     jassert (socket == nullptr && pipe == nullptr);
     socket = newSocket;
     connectionMadeInt();
-    thread->startThread();
+    startReading();
 }
 
 void InterprocessConnection::initialiseWithPipe (NamedPipe* newPipe)
@@ -197,6 +468,14 @@ void InterprocessConnection::initialiseWithPipe (NamedPipe* newPipe)
     thread->startThread();
 }
 
+void InterprocessConnection::initialiseWithSharedMemoryChannel (SharedMemoryChannel* newChannel)
+{
+    jassert (socket == nullptr && pipe == nullptr && sharedMemoryChannel == nullptr);
+    sharedMemoryChannel = newChannel;
+    connectionMadeInt();
+    thread->startThread();
+}
+
 //==============================================================================
 struct ConnectionStateMessage  : public MessageManager::MessageBase
 {
@@ -247,30 +526,79 @@ void InterprocessConnection::connectionLostInt()
     }
 }
 
-struct DataDeliveryMessage  : public Message
+struct InterprocessConnection::DataDeliveryMessage  : public Message
 {
-    DataDeliveryMessage (InterprocessConnection* ipc, const MemoryBlock& d)
-        : owner (ipc), data (d)
+    DataDeliveryMessage (InterprocessConnection* ipc, ReceiveBuffer* b)
+        : owner (ipc), pool (ipc->receiveBufferPool), buffer (b)
     {}
 
+    ~DataDeliveryMessage()
+    {
+        pool->recycle (buffer);
+    }
+
     void messageCallback() override
     {
         if (InterprocessConnection* const ipc = owner)
-            ipc->messageReceived (data);
+            ipc->messageDataReceived (buffer->data, buffer->size);
     }
 
     WeakReference<InterprocessConnection> owner;
-    MemoryBlock data;
+    ReceiveBufferPool::Ptr pool;
+    ReceiveBuffer* buffer;
+
+    JUCE_DECLARE_NON_COPYABLE (DataDeliveryMessage)
 };
 
-void InterprocessConnection::deliverDataInt (const MemoryBlock& data)
+void InterprocessConnection::deliverDataInt (ReceiveBuffer* const buffer)
 {
     jassert (callbackConnectionState);
 
     if (useMessageThread)
-        (new DataDeliveryMessage (this, data))->post();
+    {
+        (new DataDeliveryMessage (this, buffer))->post();
+    }
     else
-        messageReceived (data);
+    {
+        messageDataReceived (buffer->data, buffer->size);
+        receiveBufferPool->recycle (buffer);
+    }
+}
+
+void InterprocessConnection::messageReceived (const MemoryBlock&)
+{
+}
+
+void InterprocessConnection::messageDataReceived (const void* const messageData, const size_t numBytes)
+{
+    messageReceived (MemoryBlock (messageData, numBytes));
+}
+
+void InterprocessConnection::startReading()
+{
+    if (socket != nullptr && multiplexer != nullptr)
+    {
+        multiplexedReader->reset();
+        socketIsMultiplexed = true;
+
+        if (multiplexer->addSocket (*socket, *multiplexedReader))
+            return;
+
+        socketIsMultiplexed = false;
+    }
+
+    thread->startThread();
+}
+
+void InterprocessConnection::multiplexedConnectionLost()
+{
+    // (called on the multiplexer's thread, so removing the socket here can't deadlock)
+    if (socket != nullptr)
+        multiplexer->removeSocket (*socket);
+
+    socketIsMultiplexed = false;
+    deletePipeAndSocket();
+    connectionLostInt();
 }
 
 //==============================================================================
@@ -287,16 +615,19 @@ bool InterprocessConnection::readNextMessageInt()
 
         if (bytesInMessage > 0)
         {
-            MemoryBlock messageData ((size_t) bytesInMessage, true);
+            ReceiveBuffer* const buffer = receiveBufferPool->getBuffer ((size_t) bytesInMessage);
             int bytesRead = 0;
 
             while (bytesInMessage > 0)
             {
                 if (thread->threadShouldExit())
+                {
+                    receiveBufferPool->recycle (buffer);
                     return false;
+                }
 
                 const int numThisTime = jmin (bytesInMessage, 65536);
-                void* const data = addBytesToPointer (messageData.getData(), bytesRead);
+                void* const data = buffer->data + bytesRead;
 
                 const int bytesIn = socket != nullptr ? socket->read (data, numThisTime, true)
                                                       : pipe  ->read (data, numThisTime, -1);
@@ -308,8 +639,9 @@ bool InterprocessConnection::readNextMessageInt()
                 bytesInMessage -= bytesIn;
             }
 
-            if (bytesRead >= 0)
-                deliverDataInt (messageData);
+            // (if the message was cut short, the rest of it is delivered as zeros)
+            zeromem (buffer->data + bytesRead, buffer->size - (size_t) bytesRead);
+            deliverDataInt (buffer);
         }
     }
     else if (bytes < 0)
@@ -324,6 +656,39 @@ bool InterprocessConnection::readNextMessageInt()
     return true;
 }
 
+bool InterprocessConnection::readNextSharedMemoryMessageInt()
+{
+    size_t numBytes = 0;
+
+    if (const void* const data = sharedMemoryChannel->waitForNextMessage (numBytes, 100))
+    {
+        if (useMessageThread)
+        {
+            ReceiveBuffer* const buffer = receiveBufferPool->getBuffer (numBytes);
+            memcpy (buffer->data, data, numBytes);
+            sharedMemoryChannel->releaseMessage();
+            deliverDataInt (buffer);
+        }
+        else
+        {
+            // (the callback gets to look at the message where it is in the shared memory)
+            messageDataReceived (data, numBytes);
+            sharedMemoryChannel->releaseMessage();
+        }
+
+        return true;
+    }
+
+    if (sharedMemoryChannel->hasOtherEndDisconnected())
+    {
+        deletePipeAndSocket();
+        connectionLostInt();
+        return false;
+    }
+
+    return true;
+}
+
 void InterprocessConnection::runThread()
 {
     while (! thread->threadShouldExit())
@@ -345,6 +710,13 @@ void InterprocessConnection::runThread()
                 continue;
             }
         }
+        else if (sharedMemoryChannel != nullptr)
+        {
+            if (! readNextSharedMemoryMessageInt())
+                break;
+
+            continue;
+        }
         else if (pipe != nullptr)
         {
             if (! pipe->isOpen())
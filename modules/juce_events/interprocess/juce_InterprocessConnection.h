@@ -116,6 +116,44 @@ public:
     */
     bool createPipe (const String& pipeName, int pipeReceiveMessageTimeoutMs);
 
+    /** Tries to create a shared-memory channel for another process on this machine to
+        connect to.
+
+        This works like createPipe(), but the data is passed through a pair of ring
+        buffers in shared memory, which is much quicker than a pipe or socket. The
+        other process connects with connectToSharedMemoryChannel().
+
+        @param channelName          the name to use for the channel - this should be unique to your app
+        @param bufferSizeBytes      the size of the buffer used for each direction. A single
+                                    message can't be bigger than half of this.
+        @param writeTimeoutMs       how long sendMessage() will wait for space in the buffer if
+                                    the other end isn't reading fast enough, or -1 to wait forever
+        @see SharedMemoryChannel
+    */
+    bool createSharedMemoryChannel (const String& channelName, int bufferSizeBytes, int writeTimeoutMs);
+
+    /** Tries to connect to a shared-memory channel that another process has created
+        with createSharedMemoryChannel().
+
+        If the channel doesn't exist yet, this will keep trying for up to connectTimeoutMs.
+        @see createSharedMemoryChannel
+    */
+    bool connectToSharedMemoryChannel (const String& channelName, int connectTimeoutMs, int writeTimeoutMs);
+
+    /** Makes this connection use a shared SocketMultiplexer to read from its socket,
+        instead of starting a thread of its own.
+
+        When a process has many socket connections open, sharing one multiplexer between
+        them means that they all get serviced by a single thread. This must be called before
+        the connection is opened (for connections created by an InterprocessConnectionServer,
+        call it in your InterprocessConnectionServer::createConnectionObject() method), and
+        the multiplexer must not be deleted while the connection is open. Pass nullptr to go
+        back to using a dedicated thread.
+
+        Pipe connections always use their own thread.
+    */
+    void setSocketMultiplexer (SocketMultiplexer* multiplexerToUse);
+
     /** Disconnects and closes any currently-open sockets or pipes. */
     void disconnect();
 
@@ -128,6 +166,9 @@ public:
     /** Returns the pipe that this connection is using (or nullptr if it uses a socket). */
     NamedPipe* getPipe() const noexcept                         { return pipe; }
 
+    /** Returns the shared-memory channel that this connection is using, if there is one. */
+    SharedMemoryChannel* getSharedMemoryChannel() const noexcept    { return sharedMemoryChannel; }
+
     /** Returns the name of the machine at the other end of this connection.
         This may return an empty string if the name is unknown.
     */
@@ -144,6 +185,20 @@ public:
     */
     bool sendMessage (const MemoryBlock& message);
 
+    /** Sends a message containing a block of data.
+        This is the same as sendMessage (const MemoryBlock&), but saves you having to
+        put the data into a MemoryBlock first.
+    */
+    bool sendMessage (const void* messageData, size_t numBytes);
+
+    /** Sends a single message that's made up of several separate blocks of data.
+
+        The blocks are joined together in the order given, and the other end receives
+        them as one message. This avoids having to join the pieces together yourself
+        (e.g. a fixed header followed by a payload) before sending them.
+    */
+    bool sendMessage (const void* const* dataBlocks, const size_t* blockSizes, int numBlocks);
+
     //==============================================================================
     /** Called when the connection is first connected.
 
@@ -170,9 +225,24 @@ public:
         this will be called on the message thread; otherwise it will be called on a server
         thread.
 
-        @see sendMessage
+        You need to override either this method or messageDataReceived().
+
+        @see sendMessage, messageDataReceived
+    */
+    virtual void messageReceived (const MemoryBlock& message);
+
+    /** Called when a message arrives, with a temporary view of its data.
+
+        This is called on the same thread as messageReceived(), but rather than giving
+        you a MemoryBlock that was allocated for the message, the data is in a buffer that
+        gets re-used for later messages, so it's only valid until the method returns. If
+        you handle a lot of messages, overriding this instead of messageReceived() avoids
+        allocating any memory for each one.
+
+        The default implementation copies the data into a MemoryBlock and calls
+        messageReceived().
     */
-    virtual void messageReceived (const MemoryBlock& message) = 0;
+    virtual void messageDataReceived (const void* messageData, size_t numBytes);
 
 
 private:
@@ -182,26 +252,48 @@ private:
     CriticalSection pipeAndSocketLock;
     ScopedPointer <StreamingSocket> socket;
     ScopedPointer <NamedPipe> pipe;
+    ScopedPointer<SharedMemoryChannel> sharedMemoryChannel;
     bool callbackConnectionState;
     const bool useMessageThread;
     const uint32 magicMessageHeader;
     int pipeReceiveMessageTimeout;
+    MemoryBlock sendBuffer;
+    SocketMultiplexer* multiplexer;
+    bool socketIsMultiplexed;
 
     friend class InterprocessConnectionServer;
     void initialiseWithSocket (StreamingSocket*);
     void initialiseWithPipe (NamedPipe*);
+    void initialiseWithSharedMemoryChannel (SharedMemoryChannel*);
     void deletePipeAndSocket();
     void connectionMadeInt();
     void connectionLostInt();
-    void deliverDataInt (const MemoryBlock&);
+    struct ReceiveBuffer;
+    class ReceiveBufferPool;
+    friend class ReceiveBufferPool;
+    ReferenceCountedObjectPtr<ReceiveBufferPool> receiveBufferPool;
+
+    struct DataDeliveryMessage;
+    friend struct DataDeliveryMessage;
+
+    void deliverDataInt (ReceiveBuffer*);
     bool readNextMessageInt();
+    bool readNextSharedMemoryMessageInt();
 
     struct ConnectionThread;
     friend struct ConnectionThread;
     friend struct ContainerDeletePolicy<ConnectionThread>;
     ScopedPointer<ConnectionThread> thread;
     void runThread();
-    int writeData (void*, int);
+
+    struct MultiplexedReader;
+    friend struct MultiplexedReader;
+    friend struct ContainerDeletePolicy<MultiplexedReader>;
+    ScopedPointer<MultiplexedReader> multiplexedReader;
+
+    void startReading();
+    void multiplexedConnectionLost();
+    int writeData (const void*, int);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (InterprocessConnection)
 };
@@ -49,6 +49,7 @@
  #import <IOKit/hid/IOHIDLib.h>
  #import <IOKit/hid/IOHIDKeys.h>
  #import <IOKit/pwr_mgt/IOPMLib.h>
+ #import <CoreServices/CoreServices.h>
 
 #elif JUCE_LINUX
  #include <X11/Xlib.h>
@@ -56,6 +57,12 @@
  #include <X11/Xutil.h>
  #undef KeyPress
  #include <unistd.h>
+ #include <poll.h>
+ #include <sys/inotify.h>
+
+#elif JUCE_ANDROID
+ #include <poll.h>
+ #include <sys/inotify.h>
 #endif
 
 //==============================================================================
@@ -74,30 +81,39 @@ namespace juce
 #include "interprocess/juce_InterprocessConnection.cpp"
 #include "interprocess/juce_InterprocessConnectionServer.cpp"
 #include "interprocess/juce_ConnectedChildProcess.cpp"
+#include "network/juce_URLRequestQueue.cpp"
 
 //==============================================================================
 #if JUCE_MAC
  #include "../juce_core/native/juce_osx_ObjCHelpers.h"
  #include "native/juce_osx_MessageQueue.h"
  #include "native/juce_mac_MessageManager.mm"
+ #include "native/juce_mac_FileSystemWatcher.mm"
 
 #elif JUCE_IOS
  #include "../juce_core/native/juce_osx_ObjCHelpers.h"
  #include "native/juce_osx_MessageQueue.h"
  #include "native/juce_ios_MessageManager.mm"
+ #include "native/juce_ios_FileSystemWatcher.mm"
 
 #elif JUCE_WINDOWS
  #include "native/juce_win32_HiddenMessageWindow.h"
  #include "native/juce_win32_Messaging.cpp"
+ #include "native/juce_win32_FileSystemWatcher.cpp"
 
 #elif JUCE_LINUX
  #include "native/juce_ScopedXLock.h"
  #include "native/juce_linux_Messaging.cpp"
+ #include "native/juce_linux_FileSystemWatcher.cpp"
 
 #elif JUCE_ANDROID
  #include "../juce_core/native/juce_android_JNIHelpers.h"
  #include "native/juce_android_Messaging.cpp"
+ #include "native/juce_linux_FileSystemWatcher.cpp"
 
 #endif
 
+// (this needs to come after the native code, which defines the platform's FileSystemWatcher::Pimpl)
+#include "files/juce_FileSystemWatcher.cpp"
+
 }
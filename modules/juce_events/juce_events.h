@@ -51,6 +51,8 @@ namespace juce
 #include "interprocess/juce_InterprocessConnection.h"
 #include "interprocess/juce_InterprocessConnectionServer.h"
 #include "interprocess/juce_ConnectedChildProcess.h"
+#include "network/juce_URLRequestQueue.h"
+#include "files/juce_FileSystemWatcher.h"
 #include "native/juce_ScopedXLock.h"
 
 }
@@ -30,6 +30,10 @@ MessageManager::MessageManager() noexcept
 {
     if (JUCEApplicationBase::isStandaloneApp())
         Thread::setCurrentThreadName ("Juce Message Thread");
+
+   #if JUCE_ENABLE_TRACING
+    Tracer::setCurrentThreadName ("Message Thread");
+   #endif
 }
 
 MessageManager::~MessageManager() noexcept
@@ -70,15 +74,43 @@ bool MessageManager::MessageBase::post()
 {
     MessageManager* const mm = MessageManager::instance;
 
-    if (mm == nullptr || mm->quitMessagePosted || ! postMessageToSystemQueue (this))
+    if (mm == nullptr || mm->quitMessagePosted)
     {
         Ptr deleter (this); // (this will delete messages that were just created with a 0 ref count)
         return false;
     }
 
+    // (the count is bumped before posting, as the message may be delivered before this returns)
+    const int numPending = ++(mm->numPendingMessages);
+
+    for (int peak = mm->peakNumPendingMessages.get(); numPending > peak; peak = mm->peakNumPendingMessages.get())
+        if (mm->peakNumPendingMessages.compareAndSetBool (numPending, peak))
+            break;
+
+    // (the message's address links the post to its delivery in a trace)
+    JUCE_TRACE_FLOW_START ("events", "MessageManager::postMessage", (pointer_sized_uint) this);
+
+    if (! postMessageToSystemQueue (this))
+    {
+        --(mm->numPendingMessages);
+        Ptr deleter (this);
+        return false;
+    }
+
     return true;
 }
 
+void MessageManager::deliverMessage (MessageBase& message)
+{
+    if (instance != nullptr)
+        --(instance->numPendingMessages);
+
+    JUCE_TRACE_ZONE_FOR_OBJECT ("events", "MessageManager::deliverMessage", message);
+    JUCE_TRACE_FLOW_END ("events", "MessageManager::postMessage", (pointer_sized_uint) &message);
+
+    message.messageCallback();
+}
+
 //==============================================================================
 #if JUCE_MODAL_LOOPS_PERMITTED && ! (JUCE_MAC || JUCE_IOS)
 bool MessageManager::runDispatchLoopUntil (int millisecondsToRunFor)
@@ -292,6 +324,8 @@ MessageManagerLock::MessageManagerLock (ThreadPoolJob* const jobToCheckForExitSi
 
 bool MessageManagerLock::attemptLock (Thread* const threadToCheck, ThreadPoolJob* const job)
 {
+    JUCE_ASSERT_NOT_REALTIME ("MessageManagerLock");
+
     MessageManager* const mm = MessageManager::instance;
 
     if (mm == nullptr)
@@ -165,6 +165,22 @@ public:
     /** Deregisters a broadcast listener. */
     void deregisterBroadcastListener (ActionListener* listener);
 
+    //==============================================================================
+    /** Returns the number of messages that have been posted but not yet delivered.
+        This can be called from any thread, and is intended for instrumentation - e.g. to
+        spot code that's flooding the message queue with callAsync() or AsyncUpdater calls.
+        @see getPeakNumPendingMessages
+    */
+    int getNumPendingMessages() const noexcept              { return numPendingMessages.get(); }
+
+    /** Returns the largest value that getNumPendingMessages() has reached since the
+        MessageManager was created or resetPeakNumPendingMessages() was last called.
+    */
+    int getPeakNumPendingMessages() const noexcept          { return peakNumPendingMessages.get(); }
+
+    /** Resets the value returned by getPeakNumPendingMessages() to the current queue size. */
+    void resetPeakNumPendingMessages() noexcept             { peakNumPendingMessages = numPendingMessages.get(); }
+
     //==============================================================================
     /** Internal class used as the base class for all message objects.
         You shouldn't need to use this directly - see the CallbackMessage or Message
@@ -188,6 +204,7 @@ public:
    #ifndef DOXYGEN
     // Internal methods - do not use!
     void deliverBroadcastMessage (const String&);
+    static void deliverMessage (MessageBase&);
     ~MessageManager() noexcept;
    #endif
 
@@ -207,6 +224,7 @@ private:
     Thread::ThreadID messageThreadId;
     Thread::ThreadID volatile threadWithLock;
     CriticalSection lockingLock;
+    Atomic<int> numPendingMessages, peakNumPendingMessages;
 
     static bool postMessageToSystemQueue (MessageBase*);
     static void* exitModalLoopCallback (void*);
@@ -47,7 +47,7 @@ JUCE_JNI_CALLBACK (JUCE_ANDROID_ACTIVITY_CLASSNAME, deliverMessage, void, (JNIEn
     JUCE_TRY
     {
         MessageManager::MessageBase* const message = (MessageManager::MessageBase*) (pointer_sized_uint) value;
-        message->messageCallback();
+        MessageManager::deliverMessage (*message);
         message->decReferenceCount();
     }
     JUCE_CATCH_EXCEPTION
@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+// iOS has no API for watching folders, so this just rescans them every second, and
+// compares the results with the previous scan.
+class FileSystemWatcher::Pimpl   : private Thread
+{
+public:
+    Pimpl (FileSystemWatcher& o, const File& f, const bool recursive)
+        : Thread ("FileSystemWatcher"),
+          folder (f), owner (o), watchSubfolders (recursive),
+          pool (1), scanner (&pool)
+    {
+        if (scanner.scan (folder, true).wasOk())
+            startThread (2);
+    }
+
+    ~Pimpl()
+    {
+        scanner.cancel();
+        stopThread (5000);
+    }
+
+    bool isValid() const        { return isThreadRunning(); }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wait (1000);
+
+            if (threadShouldExit())
+                break;
+
+            if (! folder.isDirectory())
+            {
+                owner.addChange (folder, fileDeleted);
+                break;
+            }
+
+            if (scanner.scan (folder, true).wasOk())
+            {
+                Array<File> added, removed, modified;
+                scanner.getChangesFromLastScan (added, removed, modified);
+
+                reportChanges (added, fileCreated);
+                reportChanges (removed, fileDeleted);
+                reportChanges (modified, fileModified);
+            }
+        }
+    }
+
+    const File folder;
+
+private:
+    FileSystemWatcher& owner;
+    const bool watchSubfolders;
+    ThreadPool pool;
+    DirectoryScanner scanner;
+
+    void reportChanges (const Array<File>& files, const ChangeType type)
+    {
+        for (int i = 0; i < files.size(); ++i)
+            if (watchSubfolders || files.getReference(i).getParentDirectory() == folder)
+                owner.addChange (files.getReference(i), type);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Pimpl)
+};
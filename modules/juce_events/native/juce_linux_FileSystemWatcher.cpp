@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+class FileSystemWatcher::Pimpl   : private Thread
+{
+public:
+    Pimpl (FileSystemWatcher& o, const File& f, const bool recursive)
+        : Thread ("FileSystemWatcher"),
+          folder (f), owner (o), watchSubfolders (recursive),
+          fd (inotify_init())
+    {
+        if (fd >= 0)
+        {
+            addWatch (folder, false);
+            startThread();
+        }
+    }
+
+    ~Pimpl()
+    {
+        stopThread (2000);
+
+        if (fd >= 0)
+            close (fd);
+    }
+
+    bool isValid() const noexcept       { return fd >= 0 && watchedPaths.size() > 0; }
+
+    void run() override
+    {
+        // (the buffer must be able to hold at least one event with the longest possible name)
+        const int bufferSize = 32 * (int) (sizeof (struct inotify_event) + NAME_MAX + 1);
+        HeapBlock<char> buffer ((size_t) bufferSize);
+
+        while (! threadShouldExit())
+        {
+            struct pollfd pfd;
+            pfd.fd = fd;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+
+            if (poll (&pfd, 1, 100) <= 0)
+                continue;
+
+            const ssize_t numBytes = read (fd, buffer, (size_t) bufferSize);
+
+            for (ssize_t pos = 0; pos + (ssize_t) sizeof (struct inotify_event) <= numBytes;)
+            {
+                const struct inotify_event* const e = reinterpret_cast<const struct inotify_event*> (buffer + pos);
+                handleEvent (*e);
+                pos += (ssize_t) sizeof (struct inotify_event) + (ssize_t) e->len;
+            }
+        }
+    }
+
+    const File folder;
+
+private:
+    FileSystemWatcher& owner;
+    const bool watchSubfolders;
+    const int fd;
+    HashMap<int, String> watchedPaths;
+
+    enum { watchMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO
+                        | IN_DELETE_SELF | IN_MOVE_SELF };
+
+    void addWatch (const File& dir, const bool reportContents)
+    {
+        const int wd = inotify_add_watch (fd, dir.getFullPathName().toUTF8(), watchMask);
+
+        if (wd < 0)
+            return;
+
+        watchedPaths.set (wd, dir.getFullPathName());
+
+        // Anything that was put into a new folder before the watch was added would otherwise
+        // be missed, so its contents are reported as new.
+        if (watchSubfolders || reportContents)
+        {
+            DirectoryIterator iter (dir, false, "*", File::findFilesAndDirectories);
+            bool isDir;
+
+            while (iter.next (&isDir, nullptr, nullptr, nullptr, nullptr, nullptr))
+            {
+                if (reportContents)
+                    owner.addChange (iter.getFile(), fileCreated);
+
+                if (isDir && watchSubfolders)
+                    addWatch (iter.getFile(), reportContents);
+            }
+        }
+    }
+
+    void removeWatchesInside (const String& path)
+    {
+        const String prefix (File::addTrailingSeparator (path));
+
+        for (HashMap<int, String>::Iterator i (watchedPaths); i.next();)
+            if (i.getValue() == path || i.getValue().startsWith (prefix))
+                inotify_rm_watch (fd, i.getKey());
+    }
+
+    void handleEvent (const struct inotify_event& e)
+    {
+        if ((e.mask & IN_Q_OVERFLOW) != 0)
+        {
+            owner.addChange (folder, folderNeedsRescan);
+            return;
+        }
+
+        if ((e.mask & IN_IGNORED) != 0)
+        {
+            watchedPaths.remove (e.wd);
+            return;
+        }
+
+        const String dirPath (watchedPaths [e.wd]);
+
+        if (dirPath.isEmpty())
+            return;
+
+        if ((e.mask & (IN_DELETE_SELF | IN_MOVE_SELF)) != 0)
+        {
+            // (a subfolder's removal is reported by its parent's watch)
+            if (dirPath == folder.getFullPathName())
+                owner.addChange (folder, fileDeleted);
+
+            return;
+        }
+
+        const File file (e.len == 0 ? File::createFileWithoutCheckingPath (dirPath)
+                                    : File::createFileWithoutCheckingPath (File::addTrailingSeparator (dirPath)
+                                                                            + String (CharPointer_UTF8 (e.name))));
+
+        if ((e.mask & (IN_CREATE | IN_MOVED_TO)) != 0)
+        {
+            owner.addChange (file, fileCreated);
+
+            if ((e.mask & IN_ISDIR) != 0 && watchSubfolders)
+                addWatch (file, true);
+        }
+        else if ((e.mask & (IN_DELETE | IN_MOVED_FROM)) != 0)
+        {
+            owner.addChange (file, fileDeleted);
+
+            // If a folder has been moved somewhere else, its watches would now report the wrong
+            // paths. (If it's been moved within the watched tree, they'll be added again when
+            // its new name is reported).
+            if ((e.mask & (IN_ISDIR | IN_MOVED_FROM)) == (IN_ISDIR | IN_MOVED_FROM))
+                removeWatchesInside (file.getFullPathName());
+        }
+        else
+        {
+            owner.addChange (file, fileModified);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Pimpl)
+};
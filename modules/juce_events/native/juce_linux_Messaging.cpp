@@ -41,19 +41,31 @@ ScopedXLock::ScopedXLock()       { if (display != nullptr) XLockDisplay (display
 ScopedXLock::~ScopedXLock()      { if (display != nullptr) XUnlockDisplay (display); }
 
 //==============================================================================
+/*  Messages are posted onto a lock-free stack that any thread can push to, and the message
+    thread takes the whole stack in one go and delivers it in posting order. A byte is only
+    written to the wake-up socket when a post finds the queue empty, so a thread that posts
+    lots of messages doesn't pay for a lock and a syscall on each one.
+*/
 class InternalMessageQueue
 {
 public:
     InternalMessageQueue()
-        : bytesInSocket (0),
+        : batch (nullptr),
           totalEventCount (0)
     {
         int ret = ::socketpair (AF_LOCAL, SOCK_STREAM, 0, fd);
         (void) ret; jassert (ret == 0);
+
+        // (if the socket's buffer is ever full, a wake-up is already pending, so a failed write can be ignored)
+        setNonBlocking (fd[0]);
+        setNonBlocking (fd[1]);
     }
 
     ~InternalMessageQueue()
     {
+        deleteMessages (batch);
+        deleteMessages (incoming.exchange (nullptr));
+
         close (fd[0]);
         close (fd[1]);
 
@@ -63,26 +75,27 @@ public:
     //==============================================================================
     void postMessage (MessageManager::MessageBase* const msg)
     {
-        const int maxBytesInSocketQueue = 128;
+        QueuedMessage* const item = new QueuedMessage (msg);
 
-        ScopedLock sl (lock);
-        queue.add (msg);
-
-        if (bytesInSocket < maxBytesInSocketQueue)
+        for (;;)
         {
-            ++bytesInSocket;
+            QueuedMessage* const oldHead = incoming.get();
+            item->next = oldHead;
 
-            ScopedUnlock ul (lock);
-            const unsigned char x = 0xff;
-            size_t bytesWritten = write (fd[0], &x, 1);
-            (void) bytesWritten;
+            if (incoming.compareAndSetBool (item, oldHead))
+            {
+                // if the queue wasn't empty, a wake-up has already been sent and not yet handled
+                if (oldHead == nullptr)
+                    wakeUp();
+
+                return;
+            }
         }
     }
 
     bool isEmpty() const
     {
-        ScopedLock sl (lock);
-        return queue.size() == 0;
+        return batch == nullptr && incoming.get() == nullptr;
     }
 
     bool dispatchNextEvent()
@@ -127,6 +140,10 @@ public:
         }
 
         const int ret = select (fdmax + 1, &readset, 0, 0, &tv);
+
+        if (ret > 0 && FD_ISSET (fd0, &readset))
+            clearWakeUps();
+
         return (ret > 0); // ret <= 0 if error or timeout
     }
 
@@ -134,10 +151,17 @@ public:
     juce_DeclareSingleton_SingleThreaded_Minimal (InternalMessageQueue)
 
 private:
-    CriticalSection lock;
-    ReferenceCountedArray <MessageManager::MessageBase> queue;
+    struct QueuedMessage
+    {
+        QueuedMessage (MessageManager::MessageBase* m) noexcept  : message (m), next (nullptr) {}
+
+        MessageManager::MessageBase::Ptr message;
+        QueuedMessage* next;
+    };
+
+    Atomic<QueuedMessage*> incoming;  // pushed by any thread, newest first
+    QueuedMessage* batch;             // only touched by the message thread, oldest first
     int fd[2];
-    int bytesInSocket;
     int totalEventCount;
 
     int getWaitHandle() const noexcept      { return fd[1]; }
@@ -152,6 +176,30 @@ private:
         return fcntl (handle, F_SETFL, socketFlags) == 0;
     }
 
+    static void deleteMessages (QueuedMessage* item)
+    {
+        while (item != nullptr)
+        {
+            QueuedMessage* const next = item->next;
+            delete item;
+            item = next;
+        }
+    }
+
+    void wakeUp()
+    {
+        const unsigned char x = 0xff;
+        ssize_t bytesWritten = write (fd[0], &x, 1);
+        (void) bytesWritten;
+    }
+
+    void clearWakeUps()
+    {
+        unsigned char buffer[32];
+        while (read (fd[1], buffer, sizeof (buffer)) > 0)
+        {}
+    }
+
     static bool dispatchNextXEvent()
     {
         if (display == nullptr)
@@ -176,21 +224,41 @@ private:
         return true;
     }
 
-    MessageManager::MessageBase::Ptr popNextMessage()
+    void takeNextBatch()
     {
-        const ScopedLock sl (lock);
+        if (incoming.get() == nullptr)
+            return;
+
+        // (the wake-ups are cleared before taking the messages, so that a post which arrives
+        // after this finds the queue empty and sends a fresh one)
+        clearWakeUps();
 
-        if (bytesInSocket > 0)
+        QueuedMessage* item = incoming.exchange (nullptr);
+
+        while (item != nullptr)
         {
-            --bytesInSocket;
+            QueuedMessage* const next = item->next;
+            item->next = batch;
+            batch = item;
+            item = next;
+        }
+    }
+
+    MessageManager::MessageBase::Ptr popNextMessage()
+    {
+        if (batch == nullptr)
+            takeNextBatch();
 
-            const ScopedUnlock ul (lock);
-            unsigned char x;
-            size_t numBytes = read (fd[1], &x, 1);
-            (void) numBytes;
+        MessageManager::MessageBase::Ptr msg;
+
+        if (QueuedMessage* const item = batch)
+        {
+            batch = item->next;
+            msg = item->message;
+            delete item;
         }
 
-        return queue.removeAndReturn (0);
+        return msg;
     }
 
     bool dispatchNextInternalMessage()
@@ -199,7 +267,7 @@ private:
         {
             JUCE_TRY
             {
-                msg->messageCallback();
+                MessageManager::deliverMessage (*msg);
                 return true;
             }
             JUCE_CATCH_EXCEPTION
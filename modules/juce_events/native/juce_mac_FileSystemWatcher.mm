@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#if defined (MAC_OS_X_VERSION_10_7) && MAC_OS_X_VERSION_MIN_REQUIRED >= MAC_OS_X_VERSION_10_7
+ #define JUCE_USE_FSEVENTS_FILE_EVENTS 1
+#endif
+
+class FileSystemWatcher::Pimpl
+{
+public:
+    Pimpl (FileSystemWatcher& o, const File& f, const bool recursive)
+        : folder (f), owner (o), watchSubfolders (recursive), stream (nullptr)
+    {
+        JUCE_AUTORELEASEPOOL
+        {
+            NSArray* paths = [NSArray arrayWithObject: juceStringToNS (folder.getFullPathName())];
+
+            FSEventStreamContext context = { 0, this, nullptr, nullptr, nullptr };
+            FSEventStreamCreateFlags flags = kFSEventStreamCreateFlagNoDefer | kFSEventStreamCreateFlagWatchRoot;
+
+           #if JUCE_USE_FSEVENTS_FILE_EVENTS
+            flags |= kFSEventStreamCreateFlagFileEvents;
+           #endif
+
+            // (the events are delivered on the main run loop, so they arrive on the message thread)
+            stream = FSEventStreamCreate (kCFAllocatorDefault, eventCallback, &context, (CFArrayRef) paths,
+                                          kFSEventStreamEventIdSinceNow, 0.05, flags);
+
+            if (stream != nullptr)
+            {
+                FSEventStreamScheduleWithRunLoop (stream, CFRunLoopGetMain(), kCFRunLoopDefaultMode);
+
+                if (! FSEventStreamStart (stream))
+                    releaseStream();
+            }
+        }
+    }
+
+    ~Pimpl()
+    {
+        releaseStream();
+    }
+
+    bool isValid() const noexcept       { return stream != nullptr; }
+
+    const File folder;
+
+private:
+    FileSystemWatcher& owner;
+    const bool watchSubfolders;
+    FSEventStreamRef stream;
+
+    void releaseStream()
+    {
+        if (stream != nullptr)
+        {
+            FSEventStreamStop (stream);
+            FSEventStreamInvalidate (stream);
+            FSEventStreamRelease (stream);
+            stream = nullptr;
+        }
+    }
+
+    static void eventCallback (ConstFSEventStreamRef, void* info, size_t numEvents, void* eventPaths,
+                               const FSEventStreamEventFlags* eventFlags, const FSEventStreamEventId*)
+    {
+        Pimpl* const p = static_cast<Pimpl*> (info);
+        const char* const* const paths = static_cast<const char* const*> (eventPaths);
+
+        for (size_t i = 0; i < numEvents; ++i)
+            p->handleEvent (File (String (CharPointer_UTF8 (paths[i]))), eventFlags[i]);
+    }
+
+    void handleEvent (const File& file, const FSEventStreamEventFlags flags)
+    {
+        if (! (watchSubfolders || file == folder || file.getParentDirectory() == folder))
+            return;
+
+        if ((flags & kFSEventStreamEventFlagRootChanged) != 0)
+        {
+            owner.addChange (folder, folder.isDirectory() ? folderNeedsRescan : fileDeleted);
+            return;
+        }
+
+        if ((flags & (kFSEventStreamEventFlagMustScanSubDirs
+                       | kFSEventStreamEventFlagUserDropped
+                       | kFSEventStreamEventFlagKernelDropped)) != 0)
+        {
+            owner.addChange (file, folderNeedsRescan);
+            return;
+        }
+
+       #if JUCE_USE_FSEVENTS_FILE_EVENTS
+        // The flags can describe several things that have happened to the file since the
+        // last event, so whether it still exists is what decides how to report it.
+        if (! file.exists())
+            owner.addChange (file, fileDeleted);
+        else if ((flags & (kFSEventStreamEventFlagItemCreated | kFSEventStreamEventFlagItemRenamed)) != 0)
+            owner.addChange (file, fileCreated);
+        else
+            owner.addChange (file, fileModified);
+       #else
+        // Before 10.7, FSEvents only says which folders have changed, not which files.
+        owner.addChange (file, folderNeedsRescan);
+       #endif
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Pimpl)
+};
@@ -76,7 +76,7 @@ private:
         {
             JUCE_TRY
             {
-                nextMessage->messageCallback();
+                MessageManager::deliverMessage (*nextMessage);
             }
             JUCE_CATCH_EXCEPTION
         }
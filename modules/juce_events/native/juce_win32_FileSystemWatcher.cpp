@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+class FileSystemWatcher::Pimpl   : private Thread
+{
+public:
+    Pimpl (FileSystemWatcher& o, const File& f, const bool recursive)
+        : Thread ("FileSystemWatcher"),
+          folder (f), owner (o), watchSubfolders (recursive),
+          directoryHandle (CreateFile (folder.getFullPathName().toWideCharPointer(), FILE_LIST_DIRECTORY,
+                                       FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, 0, OPEN_EXISTING,
+                                       FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, 0)),
+          ioEvent (CreateEvent (0, TRUE, FALSE, 0)),
+          stopEvent (CreateEvent (0, TRUE, FALSE, 0))
+    {
+        if (isValid())
+            startThread();
+    }
+
+    ~Pimpl()
+    {
+        signalThreadShouldExit();
+        SetEvent (stopEvent);
+        stopThread (5000);
+
+        if (directoryHandle != INVALID_HANDLE_VALUE)
+            CloseHandle (directoryHandle);
+
+        CloseHandle (ioEvent);
+        CloseHandle (stopEvent);
+    }
+
+    bool isValid() const noexcept
+    {
+        return directoryHandle != INVALID_HANDLE_VALUE && ioEvent != 0 && stopEvent != 0;
+    }
+
+    void run() override
+    {
+        // (the results are a chain of DWORD-aligned structures, and network shares can't
+        // return more than 64K at a time)
+        const DWORD bufferSize = 65536;
+        HeapBlock<DWORD> buffer (bufferSize / sizeof (DWORD));
+        const String parentPath (File::addTrailingSeparator (folder.getFullPathName()));
+
+        while (! threadShouldExit())
+        {
+            OVERLAPPED overlapped = { 0 };
+            overlapped.hEvent = ioEvent;
+            ResetEvent (ioEvent);
+
+            if (! ReadDirectoryChangesW (directoryHandle, buffer, bufferSize, watchSubfolders ? TRUE : FALSE,
+                                         FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME
+                                           | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE
+                                           | FILE_NOTIFY_CHANGE_ATTRIBUTES | FILE_NOTIFY_CHANGE_CREATION,
+                                         0, &overlapped, 0))
+            {
+                // (this happens if the folder has been deleted)
+                owner.addChange (folder, fileDeleted);
+                break;
+            }
+
+            HANDLE handles[] = { ioEvent, stopEvent };
+
+            if (WaitForMultipleObjects (2, handles, FALSE, INFINITE) != WAIT_OBJECT_0)
+            {
+                DWORD unused;
+                CancelIo (directoryHandle);
+                GetOverlappedResult (directoryHandle, &overlapped, &unused, TRUE);
+                break;
+            }
+
+            DWORD numBytes = 0;
+
+            if (! GetOverlappedResult (directoryHandle, &overlapped, &numBytes, FALSE))
+                break;
+
+            // A result with no data means that the buffer overflowed, and the changes were lost.
+            if (numBytes == 0)
+            {
+                owner.addChange (folder, folderNeedsRescan);
+                continue;
+            }
+
+            const char* data = reinterpret_cast<const char*> (buffer.getData());
+
+            for (;;)
+            {
+                const FILE_NOTIFY_INFORMATION* const info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*> (data);
+                const File file (parentPath + String (info->FileName, info->FileNameLength / sizeof (WCHAR)));
+
+                switch (info->Action)
+                {
+                    case FILE_ACTION_ADDED:
+                    case FILE_ACTION_RENAMED_NEW_NAME:  owner.addChange (file, fileCreated); break;
+                    case FILE_ACTION_REMOVED:
+                    case FILE_ACTION_RENAMED_OLD_NAME:  owner.addChange (file, fileDeleted); break;
+                    default:                            owner.addChange (file, fileModified); break;
+                }
+
+                if (info->NextEntryOffset == 0)
+                    break;
+
+                data += info->NextEntryOffset;
+            }
+        }
+    }
+
+    const File folder;
+
+private:
+    FileSystemWatcher& owner;
+    const bool watchSubfolders;
+    HANDLE directoryHandle, ioEvent, stopEvent;
+
+    JUCE_DECLARE_NON_COPYABLE (Pimpl)
+};
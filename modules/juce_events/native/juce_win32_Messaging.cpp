@@ -42,7 +42,7 @@ namespace WindowsMessageHelpers
 
         JUCE_TRY
         {
-            message->messageCallback();
+            MessageManager::deliverMessage (*message);
         }
         JUCE_CATCH_EXCEPTION
 
@@ -0,0 +1,319 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+struct URLRequestQueue::Request
+{
+    Request (int requestId, const URL& u, Callback* cb, bool post, const String& extraHeaders, int timeout)
+        : id (requestId), url (u), callback (cb), usePost (post),
+          headers (extraHeaders), timeOutMs (timeout), host (u.getDomain()),
+          isRunning (false), isFinished (false), isCancelled (false)
+    {}
+
+    const int id;
+    const URL url;
+    ScopedPointer<Callback> callback;
+    const bool usePost;
+    const String headers;
+    const int timeOutMs;
+    const String host;
+    bool isRunning, isFinished, isCancelled;
+
+    JUCE_DECLARE_NON_COPYABLE (Request)
+};
+
+//==============================================================================
+class URLRequestQueue::Worker  : public Thread
+{
+public:
+    Worker (URLRequestQueue& q)  : Thread ("URL request"), owner (q) {}
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            if (Request* const r = owner.getNextRequestToRun())
+                owner.runRequest (*r);
+            else
+                owner.requestAdded.wait (500);
+        }
+    }
+
+private:
+    URLRequestQueue& owner;
+
+    JUCE_DECLARE_NON_COPYABLE (Worker)
+};
+
+//==============================================================================
+struct URLRequestQueue::ResultMessage  : public CallbackMessage
+{
+    ResultMessage (URLRequestQueue& q, int requestId, const Result& r)
+        : owner (&q), id (requestId), result (r)
+    {}
+
+    void messageCallback() override
+    {
+        if (URLRequestQueue* const q = owner)
+            q->deliverResult (id, result);
+    }
+
+    WeakReference<URLRequestQueue> owner;
+    const int id;
+    const Result result;
+
+    JUCE_DECLARE_NON_COPYABLE (ResultMessage)
+};
+
+//==============================================================================
+URLRequestQueue::URLRequestQueue (const int maxSimultaneous, const int maxPerHost, const bool callbacksOnMessageThread)
+    : maxSimultaneousRequests (jmax (1, maxSimultaneous)),
+      maxRequestsPerHost (jmax (1, maxPerHost)),
+      useMessageThread (callbacksOnMessageThread),
+      lastRequestId (0), numIdleWorkers (0)
+{
+}
+
+URLRequestQueue::~URLRequestQueue()
+{
+    cancelAllRequests();
+
+    for (int i = workers.size(); --i >= 0;)
+        workers.getUnchecked(i)->signalThreadShouldExit();
+
+    requestAdded.signal();
+
+    for (int i = workers.size(); --i >= 0;)
+        workers.getUnchecked(i)->stopThread (10000);
+
+    workers.clear();
+    requests.clear();
+    masterReference.clear();
+}
+
+//==============================================================================
+int URLRequestQueue::addRequest (const URL& url, Callback* const callback, const bool usePostCommand,
+                                 const String& extraHeaders, const int timeOutMs)
+{
+    const ScopedLock sl (lock);
+
+    const int requestId = ++lastRequestId;
+    requests.add (new Request (requestId, url, callback, usePostCommand, extraHeaders, timeOutMs));
+
+    // (threads are only started when there's nothing idle to pick the request up)
+    if (numIdleWorkers == 0 && workers.size() < maxSimultaneousRequests)
+    {
+        Worker* const w = workers.add (new Worker (*this));
+        ++numIdleWorkers;
+        w->startThread();
+    }
+
+    requestAdded.signal();
+    return requestId;
+}
+
+bool URLRequestQueue::cancelRequest (const int requestId)
+{
+    ScopedPointer<Request> requestToDelete;
+
+    {
+        const ScopedLock sl (lock);
+        const int index = indexOfRequest (requestId);
+
+        if (index < 0)
+            return false;
+
+        Request* const r = requests.getUnchecked (index);
+
+        if (r->isRunning)
+        {
+            // (the worker that's running it will delete it when it has finished)
+            r->isCancelled = true;
+            return true;
+        }
+
+        requestToDelete = requests.removeAndReturn (index);
+    }
+
+    return true;
+}
+
+void URLRequestQueue::cancelAllRequests()
+{
+    OwnedArray<Request> requestsToDelete;
+
+    {
+        const ScopedLock sl (lock);
+
+        for (int i = requests.size(); --i >= 0;)
+        {
+            Request* const r = requests.getUnchecked (i);
+
+            if (r->isRunning)
+                r->isCancelled = true;
+            else
+                requestsToDelete.add (requests.removeAndReturn (i));
+        }
+    }
+}
+
+int URLRequestQueue::getNumPendingRequests() const
+{
+    const ScopedLock sl (lock);
+    int num = 0;
+
+    for (int i = requests.size(); --i >= 0;)
+        if (! (requests.getUnchecked(i)->isFinished || requests.getUnchecked(i)->isCancelled))
+            ++num;
+
+    return num;
+}
+
+int URLRequestQueue::indexOfRequest (const int requestId) const noexcept
+{
+    for (int i = requests.size(); --i >= 0;)
+        if (requests.getUnchecked(i)->id == requestId)
+            return i;
+
+    return -1;
+}
+
+//==============================================================================
+URLRequestQueue::Request* URLRequestQueue::getNextRequestToRun()
+{
+    const ScopedLock sl (lock);
+
+    for (int i = 0; i < requests.size(); ++i)
+    {
+        Request* const r = requests.getUnchecked (i);
+
+        if (! (r->isRunning || r->isFinished) && numRequestsPerHost [r->host] < maxRequestsPerHost)
+        {
+            r->isRunning = true;
+            numRequestsPerHost.set (r->host, numRequestsPerHost [r->host] + 1);
+            --numIdleWorkers;
+            return r;
+        }
+    }
+
+    return nullptr;
+}
+
+void URLRequestQueue::runRequest (Request& r)
+{
+    Result result;
+    result.url = r.url;
+    result.succeeded = false;
+    result.statusCode = 0;
+
+    ScopedPointer<InputStream> in (r.url.createInputStream (r.usePost, nullptr, nullptr, r.headers, r.timeOutMs,
+                                                            &result.responseHeaders, &result.statusCode));
+
+    if (in != nullptr)
+    {
+        MemoryOutputStream body (result.data, false);
+        HeapBlock<char> buffer (16384);
+
+        for (;;)
+        {
+            {
+                const ScopedLock sl (lock);
+
+                if (r.isCancelled)
+                    break;
+            }
+
+            const int numRead = in->read (buffer, 16384);
+
+            if (numRead <= 0)
+            {
+                result.succeeded = in->isExhausted();
+                break;
+            }
+
+            body.write (buffer, (size_t) numRead);
+        }
+    }
+
+    requestFinished (r, result);
+}
+
+void URLRequestQueue::requestFinished (Request& r, Result& result)
+{
+    ScopedPointer<Request> requestToDeliver, cancelledRequest;
+
+    {
+        const ScopedLock sl (lock);
+
+        const int hostCount = numRequestsPerHost [r.host] - 1;
+
+        if (hostCount > 0)
+            numRequestsPerHost.set (r.host, hostCount);
+        else
+            numRequestsPerHost.remove (r.host);
+
+        ++numIdleWorkers;
+        r.isRunning = false;
+        r.isFinished = true;
+
+        const int index = requests.indexOf (&r);
+
+        if (r.isCancelled)
+        {
+            cancelledRequest = requests.removeAndReturn (index);
+        }
+        else if (useMessageThread)
+        {
+            // (the request stays in the list until its result is delivered, so that it can still be cancelled)
+            (new ResultMessage (*this, r.id, result))->post();
+        }
+        else
+        {
+            requestToDeliver = requests.removeAndReturn (index);
+        }
+    }
+
+    // (a host that was at its limit may have requests waiting)
+    requestAdded.signal();
+
+    if (requestToDeliver != nullptr && requestToDeliver->callback != nullptr)
+        requestToDeliver->callback->requestFinished (result);
+}
+
+void URLRequestQueue::deliverResult (const int requestId, const Result& result)
+{
+    ScopedPointer<Request> request;
+
+    {
+        const ScopedLock sl (lock);
+        const int index = indexOfRequest (requestId);
+
+        if (index < 0)
+            return;
+
+        request = requests.removeAndReturn (index);
+    }
+
+    if (request->callback != nullptr)
+        request->callback->requestFinished (result);
+}
@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_URLREQUESTQUEUE_H_INCLUDED
+#define JUCE_URLREQUESTQUEUE_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Runs URL requests on a set of background threads, and calls you back with
+    the results when they've finished.
+
+    Requests are started in the order they're added, but no more than a fixed number
+    run at once, and there's a separate limit on how many can be talking to the same
+    host at once. Where the platform's HTTP implementation keeps connections alive
+    between requests (see URL::createInputStream()), later requests to a host will
+    re-use the connections of earlier ones rather than connecting again.
+
+    e.g.
+    @code
+    struct VersionCheck  : public URLRequestQueue::Callback
+    {
+        void requestFinished (const URLRequestQueue::Result& result) override
+        {
+            if (result.succeeded && result.statusCode == 200)
+                showLatestVersion (result.data.toString());
+        }
+    };
+
+    requestQueue.addRequest (URL ("http://www.example.com/version"), new VersionCheck());
+    @endcode
+
+    @see URL
+*/
+class JUCE_API  URLRequestQueue
+{
+public:
+    //==============================================================================
+    /** Creates a queue.
+
+        @param maxSimultaneousRequests      the largest number of requests that can be running
+                                            at once (and the number of threads the queue can use)
+        @param maxRequestsPerHost           the largest number of requests that can be talking
+                                            to the same host at once
+        @param callbacksOnMessageThread     if true, your callbacks will be made on the message
+                                            thread; if false, they'll be made on the thread that
+                                            ran the request
+    */
+    URLRequestQueue (int maxSimultaneousRequests = 8,
+                     int maxRequestsPerHost = 4,
+                     bool callbacksOnMessageThread = true);
+
+    /** Destructor.
+        Any requests that haven't finished are cancelled.
+    */
+    ~URLRequestQueue();
+
+    //==============================================================================
+    /** The outcome of a request. */
+    struct Result
+    {
+        /** The URL that was requested. */
+        URL url;
+
+        /** True if the request was sent and its response was read. */
+        bool succeeded;
+
+        /** The HTTP status code of the response, or 0 if it failed. */
+        int statusCode;
+
+        /** The headers of the response. */
+        StringPairArray responseHeaders;
+
+        /** The body of the response. */
+        MemoryBlock data;
+    };
+
+    /** Receives the result of a request.
+        @see addRequest
+    */
+    class JUCE_API  Callback
+    {
+    public:
+        /** Destructor. */
+        virtual ~Callback() {}
+
+        /** Called when the request has finished, whether it succeeded or not. */
+        virtual void requestFinished (const Result& result) = 0;
+    };
+
+    //==============================================================================
+    /** Adds a request to the queue.
+
+        The queue takes ownership of the callback object, and deletes it after the request
+        has finished (or been cancelled). The other parameters are used in the same way as
+        the ones for URL::createInputStream().
+
+        Returns an ID that can be passed to cancelRequest().
+    */
+    int addRequest (const URL& url, Callback* callback,
+                    bool usePostCommand = false,
+                    const String& extraHeaders = String(),
+                    int timeOutMs = 0);
+
+    /** Cancels a request, so that its callback won't be called.
+        Returns false if the request had already finished, or the ID isn't known.
+    */
+    bool cancelRequest (int requestId);
+
+    /** Cancels all the requests that haven't finished. */
+    void cancelAllRequests();
+
+    /** Returns the number of requests that are waiting or running. */
+    int getNumPendingRequests() const;
+
+private:
+    //==============================================================================
+    struct Request;
+    class Worker;
+    struct ResultMessage;
+    friend class Worker;
+    friend struct ResultMessage;
+    friend struct ContainerDeletePolicy<Request>;
+    friend struct ContainerDeletePolicy<Worker>;
+
+    const int maxSimultaneousRequests, maxRequestsPerHost;
+    const bool useMessageThread;
+    CriticalSection lock;
+    OwnedArray<Request> requests;
+    OwnedArray<Worker> workers;
+    HashMap<String, int> numRequestsPerHost;
+    WaitableEvent requestAdded;
+    int lastRequestId, numIdleWorkers;
+
+    WeakReference<URLRequestQueue>::Master masterReference;
+    friend class WeakReference<URLRequestQueue>;
+
+    Request* getNextRequestToRun();
+    void runRequest (Request&);
+    void requestFinished (Request&, Result&);
+    void deliverResult (int requestId, const Result&);
+    int indexOfRequest (int requestId) const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (URLRequestQueue)
+};
+
+
+#endif   // JUCE_URLREQUESTQUEUE_H_INCLUDED
@@ -22,6 +22,12 @@
   ==============================================================================
 */
 
+/*  The running timers are kept in a hashed timing wheel: each timer sits in the slot for the
+    millisecond at which it's next due (modulo the number of slots), so starting, stopping and
+    resetting a timer are all constant-time, and each tick only has to look at the slots for
+    the milliseconds that have passed. Timers that are due more than one revolution ahead just
+    stay in their slot and are skipped until their time comes round.
+*/
 class Timer::TimerThread  : private Thread,
                             private DeletedAtShutdown,
                             private AsyncUpdater
@@ -31,9 +37,11 @@ public:
 
     TimerThread()
         : Thread ("Juce Timer"),
-          firstTimer (nullptr),
+          dueTimers (nullptr),
+          lastTimeProcessed (getCurrentTime()),
           callbackNeeded (0)
     {
+        zeromem (slots, sizeof (slots));
         triggerAsyncUpdate();
     }
 
@@ -48,24 +56,14 @@ public:
 
     void run() override
     {
-        uint32 lastTime = Time::getMillisecondCounter();
         MessageManager::MessageBase::Ptr messageToSend (new CallTimersMessage());
 
         while (! threadShouldExit())
         {
+            // (this also helps keep the Time::getApproximateMillisecondTimer value up-to-date)
             const uint32 now = Time::getMillisecondCounter();
 
-            if (now == lastTime)
-            {
-                wait (1);
-                continue;
-            }
-
-            const int elapsed = (int) (now >= lastTime ? (now - lastTime)
-                                                       : (std::numeric_limits<uint32>::max() - (lastTime - now)));
-            lastTime = now;
-
-            const int timeUntilFirstTimer = getTimeUntilFirstTimer (elapsed);
+            const int timeUntilFirstTimer = getTimeUntilFirstTimer();
 
             if (timeUntilFirstTimer <= 0)
             {
@@ -98,6 +96,10 @@ public:
                         }
                     }
                 }
+                else
+                {
+                    wait (1);
+                }
             }
             else
             {
@@ -112,18 +114,24 @@ public:
     {
         const LockType::ScopedLockType sl (lock);
 
-        while (firstTimer != nullptr && firstTimer->countdownMs <= 0)
+        const int64 now = getCurrentTime();
+        collectDueTimers (now);
+
+        // All the timers that have become due are called in one pass, and because they're all
+        // re-scheduled from the same time, timers that share a period stay in step with each other.
+        while (dueTimers != nullptr)
         {
-            Timer* const t = firstTimer;
-            t->countdownMs = t->periodMs;
+            Timer* const t = dueTimers;
 
             removeTimer (t);
+            t->expiryTime = now + t->periodMs;
             addTimer (t);
 
             const LockType::ScopedUnlockType ul (lock);
 
             JUCE_TRY
             {
+                JUCE_TRACE_ZONE_FOR_OBJECT ("events", "Timer::timerCallback", *t);
                 t->timerCallback();
             }
             JUCE_CATCH_EXCEPTION
@@ -151,12 +159,12 @@ public:
         callTimers();
     }
 
-    static inline void add (Timer* const tim) noexcept
+    static inline void add (Timer* const tim, const int initialDelayMs) noexcept
     {
         if (instance == nullptr)
             instance = new TimerThread();
 
-        instance->addTimer (tim);
+        instance->scheduleTimer (tim, initialDelayMs);
     }
 
     static inline void remove (Timer* const tim) noexcept
@@ -169,15 +177,10 @@ public:
     {
         if (instance != nullptr)
         {
-            tim->countdownMs = newCounter;
-            tim->periodMs = newCounter;
+            tim->periodMs = jmax (1, newCounter);
 
-            if ((tim->next != nullptr && tim->next->countdownMs < tim->countdownMs)
-                 || (tim->previous != nullptr && tim->previous->countdownMs > tim->countdownMs))
-            {
-                instance->removeTimer (tim);
-                instance->addTimer (tim);
-            }
+            instance->removeTimer (tim);
+            instance->scheduleTimer (tim, newCounter);
         }
     }
 
@@ -185,7 +188,11 @@ public:
     static LockType lock;
 
 private:
-    Timer* volatile firstTimer;
+    enum { numSlots = 512 }; // (must be a power of two)
+
+    Timer* slots [numSlots];
+    Timer* dueTimers;
+    int64 lastTimeProcessed;
     Atomic<int> callbackNeeded;
 
     struct CallTimersMessage  : public MessageManager::MessageBase
@@ -200,6 +207,24 @@ private:
     };
 
     //==============================================================================
+    static int64 getCurrentTime() noexcept
+    {
+        return (int64) Time::getMillisecondCounterHiRes();
+    }
+
+    Timer*& getSlot (const int64 time) noexcept
+    {
+        return slots [(int) (time & (numSlots - 1))];
+    }
+
+    void scheduleTimer (Timer* const t, const int delayMs) noexcept
+    {
+        // (a timer can't be put into a slot that has already been processed)
+        t->expiryTime = jmax (lastTimeProcessed + 1, getCurrentTime() + delayMs);
+        addTimer (t);
+        notify();
+    }
+
     void addTimer (Timer* const t) noexcept
     {
        #if JUCE_DEBUG
@@ -208,32 +233,17 @@ private:
         jassert (! timerExists (t));
        #endif
 
-        Timer* i = firstTimer;
+        jassert (t->expiryTime > lastTimeProcessed);
 
-        if (i == nullptr || i->countdownMs > t->countdownMs)
-        {
-            t->next = firstTimer;
-            firstTimer = t;
-        }
-        else
-        {
-            while (i->next != nullptr && i->next->countdownMs <= t->countdownMs)
-                i = i->next;
-
-            jassert (i != nullptr);
+        Timer*& head = getSlot (t->expiryTime);
 
-            t->next = i->next;
-            t->previous = i;
-            i->next = t;
-        }
-
-        if (t->next != nullptr)
-            t->next->previous = t;
+        t->previous = nullptr;
+        t->next = head;
 
-        jassert ((t->next == nullptr || t->next->countdownMs >= t->countdownMs)
-                  && (t->previous == nullptr || t->previous->countdownMs <= t->countdownMs));
+        if (head != nullptr)
+            head->previous = t;
 
-        notify();
+        head = t;
     }
 
     void removeTimer (Timer* const t) noexcept
@@ -246,13 +256,16 @@ private:
 
         if (t->previous != nullptr)
         {
-            jassert (firstTimer != t);
             t->previous->next = t->next;
         }
+        else if (dueTimers == t)
+        {
+            dueTimers = t->next;
+        }
         else
         {
-            jassert (firstTimer == t);
-            firstTimer = t->next;
+            jassert (getSlot (t->expiryTime) == t);
+            getSlot (t->expiryTime) = t->next;
         }
 
         if (t->next != nullptr)
@@ -262,14 +275,65 @@ private:
         t->previous = nullptr;
     }
 
-    int getTimeUntilFirstTimer (const int numMillisecsElapsed) const
+    // Moves any timers whose time has come out of the wheel and onto the dueTimers list.
+    void collectDueTimers (const int64 now) noexcept
+    {
+        Timer* lastDue = dueTimers;
+
+        while (lastDue != nullptr && lastDue->next != nullptr)
+            lastDue = lastDue->next;
+
+        // (if the message thread has been blocked for more than a whole revolution, each slot
+        // only needs looking at once)
+        const int64 firstTime = jmax (lastTimeProcessed + 1, now - (numSlots - 1));
+
+        for (int64 time = firstTime; time <= now; ++time)
+        {
+            for (Timer* t = getSlot (time); t != nullptr;)
+            {
+                Timer* const nextInSlot = t->next;
+
+                if (t->expiryTime <= now)
+                {
+                    removeTimer (t);
+
+                    t->previous = lastDue;
+
+                    if (lastDue != nullptr)
+                        lastDue->next = t;
+                    else
+                        dueTimers = t;
+
+                    lastDue = t;
+                }
+
+                t = nextInSlot;
+            }
+        }
+
+        lastTimeProcessed = jmax (lastTimeProcessed, now);
+    }
+
+    int getTimeUntilFirstTimer()
     {
         const LockType::ScopedLockType sl (lock);
 
-        for (Timer* t = firstTimer; t != nullptr; t = t->next)
-            t->countdownMs -= numMillisecsElapsed;
+        const int64 now = getCurrentTime();
+        const int64 startTime = lastTimeProcessed;
 
-        return firstTimer != nullptr ? firstTimer->countdownMs : 1000;
+        // (there's no need to look further ahead than the longest time the thread will wait for)
+        for (int64 time = startTime + 1; time <= now + 50 && time - startTime <= numSlots; ++time)
+        {
+            for (Timer* t = getSlot (time); t != nullptr; t = t->next)
+                if (t->expiryTime <= jmax (time, now))
+                    return (int) (time - now);
+
+            // slots in the past with nothing due in them never need looking at again
+            if (time <= now)
+                lastTimeProcessed = time;
+        }
+
+        return 1000;
     }
 
     void handleAsyncUpdate() override
@@ -280,7 +344,11 @@ private:
    #if JUCE_DEBUG
     bool timerExists (Timer* const t) const noexcept
     {
-        for (Timer* tt = firstTimer; tt != nullptr; tt = tt->next)
+        for (Timer* tt = dueTimers; tt != nullptr; tt = tt->next)
+            if (tt == t)
+                return true;
+
+        for (Timer* tt = slots [(int) (t->expiryTime & (numSlots - 1))]; tt != nullptr; tt = tt->next)
             if (tt == t)
                 return true;
 
@@ -296,16 +364,16 @@ Timer::TimerThread::LockType Timer::TimerThread::lock;
 
 //==============================================================================
 Timer::Timer() noexcept
-   : countdownMs (0),
-     periodMs (0),
+   : periodMs (0),
+     expiryTime (0),
      previous (nullptr),
      next (nullptr)
 {
 }
 
 Timer::Timer (const Timer&) noexcept
-   : countdownMs (0),
-     periodMs (0),
+   : periodMs (0),
+     expiryTime (0),
      previous (nullptr),
      next (nullptr)
 {
@@ -322,9 +390,8 @@ void Timer::startTimer (const int interval) noexcept
 
     if (periodMs == 0)
     {
-        countdownMs = interval;
         periodMs = jmax (1, interval);
-        TimerThread::add (this);
+        TimerThread::add (this, interval);
     }
     else
     {
@@ -125,7 +125,8 @@ public:
 private:
     class TimerThread;
     friend class TimerThread;
-    int countdownMs, periodMs;
+    int periodMs;
+    int64 expiryTime;
     Timer* previous;
     Timer* next;
 
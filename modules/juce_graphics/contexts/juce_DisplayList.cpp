@@ -0,0 +1,505 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+class DisplayList::Reader
+{
+public:
+    Reader (const DisplayList& l) noexcept
+        : list (l),
+          data (static_cast<const char*> (l.commands.getData())),
+          end (data + l.commands.getDataSize())
+    {
+    }
+
+    bool isFinished() const noexcept        { return data >= end; }
+
+    CommandType readCommand() noexcept      { return (CommandType) read<uint8>(); }
+
+    template <typename ValueType>
+    ValueType read() noexcept
+    {
+        jassert (data + sizeof (ValueType) <= end);
+
+        // (the values are stored unaligned, so have to be copied out byte-wise - the recorded
+        // types are all simple geometry classes, for which that's a safe way to copy them)
+        ValueType value;
+        memcpy (static_cast<void*> (&value), data, sizeof (ValueType));
+        data += sizeof (ValueType);
+        return value;
+    }
+
+    const Path& readPath() noexcept                             { return list.paths.getReference (read<int>()); }
+    const FillType& readFill() noexcept                         { return list.fills.getReference (read<int>()); }
+    const Font& readFont() noexcept                             { return list.fonts.getReference (read<int>()); }
+    const Image& readImage() noexcept                           { return list.images.getReference (read<int>()); }
+    const RectangleList<int>& readIntRectList() noexcept        { return list.intRectLists.getReference (read<int>()); }
+    const RectangleList<float>& readFloatRectList() noexcept    { return list.floatRectLists.getReference (read<int>()); }
+
+private:
+    const DisplayList& list;
+    const char* data;
+    const char* const end;
+
+    JUCE_DECLARE_NON_COPYABLE (Reader)
+};
+
+//==============================================================================
+DisplayList::DisplayList()
+    : physicalPixelScale (1.0f)
+{
+}
+
+DisplayList::~DisplayList()
+{
+}
+
+void DisplayList::clear()
+{
+    commands.reset();
+    paths.clearQuick();
+    fills.clearQuick();
+    fonts.clearQuick();
+    images.clearQuick();
+    intRectLists.clearQuick();
+    floatRectLists.clearQuick();
+}
+
+size_t DisplayList::getMemoryUsage() const noexcept
+{
+    return commands.getDataSize()
+            + sizeof (Path) * (size_t) paths.size()
+            + sizeof (FillType) * (size_t) fills.size()
+            + sizeof (Font) * (size_t) fonts.size()
+            + sizeof (Image) * (size_t) images.size()
+            + sizeof (RectangleList<int>) * (size_t) intRectLists.size()
+            + sizeof (RectangleList<float>) * (size_t) floatRectLists.size();
+}
+
+void DisplayList::addCommand (const CommandType type)
+{
+    commands.writeByte ((char) type);
+}
+
+template <typename ValueType>
+void DisplayList::addValue (const ValueType& value)
+{
+    commands.write (&value, sizeof (value));
+}
+
+template <typename ObjectType>
+void DisplayList::addObject (Array<ObjectType>& array, const ObjectType& object)
+{
+    addValue (array.size());
+    array.add (object);
+}
+
+// Fills and fonts are often set to the same value several times in a row, so these
+// can share the previous entry rather than adding another one.
+template <typename ObjectType>
+void DisplayList::addSharedObject (Array<ObjectType>& array, const ObjectType& object)
+{
+    if (array.size() > 0 && array.getReference (array.size() - 1) == object)
+        addValue (array.size() - 1);
+    else
+        addObject (array, object);
+}
+
+//==============================================================================
+void DisplayList::draw (Graphics& g) const
+{
+    g.saveState();
+
+    if (g.reduceClipRegion (bounds))
+        replay (g.getInternalContext());
+
+    g.restoreState();
+}
+
+void DisplayList::replay (LowLevelGraphicsContext& g) const
+{
+    Reader r (*this);
+
+    while (! r.isFinished())
+    {
+        switch (r.readCommand())
+        {
+            case setOriginCommand:                g.setOrigin (r.read<Point<int> >()); break;
+            case addTransformCommand:             g.addTransform (r.read<AffineTransform>()); break;
+            case clipToRectangleCommand:          g.clipToRectangle (r.read<Rectangle<int> >()); break;
+            case clipToRectangleListCommand:      g.clipToRectangleList (r.readIntRectList()); break;
+            case excludeClipRectangleCommand:     g.excludeClipRectangle (r.read<Rectangle<int> >()); break;
+            case saveStateCommand:                g.saveState(); break;
+            case restoreStateCommand:             g.restoreState(); break;
+            case beginTransparencyLayerCommand:   g.beginTransparencyLayer (r.read<float>()); break;
+            case endTransparencyLayerCommand:     g.endTransparencyLayer(); break;
+            case setFillCommand:                  g.setFill (r.readFill()); break;
+            case setOpacityCommand:               g.setOpacity (r.read<float>()); break;
+            case setInterpolationQualityCommand:  g.setInterpolationQuality ((Graphics::ResamplingQuality) r.read<int>()); break;
+            case fillFloatRectCommand:            g.fillRect (r.read<Rectangle<float> >()); break;
+            case fillRectListCommand:             g.fillRectList (r.readFloatRectList()); break;
+            case drawLineCommand:                 g.drawLine (r.read<Line<float> >()); break;
+            case setFontCommand:                  g.setFont (r.readFont()); break;
+
+            case clipToPathCommand:
+            {
+                const Path& path = r.readPath();
+                g.clipToPath (path, r.read<AffineTransform>());
+                break;
+            }
+
+            case clipToImageAlphaCommand:
+            {
+                const Image& image = r.readImage();
+                g.clipToImageAlpha (image, r.read<AffineTransform>());
+                break;
+            }
+
+            case fillIntRectCommand:
+            {
+                const Rectangle<int> area (r.read<Rectangle<int> >());
+                g.fillRect (area, r.read<uint8>() != 0);
+                break;
+            }
+
+            case fillPathCommand:
+            {
+                const Path& path = r.readPath();
+                g.fillPath (path, r.read<AffineTransform>());
+                break;
+            }
+
+            case drawImageCommand:
+            {
+                const Image& image = r.readImage();
+                g.drawImage (image, r.read<AffineTransform>());
+                break;
+            }
+
+            case drawGlyphCommand:
+            {
+                const int glyphNumber = r.read<int>();
+                g.drawGlyph (glyphNumber, r.read<AffineTransform>());
+                break;
+            }
+
+            default:
+                jassertfalse; // the list has been corrupted!
+                return;
+        }
+    }
+}
+
+//==============================================================================
+DisplayList::Recorder::Recorder (DisplayList& l, const Rectangle<int>& area,
+                                 float scale, const Font& initialFont)
+    : list (l), physicalPixelScale (scale)
+{
+    list.clear();
+    list.bounds = area;
+    list.physicalPixelScale = scale;
+
+    stack.add (state = new SavedState (area, initialFont));
+
+    // The font is recorded so that glyphs will be drawn in the same font when the list is
+    // replayed, whichever font the target context happens to be using at the time.
+    list.addCommand (setFontCommand);
+    list.addSharedObject (list.fonts, initialFont);
+}
+
+DisplayList::Recorder::~Recorder()
+{
+    // if the drawing code left any states saved, restore them so that replaying the list
+    // leaves the target context as it found it
+    for (int i = stack.size(); --i > 0;)
+        list.addCommand (restoreStateCommand);
+}
+
+Rectangle<int> DisplayList::Recorder::toListSpace (const Rectangle<int>& r) const noexcept
+{
+    const AffineTransform& t = state->transform;
+
+    if (t.isOnlyTranslation())
+    {
+        const int dx = (int) t.getTranslationX();
+        const int dy = (int) t.getTranslationY();
+
+        if (dx == t.getTranslationX() && dy == t.getTranslationY())
+            return r.translated (dx, dy);
+    }
+
+    return r.toFloat().transformedBy (t).getSmallestIntegerContainer();
+}
+
+void DisplayList::Recorder::clipToListSpaceArea (const Rectangle<int>& area)
+{
+    state->clip.clipTo (area);
+}
+
+bool DisplayList::Recorder::canDraw() const noexcept
+{
+    return ! state->clip.isEmpty();
+}
+
+//==============================================================================
+bool DisplayList::Recorder::isVectorDevice() const          { return false; }
+bool DisplayList::Recorder::isClipEmpty() const             { return state->clip.isEmpty(); }
+const Font& DisplayList::Recorder::getFont()                { return state->font; }
+
+float DisplayList::Recorder::getPhysicalPixelScaleFactor()
+{
+    return physicalPixelScale * state->transform.getScaleFactor();
+}
+
+void DisplayList::Recorder::setOrigin (Point<int> o)
+{
+    state->transform = AffineTransform::translation ((float) o.x, (float) o.y).followedBy (state->transform);
+
+    list.addCommand (setOriginCommand);
+    list.addValue (o);
+}
+
+void DisplayList::Recorder::addTransform (const AffineTransform& t)
+{
+    state->transform = t.followedBy (state->transform);
+
+    list.addCommand (addTransformCommand);
+    list.addValue (t);
+}
+
+bool DisplayList::Recorder::clipToRectangle (const Rectangle<int>& r)
+{
+    clipToListSpaceArea (toListSpace (r));
+
+    list.addCommand (clipToRectangleCommand);
+    list.addValue (r);
+    return ! state->clip.isEmpty();
+}
+
+bool DisplayList::Recorder::clipToRectangleList (const RectangleList<int>& r)
+{
+    if (r.getNumRectangles() == 1 || ! state->transform.isOnlyTranslation())
+    {
+        clipToListSpaceArea (toListSpace (r.getBounds()));
+    }
+    else
+    {
+        RectangleList<int> areas;
+
+        for (const Rectangle<int>* i = r.begin(), * const e = r.end(); i != e; ++i)
+            areas.addWithoutMerging (toListSpace (*i));
+
+        state->clip.clipTo (areas);
+    }
+
+    list.addCommand (clipToRectangleListCommand);
+    list.addObject (list.intRectLists, r);
+    return ! state->clip.isEmpty();
+}
+
+void DisplayList::Recorder::excludeClipRectangle (const Rectangle<int>& r)
+{
+    // (if the context is rotated, the excluded area isn't a rectangle, so the
+    // clip is just left as it is)
+    if (state->transform.isOnlyTranslation())
+        state->clip.subtract (toListSpace (r));
+
+    list.addCommand (excludeClipRectangleCommand);
+    list.addValue (r);
+}
+
+void DisplayList::Recorder::clipToPath (const Path& path, const AffineTransform& t)
+{
+    clipToListSpaceArea (path.getBoundsTransformed (t.followedBy (state->transform)).getSmallestIntegerContainer());
+
+    list.addCommand (clipToPathCommand);
+    list.addObject (list.paths, path);
+    list.addValue (t);
+}
+
+void DisplayList::Recorder::clipToImageAlpha (const Image& image, const AffineTransform& t)
+{
+    clipToListSpaceArea (image.getBounds().toFloat().transformedBy (t.followedBy (state->transform))
+                                                    .getSmallestIntegerContainer());
+
+    list.addCommand (clipToImageAlphaCommand);
+    list.addObject (list.images, image);
+    list.addValue (t);
+}
+
+bool DisplayList::Recorder::clipRegionIntersects (const Rectangle<int>& r)
+{
+    return state->clip.intersects (toListSpace (r));
+}
+
+Rectangle<int> DisplayList::Recorder::getClipBounds() const
+{
+    const Rectangle<int> clipBounds (state->clip.getBounds());
+    const AffineTransform& t = state->transform;
+
+    if (t.isOnlyTranslation())
+    {
+        const int dx = (int) t.getTranslationX();
+        const int dy = (int) t.getTranslationY();
+
+        if (dx == t.getTranslationX() && dy == t.getTranslationY())
+            return clipBounds.translated (-dx, -dy);
+    }
+
+    return clipBounds.toFloat().transformedBy (t.inverted()).getSmallestIntegerContainer();
+}
+
+void DisplayList::Recorder::saveState()
+{
+    stack.add (state = new SavedState (*state));
+    list.addCommand (saveStateCommand);
+}
+
+void DisplayList::Recorder::restoreState()
+{
+    // if this gets hit, there are more calls to restoreState() than saveState()
+    jassert (stack.size() > 1);
+
+    if (stack.size() > 1)
+    {
+        stack.removeLast();
+        state = stack.getLast();
+        list.addCommand (restoreStateCommand);
+    }
+}
+
+void DisplayList::Recorder::beginTransparencyLayer (float opacity)
+{
+    stack.add (state = new SavedState (*state));
+
+    list.addCommand (beginTransparencyLayerCommand);
+    list.addValue (opacity);
+}
+
+void DisplayList::Recorder::endTransparencyLayer()
+{
+    jassert (stack.size() > 1);
+
+    if (stack.size() > 1)
+    {
+        stack.removeLast();
+        state = stack.getLast();
+        list.addCommand (endTransparencyLayerCommand);
+    }
+}
+
+//==============================================================================
+void DisplayList::Recorder::setFill (const FillType& fill)
+{
+    list.addCommand (setFillCommand);
+    list.addSharedObject (list.fills, fill);
+}
+
+void DisplayList::Recorder::setOpacity (float opacity)
+{
+    list.addCommand (setOpacityCommand);
+    list.addValue (opacity);
+}
+
+void DisplayList::Recorder::setInterpolationQuality (Graphics::ResamplingQuality quality)
+{
+    list.addCommand (setInterpolationQualityCommand);
+    list.addValue ((int) quality);
+}
+
+void DisplayList::Recorder::setFont (const Font& font)
+{
+    state->font = font;
+
+    list.addCommand (setFontCommand);
+    list.addSharedObject (list.fonts, font);
+}
+
+//==============================================================================
+void DisplayList::Recorder::fillRect (const Rectangle<int>& r, bool replaceExistingContents)
+{
+    if (canDraw())
+    {
+        list.addCommand (fillIntRectCommand);
+        list.addValue (r);
+        list.addValue ((uint8) (replaceExistingContents ? 1 : 0));
+    }
+}
+
+void DisplayList::Recorder::fillRect (const Rectangle<float>& r)
+{
+    if (canDraw())
+    {
+        list.addCommand (fillFloatRectCommand);
+        list.addValue (r);
+    }
+}
+
+void DisplayList::Recorder::fillRectList (const RectangleList<float>& r)
+{
+    if (canDraw())
+    {
+        list.addCommand (fillRectListCommand);
+        list.addObject (list.floatRectLists, r);
+    }
+}
+
+void DisplayList::Recorder::fillPath (const Path& path, const AffineTransform& t)
+{
+    if (canDraw())
+    {
+        list.addCommand (fillPathCommand);
+        list.addObject (list.paths, path);
+        list.addValue (t);
+    }
+}
+
+void DisplayList::Recorder::drawImage (const Image& image, const AffineTransform& t)
+{
+    if (canDraw())
+    {
+        list.addCommand (drawImageCommand);
+        list.addObject (list.images, image);
+        list.addValue (t);
+    }
+}
+
+void DisplayList::Recorder::drawLine (const Line<float>& line)
+{
+    if (canDraw())
+    {
+        list.addCommand (drawLineCommand);
+        list.addValue (line);
+    }
+}
+
+void DisplayList::Recorder::drawGlyph (int glyphNumber, const AffineTransform& t)
+{
+    if (canDraw())
+    {
+        list.addCommand (drawGlyphCommand);
+        list.addValue (glyphNumber);
+        list.addValue (t);
+    }
+}
@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_DISPLAYLIST_H_INCLUDED
+#define JUCE_DISPLAYLIST_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A recorded sequence of drawing operations, which can be replayed into any
+    graphics context.
+
+    To fill a DisplayList, create a DisplayList::Recorder for it, and draw into a Graphics
+    object that uses the recorder as its context. Replaying the list with draw() then has
+    the same effect as repeating the original drawing calls, but without re-running the
+    code that made them.
+
+    Because the operations are kept as paths, glyphs, images and fills rather than pixels,
+    a list can be replayed at any scale or into any kind of context (e.g. software or
+    OpenGL), and will look the same as if it had been drawn there directly. Simple values
+    are packed into a single block of memory, so a list is quick to replay and takes up
+    far less space than an image of the same area.
+
+    Images that are drawn are kept by reference, so they mustn't be modified while a
+    list that uses them is still going to be drawn.
+
+    @see Component::setBufferedToDisplayList
+*/
+class JUCE_API  DisplayList
+{
+public:
+    //==============================================================================
+    /** Creates an empty list. */
+    DisplayList();
+
+    /** Destructor. */
+    ~DisplayList();
+
+    //==============================================================================
+    /** Draws the recorded operations into a Graphics context.
+        The drawing is clipped to the bounds that were given when the list was recorded,
+        and the context's state is left unchanged afterwards.
+    */
+    void draw (Graphics& g) const;
+
+    /** Performs the recorded operations directly on a low-level context.
+        Unlike draw(), this doesn't clip the drawing, or save and restore the context's state.
+    */
+    void replay (LowLevelGraphicsContext& context) const;
+
+    //==============================================================================
+    /** Removes all the recorded operations. */
+    void clear();
+
+    /** Returns the area that was given to the Recorder that last filled this list. */
+    Rectangle<int> getBounds() const noexcept                   { return bounds; }
+
+    /** Returns the scale factor that was given to the Recorder that last filled this list. */
+    float getPhysicalPixelScaleFactor() const noexcept          { return physicalPixelScale; }
+
+    /** Returns the number of bytes of memory used by the list, not including the
+        contents of any paths, fonts or images that it refers to.
+    */
+    size_t getMemoryUsage() const noexcept;
+
+    //==============================================================================
+    /**
+        A graphics context which records the operations that are drawn into it.
+
+        When one of these is created, it clears the list that's passed in, and then
+        adds each operation that's performed on it to the list.
+
+        It keeps track of the clip region, so that code which checks the clip to avoid
+        unnecessary work will behave in the same way as usual, although for clip
+        regions that are transformed or aren't rectangular, it uses their bounding
+        rectangles.
+    */
+    class JUCE_API  Recorder  : public LowLevelGraphicsContext
+    {
+    public:
+        /** Creates a recorder.
+
+            @param listToFill                   the list to record into - this is cleared first,
+                                                and must not be deleted before the recorder
+            @param bounds                       the area that's being drawn. This becomes the initial
+                                                clip region, and the list's bounds
+            @param physicalPixelScaleFactor     the scale at which the list is likely to be drawn,
+                                                which is returned by getPhysicalPixelScaleFactor()
+            @param initialFont                  the font that's selected when drawing begins
+        */
+        Recorder (DisplayList& listToFill, const Rectangle<int>& bounds,
+                  float physicalPixelScaleFactor = 1.0f,
+                  const Font& initialFont = Font());
+
+        /** Destructor. */
+        ~Recorder();
+
+        //==============================================================================
+        bool isVectorDevice() const override;
+        void setOrigin (Point<int>) override;
+        void addTransform (const AffineTransform&) override;
+        float getPhysicalPixelScaleFactor() override;
+        bool clipToRectangle (const Rectangle<int>&) override;
+        bool clipToRectangleList (const RectangleList<int>&) override;
+        void excludeClipRectangle (const Rectangle<int>&) override;
+        void clipToPath (const Path&, const AffineTransform&) override;
+        void clipToImageAlpha (const Image&, const AffineTransform&) override;
+        bool clipRegionIntersects (const Rectangle<int>&) override;
+        Rectangle<int> getClipBounds() const override;
+        bool isClipEmpty() const override;
+        void saveState() override;
+        void restoreState() override;
+        void beginTransparencyLayer (float opacity) override;
+        void endTransparencyLayer() override;
+        void setFill (const FillType&) override;
+        void setOpacity (float) override;
+        void setInterpolationQuality (Graphics::ResamplingQuality) override;
+        void fillRect (const Rectangle<int>&, bool replaceExistingContents) override;
+        void fillRect (const Rectangle<float>&) override;
+        void fillRectList (const RectangleList<float>&) override;
+        void fillPath (const Path&, const AffineTransform&) override;
+        void drawImage (const Image&, const AffineTransform&) override;
+        void drawLine (const Line<float>&) override;
+        void setFont (const Font&) override;
+        const Font& getFont() override;
+        void drawGlyph (int glyphNumber, const AffineTransform&) override;
+
+    private:
+        //==============================================================================
+        struct SavedState
+        {
+            SavedState (const Rectangle<int>& clipArea, const Font& f)
+                : clip (clipArea), font (f) {}
+
+            // The transform and clip are both relative to the list's coordinate space
+            AffineTransform transform;
+            RectangleList<int> clip;
+            Font font;
+        };
+
+        DisplayList& list;
+        OwnedArray<SavedState> stack;
+        SavedState* state;
+        const float physicalPixelScale;
+
+        Rectangle<int> toListSpace (const Rectangle<int>&) const noexcept;
+        void clipToListSpaceArea (const Rectangle<int>&);
+        bool canDraw() const noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE (Recorder)
+    };
+
+private:
+    //==============================================================================
+    // Simple values are packed into the command block, and anything else is kept in
+    // one of the arrays, and referred to by its index.
+    MemoryOutputStream commands;
+    Array<Path> paths;
+    Array<FillType> fills;
+    Array<Font> fonts;
+    Array<Image> images;
+    Array<RectangleList<int> > intRectLists;
+    Array<RectangleList<float> > floatRectLists;
+    Rectangle<int> bounds;
+    float physicalPixelScale;
+
+    enum CommandType
+    {
+        setOriginCommand, addTransformCommand,
+        clipToRectangleCommand, clipToRectangleListCommand, excludeClipRectangleCommand,
+        clipToPathCommand, clipToImageAlphaCommand,
+        saveStateCommand, restoreStateCommand,
+        beginTransparencyLayerCommand, endTransparencyLayerCommand,
+        setFillCommand, setOpacityCommand, setInterpolationQualityCommand,
+        fillIntRectCommand, fillFloatRectCommand, fillRectListCommand, fillPathCommand,
+        drawImageCommand, drawLineCommand, setFontCommand, drawGlyphCommand
+    };
+
+    class Reader;
+
+    void addCommand (CommandType);
+    template <typename ValueType> void addValue (const ValueType&);
+    template <typename ObjectType> void addObject (Array<ObjectType>&, const ObjectType&);
+    template <typename ObjectType> void addSharedObject (Array<ObjectType>&, const ObjectType&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DisplayList)
+};
+
+
+#endif   // JUCE_DISPLAYLIST_H_INCLUDED
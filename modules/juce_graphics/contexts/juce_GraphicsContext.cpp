@@ -40,6 +40,221 @@ namespace
     }
 }
 
+//==============================================================================
+/*  A shared, memory-bounded cache of the arrangements that drawText() and drawFittedText()
+    create, so that components which repaint the same text don't have to lay it out again.
+    The arrangements are laid out at the origin and moved into place when they're drawn.
+*/
+class GlyphArrangementCache  : private DeletedAtShutdown
+{
+public:
+    GlyphArrangementCache()
+        : mostRecent (nullptr), leastRecent (nullptr),
+          maxCost (32768), totalCost (0)
+    {
+        buckets.calloc ((size_t) numBuckets);
+    }
+
+    ~GlyphArrangementCache()
+    {
+        clear();
+        clearSingletonInstance();
+    }
+
+    juce_DeclareSingleton (GlyphArrangementCache, false)
+
+    enum LayoutType
+    {
+        fittedText,
+        curtailedText,
+        curtailedTextWithEllipsis
+    };
+
+    struct Key
+    {
+        Key (const String& t, const Font& f, float w, float h, Justification j,
+             int maxLines, float minScale, LayoutType type) noexcept
+            : text (t), font (f), width (w), height (h), justification (j.getFlags()),
+              maximumNumberOfLines (maxLines), minimumHorizontalScale (minScale), layoutType (type)
+        {
+            hash = (uint32) text.hashCode();
+            hash = hash * 31 + (uint32) font.getTypefaceName().hashCode();
+            hash = hash * 31 + (uint32) (font.getHeight() * 256.0f) + (uint32) font.getStyleFlags();
+            hash = hash * 31 + (uint32) (width * 16.0f) + ((uint32) (height * 16.0f) << 12);
+            hash = hash * 31 + (uint32) justification + ((uint32) layoutType << 16);
+        }
+
+        bool operator== (const Key& other) const noexcept
+        {
+            return hash == other.hash
+                    && width == other.width
+                    && height == other.height
+                    && justification == other.justification
+                    && maximumNumberOfLines == other.maximumNumberOfLines
+                    && minimumHorizontalScale == other.minimumHorizontalScale
+                    && layoutType == other.layoutType
+                    && font == other.font
+                    && text == other.text;
+        }
+
+        String text;
+        Font font;
+        float width, height;
+        int justification, maximumNumberOfLines;
+        float minimumHorizontalScale;
+        LayoutType layoutType;
+        uint32 hash;
+    };
+
+    struct Entry  : public ReferenceCountedObject
+    {
+        Entry (const Key& k)
+            : key (k), nextInBucket (nullptr), previous (nullptr), next (nullptr)
+        {
+            switch (key.layoutType)
+            {
+                case fittedText:
+                    arrangement.addFittedText (key.font, key.text, 0.0f, 0.0f, key.width, key.height,
+                                               Justification (key.justification),
+                                               key.maximumNumberOfLines, key.minimumHorizontalScale);
+                    break;
+
+                default:
+                    arrangement.addCurtailedLineOfText (key.font, key.text, 0.0f, 0.0f, key.width,
+                                                        key.layoutType == curtailedTextWithEllipsis);
+
+                    arrangement.justifyGlyphs (0, arrangement.getNumGlyphs(), 0.0f, 0.0f,
+                                               key.width, key.height, Justification (key.justification));
+                    break;
+            }
+
+            // (each entry is charged a little extra for its own overheads)
+            cost = arrangement.getNumGlyphs() + 8;
+        }
+
+        typedef ReferenceCountedObjectPtr<Entry> Ptr;
+
+        Key key;
+        GlyphArrangement arrangement;
+        int cost;
+        Entry* nextInBucket;
+        Entry* previous;
+        Entry* next;
+
+        JUCE_DECLARE_NON_COPYABLE (Entry)
+    };
+
+    /** Returns the arrangement for this key, either from the cache or by laying it out. */
+    Entry::Ptr getArrangement (const Key& key)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            for (Entry* e = buckets [key.hash & (numBuckets - 1)]; e != nullptr; e = e->nextInBucket)
+            {
+                if (e->key == key)
+                {
+                    unlinkFromUsageList (e);
+                    addToUsageList (e);
+                    return e;
+                }
+            }
+        }
+
+        Entry::Ptr newEntry (new Entry (key));
+
+        const ScopedLock sl (lock);
+
+        if (newEntry->cost <= maxCost / 4)
+        {
+            newEntry->incReferenceCount();
+            Entry*& bucket = buckets [key.hash & (numBuckets - 1)];
+            newEntry->nextInBucket = bucket;
+            bucket = newEntry;
+            addToUsageList (newEntry);
+            totalCost += newEntry->cost;
+
+            removeLeastRecentlyUsed (maxCost);
+        }
+
+        return newEntry;
+    }
+
+    void setMaximumCost (const int newMaximum)
+    {
+        const ScopedLock sl (lock);
+        maxCost = jmax (0, newMaximum);
+        removeLeastRecentlyUsed (maxCost);
+    }
+
+    void clear()
+    {
+        const ScopedLock sl (lock);
+        removeLeastRecentlyUsed (0);
+    }
+
+private:
+    enum { numBuckets = 1024 };
+
+    CriticalSection lock;
+    HeapBlock<Entry*> buckets;
+    Entry* mostRecent;
+    Entry* leastRecent;
+    int maxCost, totalCost;
+
+    void addToUsageList (Entry* e) noexcept
+    {
+        e->previous = nullptr;
+        e->next = mostRecent;
+
+        if (mostRecent != nullptr)
+            mostRecent->previous = e;
+        else
+            leastRecent = e;
+
+        mostRecent = e;
+    }
+
+    void unlinkFromUsageList (Entry* e) noexcept
+    {
+        if (e->previous != nullptr)  e->previous->next = e->next;
+        else                         mostRecent = e->next;
+
+        if (e->next != nullptr)      e->next->previous = e->previous;
+        else                         leastRecent = e->previous;
+    }
+
+    void removeLeastRecentlyUsed (const int costLimit)
+    {
+        while (totalCost > costLimit && leastRecent != nullptr)
+        {
+            Entry* const e = leastRecent;
+            unlinkFromUsageList (e);
+
+            for (Entry** b = &buckets [e->key.hash & (numBuckets - 1)]; *b != nullptr; b = &((*b)->nextInBucket))
+            {
+                if (*b == e)
+                {
+                    *b = e->nextInBucket;
+                    break;
+                }
+            }
+
+            totalCost -= e->cost;
+            e->decReferenceCount();
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GlyphArrangementCache)
+};
+
+juce_ImplementSingleton (GlyphArrangementCache)
+
+void GlyphArrangement::setLayoutCacheSize (int maxNumGlyphs)
+{
+    GlyphArrangementCache::getInstance()->setMaximumCost (maxNumGlyphs);
+}
+
 //==============================================================================
 LowLevelGraphicsContext::LowLevelGraphicsContext() {}
 LowLevelGraphicsContext::~LowLevelGraphicsContext() {}
@@ -286,14 +501,13 @@ void Graphics::drawText (const String& text, const Rectangle<float>& area,
 {
     if (text.isNotEmpty() && context.clipRegionIntersects (area.getSmallestIntegerContainer()))
     {
-        GlyphArrangement arr;
-        arr.addCurtailedLineOfText (context.getFont(), text, 0.0f, 0.0f,
-                                    area.getWidth(), useEllipsesIfTooBig);
+        const GlyphArrangementCache::Key key (text, context.getFont(), area.getWidth(), area.getHeight(),
+                                              justificationType, 1, 1.0f,
+                                              useEllipsesIfTooBig ? GlyphArrangementCache::curtailedTextWithEllipsis
+                                                                  : GlyphArrangementCache::curtailedText);
 
-        arr.justifyGlyphs (0, arr.getNumGlyphs(),
-                           area.getX(), area.getY(), area.getWidth(), area.getHeight(),
-                           justificationType);
-        arr.draw (*this);
+        GlyphArrangementCache::getInstance()->getArrangement (key)
+            ->arrangement.draw (*this, AffineTransform::translation (area.getX(), area.getY()));
     }
 }
 
@@ -316,15 +530,13 @@ void Graphics::drawFittedText (const String& text, const Rectangle<int>& area,
 {
     if (text.isNotEmpty() && (! area.isEmpty()) && context.clipRegionIntersects (area))
     {
-        GlyphArrangement arr;
-        arr.addFittedText (context.getFont(), text,
-                           (float) area.getX(), (float) area.getY(),
-                           (float) area.getWidth(), (float) area.getHeight(),
-                           justification,
-                           maximumNumberOfLines,
-                           minimumHorizontalScale);
+        const GlyphArrangementCache::Key key (text, context.getFont(),
+                                              (float) area.getWidth(), (float) area.getHeight(),
+                                              justification, maximumNumberOfLines, minimumHorizontalScale,
+                                              GlyphArrangementCache::fittedText);
 
-        arr.draw (*this);
+        GlyphArrangementCache::getInstance()->getArrangement (key)
+            ->arrangement.draw (*this, AffineTransform::translation ((float) area.getX(), (float) area.getY()));
     }
 }
 
@@ -0,0 +1,525 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+class LowLevelGraphicsTiledSoftwareRenderer::Recording
+{
+public:
+    Recording (const Image& im, Point<int> o, const RectangleList<int>& clip, ThreadPool& p, int bands)
+        : image (im), origin (o), initialClip (clip), pool (p), numBands (bands), isRotated (false)
+    {
+        // make sure the glyph cache exists before several threads try to use it
+        RenderingHelpers::SoftwareRendererSavedState::GlyphCacheType::getInstance();
+    }
+
+    //==============================================================================
+    struct Command
+    {
+        virtual ~Command() {}
+        virtual void perform (LowLevelGraphicsContext&) const = 0;
+    };
+
+    struct SetOrigin  : public Command
+    {
+        SetOrigin (Point<int> o) : origin (o) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.setOrigin (origin); }
+        const Point<int> origin;
+    };
+
+    struct AddTransform  : public Command
+    {
+        AddTransform (const AffineTransform& t) : transform (t) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.addTransform (transform); }
+        const AffineTransform transform;
+    };
+
+    struct ClipToRectangle  : public Command
+    {
+        ClipToRectangle (const Rectangle<int>& r) : area (r) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.clipToRectangle (area); }
+        const Rectangle<int> area;
+    };
+
+    struct ClipToRectangleList  : public Command
+    {
+        ClipToRectangleList (const RectangleList<int>& r) : areas (r) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.clipToRectangleList (areas); }
+        const RectangleList<int> areas;
+    };
+
+    struct ExcludeClipRectangle  : public Command
+    {
+        ExcludeClipRectangle (const Rectangle<int>& r) : area (r) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.excludeClipRectangle (area); }
+        const Rectangle<int> area;
+    };
+
+    struct ClipToPath  : public Command
+    {
+        ClipToPath (const Path& p, const AffineTransform& t) : path (p), transform (t) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.clipToPath (path, transform); }
+        const Path path;
+        const AffineTransform transform;
+    };
+
+    struct ClipToImageAlpha  : public Command
+    {
+        ClipToImageAlpha (const Image& im, const AffineTransform& t) : image (im), transform (t) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.clipToImageAlpha (image, transform); }
+        const Image image;
+        const AffineTransform transform;
+    };
+
+    struct SaveState  : public Command
+    {
+        void perform (LowLevelGraphicsContext& g) const override   { g.saveState(); }
+    };
+
+    struct RestoreState  : public Command
+    {
+        void perform (LowLevelGraphicsContext& g) const override   { g.restoreState(); }
+    };
+
+    struct BeginTransparencyLayer  : public Command
+    {
+        BeginTransparencyLayer (float o) : opacity (o) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.beginTransparencyLayer (opacity); }
+        const float opacity;
+    };
+
+    struct EndTransparencyLayer  : public Command
+    {
+        void perform (LowLevelGraphicsContext& g) const override   { g.endTransparencyLayer(); }
+    };
+
+    struct SetFill  : public Command
+    {
+        SetFill (const FillType& f) : fill (f) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.setFill (fill); }
+        const FillType fill;
+    };
+
+    struct SetOpacity  : public Command
+    {
+        SetOpacity (float o) : opacity (o) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.setOpacity (opacity); }
+        const float opacity;
+    };
+
+    struct SetInterpolationQuality  : public Command
+    {
+        SetInterpolationQuality (Graphics::ResamplingQuality q) : quality (q) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.setInterpolationQuality (quality); }
+        const Graphics::ResamplingQuality quality;
+    };
+
+    struct FillIntRect  : public Command
+    {
+        FillIntRect (const Rectangle<int>& r, bool replace) : area (r), replaceContents (replace) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.fillRect (area, replaceContents); }
+        const Rectangle<int> area;
+        const bool replaceContents;
+    };
+
+    struct FillFloatRect  : public Command
+    {
+        FillFloatRect (const Rectangle<float>& r) : area (r) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.fillRect (area); }
+        const Rectangle<float> area;
+    };
+
+    struct FillRectList  : public Command
+    {
+        FillRectList (const RectangleList<float>& r) : areas (r) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.fillRectList (areas); }
+        const RectangleList<float> areas;
+    };
+
+    struct FillPath  : public Command
+    {
+        FillPath (const Path& p, const AffineTransform& t) : path (p), transform (t) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.fillPath (path, transform); }
+        const Path path;
+        const AffineTransform transform;
+    };
+
+    struct DrawImage  : public Command
+    {
+        DrawImage (const Image& im, const AffineTransform& t) : image (im), transform (t) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.drawImage (image, transform); }
+        const Image image;
+        const AffineTransform transform;
+    };
+
+    struct DrawLine  : public Command
+    {
+        DrawLine (const Line<float>& l) : line (l) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.drawLine (line); }
+        const Line<float> line;
+    };
+
+    struct SetFont  : public Command
+    {
+        SetFont (const Font& f) : font (f) {}
+        void perform (LowLevelGraphicsContext& g) const override   { g.setFont (font); }
+        const Font font;
+    };
+
+    struct DrawGlyph  : public Command
+    {
+        DrawGlyph (int glyph, const AffineTransform& t, bool needsLock)
+            : glyphNumber (glyph), transform (t), needsTypefaceLock (needsLock) {}
+
+        void perform (LowLevelGraphicsContext& g) const override
+        {
+            if (needsTypefaceLock)
+            {
+                // glyphs that aren't drawn via the glyph cache go straight to the typeface,
+                // which can't be used by more than one thread at once
+                const ScopedLock sl (getTypefaceLock());
+                g.drawGlyph (glyphNumber, transform);
+            }
+            else
+            {
+                g.drawGlyph (glyphNumber, transform);
+            }
+        }
+
+        const int glyphNumber;
+        const AffineTransform transform;
+        const bool needsTypefaceLock;
+    };
+
+    //==============================================================================
+    void add (Command* c)       { commands.add (c); }
+
+    void saveRotation()         { rotationStack.add (isRotated); }
+
+    void restoreRotation()
+    {
+        if (rotationStack.size() > 0)
+            isRotated = rotationStack.remove (rotationStack.size() - 1);
+    }
+
+    void addTransform (const AffineTransform& t) noexcept
+    {
+        if (t.mat01 != 0 || t.mat10 != 0)
+            isRotated = true;
+    }
+
+    bool glyphNeedsTypefaceLock (const AffineTransform& t) const noexcept
+    {
+        return isRotated || ! t.isOnlyTranslation();
+    }
+
+    //==============================================================================
+    void render()
+    {
+        pool.parallelFor (0, numBands, BandRenderer (*this));
+    }
+
+private:
+    //==============================================================================
+    Image image;
+    const Point<int> origin;
+    const RectangleList<int> initialClip;
+    ThreadPool& pool;
+    const int numBands;
+    OwnedArray<Command> commands;
+    Array<bool> rotationStack;
+    bool isRotated;
+
+    struct BandRenderer
+    {
+        BandRenderer (Recording& r) noexcept : owner (r) {}
+        void operator() (int band) const    { owner.renderBand (band); }
+
+        Recording& owner;
+    };
+
+    void renderBand (int band) const
+    {
+        const Rectangle<int> bounds (initialClip.getBounds());
+        const int y1 = bounds.getY() + (bounds.getHeight() * band) / numBands;
+        const int y2 = bounds.getY() + (bounds.getHeight() * (band + 1)) / numBands;
+
+        RectangleList<int> bandClip (initialClip);
+        bandClip.clipTo (Rectangle<int> (bounds.getX(), y1, bounds.getWidth(), y2 - y1));
+
+        if (! bandClip.isEmpty())
+        {
+            LowLevelGraphicsSoftwareRenderer context (image, origin, bandClip);
+
+            for (int i = 0; i < commands.size(); ++i)
+                commands.getUnchecked(i)->perform (context);
+        }
+    }
+
+    static CriticalSection& getTypefaceLock()
+    {
+        static CriticalSection lock;
+        return lock;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Recording)
+};
+
+//==============================================================================
+static int getNumBandsForTiledRendering (const RectangleList<int>& clip) noexcept
+{
+    // Bands shorter than this aren't worth the overhead of replaying everything into
+    // them. Having a few more bands than CPUs helps to balance the load, as some parts
+    // of the screen are usually much busier than others.
+    const int minimumBandHeight = 32;
+
+    return jmin (SystemStats::getNumCpus() * 3, clip.getBounds().getHeight() / minimumBandHeight);
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& image, Point<int> origin,
+                                                                              const RectangleList<int>& initialClip,
+                                                                              ThreadPool& pool)
+    : stateTracker (image, origin, initialClip)
+{
+    const int numBands = getNumBandsForTiledRendering (initialClip);
+
+    if (numBands > 1)
+        recording = new Recording (image, origin, initialClip, pool, numBands);
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::~LowLevelGraphicsTiledSoftwareRenderer()
+{
+    if (recording != nullptr)
+        recording->render();
+}
+
+//==============================================================================
+bool LowLevelGraphicsTiledSoftwareRenderer::isVectorDevice() const                { return false; }
+float LowLevelGraphicsTiledSoftwareRenderer::getPhysicalPixelScaleFactor()        { return stateTracker.getPhysicalPixelScaleFactor(); }
+bool LowLevelGraphicsTiledSoftwareRenderer::clipRegionIntersects (const Rectangle<int>& r)  { return stateTracker.clipRegionIntersects (r); }
+Rectangle<int> LowLevelGraphicsTiledSoftwareRenderer::getClipBounds() const      { return stateTracker.getClipBounds(); }
+bool LowLevelGraphicsTiledSoftwareRenderer::isClipEmpty() const                   { return stateTracker.isClipEmpty(); }
+const Font& LowLevelGraphicsTiledSoftwareRenderer::getFont()                      { return stateTracker.getFont(); }
+
+void LowLevelGraphicsTiledSoftwareRenderer::setOrigin (Point<int> o)
+{
+    stateTracker.setOrigin (o);
+
+    if (recording != nullptr)
+        recording->add (new Recording::SetOrigin (o));
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addTransform (const AffineTransform& t)
+{
+    stateTracker.addTransform (t);
+
+    if (recording != nullptr)
+    {
+        recording->addTransform (t);
+        recording->add (new Recording::AddTransform (t));
+    }
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangle (const Rectangle<int>& r)
+{
+    if (recording != nullptr)
+        recording->add (new Recording::ClipToRectangle (r));
+
+    return stateTracker.clipToRectangle (r);
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangleList (const RectangleList<int>& r)
+{
+    if (recording != nullptr)
+        recording->add (new Recording::ClipToRectangleList (r));
+
+    return stateTracker.clipToRectangleList (r);
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::excludeClipRectangle (const Rectangle<int>& r)
+{
+    stateTracker.excludeClipRectangle (r);
+
+    if (recording != nullptr)
+        recording->add (new Recording::ExcludeClipRectangle (r));
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToPath (const Path& path, const AffineTransform& t)
+{
+    stateTracker.clipToPath (path, t);
+
+    if (recording != nullptr)
+        recording->add (new Recording::ClipToPath (path, t));
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToImageAlpha (const Image& im, const AffineTransform& t)
+{
+    stateTracker.clipToImageAlpha (im, t);
+
+    if (recording != nullptr)
+        recording->add (new Recording::ClipToImageAlpha (im, t));
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::saveState()
+{
+    stateTracker.saveState();
+
+    if (recording != nullptr)
+    {
+        recording->saveRotation();
+        recording->add (new Recording::SaveState());
+    }
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::restoreState()
+{
+    stateTracker.restoreState();
+
+    if (recording != nullptr)
+    {
+        recording->restoreRotation();
+        recording->add (new Recording::RestoreState());
+    }
+}
+
+// When recording, nothing gets drawn into the state tracker, so there's no need for it to
+// create a layer image - saving and restoring its state leaves its clip region the same.
+void LowLevelGraphicsTiledSoftwareRenderer::beginTransparencyLayer (float opacity)
+{
+    if (recording == nullptr)
+    {
+        stateTracker.beginTransparencyLayer (opacity);
+    }
+    else
+    {
+        stateTracker.saveState();
+        recording->saveRotation();
+        recording->add (new Recording::BeginTransparencyLayer (opacity));
+    }
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::endTransparencyLayer()
+{
+    if (recording == nullptr)
+    {
+        stateTracker.endTransparencyLayer();
+    }
+    else
+    {
+        stateTracker.restoreState();
+        recording->restoreRotation();
+        recording->add (new Recording::EndTransparencyLayer());
+    }
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::setFill (const FillType& fill)
+{
+    stateTracker.setFill (fill);
+
+    if (recording != nullptr)
+        recording->add (new Recording::SetFill (fill));
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setOpacity (float opacity)
+{
+    stateTracker.setOpacity (opacity);
+
+    if (recording != nullptr)
+        recording->add (new Recording::SetOpacity (opacity));
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setInterpolationQuality (Graphics::ResamplingQuality quality)
+{
+    stateTracker.setInterpolationQuality (quality);
+
+    if (recording != nullptr)
+        recording->add (new Recording::SetInterpolationQuality (quality));
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setFont (const Font& font)
+{
+    // this makes sure the font's typeface has been created before it's shared between threads
+    font.getTypeface();
+
+    stateTracker.setFont (font);
+
+    if (recording != nullptr)
+        recording->add (new Recording::SetFont (font));
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<int>& r, bool replaceExistingContents)
+{
+    if (recording == nullptr)
+        stateTracker.fillRect (r, replaceExistingContents);
+    else if (! stateTracker.isClipEmpty())
+        recording->add (new Recording::FillIntRect (r, replaceExistingContents));
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<float>& r)
+{
+    if (recording == nullptr)
+        stateTracker.fillRect (r);
+    else if (! stateTracker.isClipEmpty())
+        recording->add (new Recording::FillFloatRect (r));
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRectList (const RectangleList<float>& list)
+{
+    if (recording == nullptr)
+        stateTracker.fillRectList (list);
+    else if (! stateTracker.isClipEmpty())
+        recording->add (new Recording::FillRectList (list));
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillPath (const Path& path, const AffineTransform& t)
+{
+    if (recording == nullptr)
+        stateTracker.fillPath (path, t);
+    else if (! stateTracker.isClipEmpty())
+        recording->add (new Recording::FillPath (path, t));
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawImage (const Image& im, const AffineTransform& t)
+{
+    if (recording == nullptr)
+        stateTracker.drawImage (im, t);
+    else if (! stateTracker.isClipEmpty())
+        recording->add (new Recording::DrawImage (im, t));
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawLine (const Line<float>& line)
+{
+    if (recording == nullptr)
+        stateTracker.drawLine (line);
+    else if (! stateTracker.isClipEmpty())
+        recording->add (new Recording::DrawLine (line));
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawGlyph (int glyphNumber, const AffineTransform& t)
+{
+    if (recording == nullptr)
+        stateTracker.drawGlyph (glyphNumber, t);
+    else if (! stateTracker.isClipEmpty())
+        recording->add (new Recording::DrawGlyph (glyphNumber, t, recording->glyphNeedsTypefaceLock (t)));
+}
@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_LOWLEVELGRAPHICSTILEDSOFTWARERENDERER_H_INCLUDED
+#define JUCE_LOWLEVELGRAPHICSTILEDSOFTWARERENDERER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A software renderer which spreads the work of drawing a large area across the
+    threads of a ThreadPool.
+
+    Instead of drawing each operation immediately, this context records everything
+    that's drawn into it. When it's deleted, the clip region is divided into horizontal
+    bands, and the recorded operations are replayed into each band on the pool's threads,
+    with each band being drawn by its own LowLevelGraphicsSoftwareRenderer. The end
+    result is the same as drawing with a single LowLevelGraphicsSoftwareRenderer, apart
+    from occasional rounding differences in anti-aliased pixels at the edges of the clip
+    region.
+
+    Because the drawing is deferred, any images that are drawn must not be modified
+    until the context has been deleted. If the area being drawn is too small to be
+    worth splitting up, the context just draws everything directly.
+
+    User code is not supposed to create instances of this class directly - do all your
+    rendering via the Graphics class instead.
+
+    @see LookAndFeel::setRenderingThreadPool
+*/
+class JUCE_API  LowLevelGraphicsTiledSoftwareRenderer    : public LowLevelGraphicsContext
+{
+public:
+    //==============================================================================
+    /** Creates a context to render into a clipped subsection of an image.
+        The pool is used by the destructor to do the rendering, so it must not be
+        deleted before this context.
+    */
+    LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto, Point<int> origin,
+                                           const RectangleList<int>& initialClip,
+                                           ThreadPool& threadPoolToUse);
+
+    /** Destructor.
+        This is where all the recorded drawing operations get rendered.
+    */
+    ~LowLevelGraphicsTiledSoftwareRenderer();
+
+    //==============================================================================
+    bool isVectorDevice() const override;
+    void setOrigin (Point<int>) override;
+    void addTransform (const AffineTransform&) override;
+    float getPhysicalPixelScaleFactor() override;
+    bool clipToRectangle (const Rectangle<int>&) override;
+    bool clipToRectangleList (const RectangleList<int>&) override;
+    void excludeClipRectangle (const Rectangle<int>&) override;
+    void clipToPath (const Path&, const AffineTransform&) override;
+    void clipToImageAlpha (const Image&, const AffineTransform&) override;
+    bool clipRegionIntersects (const Rectangle<int>&) override;
+    Rectangle<int> getClipBounds() const override;
+    bool isClipEmpty() const override;
+    void saveState() override;
+    void restoreState() override;
+    void beginTransparencyLayer (float opacity) override;
+    void endTransparencyLayer() override;
+    void setFill (const FillType&) override;
+    void setOpacity (float) override;
+    void setInterpolationQuality (Graphics::ResamplingQuality) override;
+    void fillRect (const Rectangle<int>&, bool replaceExistingContents) override;
+    void fillRect (const Rectangle<float>&) override;
+    void fillRectList (const RectangleList<float>&) override;
+    void fillPath (const Path&, const AffineTransform&) override;
+    void drawImage (const Image&, const AffineTransform&) override;
+    void drawLine (const Line<float>&) override;
+    void setFont (const Font&) override;
+    const Font& getFont() override;
+    void drawGlyph (int glyphNumber, const AffineTransform&) override;
+
+private:
+    //==============================================================================
+    // All the state changes are applied to this context so that it can answer queries
+    // about the clip region - it only does any drawing if nothing is being recorded.
+    LowLevelGraphicsSoftwareRenderer stateTracker;
+
+    class Recording;
+    friend class Recording;
+    friend struct ContainerDeletePolicy<Recording>;
+    ScopedPointer<Recording> recording;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LowLevelGraphicsTiledSoftwareRenderer)
+};
+
+
+#endif   // JUCE_LOWLEVELGRAPHICSTILEDSOFTWARERENDERER_H_INCLUDED
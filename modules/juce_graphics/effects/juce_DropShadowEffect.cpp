@@ -22,44 +22,161 @@
   ==============================================================================
 */
 
-static inline void blurDataTriplets (uint8* d, int num, const int delta) noexcept
+namespace ImageBlurHelpers
 {
-    uint32 last = d[0];
-    d[0] = (uint8) ((d[0] + d[delta] + 1) / 3);
-    d += delta;
+    // A gaussian blur is approximated by a few passes of a box blur, each of which is done
+    // with a running sum, so the cost per pixel doesn't depend on the radius. Pixels beyond
+    // the edges of the image are treated as being zero.
+    enum { numBoxBlurPasses = 3 };
+
+    // Finds the box sizes whose combined variance is closest to the given one. Each pass can
+    // use one of two neighbouring odd widths, so the total doesn't have to be a multiple of 3.
+    static void getBoxBlurRadii (const double variance, int* radii) noexcept
+    {
+        const int n = numBoxBlurPasses;
+        int lowerWidth = (int) std::sqrt (12.0 * variance / n + 1.0);
+
+        if ((lowerWidth & 1) == 0)
+            --lowerWidth;
 
-    num -= 2;
+        const int numLower = jlimit (0, n, roundToInt ((12.0 * variance - n * lowerWidth * lowerWidth
+                                                          - 4.0 * n * lowerWidth - 3.0 * n)
+                                                         / (-4.0 * lowerWidth - 4.0)));
 
-    do
+        for (int i = 0; i < n; ++i)
+            radii[i] = ((i < numLower ? lowerWidth : lowerWidth + 2) - 1) / 2;
+    }
+
+    static inline uint32 getBoxBlurMultiplier (const int radius) noexcept
     {
-        const uint32 newLast = d[0];
-        d[0] = (uint8) ((last + d[0] + d[delta] + 1) / 3);
-        d += delta;
-        last = newLast;
+        return (uint32) ((65536 + radius) / (2 * radius + 1));
     }
-    while (--num > 0);
 
-    d[0] = (uint8) ((last + d[0] + 1) / 3);
-}
+    static void boxBlurRow (const uint8* src, uint8* dest, const int width, const int radius) noexcept
+    {
+        const uint32 multiplier = getBoxBlurMultiplier (radius);
+        uint32 sum = 0;
 
-static void blurSingleChannelImage (uint8* const data, const int width, const int height,
-                                    const int lineStride, const int repetitions) noexcept
-{
-    jassert (width > 2 && height > 2);
+        for (int x = jmin (radius, width - 1); x >= 0; --x)
+            sum += src[x];
 
-    for (int y = 0; y < height; ++y)
-        for (int i = repetitions; --i >= 0;)
-            blurDataTriplets (data + lineStride * y, width, 1);
+        for (int x = 0; x < width; ++x)
+        {
+            dest[x] = (uint8) ((sum * multiplier + 32768) >> 16);
 
-    for (int x = 0; x < width; ++x)
-        for (int i = repetitions; --i >= 0;)
-            blurDataTriplets (data + x, height, lineStride);
-}
+            if (x + radius + 1 < width)   sum += src [x + radius + 1];
+            if (x - radius >= 0)          sum -= src [x - radius];
+        }
+    }
 
-static void blurSingleChannelImage (Image& image, int radius)
-{
-    const Image::BitmapData bm (image, Image::BitmapData::readWrite);
-    blurSingleChannelImage (bm.data, bm.width, bm.height, bm.lineStride, 2 * radius);
+    // (the columns are all summed together a row at a time, so that the memory is read
+    // in order and the inner loops can be vectorised by the compiler)
+    static void boxBlurColumns (const uint8* src, const int srcStride, uint8* dest, const int destStride,
+                                const int width, const int height, const int radius, uint32* sums) noexcept
+    {
+        const uint32 multiplier = getBoxBlurMultiplier (radius);
+        zeromem (sums, sizeof (uint32) * (size_t) width);
+
+        for (int y = jmin (radius, height - 1); y >= 0; --y)
+        {
+            const uint8* const s = src + y * srcStride;
+
+            for (int x = 0; x < width; ++x)
+                sums[x] += s[x];
+        }
+
+        for (int y = 0; y < height; ++y)
+        {
+            uint8* const d = dest + y * destStride;
+
+            for (int x = 0; x < width; ++x)
+                d[x] = (uint8) ((sums[x] * multiplier + 32768) >> 16);
+
+            if (y + radius + 1 < height)
+            {
+                const uint8* const s = src + (y + radius + 1) * srcStride;
+
+                for (int x = 0; x < width; ++x)
+                    sums[x] += s[x];
+            }
+
+            if (y - radius >= 0)
+            {
+                const uint8* const s = src + (y - radius) * srcStride;
+
+                for (int x = 0; x < width; ++x)
+                    sums[x] -= s[x];
+            }
+        }
+    }
+
+    static void blurSingleChannelImage (uint8* const data, const int width, const int height,
+                                        const int lineStride, const double variance)
+    {
+        if (width <= 0 || height <= 0 || variance <= 0)
+            return;
+
+        int radii [numBoxBlurPasses];
+        getBoxBlurRadii (variance, radii);
+
+        HeapBlock<uint8> temp ((size_t) (width * height));
+        HeapBlock<uint32> sums ((size_t) width);
+
+        for (int pass = 0; pass < numBoxBlurPasses; ++pass)
+        {
+            const int radius = radii[pass];
+
+            if (radius > 0)
+            {
+                for (int y = 0; y < height; ++y)
+                    boxBlurRow (data + y * lineStride, temp + y * width, width, radius);
+
+                boxBlurColumns (temp, width, data, lineStride, width, height, radius, sums);
+            }
+        }
+    }
+
+    static void blurSingleChannelImage (Image& image, const double variance)
+    {
+        jassert (image.getFormat() == Image::SingleChannel);
+
+        const Image::BitmapData bm (image, Image::BitmapData::readWrite);
+        blurSingleChannelImage (bm.data, bm.width, bm.height, bm.lineStride, variance);
+    }
+
+    // This matches the spread of the repeated 3-pixel blurs that shadows used to be made with.
+    static double getVarianceForShadowRadius (const int radius) noexcept
+    {
+        return radius * 4.0 / 3.0;
+    }
+
+    static Image createShadowImage (const Image& srcImage, const int radius)
+    {
+        Image shadowImage (srcImage.convertedToFormat (Image::SingleChannel));
+        shadowImage.duplicateIfShared();
+        blurSingleChannelImage (shadowImage, getVarianceForShadowRadius (radius));
+        return shadowImage;
+    }
+
+    static int64 getAlphaChannelHash (const Image& image)
+    {
+        const Image::BitmapData bm (image, Image::BitmapData::readOnly);
+        const int alphaOffset = (bm.pixelFormat == Image::ARGB) ? PixelARGB::indexA : 0;
+        uint64 hash = (uint64) (bm.width * 65537 + bm.height);
+
+        if (bm.pixelFormat == Image::RGB)
+            return (int64) hash;
+
+        for (int y = 0; y < bm.height; ++y)
+        {
+            const uint8* p = bm.getLinePointer (y) + alphaOffset;
+
+            for (int x = 0; x < bm.width; ++x, p += bm.pixelStride)
+                hash = (hash ^ *p) * 0x100000001b3ULL;
+        }
+
+        return (int64) hash;
+    }
 }
 
 //==============================================================================
@@ -80,10 +197,7 @@ void DropShadow::drawForImage (Graphics& g, const Image& srcImage) const
 
     if (srcImage.isValid())
     {
-        Image shadowImage (srcImage.convertedToFormat (Image::SingleChannel));
-        shadowImage.duplicateIfShared();
-
-        blurSingleChannelImage (shadowImage, radius);
+        const Image shadowImage (ImageBlurHelpers::createShadowImage (srcImage, radius));
 
         g.setColour (colour);
         g.drawImageAt (shadowImage, offset.x, offset.y, true);
@@ -98,7 +212,7 @@ void DropShadow::drawForPath (Graphics& g, const Path& path) const
                                    .expanded (radius + 1)
                                    .getIntersection (g.getClipBounds().expanded (radius + 1)));
 
-    if (area.getWidth() > 2 && area.getHeight() > 2)
+    if (! area.isEmpty())
     {
         Image renderedPath (Image::SingleChannel, area.getWidth(), area.getHeight(), true);
 
@@ -109,7 +223,7 @@ void DropShadow::drawForPath (Graphics& g, const Path& path) const
                                                              (float) (offset.y - area.getY())));
         }
 
-        blurSingleChannelImage (renderedPath, radius);
+        ImageBlurHelpers::blurSingleChannelImage (renderedPath, ImageBlurHelpers::getVarianceForShadowRadius (radius));
 
         g.setColour (colour);
         g.drawImageAt (renderedPath, area.getX(), area.getY(), true);
@@ -159,12 +273,13 @@ void DropShadow::drawForRectangle (Graphics& g, const Rectangle<int>& targetArea
 }
 
 //==============================================================================
-DropShadowEffect::DropShadowEffect() {}
+DropShadowEffect::DropShadowEffect()  : cachedSourceHash (0), cachedShadowRadius (0) {}
 DropShadowEffect::~DropShadowEffect() {}
 
 void DropShadowEffect::setShadowProperties (const DropShadow& newShadow)
 {
     shadow = newShadow;
+    cachedShadowImage = Image();
 }
 
 void DropShadowEffect::applyEffect (Image& image, Graphics& g, float scaleFactor, float alpha)
@@ -175,7 +290,22 @@ void DropShadowEffect::applyEffect (Image& image, Graphics& g, float scaleFactor
     s.offset.x = roundToInt (s.offset.x * scaleFactor);
     s.offset.y = roundToInt (s.offset.y * scaleFactor);
 
-    s.drawForImage (g, image);
+    if (image.isValid())
+    {
+        // A component that's repainted without its shape changing gets the same shadow, so
+        // the blurred image is kept, and only made again when the source's alpha changes.
+        const int64 sourceHash = ImageBlurHelpers::getAlphaChannelHash (image);
+
+        if (cachedShadowImage.isNull() || sourceHash != cachedSourceHash || s.radius != cachedShadowRadius)
+        {
+            cachedShadowImage = ImageBlurHelpers::createShadowImage (image, s.radius);
+            cachedSourceHash = sourceHash;
+            cachedShadowRadius = s.radius;
+        }
+
+        g.setColour (s.colour);
+        g.drawImageAt (cachedShadowImage, s.offset.x, s.offset.y, true);
+    }
 
     g.setOpacity (alpha);
     g.drawImageAt (image, 0, 0);
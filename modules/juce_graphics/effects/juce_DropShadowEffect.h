@@ -72,9 +72,12 @@ struct JUCE_API  DropShadow
     shadow based on what gets drawn inside it. The shadow will also
     be applied to the component's children.
 
-    For speed, this doesn't use a proper gaussian blur, but cheats by
-    using a simple bilinear filter. If you need a really high-quality
-    shadow, check out ImageConvolutionKernel::createGaussianBlur()
+    The shadow is blurred with a few passes of a box filter, which approximates
+    a gaussian blur at a cost that doesn't depend on the radius. If you need a
+    really high-quality shadow, check out ImageConvolutionKernel::createGaussianBlur()
+
+    The blurred shadow is kept between repaints, and is only made again if the
+    shape of what's being drawn changes.
 
     @see Component::setComponentEffect
 */
@@ -102,6 +105,9 @@ public:
 private:
     //==============================================================================
     DropShadow shadow;
+    Image cachedShadowImage;
+    int64 cachedSourceHash;
+    int cachedShadowRadius;
 
     JUCE_LEAK_DETECTOR (DropShadowEffect)
 };
@@ -41,14 +41,27 @@ void GlowEffect::setGlowProperties (const float newRadius,
 
 void GlowEffect::applyEffect (Image& image, Graphics& g, float scaleFactor, float alpha)
 {
-    Image temp (image.getFormat(), image.getWidth(), image.getHeight(), true);
-
-    ImageConvolutionKernel blurKernel (roundToInt (radius * scaleFactor * 2.0f));
-
-    blurKernel.createGaussianBlur (radius);
-    blurKernel.rescaleAllValues (radius);
-
-    blurKernel.applyToImage (temp, image, image.getBounds());
+    Image temp (image.convertedToFormat (Image::SingleChannel));
+    temp.duplicateIfShared();
+
+    {
+        // This gives roughly the same spread as the truncated gaussian kernel that used to be
+        // used, which had a size of twice the scaled radius.
+        const double scaledRadius = radius * scaleFactor;
+        ImageBlurHelpers::blurSingleChannelImage (temp, scaledRadius * scaledRadius * 0.3);
+
+        // ..and the glow is strengthened in proportion to its radius, as that kernel was.
+        const int gain = roundToInt (radius * 256.0f);
+        const Image::BitmapData bm (temp, Image::BitmapData::readWrite);
+
+        for (int y = 0; y < bm.height; ++y)
+        {
+            uint8* const line = bm.getLinePointer (y);
+
+            for (int x = 0; x < bm.width; ++x)
+                line[x] = (uint8) jmin (255, (line[x] * gain) >> 8);
+        }
+    }
 
     g.setColour (colour.withMultipliedAlpha (alpha));
     g.drawImageAt (temp, 0, 0, true);
@@ -39,22 +39,53 @@ public:
     void addKerningPair (const juce_wchar subsequentCharacter,
                          const float extraKerningAmount) noexcept
     {
-        KerningPair kp;
-        kp.character2 = subsequentCharacter;
-        kp.kerningAmount = extraKerningAmount;
-        kerningPairs.add (kp);
+        // The pairs are kept sorted so that they can be binary-searched - a FreeType
+        // font can have hundreds of them for each glyph.
+        const int index = findKerningPairIndex (subsequentCharacter);
+
+        if (index < kerningPairs.size() && kerningPairs.getReference (index).character2 == subsequentCharacter)
+        {
+            kerningPairs.getReference (index).kerningAmount = extraKerningAmount;
+        }
+        else
+        {
+            KerningPair kp;
+            kp.character2 = subsequentCharacter;
+            kp.kerningAmount = extraKerningAmount;
+            kerningPairs.insert (index, kp);
+        }
     }
 
     float getHorizontalSpacing (const juce_wchar subsequentCharacter) const noexcept
     {
-        if (subsequentCharacter != 0)
-            for (int i = kerningPairs.size(); --i >= 0;)
-                if (kerningPairs.getReference(i).character2 == subsequentCharacter)
-                    return width + kerningPairs.getReference(i).kerningAmount;
+        if (subsequentCharacter != 0 && kerningPairs.size() > 0)
+        {
+            const int index = findKerningPairIndex (subsequentCharacter);
+
+            if (index < kerningPairs.size() && kerningPairs.getReference (index).character2 == subsequentCharacter)
+                return width + kerningPairs.getReference (index).kerningAmount;
+        }
 
         return width;
     }
 
+    int findKerningPairIndex (const juce_wchar subsequentCharacter) const noexcept
+    {
+        int start = 0, end = kerningPairs.size();
+
+        while (start < end)
+        {
+            const int mid = (start + end) / 2;
+
+            if (kerningPairs.getReference (mid).character2 < subsequentCharacter)
+                start = mid + 1;
+            else
+                end = mid;
+        }
+
+        return start;
+    }
+
     const juce_wchar character;
     const Path path;
     float width;
@@ -155,6 +186,7 @@ void CustomTypeface::clear()
     ascent = 1.0f;
     style = "Regular";
     zeromem (lookupTable, sizeof (lookupTable));
+    otherGlyphLookups.clear();
     glyphs.clear();
 }
 
@@ -181,9 +213,7 @@ void CustomTypeface::addGlyph (const juce_wchar character, const Path& path, con
     // Check that you're not trying to add the same character twice..
     jassert (findGlyph (character, false) == nullptr);
 
-    if (isPositiveAndBelow ((int) character, (int) numElementsInArray (lookupTable)))
-        lookupTable [character] = (short) glyphs.size();
-
+    setGlyphLookup (character, glyphs.size() + 1);
     glyphs.add (new GlyphInfo (character, path, width));
 }
 
@@ -198,20 +228,32 @@ void CustomTypeface::addKerningPair (const juce_wchar char1, const juce_wchar ch
     }
 }
 
+// The lookups hold (index + 1) of a character's glyph, 0 for a character that hasn't been
+// asked for yet, or -1 for one that loadGlyphIfPossible() has already failed to provide.
+void CustomTypeface::setGlyphLookup (const juce_wchar character, const int entry) noexcept
+{
+    if (isPositiveAndBelow ((int) character, (int) numElementsInArray (lookupTable)))
+        lookupTable [character] = entry;
+    else
+        otherGlyphLookups.set ((int) character, entry);
+}
+
 CustomTypeface::GlyphInfo* CustomTypeface::findGlyph (const juce_wchar character, const bool loadIfNeeded) noexcept
 {
-    if (isPositiveAndBelow ((int) character, (int) numElementsInArray (lookupTable)) && lookupTable [character] > 0)
-        return glyphs [(int) lookupTable [(int) character]];
+    const int entry = isPositiveAndBelow ((int) character, (int) numElementsInArray (lookupTable))
+                        ? lookupTable [character]
+                        : otherGlyphLookups [(int) character];
 
-    for (int i = 0; i < glyphs.size(); ++i)
+    if (entry > 0)
+        return glyphs.getUnchecked (entry - 1);
+
+    if (entry == 0 && loadIfNeeded)
     {
-        GlyphInfo* const g = glyphs.getUnchecked(i);
-        if (g->character == character)
-            return g;
-    }
+        if (loadGlyphIfPossible (character))
+            return findGlyph (character, false);
 
-    if (loadIfNeeded && loadGlyphIfPossible (character))
-        return findGlyph (character, false);
+        setGlyphLookup (character, -1);
+    }
 
     return nullptr;
 }
@@ -307,14 +349,15 @@ float CustomTypeface::getHeightToPointsFactor() const   { return ascent; }
 float CustomTypeface::getStringWidth (const String& text)
 {
     float x = 0;
+    String::CharPointerType t (text.getCharPointer());
 
-    for (String::CharPointerType t (text.getCharPointer()); ! t.isEmpty();)
+    for (juce_wchar c = t.getAndAdvance(), next; c != 0; c = next)
     {
-        const juce_wchar c = t.getAndAdvance();
+        next = t.getAndAdvance();
 
         if (const GlyphInfo* const glyph = findGlyph (c, true))
         {
-            x += glyph->getHorizontalSpacing (*t);
+            x += glyph->getHorizontalSpacing (next);
         }
         else
         {
@@ -332,17 +375,18 @@ void CustomTypeface::getGlyphPositions (const String& text, Array <int>& resultG
 {
     xOffsets.add (0);
     float x = 0;
+    String::CharPointerType t (text.getCharPointer());
 
-    for (String::CharPointerType t (text.getCharPointer()); ! t.isEmpty();)
+    for (juce_wchar c = t.getAndAdvance(), next; c != 0; c = next)
     {
         float width = 0.0f;
         int glyphChar = 0;
 
-        const juce_wchar c = t.getAndAdvance();
+        next = t.getAndAdvance();
 
         if (const GlyphInfo* const glyph = findGlyph (c, true))
         {
-            width = glyph->getHorizontalSpacing (*t);
+            width = glyph->getHorizontalSpacing (next);
             glyphChar = (int) glyph->character;
         }
         else
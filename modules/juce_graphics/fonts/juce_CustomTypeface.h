@@ -154,9 +154,11 @@ private:
     class GlyphInfo;
     friend struct ContainerDeletePolicy<GlyphInfo>;
     OwnedArray<GlyphInfo> glyphs;
-    short lookupTable [128];
+    int lookupTable [256];
+    HashMap<int, int> otherGlyphLookups;
 
     GlyphInfo* findGlyph (const juce_wchar character, bool loadIfNeeded) noexcept;
+    void setGlyphLookup (juce_wchar character, int entry) noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CustomTypeface)
 };
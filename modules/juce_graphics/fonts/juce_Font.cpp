@@ -166,6 +166,7 @@ extern void clearOpenGLGlyphCache();
 void Typeface::clearTypefaceCache()
 {
     TypefaceCache::getInstance()->clear();
+    GlyphArrangementCache::getInstance()->clear();
 
     RenderingHelpers::SoftwareRendererSavedState::clearGlyphCache();
 
@@ -644,6 +645,27 @@ float Font::getStringWidthFloat (const String& text) const
     return w * font->height * font->horizontalScale;
 }
 
+void Font::getStringWidths (const StringArray& strings, Array<float>& widths) const
+{
+    Typeface* const t = getTypeface();
+    const float scale = font->height * font->horizontalScale;
+    const int num = strings.size();
+
+    widths.clearQuick();
+    widths.ensureStorageAllocated (num);
+
+    for (int i = 0; i < num; ++i)
+    {
+        const String& text = strings[i];
+        float w = t->getStringWidth (text);
+
+        if (font->kerning != 0)
+            w += font->kerning * text.length();
+
+        widths.add (w * scale);
+    }
+}
+
 void Font::getGlyphPositions (const String& text, Array<int>& glyphs, Array<float>& xOffsets) const
 {
     getTypeface()->getGlyphPositions (text, glyphs, xOffsets);
@@ -381,6 +381,14 @@ public:
     */
     float getStringWidthFloat (const String& text) const;
 
+    /** Measures a whole set of strings in one go, replacing the contents of the widths
+        array with the width of each string, as getStringWidthFloat() would return it.
+
+        This is handy for things like auto-sizing a table column, where lots of strings
+        need to be measured with the same font.
+    */
+    void getStringWidths (const StringArray& strings, Array<float>& widths) const;
+
     /** Returns the series of glyph numbers and their x offsets needed to represent a string.
 
         An extra x offset is added at the end of the run, to indicate where the right hand
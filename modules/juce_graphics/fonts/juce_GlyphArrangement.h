@@ -305,6 +305,16 @@ public:
                         float x, float y, float width, float height,
                         Justification justification);
 
+    //==============================================================================
+    /** Changes the size of the cache used by Graphics::drawText() and Graphics::drawFittedText().
+
+        Those methods keep the arrangements that they create in a cache which is shared by
+        all components, so that text which is repainted without changing doesn't have to be
+        laid out again. The size is given as a total number of glyphs, and the least recently
+        used arrangements are discarded when it's exceeded. A size of 0 disables the cache.
+    */
+    static void setLayoutCacheSize (int maxNumGlyphs);
+
 
 private:
     //==============================================================================
@@ -300,6 +300,11 @@ void EdgeTable::allocate()
     table.malloc (getEdgeTableAllocationSize (lineStrideElements, bounds.getHeight()));
 }
 
+size_t EdgeTable::getMemoryUsage() const noexcept
+{
+    return getEdgeTableAllocationSize (lineStrideElements, bounds.getHeight()) * sizeof (int);
+}
+
 void EdgeTable::clearLineSizes() noexcept
 {
     int* t = table;
@@ -34,6 +34,10 @@
     add and remove rectangular sections of it, and simplify overlapping or
     adjacent rectangles.
 
+    When two large lists are combined, the result is built as a series of horizontal
+    bands, each containing non-overlapping rectangles sorted from left to right, which
+    keeps the cost roughly proportional to the number of rectangles involved.
+
     @see Rectangle
 */
 template <typename ValueType>
@@ -192,6 +196,14 @@ public:
     */
     void add (const RectangleList& other)
     {
+        if (rects.size() * other.rects.size() >= minComplexityForSweep)
+        {
+            RectangleList result;
+            sweep (rects, other.rects, sweepUnion, result);
+            swapWith (result);
+            return;
+        }
+
         for (const RectangleType* r = other.begin(), * const e = other.end(); r != e; ++r)
             add (*r);
     }
@@ -293,6 +305,14 @@ public:
     */
     bool subtract (const RectangleList& otherList)
     {
+        if (rects.size() * otherList.rects.size() >= minComplexityForSweep)
+        {
+            RectangleList result;
+            sweep (rects, otherList.rects, sweepDifference, result);
+            swapWith (result);
+            return rects.size() > 0;
+        }
+
         for (int i = otherList.rects.size(); --i >= 0 && rects.size() > 0;)
             subtract (otherList.rects.getReference (i));
 
@@ -351,6 +371,19 @@ public:
 
         RectangleList result;
 
+        if (rects.size() * other.getNumRectangles() >= minComplexityForSweep)
+        {
+            RectangleList converted;
+            converted.ensureStorageAllocated (other.getNumRectangles());
+
+            for (const Rectangle<OtherValueType>* r = other.begin(), * const e = other.end(); r != e; ++r)
+                converted.addWithoutMerging (r->template toType<ValueType>());
+
+            sweep (rects, converted.rects, sweepIntersection, result);
+            swapWith (result);
+            return ! isEmpty();
+        }
+
         for (int j = 0; j < rects.size(); ++j)
         {
             const RectangleType& rect = rects.getReference (j);
@@ -524,6 +557,14 @@ public:
     */
     void consolidate()
     {
+        if (rects.size() * rects.size() >= minComplexityForSweep)
+        {
+            RectangleList result;
+            sweep (rects, Array<RectangleType>(), sweepUnion, result);
+            swapWith (result);
+            return;
+        }
+
         for (int i = 0; i < getNumRectangles() - 1; ++i)
         {
             RectangleType& r = rects.getReference (i);
@@ -656,6 +697,228 @@ public:
 private:
     //==============================================================================
     Array<RectangleType> rects;
+
+    //==============================================================================
+    /*  When the lists being combined are big enough for the simple rectangle-by-rectangle
+        methods to be slow (they're quadratic), a sweep is done instead: the region is cut
+        into horizontal bands wherever a rectangle starts or ends, and each band is combined
+        as a sorted list of x-spans, like an X11 region. The result is a list of bands of
+        non-overlapping rectangles, with identical neighbouring bands merged together.
+    */
+    enum { minComplexityForSweep = 256 };
+
+    enum SweepOperation
+    {
+        sweepUnion,
+        sweepIntersection,
+        sweepDifference
+    };
+
+    struct Span
+    {
+        ValueType start, end;
+
+        bool operator== (const Span& other) const noexcept  { return start == other.start && end == other.end; }
+        bool operator!= (const Span& other) const noexcept  { return ! operator== (other); }
+    };
+
+    static bool isHigher (const RectangleType* a, const RectangleType* b) noexcept     { return a->getY() < b->getY(); }
+    static bool spanStartsFirst (const Span& a, const Span& b) noexcept                { return a.start < b.start; }
+
+    struct SweepList
+    {
+        SweepList (const Array<RectangleType>& sourceRects)  : next (0)
+        {
+            sorted.ensureStorageAllocated (sourceRects.size());
+
+            for (const RectangleType* r = sourceRects.begin(), * const e = sourceRects.end(); r != e; ++r)
+                sorted.add (r);
+
+            std::sort (sorted.begin(), sorted.end(), isHigher);
+        }
+
+        // Moves down to y, picking up the rectangles that start there and dropping the ones that end.
+        void moveTo (const ValueType y)
+        {
+            for (int i = active.size(); --i >= 0;)
+                if (active.getUnchecked (i)->getBottom() <= y)
+                    active.remove (i);
+
+            while (next < sorted.size() && sorted.getUnchecked (next)->getY() <= y)
+                active.add (sorted.getUnchecked (next++));
+        }
+
+        // Finds the next y below the current position at which the active set changes.
+        void findNextEdge (ValueType& y, bool& found) const noexcept
+        {
+            if (next < sorted.size())
+                updateEdge (sorted.getUnchecked (next)->getY(), y, found);
+
+            for (const RectangleType* const* r = active.begin(), * const* const e = active.end(); r != e; ++r)
+                updateEdge ((*r)->getBottom(), y, found);
+        }
+
+        void getSpans (Array<Span>& spans) const
+        {
+            spans.clearQuick();
+
+            for (const RectangleType* const* r = active.begin(), * const* const e = active.end(); r != e; ++r)
+            {
+                const Span s = { (*r)->getX(), (*r)->getRight() };
+                spans.add (s);
+            }
+
+            mergeSpans (spans);
+        }
+
+        static void updateEdge (const ValueType edge, ValueType& y, bool& found) noexcept
+        {
+            if (! found || edge < y)
+            {
+                y = edge;
+                found = true;
+            }
+        }
+
+        Array<const RectangleType*> sorted, active;
+        int next;
+    };
+
+    // Sorts a set of spans and joins any that overlap or touch.
+    static void mergeSpans (Array<Span>& spans)
+    {
+        if (spans.size() > 1)
+        {
+            std::sort (spans.begin(), spans.end(), spanStartsFirst);
+
+            Span* const s = spans.getRawDataPointer();
+            int numMerged = 0;
+
+            for (int i = 1; i < spans.size(); ++i)
+            {
+                if (s[i].start <= s[numMerged].end)
+                    s[numMerged].end = jmax (s[numMerged].end, s[i].end);
+                else
+                    s[++numMerged] = s[i];
+            }
+
+            spans.resize (numMerged + 1);
+        }
+    }
+
+    static void combineSpans (const Array<Span>& a, const Array<Span>& b,
+                              const SweepOperation op, Array<Span>& result)
+    {
+        result.clearQuick();
+
+        if (op == sweepUnion)
+        {
+            result.addArray (a);
+            result.addArray (b);
+            mergeSpans (result);
+        }
+        else if (op == sweepIntersection)
+        {
+            for (int i = 0, j = 0; i < a.size() && j < b.size();)
+            {
+                const Span& sa = a.getReference (i);
+                const Span& sb = b.getReference (j);
+                const Span s = { jmax (sa.start, sb.start), jmin (sa.end, sb.end) };
+
+                if (s.start < s.end)
+                    result.add (s);
+
+                if (sa.end < sb.end)
+                    ++i;
+                else
+                    ++j;
+            }
+        }
+        else
+        {
+            int j = 0;
+
+            for (int i = 0; i < a.size(); ++i)
+            {
+                const Span& sa = a.getReference (i);
+                ValueType pos = sa.start;
+
+                while (j < b.size() && b.getReference (j).end <= pos)
+                    ++j;
+
+                for (; j < b.size() && b.getReference (j).start < sa.end; ++j)
+                {
+                    const Span& sb = b.getReference (j);
+
+                    if (sb.start > pos)
+                    {
+                        const Span s = { pos, sb.start };
+                        result.add (s);
+                    }
+
+                    pos = sb.end;
+
+                    if (pos >= sa.end)
+                        break;
+                }
+
+                if (pos < sa.end)
+                {
+                    const Span s = { pos, sa.end };
+                    result.add (s);
+                }
+            }
+        }
+    }
+
+    static void sweep (const Array<RectangleType>& a, const Array<RectangleType>& b,
+                       const SweepOperation op, RectangleList& result)
+    {
+        SweepList listA (a), listB (b);
+        Array<Span> spansA, spansB, spans, lastSpans;
+        ValueType top = ValueType(), bottom = ValueType();
+        int firstRectInLastBand = 0;
+        bool found = false;
+
+        result.clear();
+        listA.findNextEdge (top, found);
+        listB.findNextEdge (top, found);
+
+        while (found)
+        {
+            listA.moveTo (top);
+            listB.moveTo (top);
+
+            found = false;
+            listA.findNextEdge (bottom, found);
+            listB.findNextEdge (bottom, found);
+
+            if (! found)
+                break;
+
+            listA.getSpans (spansA);
+            listB.getSpans (spansB);
+            combineSpans (spansA, spansB, op, spans);
+
+            if (spans.size() > 0 && spans == lastSpans
+                 && result.rects.getReference (firstRectInLastBand).getBottom() == top)
+            {
+                for (int i = firstRectInLastBand; i < result.rects.size(); ++i)
+                    result.rects.getReference (i).setBottom (bottom);
+            }
+            else
+            {
+                firstRectInLastBand = result.rects.size();
+
+                for (const Span* s = spans.begin(), * const e = spans.end(); s != e; ++s)
+                    result.rects.add (RectangleType (s->start, top, s->end - s->start, bottom - top));
+
+                lastSpans.swapWith (spans);
+            }
+
+            top = bottom;
+        }
+    }
 };
 
 
@@ -246,12 +246,27 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
     using namespace jpeglibNamespace;
     using namespace JPEGHelpers;
 
+    // If the data's already in memory, it can be decoded where it is rather than copied..
     MemoryOutputStream mb;
-    mb << in;
+    const int64 startPosition = in.getPosition();
+    const uint8* data = nullptr;
+    size_t dataSize = 0;
+
+    if (MemoryInputStream* const mis = dynamic_cast<MemoryInputStream*> (&in))
+    {
+        data = static_cast<const uint8*> (mis->getData()) + startPosition;
+        dataSize = mis->getDataSize() - (size_t) startPosition;
+    }
+    else
+    {
+        mb << in;
+        data = static_cast<const uint8*> (mb.getData());
+        dataSize = mb.getDataSize();
+    }
 
     Image image;
 
-    if (mb.getDataSize() > 16)
+    if (dataSize > 16)
     {
         struct jpeg_decompress_struct jpegDecompStruct;
 
@@ -270,8 +285,8 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
         jpegDecompStruct.src->resync_to_restart = jpeg_resync_to_restart;
         jpegDecompStruct.src->term_source       = dummyCallback1;
 
-        jpegDecompStruct.src->next_input_byte   = static_cast <const unsigned char*> (mb.getData());
-        jpegDecompStruct.src->bytes_in_buffer   = mb.getDataSize();
+        jpegDecompStruct.src->next_input_byte   = data;
+        jpegDecompStruct.src->bytes_in_buffer   = dataSize;
 
         try
         {
@@ -327,7 +342,7 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
 
                 jpeg_finish_decompress (&jpegDecompStruct);
 
-                in.setPosition (((char*) jpegDecompStruct.src->next_input_byte) - (char*) mb.getData());
+                in.setPosition (startPosition + (jpegDecompStruct.src->next_input_byte - data));
             }
 
             jpeg_destroy_decompress (&jpegDecompStruct);
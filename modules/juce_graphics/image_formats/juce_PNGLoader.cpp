@@ -319,6 +319,40 @@ namespace PNGHelpers
     }
 
     static void JUCE_CDECL warningCallback (png_structp, png_const_charp) {}
+
+    // True if libpng can be told to write its pixels straight into this bitmap, i.e.
+    // if the bitmap's bytes are in B, G, R (, A) order with no padding.
+    static bool canDecodeDirectly (const Image::BitmapData& data, const bool hasAlphaChan) noexcept
+    {
+        if (hasAlphaChan)
+            return data.pixelFormat == Image::ARGB && data.pixelStride == 4
+                    && PixelARGB::indexB == 0 && PixelARGB::indexG == 1
+                    && PixelARGB::indexR == 2 && PixelARGB::indexA == 3;
+
+        return data.pixelFormat == Image::RGB && data.pixelStride == 3
+                && PixelRGB::indexB == 0 && PixelRGB::indexG == 1 && PixelRGB::indexR == 2;
+    }
+
+    // Premultiplies a line of ARGB pixels in place. The red and blue channels are done
+    // together in one multiply, which gives the same results as PixelARGB::premultiply().
+    static void premultiplyLine (uint8* line, const int numPixels) noexcept
+    {
+        PixelARGB* const pixels = reinterpret_cast<PixelARGB*> (line);
+
+        for (int i = 0; i < numPixels; ++i)
+        {
+            const uint32 argb = pixels[i].getARGB();
+            const uint32 alpha = argb >> 24;
+
+            if (alpha < 0xff)
+            {
+                const uint32 rb = (((argb & 0x00ff00ff) * alpha + 0x007f007f) >> 8) & 0x00ff00ff;
+                const uint32 g  = (((argb & 0x0000ff00) * alpha + 0x00007f00) >> 8) & 0x0000ff00;
+
+                pixels[i] = PixelARGB (alpha == 0 ? 0 : ((alpha << 24) | rb | g));
+            }
+        }
+    }
    #endif
 }
 
@@ -394,11 +428,49 @@ Image PNGImageFormat::decodeImage (InputStream& in)
             if (colorType == PNG_COLOR_TYPE_GRAY || colorType == PNG_COLOR_TYPE_GRAY_ALPHA)
                 png_set_gray_to_rgb (pngReadStruct);
 
-            png_set_add_alpha (pngReadStruct, 0xff, PNG_FILLER_AFTER);
-
             bool hasAlphaChan = (colorType & PNG_COLOR_MASK_ALPHA) != 0
                                   || pngInfoStruct->num_trans > 0;
 
+            {
+                Image directImage (hasAlphaChan ? Image::ARGB : Image::RGB,
+                                   (int) width, (int) height, hasAlphaChan);
+
+                const Image::BitmapData destData (directImage, Image::BitmapData::writeOnly);
+
+                if (PNGHelpers::canDecodeDirectly (destData, hasAlphaChan))
+                {
+                    // The image is in libpng's byte order (once it's told to use BGR), so the
+                    // rows can be decoded straight into it without a temporary copy..
+                    png_set_bgr (pngReadStruct);
+
+                    if (hasAlphaChan)
+                        png_set_add_alpha (pngReadStruct, 0xff, PNG_FILLER_AFTER);
+
+                    HeapBlock<png_bytep> rows (height);
+                    for (size_t y = 0; y < height; ++y)
+                        rows[y] = (png_bytep) destData.getLinePointer ((int) y);
+
+                    try
+                    {
+                        png_read_image (pngReadStruct, rows);
+                        png_read_end (pngReadStruct, pngInfoStruct);
+                    }
+                    catch (PNGHelpers::PNGErrorStruct&)
+                    {}
+
+                    png_destroy_read_struct (&pngReadStruct, &pngInfoStruct, 0);
+
+                    if (hasAlphaChan)
+                        for (int y = 0; y < (int) height; ++y)
+                            PNGHelpers::premultiplyLine (destData.getLinePointer (y), (int) width);
+
+                    directImage.getProperties()->set ("originalImageHadAlpha", hasAlphaChan);
+                    return directImage;
+                }
+            }
+
+            png_set_add_alpha (pngReadStruct, 0xff, PNG_FILLER_AFTER);
+
             // Load the image into a temp buffer in the pnglib format..
             const size_t lineStride = width * 4;
             HeapBlock<uint8> tempBuffer (height * lineStride);
@@ -436,10 +508,24 @@ Image PNGImageFormat::decodeImage (InputStream& in)
                     for (int i = (int) width; --i >= 0;)
                     {
                         ((PixelARGB*) dest)->setARGB (src[3], src[0], src[1], src[2]);
-                        ((PixelARGB*) dest)->premultiply();
                         dest += destData.pixelStride;
                         src += 4;
                     }
+
+                    if (destData.pixelStride == 4)
+                    {
+                        PNGHelpers::premultiplyLine (destData.getLinePointer (y), (int) width);
+                    }
+                    else
+                    {
+                        dest = destData.getLinePointer (y);
+
+                        for (int i = (int) width; --i >= 0;)
+                        {
+                            ((PixelARGB*) dest)->premultiply();
+                            dest += destData.pixelStride;
+                        }
+                    }
                 }
                 else
                 {
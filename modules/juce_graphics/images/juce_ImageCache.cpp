@@ -26,12 +26,14 @@ class ImageCache::Pimpl     : private Timer,
                               private DeletedAtShutdown
 {
 public:
-    Pimpl()  : cacheTimeout (5000)
+    Pimpl()  : cacheTimeout (5000), maxCacheSize (0), totalCacheSize (0)
     {
     }
 
     ~Pimpl()
     {
+        // (this must stop any loads in progress before the rest of the cache is deleted)
+        loaderThreads = nullptr;
         clearSingletonInstance();
     }
 
@@ -41,10 +43,13 @@ public:
 
         for (int i = images.size(); --i >= 0;)
         {
-            const Item* const item = images.getUnchecked(i);
+            Item* const item = images.getUnchecked(i);
 
             if (item->hashCode == hashCode)
+            {
+                item->lastUseTime = Time::getApproximateMillisecondCounter();
                 return item->image;
+            }
         }
 
         return Image::null;
@@ -61,9 +66,12 @@ public:
             item->hashCode = hashCode;
             item->image = image;
             item->lastUseTime = Time::getApproximateMillisecondCounter();
+            item->numBytes = getNumBytesUsed (image);
 
             const ScopedLock sl (lock);
             images.add (item);
+            totalCacheSize += item->numBytes;
+            applySizeLimit();
         }
     }
 
@@ -80,7 +88,7 @@ public:
             if (item->image.getReferenceCount() <= 1)
             {
                 if (now > item->lastUseTime + cacheTimeout || now < item->lastUseTime - 1000)
-                    images.remove (i);
+                    removeItem (i);
             }
             else
             {
@@ -88,6 +96,8 @@ public:
             }
         }
 
+        applySizeLimit();
+
         if (images.size() == 0)
             stopTimer();
     }
@@ -98,13 +108,103 @@ public:
 
         for (int i = images.size(); --i >= 0;)
             if (images.getUnchecked(i)->image.getReferenceCount() <= 1)
-                images.remove (i);
+                removeItem (i);
+    }
+
+    void setMaximumCacheSize (const int64 maxNumBytes)
+    {
+        const ScopedLock sl (lock);
+        maxCacheSize = maxNumBytes;
+        applySizeLimit();
+    }
+
+    //==============================================================================
+    void loadAsync (const int64 hashCode, const File& file, const void* data, const size_t dataSize,
+                    ImageCache::Listener* const listener)
+    {
+        const ScopedLock sl (lock);
+
+        for (int i = pendingLoads.size(); --i >= 0;)
+        {
+            PendingLoad* const p = pendingLoads.getUnchecked(i);
+
+            if (p->hashCode == hashCode)
+            {
+                if (listener != nullptr)
+                    p->listeners.addIfNotAlreadyThere (listener);
+
+                return;
+            }
+        }
+
+        PendingLoad* const p = new PendingLoad();
+        p->hashCode = hashCode;
+
+        if (listener != nullptr)
+            p->listeners.add (listener);
+
+        pendingLoads.add (p);
+
+        if (loaderThreads == nullptr)
+            loaderThreads = new ThreadPool (jlimit (1, 4, SystemStats::getNumCpus() - 1));
+
+        loaderThreads->addJob (new LoaderJob (*this, hashCode, file, data, dataSize), true);
+    }
+
+    void cancelAsyncLoads (ImageCache::Listener* const listener)
+    {
+        const ScopedLock sl (lock);
+
+        for (int i = pendingLoads.size(); --i >= 0;)
+            pendingLoads.getUnchecked(i)->listeners.removeFirstMatchingValue (listener);
+    }
+
+    void loadFinished (const int64 hashCode, const Image& image)
+    {
+        if (getFromHashCode (hashCode).isNull())
+            addImageToCache (image, hashCode);
+
+        (new LoadFinishedMessage (hashCode, image))->post();
+    }
+
+    void deliverLoadedImage (const int64 hashCode, const Image& image)
+    {
+        for (;;)
+        {
+            ImageCache::Listener* listener = nullptr;
+
+            {
+                // (the listeners are taken one at a time, so any that are cancelled
+                // during one of these callbacks won't get called afterwards)
+                const ScopedLock sl (lock);
+
+                for (int i = pendingLoads.size(); --i >= 0;)
+                {
+                    PendingLoad* const p = pendingLoads.getUnchecked(i);
+
+                    if (p->hashCode == hashCode)
+                    {
+                        if (p->listeners.size() == 0)
+                            pendingLoads.remove (i);
+                        else
+                            listener = p->listeners.remove (0);
+
+                        break;
+                    }
+                }
+            }
+
+            if (listener == nullptr)
+                break;
+
+            listener->imageCacheLoadFinished (hashCode, image);
+        }
     }
 
     struct Item
     {
         Image image;
-        int64 hashCode;
+        int64 hashCode, numBytes;
         uint32 lastUseTime;
     };
 
@@ -115,6 +215,98 @@ public:
 private:
     OwnedArray<Item> images;
     CriticalSection lock;
+    int64 maxCacheSize, totalCacheSize;
+
+    struct PendingLoad
+    {
+        int64 hashCode;
+        Array<ImageCache::Listener*> listeners;
+    };
+
+    OwnedArray<PendingLoad> pendingLoads;
+    ScopedPointer<ThreadPool> loaderThreads;
+
+    //==============================================================================
+    class LoaderJob  : public ThreadPoolJob
+    {
+    public:
+        LoaderJob (Pimpl& p, int64 hash, const File& f, const void* d, size_t size)
+            : ThreadPoolJob ("ImageCache loader"), owner (p), hashCode (hash),
+              file (f), data (d), dataSize (size)
+        {
+        }
+
+        JobStatus runJob() override
+        {
+            owner.loadFinished (hashCode, data != nullptr ? ImageFileFormat::loadFrom (data, dataSize)
+                                                          : ImageFileFormat::loadFrom (file));
+            return jobHasFinished;
+        }
+
+    private:
+        Pimpl& owner;
+        const int64 hashCode;
+        const File file;
+        const void* const data;
+        const size_t dataSize;
+
+        JUCE_DECLARE_NON_COPYABLE (LoaderJob)
+    };
+
+    struct LoadFinishedMessage  : public CallbackMessage
+    {
+        LoadFinishedMessage (int64 hash, const Image& im)  : hashCode (hash), image (im) {}
+
+        void messageCallback() override
+        {
+            if (Pimpl* const p = Pimpl::getInstanceWithoutCreating())
+                p->deliverLoadedImage (hashCode, image);
+        }
+
+        const int64 hashCode;
+        const Image image;
+    };
+
+    //==============================================================================
+    static int64 getNumBytesUsed (const Image& image) noexcept
+    {
+        const int bytesPerPixel = image.isARGB() ? 4 : (image.isRGB() ? 3 : 1);
+        return image.getWidth() * (int64) image.getHeight() * bytesPerPixel;
+    }
+
+    void removeItem (const int index)
+    {
+        totalCacheSize -= images.getUnchecked (index)->numBytes;
+        images.remove (index);
+    }
+
+    // Removes the least recently used images that nothing else is referencing
+    // until the total size is back within the limit.
+    void applySizeLimit()
+    {
+        while (maxCacheSize > 0 && totalCacheSize > maxCacheSize)
+        {
+            int oldestIndex = -1;
+            uint32 oldestTime = 0;
+
+            for (int i = images.size(); --i >= 0;)
+            {
+                const Item* const item = images.getUnchecked(i);
+
+                if (item->image.getReferenceCount() <= 1
+                     && (oldestIndex < 0 || item->lastUseTime < oldestTime))
+                {
+                    oldestIndex = i;
+                    oldestTime = item->lastUseTime;
+                }
+            }
+
+            if (oldestIndex < 0)
+                break;
+
+            removeItem (oldestIndex);
+        }
+    }
 
     JUCE_DECLARE_NON_COPYABLE (Pimpl)
 };
@@ -164,12 +356,56 @@ Image ImageCache::getFromMemory (const void* imageData, const int dataSize)
     return image;
 }
 
+Image ImageCache::getFromFileAsync (const File& file, Listener* const listener, const Image& placeholder)
+{
+    const int64 hashCode = file.hashCode64();
+    const Image image (getFromHashCode (hashCode));
+
+    if (image.isValid())
+        return image;
+
+    Pimpl::getInstance()->loadAsync (hashCode, file, nullptr, 0, listener);
+    return placeholder;
+}
+
+Image ImageCache::getFromMemoryAsync (const void* imageData, const int dataSize,
+                                      Listener* const listener, const Image& placeholder)
+{
+    const int64 hashCode = (int64) (pointer_sized_int) imageData;
+    const Image image (getFromHashCode (hashCode));
+
+    if (image.isValid())
+        return image;
+
+    Pimpl::getInstance()->loadAsync (hashCode, File::nonexistent, imageData, (size_t) dataSize, listener);
+    return placeholder;
+}
+
+void ImageCache::cancelAsyncLoads (Listener* const listener)
+{
+    if (Pimpl::getInstanceWithoutCreating() != nullptr)
+        Pimpl::getInstanceWithoutCreating()->cancelAsyncLoads (listener);
+}
+
+void ImageCache::preloadImages (const Array<File>& files)
+{
+    for (int i = 0; i < files.size(); ++i)
+        if (getFromHashCode (files.getReference(i).hashCode64()).isNull())
+            Pimpl::getInstance()->loadAsync (files.getReference(i).hashCode64(), files.getReference(i), nullptr, 0, nullptr);
+}
+
 void ImageCache::setCacheTimeout (const int millisecs)
 {
     jassert (millisecs >= 0);
     Pimpl::getInstance()->cacheTimeout = (unsigned int) millisecs;
 }
 
+void ImageCache::setMaximumCacheSize (const int64 maxNumBytes)
+{
+    jassert (maxNumBytes >= 0);
+    Pimpl::getInstance()->setMaximumCacheSize (maxNumBytes);
+}
+
 void ImageCache::releaseUnusedImages()
 {
     Pimpl::getInstance()->releaseUnusedImages();
@@ -78,6 +78,57 @@ public:
     */
     static Image getFromMemory (const void* imageData, int dataSize);
 
+    //==============================================================================
+    /** Receives callbacks when images that were requested with getFromFileAsync() or
+        getFromMemoryAsync() have finished loading.
+        @see ImageCache::cancelAsyncLoads
+    */
+    class JUCE_API  Listener
+    {
+    public:
+        /** Destructor. */
+        virtual ~Listener()  {}
+
+        /** Called on the message thread when an image has been loaded.
+
+            The hash code is the one under which the image is stored in the cache, i.e.
+            File::hashCode64() for a file, or the address of the data for an image that was
+            loaded from memory. If the image couldn't be loaded, this will be an invalid image.
+        */
+        virtual void imageCacheLoadFinished (int64 hashCode, const Image& newImage) = 0;
+    };
+
+    /** Returns an image from the cache, or starts loading it on a background thread.
+
+        If the image is already in the cache, it's returned immediately. Otherwise, the
+        placeholder (which can be a null Image) is returned, and the listener (if it isn't
+        null) will be called on the message thread when the real image is ready, at which
+        point it will also have been added to the cache.
+
+        If the listener is deleted before that happens, you must call cancelAsyncLoads()
+        to remove it.
+        @see getFromFile, preloadImages
+    */
+    static Image getFromFileAsync (const File& file, Listener* listener,
+                                   const Image& placeholder);
+
+    /** Returns an image from the cache, or starts loading it on a background thread.
+
+        This works like getFromFileAsync(), for an image in a block of memory. The memory
+        must stay valid until the image has been loaded.
+        @see getFromMemory
+    */
+    static Image getFromMemoryAsync (const void* imageData, int dataSize, Listener* listener,
+                                     const Image& placeholder);
+
+    /** Stops a listener from receiving any callbacks for loads that are still in progress. */
+    static void cancelAsyncLoads (Listener* listener);
+
+    /** Starts loading a set of image files into the cache on a background thread, so
+        that they're ready by the time getFromFile() is called for them.
+    */
+    static void preloadImages (const Array<File>& files);
+
     //==============================================================================
     /** Checks the cache for an image with a particular hashcode.
 
@@ -106,6 +157,15 @@ public:
     */
     static void setCacheTimeout (int millisecs);
 
+    /** Sets a limit on the total size of the pixel data that the cache keeps.
+
+        When the limit is exceeded, the images that have gone unused the longest are
+        dropped first, without waiting for their timeout. Images which are still being
+        used elsewhere can't be released, so they may push the total above the limit.
+        A size of 0 (the default) means that there's no limit.
+    */
+    static void setMaximumCacheSize (int64 maxNumBytes);
+
     /** Releases any images in the cache that aren't being referenced by active
         Image objects.
     */
@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+struct MultiResolutionImage::SharedData  : public ReferenceCountedObject
+{
+    SharedData (int w, int h) noexcept  : width (w), height (h) {}
+
+    struct Version
+    {
+        Image image;
+        float scale;
+        bool isGenerated;
+    };
+
+    const int width, height;
+    Array<Version> versions;
+    CriticalSection lock;
+
+    static const int maxGeneratedVersions = 4;
+
+    // The renderer only blits an image untransformed if its transform is within 0.2% of
+    // a pure translation, so this is kept a bit tighter than that.
+    static bool scalesMatch (float imageScale, float targetScale) noexcept
+    {
+        return std::abs (imageScale - targetScale) < 0.001f * targetScale;
+    }
+
+    int findMatch (float scale) const noexcept
+    {
+        for (int i = 0; i < versions.size(); ++i)
+            if (scalesMatch (versions.getReference(i).scale, scale))
+                return i;
+
+        return -1;
+    }
+
+    // Prefers the smallest of the original versions that's at least as big as needed,
+    // since shrinking gives a better result than enlarging.
+    int findBestSource (float scale) const noexcept
+    {
+        int best = -1;
+
+        for (int i = 0; i < versions.size(); ++i)
+        {
+            const Version& v = versions.getReference(i);
+
+            if (v.isGenerated)
+                continue;
+
+            if (best < 0)
+            {
+                best = i;
+                continue;
+            }
+
+            const float bestScale = versions.getReference (best).scale;
+
+            if (bestScale < scale ? v.scale > bestScale
+                                  : (v.scale >= scale && v.scale < bestScale))
+                best = i;
+        }
+
+        return best;
+    }
+
+    void removeGeneratedVersions (int numToKeep)
+    {
+        for (int i = versions.size(); --i >= 0;)
+            if (versions.getReference(i).isGenerated && --numToKeep < 0)
+                versions.remove (i);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (SharedData)
+};
+
+//==============================================================================
+MultiResolutionImage::MultiResolutionImage() noexcept {}
+
+MultiResolutionImage::MultiResolutionImage (const Image& image, float scale)
+{
+    addImage (image, scale);
+}
+
+MultiResolutionImage::MultiResolutionImage (const MultiResolutionImage& other) noexcept
+    : data (other.data)
+{
+}
+
+MultiResolutionImage& MultiResolutionImage::operator= (const MultiResolutionImage& other) noexcept
+{
+    data = other.data;
+    return *this;
+}
+
+MultiResolutionImage::~MultiResolutionImage() {}
+
+void MultiResolutionImage::addImage (const Image& image, float scale)
+{
+    jassert (scale > 0);
+
+    if (! image.isValid() || scale <= 0)
+        return;
+
+    if (data == nullptr)
+        data = new SharedData (roundToInt (image.getWidth() / scale),
+                               roundToInt (image.getHeight() / scale));
+
+    // All the versions must have the same logical size!
+    jassert (roundToInt (image.getWidth()  / scale) == data->width
+              && roundToInt (image.getHeight() / scale) == data->height);
+
+    const ScopedLock sl (data->lock);
+
+    data->removeGeneratedVersions (0);
+
+    const int existing = data->findMatch (scale);
+
+    if (existing >= 0)
+        data->versions.remove (existing);
+
+    SharedData::Version v = { image, scale, false };
+    data->versions.add (v);
+}
+
+bool MultiResolutionImage::isValid() const noexcept     { return data != nullptr; }
+int MultiResolutionImage::getWidth() const noexcept     { return data != nullptr ? data->width : 0; }
+int MultiResolutionImage::getHeight() const noexcept    { return data != nullptr ? data->height : 0; }
+
+Image MultiResolutionImage::getImageForScale (float scale) const
+{
+    float imageScale;
+    return findImage (scale, imageScale);
+}
+
+void MultiResolutionImage::clearGeneratedImages()
+{
+    if (data != nullptr)
+    {
+        const ScopedLock sl (data->lock);
+        data->removeGeneratedVersions (0);
+    }
+}
+
+Image MultiResolutionImage::findImage (float scale, float& imageScale) const
+{
+    imageScale = 1.0f;
+
+    if (data == nullptr || scale <= 0)
+        return Image();
+
+    const ScopedLock sl (data->lock);
+
+    const int match = data->findMatch (scale);
+
+    if (match >= 0)
+    {
+        const SharedData::Version& v = data->versions.getReference (match);
+        imageScale = v.scale;
+        return v.image;
+    }
+
+    const SharedData::Version& source = data->versions.getReference (data->findBestSource (scale));
+
+    // (the same scale is used for both axes, so that the result can be blitted without
+    // any stretching, even if that leaves the size a fraction of a pixel out)
+    const float relativeScale = scale / source.scale;
+
+    SharedData::Version v = { source.image.rescaled (jmax (1, roundToInt (source.image.getWidth()  * relativeScale)),
+                                                     jmax (1, roundToInt (source.image.getHeight() * relativeScale)),
+                                                     Graphics::highResamplingQuality),
+                              scale, true };
+
+    data->removeGeneratedVersions (SharedData::maxGeneratedVersions - 1);
+    data->versions.add (v);
+
+    imageScale = scale;
+    return v.image;
+}
+
+//==============================================================================
+void MultiResolutionImage::draw (Graphics& g, int x, int y) const
+{
+    draw (g, x, y, Rectangle<int> (getWidth(), getHeight()));
+}
+
+void MultiResolutionImage::draw (Graphics& g, int x, int y, const Rectangle<int>& sourceArea) const
+{
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    float imageScale;
+    const Image image (findImage (scale, imageScale));
+
+    if (! image.isValid())
+        return;
+
+    const Rectangle<float> scaledArea (sourceArea.toFloat() * imageScale);
+    const Rectangle<int> area (Rectangle<int>::leftTopRightBottom (roundToInt (scaledArea.getX()),
+                                                                   roundToInt (scaledArea.getY()),
+                                                                   roundToInt (scaledArea.getRight()),
+                                                                   roundToInt (scaledArea.getBottom())));
+
+    const AffineTransform transform (AffineTransform::scale (1.0f / imageScale)
+                                        .translated (x + area.getX() / imageScale - sourceArea.getX(),
+                                                     y + area.getY() / imageScale - sourceArea.getY()));
+
+    if (SharedData::scalesMatch (imageScale, scale))
+    {
+        // The image's pixels line up with the physical ones, so there's nothing to interpolate.
+        // Dropping to low quality lets the renderer round any fractional position to the
+        // nearest pixel and blit it, rather than resampling the whole thing to shift it.
+        Graphics::ScopedSaveState state (g);
+        g.setImageResamplingQuality (Graphics::lowResamplingQuality);
+        g.drawImageTransformed (image.getClippedImage (area), transform);
+    }
+    else
+    {
+        g.drawImageTransformed (image.getClippedImage (area), transform);
+    }
+}
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_MULTIRESOLUTIONIMAGE_H_INCLUDED
+#define JUCE_MULTIRESOLUTIONIMAGE_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Holds several versions of an image, each prepared for a different display scale.
+
+    When an ordinary Image is drawn into a context whose physical pixel scale isn't 1.0,
+    (e.g. on a display that's set to 150%), the renderer has to resample it every time
+    it's painted. A MultiResolutionImage avoids that by picking the version that matches
+    the context's scale and blitting it without any transform.
+
+    You can add your own versions of the image with addImage(), e.g. 1x and 2x artwork.
+    When it's drawn at a scale for which there's no matching version, one is created by
+    resampling the nearest version at high quality, and is cached for next time.
+
+    Like Image, this is a lightweight reference to some shared data, so copies of it are
+    cheap, and share the same cache.
+
+    e.g. for a filmstrip knob:
+    @code
+    MultiResolutionImage filmstrip (ImageCache::getFromMemory (knob_png, knob_pngSize), 1.0f);
+    filmstrip.addImage (ImageCache::getFromMemory (knob2x_png, knob2x_pngSize), 2.0f);
+
+    void paint (Graphics& g) override
+    {
+        filmstrip.draw (g, 0, 0, Rectangle<int> (0, frameIndex * frameHeight, frameWidth, frameHeight));
+    }
+    @endcode
+
+    @see Image, Graphics::drawImageTransformed
+*/
+class JUCE_API  MultiResolutionImage
+{
+public:
+    //==============================================================================
+    /** Creates an invalid, empty image set. */
+    MultiResolutionImage() noexcept;
+
+    /** Creates a set containing a single image.
+
+        The scale is the number of image pixels per logical unit, so e.g. an image
+        that was drawn for a 2x display should be given a scale of 2.0, and its logical
+        size will be half its size in pixels.
+    */
+    MultiResolutionImage (const Image& image, float scale);
+
+    /** Creates a reference to the same shared data as another set. */
+    MultiResolutionImage (const MultiResolutionImage&) noexcept;
+
+    /** Makes this refer to the same shared data as another set. */
+    MultiResolutionImage& operator= (const MultiResolutionImage&) noexcept;
+
+    /** Destructor. */
+    ~MultiResolutionImage();
+
+    //==============================================================================
+    /** Adds another version of the image, for use at the given scale.
+
+        Its logical size (i.e. its size in pixels divided by the scale) should match that
+        of the other versions. If there's already a version for this scale, it's replaced.
+        Any versions that had been generated automatically are discarded, because a
+        better source might now be available.
+    */
+    void addImage (const Image& image, float scale);
+
+    /** Returns true if the set contains at least one valid image. */
+    bool isValid() const noexcept;
+
+    /** Returns the logical width of the image. */
+    int getWidth() const noexcept;
+
+    /** Returns the logical height of the image. */
+    int getHeight() const noexcept;
+
+    /** Returns the version of the image that would be used for drawing at the given scale,
+        generating and caching it if necessary.
+    */
+    Image getImageForScale (float scale) const;
+
+    /** Frees any versions that were generated automatically. */
+    void clearGeneratedImages();
+
+    //==============================================================================
+    /** Draws the whole image at its logical size, with its top-left at the given position.
+
+        As with Graphics::drawImageAt(), the image is drawn using the context's current
+        opacity.
+    */
+    void draw (Graphics& g, int x, int y) const;
+
+    /** Draws a section of the image at its logical size, with the top-left of the section
+        at the given position.
+
+        The section is in logical coordinates, so e.g. a single frame from a filmstrip can
+        be drawn without the caller needing to know which version of the image is used.
+    */
+    void draw (Graphics& g, int x, int y, const Rectangle<int>& sourceArea) const;
+
+private:
+    //==============================================================================
+    struct SharedData;
+    ReferenceCountedObjectPtr<SharedData> data;
+
+    Image findImage (float scale, float& imageScale) const;
+
+    JUCE_LEAK_DETECTOR (MultiResolutionImage)
+};
+
+
+#endif   // JUCE_MULTIRESOLUTIONIMAGE_H_INCLUDED
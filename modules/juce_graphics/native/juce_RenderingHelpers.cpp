@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+namespace RenderingHelpers
+{
+namespace PixelSpanOperations
+{
+
+#if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+ #define JUCE_USE_PIXEL_SPAN_VECTORS 1
+
+// The vector versions work on four pixels at a time, with each component widened to
+// 16 bits, and use the same arithmetic as the PixelARGB and PixelRGB blend methods.
+#if JUCE_USE_SSE_INTRINSICS
+typedef __m128i PixelQuad;
+typedef __m128i AlphaMultiplier;
+
+static forcedinline PixelQuad loadQuad (const void* p) noexcept          { return _mm_loadu_si128 ((const __m128i*) p); }
+static forcedinline void storeQuad (void* p, PixelQuad q) noexcept       { _mm_storeu_si128 ((__m128i*) p, q); }
+static forcedinline PixelQuad broadcastPixel (uint32 argb) noexcept      { return _mm_set1_epi32 ((int) argb); }
+static forcedinline AlphaMultiplier getMultiplier (uint32 a) noexcept    { return _mm_set1_epi16 ((short) a); }
+
+static forcedinline __m128i blendHalf (__m128i dest, __m128i src) noexcept
+{
+    const __m128i alphas = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (src, _MM_SHUFFLE (3, 3, 3, 3)), _MM_SHUFFLE (3, 3, 3, 3));
+    const __m128i inverseAlphas = _mm_sub_epi16 (_mm_set1_epi16 (256), alphas);
+    return _mm_add_epi16 (src, _mm_srli_epi16 (_mm_mullo_epi16 (dest, inverseAlphas), 8));
+}
+
+static forcedinline PixelQuad blendQuad (PixelQuad dest, PixelQuad src) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    return _mm_packus_epi16 (blendHalf (_mm_unpacklo_epi8 (dest, zero), _mm_unpacklo_epi8 (src, zero)),
+                             blendHalf (_mm_unpackhi_epi8 (dest, zero), _mm_unpackhi_epi8 (src, zero)));
+}
+
+static forcedinline PixelQuad blendQuad (PixelQuad dest, PixelQuad src, AlphaMultiplier extraAlpha) noexcept
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    return _mm_packus_epi16 (blendHalf (_mm_unpacklo_epi8 (dest, zero),
+                                        _mm_srli_epi16 (_mm_mullo_epi16 (_mm_unpacklo_epi8 (src, zero), extraAlpha), 8)),
+                             blendHalf (_mm_unpackhi_epi8 (dest, zero),
+                                        _mm_srli_epi16 (_mm_mullo_epi16 (_mm_unpackhi_epi8 (src, zero), extraAlpha), 8)));
+}
+
+#elif JUCE_USE_ARM_NEON
+typedef uint8x16_t PixelQuad;
+typedef uint16x8_t AlphaMultiplier;
+
+static forcedinline PixelQuad loadQuad (const void* p) noexcept          { return vld1q_u8 ((const uint8*) p); }
+static forcedinline void storeQuad (void* p, PixelQuad q) noexcept       { vst1q_u8 ((uint8*) p, q); }
+static forcedinline PixelQuad broadcastPixel (uint32 argb) noexcept      { return vreinterpretq_u8_u32 (vdupq_n_u32 (argb)); }
+static forcedinline AlphaMultiplier getMultiplier (uint32 a) noexcept    { return vdupq_n_u16 ((uint16) a); }
+
+static forcedinline uint16x8_t blendHalf (uint16x8_t dest, uint16x8_t src) noexcept
+{
+    const uint16x8_t alphas = vcombine_u16 (vdup_lane_u16 (vget_low_u16 (src), 3),
+                                            vdup_lane_u16 (vget_high_u16 (src), 3));
+    const uint16x8_t inverseAlphas = vsubq_u16 (vdupq_n_u16 (256), alphas);
+    return vaddq_u16 (src, vshrq_n_u16 (vmulq_u16 (dest, inverseAlphas), 8));
+}
+
+static forcedinline PixelQuad blendQuad (PixelQuad dest, PixelQuad src) noexcept
+{
+    return vcombine_u8 (vqmovn_u16 (blendHalf (vmovl_u8 (vget_low_u8 (dest)),  vmovl_u8 (vget_low_u8 (src)))),
+                        vqmovn_u16 (blendHalf (vmovl_u8 (vget_high_u8 (dest)), vmovl_u8 (vget_high_u8 (src)))));
+}
+
+static forcedinline PixelQuad blendQuad (PixelQuad dest, PixelQuad src, AlphaMultiplier extraAlpha) noexcept
+{
+    return vcombine_u8 (vqmovn_u16 (blendHalf (vmovl_u8 (vget_low_u8 (dest)),
+                                               vshrq_n_u16 (vmulq_u16 (vmovl_u8 (vget_low_u8 (src)), extraAlpha), 8))),
+                        vqmovn_u16 (blendHalf (vmovl_u8 (vget_high_u8 (dest)),
+                                               vshrq_n_u16 (vmulq_u16 (vmovl_u8 (vget_high_u8 (src)), extraAlpha), 8))));
+}
+#endif
+
+//==============================================================================
+static forcedinline PixelQuad loadPixels (const PixelARGB* p) noexcept      { return loadQuad (p); }
+static forcedinline void storePixels (PixelARGB* p, PixelQuad q) noexcept   { storeQuad (p, q); }
+
+// PixelRGBs are only 3 bytes, so these get expanded to ARGB and back again..
+static forcedinline PixelQuad loadPixels (const PixelRGB* p) noexcept
+{
+    const uint32 pixels[4] = { p[0].getARGB(), p[1].getARGB(), p[2].getARGB(), p[3].getARGB() };
+    return loadQuad (pixels);
+}
+
+static forcedinline void storePixels (PixelRGB* p, PixelQuad q) noexcept
+{
+    uint32 pixels[4];
+    storeQuad (pixels, q);
+
+    for (int i = 0; i < 4; ++i)
+        p[i].set (PixelARGB (pixels[i]));
+}
+#endif
+
+//==============================================================================
+template <class DestPixelType>
+static forcedinline void blendColourSpan (DestPixelType* dest, const PixelARGB colour, int num) noexcept
+{
+   #if JUCE_USE_PIXEL_SPAN_VECTORS
+    const PixelQuad src (broadcastPixel (colour.getARGB()));
+
+    for (; num >= 4; num -= 4, dest += 4)
+        storePixels (dest, blendQuad (loadPixels (dest), src));
+   #endif
+
+    while (--num >= 0)
+        (dest++)->blend (colour);
+}
+
+template <class DestPixelType, class SrcPixelType>
+static forcedinline void blendSpan (DestPixelType* dest, const SrcPixelType* src, int num) noexcept
+{
+   #if JUCE_USE_PIXEL_SPAN_VECTORS
+    for (; num >= 4; num -= 4, dest += 4, src += 4)
+        storePixels (dest, blendQuad (loadPixels (dest), loadPixels (src)));
+   #endif
+
+    while (--num >= 0)
+        (dest++)->blend (*src++);
+}
+
+template <class DestPixelType, class SrcPixelType>
+static forcedinline void blendSpan (DestPixelType* dest, const SrcPixelType* src, int num, const uint32 extraAlpha) noexcept
+{
+   #if JUCE_USE_PIXEL_SPAN_VECTORS
+    const AlphaMultiplier multiplier (getMultiplier (extraAlpha));
+
+    for (; num >= 4; num -= 4, dest += 4, src += 4)
+        storePixels (dest, blendQuad (loadPixels (dest), loadPixels (src), multiplier));
+   #endif
+
+    while (--num >= 0)
+        (dest++)->blend (*src++, extraAlpha);
+}
+
+void blendColour (PixelARGB* dest, PixelARGB colour, int num) noexcept                      { blendColourSpan (dest, colour, num); }
+void blendColour (PixelRGB* dest, PixelARGB colour, int num) noexcept                       { blendColourSpan (dest, colour, num); }
+
+void blendPixels (PixelARGB* dest, const PixelARGB* src, int num) noexcept                  { blendSpan (dest, src, num); }
+void blendPixels (PixelARGB* dest, const PixelARGB* src, int num, uint32 extraAlpha) noexcept { blendSpan (dest, src, num, extraAlpha); }
+void blendPixels (PixelRGB* dest, const PixelARGB* src, int num) noexcept                   { blendSpan (dest, src, num); }
+void blendPixels (PixelRGB* dest, const PixelARGB* src, int num, uint32 extraAlpha) noexcept  { blendSpan (dest, src, num, extraAlpha); }
+void blendPixels (PixelRGB* dest, const PixelRGB* src, int num, uint32 extraAlpha) noexcept   { blendSpan (dest, src, num, extraAlpha); }
+
+//==============================================================================
+void getLinearGradientPixels (PixelARGB* dest, int num, const PixelARGB* lookupTable,
+                              const int numEntries, const int position, const int step, const int shift) noexcept
+{
+    // The positions are allowed to wrap around in the same way that the
+    // original int arithmetic in GradientPixelIterators::Linear would.
+    uint32 pos = (uint32) position;
+
+   #if JUCE_USE_PIXEL_SPAN_VECTORS
+    if (num >= 4)
+    {
+        const uint32 ustep = (uint32) step;
+        const int startPositions[4] = { (int) pos, (int) (pos + ustep), (int) (pos + ustep * 2), (int) (pos + ustep * 3) };
+        int indexes[4];
+
+       #if JUCE_USE_SSE_INTRINSICS
+        __m128i positions = _mm_loadu_si128 ((const __m128i*) startPositions);
+        const __m128i increment = _mm_set1_epi32 ((int) (ustep * 4));
+        const __m128i shiftAmount = _mm_cvtsi32_si128 (shift);
+        const __m128i limit = _mm_set1_epi32 (numEntries);
+       #else
+        int32x4_t positions = vld1q_s32 (startPositions);
+        const int32x4_t increment = vdupq_n_s32 ((int) (ustep * 4));
+        const int32x4_t shiftAmount = vdupq_n_s32 (-shift);
+        const int32x4_t zero = vdupq_n_s32 (0);
+        const int32x4_t limit = vdupq_n_s32 (numEntries);
+       #endif
+
+        for (; num >= 4; num -= 4, dest += 4)
+        {
+           #if JUCE_USE_SSE_INTRINSICS
+            __m128i index = _mm_sra_epi32 (positions, shiftAmount);
+            index = _mm_andnot_si128 (_mm_srai_epi32 (index, 31), index);
+            const __m128i tooBig = _mm_cmpgt_epi32 (index, limit);
+            index = _mm_or_si128 (_mm_and_si128 (tooBig, limit), _mm_andnot_si128 (tooBig, index));
+            _mm_storeu_si128 ((__m128i*) indexes, index);
+            positions = _mm_add_epi32 (positions, increment);
+           #else
+            vst1q_s32 (indexes, vminq_s32 (vmaxq_s32 (vshlq_s32 (positions, shiftAmount), zero), limit));
+            positions = vaddq_s32 (positions, increment);
+           #endif
+
+            dest[0] = lookupTable [indexes[0]];
+            dest[1] = lookupTable [indexes[1]];
+            dest[2] = lookupTable [indexes[2]];
+            dest[3] = lookupTable [indexes[3]];
+            pos += ustep * 4;
+        }
+    }
+   #endif
+
+    while (--num >= 0)
+    {
+        *dest++ = lookupTable [jlimit (0, numEntries, ((int) pos) >> shift)];
+        pos += (uint32) step;
+    }
+}
+
+#undef JUCE_USE_PIXEL_SPAN_VECTORS
+
+}
+}
@@ -136,18 +136,26 @@ public:
 };
 
 //==============================================================================
-/** Holds a cache of recently-used glyph objects of some type. */
+/** Holds a cache of recently-used glyph objects of some type.
+
+    The glyphs are kept in a hash table for each font, so looking one up doesn't get
+    slower as the cache fills up. When the total size of the cached glyphs exceeds the
+    memory limit, the least-recently-used ones are discarded.
+*/
 template <class CachedGlyphType, class RenderTargetType>
 class GlyphCache  : private DeletedAtShutdown
 {
 public:
     GlyphCache()
+        : memoryLimit (defaultMemoryLimit), memoryUsed (0),
+          mostRecent (nullptr), leastRecent (nullptr), lastFontUsed (nullptr)
     {
         reset();
     }
 
     ~GlyphCache()
     {
+        clearAllGlyphs();
         getSingletonPointer() = nullptr;
     }
 
@@ -165,8 +173,7 @@ public:
     void reset()
     {
         const ScopedLock sl (lock);
-        glyphs.clear();
-        addNewGlyphSlots (120);
+        clearAllGlyphs();
         hits.set (0);
         misses.set (0);
     }
@@ -174,92 +181,172 @@ public:
     void drawGlyph (RenderTargetType& target, const Font& font, const int glyphNumber, Point<float> pos)
     {
         if (ReferenceCountedObjectPtr<CachedGlyphType> glyph = findOrCreateGlyph (font, glyphNumber))
-        {
-            glyph->lastAccessCount = ++accessCounter;
             glyph->draw (target, pos);
-        }
     }
 
     ReferenceCountedObjectPtr<CachedGlyphType> findOrCreateGlyph (const Font& font, int glyphNumber)
     {
         const ScopedLock sl (lock);
+        FontGlyphs& fontGlyphs = getGlyphsForFont (font);
 
-        if (CachedGlyphType* g = findExistingGlyph (font, glyphNumber))
+        if (CacheEntry* e = fontGlyphs.entries [glyphNumber])
         {
             ++hits;
-            return g;
+            unlink (e);
+            linkAsMostRecent (e);
+            return e->glyph;
         }
 
         ++misses;
-        CachedGlyphType* g = getGlyphForReuse();
-        jassert (g != nullptr);
-        g->generate (font, glyphNumber);
-        return g;
+        CacheEntry* const e = new CacheEntry (fontGlyphs, glyphNumber);
+        e->glyph->generate (font, glyphNumber);
+        e->size = sizeof (CacheEntry) + e->glyph->getMemoryUsage();
+
+        fontGlyphs.entries.set (glyphNumber, e);
+        linkAsMostRecent (e);
+        memoryUsed += e->size;
+
+        ReferenceCountedObjectPtr<CachedGlyphType> glyph (e->glyph);
+        removeLeastRecentlyUsedGlyphs();
+        return glyph;
     }
 
+    //==============================================================================
+    /** Sets the number of bytes that the cached glyphs are allowed to use. */
+    void setMemoryLimit (size_t maxBytes)
+    {
+        const ScopedLock sl (lock);
+        memoryLimit = maxBytes;
+        removeLeastRecentlyUsedGlyphs();
+    }
+
+    /** Returns the current memory limit. @see setMemoryLimit */
+    size_t getMemoryLimit() const noexcept         { return memoryLimit; }
+
+    /** Returns the approximate number of bytes used by the glyphs that are currently cached. */
+    size_t getMemoryUsage() const noexcept         { return memoryUsed; }
+
+    /** Returns the number of lookups that found a cached glyph since the last reset(). */
+    int getNumHits() const noexcept                { return hits.get(); }
+
+    /** Returns the number of lookups that had to create a new glyph since the last reset(). */
+    int getNumMisses() const noexcept              { return misses.get(); }
+
+    enum { defaultMemoryLimit = 1024 * 1024 };
+
 private:
-    friend struct ContainerDeletePolicy<CachedGlyphType>;
-    ReferenceCountedArray<CachedGlyphType> glyphs;
-    Atomic<int> accessCounter, hits, misses;
+    struct FontGlyphs;
+
+    struct CacheEntry
+    {
+        CacheEntry (FontGlyphs& f, int glyphNumber)
+            : glyph (new CachedGlyphType()), owner (f), glyphIndex (glyphNumber),
+              size (0), moreRecent (nullptr), lessRecent (nullptr)
+        {}
+
+        ReferenceCountedObjectPtr<CachedGlyphType> glyph;
+        FontGlyphs& owner;
+        const int glyphIndex;
+        size_t size;
+        CacheEntry* moreRecent;
+        CacheEntry* lessRecent;
+
+        JUCE_DECLARE_NON_COPYABLE (CacheEntry)
+    };
+
+    struct FontGlyphs
+    {
+        FontGlyphs (const Font& f) : font (f) {}
+
+        const Font font;
+        HashMap<int, CacheEntry*> entries;
+
+        JUCE_DECLARE_NON_COPYABLE (FontGlyphs)
+    };
+
+    friend struct ContainerDeletePolicy<FontGlyphs>;
+    OwnedArray<FontGlyphs> fonts;
+    size_t memoryLimit, memoryUsed;
+    CacheEntry* mostRecent;
+    CacheEntry* leastRecent;
+    FontGlyphs* lastFontUsed;
+    Atomic<int> hits, misses;
     CriticalSection lock;
 
-    CachedGlyphType* findExistingGlyph (const Font& font, int glyphNumber) const
+    FontGlyphs& getGlyphsForFont (const Font& font)
     {
-        for (int i = 0; i < glyphs.size(); ++i)
+        if (lastFontUsed != nullptr && lastFontUsed->font == font)
+            return *lastFontUsed;
+
+        for (int i = fonts.size(); --i >= 0;)
         {
-            CachedGlyphType* const g = glyphs.getUnchecked (i);
+            FontGlyphs* const f = fonts.getUnchecked (i);
 
-            if (g->glyph == glyphNumber && g->font == font)
-                return g;
+            if (f->font == font)
+                return *(lastFontUsed = f);
         }
 
-        return nullptr;
+        return *(lastFontUsed = fonts.add (new FontGlyphs (font)));
     }
 
-    CachedGlyphType* getGlyphForReuse()
+    void linkAsMostRecent (CacheEntry* e) noexcept
     {
-        if (hits.value + misses.value > glyphs.size() * 16)
-        {
-            if (misses.value * 2 > hits.value)
-                addNewGlyphSlots (32);
-
-            hits.set (0);
-            misses.set (0);
-        }
+        e->lessRecent = mostRecent;
+        e->moreRecent = nullptr;
 
-        if (CachedGlyphType* g = findLeastRecentlyUsedGlyph())
-            return g;
+        if (mostRecent != nullptr)
+            mostRecent->moreRecent = e;
+        else
+            leastRecent = e;
 
-        addNewGlyphSlots (32);
-        return glyphs.getLast();
+        mostRecent = e;
     }
 
-    void addNewGlyphSlots (int num)
+    void unlink (CacheEntry* e) noexcept
     {
-        glyphs.ensureStorageAllocated (glyphs.size() + num);
+        if (e->moreRecent != nullptr)  e->moreRecent->lessRecent = e->lessRecent;
+        else                           mostRecent = e->lessRecent;
 
-        while (--num >= 0)
-            glyphs.add (new CachedGlyphType());
+        if (e->lessRecent != nullptr)  e->lessRecent->moreRecent = e->moreRecent;
+        else                           leastRecent = e->moreRecent;
     }
 
-    CachedGlyphType* findLeastRecentlyUsedGlyph() const noexcept
+    void removeLeastRecentlyUsedGlyphs()
     {
-        CachedGlyphType* oldest = nullptr;
-        int oldestCounter = std::numeric_limits<int>::max();
-
-        for (int i = glyphs.size() - 1; --i >= 0;)
+        // Glyphs that another thread is still drawing get deleted when it releases them
+        while (memoryUsed > memoryLimit && leastRecent != nullptr)
         {
-            CachedGlyphType* const glyph = glyphs.getUnchecked(i);
+            CacheEntry* const e = leastRecent;
+            FontGlyphs& owner = e->owner;
 
-            if (glyph->lastAccessCount <= oldestCounter
-                 && glyph->getReferenceCount() == 1)
+            unlink (e);
+            owner.entries.remove (e->glyphIndex);
+            memoryUsed -= e->size;
+            delete e;
+
+            if (owner.entries.size() == 0)
             {
-                oldestCounter = glyph->lastAccessCount;
-                oldest = glyph;
+                if (lastFontUsed == &owner)
+                    lastFontUsed = nullptr;
+
+                fonts.removeObject (&owner);
             }
         }
+    }
 
-        return oldest;
+    void clearAllGlyphs()
+    {
+        for (CacheEntry* e = mostRecent; e != nullptr;)
+        {
+            CacheEntry* const next = e->lessRecent;
+            delete e;
+            e = next;
+        }
+
+        mostRecent = leastRecent = nullptr;
+        lastFontUsed = nullptr;
+        fonts.clear();
+        memoryUsed = 0;
     }
 
     static GlyphCache*& getSingletonPointer() noexcept
@@ -277,7 +364,7 @@ template <class RendererType>
 class CachedGlyphEdgeTable  : public ReferenceCountedObject
 {
 public:
-    CachedGlyphEdgeTable() : glyph (0), lastAccessCount (0) {}
+    CachedGlyphEdgeTable() : glyph (0) {}
 
     void draw (RendererType& state, Point<float> pos) const
     {
@@ -299,16 +386,244 @@ public:
         edgeTable = typeface->getEdgeTableForGlyph (glyphNumber,
                                                     AffineTransform::scale (fontHeight * font.getHorizontalScale(),
                                                                             fontHeight), fontHeight);
+
+        if (edgeTable != nullptr && edgeTable->getMaximumBounds().getHeight() > 0)
+            edgeTable->optimiseTable();
+    }
+
+    size_t getMemoryUsage() const noexcept
+    {
+        return sizeof (*this) + (edgeTable != nullptr ? edgeTable->getMemoryUsage() : 0);
     }
 
     Font font;
     ScopedPointer<EdgeTable> edgeTable;
-    int glyph, lastAccessCount;
+    int glyph;
     bool snapToIntegerCoordinate;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedGlyphEdgeTable)
 };
 
+//==============================================================================
+/** Keeps the scan-converted edge tables of recently filled paths, so that a path which
+    is drawn again (e.g. an icon or a knob background) doesn't have to be flattened and
+    rasterised again every time.
+
+    The tables are made without any clipping, and are keyed on the path and the transform
+    with its whole-pixel part of the translation removed, so a path that has only been moved
+    by a whole number of pixels can re-use its table by shifting it.
+
+    A table is only made the second time a path is seen, so shapes that are only drawn
+    once don't pay for building an unclipped table that would never be used again.
+*/
+class PathEdgeTableCache
+{
+public:
+    PathEdgeTableCache() noexcept  : totalMemory (0) {}
+
+    enum
+    {
+        maxNumEntries = 256,
+        maxMemoryUsage = 4 * 1024 * 1024,
+        maxPathSize = 2048
+    };
+
+    /** Returns a new region containing the path's edge table for the given transform, or
+        nullptr if there's no table for it yet, in which case the caller should rasterise
+        the path itself.
+    */
+    template <class EdgeTableRegionType>
+    EdgeTableRegionType* createRegionFor (const Path& path, const AffineTransform& transform)
+    {
+        const float wholeX = std::floor (transform.getTranslationX());
+        const float wholeY = std::floor (transform.getTranslationY());
+
+        if (std::abs (wholeX) > 1.0e6f || std::abs (wholeY) > 1.0e6f)
+            return nullptr;
+
+        const AffineTransform keyTransform (transform.translated (-wholeX, -wholeY));
+        const ScopedLock sl (lock);
+
+        Entry* const e = findEntry (path, keyTransform);
+
+        if (e == nullptr)
+        {
+            const Rectangle<int> bounds (path.getBoundsTransformed (keyTransform)
+                                             .getSmallestIntegerContainer().expanded (1));
+
+            if (bounds.getWidth() <= maxPathSize && bounds.getHeight() <= maxPathSize)
+            {
+                entries.add (new Entry (path, keyTransform, bounds));
+                removeOldEntries();
+            }
+
+            return nullptr;
+        }
+
+        if (e->edgeTable == nullptr)
+        {
+            e->edgeTable = new EdgeTable (e->bounds, e->path, e->transform);
+            totalMemory += e->edgeTable->getMemoryUsage();
+            removeOldEntries();
+        }
+
+        EdgeTableRegionType* const region = new EdgeTableRegionType (*e->edgeTable);
+        region->edgeTable.translate (wholeX, (int) wholeY);
+        return region;
+    }
+
+private:
+    struct Entry
+    {
+        Entry (const Path& p, const AffineTransform& t, const Rectangle<int>& b)
+            : path (p), transform (t), bounds (b)
+        {}
+
+        const Path path;
+        const AffineTransform transform;
+        const Rectangle<int> bounds;
+        ScopedPointer<EdgeTable> edgeTable;
+    };
+
+    OwnedArray<Entry> entries;
+    size_t totalMemory;
+    CriticalSection lock;
+
+    Entry* findEntry (const Path& path, const AffineTransform& transform)
+    {
+        for (int i = entries.size(); --i >= 0;)
+        {
+            Entry* const e = entries.getUnchecked (i);
+
+            if (e->transform == transform && e->path == path)
+            {
+                entries.move (i, entries.size() - 1);  // (the end of the list is the most recently used)
+                return e;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void removeOldEntries()
+    {
+        while (entries.size() > 1 && (entries.size() > maxNumEntries || totalMemory > (size_t) maxMemoryUsage))
+        {
+            if (const EdgeTable* const et = entries.getUnchecked (0)->edgeTable)
+                totalMemory -= et->getMemoryUsage();
+
+            entries.remove (0);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PathEdgeTableCache)
+};
+
+//==============================================================================
+/** Keeps the most recently used gradient lookup tables, so that gradients which are
+    drawn over and over again don't need a new table to be allocated and filled each time.
+
+    Tables are matched on a hash of the gradient's colour stops and the number of entries,
+    and the least-recently-used ones are discarded when the cache is full.
+*/
+class GradientLookupTableCache
+{
+public:
+    GradientLookupTableCache() noexcept {}
+
+    enum { maxNumEntries = 64 };
+
+    struct LookupTable  : public ReferenceCountedObject
+    {
+        LookupTable (const ColourGradient& gradient, int size)
+            : entries ((size_t) size), numEntries (size)
+        {
+            gradient.createLookupTable (entries, numEntries);
+        }
+
+        typedef ReferenceCountedObjectPtr<LookupTable> Ptr;
+
+        HeapBlock<PixelARGB> entries;
+        const int numEntries;
+    };
+
+    /** Returns a table for the gradient, as it would be drawn with the given transform. */
+    LookupTable::Ptr getLookupTable (const ColourGradient& gradient, const AffineTransform& transform)
+    {
+        // (this is the same size that ColourGradient::createLookupTable() would choose)
+        const int numEntries = jlimit (1, jmax (1, (gradient.getNumColours() - 1) << 8),
+                                       3 * (int) gradient.point1.transformedBy (transform)
+                                                    .getDistanceFrom (gradient.point2.transformedBy (transform)));
+
+        const uint32 hash = getColourHash (gradient) ^ ((uint32) numEntries * 0x9e3779b9u);
+        const ScopedLock sl (lock);
+
+        for (int i = entries.size(); --i >= 0;)
+        {
+            Entry* const e = entries.getUnchecked (i);
+
+            if (e->hash == hash && e->table->numEntries == numEntries && haveSameColours (e->gradient, gradient))
+            {
+                entries.move (i, entries.size() - 1);  // (the end of the list is the most recently used)
+                return e->table;
+            }
+        }
+
+        Entry* const e = new Entry (gradient, hash, new LookupTable (gradient, numEntries));
+        entries.add (e);
+
+        while (entries.size() > maxNumEntries)
+            entries.remove (0);
+
+        return e->table;
+    }
+
+    /** Returns a hash of a gradient's colour stops, ignoring its position. */
+    static uint32 getColourHash (const ColourGradient& gradient) noexcept
+    {
+        uint32 hash = (uint32) gradient.getNumColours();
+
+        for (int i = 0; i < gradient.getNumColours(); ++i)
+        {
+            hash = hash * 31 + gradient.getColour (i).getARGB();
+            hash = hash * 31 + (uint32) roundToInt (gradient.getColourPosition (i) * 65536.0);
+        }
+
+        return hash;
+    }
+
+    /** Returns true if two gradients have the same colour stops, regardless of their positions. */
+    static bool haveSameColours (const ColourGradient& g1, const ColourGradient& g2) noexcept
+    {
+        if (g1.getNumColours() != g2.getNumColours())
+            return false;
+
+        for (int i = 0; i < g1.getNumColours(); ++i)
+            if (g1.getColour (i) != g2.getColour (i)
+                 || g1.getColourPosition (i) != g2.getColourPosition (i))
+                return false;
+
+        return true;
+    }
+
+private:
+    struct Entry
+    {
+        Entry (const ColourGradient& g, uint32 h, LookupTable* t)
+            : gradient (g), hash (h), table (t)
+        {}
+
+        const ColourGradient gradient;
+        const uint32 hash;
+        const LookupTable::Ptr table;
+    };
+
+    OwnedArray<Entry> entries;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GradientLookupTableCache)
+};
+
 //==============================================================================
 /** Calculates the alpha values and positions for rendering the edges of a
     non-pixel-aligned rectangle.
@@ -398,6 +713,54 @@ struct FloatRectangleRasterisingInfo
     int topAlpha, leftAlpha, bottomAlpha, rightAlpha; // alpha of each anti-aliased edge
 };
 
+//==============================================================================
+/** Blends runs of pixels which are contiguous in memory.
+
+    These are the inner loops of the EdgeTableFillers. The overloads for PixelARGB and
+    PixelRGB are implemented with SSE2 or NEON where possible, and give exactly the same
+    results as calling the pixel classes' blend() methods on each pixel in turn.
+*/
+namespace PixelSpanOperations
+{
+    JUCE_API void blendColour (PixelARGB* dest, PixelARGB colour, int num) noexcept;
+    JUCE_API void blendColour (PixelRGB* dest, PixelARGB colour, int num) noexcept;
+
+    JUCE_API void blendPixels (PixelARGB* dest, const PixelARGB* src, int num) noexcept;
+    JUCE_API void blendPixels (PixelARGB* dest, const PixelARGB* src, int num, uint32 extraAlpha) noexcept;
+    JUCE_API void blendPixels (PixelRGB* dest, const PixelARGB* src, int num) noexcept;
+    JUCE_API void blendPixels (PixelRGB* dest, const PixelARGB* src, int num, uint32 extraAlpha) noexcept;
+    JUCE_API void blendPixels (PixelRGB* dest, const PixelRGB* src, int num, uint32 extraAlpha) noexcept;
+
+    /** Looks up the colours for a run of pixels in a linear gradient.
+        For each pixel, this uses the entry at (position >> shift), clipped to the size
+        of the table, and then adds the step value to the position.
+    */
+    JUCE_API void getLinearGradientPixels (PixelARGB* dest, int num, const PixelARGB* lookupTable,
+                                           int numEntries, int position, int step, int shift) noexcept;
+
+    // Any other combinations of pixel types just use the pixel classes' methods..
+    template <class DestPixelType>
+    inline void blendColour (DestPixelType* dest, const PixelARGB colour, int num) noexcept
+    {
+        while (--num >= 0)
+            (dest++)->blend (colour);
+    }
+
+    template <class DestPixelType, class SrcPixelType>
+    inline void blendPixels (DestPixelType* dest, const SrcPixelType* src, int num) noexcept
+    {
+        while (--num >= 0)
+            (dest++)->blend (*src++);
+    }
+
+    template <class DestPixelType, class SrcPixelType>
+    inline void blendPixels (DestPixelType* dest, const SrcPixelType* src, int num, uint32 extraAlpha) noexcept
+    {
+        while (--num >= 0)
+            (dest++)->blend (*src++, extraAlpha);
+    }
+}
+
 //==============================================================================
 /** Contains classes for calculating the colour of pixels within various types of gradient. */
 namespace GradientPixelIterators
@@ -463,6 +826,20 @@ namespace GradientPixelIterators
                             : lookupTable [jlimit (0, numEntries, (x * scale - start) >> (int) numScaleBits)];
         }
 
+        void getPixels (const int x, int num, PixelARGB* dest) const noexcept
+        {
+            if (vertical)
+            {
+                while (--num >= 0)
+                    *dest++ = linePix;
+            }
+            else
+            {
+                PixelSpanOperations::getLinearGradientPixels (dest, num, lookupTable, numEntries,
+                                                              x * scale - start, scale, (int) numScaleBits);
+            }
+        }
+
     private:
         const PixelARGB* const lookupTable;
         const int numEntries;
@@ -509,6 +886,12 @@ namespace GradientPixelIterators
             return lookupTable [x >= maxDist ? numEntries : roundToInt (std::sqrt (x) * invScale)];
         }
 
+        void getPixels (const int x, const int num, PixelARGB* dest) const noexcept
+        {
+            for (int i = 0; i < num; ++i)
+                dest[i] = getPixel (x + i);
+        }
+
     protected:
         const PixelARGB* const lookupTable;
         const int numEntries;
@@ -553,6 +936,12 @@ namespace GradientPixelIterators
             return lookupTable [jmin (numEntries, roundToInt (std::sqrt (x) * invScale))];
         }
 
+        void getPixels (const int x, const int num, PixelARGB* dest) const noexcept
+        {
+            for (int i = 0; i < num; ++i)
+                dest[i] = getPixel (x + i);
+        }
+
     private:
         double tM10, tM00, lineYM01, lineYM11;
         const AffineTransform inverseTransform;
@@ -652,7 +1041,10 @@ namespace EdgeTableFillers
 
         inline void blendLine (PixelType* dest, const PixelARGB colour, int width) const noexcept
         {
-            JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
+            if (destData.pixelStride == sizeof (PixelType))
+                PixelSpanOperations::blendColour (dest, colour, width);
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
         }
 
         forcedinline void replaceLine (PixelRGB* dest, const PixelARGB colour, int width) const noexcept
@@ -749,7 +1141,9 @@ namespace EdgeTableFillers
         {
             PixelType* dest = getPixel (x);
 
-            if (alphaLevel < 0xff)
+            if (destData.pixelStride == sizeof (PixelType))
+                blendSpan (dest, x, width, alphaLevel);
+            else if (alphaLevel < 0xff)
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++), (uint32) alphaLevel))
             else
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
@@ -758,13 +1152,37 @@ namespace EdgeTableFillers
         void handleEdgeTableLineFull (int x, int width) const noexcept
         {
             PixelType* dest = getPixel (x);
-            JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
+
+            if (destData.pixelStride == sizeof (PixelType))
+                blendSpan (dest, x, width, 0xff);
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
         }
 
     private:
         const Image::BitmapData& destData;
         PixelType* linePixels;
 
+        void blendSpan (PixelType* dest, int x, int width, const int alphaLevel) const noexcept
+        {
+            PixelARGB colours [64];
+
+            while (width > 0)
+            {
+                const int num = jmin (width, numElementsInArray (colours));
+                GradientType::getPixels (x, num, colours);
+
+                if (alphaLevel < 0xff)
+                    PixelSpanOperations::blendPixels (dest, colours, num, (uint32) alphaLevel);
+                else
+                    PixelSpanOperations::blendPixels (dest, colours, num);
+
+                dest += num;
+                x += num;
+                width -= num;
+            }
+        }
+
         forcedinline PixelType* getPixel (const int x) const noexcept
         {
             return addBytesToPointer (linePixels, x * destData.pixelStride);
@@ -833,7 +1251,7 @@ namespace EdgeTableFillers
                 jassert (x >= 0 && x + width <= srcData.width);
 
                 if (alphaLevel < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) alphaLevel))
+                    blendRow (dest, getSrcPixel (x), width, (uint32) alphaLevel);
                 else
                     copyRow (dest, getSrcPixel (x), width);
             }
@@ -856,7 +1274,7 @@ namespace EdgeTableFillers
                 jassert (x >= 0 && x + width <= srcData.width);
 
                 if (extraAlpha < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) extraAlpha))
+                    blendRow (dest, getSrcPixel (x), width, (uint32) extraAlpha);
                 else
                     copyRow (dest, getSrcPixel (x), width);
             }
@@ -902,6 +1320,10 @@ namespace EdgeTableFillers
             {
                 memcpy (dest, src, (size_t) (width * srcStride));
             }
+            else if (destStride == sizeof (DestPixelType) && srcStride == sizeof (SrcPixelType))
+            {
+                PixelSpanOperations::blendPixels (dest, src, width);
+            }
             else
             {
                 do
@@ -913,6 +1335,19 @@ namespace EdgeTableFillers
             }
         }
 
+        forcedinline void blendRow (DestPixelType* dest, SrcPixelType const* src, int width, const uint32 alpha) const noexcept
+        {
+            if (destData.pixelStride == sizeof (DestPixelType) && srcData.pixelStride == sizeof (SrcPixelType))
+            {
+                PixelSpanOperations::blendPixels (dest, src, width, alpha);
+            }
+            else
+            {
+                const int srcStride = srcData.pixelStride;
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (*src, alpha); src = addBytesToPointer (src, srcStride))
+            }
+        }
+
         JUCE_DECLARE_NON_COPYABLE (ImageFill)
     };
 
@@ -2475,6 +2910,62 @@ public:
         GlyphCacheType::getInstance().reset();
     }
 
+    struct PathCacheType  : public PathEdgeTableCache,
+                            private DeletedAtShutdown
+    {
+        ~PathCacheType()    { getSingletonPointer() = nullptr; }
+
+        static PathCacheType& getInstance()
+        {
+            PathCacheType*& p = getSingletonPointer();
+
+            if (p == nullptr)
+                p = new PathCacheType();
+
+            return *p;
+        }
+
+        static PathCacheType*& getSingletonPointer() noexcept
+        {
+            static PathCacheType* p = nullptr;
+            return p;
+        }
+    };
+
+    struct GradientCacheType  : public GradientLookupTableCache,
+                                private DeletedAtShutdown
+    {
+        ~GradientCacheType()    { getSingletonPointer() = nullptr; }
+
+        static GradientCacheType& getInstance()
+        {
+            GradientCacheType*& p = getSingletonPointer();
+
+            if (p == nullptr)
+                p = new GradientCacheType();
+
+            return *p;
+        }
+
+        static GradientCacheType*& getSingletonPointer() noexcept
+        {
+            static GradientCacheType* p = nullptr;
+            return p;
+        }
+    };
+
+    void fillPath (const Path& path, const AffineTransform& t)
+    {
+        if (clip != nullptr)
+        {
+            if (EdgeTableRegionType* const cached = PathCacheType::getInstance()
+                                                      .createRegionFor<EdgeTableRegionType> (path, transform.getTransformWith (t)))
+                fillShape (cached, false);
+            else
+                BaseClass::fillPath (path, t);
+        }
+    }
+
     //==============================================================================
     void drawGlyph (int glyphNumber, const AffineTransform& trans)
     {
@@ -2554,8 +3045,9 @@ public:
     template <typename IteratorType>
     void fillWithGradient (IteratorType& iter, ColourGradient& gradient, const AffineTransform& trans, bool isIdentity) const
     {
-        HeapBlock<PixelARGB> lookupTable;
-        const int numLookupEntries = gradient.createLookupTable (trans, lookupTable);
+        const GradientLookupTableCache::LookupTable::Ptr table (GradientCacheType::getInstance().getLookupTable (gradient, trans));
+        const PixelARGB* const lookupTable = table->entries;
+        const int numLookupEntries = table->numEntries;
         jassert (numLookupEntries > 0);
 
         Image::BitmapData destData (image, Image::BitmapData::readWrite);
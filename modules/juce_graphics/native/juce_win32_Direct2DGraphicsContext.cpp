@@ -29,20 +29,7 @@ public:
         : hwnd (hwnd_),
           currentState (nullptr)
     {
-        RECT windowRect;
-        GetClientRect (hwnd, &windowRect);
-        D2D1_SIZE_U size = { windowRect.right - windowRect.left, windowRect.bottom - windowRect.top };
-        bounds.setSize (size.width, size.height);
-
-        D2D1_RENDER_TARGET_PROPERTIES props = D2D1::RenderTargetProperties();
-        D2D1_HWND_RENDER_TARGET_PROPERTIES propsHwnd = D2D1::HwndRenderTargetProperties (hwnd, size);
-
-        if (factories->d2dFactory != nullptr)
-        {
-            HRESULT hr = factories->d2dFactory->CreateHwndRenderTarget (props, propsHwnd, renderingTarget.resetAndGetPointerAddress());
-            jassert (SUCCEEDED (hr)); (void) hr;
-            hr = renderingTarget->CreateSolidColorBrush (D2D1::ColorF::ColorF (0.0f, 0.0f, 0.0f, 1.0f), colourBrush.resetAndGetPointerAddress());
-        }
+        createRenderTarget();
     }
 
     ~Direct2DLowLevelGraphicsContext()
@@ -75,8 +62,19 @@ public:
     {
         states.clear();
         currentState = 0;
-        renderingTarget->EndDraw();
-        renderingTarget->CheckWindowState();
+
+        if (renderingTarget->EndDraw() == D2DERR_RECREATE_TARGET)
+        {
+            // The device has been lost, so everything that was made with the old target
+            // has to be thrown away and created again for the next frame.
+            bitmapCache.clear();
+            createRenderTarget();
+        }
+        else
+        {
+            renderingTarget->CheckWindowState();
+            bitmapCache.endFrame();
+        }
     }
 
     bool isVectorDevice() const { return false; }
@@ -104,22 +102,39 @@ public:
 
     bool clipToRectangleList (const RectangleList<int>& clipRegion)
     {
-        currentState->clipToRectList (rectListToPathGeometry (clipRegion));
+        currentState->intersectClipBounds (clipRegion.getBounds().toFloat());
+        currentState->clipToRectList (pathToPathGeometry (clipRegion.toPath(), currentState->transform));
         return ! isClipEmpty();
     }
 
-    void excludeClipRectangle (const Rectangle<int>&)
+    void excludeClipRectangle (const Rectangle<int>& r)
     {
-        //xxx
+        const Rectangle<int> clipBounds (getClipBounds());
+        const Rectangle<int> excluded (r.getIntersection (clipBounds));
+
+        if (! excluded.isEmpty())
+        {
+            // (with the even-odd rule, the excluded rectangle becomes a hole in the clip bounds)
+            Path p;
+            p.addRectangle (clipBounds);
+            p.addRectangle (excluded);
+            p.setUsingNonZeroWinding (false);
+
+            currentState->clipToRectList (pathToPathGeometry (p, currentState->transform));
+        }
     }
 
     void clipToPath (const Path& path, const AffineTransform& transform)
     {
-        currentState->clipToPath (pathToPathGeometry (path, transform));
+        const AffineTransform t (transform.followedBy (currentState->transform));
+
+        currentState->intersectClipBounds (path.getBoundsTransformed (transform));
+        currentState->clipToPath (pathToPathGeometry (path, t));
     }
 
     void clipToImageAlpha (const Image& sourceImage, const AffineTransform& transform)
     {
+        currentState->intersectClipBounds (sourceImage.getBounds().toFloat().transformed (transform));
         currentState->clipToImage (sourceImage, transform);
     }
 
@@ -152,14 +167,17 @@ public:
         currentState = states.getLast();
     }
 
-    void beginTransparencyLayer (float /*opacity*/)
+    void beginTransparencyLayer (float opacity)
     {
-        jassertfalse; //xxx todo
+        saveState();
+        currentState->pushTransparencyLayer (opacity);
     }
 
     void endTransparencyLayer()
     {
-        jassertfalse; //xxx todo
+        // (deleting the state pops its layer, which composites everything that was
+        // drawn into it onto the layers beneath)
+        restoreState();
     }
 
     void setFill (const FillType& fillType)
@@ -172,13 +190,29 @@ public:
         currentState->setOpacity (newOpacity);
     }
 
-    void setInterpolationQuality (Graphics::ResamplingQuality /*quality*/)
+    void setInterpolationQuality (Graphics::ResamplingQuality quality)
     {
+        currentState->interpolationMode = (quality == Graphics::lowResamplingQuality)
+                                              ? D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR
+                                              : D2D1_BITMAP_INTERPOLATION_MODE_LINEAR;
     }
 
-    void fillRect (const Rectangle<int>& r, bool /*replaceExistingContents*/)
+    void fillRect (const Rectangle<int>& r, bool replaceExistingContents)
     {
-        fillRect (r.toFloat());
+        if (replaceExistingContents && currentState->fillType.isColour()
+             && currentState->transform.isOnlyTranslation() && ! isUsingLayers())
+        {
+            // Clear() overwrites the pixels rather than blending with them, and is limited
+            // to the area of the axis-aligned clip that's active.
+            renderingTarget->PushAxisAlignedClip (rectangleToRectF (r.toFloat().transformed (currentState->transform)),
+                                                  D2D1_ANTIALIAS_MODE_ALIASED);
+            renderingTarget->Clear (colourToD2D (currentState->fillType.colour));
+            renderingTarget->PopAxisAlignedClip();
+        }
+        else
+        {
+            fillRect (r.toFloat());
+        }
     }
 
     void fillRect (const Rectangle<float>& r)
@@ -206,27 +240,13 @@ public:
 
     void drawImage (const Image& image, const AffineTransform& transform)
     {
-        renderingTarget->SetTransform (transformToMatrix (transform.followedBy (currentState->transform)));
-
-        D2D1_SIZE_U size;
-        size.width = image.getWidth();
-        size.height = image.getHeight();
-
-        D2D1_BITMAP_PROPERTIES bp = D2D1::BitmapProperties();
-
-        Image img (image.convertedToFormat (Image::ARGB));
-        Image::BitmapData bd (img, Image::BitmapData::readOnly);
-        bp.pixelFormat = renderingTarget->GetPixelFormat();
-        bp.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
-
+        if (ID2D1Bitmap* const bitmap = bitmapCache.getBitmapFor (*renderingTarget, image))
         {
-            ComSmartPtr <ID2D1Bitmap> tempBitmap;
-            renderingTarget->CreateBitmap (size, bd.data, bd.lineStride, bp, tempBitmap.resetAndGetPointerAddress());
-            if (tempBitmap != nullptr)
-                renderingTarget->DrawBitmap (tempBitmap);
+            renderingTarget->SetTransform (transformToMatrix (transform.followedBy (currentState->transform)));
+            renderingTarget->DrawBitmap (bitmap, rectangleToRectF (image.getBounds()),
+                                         currentState->fillType.getOpacity(), currentState->interpolationMode);
+            renderingTarget->SetTransform (D2D1::IdentityMatrix());
         }
-
-        renderingTarget->SetTransform (D2D1::IdentityMatrix());
     }
 
     void drawLine (const Line <float>& line)
@@ -253,10 +273,19 @@ public:
 
     void drawGlyph (int glyphNumber, const AffineTransform& transform)
     {
-        currentState->createBrush();
-        currentState->createFont();
+        const Font& font = currentState->font;
+        const float hScale = font.getHorizontalScale();
+
+        if (! currentState->createFont())
+        {
+            // This isn't a DirectWrite font, so its glyph has to be drawn as a path instead
+            Path p;
+            font.getTypeface()->getOutlineForGlyph (glyphNumber, p);
+            fillPath (p, AffineTransform::scale (font.getHeight() * hScale, font.getHeight()).followedBy (transform));
+            return;
+        }
 
-        float hScale = currentState->font.getHorizontalScale();
+        currentState->createBrush();
 
         renderingTarget->SetTransform (transformToMatrix (AffineTransform::scale (hScale, 1.0f)
                                                                           .followedBy (transform)
@@ -284,10 +313,13 @@ public:
 
     bool drawTextLayout (const AttributedString& text, const Rectangle<float>& area)
     {
+        if (factories->directWriteFactory == nullptr || factories->systemFonts == nullptr)
+            return false;
+
         renderingTarget->SetTransform (transformToMatrix (currentState->transform));
 
-        DirectWriteTypeLayout::drawToD2DContext (text, area, renderingTarget, factories->directWriteFactory,
-                                                 factories->d2dFactory, factories->systemFonts);
+        DirectWriteTypeLayout::drawToD2DContext (text, area, renderingTarget,
+                                                 factories->directWriteFactory, factories->systemFonts);
 
         renderingTarget->SetTransform (D2D1::IdentityMatrix());
         return true;
@@ -303,7 +335,8 @@ public:
             clipsRect (false), shouldClipRect (false),
             clipsRectList (false), shouldClipRectList (false),
             clipsComplex (false), shouldClipComplex (false),
-            clipsBitmap (false), shouldClipBitmap (false)
+            clipsBitmap (false), shouldClipBitmap (false),
+            interpolationMode (D2D1_BITMAP_INTERPOLATION_MODE_LINEAR)
         {
             if (owner.currentState != nullptr)
             {
@@ -316,6 +349,8 @@ public:
 
                 font = owner.currentState->font;
                 currentFontFace = owner.currentState->currentFontFace;
+                fontHeightToEmSizeFactor = owner.currentState->fontHeightToEmSizeFactor;
+                interpolationMode = owner.currentState->interpolationMode;
             }
             else
             {
@@ -334,6 +369,9 @@ public:
             clearImageClip();
             complexClipLayer = 0;
             bitmapMaskLayer = 0;
+
+            if (transparencyLayer != nullptr)
+                owner.renderingTarget->PopLayer();
         }
 
         void clearClip()
@@ -345,11 +383,28 @@ public:
         void clipToRectangle (const Rectangle<int>& r)
         {
             clearClip();
-            clipRect = r.toFloat().transformed (transform).getSmallestIntegerContainer();
+            intersectClipBounds (r.toFloat());
             shouldClipRect = true;
             pushClips();
         }
 
+        // Keeps the bounds of the clip up-to-date when a more complex region is used
+        void intersectClipBounds (const Rectangle<float>& area)
+        {
+            clipRect = clipRect.getIntersection (area.transformed (transform).getSmallestIntegerContainer());
+        }
+
+        void pushTransparencyLayer (float opacity)
+        {
+            jassert (transparencyLayer == nullptr);
+            owner.renderingTarget->CreateLayer (transparencyLayer.resetAndGetPointerAddress());
+
+            D2D1_LAYER_PARAMETERS layerParams = D2D1::LayerParameters();
+            layerParams.contentBounds = rectangleToRectF (clipRect);
+            layerParams.opacity = opacity;
+            owner.renderingTarget->PushLayer (layerParams, transparencyLayer);
+        }
+
         void clearPathClip()
         {
             popClips();
@@ -363,12 +418,17 @@ public:
 
         void clipToPath (ID2D1Geometry* geometry)
         {
+            ComSmartPtr<ID2D1Geometry> newGeometry (geometry);
+
+            if (complexClipGeometry != nullptr)
+                newGeometry = owner.combineGeometries (complexClipGeometry, geometry, D2D1_COMBINE_MODE_INTERSECT);
+
             clearPathClip();
 
             if (complexClipLayer == 0)
                 owner.renderingTarget->CreateLayer (complexClipLayer.resetAndGetPointerAddress());
 
-            complexClipGeometry = geometry;
+            complexClipGeometry = newGeometry;
             shouldClipComplex = true;
             pushClips();
         }
@@ -386,12 +446,17 @@ public:
 
         void clipToRectList (ID2D1Geometry* geometry)
         {
+            ComSmartPtr<ID2D1Geometry> newGeometry (geometry);
+
+            if (rectListGeometry != nullptr)
+                newGeometry = owner.combineGeometries (rectListGeometry, geometry, D2D1_COMBINE_MODE_INTERSECT);
+
             clearRectListClip();
 
             if (rectListLayer == 0)
                 owner.renderingTarget->CreateLayer (rectListLayer.resetAndGetPointerAddress());
 
-            rectListGeometry = geometry;
+            rectListGeometry = newGeometry;
             shouldClipRectList = true;
             pushClips();
         }
@@ -402,40 +467,43 @@ public:
 
             if (shouldClipBitmap)
             {
-                maskBitmap = 0;
+                maskGeometry = 0;
                 bitmapMaskBrush = 0;
                 shouldClipBitmap = false;
             }
         }
 
-        void clipToImage (const Image& image, const AffineTransform& transform)
+        void clipToImage (const Image& image, const AffineTransform& t)
         {
             clearImageClip();
 
+            ID2D1Bitmap* const maskBitmap = owner.bitmapCache.getBitmapFor (*owner.renderingTarget, image);
+
+            if (maskBitmap == nullptr)
+                return;
+
             if (bitmapMaskLayer == 0)
                 owner.renderingTarget->CreateLayer (bitmapMaskLayer.resetAndGetPointerAddress());
 
+            const AffineTransform imageTransform (t.followedBy (transform));
+
             D2D1_BRUSH_PROPERTIES brushProps;
             brushProps.opacity = 1;
-            brushProps.transform = transformToMatrix (transform);
+            brushProps.transform = transformToMatrix (imageTransform);
 
-            D2D1_BITMAP_BRUSH_PROPERTIES bmProps = D2D1::BitmapBrushProperties (D2D1_EXTEND_MODE_WRAP, D2D1_EXTEND_MODE_WRAP);
+            D2D1_BITMAP_BRUSH_PROPERTIES bmProps = D2D1::BitmapBrushProperties (D2D1_EXTEND_MODE_CLAMP, D2D1_EXTEND_MODE_CLAMP,
+                                                                                interpolationMode);
 
-            D2D1_SIZE_U size;
-            size.width = image.getWidth();
-            size.height = image.getHeight();
+            owner.renderingTarget->CreateBitmapBrush (maskBitmap, bmProps, brushProps, bitmapMaskBrush.resetAndGetPointerAddress());
 
-            D2D1_BITMAP_PROPERTIES bp = D2D1::BitmapProperties();
-
-            maskImage = image.convertedToFormat (Image::ARGB);
-            Image::BitmapData bd (this->image, Image::BitmapData::readOnly); // xxx should be maskImage?
-            bp.pixelFormat = owner.renderingTarget->GetPixelFormat();
-            bp.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
-
-            HRESULT hr = owner.renderingTarget->CreateBitmap (size, bd.data, bd.lineStride, bp, maskBitmap.resetAndGetPointerAddress());
-            hr = owner.renderingTarget->CreateBitmapBrush (maskBitmap, bmProps, brushProps, bitmapMaskBrush.resetAndGetPointerAddress());
+            // (the brush's edge pixels would be stretched outwards, so the area outside
+            // the image is masked off with a geometry too)
+            Path imageArea;
+            imageArea.addRectangle (image.getBounds());
+            maskGeometry = owner.pathToPathGeometry (imageArea, imageTransform);
 
             imageMaskLayerParams = D2D1::LayerParameters();
+            imageMaskLayerParams.geometricMask = maskGeometry;
             imageMaskLayerParams.opacityBrush = bitmapMaskBrush;
 
             shouldClipBitmap = true;
@@ -525,14 +593,18 @@ public:
             }
         }
 
-        void createFont()
+        bool createFont()
         {
             if (currentFontFace == nullptr)
             {
-                WindowsDirectWriteTypeface* typeface = dynamic_cast<WindowsDirectWriteTypeface*> (font.getTypeface());
-                currentFontFace = typeface->getIDWriteFontFace();
-                fontHeightToEmSizeFactor = typeface->unitsToHeightScaleFactor();
+                if (WindowsDirectWriteTypeface* typeface = dynamic_cast<WindowsDirectWriteTypeface*> (font.getTypeface()))
+                {
+                    currentFontFace = typeface->getIDWriteFontFace();
+                    fontHeightToEmSizeFactor = typeface->unitsToHeightScaleFactor();
+                }
             }
+
+            return currentFontFace != nullptr;
         }
 
         void setOpacity (float newOpacity)
@@ -548,7 +620,6 @@ public:
             gradientStops = 0;
             linearGradient = 0;
             radialGradient = 0;
-            bitmap = 0;
             bitmapBrush = 0;
             currentBrush = 0;
         }
@@ -569,23 +640,11 @@ public:
                     brushProps.opacity = fillType.getOpacity();
                     brushProps.transform = transformToMatrix (fillType.transform);
 
-                    D2D1_BITMAP_BRUSH_PROPERTIES bmProps = D2D1::BitmapBrushProperties (D2D1_EXTEND_MODE_WRAP,D2D1_EXTEND_MODE_WRAP);
-
-                    image = fillType.image;
-
-                    D2D1_SIZE_U size;
-                    size.width = image.getWidth();
-                    size.height = image.getHeight();
-
-                    D2D1_BITMAP_PROPERTIES bp = D2D1::BitmapProperties();
-
-                    this->image = image.convertedToFormat (Image::ARGB);
-                    Image::BitmapData bd (this->image, Image::BitmapData::readOnly);
-                    bp.pixelFormat = owner.renderingTarget->GetPixelFormat();
-                    bp.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
+                    D2D1_BITMAP_BRUSH_PROPERTIES bmProps = D2D1::BitmapBrushProperties (D2D1_EXTEND_MODE_WRAP, D2D1_EXTEND_MODE_WRAP,
+                                                                                        interpolationMode);
 
-                    HRESULT hr = owner.renderingTarget->CreateBitmap (size, bd.data, bd.lineStride, bp, bitmap.resetAndGetPointerAddress());
-                    hr = owner.renderingTarget->CreateBitmapBrush (bitmap, bmProps, brushProps, bitmapBrush.resetAndGetPointerAddress());
+                    if (ID2D1Bitmap* const bitmap = owner.bitmapCache.getBitmapFor (*owner.renderingTarget, fillType.image))
+                        owner.renderingTarget->CreateBitmapBrush (bitmap, bmProps, brushProps, bitmapBrush.resetAndGetPointerAddress());
 
                     currentBrush = bitmapBrush;
                 }
@@ -657,9 +716,7 @@ public:
         ComSmartPtr <IDWriteFontFace> localFontFace;
 
         FillType fillType;
-
-        Image image;
-        ComSmartPtr <ID2D1Bitmap> bitmap; // xxx needs a better name - what is this for??
+        D2D1_BITMAP_INTERPOLATION_MODE interpolationMode;
 
         Rectangle<int> clipRect;
         bool clipsRect, shouldClipRect;
@@ -674,13 +731,14 @@ public:
         ComSmartPtr <ID2D1Layer> rectListLayer;
         bool clipsRectList, shouldClipRectList;
 
-        Image maskImage;
         D2D1_LAYER_PARAMETERS imageMaskLayerParams;
         ComSmartPtr <ID2D1Layer> bitmapMaskLayer;
-        ComSmartPtr <ID2D1Bitmap> maskBitmap;
+        ComSmartPtr <ID2D1Geometry> maskGeometry;
         ComSmartPtr <ID2D1BitmapBrush> bitmapMaskBrush;
         bool clipsBitmap, shouldClipBitmap;
 
+        ComSmartPtr <ID2D1Layer> transparencyLayer;
+
         ID2D1Brush* currentBrush;
         ComSmartPtr <ID2D1BitmapBrush> bitmapBrush;
         ComSmartPtr <ID2D1LinearGradientBrush> linearGradient;
@@ -691,6 +749,137 @@ public:
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SavedState)
     };
 
+    //==============================================================================
+    // Keeps the bitmaps that have been made from images, so that drawing the same image
+    // again doesn't have to copy all of its pixels into a new D2D bitmap.
+    class BitmapCache  : private ImagePixelData::Listener
+    {
+    public:
+        BitmapCache() : frameNumber (0) {}
+        ~BitmapCache()    { clear(); }
+
+        ID2D1Bitmap* getBitmapFor (ID2D1RenderTarget& target, const Image& image)
+        {
+            ImagePixelData* const pixelData = image.getPixelData();
+
+            if (pixelData == nullptr)
+                return nullptr;
+
+            CachedBitmap* c = findCachedBitmap (pixelData);
+
+            if (c == nullptr)
+            {
+                c = bitmaps.add (new CachedBitmap (pixelData));
+                pixelData->listeners.add (this);
+            }
+
+            if (c->bitmap == nullptr)
+            {
+                c->needsUpdate = 0;
+                createBitmap (target, image, *c);
+            }
+            else if (c->needsUpdate.compareAndSetBool (0, 1))
+            {
+                const Image argbImage (getARGBVersion (image));
+                const Image::BitmapData data (argbImage, Image::BitmapData::readOnly);
+                c->bitmap->CopyFromMemory (nullptr, data.data, (UINT32) data.lineStride);
+            }
+
+            c->lastFrameUsed = frameNumber;
+            return c->bitmap;
+        }
+
+        void endFrame()
+        {
+            ++frameNumber;
+
+            for (int i = bitmaps.size(); --i >= 0;)
+                if (frameNumber - bitmaps.getUnchecked(i)->lastFrameUsed > maxUnusedFrames)
+                    removeCachedBitmap (i);
+        }
+
+        void clear()
+        {
+            for (int i = bitmaps.size(); --i >= 0;)
+                removeCachedBitmap (i);
+        }
+
+    private:
+        struct CachedBitmap
+        {
+            CachedBitmap (ImagePixelData* im) noexcept : pixelData (im), lastFrameUsed (0) {}
+
+            ImagePixelData* pixelData;
+            ComSmartPtr <ID2D1Bitmap> bitmap;
+            Atomic<int> needsUpdate;
+            uint32 lastFrameUsed;
+        };
+
+        OwnedArray<CachedBitmap> bitmaps;
+        uint32 frameNumber;
+
+        enum { maxUnusedFrames = 60 };
+
+        static Image getARGBVersion (const Image& image)
+        {
+            return image.getFormat() == Image::ARGB ? image : image.convertedToFormat (Image::ARGB);
+        }
+
+        static void createBitmap (ID2D1RenderTarget& target, const Image& image, CachedBitmap& c)
+        {
+            const Image argbImage (getARGBVersion (image));
+            const Image::BitmapData data (argbImage, Image::BitmapData::readOnly);
+
+            D2D1_BITMAP_PROPERTIES bp = D2D1::BitmapProperties();
+            bp.pixelFormat = target.GetPixelFormat();
+            bp.pixelFormat.alphaMode = D2D1_ALPHA_MODE_PREMULTIPLIED;
+
+            target.CreateBitmap (D2D1::SizeU ((UINT32) image.getWidth(), (UINT32) image.getHeight()),
+                                 data.data, (UINT32) data.lineStride, bp, c.bitmap.resetAndGetPointerAddress());
+        }
+
+        CachedBitmap* findCachedBitmap (ImagePixelData* pixelData) const noexcept
+        {
+            for (int i = 0; i < bitmaps.size(); ++i)
+            {
+                CachedBitmap* const c = bitmaps.getUnchecked(i);
+
+                if (c->pixelData == pixelData)
+                    return c;
+            }
+
+            return nullptr;
+        }
+
+        void removeCachedBitmap (int index)
+        {
+            if (ImagePixelData* const pixelData = bitmaps.getUnchecked (index)->pixelData)
+                pixelData->listeners.remove (this);
+
+            bitmaps.remove (index);
+        }
+
+        void imageDataChanged (ImagePixelData* im) override
+        {
+            if (CachedBitmap* const c = findCachedBitmap (im))
+                c->needsUpdate = 1;
+        }
+
+        void imageDataBeingDeleted (ImagePixelData* im) override
+        {
+            for (int i = bitmaps.size(); --i >= 0;)
+            {
+                if (bitmaps.getUnchecked(i)->pixelData == im)
+                {
+                    bitmaps.getUnchecked(i)->pixelData = nullptr;
+                    bitmaps.remove (i);
+                }
+            }
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (BitmapCache)
+    };
+
     //==============================================================================
 private:
     SharedResourcePointer<Direct2DFactories> factories;
@@ -698,56 +887,58 @@ private:
     ComSmartPtr <ID2D1HwndRenderTarget> renderingTarget;
     ComSmartPtr <ID2D1SolidColorBrush> colourBrush;
     Rectangle<int> bounds;
+    BitmapCache bitmapCache;
 
     SavedState* currentState;
     OwnedArray<SavedState> states;
 
-    //==============================================================================
-    template <typename Type>
-    static D2D1_RECT_F rectangleToRectF (const Rectangle<Type>& r)
+    void createRenderTarget()
     {
-        return D2D1::RectF ((float) r.getX(), (float) r.getY(), (float) r.getRight(), (float) r.getBottom());
-    }
+        RECT windowRect;
+        GetClientRect (hwnd, &windowRect);
+        D2D1_SIZE_U size = { windowRect.right - windowRect.left, windowRect.bottom - windowRect.top };
+        bounds.setSize (size.width, size.height);
 
-    static D2D1_COLOR_F colourToD2D (Colour c)
-    {
-        return D2D1::ColorF::ColorF (c.getFloatRed(), c.getFloatGreen(), c.getFloatBlue(), c.getFloatAlpha());
+        D2D1_RENDER_TARGET_PROPERTIES props = D2D1::RenderTargetProperties();
+        D2D1_HWND_RENDER_TARGET_PROPERTIES propsHwnd = D2D1::HwndRenderTargetProperties (hwnd, size);
+
+        if (factories->d2dFactory != nullptr)
+        {
+            HRESULT hr = factories->d2dFactory->CreateHwndRenderTarget (props, propsHwnd, renderingTarget.resetAndGetPointerAddress());
+            jassert (SUCCEEDED (hr)); (void) hr;
+            hr = renderingTarget->CreateSolidColorBrush (D2D1::ColorF::ColorF (0.0f, 0.0f, 0.0f, 1.0f), colourBrush.resetAndGetPointerAddress());
+        }
     }
 
-    static D2D1_POINT_2F pointTransformed (int x, int y, const AffineTransform& transform)
+    bool isUsingLayers() const noexcept
     {
-        transform.transformPoint (x, y);
-        return D2D1::Point2F ((FLOAT) x, (FLOAT) y);
+        for (int i = states.size(); --i >= 0;)
+        {
+            const SavedState& s = *states.getUnchecked(i);
+
+            if (s.clipsRectList || s.clipsComplex || s.clipsBitmap || s.transparencyLayer != nullptr)
+                return true;
+        }
+
+        return false;
     }
 
-    static void rectToGeometrySink (const Rectangle<int>& rect, ID2D1GeometrySink* sink)
+    //==============================================================================
+    template <typename Type>
+    static D2D1_RECT_F rectangleToRectF (const Rectangle<Type>& r)
     {
-        sink->BeginFigure (pointTransformed (rect.getX(), rect.getY()), D2D1_FIGURE_BEGIN_FILLED);
-        sink->AddLine (pointTransformed (rect.getRight(), rect.getY()));
-        sink->AddLine (pointTransformed (rect.getRight(), rect.getBottom()));
-        sink->AddLine (pointTransformed (rect.getX(), rect.getBottom()));
-        sink->EndFigure (D2D1_FIGURE_END_CLOSED);
+        return D2D1::RectF ((float) r.getX(), (float) r.getY(), (float) r.getRight(), (float) r.getBottom());
     }
 
-    static ID2D1PathGeometry* rectListToPathGeometry (const RectangleList<int>& clipRegion)
+    static D2D1_COLOR_F colourToD2D (Colour c)
     {
-        ID2D1PathGeometry* p = nullptr;
-        factories->d2dFactory->CreatePathGeometry (&p);
-
-        ComSmartPtr <ID2D1GeometrySink> sink;
-        HRESULT hr = p->Open (sink.resetAndGetPointerAddress()); // xxx handle error
-        sink->SetFillMode (D2D1_FILL_MODE_WINDING);
-
-        for (int i = clipRegion.getNumRectangles(); --i >= 0;)
-            rectToGeometrySink (clipRegion.getRectangle(i), sink);
-
-        hr = sink->Close();
-        return p;
+        return D2D1::ColorF::ColorF (c.getFloatRed(), c.getFloatGreen(), c.getFloatBlue(), c.getFloatAlpha());
     }
 
     static void pathToGeometrySink (const Path& path, ID2D1GeometrySink* sink, const AffineTransform& transform)
     {
         Path::Iterator it (path);
+        bool isFigureOpen = false;
 
         while (it.next())
         {
@@ -793,33 +984,59 @@ private:
 
                 case Path::Iterator::closePath:
                 {
-                    sink->EndFigure (D2D1_FIGURE_END_CLOSED);
+                    if (isFigureOpen)
+                        sink->EndFigure (D2D1_FIGURE_END_CLOSED);
+
+                    isFigureOpen = false;
                     break;
                 }
 
                 case Path::Iterator::startNewSubPath:
                 {
+                    if (isFigureOpen)
+                        sink->EndFigure (D2D1_FIGURE_END_OPEN);
+
                     transform.transformPoint (it.x1, it.y1);
                     sink->BeginFigure (D2D1::Point2F (it.x1, it.y1), D2D1_FIGURE_BEGIN_FILLED);
+                    isFigureOpen = true;
                     break;
                 }
             }
         }
+
+        if (isFigureOpen)
+            sink->EndFigure (D2D1_FIGURE_END_OPEN);
     }
 
-    static ID2D1PathGeometry* pathToPathGeometry (const Path& path, const AffineTransform& transform)
+    ComSmartPtr<ID2D1Geometry> pathToPathGeometry (const Path& path, const AffineTransform& transform)
     {
-        ID2D1PathGeometry* p = nullptr;
-        factories->d2dFactory->CreatePathGeometry (&p);
+        ComSmartPtr<ID2D1PathGeometry> p;
+        ComSmartPtr<ID2D1GeometrySink> sink;
 
-        ComSmartPtr <ID2D1GeometrySink> sink;
-        HRESULT hr = p->Open (sink.resetAndGetPointerAddress());
-        sink->SetFillMode (D2D1_FILL_MODE_WINDING); // xxx need to check Path::isUsingNonZeroWinding()
+        if (SUCCEEDED (factories->d2dFactory->CreatePathGeometry (p.resetAndGetPointerAddress()))
+             && SUCCEEDED (p->Open (sink.resetAndGetPointerAddress())))
+        {
+            sink->SetFillMode (path.isUsingNonZeroWinding() ? D2D1_FILL_MODE_WINDING : D2D1_FILL_MODE_ALTERNATE);
+            pathToGeometrySink (path, sink, transform);
+            sink->Close();
+        }
 
-        pathToGeometrySink (path, sink, transform);
+        return ComSmartPtr<ID2D1Geometry> (p);
+    }
+
+    ComSmartPtr<ID2D1Geometry> combineGeometries (ID2D1Geometry* g1, ID2D1Geometry* g2, D2D1_COMBINE_MODE mode)
+    {
+        ComSmartPtr<ID2D1PathGeometry> p;
+        ComSmartPtr<ID2D1GeometrySink> sink;
+
+        if (SUCCEEDED (factories->d2dFactory->CreatePathGeometry (p.resetAndGetPointerAddress()))
+             && SUCCEEDED (p->Open (sink.resetAndGetPointerAddress())))
+        {
+            g1->CombineWithGeometry (g2, mode, nullptr, sink);
+            sink->Close();
+        }
 
-        hr = sink->Close();
-        return p;
+        return ComSmartPtr<ID2D1Geometry> (p);
     }
 
     static D2D1::Matrix3x2F transformToMatrix (const AffineTransform& transform)
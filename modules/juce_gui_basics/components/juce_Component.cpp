@@ -431,6 +431,71 @@ struct Component::ComponentHelpers
         return nothingChanged;
     }
 
+    // When a layer's transform or alpha changes, only the area that it covers in its parent
+    // needs redrawing, and its cached image can be re-used.
+    static void repaintAfterCompositingChange (Component& c)
+    {
+        if (c.flags.isLayerFlag && c.cachedImage != nullptr && ! c.flags.hasHeavyweightPeerFlag)
+            c.repaintParent();
+        else
+            c.repaint();
+    }
+
+    static bool isOpaqueOccluder (const Component& c) noexcept
+    {
+        return c.isVisible() && c.isOpaque() && c.componentTransparency == 0 && ! c.isTransformed();
+    }
+
+    // Returns true if the given area of one of a component's children is entirely covered
+    // by a single opaque sibling which is in front of it.
+    static bool isHiddenBehindSiblings (const Component& parent, const int childIndex, const Rectangle<int>& area)
+    {
+        for (int i = parent.childComponentList.size(); --i > childIndex;)
+        {
+            const Component& sibling = *parent.childComponentList.getUnchecked(i);
+
+            if (isOpaqueOccluder (sibling) && sibling.bounds.contains (area))
+                return true;
+        }
+
+        return false;
+    }
+
+    // Excludes from the clip region any parts of a child which are hidden by opaque siblings
+    // (or opaque components inside those siblings) that are in front of it.
+    static bool clipObscuringSiblings (const Component& parent, const int childIndex, Graphics& g, const Rectangle<int>& childArea)
+    {
+        bool nothingChanged = true;
+
+        for (int i = parent.childComponentList.size(); --i > childIndex;)
+        {
+            const Component& sibling = *parent.childComponentList.getUnchecked(i);
+
+            if (sibling.isVisible() && ! sibling.isTransformed())
+            {
+                const Rectangle<int> overlap (childArea.getIntersection (sibling.bounds));
+
+                if (! overlap.isEmpty())
+                {
+                    if (isOpaqueOccluder (sibling))
+                    {
+                        g.excludeClipRegion (overlap);
+                        nothingChanged = false;
+                    }
+                    else
+                    {
+                        const Point<int> siblingPos (sibling.getPosition());
+
+                        if (clipObscuredRegions (sibling, g, overlap - siblingPos, siblingPos))
+                            nothingChanged = false;
+                    }
+                }
+            }
+        }
+
+        return nothingChanged;
+    }
+
     static Rectangle<int> getParentOrMainMonitorBounds (const Component& comp)
     {
         if (Component* p = comp.getParentComponent())
@@ -769,7 +834,7 @@ public:
 
     void paint (Graphics& g) override
     {
-        scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        updateScale (g.getInternalContext().getPhysicalPixelScaleFactor());
         const Rectangle<int> compBounds (owner.getLocalBounds());
         const Rectangle<int> imageBounds (compBounds * scale);
 
@@ -820,6 +885,28 @@ private:
     Component& owner;
     float scale;
 
+    void updateScale (float newScale)
+    {
+        if (owner.isCompositedAsLayer())
+        {
+            // A layer's own transform is applied when its image is drawn, so it's left out
+            // here, and tiny rounding differences are ignored, so that animating the
+            // transform doesn't cause the image to be re-painted.
+            if (owner.isTransformed())
+            {
+                const float transformScale = std::abs (owner.getTransform().getScaleFactor());
+
+                if (transformScale > 0)
+                    newScale /= transformScale;
+            }
+
+            if (image.isValid() && std::abs (newScale - scale) < scale * 0.001f)
+                return;
+        }
+
+        scale = newScale;
+    }
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StandardCachedComponentImage)
 };
 
@@ -851,6 +938,32 @@ void Component::setBufferedToImage (const bool shouldBeBuffered)
     }
 }
 
+void Component::setCompositedAsLayer (const bool shouldBeLayer)
+{
+    if (flags.isLayerFlag != shouldBeLayer)
+    {
+        flags.isLayerFlag = shouldBeLayer;
+        setBufferedToImage (shouldBeLayer);
+        repaint();
+    }
+}
+
+void Component::setBufferedToDisplayList (const bool shouldBeBuffered)
+{
+    if (shouldBeBuffered)
+    {
+        if (displayList == nullptr)
+        {
+            displayList = new DisplayList();
+            flags.displayListIsValidFlag = false;
+        }
+    }
+    else
+    {
+        displayList = nullptr;
+    }
+}
+
 //==============================================================================
 void Component::reorderChildInternal (const int sourceIndex, const int destIndex)
 {
@@ -1135,7 +1248,7 @@ void Component::setBounds (const int x, const int y, int w, int h)
             else if (! flags.hasHeavyweightPeerFlag)
                 repaintParent();
         }
-        else if (cachedImage != nullptr)
+        else if (cachedImage != nullptr && (wasResized || ! flags.isLayerFlag))
         {
             cachedImage->invalidateAll();
         }
@@ -1325,25 +1438,25 @@ void Component::setTransform (const AffineTransform& newTransform)
     {
         if (affineTransform != nullptr)
         {
-            repaint();
+            ComponentHelpers::repaintAfterCompositingChange (*this);
             affineTransform = nullptr;
-            repaint();
+            ComponentHelpers::repaintAfterCompositingChange (*this);
 
             sendMovedResizedMessages (false, false);
         }
     }
     else if (affineTransform == nullptr)
     {
-        repaint();
+        ComponentHelpers::repaintAfterCompositingChange (*this);
         affineTransform = new AffineTransform (newTransform);
-        repaint();
+        ComponentHelpers::repaintAfterCompositingChange (*this);
         sendMovedResizedMessages (false, false);
     }
     else if (*affineTransform != newTransform)
     {
-        repaint();
+        ComponentHelpers::repaintAfterCompositingChange (*this);
         *affineTransform = newTransform;
-        repaint();
+        ComponentHelpers::repaintAfterCompositingChange (*this);
         sendMovedResizedMessages (false, false);
     }
 }
@@ -1849,7 +1962,7 @@ void Component::setAlpha (const float newAlpha)
         }
         else
         {
-            repaint();
+            ComponentHelpers::repaintAfterCompositingChange (*this);
         }
     }
 }
@@ -1862,16 +1975,18 @@ float Component::getAlpha() const
 //==============================================================================
 void Component::repaint()
 {
+    flags.displayListIsValidFlag = false;
     internalRepaintUnchecked (getLocalBounds(), true);
 }
 
 void Component::repaint (const int x, const int y, const int w, const int h)
 {
-    internalRepaint (Rectangle<int> (x, y, w, h));
+    repaint (Rectangle<int> (x, y, w, h));
 }
 
 void Component::repaint (const Rectangle<int>& area)
 {
+    flags.displayListIsValidFlag = false;
     internalRepaint (area);
 }
 
@@ -1906,12 +2021,14 @@ void Component::internalRepaintUnchecked (Rectangle<int> area, const bool isEnti
 
             if (ComponentPeer* const peer = getPeer())
             {
+                JUCE_TRACE_INSTANT ("gui", "ComponentPeer::repaint");
+
                 // Tweak the scaling so that the component's integer size exactly aligns with the peer's scaled size
                 const Rectangle<int> peerBounds (peer->getBounds());
                 const Rectangle<int> scaled (area * Point<float> (peerBounds.getWidth()  / (float) getWidth(),
                                                                   peerBounds.getHeight() / (float) getHeight()));
 
-                peer->repaint (affineTransform != nullptr ? scaled.transformedBy (*affineTransform) : scaled);
+                peer->queueRepaint (affineTransform != nullptr ? scaled.transformedBy (*affineTransform) : scaled);
             }
         }
         else
@@ -1946,20 +2063,58 @@ void Component::paintWithinParentContext (Graphics& g)
         paintEntireComponent (g, false);
 }
 
+void Component::paintUsingDisplayList (Graphics& g)
+{
+    LowLevelGraphicsContext& context = g.getInternalContext();
+    const float scale = context.getPhysicalPixelScaleFactor();
+
+    if (! (flags.displayListIsValidFlag
+            && displayList->getBounds() == getLocalBounds()
+            && displayList->getPhysicalPixelScaleFactor() == scale))
+    {
+        // (this is set before painting, in case the paint() method calls repaint())
+        flags.displayListIsValidFlag = true;
+
+        DisplayList::Recorder recorder (*displayList, getLocalBounds(), scale, context.getFont());
+        Graphics recordingContext (recorder);
+        paint (recordingContext);
+    }
+
+    displayList->draw (g);
+}
+
 void Component::paintComponentAndChildren (Graphics& g)
 {
+    JUCE_TRACE_ZONE_FOR_OBJECT ("gui", "Component::paint", *this);
+
     const Rectangle<int> clipBounds (g.getClipBounds());
+    ComponentPeer* const profilingPeer = ComponentPeer::peerBeingProfiled;
 
     if (flags.dontClipGraphicsFlag)
     {
+        const double startTime = profilingPeer != nullptr ? Time::getMillisecondCounterHiRes() : 0.0;
+
         paint (g);
+
+        if (profilingPeer != nullptr)
+            profilingPeer->addToPaintProfile (*this, clipBounds, Time::getMillisecondCounterHiRes() - startTime, true);
     }
     else
     {
         g.saveState();
 
         if (ComponentHelpers::clipObscuredRegions (*this, g, clipBounds, Point<int>()) || ! g.isClipEmpty())
-            paint (g);
+        {
+            const double startTime = profilingPeer != nullptr ? Time::getMillisecondCounterHiRes() : 0.0;
+
+            if (displayList != nullptr)
+                paintUsingDisplayList (g);
+            else
+                paint (g);
+
+            if (profilingPeer != nullptr)
+                profilingPeer->addToPaintProfile (*this, g.getClipBounds(), Time::getMillisecondCounterHiRes() - startTime, true);
+        }
 
         g.restoreState();
     }
@@ -1982,6 +2137,10 @@ void Component::paintComponentAndChildren (Graphics& g)
             }
             else if (clipBounds.intersects (child.getBounds()))
             {
+                if (! child.flags.dontClipGraphicsFlag
+                     && ComponentHelpers::isHiddenBehindSiblings (*this, i, clipBounds.getIntersection (child.getBounds())))
+                    continue;
+
                 g.saveState();
 
                 if (child.flags.dontClipGraphicsFlag)
@@ -1990,20 +2149,7 @@ void Component::paintComponentAndChildren (Graphics& g)
                 }
                 else if (g.reduceClipRegion (child.getBounds()))
                 {
-                    bool nothingClipped = true;
-
-                    for (int j = i + 1; j < childComponentList.size(); ++j)
-                    {
-                        const Component& sibling = *childComponentList.getUnchecked (j);
-
-                        if (sibling.flags.opaqueFlag && sibling.isVisible() && sibling.affineTransform == nullptr)
-                        {
-                            nothingClipped = false;
-                            g.excludeClipRegion (sibling.getBounds());
-                        }
-                    }
-
-                    if (nothingClipped || ! g.isClipEmpty())
+                    if (ComponentHelpers::clipObscuringSiblings (*this, i, g, child.getBounds()) || ! g.isClipEmpty())
                         child.paintWithinParentContext (g);
                 }
 
@@ -2013,7 +2159,18 @@ void Component::paintComponentAndChildren (Graphics& g)
     }
 
     g.saveState();
-    paintOverChildren (g);
+
+    if (profilingPeer != nullptr)
+    {
+        const double startTime = Time::getMillisecondCounterHiRes();
+        paintOverChildren (g);
+        profilingPeer->addToPaintProfile (*this, clipBounds, Time::getMillisecondCounterHiRes() - startTime, false);
+    }
+    else
+    {
+        paintOverChildren (g);
+    }
+
     g.restoreState();
 }
 
@@ -1024,6 +1024,54 @@ public:
     */
     void setBufferedToImage (bool shouldBeBuffered);
 
+    /** Makes the component record what its paint() method draws, and replay the recording
+        rather than calling paint() each time it needs redrawing.
+
+        Unlike setBufferedToImage(), this keeps the drawing operations rather than pixels,
+        so it uses much less memory, and stays sharp at any scale and in any kind of
+        context. Only the paint() method is recorded - the children and paintOverChildren()
+        are drawn as usual, so when a child or a parent is repainted, this component's
+        recording can just be replayed.
+
+        The recording is made again after repaint() has been called on this component, or
+        when its size or the display scale has changed. Your paint() method mustn't depend
+        on anything else that could change without a call to repaint(), including the
+        colour or fill that the Graphics context had before it was called. Components that
+        use setPaintingIsUnclipped() aren't affected by this setting.
+
+        @see setBufferedToImage, DisplayList
+    */
+    void setBufferedToDisplayList (bool shouldBeBuffered);
+
+    /** Returns true if setBufferedToDisplayList() has been used to make this component
+        record its painting.
+    */
+    bool isBufferedToDisplayList() const noexcept       { return displayList != nullptr; }
+
+    /** Makes this component a compositing layer, for cheap animation.
+
+        A layer is painted into a cached image in the same way as setBufferedToImage(), but
+        changing its alpha with setAlpha() or its transform with setTransform() doesn't
+        invalidate that image, and neither does moving it with setBounds() - the image is
+        just redrawn with the new position, opacity and transform, and paint() isn't called.
+        This makes sliding panels, fades and zooms cost very little, even when the component
+        is expensive to draw. Resizing the layer, or calling repaint() on it (or any of its
+        children), still causes it to be painted again.
+
+        The image is drawn at the scale of the display, not including the component's own
+        transform, so while a layer is being zoomed its image is stretched rather than being
+        re-painted at the new size. If an OpenGLContext is being used, the image is uploaded
+        to a texture when it's painted, and that texture is re-used until it's invalidated.
+
+        Turning this off also turns off buffering with setBufferedToImage().
+
+        @see setBufferedToImage, setAlpha, setTransform, ComponentAnimator
+    */
+    void setCompositedAsLayer (bool shouldBeLayer);
+
+    /** Returns true if setCompositedAsLayer() has been used to make this a layer. */
+    bool isCompositedAsLayer() const noexcept           { return flags.isLayerFlag; }
+
     /** Generates a snapshot of part of this component.
 
         This will return a new Image, the size of the rectangle specified,
@@ -1152,7 +1200,9 @@ public:
         to tell the repaint system that they are opaque.
 
         This information is used to optimise drawing, because it means that
-        objects underneath opaque windows don't need to be painted.
+        objects underneath opaque windows don't need to be painted. That applies both to
+        the component's parent and to any siblings which are behind it, as long as the
+        component isn't transformed and its alpha is 1.0.
 
         By default, components are considered transparent, unless this is used to
         make it otherwise.
@@ -2267,6 +2317,7 @@ private:
     MouseCursor cursor;
     ImageEffectFilter* effect;
     ScopedPointer<CachedComponentImage> cachedImage;
+    ScopedPointer<DisplayList> displayList;
 
     class MouseListenerList;
     friend class MouseListenerList;
@@ -2300,6 +2351,8 @@ private:
         bool mouseDownWasBlocked        : 1;
         bool isMoveCallbackPending      : 1;
         bool isResizeCallbackPending    : 1;
+        bool displayListIsValidFlag     : 1;
+        bool isLayerFlag                : 1;
        #if JUCE_DEBUG
         bool isInsidePaintCall          : 1;
        #endif
@@ -2336,6 +2389,7 @@ private:
     Component* removeChildComponent (int index, bool sendParentEvents, bool sendChildEvents);
     void reorderChildInternal (int sourceIndex, int destIndex);
     void paintComponentAndChildren (Graphics&);
+    void paintUsingDisplayList (Graphics&);
     void paintWithinParentContext (Graphics&);
     void sendMovedResizedMessages (bool wasMoved, bool wasResized);
     void sendMovedResizedMessagesIfPending();
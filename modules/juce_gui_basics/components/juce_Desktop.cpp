@@ -24,6 +24,8 @@
 
 Desktop::Desktop()
     : mouseSources (new MouseInputSource::SourceList()),
+      frameRate (60.0),
+      repaintBatchingEnabled (false),
       mouseClickCounter (0), mouseWheelCounter (0),
       kioskModeComponent (nullptr),
       kioskModeReentrant (false),
@@ -37,6 +39,10 @@ Desktop::~Desktop()
 {
     setScreenSaverEnabled (true);
 
+    // (this stops the animator listening for frames while the instance is still valid)
+    animator.cancelAllAnimations (false);
+    frameClock = nullptr;
+
     jassert (instance == this);
     instance = nullptr;
 
@@ -186,6 +192,121 @@ void Desktop::addFocusChangeListener    (FocusChangeListener* const listener)
 void Desktop::removeFocusChangeListener (FocusChangeListener* const listener)   { focusListeners.remove (listener); }
 void Desktop::triggerFocusCallback()                                            { triggerAsyncUpdate(); }
 
+//==============================================================================
+class Desktop::FrameClock  : private Thread
+{
+public:
+    FrameClock (const double framesPerSecond)
+        : Thread ("JUCE frame clock"),
+          periodMs (1000.0 / jmax (1.0, framesPerSecond)),
+          message (new FrameMessage())
+    {
+        startThread (8);
+    }
+
+    ~FrameClock()
+    {
+        stopThread (2000);
+    }
+
+private:
+    struct FrameMessage  : public MessageManager::MessageBase
+    {
+        FrameMessage() : frameTime (0) {}
+
+        void messageCallback() override
+        {
+            const double time = frameTime;
+            isPending = 0;
+
+            if (Desktop* const d = Desktop::instance)
+                d->deliverFrame (time);
+        }
+
+        double frameTime;
+        Atomic<int> isPending;
+    };
+
+    const double periodMs;
+    const ReferenceCountedObjectPtr<FrameMessage> message;
+
+    void run() override
+    {
+        double nextFrame = Time::getMillisecondCounterHiRes() + periodMs;
+
+        while (! threadShouldExit())
+        {
+            const double now = Time::getMillisecondCounterHiRes();
+
+            if (now < nextFrame)
+            {
+                wait (jmax (0, (int) (nextFrame - now)));
+                continue;
+            }
+
+            // If the message thread is still busy with the last frame, or this thread has been
+            // held up for more than a whole frame, the missed frames are dropped rather than
+            // being delivered late.
+            if (message->isPending.compareAndSetBool (1, 0))
+            {
+                message->frameTime = nextFrame;
+                message->post();
+            }
+
+            nextFrame += periodMs * (1.0 + std::floor ((now - nextFrame) / periodMs));
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (FrameClock)
+};
+
+void Desktop::addFrameListener (FrameListener* const listener)
+{
+    ASSERT_MESSAGE_MANAGER_IS_LOCKED
+    frameListeners.add (listener);
+
+    if (frameClock == nullptr)
+        frameClock = new FrameClock (frameRate);
+}
+
+void Desktop::removeFrameListener (FrameListener* const listener)
+{
+    ASSERT_MESSAGE_MANAGER_IS_LOCKED
+    frameListeners.remove (listener);
+
+    if (frameListeners.size() == 0)
+        frameClock = nullptr;
+}
+
+void Desktop::setFrameRate (const double framesPerSecond)
+{
+    ASSERT_MESSAGE_MANAGER_IS_LOCKED
+    jassert (framesPerSecond > 0);
+
+    if (frameRate != framesPerSecond)
+    {
+        frameRate = framesPerSecond;
+
+        if (frameClock != nullptr)
+            frameClock = new FrameClock (frameRate);
+    }
+}
+
+void Desktop::setRepaintBatchingEnabled (const bool shouldBatchRepaints)
+{
+    ASSERT_MESSAGE_MANAGER_IS_LOCKED
+    repaintBatchingEnabled = shouldBatchRepaints;
+
+    if (! shouldBatchRepaints)
+        for (int i = peers.size(); --i >= 0;)
+            peers.getUnchecked (i)->flushQueuedRepaints();
+}
+
+void Desktop::deliverFrame (const double frameTimeMs)
+{
+    frameListeners.call (&FrameListener::frameCallback, frameTimeMs);
+}
+
 void Desktop::handleAsyncUpdate()
 {
     // The component may be deleted during this operation, but we'll use a SafePointer rather than a
@@ -146,6 +146,49 @@ public:
     /** Unregisters a listener that was added with addFocusChangeListener(). */
     void removeFocusChangeListener (FocusChangeListener* listener);
 
+    //==============================================================================
+    /** Registers a FrameListener that will be called back once per frame.
+
+        The frame clock runs on its own thread while there are listeners registered. It
+        posts one message per frame to the message thread, and it skips a frame if the
+        previous one hasn't been delivered yet. Animations driven this way are updated
+        exactly once per frame, without the beating that you get between a Timer and the
+        display's refresh.
+
+        @see removeFrameListener, setFrameRate
+    */
+    void addFrameListener (FrameListener* listener);
+
+    /** Unregisters a listener that was added with addFrameListener(). */
+    void removeFrameListener (FrameListener* listener);
+
+    /** Sets the rate at which FrameListeners are called.
+        This should match the refresh rate of the display. The default is 60 frames per second.
+    */
+    void setFrameRate (double framesPerSecond);
+
+    /** Returns the rate at which FrameListeners are called.
+        @see setFrameRate
+    */
+    double getFrameRate() const noexcept                            { return frameRate; }
+
+    /** Makes windows collect up the areas that get repainted, and redraw them together
+        once per frame.
+
+        When this is enabled, the areas that Component::repaint() marks as dirty are merged
+        into a small number of rectangles, and only passed on to the window at the start of
+        the next frame, so that lots of components changing at different moments get redrawn
+        in a single pass. It's disabled by default.
+
+        @see setFrameRate, ComponentPeer::queueRepaint
+    */
+    void setRepaintBatchingEnabled (bool shouldBatchRepaints);
+
+    /** Returns true if repaint batching has been turned on.
+        @see setRepaintBatchingEnabled
+    */
+    bool isRepaintBatchingEnabled() const noexcept                  { return repaintBatchingEnabled; }
+
     //==============================================================================
     /** Takes a component and makes it full-screen, removing the taskbar, dock, etc.
 
@@ -409,6 +452,14 @@ private:
     ListenerList<MouseListener> mouseListeners;
     ListenerList<FocusChangeListener> focusListeners;
 
+    class FrameClock;
+    friend class FrameClock;
+    ListenerList<FrameListener> frameListeners;
+    ScopedPointer<FrameClock> frameClock;
+    double frameRate;
+    bool repaintBatchingEnabled;
+    void deliverFrame (double frameTimeMs);
+
     Array<Component*> desktopComponents;
     Array<ComponentPeer*> peers;
 
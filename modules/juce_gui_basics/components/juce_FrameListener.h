@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_FRAMELISTENER_H_INCLUDED
+#define JUCE_FRAMELISTENER_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Receives a callback once per display frame, for driving animations.
+
+    Register one of these with Desktop::addFrameListener(). Callbacks are made on the
+    message thread at the rate given by Desktop::getFrameRate(). If the message thread
+    is too busy to keep up, frames are dropped rather than being queued up.
+
+    A listener should only stay registered while it has something to animate - the
+    clock stops when no listeners are registered.
+
+    @see Desktop::addFrameListener, Desktop::removeFrameListener
+*/
+class JUCE_API  FrameListener
+{
+public:
+    /** Destructor. */
+    virtual ~FrameListener()  {}
+
+    /** Called on the message thread once per frame.
+
+        @param frameTimeMs  the time at which this frame was due, in the same units as
+                            Time::getMillisecondCounterHiRes(). Because this is the scheduled
+                            time rather than the time the callback happened to arrive,
+                            the difference between successive values is always a whole
+                            number of frame periods, which keeps animations smooth.
+    */
+    virtual void frameCallback (double frameTimeMs) = 0;
+};
+
+
+#endif   // JUCE_FRAMELISTENER_H_INCLUDED
@@ -131,9 +131,86 @@ void Drawable::setTransformToFit (const Rectangle<float>& area, RectanglePlaceme
         setTransform (placement.getTransformToFit (getDrawableBounds(), area));
 }
 
+//==============================================================================
+// Keeps the drawables that have been parsed from SVG data, so that when the same icon is
+// loaded many times, its XML only gets parsed once, and after that it's just copied.
+class ParsedSVGCache  : private DeletedAtShutdown
+{
+public:
+    ParsedSVGCache() {}
+    ~ParsedSVGCache()   { clearSingletonInstance(); }
+
+    juce_DeclareSingleton (ParsedSVGCache, false)
+
+    Drawable* createCopyOf (const void* data, size_t numBytes)
+    {
+        const int64 hash = getHash (data, numBytes);
+        const ScopedLock sl (lock);
+
+        for (int i = entries.size(); --i >= 0;)
+        {
+            Entry* const e = entries.getUnchecked (i);
+
+            if (e->hash == hash && e->data.matches (data, numBytes))
+            {
+                entries.move (i, entries.size() - 1);  // (the end of the list is the most recently used)
+                return e->drawable->createCopy();
+            }
+        }
+
+        return nullptr;
+    }
+
+    void add (const void* data, size_t numBytes, const Drawable& drawable)
+    {
+        const int64 hash = getHash (data, numBytes);
+        const ScopedLock sl (lock);
+
+        entries.add (new Entry (hash, data, numBytes, drawable.createCopy()));
+
+        while (entries.size() > maxNumEntries)
+            entries.remove (0);
+    }
+
+private:
+    struct Entry
+    {
+        Entry (int64 h, const void* d, size_t numBytes, Drawable* drawableToUse)
+            : hash (h), data (d, numBytes), drawable (drawableToUse)
+        {}
+
+        const int64 hash;
+        const MemoryBlock data;
+        const ScopedPointer<Drawable> drawable;
+    };
+
+    OwnedArray<Entry> entries;
+    CriticalSection lock;
+
+    enum { maxNumEntries = 128 };
+
+    static int64 getHash (const void* data, size_t numBytes) noexcept
+    {
+        const uint8* const bytes = static_cast<const uint8*> (data);
+        uint64 hash = (uint64) numBytes;
+
+        for (size_t i = 0; i < numBytes; ++i)
+            hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+
+        return (int64) hash;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (ParsedSVGCache)
+};
+
+juce_ImplementSingleton (ParsedSVGCache)
+
 //==============================================================================
 Drawable* Drawable::createFromImageData (const void* data, const size_t numBytes)
 {
+    if (Drawable* const cachedSVG = ParsedSVGCache::getInstance()->createCopyOf (data, numBytes))
+        return cachedSVG;
+
     Drawable* result = nullptr;
 
     Image image (ImageFileFormat::loadFrom (data, numBytes));
@@ -156,7 +233,12 @@ Drawable* Drawable::createFromImageData (const void* data, const size_t numBytes
             ScopedPointer <XmlElement> svg (doc.getDocumentElement());
 
             if (svg != nullptr)
+            {
                 result = Drawable::createFromSVG (*svg);
+
+                if (result != nullptr)
+                    ParsedSVGCache::getInstance()->add (data, numBytes, *result);
+            }
         }
     }
 
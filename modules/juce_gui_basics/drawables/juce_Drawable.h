@@ -206,6 +206,7 @@ protected:
     //==============================================================================
     friend class DrawableComposite;
     friend class DrawableShape;
+    friend class FlattenedDrawable;
 
     /** @internal */
     void transformContextToCorrectOrigin (Graphics&);
@@ -168,6 +168,7 @@ protected:
     Path path, strokePath;
 
 private:
+    friend class FlattenedDrawable;
     class RelativePositioner;
     RelativeFillType mainFill, strokeFill;
     ScopedPointer<RelativeCoordinatePositionerBase> mainFillPositioner, strokeFillPositioner;
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+struct FlattenedDrawable::Item
+{
+    virtual ~Item() {}
+    virtual void draw (Graphics&) const = 0;
+};
+
+struct FlattenedDrawable::ShapeItem  : public FlattenedDrawable::Item
+{
+    ShapeItem (const Path& p, const FillType& f, const AffineTransform& transform)
+        : path (p), fill (f.transformed (transform))
+    {
+        path.applyTransform (transform);
+    }
+
+    void draw (Graphics& g) const override
+    {
+        g.setFillType (fill);
+        g.fillPath (path);
+    }
+
+    Path path;
+    const FillType fill;
+};
+
+struct FlattenedDrawable::ImageItem  : public FlattenedDrawable::Item
+{
+    ImageItem (const DrawableImage& d, const AffineTransform& t)
+        : image (d.getImage()), transform (t),
+          opacity (d.getOpacity()), overlayColour (d.getOverlayColour())
+    {}
+
+    void draw (Graphics& g) const override
+    {
+        if (opacity > 0.0f && ! overlayColour.isOpaque())
+        {
+            g.setOpacity (opacity);
+            g.drawImageTransformed (image, transform, false);
+        }
+
+        if (! overlayColour.isTransparent())
+        {
+            g.setColour (overlayColour.withMultipliedAlpha (opacity));
+            g.drawImageTransformed (image, transform, true);
+        }
+    }
+
+    const Image image;
+    const AffineTransform transform;
+    const float opacity;
+    const Colour overlayColour;
+};
+
+// Anything that can't be broken down into shapes is kept as a copy of the original drawable
+struct FlattenedDrawable::DrawableItem  : public FlattenedDrawable::Item
+{
+    DrawableItem (const Drawable& d, const AffineTransform& t)
+        : drawable (d.createCopy()), transform (t)
+    {
+        drawable->setTransform (AffineTransform::identity);
+    }
+
+    void draw (Graphics& g) const override
+    {
+        drawable->draw (g, 1.0f, transform);
+    }
+
+    const ScopedPointer<Drawable> drawable;
+    const AffineTransform transform;
+};
+
+//==============================================================================
+FlattenedDrawable::FlattenedDrawable (const Drawable& source)
+    : bounds (source.getDrawableBounds())
+{
+    addItemsFor (source, source.getTransform());
+}
+
+FlattenedDrawable::~FlattenedDrawable()
+{
+}
+
+// The transform maps the drawable's own coordinates onto those of the top-level one
+void FlattenedDrawable::addItemsFor (const Drawable& d, const AffineTransform& transform)
+{
+    if (const DrawableShape* const shape = dynamic_cast<const DrawableShape*> (&d))
+    {
+        if (! shape->getFill().fill.isInvisible())
+            items.add (new ShapeItem (shape->path, shape->getFill().fill, transform));
+
+        if (shape->isStrokeVisible())
+            items.add (new ShapeItem (shape->strokePath, shape->getStrokeFill().fill, transform));
+    }
+    else if (const DrawableImage* const image = dynamic_cast<const DrawableImage*> (&d))
+    {
+        if (image->getImage().isValid())
+            items.add (new ImageItem (*image, transform));
+    }
+    else if (dynamic_cast<const DrawableComposite*> (&d) == nullptr)
+    {
+        items.add (new DrawableItem (d, transform));
+        return;
+    }
+
+    // A child component is painted with its parent's origin, and then has its own
+    // transform applied in the parent component's space.
+    const Point<float> origin (d.originRelativeToComponent.toFloat());
+
+    for (int i = 0; i < d.getNumChildComponents(); ++i)
+    {
+        const Drawable* const child = dynamic_cast<const Drawable*> (d.getChildComponent (i));
+
+        if (child != nullptr && child->isVisible())
+            addItemsFor (*child, AffineTransform::translation (origin)
+                                    .followedBy (child->getTransform())
+                                    .translated (-origin)
+                                    .followedBy (transform));
+    }
+}
+
+//==============================================================================
+void FlattenedDrawable::draw (Graphics& g, float opacity, const AffineTransform& transform) const
+{
+    Graphics::ScopedSaveState ss (g);
+    g.addTransform (transform);
+
+    if (! g.isClipEmpty())
+    {
+        if (opacity < 1.0f)
+            g.beginTransparencyLayer (opacity);
+
+        for (int i = 0; i < items.size(); ++i)
+            items.getUnchecked (i)->draw (g);
+
+        if (opacity < 1.0f)
+            g.endTransparencyLayer();
+    }
+}
+
+void FlattenedDrawable::drawAt (Graphics& g, float x, float y, float opacity) const
+{
+    draw (g, opacity, AffineTransform::translation (x, y));
+}
+
+void FlattenedDrawable::drawWithin (Graphics& g, const Rectangle<float>& destArea,
+                                    RectanglePlacement placement, float opacity) const
+{
+    draw (g, opacity, placement.getTransformToFit (bounds, destArea));
+}
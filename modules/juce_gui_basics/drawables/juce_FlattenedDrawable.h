@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+#ifndef JUCE_FLATTENEDDRAWABLE_H_INCLUDED
+#define JUCE_FLATTENEDDRAWABLE_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A lightweight, read-only copy of a Drawable, which can draw it without needing
+    any components.
+
+    A Drawable is a tree of components, and drawing one means painting each of those
+    components in turn. A FlattenedDrawable takes a snapshot of that tree as a simple
+    list of paths, images and fills, with all the transforms between the drawable's
+    components already applied, so that the whole thing can be drawn in a single call.
+
+    This is handy when you need to draw lots of copies of the same icon, e.g. in a list
+    or a grid, as each copy costs a lot less memory and time than a Drawable would.
+    Because the paths are the same each time they're drawn, the renderer's caches can
+    also re-use the work it did to rasterise them.
+
+    Any text in the drawable is kept as a copy of its DrawableText object, which is
+    drawn in the normal way.
+
+    Note that this is a snapshot, so any changes made to the original Drawable after
+    creating one of these won't be reflected in it.
+
+    @see Drawable
+*/
+class JUCE_API  FlattenedDrawable
+{
+public:
+    //==============================================================================
+    /** Creates a flattened copy of a drawable. */
+    explicit FlattenedDrawable (const Drawable& sourceDrawable);
+
+    /** Destructor. */
+    ~FlattenedDrawable();
+
+    //==============================================================================
+    /** Draws the shapes, with a given transform applied.
+        This behaves in the same way as Drawable::draw().
+    */
+    void draw (Graphics& g, float opacity,
+               const AffineTransform& transform = AffineTransform::identity) const;
+
+    /** Draws the shapes at a given position.
+        This behaves in the same way as Drawable::drawAt().
+    */
+    void drawAt (Graphics& g, float x, float y, float opacity) const;
+
+    /** Draws the shapes so that they fit inside a rectangle.
+        This behaves in the same way as Drawable::drawWithin().
+    */
+    void drawWithin (Graphics& g, const Rectangle<float>& destArea,
+                     RectanglePlacement placement, float opacity) const;
+
+    /** Returns the area that the original drawable covered. */
+    Rectangle<float> getDrawableBounds() const noexcept         { return bounds; }
+
+private:
+    //==============================================================================
+    struct Item;
+    struct ShapeItem;
+    struct ImageItem;
+    struct DrawableItem;
+
+    OwnedArray<Item> items;
+    Rectangle<float> bounds;
+
+    void addItemsFor (const Drawable&, const AffineTransform&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlattenedDrawable)
+};
+
+
+#endif   // JUCE_FLATTENEDDRAWABLE_H_INCLUDED
@@ -56,6 +56,7 @@ void DirectoryContentsList::setDirectory (const File& directory,
     {
         clear();
         root = directory;
+        updateWatchedFolder();
         changed();
 
         // (this forces a refresh when setTypeFlags() is called, rather than triggering two refreshes)
@@ -114,6 +115,87 @@ void DirectoryContentsList::setFileFilter (const FileFilter* newFileFilter)
     fileFilter = newFileFilter;
 }
 
+//==============================================================================
+void DirectoryContentsList::setWatchesForChanges (const bool shouldWatchForChanges)
+{
+    if (shouldWatchForChanges != isWatchingForChanges())
+    {
+        if (shouldWatchForChanges)
+        {
+            watcher = new FileSystemWatcher();
+            watcher->addListener (this);
+            updateWatchedFolder();
+        }
+        else
+        {
+            watcher = nullptr;
+        }
+    }
+}
+
+void DirectoryContentsList::updateWatchedFolder()
+{
+    if (watcher != nullptr)
+    {
+        watcher->removeAllFolders();
+
+        if (root.isDirectory())
+            watcher->addFolder (root, false);
+    }
+}
+
+void DirectoryContentsList::fileSystemChanged (FileSystemWatcher&, const Array<FileSystemWatcher::Change>& changes)
+{
+    bool hasChanged = false;
+
+    for (int i = 0; i < changes.size(); ++i)
+    {
+        const FileSystemWatcher::Change& change = changes.getReference (i);
+
+        if (change.type == FileSystemWatcher::folderNeedsRescan || change.file == root)
+        {
+            refresh();
+            return;
+        }
+
+        if (change.file.getParentDirectory() == root && updateFile (change.file))
+            hasChanged = true;
+    }
+
+    if (hasChanged)
+        changed();
+}
+
+bool DirectoryContentsList::updateFile (const File& file)
+{
+    const ScopedLock sl (fileListLock);
+
+    const String filename (file.getFileName());
+    bool wasRemoved = false;
+
+    for (int i = files.size(); --i >= 0;)
+    {
+        if (files.getUnchecked(i)->filename == filename)
+        {
+            files.remove (i);
+            wasRemoved = true;
+            break;
+        }
+    }
+
+    if (file.exists() && ! (ignoresHiddenFiles() && file.isHidden()))
+    {
+        const bool isDir = file.isDirectory();
+
+        if ((fileTypeFlags & (isDir ? File::findDirectories : File::findFiles)) != 0
+             && addFile (file, isDir, file.getSize(), file.getLastModificationTime(),
+                         file.getCreationTime(), ! file.hasWriteAccess()))
+            return true;
+    }
+
+    return wasRemoved;
+}
+
 //==============================================================================
 bool DirectoryContentsList::getFileInfo (const int index, FileInfo& result) const
 {
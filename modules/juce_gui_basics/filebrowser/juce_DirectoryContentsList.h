@@ -37,7 +37,8 @@
     @see FileListComponent, FileBrowserComponent
 */
 class JUCE_API  DirectoryContentsList   : public ChangeBroadcaster,
-                                          private TimeSliceClient
+                                          private TimeSliceClient,
+                                          private FileSystemWatcher::Listener
 {
 public:
     //==============================================================================
@@ -117,6 +118,19 @@ public:
     */
     void setFileFilter (const FileFilter* newFileFilter);
 
+    /** Makes the list keep itself up-to-date when the files in its directory change.
+
+        When this is enabled, the list uses a FileSystemWatcher to find out which files
+        have been added, removed or modified, and updates just those items, so there's no
+        need to call refresh(). By default, this is disabled.
+    */
+    void setWatchesForChanges (bool shouldWatchForChanges);
+
+    /** Returns true if the list is updating itself when files change.
+        @see setWatchesForChanges
+    */
+    bool isWatchingForChanges() const noexcept              { return watcher != nullptr; }
+
     //==============================================================================
     /** Contains cached information about one of the files in a DirectoryContentsList.
     */
@@ -208,6 +222,8 @@ private:
     ScopedPointer<DirectoryIterator> fileFindHandle;
     bool volatile shouldStop;
 
+    ScopedPointer<FileSystemWatcher> watcher;
+
     int useTimeSlice() override;
     void stopSearching();
     void changed();
@@ -215,6 +231,9 @@ private:
     bool addFile (const File&, bool isDir, int64 fileSize, Time modTime,
                   Time creationTime, bool isReadOnly);
     void setTypeFlags (int);
+    void updateWatchedFolder();
+    bool updateFile (const File&);
+    void fileSystemChanged (FileSystemWatcher&, const Array<FileSystemWatcher::Change>&) override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DirectoryContentsList)
 };
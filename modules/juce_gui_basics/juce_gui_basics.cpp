@@ -143,6 +143,8 @@ namespace juce
 
 extern bool juce_areThereAnyAlwaysOnTopWindows();
 
+// (the module is split into four compile units of roughly equal size - see JUCE_COMPILE_UNIT)
+#if JUCE_COMPILE_UNIT (1)
 #include "components/juce_Component.cpp"
 #include "components/juce_ComponentListener.cpp"
 #include "mouse/juce_MouseInputSource.cpp"
@@ -159,6 +161,60 @@ extern bool juce_areThereAnyAlwaysOnTopWindows();
 #include "keyboard/juce_KeyListener.cpp"
 #include "keyboard/juce_KeyPress.cpp"
 #include "keyboard/juce_ModifierKeys.cpp"
+#include "windows/juce_AlertWindow.cpp"
+#include "windows/juce_CallOutBox.cpp"
+#include "windows/juce_ComponentPeer.cpp"
+#include "windows/juce_DialogWindow.cpp"
+#include "windows/juce_DocumentWindow.cpp"
+#include "windows/juce_ResizableWindow.cpp"
+#include "windows/juce_ThreadWithProgressWindow.cpp"
+#include "windows/juce_TooltipWindow.cpp"
+#include "windows/juce_TopLevelWindow.cpp"
+#include "filebrowser/juce_FileChooser.cpp"
+
+#if JUCE_IOS || JUCE_WINDOWS
+ #include "native/juce_MultiTouchMapper.h"
+#endif
+
+#if JUCE_MAC || JUCE_IOS
+ #include "../juce_core/native/juce_osx_ObjCHelpers.h"
+ #include "../juce_graphics/native/juce_mac_CoreGraphicsHelpers.h"
+ #include "../juce_graphics/native/juce_mac_CoreGraphicsContext.h"
+
+ #if JUCE_IOS
+  #include "native/juce_ios_UIViewComponentPeer.mm"
+  #include "native/juce_ios_Windowing.mm"
+ #else
+  #include "native/juce_mac_NSViewComponentPeer.mm"
+  #include "native/juce_mac_Windowing.mm"
+  #include "native/juce_mac_MainMenu.mm"
+ #endif
+
+ #include "native/juce_mac_MouseCursor.mm"
+ #include "native/juce_mac_FileChooser.mm"
+
+#elif JUCE_WINDOWS
+ #include "../juce_core/native/juce_win32_ComSmartPtr.h"
+ #include "../juce_events/native/juce_win32_HiddenMessageWindow.h"
+ #include "native/juce_win32_Windowing.cpp"
+ #include "native/juce_win32_DragAndDrop.cpp"
+ #include "native/juce_win32_FileChooser.cpp"
+
+#elif JUCE_LINUX
+ #include "native/juce_linux_Clipboard.cpp"
+ #include "native/juce_linux_Windowing.cpp"
+ #include "native/juce_linux_FileChooser.cpp"
+
+#elif JUCE_ANDROID
+ #include "../juce_core/native/juce_android_JNIHelpers.h"
+ #include "native/juce_android_Windowing.cpp"
+ #include "native/juce_android_FileChooser.cpp"
+
+#endif
+#endif
+
+//==============================================================================
+#if JUCE_COMPILE_UNIT (2)
 #include "buttons/juce_ArrowButton.cpp"
 #include "buttons/juce_Button.cpp"
 #include "buttons/juce_DrawableButton.cpp"
@@ -175,11 +231,11 @@ extern bool juce_areThereAnyAlwaysOnTopWindows();
 #include "drawables/juce_DrawableRectangle.cpp"
 #include "drawables/juce_DrawableShape.cpp"
 #include "drawables/juce_DrawableText.cpp"
+#include "drawables/juce_FlattenedDrawable.cpp"
 #include "drawables/juce_SVGParser.cpp"
 #include "filebrowser/juce_DirectoryContentsDisplayComponent.cpp"
 #include "filebrowser/juce_DirectoryContentsList.cpp"
 #include "filebrowser/juce_FileBrowserComponent.cpp"
-#include "filebrowser/juce_FileChooser.cpp"
 #include "filebrowser/juce_FileChooserDialogBox.cpp"
 #include "filebrowser/juce_FileListComponent.cpp"
 #include "filebrowser/juce_FilenameComponent.cpp"
@@ -203,6 +259,10 @@ extern bool juce_areThereAnyAlwaysOnTopWindows();
 #include "layout/juce_TabbedButtonBar.cpp"
 #include "layout/juce_TabbedComponent.cpp"
 #include "layout/juce_Viewport.cpp"
+#endif
+
+//==============================================================================
+#if JUCE_COMPILE_UNIT (3)
 #include "lookandfeel/juce_LookAndFeel.cpp"
 #include "lookandfeel/juce_LookAndFeel_V2.cpp"
 #include "lookandfeel/juce_LookAndFeel_V1.cpp"
@@ -224,6 +284,17 @@ extern bool juce_areThereAnyAlwaysOnTopWindows();
 #include "properties/juce_PropertyPanel.cpp"
 #include "properties/juce_SliderPropertyComponent.cpp"
 #include "properties/juce_TextPropertyComponent.cpp"
+#include "commands/juce_ApplicationCommandInfo.cpp"
+#include "commands/juce_ApplicationCommandManager.cpp"
+#include "commands/juce_ApplicationCommandTarget.cpp"
+#include "commands/juce_KeyPressMappingSet.cpp"
+#include "application/juce_Application.cpp"
+#include "misc/juce_BubbleComponent.cpp"
+#include "misc/juce_DropShadower.cpp"
+#endif
+
+//==============================================================================
+#if JUCE_COMPILE_UNIT (4)
 #include "widgets/juce_ComboBox.cpp"
 #include "widgets/juce_ImageComponent.cpp"
 #include "widgets/juce_Label.cpp"
@@ -237,61 +308,7 @@ extern bool juce_areThereAnyAlwaysOnTopWindows();
 #include "widgets/juce_Toolbar.cpp"
 #include "widgets/juce_ToolbarItemPalette.cpp"
 #include "widgets/juce_TreeView.cpp"
-#include "windows/juce_AlertWindow.cpp"
-#include "windows/juce_CallOutBox.cpp"
-#include "windows/juce_ComponentPeer.cpp"
-#include "windows/juce_DialogWindow.cpp"
-#include "windows/juce_DocumentWindow.cpp"
-#include "windows/juce_ResizableWindow.cpp"
-#include "windows/juce_ThreadWithProgressWindow.cpp"
-#include "windows/juce_TooltipWindow.cpp"
-#include "windows/juce_TopLevelWindow.cpp"
-#include "commands/juce_ApplicationCommandInfo.cpp"
-#include "commands/juce_ApplicationCommandManager.cpp"
-#include "commands/juce_ApplicationCommandTarget.cpp"
-#include "commands/juce_KeyPressMappingSet.cpp"
-#include "application/juce_Application.cpp"
-#include "misc/juce_BubbleComponent.cpp"
-#include "misc/juce_DropShadower.cpp"
-
-#if JUCE_IOS || JUCE_WINDOWS
- #include "native/juce_MultiTouchMapper.h"
-#endif
-
-#if JUCE_MAC || JUCE_IOS
- #include "../juce_core/native/juce_osx_ObjCHelpers.h"
- #include "../juce_graphics/native/juce_mac_CoreGraphicsHelpers.h"
- #include "../juce_graphics/native/juce_mac_CoreGraphicsContext.h"
-
- #if JUCE_IOS
-  #include "native/juce_ios_UIViewComponentPeer.mm"
-  #include "native/juce_ios_Windowing.mm"
- #else
-  #include "native/juce_mac_NSViewComponentPeer.mm"
-  #include "native/juce_mac_Windowing.mm"
-  #include "native/juce_mac_MainMenu.mm"
- #endif
-
- #include "native/juce_mac_MouseCursor.mm"
- #include "native/juce_mac_FileChooser.mm"
-
-#elif JUCE_WINDOWS
- #include "../juce_core/native/juce_win32_ComSmartPtr.h"
- #include "../juce_events/native/juce_win32_HiddenMessageWindow.h"
- #include "native/juce_win32_Windowing.cpp"
- #include "native/juce_win32_DragAndDrop.cpp"
- #include "native/juce_win32_FileChooser.cpp"
-
-#elif JUCE_LINUX
- #include "native/juce_linux_Clipboard.cpp"
- #include "native/juce_linux_Windowing.cpp"
- #include "native/juce_linux_FileChooser.cpp"
-
-#elif JUCE_ANDROID
- #include "../juce_core/native/juce_android_JNIHelpers.h"
- #include "native/juce_android_Windowing.cpp"
- #include "native/juce_android_FileChooser.cpp"
-
+#include "widgets/juce_VirtualTreeView.cpp"
 #endif
 
 }
@@ -127,6 +127,7 @@ class DrawableButton;
 #include "components/juce_ComponentListener.h"
 #include "components/juce_CachedComponentImage.h"
 #include "components/juce_Component.h"
+#include "components/juce_FrameListener.h"
 #include "layout/juce_ComponentAnimator.h"
 #include "components/juce_Desktop.h"
 #include "layout/juce_ComponentBoundsConstrainer.h"
@@ -189,6 +190,7 @@ class DrawableButton;
 #include "drawables/juce_DrawablePath.h"
 #include "drawables/juce_DrawableRectangle.h"
 #include "drawables/juce_DrawableText.h"
+#include "drawables/juce_FlattenedDrawable.h"
 #include "widgets/juce_TextEditor.h"
 #include "widgets/juce_Label.h"
 #include "widgets/juce_ComboBox.h"
@@ -205,6 +207,7 @@ class DrawableButton;
 #include "buttons/juce_ToolbarButton.h"
 #include "misc/juce_DropShadower.h"
 #include "widgets/juce_TreeView.h"
+#include "widgets/juce_VirtualTreeView.h"
 #include "windows/juce_TopLevelWindow.h"
 #include "windows/juce_AlertWindow.h"
 #include "windows/juce_CallOutBox.h"
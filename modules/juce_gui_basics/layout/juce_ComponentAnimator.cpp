@@ -152,6 +152,8 @@ public:
 
             image = c.createComponentSnapshot (c.getLocalBounds(), false, scale);
 
+            // (so that fading it out doesn't need a transparency layer on every frame)
+            setCompositedAsLayer (true);
             setVisible (true);
             toBehind (&c);
         }
@@ -190,8 +192,21 @@ private:
 };
 
 //==============================================================================
-ComponentAnimator::ComponentAnimator()  : lastTime (0) {}
-ComponentAnimator::~ComponentAnimator() {}
+ComponentAnimator::ComponentAnimator()  : lastTime (0), isListeningForFrames (false) {}
+
+ComponentAnimator::~ComponentAnimator()
+{
+    stopListeningForFrames();
+}
+
+void ComponentAnimator::stopListeningForFrames()
+{
+    if (isListeningForFrames)
+    {
+        isListeningForFrames = false;
+        Desktop::getInstance().removeFrameListener (this);
+    }
+}
 
 //==============================================================================
 ComponentAnimator::AnimationTask* ComponentAnimator::findTaskFor (Component* const component) const noexcept
@@ -228,10 +243,11 @@ void ComponentAnimator::animateComponent (Component* const component,
         at->reset (finalBounds, finalAlpha, millisecondsToSpendMoving,
                    useProxyComponent, startSpeed, endSpeed);
 
-        if (! isTimerRunning())
+        if (! isListeningForFrames)
         {
-            lastTime = Time::getMillisecondCounter();
-            startTimerHz (50);
+            isListeningForFrames = true;
+            lastTime = Time::getMillisecondCounterHiRes();
+            Desktop::getInstance().addFrameListener (this);
         }
     }
 }
@@ -268,6 +284,8 @@ void ComponentAnimator::cancelAllAnimations (const bool moveComponentsToTheirFin
         tasks.clear();
         sendChangeMessage();
     }
+
+    stopListeningForFrames();
 }
 
 void ComponentAnimator::cancelAnimation (Component* const component,
@@ -303,14 +321,10 @@ bool ComponentAnimator::isAnimating() const noexcept
     return tasks.size() != 0;
 }
 
-void ComponentAnimator::timerCallback()
+void ComponentAnimator::frameCallback (const double frameTimeMs)
 {
-    const uint32 timeNow = Time::getMillisecondCounter();
-
-    if (lastTime == 0 || lastTime == timeNow)
-        lastTime = timeNow;
-
-    const int elapsed = (int) (timeNow - lastTime);
+    // (rounding both times, rather than the difference, stops the error building up over many frames)
+    const int elapsed = jmax (0, roundToInt (frameTimeMs) - roundToInt (lastTime));
 
     for (int i = tasks.size(); --i >= 0;)
     {
@@ -321,8 +335,8 @@ void ComponentAnimator::timerCallback()
         }
     }
 
-    lastTime = timeNow;
+    lastTime = jmax (lastTime, frameTimeMs);
 
     if (tasks.size() == 0)
-        stopTimer();
+        stopListeningForFrames();
 }
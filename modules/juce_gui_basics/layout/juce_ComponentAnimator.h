@@ -42,13 +42,16 @@
     It's ok to delete components while they're being animated - the animator will detect this
     and safely stop using them.
 
+    A component that has been made into a layer with Component::setCompositedAsLayer() can
+    be moved and faded without being re-painted, as long as its size isn't being animated.
+
     The class is a ChangeBroadcaster and sends a notification when any components
     start or finish being animated.
 
     @see Desktop::getAnimator
 */
 class JUCE_API  ComponentAnimator  : public ChangeBroadcaster,
-                                     private Timer
+                                     private FrameListener
 {
 public:
     //==============================================================================
@@ -149,10 +152,12 @@ private:
     //==============================================================================
     class AnimationTask;
     OwnedArray<AnimationTask> tasks;
-    uint32 lastTime;
+    double lastTime;
+    bool isListeningForFrames;
 
     AnimationTask* findTaskFor (Component*) const noexcept;
-    void timerCallback();
+    void frameCallback (double) override;
+    void stopListeningForFrames();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ComponentAnimator)
 };
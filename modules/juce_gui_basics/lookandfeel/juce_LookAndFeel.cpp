@@ -33,7 +33,7 @@ extern GetTypefaceForFont juce_getTypefaceForFont;
 
 //==============================================================================
 LookAndFeel::LookAndFeel()
-    : useNativeAlertWindows (false)
+    : useNativeAlertWindows (false), renderingThreadPool (nullptr)
 {
     /* if this fails it means you're trying to create a LookAndFeel object before
        the static Colours have been initialised. That ain't gonna work. It probably
@@ -131,9 +131,17 @@ MouseCursor LookAndFeel::getMouseCursorFor (Component& component)
 LowLevelGraphicsContext* LookAndFeel::createGraphicsContext (const Image& imageToRenderOn, const Point<int>& origin,
                                                              const RectangleList<int>& initialClip)
 {
+    if (renderingThreadPool != nullptr)
+        return new LowLevelGraphicsTiledSoftwareRenderer (imageToRenderOn, origin, initialClip, *renderingThreadPool);
+
     return new LowLevelGraphicsSoftwareRenderer (imageToRenderOn, origin, initialClip);
 }
 
+void LookAndFeel::setRenderingThreadPool (ThreadPool* const poolToUse) noexcept
+{
+    renderingThreadPool = poolToUse;
+}
+
 //==============================================================================
 void LookAndFeel::setUsingNativeAlertWindows (bool shouldUseNativeAlerts)
 {
@@ -179,11 +179,28 @@ public:
     virtual MouseCursor getMouseCursorFor (Component&);
 
     //==============================================================================
-    /** Creates a new graphics context object. */
+    /** Creates a new graphics context object.
+        By default this returns a LowLevelGraphicsSoftwareRenderer, or a
+        LowLevelGraphicsTiledSoftwareRenderer if a rendering thread pool has been set.
+        @see setRenderingThreadPool
+    */
     virtual LowLevelGraphicsContext* createGraphicsContext (const Image& imageToRenderOn,
                                                             const Point<int>& origin,
                                                             const RectangleList<int>& initialClip);
 
+    /** Makes the software renderer use a thread pool to paint large areas of the screen.
+
+        When a pool is set, windows that use this look-and-feel will be painted by a
+        LowLevelGraphicsTiledSoftwareRenderer, which divides big repaints into bands and
+        draws them on the pool's threads. The pool isn't owned by the look-and-feel, so it
+        must not be deleted while it's being used - pass nullptr to go back to normal
+        single-threaded rendering.
+
+        This only affects windows that are drawn by the software renderer - it makes no
+        difference when CoreGraphics or Direct2D are being used.
+    */
+    void setRenderingThreadPool (ThreadPool* poolToUse) noexcept;
+
     void setUsingNativeAlertWindows (bool shouldUseNativeAlerts);
     bool isUsingNativeAlertWindows();
 
@@ -225,6 +242,7 @@ private:
     SortedSet<ColourSetting> colours;
     String defaultSans, defaultSerif, defaultFixed;
     bool useNativeAlertWindows;
+    ThreadPool* renderingThreadPool;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LookAndFeel)
 };
@@ -454,6 +454,7 @@ void DragAndDropContainer::startDragging (const var& sourceDescription,
         // Under heavy load, the layered window's paint callback can often be lost by the OS,
         // so forcing a repaint at least once makes sure that the window becomes visible..
         if (ComponentPeer* const peer = dragImageComponent->getPeer())
+            peer->flushQueuedRepaints();
             peer->performAnyPendingRepaintsNow();
        #endif
 
@@ -657,7 +657,8 @@ public:
 
     ImageType* createType() const override     { return new NativeImageType(); }
 
-    void blitToWindow (Window window, int dx, int dy, int dw, int dh, int sx, int sy)
+    void blitToWindow (Window window, int dx, int dy, int dw, int dh, int sx, int sy,
+                       bool sendCompletionEvent = true)
     {
         ScopedXLock xlock;
 
@@ -710,7 +711,7 @@ public:
         // blit results to screen.
        #if JUCE_USE_XSHM
         if (isUsingXShm())
-            XShmPutImage (display, (::Drawable) window, gc, xImage, sx, sy, dx, dy, dw, dh, True);
+            XShmPutImage (display, (::Drawable) window, gc, xImage, sx, sy, dx, dy, dw, dh, sendCompletionEvent ? True : False);
         else
        #endif
             XPutImage (display, (::Drawable) window, gc, xImage, sx, sy, dx, dy, dw, dh);
@@ -1649,8 +1650,8 @@ public:
                                    &child);
         }
 
-        repaint (Rectangle<int> (exposeEvent.x, exposeEvent.y,
-                                 exposeEvent.width, exposeEvent.height));
+        handleExposedArea (Rectangle<int> (exposeEvent.x, exposeEvent.y,
+                                           exposeEvent.width, exposeEvent.height));
 
         while (XEventsQueued (display, QueuedAfterFlush) > 0)
         {
@@ -1660,11 +1661,16 @@ public:
 
             XNextEvent (display, &nextEvent);
             const XExposeEvent& nextExposeEvent = (const XExposeEvent&) nextEvent.xexpose;
-            repaint (Rectangle<int> (nextExposeEvent.x, nextExposeEvent.y,
-                                     nextExposeEvent.width, nextExposeEvent.height));
+            handleExposedArea (Rectangle<int> (nextExposeEvent.x, nextExposeEvent.y,
+                                               nextExposeEvent.width, nextExposeEvent.height));
         }
     }
 
+    void handleExposedArea (const Rectangle<int>& area)
+    {
+        repainter->exposed (area.getIntersection (bounds.withZeroOrigin()));
+    }
+
     void handleConfigureNotifyEvent (XConfigureEvent& confEvent)
     {
         updateWindowBounds();
@@ -1834,7 +1840,7 @@ private:
     {
     public:
         LinuxRepaintManager (LinuxComponentPeer& p)
-            : peer (p), lastTimeImageUsed (0)
+            : peer (p)
         {
            #if JUCE_USE_XSHM
             shmPaintsPending = 0;
@@ -1863,16 +1869,10 @@ private:
                 return;
            #endif
 
-            if (! regionsNeedingRepaint.isEmpty())
-            {
-                stopTimer();
+            stopTimer();
+
+            if (! (regionsNeedingRepaint.isEmpty() && regionsNeedingBlit.isEmpty()))
                 performAnyPendingRepaintsNow();
-            }
-            else if (Time::getApproximateMillisecondCounter() > lastTimeImageUsed + 3000)
-            {
-                stopTimer();
-                image = Image::null;
-            }
         }
 
         void repaint (const Rectangle<int>& area)
@@ -1880,7 +1880,28 @@ private:
             if (! isTimerRunning())
                 startTimer (repaintTimerPeriod);
 
-            regionsNeedingRepaint.add (area);
+            ComponentPeer::addToRepaintRegion (regionsNeedingRepaint, area);
+        }
+
+        // Called when the X server has lost part of the window's contents. Anything that's
+        // still correct in the back buffer is just sent again, rather than being repainted.
+        void exposed (const Rectangle<int>& area)
+        {
+            if (area.isEmpty())
+                return;
+
+            if (! isTimerRunning())
+                startTimer (repaintTimerPeriod);
+
+            RectangleList<int> stillValid (validArea);
+            stillValid.clipTo (area);
+            regionsNeedingBlit.add (stillValid);
+
+            RectangleList<int> needsPainting (area);
+            needsPainting.subtract (validArea);
+
+            for (const Rectangle<int>* i = needsPainting.begin(), * const e = needsPainting.end(); i != e; ++i)
+                ComponentPeer::addToRepaintRegion (regionsNeedingRepaint, *i);
         }
 
         void performAnyPendingRepaintsNow()
@@ -1893,57 +1914,74 @@ private:
             }
            #endif
 
-            RectangleList<int>  originalRepaintRegion (regionsNeedingRepaint);
+            RectangleList<int> areaToPaint (regionsNeedingRepaint);
+            RectangleList<int> areaToBlit (regionsNeedingBlit);
             regionsNeedingRepaint.clear();
-            const Rectangle<int> totalArea (originalRepaintRegion.getBounds());
+            regionsNeedingBlit.clear();
+
+            const Rectangle<int> windowArea (peer.bounds.withZeroOrigin());
 
-            if (! totalArea.isEmpty())
+            if (windowArea.isEmpty() || (areaToPaint.isEmpty() && areaToBlit.isEmpty()))
+                return;
+
+            // The back buffer covers the whole window, so its pixels stay in the right place
+            // between repaints, and it only has to be re-allocated when the window grows.
+            if (image.isNull() || image.getWidth() < windowArea.getWidth()
+                 || image.getHeight() < windowArea.getHeight())
             {
-                if (image.isNull() || image.getWidth() < totalArea.getWidth()
-                     || image.getHeight() < totalArea.getHeight())
-                {
-                   #if JUCE_USE_XSHM
-                    image = Image (new XBitmapImage (useARGBImagesForRendering ? Image::ARGB
-                                                                               : Image::RGB,
-                   #else
-                    image = Image (new XBitmapImage (Image::RGB,
-                   #endif
-                                                     (totalArea.getWidth()  + 31) & ~31,
-                                                     (totalArea.getHeight() + 31) & ~31,
-                                                     false, peer.depth, peer.visual));
-                }
+               #if JUCE_USE_XSHM
+                image = Image (new XBitmapImage (useARGBImagesForRendering ? Image::ARGB
+                                                                           : Image::RGB,
+               #else
+                image = Image (new XBitmapImage (Image::RGB,
+               #endif
+                                                 (windowArea.getWidth()  + 31) & ~31,
+                                                 (windowArea.getHeight() + 31) & ~31,
+                                                 false, peer.depth, peer.visual));
 
-                startTimer (repaintTimerPeriod);
+                validArea.clear();
+                areaToPaint.add (areaToBlit);
+            }
 
-                RectangleList<int> adjustedList (originalRepaintRegion);
-                adjustedList.offsetAll (-totalArea.getX(), -totalArea.getY());
+            areaToPaint.clipTo (windowArea);
 
+            if (! areaToPaint.isEmpty())
+            {
                 if (peer.depth == 32)
-                    for (const Rectangle<int>* i = originalRepaintRegion.begin(), * const e = originalRepaintRegion.end(); i != e; ++i)
-                        image.clear (*i - totalArea.getPosition());
+                    for (const Rectangle<int>* i = areaToPaint.begin(), * const e = areaToPaint.end(); i != e; ++i)
+                        image.clear (*i);
 
                 {
                     ScopedPointer<LowLevelGraphicsContext> context (peer.getComponent().getLookAndFeel()
-                                                                      .createGraphicsContext (image, -totalArea.getPosition(), adjustedList));
+                                                                      .createGraphicsContext (image, Point<int>(), areaToPaint));
                     peer.handlePaint (*context);
                 }
 
-                for (const Rectangle<int>* i = originalRepaintRegion.begin(), * const e = originalRepaintRegion.end(); i != e; ++i)
-                {
-                    XBitmapImage* xbitmap = static_cast<XBitmapImage*> (image.getPixelData());
-                   #if JUCE_USE_XSHM
-                    if (xbitmap->isUsingXShm())
-                        ++shmPaintsPending;
-                   #endif
+                validArea.add (areaToPaint);
+                areaToBlit.add (areaToPaint);
+            }
 
+            areaToBlit.clipTo (windowArea);
+            areaToBlit.consolidate();
 
-                   xbitmap->blitToWindow (peer.windowH,
-                                          i->getX(), i->getY(), i->getWidth(), i->getHeight(),
-                                          i->getX() - totalArea.getX(), i->getY() - totalArea.getY());
-                }
+            XBitmapImage* const xbitmap = static_cast<XBitmapImage*> (image.getPixelData());
+
+            for (const Rectangle<int>* i = areaToBlit.begin(), * const e = areaToBlit.end(); i != e; ++i)
+            {
+                // With XShm, only the last put asks for a completion event: the server handles
+                // them in order, so when that one arrives, the buffer is free to be drawn into again.
+                const bool isLastRectangle = (i == e - 1);
+
+               #if JUCE_USE_XSHM
+                if (isLastRectangle && xbitmap->isUsingXShm())
+                    ++shmPaintsPending;
+               #endif
+
+                xbitmap->blitToWindow (peer.windowH,
+                                       i->getX(), i->getY(), i->getWidth(), i->getHeight(),
+                                       i->getX(), i->getY(), isLastRectangle);
             }
 
-            lastTimeImageUsed = Time::getApproximateMillisecondCounter();
             startTimer (repaintTimerPeriod);
         }
 
@@ -1956,8 +1994,7 @@ private:
 
         LinuxComponentPeer& peer;
         Image image;
-        uint32 lastTimeImageUsed;
-        RectangleList<int> regionsNeedingRepaint;
+        RectangleList<int> regionsNeedingRepaint, regionsNeedingBlit, validArea;
 
        #if JUCE_USE_XSHM
         bool useARGBImagesForRendering;
@@ -219,15 +219,251 @@ private:
     JUCE_DECLARE_NON_COPYABLE (DependencyFinderScope)
 };
 
+//==============================================================================
+/*  Keeps track of which positioners depend on which components, so that a change to a
+    component only needs a single listener callback, and so that the positioners it
+    affects can be applied in order.
+
+    Each positioner has a rank, which is one more than the highest rank of any positioner
+    that moves a component it refers to. While a pass is in progress, positioners that need
+    updating are queued rather than applied, and the queue is emptied lowest-rank first.
+*/
+class RelativeCoordinatePositionerBase::LayoutGraph  : private ComponentListener
+{
+public:
+    LayoutGraph() : generation (0), passDepth (0), passNumber (0) {}
+
+    ~LayoutGraph()
+    {
+        jassert (sources.size() == 0 && pending.size() == 0);
+    }
+
+    void addDependency (Component& comp, RelativeCoordinatePositionerBase& positioner)
+    {
+        bool found;
+        const int index = findSource (comp, found);
+
+        if (! found)
+        {
+            sources.insert (index, new Source (comp));
+            comp.addComponentListener (this);
+        }
+
+        sources.getUnchecked (index)->dependents.addIfNotAlreadyThere (&positioner);
+        ++generation;
+    }
+
+    void removeDependency (Component& comp, RelativeCoordinatePositionerBase& positioner)
+    {
+        bool found;
+        const int index = findSource (comp, found);
+
+        if (found)
+        {
+            Array<RelativeCoordinatePositionerBase*>& dependents = sources.getUnchecked (index)->dependents;
+            dependents.removeFirstMatchingValue (&positioner);
+
+            if (dependents.size() == 0)
+            {
+                comp.removeComponentListener (this);
+                sources.remove (index);
+            }
+
+            ++generation;
+        }
+    }
+
+    void positionerDeleted (RelativeCoordinatePositionerBase& positioner)
+    {
+        pending.removeFirstMatchingValue (&positioner);
+    }
+
+    //==============================================================================
+    void beginPass() noexcept
+    {
+        ++passDepth;
+    }
+
+    void endPass()
+    {
+        if (passDepth == 1)
+        {
+            ++passNumber;
+
+            while (pending.size() > 0)
+            {
+                RelativeCoordinatePositionerBase* const next = pending.remove (findLowestRankedPending());
+
+                if (next->lastLayoutPass != passNumber)
+                {
+                    next->lastLayoutPass = passNumber;
+                    next->numAppliesInPass = 0;
+                }
+
+                // If this fails, a set of positioners refer to each other's components in a
+                // loop that never settles on a fixed set of positions.
+                jassert (next->numAppliesInPass < maxAppliesPerPass);
+
+                if (++(next->numAppliesInPass) <= maxAppliesPerPass)
+                    next->applyNow();
+            }
+        }
+
+        --passDepth;
+    }
+
+    void schedule (RelativeCoordinatePositionerBase& positioner)
+    {
+        pending.addIfNotAlreadyThere (&positioner);
+    }
+
+    int generation;
+
+private:
+    //==============================================================================
+    struct Source
+    {
+        Source (Component& c) noexcept : component (&c) {}
+
+        Component* const component;
+        Array<RelativeCoordinatePositionerBase*> dependents;
+    };
+
+    OwnedArray<Source> sources;  // (sorted by component address)
+    Array<RelativeCoordinatePositionerBase*> pending;
+    int passDepth, passNumber;
+
+    enum { maxAppliesPerPass = 16 };
+
+    int findSource (Component& comp, bool& found) const noexcept
+    {
+        int start = 0, end = sources.size();
+
+        while (start < end)
+        {
+            const int mid = (start + end) / 2;
+            Component* const c = sources.getUnchecked (mid)->component;
+
+            if (c == &comp)
+            {
+                found = true;
+                return mid;
+            }
+
+            if (c < &comp)
+                start = mid + 1;
+            else
+                end = mid;
+        }
+
+        found = false;
+        return start;
+    }
+
+    int findLowestRankedPending() const
+    {
+        int best = 0, bestRank = pending.getUnchecked (0)->getLayoutRank();
+
+        for (int i = 1; i < pending.size(); ++i)
+        {
+            const int rank = pending.getUnchecked (i)->getLayoutRank();
+
+            if (rank < bestRank)
+            {
+                best = i;
+                bestRank = rank;
+            }
+        }
+
+        return best;
+    }
+
+    //==============================================================================
+    // (the dependents only queue themselves while a pass is active, so these lists
+    // can't be changed by the callbacks)
+    void componentMovedOrResized (Component& comp, bool wasMoved, bool wasResized) override
+    {
+        bool found;
+        const int index = findSource (comp, found);
+
+        if (found)
+        {
+            beginPass();
+
+            const Array<RelativeCoordinatePositionerBase*>& dependents = sources.getUnchecked (index)->dependents;
+
+            for (int i = 0; i < dependents.size(); ++i)
+                dependents.getUnchecked (i)->componentMovedOrResized (comp, wasMoved, wasResized);
+
+            endPass();
+        }
+    }
+
+    void componentParentHierarchyChanged (Component& comp) override
+    {
+        bool found;
+        const int index = findSource (comp, found);
+
+        if (found)
+        {
+            beginPass();
+
+            const Array<RelativeCoordinatePositionerBase*>& dependents = sources.getUnchecked (index)->dependents;
+
+            for (int i = 0; i < dependents.size(); ++i)
+                dependents.getUnchecked (i)->componentParentHierarchyChanged (comp);
+
+            endPass();
+        }
+    }
+
+    void componentChildrenChanged (Component& comp) override
+    {
+        bool found;
+        const int index = findSource (comp, found);
+
+        if (found)
+        {
+            beginPass();
+
+            const Array<RelativeCoordinatePositionerBase*>& dependents = sources.getUnchecked (index)->dependents;
+
+            for (int i = 0; i < dependents.size(); ++i)
+                dependents.getUnchecked (i)->componentChildrenChanged (comp);
+
+            endPass();
+        }
+    }
+
+    void componentBeingDeleted (Component& comp) override
+    {
+        bool found;
+        const int index = findSource (comp, found);
+
+        if (found)
+        {
+            const ScopedPointer<Source> source (sources.removeAndReturn (index));
+            ++generation;
+
+            for (int i = 0; i < source->dependents.size(); ++i)
+                source->dependents.getUnchecked (i)->componentBeingDeleted (comp);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (LayoutGraph)
+};
+
 //==============================================================================
 RelativeCoordinatePositionerBase::RelativeCoordinatePositionerBase (Component& comp)
-    : Component::Positioner (comp), registeredOk (false)
+    : Component::Positioner (comp), layoutRank (0), layoutRankGeneration (-1),
+      numAppliesInPass (0), lastLayoutPass (0), registeredOk (false), isCalculatingLayoutRank (false)
 {
 }
 
 RelativeCoordinatePositionerBase::~RelativeCoordinatePositionerBase()
 {
     unregisterListeners();
+    layoutGraph->positionerDeleted (*this);
 }
 
 void RelativeCoordinatePositionerBase::componentMovedOrResized (Component&, bool /*wasMoved*/, bool /*wasResized*/)
@@ -265,6 +501,13 @@ void RelativeCoordinatePositionerBase::markerListBeingDeleted (MarkerList* marke
 }
 
 void RelativeCoordinatePositionerBase::apply()
+{
+    layoutGraph->beginPass();
+    layoutGraph->schedule (*this);
+    layoutGraph->endPass();
+}
+
+void RelativeCoordinatePositionerBase::applyNow()
 {
     if (! registeredOk)
     {
@@ -289,11 +532,39 @@ bool RelativeCoordinatePositionerBase::addPoint (const RelativePoint& point)
     return addCoordinate (point.y) && ok;
 }
 
+int RelativeCoordinatePositionerBase::getLayoutRank()
+{
+    if (layoutRankGeneration != layoutGraph->generation)
+    {
+        // (a loop of positioners that refer to each other is treated as if it were broken here)
+        if (isCalculatingLayoutRank)
+            return 0;
+
+        isCalculatingLayoutRank = true;
+        int rank = 0;
+
+        for (int i = 0; i < sourceComponents.size(); ++i)
+        {
+            Component* const source = sourceComponents.getUnchecked (i);
+
+            if (source != &getComponent())
+                if (RelativeCoordinatePositionerBase* const p = dynamic_cast<RelativeCoordinatePositionerBase*> (source->getPositioner()))
+                    rank = jmax (rank, p->getLayoutRank() + 1);
+        }
+
+        isCalculatingLayoutRank = false;
+        layoutRank = rank;
+        layoutRankGeneration = layoutGraph->generation;
+    }
+
+    return layoutRank;
+}
+
 void RelativeCoordinatePositionerBase::registerComponentListener (Component& comp)
 {
     if (! sourceComponents.contains (&comp))
     {
-        comp.addComponentListener (this);
+        layoutGraph->addDependency (comp, *this);
         sourceComponents.add (&comp);
     }
 }
@@ -310,7 +581,7 @@ void RelativeCoordinatePositionerBase::registerMarkerListListener (MarkerList* c
 void RelativeCoordinatePositionerBase::unregisterListeners()
 {
     for (int i = sourceComponents.size(); --i >= 0;)
-        sourceComponents.getUnchecked(i)->removeComponentListener (this);
+        layoutGraph->removeDependency (*sourceComponents.getUnchecked(i), *this);
 
     for (int i = sourceMarkerLists.size(); --i >= 0;)
         sourceMarkerLists.getUnchecked(i)->removeListener (this);
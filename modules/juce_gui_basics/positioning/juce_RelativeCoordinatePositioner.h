@@ -29,6 +29,12 @@
 //==============================================================================
 /**
     Base class for Component::Positioners that are based upon relative coordinates.
+
+    All the positioners share a single dependency graph, which listens to each
+    component that any of them refer to. When one of those components changes, the
+    positioners that depend on it are collected first, and then applied in dependency
+    order, so that each one is only re-evaluated once per change, after everything it
+    refers to has been updated.
 */
 class JUCE_API  RelativeCoordinatePositionerBase  : public Component::Positioner,
                                                     public ComponentListener,
@@ -45,6 +51,10 @@ public:
     void markersChanged (MarkerList*);
     void markerListBeingDeleted (MarkerList* markerList);
 
+    /** Recalculates the component's position.
+        If this is called while other positioners are being applied, it's deferred until
+        the positioners that this one depends on have been updated.
+    */
     void apply();
 
     bool addCoordinate (const RelativeCoordinate& coord);
@@ -77,10 +87,16 @@ protected:
 private:
     class DependencyFinderScope;
     friend class DependencyFinderScope;
+    class LayoutGraph;
+    friend class LayoutGraph;
+    SharedResourcePointer<LayoutGraph> layoutGraph;
     Array <Component*> sourceComponents;
     Array <MarkerList*> sourceMarkerLists;
-    bool registeredOk;
+    int layoutRank, layoutRankGeneration, numAppliesInPass, lastLayoutPass;
+    bool registeredOk, isCalculatingLayoutRank;
 
+    void applyNow();
+    int getLayoutRank();
     void registerComponentListener (Component& comp);
     void registerMarkerListListener (MarkerList* const list);
     void unregisterListeners();
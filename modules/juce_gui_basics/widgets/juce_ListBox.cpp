@@ -200,7 +200,7 @@ public:
         const int newX = content.getX();
         int newY = content.getY();
         const int newW = jmax (owner.minimumRowWidth, getMaximumVisibleWidth());
-        const int newH = owner.totalItems * owner.getRowHeight();
+        const int newH = owner.getRowY (owner.totalItems);
 
         if (newY + newH < getMaximumVisibleHeight() && newH > getMaximumVisibleHeight())
             newY = getMaximumVisibleHeight() - newH;
@@ -222,7 +222,19 @@ public:
             const int y = getViewPositionY();
             const int w = content.getWidth();
 
-            const int numNeeded = 2 + getMaximumVisibleHeight() / rowH;
+            firstIndex = owner.getRowAtY (y);
+            firstWholeIndex = owner.getRowY (firstIndex) < y ? firstIndex + 1 : firstIndex;
+            lastWholeIndex = owner.getRowAtY (y + getMaximumVisibleHeight() - 1);
+
+            int numNeeded = 2 + getMaximumVisibleHeight() / rowH;
+
+            if (owner.rowTops.size() > 0)
+            {
+                // (with variable heights, the number of rows on screen changes as the list
+                // scrolls, so the components are only ever added, to avoid recreating them)
+                numNeeded = jmax (rows.size(), 2 + lastWholeIndex - firstIndex);
+            }
+
             rows.removeRange (numNeeded, rows.size());
 
             while (numNeeded > rows.size())
@@ -232,17 +244,14 @@ public:
                 content.addAndMakeVisible (newRow);
             }
 
-            firstIndex = y / rowH;
-            firstWholeIndex = (y + rowH - 1) / rowH;
-            lastWholeIndex = (y + getMaximumVisibleHeight() - 1) / rowH;
-
             for (int i = 0; i < numNeeded; ++i)
             {
                 const int row = i + firstIndex;
 
                 if (RowComponent* const rowComp = getComponentForRow (row))
                 {
-                    rowComp->setBounds (0, row * rowH, w, rowH);
+                    const int rowY = owner.getRowY (row);
+                    rowComp->setBounds (0, rowY, w, owner.getRowY (row + 1) - rowY);
                     rowComp->update (row, owner.isRowSelected (row));
                 }
             }
@@ -256,14 +265,14 @@ public:
                                               owner.headerComponent->getHeight());
     }
 
-    void selectRow (const int row, const int rowH, const bool dontScroll,
+    void selectRow (const int row, const bool dontScroll,
                     const int lastSelectedRow, const int totalRows, const bool isMouseClick)
     {
         hasUpdated = false;
 
         if (row < firstWholeIndex && ! dontScroll)
         {
-            setViewPosition (getViewPositionX(), row * rowH);
+            setViewPosition (getViewPositionX(), owner.getRowY (row));
         }
         else if (row >= lastWholeIndex && ! dontScroll)
         {
@@ -274,12 +283,12 @@ public:
                  && ! isMouseClick)
             {
                 setViewPosition (getViewPositionX(),
-                                 jlimit (0, jmax (0, totalRows - rowsOnScreen), row) * rowH);
+                                 owner.getRowY (jlimit (0, jmax (0, totalRows - rowsOnScreen), row)));
             }
             else
             {
                 setViewPosition (getViewPositionX(),
-                                 jmax (0, (row  + 1) * rowH - getMaximumVisibleHeight()));
+                                 jmax (0, owner.getRowY (row + 1) - getMaximumVisibleHeight()));
             }
         }
 
@@ -287,16 +296,16 @@ public:
             updateContents();
     }
 
-    void scrollToEnsureRowIsOnscreen (const int row, const int rowH)
+    void scrollToEnsureRowIsOnscreen (const int row)
     {
         if (row < firstWholeIndex)
         {
-            setViewPosition (getViewPositionX(), row * rowH);
+            setViewPosition (getViewPositionX(), owner.getRowY (row));
         }
         else if (row >= lastWholeIndex)
         {
             setViewPosition (getViewPositionX(),
-                             jmax (0, (row  + 1) * rowH - getMaximumVisibleHeight()));
+                             jmax (0, owner.getRowY (row + 1) - getMaximumVisibleHeight()));
         }
     }
 
@@ -460,6 +469,7 @@ void ListBox::updateContent()
 {
     hasDoneInitialUpdate = true;
     totalItems = (model != nullptr) ? model->getNumRows() : 0;
+    updateRowHeights();
 
     bool selectionChanged = false;
 
@@ -504,7 +514,7 @@ void ListBox::selectRowInternal (const int row,
             if (getHeight() == 0 || getWidth() == 0)
                 dontScroll = true;
 
-            viewport->selectRow (row, getRowHeight(), dontScroll,
+            viewport->selectRow (row, dontScroll,
                                  lastRowSelected, totalItems, isMouseClick);
 
             lastRowSelected = row;
@@ -635,7 +645,7 @@ int ListBox::getRowContainingPosition (const int x, const int y) const noexcept
 {
     if (isPositiveAndBelow (x, getWidth()))
     {
-        const int row = (viewport->getViewPositionY() + y - viewport->getY()) / rowHeight;
+        const int row = getRowAtY (viewport->getViewPositionY() + y - viewport->getY());
 
         if (isPositiveAndBelow (row, totalItems))
             return row;
@@ -648,8 +658,12 @@ int ListBox::getInsertionIndexForPosition (const int x, const int y) const noexc
 {
     if (isPositiveAndBelow (x, getWidth()))
     {
-        const int row = (viewport->getViewPositionY() + y + rowHeight / 2 - viewport->getY()) / rowHeight;
-        return jlimit (0, totalItems, row);
+        const int pos = viewport->getViewPositionY() + y - viewport->getY();
+        const int row = getRowAtY (pos);
+        const int rowY = getRowY (row);
+        const int h = getRowY (row + 1) - rowY;
+
+        return jlimit (0, totalItems, pos - rowY >= (h + 1) / 2 ? row + 1 : row);
     }
 
     return -1;
@@ -671,13 +685,14 @@ int ListBox::getRowNumberOfComponent (Component* const rowComponent) const noexc
 Rectangle<int> ListBox::getRowPosition (const int rowNumber,
                                         const bool relativeToComponentTopLeft) const noexcept
 {
-    int y = viewport->getY() + rowHeight * rowNumber;
+    const int rowY = getRowY (rowNumber);
+    int y = viewport->getY() + rowY;
 
     if (relativeToComponentTopLeft)
         y -= viewport->getViewPositionY();
 
     return Rectangle<int> (viewport->getX(), y,
-                           viewport->getViewedComponent()->getWidth(), rowHeight);
+                           viewport->getViewedComponent()->getWidth(), getRowY (rowNumber + 1) - rowY);
 }
 
 void ListBox::setVerticalPosition (const double proportion)
@@ -703,13 +718,14 @@ int ListBox::getVisibleRowWidth() const noexcept
 
 void ListBox::scrollToEnsureRowIsOnscreen (const int row)
 {
-    viewport->scrollToEnsureRowIsOnscreen (row, getRowHeight());
+    viewport->scrollToEnsureRowIsOnscreen (row);
 }
 
 //==============================================================================
 bool ListBox::keyPressed (const KeyPress& key)
 {
-    const int numVisibleRows = viewport->getHeight() / getRowHeight();
+    const int numVisibleRows = rowTops.size() > 0 ? jmax (1, getNumRowsOnScreen())
+                                                  : viewport->getHeight() / getRowHeight();
 
     const bool multiple = multipleSelection
                             && lastRowSelected >= 0
@@ -828,9 +844,76 @@ void ListBox::setRowHeight (const int newHeight)
 
 int ListBox::getNumRowsOnScreen() const noexcept
 {
+    if (rowTops.size() > 0)
+    {
+        const int y = viewport->getViewPositionY();
+        return getRowAtY (y + viewport->getMaximumVisibleHeight()) - getRowAtY (y);
+    }
+
     return viewport->getMaximumVisibleHeight() / rowHeight;
 }
 
+//==============================================================================
+void ListBox::updateRowHeights()
+{
+    if (model == nullptr || ! model->hasVariableRowHeights())
+    {
+        rowTops.clear();
+        return;
+    }
+
+    rowTops.resize (totalItems + 1);
+    int* const tops = rowTops.getRawDataPointer();
+    int y = 0;
+
+    for (int i = 0; i < totalItems; ++i)
+    {
+        tops[i] = y;
+
+        const int h = model->getHeightForRow (i);
+        y += h < 0 ? rowHeight : h;
+    }
+
+    tops[totalItems] = y;
+}
+
+int ListBox::getRowY (const int row) const noexcept
+{
+    if (rowTops.size() == 0 || row <= 0)
+        return row * rowHeight;
+
+    if (row >= totalItems)
+        return rowTops.getLast() + (row - totalItems) * rowHeight;
+
+    return rowTops.getUnchecked (row);
+}
+
+int ListBox::getRowAtY (const int y) const noexcept
+{
+    if (rowTops.size() == 0 || y < 0)
+        return y / rowHeight;
+
+    const int totalHeight = rowTops.getLast();
+
+    if (y >= totalHeight)
+        return totalItems + (y - totalHeight) / rowHeight;
+
+    // find the last row whose top is at or above y
+    int start = 0, end = totalItems;
+
+    while (end - start > 1)
+    {
+        const int mid = (start + end) / 2;
+
+        if (rowTops.getUnchecked (mid) <= y)
+            start = mid;
+        else
+            end = mid;
+    }
+
+    return start;
+}
+
 void ListBox::setMinimumContentWidth (const int newMinimumWidth)
 {
     minimumRowWidth = newMinimumWidth;
@@ -966,3 +1049,5 @@ void ListBoxModel::listWasScrolled() {}
 var ListBoxModel::getDragSourceDescription (const SparseSet<int>&)      { return var(); }
 String ListBoxModel::getTooltipForRow (int)                             { return String::empty; }
 MouseCursor ListBoxModel::getMouseCursorForRow (int)                    { return MouseCursor::NormalCursor; }
+bool ListBoxModel::hasVariableRowHeights()                              { return false; }
+int ListBoxModel::getHeightForRow (int)                                 { return -1; }
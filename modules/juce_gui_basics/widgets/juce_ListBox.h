@@ -156,6 +156,21 @@ public:
     /** You can override this to return a custom mouse cursor for each row. */
     virtual MouseCursor getMouseCursorForRow (int row);
 
+    //==============================================================================
+    /** Override this to return true if the rows in your list aren't all the same height.
+
+        If this returns true, ListBox::updateContent() will call getHeightForRow() for
+        every row in the list, and keep a table of the row positions so that it can still
+        find the row at a given position quickly.
+    */
+    virtual bool hasVariableRowHeights();
+
+    /** If hasVariableRowHeights() returns true, this must return the height of a row.
+        A negative value means that the row should use the ListBox's default height.
+        @see ListBox::setRowHeight
+    */
+    virtual int getHeightForRow (int rowNumber);
+
 private:
    #if JUCE_CATCH_DEPRECATED_CODE_MISUSE
     // This method's signature has changed to take a MouseEvent parameter - please update your code!
@@ -429,12 +444,15 @@ public:
 
     //==============================================================================
     /** Sets the height of each row in the list.
-        The default height is 22 pixels.
-        @see getRowHeight
+        The default height is 22 pixels. If the model has variable row heights, this is
+        the height used for any rows for which it doesn't supply one.
+        @see getRowHeight, ListBoxModel::getHeightForRow
     */
     void setRowHeight (int newHeight);
 
-    /** Returns the height of a row in the list.
+    /** Returns the default height of a row in the list.
+        If the model has variable row heights, use getRowPosition() to find the height
+        of a particular row.
         @see setRowHeight
     */
     int getRowHeight() const noexcept                   { return rowHeight; }
@@ -573,7 +591,11 @@ private:
     int lastRowSelected;
     bool multipleSelection, alwaysFlipSelection, hasDoneInitialUpdate;
     SparseSet<int> selected;
+    Array<int> rowTops; // if the model has variable row heights, the top of each row, plus the total height
 
+    void updateRowHeights();
+    int getRowY (int row) const noexcept;
+    int getRowAtY (int y) const noexcept;
     void selectRowInternal (int rowNumber, bool dontScrollToShowThisRow,
                             bool deselectOthersFirst, bool isMouseClick);
 
@@ -55,6 +55,8 @@ public:
         useDragEvents (false),
         scrollWheelEnabled (true),
         snapsToMousePos (true),
+        quantisesRepaints (false),
+        numFilmstripFrames (0),
         parentForPopupDisplay (nullptr)
     {
     }
@@ -118,6 +120,7 @@ public:
     {
         if (minimum != newMin || maximum != newMax || interval != newInt)
         {
+            lastVisualState = VisualState();
             minimum = newMin;
             maximum = newMax;
             interval = newInt;
@@ -191,7 +194,7 @@ public:
                 currentValue = newValue;
 
             updateText();
-            owner.repaint();
+            repaintForValueChange();
 
             if (popupDisplay != nullptr)
                 popupDisplay->updatePosition (owner.getTextFromValue (newValue));
@@ -228,7 +231,7 @@ public:
         {
             lastValueMin = newValue;
             valueMin = newValue;
-            owner.repaint();
+            repaintForValueChange();
 
             if (popupDisplay != nullptr)
                 popupDisplay->updatePosition (owner.getTextFromValue (newValue));
@@ -265,7 +268,7 @@ public:
         {
             lastValueMax = newValue;
             valueMax = newValue;
-            owner.repaint();
+            repaintForValueChange();
 
             if (popupDisplay != nullptr)
                 popupDisplay->updatePosition (owner.getTextFromValue (valueMax.getValue()));
@@ -292,7 +295,7 @@ public:
             lastValueMin = newMinValue;
             valueMin = newMinValue;
             valueMax = newMaxValue;
-            owner.repaint();
+            repaintForValueChange();
 
             triggerChangeMessage (notification);
         }
@@ -316,6 +319,138 @@ public:
         return valueMax.getValue();
     }
 
+    //==============================================================================
+    // The parts of the slider's appearance that depend on its values, quantised to the
+    // smallest steps that the user could actually see.
+    struct VisualState
+    {
+        VisualState() noexcept  : current (-0x7fffffff), min (0), max (0) {}
+
+        bool operator== (const VisualState& other) const noexcept
+        {
+            return current == other.current && min == other.min && max == other.max;
+        }
+
+        bool operator!= (const VisualState& other) const noexcept   { return ! operator== (other); }
+
+        int current, min, max;
+    };
+
+    int getVisualPosition (const double value) const
+    {
+        if (numFilmstripFrames > 0)
+        {
+            // (counted in half-frames, so that it changes whenever the frame index would,
+            // whether the LookAndFeel rounds or truncates it)
+            const double proportion = maximum > minimum ? owner.valueToProportionOfLength (jlimit (minimum, maximum, value))
+                                                        : 0.5;
+            return (int) std::floor (proportion * (numFilmstripFrames - 1) * 2.0);
+        }
+
+        if (isRotary())
+        {
+            // (the distance moved by the end of the pointer, in pixels)
+            const double proportion = owner.valueToProportionOfLength (value);
+            const float radius = jmin (sliderRect.getWidth(), sliderRect.getHeight()) * 0.5f;
+            return roundToInt (proportion * (rotaryEnd - rotaryStart) * radius);
+        }
+
+        return roundToInt (getLinearSliderPos (value));
+    }
+
+    VisualState getVisualState() const
+    {
+        VisualState state;
+
+        if (style == IncDecButtons)
+        {
+            // (the slider itself doesn't draw anything that depends on the value)
+            state.current = 0;
+        }
+        else if (style == TwoValueHorizontal || style == TwoValueVertical)
+        {
+            state.current = 0;
+            state.min = getVisualPosition (lastValueMin);
+            state.max = getVisualPosition (lastValueMax);
+        }
+        else
+        {
+            state.current = getVisualPosition (lastCurrentValue);
+
+            if (style == ThreeValueHorizontal || style == ThreeValueVertical)
+            {
+                state.min = getVisualPosition (lastValueMin);
+                state.max = getVisualPosition (lastValueMax);
+            }
+        }
+
+        return state;
+    }
+
+    // Returns true if a repaint of this component couldn't possibly change anything on
+    // screen, because it's hidden behind an opaque sibling, or clipped away by a parent.
+    static bool isObscured (const Component& c)
+    {
+        Rectangle<int> area (c.getLocalBounds());
+
+        for (const Component* comp = &c;;)
+        {
+            // (a cached image needs repainting even when it can't be seen, or it'll be stale
+            // when it's next drawn)
+            if (comp->getCachedComponentImage() != nullptr)
+                return false;
+
+            const Component* const parent = comp->getParentComponent();
+
+            if (parent == nullptr || ! comp->isVisible())
+                return false;
+
+            area = parent->getLocalArea (comp, area).getIntersection (parent->getLocalBounds());
+
+            if (area.isEmpty())
+                return true;
+
+            for (int i = parent->getIndexOfChildComponent (comp) + 1; i < parent->getNumChildComponents(); ++i)
+            {
+                const Component* const sibling = parent->getChildComponent (i);
+
+                if (sibling->isVisible() && sibling->isOpaque() && sibling->getAlpha() >= 1.0f
+                     && ! sibling->isTransformed() && sibling->getBounds().contains (area))
+                    return true;
+            }
+
+            comp = parent;
+        }
+    }
+
+    void repaintForValueChange()
+    {
+        if (quantisesRepaints)
+        {
+            // Because paint() always draws the latest values, there's no need for another
+            // repaint until the appearance has changed from the last one that was requested.
+            const VisualState newState (getVisualState());
+
+            if (newState == lastVisualState || isObscured (owner))
+                return;
+
+            lastVisualState = newState;
+        }
+        else if (isObscured (owner))
+        {
+            return;
+        }
+
+        owner.repaint();
+    }
+
+    void setRepaintQuantisation (const bool shouldQuantise, const int numFrames)
+    {
+        quantisesRepaints = shouldQuantise;
+        numFilmstripFrames = jmax (0, numFrames);
+        lastVisualState = VisualState();
+    }
+
     void triggerChangeMessage (const NotificationType notification)
     {
         if (notification != dontSendNotification)
@@ -471,6 +606,7 @@ public:
         rotaryStart = startAngleRadians;
         rotaryEnd = endAngleRadians;
         rotaryStop = stopAtEnd;
+        lastVisualState = VisualState();
     }
 
     void setVelocityModeParameters (const double sensitivity, const int threshold,
@@ -1089,6 +1225,9 @@ public:
     //==============================================================================
     void paint (Graphics& g, LookAndFeel& lf)
     {
+        if (quantisesRepaints)
+            lastVisualState = getVisualState();
+
         if (style != IncDecButtons)
         {
             if (isRotary())
@@ -1122,6 +1261,8 @@ public:
 
     void resized (const Rectangle<int>& localBounds, LookAndFeel& lf)
     {
+        lastVisualState = VisualState();
+
         int minXSpace = 0;
         int minYSpace = 0;
 
@@ -1278,6 +1419,9 @@ public:
     bool incDecDragged;
     bool scrollWheelEnabled;
     bool snapsToMousePos;
+    bool quantisesRepaints;
+    int numFilmstripFrames;
+    VisualState lastVisualState;
 
     ScopedPointer<Label> valueBox;
     ScopedPointer<Button> incButton, decButton;
@@ -1404,7 +1548,11 @@ void Slider::setVelocityModeParameters (const double sensitivity, const int thre
 }
 
 double Slider::getSkewFactor() const noexcept               { return pimpl->skewFactor; }
-void Slider::setSkewFactor (const double factor)            { pimpl->skewFactor = factor; }
+void Slider::setSkewFactor (const double factor)
+{
+    pimpl->skewFactor = factor;
+    pimpl->lastVisualState = Pimpl::VisualState();
+}
 
 void Slider::setSkewFactorFromMidPoint (const double sliderValueToShowAtMidPoint)
 {
@@ -1579,6 +1727,11 @@ void Slider::valueChanged() {}
 void Slider::setPopupMenuEnabled (const bool menuEnabled)   { pimpl->menuEnabled = menuEnabled; }
 void Slider::setScrollWheelEnabled (const bool enabled)     { pimpl->scrollWheelEnabled = enabled; }
 
+void Slider::setRepaintQuantisation (const bool shouldQuantise, const int numFilmstripFrames)
+{
+    pimpl->setRepaintQuantisation (shouldQuantise, numFilmstripFrames);
+}
+
 bool Slider::isHorizontal() const noexcept                  { return pimpl->isHorizontal(); }
 bool Slider::isVertical() const noexcept                    { return pimpl->isVertical(); }
 bool Slider::isRotary() const noexcept                      { return pimpl->isRotary(); }
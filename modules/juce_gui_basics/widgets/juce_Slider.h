@@ -623,6 +623,26 @@ public:
     */
     void setScrollWheelEnabled (bool enabled);
 
+    /** Stops the slider repainting itself when its value changes by too little to make
+        any visible difference.
+
+        By default, every change of value causes a repaint, which can add up to a lot of
+        wasted drawing when many sliders are being automated at once. When this is turned
+        on, a value change only causes a repaint if it moves the thumb of a linear slider
+        (or the tip of a rotary slider's pointer) by at least a pixel.
+
+        If numFilmstripFrames is greater than zero, the slider is assumed to be drawn as one
+        of that many images (e.g. the frames of a filmstrip knob), and only repaints when
+        the frame that would be shown has changed.
+
+        Only turn this on if your LookAndFeel doesn't draw anything else that depends on the
+        value, such as the value as text, because that won't be updated for small changes.
+
+        Regardless of this setting, a value change never causes a repaint while the slider
+        is completely covered by an opaque sibling, or scrolled out of sight.
+    */
+    void setRepaintQuantisation (bool shouldQuantise, int numFilmstripFrames = 0);
+
     /** Returns a number to indicate which thumb is currently being dragged by the mouse.
 
         This will return 0 for the main thumb, 1 for the minimum-value thumb, 2 for
@@ -405,6 +405,16 @@ void TableListBox::listWasScrolled()
         model->listWasScrolled();
 }
 
+bool TableListBox::hasVariableRowHeights()
+{
+    return model != nullptr && model->hasVariableRowHeights();
+}
+
+int TableListBox::getHeightForRow (int row)
+{
+    return model != nullptr ? model->getHeightForRow (row) : -1;
+}
+
 void TableListBox::tableColumnsChanged (TableHeaderComponent*)
 {
     setMinimumContentWidth (header->getTotalWidth());
@@ -459,6 +469,8 @@ void TableListBoxModel::selectedRowsChanged (int)                       {}
 void TableListBoxModel::deleteKeyPressed (int)                          {}
 void TableListBoxModel::returnKeyPressed (int)                          {}
 void TableListBoxModel::listWasScrolled()                               {}
+bool TableListBoxModel::hasVariableRowHeights()                         { return false; }
+int TableListBoxModel::getHeightForRow (int)                            { return -1; }
 
 String TableListBoxModel::getCellTooltip (int /*rowNumber*/, int /*columnId*/)    { return String(); }
 var TableListBoxModel::getDragSourceDescription (const SparseSet<int>&)           { return var(); }
@@ -182,6 +182,16 @@ public:
     */
     virtual var getDragSourceDescription (const SparseSet<int>& currentlySelectedRows);
 
+    /** Override this to return true if the rows in your table aren't all the same height.
+        @see ListBoxModel::hasVariableRowHeights
+    */
+    virtual bool hasVariableRowHeights();
+
+    /** If hasVariableRowHeights() returns true, this must return the height of a row.
+        @see ListBoxModel::getHeightForRow
+    */
+    virtual int getHeightForRow (int rowNumber);
+
 private:
    #if JUCE_CATCH_DEPRECATED_CODE_MISUSE
     // This method's signature has changed to take a MouseEvent parameter - please update your code!
@@ -316,6 +326,10 @@ public:
     /** @internal */
     void listWasScrolled() override;
     /** @internal */
+    bool hasVariableRowHeights() override;
+    /** @internal */
+    int getHeightForRow (int rowNumber) override;
+    /** @internal */
     void tableColumnsChanged (TableHeaderComponent*) override;
     /** @internal */
     void tableColumnsResized (TableHeaderComponent*) override;
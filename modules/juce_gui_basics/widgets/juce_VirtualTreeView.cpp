@@ -0,0 +1,593 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+bool VirtualTreeViewModel::mightHaveChildren (int64 nodeID)                 { return getNumChildren (nodeID) > 0; }
+void VirtualTreeViewModel::nodeClicked (int64, const MouseEvent&)           {}
+void VirtualTreeViewModel::nodeDoubleClicked (int64, const MouseEvent&)     {}
+void VirtualTreeViewModel::nodeOpennessChanged (int64, bool)                {}
+void VirtualTreeViewModel::selectedRowsChanged (int)                        {}
+String VirtualTreeViewModel::getTooltipForNode (int64)                      { return String::empty; }
+
+//==============================================================================
+// A node which has been opened at some point. Its weights are a Fenwick tree in which
+// each child's weight is the number of rows it takes up: 1 for the child itself, plus
+// the rows inside it if it's an open node.
+struct VirtualTreeView::Node
+{
+    Node (const int64 nodeID, Node* const parentNode, const int index, const int numKids)
+        : id (nodeID), parent (parentNode), indexInParent (index),
+          numChildren (jmax (0, numKids)), totalRows (0), isOpen (false)
+    {
+        initialiseWeights();
+    }
+
+    int getVisibleRows() const noexcept     { return isOpen ? totalRows : 0; }
+
+    // Rebuilds the weights from scratch, which takes linear time rather than the
+    // n log n it would take to add each child's rows separately.
+    void initialiseWeights()
+    {
+        weights.malloc ((size_t) numChildren + 1);
+        weights[0] = 0;
+
+        for (int i = 1; i <= numChildren; ++i)
+            weights[i] = 1;
+
+        for (int i = children.size(); --i >= 0;)
+        {
+            const Node& child = *children.getUnchecked (i);
+            weights[child.indexInParent + 1] += child.getVisibleRows();
+        }
+
+        totalRows = 0;
+
+        for (int i = 1; i <= numChildren; ++i)
+            totalRows += weights[i];
+
+        for (int i = 1; i <= numChildren; ++i)
+        {
+            const int next = i + (i & -i);
+
+            if (next <= numChildren)
+                weights[next] += weights[i];
+        }
+    }
+
+    void addToWeight (const int childIndex, const int delta) noexcept
+    {
+        for (int i = childIndex + 1; i <= numChildren; i += (i & -i))
+            weights[i] += delta;
+
+        totalRows += delta;
+    }
+
+    int getRowsBefore (const int childIndex) const noexcept
+    {
+        int sum = 0;
+
+        for (int i = childIndex; i > 0; i -= (i & -i))
+            sum += weights[i];
+
+        return sum;
+    }
+
+    // Returns the child whose rows include the given row (counted from the row
+    // after this node), and the number of rows that come before that child.
+    int findChildContainingRow (const int row, int& rowsBefore) const noexcept
+    {
+        int step = 1;
+
+        while (step * 2 <= numChildren)
+            step *= 2;
+
+        int index = 0, sum = 0;
+
+        for (; step > 0; step >>= 1)
+        {
+            if (index + step <= numChildren && sum + weights[index + step] <= row)
+            {
+                index += step;
+                sum += weights[index];
+            }
+        }
+
+        rowsBefore = sum;
+        return index;
+    }
+
+    // Returns the position in the children array at which a node for this child is (or would be).
+    int findChildPosition (const int childIndex) const noexcept
+    {
+        int start = 0, end = children.size();
+
+        while (start < end)
+        {
+            const int mid = (start + end) / 2;
+
+            if (children.getUnchecked (mid)->indexInParent < childIndex)
+                start = mid + 1;
+            else
+                end = mid;
+        }
+
+        return start;
+    }
+
+    Node* findChildNode (const int childIndex) const noexcept
+    {
+        Node* const n = children [findChildPosition (childIndex)];
+        return (n != nullptr && n->indexInParent == childIndex) ? n : nullptr;
+    }
+
+    // Passes a change in the number of rows that this node shows up to its parents.
+    void visibleRowsChanged (int delta) noexcept
+    {
+        for (Node* n = this; delta != 0 && n->parent != nullptr; n = n->parent)
+        {
+            n->parent->addToWeight (n->indexInParent, delta);
+
+            if (! n->parent->isOpen)
+                break;
+        }
+    }
+
+    void collectOpenNodes (SortedSet<int64>& openNodes) const
+    {
+        for (int i = 0; i < children.size(); ++i)
+        {
+            const Node& child = *children.getUnchecked (i);
+
+            if (child.isOpen)
+            {
+                openNodes.add (child.id);
+                child.collectOpenNodes (openNodes);
+            }
+        }
+    }
+
+    const int64 id;
+    Node* const parent;
+    const int indexInParent, numChildren;
+    int totalRows;
+    bool isOpen;
+    HeapBlock<int> weights;
+    OwnedArray<Node> children;
+
+    JUCE_DECLARE_NON_COPYABLE (Node)
+};
+
+//==============================================================================
+VirtualTreeView::VirtualTreeView (const String& name, VirtualTreeViewModel* const m)
+    : Component (name), model (nullptr), indentSize (24)
+{
+    setModel (m);
+    listBox.setModel (this);
+    addAndMakeVisible (listBox);
+}
+
+VirtualTreeView::~VirtualTreeView()
+{
+}
+
+void VirtualTreeView::setModel (VirtualTreeViewModel* const newModel)
+{
+    model = newModel;
+    rootNode = new Node (0, nullptr, 0, model != nullptr ? model->getNumChildren (0) : 0);
+    rootNode->isOpen = true;
+
+    listBox.deselectAllRows();
+    listBox.updateContent();
+    listBox.repaint();
+}
+
+void VirtualTreeView::refresh()
+{
+    SortedSet<int64> openNodes;
+    rootNode->collectOpenNodes (openNodes);
+
+    rootNode = new Node (0, nullptr, 0, model != nullptr ? model->getNumChildren (0) : 0);
+    rootNode->isOpen = true;
+
+    if (model != nullptr)
+        reopenRecursively (*rootNode, openNodes);
+
+    listBox.deselectAllRows();
+    listBox.updateContent();
+    listBox.repaint();
+}
+
+void VirtualTreeView::reopenRecursively (Node& node, const SortedSet<int64>& openNodes)
+{
+    for (int i = 0; i < node.numChildren; ++i)
+    {
+        const int64 childID = model->getChildID (node.id, i);
+
+        if (openNodes.contains (childID))
+        {
+            Node* const child = new Node (childID, &node, i, model->getNumChildren (childID));
+            child->isOpen = true;
+            node.children.add (child);
+            reopenRecursively (*child, openNodes);
+        }
+    }
+
+    node.initialiseWeights();
+}
+
+//==============================================================================
+int VirtualTreeView::getNumRowsInTree() const noexcept
+{
+    return rootNode->totalRows;
+}
+
+bool VirtualTreeView::findRow (int row, Node*& parent, int& childIndex, int& depth) const
+{
+    if (! isPositiveAndBelow (row, rootNode->totalRows))
+        return false;
+
+    Node* node = rootNode;
+    depth = 0;
+
+    for (;;)
+    {
+        int rowsBefore;
+        const int index = node->findChildContainingRow (row, rowsBefore);
+        jassert (index < node->numChildren);
+
+        row -= rowsBefore;
+
+        if (row == 0)
+        {
+            parent = node;
+            childIndex = index;
+            return true;
+        }
+
+        node = node->findChildNode (index);
+        jassert (node != nullptr && node->isOpen);
+
+        --row;
+        ++depth;
+    }
+}
+
+int64 VirtualTreeView::getNodeOnRow (const int row) const
+{
+    Node* parent;
+    int index, depth;
+
+    if (model != nullptr && findRow (row, parent, index, depth))
+        return model->getChildID (parent->id, index);
+
+    return 0;
+}
+
+int VirtualTreeView::getDepthOfRow (const int row) const
+{
+    Node* parent;
+    int index, depth;
+    return findRow (row, parent, index, depth) ? depth : -1;
+}
+
+bool VirtualTreeView::isRowOpen (const int row) const
+{
+    Node* parent;
+    int index, depth;
+
+    if (findRow (row, parent, index, depth))
+        if (const Node* const node = parent->findChildNode (index))
+            return node->isOpen;
+
+    return false;
+}
+
+VirtualTreeView::Node* VirtualTreeView::getOrCreateChildNode (Node& parent, const int childIndex)
+{
+    const int pos = parent.findChildPosition (childIndex);
+
+    if (Node* const existing = parent.children [pos])
+        if (existing->indexInParent == childIndex)
+            return existing;
+
+    const int64 childID = model->getChildID (parent.id, childIndex);
+    return parent.children.insert (pos, new Node (childID, &parent, childIndex, model->getNumChildren (childID)));
+}
+
+void VirtualTreeView::setRowOpen (const int row, const bool shouldBeOpen)
+{
+    Node* parent;
+    int index, depth;
+
+    if (model == nullptr || ! findRow (row, parent, index, depth))
+        return;
+
+    Node* const node = shouldBeOpen ? getOrCreateChildNode (*parent, index)
+                                    : parent->findChildNode (index);
+
+    if (node == nullptr || node->isOpen == shouldBeOpen)
+        return;
+
+    node->isOpen = shouldBeOpen;
+
+    const int rowsAdded = shouldBeOpen ? node->totalRows : -node->totalRows;
+    node->visibleRowsChanged (rowsAdded);
+    updateAfterRowCountChange (row, rowsAdded);
+
+    model->nodeOpennessChanged (node->id, shouldBeOpen);
+}
+
+void VirtualTreeView::openAll()
+{
+    if (model != nullptr)
+    {
+        openAllRecursively (*rootNode);
+
+        listBox.deselectAllRows();
+        listBox.updateContent();
+        listBox.repaint();
+    }
+}
+
+void VirtualTreeView::openAllRecursively (Node& node)
+{
+    // (this builds each node's weights after its children have been filled in, rather than
+    // updating every parent as each child gets opened)
+    for (int i = 0; i < node.numChildren; ++i)
+    {
+        Node* child = node.findChildNode (i);
+
+        if (child == nullptr)
+        {
+            const int64 childID = model->getChildID (node.id, i);
+
+            if (! model->mightHaveChildren (childID))
+                continue;
+
+            child = getOrCreateChildNode (node, i);
+        }
+
+        child->isOpen = true;
+        openAllRecursively (*child);
+    }
+
+    node.initialiseWeights();
+}
+
+void VirtualTreeView::closeAll()
+{
+    rootNode->children.clear();
+    rootNode->initialiseWeights();
+
+    listBox.deselectAllRows();
+    listBox.updateContent();
+    listBox.repaint();
+}
+
+void VirtualTreeView::updateAfterRowCountChange (const int changedRow, const int rowsAdded)
+{
+    // Moves the selection so that the same rows stay selected, and deselects any rows that
+    // have been hidden by closing a node.
+    const SparseSet<int> oldSelection (listBox.getSelectedRows());
+    SparseSet<int> newSelection;
+
+    const int firstMovedRow = changedRow + 1 + jmax (0, -rowsAdded);
+
+    for (int i = 0; i < oldSelection.getNumRanges(); ++i)
+    {
+        const Range<int> r (oldSelection.getRange (i));
+
+        const Range<int> before (r.getStart(), jmin (r.getEnd(), changedRow + 1));
+        const Range<int> after (jmax (r.getStart(), firstMovedRow), r.getEnd());
+
+        if (! before.isEmpty())
+            newSelection.addRange (before);
+
+        if (! after.isEmpty())
+            newSelection.addRange (after + rowsAdded);
+    }
+
+    listBox.setSelectedRows (SparseSet<int>(), dontSendNotification);
+    listBox.updateContent();
+    listBox.setSelectedRows (newSelection, newSelection.size() != oldSelection.size() ? sendNotification
+                                                                                      : dontSendNotification);
+    listBox.repaint();
+}
+
+//==============================================================================
+void VirtualTreeView::setRowHeight (const int newHeight)
+{
+    listBox.setRowHeight (newHeight);
+}
+
+int VirtualTreeView::getRowHeight() const noexcept
+{
+    return listBox.getRowHeight();
+}
+
+void VirtualTreeView::setIndentSize (const int newIndentSize)
+{
+    if (indentSize != newIndentSize)
+    {
+        indentSize = newIndentSize;
+        listBox.repaint();
+    }
+}
+
+void VirtualTreeView::setMultipleSelectionEnabled (const bool shouldBeEnabled) noexcept
+{
+    listBox.setMultipleSelectionEnabled (shouldBeEnabled);
+}
+
+void VirtualTreeView::selectRow (const int row)                      { listBox.selectRow (row); }
+void VirtualTreeView::deselectAllRows()                              { listBox.deselectAllRows(); }
+SparseSet<int> VirtualTreeView::getSelectedRows() const              { return listBox.getSelectedRows(); }
+int VirtualTreeView::getNumSelectedRows() const                      { return listBox.getNumSelectedRows(); }
+int VirtualTreeView::getSelectedRow (const int index) const          { return listBox.getSelectedRow (index); }
+void VirtualTreeView::scrollToEnsureRowIsOnscreen (const int row)    { listBox.scrollToEnsureRowIsOnscreen (row); }
+
+//==============================================================================
+void VirtualTreeView::resized()
+{
+    listBox.setBounds (getLocalBounds());
+}
+
+bool VirtualTreeView::keyPressed (const KeyPress& key)
+{
+    const int row = listBox.getLastRowSelected();
+
+    if (row >= 0)
+    {
+        if (key == KeyPress::leftKey)
+        {
+            if (isRowOpen (row))
+            {
+                setRowOpen (row, false);
+            }
+            else
+            {
+                // move up to the parent node
+                const int depth = getDepthOfRow (row);
+                int parentRow = row;
+
+                while (--parentRow >= 0 && getDepthOfRow (parentRow) >= depth)
+                {}
+
+                if (parentRow >= 0)
+                    listBox.selectRow (parentRow);
+            }
+
+            return true;
+        }
+
+        if (key == KeyPress::rightKey)
+        {
+            if (! isRowOpen (row))
+                setRowOpen (row, true);
+            else if (getDepthOfRow (row + 1) > getDepthOfRow (row))
+                listBox.selectRow (row + 1);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//==============================================================================
+int VirtualTreeView::getNumRows()
+{
+    return getNumRowsInTree();
+}
+
+void VirtualTreeView::paintListBoxItem (const int row, Graphics& g, const int width, const int height, const bool isSelected)
+{
+    Node* parent;
+    int index, depth;
+
+    if (model == nullptr || ! findRow (row, parent, index, depth))
+        return;
+
+    const int64 nodeID = model->getChildID (parent->id, index);
+
+    if (isSelected)
+        g.fillAll (findColour (TreeView::selectedItemBackgroundColourId));
+
+    const int buttonX = depth * indentSize;
+
+    if (model->mightHaveChildren (nodeID))
+    {
+        const Node* const node = parent->findChildNode (index);
+
+        getLookAndFeel().drawTreeviewPlusMinusBox (g, Rectangle<float> ((float) buttonX, 0.0f, (float) indentSize, (float) height),
+                                                   listBox.findColour (ListBox::backgroundColourId),
+                                                   node != nullptr && node->isOpen, false);
+    }
+
+    const int nodeX = buttonX + indentSize;
+
+    if (width > nodeX)
+    {
+        g.reduceClipRegion (nodeX, 0, width - nodeX, height);
+        g.setOrigin (nodeX, 0);
+        model->paintNode (nodeID, g, width - nodeX, height, isSelected);
+    }
+}
+
+void VirtualTreeView::listBoxItemClicked (const int row, const MouseEvent& e)
+{
+    if (model == nullptr)
+        return;
+
+    const int depth = getDepthOfRow (row);
+    const int buttonX = depth * indentSize;
+
+    if (depth < 0 || e.x < buttonX)
+        return;
+
+    const int64 nodeID = getNodeOnRow (row);
+
+    if (e.x < buttonX + indentSize)
+    {
+        if (model->mightHaveChildren (nodeID))
+            setRowOpen (row, ! isRowOpen (row));
+    }
+    else
+    {
+        model->nodeClicked (nodeID, e.withNewPosition (e.position - Point<float> ((float) (buttonX + indentSize), 0.0f)));
+    }
+}
+
+void VirtualTreeView::listBoxItemDoubleClicked (const int row, const MouseEvent& e)
+{
+    if (model == nullptr)
+        return;
+
+    const int depth = getDepthOfRow (row);
+    const int nodeX = (depth + 1) * indentSize;
+
+    if (depth >= 0 && e.x >= nodeX)
+    {
+        const int64 nodeID = getNodeOnRow (row);
+
+        if (model->mightHaveChildren (nodeID))
+            setRowOpen (row, ! isRowOpen (row));
+
+        model->nodeDoubleClicked (nodeID, e.withNewPosition (e.position - Point<float> ((float) nodeX, 0.0f)));
+    }
+}
+
+void VirtualTreeView::selectedRowsChanged (const int lastRowSelected)
+{
+    if (model != nullptr)
+        model->selectedRowsChanged (lastRowSelected);
+}
+
+String VirtualTreeView::getTooltipForRow (const int row)
+{
+    if (model != nullptr && isPositiveAndBelow (row, getNumRowsInTree()))
+        return model->getTooltipForNode (getNodeOnRow (row));
+
+    return String::empty;
+}
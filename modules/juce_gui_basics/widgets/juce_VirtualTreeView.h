@@ -0,0 +1,251 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_VIRTUALTREEVIEW_H_INCLUDED
+#define JUCE_VIRTUALTREEVIEW_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A subclass of this is used to supply the contents of a VirtualTreeView.
+
+    Each node of the tree is identified by a 64-bit ID which the model chooses. The
+    top-level nodes are the children of a root node with an ID of 0, which isn't
+    shown. The view only asks about nodes that are scrolled into view or are being
+    opened, so the model doesn't need to create any objects for the rest of the tree.
+
+    @see VirtualTreeView
+*/
+class JUCE_API  VirtualTreeViewModel
+{
+public:
+    //==============================================================================
+    /** Destructor. */
+    virtual ~VirtualTreeViewModel()  {}
+
+    //==============================================================================
+    /** Must return the number of children that a node has.
+        This is called when the node is opened, and when the view is refreshed.
+    */
+    virtual int getNumChildren (int64 parentNodeID) = 0;
+
+    /** Must return the ID of one of a node's children. */
+    virtual int64 getChildID (int64 parentNodeID, int childIndex) = 0;
+
+    /** Tells the view whether a node should be drawn with an open/close button.
+        This is called for every row that gets drawn, so if counting a node's children
+        is slow, you should override it with something quicker. By default it
+        returns true if getNumChildren() is greater than zero.
+    */
+    virtual bool mightHaveChildren (int64 nodeID);
+
+    /** Must draw the contents of a row.
+        The graphics context's origin is at the right of the open/close button, and
+        width is the space that's left for the node after it has been indented.
+    */
+    virtual void paintNode (int64 nodeID, Graphics& g, int width, int height, bool isSelected) = 0;
+
+    /** Called when the user clicks on a node. */
+    virtual void nodeClicked (int64 nodeID, const MouseEvent&);
+
+    /** Called when the user double-clicks on a node.
+        The view has already opened or closed the node by the time this is called.
+    */
+    virtual void nodeDoubleClicked (int64 nodeID, const MouseEvent&);
+
+    /** Called when a node is opened or closed. */
+    virtual void nodeOpennessChanged (int64 nodeID, bool isNowOpen);
+
+    /** Called when the selection changes.
+        @see VirtualTreeView::getSelectedRows
+    */
+    virtual void selectedRowsChanged (int lastRowSelected);
+
+    /** Can return a tooltip for a node. */
+    virtual String getTooltipForNode (int64 nodeID);
+};
+
+
+//==============================================================================
+/**
+    A tree view which can show very large trees.
+
+    TreeView needs a TreeViewItem object for every item that's been added to it, and
+    it walks the whole open tree whenever it needs to find the item on a row. This class
+    instead asks a VirtualTreeViewModel for the nodes that it needs as they're scrolled into
+    view, and draws them using a ListBox, whose row components are recycled as the list
+    scrolls.
+
+    The only per-node storage is for nodes which have been opened. Each of these keeps a
+    Fenwick tree of the number of rows shown by each of its children, so finding the node
+    on a row, and updating the row count when a node is opened or closed, both take a time
+    proportional to the depth of the tree multiplied by the log of the number of children,
+    rather than to the total number of rows.
+
+    Because the view works in terms of rows, the selection is a set of row numbers. Rows
+    are shifted when nodes are opened and closed, so the same nodes stay selected.
+
+    @see VirtualTreeViewModel, TreeView, ListBox
+*/
+class JUCE_API  VirtualTreeView  : public Component,
+                                   private ListBoxModel
+{
+public:
+    //==============================================================================
+    /** Creates a tree view.
+        The model pointer isn't deleted by the view, and can be null.
+    */
+    VirtualTreeView (const String& componentName = String::empty,
+                     VirtualTreeViewModel* model = nullptr);
+
+    /** Destructor. */
+    ~VirtualTreeView();
+
+    //==============================================================================
+    /** Changes the model that the tree uses.
+        This closes all the nodes and clears the selection.
+    */
+    void setModel (VirtualTreeViewModel* newModel);
+
+    /** Returns the current model. */
+    VirtualTreeViewModel* getModel() const noexcept             { return model; }
+
+    /** Re-reads the structure of the tree from the model.
+
+        Call this when nodes have been added or removed. Any nodes which were open and
+        whose IDs are still children of open nodes will be re-opened. This needs to look
+        at every child of every open node, so avoid calling it more than you need to.
+        The selection is cleared.
+    */
+    void refresh();
+
+    //==============================================================================
+    /** Returns the number of rows that the tree currently shows. */
+    int getNumRowsInTree() const noexcept;
+
+    /** Returns the ID of the node on a row, or 0 if the row number is out of range. */
+    int64 getNodeOnRow (int row) const;
+
+    /** Returns how many levels below the top of the tree the node on a row is.
+        The top-level nodes have a depth of 0. Returns -1 if the row is out of range.
+    */
+    int getDepthOfRow (int row) const;
+
+    /** Returns true if the node on a row is open. */
+    bool isRowOpen (int row) const;
+
+    /** Opens or closes the node on a row.
+        Nodes inside a closed node remember whether they were open.
+    */
+    void setRowOpen (int row, bool shouldBeOpen);
+
+    /** Opens every node in the tree.
+        This has to visit every node, asking the model about its children, so it'll be slow
+        for a very big model - but it takes a time proportional to the number of nodes, rather
+        than the number of nodes multiplied by the number of rows. The selection is cleared,
+        and nodeOpennessChanged() isn't called for the nodes that get opened.
+    */
+    void openAll();
+
+    /** Closes every node in the tree, and clears the selection.
+        Unlike setRowOpen(), this doesn't call nodeOpennessChanged(), and the nodes inside
+        don't remember whether they were open.
+    */
+    void closeAll();
+
+    //==============================================================================
+    /** Changes the height of the rows. */
+    void setRowHeight (int newHeight);
+
+    /** Returns the height of the rows. */
+    int getRowHeight() const noexcept;
+
+    /** Changes the distance by which each level of the tree is indented. */
+    void setIndentSize (int newIndentSize);
+
+    /** Returns the distance by which each level of the tree is indented. */
+    int getIndentSize() const noexcept                          { return indentSize; }
+
+    //==============================================================================
+    /** Allows more than one row to be selected. */
+    void setMultipleSelectionEnabled (bool shouldBeEnabled) noexcept;
+
+    /** Selects a row, deselecting any others. */
+    void selectRow (int row);
+
+    /** Deselects all the rows. */
+    void deselectAllRows();
+
+    /** Returns the selected rows. */
+    SparseSet<int> getSelectedRows() const;
+
+    /** Returns the number of selected rows. */
+    int getNumSelectedRows() const;
+
+    /** Returns the row number of one of the selected rows, or -1 if the index is out of range. */
+    int getSelectedRow (int index = 0) const;
+
+    /** Scrolls so that a row is visible. */
+    void scrollToEnsureRowIsOnscreen (int row);
+
+    /** Returns the ListBox that draws the rows.
+        You can use this to change its colours and scrollbars, but don't give it a different model.
+    */
+    ListBox& getListBox() noexcept                              { return listBox; }
+
+    //==============================================================================
+    /** @internal */
+    void resized() override;
+    /** @internal */
+    bool keyPressed (const KeyPress&) override;
+
+private:
+    //==============================================================================
+    struct Node;
+    friend struct ContainerDeletePolicy<Node>;
+
+    ListBox listBox;
+    VirtualTreeViewModel* model;
+    ScopedPointer<Node> rootNode;
+    int indentSize;
+
+    bool findRow (int row, Node*& parent, int& childIndex, int& depth) const;
+    Node* getOrCreateChildNode (Node& parent, int childIndex);
+    void openAllRecursively (Node&);
+    void reopenRecursively (Node&, const SortedSet<int64>& openNodes);
+    void updateAfterRowCountChange (int changedRow, int rowsAdded);
+
+    int getNumRows() override;
+    void paintListBoxItem (int, Graphics&, int, int, bool) override;
+    void listBoxItemClicked (int, const MouseEvent&) override;
+    void listBoxItemDoubleClicked (int, const MouseEvent&) override;
+    void selectedRowsChanged (int) override;
+    String getTooltipForRow (int) override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VirtualTreeView)
+};
+
+
+#endif   // JUCE_VIRTUALTREEVIEW_H_INCLUDED
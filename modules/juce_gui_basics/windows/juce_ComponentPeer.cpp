@@ -31,8 +31,13 @@ ComponentPeer::ComponentPeer (Component& comp, const int flags)
       constrainer (nullptr),
       lastDragAndDropCompUnderMouse (nullptr),
       uniqueID (lastUniquePeerID += 2), // increment by 2 so that this can never hit 0
-      isWindowMinimised (false)
+      isWindowMinimised (false),
+      numRepaintRequests (0),
+      requestedRepaintArea (0)
 {
+    lastRepaintStats.paintTimeMs = 0;
+    lastRepaintStats.numRepaintRequests = 0;
+    lastRepaintStats.requestedPixels = 0;
     Desktop::getInstance().peers.add (this);
 }
 
@@ -103,11 +108,101 @@ void ComponentPeer::handleMagnifyGesture (int touchIndex, Point<float> pos, int6
         MouseInputSource (*mouse).handleMagnifyGesture (*this, pos, time, scaleFactor);
 }
 
+//==============================================================================
+struct ComponentPeer::PaintProfile
+{
+    PaintProfile (bool heatMap)  : showHeatMap (heatMap) {}
+
+    void startFrame()
+    {
+        current.clearQuick();
+        areas.clearQuick();
+        indexes.clear();
+    }
+
+    void add (Component& peerComp, Component& c, const Rectangle<int>& area, double timeMs, bool isPaintCall)
+    {
+        const int64 key = (int64) (pointer_sized_int) &c;
+        int index = indexes [key] - 1;
+
+        if (index < 0)
+        {
+            ComponentPaintStats s;
+            s.component = &c;
+            s.numPaints = 0;
+            s.paintTimeMs = 0;
+            s.paintedPixels = 0;
+
+            index = current.size();
+            current.add (s);
+            areas.add (Rectangle<int>());
+            indexes.set (key, index + 1);
+        }
+
+        ComponentPaintStats& s = current.getReference (index);
+        s.paintTimeMs += timeMs;
+
+        if (isPaintCall)
+        {
+            ++s.numPaints;
+            s.paintedPixels += (int64) area.getWidth() * area.getHeight();
+
+            if (showHeatMap)
+                areas.getReference (index) = areas.getReference (index).getUnion (peerComp.getLocalArea (&c, area));
+        }
+    }
+
+    void endFrame (Graphics& g)
+    {
+        if (showHeatMap && current.size() > 0)
+        {
+            double maxTime = 0.001;
+
+            for (int i = 0; i < current.size(); ++i)
+                maxTime = jmax (maxTime, current.getReference (i).paintTimeMs);
+
+            for (int i = 0; i < current.size(); ++i)
+            {
+                g.setColour (Colours::red.withAlpha ((float) (0.08 + 0.5 * current.getReference (i).paintTimeMs / maxTime)));
+                g.fillRect (areas.getReference (i));
+            }
+        }
+
+        std::sort (current.begin(), current.end(), isSlower);
+        last.swapWith (current);
+    }
+
+    static bool isSlower (const ComponentPaintStats& a, const ComponentPaintStats& b) noexcept
+    {
+        return a.paintTimeMs > b.paintTimeMs;
+    }
+
+    Array<ComponentPaintStats> current, last;
+    Array<Rectangle<int> > areas;
+    HashMap<int64, int> indexes;
+    const bool showHeatMap;
+
+    JUCE_DECLARE_NON_COPYABLE (PaintProfile)
+};
+
 //==============================================================================
 void ComponentPeer::handlePaint (LowLevelGraphicsContext& contextToPaintTo)
 {
+    JUCE_TRACE_ZONE ("gui", "ComponentPeer::handlePaint");
+
     ModifierKeys::updateCurrentModifiers();
 
+    const double startTime = Time::getMillisecondCounterHiRes();
+    const Rectangle<int> paintedArea (contextToPaintTo.getClipBounds());
+
+    ComponentPeer* const previousPeerBeingProfiled = peerBeingProfiled;
+
+    if (paintProfile != nullptr)
+    {
+        paintProfile->startFrame();
+        peerBeingProfiled = this;
+    }
+
     Graphics g (contextToPaintTo);
 
     if (component.isTransformed())
@@ -135,6 +230,11 @@ void ComponentPeer::handlePaint (LowLevelGraphicsContext& contextToPaintTo)
     }
     JUCE_CATCH_EXCEPTION
 
+    peerBeingProfiled = previousPeerBeingProfiled;
+
+    if (paintProfile != nullptr)
+        paintProfile->endFrame (g);
+
   #if JUCE_ENABLE_REPAINT_DEBUGGING
    #ifdef JUCE_IS_REPAINT_DEBUGGING_ACTIVE
     if (JUCE_IS_REPAINT_DEBUGGING_ACTIVE)
@@ -158,6 +258,226 @@ void ComponentPeer::handlePaint (LowLevelGraphicsContext& contextToPaintTo)
         mess up a lot of the calculations that the library needs to do.
     */
     jassert (roundToInt (10.1f) == 10);
+
+    lastRepaintStats.paintedArea = paintedArea;
+    lastRepaintStats.paintTimeMs = Time::getMillisecondCounterHiRes() - startTime;
+    lastRepaintStats.numRepaintRequests = numRepaintRequests;
+    lastRepaintStats.requestedPixels = requestedRepaintArea;
+    numRepaintRequests = 0;
+    requestedRepaintArea = 0;
+
+    JUCE_TRACE_COUNTER ("gui", "repaint requests", lastRepaintStats.numRepaintRequests);
+    JUCE_TRACE_COUNTER ("gui", "repainted pixels", (int64) paintedArea.getWidth() * paintedArea.getHeight());
+}
+
+//==============================================================================
+ComponentPeer* ComponentPeer::peerBeingProfiled = nullptr;
+
+void ComponentPeer::setPaintProfilingEnabled (const bool shouldProfile, const bool showHeatMap)
+{
+    paintProfile = shouldProfile ? new PaintProfile (showHeatMap) : nullptr;
+    component.repaint();
+}
+
+bool ComponentPeer::isPaintProfilingEnabled() const noexcept
+{
+    return paintProfile != nullptr;
+}
+
+const Array<ComponentPeer::ComponentPaintStats>& ComponentPeer::getLastPaintProfile() const noexcept
+{
+    static const Array<ComponentPaintStats> empty;
+    return paintProfile != nullptr ? paintProfile->last : empty;
+}
+
+void ComponentPeer::addToPaintProfile (Component& c, const Rectangle<int>& area, double timeMs, bool isPaintCall)
+{
+    if (paintProfile != nullptr)
+        paintProfile->add (component, c, area, timeMs, isPaintCall);
+}
+
+//==============================================================================
+class ComponentPeer::QueuedRepaints  : private FrameListener
+{
+public:
+    QueuedRepaints (ComponentPeer& p)  : peer (p), isListening (false) {}
+
+    ~QueuedRepaints()
+    {
+        stopListening();
+    }
+
+    void add (const Rectangle<int>& area)
+    {
+        addToRepaintRegion (region, area);
+
+        if (! isListening)
+        {
+            Desktop::getInstance().addFrameListener (this);
+            isListening = true;
+        }
+    }
+
+    void flush()
+    {
+        RectangleList<int> areas;
+        areas.swapWith (region);
+
+        for (const Rectangle<int>* i = areas.begin(), * const e = areas.end(); i != e; ++i)
+            peer.repaint (*i);
+    }
+
+private:
+    ComponentPeer& peer;
+    RectangleList<int> region;
+    bool isListening;
+
+    void frameCallback (double) override
+    {
+        // (staying registered while repaints keep arriving avoids restarting the frame clock every frame)
+        if (region.isEmpty())
+            stopListening();
+        else
+            flush();
+    }
+
+    void stopListening()
+    {
+        if (isListening)
+        {
+            Desktop::getInstance().removeFrameListener (this);
+            isListening = false;
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (QueuedRepaints)
+};
+
+void ComponentPeer::queueRepaint (const Rectangle<int>& area)
+{
+    ++numRepaintRequests;
+    requestedRepaintArea += (int64) area.getWidth() * area.getHeight();
+
+    if (Desktop::getInstance().isRepaintBatchingEnabled())
+    {
+        if (queuedRepaints == nullptr)
+            queuedRepaints = new QueuedRepaints (*this);
+
+        queuedRepaints->add (area);
+    }
+    else
+    {
+        repaint (area);
+    }
+}
+
+void ComponentPeer::flushQueuedRepaints()
+{
+    if (queuedRepaints != nullptr)
+        queuedRepaints->flush();
+}
+
+// Returns the number of pixels that would be painted unnecessarily if these two areas
+// were replaced by the smallest rectangle that encloses them both.
+static int64 getRepaintMergeWaste (const Rectangle<int>& a, const Rectangle<int>& b) noexcept
+{
+    const Rectangle<int> u (a.getUnion (b)), i (a.getIntersection (b));
+
+    return (int64) u.getWidth() * u.getHeight()
+            - (int64) a.getWidth() * a.getHeight()
+            - (int64) b.getWidth() * b.getHeight()
+            + (int64) i.getWidth() * i.getHeight();
+}
+
+static bool isWorthMergingRepaints (const Rectangle<int>& a, const Rectangle<int>& b) noexcept
+{
+    const Rectangle<int> u (a.getUnion (b));
+    const int64 waste = getRepaintMergeWaste (a, b);
+
+    // a small amount of overdraw is cheaper than the overhead of painting another rectangle
+    return waste <= 32 * 32 || waste * 4 <= (int64) u.getWidth() * u.getHeight();
+}
+
+void ComponentPeer::addToRepaintRegion (RectangleList<int>& region, const Rectangle<int>& area,
+                                        const int maxRectangles)
+{
+    if (area.isEmpty())
+        return;
+
+    Array<Rectangle<int> > rects;
+    rects.addArray (region.begin(), region.getNumRectangles());
+
+    Rectangle<int> newArea (area);
+
+    for (int i = 0; i < rects.size(); ++i)
+    {
+        const Rectangle<int>& r = rects.getReference (i);
+
+        if (r.contains (newArea))
+            return;
+
+        if (newArea.contains (r) || isWorthMergingRepaints (r, newArea))
+        {
+            newArea = newArea.getUnion (r);
+            rects.remove (i);
+            i = -1;  // the merged area may now be worth combining with ones that were skipped
+        }
+    }
+
+    {
+        RectangleList<int> uncovered (newArea);
+
+        for (int i = 0; i < rects.size(); ++i)
+            if (rects.getReference (i).intersects (newArea))
+                uncovered.subtract (rects.getReference (i));
+
+        rects.addArray (uncovered.begin(), uncovered.getNumRectangles());
+    }
+
+    while (rects.size() > jmax (1, maxRectangles))
+    {
+        int bestA = 0, bestB = 1;
+        int64 bestWaste = std::numeric_limits<int64>::max();
+
+        for (int a = 0; a < rects.size(); ++a)
+        {
+            for (int b = a + 1; b < rects.size(); ++b)
+            {
+                const int64 waste = getRepaintMergeWaste (rects.getReference (a), rects.getReference (b));
+
+                if (waste < bestWaste)
+                {
+                    bestWaste = waste;
+                    bestA = a;
+                    bestB = b;
+                }
+            }
+        }
+
+        Rectangle<int> merged (rects.getReference (bestA).getUnion (rects.getReference (bestB)));
+        rects.remove (bestB);
+        rects.remove (bestA);
+
+        // anything that the merged rectangle now overlaps gets absorbed too, so that none overlap
+        for (int i = 0; i < rects.size(); ++i)
+        {
+            if (rects.getReference (i).intersects (merged))
+            {
+                merged = merged.getUnion (rects.getReference (i));
+                rects.remove (i);
+                i = -1;
+            }
+        }
+
+        rects.add (merged);
+    }
+
+    RectangleList<int> result;
+
+    for (int i = 0; i < rects.size(); ++i)
+        result.addWithoutMerging (rects.getReference (i));
+
+    region.swapWith (result);
 }
 
 Component* ComponentPeer::getTargetForKeyPress()
@@ -302,6 +302,84 @@ public:
     */
     virtual void performAnyPendingRepaintsNow() = 0;
 
+    /** Marks a region of the window as needing to be repainted.
+
+        This is what Component::repaint() uses. Normally it just calls repaint(), but if
+        Desktop::setRepaintBatchingEnabled() has been turned on, the area is merged into a
+        list of dirty rectangles which gets passed to repaint() at the start of the next frame.
+
+        @see flushQueuedRepaints, addToRepaintRegion
+    */
+    void queueRepaint (const Rectangle<int>& area);
+
+    /** Immediately passes any areas that queueRepaint() is holding on to to repaint().
+        Call this before performAnyPendingRepaintsNow() if you need the window to be
+        completely up to date.
+    */
+    void flushQueuedRepaints();
+
+    /** Adds a rectangle to a list of dirty areas, keeping the list short.
+
+        The new area is merged with any rectangles that it overlaps or sits close to,
+        as long as doing so wouldn't mean repainting much more than is needed. If that
+        still leaves more than maxRectangles in the list, the pairs of rectangles which
+        waste the least area when combined are merged until it fits. The rectangles in
+        the list never overlap each other.
+    */
+    static void addToRepaintRegion (RectangleList<int>& region, const Rectangle<int>& area,
+                                    int maxRectangles = 16);
+
+    /** Describes the most recent call to handlePaint().
+        @see getLastRepaintStats
+    */
+    struct RepaintStats
+    {
+        Rectangle<int> paintedArea;     /**< The bounds of the area that was painted, in peer coordinates. */
+        double paintTimeMs;             /**< How long the paint took. */
+        int numRepaintRequests;         /**< The number of queueRepaint() calls since the previous paint. */
+        int64 requestedPixels;          /**< The total area of those calls, before they were merged. */
+    };
+
+    /** Returns some statistics about the last time this window was painted.
+        Comparing the number of pixels that were requested with the size of the area that
+        actually got painted is a good way to find components that repaint too much.
+    */
+    const RepaintStats& getLastRepaintStats() const noexcept    { return lastRepaintStats; }
+
+    //==============================================================================
+    /** Describes the time that one component spent painting itself during a call to handlePaint().
+        @see setPaintProfilingEnabled, getLastPaintProfile
+    */
+    struct ComponentPaintStats
+    {
+        WeakReference<Component> component; /**< The component - this will be null if it has been deleted since. */
+        int numPaints;                      /**< The number of times its paint() method was called. */
+        double paintTimeMs;                 /**< The time spent in its paint() and paintOverChildren() methods, not including its children. */
+        int64 paintedPixels;                /**< The total area that it was asked to paint, in its own coordinate space. */
+    };
+
+    /** Turns on per-component profiling of this window's paint calls.
+
+        While this is enabled, each call to handlePaint() measures how long every component
+        spends in its own paint methods, which you can retrieve with getLastPaintProfile().
+        It adds a small overhead to each paint() call, so it's only intended for debugging.
+
+        If showHeatMap is true, each component that gets painted is then overlaid with a
+        translucent red tint, which is stronger for the components that took longer to paint.
+        Areas that are painted by several overlapping components build up a deeper colour,
+        so this also shows up places where things are being painted unnecessarily.
+    */
+    void setPaintProfilingEnabled (bool shouldProfile, bool showHeatMap = false);
+
+    /** Returns true if setPaintProfilingEnabled() has been turned on. */
+    bool isPaintProfilingEnabled() const noexcept;
+
+    /** Returns the per-component statistics for the most recent call to handlePaint(),
+        with the slowest component first. This will be empty unless profiling has been
+        enabled with setPaintProfilingEnabled().
+    */
+    const Array<ComponentPaintStats>& getLastPaintProfile() const noexcept;
+
     /** Changes the window's transparency. */
     virtual void setAlpha (float newAlpha) = 0;
 
@@ -363,6 +441,22 @@ private:
     Component* lastDragAndDropCompUnderMouse;
     const uint32 uniqueID;
     bool isWindowMinimised;
+
+    class QueuedRepaints;
+    friend class QueuedRepaints;
+    ScopedPointer<QueuedRepaints> queuedRepaints;
+    RepaintStats lastRepaintStats;
+    int numRepaintRequests;
+    int64 requestedRepaintArea;
+
+    struct PaintProfile;
+    friend struct ContainerDeletePolicy<PaintProfile>;
+    ScopedPointer<PaintProfile> paintProfile;
+    static ComponentPeer* peerBeingProfiled;
+    friend class Component;
+
+    void addToPaintProfile (Component&, const Rectangle<int>& area, double timeMs, bool isPaintCall);
+
     Component* getTargetForKeyPress();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ComponentPeer)
@@ -28,10 +28,8 @@ public:
     CodeDocumentLine (const String::CharPointerType startOfLine,
                       const String::CharPointerType endOfLine,
                       const int lineLen,
-                      const int numNewLineChars,
-                      const int startInFile)
+                      const int numNewLineChars)
         : line (startOfLine, endOfLine),
-          lineStartInFile (startInFile),
           lineLength (lineLen),
           lineLengthWithoutNewLines (lineLen - numNewLineChars)
     {
@@ -46,7 +44,6 @@ public:
         while (! (finished || t.isEmpty()))
         {
             String::CharPointerType startOfLine (t);
-            int startOfLineInFile = charNumInFile;
             int lineLength = 0;
             int numNewLineChars = 0;
 
@@ -85,8 +82,7 @@ public:
                 }
             }
 
-            newLines.add (new CodeDocumentLine (startOfLine, t, lineLength,
-                                                numNewLineChars, startOfLineInFile));
+            newLines.add (new CodeDocumentLine (startOfLine, t, lineLength, numNewLineChars));
         }
 
         jassert (charNumInFile == text.length());
@@ -117,7 +113,7 @@ public:
     }
 
     String line;
-    int lineStartInFile, lineLength, lineLengthWithoutNewLines;
+    int lineLength, lineLengthWithoutNewLines;
 };
 
 //==============================================================================
@@ -129,6 +125,28 @@ CodeDocument::Iterator::Iterator (const CodeDocument& doc) noexcept
 {
 }
 
+CodeDocument::Iterator::Iterator (const CodeDocument& doc, const int startPosition) noexcept
+    : document (&doc),
+      charPointer (nullptr),
+      line (0),
+      position (0)
+{
+    if (startPosition >= doc.getNumCharacters())
+    {
+        line = doc.lines.size();
+        position = doc.getNumCharacters();
+    }
+    else if (startPosition > 0)
+    {
+        int lineStart;
+        line = doc.findLineContaining (startPosition, lineStart);
+        position = startPosition;
+
+        if (position > lineStart)
+            charPointer = doc.lines.getUnchecked (line)->line.getCharPointer() + (position - lineStart);
+    }
+}
+
 CodeDocument::Iterator::Iterator (const CodeDocument::Iterator& other) noexcept
     : document (other.document),
       charPointer (other.charPointer),
@@ -321,7 +339,7 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
 
             const CodeDocumentLine& l = *owner->lines.getUnchecked (line);
             indexInLine = l.lineLengthWithoutNewLines;
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = owner->getLineStart (line) + indexInLine;
         }
         else
         {
@@ -334,7 +352,7 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
             else
                 indexInLine = 0;
 
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = owner->getLineStart (line) + indexInLine;
         }
     }
 }
@@ -347,40 +365,14 @@ void CodeDocument::Position::setPosition (const int newPosition)
     indexInLine = 0;
     characterPos = 0;
 
-    if (newPosition > 0)
+    if (newPosition > 0 && owner->lines.size() > 0)
     {
-        int lineStart = 0;
-        int lineEnd = owner->lines.size();
-
-        for (;;)
-        {
-            if (lineEnd - lineStart < 4)
-            {
-                for (int i = lineStart; i < lineEnd; ++i)
-                {
-                    const CodeDocumentLine& l = *owner->lines.getUnchecked (i);
-                    const int index = newPosition - l.lineStartInFile;
-
-                    if (index >= 0 && (index < l.lineLength || i == lineEnd - 1))
-                    {
-                        line = i;
-                        indexInLine = jmin (l.lineLengthWithoutNewLines, index);
-                        characterPos = l.lineStartInFile + indexInLine;
-                    }
-                }
+        int lineStart;
+        line = owner->findLineContaining (newPosition, lineStart);
 
-                break;
-            }
-            else
-            {
-                const int midIndex = (lineStart + lineEnd + 1) / 2;
-
-                if (newPosition >= owner->lines.getUnchecked (midIndex)->lineStartInFile)
-                    lineStart = midIndex;
-                else
-                    lineEnd = midIndex;
-            }
-        }
+        const CodeDocumentLine& l = *owner->lines.getUnchecked (line);
+        indexInLine = jmin (l.lineLengthWithoutNewLines, newPosition - lineStart);
+        characterPos = lineStart + indexInLine;
     }
 }
 
@@ -465,7 +457,8 @@ CodeDocument::CodeDocument()
       currentActionIndex (0),
       indexOfSavedState (-1),
       maximumLineLength (-1),
-      newLineChars ("\r\n")
+      newLineChars ("\r\n"),
+      lineStartTreeIsValid (false)
 {
 }
 
@@ -526,10 +519,93 @@ String CodeDocument::getTextBetween (const Position& start, const Position& end)
 
 int CodeDocument::getNumCharacters() const noexcept
 {
-    if (const CodeDocumentLine* const lastLine = lines.getLast())
-        return lastLine->lineStartInFile + lastLine->lineLength;
+    return getLineStart (lines.size());
+}
 
-    return 0;
+//==============================================================================
+void CodeDocument::updateLineStartTree() const
+{
+    jassert (lineLengths.size() == lines.size());
+
+    if (! lineStartTreeIsValid)
+    {
+        // (this builds the tree in linear time, by adding each node into its parent)
+        const int num = lineLengths.size();
+        lineStartTree.malloc ((size_t) num + 1);
+        lineStartTree[0] = 0;
+
+        for (int i = 1; i <= num; ++i)
+            lineStartTree[i] = lineLengths.getUnchecked (i - 1);
+
+        for (int i = 1; i <= num; ++i)
+        {
+            const int parent = i + (i & -i);
+
+            if (parent <= num)
+                lineStartTree[parent] += lineStartTree[i];
+        }
+
+        lineStartTreeIsValid = true;
+    }
+}
+
+int CodeDocument::getLineStart (const int lineIndex) const noexcept
+{
+    updateLineStartTree();
+
+    int start = 0;
+
+    for (int i = jmin (lineIndex, lineLengths.size()); i > 0; i -= (i & -i))
+        start += lineStartTree[i];
+
+    return start;
+}
+
+int CodeDocument::findLineContaining (const int position, int& lineStart) const noexcept
+{
+    updateLineStartTree();
+
+    const int num = lineLengths.size();
+    int step = 1;
+
+    while (step * 2 <= num)
+        step *= 2;
+
+    // finds the number of lines which end at or before this position
+    int index = 0, start = 0;
+
+    for (; step > 0; step >>= 1)
+    {
+        if (index + step <= num && start + lineStartTree[index + step] <= position)
+        {
+            index += step;
+            start += lineStartTree[index];
+        }
+    }
+
+    if (index >= num && num > 0)
+    {
+        // (positions beyond the end are on the last line)
+        index = num - 1;
+        start -= lineLengths.getUnchecked (index);
+    }
+
+    lineStart = start;
+    return index;
+}
+
+void CodeDocument::setLineLength (const int lineIndex, const int newLength) noexcept
+{
+    const int delta = newLength - lineLengths.getUnchecked (lineIndex);
+
+    if (delta != 0)
+    {
+        lineLengths.set (lineIndex, newLength);
+
+        if (lineStartTreeIsValid)
+            for (int i = lineIndex + 1; i <= lineLengths.size(); i += (i & -i))
+                lineStartTree[i] += delta;
+    }
 }
 
 String CodeDocument::getLine (const int lineIndex) const noexcept
@@ -782,6 +858,8 @@ void CodeDocument::checkLastLineStatus()
     {
         // remove any empty lines at the end if the preceding line doesn't end in a newline.
         lines.removeLast();
+        lineLengths.removeLast();
+        lineStartTreeIsValid = false;
     }
 
     const CodeDocumentLine* const lastLine = lines.getLast();
@@ -789,8 +867,9 @@ void CodeDocument::checkLastLineStatus()
     if (lastLine != nullptr && lastLine->endsWithLineBreak())
     {
         // check that there's an empty line at the end if the preceding one ends in a newline..
-        lines.add (new CodeDocumentLine (StringRef(), StringRef(), 0, 0,
-                                         lastLine->lineStartInFile + lastLine->lineLength));
+        lines.add (new CodeDocumentLine (StringRef(), StringRef(), 0, 0));
+        lineLengths.add (0);
+        lineStartTreeIsValid = false;
     }
 }
 
@@ -861,20 +940,29 @@ void CodeDocument::insert (const String& text, const int insertPos, const bool u
             jassert (newLines.size() > 0);
 
             CodeDocumentLine* const newFirstLine = newLines.getUnchecked (0);
-            newFirstLine->lineStartInFile = firstLine != nullptr ? firstLine->lineStartInFile : 0;
             lines.set (firstAffectedLine, newFirstLine);
 
+            if (firstLine != nullptr)
+                setLineLength (firstAffectedLine, newFirstLine->lineLength);
+            else
+                lineLengths.add (newFirstLine->lineLength);
+
             if (newLines.size() > 1)
+            {
                 lines.insertArray (firstAffectedLine + 1, newLines.getRawDataPointer() + 1, newLines.size() - 1);
 
-            int lineStart = newFirstLine->lineStartInFile;
-            for (int i = firstAffectedLine; i < lines.size(); ++i)
-            {
-                CodeDocumentLine& l = *lines.getUnchecked (i);
-                l.lineStartInFile = lineStart;
-                lineStart += l.lineLength;
+                Array<int> newLengths;
+                newLengths.ensureStorageAllocated (newLines.size() - 1);
+
+                for (int i = 1; i < newLines.size(); ++i)
+                    newLengths.add (newLines.getUnchecked (i)->lineLength);
+
+                lineLengths.insertArray (firstAffectedLine + 1, newLengths.getRawDataPointer(), newLengths.size());
             }
 
+            if (firstLine == nullptr || newLines.size() > 1)
+                lineStartTreeIsValid = false;
+
             checkLastLineStatus();
 
             const int newTextLength = text.length();
@@ -950,6 +1038,7 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
             firstLine.line = firstLine.line.substring (0, startPosition.getIndexInLine())
                            + firstLine.line.substring (endPosition.getIndexInLine());
             firstLine.updateLength();
+            setLineLength (firstAffectedLine, firstLine.lineLength);
         }
         else
         {
@@ -961,13 +1050,10 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
 
             int numLinesToRemove = endLine - firstAffectedLine;
             lines.removeRange (firstAffectedLine + 1, numLinesToRemove);
-        }
 
-        for (int i = firstAffectedLine + 1; i < lines.size(); ++i)
-        {
-            CodeDocumentLine& l = *lines.getUnchecked (i);
-            const CodeDocumentLine& previousLine = *lines.getUnchecked (i - 1);
-            l.lineStartInFile = previousLine.lineStartInFile + previousLine.lineLength;
+            lineLengths.set (firstAffectedLine, firstLine.lineLength);
+            lineLengths.removeRange (firstAffectedLine + 1, numLinesToRemove);
+            lineStartTreeIsValid = false;
         }
 
         checkLastLineStatus();
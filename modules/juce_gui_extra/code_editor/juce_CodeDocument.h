@@ -355,6 +355,12 @@ public:
     {
     public:
         Iterator (const CodeDocument& document) noexcept;
+
+        /** Creates an iterator which will read the document starting at the given
+            character position.
+        */
+        Iterator (const CodeDocument& document, int startPosition) noexcept;
+
         Iterator (const Iterator&) noexcept;
         Iterator& operator= (const Iterator&) noexcept;
         ~Iterator() noexcept;
@@ -406,10 +412,21 @@ private:
     ListenerList <Listener> listeners;
     String newLineChars;
 
+    // The length of each line, and a Fenwick tree of these lengths which is used to find
+    // the position of the start of a line, or the line containing a position.
+    Array<int> lineLengths;
+    mutable HeapBlock<int> lineStartTree;
+    mutable bool lineStartTreeIsValid;
+
     void insert (const String& text, int insertPos, bool undoable);
     void remove (int startPos, int endPos, bool undoable);
     void checkLastLineStatus();
 
+    int getLineStart (int lineIndex) const noexcept;
+    int findLineContaining (int position, int& lineStart) const noexcept;
+    void setLineLength (int lineIndex, int newLength) noexcept;
+    void updateLineStartTree() const;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CodeDocument)
 };
 
@@ -250,11 +250,36 @@ class CodeEditorComponent::Pimpl   : public Timer,
                                      public CodeDocument::Listener
 {
 public:
-    Pimpl (CodeEditorComponent& ed) : owner (ed) {}
+    Pimpl (CodeEditorComponent& ed) : owner (ed), tokenScanner (ed) {}
+
+    void startTokenScan()
+    {
+        if (owner.codeTokeniser != nullptr && ! tokenScanner.isTimerRunning())
+            tokenScanner.startTimer (20);
+    }
 
 private:
     CodeEditorComponent& owner;
 
+    // Works through the document in short slices while the editor is idle, so that
+    // the tokeniser state is usually known for a line before it gets scrolled into view.
+    struct TokenScanner  : public Timer
+    {
+        TokenScanner (CodeEditorComponent& ed) : owner (ed) {}
+
+        void timerCallback() override
+        {
+            if (owner.updateCachedIterators (std::numeric_limits<int>::max(), 5))
+                stopTimer();
+        }
+
+        CodeEditorComponent& owner;
+
+        JUCE_DECLARE_NON_COPYABLE (TokenScanner)
+    };
+
+    TokenScanner tokenScanner;
+
     void timerCallback() override        { owner.newTransaction(); }
     void handleAsyncUpdate() override    { owner.rebuildLineTokens(); }
 
@@ -383,6 +408,7 @@ CodeEditorComponent::CodeEditorComponent (CodeDocument& doc, CodeTokeniser* cons
     verticalScrollBar.addListener (pimpl);
     horizontalScrollBar.addListener (pimpl);
     document.addListener (pimpl);
+    pimpl->startTokenScan();
 }
 
 CodeEditorComponent::~CodeEditorComponent()
@@ -538,7 +564,7 @@ void CodeEditorComponent::rebuildLineTokens()
     jassert (numNeeded == lines.size());
 
     CodeDocument::Iterator source (document);
-    getIteratorForPosition (CodeDocument::Position (document, firstLineOnScreen, 0).getPosition(), source);
+    getIteratorForLine (firstLineOnScreen, source);
 
     for (int i = 0; i < numNeeded; ++i)
     {
@@ -676,7 +702,6 @@ void CodeEditorComponent::scrollToLineInternal (int newFirstLineOnScreen)
         firstLineOnScreen = newFirstLineOnScreen;
         updateCaretPosition();
 
-        updateCachedIterators (firstLineOnScreen);
         rebuildLineTokensAsync();
         pimpl->handleUpdateNowIfNeeded();
     }
@@ -1542,74 +1567,57 @@ Colour CodeEditorComponent::getColourForTokenType (const int tokenType) const
 
 void CodeEditorComponent::clearCachedIterators (const int firstLineToBeInvalid)
 {
-    int i;
-    for (i = cachedIterators.size(); --i >= 0;)
-        if (cachedIterators.getUnchecked (i)->getLine() < firstLineToBeInvalid)
-            break;
-
-    cachedIterators.removeRange (jmax (0, i - 1), cachedIterators.size());
+    // (an edit can't move the token boundary at the start of the line it's on, as that
+    // boundary was found by reading the text before it)
+    lineTokenStarts.removeRange (jmax (1, firstLineToBeInvalid + 1), lineTokenStarts.size());
+    pimpl->startTokenScan();
 }
 
-void CodeEditorComponent::updateCachedIterators (int maxLineNum)
+bool CodeEditorComponent::updateCachedIterators (const int maxLineNum, const int maxMillisecs)
 {
-    const int maxNumCachedPositions = 5000;
-    const int linesBetweenCachedSources = jmax (10, document.getNumLines() / maxNumCachedPositions);
+    if (codeTokeniser == nullptr)
+        return true;
 
-    if (cachedIterators.size() == 0)
-        cachedIterators.add (new CodeDocument::Iterator (document));
+    if (lineTokenStarts.size() == 0)
+        lineTokenStarts.add (0);
 
-    if (codeTokeniser != nullptr)
-    {
-        for (;;)
-        {
-            CodeDocument::Iterator& last = *cachedIterators.getLast();
-
-            if (last.getLine() >= maxLineNum)
-                break;
+    const int lastLine = jmin (maxLineNum, document.getNumLines() - 1);
+    const uint32 startTime = Time::getMillisecondCounter();
 
-            CodeDocument::Iterator* t = new CodeDocument::Iterator (last);
-            cachedIterators.add (t);
-            const int targetLine = jmin (maxLineNum, last.getLine() + linesBetweenCachedSources);
+    CodeDocument::Iterator t (document, lineTokenStarts.getLast());
 
-            for (;;)
-            {
-                codeTokeniser->readNextToken (*t);
+    for (int numTokens = 0; lineTokenStarts.size() <= lastLine;)
+    {
+        const int tokenStart = t.getPosition();
+        codeTokeniser->readNextToken (t);
 
-                if (t->getLine() >= targetLine)
-                    break;
+        if (t.isEOF() || t.getPosition() <= tokenStart)
+        {
+            while (lineTokenStarts.size() <= lastLine)
+                lineTokenStarts.add (tokenStart);
 
-                if (t->isEOF())
-                    return;
-            }
+            break;
         }
+
+        // Any lines that start inside this token (or where it ends) can be
+        // tokenised by starting at the beginning of it..
+        while (lineTokenStarts.size() <= jmin (t.getLine(), lastLine))
+            lineTokenStarts.add (tokenStart);
+
+        if (maxMillisecs > 0 && (++numTokens & 63) == 0
+             && Time::getMillisecondCounter() - startTime >= (uint32) maxMillisecs)
+            return false;
     }
+
+    return true;
 }
 
-void CodeEditorComponent::getIteratorForPosition (int position, CodeDocument::Iterator& source)
+void CodeEditorComponent::getIteratorForLine (const int line, CodeDocument::Iterator& source)
 {
-    if (codeTokeniser != nullptr)
+    if (codeTokeniser != nullptr && line > 0)
     {
-        for (int i = cachedIterators.size(); --i >= 0;)
-        {
-            const CodeDocument::Iterator& t = *cachedIterators.getUnchecked (i);
-            if (t.getPosition() <= position)
-            {
-                source = t;
-                break;
-            }
-        }
-
-        while (source.getPosition() < position)
-        {
-            const CodeDocument::Iterator original (source);
-            codeTokeniser->readNextToken (source);
-
-            if (source.getPosition() > position || source.isEOF())
-            {
-                source = original;
-                break;
-            }
-        }
+        updateCachedIterators (line, 0);
+        source = CodeDocument::Iterator (document, lineTokenStarts [jmin (line, lineTokenStarts.size() - 1)]);
     }
 }
 
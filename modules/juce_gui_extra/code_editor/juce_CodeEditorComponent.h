@@ -402,10 +402,12 @@ private:
     void rebuildLineTokensAsync();
     void codeDocumentChanged (int start, int end);
 
-    OwnedArray<CodeDocument::Iterator> cachedIterators;
+    // For each line that has been scanned so far, the position of the token boundary at or
+    // before the start of that line, so that any of these lines can be tokenised on its own.
+    Array<int> lineTokenStarts;
     void clearCachedIterators (int firstLineToBeInvalid);
-    void updateCachedIterators (int maxLineNum);
-    void getIteratorForPosition (int position, CodeDocument::Iterator&);
+    bool updateCachedIterators (int maxLineNum, int maxMillisecs);
+    void getIteratorForLine (int line, CodeDocument::Iterator&);
 
     void moveLineDelta (int delta, bool selecting);
     int getGutterSize() const noexcept;
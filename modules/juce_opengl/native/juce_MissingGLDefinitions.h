@@ -83,6 +83,10 @@ enum MissingOpenGLDefinitions
     GL_STENCIL_ATTACHMENT           = 0x8D20,
    #endif
 
+   #ifndef GL_PIXEL_UNPACK_BUFFER
+    GL_PIXEL_UNPACK_BUFFER          = 0x88EC,
+   #endif
+
    #if JUCE_WINDOWS && ! defined (GL_TEXTURE0)
     GL_OPERAND0_RGB                 = 0x8590,
     GL_OPERAND1_RGB                 = 0x8591,
@@ -22,7 +22,105 @@
   ==============================================================================
 */
 
-class OpenGLContext::CachedImage  : public CachedComponentImage
+//==============================================================================
+// All the contexts that have setResourceSharingEnabled() turned on belong to this group.
+// Their native contexts share GL objects, and their associated objects are kept here
+// rather than in each context, so that things like shader programs, image textures and
+// glyph atlases only get built once. Only one member renders at a time (see renderLock),
+// so nothing in here is ever used by two threads at once. An object is released when the
+// context that created it shuts down, while that context is still active.
+struct OpenGLSharedResourceGroup
+{
+    static OpenGLSharedResourceGroup& getInstance()
+    {
+        static OpenGLSharedResourceGroup group;
+        return group;
+    }
+
+    void* getContextToShareWith() const
+    {
+        const ScopedLock sl (lock);
+        return members.size() > 0 ? members.getFirst()->getRawContext() : nullptr;
+    }
+
+    void addMember (OpenGLContext::NativeContext* nc)
+    {
+        const ScopedLock sl (lock);
+        members.add (nc);
+    }
+
+    void removeMember (OpenGLContext::NativeContext* nc)
+    {
+        const ScopedLock sl (lock);
+        members.removeFirstMatchingValue (nc);
+    }
+
+    ReferenceCountedObject* getAssociatedObject (const char* name) const
+    {
+        const ScopedLock sl (lock);
+        const int index = names.indexOf (name);
+        return index >= 0 ? objects.getUnchecked (index) : nullptr;
+    }
+
+    void setAssociatedObject (const char* name, ReferenceCountedObject* newObject, const OpenGLContext* creator)
+    {
+        const ScopedLock sl (lock);
+        const int index = names.indexOf (name);
+
+        if (index >= 0)
+        {
+            if (newObject != nullptr)
+            {
+                objects.set (index, newObject);
+                creators.set (index, creator);
+            }
+            else
+            {
+                names.remove (index);
+                objects.remove (index);
+                creators.remove (index);
+            }
+        }
+        else if (newObject != nullptr)
+        {
+            names.add (name);
+            objects.add (newObject);
+            creators.add (creator);
+        }
+    }
+
+    void removeObjectsCreatedBy (const OpenGLContext* creator)
+    {
+        const ScopedLock sl (lock);
+
+        for (int i = creators.size(); --i >= 0;)
+        {
+            if (creators.getUnchecked (i) == creator)
+            {
+                names.remove (i);
+                objects.remove (i);
+                creators.remove (i);
+            }
+        }
+    }
+
+    CriticalSection renderLock;
+
+private:
+    OpenGLSharedResourceGroup() {}
+
+    CriticalSection lock;
+    Array<OpenGLContext::NativeContext*> members;
+    StringArray names;
+    ReferenceCountedArray<ReferenceCountedObject> objects;
+    Array<const OpenGLContext*> creators;
+
+    JUCE_DECLARE_NON_COPYABLE (OpenGLSharedResourceGroup)
+};
+
+//==============================================================================
+class OpenGLContext::CachedImage  : public CachedComponentImage,
+                                   private AsyncUpdater
                                  #if JUCE_OPENGL_CREATE_JUCE_RENDER_THREAD
                                   , private Thread
                                  #endif
@@ -45,10 +143,33 @@ public:
           shadersAvailable (false),
          #endif
           hasInitialised (false),
-          needsUpdate (1), lastMMLockReleaseTime (0)
+          needsUpdate (1), lastMMLockReleaseTime (0),
+          sharedGroup (nullptr)
     {
-        nativeContext = new NativeContext (component, pixFormat, contextToShare,
-                                           c.useMultisampling, c.versionRequired);
+       #if ! JUCE_ANDROID  // (android contexts can't share their objects)
+        if (c.shareResources && contextToShare == nullptr)
+        {
+            OpenGLSharedResourceGroup& group = OpenGLSharedResourceGroup::getInstance();
+
+            nativeContext = new NativeContext (component, pixFormat, group.getContextToShareWith(),
+                                               c.useMultisampling, c.versionRequired);
+
+            if (nativeContext->createdOk())
+            {
+                sharedGroup = &group;
+                group.addMember (nativeContext);
+            }
+            else
+            {
+                // (this can happen if the pixel format doesn't match the other contexts)
+                nativeContext = nullptr;
+            }
+        }
+       #endif
+
+        if (nativeContext == nullptr)
+            nativeContext = new NativeContext (component, pixFormat, contextToShare,
+                                               c.useMultisampling, c.versionRequired);
 
         if (nativeContext->createdOk())
             context.nativeContext = nativeContext;
@@ -59,6 +180,9 @@ public:
     ~CachedImage()
     {
         stop();
+
+        if (sharedGroup != nullptr)
+            sharedGroup->removeMember (nativeContext);
     }
 
     void start()
@@ -83,14 +207,14 @@ public:
     bool invalidateAll() override
     {
         validArea.clear();
-        triggerRepaint();
+        triggerComponentRepaint();
         return false;
     }
 
     bool invalidate (const Rectangle<int>& area) override
     {
         validArea.subtract (area * scale);
-        triggerRepaint();
+        triggerComponentRepaint();
         return false;
     }
 
@@ -108,6 +232,14 @@ public:
        #endif
     }
 
+    void triggerComponentRepaint()
+    {
+        if (context.recordComponentPainting)
+            triggerAsyncUpdate();
+        else
+            triggerRepaint();
+    }
+
     //==============================================================================
     bool ensureFrameBufferSize()
     {
@@ -152,7 +284,7 @@ public:
 
         const bool isUpdating = needsUpdate.compareAndSetBool (0, 1);
 
-        if (context.renderComponents && isUpdating)
+        if (context.renderComponents && isUpdating && ! context.recordComponentPainting)
         {
             // This avoids hogging the message thread when doing intensive rendering.
             if (lastMMLockReleaseTime + 1 >= Time::getMillisecondCounter())
@@ -175,6 +307,26 @@ public:
             updateViewportSize (false);
         }
 
+        // (this must be taken after the message manager lock, as other members of the
+        // group may be holding it while they wait for the message thread)
+        ScopedPointer<ScopedLock> sharedGroupLock;
+
+        if (sharedGroup != nullptr)
+            sharedGroupLock = new ScopedLock (sharedGroup->renderLock);
+
+        // (when painting is recorded, the message thread may be changing these, so this
+        // frame works with a copy of them)
+        Rectangle<int> frameArea;
+        double frameScale;
+        OwnedArray<RecordedPaint> paintsToDraw;
+
+        {
+            const ScopedLock sl (recordedPaintLock);
+            frameArea = viewportArea;
+            frameScale = scale;
+            paintsToDraw.swapWith (recordedPaints);
+        }
+
         if (! context.makeActive())
             return false;
 
@@ -184,22 +336,26 @@ public:
 
         if (context.renderer != nullptr)
         {
-            glViewport (0, 0, viewportArea.getWidth(), viewportArea.getHeight());
-            context.currentRenderScale = scale;
+            glViewport (0, 0, frameArea.getWidth(), frameArea.getHeight());
+            context.currentRenderScale = frameScale;
             context.renderer->renderOpenGL();
             clearGLError();
         }
 
         if (context.renderComponents)
         {
-            if (isUpdating)
+            if (context.recordComponentPainting)
+            {
+                drawRecordedPaints (paintsToDraw, frameArea);
+            }
+            else if (isUpdating)
             {
                 paintComponent();
                 mmLock = nullptr;
                 lastMMLockReleaseTime = Time::getMillisecondCounter();
             }
 
-            glViewport (0, 0, viewportArea.getWidth(), viewportArea.getHeight());
+            glViewport (0, 0, frameArea.getWidth(), frameArea.getHeight());
             drawComponentBuffer();
         }
 
@@ -222,8 +378,11 @@ public:
 
             if (scale != newScale || viewportArea != newArea)
             {
-                scale = newScale;
-                viewportArea = newArea;
+                {
+                    const ScopedLock sl (recordedPaintLock);
+                    scale = newScale;
+                    viewportArea = newArea;
+                }
 
                 if (canTriggerUpdate)
                     invalidateAll();
@@ -271,6 +430,100 @@ public:
         JUCE_CHECK_OPENGL_ERROR
     }
 
+    //==============================================================================
+    // When setComponentPaintingRecorded() is turned on, the message thread paints the
+    // invalid parts of the component into display lists, and the GL thread just replays
+    // them into the frame buffer, so neither thread has to wait for the other.
+    struct RecordedPaint
+    {
+        DisplayList list;
+        RectangleList<int> area;  // in frame buffer pixels
+        double scale;
+    };
+
+    void handleAsyncUpdate() override
+    {
+        if (needsFullRepaint.compareAndSetBool (0, 1))
+            validArea.clear();
+
+        updateViewportSize (true);
+
+        RectangleList<int> invalid (viewportArea);
+        invalid.subtract (validArea);
+        validArea = viewportArea;
+
+        if (invalid.isEmpty())
+            return;
+
+        ScopedPointer<RecordedPaint> paint (new RecordedPaint());
+        paint->area = invalid;
+        paint->scale = scale;
+
+        {
+            RectangleList<int> componentArea;
+
+            for (const Rectangle<int>* i = invalid.begin(), * const e = invalid.end(); i != e; ++i)
+                componentArea.add ((i->toFloat() / (float) scale).getSmallestIntegerContainer());
+
+            DisplayList::Recorder recorder (paint->list, component.getLocalBounds(), (float) scale);
+            recorder.clipToRectangleList (componentArea);
+            paintOwner (recorder);
+        }
+
+        {
+            const ScopedLock sl (recordedPaintLock);
+            recordedPaints.add (paint.release());
+        }
+
+        triggerRepaint();
+    }
+
+    void drawRecordedPaints (const OwnedArray<RecordedPaint>& paints, const Rectangle<int>& frameArea)
+    {
+        const int fbW = cachedImageFrameBuffer.getWidth();
+        const int fbH = cachedImageFrameBuffer.getHeight();
+
+        if (fbW != frameArea.getWidth() || fbH != frameArea.getHeight() || ! cachedImageFrameBuffer.isValid())
+        {
+            if (! cachedImageFrameBuffer.initialise (context, frameArea.getWidth(), frameArea.getHeight()))
+                return;
+
+            JUCE_CHECK_OPENGL_ERROR
+
+            // The new buffer is empty, so unless these paints cover all of it, the
+            // message thread needs to paint everything again..
+            RectangleList<int> unpainted (frameArea);
+
+            for (int i = 0; i < paints.size(); ++i)
+                unpainted.subtract (paints.getUnchecked(i)->area);
+
+            if (! unpainted.isEmpty())
+            {
+                needsFullRepaint = 1;
+                triggerAsyncUpdate();
+            }
+        }
+
+        for (int i = 0; i < paints.size(); ++i)
+        {
+            const RecordedPaint& paint = *paints.getUnchecked(i);
+
+            clearRegionInFrameBuffer (paint.area);
+
+            {
+                ScopedPointer<LowLevelGraphicsContext> g (createOpenGLGraphicsContext (context, cachedImageFrameBuffer));
+                g->clipToRectangleList (paint.area);
+                g->addTransform (AffineTransform::scale ((float) paint.scale));
+                paint.list.replay (*g);
+                JUCE_CHECK_OPENGL_ERROR
+            }
+
+            if (! context.isActive())
+                context.makeActive();
+        }
+    }
+
+    //==============================================================================
     void drawComponentBuffer()
     {
        #if ! JUCE_ANDROID
@@ -384,6 +637,11 @@ public:
 
     void initialiseOnThread()
     {
+        ScopedPointer<ScopedLock> sharedGroupLock;
+
+        if (sharedGroup != nullptr)
+            sharedGroupLock = new ScopedLock (sharedGroup->renderLock);
+
         // On android, this can get called twice, so drop any previous state..
         associatedObjectNames.clear();
         associatedObjects.clear();
@@ -415,9 +673,20 @@ public:
 
     void shutdownOnThread()
     {
+        ScopedPointer<ScopedLock> sharedGroupLock;
+
+        if (sharedGroup != nullptr)
+            sharedGroupLock = new ScopedLock (sharedGroup->renderLock);
+
         if (context.renderer != nullptr)
             context.renderer->openGLContextClosing();
 
+        if (sharedGroup != nullptr)
+        {
+            context.makeActive();
+            sharedGroup->removeObjectsCreatedBy (&context);
+        }
+
        #if JUCE_OPENGL3
         if (vertexArrayObject != 0)
             glDeleteVertexArrays (1, &vertexArrayObject);
@@ -455,9 +724,14 @@ public:
 
     WaitableEvent canPaintNowFlag, finishedPaintingFlag;
     bool shadersAvailable, hasInitialised;
-    Atomic<int> needsUpdate;
+    Atomic<int> needsUpdate, needsFullRepaint;
+
+    CriticalSection recordedPaintLock;
+    OwnedArray<RecordedPaint> recordedPaints;
     uint32 lastMMLockReleaseTime;
 
+    OpenGLSharedResourceGroup* sharedGroup;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedImage)
 };
 
@@ -597,7 +871,8 @@ OpenGLContext::OpenGLContext()
     : nativeContext (nullptr), renderer (nullptr), currentRenderScale (1.0),
       contextToShareWith (nullptr), versionRequired (OpenGLContext::defaultGLVersion),
       imageCacheMaxSize (8 * 1024 * 1024),
-      renderComponents (true), useMultisampling (false), continuousRepaint (false)
+      renderComponents (true), useMultisampling (false), continuousRepaint (false),
+      recordComponentPainting (false), shareResources (false)
 {
 }
 
@@ -624,6 +899,15 @@ void OpenGLContext::setComponentPaintingEnabled (bool shouldPaintComponent) noex
     renderComponents = shouldPaintComponent;
 }
 
+void OpenGLContext::setComponentPaintingRecorded (bool shouldRecordPainting) noexcept
+{
+    // This method must not be called when the context has already been attached!
+    // Call it before attaching your context, or use detach() first, before calling this!
+    jassert (nativeContext == nullptr);
+
+    recordComponentPainting = shouldRecordPainting;
+}
+
 void OpenGLContext::setContinuousRepainting (bool shouldContinuouslyRepaint) noexcept
 {
     continuousRepaint = shouldContinuouslyRepaint;
@@ -648,6 +932,21 @@ void OpenGLContext::setNativeSharedContext (void* nativeContextToShareWith) noex
     contextToShareWith = nativeContextToShareWith;
 }
 
+void OpenGLContext::setResourceSharingEnabled (bool shouldShareResources) noexcept
+{
+    // This method must not be called when the context has already been attached!
+    // Call it before attaching your context, or use detach() first, before calling this!
+    jassert (nativeContext == nullptr);
+
+    shareResources = shouldShareResources;
+}
+
+bool OpenGLContext::isSharingResources() const noexcept
+{
+    CachedImage* const c = getCachedImage();
+    return c != nullptr && c->sharedGroup != nullptr;
+}
+
 void OpenGLContext::setMultisamplingEnabled (bool b) noexcept
 {
     // This method must not be called when the context has already been attached!
@@ -777,6 +1076,9 @@ ReferenceCountedObject* OpenGLContext::getAssociatedObject (const char* name) co
     jassert (c != nullptr && nativeContext != nullptr);
     jassert (getCurrentContext() != nullptr);
 
+    if (c->sharedGroup != nullptr)
+        return c->sharedGroup->getAssociatedObject (name);
+
     const int index = c->associatedObjectNames.indexOf (name);
     return index >= 0 ? c->associatedObjects.getUnchecked (index) : nullptr;
 }
@@ -791,6 +1093,12 @@ void OpenGLContext::setAssociatedObject (const char* name, ReferenceCountedObjec
         jassert (nativeContext != nullptr);
         jassert (getCurrentContext() != nullptr);
 
+        if (c->sharedGroup != nullptr)
+        {
+            c->sharedGroup->setAssociatedObject (name, newObject, this);
+            return;
+        }
+
         const int index = c->associatedObjectNames.indexOf (name);
 
         if (index >= 0)
@@ -101,6 +101,31 @@ public:
     */
     void setNativeSharedContext (void* nativeContextToShareWith) noexcept;
 
+    /** Makes this context share its GL resources with all the other contexts in the
+        process that have this enabled.
+
+        When lots of contexts are open at the same time, (e.g. a host showing many plugin
+        editors), this means that the renderer's shader programs, image textures and glyph
+        atlases are only built once and then used by all of them, instead of being compiled
+        and uploaded again for every context. Any objects stored with setAssociatedObject()
+        are shared in the same way, so they mustn't contain GL objects which can't be shared
+        between contexts, such as vertex array objects or frame buffers.
+
+        To make this safe, the contexts in the group take turns to render their frames, and
+        they should all use the same pixel format. It's ignored if a context has been given
+        a native context with setNativeSharedContext(), and on platforms that can't share
+        GL objects between contexts.
+
+        Note: This must be called BEFORE attaching your context to a target component!
+    */
+    void setResourceSharingEnabled (bool shouldShareResources) noexcept;
+
+    /** Returns true if this context is attached and is sharing its resources with other
+        contexts.
+        @see setResourceSharingEnabled
+    */
+    bool isSharingResources() const noexcept;
+
     /** Enables multisampling on platforms where this is implemented.
         If enabling this, you must call this method before attachTo().
     */
@@ -136,6 +161,22 @@ public:
     */
     void setComponentPaintingEnabled (bool shouldPaintComponent) noexcept;
 
+    /** Changes the way that the target component is painted when component painting is enabled.
+
+        Normally, the GL thread locks the message thread while it calls the component's paint()
+        methods, so a busy message thread will hold up GL frames and vice-versa. If this is
+        enabled, the paint() calls are instead made on the message thread, and their output is
+        recorded into a DisplayList which the GL thread then draws without needing the lock.
+
+        Because the drawing happens later on another thread, any images that the component
+        draws must not be modified afterwards, (see DisplayList), and its paint() methods won't
+        be able to use anything that needs the GL context to be active.
+
+        This is disabled by default.
+        Note: This must be called BEFORE attaching your context to a target component!
+    */
+    void setComponentPaintingRecorded (bool shouldRecordPainting) noexcept;
+
     /** Enables or disables continuous repainting.
         If set to true, the context will run a loop, re-rendering itself without waiting
         for triggerRepaint() to be called, at a frequency determined by the swap interval
@@ -164,7 +205,11 @@ public:
         deleted. The main purpose is for caching GL objects such as shader programs, which
         will become invalid when the context is deleted.
 
+        If resource sharing is enabled, the object is shared with the other contexts in the
+        group, and is released when this context is closed.
+
         This method must only be called from within the GL rendering methods.
+        @see setResourceSharingEnabled
     */
     void setAssociatedObject (const char* name, ReferenceCountedObject* newObject);
 
@@ -284,7 +329,7 @@ private:
     void* contextToShareWith;
     OpenGLVersion versionRequired;
     size_t imageCacheMaxSize;
-    bool renderComponents, useMultisampling, continuousRepaint;
+    bool renderComponents, useMultisampling, continuousRepaint, recordComponentPainting, shareResources;
 
     CachedImage* getCachedImage() const noexcept;
 
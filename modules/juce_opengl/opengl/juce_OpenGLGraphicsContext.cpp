@@ -90,7 +90,10 @@ struct CachedImageList  : public ReferenceCountedObject,
         CachedImage (CachedImageList& list, ImagePixelData* im)
             : owner (list), pixelData (im),
               lastUsed (Time::getCurrentTime()),
-              imageSize ((size_t) (im->width * im->height))
+              imageSize ((size_t) (im->width * im->height)),
+              numTilesX ((im->width + tileSize - 1) / tileSize),
+              numTilesY ((im->height + tileSize - 1) / tileSize),
+              tileChecksums ((size_t) (numTilesX * numTilesY))
         {
             pixelData->listeners.add (&owner);
         }
@@ -106,7 +109,21 @@ struct CachedImageList  : public ReferenceCountedObject,
             TextureInfo t;
 
             if (texture.getTextureID() == 0)
-                texture.loadImage (Image (pixelData));
+            {
+                const Image image (pixelData);
+                needsUpdate = 0;
+                texture.loadImage (image);
+                updateChecksums (image, nullptr);
+            }
+            else if (needsUpdate.compareAndSetBool (0, 1))
+            {
+                const Image image (pixelData);
+                RectangleList<int> changedArea;
+                updateChecksums (image, &changedArea);
+
+                for (const Rectangle<int>* i = changedArea.begin(), * const e = changedArea.end(); i != e; ++i)
+                    texture.updateImageArea (image, *i);
+            }
 
             t.textureID = texture.getTextureID();
             t.imageWidth = pixelData->width;
@@ -119,15 +136,87 @@ struct CachedImageList  : public ReferenceCountedObject,
             return t;
         }
 
+        // When an image changes, only the tiles whose contents are different get sent
+        // to the texture again, so that e.g. drawing a new column into a spectrogram
+        // doesn't mean uploading the whole thing.
+        void updateChecksums (const Image& image, RectangleList<int>* changedArea)
+        {
+            const Image::BitmapData data (image, Image::BitmapData::readOnly);
+
+            for (int ty = 0; ty < numTilesY; ++ty)
+            {
+                for (int tx = 0; tx < numTilesX; ++tx)
+                {
+                    const Rectangle<int> tile (Rectangle<int> (tx * tileSize, ty * tileSize, tileSize, tileSize)
+                                                  .getIntersection (image.getBounds()));
+                    const uint64 checksum = getChecksum (data, tile);
+                    uint64& oldChecksum = tileChecksums [tx + ty * numTilesX];
+
+                    if (changedArea != nullptr && checksum != oldChecksum)
+                        changedArea->add (tile);
+
+                    oldChecksum = checksum;
+                }
+            }
+
+            if (changedArea != nullptr && changedArea->getNumRectangles() > maxUploadsPerUpdate)
+                *changedArea = RectangleList<int> (changedArea->getBounds());
+        }
+
+        static uint64 getChecksum (const Image::BitmapData& data, const Rectangle<int>& area) noexcept
+        {
+            // (this uses a few independent lanes, so the multiplies don't all have to wait for each other)
+            uint64 lanes[4] = { 1, 2, 3, 4 };
+            const uint64 prime = 0x100000001b3ULL;
+            const int numBytes = area.getWidth() * data.pixelStride;
+
+            for (int y = area.getY(); y < area.getBottom(); ++y)
+            {
+                const uint8* p = data.getPixelPointer (area.getX(), y);
+                int i = 0;
+
+                for (; i + 32 <= numBytes; i += 32)
+                {
+                    for (int lane = 0; lane < 4; ++lane)
+                    {
+                        uint64 v;
+                        memcpy (&v, p + i + lane * 8, sizeof (v));
+                        lanes[lane] = (lanes[lane] ^ v) * prime;
+                    }
+                }
+
+                for (; i < numBytes; ++i)
+                    lanes[0] = (lanes[0] ^ p[i]) * prime;
+            }
+
+            return lanes[0] ^ (lanes[1] * 3) ^ (lanes[2] * 5) ^ (lanes[3] * 7);
+        }
+
+        enum
+        {
+            tileSize = 64,
+            maxUploadsPerUpdate = 16
+        };
+
         CachedImageList& owner;
         ImagePixelData* pixelData;
         OpenGLTexture texture;
         Time lastUsed;
         const size_t imageSize;
+        Atomic<int> needsUpdate;
+        const int numTilesX, numTilesY;
+        HeapBlock<uint64> tileChecksums;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedImage)
     };
 
+    /** Returns true if the image has a texture with this ID that doesn't need updating. */
+    bool isTextureUpToDate (ImagePixelData* const pixelData, const GLuint textureID) const
+    {
+        const CachedImage* const c = findCachedImage (pixelData);
+        return c != nullptr && c->texture.getTextureID() == textureID && c->needsUpdate.get() == 0;
+    }
+
     typedef ReferenceCountedObjectPtr<CachedImageList> Ptr;
 
 private:
@@ -142,9 +231,10 @@ private:
 
     void imageDataChanged (ImagePixelData* im) override
     {
+        // (images can be changed on any thread, so this just marks the texture as needing
+        // an update, and the changed parts are re-sent the next time that it's used)
         if (CachedImage* c = findCachedImage (im))
-            if (canUseContext())
-                c->texture.release();
+            c->needsUpdate = 1;
     }
 
     void imageDataBeingDeleted (ImagePixelData* im) override
@@ -345,7 +435,8 @@ public:
           tiledImage (context),
           tiledImageMasked (context),
           copyTexture (context),
-          maskTexture (context)
+          maskTexture (context),
+          glyphAtlas (context)
     {}
 
     typedef ReferenceCountedObjectPtr<ShaderPrograms> Ptr;
@@ -391,11 +482,13 @@ public:
 
     struct ShaderBase   : public ShaderProgramHolder
     {
-        ShaderBase (OpenGLContext& context, const char* fragmentShader, const char* vertexShader = nullptr)
+        ShaderBase (OpenGLContext& context, const char* fragmentShader, const char* vertexShader = nullptr,
+                    bool colourAttributeHoldsTexturePosition = false)
             : ShaderProgramHolder (context, fragmentShader, vertexShader),
               positionAttribute (program, "position"),
               colourAttribute (program, "colour"),
-              screenBounds (program, "screenBounds")
+              screenBounds (program, "screenBounds"),
+              colourIsTexturePosition (colourAttributeHoldsTexturePosition)
         {}
 
         void set2DBounds (const Rectangle<float>& bounds)
@@ -406,7 +499,12 @@ public:
         void bindAttributes (OpenGLContext& context)
         {
             context.extensions.glVertexAttribPointer ((GLuint) positionAttribute.attributeID, 2, GL_SHORT, GL_FALSE, 8, (void*) 0);
-            context.extensions.glVertexAttribPointer ((GLuint) colourAttribute.attributeID, 4, GL_UNSIGNED_BYTE, GL_TRUE, 8, (void*) 4);
+
+            if (colourIsTexturePosition)
+                context.extensions.glVertexAttribPointer ((GLuint) colourAttribute.attributeID, 2, GL_SHORT, GL_FALSE, 8, (void*) 4);
+            else
+                context.extensions.glVertexAttribPointer ((GLuint) colourAttribute.attributeID, 4, GL_UNSIGNED_BYTE, GL_TRUE, 8, (void*) 4);
+
             context.extensions.glEnableVertexAttribArray ((GLuint) positionAttribute.attributeID);
             context.extensions.glEnableVertexAttribArray ((GLuint) colourAttribute.attributeID);
         }
@@ -421,6 +519,7 @@ public:
 
     private:
         OpenGLShaderProgram::Uniform screenBounds;
+        const bool colourIsTexturePosition;
     };
 
     struct MaskedShaderParams
@@ -786,6 +885,70 @@ public:
         ImageParams imageParams;
     };
 
+    struct GlyphAtlasProgram  : public ShaderBase
+    {
+        GlyphAtlasProgram (OpenGLContext& context)
+            : ShaderBase (context,
+                          "uniform sampler2D atlasTexture;"
+                          "uniform " JUCE_MEDIUMP " vec4 glyphColour;"
+                          "uniform " JUCE_MEDIUMP " float alphaScale;"
+                          "varying " JUCE_HIGHP " vec2 texturePos;"
+                          "void main()"
+                          "{"
+                            "gl_FragColor = glyphColour * min (1.0, alphaScale * texture2D (atlasTexture, texturePos).a);"
+                          "}",
+                          "attribute vec2 position;"
+                          "attribute vec2 colour;" // (this holds the atlas texel position of each corner)
+                          "uniform vec4 screenBounds;"
+                          "uniform " JUCE_HIGHP " float atlasScale;"
+                          "varying " JUCE_HIGHP " vec2 texturePos;"
+                          "void main()"
+                          "{"
+                            "texturePos = colour * atlasScale;"
+                            "vec2 scaledPos = (position - screenBounds.xy) / screenBounds.zw;"
+                            "gl_Position = vec4 (scaledPos.x - 1.0, 1.0 - scaledPos.y, 0, 1.0);"
+                          "}",
+                          true),
+              atlasTexture (program, "atlasTexture"),
+              glyphColour (program, "glyphColour"),
+              alphaScale (program, "alphaScale"),
+              atlasScale (program, "atlasScale"),
+              currentAtlasSize (0), currentColour (0), currentAlphaScale (-1.0f)
+        {}
+
+        // These uniforms stay the same for long runs of glyphs, so they're
+        // only changed (and the pending quads flushed) when they differ.
+        template <class QuadQueueType>
+        void setParameters (QuadQueueType& quadQueue, int atlasSize, PixelARGB colour, float newAlphaScale)
+        {
+            if (atlasSize != currentAtlasSize)
+            {
+                quadQueue.flush();
+                currentAtlasSize = atlasSize;
+                atlasTexture.set ((GLint) 0);
+                atlasScale.set (1.0f / (float) atlasSize);
+            }
+
+            if (colour.getARGB() != currentColour || newAlphaScale != currentAlphaScale)
+            {
+                quadQueue.flush();
+                currentColour = colour.getARGB();
+                currentAlphaScale = newAlphaScale;
+
+                glyphColour.set (colour.getRed()   / 255.0f, colour.getGreen() / 255.0f,
+                                 colour.getBlue()  / 255.0f, colour.getAlpha() / 255.0f);
+                alphaScale.set (newAlphaScale);
+            }
+        }
+
+        OpenGLShaderProgram::Uniform atlasTexture, glyphColour, alphaScale, atlasScale;
+
+    private:
+        int currentAtlasSize;
+        uint32 currentColour;
+        float currentAlphaScale;
+    };
+
     SolidColourProgram solidColourProgram;
     SolidColourMaskedProgram solidColourMasked;
     RadialGradientProgram radialGradient;
@@ -800,6 +963,7 @@ public:
     TiledImageMaskedProgram tiledImageMasked;
     CopyTextureProgram copyTexture;
     MaskTextureProgram maskTexture;
+    GlyphAtlasProgram glyphAtlas;
 };
 
 //==============================================================================
@@ -862,21 +1026,37 @@ struct StateHelpers
                 setPremultipliedBlendingMode (quadQueue);
         }
 
+        bool isPremultipliedBlending() const noexcept
+        {
+            return blendingEnabled && srcFunction == GL_ONE && dstFunction == GL_ONE_MINUS_SRC_ALPHA;
+        }
+
     private:
         bool blendingEnabled;
         GLenum srcFunction, dstFunction;
     };
 
     //==============================================================================
+    // Edge tables and rectangle lists are iterated one line at a time, but most lines of a
+    // typical shape (or all the lines of a rectangle or image) are the same as the line
+    // above. So each line's runs are held back until the line is finished, and if they match
+    // the previous line, the quads that were added for that line are just made taller.
     template <class QuadQueueType>
     struct EdgeTableRenderer
     {
         EdgeTableRenderer (QuadQueueType& q, const PixelARGB c) noexcept
-            : quadQueue (q), colour (c)
+            : quadQueue (q), colour (c), currentY (0),
+              numRuns (0), numPreviousRuns (0), previousBottom (0), canMergeLine (true)
         {}
 
+        ~EdgeTableRenderer() noexcept
+        {
+            finishLine();
+        }
+
         void setEdgeTableYPos (const int y) noexcept
         {
+            finishLine();
             currentY = y;
         }
 
@@ -884,30 +1064,120 @@ struct StateHelpers
         {
             PixelARGB c (colour);
             c.multiplyAlpha (alphaLevel);
-            quadQueue.add (x, currentY, 1, 1, c);
+            addRun (x, 1, c);
         }
 
         void handleEdgeTablePixelFull (const int x) noexcept
         {
-            quadQueue.add (x, currentY, 1, 1, colour);
+            addRun (x, 1, colour);
         }
 
         void handleEdgeTableLine (const int x, const int width, const int alphaLevel) noexcept
         {
             PixelARGB c (colour);
             c.multiplyAlpha (alphaLevel);
-            quadQueue.add (x, currentY, width, 1, c);
+            addRun (x, width, c);
         }
 
         void handleEdgeTableLineFull (const int x, const int width) noexcept
         {
-            quadQueue.add (x, currentY, width, 1, colour);
+            addRun (x, width, colour);
         }
 
     private:
+        struct Run
+        {
+            int x, width;
+            uint32 colour;
+
+            bool operator!= (const Run& other) const noexcept
+            {
+                return x != other.x || width != other.width || colour != other.colour;
+            }
+        };
+
+        enum { maxRunsPerLine = 32 };
+
         QuadQueueType& quadQueue;
         const PixelARGB colour;
         int currentY;
+        Run runs [maxRunsPerLine], previousRuns [maxRunsPerLine];
+        int numRuns, numPreviousRuns, previousBottom;
+        bool canMergeLine;
+
+        void addRun (const int x, const int width, const PixelARGB c) noexcept
+        {
+            if (numRuns > 0 && canMergeLine)
+            {
+                // (the edge table often sends a line's first pixel on its own, so join it up)
+                Run& last = runs [numRuns - 1];
+
+                if (last.x + last.width == x && last.colour == c.getARGB())
+                {
+                    last.width += width;
+                    return;
+                }
+            }
+
+            if (numRuns < maxRunsPerLine && canMergeLine)
+            {
+                Run& r = runs [numRuns++];
+                r.x = x;
+                r.width = width;
+                r.colour = c.getARGB();
+            }
+            else
+            {
+                // (a line with too many runs to keep track of is just added as it goes along)
+                if (canMergeLine)
+                {
+                    addRunsToQueue();
+                    canMergeLine = false;
+                }
+
+                quadQueue.add (x, currentY, width, 1, c);
+            }
+        }
+
+        void addRunsToQueue() noexcept
+        {
+            for (int i = 0; i < numRuns; ++i)
+                quadQueue.add (runs[i].x, currentY, runs[i].width, 1, PixelARGB (runs[i].colour));
+        }
+
+        bool matchesPreviousLine() const noexcept
+        {
+            if (numRuns != numPreviousRuns || currentY != previousBottom)
+                return false;
+
+            for (int i = 0; i < numRuns; ++i)
+                if (runs[i] != previousRuns[i])
+                    return false;
+
+            return true;
+        }
+
+        void finishLine() noexcept
+        {
+            if (! canMergeLine)
+            {
+                numPreviousRuns = 0;
+            }
+            else if (numRuns > 0)
+            {
+                if (! (matchesPreviousLine() && quadQueue.extendLastQuads (numRuns, currentY + 1)))
+                {
+                    addRunsToQueue();
+                    memcpy (previousRuns, runs, sizeof (Run) * (size_t) numRuns);
+                    numPreviousRuns = numRuns;
+                }
+
+                previousBottom = currentY + 1;
+            }
+
+            numRuns = 0;
+            canMergeLine = true;
+        }
 
         JUCE_DECLARE_NON_COPYABLE (EdgeTableRenderer)
     };
@@ -1045,6 +1315,11 @@ struct StateHelpers
             }
         }
 
+        bool isSingleTextureBound (const GLuint textureID) const noexcept
+        {
+            return texturesEnabled == 1 && currentActiveTexture == 0 && currentTextureID[0] == textureID;
+        }
+
     private:
         GLuint currentTextureID [3];
         int texturesEnabled, currentActiveTexture;
@@ -1057,7 +1332,7 @@ struct StateHelpers
     struct TextureCache
     {
         TextureCache() noexcept
-            : activeGradientIndex (0), gradientNeedsRefresh (true)
+            : gradientNeedsRefresh (true)
         {}
 
         OpenGLTexture* getTexture (ActiveTextures& activeTextures, int w, int h)
@@ -1089,33 +1364,81 @@ struct StateHelpers
             {
                 gradientNeedsRefresh = false;
 
-                if (gradientTextures.size() < numGradientTexturesToCache)
+                const uint32 hash = RenderingHelpers::GradientLookupTableCache::getColourHash (gradient);
+                const int existing = findGradientTexture (gradient, hash);
+
+                // (the end of the list is the most recently used texture, and is the active one)
+                if (existing >= 0)
                 {
-                    activeGradientIndex = gradientTextures.size();
-                    activeTextures.clear();
-                    gradientTextures.add (new OpenGLTexture());
+                    gradientTextures.move (existing, gradientTextures.size() - 1);
                 }
                 else
                 {
-                    activeGradientIndex = (activeGradientIndex + 1) % numGradientTexturesToCache;
-                }
+                    if (gradientTextures.size() < numGradientTexturesToCache)
+                    {
+                        activeTextures.clear();
+                        gradientTextures.add (new GradientTexture());
+                    }
+                    else
+                    {
+                        gradientTextures.move (0, gradientTextures.size() - 1);
+                    }
 
-                JUCE_CHECK_OPENGL_ERROR;
-                PixelARGB lookup [gradientTextureSize];
-                gradient.createLookupTable (lookup, gradientTextureSize);
-                gradientTextures.getUnchecked (activeGradientIndex)->loadARGB (lookup, gradientTextureSize, 1);
+                    GradientTexture& t = *gradientTextures.getLast();
+                    t.gradient = gradient;
+                    t.hash = hash;
+
+                    JUCE_CHECK_OPENGL_ERROR;
+                    PixelARGB lookup [gradientTextureSize];
+                    gradient.createLookupTable (lookup, gradientTextureSize);
+                    t.texture.loadARGB (lookup, gradientTextureSize, 1);
+                }
             }
 
-            activeTextures.bindTexture (gradientTextures.getUnchecked (activeGradientIndex)->getTextureID());
+            activeTextures.bindTexture (gradientTextures.getLast()->texture.getTextureID());
+        }
+
+        /** Returns the texture that the last gradient was drawn with, or 0 if the next
+            gradient will need a new one.
+        */
+        GLuint getCurrentGradientTextureID() const noexcept
+        {
+            if (gradientNeedsRefresh || gradientTextures.size() == 0)
+                return 0;
+
+            return gradientTextures.getLast()->texture.getTextureID();
         }
 
         enum { gradientTextureSize = 256 };
 
     private:
-        enum { numTexturesToCache = 8, numGradientTexturesToCache = 10 };
-        OwnedArray<OpenGLTexture> textures, gradientTextures;
-        int activeGradientIndex;
+        enum { numTexturesToCache = 8, numGradientTexturesToCache = 32 };
+
+        struct GradientTexture
+        {
+            GradientTexture() noexcept : hash (0) {}
+
+            OpenGLTexture texture;
+            ColourGradient gradient;
+            uint32 hash;
+        };
+
+        OwnedArray<OpenGLTexture> textures;
+        OwnedArray<GradientTexture> gradientTextures;
         bool gradientNeedsRefresh;
+
+        int findGradientTexture (const ColourGradient& gradient, const uint32 hash) const noexcept
+        {
+            for (int i = gradientTextures.size(); --i >= 0;)
+            {
+                const GradientTexture& t = *gradientTextures.getUnchecked (i);
+
+                if (t.hash == hash && RenderingHelpers::GradientLookupTableCache::haveSameColours (t.gradient, gradient))
+                    return i;
+            }
+
+            return -1;
+        }
     };
 
     //==============================================================================
@@ -1209,17 +1532,60 @@ struct StateHelpers
             et.iterate (etr);
         }
 
+        /** Adds a quad whose vertices carry texture positions instead of a colour,
+            for use with a shader whose colour attribute holds texture positions.
+        */
+        void addTextured (const Rectangle<int>& r, const Point<int> texturePos) noexcept
+        {
+            jassert (! r.isEmpty());
+
+            VertexInfo* const v = vertexData + numVertices;
+            v[0].x = v[2].x = (GLshort) r.getX();
+            v[0].y = v[1].y = (GLshort) r.getY();
+            v[1].x = v[3].x = (GLshort) r.getRight();
+            v[2].y = v[3].y = (GLshort) r.getBottom();
+
+            v[0].texturePos[0] = v[2].texturePos[0] = (GLshort) texturePos.x;
+            v[0].texturePos[1] = v[1].texturePos[1] = (GLshort) texturePos.y;
+            v[1].texturePos[0] = v[3].texturePos[0] = (GLshort) (texturePos.x + r.getWidth());
+            v[2].texturePos[1] = v[3].texturePos[1] = (GLshort) (texturePos.y + r.getHeight());
+
+            numVertices += 4;
+
+            if (numVertices > numQuads * 4 - 4)
+                draw();
+        }
+
         void flush() noexcept
         {
             if (numVertices > 0)
                 draw();
         }
 
+        /** Moves the bottom edge of the most recently added quads down, as long as they're
+            all still waiting to be drawn. Returns false if any of them have gone.
+        */
+        bool extendLastQuads (const int numQuadsToExtend, const int newBottom) noexcept
+        {
+            if (numVertices < numQuadsToExtend * 4)
+                return false;
+
+            for (VertexInfo* v = vertexData + numVertices - numQuadsToExtend * 4; v < vertexData + numVertices; v += 4)
+                v[2].y = v[3].y = (GLshort) newBottom;
+
+            return true;
+        }
+
     private:
         struct VertexInfo
         {
             GLshort x, y;
-            GLuint colour;
+
+            union
+            {
+                GLuint colour;
+                GLshort texturePos[2];
+            };
         };
 
         enum { numQuads = 256 };
@@ -1291,6 +1657,11 @@ struct StateHelpers
             setShader (target.bounds, quadQueue, shader);
         }
 
+        ShaderPrograms::ShaderBase* getActiveShader (const Rectangle<int>& bounds) const noexcept
+        {
+            return bounds == currentBounds ? activeShader : nullptr;
+        }
+
         void clearShader (ShaderQuadQueue& quadQueue)
         {
             if (activeShader != nullptr)
@@ -1313,6 +1684,237 @@ struct StateHelpers
     };
 };
 
+//==============================================================================
+// Keeps rasterised glyphs in a single alpha texture for each OpenGLContext, so that runs
+// of text can be drawn as textured quads rather than one quad per span of each glyph.
+struct GlyphAtlas  : public ReferenceCountedObject
+{
+    GlyphAtlas() noexcept
+        : shelfX (0), shelfY (0), shelfHeight (0), lastFontUsed (nullptr),
+          generation (getGeneration().get())
+    {}
+
+    static GlyphAtlas* get (OpenGLContext& c)
+    {
+        const char atlasValueID[] = "GlyphAtlas";
+        GlyphAtlas* atlas = static_cast<GlyphAtlas*> (c.getAssociatedObject (atlasValueID));
+
+        if (atlas == nullptr)
+        {
+            atlas = new GlyphAtlas();
+            c.setAssociatedObject (atlasValueID, atlas);
+        }
+
+        return atlas;
+    }
+
+    /** Bumping this makes every atlas discard its contents the next time it's used. */
+    static Atomic<int>& getGeneration() noexcept
+    {
+        static Atomic<int> generation;
+        return generation;
+    }
+
+    enum
+    {
+        atlasSize = 1024,
+        maxGlyphSize = 128,
+        numSubPixelPositions = 4
+    };
+
+    struct Glyph
+    {
+        Rectangle<int> area;    // relative to the glyph's integer drawing position
+        Point<int> atlasPos;
+    };
+
+    /** Finds or rasterises a glyph, returning false if it's too big to go in the atlas.
+        Because this may need to change the texture, the queue is flushed before any glyph
+        is added.
+    */
+    bool getGlyph (const Font& font, const int glyphNumber, const int subPixelPosition, Glyph& result,
+                   StateHelpers::ActiveTextures& activeTextures, StateHelpers::ShaderQuadQueue& quadQueue)
+    {
+        if (generation != getGeneration().get())
+            clear();
+
+        FontGlyphs& fontGlyphs = getGlyphsForFont (font);
+        const int key = glyphNumber * numSubPixelPositions + subPixelPosition;
+
+        if (fontGlyphs.glyphs.contains (key))
+        {
+            result = fontGlyphs.glyphs [key];
+            return true;
+        }
+
+        const float fontHeight = font.getHeight();
+        ScopedPointer<EdgeTable> et (font.getTypeface()->getEdgeTableForGlyph (glyphNumber,
+                                                                               AffineTransform::scale (fontHeight * font.getHorizontalScale(),
+                                                                                                       fontHeight), fontHeight));
+        Glyph glyph;
+
+        if (et != nullptr)
+        {
+            et->translate (subPixelPosition / (float) numSubPixelPositions, 0);
+            glyph.area = et->getMaximumBounds();
+
+            if (glyph.area.getWidth() > maxGlyphSize || glyph.area.getHeight() > maxGlyphSize)
+                return false;
+
+            quadQueue.flush();
+
+            if (! allocateSpace (glyph))
+            {
+                clear(); // (this also discards the FontGlyphs object we're using)
+                return getGlyph (font, glyphNumber, subPixelPosition, result, activeTextures, quadQueue);
+            }
+
+            upload (*et, glyph, activeTextures);
+        }
+
+        fontGlyphs.glyphs.set (key, glyph);
+        result = glyph;
+        return true;
+    }
+
+    int getTextureID() const noexcept      { return (int) texture.getTextureID(); }
+
+    typedef ReferenceCountedObjectPtr<GlyphAtlas> Ptr;
+
+private:
+    struct FontGlyphs
+    {
+        FontGlyphs (const Font& f) : font (f) {}
+
+        const Font font;
+        HashMap<int, Glyph> glyphs;
+
+        JUCE_DECLARE_NON_COPYABLE (FontGlyphs)
+    };
+
+    struct AlphaMapRenderer
+    {
+        AlphaMapRenderer (uint8* d, const Rectangle<int>& r) noexcept
+            : data (d), area (r), currentLine (nullptr)
+        {}
+
+        void setEdgeTableYPos (const int y) noexcept
+        {
+            currentLine = data + (y - area.getY()) * area.getWidth() - area.getX();
+        }
+
+        void handleEdgeTablePixel (const int x, const int alphaLevel) const noexcept    { currentLine[x] = (uint8) alphaLevel; }
+        void handleEdgeTablePixelFull (const int x) const noexcept                      { currentLine[x] = 255; }
+        void handleEdgeTableLine (int x, int width, const int alphaLevel) const noexcept { memset (currentLine + x, alphaLevel, (size_t) width); }
+        void handleEdgeTableLineFull (int x, int width) const noexcept                  { memset (currentLine + x, 255, (size_t) width); }
+
+    private:
+        uint8* const data;
+        const Rectangle<int> area;
+        uint8* currentLine;
+
+        JUCE_DECLARE_NON_COPYABLE (AlphaMapRenderer)
+    };
+
+    friend struct ContainerDeletePolicy<FontGlyphs>;
+    OwnedArray<FontGlyphs> fonts;
+    OpenGLTexture texture;
+    int shelfX, shelfY, shelfHeight;
+    FontGlyphs* lastFontUsed;
+    int generation;
+
+    FontGlyphs& getGlyphsForFont (const Font& font)
+    {
+        if (lastFontUsed != nullptr && lastFontUsed->font == font)
+            return *lastFontUsed;
+
+        for (int i = fonts.size(); --i >= 0;)
+        {
+            FontGlyphs* const f = fonts.getUnchecked (i);
+
+            if (f->font == font)
+                return *(lastFontUsed = f);
+        }
+
+        return *(lastFontUsed = fonts.add (new FontGlyphs (font)));
+    }
+
+    void clear()
+    {
+        fonts.clear();
+        lastFontUsed = nullptr;
+        shelfX = shelfY = shelfHeight = 0;
+        generation = getGeneration().get();
+    }
+
+    // Glyphs are packed into horizontal shelves, leaving a one-pixel gap around each one
+    bool allocateSpace (Glyph& glyph) noexcept
+    {
+        const int w = glyph.area.getWidth() + 1;
+        const int h = glyph.area.getHeight() + 1;
+
+        if (shelfX + w > atlasSize)
+        {
+            shelfX = 0;
+            shelfY += shelfHeight;
+            shelfHeight = 0;
+        }
+
+        if (shelfY + h > atlasSize)
+            return false;
+
+        glyph.atlasPos = Point<int> (shelfX, shelfY);
+        shelfX += w;
+        shelfHeight = jmax (shelfHeight, h);
+        return true;
+    }
+
+    void upload (const EdgeTable& et, const Glyph& glyph, StateHelpers::ActiveTextures& activeTextures)
+    {
+        if (texture.getTextureID() == 0)
+        {
+            activeTextures.clear();
+            texture.loadAlpha (nullptr, atlasSize, atlasSize);
+        }
+
+        HeapBlock<uint8> data ((size_t) (glyph.area.getWidth() * glyph.area.getHeight()), true);
+        AlphaMapRenderer renderer (data, glyph.area);
+        et.iterate (renderer);
+
+        activeTextures.setActiveTexture (0);
+        activeTextures.bindTexture (texture.getTextureID());
+        glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D (GL_TEXTURE_2D, 0, glyph.atlasPos.x, glyph.atlasPos.y,
+                         glyph.area.getWidth(), glyph.area.getHeight(),
+                         GL_ALPHA, GL_UNSIGNED_BYTE, data);
+        JUCE_CHECK_OPENGL_ERROR
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GlyphAtlas)
+};
+
+//==============================================================================
+/** The cache of path edge tables that's kept for each context. */
+struct PathEdgeTableCache  : public ReferenceCountedObject,
+                             public RenderingHelpers::PathEdgeTableCache
+{
+    static PathEdgeTableCache* get (OpenGLContext& c)
+    {
+        const char cacheValueID[] = "PathEdgeTableCache";
+        PathEdgeTableCache* cache = static_cast<PathEdgeTableCache*> (c.getAssociatedObject (cacheValueID));
+
+        if (cache == nullptr)
+        {
+            cache = new PathEdgeTableCache();
+            c.setAssociatedObject (cacheValueID, cache);
+        }
+
+        return cache;
+    }
+
+    typedef ReferenceCountedObjectPtr<PathEdgeTableCache> Ptr;
+};
+
 //==============================================================================
 class GLState
 {
@@ -1322,6 +1924,8 @@ public:
           activeTextures (t.context),
           currentShader (t.context),
           shaderQuadQueue (t.context),
+          lastGradientShader (nullptr), lastImageShader (nullptr),
+          lastImageData (nullptr), lastImageTexture (0), lastImageWasTiled (false),
           previousFrameBufferTarget (OpenGLFrameBuffer::getCurrentFrameBufferTarget())
     {
         // This object can only be created and used when the current thread has an active OpenGL context.
@@ -1334,6 +1938,8 @@ public:
         activeTextures.clear();
         shaderQuadQueue.initialise();
         cachedImageList = CachedImageList::get (t.context);
+        glyphAtlas = GlyphAtlas::get (t.context);
+        pathCache = PathEdgeTableCache::get (t.context);
         JUCE_CHECK_OPENGL_ERROR
     }
 
@@ -1356,9 +1962,29 @@ public:
         JUCE_CHECK_OPENGL_ERROR
     }
 
+    // Consecutive fills that use the same gradient (e.g. the segments of a level meter) can
+    // keep adding to the same batch of quads, as long as nothing has changed the shader,
+    // texture or blending state in between.
+    bool canReuseGradientState (const AffineTransform& transform) const noexcept
+    {
+        const GLuint gradientTexture = textureCache.getCurrentGradientTextureID();
+
+        return lastGradientShader != nullptr
+                && gradientTexture != 0
+                && transform == lastGradientTransform
+                && currentShader.getActiveShader (target.bounds) == lastGradientShader
+                && activeTextures.isSingleTextureBound (gradientTexture)
+                && blendMode.isPremultipliedBlending();
+    }
+
     void setShaderForGradientFill (const ColourGradient& g, const AffineTransform& transform,
                                    const int maskTextureID, const Rectangle<int>* const maskArea)
     {
+        if (maskArea == nullptr && canReuseGradientState (transform))
+            return;
+
+        lastGradientShader = nullptr;
+
         JUCE_CHECK_OPENGL_ERROR
         activeTextures.disableTextures (shaderQuadQueue);
         blendMode.setPremultipliedBlendingMode (shaderQuadQueue);
@@ -1453,10 +2079,46 @@ public:
 
         if (maskParams != nullptr)
             maskParams->setBounds (*maskArea, target, 1);
+        else
+            lastGradientShader = currentShader.getActiveShader (target.bounds);
 
+        lastGradientTransform = transform;
         JUCE_CHECK_OPENGL_ERROR
     }
 
+    // The same goes for drawing an image again with the same transform, e.g. when it's
+    // drawn through a clip region made of several pieces.
+    bool canReuseImageState (const Image& image, const AffineTransform& transform, bool isTiledFill) const
+    {
+        return lastImageShader != nullptr
+                && image.getPixelData() == lastImageData
+                && isTiledFill == lastImageWasTiled
+                && transform == lastImageTransform
+                && currentShader.getActiveShader (target.bounds) == lastImageShader
+                && activeTextures.isSingleTextureBound (lastImageTexture)
+                && blendMode.isPremultipliedBlending()
+                && cachedImageList->isTextureUpToDate (lastImageData, lastImageTexture);
+    }
+
+    void setShaderForImage (const Image& image, const AffineTransform& transform, bool isTiledFill)
+    {
+        if (canReuseImageState (image, transform, isTiledFill))
+            return;
+
+        // (this has to happen before getting the texture, as that might update or delete
+        // textures that the pending quads are using)
+        shaderQuadQueue.flush();
+
+        const TextureInfo textureInfo (cachedImageList->getTextureFor (image));
+        setShaderForTiledImageFill (textureInfo, transform, 0, nullptr, isTiledFill);
+
+        lastImageShader = currentShader.getActiveShader (target.bounds);
+        lastImageData = image.getPixelData();
+        lastImageTexture = textureInfo.textureID;
+        lastImageTransform = transform;
+        lastImageWasTiled = isTiledFill;
+    }
+
     void setShaderForTiledImageFill (const TextureInfo& textureInfo, const AffineTransform& transform,
                                      const int maskTextureID, const Rectangle<int>* const maskArea, bool isTiledFill)
     {
@@ -1516,8 +2178,18 @@ public:
     StateHelpers::ShaderQuadQueue shaderQuadQueue;
 
     CachedImageList::Ptr cachedImageList;
+    GlyphAtlas::Ptr glyphAtlas;
+    PathEdgeTableCache::Ptr pathCache;
 
 private:
+    ShaderPrograms::ShaderBase* lastGradientShader;
+    AffineTransform lastGradientTransform;
+    ShaderPrograms::ShaderBase* lastImageShader;
+    ImagePixelData* lastImageData;
+    GLuint lastImageTexture;
+    AffineTransform lastImageTransform;
+    bool lastImageWasTiled;
+
     GLuint previousFrameBufferTarget;
 };
 
@@ -1578,6 +2250,17 @@ public:
         }
     }
 
+    void fillPath (const Path& path, const AffineTransform& t)
+    {
+        if (clip != nullptr)
+        {
+            if (EdgeTableRegionType* const cached = state->pathCache->createRegionFor<EdgeTableRegionType> (path, transform.getTransformWith (t)))
+                fillShape (cached, false);
+            else
+                BaseClass::fillPath (path, t);
+        }
+    }
+
     typedef RenderingHelpers::GlyphCache <RenderingHelpers::CachedGlyphEdgeTable <SavedState>, SavedState> GlyphCacheType;
 
     void drawGlyph (int glyphNumber, const AffineTransform& trans)
@@ -1586,27 +2269,26 @@ public:
         {
             if (trans.isOnlyTranslation() && ! transform.isRotated)
             {
-                GlyphCacheType& cache = GlyphCacheType::getInstance();
-
                 Point<float> pos (trans.getTranslationX(), trans.getTranslationY());
+                Font f (font);
 
                 if (transform.isOnlyTranslated)
                 {
-                    cache.drawGlyph (*this, font, glyphNumber, pos + transform.offset.toFloat());
+                    pos += transform.offset.toFloat();
                 }
                 else
                 {
                     pos = transform.transformed (pos);
 
-                    Font f (font);
                     f.setHeight (font.getHeight() * transform.complexTransform.mat11);
 
                     const float xScale = transform.complexTransform.mat00 / transform.complexTransform.mat11;
                     if (std::abs (xScale - 1.0f) > 0.01f)
                         f.setHorizontalScale (xScale);
-
-                    cache.drawGlyph (*this, f, glyphNumber, pos);
                 }
+
+                if (! drawGlyphFromAtlas (f, glyphNumber, pos))
+                    GlyphCacheType::getInstance().drawGlyph (*this, f, glyphNumber, pos);
             }
             else
             {
@@ -1623,6 +2305,64 @@ public:
         }
     }
 
+    // Solid-coloured glyphs inside a rectangular clip region are drawn straight from the
+    // glyph atlas. Anything else goes through the edge-table glyph cache.
+    bool drawGlyphFromAtlas (const Font& f, const int glyphNumber, Point<float> pos)
+    {
+        if (isUsingCustomShader || ! fillType.isColour())
+            return false;
+
+        const RectangleListRegionType* const rectangleClip = dynamic_cast<const RectangleListRegionType*> (clip.get());
+
+        if (rectangleClip == nullptr)
+            return false;
+
+        if (f.getTypeface()->isHinted())
+            pos.x = std::floor (pos.x + 0.5f);
+
+        const float wholeX = std::floor (pos.x);
+        Point<int> origin ((int) wholeX, roundToInt (pos.y));
+        int subPixelPosition = roundToInt ((pos.x - wholeX) * GlyphAtlas::numSubPixelPositions);
+
+        if (subPixelPosition >= GlyphAtlas::numSubPixelPositions)
+        {
+            subPixelPosition = 0;
+            ++origin.x;
+        }
+
+        GlyphAtlas::Glyph glyph;
+
+        if (! state->glyphAtlas->getGlyph (f, glyphNumber, subPixelPosition, glyph,
+                                           state->activeTextures, state->shaderQuadQueue))
+            return false;
+
+        const Rectangle<int> glyphArea (glyph.area + origin);
+
+        if (glyphArea.isEmpty() || ! rectangleClip->clip.intersects (glyphArea))
+            return true;
+
+        // (this matches the level boost that SavedStateBase::fillEdgeTable applies to bright text)
+        const float brightness = fillType.colour.getBrightness() - 0.5f;
+        ShaderPrograms::GlyphAtlasProgram& program = state->currentShader.programs->glyphAtlas;
+
+        state->blendMode.setPremultipliedBlendingMode (state->shaderQuadQueue);
+        state->setShader (program);
+        state->activeTextures.setSingleTextureMode (state->shaderQuadQueue);
+        state->activeTextures.bindTexture ((GLuint) state->glyphAtlas->getTextureID());
+        program.setParameters (state->shaderQuadQueue, (int) GlyphAtlas::atlasSize, fillType.colour.getPixelARGB(),
+                               brightness > 0.0f ? 1.0f + 1.6f * brightness : 1.0f);
+
+        for (const Rectangle<int>* r = rectangleClip->clip.begin(), * const e = rectangleClip->clip.end(); r != e; ++r)
+        {
+            const Rectangle<int> area (r->getIntersection (glyphArea));
+
+            if (! area.isEmpty())
+                state->shaderQuadQueue.addTextured (area, glyph.atlasPos + (area.getPosition() - glyphArea.getPosition()));
+        }
+
+        return true;
+    }
+
     Rectangle<int> getMaximumBounds() const     { return state->target.bounds; }
 
     void setFillType (const FillType& newFill)
@@ -1636,13 +2376,8 @@ public:
     void renderImageTransformed (IteratorType& iter, const Image& src, const int alpha,
                                  const AffineTransform& trans, Graphics::ResamplingQuality, bool tiledFill) const
     {
-        state->shaderQuadQueue.flush();
-        state->setShaderForTiledImageFill (state->cachedImageList->getTextureFor (src), trans, 0, nullptr, tiledFill);
-
+        state->setShaderForImage (src, trans, tiledFill);
         state->shaderQuadQueue.add (iter, PixelARGB ((uint8) alpha, (uint8) alpha, (uint8) alpha, (uint8) alpha));
-        state->shaderQuadQueue.flush();
-
-        state->currentShader.clearShader (state->shaderQuadQueue);
     }
 
     template <typename IteratorType>
@@ -1792,6 +2527,7 @@ void clearOpenGLGlyphCache();
 void clearOpenGLGlyphCache()
 {
     OpenGLRendering::SavedState::GlyphCacheType::getInstance().reset();
+    ++(OpenGLRendering::GlyphAtlas::getGeneration());
 }
 
 
@@ -32,7 +32,8 @@ static int getAllowedTextureSize (int x)
 }
 
 OpenGLTexture::OpenGLTexture()
-    : textureID (0), width (0), height (0), ownerContext (nullptr)
+    : textureID (0), width (0), height (0), imageWidth (0), imageHeight (0),
+      ownerContext (nullptr), isShared (false)
 {
 }
 
@@ -56,6 +57,8 @@ void OpenGLTexture::create (const int w, const int h, const void* pixels, GLenum
 
     if (textureID == 0)
     {
+        isShared = ownerContext != nullptr && ownerContext->isSharingResources();
+
         JUCE_CHECK_OPENGL_ERROR
         glGenTextures (1, &textureID);
         glBindTexture (GL_TEXTURE_2D, textureID);
@@ -74,6 +77,7 @@ void OpenGLTexture::create (const int w, const int h, const void* pixels, GLenum
     glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
     JUCE_CHECK_OPENGL_ERROR
 
+    imageWidth = imageHeight = 0;
     width  = getAllowedTextureSize (w);
     height = getAllowedTextureSize (h);
 
@@ -96,6 +100,79 @@ void OpenGLTexture::create (const int w, const int h, const void* pixels, GLenum
     JUCE_CHECK_OPENGL_ERROR
 }
 
+//==============================================================================
+#if ! JUCE_OPENGL_ES
+// A few pixel buffer objects that texture updates take turns to use, so that an update
+// doesn't have to wait for the GPU to finish reading the previous one.
+struct PixelUploadBuffers  : public ReferenceCountedObject
+{
+    PixelUploadBuffers (OpenGLContext& c)  : context (c), nextBuffer (0)
+    {
+        zeromem (buffers, sizeof (buffers));
+
+        if (isSupported())
+            context.extensions.glGenBuffers (numBuffers, buffers);
+    }
+
+    ~PixelUploadBuffers()
+    {
+        if (buffers[0] != 0)
+            context.extensions.glDeleteBuffers (numBuffers, buffers);
+    }
+
+    static PixelUploadBuffers& get (OpenGLContext& c)
+    {
+        const char buffersValueID[] = "jucePixelUploadBuffers";
+        PixelUploadBuffers* b = static_cast<PixelUploadBuffers*> (c.getAssociatedObject (buffersValueID));
+
+        if (b == nullptr)
+        {
+            b = new PixelUploadBuffers (c);
+            c.setAssociatedObject (buffersValueID, b);
+        }
+
+        return *b;
+    }
+
+    bool upload (int x, int y, int w, int h, GLenum type, const void* pixels, size_t numBytes)
+    {
+        if (buffers[0] == 0)
+            return false;
+
+        context.extensions.glBindBuffer (GL_PIXEL_UNPACK_BUFFER, buffers[nextBuffer]);
+        nextBuffer = (nextBuffer + 1) % numBuffers;
+
+        // (giving the buffer a new store each time lets the driver hand out fresh memory
+        // if the GPU is still busy with the old contents)
+        context.extensions.glBufferData (GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr) numBytes, pixels, GL_STREAM_DRAW);
+        glTexSubImage2D (GL_TEXTURE_2D, 0, x, y, w, h, type, GL_UNSIGNED_BYTE, nullptr);
+        context.extensions.glBindBuffer (GL_PIXEL_UNPACK_BUFFER, 0);
+        JUCE_CHECK_OPENGL_ERROR
+        return true;
+    }
+
+private:
+    enum { numBuffers = 3 };
+
+    OpenGLContext& context;
+    GLuint buffers[numBuffers];
+    int nextBuffer;
+
+    static bool isSupported()
+    {
+        const char* const version = (const char*) glGetString (GL_VERSION);
+
+        if (version != nullptr && String (version).getDoubleValue() >= 2.1)
+            return true;
+
+        return OpenGLHelpers::isExtensionSupported ("GL_ARB_pixel_buffer_object");
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (PixelUploadBuffers)
+};
+#endif
+
+//==============================================================================
 template <class PixelType>
 struct Flipper
 {
@@ -130,6 +207,13 @@ void OpenGLTexture::loadImage (const Image& image)
     const int imageW = image.getWidth();
     const int imageH = image.getHeight();
 
+    if (textureID != 0 && imageW == imageWidth && imageH == imageHeight
+         && OpenGLContext::getCurrentContext() == ownerContext)
+    {
+        updateImageArea (image, image.getBounds());
+        return;
+    }
+
     HeapBlock<PixelARGB> dataCopy;
     Image::BitmapData srcData (image, Image::BitmapData::readOnly);
 
@@ -142,6 +226,50 @@ void OpenGLTexture::loadImage (const Image& image)
     }
 
     create (imageW, imageH, dataCopy, JUCE_RGBA_FORMAT, true);
+    imageWidth  = imageW;
+    imageHeight = imageH;
+}
+
+void OpenGLTexture::updateImageArea (const Image& image, const Rectangle<int>& area)
+{
+    // This can only be used on a texture that was made from an image of the same size!
+    jassert (textureID != 0 && image.getWidth() <= width && image.getHeight() <= height);
+
+    const Rectangle<int> r (area.getIntersection (image.getBounds()));
+
+    if (textureID == 0 || r.isEmpty())
+        return;
+
+    HeapBlock<PixelARGB> dataCopy;
+
+    {
+        const Image::BitmapData srcData (image, r.getX(), r.getY(), r.getWidth(), r.getHeight());
+
+        switch (srcData.pixelFormat)
+        {
+            case Image::ARGB:           Flipper<PixelARGB> ::flip (dataCopy, srcData.data, srcData.lineStride, r.getWidth(), r.getHeight()); break;
+            case Image::RGB:            Flipper<PixelRGB>  ::flip (dataCopy, srcData.data, srcData.lineStride, r.getWidth(), r.getHeight()); break;
+            case Image::SingleChannel:  Flipper<PixelAlpha>::flip (dataCopy, srcData.data, srcData.lineStride, r.getWidth(), r.getHeight()); break;
+            default: return;
+        }
+    }
+
+    // (loadImage() flips the image, putting its top row at the top of the texture)
+    const int textureY = height - r.getBottom();
+
+    glBindTexture (GL_TEXTURE_2D, textureID);
+    glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
+
+   #if ! JUCE_OPENGL_ES
+    if (OpenGLContext* const current = OpenGLContext::getCurrentContext())
+        if (PixelUploadBuffers::get (*current).upload (r.getX(), textureY, r.getWidth(), r.getHeight(), JUCE_RGBA_FORMAT,
+                                                       dataCopy, sizeof (PixelARGB) * (size_t) (r.getWidth() * r.getHeight())))
+            return;
+   #endif
+
+    glTexSubImage2D (GL_TEXTURE_2D, 0, r.getX(), textureY, r.getWidth(), r.getHeight(),
+                     JUCE_RGBA_FORMAT, GL_UNSIGNED_BYTE, dataCopy);
+    JUCE_CHECK_OPENGL_ERROR
 }
 
 void OpenGLTexture::loadARGB (const PixelARGB* pixels, const int w, const int h)
@@ -168,16 +296,23 @@ void OpenGLTexture::release()
     {
         // If the texture is deleted while the owner context is not active, it's
         // impossible to delete it, so this will be a leak until the context itself
-        // is deleted.
-        jassert (ownerContext == OpenGLContext::getCurrentContext());
+        // is deleted. (Textures made by a context that shares its resources can be
+        // deleted by any of the contexts in its group).
+        OpenGLContext* const current = OpenGLContext::getCurrentContext();
+        const bool canDelete = ownerContext == current
+                                || (isShared && current != nullptr && current->isSharingResources());
+
+        jassert (canDelete);
 
-        if (ownerContext == OpenGLContext::getCurrentContext())
+        if (canDelete)
         {
             glDeleteTextures (1, &textureID);
 
             textureID = 0;
             width = 0;
             height = 0;
+            imageWidth = 0;
+            imageHeight = 0;
         }
     }
 }
@@ -42,6 +42,11 @@ public:
 
         The image will be arranged so that its top-left corner is at texture
         coordinate (0, 1).
+
+        If the texture was last loaded from an image of the same size, the existing
+        texture is re-used and its contents are replaced as if by updateImageArea(), so
+        loading each new frame of a video into the same texture avoids re-allocating it
+        and lets the upload happen in the background.
     */
     void loadImage (const Image& image);
 
@@ -68,6 +73,15 @@ public:
     */
     void loadAlpha (const uint8* pixels, int width, int height);
 
+    /** Replaces an area of a texture that was made with loadImage().
+
+        The image must be the same size as the one that the texture was loaded from, and
+        only the given area of it is sent to the GPU. Where pixel buffer objects are
+        available, the pixels are passed to the driver through one of those, so the copy
+        into the texture can finish in the background rather than stalling the caller.
+    */
+    void updateImageArea (const Image& image, const Rectangle<int>& area);
+
     /** Frees the texture, if there is one. */
     void release();
 
@@ -90,8 +104,9 @@ public:
 
 private:
     GLuint textureID;
-    int width, height;
+    int width, height, imageWidth, imageHeight;
     OpenGLContext* ownerContext;
+    bool isShared;
 
     void create (int w, int h, const void*, GLenum, bool topLeft);
 
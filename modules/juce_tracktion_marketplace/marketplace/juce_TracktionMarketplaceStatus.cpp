@@ -146,6 +146,70 @@ static var machineNumberAllowed (StringArray numbersFromKeyFile,
     return result;
 }
 
+//==============================================================================
+/*  Shared by all the TracktionMarketplaceStatus objects in the process, so that when a
+    lot of them get created (e.g. one per plugin instance), the decoded states, decrypted
+    key files and machine IDs only have to be worked out once.
+*/
+struct TracktionMarketplaceStatus::SharedCache
+{
+    bool findLoadedState (int64 checksum, ValueTree& result)
+    {
+        const ScopedLock sl (lock);
+
+        if (! loadedStates.contains (checksum))
+            return false;
+
+        result = loadedStates[checksum].createCopy();
+        return true;
+    }
+
+    void storeLoadedState (int64 checksum, const ValueTree& state)
+    {
+        const ValueTree copy (state.createCopy());
+        const ScopedLock sl (lock);
+
+        if (loadedStates.size() >= maxCachedItems)
+            loadedStates.clear();
+
+        loadedStates.set (checksum, copy);
+    }
+
+    KeyFileUtils::KeyFileData getKeyFileData (const String& keyFileContent, const RSAKey& publicKey)
+    {
+        XXHash64 hash;
+        const String keyString (publicKey.toString());
+        hash.update (keyString.toRawUTF8(), keyString.getNumBytesAsUTF8());
+        hash.update (keyFileContent.toRawUTF8(), keyFileContent.getNumBytesAsUTF8());
+        const int64 checksum = (int64) hash.getHash();
+
+        {
+            const ScopedLock sl (lock);
+
+            if (keyFiles.contains (checksum))
+                return keyFiles[checksum];
+        }
+
+        // (decrypting is the slow bit, so it's done without holding the lock)
+        const KeyFileUtils::KeyFileData data (KeyFileUtils::getDataFromKeyFile (KeyFileUtils::getXmlFromKeyFile (keyFileContent, publicKey)));
+
+        const ScopedLock sl (lock);
+
+        if (keyFiles.size() >= maxCachedItems)
+            keyFiles.clear();
+
+        keyFiles.set (checksum, data);
+        return data;
+    }
+
+    enum { maxCachedItems = 32 };
+
+    CriticalSection lock;
+    HashMap<int64, ValueTree> loadedStates;
+    HashMap<int64, KeyFileUtils::KeyFileData> keyFiles;
+    StringArray localMachineIDs;
+};
+
 //==============================================================================
 TracktionMarketplaceStatus::TracktionMarketplaceStatus()  : status (stateTagName)
 {
@@ -153,12 +217,30 @@ TracktionMarketplaceStatus::TracktionMarketplaceStatus()  : status (stateTagName
 
 TracktionMarketplaceStatus::~TracktionMarketplaceStatus()
 {
+    unlockThread = nullptr;
+    masterReference.clear();
+}
+
+int64 TracktionMarketplaceStatus::getStateChecksum (const String& state)
+{
+    const String productID (getMarketplaceProductID());
+
+    XXHash64 hash;
+    hash.update (productID.toRawUTF8(), productID.getNumBytesAsUTF8());
+    hash.update (state.toRawUTF8(), state.getNumBytesAsUTF8());
+    return (int64) hash.getHash();
 }
 
 void TracktionMarketplaceStatus::load()
 {
+    const String state (getState());
+    const int64 checksum = getStateChecksum (state);
+
+    if (cache->findLoadedState (checksum, status))
+        return;
+
     MemoryBlock mb;
-    mb.fromBase64Encoding (getState());
+    mb.fromBase64Encoding (state);
 
     if (mb.getSize() > 0)
         status = ValueTree::readFromGZIPData (mb.getData(), mb.getSize());
@@ -167,6 +249,8 @@ void TracktionMarketplaceStatus::load()
 
     if (machineNumberAllowed (StringArray ("1234"), getLocalMachineIDs()))
         status.removeProperty (unlockedProp, nullptr);
+
+    cache->storeLoadedState (checksum, status);
 }
 
 void TracktionMarketplaceStatus::save()
@@ -178,7 +262,9 @@ void TracktionMarketplaceStatus::save()
         status.writeToStream (gzipStream);
     }
 
-    saveState (mo.getMemoryBlock().toBase64Encoding());
+    const String state (mo.getMemoryBlock().toBase64Encoding());
+    cache->storeLoadedState (getStateChecksum (state), status);
+    saveState (state);
 }
 
 static String getEncodedIDString (const String& input)
@@ -202,7 +288,11 @@ static String getEncodedIDString (const String& input)
 
 StringArray TracktionMarketplaceStatus::getLocalMachineIDs()
 {
-    StringArray nums;
+    const ScopedLock sl (cache->lock);
+    StringArray& nums = cache->localMachineIDs;
+
+    if (nums.size() > 0)
+        return nums;
 
     // First choice for an ID number is a filesystem ID for the user's home
     // folder or windows directory.
@@ -254,7 +344,7 @@ String TracktionMarketplaceStatus::getUserEmail() const
 bool TracktionMarketplaceStatus::applyKeyFile (String keyFileContent)
 {
     KeyFileUtils::KeyFileData data;
-    data = KeyFileUtils::getDataFromKeyFile (KeyFileUtils::getXmlFromKeyFile (keyFileContent, getPublicKey()));
+    data = cache->getKeyFileData (keyFileContent, getPublicKey());
 
     if (data.licensee.isNotEmpty() && data.email.isNotEmpty() && data.appID == getMarketplaceProductID())
     {
@@ -299,6 +389,7 @@ static bool areMajorWebsitesAvailable()
 TracktionMarketplaceStatus::UnlockResult TracktionMarketplaceStatus::handleXmlReply (XmlElement xml)
 {
     UnlockResult r;
+    r.succeeded = false;
 
     if (const XmlElement* keyNode = xml.getChildByName ("KEY"))
     {
@@ -322,11 +413,12 @@ TracktionMarketplaceStatus::UnlockResult TracktionMarketplaceStatus::handleXmlRe
     return r;
 }
 
-TracktionMarketplaceStatus::UnlockResult TracktionMarketplaceStatus::handleFailedConnection()
+static TracktionMarketplaceStatus::UnlockResult createFailedConnectionResult (const String& websiteName)
 {
-    UnlockResult r;
+    TracktionMarketplaceStatus::UnlockResult r;
+    r.succeeded = false;
 
-    r.errorMessage = TRANS("Couldn't connect to XYZ").replace ("XYZ", getWebsiteName()) + "...\n\n";
+    r.errorMessage = TRANS("Couldn't connect to XYZ").replace ("XYZ", websiteName) + "...\n\n";
 
     if (areMajorWebsitesAvailable())
         r.errorMessage << TRANS("Your internet connection seems to be OK, but our webserver "
@@ -341,20 +433,31 @@ TracktionMarketplaceStatus::UnlockResult TracktionMarketplaceStatus::handleFaile
     return r;
 }
 
-TracktionMarketplaceStatus::UnlockResult TracktionMarketplaceStatus::attemptWebserverUnlock (const String& email,
-                                                                                             const String& password)
+TracktionMarketplaceStatus::UnlockResult TracktionMarketplaceStatus::handleFailedConnection()
 {
-    // This method will block while it contacts the server, so you must run it on a background thread!
-    jassert (! MessageManager::getInstance()->isThisTheMessageThread());
+    return createFailedConnectionResult (getWebsiteName());
+}
 
-    URL url (getServerAuthenticationURL()
-                .withParameter ("product", getMarketplaceProductID())
+static URL createUnlockURL (TracktionMarketplaceStatus& status, const String& email, const String& password)
+{
+    URL url (status.getServerAuthenticationURL()
+                .withParameter ("product", status.getMarketplaceProductID())
                 .withParameter ("email", email)
                 .withParameter ("pw", password)
                 .withParameter ("os", SystemStats::getOperatingSystemName())
-                .withParameter ("mach", getLocalMachineIDs()[0]));
+                .withParameter ("mach", status.getLocalMachineIDs()[0]));
 
     DBG ("Trying to unlock via URL: " << url.toString (true));
+    return url;
+}
+
+TracktionMarketplaceStatus::UnlockResult TracktionMarketplaceStatus::attemptWebserverUnlock (const String& email,
+                                                                                             const String& password)
+{
+    // This method will block while it contacts the server, so you must run it on a background thread!
+    jassert (! MessageManager::getInstance()->isThisTheMessageThread());
+
+    const URL url (createUnlockURL (*this, email, password));
 
     const String reply (url.readEntireTextStream());
 
@@ -368,6 +471,105 @@ TracktionMarketplaceStatus::UnlockResult TracktionMarketplaceStatus::attemptWebs
     return handleFailedConnection();
 }
 
+//==============================================================================
+// Applies the server's reply to the status object on the message thread, and tells the callback.
+struct TracktionMarketplaceStatus::UnlockMessage  : public CallbackMessage
+{
+    UnlockMessage (TracktionMarketplaceStatus* s, XmlElement* x, const UnlockResult& r, UnlockCallback* c)
+        : status (s), xml (x), result (r), callback (c)
+    {
+    }
+
+    void messageCallback() override
+    {
+        if (TracktionMarketplaceStatus* const s = status)
+        {
+            if (xml != nullptr)
+                result = s->handleXmlReply (*xml);
+        }
+        else
+        {
+            result.succeeded = false;
+            result.errorMessage = TRANS ("The unlock was cancelled");
+        }
+
+        if (callback != nullptr)
+            callback->unlockCompleted (result);
+    }
+
+    WeakReference<TracktionMarketplaceStatus> status;
+    ScopedPointer<XmlElement> xml;
+    UnlockResult result;
+    ScopedPointer<UnlockCallback> callback;
+};
+
+/*  Talks to the server. Everything it needs from the status object is fetched before it
+    starts, so it doesn't call any of the status object's virtual methods while running.
+    If the reply contains a key file, this also decrypts it into the shared cache, so that
+    applying it on the message thread doesn't have to do the RSA maths.
+*/
+class TracktionMarketplaceStatus::UnlockThread  : public Thread
+{
+public:
+    UnlockThread (TracktionMarketplaceStatus& s, const String& email, const String& password, UnlockCallback* c)
+        : Thread ("Marketplace unlock"),
+          status (&s),
+          url (createUnlockURL (s, email, password)),
+          publicKey (s.getPublicKey()),
+          websiteName (s.getWebsiteName()),
+          callback (c)
+    {
+        startThread (4);
+    }
+
+    ~UnlockThread()
+    {
+        stopThread (10000);
+    }
+
+    void run() override
+    {
+        const String reply (url.readEntireTextStream());
+
+        DBG ("Reply from server: " << reply);
+
+        XmlElement* const xml = XmlDocument::parse (reply);
+        UnlockResult result;
+        result.succeeded = false;
+
+        if (xml != nullptr)
+        {
+            if (const XmlElement* keyNode = xml->getChildByName ("KEY"))
+                cache->getKeyFileData (keyNode->getAllSubText().trim(), publicKey);
+        }
+        else
+        {
+            result = createFailedConnectionResult (websiteName);
+        }
+
+        (new UnlockMessage (status, xml, result, callback.release()))->post();
+    }
+
+private:
+    WeakReference<TracktionMarketplaceStatus> status;
+    SharedResourcePointer<SharedCache> cache;
+    const URL url;
+    const RSAKey publicKey;
+    const String websiteName;
+    ScopedPointer<UnlockCallback> callback;
+
+    JUCE_DECLARE_NON_COPYABLE (UnlockThread)
+};
+
+void TracktionMarketplaceStatus::attemptWebserverUnlockAsync (const String& email, const String& password,
+                                                              UnlockCallback* callback)
+{
+    jassert (MessageManager::getInstance()->isThisTheMessageThread());
+
+    unlockThread = nullptr;
+    unlockThread = new UnlockThread (*this, email, password, callback);
+}
+
 //==============================================================================
 String TracktionMarketplaceKeyGeneration::generateKeyFile (const String& appName,
                                                            const String& userEmail,
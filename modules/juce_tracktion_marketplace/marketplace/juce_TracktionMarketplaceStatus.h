@@ -177,8 +177,37 @@ public:
     */
     UnlockResult attemptWebserverUnlock (const String& email, const String& password);
 
+    /** Receives the outcome of an attemptWebserverUnlockAsync() call. */
+    class JUCE_API  UnlockCallback
+    {
+    public:
+        virtual ~UnlockCallback() {}
+
+        /** Called on the message thread when the server has replied, or couldn't
+            be contacted.
+        */
+        virtual void unlockCompleted (const UnlockResult& result) = 0;
+    };
+
+    /** Does the same job as attemptWebserverUnlock(), but without blocking.
+
+        The server is contacted on a background thread, and the result is then applied
+        to this object and passed to your callback on the message thread. This must be
+        called on the message thread. The callback is deleted after it has been called,
+        and if this object is deleted before the server replies, the callback is told
+        that the unlock failed.
+
+        If a previous request is still running, this waits for it to finish first.
+    */
+    void attemptWebserverUnlockAsync (const String& email, const String& password,
+                                      UnlockCallback* callback);
+
     /** Attempts to load the status from the state retrieved by getState().
         Call this somewhere in your app's startup code.
+
+        The loaded status is cached for as long as any TracktionMarketplaceStatus objects
+        exist, so when a lot of these are created with the same stored state (e.g. one for
+        each instance of a plugin), only the first one has to decode and check it.
      */
     void load();
 
@@ -188,10 +217,22 @@ public:
     void save();
 
 private:
+    struct SharedCache;
+    class UnlockThread;
+    struct UnlockMessage;
+    friend class UnlockThread;
+    friend struct UnlockMessage;
+
     ValueTree status;
+    SharedResourcePointer<SharedCache> cache;
+    ScopedPointer<UnlockThread> unlockThread;
+
+    WeakReference<TracktionMarketplaceStatus>::Master masterReference;
+    friend class WeakReference<TracktionMarketplaceStatus>;
 
     UnlockResult handleXmlReply (XmlElement);
     UnlockResult handleFailedConnection();
+    int64 getStateChecksum (const String& state);
 
     static const char* unlockedProp;
 
@@ -22,6 +22,84 @@
   ==============================================================================
 */
 
+// Passes images or frames on to a listener from a thread of its own. Only the latest one is
+// kept, so if the listener is slower than the camera, it just skips the frames it missed.
+class CameraDevice::BackgroundListener  : public Listener,
+                                         public FrameListener,
+                                         private Thread
+{
+public:
+    BackgroundListener (Listener* l, FrameListener* f)
+        : Thread ("Camera listener"), listener (l), frameListener (f)
+    {
+        startThread (6);
+    }
+
+    ~BackgroundListener()
+    {
+        signalThreadShouldExit();
+        notify();
+        stopThread (4000);
+    }
+
+    void imageReceived (const Image& image) override
+    {
+        {
+            const ScopedLock sl (lock);
+            pendingImage = image;
+        }
+
+        notify();
+    }
+
+    void frameReceived (const VideoFrame::Ptr& frame) override
+    {
+        {
+            const ScopedLock sl (lock);
+            pendingFrame = frame;
+        }
+
+        notify();
+    }
+
+    Listener* const listener;
+    FrameListener* const frameListener;
+
+private:
+    CriticalSection lock;
+    Image pendingImage;
+    VideoFrame::Ptr pendingFrame;
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wait (-1);
+
+            Image image;
+            VideoFrame::Ptr frame;
+
+            {
+                const ScopedLock sl (lock);
+                std::swap (image, pendingImage);
+                std::swap (frame, pendingFrame);
+            }
+
+            if (threadShouldExit())
+                break;
+
+            if (listener != nullptr && image.isValid())
+                listener->imageReceived (image);
+
+            if (frameListener != nullptr && frame != nullptr)
+                frameListener->frameReceived (frame);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (BackgroundListener)
+};
+
+//==============================================================================
 CameraDevice::CameraDevice (const String& nm, int index, int minWidth, int minHeight, int maxWidth, int maxHeight)
    : name (nm), pimpl (new Pimpl (name, index, minWidth, minHeight, maxWidth, maxHeight))
 {
@@ -31,6 +109,7 @@ CameraDevice::~CameraDevice()
 {
     stopRecording();
     pimpl = nullptr;
+    backgroundListeners.clear();
 }
 
 Component* CameraDevice::createViewerComponent()
@@ -54,16 +133,86 @@ void CameraDevice::stopRecording()
     pimpl->stopRecording();
 }
 
-void CameraDevice::addListener (Listener* listenerToAdd)
+void CameraDevice::addListener (Listener* listenerToAdd, bool callOnBackgroundThread)
 {
     if (listenerToAdd != nullptr)
-        pimpl->addListener (listenerToAdd);
+    {
+        if (callOnBackgroundThread)
+        {
+            BackgroundListener* const b = new BackgroundListener (listenerToAdd, nullptr);
+
+            {
+                const ScopedLock sl (backgroundListenerLock);
+                backgroundListeners.add (b);
+            }
+
+            pimpl->addListener (b);
+        }
+        else
+        {
+            pimpl->addListener (listenerToAdd);
+        }
+    }
 }
 
 void CameraDevice::removeListener (Listener* listenerToRemove)
 {
     if (listenerToRemove != nullptr)
+    {
         pimpl->removeListener (listenerToRemove);
+
+        const ScopedLock sl (backgroundListenerLock);
+
+        for (int i = backgroundListeners.size(); --i >= 0;)
+        {
+            if (backgroundListeners.getUnchecked (i)->listener == listenerToRemove)
+            {
+                pimpl->removeListener (backgroundListeners.getUnchecked (i));
+                backgroundListeners.remove (i);
+            }
+        }
+    }
+}
+
+void CameraDevice::addFrameListener (FrameListener* listenerToAdd, bool callOnBackgroundThread)
+{
+    if (listenerToAdd != nullptr)
+    {
+        if (callOnBackgroundThread)
+        {
+            BackgroundListener* const b = new BackgroundListener (nullptr, listenerToAdd);
+
+            {
+                const ScopedLock sl (backgroundListenerLock);
+                backgroundListeners.add (b);
+            }
+
+            pimpl->addFrameListener (b);
+        }
+        else
+        {
+            pimpl->addFrameListener (listenerToAdd);
+        }
+    }
+}
+
+void CameraDevice::removeFrameListener (FrameListener* listenerToRemove)
+{
+    if (listenerToRemove != nullptr)
+    {
+        pimpl->removeFrameListener (listenerToRemove);
+
+        const ScopedLock sl (backgroundListenerLock);
+
+        for (int i = backgroundListeners.size(); --i >= 0;)
+        {
+            if (backgroundListeners.getUnchecked (i)->frameListener == listenerToRemove)
+            {
+                pimpl->removeFrameListener (backgroundListeners.getUnchecked (i));
+                backgroundListeners.remove (i);
+            }
+        }
+    }
 }
 
 //==============================================================================
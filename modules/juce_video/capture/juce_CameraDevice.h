@@ -121,6 +121,10 @@ public:
             This may be called by any thread, so be careful about thread-safety,
             and make sure that you process the data as quickly as possible to
             avoid glitching!
+
+            The images come from a VideoFramePool, so it's fine to keep hold of one
+            (e.g. to hand it to your OpenGL thread to be uploaded to a texture) - the
+            camera won't write any more frames into it until you let go of it.
         */
         virtual void imageReceived (const Image& image) = 0;
     };
@@ -129,15 +133,62 @@ public:
 
         Be very careful not to delete the listener without first removing it by calling
         removeListener().
+
+        Normally, the listeners are called one after the other on the camera's own
+        thread. If callOnBackgroundThread is true, this listener is given a thread of
+        its own instead, so it can't hold up the other listeners. If it's still busy
+        when a new frame arrives, it'll only be given the most recent frame when it
+        becomes free, so a slow listener will miss frames rather than falling behind.
     */
-    void addListener (Listener* listenerToAdd);
+    void addListener (Listener* listenerToAdd, bool callOnBackgroundThread = false);
 
     /** Removes a listener that was previously added with addListener(). */
     void removeListener (Listener* listenerToRemove);
 
+    //==============================================================================
+    /**
+        Receives callbacks with frames from a CameraDevice, in the camera's own pixel format.
+
+        @see CameraDevice::addFrameListener
+    */
+    class JUCE_API  FrameListener
+    {
+    public:
+        FrameListener() {}
+        virtual ~FrameListener() {}
+
+        /** This method is called when a new frame arrives.
+
+            The frame is in whatever format the camera delivered it in, e.g. NV12 or YUY2,
+            so if you only need the frames for something that can handle that format
+            itself, no RGB conversion has to be done at all. The frames come from a
+            VideoFramePool, so you can keep hold of one for as long as you need it.
+
+            As with Listener::imageReceived(), this may be called by any thread.
+        */
+        virtual void frameReceived (const VideoFrame::Ptr& frame) = 0;
+    };
+
+    /** Adds a listener to receive frames from the camera in its native pixel format.
+
+        Be very careful not to delete the listener without first removing it by calling
+        removeFrameListener(). The callOnBackgroundThread flag works in the same way as
+        it does for addListener().
+    */
+    void addFrameListener (FrameListener* listenerToAdd, bool callOnBackgroundThread = false);
+
+    /** Removes a listener that was previously added with addFrameListener(). */
+    void removeFrameListener (FrameListener* listenerToRemove);
+
 private:
     String name;
 
+    class BackgroundListener;
+    friend class BackgroundListener;
+    friend struct ContainerDeletePolicy<BackgroundListener>;
+    OwnedArray<BackgroundListener> backgroundListeners;
+    CriticalSection backgroundListenerLock;
+
     struct Pimpl;
     friend struct Pimpl;
     friend struct ContainerDeletePolicy<Pimpl>;
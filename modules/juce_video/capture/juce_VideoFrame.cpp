@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+VideoFrame::VideoFrame (const PixelFormat f, const int w, const int h)
+    : format (f), width (w), height (h), timeStamp (0)
+{
+    jassert (w > 0 && h > 0);
+
+    // (the packed YUV formats and the chroma plane of NV12 cover pairs of pixels)
+    const int evenWidth = (w + 1) & ~1;
+
+    switch (format)
+    {
+        case rgb24:   lineStrides[0] = w * 3; break;
+        case argb32:  lineStrides[0] = w * 4; break;
+        case yuy2:
+        case uyvy:    lineStrides[0] = evenWidth * 2; break;
+        case nv12:    lineStrides[0] = w; break;
+        default:      jassertfalse; lineStrides[0] = w * 4; break;
+    }
+
+    lineStrides[1] = format == nv12 ? evenWidth : 0;
+
+    planeOffsets[0] = 0;
+    planeOffsets[1] = (size_t) (lineStrides[0] * h);
+
+    data.malloc (planeOffsets[1] + (size_t) (lineStrides[1] * getNumLines (1)));
+}
+
+VideoFrame::~VideoFrame()
+{
+}
+
+uint8* VideoFrame::getPlaneData (const int plane) const noexcept
+{
+    jassert (isPositiveAndBelow (plane, getNumPlanes()));
+    return data + planeOffsets[plane];
+}
+
+int VideoFrame::getLineStride (const int plane) const noexcept
+{
+    jassert (isPositiveAndBelow (plane, getNumPlanes()));
+    return lineStrides[plane];
+}
+
+int VideoFrame::getNumLines (const int plane) const noexcept
+{
+    return plane == 0 ? height
+                      : (format == nv12 ? (height + 1) / 2 : 0);
+}
+
+//==============================================================================
+namespace VideoFrameHelpers
+{
+    static forcedinline uint8 clampToByte (const int v) noexcept
+    {
+        return (uint8) jlimit (0, 255, v);
+    }
+
+    // Video-range BT.601, in 8-bit fixed point
+    template <class PixelType>
+    static forcedinline void setFromYUV (PixelType& p, const int y, const int u, const int v) noexcept
+    {
+        const int c = 298 * (y - 16) + 128;
+        const int d = u - 128;
+        const int e = v - 128;
+
+        p.setARGB (255,
+                   clampToByte ((c + 409 * e) >> 8),
+                   clampToByte ((c - 100 * d - 208 * e) >> 8),
+                   clampToByte ((c + 516 * d) >> 8));
+    }
+
+    template <class DestPixelType, class SrcPixelType>
+    static void convertRGB (const VideoFrame& frame, const Image::BitmapData& dest)
+    {
+        for (int y = 0; y < frame.getHeight(); ++y)
+        {
+            const SrcPixelType* src = (const SrcPixelType*) (frame.getPlaneData (0) + y * frame.getLineStride (0));
+            uint8* d = dest.getLinePointer (y);
+
+            for (int x = 0; x < frame.getWidth(); ++x)
+            {
+                ((DestPixelType*) d)->set (src[x]);
+                d += dest.pixelStride;
+            }
+        }
+    }
+
+    template <class DestPixelType>
+    static void convertPacked (const VideoFrame& frame, const Image::BitmapData& dest,
+                               const int y0Index, const int uIndex, const int y1Index, const int vIndex)
+    {
+        const int w = frame.getWidth();
+
+        for (int y = 0; y < frame.getHeight(); ++y)
+        {
+            const uint8* src = frame.getPlaneData (0) + y * frame.getLineStride (0);
+            uint8* d = dest.getLinePointer (y);
+
+            for (int x = 0; x < w; x += 2)
+            {
+                const int u = src[uIndex], v = src[vIndex];
+
+                setFromYUV (*(DestPixelType*) d, src[y0Index], u, v);
+                d += dest.pixelStride;
+
+                if (x + 1 < w)
+                {
+                    setFromYUV (*(DestPixelType*) d, src[y1Index], u, v);
+                    d += dest.pixelStride;
+                }
+
+                src += 4;
+            }
+        }
+    }
+
+    template <class DestPixelType>
+    static void convertNV12 (const VideoFrame& frame, const Image::BitmapData& dest)
+    {
+        const int w = frame.getWidth();
+
+        for (int y = 0; y < frame.getHeight(); ++y)
+        {
+            const uint8* luma   = frame.getPlaneData (0) + y * frame.getLineStride (0);
+            const uint8* chroma = frame.getPlaneData (1) + (y >> 1) * frame.getLineStride (1);
+            uint8* d = dest.getLinePointer (y);
+
+            for (int x = 0; x < w; ++x)
+            {
+                const uint8* uv = chroma + (x & ~1);
+                setFromYUV (*(DestPixelType*) d, luma[x], uv[0], uv[1]);
+                d += dest.pixelStride;
+            }
+        }
+    }
+
+    template <class DestPixelType>
+    static void convert (const VideoFrame& frame, const Image::BitmapData& dest)
+    {
+        switch (frame.getPixelFormat())
+        {
+            case VideoFrame::rgb24:   convertRGB<DestPixelType, PixelRGB>  (frame, dest); break;
+            case VideoFrame::argb32:  convertRGB<DestPixelType, PixelARGB> (frame, dest); break;
+            case VideoFrame::yuy2:    convertPacked<DestPixelType> (frame, dest, 0, 1, 2, 3); break;
+            case VideoFrame::uyvy:    convertPacked<DestPixelType> (frame, dest, 1, 0, 3, 2); break;
+            case VideoFrame::nv12:    convertNV12<DestPixelType> (frame, dest); break;
+            default:                  jassertfalse; break;
+        }
+    }
+}
+
+void VideoFrame::copyToImage (Image& destImage) const
+{
+    if (destImage.getWidth() != width || destImage.getHeight() != height)
+    {
+        jassertfalse; // The image must be the same size as the frame!
+        return;
+    }
+
+    const Image::BitmapData dest (destImage, 0, 0, width, height, Image::BitmapData::writeOnly);
+
+    switch (destImage.getFormat())
+    {
+        case Image::RGB:    VideoFrameHelpers::convert<PixelRGB>  (*this, dest); break;
+        case Image::ARGB:   VideoFrameHelpers::convert<PixelARGB> (*this, dest); break;
+        default:            jassertfalse; break; // can only convert to RGB or ARGB images
+    }
+}
+
+Image VideoFrame::createImage() const
+{
+    Image image (Image::RGB, width, height, false);
+    copyToImage (image);
+    return image;
+}
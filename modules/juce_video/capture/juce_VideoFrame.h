@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_VIDEOFRAME_H_INCLUDED
+#define JUCE_VIDEOFRAME_H_INCLUDED
+
+
+//==============================================================================
+/**
+    A frame of video in the pixel format that its source produced it in.
+
+    Unlike an Image, a VideoFrame can hold YUV formats such as NV12 and YUY2, which is
+    what most cameras produce natively, so a receiver that can deal with those formats
+    itself (e.g. with a shader that does the colour conversion on the GPU) can avoid
+    having them converted to RGB on the CPU first. If you do need an RGB image, you can
+    use copyToImage() or createImage().
+
+    VideoFrames are reference-counted, and are usually recycled by a VideoFramePool.
+
+    @see VideoFramePool, CameraDevice::FrameListener
+*/
+class JUCE_API  VideoFrame  : public ReferenceCountedObject
+{
+public:
+    //==============================================================================
+    /** The layouts of pixel data that a VideoFrame can hold. */
+    enum PixelFormat
+    {
+        rgb24,      /**< One plane, laid out in the same way as the pixels of an Image::RGB. */
+        argb32,     /**< One plane, laid out in the same way as the pixels of an Image::ARGB. */
+        yuy2,       /**< One plane of packed 4:2:2 YUV, in the byte order Y0 U Y1 V. */
+        uyvy,       /**< One plane of packed 4:2:2 YUV, in the byte order U Y0 V Y1. */
+        nv12        /**< A plane of 8-bit Y values, followed by a half-height plane of interleaved
+                         U and V values for each 2x2 block of pixels. */
+    };
+
+    /** Creates a frame with the given format and size.
+        The contents of the pixel data are undefined.
+    */
+    VideoFrame (PixelFormat format, int width, int height);
+
+    /** Destructor. */
+    ~VideoFrame();
+
+    /** A pointer to a VideoFrame. */
+    typedef ReferenceCountedObjectPtr<VideoFrame> Ptr;
+
+    //==============================================================================
+    /** Returns the frame's pixel format. */
+    PixelFormat getPixelFormat() const noexcept             { return format; }
+
+    /** Returns the frame's width in pixels. */
+    int getWidth() const noexcept                           { return width; }
+
+    /** Returns the frame's height in pixels. */
+    int getHeight() const noexcept                          { return height; }
+
+    /** Returns the number of separate planes of data that the frame's format uses. */
+    int getNumPlanes() const noexcept                       { return format == nv12 ? 2 : 1; }
+
+    /** Returns the start of one of the frame's planes of data. */
+    uint8* getPlaneData (int plane) const noexcept;
+
+    /** Returns the number of bytes between the start of each line of one of the frame's planes. */
+    int getLineStride (int plane) const noexcept;
+
+    /** Returns the number of lines in one of the frame's planes. */
+    int getNumLines (int plane) const noexcept;
+
+    //==============================================================================
+    /** Returns the time at which the frame was captured, in seconds.
+        The time that this is relative to depends on where the frame came from.
+    */
+    double getTimeStamp() const noexcept                    { return timeStamp; }
+
+    /** Sets the time returned by getTimeStamp(). */
+    void setTimeStamp (double newTimeStamp) noexcept        { timeStamp = newTimeStamp; }
+
+    //==============================================================================
+    /** Converts the frame into an image, which must be the same size as the frame,
+        and must be either Image::RGB or Image::ARGB.
+        YUV data is treated as video-range BT.601.
+    */
+    void copyToImage (Image& destImage) const;
+
+    /** Creates a new RGB image containing the frame's pixels. */
+    Image createImage() const;
+
+private:
+    //==============================================================================
+    const PixelFormat format;
+    const int width, height;
+    HeapBlock<uint8> data;
+    int lineStrides[2];
+    size_t planeOffsets[2];
+    double timeStamp;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VideoFrame)
+};
+
+
+#endif   // JUCE_VIDEOFRAME_H_INCLUDED
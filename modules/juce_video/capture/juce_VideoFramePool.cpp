@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+VideoFramePool::VideoFramePool (const int maxFrames)
+    : maxNumFrames (jmax (1, maxFrames))
+{
+}
+
+VideoFramePool::~VideoFramePool()
+{
+}
+
+Image VideoFramePool::getFreeFrame (const Image::PixelFormat format, const int width, const int height)
+{
+    const ScopedLock sl (lock);
+
+    for (int i = frames.size(); --i >= 0;)
+    {
+        const Image& frame = frames.getReference (i);
+
+        // (if the pool holds the only reference to a frame, nobody else can be using it)
+        if (frame.getReferenceCount() == 1)
+        {
+            if (frame.getFormat() == format && frame.getWidth() == width && frame.getHeight() == height)
+                return frame;
+
+            // (the frame size or format has changed, so the old ones are no use any more)
+            frames.remove (i);
+        }
+    }
+
+    // The native image type lets platform code draw into the frame directly
+    Image newFrame (format, width, height, false, NativeImageType());
+
+    if (frames.size() < maxNumFrames)
+        frames.add (newFrame);
+
+    return newFrame;
+}
+
+VideoFrame::Ptr VideoFramePool::getFreeVideoFrame (const VideoFrame::PixelFormat format, const int width, const int height)
+{
+    const ScopedLock sl (lock);
+
+    for (int i = videoFrames.size(); --i >= 0;)
+    {
+        VideoFrame* const frame = videoFrames.getObjectPointerUnchecked (i);
+
+        if (frame->getReferenceCount() == 1)
+        {
+            if (frame->getPixelFormat() == format && frame->getWidth() == width && frame->getHeight() == height)
+                return frame;
+
+            videoFrames.remove (i);
+        }
+    }
+
+    VideoFrame* const newFrame = new VideoFrame (format, width, height);
+
+    if (videoFrames.size() < maxNumFrames)
+        videoFrames.add (newFrame);
+
+    return newFrame;
+}
+
+int VideoFramePool::getNumFrames() const
+{
+    const ScopedLock sl (lock);
+    return frames.size() + videoFrames.size();
+}
+
+void VideoFramePool::clear()
+{
+    const ScopedLock sl (lock);
+    frames.clear();
+    videoFrames.clear();
+}
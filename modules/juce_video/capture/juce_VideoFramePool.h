@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2013 - Raw Material Software Ltd.
+
+   Permission is granted to use this software under the terms of either:
+   a) the GPL v2 (or any later version)
+   b) the Affero GPL v3
+
+   Details of these licenses can be found at: www.gnu.org/licenses
+
+   JUCE is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+   A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   ------------------------------------------------------------------------------
+
+   To release a closed-source product which uses JUCE, commercial licenses are
+   available: visit www.juce.com for more information.
+
+  ==============================================================================
+*/
+
+
+#ifndef JUCE_VIDEOFRAMEPOOL_H_INCLUDED
+#define JUCE_VIDEOFRAMEPOOL_H_INCLUDED
+
+
+//==============================================================================
+/**
+    Keeps a set of images and VideoFrames that can be re-used for successive frames of video.
+
+    Each frame that getFreeFrame() or getFreeVideoFrame() returns is one that nothing
+    else is still holding a reference to, so a frame source can write the next frame into it without having
+    to allocate a new image, and without disturbing anyone who is still using an
+    earlier frame. When the receiver of a frame lets go of its Image, that frame
+    becomes free again.
+
+    This means the receiver of a frame can keep hold of it for a while, e.g. until it
+    has been uploaded to an OpenGLTexture on the GL thread, without the source having
+    to make a copy for it.
+
+    @see VideoFrame, CameraDevice::Listener
+*/
+class JUCE_API  VideoFramePool
+{
+public:
+    //==============================================================================
+    /** Creates a pool that will hold up to the given number of images, and the same
+        number of VideoFrames.
+
+        If all the frames are in use when another one is needed, a new one is
+        returned, but it isn't added to the pool.
+    */
+    explicit VideoFramePool (int maxNumFrames = 6);
+
+    /** Destructor. */
+    ~VideoFramePool();
+
+    //==============================================================================
+    /** Returns an image with the given format and size that nothing else is using.
+
+        The contents of the image are undefined, so the caller is expected to
+        overwrite all of it. This can be called by any thread.
+    */
+    Image getFreeFrame (Image::PixelFormat format, int width, int height);
+
+    /** Returns a VideoFrame with the given format and size that nothing else is using.
+
+        As with getFreeFrame(), the contents are undefined, and this can be called by
+        any thread.
+    */
+    VideoFrame::Ptr getFreeVideoFrame (VideoFrame::PixelFormat format, int width, int height);
+
+    /** Returns the number of images and VideoFrames that the pool is holding. */
+    int getNumFrames() const;
+
+    /** Releases all the frames that the pool is holding. */
+    void clear();
+
+private:
+    //==============================================================================
+    CriticalSection lock;
+    Array<Image> frames;
+    ReferenceCountedArray<VideoFrame> videoFrames;
+    const int maxNumFrames;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VideoFramePool)
+};
+
+
+#endif   // JUCE_VIDEOFRAMEPOOL_H_INCLUDED
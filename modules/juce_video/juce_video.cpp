@@ -139,6 +139,9 @@ namespace juce
  #endif
 #endif
 
+#include "capture/juce_VideoFrame.cpp"
+#include "capture/juce_VideoFramePool.cpp"
+
 #if JUCE_USE_CAMERA
  #include "capture/juce_CameraDevice.cpp"
 #endif
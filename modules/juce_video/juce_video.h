@@ -75,6 +75,8 @@ namespace juce
 
 #include "playback/juce_DirectShowComponent.h"
 #include "playback/juce_QuickTimeMovieComponent.h"
+#include "capture/juce_VideoFrame.h"
+#include "capture/juce_VideoFramePool.h"
 #include "capture/juce_CameraDevice.h"
 
 }
@@ -57,6 +57,14 @@ struct CameraDevice::Pimpl
         listeners.removeFirstMatchingValue (listenerToRemove);
     }
 
+    void addFrameListener (CameraDevice::FrameListener*)
+    {
+    }
+
+    void removeFrameListener (CameraDevice::FrameListener*)
+    {
+    }
+
     static StringArray getAvailableDevices()
     {
         StringArray results;
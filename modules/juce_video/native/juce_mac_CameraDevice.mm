@@ -26,7 +26,7 @@
  #error "To support cameras in OSX you'll need to enable the JUCE_QUICKTIME flag"
 #endif
 
-extern Image juce_createImageFromCIImage (CIImage*, int w, int h);
+extern CGContextRef juce_getImageContext (const Image&);
 
 struct CameraDevice::Pimpl
 {
@@ -190,7 +190,7 @@ struct CameraDevice::Pimpl
     {
         const ScopedLock sl (listenerLock);
 
-        if (listeners.size() == 0)
+        if (getNumListeners() == 0)
             [session addOutput: imageOutput error: nil];
 
         listeners.addIfNotAlreadyThere (listenerToAdd);
@@ -201,13 +201,103 @@ struct CameraDevice::Pimpl
         const ScopedLock sl (listenerLock);
         listeners.removeFirstMatchingValue (listenerToRemove);
 
-        if (listeners.size() == 0)
+        if (getNumListeners() == 0)
             [session removeOutput: imageOutput];
     }
 
+    void addFrameListener (CameraDevice::FrameListener* listenerToAdd)
+    {
+        const ScopedLock sl (listenerLock);
+
+        if (getNumListeners() == 0)
+            [session addOutput: imageOutput error: nil];
+
+        frameListeners.addIfNotAlreadyThere (listenerToAdd);
+    }
+
+    void removeFrameListener (CameraDevice::FrameListener* listenerToRemove)
+    {
+        const ScopedLock sl (listenerLock);
+        frameListeners.removeFirstMatchingValue (listenerToRemove);
+
+        if (getNumListeners() == 0)
+            [session removeOutput: imageOutput];
+    }
+
+    int getNumListeners() const noexcept
+    {
+        return listeners.size() + frameListeners.size();
+    }
+
+    static bool getVideoFrameFormat (OSType pixelFormatType, VideoFrame::PixelFormat& result) noexcept
+    {
+        switch (pixelFormatType)
+        {
+            case kCVPixelFormatType_32BGRA:                         result = VideoFrame::argb32; return true;
+            case kCVPixelFormatType_422YpCbCr8:                     result = VideoFrame::uyvy;   return true;
+            case kCVPixelFormatType_422YpCbCr8_yuvs:                result = VideoFrame::yuy2;   return true;
+            case kCVPixelFormatType_420YpCbCr8BiPlanarVideoRange:   result = VideoFrame::nv12;   return true;
+            default:                                                return false;
+        }
+    }
+
+    // Copies the camera's pixel buffer into a pooled frame, without converting it
+    VideoFrame::Ptr createVideoFrame (CVImageBufferRef buffer)
+    {
+        VideoFrame::PixelFormat format;
+
+        if (! getVideoFrameFormat (CVPixelBufferGetPixelFormatType (buffer), format))
+            return nullptr;
+
+        VideoFrame::Ptr frame (framePool.getFreeVideoFrame (format, (int) CVPixelBufferGetWidth (buffer),
+                                                            (int) CVPixelBufferGetHeight (buffer)));
+
+        CVPixelBufferLockBaseAddress (buffer, 0);
+        const bool isPlanar = CVPixelBufferIsPlanar (buffer);
+
+        for (int plane = 0; plane < frame->getNumPlanes(); ++plane)
+        {
+            const uint8* src = (const uint8*) (isPlanar ? CVPixelBufferGetBaseAddressOfPlane (buffer, (size_t) plane)
+                                                        : CVPixelBufferGetBaseAddress (buffer));
+            const int srcStride = (int) (isPlanar ? CVPixelBufferGetBytesPerRowOfPlane (buffer, (size_t) plane)
+                                                  : CVPixelBufferGetBytesPerRow (buffer));
+            const int destStride = frame->getLineStride (plane);
+            uint8* dest = frame->getPlaneData (plane);
+
+            if (src != nullptr)
+                for (int i = frame->getNumLines (plane); --i >= 0;)
+                    memcpy (dest + destStride * i, src + srcStride * i, (size_t) jmin (srcStride, destStride));
+        }
+
+        CVPixelBufferUnlockBaseAddress (buffer, 0);
+        return frame;
+    }
+
+    void callFrameListeners (const VideoFrame::Ptr& frame)
+    {
+        const ScopedLock sl (listenerLock);
+
+        for (int i = frameListeners.size(); --i >= 0;)
+            if (CameraDevice::FrameListener* const l = frameListeners[i])
+                l->frameReceived (frame);
+    }
+
+    Image createImage (CIImage* frame, int w, int h)
+    {
+        // (the pool's frames are native images, so CoreImage can draw straight into them)
+        Image image (framePool.getFreeFrame (Image::ARGB, w, h));
+
+        CGContextRef imageContext = juce_getImageContext (image);
+        CIContext* cic = [CIContext contextWithCGContext: imageContext options: nil];
+        [cic drawImage: frame inRect: CGRectMake (0, 0, w, h) fromRect: CGRectMake (0, 0, w, h)];
+        CGContextFlush (imageContext);
+
+        return image;
+    }
+
     void callListeners (CIImage* frame, int w, int h)
     {
-        Image image (juce_createImageFromCIImage (frame, w, h));
+        const Image image (createImage (frame, w, h));
 
         const ScopedLock sl (listenerLock);
 
@@ -274,7 +364,9 @@ struct CameraDevice::Pimpl
     bool isRecording;
 
     Array<CameraDevice::Listener*> listeners;
+    Array<CameraDevice::FrameListener*> frameListeners;
     CriticalSection listenerLock;
+    VideoFramePool framePool;
 
 private:
     //==============================================================================
@@ -301,6 +393,31 @@ private:
         {
             Pimpl* const internal = getOwner (self);
 
+            if (internal->frameListeners.size() > 0)
+            {
+                VideoFrame::Ptr frame (internal->createVideoFrame (videoFrame));
+
+                // (if the camera's format isn't one that a VideoFrame can hold, it's rendered as ARGB instead)
+                if (frame == nullptr)
+                {
+                    JUCE_AUTORELEASEPOOL
+                    {
+                        const Image image (internal->createImage ([CIImage imageWithCVImageBuffer: videoFrame],
+                                                                  (int) CVPixelBufferGetWidth (videoFrame),
+                                                                  (int) CVPixelBufferGetHeight (videoFrame)));
+
+                        frame = internal->framePool.getFreeVideoFrame (VideoFrame::argb32, image.getWidth(), image.getHeight());
+                        const Image::BitmapData src (image, Image::BitmapData::readOnly);
+
+                        for (int y = 0; y < image.getHeight(); ++y)
+                            memcpy (frame->getPlaneData (0) + y * frame->getLineStride (0),
+                                    src.getLinePointer (y), (size_t) frame->getLineStride (0));
+                    }
+                }
+
+                internal->callFrameListeners (frame);
+            }
+
             if (internal->listeners.size() > 0)
             {
                 JUCE_AUTORELEASEPOOL
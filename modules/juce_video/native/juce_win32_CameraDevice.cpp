@@ -43,6 +43,7 @@ static const IID IID_ISampleGrabberCB  = { 0x0579154A, 0x2B53, 0x4994, { 0xB0, 0
 static const IID IID_ISampleGrabber    = { 0x6B652FFF, 0x11FE, 0x4fce, { 0x92, 0xAD, 0x02, 0x66, 0xB5, 0xD7, 0xC7, 0x8F } };
 static const CLSID CLSID_SampleGrabber = { 0xC1F400A0, 0x3F08, 0x11d3, { 0x9F, 0x0B, 0x00, 0x60, 0x08, 0x03, 0x9E, 0x37 } };
 static const CLSID CLSID_NullRenderer  = { 0xC1F400A4, 0x3F08, 0x11d3, { 0x9F, 0x0B, 0x00, 0x60, 0x08, 0x03, 0x9E, 0x37 } };
+static const GUID  juce_MEDIASUBTYPE_NV12 = { 0x3231564E, 0x0000, 0x0010, { 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71 } };
 
 
 struct CameraDevice::Pimpl  : public ChangeBroadcaster
@@ -54,6 +55,7 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
          openedSuccessfully (false),
          imageNeedsFlipping (false),
          width (0), height (0),
+         pixelFormat (VideoFrame::rgb24),
          activeUsers (0),
          recordNextFrameTime (false),
          previewMaxFPS (60)
@@ -117,14 +119,6 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
         if (FAILED (hr))
             return;
 
-        {
-            AM_MEDIA_TYPE mt = { 0 };
-            mt.majortype = MEDIATYPE_Video;
-            mt.subtype = MEDIASUBTYPE_RGB24;
-            mt.formattype = FORMAT_VideoInfo;
-            sampleGrabber->SetMediaType (&mt);
-        }
-
         callback = new GrabberCallback (*this);
         hr = sampleGrabber->SetCallback (callback, 1);
 
@@ -138,8 +132,7 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
                 && getPin (sampleGrabberBase, PINDIR_INPUT, grabberInputPin)))
             return;
 
-        hr = graphBuilder->Connect (smartTeePreviewOutputPin, grabberInputPin);
-        if (FAILED (hr))
+        if (! connectSampleGrabber (grabberInputPin))
             return;
 
         AM_MEDIA_TYPE mt = { 0 };
@@ -214,19 +207,57 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
     {
         const ScopedLock sl (listenerLock);
 
-        if (listeners.size() == 0)
-            addUser();
+        if (! listeners.contains (listenerToAdd))
+        {
+            if (getNumListeners() == 0)
+                addUser();
 
-        listeners.addIfNotAlreadyThere (listenerToAdd);
+            listeners.add (listenerToAdd);
+        }
     }
 
     void removeListener (CameraDevice::Listener* listenerToRemove)
     {
         const ScopedLock sl (listenerLock);
-        listeners.removeAllInstancesOf (listenerToRemove);
 
-        if (listeners.size() == 0)
-            removeUser();
+        if (listeners.contains (listenerToRemove))
+        {
+            listeners.removeAllInstancesOf (listenerToRemove);
+
+            if (getNumListeners() == 0)
+                removeUser();
+        }
+    }
+
+    void addFrameListener (CameraDevice::FrameListener* listenerToAdd)
+    {
+        const ScopedLock sl (listenerLock);
+
+        if (! frameListeners.contains (listenerToAdd))
+        {
+            if (getNumListeners() == 0)
+                addUser();
+
+            frameListeners.add (listenerToAdd);
+        }
+    }
+
+    void removeFrameListener (CameraDevice::FrameListener* listenerToRemove)
+    {
+        const ScopedLock sl (listenerLock);
+
+        if (frameListeners.contains (listenerToRemove))
+        {
+            frameListeners.removeAllInstancesOf (listenerToRemove);
+
+            if (getNumListeners() == 0)
+                removeUser();
+        }
+    }
+
+    int getNumListeners() const noexcept
+    {
+        return listeners.size() + frameListeners.size();
     }
 
     void callListeners (const Image& image)
@@ -238,6 +269,15 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
                 l->imageReceived (image);
     }
 
+    void callFrameListeners (const VideoFrame::Ptr& frame)
+    {
+        const ScopedLock sl (listenerLock);
+
+        for (int i = frameListeners.size(); --i >= 0;)
+            if (CameraDevice::FrameListener* const l = frameListeners[i])
+                l->frameReceived (frame);
+    }
+
     void addUser()
     {
         if (openedSuccessfully && activeUsers++ == 0)
@@ -250,7 +290,7 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
             mediaControl->Stop();
     }
 
-    void handleFrame (double /*time*/, BYTE* buffer, long /*bufferSize*/)
+    void handleFrame (double time, BYTE* buffer, long bufferSize)
     {
         if (recordNextFrameTime)
         {
@@ -275,27 +315,91 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
             }
         }
 
+        // (each frame goes into a free one from the pool, so a listener that's still
+        // holding on to an earlier frame doesn't force it to be copied)
+        VideoFrame::Ptr frame (framePool.getFreeVideoFrame (pixelFormat, width, height));
+        frame->setTimeStamp (time);
+
+        if (! copyFrameData (*frame, buffer, bufferSize))
+            return;
+
+        if (frameListeners.size() > 0)
+            callFrameListeners (frame);
+
+        // (the RGB conversion is only needed if something's going to look at the image)
+        if (listeners.size() > 0 || viewerComps.size() > 0)
         {
-            const int lineStride = width * 3;
-            const ScopedLock sl (imageSwapLock);
+            Image image (framePool.getFreeFrame (Image::RGB, width, height));
+            frame->copyToImage (image);
 
             {
-                loadingImage.duplicateIfShared();
-                const Image::BitmapData destData (loadingImage, 0, 0, width, height, Image::BitmapData::writeOnly);
-
-                for (int i = 0; i < height; ++i)
-                    memcpy (destData.getLinePointer ((height - 1) - i),
-                            buffer + lineStride * i,
-                            lineStride);
+                const ScopedLock sl (imageSwapLock);
+                loadingImage = image;
+                imageNeedsFlipping = true;
             }
 
-            imageNeedsFlipping = true;
+            if (listeners.size() > 0)
+                callListeners (image);
+
+            sendChangeMessage();
         }
+    }
+
+    bool copyFrameData (VideoFrame& frame, const BYTE* buffer, long bufferSize) const
+    {
+        // RGB frames arrive as a bottom-up DIB, with each line padded to a multiple of 4 bytes
+        const bool isRGB = pixelFormat == VideoFrame::rgb24;
+        const int rgbLineStride = (width * 3 + 3) & ~3;
+
+        size_t bytesNeeded = 0;
+
+        for (int plane = 0; plane < frame.getNumPlanes(); ++plane)
+            bytesNeeded += (size_t) ((isRGB ? rgbLineStride : frame.getLineStride (plane)) * frame.getNumLines (plane));
+
+        if (bufferSize < 0 || (size_t) bufferSize < bytesNeeded)
+            return false;
+
+        for (int plane = 0; plane < frame.getNumPlanes(); ++plane)
+        {
+            const int destStride = frame.getLineStride (plane);
+            const int srcStride = isRGB ? rgbLineStride : destStride;
+            const int numLines = frame.getNumLines (plane);
+            uint8* const dest = frame.getPlaneData (plane);
 
-        if (listeners.size() > 0)
-            callListeners (loadingImage);
+            for (int i = 0; i < numLines; ++i)
+                memcpy (dest + destStride * (isRGB ? (numLines - 1 - i) : i),
+                        buffer + srcStride * i,
+                        (size_t) destStride);
 
-        sendChangeMessage();
+            buffer += srcStride * numLines;
+        }
+
+        return true;
+    }
+
+    bool connectSampleGrabber (IPin* grabberInputPin)
+    {
+        // The camera's own YUV formats are tried first, so that frame listeners can be given
+        // them without any conversion. RGB is the fallback, as almost anything can be converted to it.
+        const GUID* const subtypes[] = { &juce_MEDIASUBTYPE_NV12, &MEDIASUBTYPE_YUY2, &MEDIASUBTYPE_RGB24 };
+        const VideoFrame::PixelFormat formats[] = { VideoFrame::nv12, VideoFrame::yuy2, VideoFrame::rgb24 };
+
+        for (int i = 0; i < numElementsInArray (subtypes); ++i)
+        {
+            AM_MEDIA_TYPE mt = { 0 };
+            mt.majortype = MEDIATYPE_Video;
+            mt.subtype = *subtypes[i];
+            mt.formattype = FORMAT_VideoInfo;
+            sampleGrabber->SetMediaType (&mt);
+
+            if (SUCCEEDED (graphBuilder->Connect (smartTeePreviewOutputPin, grabberInputPin)))
+            {
+                pixelFormat = formats[i];
+                return true;
+            }
+        }
+
+        return false;
     }
 
     void drawCurrentImage (Graphics& g, Rectangle<int> area)
@@ -522,10 +626,12 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
 
     ComSmartPtr<GrabberCallback> callback;
     Array<CameraDevice::Listener*> listeners;
+    Array<CameraDevice::FrameListener*> frameListeners;
     CriticalSection listenerLock;
 
     bool isRecording, openedSuccessfully;
     int width, height;
+    VideoFrame::PixelFormat pixelFormat;
     Time firstRecordedTime;
 
     Array<ViewerComponent*> viewerComps;
@@ -543,6 +649,7 @@ struct CameraDevice::Pimpl  : public ChangeBroadcaster
     CriticalSection imageSwapLock;
     bool imageNeedsFlipping;
     Image loadingImage, activeImage;
+    VideoFramePool framePool;
 
     bool recordNextFrameTime;
     int previewMaxFPS;